@@ -0,0 +1,314 @@
+// Microbenchmarks of the symbolic kernels on the generated spec families of examples/.
+//
+// Every kernel is registered once per spec, as "<kernel>/<family>/<size>",
+// for the families examples/pattern_* and examples/counter and the sizes in
+// LYDIASYFT_BENCHMARK_SIZES (comma-separated, "2,4,8" by default). The DFAs
+// of a spec are built on the first run of one of its kernels and kept for
+// the others, so that a --benchmark_filter only pays for the specs it selects.
+// LYDIASYFT_BENCHMARK_BDD_BACKEND ("cudd" by default, or "sylvan") selects the
+// BddBackend of the preimage, cpre and Reachability::run kernels.
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "InterfaceLayout.h"
+#include "Synthesizer.h"
+#include "automata/ColorAutomatonBuilder.h"
+#include "automata/ExplicitStateDfa.h"
+#include "automata/SymbolicStateDfa.h"
+#include "game/EmersonLei.hpp"
+#include "game/Reachability.hpp"
+#include "game/SCCDecomposer.h"
+#include "game/LayeredEmersonLei.h"
+#include "game/SymbolicEmersonLei.h"
+#include "game/ZielonkaTree.hh"
+#include "string_utilities.h"
+#include <lydia/logic/pnf.hpp>
+#include <lydia/parser/ltlfplus/driver.hpp>
+
+namespace {
+  // Exposes the preimage of the game solvers
+  class PreimageGame : public Syft::Reachability {
+   public:
+    using Syft::Reachability::Reachability;
+    using Syft::DfaGameSynthesizer::preimage;
+  };
+
+  // The automata of one spec, built once
+  struct Spec {
+    std::shared_ptr<Syft::VarMgr> var_mgr;
+    std::string color_formula;
+    std::vector<Syft::ExplicitStateDfa> explicit_dfas;
+    std::vector<Syft::SymbolicStateDfa> components;
+    std::vector<CUDD::BDD> goal_states;
+    std::unique_ptr<Syft::SymbolicStateDfa> product;
+  };
+
+  Syft::LTLfPlus read_formula(const std::string& filename) {
+    std::ifstream in(filename);
+    whitemech::lydia::parsers::ltlfplus::LTLfPlusDriver driver;
+    driver.parse(in);
+    auto formula = std::static_pointer_cast<const whitemech::lydia::LTLfPlusFormula>(driver.get_result());
+    auto pnf = whitemech::lydia::get_pnf_result(*formula);
+    Syft::LTLfPlus ltlf_plus;
+    ltlf_plus.color_formula_ = pnf.color_formula_;
+    ltlf_plus.formula_to_color_ = pnf.subformula_to_color_;
+    ltlf_plus.formula_to_quantification_ = pnf.subformula_to_quantifier_;
+    return ltlf_plus;
+  }
+
+  Syft::VarMgrOptions benchmark_var_mgr_options() {
+    const char* backend = std::getenv("LYDIASYFT_BENCHMARK_BDD_BACKEND");
+    Syft::VarMgrOptions options;
+    options.bdd_backend = Syft::bdd_backend_from_string(backend ? backend : "cudd");
+    return options;
+  }
+
+  const Spec& load_spec(const std::string& formula_file) {
+    static std::map<std::string, std::unique_ptr<Spec>> specs;
+    std::unique_ptr<Spec>& spec = specs[formula_file];
+    if (spec) {
+      return *spec;
+    }
+    spec = std::make_unique<Spec>();
+    std::filesystem::path partition_file = std::filesystem::path(formula_file).replace_extension(".part");
+    Syft::LTLfPlus formula = read_formula(formula_file);
+    spec->var_mgr =
+        Syft::InterfaceLayout::read_from_file(partition_file.string()).instantiate(benchmark_var_mgr_options());
+    spec->color_formula = formula.color_formula_;
+
+    Syft::ColorAutomatonBuilder builder(spec->var_mgr, Syft::DfaConstructionOptions());
+    std::map<int, Syft::SharedExplicitStateDfa> explicit_dfas =
+        builder.build_explicit(formula, Syft::ColorAutomatonBuilder::emerson_lei_transform);
+    std::vector<const Syft::ExplicitStateDfa*> distinct;
+    for (const auto& [color, dfa] : explicit_dfas) {
+      if (std::find(distinct.begin(), distinct.end(), dfa.get()) == distinct.end()) {
+        distinct.push_back(dfa.get());
+        spec->explicit_dfas.push_back(*dfa);
+      }
+    }
+    Syft::ColorArenas arenas = builder.build_symbolic(formula, Syft::ColorAutomatonBuilder::emerson_lei_transform);
+    spec->components = std::move(arenas.components);
+    spec->goal_states = std::move(arenas.goal_states);
+    spec->product = std::make_unique<Syft::SymbolicStateDfa>(Syft::SymbolicStateDfa::product_AND(spec->components));
+    return *spec;
+  }
+
+  void BM_Preimage(benchmark::State& state, const std::string& formula_file) {
+    const Spec& spec = load_spec(formula_file);
+    CUDD::BDD one = spec.var_mgr->cudd_mgr()->bddOne();
+    PreimageGame game(*spec.product, Syft::Player::Agent, Syft::Player::Agent, spec.product->final_states(), one);
+    CUDD::BDD target = spec.product->final_states();
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(game.preimage(target));
+    }
+  }
+
+  // A whole reachability fixpoint, which the backends other than CUDD keep in their own package
+  void BM_ReachabilityRun(benchmark::State& state, const std::string& formula_file) {
+    const Spec& spec = load_spec(formula_file);
+    CUDD::BDD one = spec.var_mgr->cudd_mgr()->bddOne();
+    for (auto _ : state) {
+      Syft::Reachability solver(*spec.product, Syft::Player::Agent, Syft::Player::Agent,
+                                spec.product->final_states(), one);
+      solver.set_realizability_only(true);
+      benchmark::DoNotOptimize(solver.run().realizability);
+    }
+  }
+
+  void BM_SymbolicProductAnd(benchmark::State& state, const std::string& formula_file) {
+    const Spec& spec = load_spec(formula_file);
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(Syft::SymbolicStateDfa::product_AND(spec.components));
+    }
+  }
+
+  void BM_ExplicitProductAnd(benchmark::State& state, const std::string& formula_file) {
+    const Spec& spec = load_spec(formula_file);
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(Syft::ExplicitStateDfa::dfa_product_and(spec.explicit_dfas));
+    }
+  }
+
+  void BM_MinimizeWeak(benchmark::State& state, const std::string& formula_file) {
+    const Spec& spec = load_spec(formula_file);
+    Syft::ExplicitStateDfa product = Syft::ExplicitStateDfa::dfa_product_and(spec.explicit_dfas);
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(Syft::ExplicitStateDfa::dfa_minimize_weak(product));
+    }
+  }
+
+  template <typename Decomposer>
+  void BM_PeelLayer(benchmark::State& state, const std::string& formula_file) {
+    const Spec& spec = load_spec(formula_file);
+    CUDD::BDD states = spec.product->reachable_states();
+    for (auto _ : state) {
+      // A new decomposer per iteration, as its cached relations would otherwise answer all but the first
+      Decomposer decomposer(*spec.product);
+      benchmark::DoNotOptimize(decomposer.PeelLayer(states));
+    }
+  }
+
+  // All layers of the reachable states, as the layered solvers peel them
+  void BM_PeelLayers(benchmark::State& state, const std::string& formula_file, Syft::SCCAlgorithm algorithm) {
+    const Spec& spec = load_spec(formula_file);
+    CUDD::BDD states = spec.product->reachable_states();
+    for (auto _ : state) {
+      std::unique_ptr<Syft::SCCDecomposer> decomposer = Syft::SCCDecomposer::Create(algorithm, *spec.product);
+      benchmark::DoNotOptimize(decomposer->PeelLayers(states));
+    }
+  }
+
+  void BM_ZielonkaTree(benchmark::State& state, const std::string& formula_file) {
+    const Spec& spec = load_spec(formula_file);
+    for (auto _ : state) {
+      ZielonkaTree tree(spec.color_formula, spec.goal_states, spec.var_mgr);
+      benchmark::DoNotOptimize(tree.get_root());
+    }
+  }
+
+  void BM_EmersonLeiCpre(benchmark::State& state, const std::string& formula_file) {
+    const Spec& spec = load_spec(formula_file);
+    CUDD::BDD one = spec.var_mgr->cudd_mgr()->bddOne();
+    CUDD::BDD zero = spec.var_mgr->cudd_mgr()->bddZero();
+    auto tree = std::make_shared<ZielonkaTree>(spec.color_formula, spec.goal_states, spec.var_mgr);
+    Syft::EmersonLei solver(*spec.product, spec.color_formula, Syft::Player::Agent, Syft::Player::Agent,
+                            spec.goal_states, one, zero, zero, false, tree);
+    // Without winning moves, cpre has no side effect on the tree
+    solver.set_realizability_only(true);
+    CUDD::BDD target = spec.product->final_states();
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(solver.cpre(tree->get_root(), 0, target));
+    }
+  }
+
+  // The whole game, by the Zielonka tree and by the colors of each subgame, for comparing the two
+  // on the specs of many colors
+  void BM_EmersonLeiRun(benchmark::State& state, const std::string& formula_file) {
+    const Spec& spec = load_spec(formula_file);
+    CUDD::BDD one = spec.var_mgr->cudd_mgr()->bddOne();
+    CUDD::BDD zero = spec.var_mgr->cudd_mgr()->bddZero();
+    for (auto _ : state) {
+      Syft::EmersonLei solver(*spec.product, spec.color_formula, Syft::Player::Agent, Syft::Player::Agent,
+                              spec.goal_states, one, zero, zero, false);
+      solver.set_realizability_only(true);
+      benchmark::DoNotOptimize(solver.run_EL().realizability);
+    }
+  }
+
+  void BM_SymbolicEmersonLeiRun(benchmark::State& state, const std::string& formula_file) {
+    const Spec& spec = load_spec(formula_file);
+    CUDD::BDD one = spec.var_mgr->cudd_mgr()->bddOne();
+    for (auto _ : state) {
+      Syft::SymbolicEmersonLei solver(*spec.product, Syft::ColorFormula(spec.color_formula), Syft::Player::Agent,
+                                      Syft::Player::Agent, spec.goal_states, one);
+      solver.set_realizability_only(true);
+      benchmark::DoNotOptimize(solver.run().realizability);
+    }
+  }
+
+  void BM_LayeredEmersonLeiRun(benchmark::State& state, const std::string& formula_file) {
+    const Spec& spec = load_spec(formula_file);
+    CUDD::BDD one = spec.var_mgr->cudd_mgr()->bddOne();
+    for (auto _ : state) {
+      Syft::LayeredEmersonLei solver(*spec.product, Syft::ColorFormula(spec.color_formula), Syft::Player::Agent,
+                                     Syft::Player::Agent, spec.goal_states, one);
+      solver.set_realizability_only(true);
+      benchmark::DoNotOptimize(solver.run().realizability);
+    }
+  }
+
+  std::vector<int> benchmark_sizes() {
+    const char* sizes = std::getenv("LYDIASYFT_BENCHMARK_SIZES");
+    std::vector<int> result;
+    for (const std::string& size : Syft::split(sizes ? sizes : "2,4,8", ",")) {
+      if (!Syft::trim(size).empty()) {
+        result.push_back(std::stoi(size));
+      }
+    }
+    return result;
+  }
+
+  // The number at the end of the name of a spec, e.g. 4 for pattern_4.ltlfplus, or -1
+  int spec_size(const std::filesystem::path& formula_file) {
+    std::string stem = formula_file.stem().string();
+    std::size_t digits = stem.find_last_not_of("0123456789") + 1;
+    return digits < stem.size() ? std::stoi(stem.substr(digits)) : -1;
+  }
+
+  void register_kernels(const std::string& family, int size, const std::string& formula_file) {
+    std::string suffix = "/" + family + "/" + std::to_string(size);
+    benchmark::RegisterBenchmark(("preimage" + suffix).c_str(), BM_Preimage, formula_file);
+    benchmark::RegisterBenchmark(("Reachability::run" + suffix).c_str(), BM_ReachabilityRun, formula_file);
+    // These allocate fresh state variables on every iteration, so the manager grows with
+    // the iterations; a fixed count keeps the runs comparable
+    benchmark::RegisterBenchmark(("product_AND" + suffix).c_str(), BM_SymbolicProductAnd, formula_file)
+        ->Iterations(20);
+    benchmark::RegisterBenchmark(("dfa_product_and" + suffix).c_str(), BM_ExplicitProductAnd, formula_file);
+    benchmark::RegisterBenchmark(("dfa_minimize_weak" + suffix).c_str(), BM_MinimizeWeak, formula_file);
+    benchmark::RegisterBenchmark(("ChainSCCDecomposer::PeelLayer" + suffix).c_str(),
+                                 BM_PeelLayer<Syft::ChainSCCDecomposer>, formula_file)->Iterations(20);
+    benchmark::RegisterBenchmark(("NaiveSCCDecomposer::PeelLayer" + suffix).c_str(),
+                                 BM_PeelLayer<Syft::NaiveSCCDecomposer>, formula_file)->Iterations(20);
+    benchmark::RegisterBenchmark(("SkeletonSCCDecomposer::PeelLayer" + suffix).c_str(),
+                                 BM_PeelLayer<Syft::SkeletonSCCDecomposer>, formula_file)->Iterations(20);
+    for (const auto& [name, algorithm] : {std::make_pair("naive", Syft::SCCAlgorithm::Naive),
+                                          std::make_pair("chain", Syft::SCCAlgorithm::Chain),
+                                          std::make_pair("skeleton", Syft::SCCAlgorithm::Skeleton)}) {
+      benchmark::RegisterBenchmark(("SCCDecomposer::PeelLayers/" + std::string(name) + suffix).c_str(),
+                                   BM_PeelLayers, formula_file, algorithm)->Iterations(20);
+    }
+    benchmark::RegisterBenchmark(("ZielonkaTree" + suffix).c_str(), BM_ZielonkaTree, formula_file);
+    benchmark::RegisterBenchmark(("EmersonLei::cpre" + suffix).c_str(), BM_EmersonLeiCpre, formula_file);
+    benchmark::RegisterBenchmark(("EmersonLei::run_EL" + suffix).c_str(), BM_EmersonLeiRun, formula_file);
+    benchmark::RegisterBenchmark(("SymbolicEmersonLei::run" + suffix).c_str(), BM_SymbolicEmersonLeiRun,
+                                 formula_file);
+    benchmark::RegisterBenchmark(("LayeredEmersonLei::run" + suffix).c_str(), BM_LayeredEmersonLeiRun,
+                                 formula_file);
+  }
+
+  void register_families() {
+    std::filesystem::path examples = std::filesystem::path(__ROOT_DIRECTORY) / "examples";
+    std::vector<int> sizes = benchmark_sizes();
+    std::vector<std::filesystem::path> families;
+    for (const auto& entry : std::filesystem::directory_iterator(examples)) {
+      std::string name = entry.path().filename().string();
+      if (entry.is_directory() && (name.rfind("pattern_", 0) == 0 || name == "counter")) {
+        families.push_back(entry.path());
+      }
+    }
+    std::sort(families.begin(), families.end());
+    for (const std::filesystem::path& family : families) {
+      std::map<int, std::string> specs;
+      for (const auto& entry : std::filesystem::directory_iterator(family)) {
+        int size = spec_size(entry.path());
+        if (entry.path().extension() == ".ltlfplus" && std::count(sizes.begin(), sizes.end(), size) > 0 &&
+            std::filesystem::exists(std::filesystem::path(entry.path()).replace_extension(".part"))) {
+          specs[size] = entry.path().string();
+        }
+      }
+      for (const auto& [size, formula_file] : specs) {
+        register_kernels(family.filename().string(), size, formula_file);
+      }
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  register_families();
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
@@ -48,8 +48,8 @@ int main(int argc, char ** argv) {
     if (result.realizability) {
         std::cout << "Specification is realizable!" << std::endl;
         std::cout << "Printing the (maximally permissive) strategy in DOT format..." << std::endl;
-        var_mgr->dump_dot(result.deferring_strategy.Add(), "deferring_strategy.dot");
-        var_mgr->dump_dot(result.nondeferring_strategy.Add(), "nondeferring_strategy.dot");
+        var_mgr->dump_dot(result.deferring_strategy().Add(), "deferring_strategy.dot");
+        var_mgr->dump_dot(result.nondeferring_strategy().Add(), "nondeferring_strategy.dot");
     }
     else {
         std::cout << "Specification is unrealizable!" << std::endl;
@@ -41,9 +41,12 @@ int main(int argc, char ** argv) {
     std::cout << "Solving the DFA game with GR(1) env assumptions..." << std::endl;
     Syft::GR1 gr1 = Syft::GR1::read_from_gr1_file(var_mgr, finding_nemo_1_env_gr1.string());
     var_mgr->partition_variables(args.partition.input_variables, args.partition.output_variables);
-    Syft::GR1LTLfSynthesizer synthesizer(var_mgr, gr1, dfa_env,
-                                         dfa, dfa_agn, path_to_slugs_dir.string(), "problem");
-    Syft::SynthesisResult result = synthesizer.run();
+    // An empty Slugs directory selects the native GR(1) solver
+    Syft::GR1LTLfSynthesizer native_synthesizer(var_mgr, gr1, dfa_env, dfa, dfa_agn, "", "problem");
+    Syft::Stopwatch native_stopwatch;
+    native_stopwatch.start();
+    Syft::SynthesisResult result = native_synthesizer.run();
+    auto native_time = native_stopwatch.stop();
 
     if (result.realizability) {
         std::cout << "Specification is realizable!" << std::endl;
@@ -51,5 +54,19 @@ int main(int argc, char ** argv) {
     else {
         std::cout << "Specification is unrealizable!" << std::endl;
     }
+    std::cout << "Native GR(1) solver: " << native_time.count() << " ms" << std::endl;
+
+    // Compare with the Slugs round trip when the submodule is checked out
+    if (std::filesystem::exists(path_to_slugs_dir / "src" / "slugs")) {
+        Syft::GR1LTLfSynthesizer slugs_synthesizer(var_mgr, gr1, dfa_env,
+                                                   dfa, dfa_agn, path_to_slugs_dir.string(), "problem");
+        Syft::Stopwatch slugs_stopwatch;
+        slugs_stopwatch.start();
+        Syft::SynthesisResult slugs_result = slugs_synthesizer.run();
+        auto slugs_time = slugs_stopwatch.stop();
+        std::cout << "Slugs: " << slugs_time.count() << " ms, "
+                  << (slugs_result.realizability == result.realizability ? "same" : "different")
+                  << " realizability" << std::endl;
+    }
 
 }
\ No newline at end of file
@@ -0,0 +1,185 @@
+#!/usr/bin/env python3
+"""
+End-to-end performance regression check of LydiaSyftEL against stored baselines.
+
+Runs every case of a suite (perf/suite.json) in each of its solver modes, and
+records per run the verdict, the wall time, the peak RSS of the solver process
+and the peak BDD node count reported by --stats. Each measurement is compared
+with the baseline of the same case and mode (perf/baselines.json): a run
+regresses if its verdict differs, or if a measurement exceeds its baseline by
+more than the threshold. Wall times also get an absolute slack, so that runs of
+a few milliseconds do not fail on noise. Cases with an "expected" verdict, such
+as those generated by LydiaSyftGen, also regress when their verdict differs.
+
+Usage:
+    python scripts/perf_regression.py --binary build/bin/LydiaSyftEL
+    python scripts/perf_regression.py --binary build/bin/LydiaSyftEL --mode el --threshold 0.1
+    python scripts/perf_regression.py --binary build/bin/LydiaSyftEL --update   # record baselines
+    build/bin/LydiaSyftGen --sizes 1,2,4,8 --output families
+    python scripts/perf_regression.py --binary build/bin/LydiaSyftEL --cases families/cases.json \
+        --baselines perf/scaling_baselines.json   # scaling curves of the generated families
+
+Exits with 1 if a run regressed, and with 0 otherwise; runs without a
+baseline are reported but do not fail unless --strict is given. --output
+writes the measurements in the format of the baselines.
+"""
+
+import argparse
+import json
+import os
+import platform
+import re
+import subprocess
+import sys
+import threading
+import time
+
+PROJECT_ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+VERDICT_PAT = re.compile(r"LTLf\+ synthesis is (REALIZABLE|UNREALIZABLE|UNKNOWN)")
+PEAK_NODES_PAT = re.compile(r'"peak_nodes": (\d+)')
+METRICS = ("wall_time", "peak_rss_kb", "peak_bdd_nodes")
+
+
+def run_case(binary, case, mode_args, starting_player, timeout):
+    """Runs one case in one mode; returns its measurements."""
+    cmd = [binary,
+           "-i", os.path.join(PROJECT_ROOT, case["formula"]),
+           "-p", os.path.join(PROJECT_ROOT, case["partition"]),
+           "-s", str(case.get("starting_player", starting_player)),
+           "--stats"] + mode_args
+    timed_out = threading.Event()
+
+    def kill():
+        timed_out.set()
+        proc.kill()
+
+    start = time.monotonic()
+    proc = subprocess.Popen(cmd, stdout=subprocess.PIPE, stderr=subprocess.DEVNULL, text=True)
+    timer = threading.Timer(timeout, kill) if timeout else None
+    if timer:
+        timer.start()
+    stdout = proc.stdout.read()
+    # Reaped here rather than by Popen, for the rusage of this child alone;
+    # ru_maxrss is in kilobytes on Linux
+    _, status, rusage = os.wait4(proc.pid, 0)
+    proc.returncode = status
+    wall_time = time.monotonic() - start
+    if timer:
+        timer.cancel()
+    if timed_out.is_set():
+        return {"verdict": "TIMEOUT", "wall_time": round(wall_time, 4)}
+    verdict = VERDICT_PAT.search(stdout)
+    peak_nodes = [int(n) for n in PEAK_NODES_PAT.findall(stdout)]
+    return {
+        "verdict": verdict.group(1) if verdict else "ERROR",
+        "wall_time": round(wall_time, 4),
+        "peak_rss_kb": rusage.ru_maxrss,
+        "peak_bdd_nodes": max(peak_nodes) if peak_nodes else None,
+    }
+
+
+def measure(binary, case, mode_args, starting_player, timeout, repeat):
+    """Best of repeat runs: the minimum of each measurement, the verdict of the first run."""
+    runs = [run_case(binary, case, mode_args, starting_player, timeout) for _ in range(repeat)]
+    result = {"verdict": runs[0]["verdict"]}
+    for metric in METRICS:
+        values = [run[metric] for run in runs if run.get(metric) is not None]
+        result[metric] = min(values) if values else None
+    return result
+
+
+def compare(result, baseline, threshold, time_slack):
+    """Returns the regressions of result against baseline, as messages."""
+    problems = []
+    if result["verdict"] != baseline.get("verdict"):
+        problems.append(f"verdict {result['verdict']} (baseline {baseline.get('verdict')})")
+    for metric in METRICS:
+        value, reference = result.get(metric), baseline.get(metric)
+        if value is None or reference is None:
+            continue
+        limit = reference * (1 + threshold) + (time_slack if metric == "wall_time" else 0)
+        if value > limit:
+            problems.append(f"{metric} {value} > {limit:.4g} (baseline {reference})")
+    return problems
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("--binary", required=True, help="LydiaSyftEL binary")
+    ap.add_argument("--suite", default=os.path.join(PROJECT_ROOT, "perf", "suite.json"))
+    ap.add_argument("--cases", help="run the cases of this file, e.g. from LydiaSyftGen, in the modes of the suite")
+    ap.add_argument("--baselines", default=os.path.join(PROJECT_ROOT, "perf", "baselines.json"))
+    ap.add_argument("--mode", action="append", help="only run these modes (repeatable)")
+    ap.add_argument("--case", help="only run the cases whose id contains this string")
+    ap.add_argument("--threshold", type=float, default=0.25,
+                    help="allowed relative increase of each measurement (default: 0.25)")
+    ap.add_argument("--time-slack", type=float, default=0.05,
+                    help="allowed absolute increase of the wall time, in seconds (default: 0.05)")
+    ap.add_argument("--repeat", type=int, default=1, help="runs per case and mode, the best of which counts")
+    ap.add_argument("--update", action="store_true", help="store the measurements as the new baselines")
+    ap.add_argument("--strict", action="store_true", help="fail on runs without a baseline")
+    ap.add_argument("--output", help="write the measurements to this file")
+    args = ap.parse_args()
+
+    with open(args.suite, "r", encoding="utf-8") as fh:
+        suite = json.load(fh)
+    if args.cases:
+        with open(args.cases, "r", encoding="utf-8") as fh:
+            suite["cases"] = json.load(fh)["cases"]
+    baselines = {"machine": None, "results": {}}
+    if os.path.exists(args.baselines):
+        with open(args.baselines, "r", encoding="utf-8") as fh:
+            baselines = json.load(fh)
+
+    results = {}
+    regressions = missing = 0
+    for case in suite["cases"]:
+        if args.case and args.case not in case["id"]:
+            continue
+        for mode in case["modes"]:
+            if args.mode and mode not in args.mode:
+                continue
+            key = f"{case['id']}:{mode}"
+            result = measure(args.binary, case, suite["modes"][mode], suite.get("starting_player", 0),
+                             suite.get("timeout"), args.repeat)
+            results[key] = result
+            baseline = baselines["results"].get(key)
+            problems = []
+            expected = case.get("expected")
+            if expected and result["verdict"] not in (expected, "TIMEOUT"):
+                problems.append(f"verdict {result['verdict']} (expected {expected})")
+            if baseline is None and not problems:
+                missing += 1
+                status = "NO BASELINE"
+            else:
+                if baseline is not None:
+                    problems += compare(result, baseline, args.threshold, args.time_slack)
+                regressions += bool(problems)
+                status = "REGRESSED: " + "; ".join(problems) if problems else "ok"
+            print(f"{key:<70} {result['verdict']:<12} {result['wall_time']:>9.3f}s "
+                  f"{result['peak_rss_kb'] or '-':>9} KB {result['peak_bdd_nodes'] or '-':>10} nodes  {status}",
+                  flush=True)
+
+    measurements = {"machine": platform.node() + " " + platform.machine(), "results": results}
+    if args.output:
+        with open(args.output, "w", encoding="utf-8") as fh:
+            json.dump(measurements, fh, indent=2, sort_keys=True)
+            fh.write("\n")
+    if args.update:
+        # Keeps the baselines of the cases and modes that were not run
+        baselines["machine"] = measurements["machine"]
+        baselines["results"].update(results)
+        with open(args.baselines, "w", encoding="utf-8") as fh:
+            json.dump(baselines, fh, indent=2, sort_keys=True)
+            fh.write("\n")
+        print(f"\n{len(results)} baselines written to {args.baselines}")
+        return 0
+
+    print(f"\n{len(results)} runs, {regressions} regressed, {missing} without a baseline")
+    if regressions or (args.strict and missing):
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
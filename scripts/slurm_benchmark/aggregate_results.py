@@ -2,9 +2,14 @@
 """
 Aggregate per-run JSON files produced by the Slurm benchmark into a single
 JSON file and print a short summary.
+
+Runs are summarized from the "result" the binary wrote with --json-result
+(see job_runner.py); runs without one (timeouts, crashes, older binaries)
+count as having no verdict.
 """
 import argparse
 import json
+from collections import Counter
 from pathlib import Path
 import os
 import time
@@ -28,6 +33,11 @@ def aggregate(results_dir, out_file):
 
     Path(out_file).write_text(json.dumps(out, indent=2))
     print(f'Wrote aggregated results: {out_file} ({len(files)} run files)')
+    for k, runs in sorted(data.items()):
+        verdicts = Counter((run.get('result') or {}).get('verdict') or 'NO RESULT' for run in runs)
+        times = [run['result']['wall_time'] for run in runs if (run.get('result') or {}).get('wall_time') is not None]
+        best = f', best wall time {min(times):.3f} s' if times else ''
+        print(f'  {k}: ' + ', '.join(f'{n} {v}' for v, n in sorted(verdicts.items())) + best)
 
 
 def main():
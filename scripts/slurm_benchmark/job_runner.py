@@ -5,7 +5,9 @@ Run a single benchmark run (intended to be invoked by a Slurm job).
 This script executes the target binary (optionally inside a Singularity image),
 enforces a timeout, measures elapsed time and peak memory (RSS) using resource
 usage, captures stdout/stderr, and writes a JSON result file to the given
-output directory.
+output directory. The verdict, phase times and sizes the binary writes with
+--json-result are included under "result", so that they need not be scraped
+from stdout.
 
 It is designed to be robust inside Slurm jobs and to produce one JSON file per
 run (no shared locking required).
@@ -28,7 +30,8 @@ import sys
 from typing import Any
 
 
-def run_once(binary, binary_args, singularity, formula_file, partition_file, timeout_s, extra_env=None):
+def run_once(binary, binary_args, singularity, formula_file, partition_file, timeout_s, extra_env=None,
+             json_result_file=None):
     # Build command list
     cmd = []
     if singularity:
@@ -46,6 +49,8 @@ def run_once(binary, binary_args, singularity, formula_file, partition_file, tim
         cmd.extend(['-i', formula_file])
     if partition_file:
         cmd.extend(['-p', partition_file])
+    if json_result_file:
+        cmd.extend(['--json-result', json_result_file])
 
     # Prepare environment
     env = os.environ.copy()
@@ -106,6 +111,8 @@ def main():
     parser.add_argument('--run-idx', type=int, required=True, help='Run index (1..N)')
     parser.add_argument('--out-dir', required=True, help='Directory where per-run JSON result will be written')
     parser.add_argument('--timeout', type=int, default=60, help='Timeout in seconds for this run')
+    parser.add_argument('--no-json-result', action='store_true',
+                        help='Do not pass --json-result to the binary (for binaries without the option)')
 
     args = parser.parse_args()
 
@@ -241,11 +248,20 @@ def main():
         # best-effort; continue even if we can't write the started file
         pass
 
-    # Run
-    result = run_once(args.binary, args.binary_args, args.singularity or None, args.formula, args.partition, args.timeout)
+    # Run; the JSON result sits next to the report, in a directory the container can write
+    json_result_file = None if args.no_json_result else out_file + '.result'
+    result = run_once(args.binary, args.binary_args, args.singularity or None, args.formula, args.partition, args.timeout,
+                      json_result_file=json_result_file)
 
     # Augment result with metadata
     report = {**metadata, **result}
+    if json_result_file and os.path.exists(json_result_file):
+        try:
+            with open(json_result_file) as f:
+                report['result'] = json.load(f)
+        except ValueError:
+            report['result'] = None
+        os.remove(json_result_file)
 
     # Truncate very large outputs to keep JSON sane
     MAX_LOG = 200_000
@@ -37,7 +37,7 @@ def find_examples(examples_dir, prefix='pattern'):
     return files
 
 
-def write_job_script(out_dir, pattern_file, partition_file, binary, singularity, binary_args, timeout, runs, sbatch_opts, mode, single_node=False):
+def write_job_script(out_dir, pattern_file, partition_file, binary, singularity, binary_args, timeout, runs, sbatch_opts, mode, single_node=False, checkpoint_dir=None):
     # Create a job script under out_dir/jobs
     job_name = pattern_file.stem
     jobs_dir = out_dir / 'jobs'
@@ -72,6 +72,9 @@ def write_job_script(out_dir, pattern_file, partition_file, binary, singularity,
         else:
             # request a single node/task for sequential runs
             out.write(f"#SBATCH --nodes=1\n")
+        if checkpoint_dir:
+            # Preempted tasks are requeued and resume from their checkpoint
+            out.write("#SBATCH --requeue\n")
         out.write('\n')
 
         # Export environment variables that template expects
@@ -125,6 +128,8 @@ def write_job_script(out_dir, pattern_file, partition_file, binary, singularity,
         out.write(f"export MODE=\"{mode}\"\n")
         out.write(f"OUT_DIR=\"{out_dir / 'results'}\"\n")
         out.write(f"TIMEOUT=\"{timeout}\"\n")   
+        if checkpoint_dir:
+            out.write(f"CHECKPOINT_DIR=\"{checkpoint_dir}\"\n")
         if not single_node:
             out.write(f"RUN_IDX=\"${{SLURM_ARRAY_TASK_ID}}\"\n")
 
@@ -248,6 +253,9 @@ def main():
                         help='Initial delay in seconds before retrying sbatch submission (default: 5.0)')
     parser.add_argument('--sbatch-retry-backoff', type=float, default=2.0,
                         help='Multiplicative backoff applied to the retry delay (default: 2.0)')
+    parser.add_argument('--checkpoint-dir', default='',
+                        help='Directory of the checkpoints of the runs, which are requeued and resumed when preempted '
+                             '(EL and MP solvers; not with --single-job)')
     parser.add_argument('--single-node', action='store_true', help='Run all runs for a pattern sequentially in a single Slurm job (no array)')
     parser.add_argument('--single-job', action='store_true', help='Run all patterns and modes sequentially in one Slurm job on a single node')
     parser.add_argument('--max-examples', type=int, default=None, help='Limit to first N examples')
@@ -502,6 +510,7 @@ def main():
                     sbatch_opts,
                     mode,
                     single_node=args.single_node,
+                    checkpoint_dir=str(Path(args.checkpoint_dir).resolve()) if args.checkpoint_dir else None,
                 )
                 jobid = submit_script(
                     job_script,
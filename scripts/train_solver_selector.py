@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+"""
+Trains the decision tree of `LydiaSyftEL --solver auto` from benchmark results.
+
+Reads the measurements written by `scripts/perf_regression.py --output` (one
+or more files, e.g. of the perf suite and of the LydiaSyftGen families), and
+labels each case with its fastest mode among those that reached a verdict.
+The features of each case are those printed by `LydiaSyftEL --print-features`,
+which only parses the spec and builds its DFAs. A CART tree (Gini impurity,
+thresholds halfway between observed values) is grown on them and written in
+the line format read by SolverSelector, by default to perf/solver_model.jsonl;
+copy that file into the builtin model of src/synthesis/source/SolverSelector.cpp
+to make it the default, or pass it to --solver-model.
+
+Usage:
+    python scripts/perf_regression.py --binary build/bin/LydiaSyftEL --output results.json
+    python scripts/train_solver_selector.py --binary build/bin/LydiaSyftEL results.json
+    python scripts/train_solver_selector.py --binary build/bin/LydiaSyftEL results.json \
+        --cases families/cases.json families.json --max-depth 4
+"""
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+from collections import Counter
+
+PROJECT_ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+VERDICTS = ("REALIZABLE", "UNREALIZABLE")
+
+
+def spec_features(binary, case, starting_player, timeout):
+    """Returns the numeric features of a case, or None if they could not be computed."""
+    cmd = [binary,
+           "-i", os.path.join(PROJECT_ROOT, case["formula"]),
+           "-p", os.path.join(PROJECT_ROOT, case["partition"]),
+           "-s", str(case.get("starting_player", starting_player)),
+           "-g", "0", "--obligation-simplification", "0", "--print-features"]
+    try:
+        proc = subprocess.run(cmd, capture_output=True, text=True, timeout=timeout)
+    except subprocess.TimeoutExpired:
+        return None
+    for line in reversed(proc.stdout.splitlines()):
+        if line.startswith("{"):
+            features = json.loads(line)
+            return {name: value for name, value in features.items() if isinstance(value, (int, float))}
+    return None
+
+
+def fastest_modes(measurements):
+    """Returns the fastest mode with a verdict of each case id."""
+    best = {}
+    for key, result in measurements.items():
+        case_id, mode = key.rsplit(":", 1)
+        if result.get("verdict") not in VERDICTS or result.get("wall_time") is None:
+            continue
+        if case_id not in best or result["wall_time"] < best[case_id][1]:
+            best[case_id] = (mode, result["wall_time"])
+    return {case_id: mode for case_id, (mode, _) in best.items()}
+
+
+def gini(labels):
+    counts = Counter(labels)
+    return 1.0 - sum((n / len(labels)) ** 2 for n in counts.values())
+
+
+def best_split(samples, features):
+    """Returns the (feature, threshold) of least weighted Gini impurity, or None if no split helps."""
+    labels = [label for _, label in samples]
+    best, best_impurity = None, gini(labels)
+    for feature in features:
+        values = sorted({x[feature] for x, _ in samples})
+        for low, high in zip(values, values[1:]):
+            threshold = (low + high) / 2
+            below = [label for x, label in samples if x[feature] <= threshold]
+            above = [label for x, label in samples if x[feature] > threshold]
+            impurity = (len(below) * gini(below) + len(above) * gini(above)) / len(samples)
+            if impurity < best_impurity - 1e-12:
+                best, best_impurity = (feature, threshold), impurity
+    return best
+
+
+def grow(samples, features, depth, max_depth, min_samples, nodes):
+    """Appends the subtree of samples to nodes, root first; returns the index of its root."""
+    index = len(nodes)
+    nodes.append(None)
+    labels = [label for _, label in samples]
+    split = None
+    if depth < max_depth and len(samples) >= min_samples and len(set(labels)) > 1:
+        split = best_split(samples, features)
+    if split is None:
+        # Ties go to the first mode in name order, so that retraining is deterministic
+        counts = Counter(labels)
+        nodes[index] = {"node": index, "solver": min(counts, key=lambda mode: (-counts[mode], mode))}
+        return index
+    feature, threshold = split
+    below = grow([s for s in samples if s[0][feature] <= threshold], features, depth + 1, max_depth,
+                 min_samples, nodes)
+    above = grow([s for s in samples if s[0][feature] > threshold], features, depth + 1, max_depth,
+                 min_samples, nodes)
+    nodes[index] = {"node": index, "feature": feature, "threshold": threshold, "below": below, "above": above}
+    return index
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("results", nargs="+", help="measurements written by perf_regression.py --output")
+    ap.add_argument("--binary", required=True, help="LydiaSyftEL binary")
+    ap.add_argument("--suite", default=os.path.join(PROJECT_ROOT, "perf", "suite.json"))
+    ap.add_argument("--cases", action="append", default=[],
+                    help="also read the cases of this file, e.g. from LydiaSyftGen (repeatable)")
+    ap.add_argument("--output", default=os.path.join(PROJECT_ROOT, "perf", "solver_model.jsonl"))
+    ap.add_argument("--max-depth", type=int, default=3, help="depth of the tree (default: 3)")
+    ap.add_argument("--min-samples", type=int, default=2, help="least cases of a split node (default: 2)")
+    ap.add_argument("--timeout", type=float, default=120, help="seconds per feature extraction (default: 120)")
+    args = ap.parse_args()
+
+    with open(args.suite, "r", encoding="utf-8") as fh:
+        suite = json.load(fh)
+    cases = {case["id"]: case for case in suite["cases"]}
+    for path in args.cases:
+        with open(path, "r", encoding="utf-8") as fh:
+            cases.update({case["id"]: case for case in json.load(fh)["cases"]})
+    measurements = {}
+    for path in args.results:
+        with open(path, "r", encoding="utf-8") as fh:
+            measurements.update(json.load(fh)["results"])
+
+    samples = []
+    for case_id, mode in sorted(fastest_modes(measurements).items()):
+        if case_id not in cases:
+            print(f"{case_id}: not in the suite or --cases, skipped", file=sys.stderr)
+            continue
+        features = spec_features(args.binary, cases[case_id], suite.get("starting_player", 0), args.timeout)
+        if features is None:
+            print(f"{case_id}: no features, skipped", file=sys.stderr)
+            continue
+        samples.append((features, mode))
+        print(f"{case_id:<70} {mode}")
+    if not samples:
+        print("Error: no case has both a verdict and features", file=sys.stderr)
+        return 1
+
+    features = sorted(set.intersection(*(set(x) for x, _ in samples)))
+    nodes = []
+    grow(samples, features, 0, args.max_depth, args.min_samples, nodes)
+    with open(args.output, "w", encoding="utf-8") as fh:
+        for node in nodes:
+            fh.write(json.dumps(node) + "\n")
+    print(f"\n{len(nodes)} nodes trained on {len(samples)} cases written to {args.output}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
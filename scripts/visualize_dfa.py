@@ -6,7 +6,7 @@ Usage:
     ./bin/LydiaSyftEL ... 2>&1 | python scripts/visualize_dfa.py > dfa.dot
     dot -Tpng dfa.dot -o dfa.png
     
-    # Or with JSON input:
+    # Or with JSON input (from dump_json or dump_json_cubes):
     python scripts/visualize_dfa.py dfa.json -o dfa.png
 """
 
@@ -23,12 +23,56 @@ except ImportError:
 
 
 
+def expand_cube(cube):
+    """Expand a cube string over '0', '1' and '-' into the bit lists it covers."""
+    free = [i for i, c in enumerate(cube) if c == '-']
+    for assignment in range(1 << len(free)):
+        bits = [1 if c == '1' else 0 for c in cube]
+        for j, i in enumerate(free):
+            bits[i] = (assignment >> j) & 1
+        yield bits
+
+
+def bits_to_int(bits):
+    """Convert a list of bits to integer (LSB first)."""
+    result = 0
+    for i, bit in enumerate(bits):
+        result |= bit << i
+    return result
+
+
+def expand_cube_format(data):
+    """Convert the cube format of SymbolicStateDfa::dump_json_cubes to minterms."""
+    num_state_bits = data['num_state_bits']
+    num_inputs = data['num_inputs']
+
+    def split(bits):
+        return (bits_to_int(bits[:num_state_bits]),
+                bits_to_int(bits[num_state_bits:num_state_bits + num_inputs]),
+                bits_to_int(bits[num_state_bits + num_inputs:]))
+
+    accepting = set()
+    for cube in data.get('accepting_cubes', []):
+        for bits in expand_cube(cube[:num_state_bits]):
+            accepting.add(''.join(str(b) for b in bits))
+    data['accepting_minterms'] = sorted(accepting)
+
+    data['trans_funcs'] = {
+        bit: [split(bits) for cube in cubes for bits in expand_cube(cube)]
+        for bit, cubes in data.get('trans_cubes', {}).items()
+    }
+    return data
+
+
 def parse_json_dfa(json_data):
     """Parse DFA from JSON format."""
     if isinstance(json_data, str):
         data = json.loads(json_data)
     else:
         data = json_data
+
+    if data.get('format') == 'cubes':
+        data = expand_cube_format(data)
     
     dfa = {
         'num_state_bits': data['num_state_bits'],
@@ -6,6 +6,12 @@ of states and how they are classified across layers.
 Usage:
     python scripts/visualize_solver_trace.py --dot out.dot trace.txt
     cat trace.txt | python scripts/visualize_solver_trace.py --dot out.dot
+    python scripts/visualize_solver_trace.py --telemetry fixpoints.jsonl
+
+With --telemetry, the input is the file written by LydiaSyftEL
+--fixpoint-telemetry (JSONL or CSV) instead of debug output, and one line is
+printed per fixpoint: its solver and node, its number of iterations, the
+largest and final approximation sizes and its total time.
 
 Outputs:
     - Prints a per-layer summary of sets: layer, avoid_bad, accepting_winners,
@@ -15,6 +21,8 @@ Outputs:
 """
 
 import argparse
+import csv
+import json
 import sys
 import re
 from collections import defaultdict
@@ -82,10 +90,41 @@ def emit_dot(transitions, good_after, bad_after, outfile):
         f.write("}\n")
 
 
+def parse_telemetry(lines):
+    """Groups telemetry records into fixpoints, in order of their first iteration."""
+    text = [line for line in lines if line.strip()]
+    if text and not text[0].lstrip().startswith("{"):
+        records = list(csv.DictReader(text))
+    else:
+        records = [json.loads(line) for line in text]
+    fixpoints = {}
+    for record in records:
+        iteration = int(record["iteration"])
+        # A fixpoint starts again at iteration 1, e.g. when a Zielonka node is solved for another term
+        key = (record["pid"], record["solver"], record["node"])
+        if iteration == 1 or key not in fixpoints:
+            fixpoints.setdefault(key, []).append([])
+        fixpoints[key][-1].append(record)
+    return [(key, runs) for key, all_runs in fixpoints.items() for runs in all_runs]
+
+
+def print_telemetry(fixpoints):
+    print(f"{'pid':>8} {'solver':<18} {'node':<12} {'iters':>6} {'max nodes':>10} "
+          f"{'final nodes':>11} {'final states':>13} {'ms':>10}")
+    for (pid, solver, node), records in fixpoints:
+        nodes = [float(r["approximation_nodes"]) for r in records]
+        last = records[-1]
+        print(f"{pid:>8} {solver:<18} {node:<12} {len(records):>6} {max(nodes):>10.0f} "
+              f"{nodes[-1]:>11.0f} {float(last['approximation_states'] or 'nan'):>13.0f} "
+              f"{float(last['elapsed_ms']):>10.2f}")
+
+
 def main():
     ap = argparse.ArgumentParser()
     ap.add_argument("trace", nargs="?", help="trace file (default: stdin)")
     ap.add_argument("--dot", help="write DOT graph to file")
+    ap.add_argument("--telemetry", action="store_true",
+                    help="summarize a --fixpoint-telemetry file instead of debug output")
     args = ap.parse_args()
 
     if args.trace:
@@ -94,6 +133,10 @@ def main():
     else:
         lines = sys.stdin.readlines()
 
+    if args.telemetry:
+        print_telemetry(parse_telemetry(lines))
+        return
+
     layers, transitions, good_after, bad_after = parse_trace(lines)
 
     print("=== Layer summaries ===")
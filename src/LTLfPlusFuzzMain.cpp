@@ -0,0 +1,123 @@
+#include <cstddef>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "DifferentialFuzzer.h"
+#include <CLI/CLI.hpp>
+#include <spdlog/spdlog.h>
+
+int main(int argc, char** argv) {
+
+    CLI::App app {
+        "LydiaSyft-Fuzz: A differential fuzzer of the LTLf+ synthesis configurations"
+    };
+
+    unsigned int seed = 0;
+    std::size_t instances = 100, atoms = 4, ltlf_depth = 3, boolean_depth = 2, repeats = 3;
+    bool obligation_only = false, fail_on_mismatch = false;
+    int starting_player_id = 1;
+    std::string configuration_list = "emerson-lei,manna-pnueli";
+    double timeout = 10, differential = 2.0, min_seconds = 0.05;
+    std::string corpus_directory = "fuzz_corpus";
+
+    app.add_option("--seed", seed, "Seed of the random specs (default: 0)");
+    app.add_option("-n,--instances", instances, "Number of random specs; 0 runs until interrupted (default: 100)");
+    app.add_option("--atoms", atoms, "Number of atoms of the specs, split into inputs and outputs (default: 4)")->
+        check(CLI::PositiveNumber);
+    app.add_option("--ltlf-depth", ltlf_depth, "Depth of the quantified LTLf formulas (default: 3)");
+    app.add_option("--boolean-depth", boolean_depth,
+        "Depth of the Boolean combination of quantified formulas (default: 2)");
+    app.add_flag("--obligation-only", obligation_only,
+        "Only generate specs in the obligation fragment, which every configuration takes");
+    std::ostringstream configuration_help;
+    configuration_help << "Comma-separated configurations to compare, among:";
+    for (const std::string& name : Syft::fuzz_configuration_names()) {
+        configuration_help << " " << name;
+    }
+    configuration_help << " (default: " << configuration_list << ")";
+    app.add_option("-c,--configs", configuration_list, configuration_help.str());
+    app.add_option("-s,--starting-player", starting_player_id, "Starting player:\nagent=1;\nenvironment=0.")->
+        check(CLI::Range(0, 1));
+    app.add_option("-t,--timeout", timeout, "Time limit of every run in seconds (default: 10)")->
+        check(CLI::PositiveNumber);
+    app.add_option("--differential", differential,
+        "Ratio of the slowest to the fastest configuration that makes a performance cliff (default: 2)")->
+        check(CLI::Range(1.0, 1e9));
+    app.add_option("--min-seconds", min_seconds,
+        "Cliffs whose slowest configuration is faster than this are ignored (default: 0.05)");
+    app.add_option("--repeats", repeats, "Runs of each configuration confirming a suspected cliff (default: 3)")->
+        check(CLI::PositiveNumber);
+    app.add_option("--corpus", corpus_directory,
+        "Directory of the mismatches and cliffs found, replayable by LydiaSyftEL --batch (default: fuzz_corpus)");
+    app.add_flag("--fail-on-mismatch", fail_on_mismatch, "Stop with exit code 1 at the first verdict mismatch");
+
+    CLI11_PARSE(app, argc, argv);
+
+    std::vector<std::string> names;
+    std::stringstream configuration_stream(configuration_list);
+    for (std::string name; std::getline(configuration_stream, name, ',');) {
+        if (!name.empty()) {
+            names.push_back(name);
+        }
+    }
+
+    Syft::FuzzOptions options;
+    options.time_limit = timeout;
+    options.differential = differential;
+    options.min_seconds = min_seconds;
+    options.repeats = repeats;
+    options.corpus_directory = corpus_directory;
+
+    try {
+        Syft::DifferentialFuzzer fuzzer(Syft::fuzz_configurations(names), options);
+        Syft::RandomSpecGenerator generator(seed, atoms);
+        Syft::Player starting_player = starting_player_id ? Syft::Player::Agent : Syft::Player::Environment;
+        std::size_t mismatches = 0, cliffs = 0;
+
+        for (std::size_t instance = 0; instances == 0 || instance < instances; ++instance) {
+            std::string formula = generator.ltlf_plus(boolean_depth, ltlf_depth, obligation_only);
+            std::string id = std::to_string(seed) + "_" + std::to_string(instance);
+            Syft::FuzzSpec spec;
+            try {
+                spec = Syft::DifferentialFuzzer::parse(formula, generator.partition(), starting_player);
+            } catch (const std::exception& e) {
+                spdlog::warn("[LydiaSyftFuzz] {}: cannot parse {}: {}", id, formula, e.what());
+                continue;
+            }
+            Syft::FuzzOutcome outcome = fuzzer.run(spec, id);
+
+            std::cout << id;
+            for (std::size_t i = 0; i < fuzzer.configurations().size(); ++i) {
+                if (!outcome.applicable[i]) {
+                    continue;
+                }
+                const std::optional<bool>& verdict = outcome.verdicts[i];
+                std::cout << " " << fuzzer.configurations()[i].name << "="
+                          << (!verdict ? "timeout" : *verdict ? "realizable" : "unrealizable")
+                          << "(" << outcome.seconds[i] << "s)";
+            }
+            if (outcome.mismatch) {
+                std::cout << " MISMATCH";
+            }
+            if (outcome.cliff) {
+                std::cout << " CLIFF(" << outcome.differential << "x)";
+            }
+            std::cout << std::endl;
+
+            mismatches += outcome.mismatch ? 1 : 0;
+            cliffs += outcome.cliff ? 1 : 0;
+            if (outcome.mismatch && fail_on_mismatch) {
+                std::cerr << "Error: verdict mismatch on " << formula << std::endl;
+                return 1;
+            }
+        }
+        std::cout << "Mismatches: " << mismatches << ", performance cliffs: " << cliffs << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
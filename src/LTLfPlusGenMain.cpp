@@ -0,0 +1,126 @@
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "BenchmarkFamilies.h"
+#include "FlatJson.h"
+#include <CLI/CLI.hpp>
+
+namespace {
+    std::vector<std::string> split_list(const std::string& list) {
+        std::vector<std::string> items;
+        std::stringstream stream(list);
+        for (std::string item; std::getline(stream, item, ',');) {
+            if (!item.empty()) {
+                items.push_back(item);
+            }
+        }
+        return items;
+    }
+
+    std::string json_list(const std::vector<std::string>& items) {
+        std::string list = "[";
+        for (std::size_t i = 0; i < items.size(); ++i) {
+            list += (i == 0 ? "" : ", ") + Syft::json_quote(items[i]);
+        }
+        return list + "]";
+    }
+}
+
+int main(int argc, char** argv) {
+
+    CLI::App app {
+        "LydiaSyft-Gen: A generator of parametric LTLf+ benchmark families with known verdicts"
+    };
+
+    std::string family_list, size_list = "1,2,3,4", output_directory = "benchmark_families", cases_file;
+    std::string mode_list = "el,mp,mp-adv,parity";
+    std::string obligation_mode_list = "obligation-cl,obligation-pm,obligation-wg,obligation-cb";
+    bool list = false;
+
+    std::ostringstream family_help;
+    family_help << "Comma-separated families to generate, among:";
+    for (const Syft::BenchmarkFamily& family : Syft::benchmark_families()) {
+        family_help << " " << family.name;
+    }
+    family_help << " (default: all)";
+    app.add_option("-f,--families", family_list, family_help.str());
+    app.add_option("-n,--sizes", size_list, "Comma-separated sizes n of every family (default: 1,2,3,4)");
+    app.add_option("-o,--output", output_directory,
+        "Directory of the <family>/<family>_<n>.ltlfplus and .part files (default: benchmark_families)");
+    app.add_option("--cases", cases_file,
+        "Cases file of scripts/perf_regression.py --cases, with the expected verdicts (default: <output>/cases.json)");
+    app.add_option("--modes", mode_list, "Comma-separated modes of perf/suite.json of every case");
+    app.add_option("--obligation-modes", obligation_mode_list,
+        "Comma-separated modes of perf/suite.json also run on the cases in the obligation fragment");
+    app.add_flag("--list", list, "Print the families and exit");
+
+    CLI11_PARSE(app, argc, argv);
+
+    if (list) {
+        for (const Syft::BenchmarkFamily& family : Syft::benchmark_families()) {
+            std::cout << family.name << ": " << family.description << std::endl;
+        }
+        return 0;
+    }
+
+    try {
+        std::vector<const Syft::BenchmarkFamily*> families;
+        if (family_list.empty()) {
+            for (const Syft::BenchmarkFamily& family : Syft::benchmark_families()) {
+                families.push_back(&family);
+            }
+        } else {
+            for (const std::string& name : split_list(family_list)) {
+                families.push_back(&Syft::benchmark_family(name));
+            }
+        }
+        std::vector<std::size_t> sizes;
+        for (const std::string& size : split_list(size_list)) {
+            sizes.push_back(std::stoul(size));
+        }
+        std::vector<std::string> modes = split_list(mode_list);
+        std::vector<std::string> obligation_modes = modes;
+        for (const std::string& mode : split_list(obligation_mode_list)) {
+            obligation_modes.push_back(mode);
+        }
+
+        if (cases_file.empty()) {
+            cases_file = (std::filesystem::path(output_directory) / "cases.json").string();
+        }
+        std::filesystem::create_directories(output_directory);
+        std::ofstream cases(cases_file);
+        cases << "{\n  \"cases\": [";
+        bool first = true;
+        for (const Syft::BenchmarkFamily* family : families) {
+            for (std::size_t size : sizes) {
+                Syft::BenchmarkInstance instance = family->generate(size);
+                std::filesystem::path formula = std::filesystem::absolute(
+                    Syft::write_instance(instance, output_directory));
+                std::filesystem::path partition = formula;
+                partition.replace_extension(".part");
+                cases << (first ? "\n" : ",\n") << "    {\"id\": " << Syft::json_quote(instance.id())
+                      << ", \"formula\": " << Syft::json_quote(formula.string())
+                      << ", \"partition\": " << Syft::json_quote(partition.string())
+                      << ", \"expected\": " << Syft::json_quote(instance.realizable ? "REALIZABLE" : "UNREALIZABLE")
+                      << ", \"modes\": " << json_list(instance.obligation ? obligation_modes : modes) << "}";
+                first = false;
+                std::cout << "Generated: " << formula.string() << std::endl;
+            }
+        }
+        cases << "\n  ]\n}\n";
+        if (!cases) {
+            std::cerr << "Error: Cannot write " << cases_file << std::endl;
+            return 1;
+        }
+        std::cout << "Cases: " << cases_file << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -1,15 +1,39 @@
+#include <cstdio>
+#include <fstream>
+#include <map>
 #include <memory>
+#include <optional>
+#include <sstream>
+#include <tuple>
 
+#include <unistd.h>
+
+#include "BatchRunner.h"
+#include "SynthesisDaemon.h"
+#include "SynthesisReport.h"
+#include "Trace.h"
+
+#include "automata/PrecompiledAutomata.h"
+#include "game/CompiledTransducer.h"
+#include "game/DagWorkQueue.h"
+#include "game/FixpointTelemetry.h"
+#include "game/TransducerCodegen.h"
 #include "game/InputOutputPartition.h"
+#include "InterfaceLayout.h"
+#include "ResultCache.h"
+#include "SolverSelector.h"
 #include "Utils.h"
+#include "formula_file.h"
 #include <lydia/logic/ltlfplus/base.hpp>
 #include <lydia/logic/ltlfplus/duality.hpp>
 #include <lydia/parser/ltlfplus/driver.hpp>
 #include <lydia/logic/pnf.hpp>
+#include "synthesizer/LTLfPlusSession.h"
 #include "synthesizer/LTLfPlusSynthesizer.h"
 #include "synthesizer/LTLfPlusSynthesizerMP.h"
 #include "synthesizer/ObligationLTLfPlusSynthesizer.h"
 #include "ObligationFragmentDetector.h"
+#include "Portfolio.h"
 
 
 #include <CLI/CLI.hpp>
@@ -18,6 +42,7 @@
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <ctime>
 #include <chrono>
+#include <thread>
 
 int main(int argc, char** argv) {
 
@@ -37,32 +62,108 @@ int main(int argc, char** argv) {
     std::string ltlf_plus_file, partition_file;
     int starting_player_id, game_solver;
     bool verbose = false;
-    bool DEBUG_MODE = false;
+    bool debug = false;
     bool STRATEGY = false;
     bool obligation_simplification = false;
     bool disable_minimisation = false;
     bool legacy_boolean_product = false;
     int minimisation_threshold = 128;
     int symbolic_threshold = 128;
+    std::size_t explicit_game_states = Syft::ExplicitGameSolver::default_max_states;
+    bool fixed_product_thresholds = false;
+    bool mona_products = false;
+    bool minimize_arena = false;
+    bool no_pure_obligation_games = false;
+    bool no_merge_sinks = false;
+    bool no_compact_arena = false;
+    bool symmetry_reduction = false;
+    bool abstraction_refinement = false;
+    std::size_t abstraction_visible_bits = Syft::AbstractionRefinementOptions().max_visible_bits;
+    Syft::ProductMinimisationPolicy product_policy;
     std::string buechi_mode_str = "wg"; // default to weak-game (SCC) solver
+    std::string reorder_mode_str = "off";
+    std::string bdd_backend_str = "cudd";
+    std::string reorder_method_str = "sift";
+    std::string proposition_order_str = "partition";
+    std::string strategy_minimization_str = "off";
+    std::string care_simplification_str = "off";
+    std::string el_child_order_str = "construction";
+    std::string state_encoding_str = "binary";
+    std::string dfa_backend_str = "auto";
+    std::string product_order_str = "overlap";
+    long long dfa_race_ms = 2000;
+    std::string scc_algorithm_str = "naive";
+    std::string chain_pivot_str = "last-layer";
+    std::size_t chain_pivots_per_round = 1;
+    std::size_t layer_threads = 1;
+    Syft::VarMgrOptions var_mgr_options;
+    std::size_t cudd_max_memory_mb = 0;
+    bool print_stats = false;
+    std::string trace_file;
+    std::string fixpoint_telemetry_file;
+    std::string json_result_file;
+    bool frontier_fixpoints = false;
+    bool portfolio = false;
+    bool realizability_only = false;
+    bool no_one_step_colors = false;
+    bool both_orders = false;
+    std::string solver_str;
+    std::string solver_model_file;
+    bool print_features = false;
+    std::string resume_directory;
+    std::string automata_manifest;
+    bool watch = false;
+    double time_limit_s = 0;
+    long max_live_nodes = 0;
+    std::size_t max_rss_mb = 0;
+    Syft::DfaConstructionOptions dfa_options;
+    std::string mp_worker_directory;
+    std::string export_c_file;
+    std::string export_verilog_file;
+    std::string save_strategy_file;
+    std::string batch_manifest;
+    std::size_t batch_workers = 1;
+    std::string daemon_address;
+    std::string result_cache_directory;
+    bool result_cache_validate = false;
     auto console = spdlog::stdout_color_mt("console");
     spdlog::set_default_logger(console);
     spdlog::set_level(spdlog::level::debug); // or debug, trace, etc.
     spdlog::set_pattern("[%H:%M:%S.%e] [%^%l%$] %v");
 
     // CLI::Option* ltlf_plus_file_opt;
-    app.add_option("-i,--input-file", ltlf_plus_file, "Path to LTLf+ formula file")->
-            required() -> check(CLI::ExistingFile);
+    CLI::Option* ltlf_plus_file_opt = app.add_option("-i,--input-file", ltlf_plus_file, "Path to LTLf+ formula file")->
+            check(CLI::ExistingFile);
+
+    CLI::Option* partition_file_opt = app.add_option("-p,--partition-file", partition_file, "Path to partition file")->
+            check(CLI::ExistingFile);
 
-    // CLI::Option* partition_file_opt;
-    app.add_option("-p,--partition-file", partition_file, "Path to partition file")->
-            required() -> check(CLI::ExistingFile);
+    app.add_option("--batch", batch_manifest,
+                   "Solve every job of a manifest in this process instead of -i and -p: a JSONL file of objects with "
+                   "\"formula\", \"partition\" and optionally \"id\", \"starting_player\", \"game_solver\", "
+                   "\"obligation_simplification\", \"buechi_mode\" and \"time_limit\", or a directory of .ltlfplus "
+                   "files with .part files of the same name. Prints one JSON result line per job on the standard "
+                   "output, and everything else on the standard error")
+        ->check(CLI::ExistingPath)
+        ->excludes(ltlf_plus_file_opt)
+        ->excludes(partition_file_opt);
+    app.add_option("--daemon", daemon_address,
+                   "Serve synthesis jobs over unix:<path> or tcp:<port> (loopback only) until a client sends "
+                   "{\"shutdown\": true}: one JSON object per line, with the fields of a --batch manifest line, "
+                   "answered by progress events and one result line per job. The DFAs stay in memory across jobs")
+        ->excludes(ltlf_plus_file_opt)
+        ->excludes(partition_file_opt)
+        ->excludes("--batch");
+    app.add_option("--batch-workers", batch_workers,
+                   "Number of worker processes solving the jobs of --batch, each keeping its parser, partitions and "
+                   "DFAs across its jobs")
+        ->default_val(1);
 
     // CLI::Option* starting_player_opt =
     app.add_option("-s,--starting-player", starting_player_id, "Starting player:\nagent=1;\nenvironment=0.")->
             required();
 
-    app.add_option("-g,--game-solver", game_solver, "Game:\nManna-Pnueli-Adv=2;\nManna-Pnueli=1;\nEmerson-Lei=0.")->
+    app.add_option("-g,--game-solver", game_solver, "Game:\nLayered-Emerson-Lei=5;\nSymbolic-Emerson-Lei=4;\nParity=3;\nManna-Pnueli-Adv=2;\nManna-Pnueli=1;\nEmerson-Lei=0.")->
             required();
 
     app.add_option("--obligation-simplification", obligation_simplification, "should obligation properties be treated using simpler algorithm (boolean)") ->
@@ -76,46 +177,658 @@ int main(int argc, char** argv) {
     app.add_option("--symbolic-threshold", symbolic_threshold,
                    "State-count threshold at which to switch to symbolic representation in obligation mode")
         ->default_val(128);
+    app.add_option("--explicit-game-states", explicit_game_states,
+                   "Solve obligation arenas of at most this many explicit states without BDDs (0 = never)")
+        ->default_val(Syft::ExplicitGameSolver::default_max_states);
+    app.add_flag("--fixed-product-thresholds", fixed_product_thresholds,
+                 "Switch to symbolic products at --symbolic-threshold instead of by the product cost model in obligation mode");
+    app.add_flag("--mona-products", mona_products,
+                 "Build explicit products with MONA instead of on the fly over reachable states in obligation mode");
+    app.add_flag("--minimize-arena", minimize_arena,
+                 "Quotient the symbolic arena by bisimulation before solving in obligation mode");
+    app.add_flag("--no-pure-obligation-games", no_pure_obligation_games,
+                 "Solve all-safety and all-guarantee specs with the selected solver instead of one fixpoint in obligation mode");
+    app.add_flag("--no-merge-sinks", no_merge_sinks,
+                 "Keep the product states in which an operand is in a sink distinct in symbolic products in obligation mode");
+    app.add_flag("--no-compact-arena", no_compact_arena,
+                 "Keep the state bits of an arena whose sinks were merged instead of re-encoding it in obligation mode");
+    app.add_flag("--symmetry-reduction", symmetry_reduction,
+                 "Quotient the arena by the permutations of colors with isomorphic DFAs in obligation mode");
+    app.add_flag("--abstraction-refinement", abstraction_refinement,
+                 "Solve large Buchi arenas by hiding and refining the state bits of their components in obligation mode");
+    app.add_option("--abstraction-visible-bits", abstraction_visible_bits,
+                   "State bits left visible by the first abstraction of --abstraction-refinement");
+
+    app.add_option("--product-minimisation-threshold", product_policy.state_threshold,
+                   "State count above which MONA products are minimised in obligation mode (0 = always)")
+        ->default_val(0);
+    app.add_option("--product-growth-ratio", product_policy.growth_ratio,
+                   "Also minimise MONA products that grow by more than this factor over their larger operand (0 = disabled)")
+        ->default_val(0);
+    app.add_option("--product-order", product_order_str,
+                   "Order of the MONA products in obligation mode: overlap (smallest estimated product, from the "
+                   "shared propositions, first) or smallest (smallest DFAs first)")
+        ->default_val("overlap")
+        ->check(CLI::IsMember({"overlap", "smallest"}));
+    app.add_option("--product-order-exhaustive", product_policy.exhaustive_order_limit,
+                   "Products of at most this many DFAs are planned over every order with --product-order overlap")
+        ->default_val(5);
+    app.add_option("--product-workers", product_policy.workers,
+                   "Processes computing the MONA products of a balanced product tree at once in obligation mode "
+                   "(1 = sequential products)")
+        ->default_val(1)
+        ->check(CLI::PositiveNumber);
 
     app.add_flag("--legacy-boolean-product", legacy_boolean_product,
                  "Use the legacy left-associative boolean product when combining DFAs");
 
-    app.add_option("-b,--buechi-mode", buechi_mode_str, "Solver mode: wg (weak-game / SCC), cl (Büchi classic), pm (Büchi Piterman), cb (CoBuchi)")
+    app.add_option("-b,--buechi-mode", buechi_mode_str, "Solver mode: wg (weak-game / SCC), cl (Büchi classic), pm (Büchi Piterman), cb (CoBuchi), "
+                   "lb (Büchi layered over the SCC decomposition of --scc-algorithm)")
     ->default_val("wg");
 
+    app.add_option("--reorder", reorder_mode_str,
+                   "BDD variable reordering: off, auto (CUDD dynamic reordering) or phase (reorder after DFA construction and after the arena product)")
+        ->default_val("off")
+        ->check(CLI::IsMember({"off", "auto", "phase"}));
+    app.add_option("--reorder-method", reorder_method_str,
+                   "BDD variable reordering method: sift, sift-converge, symm-sift, group-sift, window, annealing, genetic, exact")
+        ->default_val("sift")
+        ->check(CLI::IsMember({"sift", "sift-converge", "symm-sift", "group-sift", "window", "annealing", "genetic", "exact"}));
+
+    app.add_option("--proposition-order", proposition_order_str,
+                   "Initial order of the input and output variables: partition (as in the partition file) or force "
+                   "(FORCE heuristic over the variables of the subformulas)")
+        ->default_val("partition")
+        ->check(CLI::IsMember({"partition", "force"}));
+
+    app.add_option("--cudd-unique-slots", var_mgr_options.unique_slots,
+                   "Initial number of slots of each CUDD unique subtable")
+        ->default_val(CUDD_UNIQUE_SLOTS);
+    app.add_option("--cudd-cache-slots", var_mgr_options.cache_slots,
+                   "Initial number of slots of the CUDD computed table")
+        ->default_val(CUDD_CACHE_SLOTS);
+    app.add_option("--cudd-max-cache", var_mgr_options.max_cache_hard,
+                   "Maximum number of slots of the CUDD computed table (0 = CUDD default)")
+        ->default_val(0);
+    app.add_option("--cudd-max-memory", cudd_max_memory_mb,
+                   "Memory target and hard limit of the CUDD manager in MB (0 = CUDD default)")
+        ->default_val(0);
+    app.add_option("--cudd-loose-up-to", var_mgr_options.loose_up_to,
+                   "Unique table size up to which CUDD grows eagerly instead of collecting garbage (0 = CUDD default)")
+        ->default_val(0);
+    app.add_option("--bdd-backend", bdd_backend_str,
+                   "BDD package of the game fixpoints: cudd, or sylvan (multi-threaded; needs a build with "
+                   "-DLYDIASYFT_ENABLE_SYLVAN=ON)")
+        ->default_val("cudd")
+        ->check(CLI::IsMember({"cudd", "sylvan"}));
+    app.add_option("--bdd-threads", var_mgr_options.bdd_threads,
+                   "Threads of the sylvan BDD backend (0 = one per core)")
+        ->default_val(0);
+    app.add_option("--dfa-threads", dfa_options.threads,
+                   "Number of threads used to construct the DFAs of the LTLf subformulas (EL and MP solvers)")
+        ->default_val(1);
+    app.add_option("--dfa-cache-dir", dfa_options.cache_directory,
+                   "Directory of a persistent cache of the DFAs of the LTLf subformulas (EL and MP solvers; disabled if not given)");
+    app.add_option("--automata", automata_manifest,
+                   "Manifest of precompiled DFAs of LTLf subformulas, one {\"formula\": ..., \"automaton\": ...} "
+                   "line each, naming a MONA .dfa export or a finite-word .hoa file that a color whose argument is "
+                   "that formula (after the PNF) reads instead of building its DFA (EL and MP solvers)")
+        ->check(CLI::ExistingFile);
+    app.add_option("--result-cache-dir", result_cache_directory,
+                   "Directory of a persistent cache of the verdicts and strategies of specs already solved, keyed "
+                   "by their PNF, partition, starting player and solver options (disabled if not given)");
+    app.add_flag("--result-cache-validate", result_cache_validate,
+                 "Check the strategy of a result cache hit against the partition, instead of trusting the entry");
+    app.add_option("--symbolic-construction-bits", dfa_options.symbolic_construction_bits,
+                   "Build the DFA of a conjunction or disjunction with more temporal operators than this as the "
+                   "symbolic product of the DFAs of its arguments (EL and MP solvers; 0 = always through MONA)")
+        ->default_val(16);
+    app.add_option("--dfa-backend", dfa_backend_str,
+                   "LTLf-to-DFA backend of the subformulas: compositional, complemented (of the negation), decomposed "
+                   "(products of the arguments of a conjunction or disjunction) or auto (chosen per subformula)")
+        ->default_val("auto")
+        ->check(CLI::IsMember({"auto", "compositional", "complemented", "decomposed"}));
+    app.add_option("--dfa-race-ms", dfa_race_ms,
+                   "Time mid-sized subformulas race their candidate DFA backends before waiting for the preferred one "
+                   "(with --dfa-backend auto; 0 = no races; ignored with more than one DFA or component thread and with "
+                   "--daemon)")
+        ->default_val(2000);
+    app.add_option("--state-encoding", state_encoding_str,
+                   "Encoding of DFA states in state variables: binary, gray, one-hot, scc (SCC-ordered Gray code) or auto (chosen per DFA)")
+        ->default_val("binary")
+        ->check(CLI::IsMember({"binary", "gray", "one-hot", "scc", "auto"}));
+    app.add_flag("--reachable-only", dfa_options.reachable_states_only,
+                 "Solve the game over the states reachable from the initial state only (EL, MP and weak-game solvers)");
+    app.add_option("--care-simplification", care_simplification_str,
+                   "Simplify the transitions and colors outside the states reachable from the initial state, over "
+                   "which the game is then solved: off, restrict or licompaction (EL, MP and obligation solvers)")
+        ->default_val("off")
+        ->check(CLI::IsMember({"off", "restrict", "licompaction"}));
+    app.add_option("--scc-algorithm", scc_algorithm_str,
+                   "SCC decomposition of the weak game solver: naive (transitive closure), chain or skeleton "
+                   "(linear number of symbolic steps)")
+        ->default_val("naive")
+        ->check(CLI::IsMember({"naive", "chain", "skeleton"}));
+    app.add_option("--chain-pivot", chain_pivot_str,
+                   "Pivots of the chain SCC algorithm: arbitrary, last-layer (last BFS level of the enclosing "
+                   "forward search) or min-in-degree (chain candidates entered from the fewest states)")
+        ->default_val("last-layer")
+        ->check(CLI::IsMember({"arbitrary", "last-layer", "min-in-degree"}));
+    app.add_option("--chain-pivots-per-round", chain_pivots_per_round,
+                   "Forward searches of the chain SCC algorithm started from each subgraph before it is split")
+        ->default_val(1)
+        ->check(CLI::PositiveNumber);
+    app.add_option("--layer-threads", layer_threads,
+                   "Number of threads solving the independent SCCs of large weak-game layers (obligation mode)")
+        ->default_val(1);
+    app.add_option("--el-threads", dfa_options.el_threads,
+                   "Number of threads solving the children of wide Zielonka tree nodes when no strategy is extracted "
+                   "(EL solver)")
+        ->default_val(1);
+    app.add_option("--el-child-order", el_child_order_str,
+                   "Order in which the EL solver visits the children of a Zielonka tree node when no strategy is "
+                   "extracted, skipping those that cannot change the iteration: construction, smallest-target or "
+                   "changed-first (EL solver)")
+        ->default_val("construction")
+        ->check(CLI::IsMember({"construction", "smallest-target", "changed-first"}));
+    app.add_flag("--el-warm-start", dfa_options.el_warm_start,
+                 "Start each Zielonka tree node fixpoint from its result in the previous iteration of its "
+                 "grandparent when no strategy is extracted (EL solver)");
+    app.add_flag("--el-auto-dispatch", dfa_options.el_auto_dispatch,
+                 "Solve conditions whose Zielonka tree has height at most two with two-level fixpoints instead of "
+                 "the general recursion when no strategy is extracted (EL solver)");
+    app.add_flag("--pipeline-stages", dfa_options.pipeline_stages,
+                 "Compute the labels of the Zielonka tree on a separate thread while the DFAs of the colors are "
+                 "built, and report the critical path of the two (EL solver)");
+    app.add_option("--mp-threads", dfa_options.mp_threads,
+                   "Number of threads solving the independent nodes of a Manna-Pnueli DAG level when no strategy is "
+                   "extracted (MP solver)")
+        ->default_val(1);
+    app.add_option("--mp-work-dir", dfa_options.mp_work_directory,
+                   "Directory shared with worker processes started with --mp-worker, which then solve the nodes of the "
+                   "Manna-Pnueli DAG when no strategy is extracted (MP solver)");
+    app.add_option("--mp-worker", mp_worker_directory,
+                   "Run as a worker solving the Manna-Pnueli DAG nodes published in this directory by a coordinator "
+                   "started with --mp-work-dir, then exit; the formula is not read");
+    app.add_option("--checkpoint-dir", dfa_options.checkpoint_directory,
+                   "Save the solved Manna-Pnueli DAG nodes and the Emerson-Lei root bounds in this directory, "
+                   "overwriting any checkpoint there, when no strategy is extracted (EL and MP solvers)");
+    app.add_option("--resume", resume_directory,
+                   "As --checkpoint-dir, but first continue from the checkpoint in this directory if it was saved by "
+                   "a run of the same spec and options, e.g. one preempted by Slurm");
+    app.add_option("--checkpoint-interval", dfa_options.checkpoint_interval,
+                   "Least number of seconds between two checkpoints of the Emerson-Lei root bounds")
+        ->default_val(600);
+    app.add_flag("--symbolic-strategy", dfa_options.symbolic_strategy,
+                 "Extract the strategy as a symbolic transducer over states and Zielonka tree memory, instead of "
+                 "one move per visited state (EL and MP solvers)");
+    app.add_option("--minimize-strategy", strategy_minimization_str,
+                   "Simplify the output functions of the extracted strategy outside the states reachable under it: "
+                   "off, restrict or licompaction (EL solver with --symbolic-strategy)")
+        ->default_val("off")
+        ->check(CLI::IsMember({"off", "restrict", "licompaction"}));
+    app.add_flag("--minimize-per-output", dfa_options.strategy_minimization.per_output,
+                 "With --minimize-strategy, first free each output where both of its values are winning");
+    app.add_option("--export-c", export_c_file,
+                   "Write the extracted strategy as standalone C to this file (EL solver with --symbolic-strategy)");
+    app.add_option("--save-strategy", save_strategy_file,
+                   "Write the extracted strategy as a compiled controller to this file, which "
+                   "Syft::CompiledTransducer::load maps back (EL solver with --symbolic-strategy, or obligation "
+                   "arenas solved explicitly)");
+    app.add_option("--export-verilog", export_verilog_file,
+                   "Write the extracted strategy as a Verilog module to this file (EL solver with --symbolic-strategy)");
+    app.add_flag("--frontier-fixpoints", frontier_fixpoints,
+                 "Only re-examine the predecessors of the last changed states in each fixpoint iteration, and warm-start "
+                 "the inner fixpoints of the Buchi solvers (obligation mode)");
+    app.add_option("--time-limit", time_limit_s,
+                   "Stop with a budget-exceeded report after this many seconds (0 = unlimited)")
+        ->default_val(0);
+    app.add_option("--max-live-nodes", max_live_nodes,
+                   "Stop with a budget-exceeded report beyond this many live BDD nodes (0 = unlimited)")
+        ->default_val(0);
+    app.add_option("--max-rss", max_rss_mb,
+                   "Stop with a budget-exceeded report beyond this resident set size in MB (0 = unlimited)")
+        ->default_val(0);
+    app.add_flag("--realizability-only", realizability_only,
+                 "Only compute the verdict: stop the fixpoints once the initial state is decided (EL and obligation solvers)");
+    app.add_flag("--anytime", dfa_options.anytime,
+                 "Log sound partial winning regions while solving and stop at the first sound verdict, also when "
+                 "not in --realizability-only mode (EL and MP solvers)");
+    app.add_flag("--portfolio", portfolio,
+                 "Run Emerson-Lei, both Manna-Pnueli solvers and, on obligation formulas, every obligation solver "
+                 "concurrently in separate processes, and report the first verdict (ignores -g, --obligation-simplification and -b)");
+    app.add_flag("--no-one-step-colors", no_one_step_colors,
+                 "Build the DFA of every color, also of those decided by their first step on every play (EL and MP solvers)");
+    app.add_flag("--decompose", dfa_options.decompose_components,
+                 "Solve the components of the color formula that share no variables of the agent as separate "
+                 "games, instead of the whole spec as one game (EL solver)");
+    app.add_flag("--watch", watch,
+                 "Solve the formula again whenever its file changes, only building the DFAs of new subformulas and "
+                 "warm-starting from the previous solve when conjuncts were only added or removed (EL solver)");
+    app.add_option("--component-threads", dfa_options.component_threads,
+                   "Number of threads solving the independent components of a decomposed spec (EL solver)")
+        ->default_val(1);
+    app.add_flag("--split-disjuncts", dfa_options.split_disjuncts,
+                 "First solve each top disjunct of the color formula as a game of its own, in parallel on the "
+                 "--el-threads, and solve the whole condition only if none wins from the initial state, seeded with "
+                 "their winning states (EL solver, when no strategy is extracted)");
+    app.add_option("--horizon-precheck", dfa_options.horizon_precheck,
+                   "Before the Zielonka tree, check whether the agent forces within this many steps a region whose "
+                   "colors already satisfy the condition, reporting realizable if so; 0 disables (EL solver, when no "
+                   "strategy is extracted)")
+        ->default_val(0);
+    app.add_flag("--safety-first", dfa_options.safety_first,
+                 "First restrict the arena to the safe region of the Forall colors of the top conjunction, and drop "
+                 "those colors from the game (EL and MP solvers)");
+    app.add_flag("--both-orders", both_orders,
+                 "Report the verdicts with the agent and with the environment moving first, building the DFAs and "
+                 "the arena once (EL solver, ignores -s)");
+    app.add_option("--solver", solver_str,
+                   "Solver mode, as named in perf/suite.json (el, mp, mp-adv, parity, symbolic-colors, scc-layers, "
+                   "obligation-cl|pm|wg|cb), or auto to predict the fastest one from features of the spec and its "
+                   "DFAs (overrides -g, --obligation-simplification and -b)");
+    app.add_option("--solver-model", solver_model_file,
+                   "Decision tree of --solver auto, as written by scripts/train_solver_selector.py (default: the "
+                   "builtin model, perf/solver_model.jsonl)")
+        ->check(CLI::ExistingFile);
+    app.add_flag("--print-features", print_features,
+                 "Print the features of the spec read by --solver auto as one JSON line, and exit");
+    app.add_flag("--stats", print_stats,
+                 "Print BDD engine statistics of each synthesis phase as JSON");
+    app.add_option("--trace", trace_file,
+                   "Write a Chrome trace (chrome://tracing, Perfetto) of the spans of the pipeline to this file at "
+                   "exit, annotated with BDD sizes");
+    app.add_option("--fixpoint-telemetry", fixpoint_telemetry_file,
+                   "Write the approximation size, state count and time of every fixpoint iteration of the game "
+                   "solvers to this file, as CSV if it ends in .csv and as JSONL otherwise");
+    app.add_option("--json-result", json_result_file,
+                   "Write the verdict, the solver, the phase times and BDD statistics and the DFA, arena, Zielonka "
+                   "tree and DAG sizes of the run to this file as JSON (see SynthesisReport)");
+
+    app.add_flag("--debug", debug,
+                 "Dump the BDDs and strategies of the solvers while they run (builds with "
+                 "LYDIASYFT_ENABLE_DEBUG_TRACE only)");
     app.add_flag("-v,--verbose", verbose, "Enable verbose mode");      
 
     CLI11_PARSE(app, argc, argv);
 
+    if (batch_manifest.empty() && daemon_address.empty() && mp_worker_directory.empty() &&
+        (ltlf_plus_file.empty() || partition_file.empty())) {
+        std::cerr << "Error: --input-file and --partition-file are required unless --batch or --daemon is given"
+                  << std::endl;
+        return 1;
+    }
+
+    if (debug) {
+#ifdef LYDIASYFT_DEBUG_TRACE
+        DEBUG_MODE = true;
+#else
+        std::cerr << "Error: --debug needs a build with LYDIASYFT_ENABLE_DEBUG_TRACE" << std::endl;
+        return 1;
+#endif
+    }
+    if (!trace_file.empty()) {
+        Syft::Tracer::start(trace_file);
+    }
+    if (!fixpoint_telemetry_file.empty()) {
+        try {
+            Syft::FixpointTelemetry::start(fixpoint_telemetry_file);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+    }
+    var_mgr_options.reorder_policy =
+        Syft::ReorderPolicy::from_string(reorder_mode_str, reorder_method_str);
+    try {
+        var_mgr_options.bdd_backend = Syft::bdd_backend_from_string(bdd_backend_str);
+    } catch (const std::runtime_error& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    var_mgr_options.proposition_order = proposition_order_str == "force" ? Syft::PropositionOrder::Force
+                                                                         : Syft::PropositionOrder::Partition;
+    dfa_options.strategy_minimization.method = Syft::strategy_minimization_from_string(strategy_minimization_str);
+    dfa_options.care_simplification = Syft::strategy_minimization_from_string(care_simplification_str);
+    dfa_options.el_child_order = Syft::child_order_from_string(el_child_order_str);
+    var_mgr_options.max_memory = cudd_max_memory_mb * 1024 * 1024;
+    // The phase snapshots are part of the JSON result
+    var_mgr_options.collect_stats = print_stats || !json_result_file.empty();
+    if (time_limit_s > 0) {
+        var_mgr_options.budget.set_time_limit(
+            std::chrono::milliseconds(static_cast<long long>(time_limit_s * 1000)));
+    }
+    var_mgr_options.budget.set_max_live_nodes(max_live_nodes);
+    var_mgr_options.budget.set_max_rss(max_rss_mb * 1024 * 1024);
+    dfa_options.state_encoding = Syft::StateEncoding::kind_from_string(state_encoding_str);
+    dfa_options.dfa_backend.backend = Syft::parse_dfa_backend(dfa_backend_str);
+    product_policy.order = product_order_str == "smallest" ? Syft::ProductOrder::Smallest : Syft::ProductOrder::Overlap;
+    dfa_options.dfa_backend.race_budget = std::chrono::milliseconds(dfa_race_ms);
+    if (dfa_options.threads > 1 || dfa_options.component_threads > 1 || !daemon_address.empty()) {
+        // Races fork, which is unsafe while other threads may hold locks
+        dfa_options.dfa_backend.race_budget = std::chrono::milliseconds(0);
+    }
+    dfa_options.one_step_colors = !no_one_step_colors;
+    if (!automata_manifest.empty()) {
+        try {
+            dfa_options.precompiled = std::make_shared<const Syft::PrecompiledAutomata>(
+                Syft::PrecompiledAutomata::read_manifest(automata_manifest));
+        } catch (const std::runtime_error& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+        spdlog::info("Read {} precompiled automata from {}", dfa_options.precompiled->size(), automata_manifest);
+    }
+    if (!resume_directory.empty()) {
+        dfa_options.checkpoint_directory = resume_directory;
+        dfa_options.resume = true;
+    }
+    if (!mp_worker_directory.empty()) {
+        std::size_t solved = Syft::DagWorkQueue::serve(mp_worker_directory, var_mgr_options);
+        std::cout << "Manna-Pnueli worker solved " << solved << " DAG nodes" << std::endl;
+        return 0;
+    }
+    // The portfolio only reports verdicts
+    dfa_options.realizability_only = realizability_only || portfolio;
+
     // Start stopwatch to measure execution time (wall and CPU)
     auto start = std::chrono::high_resolution_clock::now();
     const std::clock_t c_start = std::clock();
 
+    // Wall and CPU time elapsed since the start, in seconds
+    auto elapsed_times = [&]() {
+        std::chrono::duration<double> wall_elapsed = std::chrono::high_resolution_clock::now() - start;
+        double cpu_elapsed = double(std::clock() - c_start) / double(CLOCKS_PER_SEC);
+        return std::make_pair(wall_elapsed.count(), cpu_elapsed);
+    };
     // Helper to print wall and CPU elapsed time
     auto print_times = [&](const std::string &label = "") {
-        auto end = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<double> wall_elapsed = end - start;
-        const std::clock_t c_end = std::clock();
-        double cpu_elapsed = double(c_end - c_start) / double(CLOCKS_PER_SEC);
+        auto [wall_elapsed, cpu_elapsed] = elapsed_times();
         if (!label.empty()) std::cout << label << ": ";
-        std::cout << "Wall time: " << wall_elapsed.count() << " seconds; CPU time: " << cpu_elapsed << " seconds" << std::endl;
+        std::cout << "Wall time: " << wall_elapsed << " seconds; CPU time: " << cpu_elapsed << " seconds" << std::endl;
     };
-    // parse and process input LTLf+ formula
-    // read formula
-    std::string ltlf_plus_formula_str;
-    std::ifstream ltlf_plus_formula_stream(ltlf_plus_file);
-    getline(ltlf_plus_formula_stream, ltlf_plus_formula_str);
-    if (verbose) {
-        std::cout << "LTLf+ formula: " << ltlf_plus_formula_str << std::endl;
+    // Writes the --json-result of the run, if one was requested; returns false if it could not be written
+    auto write_json_result = [&](const std::string &verdict, const std::string &solver, const std::string &mode,
+                                 const Syft::SolverStats *stats, const std::string &detail = "") {
+        if (json_result_file.empty()) {
+            return true;
+        }
+        Syft::SynthesisReport report;
+        report.tool = "LydiaSyftEL";
+        report.formula_file = ltlf_plus_file;
+        report.partition_file = partition_file;
+        report.verdict = verdict;
+        report.solver = solver;
+        report.mode = mode;
+        report.agent_starts = starting_player_id != 0;
+        report.detail = detail;
+        std::tie(report.wall_time, report.cpu_time) = elapsed_times();
+        report.stats = stats;
+        try {
+            report.write(json_result_file);
+        } catch (const std::runtime_error &e) {
+            std::cerr << e.what() << std::endl;
+            return false;
+        }
+        return true;
+    };
+    // The name and mode of the Emerson-Lei and Manna-Pnueli solvers in the JSON result
+    auto solver_name = [&]() -> std::pair<std::string, std::string> {
+        if (game_solver == 1) return {"manna-pnueli", ""};
+        if (game_solver == 2) return {"manna-pnueli-adv", ""};
+        return {"emerson-lei", dfa_options.parity_solver ? "parity" : dfa_options.symbolic_colors ? "symbolic-colors" :
+                                dfa_options.scc_layers ? "scc-layers" : ""};
+    };
+    // Reports an exhausted budget with the statistics gathered so far; returns the exit code
+    auto report_budget_exceeded = [&](const Syft::BudgetExceeded &e, const Syft::SolverStats &stats,
+                                      const std::string &solver, const std::string &mode) {
+        const Syft::BddStatsSnapshot &s = e.snapshot();
+        std::cout << "LTLf+ synthesis is UNKNOWN: budget exceeded (" << e.resource() << ") during " << e.phase()
+                  << "; live nodes: " << s.live_nodes << ", peak nodes: " << s.peak_nodes
+                  << ", memory in use: " << s.memory_in_use << " bytes" << std::endl;
+        if (print_stats) {
+            stats.print_json(std::cout);
+        }
+        print_times();
+        write_json_result("UNKNOWN", solver, mode, &stats,
+                          "budget exceeded (" + e.resource() + ") during " + e.phase());
+        return 3;
+    };
+
+    // Transforms a parsed formula in PNF, as the synthesizers take it
+    auto to_ltlf_plus = [](const whitemech::lydia::LTLfPlusFormula &formula) {
+        Syft::TraceScope trace("PNF", "parsing");
+        auto formula_pnf = whitemech::lydia::get_pnf_result(formula);
+        trace.arg("colors", static_cast<double>(formula_pnf.subformula_to_color_.size()));
+        Syft::LTLfPlus spec;
+        spec.color_formula_ = formula_pnf.color_formula_;
+        spec.formula_to_color_ = formula_pnf.subformula_to_color_;
+        spec.formula_to_quantification_ = formula_pnf.subformula_to_quantifier_;
+        return spec;
+    };
+    // Maps a --buechi-mode to the use_buchi flag and BuchiMode of the obligation synthesizer
+    auto obligation_mode = [](const std::string &mode_str) {
+        if (mode_str == "wg" || mode_str == "weak" || mode_str == "weak-game") {
+            // SCC-based weak-game solver
+            return std::make_pair(false, Syft::BuchiSolver::BuchiMode::CLASSIC);
+        }
+        if (mode_str == "pm" || mode_str == "piterman") {
+            return std::make_pair(true, Syft::BuchiSolver::BuchiMode::PITERMAN);
+        }
+        if (mode_str == "cb" || mode_str == "cobuchi") {
+            return std::make_pair(true, Syft::BuchiSolver::BuchiMode::COBUCHI);
+        }
+        if (mode_str == "lb" || mode_str == "layered") {
+            return std::make_pair(true, Syft::BuchiSolver::BuchiMode::LAYERED);
+        }
+        // default to classic if unrecognised but not wg
+        return std::make_pair(true, Syft::BuchiSolver::BuchiMode::CLASSIC);
+    };
+
+    MinimisationOptions minimisation_options{!disable_minimisation, minimisation_threshold, symbolic_threshold,
+                                             product_policy, dfa_options.state_encoding,
+                                             frontier_fixpoints ? Syft::FixpointMode::Frontier : Syft::FixpointMode::Full,
+                                             dfa_options.realizability_only};
+    minimisation_options.scc_algorithm = Syft::SCCDecomposer::AlgorithmFromString(scc_algorithm_str);
+    minimisation_options.scc_chain.pivot = Syft::ChainSCCDecomposer::PivotFromString(chain_pivot_str);
+    minimisation_options.scc_chain.pivots_per_round = chain_pivots_per_round;
+    minimisation_options.layer_threads = layer_threads;
+    minimisation_options.reachable_states_only = dfa_options.reachable_states_only;
+    minimisation_options.care_simplification = dfa_options.care_simplification;
+    minimisation_options.cost_model.enabled = !fixed_product_thresholds;
+    minimisation_options.reachable_products = !mona_products;
+    minimisation_options.minimize_arena = minimize_arena;
+    minimisation_options.pure_obligation_games = !no_pure_obligation_games;
+    minimisation_options.merge_product_sinks = !no_merge_sinks;
+    minimisation_options.compact_arena = !no_compact_arena;
+    minimisation_options.symmetry_reduction = symmetry_reduction;
+    minimisation_options.abstraction_refinement = abstraction_refinement;
+    minimisation_options.abstraction_max_visible_bits = abstraction_visible_bits;
+    minimisation_options.explicit_game_max_states = explicit_game_states;
+
+    // The result cache keys a spec on the solver options that may change its result: every solver gives the
+    // same verdict, but not the same strategy
+    std::unique_ptr<Syft::ResultCache> result_cache;
+    if (!result_cache_directory.empty()) {
+        try {
+            result_cache = std::make_unique<Syft::ResultCache>(result_cache_directory);
+        } catch (const std::runtime_error &e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+    }
+    auto result_cache_options = [&](int solver, bool obligation, const std::string &mode_str) {
+        if (obligation) {
+            return "obligation/" + mode_str;
+        }
+        std::string options = "game-solver/" + std::to_string(solver);
+        if (dfa_options.symbolic_strategy) {
+            options += "/symbolic-strategy/" + strategy_minimization_str +
+                       (dfa_options.strategy_minimization.per_output ? "/per-output" : "");
+        }
+        return options;
+    };
+
+    if (!batch_manifest.empty() || !daemon_address.empty()) {
+        // Kept across the jobs of a process: the parser, the interface layouts and the explicit DFAs, in memory
+        // in front of --dfa-cache-dir if given
+        auto batch_driver = std::make_shared<whitemech::lydia::parsers::ltlfplus::LTLfPlusDriver>();
+        std::map<std::string, Syft::InterfaceLayout> layouts;
+        dfa_options.shared_cache = std::make_shared<Syft::DfaCache>(dfa_options.cache_directory, true);
+        // A batch also keeps an EL session per partition, starting player and condition solver, which only
+        // builds the symbolic DFAs of subformulas it has not seen; the daemon gives each job a VarMgr of its own
+        bool use_sessions = daemon_address.empty();
+        std::map<std::tuple<std::string, int, bool>, std::unique_ptr<Syft::LTLfPlusSession>> sessions;
+
+        auto solve_job = [&](const Syft::BatchJob &job, const Syft::DaemonJobContext *context) {
+            {
+                Syft::TraceScope trace("parse", "parsing");
+                Syft::FormulaFile job_formula(job.formula_file);
+                trace.arg("bytes", static_cast<double>(job_formula.formula().size()));
+                batch_driver->parse(job_formula.stream());
+            }
+            Syft::LTLfPlus spec = to_ltlf_plus(*std::static_pointer_cast<const whitemech::lydia::LTLfPlusFormula>(
+                    batch_driver->get_result()));
+
+            auto job_layout = layouts.find(job.partition_file);
+            if (job_layout == layouts.end()) {
+                job_layout = layouts.emplace(job.partition_file,
+                                             Syft::InterfaceLayout::read_from_file(job.partition_file)).first;
+            }
+            int job_starting_player_id = job.starting_player.value_or(starting_player_id);
+            Syft::Player job_starting_player = job_starting_player_id ? Syft::Player::Agent : Syft::Player::Environment;
+            int job_game_solver = job.game_solver.value_or(game_solver);
+
+            // Each job gets a deadline of its own
+            Syft::SolveBudget budget;
+            double job_time_limit_s = job.time_limit.value_or(time_limit_s);
+            if (job_time_limit_s > 0) {
+                budget.set_time_limit(std::chrono::milliseconds(static_cast<long long>(job_time_limit_s * 1000)));
+            }
+            budget.set_max_live_nodes(max_live_nodes);
+            budget.set_max_rss(max_rss_mb * 1024 * 1024);
+            Syft::VarMgrOptions job_var_mgr_options = var_mgr_options;
+            if (context) {
+                budget.set_cancellation_token(context->cancelled);
+                job_var_mgr_options.phase_listener = context->progress;
+            }
+            job_var_mgr_options.budget = budget;
+
+            Syft::BatchResult job_result;
+            std::string job_key;
+            if (result_cache) {
+                bool job_obligation = job.obligation_simplification.value_or(obligation_simplification);
+                job_key = Syft::ResultCache::cache_key(
+                        spec, job_layout->second.partition(), job_starting_player,
+                        result_cache_options(job_game_solver, job_obligation, job.buechi_mode.value_or(buechi_mode_str)));
+                if (std::optional<Syft::CachedResult> cached = result_cache->load(job_key)) {
+                    job_result.verdict = cached->realizability ? "REALIZABLE" : "UNREALIZABLE";
+                    job_result.detail = "result cache hit";
+                    return job_result;
+                }
+            }
+            try {
+                bool realizability;
+                if (job.obligation_simplification.value_or(obligation_simplification)) {
+                    auto [use_buchi_flag, mode] = obligation_mode(job.buechi_mode.value_or(buechi_mode_str));
+                    Syft::ObligationLTLfPlusSynthesizer synthesizer(
+                        spec, job_layout->second, job_starting_player, Syft::Player::Agent, use_buchi_flag, mode,
+                        minimisation_options, /*use_balanced_boolean_product=*/!legacy_boolean_product,
+                        job_var_mgr_options);
+                    realizability = synthesizer.run().realizability;
+                } else if ((job_game_solver == 0 || job_game_solver == 3) && use_sessions) {
+                    std::unique_ptr<Syft::LTLfPlusSession> &session =
+                        sessions[std::make_tuple(job.partition_file, job_starting_player_id, job_game_solver == 3)];
+                    if (!session) {
+                        Syft::DfaConstructionOptions session_options = dfa_options;
+                        session_options.parity_solver = job_game_solver == 3;
+                        session = std::make_unique<Syft::LTLfPlusSession>(job_layout->second, job_starting_player,
+                                                                          Syft::Player::Agent, job_var_mgr_options,
+                                                                          session_options);
+                    }
+                    session->var_mgr()->set_budget(budget);
+                    realizability = session->solve(spec).realizability;
+                } else if (job_game_solver == 0 || (job_game_solver >= 3 && job_game_solver <= 5)) {
+                    Syft::DfaConstructionOptions el_options = dfa_options;
+                    el_options.parity_solver = job_game_solver == 3;
+                    el_options.symbolic_colors = job_game_solver == 4;
+                    el_options.scc_layers = job_game_solver == 5;
+                    Syft::LTLfPlusSynthesizer synthesizer(spec, job_layout->second, job_starting_player,
+                                                          Syft::Player::Agent, job_var_mgr_options, el_options);
+                    realizability = synthesizer.run().realizability;
+                } else if (job_game_solver == 1 || job_game_solver == 2) {
+                    Syft::LTLfPlusSynthesizerMP synthesizer(spec, job_layout->second, job_starting_player,
+                                                            Syft::Player::Agent, job_game_solver, job_var_mgr_options,
+                                                            dfa_options);
+                    realizability = synthesizer.run().realizability;
+                } else {
+                    throw std::runtime_error("Error: Unknown game solver " + std::to_string(job_game_solver));
+                }
+                job_result.verdict = realizability ? "REALIZABLE" : "UNREALIZABLE";
+                if (result_cache) {
+                    result_cache->store(job_key, realizability);
+                }
+            } catch (const Syft::BudgetExceeded &e) {
+                job_result.verdict = "UNKNOWN";
+                job_result.detail = "budget exceeded (" + e.resource() + ") during " + e.phase();
+            }
+            return job_result;
+        };
+
+        if (!daemon_address.empty()) {
+            try {
+                Syft::SynthesisDaemon daemon(daemon_address);
+                std::size_t solved = daemon.serve([&](const Syft::BatchJob &job,
+                                                      const Syft::DaemonJobContext &context) {
+                    return solve_job(job, &context);
+                });
+                spdlog::info("Synthesis daemon solved {} jobs", solved);
+            } catch (const std::exception &e) {
+                std::cerr << e.what() << std::endl;
+                return 1;
+            }
+            return 0;
+        }
+
+        std::vector<Syft::BatchJob> jobs;
+        try {
+            jobs = Syft::read_batch_manifest(batch_manifest);
+        } catch (const std::exception &e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+        // The result lines are the only standard output; whatever the solvers print goes to the standard error
+        std::cout.flush();
+        std::FILE *results = fdopen(dup(STDOUT_FILENO), "w");
+        dup2(STDERR_FILENO, STDOUT_FILENO);
+
+        Syft::BatchRunner runner(batch_workers);
+        auto solve_batch_job = [&](const Syft::BatchJob &job) {
+            return solve_job(job, nullptr);
+        };
+        std::size_t solved = runner.run(jobs, solve_batch_job, [&](const Syft::BatchResult &job_result) {
+            std::fputs((job_result.to_json() + "\n").c_str(), results);
+            std::fflush(results);
+        });
+        std::fclose(results);
+        return solved == jobs.size() ? 0 : 1;
     }
 
+    // parse and process input LTLf+ formula
     // LTLf+ driver
     std::shared_ptr<whitemech::lydia::parsers::ltlfplus::LTLfPlusDriver> driver = 
         std::make_shared<whitemech::lydia::parsers::ltlfplus::LTLfPlusDriver>();
 
-    // parse formula
-    std::stringstream formula_stream(ltlf_plus_formula_str);
-    driver->parse(formula_stream);
+    // parse formula, read in place from the mapped file, which is released once parsed
+    {
+        Syft::TraceScope trace("parse", "parsing");
+        Syft::FormulaFile formula_file(ltlf_plus_file);
+        trace.arg("bytes", static_cast<double>(formula_file.formula().size()));
+        if (verbose) {
+            std::cout << "LTLf+ formula: " << formula_file.formula() << std::endl;
+        }
+        driver->parse(formula_file.stream());
+    }
     auto result = driver->get_result();
 
     // cast ast_ptr into ltlf_plus_ptr. Necessary since AbstractDriver is not template anymore
@@ -123,7 +836,10 @@ int main(int argc, char** argv) {
         std::static_pointer_cast<const whitemech::lydia::LTLfPlusFormula>(result);
 
     // transform formula in PNF
-    auto pnf = whitemech::lydia::get_pnf_result(*ptr_ltlf_plus_formula);
+    auto pnf = [&]() {
+        Syft::TraceScope trace("PNF", "parsing");
+        return whitemech::lydia::get_pnf_result(*ptr_ltlf_plus_formula);
+    }();
     Syft::LTLfPlus ltlf_plus_formula;
     ltlf_plus_formula.color_formula_ = pnf.color_formula_;
     ltlf_plus_formula.formula_to_color_= pnf.subformula_to_color_;
@@ -161,27 +877,184 @@ int main(int argc, char** argv) {
     Syft::InputOutputPartition partition =
         Syft::InputOutputPartition::read_from_file(partition_file);
 
+    if (watch) {
+        // The driver of the first parse reads every edit, so that the subformulas an edit keeps are the nodes
+        // already parsed
+        auto parse_spec = [&to_ltlf_plus, &driver](Syft::FormulaFile &formula) {
+            driver->parse(formula.stream());
+            auto parsed = std::static_pointer_cast<const whitemech::lydia::LTLfPlusFormula>(driver->get_result());
+            return to_ltlf_plus(*parsed);
+        };
+        Syft::LTLfPlusSession session(partition, starting_player, Syft::Player::Agent, var_mgr_options, dfa_options);
+        std::string solved_formula;
+        while (true) {
+            std::unique_ptr<Syft::FormulaFile> watched_formula;
+            try {
+                watched_formula = std::make_unique<Syft::FormulaFile>(ltlf_plus_file);
+            } catch (const std::runtime_error &) {
+                // The file may be replaced while it is edited; it is read again at the next poll
+            }
+            if (watched_formula && !watched_formula->formula().empty() &&
+                watched_formula->formula() != solved_formula) {
+                solved_formula = std::string(watched_formula->formula());
+                start = std::chrono::high_resolution_clock::now();
+                try {
+                    Syft::ELSynthesisResult watched_result = session.solve(parse_spec(*watched_formula));
+                    std::cout << "LTLf+ synthesis is " << (watched_result.realizability ? "REALIZABLE" : "UNREALIZABLE")
+                              << std::endl;
+                } catch (const std::exception &e) {
+                    std::cerr << "Error: " << e.what() << std::endl;
+                }
+                print_times();
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        }
+    }
+
+    if (portfolio) {
+        Syft::Portfolio solvers(!verbose);
+        solvers.add("emerson-lei", [&]() {
+            Syft::LTLfPlusSynthesizer synthesizer(ltlf_plus_formula, partition, starting_player, Syft::Player::Agent,
+                                                  var_mgr_options, dfa_options);
+            return synthesizer.run().realizability;
+        });
+        for (int mp_solver : {1, 2}) {
+            solvers.add(mp_solver == 1 ? "manna-pnueli" : "manna-pnueli-adv", [&, mp_solver]() {
+                Syft::LTLfPlusSynthesizerMP synthesizer(ltlf_plus_formula, partition, starting_player,
+                                                        Syft::Player::Agent, mp_solver, var_mgr_options, dfa_options);
+                return synthesizer.run().realizability;
+            });
+        }
+        if (Syft::ObligationFragmentDetector::isObligationFragment(ptr_ltlf_plus_formula)) {
+            const std::vector<std::pair<std::string, std::optional<Syft::BuchiSolver::BuchiMode>>> obligation_modes = {
+                {"obligation-wg", std::nullopt},
+                {"obligation-cl", Syft::BuchiSolver::BuchiMode::CLASSIC},
+                {"obligation-pm", Syft::BuchiSolver::BuchiMode::PITERMAN},
+                {"obligation-cb", Syft::BuchiSolver::BuchiMode::COBUCHI},
+                {"obligation-lb", Syft::BuchiSolver::BuchiMode::LAYERED}};
+            for (const auto& [name, mode] : obligation_modes) {
+                solvers.add(name, [&, mode = mode]() {
+                    Syft::ObligationLTLfPlusSynthesizer synthesizer(
+                        ltlf_plus_formula, partition, starting_player, Syft::Player::Agent, mode.has_value(),
+                        mode.value_or(Syft::BuchiSolver::BuchiMode::CLASSIC), minimisation_options,
+                        /*use_balanced_boolean_product=*/!legacy_boolean_product, var_mgr_options);
+                    return synthesizer.run().realizability;
+                });
+            }
+        }
+
+        std::optional<Syft::PortfolioVerdict> verdict = solvers.run();
+        if (!verdict) {
+            std::cerr << "Error: every solver of the portfolio failed" << std::endl;
+            return 1;
+        }
+        std::cout << "Portfolio winner: " << verdict->winner << " after " << verdict->elapsed.count() << " ms" << std::endl;
+        if (verdict->realizability) {
+            std::cout << "LTLf+ synthesis is REALIZABLE" << std::endl;
+        } else {
+            std::cout << "LTLf+ synthesis is UNREALIZABLE" << std::endl;
+        }
+        print_times();
+        // The statistics of the entries stay in their processes
+        if (!write_json_result(verdict->realizability ? "REALIZABLE" : "UNREALIZABLE", "portfolio", verdict->winner,
+                               nullptr)) {
+            return 1;
+        }
+        return 0;
+    }
+
+    if (!solver_str.empty() || print_features) {
+        std::string mode_name = solver_str;
+        if (solver_str == "auto" || print_features) {
+            // The DFAs built for the features stay in the shared cache of dfa_options for the solver
+            Syft::SpecFeatures features = [&]() {
+                Syft::TraceScope trace("solver selection");
+                return Syft::extract_spec_features(
+                    ltlf_plus_formula, Syft::ObligationFragmentDetector::isObligationFragment(ptr_ltlf_plus_formula),
+                    Syft::InterfaceLayout(partition), var_mgr_options, dfa_options);
+            }();
+            if (print_features) {
+                std::cout << features.to_json() << std::endl;
+                return 0;
+            }
+            Syft::SolverSelector selector = solver_model_file.empty()
+                ? Syft::SolverSelector::builtin() : Syft::SolverSelector::load(solver_model_file);
+            std::string explanation;
+            mode_name = selector.predict(features, &explanation);
+            spdlog::info("[SolverSelector] features {}", features.to_json());
+            spdlog::info("[SolverSelector] predicted {} ({})", mode_name, explanation);
+        }
+        std::optional<Syft::SolverMode> mode = Syft::SolverSelector::solver_mode(mode_name);
+        if (!mode) {
+            std::cerr << "Error: Unknown solver: " << mode_name << std::endl;
+            return 1;
+        }
+        game_solver = mode->game_solver;
+        obligation_simplification = mode->obligation_simplification;
+        if (!mode->buechi_mode.empty()) {
+            buechi_mode_str = mode->buechi_mode;
+        }
+    }
+
+    // The game solver as requested, which keys the result cache
+    const int requested_game_solver = game_solver;
+    if (game_solver == 3) {
+        // The EL pipeline, with the condition solved as a parity game
+        dfa_options.parity_solver = true;
+        game_solver = 0;
+    }
+    if (game_solver == 4) {
+        // The EL pipeline, with the condition solved on the colors of each subgame
+        dfa_options.symbolic_colors = true;
+        game_solver = 0;
+    }
+    if (game_solver == 5) {
+        // The EL pipeline, with the arena solved one SCC layer at a time
+        dfa_options.scc_layers = true;
+        game_solver = 0;
+    }
+
+    // A spec solved before with the same options is answered from the result cache, unless the hit lacks the
+    // strategy to export
+    std::string result_key;
+    if (result_cache && !both_orders) {
+        result_key = Syft::ResultCache::cache_key(ltlf_plus_formula, partition, starting_player,
+                                                  result_cache_options(requested_game_solver, obligation_simplification,
+                                                                       buechi_mode_str));
+        std::optional<Syft::CachedResult> cached =
+            result_cache->load(result_key, result_cache_validate ? &partition : nullptr);
+        bool usable = cached && (!cached->realizability ||
+                                 (export_c_file.empty() && export_verilog_file.empty() &&
+                                  (save_strategy_file.empty() || cached->strategy)));
+        if (usable) {
+            std::string verdict = cached->realizability ? "REALIZABLE" : "UNREALIZABLE";
+            std::cout << "LTLf+ synthesis is " << verdict << " (result cache hit)" << std::endl;
+            if (cached->realizability && !save_strategy_file.empty()) {
+                cached->strategy->save(save_strategy_file);
+                spdlog::info("Wrote {}", save_strategy_file);
+            }
+            print_times();
+            auto [cached_solver, cached_mode] = obligation_simplification
+                ? std::make_pair(std::string("obligation"), buechi_mode_str) : solver_name();
+            if (!write_json_result(verdict, cached_solver, cached_mode, nullptr, "result cache hit")) {
+                return 1;
+            }
+            return 0;
+        }
+    }
+    // Stores the result of the run in the result cache, if any
+    auto store_result = [&](bool realizability, const Syft::Transducer *strategy) {
+        if (result_cache) {
+            result_cache->store(result_key, realizability, strategy);
+        }
+    };
+
     // Use obligation synthesizer if enabled
     if (obligation_simplification) {
         std::cout << "Using obligation fragment synthesizer" << std::endl;
         try {
             // Map CLI string to use_buchi flag and BuchiMode enum
-            bool use_buchi_flag = true;
-            Syft::BuchiSolver::BuchiMode mode = Syft::BuchiSolver::BuchiMode::CLASSIC;
-
-            if (buechi_mode_str == "wg" || buechi_mode_str == "weak" || buechi_mode_str == "weak-game") {
-                use_buchi_flag = false; // use SCC-based weak-game solver
-            } else {
-                // When selecting a Büchi-based solver, set the enum appropriately
-                if (buechi_mode_str == "pm" || buechi_mode_str == "piterman") {
-                    mode = Syft::BuchiSolver::BuchiMode::PITERMAN;
-                } else if (buechi_mode_str == "cb" || buechi_mode_str == "cobuchi") {
-                    mode = Syft::BuchiSolver::BuchiMode::COBUCHI;
-                } else {
-                    // default to classic if unrecognised but not wg
-                    mode = Syft::BuchiSolver::BuchiMode::CLASSIC;
-                }
-            }
+            auto [use_buchi_flag, mode] = obligation_mode(buechi_mode_str);
 
             Syft::ObligationLTLfPlusSynthesizer obligation_synthesizer(
                 ltlf_plus_formula,
@@ -190,17 +1063,41 @@ int main(int argc, char** argv) {
                 Syft::Player::Agent,
                 use_buchi_flag,
                 mode,
-                MinimisationOptions{!disable_minimisation, minimisation_threshold, symbolic_threshold},
-                /*use_balanced_boolean_product=*/!legacy_boolean_product
+                minimisation_options,
+                /*use_balanced_boolean_product=*/!legacy_boolean_product,
+                var_mgr_options
             );
-            auto synthesis_result = obligation_synthesizer.run();
+            Syft::ELSynthesisResult synthesis_result;
+            try {
+                synthesis_result = obligation_synthesizer.run();
+            } catch (const Syft::BudgetExceeded& e) {
+                return report_budget_exceeded(e, obligation_synthesizer.var_mgr()->stats(), "obligation",
+                                              buechi_mode_str);
+            }
+            if (print_stats) {
+                obligation_synthesizer.var_mgr()->stats().print_json(std::cout);
+            }
+            store_result(synthesis_result.realizability, synthesis_result.transducer.get());
 
             if (synthesis_result.realizability) {
                 std::cout << "LTLf+ synthesis is REALIZABLE" << std::endl;
+                if (!save_strategy_file.empty()) {
+                    // Only arenas solved by the explicit game solver come with a transducer
+                    if (!synthesis_result.transducer) {
+                        spdlog::warn("No strategy to export, the arena was not solved explicitly");
+                    } else {
+                        Syft::CompiledTransducer(*synthesis_result.transducer).save(save_strategy_file);
+                        spdlog::info("Wrote {}", save_strategy_file);
+                    }
+                }
             } else {
                 std::cout << "LTLf+ synthesis is UNREALIZABLE" << std::endl;
             }
             print_times();
+            if (!write_json_result(synthesis_result.realizability ? "REALIZABLE" : "UNREALIZABLE", "obligation",
+                                   buechi_mode_str, &obligation_synthesizer.var_mgr()->stats())) {
+                return 1;
+            }
         } catch (const std::runtime_error& e) {
             std::cerr << "Error: " << e.what() << std::endl;
             std::cerr << "The formula is not in the obligation fragment. Use a different synthesizer." << std::endl;
@@ -209,20 +1106,94 @@ int main(int argc, char** argv) {
         return 0;
     }
 
+    if (game_solver == 0 && both_orders) {
+        Syft::LTLfPlusSynthesizer synthesizer(ltlf_plus_formula, partition, starting_player, Syft::Player::Agent,
+                                              var_mgr_options, dfa_options);
+        std::pair<Syft::ELSynthesisResult, Syft::ELSynthesisResult> results;
+        try {
+            results = synthesizer.run_both_orders();
+        } catch (const Syft::BudgetExceeded& e) {
+            return report_budget_exceeded(e, synthesizer.var_mgr()->stats(), solver_name().first,
+                                          solver_name().second);
+        }
+        if (print_stats) {
+            synthesizer.var_mgr()->stats().print_json(std::cout);
+        }
+        std::string agent_first = results.first.realizability ? "REALIZABLE" : "UNREALIZABLE";
+        std::string environment_first = results.second.realizability ? "REALIZABLE" : "UNREALIZABLE";
+        std::cout << "LTLf+ synthesis with the agent first is " << agent_first << std::endl;
+        std::cout << "LTLf+ synthesis with the environment first is " << environment_first << std::endl;
+        print_times();
+        if (!write_json_result(starting_player == Syft::Player::Agent ? agent_first : environment_first,
+                               solver_name().first, solver_name().second, &synthesizer.var_mgr()->stats(),
+                               "both orders: agent first " + agent_first + ", environment first " +
+                               environment_first)) {
+            return 1;
+        }
+        return 0;
+    }
+
     if (game_solver == 0) {
         Syft::LTLfPlusSynthesizer synthesizer(
             ltlf_plus_formula,
             partition,
             starting_player,
-            Syft::Player::Agent
+            Syft::Player::Agent,
+            var_mgr_options,
+            dfa_options
         );
-        auto synthesis_result = synthesizer.run();
+        Syft::ELSynthesisResult synthesis_result;
+        try {
+            synthesis_result = synthesizer.run();
+        } catch (const Syft::BudgetExceeded& e) {
+            return report_budget_exceeded(e, synthesizer.var_mgr()->stats(), solver_name().first,
+                                          solver_name().second);
+        }
+        if (print_stats) {
+            synthesizer.var_mgr()->stats().print_json(std::cout);
+        }
+        store_result(synthesis_result.realizability, synthesis_result.transducer.get());
+        if (!write_json_result(synthesis_result.realizability ? "REALIZABLE" : "UNREALIZABLE", solver_name().first,
+                               solver_name().second, &synthesizer.var_mgr()->stats())) {
+            return 1;
+        }
 
             if (synthesis_result.realizability) {
             std::cout << "LTLf+ synthesis is REALIZABLE" << std::endl;
                         print_times();
 
-            if (verbose) {
+            bool export_strategy = !export_c_file.empty() || !export_verilog_file.empty() ||
+                                   !save_strategy_file.empty();
+            if (export_strategy && !synthesis_result.transducer) {
+                spdlog::warn("No symbolic strategy to export, run with --symbolic-strategy");
+            } else if (!save_strategy_file.empty()) {
+                Syft::CompiledTransducer(*synthesis_result.transducer).save(save_strategy_file);
+                spdlog::info("Wrote {}", save_strategy_file);
+            }
+            if (synthesis_result.transducer && (!export_c_file.empty() || !export_verilog_file.empty())) {
+                Syft::TransducerCodegen codegen(*synthesis_result.transducer);
+                const Syft::CodegenReport& report = codegen.report();
+                spdlog::info("Exporting the strategy: {} BDD nodes, {} circuit nodes, {} temporaries",
+                             report.bdd_nodes, report.circuit_nodes, report.temporaries);
+                for (const auto& [file, verilog] : {std::make_pair(export_c_file, false),
+                                                    std::make_pair(export_verilog_file, true)}) {
+                    if (file.empty()) {
+                        continue;
+                    }
+                    std::string code = verilog ? codegen.to_verilog("strategy") : codegen.to_c("strategy");
+                    std::ofstream out(file);
+                    if (!out.is_open()) {
+                        throw std::runtime_error("Error: Could not open file for writing: " + file);
+                    }
+                    out << code;
+                    spdlog::info("Wrote {} ({} bytes)", file, code.size());
+                }
+            }
+            if (verbose && synthesis_result.transducer) {
+                std::cout << "Strategy: transducer with " << synthesis_result.transducer->get_output_function().size()
+                          << " output functions and " << synthesis_result.transducer->get_transition_function().size()
+                          << " transition functions" << std::endl;
+            } else if (verbose) {
                 std::cout << "Strategy:" << std::endl;
                 for (auto item : synthesis_result.output_function) {
                     std::cout << "state: " << item.gameNode;
@@ -242,7 +1213,7 @@ int main(int argc, char** argv) {
         }
     } else {
         if ((game_solver != 1) & (game_solver != 2)) {
-            std::cout << "Please specify a correct game solver. \nGame:\nManna-Pnueli-Adv=2;\nManna-Pnueli=1;\nEmerson-Lei=0" << std::endl;
+            std::cout << "Please specify a correct game solver. \nGame:\nLayered-Emerson-Lei=5;\nSymbolic-Emerson-Lei=4;\nParity=3;\nManna-Pnueli-Adv=2;\nManna-Pnueli=1;\nEmerson-Lei=0" << std::endl;
             return 0;
         }
             std::cout << "Using MP solvers" << std::endl;
@@ -252,16 +1223,36 @@ int main(int argc, char** argv) {
         partition,
         starting_player,
         Syft::Player::Agent,
-        game_solver
+        game_solver,
+        var_mgr_options,
+        dfa_options
     );
             std::cout << "Running MP solver" << std::endl;
 
-        auto synthesis_result_MP = synthesizerMP.run();
+        Syft::MPSynthesisResult synthesis_result_MP;
+        try {
+            synthesis_result_MP = synthesizerMP.run();
+        } catch (const Syft::BudgetExceeded& e) {
+            return report_budget_exceeded(e, synthesizerMP.var_mgr()->stats(), solver_name().first,
+                                          solver_name().second);
+        }
+        if (print_stats) {
+            synthesizerMP.var_mgr()->stats().print_json(std::cout);
+        }
+        store_result(synthesis_result_MP.realizability, synthesis_result_MP.transducer.get());
+        if (!write_json_result(synthesis_result_MP.realizability ? "REALIZABLE" : "UNREALIZABLE",
+                               solver_name().first, solver_name().second, &synthesizerMP.var_mgr()->stats())) {
+            return 1;
+        }
             if (synthesis_result_MP.realizability) {
             std::cout << "LTLf+ synthesis is REALIZABLE" << std::endl;
                         print_times();
 
-            if (verbose) {
+            if (verbose && synthesis_result_MP.transducer) {
+                std::cout << "Strategy: transducer with " << synthesis_result_MP.transducer->get_output_function().size()
+                          << " output functions and " << synthesis_result_MP.transducer->get_transition_function().size()
+                          << " transition functions" << std::endl;
+            } else if (verbose) {
                 std::cout << "Strategy:" << std::endl;
                 for (auto item : synthesis_result_MP.output_function) {
                     std::cout << "state: " << item.gameNode;
@@ -34,6 +34,7 @@ int main(int argc, char ** argv) {
     std::optional<std::string> env_safety_file;
     std::optional<std::string> agent_safety_file;
     std::string path_to_slugs;
+    bool frontier_fixpoints = false;
 
     // 'synthesis' subcommand
     CLI::App *synthesis = app.add_subcommand("synthesis", "solve a classical LTLf synthesis problem");
@@ -50,12 +51,14 @@ int main(int argc, char ** argv) {
     Syft::add_spec_file_option(fairness, formula_file);
     Syft::add_syfco_option(fairness, path_to_syfco_opt);
     Syft::add_assumption_file_option(fairness, assumption_file);
+    Syft::add_frontier_fixpoints_option(fairness, frontier_fixpoints);
 
     // 'stability' subcommand
     CLI::App *stability = app.add_subcommand("stability", "solve LTLf synthesis with stability assumptions");
     Syft::add_spec_file_option(stability, formula_file);
     Syft::add_syfco_option(stability, path_to_syfco_opt);
     Syft::add_assumption_file_option(stability, assumption_file);
+    Syft::add_frontier_fixpoints_option(stability, frontier_fixpoints);
 
     // 'gr1' subcommand
     CLI::App *gr1 = app.add_subcommand("gr1", "Solve LTLf synthesis with GR(1) conditions");
@@ -84,10 +87,10 @@ int main(int argc, char ** argv) {
         Syft::MaxSetRunner(driver, formula_file, path_to_syfco, print_strategy, print_times).run();
     }
     else if (app.got_subcommand(fairness)) {
-        Syft::FairnessRunner(driver, formula_file, path_to_syfco, assumption_file, print_strategy, print_times).run();
+        Syft::FairnessRunner(driver, formula_file, path_to_syfco, assumption_file, frontier_fixpoints, print_strategy, print_times).run();
     }
     else if (app.got_subcommand(stability)) {
-        Syft::StabilityRunner(driver, formula_file, path_to_syfco, assumption_file, print_times, print_times).run();
+        Syft::StabilityRunner(driver, formula_file, path_to_syfco, assumption_file, frontier_fixpoints, print_times, print_times).run();
     }
     else if (app.got_subcommand(gr1)) {
         Syft::GR1Runner(driver, formula_file, path_to_syfco, path_to_slugs, gr1_file, env_safety_file, agent_safety_file, print_strategy, print_times).run();
@@ -1,13 +1,20 @@
+#include <chrono>
+#include <ctime>
+#include <fstream>
 #include <memory>
+#include <optional>
 
 #include "Preprocessing.h"
+#include "SynthesisReport.h"
 #include "Utils.h"
 #include <lydia/logic/ppltl/base.hpp>
 #include <lydia/parser/ppltl/driver.hpp>
 #include <lydia/logic/nnf.hpp>
 #include <lydia/logic/ynf.hpp>
 #include "automata/SymbolicStateDfa.h"
+#include "automata/ppltl/PPLTLDfaLibrary.h"
 #include "automata/ppltl/ValVisitor.h"
+#include "game/InputOutputPartition.h"
 
 void interactive(const Syft::SymbolicStateDfa& d) {
     auto state = d.initial_state();
@@ -88,6 +95,72 @@ void interactive(const Syft::SymbolicStateDfa& d) {
 
 int main(int argc, char** argv) {
 
+    // --variable-order dependency places each state bit next to the variables its transition depends on
+    Syft::PPLTLVariableOrder variable_order = Syft::PPLTLVariableOrder::Creation;
+    // --json-result writes the size and construction statistics of the DFA of the formula
+    std::string json_result_file;
+    // --batch converts the formulas of a file, one per line, into a DFA library in --output-dir
+    std::string batch_file, output_directory, partition_file;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--variable-order" && i + 1 < argc) {
+            std::string order = argv[++i];
+            if (order == "dependency") variable_order = Syft::PPLTLVariableOrder::Dependency;
+            else if (order != "creation") throw std::runtime_error("Invalid variable order: " + order);
+        } else if (arg == "--json-result" && i + 1 < argc) {
+            json_result_file = argv[++i];
+        } else if (arg == "--batch" && i + 1 < argc) {
+            batch_file = argv[++i];
+        } else if (arg == "--output-dir" && i + 1 < argc) {
+            output_directory = argv[++i];
+        } else if ((arg == "-p" || arg == "--partition-file") && i + 1 < argc) {
+            partition_file = argv[++i];
+        } else {
+            throw std::runtime_error("Usage: " + std::string(argv[0]) +
+                                     " [--variable-order creation|dependency] [--json-result FILE]"
+                                     " [--batch FILE --output-dir DIR [-p PARTITION_FILE]]");
+        }
+    }
+
+    if (!batch_file.empty()) {
+        if (output_directory.empty()) {
+            throw std::runtime_error("--batch needs --output-dir");
+        }
+        std::ifstream in(batch_file);
+        if (!in.is_open()) {
+            throw std::runtime_error("Could not open formula file: " + batch_file);
+        }
+        std::vector<std::string> formulas;
+        std::string line;
+        while (std::getline(in, line)) {
+            if (line.find_first_not_of(" \t\r") != std::string::npos) formulas.push_back(line);
+        }
+        std::optional<Syft::InputOutputPartition> partition;
+        if (!partition_file.empty()) partition = Syft::InputOutputPartition::read_from_file(partition_file);
+
+        Syft::VarMgrOptions var_mgr_options;
+        var_mgr_options.collect_stats = !json_result_file.empty();
+        std::shared_ptr<Syft::VarMgr> var_mgr = std::make_shared<Syft::VarMgr>(var_mgr_options);
+        auto start = std::chrono::steady_clock::now();
+        const std::clock_t c_start = std::clock();
+        Syft::PPLTLDfaLibrary library = Syft::PPLTLDfaLibrary::compile(
+            formulas, output_directory, var_mgr, partition ? &*partition : nullptr, variable_order);
+        std::cout << "Converted " << formulas.size() << " formulas into " << library.size() << " DFAs over "
+                  << var_mgr->total_state_variable_count() << " state variables in " << output_directory
+                  << "/manifest.jsonl" << std::endl;
+        if (!json_result_file.empty()) {
+            var_mgr->snapshot_stats("DFA construction");
+            var_mgr->record_size("library_dfas", static_cast<double>(library.size()));
+            Syft::SynthesisReport report;
+            report.tool = "PPLTL2SDFA";
+            report.wall_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            report.cpu_time = double(std::clock() - c_start) / double(CLOCKS_PER_SEC);
+            report.stats = &var_mgr->stats();
+            report.write(json_result_file);
+        }
+        return 0;
+    }
+
     // PPLTL Driver
     std::shared_ptr<whitemech::lydia::AbstractDriver> driver;
     driver = std::make_shared<whitemech::lydia::parsers::ppltl::PPLTLDriver>();
@@ -117,13 +190,28 @@ int main(int argc, char** argv) {
     std::cout << "YNF: " << s_ynf << std::endl;
 
     // symbolic DFA construction
-    std::shared_ptr<Syft::VarMgr> var_mgr = std::make_shared<Syft::VarMgr>();
+    Syft::VarMgrOptions var_mgr_options;
+    var_mgr_options.collect_stats = !json_result_file.empty();
+    std::shared_ptr<Syft::VarMgr> var_mgr = std::make_shared<Syft::VarMgr>(var_mgr_options);
     std::shared_ptr<Syft::VarMgr> var_mgr2 = std::make_shared<Syft::VarMgr>();
 
-    auto sdfa = Syft::SymbolicStateDfa::dfa_of_ppltl_formula(*ppltl, var_mgr);
+    auto start = std::chrono::steady_clock::now();
+    const std::clock_t c_start = std::clock();
+    auto sdfa = Syft::SymbolicStateDfa::dfa_of_ppltl_formula(*ppltl, var_mgr, nullptr, variable_order);
+    if (!json_result_file.empty()) {
+        var_mgr->snapshot_stats("DFA construction");
+        // The DFA of the formula is the arena a synthesizer would play on
+        var_mgr->record_size("arena_state_bits", static_cast<double>(sdfa.transition_function().size()));
+        Syft::SynthesisReport report;
+        report.tool = "PPLTL2SDFA";
+        report.wall_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        report.cpu_time = double(std::clock() - c_start) / double(CLOCKS_PER_SEC);
+        report.stats = &var_mgr->stats();
+        report.write(json_result_file);
+    }
     auto edfa = Syft::SymbolicStateDfa::get_exists_dfa(sdfa);
     auto adfa = Syft::SymbolicStateDfa::get_forall_dfa(sdfa);
-    auto adfa_no_loops = Syft::SymbolicStateDfa::dfa_of_ppltl_formula_remove_initial_self_loops(*ppltl, var_mgr2);
+    auto adfa_no_loops = Syft::SymbolicStateDfa::dfa_of_ppltl_formula_remove_initial_self_loops(*ppltl, var_mgr2, nullptr, variable_order);
 
     // print alphabet and state variables
     sdfa.var_mgr()->print_mgr();
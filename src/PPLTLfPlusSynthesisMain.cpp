@@ -1,7 +1,13 @@
+#include <chrono>
+#include <ctime>
 #include <memory>
+#include "SynthesisReport.h"
+#include "game/DagWorkQueue.h"
 #include "game/InputOutputPartition.h"
+#include "automata/ppltl/PPLTLDfaLibrary.h"
 #include "Preprocessing.h"
 #include "Utils.h"
+#include "formula_file.h"
 #include <lydia/logic/ppltlplus/base.hpp>
 #include <lydia/logic/ppltlplus/duality.hpp>
 #include <lydia/parser/ppltlplus/driver.hpp>
@@ -20,6 +26,18 @@ int main(int argc, char** argv) {
     std::string ppltl_plus_file, partition_file;
     int starting_player_id, game_solver;
     std::string buechi_mode_str = "cl";
+    std::string reorder_mode_str = "off";
+    std::string bdd_backend_str = "cudd";
+    std::string reorder_method_str = "sift";
+    std::string proposition_order_str = "partition";
+    Syft::VarMgrOptions var_mgr_options;
+    std::size_t cudd_max_memory_mb = 0;
+    bool print_stats = false;
+    std::string mp_work_directory, mp_worker_directory;
+    std::string variable_order_str = "creation";
+    std::string care_simplification_str = "off";
+    std::string json_result_file;
+    std::string dfa_manifest_file;
 
     CLI::Option* ppltl_plus_file_opt;
     app.add_option("-i,--input-file", ppltl_plus_file, "Path to PPLTL+ formula file")->
@@ -40,22 +58,132 @@ int main(int argc, char** argv) {
         app.add_option("-b,--buechi-mode", buechi_mode_str, "Buechi solver mode: cl (classic) or pm (piterman)")
             ->default_val("cl");
 
+    app.add_option("--reorder", reorder_mode_str,
+                   "BDD variable reordering: off, auto (CUDD dynamic reordering) or phase (reorder after DFA construction and after the arena product)")
+        ->default_val("off")
+        ->check(CLI::IsMember({"off", "auto", "phase"}));
+    app.add_option("--reorder-method", reorder_method_str,
+                   "BDD variable reordering method: sift, sift-converge, symm-sift, group-sift, window, annealing, genetic, exact")
+        ->default_val("sift")
+        ->check(CLI::IsMember({"sift", "sift-converge", "symm-sift", "group-sift", "window", "annealing", "genetic", "exact"}));
+
+    app.add_option("--proposition-order", proposition_order_str,
+                   "Initial order of the input and output variables: partition (as in the partition file) or force "
+                   "(FORCE heuristic over the variables of the subformulas)")
+        ->default_val("partition")
+        ->check(CLI::IsMember({"partition", "force"}));
+
+    app.add_option("--cudd-unique-slots", var_mgr_options.unique_slots,
+                   "Initial number of slots of each CUDD unique subtable")
+        ->default_val(CUDD_UNIQUE_SLOTS);
+    app.add_option("--cudd-cache-slots", var_mgr_options.cache_slots,
+                   "Initial number of slots of the CUDD computed table")
+        ->default_val(CUDD_CACHE_SLOTS);
+    app.add_option("--cudd-max-cache", var_mgr_options.max_cache_hard,
+                   "Maximum number of slots of the CUDD computed table (0 = CUDD default)")
+        ->default_val(0);
+    app.add_option("--cudd-max-memory", cudd_max_memory_mb,
+                   "Memory target and hard limit of the CUDD manager in MB (0 = CUDD default)")
+        ->default_val(0);
+    app.add_option("--cudd-loose-up-to", var_mgr_options.loose_up_to,
+                   "Unique table size up to which CUDD grows eagerly instead of collecting garbage (0 = CUDD default)")
+        ->default_val(0);
+    app.add_option("--bdd-backend", bdd_backend_str,
+                   "BDD package of the game fixpoints: cudd, or sylvan (multi-threaded; needs a build with "
+                   "-DLYDIASYFT_ENABLE_SYLVAN=ON)")
+        ->default_val("cudd")
+        ->check(CLI::IsMember({"cudd", "sylvan"}));
+    app.add_option("--bdd-threads", var_mgr_options.bdd_threads,
+                   "Threads of the sylvan BDD backend (0 = one per core)")
+        ->default_val(0);
+    app.add_option("--variable-order", variable_order_str,
+                   "Initial order of the DFA state variables: creation (at the top, as the subformulas are found) or "
+                   "dependency (each next to the atoms and subformulas its transition depends on)")
+        ->default_val("creation")
+        ->check(CLI::IsMember({"creation", "dependency"}));
+    app.add_option("--care-simplification", care_simplification_str,
+                   "Simplify the transitions and colors outside the states reachable from the initial state, over "
+                   "which the game is then solved: off, restrict or licompaction")
+        ->default_val("off")
+        ->check(CLI::IsMember({"off", "restrict", "licompaction"}));
+    app.add_flag("--stats", print_stats,
+                 "Print BDD engine statistics of each synthesis phase as JSON");
+    app.add_option("--mp-work-dir", mp_work_directory,
+                   "Directory shared with worker processes started with --mp-worker, which then solve the nodes of the "
+                   "Manna-Pnueli DAG (MP solver)");
+    app.add_option("--mp-worker", mp_worker_directory,
+                   "Run as a worker solving the Manna-Pnueli DAG nodes published in this directory by a coordinator "
+                   "started with --mp-work-dir, then exit; the formula is not read");
+    app.add_option("--json-result", json_result_file,
+                   "Write the verdict, the solver, the phase times and BDD statistics and the arena, Zielonka tree "
+                   "and DAG sizes of the run to this file as JSON (see SynthesisReport)");
+    app.add_option("--dfas", dfa_manifest_file,
+                   "Manifest of a DFA library written by PPLTL2SDFA --batch; the colors whose PPLTL argument is in it "
+                   "load its DFA instead of building it")
+        ->check(CLI::ExistingFile);
+
     CLI11_PARSE(app, argc, argv);
 
-    // parse and process input PPLTL+ formula
-    // read formula
-    std::string pplf_plus_formula_str;
-    std::ifstream pplf_plus_formula_stream(ppltl_plus_file);
-    getline(pplf_plus_formula_stream, pplf_plus_formula_str);
-    std::cout << "PPLTL+ formula: " << pplf_plus_formula_str << std::endl;
+    var_mgr_options.reorder_policy =
+        Syft::ReorderPolicy::from_string(reorder_mode_str, reorder_method_str);
+    try {
+        var_mgr_options.bdd_backend = Syft::bdd_backend_from_string(bdd_backend_str);
+    } catch (const std::runtime_error& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    var_mgr_options.proposition_order = proposition_order_str == "force" ? Syft::PropositionOrder::Force
+                                                                         : Syft::PropositionOrder::Partition;
+    var_mgr_options.max_memory = cudd_max_memory_mb * 1024 * 1024;
+    // The phase snapshots are part of the JSON result
+    var_mgr_options.collect_stats = print_stats || !json_result_file.empty();
+    Syft::PPLTLVariableOrder variable_order = variable_order_str == "dependency"
+                                                  ? Syft::PPLTLVariableOrder::Dependency
+                                                  : Syft::PPLTLVariableOrder::Creation;
+    Syft::StrategyMinimization care_simplification = Syft::strategy_minimization_from_string(care_simplification_str);
+    if (!mp_worker_directory.empty()) {
+        std::size_t solved = Syft::DagWorkQueue::serve(mp_worker_directory, var_mgr_options);
+        std::cout << "Manna-Pnueli worker solved " << solved << " DAG nodes" << std::endl;
+        return 0;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    const std::clock_t c_start = std::clock();
+    // Writes the --json-result of the run, if one was requested; returns false if it could not be written
+    auto write_json_result = [&](bool realizability, const Syft::SolverStats &stats) {
+        if (json_result_file.empty()) {
+            return true;
+        }
+        Syft::SynthesisReport report;
+        report.tool = "PLydiaSyftEL";
+        report.formula_file = ppltl_plus_file;
+        report.partition_file = partition_file;
+        report.verdict = realizability ? "REALIZABLE" : "UNREALIZABLE";
+        report.solver = game_solver == 0 ? "emerson-lei" : game_solver == 1 ? "manna-pnueli" : "manna-pnueli-adv";
+        report.agent_starts = starting_player_id != 0;
+        report.wall_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        report.cpu_time = double(std::clock() - c_start) / double(CLOCKS_PER_SEC);
+        report.stats = &stats;
+        try {
+            report.write(json_result_file);
+        } catch (const std::runtime_error &e) {
+            std::cerr << e.what() << std::endl;
+            return false;
+        }
+        return true;
+    };
 
+    // parse and process input PPLTL+ formula
     // PPLTL+ driver
     std::shared_ptr<whitemech::lydia::parsers::ppltlplus::PPLTLPlusDriver> driver = 
         std::make_shared<whitemech::lydia::parsers::ppltlplus::PPLTLPlusDriver>();
 
-    // parse formula
-    std::stringstream formula_stream(pplf_plus_formula_str);
-    driver->parse(formula_stream);
+    // parse formula, read in place from the mapped file, which is released once parsed
+    {
+        Syft::FormulaFile formula_file(ppltl_plus_file);
+        std::cout << "PPLTL+ formula: " << formula_file.formula() << std::endl;
+        driver->parse(formula_file.stream());
+    }
     auto result = driver->get_result();
 
     // cast ast_ptr into ppltl_plus_ptr
@@ -98,6 +226,16 @@ int main(int argc, char** argv) {
     }
     Syft::InputOutputPartition partition =
         Syft::InputOutputPartition::read_from_file(partition_file);
+    std::shared_ptr<const Syft::PPLTLDfaLibrary> dfa_library;
+    if (!dfa_manifest_file.empty()) {
+        try {
+            dfa_library = std::make_shared<Syft::PPLTLDfaLibrary>(Syft::PPLTLDfaLibrary::read_manifest(dfa_manifest_file));
+        } catch (const std::runtime_error& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+        std::cout << "DFA library: " << dfa_library->size() << " formulas" << std::endl;
+    }
 
     // show result
     if (game_solver == 0) 
@@ -106,10 +244,20 @@ int main(int argc, char** argv) {
             ppltl_plus_formula,
             partition,
             starting_player,
-            Syft::Player::Agent);
+            Syft::Player::Agent,
+            var_mgr_options);
+        synthesizer.set_variable_order(variable_order);
+        synthesizer.set_dfa_library(dfa_library);
+        synthesizer.set_care_simplification(care_simplification);
     
         // do synthesis
         auto synthesis_result = synthesizer.run();
+        if (print_stats) {
+            synthesizer.var_mgr()->stats().print_json(std::cout);
+        }
+        if (!write_json_result(synthesis_result.realizability, synthesizer.var_mgr()->stats())) {
+            return 1;
+        }
 
         if (synthesis_result.realizability) {
             std::cout << "PPLTL+ synthesis is REALIZABLE" << std::endl;
@@ -136,10 +284,21 @@ int main(int argc, char** argv) {
             partition,
             starting_player,
             Syft::Player::Agent,
-            game_solver
+            game_solver,
+            var_mgr_options
         );
+        synthesizerMP.set_work_directory(mp_work_directory);
+        synthesizerMP.set_variable_order(variable_order);
+        synthesizerMP.set_dfa_library(dfa_library);
+        synthesizerMP.set_care_simplification(care_simplification);
 
         auto synthesis_result_MP = synthesizerMP.run();
+        if (print_stats) {
+            synthesizerMP.var_mgr()->stats().print_json(std::cout);
+        }
+        if (!write_json_result(synthesis_result_MP.realizability, synthesizerMP.var_mgr()->stats())) {
+            return 1;
+        }
         if (synthesis_result_MP.realizability) {
             std::cout << "PPLTL+ synthesis is REALIZABLE" << std::endl;
         } else {
@@ -39,6 +39,13 @@ namespace Syft {
         }
     }
 
+    void Printer::print_iterations_if_enabled(const std::string &message, std::size_t outer_iterations,
+                                              std::size_t inner_iterations) const {
+        if (print_times_) {
+            out_ << message << ": " << outer_iterations << " outer, " << inner_iterations << " inner" << std::endl;
+        }
+    }
+
     void add_assumption_file_option(CLI::App *app, std::string &assumption_file) {
         app->add_option("-a,--assumption-file", assumption_file, "Assumption file")->required()->check(
                 CLI::ExistingFile);
@@ -68,10 +75,16 @@ namespace Syft {
     }
 
     void add_slugs_option(CLI::App *app, std::string &path_to_slugs) {
-        app->add_option("-S,--slugs-path", path_to_slugs, "Path to Slugs root directory")
+        app->add_option("-S,--slugs-path", path_to_slugs, "Path to Slugs root directory; without it, the GR(1) game is solved natively")
         ->check(CLI::ExistingDirectory);
     }
 
+    void add_frontier_fixpoints_option(CLI::App *app, bool &frontier_fixpoints) {
+        app->add_flag("--frontier-fixpoints", frontier_fixpoints,
+                      "Warm-start the inner fixpoints from the previous outer iteration and only re-examine the "
+                      "predecessors of the last changed states (default: false)");
+    }
+
     bool BaseRunner::handle_preprocessing_result_(const OneStepSynthesisResult &one_step_result,
                                                   Stopwatch &total_time_stopwatch) const {
         bool preprocessing_success = one_step_result.realizability.has_value();
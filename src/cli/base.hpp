@@ -48,6 +48,9 @@ namespace Syft {
 
         void print_times_if_enabled(const std::string &message, std::chrono::milliseconds time) const;
 
+        void print_iterations_if_enabled(const std::string &message, std::size_t outer_iterations,
+                                         std::size_t inner_iterations) const;
+
         void print_realizable() const { out_ << Syft::REALIZABLE_STR << std::endl; }
 
         void print_unrealizable() const { out_ << Syft::UNREALIZABLE_STR << std::endl; }
@@ -69,6 +72,8 @@ namespace Syft {
 
     void add_slugs_option(CLI::App *, std::string &);
 
+    void add_frontier_fixpoints_option(CLI::App *, bool &);
+
     /**
      * \brief Base class for running a synthesis algorithm.
      */
@@ -46,7 +46,10 @@ namespace Syft {
         Syft::StabilityLtlfSynthesizer synthesizer(symbolic_dfa, args_.starting_player,
                                                    args_.protagonist_player, symbolic_dfa.final_states(),
                                                    var_mgr_->cudd_mgr()->bddOne(), assumption_filename_);
+        synthesizer.set_fixpoint_mode(frontier_fixpoints_ ? FixpointMode::Frontier : FixpointMode::Full);
         Syft::SynthesisResult result = synthesizer.run();
+        printer_.print_iterations_if_enabled("Stability fixpoint iterations", synthesizer.outer_iterations(),
+                                             synthesizer.fixpoint_trace().iterations());
         handle_synthesis_result_(result);
     }
 }
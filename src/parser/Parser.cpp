@@ -8,6 +8,9 @@
 #include <fstream>
 #include <filesystem>
 #include <algorithm>
+#include <cctype>
+#include <map>
+#include <sstream>
 
 
 namespace Syft {
@@ -15,19 +18,163 @@ namespace Syft {
     Parser::Parser()
     {}
 
+    namespace {
+        std::string strip_comments(const std::string &text) {
+            std::string result;
+            for (std::size_t i = 0; i < text.size(); ++i) {
+                if (text.compare(i, 2, "//") == 0) {
+                    i = text.find('\n', i);
+                    if (i == std::string::npos) {
+                        break;
+                    }
+                    result += '\n';
+                } else if (text.compare(i, 2, "/*") == 0) {
+                    i = text.find("*/", i + 2);
+                    if (i == std::string::npos) {
+                        break;
+                    }
+                    i++;
+                    result += ' ';
+                } else {
+                    result += text[i];
+                }
+            }
+            return result;
+        }
+
+        // The sections NAME { ... } of text, or nothing if braces are nested in a section or unbalanced
+        std::optional<std::vector<std::pair<std::string, std::string>>> sections(const std::string &text,
+                                                                                 bool nested) {
+            std::vector<std::pair<std::string, std::string>> result;
+            std::size_t position = 0;
+            while (true) {
+                std::size_t open = text.find('{', position);
+                if (open == std::string::npos) {
+                    if (!Syft::trim(text.substr(position)).empty()) {
+                        return std::nullopt;
+                    }
+                    return result;
+                }
+                std::string name = Syft::trim(text.substr(position, open - position));
+                std::size_t depth = 1;
+                std::size_t close = open + 1;
+                for (; close < text.size() && depth > 0; ++close) {
+                    if (text[close] == '{') {
+                        depth++;
+                    } else if (text[close] == '}') {
+                        depth--;
+                    }
+                }
+                if (depth != 0 || name.empty() || (!nested && text.substr(open + 1, close - open - 2).find('{') !=
+                                                              std::string::npos)) {
+                    return std::nullopt;
+                }
+                result.emplace_back(name, text.substr(open + 1, close - open - 2));
+                position = close;
+            }
+        }
+
+        std::vector<std::string> statements(const std::string &body) {
+            std::vector<std::string> result;
+            for (const std::string &statement : Syft::split(body, ";")) {
+                std::string trimmed = Syft::trim(statement);
+                if (!trimmed.empty()) {
+                    result.push_back(trimmed);
+                }
+            }
+            return result;
+        }
+
+        bool is_signal(const std::string &name) {
+            if (name.empty() || !(std::isalpha(static_cast<unsigned char>(name[0])) || name[0] == '_')) {
+                return false;
+            }
+            return std::all_of(name.begin(), name.end(), [](char c) {
+                return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '\'' || c == '@';
+            });
+        }
+
+        std::string conjunction(const std::vector<std::string> &formulas) {
+            if (formulas.empty()) {
+                return "true";
+            }
+            std::string result;
+            for (const std::string &formula : formulas) {
+                result += (result.empty() ? "(" : " && (") + formula + ")";
+            }
+            return formulas.size() == 1 ? result : "(" + result + ")";
+        }
+    }
+
+    std::optional<Parser> Parser::parse_basic_tlsf(const std::string &text) {
+        auto top = sections(strip_comments(text), true);
+        if (!top || top->size() != 2 || (*top)[0].first != "INFO" || (*top)[1].first != "MAIN") {
+            return std::nullopt;
+        }
+
+        Parser parser;
+        std::optional<std::string> target;
+        for (const std::string &line : Syft::split((*top)[0].second, "\n")) {
+            std::size_t colon = line.find(':');
+            if (colon != std::string::npos && Syft::trim(line.substr(0, colon)) == "TARGET") {
+                target = Syft::trim(line.substr(colon + 1));
+            }
+        }
+        if (!target || (*target != "Mealy" && *target != "Moore")) {
+            return std::nullopt;
+        }
+        parser.sys_first = *target == "Moore";
+
+        auto main = sections((*top)[1].second, false);
+        if (!main) {
+            return std::nullopt;
+        }
+        std::map<std::string, std::vector<std::string>> parts;
+        for (const auto &[name, body] : *main) {
+            if ((name != "INPUTS" && name != "OUTPUTS" && name != "ASSUMPTIONS" && name != "GUARANTEES") ||
+                parts.count(name) > 0) {
+                return std::nullopt;
+            }
+            parts[name] = statements(body);
+        }
+        for (const std::string &signals : {"INPUTS", "OUTPUTS"}) {
+            if (!std::all_of(parts[signals].begin(), parts[signals].end(), is_signal)) {
+                return std::nullopt;
+            }
+        }
+        parser.input_variables = parts["INPUTS"];
+        parser.output_variables = parts["OUTPUTS"];
+        std::string guarantees = conjunction(parts["GUARANTEES"]);
+        parser.formula = parts["ASSUMPTIONS"].empty() ? guarantees
+                                                      : conjunction(parts["ASSUMPTIONS"]) + " -> " + guarantees;
+        return parser;
+    }
+
     std::string Parser::exec(const char* cmd) {
         std::shared_ptr<FILE> pipe(popen(cmd, "r"), pclose);
         if (!pipe) return "ERROR";
-        char buffer[128];
+        char buffer[4096];
         std::string result = "";
-        while (!feof(pipe.get())) {
-            if (fgets(buffer, 128, pipe.get()) != NULL)
-                result += buffer;
+        std::size_t read;
+        while ((read = fread(buffer, 1, sizeof(buffer), pipe.get())) > 0) {
+            result.append(buffer, read);
         }
         return result;
     }
 
     Parser Parser::read_from_file(const std::string &syfco_location, const std::string &filename) {
+        std::ifstream in(filename);
+        if (in.is_open()) {
+            std::stringstream text;
+            text << in.rdbuf();
+            if (std::optional<Parser> parser = parse_basic_tlsf(text.str())) {
+                return *parser;
+            }
+        }
+        return read_with_syfco(syfco_location, filename);
+    }
+
+    Parser Parser::read_with_syfco(const std::string &syfco_location, const std::string &filename) {
         Parser parser;
 
         // check whether the path is absolute or relative
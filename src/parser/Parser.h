@@ -5,7 +5,9 @@
 #ifndef LYDIASYFT_APARSER_H
 #define LYDIASYFT_APARSER_H
 
+#include <optional>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
 namespace Syft {
@@ -22,6 +24,8 @@ namespace Syft {
         bool sys_first;
 
         std::string exec(const char* cmd);
+
+        static Parser read_with_syfco(const std::string &syfco_location, const std::string &filename);
         std::string ltrim(const std::string &s);
 
         std::string rtrim(const std::string &s);
@@ -37,10 +41,24 @@ namespace Syft {
 
         /**
          * \brief Obtain an LTLf formula and construct a partition from a TLSF file.
+         *
+         * Files in the basic fragment of TLSF (see parse_basic_tlsf) are read
+         * directly; syfco is only run on the others.
          * \param filename The name of the TLSF file.
          */
         static Parser read_from_file(const std::string &syfco_location, const std::string &filename);
 
+        /**
+         * \brief Parses TLSF text in the basic fragment, or returns nothing if it is outside it.
+         *
+         * The fragment is an INFO section and a MAIN section holding only INPUTS,
+         * OUTPUTS, ASSUMPTIONS and GUARANTEES, with plain signal names and no
+         * parameters, GLOBAL section or other specification types. As with
+         * syfco -m fully, the formula is the conjunction of the assumptions
+         * implying the conjunction of the guarantees, each kept as written.
+         */
+        static std::optional<Parser> parse_basic_tlsf(const std::string &text);
+
         /**
          * \brief Return input variables in a vector.
          */
@@ -0,0 +1,118 @@
+#ifndef BATCH_RUNNER_H
+#define BATCH_RUNNER_H
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "FlatJson.h"
+
+namespace Syft {
+
+/**
+ * \brief A spec of a batch: a formula, its partition and the options that differ from the command line.
+ */
+struct BatchJob {
+  std::string id;             ///< Reported with the result; the formula file if not given
+  std::string formula_file;
+  std::string partition_file;
+  // Unset options take the value given on the command line
+  std::optional<int> starting_player;
+  std::optional<int> game_solver;
+  std::optional<bool> obligation_simplification;
+  std::optional<std::string> buechi_mode;
+  std::optional<double> time_limit;   ///< In seconds, 0 = unlimited
+};
+
+/**
+ * \brief The outcome of a BatchJob.
+ */
+struct BatchResult {
+  std::string id;
+  std::string verdict;        ///< REALIZABLE, UNREALIZABLE, UNKNOWN (budget exceeded) or ERROR
+  std::string detail;         ///< The exhausted budget or the error, if any
+  double wall_time = 0;       ///< In seconds
+  double cpu_time = 0;        ///< In seconds, of the process that solved the job
+
+  /**
+   * \brief Returns the result as one line of JSON, without the newline.
+   */
+  std::string to_json() const;
+};
+
+/**
+ * \brief Reads a job from one object of a JSONL manifest (see read_batch_manifest).
+ *
+ * Relative paths are resolved against \a base_directory. Throws
+ * std::runtime_error on unknown fields, fields of the wrong type and jobs
+ * without a formula or a partition.
+ */
+BatchJob batch_job_from_json(const JsonObject& object, const std::string& base_directory, std::size_t line = 1);
+
+/**
+ * \brief Reads the jobs of a batch from \a path.
+ *
+ * If \a path is a directory, every *.ltlfplus file below it is a job, whose
+ * partition is the .part file of the same name and whose id is its path
+ * relative to the directory, without the extension. Otherwise \a path is a
+ * JSONL manifest: one flat JSON object per non-empty line, with the fields
+ * "formula" and "partition" and optionally "id", "starting_player",
+ * "game_solver", "obligation_simplification", "buechi_mode" and
+ * "time_limit", named and valued as the command line options. Relative paths
+ * are resolved against the directory of the manifest.
+ *
+ * Throws std::runtime_error on a malformed manifest, with its line number.
+ */
+std::vector<BatchJob> read_batch_manifest(const std::string& path);
+
+/**
+ * \brief Calls \a solve on \a job and times it.
+ *
+ * Sets the id and the times of the result. An exception thrown by \a solve
+ * gives an ERROR result with its message.
+ */
+BatchResult solve_batch_job(const BatchJob& job, const std::function<BatchResult(const BatchJob&)>& solve);
+
+/**
+ * \brief Solves the jobs of a batch in one process, or on a pool of worker processes.
+ *
+ * The solve function is called once per job and may keep state between
+ * jobs, e.g. parsed partitions and sessions whose DFAs are reused by later
+ * specs. With more than one worker, the jobs are dealt round-robin to forked
+ * children, since neither CUDD nor MONA is thread-safe; each child keeps the
+ * state of the jobs it solved, and sends back its results through a pipe as
+ * they are done. A job whose solve throws gets an ERROR result, as do the
+ * remaining jobs of a worker that dies.
+ */
+class BatchRunner {
+ public:
+
+  typedef std::function<BatchResult(const BatchJob&)> Solver;
+  typedef std::function<void(const BatchResult&)> Reporter;
+
+  /**
+   * \param workers The number of worker processes; 0 or 1 solves the jobs in this process.
+   */
+  explicit BatchRunner(std::size_t workers = 1);
+
+  /**
+   * \brief Solves \a jobs and calls \a report once per job, as results arrive.
+   *
+   * The id and the times of each result are set by the runner. Results come
+   * in the order of the jobs with one worker, and in completion order
+   * otherwise. Returns the number of results that are not ERROR.
+   */
+  std::size_t run(const std::vector<BatchJob>& jobs, const Solver& solve, const Reporter& report) const;
+
+ private:
+
+  std::size_t workers_;
+
+  std::size_t run_pool(const std::vector<BatchJob>& jobs, const Solver& solve, const Reporter& report) const;
+};
+
+}
+
+#endif // BATCH_RUNNER_H
@@ -0,0 +1,81 @@
+#ifndef BDD_ARCHIVE_H
+#define BDD_ARCHIVE_H
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "cuddObj.hh"
+
+#include "Synthesizer.h"
+#include "VarMgr.h"
+
+namespace Syft {
+
+/**
+ * \brief BDDs over one state space, saved in CUDD's dddmp binary format.
+ *
+ * An archive file starts with a small text header recording what the archive
+ * holds, the variable layout (index and name of each input and output
+ * variable, index of each state variable) and a few integers, followed by the
+ * BDDs as one dddmp binary array. On load, input and output variables are
+ * matched by name and state variables by position, so archives can be loaded
+ * into a different variable manager, e.g. on another machine.
+ */
+    struct BddArchive {
+        std::string kind;                ///< What the archive holds, e.g. "symbolic-dfa"
+        std::size_t automaton_id = 0;    ///< The state space of the BDDs
+        std::vector<int> values;         ///< Integers stored alongside the BDDs
+        std::vector<CUDD::BDD> bdds;     ///< The stored BDDs
+        /// Whether the layout only records the input and output variables the BDDs depend on, so that the
+        /// archive loads into managers without the others, e.g. a DFA of a library over a larger alphabet
+        bool support_only = false;
+
+        /**
+         * \brief Saves the archive, whose BDDs are over the state variables of automaton_id.
+         */
+        void save(const std::string &filename, const std::shared_ptr<VarMgr> &var_mgr) const;
+
+        /**
+         * \brief Loads an archive into \a var_mgr.
+         *
+         * \param filename The archive file.
+         * \param var_mgr The variable manager of the loaded BDDs. It must already
+         *   have every input and output variable of the archive.
+         * \param automaton_id The state space onto which the stored state
+         *   variables are mapped, bit by bit. If not given, fresh state variables
+         *   are created.
+         * \throws std::runtime_error if the file cannot be read or does not
+         *   match \a var_mgr.
+         */
+        static BddArchive load(const std::string &filename,
+                               const std::shared_ptr<VarMgr> &var_mgr,
+                               std::optional<std::size_t> automaton_id = std::nullopt);
+    };
+
+/**
+ * \brief Saves the realizability, the winning states and the winning moves of each Zielonka tree node.
+ *
+ * The nodes are stored in preorder, so the result can only be loaded back
+ * into the Zielonka tree of the same color formula.
+ */
+    void save_el_synthesis_result(const std::string &filename,
+                                  const std::shared_ptr<VarMgr> &var_mgr,
+                                  std::size_t automaton_id,
+                                  const ELSynthesisResult &result);
+
+/**
+ * \brief Loads a result saved by save_el_synthesis_result onto the state space \a automaton_id.
+ *
+ * If result.z_tree is set, the winning moves of its nodes are restored as
+ * well, e.g. to extract a strategy without solving again.
+ */
+    void load_el_synthesis_result(const std::string &filename,
+                                  const std::shared_ptr<VarMgr> &var_mgr,
+                                  std::size_t automaton_id,
+                                  ELSynthesisResult &result);
+
+}
+
+#endif // BDD_ARCHIVE_H
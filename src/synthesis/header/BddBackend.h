@@ -0,0 +1,135 @@
+#ifndef BDD_BACKEND_H
+#define BDD_BACKEND_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cuddObj.hh"
+
+namespace Syft {
+
+/**
+ * \brief The BDD packages a VarMgr can run the fixpoint operations on.
+ *
+ * Cudd runs them in the CUDD manager of the VarMgr. Sylvan, available when
+ * built with LYDIASYFT_WITH_SYLVAN (the LYDIASYFT_ENABLE_SYLVAN option), runs
+ * them on Sylvan's parallel unique table with its work-stealing operations.
+ */
+enum class BddBackendKind {
+  Cudd,
+  Sylvan
+};
+
+/**
+ * \brief Returns the backend named \a name, "cudd" or "sylvan".
+ *
+ * Throws std::runtime_error for an unknown name, or for "sylvan" in a build
+ * without Sylvan.
+ */
+BddBackendKind bdd_backend_from_string(const std::string& name);
+
+/**
+ * \brief One quantification of a controllable predecessor: forall \a cube if \a universal, exists \a cube otherwise.
+ */
+struct BddQuantifier {
+  bool universal = false;
+  CUDD::BDD cube;
+};
+
+/**
+ * \brief The least fixpoint of X = X | (care & Q(X composed with vector)), from \a start.
+ *
+ * Q applies \a quantifiers in order, as the controllable predecessor of a
+ * GameKernel (see GameKernel::quantifiers). The iteration also stops at the
+ * first iterate that intersects \a stop, e.g. the initial state, or after
+ * \a max_steps iterations if it is not 0. \a on_iteration, if set, runs
+ * before each iteration, e.g. to check the budget of the VarMgr.
+ */
+struct ControllableFixpoint {
+  CUDD::BDD start;
+  CUDD::BDD care;
+  std::vector<CUDD::BDD> vector;
+  std::vector<BddQuantifier> quantifiers;
+  CUDD::BDD stop;
+  std::size_t max_steps = 0;
+  std::function<void()> on_iteration;
+};
+
+/**
+ * \brief Runs the BDD operations of the solver fixpoints.
+ *
+ * The operands and results are BDDs of the CUDD manager of the backend, which
+ * every other part of the project keeps using. A backend other than CUDD
+ * translates the operands into its own package, where it keeps the
+ * translation of the BDDs that stay the same across fixpoint iterations (the
+ * transition functions and cubes), and translates the results back.
+ *
+ * Backends are created by VarMgr (see VarMgrOptions::bdd_backend) and used
+ * through VarMgr::bdd_backend, e.g. by DfaGameSynthesizer::preimage and the
+ * Quantification of the Emerson-Lei solver.
+ */
+class BddBackend {
+ public:
+  virtual ~BddBackend() = default;
+
+  /**
+   * \brief Returns the name of the backend, as accepted by bdd_backend_from_string.
+   */
+  virtual std::string name() const = 0;
+
+  /**
+   * \brief Returns the number of threads each operation may use.
+   */
+  virtual std::size_t threads() const = 0;
+
+  virtual CUDD::BDD And(const CUDD::BDD& f, const CUDD::BDD& g) const = 0;
+  virtual CUDD::BDD Or(const CUDD::BDD& f, const CUDD::BDD& g) const = 0;
+  virtual CUDD::BDD ExistAbstract(const CUDD::BDD& f, const CUDD::BDD& cube) const = 0;
+  virtual CUDD::BDD UnivAbstract(const CUDD::BDD& f, const CUDD::BDD& cube) const = 0;
+
+  /**
+   * \brief Returns exists \a cube. f & g.
+   */
+  virtual CUDD::BDD AndAbstract(const CUDD::BDD& f, const CUDD::BDD& g, const CUDD::BDD& cube) const = 0;
+
+  /**
+   * \brief Substitutes \a vector[i] for the variable of index i in \a f, as CUDD::BDD::VectorCompose.
+   */
+  virtual CUDD::BDD VectorCompose(const CUDD::BDD& f, const std::vector<CUDD::BDD>& vector) const = 0;
+
+  /**
+   * \brief Returns the value of \a f under \a assignment, one value per variable index.
+   */
+  virtual bool Eval(const CUDD::BDD& f, const std::vector<int>& assignment) const = 0;
+
+  /**
+   * \brief Returns the last iterate of \a fixpoint.
+   *
+   * By default each iteration runs the operations above. A backend other than
+   * CUDD overrides it to translate the operands once and keep the iterates in
+   * its own package, translating back only the result.
+   */
+  virtual CUDD::BDD LeastFixpoint(const ControllableFixpoint& fixpoint) const;
+};
+
+/**
+ * \brief Creates a backend of \a kind for the BDDs of \a mgr.
+ *
+ * \param threads The threads of a Sylvan backend, 0 for one per core. Sylvan
+ *   is started once per process, by the first Sylvan backend created, with
+ *   the threads of that backend.
+ */
+std::unique_ptr<BddBackend> make_bdd_backend(BddBackendKind kind, std::shared_ptr<CUDD::Cudd> mgr,
+                                             std::size_t threads = 0);
+
+/**
+ * \brief Creates a Sylvan backend; defined in SylvanBackend.cpp if built with LYDIASYFT_WITH_SYLVAN.
+ */
+std::unique_ptr<BddBackend> make_sylvan_backend(std::shared_ptr<CUDD::Cudd> mgr, std::size_t threads);
+
+}
+
+#endif // BDD_BACKEND_H
@@ -0,0 +1,120 @@
+#ifndef BDD_CUBES_H
+#define BDD_CUBES_H
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include "cuddObj.hh"
+
+namespace Syft {
+
+/**
+ * \brief The disjoint cubes of a BDD, as enumerated by Cudd_FirstCube and Cudd_NextCube.
+ *
+ * Each cube is an array indexed by variable index, with 0 or 1 for a
+ * variable of the cube and 2 for a variable it does not mention; it is valid
+ * until the iterator is incremented. The generator is freed with the object,
+ * also when the enumeration stops early, and the BDD is kept alive until then.
+ *
+ *   for (const int* cube : BddCubes(states)) { ... }
+ */
+class BddCubes {
+ public:
+
+  class iterator {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = const int*;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const int* const*;
+    using reference = const int*;
+
+    const int* operator*() const { return cubes_->cube_; }
+    iterator& operator++() {
+      cubes_->next();
+      return *this;
+    }
+    bool operator==(const iterator& other) const { return done() == other.done(); }
+    bool operator!=(const iterator& other) const { return !(*this == other); }
+
+   private:
+    friend class BddCubes;
+    explicit iterator(BddCubes* cubes) : cubes_(cubes) {}
+    bool done() const { return cubes_ == nullptr || cubes_->done_; }
+
+    BddCubes* cubes_;
+  };
+
+  explicit BddCubes(const CUDD::BDD& bdd);
+  ~BddCubes();
+
+  BddCubes(const BddCubes&) = delete;
+  BddCubes& operator=(const BddCubes&) = delete;
+
+  /**
+   * \brief Starts the enumeration; there is a single pass per object.
+   */
+  iterator begin() { return iterator(this); }
+  iterator end() { return iterator(nullptr); }
+
+  /**
+   * \brief Returns whether the BDD has no cube, i.e. is the zero BDD.
+   */
+  bool empty() const { return done_; }
+
+ private:
+
+  CUDD::BDD bdd_;
+  DdGen* generator_ = nullptr;
+  int* cube_ = nullptr;
+  bool done_ = true;
+
+  void next();
+};
+
+/**
+ * \brief Picks minterms of BDDs over a fixed set of variables.
+ *
+ * The variable indices are resolved once, at construction, so that a pick
+ * only reads the first cube of its BDD and builds the minterm with
+ * Cudd_bddComputeCube, instead of looking up each variable by name. Like the
+ * first cube, picks are deterministic; variables the cube does not mention
+ * are set to true.
+ */
+class MintermPicker {
+ public:
+
+  MintermPicker() = default;
+
+  /**
+   * \brief A picker of minterms over \a variables, e.g. the state variables of an automaton.
+   */
+  MintermPicker(std::shared_ptr<CUDD::Cudd> mgr, const std::vector<CUDD::BDD>& variables);
+
+  /**
+   * \brief Returns a minterm over the variables of the picker that, extended, satisfies \a bdd.
+   *
+   * Throws std::runtime_error if \a bdd is the zero BDD.
+   */
+  CUDD::BDD pick(const CUDD::BDD& bdd) const;
+
+  /**
+   * \brief Returns the minterm over the variables of the picker with the values of \a cube.
+   *
+   * \param cube An array indexed by variable index, as enumerated by BddCubes.
+   */
+  CUDD::BDD minterm(const int* cube) const;
+
+ private:
+
+  std::shared_ptr<CUDD::Cudd> mgr_;
+  std::vector<CUDD::BDD> variables_;
+  std::vector<DdNode*> nodes_;
+  std::vector<int> indices_;
+};
+
+}
+
+#endif // BDD_CUBES_H
@@ -0,0 +1,85 @@
+#ifndef BENCHMARK_FAMILIES_H
+#define BENCHMARK_FAMILIES_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "DifferentialFuzzer.h"
+#include "game/InputOutputPartition.h"
+#include "Player.h"
+
+namespace Syft {
+
+/**
+ * \brief One spec of a parametric benchmark family, with the verdict it is built to have.
+ */
+struct BenchmarkInstance {
+  std::string family;
+  std::size_t size = 0;
+  std::string formula;
+  InputOutputPartition partition;
+  /** \brief The verdict for both starting players. */
+  bool realizable = false;
+  /** \brief Whether the formula is in the obligation fragment, which the obligation solvers take. */
+  bool obligation = false;
+
+  /** \brief The identifier of the instance, "<family>/<size>". */
+  std::string id() const;
+};
+
+/**
+ * \brief A family of LTLf+ specs parameterised by a size n >= 1.
+ *
+ * The verdict of every member is known by construction, and does not depend
+ * on the starting player: the winning strategies never need the inputs of the
+ * current step.
+ */
+struct BenchmarkFamily {
+  std::string name;
+  std::string description;
+  std::function<BenchmarkInstance(std::size_t)> generate;
+};
+
+/**
+ * \brief Returns the families of LydiaSyftGen.
+ *
+ * - counter: an n-bit counter incremented by the environment reaches its
+ *   maximum if the environment increments infinitely often; realizable, with
+ *   an arena of 2^n states.
+ * - counter-unrealizable: the same without the assumption.
+ * - obligation-chain: n eventual requests and grants, consecutive grants
+ *   mutually exclusive; realizable, in the obligation fragment.
+ * - obligation-chain-unrealizable: the same, with the first grant forbidden
+ *   while requested.
+ * - gr1: n recurrent requests imply n recurrent grants, pairwise mutually
+ *   exclusive; realizable.
+ * - gr1-unrealizable: the same, with the first grant forbidden while requested.
+ * - nested: implications between persistent requests and recurrent grants,
+ *   nested n deep; realizable.
+ * - nested-unrealizable: the same, with the outermost grant forbidden while
+ *   requested.
+ */
+const std::vector<BenchmarkFamily>& benchmark_families();
+
+/**
+ * \brief Returns the family named \a name; throws std::runtime_error on an unknown name.
+ */
+const BenchmarkFamily& benchmark_family(const std::string& name);
+
+/**
+ * \brief Parses \a instance into the lydia AST of a FuzzSpec, e.g. to solve it in this process.
+ */
+FuzzSpec parse_instance(const BenchmarkInstance& instance, Player starting_player);
+
+/**
+ * \brief Writes \a instance as <directory>/<family>/<family>_<size>.ltlfplus and .part.
+ *
+ * \return The path of the formula file; the partition file has the same stem.
+ */
+std::string write_instance(const BenchmarkInstance& instance, const std::string& directory);
+
+}
+
+#endif // BENCHMARK_FAMILIES_H
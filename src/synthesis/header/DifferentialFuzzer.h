@@ -0,0 +1,180 @@
+#ifndef DIFFERENTIAL_FUZZER_H
+#define DIFFERENTIAL_FUZZER_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <lydia/parser/ltlfplus/driver.hpp>
+
+#include "game/InputOutputPartition.h"
+#include "Player.h"
+#include "Synthesizer.h"
+#include "VarMgr.h"
+
+namespace Syft {
+
+/**
+ * \brief Generates random LTLf+ specs, as scripts/head2head.py does.
+ *
+ * LTLf formulas are built over the atoms p0, p1, ... with the operators of
+ * head2head.py; LTLf+ formulas are Boolean combinations of their A, E, AE and
+ * EA quantifications, positive ones only in the obligation fragment.
+ */
+class RandomSpecGenerator {
+ public:
+
+  RandomSpecGenerator(unsigned int seed, std::size_t atoms);
+
+  /**
+   * \brief Returns a random LTLf formula of depth at most \a depth.
+   */
+  std::string ltlf(std::size_t depth);
+
+  /**
+   * \brief Returns a random LTLf+ formula.
+   *
+   * \param boolean_depth The depth of the Boolean combination of quantified formulas.
+   * \param ltlf_depth The depth of the quantified LTLf formulas.
+   * \param obligation Whether only positive combinations of A and E are generated.
+   */
+  std::string ltlf_plus(std::size_t boolean_depth, std::size_t ltlf_depth, bool obligation);
+
+  /**
+   * \brief Splits the atoms into inputs and outputs, each with at least one atom if there are two.
+   */
+  InputOutputPartition partition();
+
+  const std::vector<std::string>& atoms() const { return atoms_; }
+
+ private:
+
+  std::mt19937 random_;
+  std::vector<std::string> atoms_;
+
+  // Returns true with probability \a p
+  bool chance(double p);
+  const std::string& any_atom();
+};
+
+/**
+ * \brief A parsed spec, as handed to every configuration of a DifferentialFuzzer.
+ */
+struct FuzzSpec {
+  std::string formula;
+  /** \brief The parser of the formula, which owns the nodes of ltlf_plus. */
+  std::shared_ptr<whitemech::lydia::parsers::ltlfplus::LTLfPlusDriver> driver;
+  LTLfPlus ltlf_plus;
+  InputOutputPartition partition;
+  Player starting_player = Player::Agent;
+  /** \brief Whether the formula is in the obligation fragment (see ObligationFragmentDetector). */
+  bool obligation = false;
+};
+
+/**
+ * \brief A configuration of the solvers, run on every instance of a DifferentialFuzzer.
+ */
+struct FuzzConfiguration {
+  std::string name;
+  /** \brief Returns the verdict on the spec; throws BudgetExceeded past the budget of the options. */
+  std::function<bool(const FuzzSpec&, const VarMgrOptions&)> solve;
+  /** \brief Whether the configuration only takes specs in the obligation fragment. */
+  bool obligation_only = false;
+};
+
+/**
+ * \brief Returns the configurations named in \a names, e.g. "emerson-lei" or "obligation-wg".
+ *
+ * The names are those of the portfolio entries of LydiaSyftEL, with
+ * "emerson-lei-monolithic" for the Emerson-Lei game without decomposition and
+ * "parity", "symbolic-colors" and "scc-layers" for the Emerson-Lei pipeline
+ * solved as a parity game, by SymbolicEmersonLei and by LayeredEmersonLei. Throws
+ * std::runtime_error on an unknown name.
+ */
+std::vector<FuzzConfiguration> fuzz_configurations(const std::vector<std::string>& names);
+
+/**
+ * \brief The names accepted by fuzz_configurations.
+ */
+std::vector<std::string> fuzz_configuration_names();
+
+/**
+ * \brief What a DifferentialFuzzer looks for, and where it keeps what it finds.
+ */
+struct FuzzOptions {
+  double time_limit = 10;       ///< Per configuration and instance, in seconds
+  double differential = 2.0;    ///< Ratio of the slowest to the fastest run that makes a performance cliff
+  double min_seconds = 0.05;    ///< Cliffs whose slowest run is faster than this are noise
+  std::size_t repeats = 3;      ///< Runs of each configuration of a suspected cliff, whose medians must confirm it
+  std::string corpus_directory; ///< Where mismatches and cliffs are saved; nothing is saved if empty
+  VarMgrOptions var_mgr_options; ///< Of every run, whose budget also gets the time limit
+};
+
+/**
+ * \brief The runs of the configurations of a DifferentialFuzzer on one spec.
+ */
+struct FuzzOutcome {
+  std::string id;
+  /** \brief The verdict of each configuration, none if it timed out or does not apply. */
+  std::vector<std::optional<bool>> verdicts;
+  /** \brief The median time of each configuration in seconds, the time limit if it timed out, 0 if it does not apply. */
+  std::vector<double> seconds;
+  std::vector<bool> applicable;
+  /** \brief Whether two configurations returned different verdicts. */
+  bool mismatch = false;
+  /** \brief The ratio of the slowest to the fastest applicable configuration. */
+  double differential = 1;
+  std::size_t fastest = 0;
+  std::size_t slowest = 0;
+  /** \brief Whether the differential was confirmed by the repeats. */
+  bool cliff = false;
+};
+
+/**
+ * \brief Runs several solver configurations against the same parsed specs.
+ *
+ * Every configuration solves the spec in this process, on a VarMgr of its
+ * own, under the time limit of the options: the measurements have none of the
+ * process startup or parsing of one binary per run. Configurations whose
+ * verdicts differ are a correctness mismatch. A spec on which the slowest
+ * configuration takes more than FuzzOptions::differential times the fastest is
+ * measured again, and is a performance cliff if the medians agree. Mismatches
+ * and cliffs are saved to the corpus directory as a .ltlfplus formula, a .part
+ * partition, so that LydiaSyftEL --batch replays them, and a .json with the
+ * verdicts and timings.
+ */
+class DifferentialFuzzer {
+ public:
+
+  DifferentialFuzzer(std::vector<FuzzConfiguration> configurations, FuzzOptions options = FuzzOptions());
+
+  /**
+   * \brief Parses \a formula into a FuzzSpec.
+   */
+  static FuzzSpec parse(const std::string& formula, const InputOutputPartition& partition, Player starting_player);
+
+  /**
+   * \brief Runs every configuration on \a spec, and saves it to the corpus if it is a mismatch or a cliff.
+   */
+  FuzzOutcome run(const FuzzSpec& spec, const std::string& id) const;
+
+  const std::vector<FuzzConfiguration>& configurations() const { return configurations_; }
+
+ private:
+
+  std::vector<FuzzConfiguration> configurations_;
+  FuzzOptions options_;
+
+  // Runs configuration \a index once: its verdict, none on timeout, and its time in seconds
+  std::pair<std::optional<bool>, double> measure(std::size_t index, const FuzzSpec& spec) const;
+  void save(const FuzzSpec& spec, const FuzzOutcome& outcome) const;
+};
+
+}
+
+#endif // DIFFERENTIAL_FUZZER_H
@@ -0,0 +1,47 @@
+#ifndef FLAT_JSON_H
+#define FLAT_JSON_H
+
+#include <cstddef>
+#include <map>
+#include <string>
+
+namespace Syft {
+
+/**
+ * \brief A scalar JSON value: the values of the line protocols of the batch runner and the daemon.
+ */
+struct JsonValue {
+  enum class Kind {String, Number, Bool, Null};
+  Kind kind = Kind::Null;
+  std::string text;
+  double number = 0;
+  bool boolean = false;
+};
+
+typedef std::map<std::string, JsonValue> JsonObject;
+
+/**
+ * \brief Parses \a text as one JSON object whose values are all scalars.
+ *
+ * Throws std::runtime_error on malformed input, duplicate fields and nested
+ * values, naming \a line in the message.
+ */
+JsonObject parse_json_object(const std::string& text, std::size_t line = 1);
+
+/**
+ * \brief Returns the field \a name of \a object, or nullptr if it is missing or null.
+ *
+ * A Bool field may also be given as a number, as on the command line. Throws
+ * std::runtime_error if the field has another kind.
+ */
+const JsonValue* json_field(const JsonObject& object, const std::string& name, JsonValue::Kind kind,
+                            std::size_t line = 1);
+
+/**
+ * \brief Returns \a text as a quoted and escaped JSON string.
+ */
+std::string json_quote(const std::string& text);
+
+}
+
+#endif // FLAT_JSON_H
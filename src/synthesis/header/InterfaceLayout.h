@@ -0,0 +1,80 @@
+#ifndef INTERFACE_LAYOUT_H
+#define INTERFACE_LAYOUT_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Synthesizer.h"
+#include "VarMgr.h"
+#include "game/InputOutputPartition.h"
+
+namespace Syft {
+
+/**
+ * \brief The interface of a family of specs: a parsed partition and the order of its variables.
+ *
+ * The synthesizers take either a partition or a layout, and build their
+ * VarMgr with instantiate. A layout is built once per partition, so that the
+ * jobs of a batch or of the daemon over the same interface do not parse and
+ * check the partition again. Copies are cheap and share the layout, which is
+ * immutable and holds no BDDs: each VarMgr still gets variables and cubes of
+ * its own, since BDDs cannot be shared between CUDD managers.
+ */
+class InterfaceLayout {
+ public:
+
+  /**
+   * \brief Lays out \a partition, inputs first, in the order of the partition.
+   *
+   * Throws std::runtime_error if a variable is listed twice, or both as an
+   * input and as an output.
+   */
+  explicit InterfaceLayout(InputOutputPartition partition);
+
+  /**
+   * \brief Reads the partition file \a filename; see InputOutputPartition::read_from_file.
+   */
+  static InterfaceLayout read_from_file(const std::string& filename);
+
+  const InputOutputPartition& partition() const {return layout_->partition;}
+
+  /**
+   * \brief Returns the inputs, then the outputs, as listed in the partition.
+   */
+  const std::vector<std::string>& partition_order() const {return layout_->order;}
+
+  /**
+   * \brief Returns the order in which the LTLf+ synthesizers create the variables for \a formula.
+   *
+   * The precomputed partition order unless \a order is PropositionOrder::Force,
+   * which depends on the subformulas of \a formula; see proposition_order.
+   */
+  std::vector<std::string> variable_order(const LTLfPlus& formula, PropositionOrder order) const;
+
+  /**
+   * \brief Returns a new VarMgr with the variables of the layout, created in \a order, and partitioned.
+   *
+   * The input and output cubes are computed before it is returned. \a order
+   * must be a permutation of the variables of the layout.
+   */
+  std::shared_ptr<VarMgr> instantiate(const VarMgrOptions& options, const std::vector<std::string>& order) const;
+
+  /**
+   * \brief Returns a new VarMgr with the variables created in the partition order.
+   */
+  std::shared_ptr<VarMgr> instantiate(const VarMgrOptions& options) const;
+
+ private:
+
+  struct Layout {
+    InputOutputPartition partition;
+    std::vector<std::string> order;
+  };
+
+  std::shared_ptr<const Layout> layout_;
+};
+
+}
+
+#endif // INTERFACE_LAYOUT_H
@@ -0,0 +1,68 @@
+#ifndef ONE_STEP_BDD_HPP
+#define ONE_STEP_BDD_HPP
+
+#include <memory>
+#include <optional>
+
+#include <lydia/logic/ltlf/base.hpp>
+#include <lydia/logic/ltlfplus/base.hpp>
+
+#include "Player.h"
+#include "VarMgr.h"
+
+namespace Syft {
+
+  /**
+  * \brief One-step checks of LTLf formulas computed with BDDs over the named variables of a VarMgr.
+  *
+  * BDD counterpart of the Z3 checks of OneStepRealizability.h and
+  * OneStepUnrealizability.h, without a solver per call: the first letters of
+  * a formula are built once as BDDs over the partitioned input and output
+  * variables, and the checks quantify them.
+  *
+  * Shengping Xiao, Jianwen Li, Shufang Zhu, Yingying Shi, Geguang Pu, Moshe Y. Vardi. "On-the-fly Synthesis for LTL over Finite Traces". AAAI 2021: 6530-6537
+  */
+  class OneStepBdd {
+  public:
+    /**
+     * \brief Creates a checker over \a var_mgr, whose input-output partition must be set.
+     */
+    explicit OneStepBdd(std::shared_ptr<VarMgr> var_mgr);
+
+    /**
+     * \brief Returns the letters whose one-letter trace satisfies \a formula.
+     */
+    CUDD::BDD satisfying_letters(const whitemech::lydia::LTLfFormula &formula) const;
+
+    /**
+     * \brief Returns an over-approximation of the first letters of the traces satisfying \a formula.
+     */
+    CUDD::BDD possible_letters(const whitemech::lydia::LTLfFormula &formula) const;
+
+    /**
+     * \brief Returns an agent move satisfying \a formula in one step whatever the environment does, if any.
+     */
+    std::optional<CUDD::BDD> realizable(const whitemech::lydia::LTLfFormula &formula) const;
+
+    /**
+     * \brief Whether the environment can violate \a formula in the first step.
+     */
+    bool unrealizable(const whitemech::lydia::LTLfFormula &formula, Player starting_player) const;
+
+    /**
+     * \brief Returns the value of the prefix-quantified \a formula if the first step decides it on every play.
+     *
+     * An E argument whose first letter always satisfies it holds on every play,
+     * and an A argument whose first letter never does fails on every play. An
+     * argument without satisfying trace fails whatever its quantifier.
+     */
+    std::optional<bool> constant_value(const whitemech::lydia::LTLfFormula &formula,
+                                       whitemech::lydia::PrefixQuantifier quantifier) const;
+
+  private:
+    std::shared_ptr<VarMgr> var_mgr_;
+  };
+
+}
+
+#endif //ONE_STEP_BDD_HPP
@@ -0,0 +1,72 @@
+#ifndef PORTFOLIO_H
+#define PORTFOLIO_H
+
+#include <chrono>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Syft {
+
+/**
+ * \brief A solver configuration run by a portfolio.
+ */
+struct PortfolioEntry {
+  std::string name;            ///< Name reported when the entry wins
+  std::function<bool()> solve; ///< Builds its own synthesizer and returns the realizability
+};
+
+/**
+ * \brief The verdict of the first entry of a portfolio to finish.
+ */
+struct PortfolioVerdict {
+  std::string winner;
+  bool realizability;
+  std::chrono::milliseconds elapsed;
+};
+
+/**
+ * \brief Runs solver configurations concurrently and keeps the first verdict.
+ *
+ * Each entry runs in a forked child process, so that it gets its own CUDD
+ * manager, VarMgr and MONA/Lydia global state, none of which is thread-safe.
+ * The verdict is passed back through the exit status. As soon as one child
+ * reports a verdict the others are sent SIGTERM, which requests cancellation
+ * at their next SolveBudget check, and are killed if they do not stop
+ * shortly after. Children that fail (e.g. an obligation solver on a formula
+ * outside the fragment) are ignored.
+ */
+class Portfolio {
+ private:
+
+  std::vector<PortfolioEntry> entries_;
+  bool quiet_children_;
+
+ public:
+
+  /**
+   * \brief Creates a portfolio.
+   *
+   * \param quiet_children Whether to discard the standard output and error of
+   *   the children, which would otherwise interleave.
+   */
+  explicit Portfolio(bool quiet_children = true);
+
+  /**
+   * \brief Adds a solver configuration.
+   */
+  void add(std::string name, std::function<bool()> solve);
+
+  /**
+   * \brief Runs all entries and returns the first verdict, or std::nullopt if every entry failed.
+   *
+   * Throws std::runtime_error if no child process could be started.
+   */
+  std::optional<PortfolioVerdict> run() const;
+
+};
+
+}
+
+#endif // PORTFOLIO_H
@@ -0,0 +1,84 @@
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include <optional>
+#include <string>
+
+#include "Player.h"
+#include "Synthesizer.h"
+#include "game/CompiledTransducer.h"
+#include "game/InputOutputPartition.h"
+#include "game/Transducer.h"
+
+namespace Syft {
+
+/**
+ * \brief A verdict found in a ResultCache, with the strategy stored alongside it, if any.
+ */
+struct CachedResult {
+  bool realizability = false;
+  std::optional<CompiledTransducer> strategy;
+};
+
+/**
+ * \brief A persistent cache of synthesis verdicts and strategies, keyed on the spec.
+ *
+ * The key (see cache_key) is a canonical string of the PNF result of the
+ * formula, the partition, the starting player and the solver options that
+ * may change the result, so that a spec regenerated or solved again, e.g. by
+ * a CI re-run, is answered without building its game. As in DfaCache, each
+ * entry is stored under the hash of its key together with a file holding the
+ * full key, so that hash collisions are detected on load; the verdict is a
+ * text file and the strategy, if any, a CompiledTransducer image.
+ */
+class ResultCache {
+ public:
+
+  /**
+   * \brief Creates a cache in \a directory, creating the directory if needed.
+   */
+  explicit ResultCache(std::string directory);
+
+  /**
+   * \brief Builds the cache key of \a spec.
+   *
+   * The colors are listed by color with their quantifier and the canonical
+   * lydia string of their formula, and the variables of the partition are
+   * sorted, so that the key depends neither on the order of the hash maps of
+   * the PNF result nor on the order of the partition file.
+   *
+   * \param solver_options The solver and the options that may change the
+   *   verdict or the strategy, e.g. "emerson-lei/scc-layers"; "" if none.
+   */
+  static std::string cache_key(const LTLfPlus& spec, const InputOutputPartition& partition, Player starting_player,
+                               const std::string& solver_options);
+
+  /**
+   * \brief Returns the result stored under \a key, if any.
+   *
+   * \param validate If set, the stored strategy, if any, is loaded and checked
+   *   against this partition instead of solving again: a strategy that cannot
+   *   be loaded, or whose inputs and outputs are not those of the partition,
+   *   makes the entry a miss. Verdicts stored without a strategy are returned
+   *   as they are.
+   */
+  std::optional<CachedResult> load(const std::string& key,
+                                   const InputOutputPartition* validate = nullptr) const;
+
+  /**
+   * \brief Stores \a realizability, and \a strategy if given, under \a key, replacing any previous entry.
+   *
+   * A strategy that CompiledTransducer cannot compile is left out.
+   */
+  void store(const std::string& key, bool realizability, const Transducer* strategy = nullptr) const;
+
+ private:
+
+  std::string directory_;
+
+  std::string entry_path(const std::string& key) const;
+};
+
+}
+
+#endif // RESULT_CACHE_H
@@ -0,0 +1,117 @@
+#ifndef SOLVE_BUDGET_H
+#define SOLVE_BUDGET_H
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+#include "cuddObj.hh"
+#include "SolverStats.h"
+
+namespace Syft {
+
+/**
+ * \brief Thrown when a run exhausts its SolveBudget.
+ *
+ * Carries which resource ran out, in which phase, and a snapshot of the BDD
+ * engine at that point, so that a bounded run still reports its diagnostics.
+ */
+class BudgetExceeded : public std::runtime_error {
+ private:
+
+  std::string resource_;
+  std::string phase_;
+  BddStatsSnapshot snapshot_;
+
+ public:
+
+  BudgetExceeded(std::string resource, std::string phase, BddStatsSnapshot snapshot);
+
+  /**
+   * \brief Returns the exhausted resource: "time", "nodes", "memory" or "cancelled".
+   */
+  const std::string& resource() const;
+
+  /**
+   * \brief Returns the phase during which the budget was exhausted.
+   */
+  const std::string& phase() const;
+
+  /**
+   * \brief Returns the state of the BDD engine when the budget was exhausted.
+   */
+  const BddStatsSnapshot& snapshot() const;
+};
+
+/**
+ * \brief Limits on the resources of one synthesis run.
+ *
+ * Solvers check the budget once per fixpoint iteration, and the construction
+ * phases at their boundaries, through VarMgr::check_budget. Limits of 0 are
+ * disabled; a default-constructed budget never runs out unless cancellation
+ * is requested.
+ */
+class SolveBudget {
+ private:
+
+  std::optional<std::chrono::steady_clock::time_point> deadline_;
+  long max_live_nodes_ = 0;
+  std::size_t max_rss_ = 0;
+  std::shared_ptr<const std::atomic<bool>> cancellation_token_;
+
+ public:
+
+  /**
+   * \brief Sets the deadline to \a time_limit from now.
+   */
+  void set_time_limit(std::chrono::milliseconds time_limit);
+
+  /**
+   * \brief Sets the maximum number of live BDD nodes.
+   */
+  void set_max_live_nodes(long max_live_nodes);
+
+  /**
+   * \brief Sets the maximum resident set size of the process, in bytes.
+   */
+  void set_max_rss(std::size_t max_rss);
+
+  /**
+   * \brief Makes checks throw once \a token is set, e.g. to cancel one job of a long-lived process.
+   *
+   * Unlike request_cancellation, only this budget and its copies are cancelled.
+   */
+  void set_cancellation_token(std::shared_ptr<const std::atomic<bool>> token);
+
+  /**
+   * \brief Throws BudgetExceeded if a limit is exceeded or cancellation was requested.
+   *
+   * \param mgr The manager whose live nodes are counted.
+   * \param phase The current phase, reported in the exception.
+   */
+  void check(const CUDD::Cudd& mgr, const std::string& phase) const;
+
+  /**
+   * \brief Makes every subsequent check throw; async-signal-safe.
+   *
+   * Cancellation is process-wide, e.g. requested from a SIGTERM handler.
+   */
+  static void request_cancellation();
+
+  /**
+   * \brief Returns whether cancellation was requested.
+   */
+  static bool cancellation_requested();
+
+  /**
+   * \brief Returns the resident set size of the process in bytes, or 0 if unknown.
+   */
+  static std::size_t current_rss();
+};
+
+}
+
+#endif // SOLVE_BUDGET_H
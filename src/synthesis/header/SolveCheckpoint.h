@@ -0,0 +1,88 @@
+#ifndef SOLVE_CHECKPOINT_H
+#define SOLVE_CHECKPOINT_H
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "cuddObj.hh"
+#include "Synthesizer.h"
+#include "VarMgr.h"
+#include "automata/SymbolicStateDfa.h"
+
+namespace Syft {
+
+/**
+ * \brief The progress of a long Emerson-Lei or Manna-Pnueli solve, saved to a directory so that it can be resumed.
+ *
+ * A checkpoint holds the game it belongs to (the solver and condition, the
+ * transitions and initial state of the arena, the colors and the state
+ * space), the winning states of the Manna-Pnueli DAG nodes solved so far, and
+ * the bounds of the last root iteration of an Emerson-Lei solve, all as
+ * BddArchive files. A preempted run started again with the same spec and
+ * options rebuilds its arena, finds it in the checkpoint (see attach) and
+ * continues from the last completed unit of work: solved DAG nodes are not
+ * solved again, and the root bounds become instantly winning and losing
+ * states of the Emerson-Lei game. Both are sound, so the verdict and winning
+ * states are those of an uninterrupted run; strategies are not saved, so
+ * checkpoints only apply when no strategy is extracted. Every file is written
+ * under a temporary name and renamed, so a run killed while saving leaves the
+ * previous checkpoint intact.
+ */
+class SolveCheckpoint {
+ public:
+
+  /**
+   * \brief Creates a checkpoint in \a directory, creating the directory if needed.
+   *
+   * \param interval The least time between two saves of the root bounds; DAG nodes are saved as they are solved.
+   */
+  SolveCheckpoint(std::string directory, std::shared_ptr<VarMgr> var_mgr,
+                  std::chrono::seconds interval = std::chrono::seconds(600));
+
+  /**
+   * \brief Binds the checkpoint to a game, and returns whether the directory holds progress of that game.
+   *
+   * The game is identified by \a description, e.g. the solver and its
+   * condition, and by the BDDs of \a arena, \a colors and \a state_space. If
+   * \a resume is false, or the directory holds no readable checkpoint of this
+   * game, its contents are cleared and the game is saved afresh.
+   */
+  bool attach(const std::string &description, const SymbolicStateDfa &arena, const std::vector<CUDD::BDD> &colors,
+              const CUDD::BDD &state_space, bool resume);
+
+  /**
+   * \brief Returns the verdict and winning states of DAG node \a node, if saved.
+   */
+  std::optional<ELSynthesisResult> load_node(int node) const;
+
+  /**
+   * \brief Saves the verdict and winning states of DAG node \a node.
+   */
+  void store_node(int node, const ELSynthesisResult &result) const;
+
+  /**
+   * \brief Returns the root bounds saved by the last store_root, if any.
+   */
+  std::optional<PartialSynthesisResult> load_root() const;
+
+  /**
+   * \brief Saves \a partial as the root bounds if the interval has elapsed since the last save, or if \a force is set.
+   */
+  void store_root(const PartialSynthesisResult &partial, bool force = false) const;
+
+ private:
+
+  std::string directory_;
+  std::shared_ptr<VarMgr> var_mgr_;
+  std::chrono::seconds interval_;
+  std::size_t automaton_id_ = 0;
+  bool attached_ = false;
+  mutable std::chrono::steady_clock::time_point last_root_save_;
+};
+
+}
+
+#endif // SOLVE_CHECKPOINT_H
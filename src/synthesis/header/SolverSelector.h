@@ -0,0 +1,133 @@
+#ifndef SOLVER_SELECTOR_H
+#define SOLVER_SELECTOR_H
+
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "InterfaceLayout.h"
+#include "Synthesizer.h"
+#include "VarMgr.h"
+#include "automata/DfaCache.h"
+#include "game/AcceptanceClass.h"
+
+namespace Syft {
+
+/**
+ * \brief Cheap features of a spec, read after the PNF and the construction of its color DFAs.
+ */
+struct SpecFeatures {
+  std::size_t colors = 0;
+  std::size_t forall = 0;         ///< A colors
+  std::size_t exists = 0;         ///< E colors
+  std::size_t forall_exists = 0;  ///< AE colors
+  std::size_t exists_forall = 0;  ///< EA colors
+  bool obligation = false;        ///< Whether the formula is in the obligation fragment
+  AcceptanceClass acceptance = AcceptanceClass::General;
+  std::size_t components = 0;     ///< Distinct color DFAs
+  std::size_t max_dfa_bits = 0;   ///< State variables of the largest DFA
+  std::size_t arena_bits = 0;     ///< State variables of the product arena
+  double max_dfa_states = 0;      ///< Reachable states of the largest DFA
+  double total_dfa_states = 0;    ///< Reachable states of all DFAs
+  std::size_t scc_layers = 0;     ///< SCC layers of the DFAs, summed
+
+  /**
+   * \brief Returns the features by name, as read by SolverSelector models.
+   */
+  std::map<std::string, double> values() const;
+
+  /**
+   * \brief Returns values as one JSON object, the input of scripts/train_solver_selector.py.
+   */
+  std::string to_json() const;
+};
+
+/**
+ * \brief Builds the DFAs of the colors of \a spec for the EL solver, and returns the features of the spec.
+ *
+ * Unless \a dfa_options has a shared cache, one is created and set in memory,
+ * so that the EL solver run afterwards with the same options reuses the DFAs.
+ */
+SpecFeatures extract_spec_features(const LTLfPlus& spec, bool obligation, const InterfaceLayout& layout,
+                                   const VarMgrOptions& var_mgr_options, DfaConstructionOptions& dfa_options);
+
+/**
+ * \brief The command line settings of a solver mode of perf/suite.json.
+ */
+struct SolverMode {
+  int game_solver = 0;
+  bool obligation_simplification = false;
+  std::string buechi_mode;
+};
+
+/**
+ * \brief Predicts the fastest solver mode of a spec from its features, with a decision tree.
+ *
+ * A model is a list of nodes, the first of which is the root. An inner node
+ * compares one feature (see SpecFeatures::values) with a threshold and
+ * continues at its below child if the value is at most the threshold, and at
+ * its above child otherwise; a leaf names a mode of perf/suite.json, e.g. "el"
+ * or "obligation-wg". Models are stored one node per line, as flat JSON
+ * objects: {"node": 0, "feature": "obligation", "threshold": 0.5, "below": 1,
+ * "above": 2} or {"node": 1, "solver": "el"}. The builtin model is that of
+ * perf/solver_model.jsonl; scripts/train_solver_selector.py retrains one from
+ * the results of scripts/perf_regression.py.
+ */
+class SolverSelector {
+ public:
+
+  struct Node {
+    std::string feature;
+    double threshold = 0;
+    std::size_t below = 0;
+    std::size_t above = 0;
+    std::string solver;  ///< The mode of a leaf; empty for inner nodes
+  };
+
+  /**
+   * \brief Creates a selector from the nodes of a model.
+   *
+   * Throws std::runtime_error unless every path from the root ends in a leaf
+   * naming a known mode (see solver_mode).
+   */
+  explicit SolverSelector(std::vector<Node> nodes);
+
+  /**
+   * \brief Returns the selector of the builtin model.
+   */
+  static SolverSelector builtin();
+
+  /**
+   * \brief Parses a model in the line format above; empty lines are skipped.
+   */
+  static SolverSelector parse(const std::string& text);
+
+  /**
+   * \brief Reads a model file in the line format above.
+   */
+  static SolverSelector load(const std::string& filename);
+
+  /**
+   * \brief Returns the predicted mode of \a features.
+   *
+   * Modes of the obligation solvers are only predicted for specs in the
+   * obligation fragment; otherwise the EL solver is. If \a explanation is
+   * given, it receives the comparisons on the path to the leaf.
+   */
+  std::string predict(const SpecFeatures& features, std::string* explanation = nullptr) const;
+
+  /**
+   * \brief Returns the settings of the mode \a name of perf/suite.json, or std::nullopt if it is unknown.
+   */
+  static std::optional<SolverMode> solver_mode(const std::string& name);
+
+ private:
+
+  std::vector<Node> nodes_;
+};
+
+}
+
+#endif // SOLVER_SELECTOR_H
@@ -0,0 +1,136 @@
+#ifndef SOLVER_STATS_H
+#define SOLVER_STATS_H
+
+#include <chrono>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "cuddObj.hh"
+
+namespace Syft {
+
+/**
+ * \brief The state of the BDD engine at the end of one synthesis phase.
+ *
+ * Counters are cumulative since the creation of the manager, and the peak
+ * resident set size since the start of the process, so that the phase that
+ * raised it is the first whose peak_rss_kb exceeds that of its predecessor.
+ */
+    struct BddStatsSnapshot {
+        std::string phase;
+        double elapsed_ms = 0;
+        long live_nodes = 0;
+        long peak_nodes = 0;
+        std::size_t memory_in_use = 0;
+        int garbage_collections = 0;
+        long garbage_collection_ms = 0;
+        double cache_lookups = 0;
+        double cache_hits = 0;
+        unsigned int reorderings = 0;
+        long reordering_ms = 0;
+        long peak_rss_kb = 0;
+    };
+
+/**
+ * \brief Collects BDD engine statistics at phase boundaries of a synthesis run.
+ *
+ * Owned by a VarMgr. Phases are recorded in the order in which they end, so
+ * phases that run more than once (e.g. one fixpoint per Manna-Pnueli DAG node)
+ * appear once per run.
+ */
+    class SolverStats {
+    private:
+        bool enabled_ = false;
+        std::chrono::steady_clock::time_point start_time_;
+        std::vector<BddStatsSnapshot> snapshots_;
+        std::map<std::string, double> sizes_;
+        std::map<int, int> color_dfa_states_;
+        std::map<std::string, int> dfa_backend_counts_;
+
+    public:
+
+        /**
+         * \brief Constructs a disabled collector and starts its clock.
+         */
+        SolverStats();
+
+        /**
+         * \brief Enables or disables recording of snapshots.
+         */
+        void set_enabled(bool enabled);
+
+        /**
+         * \brief Returns whether snapshots are recorded.
+         */
+        bool enabled() const;
+
+        /**
+         * \brief Records the current state of \a mgr as the end of \a phase.
+         *
+         * Does nothing unless the collector is enabled.
+         */
+        void snapshot(const CUDD::Cudd &mgr, const std::string &phase);
+
+        /**
+         * \brief Reads the current state of \a mgr, whether or not a collector is enabled.
+         *
+         * The elapsed time is left at 0; the peak RSS is that of the process.
+         */
+        static BddStatsSnapshot read(const CUDD::Cudd &mgr, const std::string &phase);
+
+        /**
+         * \brief Returns the recorded snapshots in the order they were taken.
+         */
+        const std::vector<BddStatsSnapshot> &snapshots() const;
+
+        /**
+         * \brief Prints the recorded snapshots as a JSON object.
+         *
+         * The object has a single key "phases" holding one object per snapshot.
+         */
+        void print_json(std::ostream &out) const;
+
+        /**
+         * \brief Records a size of the run under \a name, e.g. "zielonka_tree_nodes".
+         *
+         * Sizes are recorded whether or not the collector is enabled. A name
+         * recorded more than once (e.g. by the solvers of Manna-Pnueli DAG
+         * nodes) keeps its largest value.
+         */
+        void record_size(const std::string &name, double value);
+
+        /**
+         * \brief Returns the recorded sizes by name.
+         */
+        const std::map<std::string, double> &sizes() const;
+
+        /**
+         * \brief Records the number of states of the DFA of \a color, 0 for a color that needs none.
+         *
+         * Recorded whether or not the collector is enabled.
+         */
+        void record_color_states(int color, int states);
+
+        /**
+         * \brief Returns the recorded number of DFA states of each color.
+         */
+        const std::map<int, int> &color_dfa_states() const;
+
+        /**
+         * \brief Counts one more DFA built by \a backend, e.g. "compositional".
+         *
+         * Recorded whether or not the collector is enabled.
+         */
+        void record_dfa_backend(const std::string &backend);
+
+        /**
+         * \brief Returns the number of DFAs built by each backend, by name.
+         */
+        const std::map<std::string, int> &dfa_backend_counts() const;
+    };
+
+}
+
+#endif // SOLVER_STATS_H
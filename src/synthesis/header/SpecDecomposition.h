@@ -0,0 +1,77 @@
+#ifndef SPEC_DECOMPOSITION_H
+#define SPEC_DECOMPOSITION_H
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include <lydia/logic/ltlf/base.hpp>
+
+#include "Player.h"
+#include "Synthesizer.h"
+#include "game/InputOutputPartition.h"
+
+namespace Syft {
+
+  /**
+  * \brief An LTLf+ spec split into independent components, combined by the top operator of its color formula.
+  */
+  struct SpecDecomposition {
+    /** \brief Whether the verdict is the conjunction of the verdicts of the components, rather than the disjunction. */
+    bool conjunction = true;
+    /** \brief The components, each with its own colors numbered from 0. */
+    std::vector<LTLfPlus> components;
+  };
+
+  /**
+  * \brief Returns the variables occurring in \a formula.
+  */
+  std::set<std::string> variable_support(const whitemech::lydia::LTLfFormula &formula);
+
+  /**
+  * \brief Splits \a formula into the operands of the top conjunction or disjunction of its color formula that share no variables.
+  *
+  * Operands are grouped as long as they share a color or a variable of the
+  * protagonist for a conjunction, so that the protagonist plays each group
+  * with its own variables against the shared ones of the opponent; and as
+  * long as they share any variable for a disjunction, so that the opponent
+  * can also spoil each group separately. A grouping that leaves a single
+  * component is returned as the unchanged spec.
+  */
+  SpecDecomposition decompose_spec(const LTLfPlus &formula, const InputOutputPartition &partition,
+                                   Player protagonist_player);
+
+  /**
+  * \brief Returns the operands of the top conjunction of the color formula of \a formula, or the whole color formula if it is none.
+  *
+  * Colors are spelled out as their quantified LTLf arguments, so that the
+  * operands of specs colored by different PNF runs compare equal.
+  */
+  std::set<std::string> top_conjuncts(const LTLfPlus &formula);
+
+  /**
+  * \brief Returns the operands of the top disjunction of \a color_formula, or the whole formula if it is none.
+  *
+  * Unlike the components of decompose_spec, the operands keep the colors of
+  * \a color_formula, and may share colors and variables.
+  */
+  std::vector<std::string> top_disjuncts(const std::string &color_formula);
+
+  /**
+  * \brief Returns the colors that are operands of the top conjunction of \a color_formula, as Inf of the color.
+  *
+  * For a color formula that is not a conjunction, this is the color itself if
+  * the formula is Inf of one color, and none otherwise.
+  */
+  std::vector<int> top_conjunct_colors(const std::string &color_formula);
+
+  /**
+  * \brief Returns \a color_formula without the operands of its top conjunction that are Inf of one of \a colors.
+  *
+  * The other operands keep their colors; "true" if no operand is left.
+  */
+  std::string drop_top_conjuncts(const std::string &color_formula, const std::set<int> &colors);
+
+}
+
+#endif //SPEC_DECOMPOSITION_H
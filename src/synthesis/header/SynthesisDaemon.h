@@ -0,0 +1,122 @@
+#ifndef SYNTHESIS_DAEMON_H
+#define SYNTHESIS_DAEMON_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "BatchRunner.h"
+#include "SolverStats.h"
+
+namespace Syft {
+
+/**
+ * \brief What the solve function of a SynthesisDaemon gets besides its job.
+ */
+struct DaemonJobContext {
+  /** \brief Set when the client cancels the job or disconnects; see SolveBudget::set_cancellation_token. */
+  std::shared_ptr<const std::atomic<bool>> cancelled;
+  /** \brief Streams the end of a phase to the client; see VarMgrOptions::phase_listener. */
+  std::function<void(const BddStatsSnapshot&)> progress;
+};
+
+/**
+ * \brief A long-lived process solving the jobs of local clients over a Unix socket or TCP.
+ *
+ * Clients send one flat JSON object per line: a job, with the fields of a
+ * line of a batch manifest (see read_batch_manifest) and an id naming it in
+ * the replies, {"cancel": "<id>"} to cancel a queued or running job of the
+ * same connection, or {"shutdown": true} to stop the daemon once the
+ * running job is done. The daemon replies with one object per line: events
+ * {"id": ..., "event": "queued"}, "started" and "phase", the latter with the
+ * BDD statistics at the end of each phase, then the BatchResult of the job,
+ * which has a "verdict". Malformed requests get {"event": "error"}.
+ *
+ * Connections are read on threads of their own, but the jobs of every client
+ * are solved one at a time on the thread calling serve, since neither CUDD
+ * nor MONA is thread-safe. Whatever the solve function keeps between jobs,
+ * e.g. a DfaCache in memory, thus stays warm across requests. A job is
+ * cancelled through its budget at the next check of the solver; a client
+ * that went away has its jobs cancelled once a reply to it fails, so a client
+ * may still close its writing side and wait for its results.
+ */
+class SynthesisDaemon {
+ public:
+
+  typedef std::function<BatchResult(const BatchJob&, const DaemonJobContext&)> Solver;
+
+  /**
+   * \brief Listens on \a address: "unix:<path>", "tcp:<port>" on the loopback interface, or a socket path.
+   *
+   * A stale Unix socket at the path is replaced. Throws std::runtime_error if
+   * the address cannot be bound.
+   */
+  explicit SynthesisDaemon(const std::string& address);
+
+  /**
+   * \brief Stops serving, closes the connections and removes the Unix socket.
+   */
+  ~SynthesisDaemon();
+
+  SynthesisDaemon(const SynthesisDaemon&) = delete;
+  SynthesisDaemon& operator=(const SynthesisDaemon&) = delete;
+
+  /**
+   * \brief Returns the TCP port listened on, e.g. the one chosen for "tcp:0", or 0 for a Unix socket.
+   */
+  int port() const {return port_;}
+
+  /**
+   * \brief Solves the jobs of the clients until stop or a shutdown request; returns the number of jobs solved.
+   */
+  std::size_t serve(const Solver& solve);
+
+  /**
+   * \brief Makes serve return after the running job; the queued jobs get an ERROR result. Thread-safe.
+   */
+  void stop();
+
+ private:
+
+  struct Connection;
+
+  struct QueuedJob {
+    BatchJob job;
+    std::shared_ptr<Connection> connection;
+    std::shared_ptr<std::atomic<bool>> cancelled;
+  };
+
+  int listen_fd_ = -1;
+  // Written by stop to wake the accepting thread
+  int wake_fds_[2] = {-1, -1};
+  std::string unix_path_;
+  int port_ = 0;
+
+  std::mutex mutex_;
+  std::condition_variable queue_changed_;
+  std::deque<QueuedJob> queue_;
+  bool stopping_ = false;
+  std::vector<std::weak_ptr<Connection>> connections_;
+  // Readers are detached; closing the connections waits for them
+  std::size_t active_readers_ = 0;
+  std::condition_variable readers_done_;
+
+  void accept_connections();
+
+  void read_requests(const std::shared_ptr<Connection>& connection);
+
+  void handle_request(const std::shared_ptr<Connection>& connection, const std::string& line,
+                      std::size_t line_number);
+
+  void close_connections();
+};
+
+}
+
+#endif // SYNTHESIS_DAEMON_H
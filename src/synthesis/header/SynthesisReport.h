@@ -0,0 +1,70 @@
+#ifndef SYNTHESIS_REPORT_H
+#define SYNTHESIS_REPORT_H
+
+#include <string>
+
+#include "SolverStats.h"
+
+namespace Syft {
+
+/**
+ * \brief The result of one run of a command line binary, as written by --json-result.
+ *
+ * The JSON object has the fields below, with the sizes and BDD statistics
+ * taken from the SolverStats of the run:
+ *
+ *   schema_version       SynthesisReport::schema_version
+ *   tool                 the binary, e.g. "LydiaSyftEL"
+ *   formula_file, partition_file
+ *   verdict              "REALIZABLE", "UNREALIZABLE" or "UNKNOWN"; null if the
+ *                        binary only builds automata (PPLTL2SDFA)
+ *   solver, mode         e.g. "obligation" and "wg"; null if there is no solver, or
+ *                        the solver has no modes
+ *   starting_player      "agent" or "environment"
+ *   detail               why the verdict is UNKNOWN, null otherwise
+ *   wall_time, cpu_time  in seconds
+ *   phases               one object per snapshot: the BddStatsSnapshot fields,
+ *                        and phase_ms, the time since the previous snapshot
+ *   arena_state_bits     the state variables of the game arena
+ *   color_dfa_states     the number of DFA states of each color, by color
+ *   dfa_backends         the number of DFAs built by each LTLf-to-DFA backend, by
+ *                        name (see DfaBackendSelector); cached DFAs are not built
+ *   zielonka_tree_nodes  the nodes of the largest Zielonka tree solved
+ *   mp_dag_nodes         the nodes of the Manna-Pnueli DAG
+ *
+ * Sizes the run did not reach (e.g. the DAG of an Emerson-Lei run) are null.
+ * Fields are only added to the schema; a change of meaning increments
+ * schema_version.
+ */
+struct SynthesisReport {
+  static constexpr int schema_version = 1;
+
+  std::string tool;
+  std::string formula_file;
+  std::string partition_file;
+  std::string verdict;
+  std::string solver;
+  std::string mode;
+  bool agent_starts = false;
+  std::string detail;
+  double wall_time = 0;
+  double cpu_time = 0;
+  /** \brief The statistics of the run, or nullptr if they are not available (e.g. of a portfolio). */
+  const SolverStats* stats = nullptr;
+
+  /**
+   * \brief Returns the report as a JSON object.
+   */
+  std::string to_json() const;
+
+  /**
+   * \brief Writes the report to \a filename, replacing it.
+   *
+   * Throws std::runtime_error if the file cannot be written.
+   */
+  void write(const std::string& filename) const;
+};
+
+}
+
+#endif // SYNTHESIS_REPORT_H
@@ -1,6 +1,7 @@
 #ifndef SYNTHESIZER_H
 #define SYNTHESIZER_H
 
+#include <functional>
 #include <memory>
 
 #include "game/Transducer.h"
@@ -35,7 +36,9 @@ namespace Syft {
         bool realizability;
         CUDD::BDD winning_states;
         EL_output_function output_function;
-        ZielonkaTree* z_tree = nullptr;
+        std::shared_ptr<ZielonkaTree> z_tree;
+        // Set instead of output_function by symbolic strategy extraction
+        std::shared_ptr<Transducer> transducer;
     };
 
 
@@ -52,12 +55,34 @@ namespace Syft {
         bool realizability;
         CUDD::BDD winning_states;
         MP_output_function output_function;
+        // Set instead of output_function by symbolic strategy extraction
+        std::shared_ptr<Transducer> transducer;
+        // DAG nodes skipped for having no reachable states (see MannaPnueli::set_prune_nodes)
+        std::size_t pruned_nodes = 0;
     };
 
+    /**
+     * \brief Sound partial information on a game that is still being solved.
+     *
+     * The protagonist wins from every state of winning and loses from every
+     * state of losing; states in neither are undecided so far.
+     */
+    struct PartialSynthesisResult {
+        CUDD::BDD winning;
+        CUDD::BDD losing;
+    };
+    typedef std::function<void(const PartialSynthesisResult &)> PartialResultCallback;
+
+    /**
+     * \brief The maximally permissive strategies of a reachability game.
+     *
+     * The strategies are derived from the layers of the winning region on their
+     * first call, and kept for later calls.
+     */
     struct MaxSetSynthesisResult {
         bool realizability;
-        CUDD::BDD deferring_strategy;
-        CUDD::BDD nondeferring_strategy;
+        std::function<CUDD::BDD()> deferring_strategy;
+        std::function<CUDD::BDD()> nondeferring_strategy;
     };
 
     struct OneStepSynthesisResult {
@@ -0,0 +1,103 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <chrono>
+#include <string>
+
+#include "cuddObj.hh"
+
+namespace Syft {
+
+/**
+ * \brief Records the spans of TraceScope and writes them as a Chrome trace.
+ *
+ * The trace is the JSON object format of the Trace Event Format, read by
+ * chrome://tracing and by Perfetto: one complete event per span, with the
+ * thread that ran it and the arguments given to the scope. Spans are kept in
+ * memory and written once, when the process exits, so that recording costs
+ * no I/O while solving. Recording is off unless start is called, and a
+ * TraceScope then costs one atomic load. Past about a million spans, only
+ * the number of spans dropped is kept, in the otherData of the trace.
+ *
+ * Forked children (Portfolio entries, batch workers) inherit the recorded
+ * spans but never write them, as they leave with _exit.
+ */
+class Tracer {
+ public:
+
+  /**
+   * \brief Starts recording; the trace is written to \a filename at exit, or by finish.
+   */
+  static void start(const std::string& filename);
+
+  /**
+   * \brief Returns whether spans are recorded.
+   */
+  static bool enabled();
+
+  /**
+   * \brief Writes the spans recorded so far and stops recording. Does nothing if not recording.
+   *
+   * Throws std::runtime_error if the trace cannot be written, unless called at exit.
+   */
+  static void finish();
+
+  /**
+   * \brief Records a span of \a name that started at \a start and ends now.
+   *
+   * \param args The arguments of the span, as the members of a JSON object without the braces.
+   */
+  static void record(const char* name, const char* category, std::chrono::steady_clock::time_point start,
+                     const std::string& args);
+};
+
+/**
+ * \brief A span of the synthesis pipeline, from its construction to its destruction.
+ *
+ * Arguments, e.g. the BDD sizes of the results of the span, are only
+ * formatted while recording:
+ *
+ *   TraceScope trace("EL node", "game");
+ *   ...
+ *   trace.arg("node", t->order).bdd("winning_nodes", X);
+ */
+class TraceScope {
+ public:
+
+  /**
+   * \param name The name of the span; must outlive the scope, e.g. a string literal.
+   * \param category The category of the span, e.g. "automata" or "game"; same lifetime.
+   */
+  explicit TraceScope(const char* name, const char* category = "synthesis");
+
+  ~TraceScope();
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+
+  /**
+   * \brief Returns whether the span is recorded, e.g. to skip computing its arguments.
+   */
+  bool active() const {return active_;}
+
+  TraceScope& arg(const char* key, double value);
+
+  TraceScope& arg(const char* key, const std::string& value);
+
+  /**
+   * \brief Adds the node count of \a bdd, which is only counted while recording.
+   */
+  TraceScope& bdd(const char* key, const CUDD::BDD& bdd);
+
+ private:
+
+  bool active_;
+  const char* name_;
+  const char* category_;
+  std::chrono::steady_clock::time_point start_;
+  std::string args_;
+};
+
+}
+
+#endif // TRACE_H
@@ -1,15 +1,99 @@
 #ifndef VAR_MGR_H
 #define VAR_MGR_H
 
+#include <functional>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 #include <iostream>
+#include <string>
 
 #include "cuddObj.hh"
+#include "BddBackend.h"
+#include "SolveBudget.h"
+#include "SolverStats.h"
 
 namespace Syft {
 
+/**
+ * \brief When the CUDD manager is allowed to reorder its variables.
+ *
+ * Off keeps the creation order. Auto enables CUDD's dynamic reordering, which
+ * triggers whenever the node count crosses the manager's threshold. Phase
+ * only reorders explicitly at phase boundaries of the synthesis pipeline
+ * (see VarMgr::reorder_at_phase), e.g. after the arena product and before
+ * the game fixpoints.
+ */
+    enum class ReorderMode {
+        Off,
+        Auto,
+        Phase
+    };
+
+/**
+ * \brief Variable reordering policy of a VarMgr.
+ */
+    struct ReorderPolicy {
+        ReorderMode mode = ReorderMode::Off;
+        Cudd_ReorderingType method = CUDD_REORDER_SIFT;
+
+        /**
+         * \brief Builds a policy from its command-line spelling.
+         *
+         * \param mode One of "off", "auto" or "phase".
+         * \param method One of "sift", "sift-converge", "symm-sift", "group-sift",
+         *   "window", "annealing", "genetic" or "exact".
+         */
+        static ReorderPolicy from_string(const std::string &mode,
+                                         const std::string &method = "sift");
+    };
+
+/**
+ * \brief How the synthesizers order the input and output variables.
+ *
+ * Partition keeps the order of the partition file, inputs first. Force
+ * derives the order from the co-occurrence of the variables in the
+ * subformulas of the spec (see force_order in VariableOrdering.h).
+ */
+    enum class PropositionOrder {
+        Partition,
+        Force
+    };
+
+/**
+ * \brief Sizing and limits of the CUDD manager owned by a VarMgr.
+ *
+ * The defaults are CUDD's own defaults. A value of 0 for \a max_cache_hard,
+ * \a max_memory or \a loose_up_to leaves CUDD's setting untouched.
+ */
+    struct VarMgrOptions {
+        /** \brief Initial number of slots of each unique subtable. */
+        unsigned int unique_slots = CUDD_UNIQUE_SLOTS;
+        /** \brief Initial number of slots of the computed table (cache). */
+        unsigned int cache_slots = CUDD_CACHE_SLOTS;
+        /** \brief Maximum number of slots the computed table may grow to. */
+        unsigned int max_cache_hard = 0;
+        /** \brief Memory target in bytes, used by CUDD to size tables and as a hard limit. */
+        std::size_t max_memory = 0;
+        /** \brief Table size beyond which CUDD stops growing eagerly and prefers garbage collection. */
+        unsigned int loose_up_to = 0;
+        /** \brief Variable reordering policy. */
+        ReorderPolicy reorder_policy;
+        /** \brief Initial order of the input and output variables, applied by the synthesizers. */
+        PropositionOrder proposition_order = PropositionOrder::Partition;
+        /** \brief Whether to record BDD engine statistics at phase boundaries. */
+        bool collect_stats = false;
+        /** \brief Resource limits of the run, checked by check_budget. */
+        SolveBudget budget;
+        /** \brief Called at the end of each phase (see VarMgr::end_phase), e.g. to report progress; may be empty. */
+        std::function<void(const BddStatsSnapshot &)> phase_listener;
+        /** \brief The package running the fixpoint operations (see BddBackend). */
+        BddBackendKind bdd_backend = BddBackendKind::Cudd;
+        /** \brief Threads of a parallel backend, 0 for one per core. */
+        std::size_t bdd_threads = 0;
+    };
+
 /**
  * \brief A dictionary that maps variable names to indices and vice versa.
  */
@@ -24,6 +108,29 @@ namespace Syft {
         std::vector<CUDD::BDD> input_variables_;
         std::vector<CUDD::BDD> output_variables_;
         std::size_t total_variable_count_ = 0;
+        ReorderPolicy reorder_policy_;
+        mutable SolverStats stats_;
+        SolveBudget budget_;
+        std::function<void(const BddStatsSnapshot &)> phase_listener_;
+        BddBackendKind bdd_backend_kind_ = BddBackendKind::Cudd;
+        std::size_t bdd_threads_ = 0;
+        std::unique_ptr<BddBackend> bdd_backend_;
+
+        // Memoized cubes and compose vectors. They are reset whenever variables
+        // are created, since compose vectors need one entry per BDD variable.
+        struct ComposeCacheEntry {
+            std::vector<CUDD::BDD> state_bdds;
+            std::vector<CUDD::BDD> compose_vector;
+        };
+        mutable std::optional<CUDD::BDD> input_cube_;
+        mutable std::optional<CUDD::BDD> output_cube_;
+        mutable std::unordered_map<std::size_t, CUDD::BDD> state_cube_cache_;
+        mutable std::vector<CUDD::BDD> identity_compose_vector_;
+        mutable std::unordered_map<std::size_t, ComposeCacheEntry> compose_cache_;
+
+        void reset_caches();
+
+        const std::vector<CUDD::BDD> &identity_compose_vector() const;
 
         // for debugging
         std::vector<std::pair<int, std::string>> index_to_name_vec_;
@@ -33,8 +140,10 @@ namespace Syft {
 
         /**
          * \brief Constructs a VarMgr with no variables.
+         *
+         * \param options Sizing, limits and reordering policy of the CUDD manager.
          */
-        VarMgr();
+        explicit VarMgr(const VarMgrOptions &options = VarMgrOptions());
 
         /**
          * \brief Prints the VarMgr
@@ -128,6 +237,109 @@ namespace Syft {
          */
         std::shared_ptr<CUDD::Cudd> cudd_mgr() const;
 
+        /**
+         * \brief Returns the backend of the fixpoint operations, over the BDDs of cudd_mgr().
+         */
+        const BddBackend &bdd_backend() const;
+
+        /**
+         * \brief Returns a copy of this VarMgr on a fresh CUDD manager.
+         *
+         * The copy has the same variables at the same indices and levels, the
+         * same automaton IDs, budget and BDD backend, so BDDs can be moved between
+         * the two managers with CUDD::BDD::Transfer. Used to hand work to
+         * threads, since a CUDD manager must never be shared between them.
+         */
+        std::shared_ptr<VarMgr> clone() const;
+
+        /**
+         * \brief Sets the variable reordering policy of the CUDD manager.
+         *
+         * Enables or disables dynamic reordering according to \a policy.mode.
+         */
+        void set_reorder_policy(const ReorderPolicy &policy);
+
+        /**
+         * \brief Returns the variable reordering policy.
+         */
+        const ReorderPolicy &reorder_policy() const;
+
+        /**
+         * \brief Returns the indices of the variables from the top to the bottom level.
+         */
+        std::vector<int> variable_order() const;
+
+        /**
+         * \brief Moves the variables to the levels given by \a order.
+         *
+         * \param order The index of every variable, from the top to the bottom
+         *   level. BDDs stay valid; only their shape changes.
+         */
+        void set_variable_order(const std::vector<int> &order);
+
+        /**
+         * \brief Marks a phase boundary of the synthesis pipeline.
+         *
+         * Runs one explicit reordering pass with the policy's method if the
+         * policy mode is ReorderMode::Phase, and does nothing otherwise.
+         *
+         * \param phase A short name of the phase that was just completed, used
+         *   for logging.
+         */
+        void reorder_at_phase(const std::string &phase) const;
+
+        /**
+         * \brief Marks the end of a phase of the synthesis pipeline.
+         *
+         * Reorders the variables as described in reorder_at_phase, records a
+         * statistics snapshot if statistics are collected, notifies the phase
+         * listener of the options, if any, and checks the budget. Clones have no
+         * listener.
+         *
+         * \param phase A short name of the phase that was just completed.
+         */
+        void end_phase(const std::string &phase) const;
+
+        /**
+         * \brief Records a statistics snapshot for \a phase without reordering.
+         */
+        void snapshot_stats(const std::string &phase) const;
+
+        /**
+         * \brief Returns the statistics collected so far.
+         */
+        const SolverStats &stats() const;
+
+        /**
+         * \brief Records a size of the run in the statistics (see SolverStats::record_size).
+         */
+        void record_size(const std::string &name, double value) const;
+
+        /**
+         * \brief Records the number of DFA states of \a color in the statistics.
+         */
+        void record_color_states(int color, int states) const;
+
+        /**
+         * \brief Records in the statistics that a DFA was built by \a backend (see DfaBackendSelector).
+         */
+        void record_dfa_backend(const std::string &backend) const;
+
+        /**
+         * \brief Throws BudgetExceeded if the budget of the run is exhausted.
+         *
+         * Called by the solvers once per fixpoint iteration, and by end_phase.
+         *
+         * \param phase The current phase, reported in the exception.
+         */
+        void check_budget(const std::string &phase) const;
+
+        /**
+         * \brief Replaces the budget of the run, e.g. to give each solve over a
+         * long-lived manager a deadline of its own.
+         */
+        void set_budget(SolveBudget budget);
+
         /**
          * \brief Returns the index of the variable with the given name.
          */
@@ -165,18 +377,27 @@ namespace Syft {
 
         /**
          * \brief Returns a BDD formed by the conjunction of all input variables.
+         *
+         * The cube is computed once. The reference stays valid until new
+         * variables are created.
          */
-        CUDD::BDD input_cube() const;
+        const CUDD::BDD &input_cube() const;
 
         /**
          * \brief Returns a BDD formed by the conjunction of all output variables.
+         *
+         * The cube is computed once. The reference stays valid until new
+         * variables are created.
          */
-        CUDD::BDD output_cube() const;
+        const CUDD::BDD &output_cube() const;
 
         /**
          * \brief Returns a BDD formed by the conjunction of all state variables of automaton automaton_id.
+         *
+         * The cube is computed once per automaton. The reference stays valid
+         * until new variables are created.
          */
-        CUDD::BDD state_variables_cube(std::size_t automaton_id) const;
+        const CUDD::BDD &state_variables_cube(std::size_t automaton_id) const;
 
         /**
          * \brief Creates a valid input to CUDD::BDD::Eval.
@@ -217,8 +438,13 @@ namespace Syft {
          *   state variable of the requested automaton contains \a state_bdds[i].
          *   Indices corresponding to other variables have the identity BDD for that
          *   variable.
+         *
+         * The last vector built for each automaton is memoized and returned again
+         * if \a state_bdds is unchanged. The reference stays valid until new
+         * variables are created or the vector of the same automaton is requested
+         * with different \a state_bdds.
          */
-        std::vector<CUDD::BDD> make_compose_vector(
+        const std::vector<CUDD::BDD> &make_compose_vector(
                 std::size_t automaton_id,
                 const std::vector<CUDD::BDD> &state_bdds) const;
 
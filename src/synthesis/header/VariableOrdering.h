@@ -0,0 +1,57 @@
+#ifndef VARIABLE_ORDERING_H
+#define VARIABLE_ORDERING_H
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "Synthesizer.h"
+#include "VarMgr.h"
+#include "game/InputOutputPartition.h"
+
+namespace Syft {
+
+  /**
+  * \brief Returns the sets of variables of the subformulas of the LTLf arguments of \a formula with at least two variables.
+  */
+  std::vector<std::set<std::string>> ltlf_plus_hyperedges(const LTLfPlus &formula);
+
+  /**
+  * \brief Returns the sets of variables of the subformulas of the PPLTL arguments of \a formula with at least two variables.
+  */
+  std::vector<std::set<std::string>> ppltl_plus_hyperedges(const PPLTLPlus &formula);
+
+  /**
+  * \brief Orders \a variables so that the variables of each hyperedge are close, by the FORCE heuristic.
+  *
+  * Starting from the given order, each pass moves every variable to the mean
+  * of the centers of gravity of its hyperedges and sorts by the result, ties
+  * kept in the previous order. Stops after \a max_passes passes, or as soon
+  * as a pass does not shrink the total span of the hyperedges, and returns
+  * the order of smallest span. Variables in no hyperedge hold their place
+  * while the others move around them.
+  *
+  * Aloul, Markov, Sakallah: FORCE: A Fast and Easy-to-Implement
+  * Variable-Ordering Heuristic. GLSVLSI 2003: 116-119
+  */
+  std::vector<std::string> force_order(const std::vector<std::string> &variables,
+                                       const std::vector<std::set<std::string>> &hyperedges,
+                                       std::size_t max_passes = 50);
+
+  /**
+  * \brief Returns the inputs and outputs of \a partition in the order in which the synthesizers create them.
+  *
+  * The hyperedges of \a formula are only computed for PropositionOrder::Force.
+  */
+  std::vector<std::string> proposition_order(const InputOutputPartition &partition, const LTLfPlus &formula,
+                                             PropositionOrder order);
+
+  /**
+  * \brief Returns the inputs and outputs of \a partition in the order in which the PPLTL+ synthesizers create them.
+  */
+  std::vector<std::string> proposition_order(const InputOutputPartition &partition, const PPLTLPlus &formula,
+                                             PropositionOrder order);
+
+}
+
+#endif //VARIABLE_ORDERING_H
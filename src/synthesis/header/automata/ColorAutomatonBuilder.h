@@ -0,0 +1,142 @@
+#ifndef COLOR_AUTOMATON_BUILDER_H
+#define COLOR_AUTOMATON_BUILDER_H
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "automata/DfaCache.h"
+#include "automata/ExplicitStateDfa.h"
+#include "automata/SymbolicStateDfa.h"
+#include "OneStepBdd.h"
+#include "Synthesizer.h"
+#include "VarMgr.h"
+
+namespace Syft {
+
+/**
+ * \brief The transformation applied to the DFA of an LTLf argument for its prefix quantifier.
+ */
+    struct QuantifierTransform {
+        /** \brief Names the transformation in cache keys (see DfaCache::cache_key), e.g. "dfa_to_Gdfa". */
+        std::string name;
+        /** \brief Transforms the DFA of the argument. */
+        std::function<ExplicitStateDfa(ExplicitStateDfa)> apply;
+        /** \brief Whether the transformed DFA of a conjunction is the product of those of its arguments. */
+        bool distributes_over_and = false;
+        /** \brief Whether the transformed DFA of a disjunction is the union product of those of its arguments. */
+        bool distributes_over_or = false;
+    };
+
+/**
+ * \brief The DFAs of the colors of an LTLf+ formula, ready to be the components of an arena.
+ */
+    struct ColorArenas {
+        /** \brief The colors, in increasing order. */
+        std::vector<int> colors;
+        /** \brief The distinct DFAs of the colors, in the order of their first color. */
+        std::vector<SymbolicStateDfa> components;
+        /** \brief The goal states of each color, in the order of colors; Fin colors are read as their complements. */
+        std::vector<CUDD::BDD> goal_states;
+    };
+
+/**
+ * \brief Builds the DFA of each LTLf argument of an LTLf+ formula, transformed for its prefix quantifier.
+ *
+ * Shared by the LTLf+ synthesizers, which only differ in the transformation
+ * applied per quantifier. Arguments with the same formula and transformation
+ * share one DFA, and thus one state space. Explicit DFAs are stored in the
+ * on-disk DfaCache of the options, if any, and symbolic DFAs are encoded on
+ * the worker threads of the options (see SymbolicStateDfa::from_explicit_parallel)
+ * and kept for later builds of the same builder. An argument with an entry
+ * in the PrecompiledAutomata of the options reads its DFA from the file of
+ * the entry, bypassing the cache, and is never composed. Unless disabled in the
+ * options, a color whose value is decided by the first step on every play
+ * (see OneStepBdd::constant_value) gets no DFA: constant goal states in
+ * symbolic builds, and a constant DFA in explicit builds of A and E colors.
+ *
+ * Symbolic builds skip the explicit DFA of a large conjunction or
+ * disjunction, when its transformation distributes over it: the arguments
+ * are packed into groups of estimated size below the threshold of the
+ * options, and the DFAs of the groups are combined by symbolic products (see
+ * estimated_state_bits).
+ */
+    class ColorAutomatonBuilder {
+    public:
+
+        typedef std::function<QuantifierTransform(whitemech::lydia::PrefixQuantifier)> TransformPolicy;
+
+        /**
+         * \brief Creates a builder of DFAs over \a var_mgr, whose input-output partition must be set.
+         */
+        ColorAutomatonBuilder(std::shared_ptr<VarMgr> var_mgr, DfaConstructionOptions options);
+
+        /**
+         * \brief The transformations of the Emerson-Lei solver: G- and F-DFAs for the A and E quantifiers.
+         */
+        static QuantifierTransform emerson_lei_transform(whitemech::lydia::PrefixQuantifier quantifier);
+
+        /**
+         * \brief The transformations of the Manna-Pnueli solvers (game_solver 1 or 2).
+         */
+        static QuantifierTransform manna_pnueli_transform(whitemech::lydia::PrefixQuantifier quantifier,
+                                                          int game_solver);
+
+        /**
+         * \brief Estimates the number of state bits of the DFA of \a formula.
+         *
+         * The number of its temporal operators, each of which may double the
+         * states of the DFA: a bound that is loose for most formulas, but cheap
+         * and additive over conjunctions and disjunctions.
+         */
+        static std::size_t estimated_state_bits(const whitemech::lydia::LTLfFormula &formula);
+
+        /**
+         * \brief Returns the transformed explicit DFA of each color.
+         *
+         * Colors whose DFAs coincide share a handle (see ExplicitStateDfa::take).
+         * The number of states of each color is recorded in the statistics of the VarMgr.
+         */
+        std::map<int, SharedExplicitStateDfa> build_explicit(const LTLfPlus &formula,
+                                                             const TransformPolicy &policy) const;
+
+        /**
+         * \brief Returns the symbolic DFAs and goal states of the colors.
+         *
+         * The goal states of a color are the final states of its DFA, complemented
+         * for the EA quantifier. The number of states of the explicit DFA of each
+         * color, 0 for a color decided by its first step, is recorded in the
+         * statistics of the VarMgr.
+         */
+        ColorArenas build_symbolic(const LTLfPlus &formula, const TransformPolicy &policy) const;
+
+    private:
+
+        std::shared_ptr<VarMgr> var_mgr_;
+        DfaConstructionOptions options_;
+        std::shared_ptr<DfaCache> dfa_cache_;
+        // By cache key, so that the DFAs of earlier builds are reused
+        mutable std::unordered_map<std::string, SymbolicStateDfa> symbolic_dfas_;
+        // The number of states of the explicit DFA of each entry of symbolic_dfas_
+        mutable std::unordered_map<std::string, int> dfa_states_;
+        OneStepBdd one_step_;
+        DfaBackendSelector backend_selector_;
+        // The variables a precompiled DFA may read
+        std::unordered_set<std::string> partitioned_;
+
+        std::optional<bool> constant_color(const whitemech::lydia::LTLfFormula &formula,
+                                           whitemech::lydia::PrefixQuantifier quantifier, int color) const;
+
+        ExplicitStateDfa transformed_dfa(const whitemech::lydia::LTLfFormula &formula,
+                                         const QuantifierTransform &transform,
+                                         const std::string &key) const;
+    };
+
+}
+
+#endif // COLOR_AUTOMATON_BUILDER_H
@@ -0,0 +1,132 @@
+#ifndef DFA_BACKEND_SELECTOR_H
+#define DFA_BACKEND_SELECTOR_H
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "automata/ExplicitStateDfa.h"
+
+namespace Syft {
+
+/**
+ * \brief A way of translating an LTLf formula into its explicit DFA.
+ *
+ * All of them end in the compositional MONA construction of lydia, whose DFAs
+ * the rest of the pipeline reads; they differ in what is handed to it.
+ */
+    enum class DfaBackend {
+        /** \brief The compositional construction of the formula itself. */
+        Compositional,
+        /** \brief The complement of the compositional construction of the negation normal form of its negation. */
+        Complemented,
+        /**
+         * \brief The compositional construction of each argument of a top-level
+         * conjunction or disjunction, combined by minimized products, smallest first.
+         */
+        Decomposed
+    };
+
+/**
+ * \brief Returns the name of \a backend, e.g. "compositional".
+ */
+    std::string to_string(DfaBackend backend);
+
+/**
+ * \brief Returns the backend named \a name, if any.
+ */
+    std::optional<DfaBackend> parse_dfa_backend(const std::string &name);
+
+/**
+ * \brief A cheap syntactic estimate of the cost of translating an LTLf formula.
+ */
+    struct FormulaShape {
+        /** \brief The number of nodes of the formula. */
+        std::size_t size = 0;
+        /** \brief The number of temporal operators of the formula. */
+        std::size_t temporal_operators = 0;
+        /** \brief The largest number of nested temporal operators. */
+        std::size_t temporal_depth = 0;
+        /** \brief The temporal operators of the universal kind: G, R and weak X. */
+        std::size_t universal_operators = 0;
+        /** \brief The arguments of a top-level conjunction or disjunction, 0 if there is none. */
+        std::size_t junction_arity = 0;
+        bool conjunction = false;
+    };
+
+/**
+ * \brief Returns the shape of \a formula.
+ */
+    FormulaShape formula_shape(const whitemech::lydia::LTLfFormula &formula);
+
+/**
+ * \brief Options of DfaBackendSelector.
+ */
+    struct DfaBackendOptions {
+        /** \brief The backend of every formula; chosen per formula from its shape if not set. */
+        std::optional<DfaBackend> backend;
+        /** \brief Formulas of at least this many nodes race their candidate backends. */
+        std::size_t race_min_size = 24;
+        /** \brief Formulas of more than this many nodes only run the preferred backend, as racing would multiply their memory. */
+        std::size_t race_max_size = 400;
+        /**
+         * \brief The time after which a race only waits for the preferred backend; 0 disables races.
+         *
+         * The preferred backend is waited for one more budget, after which the
+         * DFA is built in process instead.
+         */
+        std::chrono::milliseconds race_budget{2000};
+    };
+
+/**
+ * \brief Picks the LTLf-to-DFA backend of each subformula.
+ *
+ * No backend is best on every formula, and the wrong one may cost an order of
+ * magnitude on the DFA of a color. The candidates are ranked by the shape of
+ * the formula: the decomposed construction first for wide and shallow
+ * conjunctions and disjunctions, the complemented one when universal
+ * operators dominate (they become existential in the negation), and the
+ * compositional one otherwise. Mid-sized formulas race their candidates, each
+ * in a forked process since MONA is not reentrant; the first DFA wins, and
+ * once the budget runs out only the preferred candidate is waited for. There
+ * are no races while the process runs other threads (as read from
+ * /proc/self/task), since a forked child could deadlock on a lock one of
+ * them holds; callers that may start threads should disable races outright.
+ */
+    class DfaBackendSelector {
+    public:
+        explicit DfaBackendSelector(DfaBackendOptions options = DfaBackendOptions());
+
+        /**
+         * \brief Returns the backends applicable to a formula of \a shape, preferred first.
+         */
+        std::vector<DfaBackend> candidates(const FormulaShape &shape) const;
+
+        /**
+         * \brief Returns the DFA of \a formula, built by the backend stored in \a winner if given.
+         */
+        ExplicitStateDfa build(const whitemech::lydia::LTLfFormula &formula, DfaBackend *winner = nullptr) const;
+
+        /**
+         * \brief Returns the DFA of \a formula built by \a backend.
+         *
+         * The decomposed backend falls back to the compositional one on formulas
+         * that are no conjunction or disjunction.
+         */
+        static ExplicitStateDfa build_with(DfaBackend backend, const whitemech::lydia::LTLfFormula &formula);
+
+        const DfaBackendOptions &options() const { return options_; }
+
+    private:
+        DfaBackendOptions options_;
+
+        // The DFA of the first candidate to finish in a forked process, or none if all of them failed
+        std::optional<ExplicitStateDfa> race(const whitemech::lydia::LTLfFormula &formula,
+                                             const std::vector<DfaBackend> &candidates, DfaBackend &winner) const;
+    };
+
+}
+
+#endif // DFA_BACKEND_SELECTOR_H
@@ -0,0 +1,159 @@
+#ifndef DFA_CACHE_H
+#define DFA_CACHE_H
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "automata/DfaBackendSelector.h"
+#include "automata/ExplicitStateDfa.h"
+#include "automata/StateEncoding.h"
+#include "game/ChildOrder.h"
+#include "game/StrategyMinimizer.h"
+
+namespace Syft {
+
+    class DfaCache;
+    class PrecompiledAutomata;
+
+/**
+ * \brief Options controlling how the DFAs of the LTLf subformulas are built.
+ */
+    struct DfaConstructionOptions {
+        /** \brief The number of worker threads (see SymbolicStateDfa::from_explicit_parallel). */
+        std::size_t threads = 1;
+        /** \brief Directory of the persistent DFA cache; caching is disabled if empty. */
+        std::string cache_directory;
+        /** \brief A cache shared with other builders, e.g. by the jobs of a daemon; replaces cache_directory if set. */
+        std::shared_ptr<DfaCache> shared_cache;
+        /** \brief How the states of the DFAs are encoded in state variables. */
+        StateEncodingKind state_encoding = StateEncodingKind::Binary;
+        /** \brief Whether the game is solved over the reachable states of the arena only. */
+        bool reachable_states_only = false;
+        /** \brief How the transitions and colors are simplified on the reachable states, over which the game is then solved (see ProductArena::simplify_on_care). */
+        StrategyMinimization care_simplification = StrategyMinimization::Off;
+        /** \brief Whether the solver only computes the verdict (see DfaGameSynthesizer::set_realizability_only). */
+        bool realizability_only = false;
+        /** \brief The number of threads solving the children of a Zielonka node (see EmersonLei::set_threads). */
+        std::size_t el_threads = 1;
+        /** \brief The order in which the EL solver visits the children of a Zielonka node (see EmersonLei::set_child_order). */
+        ChildOrder el_child_order = ChildOrder::Construction;
+        /** \brief Whether the EL solver starts each fixpoint from its previous result where that is sound (see EmersonLei::set_warm_start). */
+        bool el_warm_start = false;
+        /** \brief Whether the labels of the Zielonka tree are computed while the DFAs of the colors are built (see ZielonkaTree::label_dag). */
+        bool pipeline_stages = false;
+        /** \brief Whether the EL and MP solvers extract their strategy as a transducer (see EmersonLei::ExtractStrategy_Symbolic and MannaPnueli::ExtractStrategy_Symbolic). */
+        bool symbolic_strategy = false;
+        /** \brief How extracted strategies are simplified (see DfaGameSynthesizer::set_strategy_minimization). */
+        StrategyMinimizationOptions strategy_minimization;
+        /** \brief Whether the EL solver picks its fixpoint from the shape of the condition (see EmersonLei::set_auto_dispatch). */
+        bool el_auto_dispatch = false;
+        /** \brief Whether the EL condition is always solved by ParitySolver (see EmersonLei::set_force_parity). */
+        bool parity_solver = false;
+        /** \brief Whether the EL game is solved on the colors of each subgame, without the Zielonka tree (see SymbolicEmersonLei). */
+        bool symbolic_colors = false;
+        /** \brief Whether the EL game is solved one SCC layer of the arena at a time, on the colors of each layer (see LayeredEmersonLei). */
+        bool scc_layers = false;
+        /** \brief The number of threads solving the nodes of a Manna-Pnueli DAG level (see MannaPnueli::set_threads). */
+        std::size_t mp_threads = 1;
+        /** \brief Directory shared with the worker processes solving the Manna-Pnueli DAG, if any (see MannaPnueli::set_work_directory). */
+        std::string mp_work_directory;
+        /** \brief Whether the adv solver skips the Manna-Pnueli DAG nodes without reachable states (see MannaPnueli::set_prune_nodes). */
+        bool mp_prune_nodes = true;
+        /** \brief Directory of the checkpoints of the EL and MP solves, if any (see SolveCheckpoint). */
+        std::string checkpoint_directory;
+        /** \brief Whether a solve continues from the checkpoint of the same game found in checkpoint_directory, if any. */
+        bool resume = false;
+        /** \brief The least number of seconds between two checkpoints of the EL root bounds. */
+        std::size_t checkpoint_interval = 600;
+        /** \brief Whether the solvers report partial results and stop at the first sound verdict (see EmersonLei::set_anytime). */
+        bool anytime = false;
+        /** \brief Whether colors decided by their first step get constant goal states instead of a DFA (see OneStepBdd::constant_value). */
+        bool one_step_colors = true;
+        /** \brief Whether independent components of the color formula are solved as separate games (see decompose_spec). */
+        bool decompose_components = false;
+        /** \brief The number of threads solving the independent components (see LTLfPlusSynthesizer::run). */
+        std::size_t component_threads = 1;
+        /** \brief Whether the top disjuncts of the color formula are first solved as games of their own on the arena (see LTLfPlusSynthesizer::run). */
+        bool split_disjuncts = false;
+        /** \brief Whether the game is first restricted to the safe region of the Forall colors of the top conjunction, which are then dropped (see LTLfPlusSynthesizer::run). */
+        bool safety_first = false;
+        /** \brief The number of steps within which the EL synthesizer first looks for a region where the condition is settled, 0 disabling it (see LTLfPlusSynthesizer::run). */
+        std::size_t horizon_precheck = 0;
+        /** \brief Estimated state bits above which symbolic builds compose the DFA of a conjunction or disjunction (see ColorAutomatonBuilder); 0 disables. */
+        std::size_t symbolic_construction_bits = 16;
+        /** \brief How the LTLf-to-DFA backend of each subformula is picked (see DfaBackendSelector). */
+        DfaBackendOptions dfa_backend;
+        /** \brief DFAs of subformulas read from files instead of being built (see PrecompiledAutomata). */
+        std::shared_ptr<const PrecompiledAutomata> precompiled;
+    };
+
+/**
+ * \brief A persistent, content-addressed cache of explicit DFAs.
+ *
+ * Entries are keyed on a string that must identify the DFA, typically the
+ * canonical lydia string of an LTLf formula prefixed by the transformation
+ * applied to its DFA (see cache_key). Each entry is stored as a MONA DFA file
+ * written by dfaExport together with a file holding the full key, so that
+ * hash collisions are detected on load. A cache may also keep its entries in
+ * memory, in front of the directory or without one, so that a long-lived
+ * process serving related specs neither rebuilds nor reloads their DFAs.
+ */
+    class DfaCache {
+    private:
+        std::string directory_;
+        bool keep_in_memory_;
+        mutable std::mutex memory_mutex_;
+        mutable std::unordered_map<std::string, ExplicitStateDfa> memory_;
+
+        std::string entry_path(const std::string &key) const;
+
+    public:
+
+        /**
+         * \brief Creates a cache in \a directory, creating the directory if needed.
+         *
+         * \param directory The directory of the entries, or "" for a cache in memory only.
+         * \param keep_in_memory Whether get_or_build also keeps the entries in memory.
+         */
+        explicit DfaCache(std::string directory, bool keep_in_memory = false);
+
+        /**
+         * \brief Builds the cache key of the DFA of \a formula after \a transform.
+         *
+         * \param transform The name of the transformation applied to the DFA of
+         *   the formula, e.g. "dfa_to_Gdfa", or "" if none.
+         */
+        static std::string cache_key(const std::string &transform,
+                                     const whitemech::lydia::LTLfFormula &formula);
+
+        /**
+         * \brief Returns the DFA stored under \a key, if any.
+         */
+        std::optional<ExplicitStateDfa> load(const std::string &key) const;
+
+        /**
+         * \brief Stores \a dfa under \a key, replacing any previous entry.
+         */
+        void store(const std::string &key, ExplicitStateDfa &dfa) const;
+
+        /**
+         * \brief Returns the DFA stored under \a key, building and storing it first on a miss.
+         *
+         * Thread-safe; concurrent misses on one key may both build it.
+         */
+        ExplicitStateDfa get_or_build(const std::string &key,
+                                      const std::function<ExplicitStateDfa()> &build) const;
+
+        /**
+         * \brief Returns the number of entries kept in memory.
+         */
+        std::size_t memory_entries() const;
+    };
+
+}
+
+#endif // DFA_CACHE_H
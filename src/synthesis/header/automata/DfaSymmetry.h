@@ -0,0 +1,79 @@
+#ifndef DFA_SYMMETRY_H
+#define DFA_SYMMETRY_H
+
+#include "automata/ExplicitStateDfa.h"
+#include "game/ColorFormula.h"
+#include "VarMgr.h"
+
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Syft {
+
+/**
+ * \brief Colors whose DFAs are the same up to a renaming of their atoms, and that the color formula does not tell apart.
+ *
+ * Swapping any two colors of the orbit, together with their atoms, maps the
+ * product of the color DFAs onto itself and leaves the color formula
+ * unchanged, so the game on the product is symmetric under it (see
+ * SymmetryQuotient).
+ */
+    struct ColorOrbit {
+        /** \brief The colors of the orbit, the first being its representative. */
+        std::vector<int> colors;
+        /**
+         * \brief For each color, the atom standing for each atom of the representative.
+         *
+         * atoms[k][i] renames the i-th name of the DFA of the representative, so
+         * atoms[0] holds those names themselves.
+         */
+        std::vector<std::vector<std::string>> atoms;
+    };
+
+/**
+ * \brief The largest number of atoms of the DFAs compared by find_atom_renaming by default.
+ */
+    constexpr std::size_t default_symmetry_max_atoms = 10;
+
+/**
+ * \brief Finds a renaming of the atoms of \a from under which it is isomorphic to \a to.
+ *
+ * Inputs are only renamed into inputs, and outputs into outputs, as
+ * partitioned by \a var_mgr. The reachable states of both DFAs are paired by a
+ * search from their initial states, for each candidate renaming; candidates
+ * must preserve how often each atom changes the successor or its acceptance,
+ * which prunes most of them.
+ *
+ * \return The atom of \a to for each name of \a from, in its order, or
+ *   nothing if there is none, or if the DFAs have more than \a max_atoms atoms.
+ */
+    std::optional<std::vector<std::string>> find_atom_renaming(const ExplicitStateDfa &from,
+                                                               const ExplicitStateDfa &to,
+                                                               const VarMgr &var_mgr,
+                                                               std::size_t max_atoms = default_symmetry_max_atoms);
+
+/**
+ * \brief Returns a copy of \a dfa whose i-th name is \a atoms[i].
+ *
+ * Copies of one DFA share its state numbering, so their symbolic conversions
+ * encode each state by the same code.
+ */
+    ExplicitStateDfa rename_atoms(const ExplicitStateDfa &dfa, const std::vector<std::string> &atoms);
+
+/**
+ * \brief Groups the colors of \a color_to_dfa into orbits of at least two colors.
+ *
+ * The colors of an orbit have DFAs that are renamed copies of each other
+ * (see find_atom_renaming) over pairwise disjoint atoms, which no color
+ * outside the orbit reads, and \a formula is invariant under swapping any two
+ * of them. Colors in no orbit are left out.
+ */
+    std::vector<ColorOrbit> find_color_orbits(const std::map<int, SharedExplicitStateDfa> &color_to_dfa,
+                                              const ColorFormula &formula, const VarMgr &var_mgr,
+                                              std::size_t max_atoms = default_symmetry_max_atoms);
+
+}
+
+#endif // DFA_SYMMETRY_H
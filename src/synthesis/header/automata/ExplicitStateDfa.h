@@ -12,8 +12,76 @@ extern "C" {
 #include "lydia/dfa/mona_dfa.hpp"
 #include "VarMgr.h"
 
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
 namespace Syft {
 
+/**
+ * \brief The order in which a sequence of DFA products combines its operands.
+ */
+    enum class ProductOrder {
+        /** \brief The two smallest DFAs first, whatever they read. */
+        Smallest,
+        /**
+         * \brief The pair of the smallest estimated product first.
+         *
+         * The estimate goes from the larger operand, for DFAs over the same
+         * propositions, to the full product, for DFAs over disjoint ones, whose
+         * product no minimization can shrink: those are combined last, as a
+         * query planner defers cross joins.
+         */
+        Overlap
+    };
+
+/**
+ * \brief How to order and when to minimize the intermediate results of a sequence of DFA products.
+ *
+ * An intermediate product is minimized if it has more than state_threshold
+ * states, or if it has more than growth_ratio times the states of its larger
+ * operand.
+ */
+    struct ProductMinimisationPolicy {
+        /** \brief State count above which a product is minimized; 0 minimizes every product. */
+        int state_threshold = 0;
+        /** \brief Growth over the larger operand above which a product is minimized; 0 disables the check. */
+        double growth_ratio = 0;
+        ProductOrder order = ProductOrder::Overlap;
+        /**
+         * \brief Sequences of at most this many DFAs are planned over every
+         * order of ProductOrder::Overlap, the others greedily.
+         */
+        std::size_t exhaustive_order_limit = 5;
+        /**
+         * \brief Number of products computed at once; above 1, sequences are
+         * reduced as a balanced tree whose independent pairs run in forked
+         * processes, since MONA is not re-entrant.
+         */
+        std::size_t workers = 1;
+
+        /**
+         * \brief Returns whether a product of \a product_states states, built from
+         * operands of at most \a operand_states states, should be minimized.
+         */
+        bool should_minimise(int product_states, int operand_states) const {
+            return product_states > state_threshold ||
+                   (growth_ratio > 0 && product_states > growth_ratio * operand_states);
+        }
+    };
+
+    class ExplicitStateDfa;
+
+/**
+ * \brief A shared handle to an explicit-state DFA.
+ *
+ * Lets several owners hold one DFA without deep-copying its MONA structure;
+ * see ExplicitStateDfa::take.
+ */
+    using SharedExplicitStateDfa = std::shared_ptr<ExplicitStateDfa>;
+
 /**
  * \brief A DFA with explicit states and symbolic transitions.
  *
@@ -52,14 +120,54 @@ namespace Syft {
         }
 
         /**
-         * \brief Create an explicit-state DFA from an existing one using the opeartor =.
+         * \brief Create an explicit-state DFA by taking over the MONA DFA of an existing one.
+         *
+         * The moved-from DFA may only be destroyed or assigned to.
          */
-        ExplicitStateDfa &operator=(ExplicitStateDfa other) {
-            this->names = other.names;
-            this->dfa_ = dfaCopy(other.get_dfa());
+        ExplicitStateDfa(ExplicitStateDfa &&other) noexcept
+                : whitemech::lydia::mona_dfa(dfaMake(1), std::vector<std::string>()) {
+            swap_contents(other);
+        }
+
+        /**
+         * \brief Assign a deep copy of an existing explicit-state DFA.
+         */
+        ExplicitStateDfa &operator=(const ExplicitStateDfa &other) {
+            if (this != &other) {
+                ExplicitStateDfa copy(other);
+                swap_contents(copy);
+            }
             return *this;
         }
 
+        /**
+         * \brief Take over the MONA DFA of an existing explicit-state DFA.
+         *
+         * The moved-from DFA may only be destroyed or assigned to.
+         */
+        ExplicitStateDfa &operator=(ExplicitStateDfa &&other) noexcept {
+            swap_contents(other);
+            return *this;
+        }
+
+        /**
+         * \brief Release the MONA DFA to the caller, who must free it with dfaFree.
+         *
+         * This DFA is left with a placeholder and may only be destroyed or assigned to.
+         */
+        DFA *release_dfa() {
+            DFA *dfa = dfa_;
+            dfa_ = dfaMake(1);
+            return dfa;
+        }
+
+        /**
+         * \brief Take the DFA out of a shared handle, resetting the handle.
+         *
+         * The DFA is moved if the handle was its only owner, and copied otherwise.
+         */
+        static ExplicitStateDfa take(SharedExplicitStateDfa &handle);
+
 
         ~ExplicitStateDfa() {
 
@@ -96,21 +204,84 @@ namespace Syft {
          */
         static ExplicitStateDfa dfa_of_formula(const whitemech::lydia::LTLfFormula &formula);
 
+        /**
+         * \brief Returns the DFA over no variables accepting every nonempty trace if \a accepting, and none otherwise.
+         */
+        static ExplicitStateDfa dfa_constant(bool accepting);
+
+        /**
+         * \brief Writes the DFA to \a path as a MONA DFA file, together with the names of its variables.
+         *
+         * \return Whether the file was written.
+         */
+        bool export_to_file(const std::string &path);
+
+        /**
+         * \brief Reads the DFA of a file written by export_to_file, if \a path holds one.
+         */
+        static std::optional<ExplicitStateDfa> import_from_file(const std::string &path);
+
         /**
          * \brief Take the product AND of a sequence of explicit-state DFAs.
          *
+         * The DFAs are combined pairwise, in the order of \a policy. Each
+         * intermediate product is minimized as decided by \a policy.
+         *
          * \param dfa_vector The DFAs to be processed.
-         * \return The product explicit-state DFA, which is also minimized.
+         * \param policy How to order and when to minimize intermediate products.
+         * \return The product explicit-state DFA.
+         */
+        static ExplicitStateDfa dfa_product_and(const std::vector<ExplicitStateDfa> &dfa_vector,
+                                                const ProductMinimisationPolicy &policy = ProductMinimisationPolicy());
+
+        /**
+         * \brief Take the product AND of a sequence of explicit-state DFAs, consuming them.
+         *
+         * Like the copying overload, but takes over the MONA DFAs instead of
+         * copying them; the DFAs in \a dfa_vector may only be destroyed afterwards.
          */
-        static ExplicitStateDfa dfa_product_and(const std::vector<ExplicitStateDfa> &dfa_vector);
+        static ExplicitStateDfa dfa_product_and(std::vector<ExplicitStateDfa> &&dfa_vector,
+                                                const ProductMinimisationPolicy &policy = ProductMinimisationPolicy());
 
         /**
          * \brief Take the product OR of a sequence of explicit-state DFAs.
          *
+         * The DFAs are combined pairwise, in the order of \a policy. Each
+         * intermediate product is minimized as decided by \a policy.
+         *
+         * \param dfa_vector The DFAs to be processed.
+         * \param policy How to order and when to minimize intermediate products.
+         * \return The product explicit-state DFA.
+         */
+        static ExplicitStateDfa dfa_product_or(const std::vector<ExplicitStateDfa> &dfa_vector,
+                                               const ProductMinimisationPolicy &policy = ProductMinimisationPolicy());
+
+        /**
+         * \brief Take the product OR of a sequence of explicit-state DFAs, consuming them.
+         *
+         * Like the copying overload, but takes over the MONA DFAs instead of
+         * copying them; the DFAs in \a dfa_vector may only be destroyed afterwards.
+         */
+        static ExplicitStateDfa dfa_product_or(std::vector<ExplicitStateDfa> &&dfa_vector,
+                                               const ProductMinimisationPolicy &policy = ProductMinimisationPolicy());
+
+        /**
+         * \brief Take the product of a sequence of weak explicit-state DFAs on the fly.
+         *
+         * Only the state tuples reachable from the initial tuple are built, all
+         * at once rather than pairwise. A component in a sink state that
+         * decides the product (rejecting for AND, accepting for OR) sends the
+         * tuple to a single sink, and a component in the other kind of sink no
+         * longer distinguishes tuples, so tuples that only differ in such
+         * components are merged as they are discovered. The result is meant to
+         * be reduced further by dfa_minimize_weak.
+         *
          * \param dfa_vector The DFAs to be processed.
-         * \return The product explicit-state DFA, which is also minimized.
+         * \param type Whether the product is an AND or an OR.
+         * \return The product explicit-state DFA.
          */
-        static ExplicitStateDfa dfa_product_or(const std::vector<ExplicitStateDfa> &dfa_vector);
+        static ExplicitStateDfa dfa_product_reachable(const std::vector<ExplicitStateDfa> &dfa_vector,
+                                                      dfaProductType type);
 
         /**
          * \brief Minimize a given explicit-state DFA.
@@ -120,6 +291,25 @@ namespace Syft {
          */
         static ExplicitStateDfa dfa_minimize(const ExplicitStateDfa &d);
 
+        /**
+         * \brief The strongly connected components of the state graph of a DFA.
+         */
+        struct StateSccs {
+            /** \brief The SCC of each state. */
+            std::vector<int> scc_of_state;
+            /** \brief The successor SCCs of each SCC, excluding the SCC itself. */
+            std::vector<std::set<int>> successors;
+            /** \brief Whether each state has a self-loop. */
+            std::vector<bool> has_self_loop;
+            /** \brief The SCCs in reverse topological order: each SCC comes after its successors. */
+            std::vector<int> reverse_topological_order;
+        };
+
+        /**
+         * \brief Computes the SCCs of the state graph of \a d and their topological order.
+         */
+        static StateSccs state_sccs(const ExplicitStateDfa &d);
+
         /**
          * \brief Minimize a deterministic weak automaton using Löding's O(n log n) algorithm.
          *
@@ -191,6 +381,21 @@ namespace Syft {
         static std::vector<std::string>
         traverse_bdd(CUDD::BDD dd, std::shared_ptr<VarMgr> var_mgr, std::vector<std::string> &names,
                      std::string guard_str);
+
+        /**
+         * \brief Take the product of owned MONA DFAs with the variables of \a dfa_vector.
+         *
+         * \param dfas One DFA per element of \a dfa_vector, owned and renamed in place.
+         */
+        static ExplicitStateDfa dfa_product(const std::vector<ExplicitStateDfa> &dfa_vector,
+                                            const std::vector<DFA *> &dfas, dfaProductType type,
+                                            const ProductMinimisationPolicy &policy);
+
+        void swap_contents(ExplicitStateDfa &other) noexcept {
+            std::swap(dfa_, other.dfa_);
+            names.swap(other.names);
+            indices.swap(other.indices);
+        }
     };
 
 }
@@ -0,0 +1,82 @@
+#ifndef PRECOMPILED_AUTOMATA_H
+#define PRECOMPILED_AUTOMATA_H
+
+#include <cstddef>
+#include <istream>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "automata/ExplicitStateDfa.h"
+#include "lydia/logic/ltlf/base.hpp"
+
+namespace Syft {
+
+/**
+ * \brief DFAs of LTLf subformulas built by other tools, used instead of the lydia construction.
+ *
+ * Each entry maps an LTLf formula to a file holding a DFA of it: a MONA DFA
+ * file, as written by dfaExport (or ExplicitStateDfa::export_to_file), or a
+ * HOA file of a finite-word automaton. Entries are matched on the canonical
+ * lydia string of the formula, as DFA cache entries are (see DfaCache), so a
+ * color whose LTLf argument is a formula of the manifest, after the PNF, or
+ * a leaf of the product plan of such an argument, reads the DFA of its file
+ * and only applies the transformation of its quantifier to it. The DFA must
+ * accept the nonempty finite traces that satisfy the formula, over variables
+ * of the input-output partition; it is trusted, not checked against the
+ * formula.
+ */
+    class PrecompiledAutomata {
+    private:
+        // File of each entry, by canonical formula string
+        std::unordered_map<std::string, std::string> files_;
+
+    public:
+
+        /**
+         * \brief Reads a manifest of precompiled DFAs.
+         *
+         * One flat JSON object per line, {"formula": "<LTLf formula>",
+         * "automaton": "<file>"}, whose file is relative to the directory of
+         * the manifest. Files ending in .hoa are read as HOA files, the others
+         * as MONA DFA files. Throws std::runtime_error on malformed lines,
+         * unparsable formulas and formulas listed twice.
+         */
+        static PrecompiledAutomata read_manifest(const std::string &path);
+
+        /**
+         * \brief Uses the DFA of \a file for \a formula, replacing a previous entry of that formula.
+         */
+        void add(const whitemech::lydia::LTLfFormula &formula, std::string file);
+
+        /**
+         * \brief Returns the file of the DFA of \a formula, if it has an entry.
+         */
+        std::optional<std::string> find(const whitemech::lydia::LTLfFormula &formula) const;
+
+        std::size_t size() const { return files_.size(); }
+
+        /**
+         * \brief Reads the DFA of \a file, as a HOA file if it ends in .hoa and as a MONA DFA file otherwise.
+         *
+         * Throws std::runtime_error if the file cannot be read.
+         */
+        static ExplicitStateDfa load(const std::string &file);
+
+        /**
+         * \brief Reads a deterministic finite-word automaton in the HOA format.
+         *
+         * The automaton must have one initial state, explicit edge labels over
+         * its atomic propositions, and state-based acceptance Inf(0): its final
+         * states are those in acceptance set 0, as written by Spot for
+         * finite-word automata. Missing transitions go to a rejecting sink.
+         * The initial state becomes state 0 and rejects the empty trace, as in
+         * the DFAs of formulas. Throws std::runtime_error on other or malformed
+         * automata, naming \a source in the message.
+         */
+        static ExplicitStateDfa read_hoa(std::istream &in, const std::string &source = "HOA input");
+    };
+
+}
+
+#endif //PRECOMPILED_AUTOMATA_H
@@ -0,0 +1,121 @@
+#ifndef PRODUCT_ARENA_H
+#define PRODUCT_ARENA_H
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <cuddObj.hh>
+
+#include "automata/SymbolicStateDfa.h"
+
+namespace Syft {
+
+/**
+ * \brief The synchronous product of symbolic DFAs, kept as separate components.
+ *
+ * Unlike SymbolicStateDfa::product_AND, the product is never materialized:
+ * the final states stay per component, and preimages only compose the
+ * transition functions of the components whose state variables the target
+ * depends on. A symbolic_view is available for code that needs the product
+ * as a single SymbolicStateDfa.
+ */
+    class ProductArena {
+    private:
+        std::shared_ptr<VarMgr> var_mgr_;
+        std::vector<SymbolicStateDfa> components_;
+        std::size_t automaton_id_;
+
+        // component owning each variable index, or -1 for non-state variables
+        std::vector<int> component_of_variable_;
+        mutable std::optional<CUDD::BDD> final_states_;
+        mutable std::optional<CUDD::BDD> reachable_states_;
+
+    public:
+
+        /**
+         * \brief Creates the product of \a components, which must share one variable manager.
+         */
+        explicit ProductArena(std::vector<SymbolicStateDfa> components);
+
+        /**
+         * \brief Returns the variable manager.
+         */
+        std::shared_ptr<VarMgr> var_mgr() const;
+
+        /**
+         * \brief Returns the ID of the product state space.
+         */
+        std::size_t automaton_id() const;
+
+        /**
+         * \brief Returns the components of the product.
+         */
+        const std::vector<SymbolicStateDfa> &components() const;
+
+        /**
+         * \brief Returns the final states of component \a i.
+         */
+        CUDD::BDD final_states(std::size_t i) const;
+
+        /**
+         * \brief Returns the final states of the product, conjoined on first use.
+         */
+        CUDD::BDD final_states() const;
+
+        /**
+         * \brief Returns the BDD representing the initial state of the product.
+         */
+        CUDD::BDD initial_state_bdd() const;
+
+        /**
+         * \brief Returns the transitions into \a target, over state and alphabet variables.
+         *
+         * Equal to composing \a target with the transition function of the
+         * product, but only substitutes the state variables of components that
+         * \a target depends on.
+         */
+        CUDD::BDD preimage(const CUDD::BDD &target) const;
+
+        /**
+         * \brief Returns the product states reachable from the initial state, computed on first use.
+         *
+         * Excludes unreachable combinations of component states as well as the
+         * unused codes of each component.
+         */
+        CUDD::BDD reachable_states() const;
+
+        /**
+         * \brief Simplifies the transition functions of the components outside \a care_states.
+         *
+         * See SymbolicStateDfa::simplify_transitions; typically called with
+         * reachable_states. Each component only keeps the part of \a care_states
+         * over its own state variables, since Restrict abstracts the others.
+         */
+        void simplify_transitions(const CUDD::BDD &care_states);
+
+        /**
+         * \brief Simplifies the transition functions, the final states and \a colors outside \a care_states.
+         *
+         * See SymbolicStateDfa::simplify_on_care. Each component is simplified on
+         * the part of \a care_states over its own state variables, so that it
+         * keeps depending on those only, and colors equal to the final states of
+         * a component stay equal to them. Logs the shared node counts before and
+         * after; does nothing if \a method is Off.
+         */
+        void simplify_on_care(const CUDD::BDD &care_states, std::vector<CUDD::BDD> &colors,
+                              StrategyMinimization method);
+
+        /**
+         * \brief Returns the product as a single symbolic DFA.
+         *
+         * The transition function and initial state are the concatenations of
+         * those of the components. The final states are not conjoined: all states
+         * of the view are final; use final_states for the product's.
+         */
+        SymbolicStateDfa symbolic_view() const;
+    };
+
+}
+
+#endif // PRODUCT_ARENA_H
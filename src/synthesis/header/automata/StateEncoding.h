@@ -0,0 +1,83 @@
+#ifndef STATE_ENCODING_H
+#define STATE_ENCODING_H
+
+#include <string>
+#include <vector>
+
+#include "automata/ExplicitStateDfa.h"
+
+namespace Syft {
+
+/**
+ * \brief How the states of an explicit DFA are encoded in state variables.
+ */
+    enum class StateEncodingKind {
+        /** \brief The binary representation of the state index. */
+        Binary,
+        /** \brief The reflected Gray code of the state index. */
+        Gray,
+        /** \brief One state variable per state; only sensible for tiny DFAs. */
+        OneHot,
+        /**
+         * \brief The Gray code of the position of the state when states are
+         * numbered along a topological order of the SCCs, so that the states of
+         * an SCC, and consecutive SCCs, get neighbouring codes.
+         */
+        SccOrder,
+        /** \brief Picked per DFA by StateEncoding::choose. */
+        Automatic
+    };
+
+/**
+ * \brief The codes assigned to the states of an explicit DFA.
+ *
+ * Codes are vectors of bits from the least to the most significant state
+ * variable, as in SymbolicStateDfa::state_to_binary.
+ */
+    class StateEncoding {
+    private:
+        StateEncodingKind kind_;
+        std::size_t bit_count_;
+        std::vector<std::vector<int>> codes_;
+
+        StateEncoding(StateEncodingKind kind, std::size_t bit_count,
+                      std::vector<std::vector<int>> codes);
+
+    public:
+
+        /** \brief DFAs with at most this many states are one-hot encoded by choose. */
+        static constexpr std::size_t one_hot_max_states = 4;
+
+        /**
+         * \brief Computes the encoding of the states of \a dfa.
+         *
+         * \param kind The kind of encoding; Automatic is resolved by choose.
+         */
+        static StateEncoding of(const ExplicitStateDfa &dfa, StateEncodingKind kind);
+
+        /**
+         * \brief Picks an encoding for \a dfa by its state count and SCC structure.
+         *
+         * Tiny DFAs are one-hot encoded. Larger DFAs with more than one SCC use
+         * SccOrder; strongly connected ones keep Binary.
+         */
+        static StateEncodingKind choose(const ExplicitStateDfa &dfa);
+
+        /**
+         * \brief Parses an encoding name: binary, gray, one-hot, scc or auto.
+         */
+        static StateEncodingKind kind_from_string(const std::string &name);
+
+        /** \brief Returns the resolved kind of this encoding, never Automatic. */
+        StateEncodingKind kind() const;
+
+        /** \brief Returns the number of state variables of the encoding. */
+        std::size_t bit_count() const;
+
+        /** \brief Returns the code of \a state. */
+        const std::vector<int> &code(std::size_t state) const;
+    };
+
+}
+
+#endif // STATE_ENCODING_H
@@ -1,6 +1,7 @@
 #ifndef SYMBOLIC_STATE_DFA_H
 #define SYMBOLIC_STATE_DFA_H
 
+#include <functional>
 #include <memory>
 #include <vector>
 #include <optional>
@@ -8,6 +9,8 @@
 #include <cuddObj.hh>
 
 #include "ExplicitStateDfaAdd.h"
+#include "automata/StateEncoding.h"
+#include "game/StrategyMinimizer.h"
 #include "automata/ppltl/ValVisitor.h"
 #include <lydia/logic/nnf.hpp>
 #include <lydia/logic/ynf.hpp>
@@ -15,6 +18,20 @@
 
 namespace Syft {
 
+/**
+ * \brief Where the state variables of a PPLTL DFA are placed in the variable order.
+ */
+    enum class PPLTLVariableOrder {
+        /** \brief At the top of the order, in the order the subformulas are found. */
+        Creation,
+        /**
+         * \brief Each right below the deepest atom or state variable in the
+         * support of its transition function, so that a state bit sits next to
+         * the propositions and subformulas it is computed from.
+         */
+        Dependency
+    };
+
 /**
  * \brief A DFA with symbolic states and transitions.
  *
@@ -22,6 +39,8 @@ namespace Syft {
  */
     class SymbolicStateDfa {
     private:
+        friend class ProductArena;
+        friend class SymmetryQuotient;
 
         std::shared_ptr<VarMgr> var_mgr_;
         std::size_t automaton_id_;
@@ -31,6 +50,11 @@ namespace Syft {
         std::vector<CUDD::BDD> transition_function_;
         // std::vector<CUDD::BDD> transition_to_state_var_index_;
 
+        // computed on first call to reachable_states, reset by the mutators
+        mutable std::optional<CUDD::BDD> reachable_states_;
+        // the codes in use, if some were retired by merge_states or simplify_on_care
+        std::optional<CUDD::BDD> care_states_;
+
         SymbolicStateDfa(std::shared_ptr<VarMgr> var_mgr);
 
         static std::pair<std::size_t, std::size_t> create_state_variables(
@@ -46,6 +70,27 @@ namespace Syft {
                 std::size_t automaton_id,
                 const std::vector<size_t> &states);
 
+        // The DFA over fresh state variables whose c-th state is the class
+        // class_members[c], moving like its member class_cubes[c]
+        SymbolicStateDfa encode_classes(const std::vector<CUDD::BDD> &class_cubes,
+                                        const std::vector<CUDD::BDD> &class_members,
+                                        std::vector<CUDD::BDD> &colors,
+                                        const std::string &phase) const;
+
+        /**
+         * \brief Sends every transition into \a states to one of them, which loops on itself.
+         *
+         * \a states must be closed under transitions and agree on the final
+         * states. The initial state is kept as the representative if it is
+         * among them; the other codes of \a states leave the care states.
+         */
+        void merge_states(const CUDD::BDD &states);
+
+        // product_AND (conjunction) or product_OR of dfa_vector, moving its
+        // transition functions if it is an rvalue
+        template <typename DfaVector>
+        static SymbolicStateDfa product(DfaVector &&dfa_vector, bool conjunction, bool merge_sinks);
+
         static std::vector<CUDD::BDD> symbolic_transition_function(
                 const std::shared_ptr<VarMgr> &mgr,
                 std::size_t automaton_id,
@@ -61,11 +106,74 @@ namespace Syft {
          * variables, using BDDs to represent the transition function and the set of
          * final states.
          *
+         * Goes through the ADD representation of the DFA, which is costly for
+         * large DFAs; kept for debugging, use from_mona otherwise.
+         *
          * \param explicit_dfa The explicit DFA to be converted.
          * \return The symbolic representation of the DFA.
          */
         static SymbolicStateDfa from_explicit(const ExplicitStateDfaAdd &explicit_dfa);
 
+        /**
+         * \brief Converts a MONA DFA directly to a symbolic representation.
+         *
+         * Builds the bits of the transition function directly from the shared BDD
+         * nodes of the MONA DFA, converting each node once, without the ADD
+         * intermediate. With the Binary encoding, the result is the same as with
+         * from_explicit.
+         *
+         * \param var_mgr The variable manager in which to encode the DFA.
+         * \param explicit_dfa The explicit DFA to be converted.
+         * \param encoding How states are encoded in the state variables.
+         * \return The symbolic representation of the DFA.
+         */
+        static SymbolicStateDfa from_mona(std::shared_ptr<VarMgr> var_mgr,
+                                          const ExplicitStateDfa &explicit_dfa,
+                                          StateEncodingKind encoding = StateEncodingKind::Binary);
+
+        /**
+         * \brief Builds and converts several explicit DFAs, using worker threads.
+         *
+         * Each worker thread owns a separate variable manager, in which it encodes
+         * the DFAs it builds. Each result is transferred into \a var_mgr as soon
+         * as it and those before it are encoded, in the order of \a dfa_builders,
+         * so the state variables are created in the same order as with a
+         * sequential loop while the workers build the next DFAs. While waiting
+         * for a DFA, the parts transferred so far are reordered if \a var_mgr
+         * reorders at phases. The builders themselves run one at a time, since
+         * lydia and MONA keep global state; the encoding into BDDs and the
+         * transfers run concurrently.
+         *
+         * \param var_mgr The variable manager of the resulting DFAs. Its
+         *   input-output partition must already be set.
+         * \param dfa_builders Functions computing the explicit DFAs.
+         * \param thread_count The number of worker threads. With 1 or fewer, the
+         *   DFAs are built and encoded sequentially in \a var_mgr.
+         * \param encoding How the states of each DFA are encoded (see from_mona).
+         * \return The symbolic DFAs, one for each builder.
+         */
+        static std::vector<SymbolicStateDfa> from_explicit_parallel(
+                std::shared_ptr<VarMgr> var_mgr,
+                const std::vector<std::function<ExplicitStateDfa()>> &dfa_builders,
+                std::size_t thread_count,
+                StateEncodingKind encoding = StateEncodingKind::Binary);
+
+        /**
+         * \brief Returns a copy of this DFA in another variable manager.
+         *
+         * Input and output variables are matched by name. The state variables are
+         * mapped to fresh state variables of \a var_mgr.
+         */
+        SymbolicStateDfa transfer_to(std::shared_ptr<VarMgr> var_mgr) const;
+
+        /**
+         * \brief Returns a copy of this DFA in \a var_mgr, a clone of its variable manager.
+         *
+         * Unlike transfer_to, the copy keeps the automaton ID and the variable
+         * indices, since VarMgr::clone preserves them.
+         */
+        SymbolicStateDfa transfer_to_clone(std::shared_ptr<VarMgr> var_mgr) const;
+
         /**
          * \brief Creates a simple automaton that remembers the value of predicates.
          *
@@ -104,7 +212,7 @@ namespace Syft {
         /**
          * \brief Returns the bitvector representing the initial state of the DFA.
          */
-        std::vector<int> initial_state() const;
+        const std::vector<int> &initial_state() const;
 
         /**
          * \brief Returns the BDD representing the initial state of the DFA.
@@ -114,15 +222,106 @@ namespace Syft {
         /**
          * \brief Returns the BDD encoding the set of final states.
          */
-        CUDD::BDD final_states() const;
+        const CUDD::BDD &final_states() const;
 
         /**
          * \brief Returns the transition function of the DFA as a vector of BDDs.
          *
          * The BDD in index \a i computes the value of state variable \a i in the
          * next step, given the current values of the state and alphabet variables.
+         * The reference stays valid until the DFA is modified or destroyed; copy
+         * it to keep the functions beyond that.
          */
-        std::vector<CUDD::BDD> transition_function() const;
+        const std::vector<CUDD::BDD> &transition_function() const;
+
+        /**
+         * \brief Returns the function of state variable \a i, as transition_function()[i].
+         */
+        const CUDD::BDD &transition_bit(std::size_t i) const;
+
+        /**
+         * \brief Returns the states reachable from the initial state, computed on first use.
+         *
+         * The set is closed under the transition function, so games restricted to
+         * it (e.g. as the state space of EmersonLei) have the same winner in the
+         * initial state. Computing it creates a next-state copy of the state
+         * variables in the variable manager.
+         */
+        CUDD::BDD reachable_states() const;
+
+        /**
+         * \brief Returns the states from which no final state is reachable.
+         */
+        CUDD::BDD rejecting_sink_states() const;
+
+        /**
+         * \brief Returns the states from which every run only visits final states.
+         */
+        CUDD::BDD accepting_sink_states() const;
+
+        /**
+         * \brief Returns the state codes in use.
+         *
+         * All codes, unless the sinks of a product were merged (see product_AND),
+         * in which case the retired codes of the merged sinks are left out, or
+         * the DFA was simplified outside some states (see simplify_on_care). A
+         * superset of the reachable states, usable as the state space of games.
+         */
+        CUDD::BDD care_states() const;
+
+        /**
+         * \brief Simplifies the transition function with \a care_states as a don't-care mask.
+         *
+         * Each bit is replaced by its Restrict, or LICompaction with \a method,
+         * to \a care_states, so transitions from states outside \a care_states
+         * become arbitrary. Only sound when the DFA is used on a set of states
+         * closed under transitions and contained in \a care_states, such as
+         * reachable_states.
+         */
+        void simplify_transitions(const CUDD::BDD &care_states,
+                                  StrategyMinimization method = StrategyMinimization::Restrict);
+
+        /**
+         * \brief Simplifies the transition function, the final states and \a colors outside \a care_states.
+         *
+         * As simplify_transitions; the final states and the colors then only
+         * hold their exact value on \a care_states. Colors equal to the final
+         * states stay equal to them, and care_states is narrowed to
+         * \a care_states. Logs the shared node counts before and after; does
+         * nothing if \a method is Off.
+         */
+        void simplify_on_care(const CUDD::BDD &care_states, std::vector<CUDD::BDD> &colors,
+                              StrategyMinimization method);
+
+        /**
+         * \brief Returns the quotient of this DFA by bisimulation, encoded in fewer state variables.
+         *
+         * Two reachable states are equivalent if they agree on the final states
+         * and on each of \a colors, and if their successors are equivalent under
+         * every assignment of the alphabet. The equivalence is refined
+         * symbolically, over a copy of the state variables, until it is stable;
+         * each class is then numbered after its least state and the quotient is
+         * encoded in binary in fresh state variables. \a colors are replaced by
+         * their counterparts over the new state variables.
+         *
+         * Returns this DFA, and leaves \a colors unchanged, if the quotient has
+         * more than \a max_classes classes or needs as many state bits.
+         */
+        SymbolicStateDfa minimize(std::vector<CUDD::BDD> &colors, std::size_t max_classes = 4096) const;
+
+        /**
+         * \brief Returns this DFA with its states in use re-encoded in as few fresh state variables as possible.
+         *
+         * The states in use are the reachable care states. After restricting the
+         * DFA or merging sinks they may be a small fraction of the codes of its
+         * state variables; the n states in use are numbered and encoded in binary
+         * in ceil(log2(n)) fresh state variables, and \a colors are replaced by
+         * their counterparts over them. The states are enumerated one by one.
+         *
+         * Returns this DFA, and leaves \a colors unchanged, if more than
+         * \a max_states states are in use or they need as many state bits.
+         */
+        SymbolicStateDfa compact(std::vector<CUDD::BDD> &colors, std::size_t max_states = 4096) const;
 
         /**
             * \brief Restrict a symbolic DFA with a given set of states.
@@ -168,14 +367,69 @@ namespace Syft {
         void dump_json(const std::string &filename, 
                       std::optional<CUDD::BDD> alt_final_states = std::nullopt) const;
 
+        /**
+         * \brief Dumps the DFA in JSON format as BDD cubes, streamed to the file.
+         *
+         * Unlike dump_json, whose cost grows with 2^(state bits + inputs + outputs),
+         * the transition bits and the final states are written as the disjoint
+         * cubes of their BDDs, without building the output in memory. A cube is a
+         * string over the state bits (LSB first), then the inputs, then the
+         * outputs, with '0', '1' and '-' for don't care:
+         * - format: "cubes"
+         * - num_state_bits, num_inputs, num_outputs, state_var_indices
+         * - input_labels, output_labels, initial_minterm
+         * - trans_cubes: maps each state bit to the cubes where its next value is 1
+         * - accepting_cubes: cubes of the accepting states
+         * - reachable_cubes: cubes of the reachable states, only if \a reachable_only
+         *
+         * \param filename The name of the JSON file to save.
+         * \param alt_final_states Optional alternative final states BDD to use instead of the DFA's final_states_.
+         * \param reachable_only Whether to restrict the transition and accepting
+         *   cubes to the states reachable from the initial state.
+         */
+        void dump_json_cubes(const std::string &filename,
+                             std::optional<CUDD::BDD> alt_final_states = std::nullopt,
+                             bool reachable_only = false) const;
+
+        /**
+         * \brief Saves the DFA in a binary file (see BddArchive).
+         *
+         * Stores the transition bits, the final states, the initial state and the
+         * layout of the state variables and of the alphabet variables the DFA
+         * depends on.
+         */
+        void save(const std::string &filename) const;
+
+        /**
+         * \brief Loads a DFA saved with save into \a var_mgr, using fresh state variables.
+         *
+         * \a var_mgr must already have the input and output variables of the DFA;
+         * they are matched by name.
+         */
+        static SymbolicStateDfa load(std::shared_ptr<VarMgr> var_mgr, const std::string &filename);
+
         /**
          * \brief Returns a product AND of two symbolic DFAs.
          *
          * \param first_dfa The first DFA.
          * \param second_dfa The second DFA.
+         * \param merge_sinks Whether the product states in which some DFA is in
+         *   a rejecting sink are merged into one sink. Only sound when the product
+         *   is read by its final states alone, not by the final states of the
+         *   components.
          * \return A symbolic DFA of the product AND.
          */
-        static SymbolicStateDfa product_AND(const std::vector<SymbolicStateDfa> &dfa_vector);
+        static SymbolicStateDfa product_AND(const std::vector<SymbolicStateDfa> &dfa_vector,
+                                            bool merge_sinks = false);
+
+        /**
+         * \brief Returns the product AND of \a dfa_vector, moving the transition functions out of the DFAs.
+         *
+         * As product_AND of a const vector, without copying the BDDs of the
+         * components, which are left without transition functions.
+         */
+        static SymbolicStateDfa product_AND(std::vector<SymbolicStateDfa> &&dfa_vector,
+                                            bool merge_sinks = false);
 
         /**
          * \brief Returns the binary encoding of a given state index.
@@ -199,9 +453,18 @@ namespace Syft {
     *
     * \param first_dfa The first DFA.
     * \param second_dfa The second DFA.
+    * \param merge_sinks Whether the product states in which some DFA is in an
+    *   accepting sink are merged into one sink (see product_AND).
     * \return A symbolic DFA of the product OR.
     */
-        static SymbolicStateDfa product_OR(const std::vector<SymbolicStateDfa> &dfa_vector);
+        static SymbolicStateDfa product_OR(const std::vector<SymbolicStateDfa> &dfa_vector,
+                                           bool merge_sinks = false);
+
+        /**
+         * \brief Returns the product OR of \a dfa_vector, moving the transition functions out of the DFAs.
+         */
+        static SymbolicStateDfa product_OR(std::vector<SymbolicStateDfa> &&dfa_vector,
+                                           bool merge_sinks = false);
 
         /**
     * \brief Returns the complement of a symbolic DFA.
@@ -216,11 +479,16 @@ namespace Syft {
      * 
      * \param formula A PPLTL Formula
      * \param mgr The variable manager of the output DFA
+     * \param valuations Optional table of valuations over \a mgr, shared by the
+     *   DFAs of several formulas so that common subformulas are evaluated once
+     * \param order Where the new state variables go in the variable order
      * \return The symbolic-state DFA of the PPLTL formula
      */
         static SymbolicStateDfa dfa_of_ppltl_formula(
             const whitemech::lydia::PPLTLFormula& formula,
-            std::shared_ptr<VarMgr> mgr);
+            std::shared_ptr<VarMgr> mgr,
+            std::shared_ptr<PPLTLValuationTable> valuations = nullptr,
+            PPLTLVariableOrder order = PPLTLVariableOrder::Creation);
 
     /**
      * \brief Construct symbolic-state DFA for E(sdfa)
@@ -243,11 +511,15 @@ namespace Syft {
      * 
      * \param formula. A PPLTL formula
      * \param mgr. The variable manager of the output DFA
+     * \param valuations. Optional table of valuations over \a mgr (see dfa_of_ppltl_formula)
+     * \param order. Where the new state variables go in the variable order
      * \return The symbolic-state DFA of the PPLTL formula with no loops in the initial state
      */
         static SymbolicStateDfa dfa_of_ppltl_formula_remove_initial_self_loops(
             const whitemech::lydia::PPLTLFormula& formula,
-            std::shared_ptr<VarMgr> mgr
+            std::shared_ptr<VarMgr> mgr,
+            std::shared_ptr<PPLTLValuationTable> valuations = nullptr,
+            PPLTLVariableOrder order = PPLTLVariableOrder::Creation
         );
     };
 
@@ -0,0 +1,100 @@
+#ifndef SYMMETRY_QUOTIENT_H
+#define SYMMETRY_QUOTIENT_H
+
+#include "automata/DfaSymmetry.h"
+#include "automata/SymbolicStateDfa.h"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace Syft {
+
+/**
+ * \brief The product of color DFAs quotiented by the permutations of their orbits.
+ *
+ * The members of an orbit are renamed copies of its representative (see
+ * rename_atoms), so they encode each state by the same code, and permuting
+ * them maps the product onto itself. The quotient keeps one state per class
+ * of permuted states, the one whose orbit members have nondecreasing codes:
+ * each transition of the product is followed by sorting the next codes of
+ * each orbit, by a network of compare-exchanges on the bits of the next-state
+ * functions. An orbit of n colors thus has up to n! fewer states.
+ *
+ * The quotient is a game arena with the same winner from the initial state
+ * as the product, for protagonists of either side, under conditions that
+ * only read final states closed under the permutations; those of
+ * find_color_orbits are. From a state of the quotient the game continues as
+ * from every state of its class, with the atoms of the orbits permuted
+ * alike, so strategies of the quotient are lifted to the product by
+ * lift_move.
+ */
+    class SymmetryQuotient {
+    public:
+        /**
+         * \brief Builds the quotient of the product of \a components.
+         *
+         * \param components The DFAs of the colors, in the order of their state bits in the product.
+         * \param component_colors The color of each component.
+         * \param final_states The final states of the product, closed under the permutations of \a orbits.
+         * \param orbits Orbits of the colors, whose members other than the representative
+         *   are the renamed copies of the representative.
+         */
+        SymmetryQuotient(std::vector<SymbolicStateDfa> components, const std::vector<int> &component_colors,
+                         const CUDD::BDD &final_states, std::vector<ColorOrbit> orbits);
+
+        /**
+         * \brief Returns the quotient arena, whose care states are the canonical states.
+         */
+        const SymbolicStateDfa &arena() const;
+
+        /**
+         * \brief Returns the states in which the members of each orbit have nondecreasing codes.
+         */
+        const CUDD::BDD &canonical_states() const;
+
+        /**
+         * \brief Returns the permutation of the variables that maps the state of \a assignment to its canonical state.
+         *
+         * \param assignment A value for each BDD variable, by index, as read by CUDD::BDD::Eval.
+         * \return The index each variable is moved to: state and atom variables are
+         *   moved along with the orbit member they belong to, others stay.
+         */
+        std::vector<int> canonical_permutation(const std::vector<int> &assignment) const;
+
+        /**
+         * \brief Moves the value of each variable i of \a assignment to variable \a permutation[i].
+         */
+        static std::vector<int> permute(const std::vector<int> &assignment, const std::vector<int> &permutation);
+
+        /**
+         * \brief Plays a strategy of the quotient in a state of the product.
+         *
+         * \param assignment The state of the product and the moves already made this turn.
+         * \param quotient_strategy Completes an assignment of a canonical state with the
+         *   move of the protagonist.
+         * \return \a assignment completed with the move of the protagonist in the product.
+         */
+        std::vector<int> lift_move(const std::vector<int> &assignment,
+                                   const std::function<std::vector<int>(const std::vector<int> &)> &quotient_strategy) const;
+
+    private:
+        // The variable indices of an orbit member, by bit and by atom of the representative
+        struct Member {
+            std::vector<int> state_variables;
+            std::vector<int> atom_variables;
+        };
+
+        std::shared_ptr<VarMgr> var_mgr_;
+        // The state variables of each component, read before the components move into the product
+        std::vector<std::vector<CUDD::BDD>> component_variables_;
+        SymbolicStateDfa arena_;
+        std::vector<std::vector<Member>> orbit_members_;
+        CUDD::BDD canonical_states_;
+
+        static std::vector<std::vector<CUDD::BDD>> variables_of(const std::vector<SymbolicStateDfa> &components);
+    };
+
+}
+
+#endif // SYMMETRY_QUOTIENT_H
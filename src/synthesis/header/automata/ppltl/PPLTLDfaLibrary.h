@@ -0,0 +1,85 @@
+#ifndef PPLTL_DFA_LIBRARY_H
+#define PPLTL_DFA_LIBRARY_H
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "VarMgr.h"
+#include "automata/SymbolicStateDfa.h"
+#include "automata/ppltl/ValVisitor.h"
+#include "game/InputOutputPartition.h"
+#include <lydia/logic/ppltl/base.hpp>
+
+namespace Syft {
+
+/**
+ * \brief Symbolic DFAs of PPLTL formulas converted once and loaded by the synthesizers instead of being built.
+ *
+ * A library is a directory of DFAs saved by SymbolicStateDfa::save, which
+ * record the layout of their variables, and a manifest listing them, one flat
+ * JSON object per line, {"formula": "<PPLTL formula>", "dfa": "<file>"},
+ * whose file is relative to the directory of the manifest. Entries are
+ * matched on the lydia string of the formula, so a color whose PPLTL
+ * argument is a formula of the library loads its DFA onto fresh state
+ * variables; the variable manager of the synthesizer must have the variables
+ * the DFA depends on.
+ */
+    class PPLTLDfaLibrary {
+    private:
+        // File of each entry, by formula string
+        std::unordered_map<std::string, std::string> files_;
+
+    public:
+
+        /**
+         * \brief Converts \a formulas to symbolic DFAs over \a var_mgr and saves them as a library in \a directory.
+         *
+         * The DFAs share \a var_mgr and one table of valuations, so the
+         * subformulas common to several formulas are converted once. The
+         * alphabet variables are partitioned as in \a partition, if given,
+         * which must then have every variable of the formulas; otherwise all
+         * of them are recorded as inputs, which the synthesizers match by
+         * name alike. Equal formulas are stored once. The manifest is written
+         * to manifest.jsonl in \a directory, which is created if needed.
+         * Throws std::runtime_error on unparsable formulas and unwritable files.
+         */
+        static PPLTLDfaLibrary compile(const std::vector<std::string> &formulas, const std::string &directory,
+                                       const std::shared_ptr<VarMgr> &var_mgr,
+                                       const InputOutputPartition *partition = nullptr,
+                                       PPLTLVariableOrder order = PPLTLVariableOrder::Creation);
+
+        /**
+         * \brief Reads the manifest of a library.
+         *
+         * Throws std::runtime_error on malformed lines, unparsable formulas and
+         * formulas listed twice.
+         */
+        static PPLTLDfaLibrary read_manifest(const std::string &path);
+
+        /**
+         * \brief Uses the DFA saved in \a file for \a formula, replacing a previous entry of that formula.
+         */
+        void add(const whitemech::lydia::PPLTLFormula &formula, std::string file);
+
+        /**
+         * \brief Returns the file of the DFA of \a formula, if it has an entry.
+         */
+        std::optional<std::string> find(const whitemech::lydia::PPLTLFormula &formula) const;
+
+        std::size_t size() const { return files_.size(); }
+
+        /**
+         * \brief Returns the DFA of \a formula: loaded from the library if it has an entry, built by SymbolicStateDfa::dfa_of_ppltl_formula otherwise.
+         */
+        SymbolicStateDfa dfa_of(const whitemech::lydia::PPLTLFormula &formula, std::shared_ptr<VarMgr> var_mgr,
+                                std::shared_ptr<PPLTLValuationTable> valuations = nullptr,
+                                PPLTLVariableOrder order = PPLTLVariableOrder::Creation) const;
+    };
+
+}
+
+#endif //PPLTL_DFA_LIBRARY_H
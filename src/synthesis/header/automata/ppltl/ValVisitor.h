@@ -1,6 +1,8 @@
 #ifndef VAL_VISITOR_H
 #define VAL_VISITOR_H
 
+#include<string>
+#include<unordered_map>
 #include"cuddObj.hh"
 #include"VarMgr.h"
 #include<lydia/visitor.hpp>
@@ -30,6 +32,9 @@ namespace Syft {
         CUDD::BDD result;
         std::shared_ptr<VarMgr> mgr_;
         StrPrinter p;
+        // valuations of the nodes visited so far, so that shared subformulas are
+        // evaluated once; only valid while the visited formula is alive
+        std::unordered_map<const PPLTLFormula*, CUDD::BDD> memo_;
 
         public:
             void visit(const PPLTLTrue& ) override;
@@ -52,5 +57,35 @@ namespace Syft {
     };
 
     CUDD::BDD val(const PPLTLFormula& x, std::shared_ptr<VarMgr> mgr);
+
+    /**
+     * \brief Valuations of PPLTL formulas in one variable manager, shared across formulas.
+     *
+     * Keyed by the printed formula, which also names the state variables of
+     * Yesterday subformulas, so the DFAs of structurally equal subformulas of
+     * different colors share both their state bit and their valuation BDD.
+     */
+    class PPLTLValuationTable {
+        std::shared_ptr<VarMgr> mgr_;
+        std::unordered_map<std::string, CUDD::BDD> valuations_;
+        StrPrinter p_;
+        std::size_t hits_ = 0;
+
+        public:
+            explicit PPLTLValuationTable(std::shared_ptr<VarMgr> mgr);
+
+            /**
+             * \brief Returns val(\a x), computed once per structurally distinct formula.
+             */
+            CUDD::BDD val(const PPLTLFormula& x);
+
+            std::shared_ptr<VarMgr> var_mgr() const;
+
+            /** \brief Returns the number of distinct formulas evaluated. */
+            std::size_t size() const;
+
+            /** \brief Returns the number of valuations served from the table. */
+            std::size_t hits() const;
+    };
 }
 #endif // VAL_VISITOR_H
\ No newline at end of file
@@ -0,0 +1,129 @@
+#ifndef ABSTRACTION_REFINEMENT_H
+#define ABSTRACTION_REFINEMENT_H
+
+#include "automata/SymbolicStateDfa.h"
+#include "game/BuchiSolver.hpp"
+#include "game/ColorFormula.h"
+#include "game/StateAbstraction.h"
+#include "Synthesizer.h"
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace Syft {
+
+/**
+ * \brief How AbstractionRefinement picks and refines the hidden components.
+ */
+    struct AbstractionRefinementOptions {
+        std::vector<std::size_t> hidden_components;  // components hidden at first; picked by bits if empty
+        std::size_t max_visible_bits = 24;  // without hidden_components, hide the largest components but one down to this
+        std::size_t refine_per_round = 1;  // components made visible again after an inconclusive round
+    };
+
+/**
+ * \brief The verdict of AbstractionRefinement::run and the approximations of its last round.
+ */
+    struct AbstractionRefinementResult {
+        bool realizability;
+        /** \brief States won by the protagonist, those of the under-approximation. */
+        CUDD::BDD winning_states;
+        /**
+         * \brief States the protagonist may win: all others are lost.
+         *
+         * Those of the over-approximation, or all states if the
+         * under-approximation was conclusive.
+         */
+        CUDD::BDD possibly_winning_states;
+        std::size_t rounds = 0;
+        /** \brief The components hidden in the last round. */
+        std::vector<std::size_t> hidden_components;
+    };
+
+/**
+ * \brief Solves a game on a large product arena by abstraction refinement.
+ *
+ * The state bits of some components of the arena are hidden (see
+ * StateAbstraction), and the game is solved twice per round by the inner
+ * solver: with the opponent picking the hidden bits, an under-approximation
+ * for the protagonist, and with the protagonist picking them, an
+ * over-approximation. The verdict is that of the first if the protagonist
+ * wins it, and that of the second if it loses it; otherwise the winning
+ * regions disagree on the initial state, and the abstract plays from the
+ * states in between win by choosing hidden bits the arena would not. The
+ * hidden components the over-approximation depends on in those states are
+ * made visible again, and the next round starts. A round without hidden
+ * components solves the arena itself, so the verdict is always reached.
+ */
+    class AbstractionRefinement {
+    public:
+        /**
+         * \brief Solves the game of the arena on \a abstraction, or on the arena if none.
+         */
+        using InnerSolver = std::function<SynthesisResult(const std::optional<StateAbstraction> &abstraction)>;
+
+        /**
+         * \brief Prepares the refinement of \a arena.
+         *
+         * \param arena The product arena.
+         * \param components The state variables of each component of \a arena;
+         *   those of state_bit_components if empty.
+         * \param options Which components are hidden at first and how many are refined per round.
+         */
+        AbstractionRefinement(const SymbolicStateDfa &arena,
+                              std::vector<std::vector<CUDD::BDD>> components = {},
+                              AbstractionRefinementOptions options = AbstractionRefinementOptions());
+
+        /**
+         * \brief Groups the state variables of \a arena into the components of a product.
+         *
+         * Two state variables are in the same group if one is in the support of
+         * the transition function of the other, transitively, so a product of
+         * DFAs over disjoint state variables has a group per DFA, or more.
+         */
+        static std::vector<std::vector<CUDD::BDD>> state_bit_components(const SymbolicStateDfa &arena);
+
+        /**
+         * \brief Refines until \a solve returns a conclusive verdict.
+         */
+        AbstractionRefinementResult run(const InnerSolver &solve) const;
+
+        /**
+         * \brief Returns an inner solver running EmersonLei on \a arena.
+         */
+        static InnerSolver emerson_lei(const SymbolicStateDfa &arena, ColorFormula color_formula,
+                                       Player starting_player, Player protagonist_player,
+                                       std::vector<CUDD::BDD> colors, CUDD::BDD state_space,
+                                       CUDD::BDD instant_winning, CUDD::BDD instant_losing);
+
+        /**
+         * \brief Returns an inner solver running BuchiSolver on \a arena.
+         *
+         * \a mode LAYERED is solved as CLASSIC under abstractions, whose plays
+         * do not follow the SCCs of the arena.
+         */
+        static InnerSolver buchi(const SymbolicStateDfa &arena, Player starting_player, Player protagonist_player,
+                                 CUDD::BDD state_space,
+                                 BuchiSolver::BuchiMode mode = BuchiSolver::BuchiMode::CLASSIC);
+
+        const std::vector<std::vector<CUDD::BDD>> &components() const { return components_; }
+
+    private:
+        std::shared_ptr<VarMgr> var_mgr_;
+        std::size_t state_bits_;
+        std::vector<std::vector<CUDD::BDD>> components_;
+        AbstractionRefinementOptions options_;
+
+        // The components hidden in the first round
+        std::vector<std::size_t> initial_hidden() const;
+        CUDD::BDD hidden_cube(const std::vector<std::size_t> &hidden) const;
+        // The hidden components to make visible, given the approximations that disagree on the initial state
+        std::vector<std::size_t> components_to_refine(const std::vector<std::size_t> &hidden,
+                                                      const CUDD::BDD &under, const CUDD::BDD &over) const;
+    };
+
+}
+
+#endif // ABSTRACTION_REFINEMENT_H
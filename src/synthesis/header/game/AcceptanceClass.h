@@ -0,0 +1,47 @@
+#ifndef ACCEPTANCE_CLASS_H
+#define ACCEPTANCE_CLASS_H
+
+#include <string>
+
+#include "game/ZielonkaTree.hh"
+
+namespace Syft {
+
+/**
+ * \brief The shape of an Emerson-Lei condition, read off its Zielonka tree.
+ */
+enum class AcceptanceClass {
+    Reachability,        ///< A single losing node: reach the instantly winning states
+    Safety,              ///< A single winning node: stay in the state space
+    Buchi,               ///< A winning root with one leaf child
+    CoBuchi,             ///< A losing root with one leaf child
+    GeneralizedBuchi,    ///< A winning root with several leaf children
+    GeneralizedCoBuchi,  ///< A losing root with several leaf children
+    ParityChain,         ///< A chain of three or more nodes, i.e. a parity or Rabin chain condition
+    GR1Like,             ///< A winning root of height three, e.g. a GR(1) condition
+    General
+};
+
+/**
+ * \brief Classifies the condition whose Zielonka tree has root \a root.
+ */
+AcceptanceClass classify_acceptance(const ZielonkaNode *root);
+
+/**
+ * \brief Classifies the condition of \a tree, expanding only the nodes the class depends on.
+ *
+ * Those are the nodes of the first three levels, and the chain of only
+ * children below the root, so that most of a lazy tree stays unbuilt.
+ */
+AcceptanceClass classify_acceptance(ZielonkaTree &tree);
+
+/**
+ * \brief Whether the class needs at most two nested fixpoints, i.e. the tree has height at most two.
+ */
+bool is_two_level(AcceptanceClass acceptance);
+
+std::string to_string(AcceptanceClass acceptance);
+
+}
+
+#endif // ACCEPTANCE_CLASS_H
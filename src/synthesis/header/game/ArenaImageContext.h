@@ -0,0 +1,105 @@
+#ifndef ARENA_IMAGE_CONTEXT_H
+#define ARENA_IMAGE_CONTEXT_H
+
+#include "automata/SymbolicStateDfa.h"
+#include "game/PartitionedTransitionRelation.h"
+#include "cuddObj.hh"
+#include <memory>
+#include <vector>
+
+namespace Syft {
+
+/**
+ * \brief Image and preimage operators of an arena, with everything they need built once.
+ *
+ * Copying the transition function, looking up the state variables and cubes
+ * and building the compose vector cost as much as a small image on arenas
+ * with many small SCCs, so SCC decomposers build one context per arena and
+ * reuse it across all their PeelLayer calls. The primed state variables and
+ * the partitioned transition relation are only created on first use.
+ */
+class ArenaImageContext {
+private:
+    const SymbolicStateDfa& arena_;
+    std::shared_ptr<VarMgr> var_mgr_;
+    std::size_t automaton_id_;
+    std::size_t state_bits_;
+    std::vector<CUDD::BDD> transition_function_;
+    std::vector<CUDD::BDD> state_variables_;
+    CUDD::BDD state_cube_;
+    CUDD::BDD io_cube_;
+
+    // Rebuilt when variables are created, since it must cover all of them
+    mutable std::vector<CUDD::BDD> compose_vector_;
+    mutable std::unique_ptr<PartitionedTransitionRelation> relation_;
+    // s <-> s' substitutions, built with the relation
+    mutable std::vector<CUDD::BDD> unprimed_swap_;
+    mutable std::vector<CUDD::BDD> primed_swap_;
+    // Images and preimages computed so far
+    mutable std::size_t steps_ = 0;
+
+    const std::vector<CUDD::BDD>& ComposeVector() const;
+
+public:
+    /**
+     * \brief Builds the context of \a arena, which must outlive it.
+     */
+    explicit ArenaImageContext(const SymbolicStateDfa& arena);
+
+    /**
+     * \brief Returns the pairs of state and move leading into \a states, over s, x and y.
+     */
+    CUDD::BDD Compose(const CUDD::BDD& states) const;
+
+    /**
+     * \brief Returns the states reachable from \a states in one step.
+     */
+    CUDD::BDD Image(const CUDD::BDD& states) const;
+
+    /**
+     * \brief Returns the states with a successor in \a states for some move.
+     */
+    CUDD::BDD Preimage(const CUDD::BDD& states) const;
+
+    /**
+     * \brief Renames the state variables of \a states to the primed ones.
+     */
+    CUDD::BDD ToPrimed(const CUDD::BDD& states) const;
+
+    /**
+     * \brief Swaps the state and primed state variables of \a relation.
+     */
+    CUDD::BDD SwapPrimed(const CUDD::BDD& relation) const;
+
+    /**
+     * \brief Returns one state of \a states, or zero if it is empty.
+     */
+    CUDD::BDD PickState(const CUDD::BDD& states) const;
+
+    /**
+     * \brief Returns the partitioned transition relation, building it on first use.
+     */
+    const PartitionedTransitionRelation& Relation() const;
+
+    /**
+     * \brief Returns the ID of the primed state variables, creating them on first use.
+     */
+    std::size_t primed_automaton_id() const;
+
+    /**
+     * \brief Returns the number of Compose, Image and Preimage calls so far, the symbolic steps of a decomposer.
+     */
+    std::size_t step_count() const { return steps_; }
+
+    std::shared_ptr<VarMgr> var_mgr() const { return var_mgr_; }
+    std::size_t automaton_id() const { return automaton_id_; }
+    std::size_t state_bit_count() const { return state_bits_; }
+    const std::vector<CUDD::BDD>& transition_function() const { return transition_function_; }
+    const std::vector<CUDD::BDD>& state_variables() const { return state_variables_; }
+    const CUDD::BDD& state_cube() const { return state_cube_; }
+    const CUDD::BDD& io_cube() const { return io_cube_; }
+};
+
+} // namespace Syft
+
+#endif // ARENA_IMAGE_CONTEXT_H
@@ -0,0 +1,126 @@
+#ifndef BDD_CIRCUIT_H
+#define BDD_CIRCUIT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "cuddObj.hh"
+#include "VarMgr.h"
+
+namespace Syft {
+
+/**
+ * \brief BDDs flattened into one array of multiplexers over the slots of a valuation.
+ *
+ * Each variable of the BDDs is read from a slot, and each node is stored
+ * once per polarity it is reached with, so that complement edges disappear
+ * and shared subgraphs are stored once across every function added. Nodes
+ * are numbered children first, after the two terminals, so a range of nodes
+ * can be evaluated in order. A node is evaluated either on one valuation, by
+ * indexing its children with the value of its slot, or bit-sliced on 64
+ * valuations per word, with AND, OR and NOT and no branch on the values.
+ */
+class BddCircuit {
+ public:
+
+  static constexpr std::uint32_t false_node = 0;
+  static constexpr std::uint32_t true_node = 1;
+
+  struct Node {
+    std::uint32_t slot;
+    // The else child, then the then child, so that a value indexes its child
+    std::uint32_t child[2];
+  };
+
+  /**
+   * \brief Creates a circuit without slots over the variables of \a var_mgr.
+   */
+  explicit BddCircuit(std::shared_ptr<VarMgr> var_mgr);
+
+  /**
+   * \brief Reads the variable of \a index from the next slot, and returns that slot.
+   */
+  std::uint32_t add_slot(int index);
+
+  /**
+   * \brief Returns the slot of the variable of \a index.
+   *
+   * Throws std::runtime_error if the variable has no slot.
+   */
+  std::uint32_t slot(int index) const;
+
+  std::size_t slot_count() const {return slot_of_.size();}
+
+  /**
+   * \brief Adds the nodes of \a function not already in the circuit and returns its root.
+   *
+   * Throws std::runtime_error if \a function depends on a variable without a slot.
+   */
+  std::uint32_t add(const CUDD::BDD& function);
+
+  /**
+   * \brief Returns the slots \a function depends on, in increasing order.
+   */
+  std::vector<std::uint32_t> support(const CUDD::BDD& function) const;
+
+  /**
+   * \brief Returns the number of nodes, terminals included.
+   */
+  std::size_t size() const {return nodes_.size();}
+
+  const std::vector<Node>& nodes() const {return nodes_;}
+
+  /**
+   * \brief Returns the terminal \a node evaluates to on \a values, one value (0 or 1) per slot.
+   */
+  std::uint32_t evaluate(std::uint32_t node, const std::uint8_t* values) const {
+    return evaluate(nodes_.data(), node, values);
+  }
+
+  /**
+   * \brief Evaluates the nodes numbered from \a begin to \a end bit-sliced, on 64 * \a words valuations.
+   *
+   * Bit j of word w of slot s, at values[s * words + w], is the value of slot
+   * s in valuation 64 * w + j. Node n is written to node_values[n * words + w],
+   * which for its children must be already written: the terminals, set here,
+   * or nodes evaluated by an earlier call.
+   */
+  void evaluate(std::size_t begin, std::size_t end, const std::uint64_t* values, std::size_t words,
+                std::uint64_t* node_values) const {
+    evaluate(nodes_.data(), begin, end, values, words, node_values);
+  }
+
+  /**
+   * \brief As evaluate, over a node array stored elsewhere, e.g. mapped from a file.
+   */
+  static std::uint32_t evaluate(const Node* nodes, std::uint32_t node, const std::uint8_t* values) {
+    while (node > true_node) {
+      const Node& current = nodes[node];
+      node = current.child[values[current.slot]];
+    }
+    return node;
+  }
+
+  static void evaluate(const Node* nodes, std::size_t begin, std::size_t end, const std::uint64_t* values,
+                       std::size_t words, std::uint64_t* node_values);
+
+ private:
+
+  std::shared_ptr<VarMgr> var_mgr_;
+  std::unordered_map<int, std::uint32_t> slot_of_;
+  std::vector<Node> nodes_;
+  std::map<std::pair<DdNode*, bool>, std::uint32_t> compiled_;
+  // Referenced, so that the nodes keyed in compiled_ are not recycled
+  std::vector<CUDD::BDD> functions_;
+
+  std::uint32_t add(DdNode* node, bool complemented);
+};
+
+}
+
+#endif // BDD_CIRCUIT_H
@@ -28,6 +28,11 @@ namespace Syft {
          */
         CUDD::BDD Buchi_;
 
+        /**
+         * \brief The number of outer iterations of the last run.
+         */
+        mutable std::size_t outer_iterations_ = 0;
+
     public:
 
         /**
@@ -51,9 +56,21 @@ namespace Syft {
          * realizability
          * a set of agent winning states
          * a transducer representing a winning strategy or nullptr if the game is unrealizable.
+         *
+         * With FixpointMode::Frontier, the inner least fixpoint is warm-started: it
+         * stays within the inner fixpoint of the previous outer iteration, and after
+         * its first iteration only re-examines predecessors of the last added states.
+         * The composed sets (W | goal) and (Y | goal) are updated from their changes
+         * instead of being recomposed. A state entering Y keeps the moves it entered with.
+         * The inner iterations are recorded in fixpoint_trace().
          */
         SynthesisResult run() const final;
 
+        /**
+         * \brief Returns the number of outer iterations of the last run.
+         */
+        std::size_t outer_iterations() const;
+
     };
 }
 
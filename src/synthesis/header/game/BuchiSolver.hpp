@@ -2,7 +2,12 @@
 
 #include "automata/SymbolicStateDfa.h"
 #include "game/DfaGameSynthesizer.h"
+#include "game/FixpointTrace.h"
+#include "game/GameKernel.h"
+#include "game/SCCDecomposer.h"
+#include "game/StateAbstraction.h"
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 #include <algorithm>
@@ -18,7 +23,9 @@ namespace Syft
         {
             CLASSIC,
             PITERMAN,
-            COBUCHI
+            COBUCHI,
+            // one fixpoint per SCC layer of an SCCDecomposer, bottom layer first
+            LAYERED
         };
 
         BuchiSolver(const SymbolicStateDfa &spec,
@@ -33,7 +40,8 @@ namespace Syft
     private:
         // Build a BDD representing a concrete state assignment (state vars only)
         CUDD::BDD state_index_to_bdd(std::size_t index) const;
-        std::unique_ptr<Syft::Quantification> quantify_independent_variables_, quantify_non_state_variables_;
+        // The quantifiers of the controllable predecessor for the order of play
+        GameKernel kernel_;
         // Print a state-set BDD by enumerating concrete state indices (safe for small automata)
         void print_state_set(const CUDD::BDD &set_bdd,
                              const std::string &label,
@@ -57,13 +65,25 @@ namespace Syft
         CUDD::BDD normalize_state_set(const CUDD::BDD &bdd_maybe_with_io) const;
 
         // core algorithm pieces
-        CUDD::BDD computeCPreForPlayer(Player player, const CUDD::BDD &states) const;
-        CUDD::BDD CPre_agent(const CUDD::BDD &W_states) const;
-        CUDD::BDD CPre_env(const CUDD::BDD &W_states) const;
+        // The states from which the protagonist forces the next state into W_states
+        CUDD::BDD CPre(const CUDD::BDD &W_states) const;
 
         CUDD::BDD computeCPre(const CUDD::BDD &states) const;
 
-        bool DoubleFixpoint();
+        // CPre restricted to the states in care, composing transitions Restricted to care
+        CUDD::BDD CPre_care(const CUDD::BDD &W_states, const CUDD::BDD &care) const;
+        // States with a transition into states, for some move
+        CUDD::BDD predecessors(const CUDD::BDD &states) const;
+
+        // The winning states of the classic double fixpoint, partial when it stops early
+        CUDD::BDD DoubleFixpoint();
+
+        // Solves the layers of the SCC decomposition bottom-up, each with the
+        // cheapest fixpoint for its accepting states (see BuchiMode::LAYERED)
+        CUDD::BDD LayeredFixpoint() const;
+        // The states of layer that win given that below are the winning states of
+        // the lower layers; appends the traces of its fixpoints to inner_traces_
+        CUDD::BDD solve_layer(const CUDD::BDD &layer, const CUDD::BDD &below) const;
 
         // internal bookkeeping
         SymbolicStateDfa game_;
@@ -82,10 +102,49 @@ namespace Syft
         BuchiMode buechi_mode_ = BuchiMode::CLASSIC;
         // enable verbose debug printing when true
         bool debug_enabled_ = false;
+        // reuse the previous outer iteration's inner results (see set_warm_start)
+        bool warm_start_ = false;
+        // one trace per inner fixpoint of the last run, in order
+        mutable std::vector<FixpointTrace> inner_traces_;
+        // stop once the initial state is decided (see set_realizability_only)
+        bool realizability_only_ = false;
+        // decomposer used by the LAYERED mode (see set_scc_algorithm)
+        SCCAlgorithm scc_algorithm_ = SCCAlgorithm::Naive;
+        ChainOptions scc_chain_;
+        // solve on this abstraction of the arena (see set_state_abstraction)
+        std::optional<StateAbstraction> state_abstraction_;
 
     public:
         // enable/disable debug prints at runtime
         void set_debug(bool enabled) { debug_enabled_ = enabled; }
+
+        // Warm-start the inner fixpoints of the CLASSIC and PITERMAN modes.
+        // CLASSIC: the inner least fixpoint stays within the previous outer
+        // approximation and only re-examines predecessors of its last added states.
+        // PITERMAN: the safety step never re-examines the previous winning set, and
+        // the reachability step continues from the states added since the last one.
+        void set_warm_start(bool enabled) { warm_start_ = enabled; }
+
+        // Only compute the verdict: the outer fixpoints stop as soon as the initial
+        // state leaves the over-approximation (CLASSIC) or enters the
+        // under-approximation (PITERMAN, COBUCHI), or once the layer of the initial
+        // state is solved (LAYERED); winning states may be partial.
+        void set_realizability_only(bool enabled) { realizability_only_ = enabled; }
+
+        // SCC decomposition algorithm computing the layers of the LAYERED mode,
+        // with the pivot selection of the chain algorithm
+        void set_scc_algorithm(SCCAlgorithm algorithm, const ChainOptions &chain = ChainOptions())
+        {
+            scc_algorithm_ = algorithm;
+            scc_chain_ = chain;
+        }
+
+        // Solve on an abstraction of the arena, as DfaGameSynthesizer::set_state_abstraction;
+        // not supported by the LAYERED mode, whose layers are SCCs of the arena
+        void set_state_abstraction(std::optional<StateAbstraction> abstraction) { state_abstraction_ = std::move(abstraction); }
+
+        // Per-iteration counters of the inner fixpoints of the last run
+        const std::vector<FixpointTrace> &inner_traces() const { return inner_traces_; }
     };
 
 } // namespace Syft
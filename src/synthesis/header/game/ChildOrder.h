@@ -0,0 +1,32 @@
+#ifndef CHILD_ORDER_H
+#define CHILD_ORDER_H
+
+#include <string>
+
+namespace Syft {
+
+/**
+ * \brief The order in which EmersonLeiSolve visits the children of a Zielonka tree node.
+ *
+ * The children of a node are combined by intersection (winning node) or
+ * union (losing node), so the order does not change the solution; it
+ * decides how soon the remaining children can be skipped (see
+ * EmersonLei::set_child_order).
+ */
+enum class ChildOrder {
+  /** \brief The order of the tree, by sibling_order. */
+  Construction,
+  /** \brief Children of a winning node by increasing target set, of a losing node by decreasing target set. */
+  SmallestTarget,
+  /** \brief Children whose result changed in the previous iteration first, then the others, each in the order of the tree. */
+  ChangedFirst
+};
+
+/**
+ * \brief Parses construction, smallest-target or changed-first; throws std::runtime_error otherwise.
+ */
+ChildOrder child_order_from_string(const std::string& name);
+
+}
+
+#endif //CHILD_ORDER_H
@@ -0,0 +1,118 @@
+#ifndef COLOR_FORMULA_H
+#define COLOR_FORMULA_H
+
+#include "cuddObj.hh"
+#include "game/ColorSet.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Syft {
+
+/**
+ * \brief An Emerson-Lei color condition compiled once into a stack program.
+ *
+ * The formula is parsed like ELHelpers::tokenize and ELHelpers::infix2postfix
+ * ("Inf i" is color i, "Fin i" its negation), and the postfix tokens are
+ * turned into instructions with the color indices already decoded. Sets of at
+ * most 64 colors are evaluated over a uint64_t bitmask, with the stack held in
+ * a single word; for up to truth_table_max_colors colors the whole truth table
+ * is computed at construction, so evaluation is a lookup.
+ */
+class ColorFormula {
+ public:
+
+  static constexpr std::size_t truth_table_max_colors = 16;
+
+  /**
+   * \brief Creates the condition true.
+   */
+  ColorFormula();
+
+  /**
+   * \brief Compiles an infix color formula.
+   *
+   * Throws std::runtime_error if the formula is malformed.
+   */
+  explicit ColorFormula(const std::string& formula);
+
+  /**
+   * \brief Compiles a formula already tokenized in postfix order.
+   */
+  static ColorFormula from_postfix(const std::vector<std::string>& postfix);
+
+  /**
+   * \brief Compiles a BDD over color variables, with variable index i standing for color variable_color(i).
+   *
+   * Each BDD node becomes an if-then-else over its color, so shared
+   * subgraphs are repeated; meant for the small BDDs of conditions, e.g. to
+   * simplify a condition under fixed colors with CUDD::BDD::Restrict without
+   * going through a string.
+   */
+  static ColorFormula from_bdd(const CUDD::BDD& formula, const std::function<std::size_t(int)>& variable_color);
+
+  /**
+   * \brief Returns the postfix tokens of the formula, which from_postfix compiles back.
+   */
+  std::vector<std::string> to_postfix() const;
+
+  /**
+   * \brief Returns whether the color set with bit i set for each color i satisfies the formula.
+   *
+   * Requires color_count() <= 64.
+   */
+  bool evaluate(std::uint64_t colors) const;
+
+  /**
+   * \brief Returns whether the color set with colors[i] for each color i satisfies the formula.
+   */
+  bool evaluate(const std::vector<bool>& colors) const;
+
+  /**
+   * \brief Returns whether \a colors satisfies the formula, a word at a time when it has at most 64 colors.
+   */
+  bool evaluate(const ColorSet& colors) const;
+
+  /**
+   * \brief Returns the formula as a BDD, with color i replaced by color_bdd(i).
+   *
+   * Colors are requested in the order of the postfix formula.
+   */
+  CUDD::BDD to_bdd(const std::function<CUDD::BDD(std::size_t)>& color_bdd, const CUDD::Cudd& mgr) const;
+
+  /**
+   * \brief Returns one more than the highest color index in the formula.
+   */
+  std::size_t color_count() const;
+
+ private:
+
+  enum class Opcode : std::uint8_t { Color, True, False, Not, And, Or };
+
+  struct Instruction {
+    Opcode opcode;
+    std::uint32_t color;
+  };
+
+  std::vector<Instruction> program_;
+  std::size_t color_count_ = 0;
+  std::size_t max_depth_ = 0;
+  // Indexed by color bitmask, when color_count_ <= truth_table_max_colors
+  std::vector<bool> truth_table_;
+
+  void compile(const std::vector<std::string>& postfix);
+  // Appends the postfix program of node, negated if complemented
+  void emit(DdNode* node, bool complemented, const std::function<std::size_t(int)>& variable_color);
+  // Computes color_count_, max_depth_ and the truth table of program_
+  void tabulate();
+  bool run(std::uint64_t colors) const;
+  // Runs the program on a color set with size() and operator[], e.g. past 64 colors
+  template <typename Colors>
+  bool run_over(const Colors& colors) const;
+};
+
+}
+
+#endif // COLOR_FORMULA_H
@@ -0,0 +1,211 @@
+#ifndef COLOR_SET_H
+#define COLOR_SET_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Syft {
+
+/**
+ * \brief A set over a fixed number of colors, packed 64 colors per word.
+ *
+ * The labels of Zielonka tree nodes and the F- and G-bits of Manna-Pnueli
+ * DAG nodes are such sets. Subset tests, differences and counts work a word
+ * at a time, and sets of at most inline_colors colors keep their words
+ * inline, so copying them and their operations allocate nothing. The bits
+ * past size() are always clear, so sets over the same colors compare by
+ * their words.
+ */
+class ColorSet {
+ public:
+
+  static constexpr std::size_t word_bits = 64;
+  static constexpr std::size_t inline_words = 2;
+  static constexpr std::size_t inline_colors = inline_words * word_bits;
+
+  /**
+   * \brief Creates the empty set over no colors.
+   */
+  ColorSet() = default;
+
+  /**
+   * \brief Creates the set over \a size colors holding all of them if \a full, and none otherwise.
+   */
+  explicit ColorSet(std::size_t size, bool full = false) : size_(size) {
+    if (word_count() > inline_words) {
+      heap_.assign(word_count(), 0);
+    }
+    if (full) {
+      std::uint64_t* data = mutable_words();
+      for (std::size_t w = 0; w < word_count(); ++w) {
+        data[w] = ~std::uint64_t(0);
+      }
+      clear_padding();
+    }
+  }
+
+  /**
+   * \brief Returns the set of the colors i with colors[i].
+   */
+  static ColorSet from_bools(const std::vector<bool>& colors) {
+    ColorSet set(colors.size());
+    for (std::size_t color = 0; color < colors.size(); ++color) {
+      if (colors[color]) set.set(color);
+    }
+    return set;
+  }
+
+  std::size_t size() const {return size_;}
+  std::size_t word_count() const {return (size_ + word_bits - 1) / word_bits;}
+  const std::uint64_t* words() const {return heap_.empty() ? inline_.data() : heap_.data();}
+
+  bool operator[](std::size_t color) const {return (words()[color / word_bits] >> (color % word_bits)) & 1;}
+  void set(std::size_t color) {mutable_words()[color / word_bits] |= std::uint64_t(1) << (color % word_bits);}
+  void reset(std::size_t color) {mutable_words()[color / word_bits] &= ~(std::uint64_t(1) << (color % word_bits));}
+
+  /**
+   * \brief Returns the number of colors in the set.
+   */
+  std::size_t count() const {
+    std::size_t count = 0;
+    for (std::size_t w = 0; w < word_count(); ++w) {
+      count += static_cast<std::size_t>(__builtin_popcountll(words()[w]));
+    }
+    return count;
+  }
+
+  bool none() const {
+    for (std::size_t w = 0; w < word_count(); ++w) {
+      if (words()[w] != 0) return false;
+    }
+    return true;
+  }
+
+  /**
+   * \brief Whether every color of the set is in \a other, a set over as many colors.
+   */
+  bool is_subset_of(const ColorSet& other) const {
+    for (std::size_t w = 0; w < word_count(); ++w) {
+      if ((words()[w] & ~other.words()[w]) != 0) return false;
+    }
+    return true;
+  }
+
+  bool is_proper_subset_of(const ColorSet& other) const {return is_subset_of(other) && *this != other;}
+
+  /**
+   * \brief Removes the colors of \a other, a set over as many colors.
+   */
+  ColorSet& operator-=(const ColorSet& other) {
+    std::uint64_t* data = mutable_words();
+    for (std::size_t w = 0; w < word_count(); ++w) {
+      data[w] &= ~other.words()[w];
+    }
+    return *this;
+  }
+
+  ColorSet& operator&=(const ColorSet& other) {
+    std::uint64_t* data = mutable_words();
+    for (std::size_t w = 0; w < word_count(); ++w) {
+      data[w] &= other.words()[w];
+    }
+    return *this;
+  }
+
+  ColorSet& operator|=(const ColorSet& other) {
+    std::uint64_t* data = mutable_words();
+    for (std::size_t w = 0; w < word_count(); ++w) {
+      data[w] |= other.words()[w];
+    }
+    return *this;
+  }
+
+  friend ColorSet operator-(ColorSet lhs, const ColorSet& rhs) {return lhs -= rhs;}
+  friend ColorSet operator&(ColorSet lhs, const ColorSet& rhs) {return lhs &= rhs;}
+  friend ColorSet operator|(ColorSet lhs, const ColorSet& rhs) {return lhs |= rhs;}
+
+  /**
+   * \brief Calls \a visit on each color of the set, in increasing order.
+   */
+  template <typename Visit>
+  void for_each(Visit&& visit) const {
+    for (std::size_t w = 0; w < word_count(); ++w) {
+      for (std::uint64_t word = words()[w]; word != 0; word &= word - 1) {
+        visit(w * word_bits + static_cast<std::size_t>(__builtin_ctzll(word)));
+      }
+    }
+  }
+
+  std::vector<bool> to_bools() const {
+    std::vector<bool> colors(size_, false);
+    for_each([&](std::size_t color) { colors[color] = true; });
+    return colors;
+  }
+
+  /**
+   * \brief Returns one character per color, 1 for the colors of the set and 0 for the others.
+   */
+  std::string to_string() const {
+    std::string bits(size_, '0');
+    for_each([&](std::size_t color) { bits[color] = '1'; });
+    return bits;
+  }
+
+  std::size_t hash() const {
+    std::size_t hash = size_;
+    for (std::size_t w = 0; w < word_count(); ++w) {
+      hash ^= static_cast<std::size_t>(words()[w]) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+  }
+
+  friend bool operator==(const ColorSet& lhs, const ColorSet& rhs) {
+    if (lhs.size_ != rhs.size_) return false;
+    for (std::size_t w = 0; w < lhs.word_count(); ++w) {
+      if (lhs.words()[w] != rhs.words()[w]) return false;
+    }
+    return true;
+  }
+
+  friend bool operator!=(const ColorSet& lhs, const ColorSet& rhs) {return !(lhs == rhs);}
+
+  /**
+   * \brief Orders by size, then by the words from the first, e.g. for std::map keys.
+   */
+  friend bool operator<(const ColorSet& lhs, const ColorSet& rhs) {
+    if (lhs.size_ != rhs.size_) return lhs.size_ < rhs.size_;
+    for (std::size_t w = 0; w < lhs.word_count(); ++w) {
+      if (lhs.words()[w] != rhs.words()[w]) return lhs.words()[w] < rhs.words()[w];
+    }
+    return false;
+  }
+
+ private:
+
+  std::size_t size_ = 0;
+  std::array<std::uint64_t, inline_words> inline_{};
+  // Holds the words instead of inline_ past inline_colors colors
+  std::vector<std::uint64_t> heap_;
+
+  std::uint64_t* mutable_words() {return heap_.empty() ? inline_.data() : heap_.data();}
+
+  void clear_padding() {
+    if (size_ % word_bits != 0) {
+      mutable_words()[word_count() - 1] &= (std::uint64_t(1) << (size_ % word_bits)) - 1;
+    }
+  }
+};
+
+/**
+ * \brief Hashes color sets, e.g. for std::unordered_map keys.
+ */
+struct ColorSetHash {
+  std::size_t operator()(const ColorSet& set) const {return set.hash();}
+};
+
+}
+
+#endif // COLOR_SET_H
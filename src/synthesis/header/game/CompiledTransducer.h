@@ -0,0 +1,225 @@
+#ifndef COMPILED_TRANSDUCER_H
+#define COMPILED_TRANSDUCER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "game/BddCircuit.h"
+#include "game/Transducer.h"
+
+namespace Syft {
+
+/**
+ * \brief A Transducer flattened for execution as a runtime controller.
+ *
+ * The output and next-state BDDs are compiled once into a BddCircuit whose
+ * slots are the controller inputs, then its outputs, then the state bits.
+ * A function over at most
+ * lookup_table_max_support slots is also tabulated into a 64-bit truth table,
+ * so that evaluating it is a shift. A step reads the inputs, computes the
+ * outputs, which only depend on the state and the inputs, then the next
+ * state from the state, the inputs and the outputs; this covers both
+ * Moore (agent first) and Mealy (environment first) transducers.
+ *
+ * Batch steps many independent instances at once, bit-sliced 64 instances
+ * per word (see BddCircuit::evaluate).
+ *
+ * The compiled controller is one flat image: a header, the labels of the
+ * inputs and outputs, the node array, a fixed-size record per function and
+ * the initial state. save writes the image as it is, and load maps a saved
+ * file read-only and executes from the mapping, without copying or CUDD, so
+ * that a controller starts without running synthesis again.
+ */
+class CompiledTransducer {
+ public:
+
+  static constexpr std::size_t lookup_table_max_support = 6;
+
+  /**
+   * \brief One instance of a controller, with the valuation of its slots.
+   */
+  class Instance {
+   public:
+
+    /**
+     * \brief Returns the current state, one value per state bit.
+     */
+    std::vector<bool> state() const;
+
+   private:
+
+    friend class CompiledTransducer;
+
+    Instance(std::size_t slot_count, std::size_t state_count);
+
+    std::vector<std::uint8_t> values_;
+    std::vector<std::uint8_t> next_;
+  };
+
+  /**
+   * \brief Independent instances of a controller, all starting in its initial state.
+   */
+  class Batch {
+   public:
+
+    std::size_t size() const {return size_;}
+
+    void set_input(std::size_t instance, std::size_t input, bool value);
+    bool output(std::size_t instance, std::size_t output) const;
+    std::vector<bool> state(std::size_t instance) const;
+
+    /**
+     * \brief Returns the number of words of each slot; bit j of word w is instance 64 * w + j.
+     */
+    std::size_t words() const {return words_;}
+
+    std::uint64_t* input_words(std::size_t input) {return values_.data() + input * words_;}
+    const std::uint64_t* output_words(std::size_t output) const {
+      return values_.data() + (input_count_ + output) * words_;
+    }
+
+   private:
+
+    friend class CompiledTransducer;
+
+    Batch(std::size_t size, std::size_t slot_count, std::size_t input_count, std::size_t output_count,
+          std::size_t state_count, std::size_t node_count);
+
+    std::size_t size_;
+    std::size_t words_;
+    std::size_t input_count_;
+    std::size_t output_count_;
+    std::size_t state_count_;
+    // Slot s of instance i is bit i % 64 of word s * words_ + i / 64
+    std::vector<std::uint64_t> values_;
+    std::vector<std::uint64_t> node_values_;
+    std::vector<std::uint64_t> next_;
+  };
+
+  /**
+   * \brief Compiles \a transducer.
+   *
+   * Throws std::runtime_error if the transducer does not record the state
+   * variables updated by its transition function, or if its functions depend
+   * on variables other than the state bits, the inputs and the outputs, or an
+   * output depends on an output.
+   */
+  explicit CompiledTransducer(const Transducer& transducer);
+
+  /**
+   * \brief Maps a controller written by save; throws std::runtime_error if the file is not one.
+   */
+  static CompiledTransducer load(const std::string& filename);
+
+  /**
+   * \brief Writes the controller in the binary format of load.
+   */
+  void save(const std::string& filename) const;
+
+  const std::vector<std::string>& input_labels() const {return input_labels_;}
+  const std::vector<std::string>& output_labels() const {return output_labels_;}
+
+  std::size_t input_count() const {return input_count_;}
+  std::size_t output_count() const {return output_count_;}
+  std::size_t state_bit_count() const {return state_count_;}
+
+  /**
+   * \brief Returns the number of nodes of the compiled functions, without the two terminals.
+   */
+  std::size_t node_count() const {return node_total_ - 2;}
+
+  /**
+   * \brief Returns the number of functions evaluated by lookup table.
+   */
+  std::size_t tabulated_count() const;
+
+  /**
+   * \brief Returns an instance in the initial state.
+   */
+  Instance make_instance() const;
+
+  /**
+   * \brief Steps \a instance.
+   *
+   * \param inputs One value (0 or 1) per input, in the order of the input labels of the controller.
+   * \param outputs Receives one value per output, in the order of the output labels of the controller.
+   */
+  void step(Instance& instance, const std::uint8_t* inputs, std::uint8_t* outputs) const;
+
+  /**
+   * \brief Returns \a size instances in the initial state, with every input false.
+   */
+  Batch make_batch(std::size_t size) const;
+
+  /**
+   * \brief Steps every instance of \a batch, from the inputs set on it; the outputs can be read afterwards.
+   */
+  void step(Batch& batch) const;
+
+ private:
+
+  static constexpr std::uint32_t format_version = 1;
+
+  struct Header {
+    char magic[8];
+    std::uint32_t version;
+    // Written as 0x01020304, so that a file of another byte order is refused
+    std::uint32_t byte_order;
+    std::uint64_t image_size;
+    std::uint32_t input_count;
+    std::uint32_t output_count;
+    std::uint32_t state_count;
+    std::uint32_t node_count;
+    std::uint32_t output_nodes_end;
+    std::uint32_t labels_size;
+    std::uint64_t labels_offset;
+    std::uint64_t nodes_offset;
+    std::uint64_t functions_offset;
+    std::uint64_t initial_offset;
+  };
+
+  struct Function {
+    std::uint32_t root;
+    std::uint32_t tabulated;
+    // The support of a tabulated function, over whose slots its truth table is
+    std::uint32_t support;
+    std::uint32_t slots[lookup_table_max_support];
+    std::uint32_t padding;
+    std::uint64_t table;
+  };
+
+  // The image, owned or mapped, and the views into it
+  std::shared_ptr<const void> image_;
+  std::size_t image_size_ = 0;
+  const BddCircuit::Node* nodes_ = nullptr;
+  // The outputs, then the next state bits
+  const Function* functions_ = nullptr;
+  const std::uint8_t* initial_state_ = nullptr;
+
+  std::vector<std::string> input_labels_;
+  std::vector<std::string> output_labels_;
+  std::size_t input_count_ = 0;
+  std::size_t output_count_ = 0;
+  std::size_t state_count_ = 0;
+  std::size_t node_total_ = 0;
+  // The nodes of the outputs come first, so that a batch evaluates them before the next state
+  std::size_t output_nodes_end_ = 0;
+
+  CompiledTransducer() = default;
+
+  std::size_t slot_count() const {return input_count_ + output_count_ + state_count_;}
+
+  /**
+   * \brief Checks \a image and points the views into it.
+   */
+  void attach(std::shared_ptr<const void> image, std::size_t size);
+
+  bool evaluate(const Function& function, const std::uint8_t* values) const;
+};
+
+}
+
+#endif // COMPILED_TRANSDUCER_H
@@ -0,0 +1,105 @@
+#ifndef DAG_WORK_QUEUE_H
+#define DAG_WORK_QUEUE_H
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "cuddObj.hh"
+#include "Player.h"
+#include "VarMgr.h"
+#include "automata/SymbolicStateDfa.h"
+#include "game/ColorFormula.h"
+
+namespace Syft {
+
+/**
+ * \brief Emerson-Lei subgames of a Manna-Pnueli DAG, solved by worker processes sharing a directory.
+ *
+ * The coordinator (see MannaPnueli::set_work_directory) publishes the arena,
+ * the colors and the state space once, as BddArchive files, then submits one
+ * job per subgame: its compiled color formula and its instant winning and
+ * losing states. Workers started with serve, on any machine that sees the
+ * directory, claim jobs, solve them with EmersonLei and write back the
+ * realizability and the winning states, which the coordinator collects and
+ * deletes. Every file is written under a temporary name and renamed, and a
+ * job is claimed by renaming its marker, so the directory can live on a
+ * shared file system, e.g. the scratch space of a Slurm allocation. A
+ * directory may be reused: the coordinator removes the files of earlier runs,
+ * and the markers and job names carry a token of the run, so that neither side
+ * mistakes files left by a crashed run for its own.
+ */
+class DagWorkQueue {
+ public:
+
+  struct Outcome {
+    bool realizability;
+    CUDD::BDD winning_states;
+  };
+
+  /**
+   * \brief Creates the queue of a coordinator in \a directory, creating the directory if needed.
+   *
+   * Removes the arena, the jobs and the done marker of any earlier run.
+   */
+  DagWorkQueue(std::string directory, std::shared_ptr<VarMgr> var_mgr);
+
+  /**
+   * \brief Calls finish, so that workers do not wait for a coordinator that failed.
+   */
+  ~DagWorkQueue();
+
+  DagWorkQueue(const DagWorkQueue&) = delete;
+  DagWorkQueue& operator=(const DagWorkQueue&) = delete;
+
+  /**
+   * \brief Publishes the game shared by every job; workers start claiming jobs afterwards.
+   */
+  void publish_arena(const SymbolicStateDfa& arena, const std::vector<CUDD::BDD>& colors,
+                     const CUDD::BDD& state_space, Player starting_player, Player protagonist_player);
+
+  /**
+   * \brief Submits a subgame and returns its job number.
+   */
+  std::size_t submit(const ColorFormula& color_formula, const CUDD::BDD& instant_winning,
+                     const CUDD::BDD& instant_losing);
+
+  /**
+   * \brief Returns the outcome of \a job once a worker has solved it, and deletes its files.
+   *
+   * Throws std::runtime_error with the message of the worker if solving failed.
+   */
+  std::optional<Outcome> collect(std::size_t job);
+
+  /**
+   * \brief Tells the workers to stop once the queue is empty.
+   */
+  void finish();
+
+  /**
+   * \brief Solves the jobs published in \a directory until the coordinator finishes.
+   *
+   * Waits for the arena if it is not published yet, skipping a run that is
+   * already done, and moves on to the next run if the coordinator of the
+   * current one is replaced. Returns the number of jobs solved by this worker.
+   */
+  static std::size_t serve(const std::string& directory, const VarMgrOptions& options = VarMgrOptions(),
+                           std::chrono::milliseconds poll = std::chrono::milliseconds(100));
+
+ private:
+
+  std::string directory_;
+  std::shared_ptr<VarMgr> var_mgr_;
+  // Names this run in the markers and the job files
+  std::string run_;
+  std::size_t automaton_id_ = 0;
+  std::size_t next_job_ = 0;
+  bool finished_ = false;
+};
+
+}
+
+#endif // DAG_WORK_QUEUE_H
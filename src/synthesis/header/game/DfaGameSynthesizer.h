@@ -2,12 +2,33 @@
 #define DFA_GAME_SYNTHESIZER_H
 
 #include "Quantification.h"
+#include "automata/ProductArena.h"
 #include "automata/SymbolicStateDfa.h"
+#include "game/FixpointTrace.h"
+#include "game/GameKernel.h"
+#include "game/PartitionedTransitionRelation.h"
+#include "game/PreimageCache.h"
+#include "game/StateAbstraction.h"
+#include "game/StrategyMinimizer.h"
 #include "Synthesizer.h"
 #include "Transducer.h"
 
 namespace Syft {
 
+/**
+ * \brief How DfaGameSynthesizer computes preimages.
+ */
+    enum class PreimageEngine {
+        /** \brief Compose with the transition function, then quantify in a second pass. */
+        Compose,
+        /**
+         * \brief One relational product on a PartitionedTransitionRelation.
+         *
+         * The quantification of the independent variables is fused into the
+         * product, at the cost of creating a next-state copy of the state variables.
+         */
+        Partitioned
+    };
 
 /**
  * \brief A synthesizer for a game whose arena is a symbolic-state DFA.
@@ -42,6 +63,52 @@ namespace Syft {
          * \brief Quantification on non-state variables.
          */
         std::unique_ptr<Quantification> quantify_non_state_variables_;
+        /**
+         * \brief The same quantifications for the order of play of the game, used by the fixpoints.
+         */
+        GameKernel kernel_;
+        /**
+         * \brief The unmaterialized product the arena is a view of, if any.
+         *
+         * When set, preimages are computed compositionally on the product.
+         */
+        std::shared_ptr<const ProductArena> product_arena_;
+        /**
+         * \brief The variables universally quantified by quantify_independent_variables_, or bddOne if none.
+         */
+        CUDD::BDD independent_cube_;
+        /**
+         * \brief How preimages are computed.
+         */
+        PreimageEngine preimage_engine_ = PreimageEngine::Compose;
+        /**
+         * \brief The relation used by the Partitioned engine, built on first use.
+         */
+        mutable std::unique_ptr<PartitionedTransitionRelation> partitioned_relation_;
+        /**
+         * \brief The preimages of the arena shared with the solvers of other subgames, if any.
+         */
+        std::shared_ptr<PreimageCache> preimage_cache_;
+        /**
+         * \brief The abstraction the game is solved on, see set_state_abstraction.
+         */
+        std::optional<StateAbstraction> state_abstraction_;
+        /**
+         * \brief How the fixpoints of the subclass iterate.
+         */
+        FixpointMode fixpoint_mode_ = FixpointMode::Full;
+        /**
+         * \brief The iterations of the last fixpoint computed by run.
+         */
+        mutable FixpointTrace fixpoint_trace_;
+        /**
+         * \brief Whether run only needs the verdict, see set_realizability_only.
+         */
+        bool realizability_only_ = false;
+        /**
+         * \brief How extracted strategies are simplified, see set_strategy_minimization.
+         */
+        StrategyMinimizationOptions strategy_minimization_;
 
         /**
          * \brief Compute a set of winning moves.
@@ -52,6 +119,32 @@ namespace Syft {
          */
         CUDD::BDD preimage(const CUDD::BDD &winning_states) const;
 
+        /**
+         * \brief Compute a set of winning moves of the states in \a care_states only.
+         *
+         * Equal to care_states & preimage(winning_states). With the Compose
+         * engine, the transition function is first simplified with Restrict to
+         * \a care_states, which keeps the composition small when the care set is.
+         */
+        CUDD::BDD preimage(const CUDD::BDD &winning_states, const CUDD::BDD &care_states) const;
+
+        /**
+         * \brief Returns the states with a transition into \a states, for some move.
+         */
+        CUDD::BDD predecessors(const CUDD::BDD &states) const;
+
+        /**
+         * \brief Returns the distinct successors of a state under a fixed move, as state cubes.
+         *
+         * The inputs stay symbolic: they are split only on the next-state bits
+         * that depend on them, so the cost grows with the number of successors
+         * rather than with the number of input assignments.
+         *
+         * \param state A cube over the state variables of the arena.
+         * \param move A cube over the output variables.
+         */
+        std::vector<CUDD::BDD> successor_cubes(const CUDD::BDD &state, const CUDD::BDD &move) const;
+
         /**
          * \brief Project a set of winning moves to a set of winning states.
          *
@@ -69,6 +162,32 @@ namespace Syft {
          */
         bool includes_initial_state(const CUDD::BDD &winning_states) const;
 
+        /**
+         * \brief Determinize a set of winning moves into one function per output variable.
+         *
+         * \return The output functions, keyed by the index of their output variable,
+         *   over the variables of \a winning_moves other than the outputs.
+         */
+        std::unordered_map<int, CUDD::BDD>
+        synthesize_strategy(const CUDD::BDD &winning_moves, const std::shared_ptr<VarMgr> &var_mgr) const;
+
+        /**
+         * \brief Encodes a strategy with finite memory as a transducer.
+         *
+         * The memory values are encoded in fresh state variables, value 0 being
+         * the initial memory and the all-zero assignment. The transducer has one
+         * output function over states and memory per output variable, and the
+         * arena transition function followed by one memory update function per
+         * memory variable. Requires the agent to move first.
+         *
+         * \param moves The winning moves at each memory value, over states and outputs.
+         * \param next The moves of moves[m] that update memory m to each memory value.
+         * \param caller The solver named in the log.
+         */
+        std::unique_ptr<Transducer> memory_transducer(const std::vector<CUDD::BDD> &moves,
+                                                      const std::vector<std::vector<CUDD::BDD>> &next,
+                                                      const std::string &caller) const;
+
     public:
 
         /**
@@ -91,6 +210,74 @@ namespace Syft {
         virtual SynthesisResult run()
         const override = 0;
 
+        /**
+         * \brief Selects how preimages are computed; Compose by default.
+         */
+        void set_preimage_engine(PreimageEngine engine);
+
+        /**
+         * \brief Makes preimage look up and store its results in \a cache; none by default.
+         *
+         * Solvers of subgames of the same arena, such as the DAG nodes of
+         * MannaPnueli, may share one cache. A null \a cache turns caching off.
+         *
+         * \throws std::runtime_error if \a cache holds the preimages of another game.
+         */
+        void set_preimage_cache(std::shared_ptr<PreimageCache> cache);
+
+        /**
+         * \brief Returns the cache set by set_preimage_cache, or null.
+         */
+        const std::shared_ptr<PreimageCache> &preimage_cache() const;
+
+        /**
+         * \brief Solves the game on \a abstraction instead of the arena; none by default.
+         *
+         * Preimages and predecessors let the chooser of \a abstraction pick the
+         * next values of its hidden bits, so the winning states are an under- or
+         * over-approximation of those of the arena (see StateAbstraction). The
+         * target is abstracted before the preimage cache is consulted, so a
+         * cache keeps serving concrete preimages.
+         */
+        void set_state_abstraction(std::optional<StateAbstraction> abstraction);
+
+        /**
+         * \brief Returns the abstraction set by set_state_abstraction, if any.
+         */
+        const std::optional<StateAbstraction> &state_abstraction() const;
+
+        /**
+         * \brief Selects how the fixpoints iterate; Full by default.
+         */
+        void set_fixpoint_mode(FixpointMode mode);
+
+        /**
+         * \brief Returns the iterations of the last fixpoint computed by run.
+         */
+        const FixpointTrace &fixpoint_trace() const;
+
+        /**
+         * \brief Only compute the realizability verdict.
+         *
+         * Fixpoints may stop as soon as the initial state is provably in (least
+         * fixpoints) or out (greatest fixpoints) of the approximation, so the
+         * winning states of the result may be partial. Winning moves and
+         * transducers are not built.
+         */
+        void set_realizability_only(bool realizability_only);
+
+        /**
+         * \brief Simplify the output functions of extracted strategies on their care set (see minimize_strategy).
+         *
+         * Off by default.
+         */
+        void set_strategy_minimization(const StrategyMinimizationOptions &options);
+
+        /**
+         * \brief Returns how preimages are computed.
+         */
+        PreimageEngine preimage_engine() const;
+
 
         /**
          * \brief Abstract a winning strategy for the game.
@@ -100,14 +287,20 @@ namespace Syft {
         std::unique_ptr<Transducer> AbstractSingleStrategy(const SynthesisResult &result) const;
 
     private:
+        const PartitionedTransitionRelation &partitioned_relation() const;
+
+        // preimage without the abstraction
+        CUDD::BDD cached_preimage(const CUDD::BDD &winning_states) const;
+        // preimage without the abstraction and the cache
+        CUDD::BDD compute_preimage(const CUDD::BDD &winning_states) const;
+        // predecessors without the abstraction
+        CUDD::BDD predecessors_of(const CUDD::BDD &states) const;
+
         std::unique_ptr<Transducer> abstract_single_strategy(const CUDD::BDD &winning_moves,
                                                              const std::shared_ptr<VarMgr> &var_mgr,
                                                              const std::vector<int> &initial_vector,
                                                              const std::vector<CUDD::BDD> &transition_vector,
                                                              Player starting_player) const;
-
-        std::unordered_map<int, CUDD::BDD>
-        synthesize_strategy(const CUDD::BDD &winning_moves, const std::shared_ptr<VarMgr> &var_mgr) const;
     };
 
 }
@@ -6,81 +6,60 @@
 #include <cmath>
 #include <iterator>
 #include <vector>
-#include <regex>
+#include "game/ColorSet.h"
 #include "game/ZielonkaTree.hh"
 #include "VarMgr.h"
 
 namespace ELHelpers {
 
-    inline bool proper_subset(const std::vector<bool>& l1, const std::vector<bool>& l2) {
-        // Check if l1 subset of l2
-        // forall i in l1: if l1 then also l2
-        // but there must exist at least one index in l2 which is not in l1
-        bool flag = false;
-        for (size_t i = 0; i < l1.size(); ++i) {
-            if (l2[i] && !l1[i])
-                flag = true;
-            if (l1[i] && !l2[i])
-                return false;
-        }
-        return flag;
+    inline bool proper_subset(const Syft::ColorSet& l1, const Syft::ColorSet& l2) {
+        // Check if l1 subset of l2, with at least one color of l2 not in l1
+        return l1.is_proper_subset_of(l2);
     }
 
 
 
-    inline std::vector<bool> label_difference(const std::vector<bool>& t, const std::vector<bool>& s) {
-        // compute difference t-s, where s,t are vectors of colors
-        size_t size = t.size();
-        std::vector<bool> difference(size, false);
-        for (size_t i = 0; i < size; ++i)
-            difference[i] = t[i] && !s[i];
-        return difference;
+    inline Syft::ColorSet label_difference(const Syft::ColorSet& t, const Syft::ColorSet& s) {
+        // compute difference t-s, where s,t are sets of colors
+        return t - s;
     }
 
 
-    inline CUDD::BDD unionOf(const std::vector<bool>& col, const std::vector<CUDD::BDD>& colorBDDs, std::shared_ptr<Syft::VarMgr>& var_mgr_) {
+    inline CUDD::BDD unionOf(const Syft::ColorSet& col, const std::vector<CUDD::BDD>& colorBDDs, std::shared_ptr<Syft::VarMgr>& var_mgr_) {
         // return union of all color bdds indicated by col
-//        CUDD::BDD result = mgr_.bddZero();
-
         CUDD::BDD result = var_mgr_->cudd_mgr()->bddZero();
-        for (size_t i = 0; i < col.size(); ++i){
-            if (col[i])
+        col.for_each([&](size_t i) {
             result |= colorBDDs[i]; // result = result | NodesThatSeeColor(i)
-        }
+        });
         return result;
     }
 
-    inline CUDD::BDD negIntersectionOf(const std::vector<bool>& col, const std::vector<CUDD::BDD>& colorBDDs, std::shared_ptr<Syft::VarMgr>& var_mgr_) {
-        // return intersection of all negated color bdds indicated by col
-        CUDD::BDD result = var_mgr_->cudd_mgr()->bddOne();
-        for (size_t i = 0; i < col.size(); ++i){
-            if (col[i])
-            result &= (colorBDDs[colorBDDs.size()/2 + i]); // result = result & NodesThatDoNotSeeColor(i)
-        }
-        return result;
+    inline CUDD::BDD negIntersectionOf(const Syft::ColorSet& col, const std::vector<CUDD::BDD>& colorBDDs, std::shared_ptr<Syft::VarMgr>& var_mgr_) {
+        // return intersection of all negated color bdds indicated by col, i.e. the complement of their union:
+        // colorBDDs holds one BDD per color, without the complements
+        return !unionOf(col, colorBDDs, var_mgr_);
     }
 
     // Standard algorithm for powerset generation: https://www.geeksforgeeks.org/power-set/
-    inline std::vector<std::vector<bool>> powerset(size_t colors) {
-        // remake this so that it works with new evaluation function (std::vector<bool>)
-        size_t ps_size = pow(2, colors);
-        std::vector<std::vector<bool>> ps;
+    inline std::vector<Syft::ColorSet> powerset(size_t colors) {
+        size_t ps_size = size_t(1) << colors;
+        std::vector<Syft::ColorSet> ps;
         for (size_t count = 0; count < ps_size; ++count) {
-            std::vector<bool> tmp(colors, 0);
+            Syft::ColorSet tmp(colors);
             for (size_t bit = 0; bit < colors; ++bit) {
-                if (count & (1 << bit))
-                    tmp[bit] = true;
+                if (count & (size_t(1) << bit))
+                    tmp.set(bit);
             }
             ps.push_back(tmp);
         }
         return ps;
     }
 
-    inline std::vector<size_t> preprocess_to_UBDD(const std::vector<bool>& label) {
+    inline std::vector<size_t> preprocess_to_UBDD(const Syft::ColorSet& label) {
         std::vector<size_t> preprocessed;
-        for (size_t i = 0; i < label.size(); ++i){
-            if (label[i]) preprocessed.push_back(i);
-        } return preprocessed;
+        preprocessed.reserve(label.count());
+        label.for_each([&](size_t i) { preprocessed.push_back(i); });
+        return preprocessed;
     }
 
 
@@ -88,7 +67,7 @@ namespace ELHelpers {
     //
     // INPUT ALPHABET
     // a | !a | (a) | a&a | a|a
-    // (a = Inf(a), !a = Fin(a))
+    // (a = Inf(a), !a = Fin(a), over one goal state BDD per color)
     //
     // INPUT EXAMPLE
     // 0 & !1 | (1 | 2)
@@ -104,40 +83,34 @@ namespace ELHelpers {
     }
 
     // Tokenize input string to following alphabet:
-    // op (!,&,|) | a | ( | )
-    inline std::vector<std::string> tokenize(std::string input){
+    // op (!,&,|) | a | ( | ) | t | f
+    // Inf is dropped, Fin becomes !, true and false become t and f
+    inline std::vector<std::string> tokenize(const std::string& input){
         std::vector<std::string> result;
-        std::regex inf_re("Inf");
-        std::regex fin_re("Fin");
-        input = std::regex_replace(input, inf_re, "");
-        input = std::regex_replace(input, fin_re, "!");
-
-        std::regex true_re("true");
-        std::regex false_re("false");
-        input = std::regex_replace(input, true_re, "t");
-        input = std::regex_replace(input, false_re, "f");
-
         for (size_t i=0; i<input.size(); i++){
-            std::string s = "";
             char inp = input[i];
             if (inp == ' ')
                 continue;
-            else if (isdigit(inp))
-            {
-                s += inp;
-                i++;
-                for (; i<input.size(); i++){
-                    inp = input[i];
-                    if (!isdigit(inp))
-                        break;
-                    s += inp;
-                }
-                i--;
+            if (input.compare(i, 3, "Inf") == 0) {
+                i += 2;
+            } else if (input.compare(i, 3, "Fin") == 0) {
+                result.push_back("!");
+                i += 2;
+            } else if (input.compare(i, 4, "true") == 0) {
+                result.push_back("t");
+                i += 3;
+            } else if (input.compare(i, 5, "false") == 0) {
+                result.push_back("f");
+                i += 4;
+            } else if (isdigit(inp)) {
+                size_t end = i;
+                while (end < input.size() && isdigit(input[end]))
+                    end++;
+                result.push_back(input.substr(i, end - i));
+                i = end - 1;
+            } else {
+                result.push_back(std::string(1, inp));
             }
-            else
-                s += input[i];
-
-            result.push_back(s);
         }
         return result;
     }
@@ -233,9 +206,9 @@ namespace ELHelpers {
             }
         }
 
-        for (std::string s : opStack){
-            std::string tmp = opStack.back();
-            outputStack.push_back(tmp);
+        // Popped in turn, so that the negation of a parenthesized color, as in Fin(1), is not lost
+        while (!opStack.empty()){
+            outputStack.push_back(opStack.back());
             opStack.pop_back();
         }
 
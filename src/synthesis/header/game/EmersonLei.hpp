@@ -1,91 +1,352 @@
-//
-// Created by dh on 25/11/24.
-//
-
-#ifndef LYDIASYFT_EMERSONLEI_HPP
-#define LYDIASYFT_EMERSONLEI_HPP
-
-#include "game/DfaGameSynthesizer.h"
-#include "game/ZielonkaTree.hh"
-#include <optional>
-
-namespace Syft {
-	/**
-	* \brief A single-strategy-synthesizer for a Emerson-Lei game given as a symbolic-state DFA.
-	*
-	* Emerson-Lei condition (positive Boolean formula over colors and negated colors) holds.
-	* e.g. condition 1 & !2 & (3 | 4) is satisfied by plays that visit colors 1 and (3 or 4) infinitely often
-    	* and than visit color 2 finitely often
-	*/
-	class EmersonLei : public DfaGameSynthesizer {
-		private:
-		/**
-		* \brief The state space to consider.
-		*/
-		CUDD::BDD state_space_;
-		/**
-		* \brief The Emerson-Lei condition represented as a Boolean formula \beta over colors
-		*/
-		std::vector<CUDD::BDD> Colors_;
-		std::string color_formula_;
-		CUDD::BDD instant_winning_;
-		CUDD::BDD instant_losing_;
-
-		std::optional<CUDD::BDD> curr_state_;
-		std::optional<ZielonkaNode*> curr_tree_node_;
-		ZielonkaTree* z_tree_;
-		bool syn_flag_ = false;
-		// When true, run the embedded Büchi-style double-fixpoint solver instead of the EL Zielonka solve.
-		// This is enabled by default "for lolz" and can be disabled later if desired.
-		bool use_embedded_buchi_ = false;
-		bool adv_mp_;
-
-		CUDD::BDD getOneUnprocessedState(CUDD::BDD state_state, CUDD::BDD processed) const;
-		
-		public:
-		
-		/**
-		* \brief Construct a single-strategy-synthesizer for the given Emerson-Lei game.
-		*
-		* \param spec A symbolic-state DFA representing the Buchi-reachability game arena.
-		* \param starting_player The player that moves first each turn.
-		* \param protagonist_player The player for which we aim to find the winning strategy.
-		* \param Colors The Emerson-Lei condition represented as a Boolean formula \beta over colors.
-		* \param state_space The state space.
-		*/
-		EmersonLei(const SymbolicStateDfa &spec, std::string color_formula, Player starting_player, Player protagonist_player,
-			const std::vector<CUDD::BDD> &colorBDDs, const CUDD::BDD &state_space, const CUDD::BDD &instant_winning, const CUDD::BDD &instant_losing, bool adv_mp);
-
-		CUDD::BDD EmersonLeiSolve(ZielonkaNode *t, CUDD::BDD term) const;
-		CUDD::BDD BuchiAlgorithm() const;
-		// Toggle the embedded Büchi algorithm at runtime
-		void set_use_embedded_buchi(bool use) { use_embedded_buchi_ = use; }
-    	CUDD::BDD cpre(ZielonkaNode *t, int i, CUDD::BDD target) const;
-		EL_output_function ExtractStrategy_Explicit(EL_output_function op, CUDD::BDD winning_states, CUDD::BDD gameNode, ZielonkaNode *t) const;
-		CUDD::BDD getUniqueSystemChoice(CUDD::BDD gameNode, CUDD::BDD winningmoves) const;
-		// CUDD::BDD getUniqueSystemChoice(CUDD::BDD gameNode, std::unique_ptr<Transducer> transducer) const;
-		std::vector<CUDD::BDD> getSuccsWithYZ(CUDD::BDD gameNode, CUDD::BDD Y) const;
-		CUDD::BDD getSuccsWithXYZ(CUDD::BDD gameNode, CUDD::BDD Y, CUDD::BDD X) const;
-		int index_below(ZielonkaNode *anchor_node, ZielonkaNode *old_memory) const;
-		ZielonkaNode* get_anchor(CUDD::BDD game_node, ZielonkaNode *memory_value) const;
-		ZielonkaNode* get_leaf(ZielonkaNode *old_memory, ZielonkaNode *anchor_node, ZielonkaNode *curr, CUDD::BDD Y) const;
-		inline std::vector<CUDD::BDD> transition_function() const {return spec_.transition_function();}
-		inline int spec_id() const {return spec_.automaton_id();}
-		SynthesisResult run() const final;
-		ELSynthesisResult run_EL() const;
-
-		// struct OneStepSynReturn {
-		// 	EL_output_function op_;
-		// 	CUDD::BDD game_state_;
-		// 	size_t tree_node_;
-		// 	CUDD::BDD Y_;
-		// };
-		// OneStepSynReturn ExtractStrategy_Explicit_OneStep(EL_output_function op, CUDD::BDD winning_states, CUDD::BDD gameNode, ZielonkaNode *t, CUDD::BDD X) const;
-		// OneStepSynReturn synthesize(std::string X, ELSynthesisResult result );
-
-		
-	};
-}
-
-
+//
+// Created by dh on 25/11/24.
+//
+
+#ifndef LYDIASYFT_EMERSONLEI_HPP
+#define LYDIASYFT_EMERSONLEI_HPP
+
+#include "BddCubes.h"
+#include "game/AcceptanceClass.h"
+#include "game/ChildOrder.h"
+#include "game/DfaGameSynthesizer.h"
+#include "game/ZielonkaTree.hh"
+#include <map>
+#include <memory>
+#include <functional>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+namespace Syft {
+	/**
+	* \brief A single-strategy-synthesizer for a Emerson-Lei game given as a symbolic-state DFA.
+	*
+	* Emerson-Lei condition (positive Boolean formula over colors and negated colors) holds.
+	* e.g. condition 1 & !2 & (3 | 4) is satisfied by plays that visit colors 1 and (3 or 4) infinitely often
+    	* and than visit color 2 finitely often
+	*/
+	class EmersonLei : public DfaGameSynthesizer {
+		public:
+		/**
+		* \brief Default thresholds of set_threads.
+		*/
+		static constexpr std::size_t parallel_min_children = 2;
+		static constexpr int parallel_min_nodes = 1000;
+
+		private:
+		/**
+		* \brief The state space to consider.
+		*/
+		CUDD::BDD state_space_;
+		/**
+		* \brief The Emerson-Lei condition represented as a Boolean formula \beta over colors
+		*/
+		std::vector<CUDD::BDD> Colors_;
+		ColorFormula color_formula_;
+		CUDD::BDD instant_winning_;
+		CUDD::BDD instant_losing_;
+
+		std::optional<CUDD::BDD> curr_state_;
+		std::optional<ZielonkaNode*> curr_tree_node_;
+		// Shared with the results of run_EL, whose strategies point into it
+		std::shared_ptr<ZielonkaTree> z_tree_;
+		bool syn_flag_ = false;
+		// When true, run the embedded Büchi-style double-fixpoint solver instead of the EL Zielonka solve.
+		// This is enabled by default "for lolz" and can be disabled later if desired.
+		bool use_embedded_buchi_ = false;
+		bool adv_mp_;
+		bool symbolic_strategy_ = false;
+		bool release_winning_moves_ = false;
+		bool defer_strategy_ = false;
+		// Receives the root bounds of each iteration, see set_anytime
+		PartialResultCallback anytime_;
+		// Receives the same bounds without stopping, see set_root_progress
+		PartialResultCallback root_progress_;
+		// Shape of the condition, classified once the tree is built
+		AcceptanceClass acceptance_class_ = AcceptanceClass::General;
+		bool auto_dispatch_ = false;
+		bool force_parity_ = false;
+		// Results of EmersonLeiSolve by (dag_id, term), see EmersonLeiSolve
+		mutable std::map<std::pair<size_t, DdNode*>, std::pair<CUDD::BDD, CUDD::BDD>> solve_cache_;
+		mutable size_t solve_cache_hits_ = 0;
+		// Threads solving the children of a Zielonka node (see set_threads)
+		std::size_t threads_ = 1;
+		std::size_t parallel_min_children_ = parallel_min_children;
+		int parallel_min_nodes_ = parallel_min_nodes;
+		// Order of the children in EmersonLeiSolve (see set_child_order)
+		ChildOrder child_order_ = ChildOrder::Construction;
+		bool warm_start_ = false;
+		// Result of each node in each iteration of its parent, kept for the next
+		// iteration of its grandparent (see set_warm_start)
+		mutable std::unordered_map<ZielonkaNode*, std::vector<CUDD::BDD>> warm_starts_;
+		mutable size_t cpre_calls_ = 0;
+		// Minterms over the state and output variables, which strategy extraction walks
+		MintermPicker state_picker_;
+		MintermPicker output_picker_;
+
+		// A subtree of the Zielonka tree and the arena, copied to a manager of its own
+		struct SubtreeGame;
+		// Copies the subtree of root, expanded whole, to a new manager of game, with term as extra winning target
+		void detach_subtree(SubtreeGame &game, ZielonkaNode *root, const CUDD::BDD &term) const;
+		// EmersonLeiSolve from *start instead of the empty or full set, if start is set
+		CUDD::BDD EmersonLeiSolve(ZielonkaNode *t, CUDD::BDD term, const CUDD::BDD *start) const;
+		// Solves the detached games on up to threads worker threads, and returns the number of workers
+		static std::size_t SolveDetached(std::vector<SubtreeGame> &games, std::size_t threads,
+		                                 const std::function<void()> &check_budget);
+		// Solves the subtrees of the children of t for the given terms, each on a
+		// worker thread with its own manager; results are in the main manager
+		std::vector<CUDD::BDD> SolveChildrenInParallel(ZielonkaNode *t, const std::vector<CUDD::BDD> &terms) const;
+
+		CUDD::BDD getOneUnprocessedState(CUDD::BDD state_state, CUDD::BDD processed) const;
+
+		// The states of state_space_ that force target, as cpre without recording winning moves
+		CUDD::BDD controllable_pre(const CUDD::BDD &target) const;
+		// The fixpoints of EmersonLeiSolve for a tree of height at most two,
+		// without the per-node bookkeeping of the recursion
+		CUDD::BDD SolveTwoLevel() const;
+		// Publishes the root iterate X, of a greatest fixpoint if greatest, to the
+		// anytime callback, and returns whether it decides the initial state
+		bool root_iteration_decides(const CUDD::BDD &X, bool greatest) const;
+		// Solves a chain-shaped tree with ParitySolver, node i of the chain giving
+		// the states of priority i (shifted by one if the root is losing)
+		CUDD::BDD SolveParity() const;
+
+		// Index of the move of each (state cube, Zielonka order) in an EL_output_function.
+		// The cubes are kept alive by the moves, so their nodes are not reused
+		struct VisitedKeyHash {
+			std::size_t operator()(const std::pair<DdNode*, std::size_t> &key) const {
+				return std::hash<DdNode*>()(key.first) ^ (std::hash<std::size_t>()(key.second) * 0x9E3779B97F4A7C15ull);
+			}
+		};
+		using VisitedMoves = std::unordered_map<std::pair<DdNode*, std::size_t>, std::size_t, VisitedKeyHash>;
+		// Appends the moves from (gameNode, t) to op, skipping the pairs already in visited
+		void ExtractStrategy_Explicit(EL_output_function &op, VisitedMoves &visited, const CUDD::BDD &gameNode, ZielonkaNode *t) const;
+		
+		public:
+		
+		/**
+		* \brief Construct a single-strategy-synthesizer for the given Emerson-Lei game.
+		*
+		* \param spec A symbolic-state DFA representing the Buchi-reachability game arena.
+		* \param starting_player The player that moves first each turn.
+		* \param protagonist_player The player for which we aim to find the winning strategy.
+		* \param Colors The Emerson-Lei condition represented as a Boolean formula \beta over colors.
+		* \param colorBDDs The states of each color, one BDD per color: Fin(i) is read as the complement of colorBDDs[i].
+		* \param state_space The state space.
+		* \param z_tree The Zielonka tree of \a color_formula over \a colorBDDs, if one was
+		*   already built by a solver with the same state space; built otherwise. It must not
+		*   hold the winning moves of another solve (see set_release_winning_moves). A tree
+		*   built here is lazy: each node is expanded when EmersonLeiSolve first enters it.
+		*/
+		EmersonLei(const SymbolicStateDfa &spec, ColorFormula color_formula, Player starting_player, Player protagonist_player,
+			const std::vector<CUDD::BDD> &colorBDDs, const CUDD::BDD &state_space, const CUDD::BDD &instant_winning, const CUDD::BDD &instant_losing, bool adv_mp,
+			std::shared_ptr<ZielonkaTree> z_tree = nullptr);
+
+		/**
+		* \brief Same as above, with \a color_formula given in infix form.
+		*/
+		EmersonLei(const SymbolicStateDfa &spec, const std::string &color_formula, Player starting_player, Player protagonist_player,
+			const std::vector<CUDD::BDD> &colorBDDs, const CUDD::BDD &state_space, const CUDD::BDD &instant_winning, const CUDD::BDD &instant_losing, bool adv_mp,
+			std::shared_ptr<ZielonkaTree> z_tree = nullptr);
+
+		/**
+		* \brief Construct a single-strategy-synthesizer for an Emerson-Lei game on an unmaterialized product.
+		*
+		* Same as above, with preimages computed compositionally on \a arena.
+		*/
+		EmersonLei(const ProductArena &arena, ColorFormula color_formula, Player starting_player, Player protagonist_player,
+			const std::vector<CUDD::BDD> &colorBDDs, const CUDD::BDD &state_space, const CUDD::BDD &instant_winning, const CUDD::BDD &instant_losing, bool adv_mp,
+			std::shared_ptr<ZielonkaTree> z_tree = nullptr);
+
+		/**
+		* \brief Same as above, with \a color_formula given in infix form.
+		*/
+		EmersonLei(const ProductArena &arena, const std::string &color_formula, Player starting_player, Player protagonist_player,
+			const std::vector<CUDD::BDD> &colorBDDs, const CUDD::BDD &state_space, const CUDD::BDD &instant_winning, const CUDD::BDD &instant_losing, bool adv_mp,
+			std::shared_ptr<ZielonkaTree> z_tree = nullptr);
+
+		/**
+		* \brief Solves the game for the subtree of \a t, with \a term as extra winning target.
+		*
+		* The result only depends on the label of \a t and on \a term, since the
+		* state space is fixed. Unless winning moves are recorded for strategy
+		* extraction, results are cached by the dag_id of \a t and \a term, so
+		* repeated subtrees are solved once per distinct target.
+		*/
+		CUDD::BDD EmersonLeiSolve(ZielonkaNode *t, CUDD::BDD term) const;
+		CUDD::BDD BuchiAlgorithm() const;
+		// Toggle the embedded Büchi algorithm at runtime
+		void set_use_embedded_buchi(bool use) { use_embedded_buchi_ = use; }
+		/**
+		* \brief Solves the children of a Zielonka node on up to \a threads threads.
+		*
+		* Only used for nodes with at least \a min_children children while the
+		* approximation has at least \a min_nodes BDD nodes, since each child
+		* needs its own manager and a copy of the transition function, and only
+		* when no winning moves are recorded for strategy extraction and no
+		* state abstraction is set.
+		*/
+		void set_threads(std::size_t threads, std::size_t min_children = parallel_min_children,
+		                 int min_nodes = parallel_min_nodes);
+		/**
+		* \brief Sets the order in which EmersonLeiSolve visits the children of a node; ChildOrder::Construction by default.
+		*
+		* When no winning moves are recorded for strategy extraction and the
+		* children are solved sequentially, an iteration of a winning node stops
+		* once the intersection of its children is its term, which every child
+		* contains, and of a losing node once the union is every state, so the
+		* order decides how many children are skipped. The solution is the same.
+		*/
+		void set_child_order(ChildOrder order) { child_order_ = order; }
+		/**
+		* \brief Starts the fixpoint of each node from its result in the previous iteration of its grandparent; off by default.
+		*
+		* The grandparent has the fixpoint type of the node, so along its
+		* iterations the terms of the node, for the same iteration of the
+		* parent, only shrink (greatest fixpoints) or only grow (least
+		* fixpoints). The previous result is then a bound on the side the
+		* fixpoint starts from, and the solution is the same. Only used when no
+		* winning moves are recorded for strategy extraction, since they depend
+		* on the iterates.
+		*/
+		void set_warm_start(bool warm_start) { warm_start_ = warm_start; }
+		/**
+		* \brief The number of cpre calls of the last run_EL, also recorded as the size "el_cpre_calls".
+		*/
+		size_t cpre_calls() const { return cpre_calls_; }
+		/**
+		* \brief Solves the games of \a solvers on up to \a threads threads, each on a worker thread with its own manager.
+		*
+		* The solvers must share their variable manager, e.g. conditions on the
+		* same arena. Each game is solved as by EmersonLeiSolve on its whole
+		* Zielonka tree from the instantly winning states, without winning moves,
+		* state abstraction or the solvers picked by run_EL.
+		*
+		* \return The winning states of each solver, in the shared manager.
+		*/
+		static std::vector<CUDD::BDD> SolveInParallel(const std::vector<const EmersonLei*> &solvers, std::size_t threads);
+    	CUDD::BDD cpre(ZielonkaNode *t, int i, CUDD::BDD target) const;
+		EL_output_function ExtractStrategy_Explicit(EL_output_function op, CUDD::BDD winning_states, CUDD::BDD gameNode, ZielonkaNode *t) const;
+		/**
+		* \brief Extracts a winning strategy from every state of \a winning_states at once.
+		*
+		* Follows the choices of ExtractStrategy_Explicit, but as BDDs: the memory
+		* (the root and the leaves of the Zielonka tree) is encoded in fresh state
+		* variables, and the returned transducer has one output function over
+		* states and memory per output variable, and the arena transition function
+		* followed by one memory update function per memory variable. Requires the
+		* winning moves of a solve that extracts strategies, and the agent to move first.
+		*/
+		std::unique_ptr<Transducer> ExtractStrategy_Symbolic(const CUDD::BDD &winning_states) const;
+		/**
+		* \brief The strategy of ExtractStrategy_Symbolic, before its memory is encoded.
+		*/
+		struct MemoryStrategy {
+			// The memory values: the root of the tree, then its leaves
+			std::vector<ZielonkaNode *> memory;
+			// The winning moves at each memory value, over states and outputs
+			std::vector<CUDD::BDD> moves;
+			// The moves of moves[m] that update memory m to each memory value
+			std::vector<std::vector<CUDD::BDD>> next;
+		};
+		/**
+		* \brief Returns the strategy of ExtractStrategy_Symbolic from \a winning_states on the tree of \a root.
+		*
+		* Only reads the tree, whose winning moves must have been recorded, so
+		* it applies to the trees of any ELSynthesisResult, e.g. those of the
+		* DAG nodes of MannaPnueli.
+		*/
+		static MemoryStrategy memory_strategy(ZielonkaNode *root, const CUDD::BDD &winning_states,
+		                                      const std::shared_ptr<VarMgr> &var_mgr);
+		/**
+		* \brief Makes run_EL keep the winning moves of a strategy solve but extract no strategy.
+		*
+		* The caller extracts it from the Zielonka tree of the result, which is
+		* then also returned when the initial state is lost.
+		*/
+		void set_defer_strategy(bool defer) { defer_strategy_ = defer; }
+		/**
+		* \brief Makes run_EL return a strategy from ExtractStrategy_Symbolic instead of ExtractStrategy_Explicit when realizable.
+		*/
+		void set_symbolic_strategy(bool symbolic) { symbolic_strategy_ = symbolic; }
+		/**
+		* \brief Makes run_EL free the winning moves of the Zielonka tree and the solve cache once solved, when no strategy is extracted.
+		*
+		* The tree is kept, but its nodes cannot be used for strategy
+		* extraction or saved with save_el_synthesis_result afterwards.
+		*/
+		void set_release_winning_moves(bool release) { release_winning_moves_ = release; }
+		/**
+		* \brief Makes run_EL publish sound bounds on the winning states while solving, and stop once they decide the initial state.
+		*
+		* After each iteration of the root fixpoint of EmersonLeiSolve or SolveTwoLevel,
+		* \a callback receives the iterate: a least fixpoint (losing root) grows from
+		* below, so its iterates are winning states, and a greatest fixpoint (winning
+		* root) shrinks from above, so the states outside its iterates are losing.
+		* When no strategy is extracted, solving stops as soon as the initial state is
+		* decided by such a bound, and run_EL returns the verdict with the last iterate as winning
+		* states. An empty callback turns the mode off.
+		*/
+		void set_anytime(PartialResultCallback callback) { anytime_ = std::move(callback); }
+		/**
+		* \brief Makes run_EL publish the bounds of set_anytime after each root iteration, without stopping early.
+		*
+		* Used to checkpoint long solves (see SolveCheckpoint). An empty callback turns it off.
+		*/
+		void set_root_progress(PartialResultCallback callback) { root_progress_ = std::move(callback); }
+		/**
+		* \brief Returns the Zielonka tree of the condition, restricted to the state space.
+		*
+		* Only the nodes entered by the solves so far are built, unless a strategy is
+		* extracted, which needs the whole tree.
+		*/
+		std::shared_ptr<ZielonkaTree> zielonka_tree() const { return z_tree_; }
+		/**
+		* \brief Returns the shape of the condition, as classified from the Zielonka tree.
+		*/
+		AcceptanceClass acceptance_class() const { return acceptance_class_; }
+		/**
+		* \brief Whether run_EL picks the solver from acceptance_class(); false by default.
+		*
+		* Conditions whose tree has height at most two (reachability, safety, and
+		* generalized Büchi and co-Büchi) are then solved by SolveTwoLevel when no
+		* strategy is extracted, and all others by EmersonLeiSolve.
+		*/
+		void set_auto_dispatch(bool auto_dispatch) { auto_dispatch_ = auto_dispatch; }
+		/**
+		* \brief Whether run_EL always solves the condition with ParitySolver.
+		*
+		* False by default, so that parity chain conditions are solved like the
+		* others (see set_auto_dispatch); the LTLf+ synthesizer sets it for
+		* -g 3. run_EL throws std::runtime_error if the Zielonka tree is not a
+		* chain or if there are instantly winning or losing states, and extracts
+		* no strategy.
+		*/
+		void set_force_parity(bool force_parity) { force_parity_ = force_parity; }
+		CUDD::BDD getUniqueSystemChoice(CUDD::BDD gameNode, CUDD::BDD winningmoves) const;
+		// CUDD::BDD getUniqueSystemChoice(CUDD::BDD gameNode, std::unique_ptr<Transducer> transducer) const;
+		std::vector<CUDD::BDD> getSuccsWithYZ(CUDD::BDD gameNode, CUDD::BDD Y) const;
+		CUDD::BDD getSuccsWithXYZ(CUDD::BDD gameNode, CUDD::BDD Y, CUDD::BDD X) const;
+		static int index_below(ZielonkaNode *anchor_node, ZielonkaNode *old_memory);
+		ZielonkaNode* get_anchor(CUDD::BDD game_node, ZielonkaNode *memory_value) const;
+		ZielonkaNode* get_leaf(ZielonkaNode *old_memory, ZielonkaNode *anchor_node, ZielonkaNode *curr, CUDD::BDD Y) const;
+		inline const std::vector<CUDD::BDD>& transition_function() const {return spec_.transition_function();}
+		inline int spec_id() const {return spec_.automaton_id();}
+		SynthesisResult run() const final;
+		ELSynthesisResult run_EL() const;
+
+		// struct OneStepSynReturn {
+		// 	EL_output_function op_;
+		// 	CUDD::BDD game_state_;
+		// 	size_t tree_node_;
+		// 	CUDD::BDD Y_;
+		// };
+		// OneStepSynReturn ExtractStrategy_Explicit_OneStep(EL_output_function op, CUDD::BDD winning_states, CUDD::BDD gameNode, ZielonkaNode *t, CUDD::BDD X) const;
+		// OneStepSynReturn synthesize(std::string X, ELSynthesisResult result );
+
+		
+	};
+}
+
+
 #endif //LYDIASYFT_EMERSONLEI_HPP
\ No newline at end of file
@@ -0,0 +1,204 @@
+#ifndef EXPLICIT_GAME_SOLVER_H
+#define EXPLICIT_GAME_SOLVER_H
+
+#include "automata/ExplicitStateDfa.h"
+#include "automata/StateEncoding.h"
+#include "automata/SymbolicStateDfa.h"
+#include "game/Transducer.h"
+#include "Player.h"
+#include "VarMgr.h"
+#include "cuddObj.hh"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Syft {
+
+/**
+ * \brief A set of explicit states, one bit per state in 64-bit words.
+ *
+ * The set operations work a word at a time, so that the compiler can
+ * vectorize them. Padding bits past size() are always clear.
+ */
+class StateBitset {
+public:
+    StateBitset() = default;
+
+    /**
+     * \brief Creates a set of \a size states, all of them if \a full.
+     */
+    explicit StateBitset(std::size_t size, bool full = false);
+
+    std::size_t size() const { return size_; }
+    bool test(std::size_t state) const { return (words_[state >> 6] >> (state & 63)) & 1; }
+    void set(std::size_t state) { words_[state >> 6] |= std::uint64_t(1) << (state & 63); }
+    void reset(std::size_t state) { words_[state >> 6] &= ~(std::uint64_t(1) << (state & 63)); }
+
+    /** \brief Returns the number of states in the set. */
+    std::size_t count() const;
+    /** \brief Returns whether the set is empty. */
+    bool none() const;
+    /** \brief Returns the complement of the set. */
+    StateBitset operator~() const;
+
+    StateBitset &operator|=(const StateBitset &other);
+    StateBitset &operator&=(const StateBitset &other);
+    bool operator==(const StateBitset &other) const { return words_ == other.words_; }
+    bool operator!=(const StateBitset &other) const { return !(*this == other); }
+
+    const std::vector<std::uint64_t> &words() const { return words_; }
+
+private:
+    std::size_t size_ = 0;
+    std::vector<std::uint64_t> words_;
+};
+
+/**
+ * \brief The winning conditions solved by ExplicitGameSolver, over the final states F of the DFA.
+ */
+enum class ExplicitGameCondition {
+    /** \brief Reach F: μX. F ∪ CPre(X). */
+    Reachability,
+    /** \brief Stay in F: νX. F ∩ CPre(X). */
+    Safety,
+    /** \brief Visit F infinitely often: νZ. μY. (F ∩ CPre(Z)) ∪ CPre(Y); also solves weak games. */
+    Buchi,
+    /** \brief Eventually stay in F: μX. νY. (F ∩ CPre(Y)) ∪ CPre(X), as BuchiSolver::BuchiMode::COBUCHI. */
+    CoBuchi
+};
+
+/**
+ * \brief Result of the explicit game solver.
+ */
+struct ExplicitGameResult {
+    bool realizability = false;
+    StateBitset winning_states;  ///< Partial if the solver only decided the initial state
+    /**
+     * \brief The rank of each winning state, by which the strategy makes progress.
+     *
+     * The iteration of the least fixpoint (the last inner one for Büchi) in
+     * which the state became winning, or the outer iteration for coBüchi.
+     */
+    std::vector<std::uint32_t> ranks;
+    std::size_t iterations = 0;  ///< CPre computations of all fixpoints
+};
+
+/**
+ * \brief Solves games on the arena of a small explicit DFA without BDDs.
+ *
+ * Each turn the starting player picks its variables, then the other player,
+ * and the DFA reads the joint letter. The successors of each state under each
+ * move of the starting player (its variables read by the DFA) are stored as
+ * one row of a compressed sparse successor graph, read once from the MONA
+ * BDDs of the DFA. A protagonist moving first then controls a state if one of
+ * its rows lies in the target, and a protagonist moving second if every row
+ * meets the target; the fixpoints iterate this over bitsets.
+ *
+ * For arenas of a few thousand states, e.g. obligation arenas after
+ * ExplicitStateDfa::dfa_minimize_weak, this is cheaper than the symbolic
+ * solvers, which is what applicable decides (see
+ * ObligationLTLfPlusSynthesizer::run). The graph has states times 2^k rows,
+ * for the k variables of the starting player, hence the bound on rows.
+ */
+class ExplicitGameSolver {
+public:
+    /** \brief Arenas with more states are left to the symbolic solvers by default. */
+    static constexpr std::size_t default_max_states = 4096;
+    /** \brief Arenas with more rows (states times moves of the starting player) are never solved explicitly. */
+    static constexpr std::size_t max_rows = std::size_t(1) << 22;
+
+    /**
+     * \brief Creates a solver for the game on \a dfa, whose variables are partitioned in \a var_mgr.
+     *
+     * Builds the successor graph.
+     */
+    ExplicitGameSolver(SharedExplicitStateDfa dfa, std::shared_ptr<VarMgr> var_mgr,
+                       Player starting_player, Player protagonist_player);
+
+    /**
+     * \brief Returns whether \a dfa has at most \a max_states states and max_rows rows.
+     */
+    static bool applicable(const ExplicitStateDfa &dfa, const VarMgr &var_mgr, Player starting_player,
+                           std::size_t max_states = default_max_states);
+
+    /**
+     * \brief Only decide the initial state; fixpoints stop once it is decided and the ranks are partial.
+     */
+    void set_realizability_only(bool realizability_only);
+
+    std::size_t state_count() const;
+    /** \brief Returns the number of rows of each state, the moves of the starting player. */
+    std::size_t move_count() const;
+    /** \brief Returns the number of distinct successors over all rows. */
+    std::size_t edge_count() const;
+
+    /** \brief Returns the final states of the DFA. */
+    const StateBitset &final_states() const;
+
+    /**
+     * \brief Returns the states from which the protagonist can force the next state into \a target.
+     */
+    StateBitset controllable_preimage(const StateBitset &target) const;
+
+    /**
+     * \brief Solves the game for \a condition.
+     */
+    ExplicitGameResult solve(ExplicitGameCondition condition) const;
+
+    /**
+     * \brief Returns the states of \a states as a BDD over the state variables of \a arena.
+     *
+     * \param arena SymbolicStateDfa::from_mona of the DFA of the solver with \a encoding.
+     */
+    CUDD::BDD to_bdd(const StateBitset &states, const SymbolicStateDfa &arena, StateEncodingKind encoding) const;
+
+    /**
+     * \brief Returns a winning strategy from the states of a realizable \a result as a transducer over \a arena.
+     *
+     * \param arena SymbolicStateDfa::from_mona of the DFA of the solver with \a encoding.
+     */
+    std::unique_ptr<Transducer> transducer(const ExplicitGameResult &result, ExplicitGameCondition condition,
+                                           const SymbolicStateDfa &arena, StateEncodingKind encoding) const;
+
+private:
+    SharedExplicitStateDfa dfa_;
+    std::shared_ptr<VarMgr> var_mgr_;
+    Player starting_player_;
+    Player protagonist_player_;
+    bool realizability_only_ = false;
+
+    // The bit of each DFA variable in a move of the starting player, or -1 for the other player's
+    std::vector<int> move_bit_;
+    std::size_t move_count_ = 1;
+    // Row s * move_count_ + a lists the successors of state s under move a
+    std::vector<std::size_t> row_offsets_;
+    std::vector<std::uint32_t> successors_;
+    StateBitset final_states_;
+
+    bool protagonist_moves_first() const;
+    void build_rows();
+
+    /**
+     * \brief The least fixpoint of base ∪ CPre(Y) within \a bound, ranking its states from \a first_rank.
+     *
+     * Stops once the initial state is in if \a stop_at_initial.
+     */
+    StateBitset attractor(const StateBitset &base, const StateBitset &bound, std::vector<std::uint32_t> &ranks,
+                          std::uint32_t first_rank, bool stop_at_initial, std::size_t &iterations) const;
+
+    /**
+     * \brief Returns whether moving from \a state to \a successor makes progress in \a result.
+     */
+    bool progresses(const ExplicitGameResult &result, ExplicitGameCondition condition, std::size_t state,
+                    std::size_t successor) const;
+
+    /**
+     * \brief Returns the assignment of the protagonist variables answering \a move in \a state, as DFA variable values.
+     */
+    std::vector<int> response(const ExplicitGameResult &result, ExplicitGameCondition condition, std::size_t state,
+                              std::size_t move) const;
+};
+
+}
+
+#endif // EXPLICIT_GAME_SOLVER_H
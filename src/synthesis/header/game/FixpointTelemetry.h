@@ -0,0 +1,88 @@
+#ifndef FIXPOINT_TELEMETRY_H
+#define FIXPOINT_TELEMETRY_H
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+#include <cuddObj.hh>
+
+namespace Syft {
+
+/**
+ * \brief Writes one record per fixpoint iteration of the game solvers to a file.
+ *
+ * A record has the pid of the process, the solver, the node of the solver
+ * whose fixpoint it is (e.g. a Zielonka tree node or an SCC layer), the index
+ * of the iteration from 1, the BDD size and the number of states of the
+ * approximation after the iteration, the time spent in the iteration and
+ * the time since the fixpoint started, in milliseconds. A file ending in
+ * .csv gets a header line and one line of CSV per record; any other file
+ * gets one JSON object per line.
+ *
+ * Each record is written with one write to a file opened for appending, so
+ * records of threads and of forked children (Portfolio entries, batch
+ * workers) are never interleaved, and none is lost when a child leaves with
+ * _exit. Recording is off unless start is called, and a FixpointProbe then
+ * costs one atomic load per fixpoint.
+ */
+class FixpointTelemetry {
+public:
+    /**
+     * \brief Truncates \a filename and starts recording to it.
+     *
+     * Throws std::runtime_error if the file cannot be opened.
+     */
+    static void start(const std::string& filename);
+
+    /**
+     * \brief Returns whether iterations are recorded.
+     */
+    static bool enabled();
+
+    /**
+     * \brief Stops recording and closes the file. Does nothing if not recording.
+     */
+    static void finish();
+
+    static void record(const char* solver, const std::string& node, std::size_t iteration,
+                       double approximation_nodes, double approximation_states,
+                       double iteration_ms, double elapsed_ms);
+};
+
+/**
+ * \brief Records the iterations of one fixpoint to the FixpointTelemetry.
+ *
+ *   FixpointProbe probe("weak reachability", node, state_bits);
+ *   while (true) {
+ *       ...
+ *       probe.iteration(new_winning);
+ *   }
+ */
+class FixpointProbe {
+public:
+    /**
+     * \param solver The name of the fixpoint; must outlive the probe, e.g. a string literal.
+     * \param node The node of the solver the fixpoint belongs to, empty if the solver has a single one.
+     * \param state_bits The number of state variables, over which the states of the approximations are counted.
+     */
+    FixpointProbe(const char* solver, std::string node, std::size_t state_bits);
+
+    /**
+     * \brief Records an iteration whose result is \a approximation; its size is only counted while recording.
+     */
+    void iteration(const CUDD::BDD& approximation);
+
+private:
+    bool active_;
+    const char* solver_;
+    std::string node_;
+    std::size_t state_bits_;
+    std::size_t iterations_ = 0;
+    std::chrono::steady_clock::time_point start_;
+    std::chrono::steady_clock::time_point last_;
+};
+
+}
+
+#endif // FIXPOINT_TELEMETRY_H
@@ -0,0 +1,49 @@
+#ifndef FIXPOINT_TRACE_H
+#define FIXPOINT_TRACE_H
+
+#include <cstddef>
+#include <vector>
+
+#include <cuddObj.hh>
+
+namespace Syft {
+
+/**
+ * \brief How the iterations of a reachability or safety fixpoint are computed.
+ */
+enum class FixpointMode {
+    /** \brief Recompute the controllable predecessor of the whole approximation. */
+    Full,
+    /**
+     * \brief Only re-examine the predecessors of the states added (or removed) by the last iteration.
+     *
+     * Other states have the same successors in the approximation as before, so
+     * their status cannot change. The transition function is simplified with
+     * Restrict to those candidate states before composing.
+     */
+    Frontier
+};
+
+/**
+ * \brief Sizes recorded at each iteration of a fixpoint.
+ */
+struct FixpointTrace {
+    std::vector<double> frontier_states;      ///< States added or removed by each iteration
+    std::vector<double> candidate_states;     ///< States re-examined by each iteration
+    std::vector<int> approximation_nodes;     ///< BDD size of the approximation after each iteration
+
+    std::size_t iterations() const {
+        return frontier_states.size();
+    }
+
+    void record(const CUDD::BDD &frontier, const CUDD::BDD &candidates,
+                const CUDD::BDD &approximation, std::size_t state_bits) {
+        frontier_states.push_back(frontier.CountMinterm(static_cast<int>(state_bits)));
+        candidate_states.push_back(candidates.CountMinterm(static_cast<int>(state_bits)));
+        approximation_nodes.push_back(approximation.nodeCount());
+    }
+};
+
+}
+
+#endif // FIXPOINT_TRACE_H
@@ -0,0 +1,122 @@
+#ifndef GAME_KERNEL_H
+#define GAME_KERNEL_H
+
+#include "BddBackend.h"
+#include "Player.h"
+#include "cuddObj.hh"
+
+#include <vector>
+
+namespace Syft {
+
+/**
+ * \brief The cubes of the two players of a game, from the view of the protagonist.
+ */
+struct GameCubes {
+    /** \brief The variables of the protagonist. */
+    CUDD::BDD protagonist;
+    /** \brief The variables of the other player. */
+    CUDD::BDD opponent;
+};
+
+/**
+ * \brief The quantification of a controllable predecessor for one order of play, fixed at compile time.
+ *
+ * A protagonist that moves first wins from a state if its move wins against
+ * every move of the opponent, exists P. forall O, and one that moves second
+ * if it has an answer to every move, forall O. exists P. The moves the
+ * protagonist picks are quantified in two steps, as by the Quantification of
+ * DfaGameSynthesizer: independent() the variables its move does not depend
+ * on, and non_state() the rest.
+ */
+template <Player Starting, Player Protagonist>
+struct GameQuantifiers {
+    static constexpr bool protagonist_first = Starting == Protagonist;
+
+    static CUDD::BDD independent(const CUDD::BDD &moves, const GameCubes &cubes, const BddBackend &backend) {
+        if constexpr (protagonist_first) {
+            return backend.UnivAbstract(moves, cubes.opponent);
+        } else {
+            return moves;
+        }
+    }
+
+    static CUDD::BDD non_state(const CUDD::BDD &moves, const GameCubes &cubes, const BddBackend &backend) {
+        if constexpr (protagonist_first) {
+            return backend.ExistAbstract(moves, cubes.protagonist);
+        } else {
+            return backend.UnivAbstract(backend.ExistAbstract(moves, cubes.protagonist), cubes.opponent);
+        }
+    }
+
+    static CUDD::BDD controllable(const CUDD::BDD &moves, const GameCubes &cubes, const BddBackend &backend) {
+        return non_state(independent(moves, cubes, backend), cubes, backend);
+    }
+
+    static std::vector<BddQuantifier> quantifiers(const GameCubes &cubes) {
+        if constexpr (protagonist_first) {
+            return {BddQuantifier{true, cubes.opponent}, BddQuantifier{false, cubes.protagonist}};
+        } else {
+            return {BddQuantifier{false, cubes.protagonist}, BddQuantifier{true, cubes.opponent}};
+        }
+    }
+};
+
+/**
+ * \brief The GameQuantifiers of a game, selected once when the game is built.
+ *
+ * The solvers call it in every preimage of their fixpoints, through function
+ * pointers to the instantiation of their order of play, instead of through a
+ * virtual Quantification per step that must also run the steps quantifying
+ * nothing.
+ */
+class GameKernel {
+public:
+    using Step = CUDD::BDD (*)(const CUDD::BDD &, const GameCubes &, const BddBackend &);
+
+    GameKernel() = default;
+
+    /**
+     * \brief Selects the kernel of the game where \a starting_player moves first.
+     */
+    GameKernel(Player starting_player, Player protagonist_player, const CUDD::BDD &input_cube,
+               const CUDD::BDD &output_cube);
+
+    /** \brief Quantifies the variables the moves of the protagonist do not depend on. */
+    CUDD::BDD independent(const CUDD::BDD &moves, const BddBackend &backend) const {
+        return independent_(moves, cubes_, backend);
+    }
+
+    /** \brief Quantifies the remaining non-state variables of moves already passed to independent. */
+    CUDD::BDD non_state(const CUDD::BDD &moves, const BddBackend &backend) const {
+        return non_state_(moves, cubes_, backend);
+    }
+
+    /** \brief Returns the states from which the protagonist forces the transitions \a moves, both steps. */
+    CUDD::BDD controllable(const CUDD::BDD &moves, const BddBackend &backend) const {
+        return controllable_(moves, cubes_, backend);
+    }
+
+    /** \brief The quantifications of controllable, in order, for BddBackend::LeastFixpoint. */
+    std::vector<BddQuantifier> quantifiers() const {
+        return quantifiers_(cubes_);
+    }
+
+    bool protagonist_first() const { return protagonist_first_; }
+    const GameCubes &cubes() const { return cubes_; }
+
+private:
+    GameCubes cubes_;
+    bool protagonist_first_ = false;
+    Step independent_ = nullptr;
+    Step non_state_ = nullptr;
+    Step controllable_ = nullptr;
+    std::vector<BddQuantifier> (*quantifiers_)(const GameCubes &) = nullptr;
+
+    template <Player Starting, Player Protagonist>
+    void select();
+};
+
+}
+
+#endif // GAME_KERNEL_H
@@ -0,0 +1,76 @@
+#ifndef LYDIASYFT_LAYEREDEMERSONLEI_H
+#define LYDIASYFT_LAYEREDEMERSONLEI_H
+
+#include "game/ColorFormula.h"
+#include "game/DfaGameSynthesizer.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace Syft {
+/**
+ * \brief A synthesizer for an Emerson-Lei game solved one layer of the arena's SCC DAG at a time.
+ *
+ * The state space is peeled into layers of SCCs by ChainSCCDecomposer, and
+ * the layers are solved bottom-up, as in WeakGameSolver: the successors of a
+ * layer lie in it or below it, where every state is already decided, so each
+ * layer is an EmersonLei game on its own states with the winning and losing
+ * states below as instantly winning and losing. A play that stays in a
+ * layer visits the colors of the other layers finitely often, so they are
+ * set to false in the condition of the layer, and its Zielonka tree is only
+ * built over the colors the layer contains; EmersonLei builds the tree of
+ * all the colors, whose size may be exponential in their number.
+ */
+    class LayeredEmersonLei : public DfaGameSynthesizer {
+    private:
+        ColorFormula color_formula_;
+        std::vector<CUDD::BDD> colors_;
+        CUDD::BDD state_space_;
+        // The condition, over variable i for color i
+        mutable CUDD::Cudd color_mgr_;
+        CUDD::BDD condition_;
+
+        // The winning states of layer, whose successors outside it are in winning_below or losing_below;
+        // tree_nodes is raised to the size of the Zielonka tree of the layer
+        CUDD::BDD solve_layer(const CUDD::BDD &layer, const CUDD::BDD &winning_below, const CUDD::BDD &losing_below,
+                              std::size_t &tree_nodes) const;
+
+    public:
+
+        /**
+         * \brief Construct a synthesizer for the given Emerson-Lei game.
+         *
+         * \param spec A symbolic-state DFA representing the game arena.
+         * \param color_formula The Emerson-Lei condition over the colors.
+         * \param starting_player The player that moves first each turn.
+         * \param protagonist_player The player for which we aim to find the winning strategy.
+         * \param colorBDDs The states of each color.
+         * \param state_space The state space.
+         */
+        LayeredEmersonLei(const SymbolicStateDfa &spec, ColorFormula color_formula, Player starting_player,
+                          Player protagonist_player, const std::vector<CUDD::BDD> &colorBDDs,
+                          const CUDD::BDD &state_space);
+
+        /**
+         * \brief Construct a synthesizer for an Emerson-Lei game on an unmaterialized product.
+         *
+         * Same as above, with the layers of the symbolic view of \a arena and
+         * preimages computed compositionally on \a arena.
+         */
+        LayeredEmersonLei(const ProductArena &arena, ColorFormula color_formula, Player starting_player,
+                          Player protagonist_player, const std::vector<CUDD::BDD> &colorBDDs,
+                          const CUDD::BDD &state_space);
+
+        /**
+         * \brief Solves the Emerson-Lei game.
+         *
+         * With set_realizability_only, stops at the layer of the initial state.
+         *
+         * \return The result consists of realizability and the set of protagonist
+         * winning states; no winning moves or transducer are built.
+         */
+        SynthesisResult run() const final;
+    };
+}
+
+#endif //LYDIASYFT_LAYEREDEMERSONLEI_H
@@ -6,8 +6,14 @@
 #define MANNAPNUELI_H
 
 
+#include "SolveCheckpoint.h"
+#include "game/DagWorkQueue.h"
+#include "game/ColorSet.h"
 #include "game/DfaGameSynthesizer.h"
 #include "game/ZielonkaTree.hh"
+#include <map>
+#include <memory>
+#include <tuple>
 
 namespace Syft {
 	/**
@@ -42,39 +48,115 @@ namespace Syft {
 		*/
     	CUDD::BDD color_formula_bdd_;
 		int game_solver_;
+		// Threads solving the DAG nodes of a level (see set_threads)
+		std::size_t threads_ = 1;
+		// Directory shared with DagWorkQueue workers, if the DAG is solved by them (see set_work_directory)
+		std::string work_directory_;
+		// Saves the solved DAG nodes, if set (see set_checkpoint)
+		std::shared_ptr<SolveCheckpoint> checkpoint_;
+		bool resume_ = false;
+		// Identical subgames of different DAG nodes are solved once: keyed by the
+		// simplified color formula (a BDD of color_mgr_), the state space and the
+		// instant winning and losing states
+		typedef std::tuple<DdNode*, DdNode*, DdNode*, DdNode*> SubgameKey;
+		struct Subgame {
+			// Keep the nodes of the key alive
+			CUDD::BDD color_formula;
+			CUDD::BDD state_space;
+			CUDD::BDD instant_winning;
+			CUDD::BDD instant_losing;
+			ELSynthesisResult result;
+		};
+		mutable std::map<SubgameKey, Subgame> subgame_cache_;
+		// Zielonka trees by simplified color formula and state space, shared when no strategy is extracted
+		struct CachedTree {
+			// Keep the nodes of the key alive
+			CUDD::BDD color_formula;
+			CUDD::BDD state_space;
+			std::shared_ptr<ZielonkaTree> tree;
+		};
+		mutable std::map<std::pair<DdNode*, DdNode*>, CachedTree> tree_cache_;
+		mutable std::size_t subgame_cache_hits_ = 0;
+		// Receives the winning states known so far, see set_anytime
+		PartialResultCallback anytime_;
+		bool symbolic_strategy_ = false;
+		// Whether the adv solver skips the DAG nodes without reachable states (see set_prune_nodes)
+		bool prune_nodes_ = true;
 		struct Node {
-			std::vector<int> F;
-			std::vector<int> G;
+			// Bit i of F for F_colors_[i], and of G for G_colors_[i]
+			ColorSet F;
+			ColorSet G;
 			int id;
 			std::vector<Node*> parents; // Store parent nodes directly
 			std::vector<std::pair<Node*, int>> children; // Store child nodes directly
 		};
 
 		// Custom hash function for unordered_map
-		struct VectorHash {
-			size_t operator()(const std::pair<std::vector<int>, std::vector<int>>& p) const {
-				size_t hashF = 0, hashG = 0;
-				for (int i : p.first) hashF = hashF * 31 + i;
-				for (int i : p.second) hashG = hashG * 31 + i;
-				return hashF ^ hashG;
+		struct ColorSetPairHash {
+			size_t operator()(const std::pair<ColorSet, ColorSet>& p) const {
+				return p.first.hash() * 31 ^ p.second.hash();
 			}
 		};
 		typedef std::unordered_map<int, Node*> Dag; // Store nodes by their unique ID
-		typedef std::unordered_map<std::pair<std::vector<int>, std::vector<int>>, int, VectorHash> Node_to_Id;
+		typedef std::unordered_map<std::pair<ColorSet, ColorSet>, int, ColorSetPairHash> Node_to_Id;
 		Dag dag_; // The bottom node is having all F-bits as 1 and G-bits as 0, the id of this node is 0
 		Node_to_Id node_to_id_;
 
 		std::pair<Dag, Node_to_Id> build_FG_dag();
-		std::string simplify_color_formula(std::vector<int> F_color, std::vector<int> G_color) const;
-		std::string color_formula_bdd_to_string (const CUDD::BDD &color_formula_bdd) const;
+		// color_formula_bdd_ with the F- and G-colors fixed as given
+		CUDD::BDD simplify_color_formula(const ColorSet &F_color, const ColorSet &G_color) const;
+		// Compiles a BDD of color_mgr_ for the Zielonka tree, with no string in between
+		ColorFormula compile_color_formula(const CUDD::BDD &color_formula_bdd) const;
+		// The states of each DAG node the colors of a state move a play in node \a id to, for ExtractStrategy_Symbolic
+		std::vector<std::pair<int, CUDD::BDD>> successor_regions(int id) const;
 		void print_FG_dag() const;
-		std::string remove_whitespace(const std::string &str) const;
-		int precedence(char op) const;
-		std::string infix_to_postfix(const std::string &infix) const;
 		Node* bottom_node_Dag() const;
 		std::vector<CUDD::BDD> getSuccsWithYZ(CUDD::BDD gameNode, CUDD::BDD Y) const;
 		CUDD::BDD cpre(CUDD::BDD target) const;
 		void MP_solve();
+		/**
+		* \brief The states where \a node is won or lost at once, when their color flips to a child of winning states \a children_winning.
+		*/
+		std::pair<CUDD::BDD, CUDD::BDD> children_instant_sets(const Node *node,
+		const std::vector<CUDD::BDD> &children_winning) const;
+		/**
+		* \brief The states of the arena whose colors match the F- and G-bits of \a node.
+		*/
+		CUDD::BDD node_state_space(const Node *node) const;
+		/**
+		* \brief Marks the DAG nodes whose node_state_space has no state reachable from the initial state.
+		*
+		* With the adv solver (game_solver_ == 2) such nodes need not be solved: their
+		* states are neither reachable nor successors of reachable states, so they
+		* cannot change the winning states of the other nodes in reachable states.
+		*/
+		std::vector<bool> prune_unreachable_nodes() const;
+		/**
+		* \brief The DAG node ids grouped by height: a node only depends on nodes of earlier groups.
+		*/
+		std::vector<std::vector<int>> dag_levels() const;
+		/**
+		* \brief Solves the nodes of \a level, each on its own manager by a worker thread.
+		*
+		* Only valid with game_solver_ == 1 and no strategy extraction: the nodes only
+		* read the winning states of their children.
+		*/
+		void SolveLevelInParallel(const std::vector<int> &level, std::vector<ELSynthesisResult> &EL_results) const;
+		/**
+		* \brief Solves the nodes of \a level by the worker processes of \a queue, under the same conditions.
+		*
+		* Only the realizability and the winning states of the nodes come back.
+		*/
+		void SolveLevelDistributed(DagWorkQueue &queue, const std::vector<int> &level,
+		std::vector<ELSynthesisResult> &EL_results) const;
+		/**
+		* \brief Releases the results of the children of \a level whose parents are now all solved.
+		*
+		* \a unsolved_parents counts, per node, the parents not solved yet. Only
+		* valid without strategy extraction, which reads the results of all nodes.
+		*/
+		void release_read_children(const std::vector<int> &level, std::vector<std::size_t> &unsolved_parents,
+		std::vector<ELSynthesisResult> &EL_results) const;
 
 		public:
 
@@ -91,8 +173,82 @@ namespace Syft {
 		std::vector<int> G_colors_, Player starting_player, Player protagonist_player,
 		const std::vector<CUDD::BDD> &colorBDDs, const CUDD::BDD &state_space, int game_solver);
 
+		/**
+		* \brief Same as above, with preimages computed compositionally on the unmaterialized product \a arena.
+		*/
+		MannaPnueli(const ProductArena &arena, std::string color_formula, std::vector<int> F_colors_,
+		std::vector<int> G_colors_, Player starting_player, Player protagonist_player,
+		const std::vector<CUDD::BDD> &colorBDDs, const CUDD::BDD &state_space, int game_solver);
+
 		CUDD::BDD boolean_string_to_bdd(const std::string &color_formula);
 
+		/**
+		* \brief Sets the number of threads solving the DAG nodes of a level concurrently.
+		*
+		* Used only with the Manna-Pnueli solver (game_solver 1) when no strategy is
+		* extracted, since the other solvers chain every node to the previous one.
+		* With 1, the nodes are solved one at a time, in id order.
+		*/
+		void set_threads(std::size_t threads);
+
+		/**
+		* \brief Solves the DAG nodes by worker processes sharing \a directory (see DagWorkQueue).
+		*
+		* Used under the same conditions as set_threads; the levels are then submitted
+		* to the workers instead of being solved by threads. An empty \a directory
+		* solves the nodes in this process.
+		*/
+		void set_work_directory(std::string directory);
+
+		/**
+		* \brief Saves the verdict and winning states of each DAG node in \a checkpoint as it is solved.
+		*
+		* If \a resume is set and \a checkpoint holds progress of this game, run_MP reloads
+		* the nodes solved before instead of solving them again. Ignored when a strategy
+		* is extracted, as the Zielonka trees of the nodes are not saved.
+		*/
+		void set_checkpoint(std::shared_ptr<SolveCheckpoint> checkpoint, bool resume);
+
+		/**
+		* \brief Makes run_MP publish sound bounds on the winning states while solving, and stop once they decide the initial state.
+		*
+		* With the EL and adv solvers (game_solver 0 and 2), the winning states of the
+		* nodes solved so far are instantly winning for the last node, so \a callback
+		* receives them after each node. The last node is solved with
+		* EmersonLei::set_anytime, which publishes the bounds of its root fixpoint.
+		* When no strategy is extracted, run_MP returns as soon as the initial state
+		* is decided. An empty callback turns the mode off.
+		*/
+		void set_anytime(PartialResultCallback callback);
+
+		/**
+		* \brief Extracts a winning strategy from the initial state at once, as a transducer.
+		*
+		* The memory is a DAG node id and a memory value of the Zielonka tree
+		* of that node (see EmersonLei::memory_strategy): a state whose colors
+		* keep the node follows the strategy of its tree, and one whose colors
+		* move to another node starts from the root of that node's tree, as
+		* ExtractStrategy_Explicit. The strategy of each node is built once,
+		* and shared by the nodes that reused the result of an identical
+		* subgame. Requires the winning moves of a solve that extracts
+		* strategies, and the agent to move first.
+		*/
+		std::unique_ptr<Transducer> ExtractStrategy_Symbolic(const std::vector<ELSynthesisResult> &EL_results) const;
+
+		/**
+		* \brief Makes run_MP return a strategy from ExtractStrategy_Symbolic instead of ExtractStrategy_Explicit when realizable.
+		*
+		* The DAG nodes then extract no strategy of their own (see EmersonLei::set_defer_strategy).
+		*/
+		void set_symbolic_strategy(bool symbolic) { symbolic_strategy_ = symbolic; }
+
+		/**
+		* \brief Sets whether run_MP skips the DAG nodes whose states are all unreachable (see prune_unreachable_nodes).
+		*
+		* Only used with the adv solver (game_solver 2) when no strategy is extracted. True by default.
+		*/
+		void set_prune_nodes(bool prune) { prune_nodes_ = prune; }
+
 		MP_output_function ExtractStrategy_Explicit(MP_output_function op, int curr_node_id, CUDD::BDD gameNode,
 																													ZielonkaNode *t,
 																													std::vector<ELSynthesisResult> EL_results) const;
@@ -0,0 +1,65 @@
+#ifndef LYDIASYFT_PARITYSOLVER_HPP
+#define LYDIASYFT_PARITYSOLVER_HPP
+
+#include "game/DfaGameSynthesizer.h"
+
+#include <vector>
+
+namespace Syft {
+/**
+ * \brief A synthesizer for a parity game given as a symbolic-state DFA.
+ *
+ * The agent wins the plays whose least priority visited infinitely often is
+ * even, the order of the nodes of a Zielonka tree chain. The game is solved
+ * by the nested fixpoint nu Z_0. mu Z_1. nu Z_2 ... of the union over i of
+ * P_i & CPre(Z_i), iterated as by Emerson and Lei: when Z_i changes, only the
+ * inner variables of the other polarity are reset, and the others keep their
+ * values, which still bound their new fixpoints from the right side.
+ */
+    class ParitySolver : public DfaGameSynthesizer {
+    private:
+        /**
+         * \brief The states of each priority; states of no priority are lost.
+         */
+        std::vector<CUDD::BDD> priorities_;
+        /**
+         * \brief The state space to consider.
+         */
+        CUDD::BDD state_space_;
+
+        // The states of state_space_ that force target, as EmersonLei::cpre
+        CUDD::BDD cpre(const CUDD::BDD &target) const;
+
+    public:
+
+        /**
+         * \brief Construct a synthesizer for the given parity game.
+         *
+         * \param spec A symbolic-state DFA representing the game arena.
+         * \param starting_player The player that moves first each turn.
+         * \param protagonist_player The player for which we aim to find the winning strategy.
+         * \param priorities The states of priority i, for each i; they should be disjoint.
+         * \param state_space The state space.
+         */
+        ParitySolver(const SymbolicStateDfa &spec, Player starting_player, Player protagonist_player,
+                     const std::vector<CUDD::BDD> &priorities, const CUDD::BDD &state_space);
+
+        /**
+         * \brief Construct a synthesizer for a parity game on an unmaterialized product.
+         *
+         * Same as above, with preimages computed compositionally on \a arena.
+         */
+        ParitySolver(const ProductArena &arena, Player starting_player, Player protagonist_player,
+                     const std::vector<CUDD::BDD> &priorities, const CUDD::BDD &state_space);
+
+        /**
+         * \brief Solves the parity game.
+         *
+         * \return The result consists of realizability and the set of agent
+         * winning states; no winning moves or transducer are built.
+         */
+        SynthesisResult run() const final;
+    };
+}
+
+#endif //LYDIASYFT_PARITYSOLVER_HPP
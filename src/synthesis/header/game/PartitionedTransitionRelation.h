@@ -0,0 +1,118 @@
+#ifndef PARTITIONED_TRANSITION_RELATION_H
+#define PARTITIONED_TRANSITION_RELATION_H
+
+#include "automata/SymbolicStateDfa.h"
+#include "cuddObj.hh"
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace Syft {
+
+/**
+ * \brief A transition relation kept as a conjunction of clusters, with early quantification.
+ *
+ * The relation R(s, x, y, s') = AND_i (s'_i <-> f_i(s, x, y)) of a symbolic DFA
+ * is never built as one BDD. The bit relations s'_i <-> f_i are conjoined into
+ * clusters of at most a given node count, and for each kind of relational
+ * product a quantification schedule orders the clusters so that every
+ * quantified variable is abstracted, by AndAbstract, right after the last
+ * cluster that mentions it (IWLS95-style greedy ordering).
+ */
+class PartitionedTransitionRelation {
+public:
+
+    /** \brief Default node count above which bit relations are not merged into one cluster. */
+    static constexpr std::size_t default_cluster_threshold = 2500;
+
+private:
+
+    /**
+     * \brief An order of the clusters and the variables abstracted after each.
+     */
+    struct Schedule {
+        std::vector<std::size_t> order;        ///< Cluster indices, in conjunction order
+        std::vector<CUDD::BDD> cubes;          ///< Variables abstracted after each cluster of order
+        CUDD::BDD leading_cube;                ///< Variables in no cluster, abstracted from the operand first
+    };
+
+    std::shared_ptr<VarMgr> var_mgr_;
+    std::size_t automaton_id_;
+    std::size_t primed_automaton_id_;
+
+    std::vector<CUDD::BDD> state_variables_;
+    std::vector<CUDD::BDD> primed_variables_;
+    std::vector<CUDD::BDD> clusters_;
+
+    Schedule image_schedule_;              ///< Abstracts s, x and y
+    Schedule preimage_schedule_;           ///< Abstracts s', x and y
+    Schedule move_preimage_schedule_;      ///< Abstracts s'
+    Schedule state_relation_schedule_;     ///< Abstracts x and y
+    // Schedules abstracting s' and a given cube, built on first use
+    mutable std::vector<std::pair<CUDD::BDD, Schedule>> cube_schedules_;
+
+    Schedule MakeSchedule(const std::vector<CUDD::BDD> &parts,
+                          const std::vector<bool> &quantified) const;
+
+    CUDD::BDD Apply(const CUDD::BDD &operand, const Schedule &schedule) const;
+
+    std::vector<bool> QuantifiedIndices(const std::vector<CUDD::BDD> &cubes) const;
+
+public:
+
+    /**
+     * \brief Partitions the transition relation of \a dfa.
+     *
+     * \param dfa The symbolic DFA whose transition function is partitioned.
+     * \param primed_automaton_id The ID of state variables used as the next-state
+     *   copy s'; must have as many variables as the state space of \a dfa.
+     * \param cluster_threshold Node count up to which bit relations are merged.
+     */
+    PartitionedTransitionRelation(const SymbolicStateDfa &dfa,
+                                  std::size_t primed_automaton_id,
+                                  std::size_t cluster_threshold = default_cluster_threshold);
+
+    /**
+     * \brief Returns the states reachable from \a states in one step, over s.
+     */
+    CUDD::BDD Image(const CUDD::BDD &states) const;
+
+    /**
+     * \brief Returns the states with a successor in \a states for some move, over s.
+     */
+    CUDD::BDD Preimage(const CUDD::BDD &states) const;
+
+    /**
+     * \brief Returns the pairs of state and move leading into \a states, over s, x and y.
+     *
+     * Equal to composing \a states with the transition function.
+     */
+    CUDD::BDD MovePreimage(const CUDD::BDD &states) const;
+
+    /**
+     * \brief Returns exists \a cube. MovePreimage(\a states), in one relational product.
+     *
+     * \a cube is abstracted together with s' as soon as the last cluster
+     * mentioning each of its variables has been conjoined.
+     */
+    CUDD::BDD MovePreimage(const CUDD::BDD &states, const CUDD::BDD &cube) const;
+
+    /**
+     * \brief Returns the state-to-state relation, exists x, y. R(s, x, y, s').
+     */
+    CUDD::BDD StateRelation() const;
+
+    /**
+     * \brief Returns the clusters whose conjunction is the transition relation.
+     */
+    const std::vector<CUDD::BDD> &clusters() const;
+
+    /**
+     * \brief Returns the ID of the primed state variables.
+     */
+    std::size_t primed_automaton_id() const;
+};
+
+} // namespace Syft
+
+#endif // PARTITIONED_TRANSITION_RELATION_H
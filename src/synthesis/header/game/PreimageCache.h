@@ -0,0 +1,108 @@
+#ifndef PREIMAGE_CACHE_H
+#define PREIMAGE_CACHE_H
+
+#include <cstddef>
+#include <list>
+#include <optional>
+#include <unordered_map>
+
+#include "Player.h"
+#include "cuddObj.hh"
+
+namespace Syft {
+
+/**
+ * \brief Counters of a PreimageCache since its creation or last clear.
+ */
+    struct PreimageCacheStats {
+        std::size_t lookups = 0;
+        std::size_t hits = 0;
+        std::size_t evictions = 0;
+        /** \brief The entries currently cached. */
+        std::size_t entries = 0;
+        /** \brief The BDD nodes of the targets and preimages currently cached. */
+        std::size_t nodes = 0;
+
+        double hit_rate() const {
+            return lookups > 0 ? static_cast<double>(hits) / static_cast<double>(lookups) : 0.0;
+        }
+    };
+
+/**
+ * \brief The preimages of one game arena by target, shared by the solvers of its subgames.
+ *
+ * The subgames of a Manna-Pnueli DAG and the nodes of their Zielonka trees
+ * ask for the preimages of the same targets over and over, and such large
+ * compositions rarely survive in the computed table of CUDD. Entries are
+ * keyed by the node of the target, which the entry references so that it is
+ * not reused, and the least recently used entries are dropped once they hold
+ * more than a given number of BDD nodes.
+ *
+ * A preimage depends on the transition function and on the order of play, so
+ * the cache is bound to the first game it is attached to (see attach). Like
+ * the manager whose BDDs it holds, it is not thread-safe.
+ */
+    class PreimageCache {
+    public:
+        /**
+         * \brief Default bound on the BDD nodes held by the cache.
+         */
+        static constexpr std::size_t default_max_nodes = std::size_t(1) << 22;
+
+        /**
+         * \brief Constructs an empty cache holding at most \a max_nodes BDD nodes.
+         */
+        explicit PreimageCache(std::size_t max_nodes = default_max_nodes);
+
+        /**
+         * \brief Binds the cache to the game on automaton \a automaton_id with the given order of play.
+         *
+         * \throws std::runtime_error if the cache is already bound to another game.
+         */
+        void attach(std::size_t automaton_id, Player starting_player, Player protagonist_player);
+
+        /**
+         * \brief Returns the cached preimage of \a target, if any, and marks it as most recently used.
+         */
+        std::optional<CUDD::BDD> find(const CUDD::BDD &target);
+
+        /**
+         * \brief Caches \a preimage as the preimage of \a target, evicting the least recently used entries if needed.
+         *
+         * An entry larger than the whole bound is not cached.
+         */
+        void insert(const CUDD::BDD &target, const CUDD::BDD &preimage);
+
+        /**
+         * \brief Drops all entries and resets the counters; the cache stays bound to its game.
+         */
+        void clear();
+
+        std::size_t max_nodes() const;
+
+        const PreimageCacheStats &stats() const;
+
+    private:
+        struct Entry {
+            CUDD::BDD target;
+            CUDD::BDD preimage;
+            std::size_t nodes;
+        };
+
+        std::size_t max_nodes_;
+        // Most recently used first
+        std::list<Entry> entries_;
+        std::unordered_map<DdNode *, std::list<Entry>::iterator> index_;
+        PreimageCacheStats stats_;
+
+        struct Game {
+            std::size_t automaton_id;
+            Player starting_player;
+            Player protagonist_player;
+        };
+        std::optional<Game> game_;
+    };
+
+}
+
+#endif // PREIMAGE_CACHE_H
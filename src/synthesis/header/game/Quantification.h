@@ -2,6 +2,9 @@
 #define QUANTIFICATION_H
 
 #include <cuddObj.hh>
+#include <memory>
+
+#include "BddBackend.h"
 
 namespace Syft {
 
@@ -12,6 +15,15 @@ class Quantification {
  public:
   virtual ~Quantification() {}
   virtual CUDD::BDD apply(const CUDD::BDD& bdd) const = 0;
+  /**
+   * \brief Returns the same as apply(bdd), computed by \a backend.
+   */
+  virtual CUDD::BDD apply(const CUDD::BDD& bdd, const BddBackend& backend) const = 0;
+  /**
+   * \brief Returns the same quantification on the variables of \a mgr,
+   *   which must have at least the variables quantified here.
+   */
+  virtual std::unique_ptr<Quantification> transfer(CUDD::Cudd& mgr) const = 0;
 };
 
 /**
@@ -20,6 +32,8 @@ class Quantification {
 class NoQuantification final : public Quantification {
  public:
   CUDD::BDD apply(const CUDD::BDD& bdd) const override;
+  CUDD::BDD apply(const CUDD::BDD& bdd, const BddBackend& backend) const override;
+  std::unique_ptr<Quantification> transfer(CUDD::Cudd& mgr) const override;
 };
 
 /**
@@ -32,7 +46,11 @@ class Forall final : public Quantification {
  public:
   Forall(CUDD::BDD universal_variables);
 
+  const CUDD::BDD& variables() const { return universal_variables_; }
+
   CUDD::BDD apply(const CUDD::BDD& bdd) const override;
+  CUDD::BDD apply(const CUDD::BDD& bdd, const BddBackend& backend) const override;
+  std::unique_ptr<Quantification> transfer(CUDD::Cudd& mgr) const override;
 };
 
 /**
@@ -45,7 +63,11 @@ class Exists final : public Quantification {
  public:
   Exists(CUDD::BDD existential_variables);
 
+  const CUDD::BDD& variables() const { return existential_variables_; }
+
   CUDD::BDD apply(const CUDD::BDD& bdd) const override;
+  CUDD::BDD apply(const CUDD::BDD& bdd, const BddBackend& backend) const override;
+  std::unique_ptr<Quantification> transfer(CUDD::Cudd& mgr) const override;
 };
 
 /**
@@ -61,6 +83,8 @@ class ForallExists final : public Quantification {
 	       CUDD::BDD existential_variables);
 
   CUDD::BDD apply(const CUDD::BDD& bdd) const override;
+  CUDD::BDD apply(const CUDD::BDD& bdd, const BddBackend& backend) const override;
+  std::unique_ptr<Quantification> transfer(CUDD::Cudd& mgr) const override;
 };
 
 /**
@@ -76,6 +100,8 @@ class ForallExists final : public Quantification {
                     CUDD::BDD universal_variables);
 
         CUDD::BDD apply(const CUDD::BDD& bdd) const override;
+        CUDD::BDD apply(const CUDD::BDD& bdd, const BddBackend& backend) const override;
+        std::unique_ptr<Quantification> transfer(CUDD::Cudd& mgr) const override;
     };
 
 
@@ -23,6 +23,10 @@ namespace Syft {
          * \brief The state space to consider.
          */
         CUDD::BDD state_space_;
+        /**
+         * \brief The number of steps within which the goal must be reached, or 0 for no bound.
+         */
+        std::size_t horizon_ = 0;
 
     public:
 
@@ -38,6 +42,24 @@ namespace Syft {
         Reachability(const SymbolicStateDfa &spec, Player starting_player, Player protagonist_player,
                      const CUDD::BDD &goal_states, const CUDD::BDD &state_space);
 
+        /**
+         * \brief Construct a single-strategy-synthesizer for a reachability game on an unmaterialized product.
+         *
+         * Same as above, with preimages computed compositionally on \a arena.
+         */
+        Reachability(const ProductArena &arena, Player starting_player, Player protagonist_player,
+                     const CUDD::BDD &goal_states, const CUDD::BDD &state_space);
+
+        /**
+         * \brief Bounds the game to reaching the goal within \a steps steps, 0 meaning no bound.
+         *
+         * A bounded run stops after \a steps iterations of the attractor. Its
+         * winning states are then those from which the goal is forced within
+         * the bound, and an unrealizable verdict only means the goal cannot be
+         * forced that fast.
+         */
+        void set_horizon(std::size_t steps);
+
 
         /**
          * \brief Solves the reachability game.
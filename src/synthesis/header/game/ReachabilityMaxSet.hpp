@@ -25,6 +25,13 @@ namespace Syft {
          */
         CUDD::BDD state_space_;
 
+        /**
+         * \brief Solves the reachability game, collecting the winning moves only if \a collect_moves.
+         *
+         * Appends the winning states of each iteration to \a winning_sets, the first being the goal states.
+         */
+        SynthesisResult solve(bool collect_moves, std::vector<CUDD::BDD> &winning_sets) const;
+
     public:
 
         /**
@@ -43,6 +50,12 @@ namespace Syft {
         /**
          * \brief Solves the maxset-reachability game.
          *
+         * Only the layers of the winning region are computed: the goal states, then
+         * the states each iteration adds. The strategies are derived from them on
+         * demand, through this synthesizer, which must outlive their first call.
+         * The non-deferring strategy takes one preimage per layer, and the deferring
+         * strategy one preimage of the whole winning region.
+         *
          * \return The result consists of
          * realizability
          * the non-deferring strategy
@@ -60,7 +73,10 @@ namespace Syft {
          */
         SynthesisResult run() const final;
 
-        void dump_dot(MaxSetSynthesisResult maxset, const std::string &def_filename,
+        /**
+         * \brief Dumps the strategies of \a maxset, skipping a strategy whose file name is empty.
+         */
+        void dump_dot(const MaxSetSynthesisResult &maxset, const std::string &def_filename,
                       const std::string &nondef_filename) const;
 
     };
@@ -2,10 +2,41 @@
 #define SCC_DECOMPOSER_H
 
 #include "automata/SymbolicStateDfa.h"
+#include "game/ArenaImageContext.h"
 #include "cuddObj.hh"
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
 
 namespace Syft {
 
+/**
+ * \brief The available SCC decomposition algorithms.
+ */
+enum class SCCAlgorithm {
+    Naive,    ///< NaiveSCCDecomposer
+    Chain,    ///< ChainSCCDecomposer
+    Skeleton  ///< SkeletonSCCDecomposer
+};
+
+/**
+ * \brief How ChainSCCDecomposer picks the pivots of its forward searches.
+ */
+enum class ChainPivot {
+    Arbitrary,    ///< Any state of the subgraph
+    LastLayer,    ///< A state of the last BFS level of the enclosing forward search (the chain heuristic)
+    MinInDegree   ///< A chain candidate with no predecessor in the subgraph, or none outside the candidates
+};
+
+/**
+ * \brief Pivot selection of ChainSCCDecomposer.
+ */
+struct ChainOptions {
+    ChainPivot pivot = ChainPivot::LastLayer;
+    std::size_t pivots_per_round = 1;  ///< Forward searches started from each subgraph before it is split
+};
+
 /**
  * \brief Abstract interface for SCC (Strongly Connected Component) decomposition algorithms.
  * 
@@ -13,6 +44,12 @@ namespace Syft {
  * that can be tested independently before being used in synthesis.
  */
 class SCCDecomposer {
+protected:
+    ArenaImageContext context_;  ///< Image operators of the arena, shared by all PeelLayer calls
+
+    explicit SCCDecomposer(const SymbolicStateDfa& arena)
+        : context_(arena) {}
+
 public:
     virtual ~SCCDecomposer() = default;
 
@@ -26,6 +63,39 @@ public:
      * \return A BDD representing the top layer (terminal SCCs) of the given states.
      */
     virtual CUDD::BDD PeelLayer(const CUDD::BDD& states) const = 0;
+
+    /**
+     * \brief Peels all layers of the given state set, from the top one down.
+     *
+     * The layers are over state variables only. Peeling stops early if
+     * PeelLayer returns an empty layer, leaving the remaining states out.
+     * By default PeelLayer is called once per layer.
+     *
+     * \param states The set of states to decompose.
+     * \return The layers, top (source SCCs) first.
+     */
+    virtual std::vector<CUDD::BDD> PeelLayers(const CUDD::BDD& states) const;
+
+    /**
+     * \brief Returns the image and preimage steps taken so far on the arena.
+     *
+     * Only the steps of the shared image context are counted, so the
+     * relational products of NaiveSCCDecomposer are not.
+     */
+    std::size_t SymbolicSteps() const { return context_.step_count(); }
+
+    /**
+     * \brief Creates a decomposer of \a arena using \a algorithm.
+     *
+     * \param chain The pivot selection, if \a algorithm is Chain.
+     */
+    static std::unique_ptr<SCCDecomposer> Create(SCCAlgorithm algorithm, const SymbolicStateDfa& arena,
+                                                 const ChainOptions& chain = ChainOptions());
+
+    /**
+     * \brief Parses an algorithm name: naive, chain or skeleton.
+     */
+    static SCCAlgorithm AlgorithmFromString(const std::string& name);
 };
 
 /**
@@ -33,30 +103,78 @@ public:
  * 
  * Implements the chain algorithm for computing SCC layers symbolically.
  * This algorithm is particularly efficient for weak games (obligation fragment).
+ *
+ * Each round picks a pivot, computes its forward set and the SCC of the pivot
+ * inside it, then splits the subgraph into the rest of the forward set and
+ * the states outside it. The pivot of the forward part is taken from the last
+ * BFS level of the search and the one of the outer part from the
+ * predecessors of the SCC, as selected by ChainOptions. The SCCs are computed
+ * once and reused while PeelLayer is called with unions of them.
  */
 class ChainSCCDecomposer : public SCCDecomposer {
 private:
-    const SymbolicStateDfa& arena_;
+    ChainOptions options_;
+
+    // SCCs of the last decomposed state set, with the states outside each one that enter it
+    mutable CUDD::BDD decomposed_states_;
+    mutable std::vector<CUDD::BDD> components_;
+    mutable std::vector<CUDD::BDD> component_entries_;
+    mutable bool has_decomposition_ = false;
+
+    /**
+     * \brief Picks a pivot in \a vertices, preferring the chain candidates \a pivots.
+     */
+    CUDD::BDD ChoosePivot(const CUDD::BDD& vertices, const CUDD::BDD& pivots) const;
+
+    /**
+     * \brief Computes and caches the SCCs of the subgraph induced by \a states.
+     */
+    void Decompose(const CUDD::BDD& states) const;
+
+    /**
+     * \brief Returns the indices of the cached components inside \a states, decomposing it if needed.
+     */
+    std::vector<std::size_t> LiveComponents(const CUDD::BDD& states) const;
+
+    /**
+     * \brief Returns the components in \a live that no other component inside \a states enters.
+     */
+    CUDD::BDD TopLayer(const CUDD::BDD& states, const std::vector<std::size_t>& live) const;
 
 public:
     /**
      * \brief Constructs a ChainSCCDecomposer from a symbolic state DFA.
      * 
      * \param arena The symbolic state DFA representing the game arena.
+     * \param options How the pivots are picked.
      */
-    explicit ChainSCCDecomposer(const SymbolicStateDfa& arena)
-        : arena_(arena) {}
+    explicit ChainSCCDecomposer(const SymbolicStateDfa& arena, ChainOptions options = ChainOptions())
+        : SCCDecomposer(arena), options_(options) {}
 
     /**
-     * \brief Peels off one layer of SCCs using the chain algorithm.
-     * 
-     * The chain algorithm identifies terminal SCCs by finding states s such that
-     * for all states s' reachable from s, there is a path from s' back to s.
+     * \brief Peels off the SCCs of \a states that no other SCC of \a states reaches.
      * 
      * \param states The set of states to peel a layer from.
-     * \return A BDD representing the top layer (terminal SCCs).
+     * \return A BDD representing the top layer.
      */
     CUDD::BDD PeelLayer(const CUDD::BDD& states) const override;
+
+    /**
+     * \brief Peels all layers of \a states with one decomposition.
+     */
+    std::vector<CUDD::BDD> PeelLayers(const CUDD::BDD& states) const override;
+
+    /**
+     * \brief Returns the SCCs of the subgraph induced by \a states.
+     *
+     * This is exposed for testing purposes.
+     */
+    std::vector<CUDD::BDD> Components(const CUDD::BDD& states) const;
+
+    /**
+     * \brief Parses a pivot strategy name: arbitrary, last-layer or min-in-degree.
+     */
+    static ChainPivot PivotFromString(const std::string& name);
 };
 
 /**
@@ -84,6 +202,10 @@ struct PathRelationResult {
 };
 
 class NaiveSCCDecomposer : public SCCDecomposer {
+public:
+    /** \brief Default node count above which the path relation is not cached. */
+    static constexpr std::size_t default_closure_node_limit = 1000000;
+
 private:
     const SymbolicStateDfa& arena_;
 
@@ -92,21 +214,33 @@ private:
     mutable std::size_t primed_automaton_id_;
     mutable std::size_t temp_automaton_id_;
     mutable bool initialized_ = false;
-    // Cached full path (transitive closure) relation over (s,s') for the whole arena
+    // Cached path (transitive closure) relation over (s,s') within the first state set
     mutable CUDD::BDD cached_path_relation_;
+    mutable CUDD::BDD cached_path_domain_;
     mutable bool has_cached_path_relation_ = false;
+    // Set once the cached closure exceeded closure_node_limit_
+    mutable bool closure_cache_disabled_ = false;
+    std::size_t closure_node_limit_ = default_closure_node_limit;
 
     /**
-     * \brief Builds the one-step transition relation.
+     * \brief Builds the one-step transition relation over the primed variables of the context.
      */
-    CUDD::BDD BuildTransitionRelation(std::size_t primed_automaton_id) const;
+    CUDD::BDD BuildTransitionRelation() const;
 
     /**
-     * \brief Computes the transitive closure of a relation.
+     * \brief Computes the transitive closure of a relation within a state set, by iterative squaring.
+     *
+     * The relation is restricted to \a states x \a states' before and after
+     * each squaring, so only paths through \a states are built.
+     *
+     * \param relation The one-step relation over (s, s').
+     * \param states The states the paths may visit.
+     * \param node_limit Node count beyond which the closure is abandoned (0 = unlimited).
+     * \return The closure, or std::nullopt if it exceeded \a node_limit.
      */
-    CUDD::BDD TransitiveClosure(const CUDD::BDD& relation, 
-                                std::size_t primed_automaton_id,
-                                std::size_t temp_automaton_id) const;
+    std::optional<CUDD::BDD> TransitiveClosure(const CUDD::BDD& relation,
+                                               const CUDD::BDD& states,
+                                               std::size_t node_limit) const;
 
     /**
      * \brief Composes two relations R1(s,s') and R2(s,s').
@@ -149,7 +283,7 @@ public:
      * \param arena The symbolic state DFA representing the game arena.
      */
     explicit NaiveSCCDecomposer(const SymbolicStateDfa& arena)
-        : arena_(arena) {}
+        : SCCDecomposer(arena), arena_(arena) {}
 
     /**
      * \brief Peels off one layer of SCCs using the naive backward-forward algorithm.
@@ -162,6 +296,16 @@ public:
      */
     CUDD::BDD PeelLayer(const CUDD::BDD& states) const override;
 
+    /**
+     * \brief Sets the node count above which the path relation is not cached.
+     *
+     * The path relation is computed once, within the first state set, and
+     * reused for its subsets. If it grows beyond \a node_limit, it is instead
+     * recomputed within the states of every PeelLayer call, which peeled
+     * layers no longer inflate.
+     */
+    void SetClosureNodeLimit(std::size_t node_limit);
+
     /**
      * \brief Builds the one-step transition relation and returns it with primed variable info.
      * 
@@ -182,6 +326,93 @@ public:
     PathRelationResult BuildPathRelationWithPrimed(const CUDD::BDD& states) const;
 };
 
+/**
+ * \brief Skeleton-based SCC decomposition (Gentilini, Piazza and Policriti, 2003).
+ *
+ * Each forward search from a node also returns a skeleton: a path from the
+ * node to a node of its last BFS level. The next search in the forward set is
+ * started from the end of that path, and the one in the rest of the graph from
+ * the last node of the path outside the SCC found, so that the whole
+ * decomposition takes a linear number of image and preimage steps.
+ *
+ * The SCCs are computed once and reused while PeelLayer is called with unions
+ * of them, as in the layer loop of WeakGameSolver. A layer is then obtained
+ * by one forward search from the states entered from another SCC, which
+ * peels all source SCCs of the layer at once; PeelLayers also drops the
+ * peeled SCCs from later passes.
+ */
+class SkeletonSCCDecomposer : public SCCDecomposer {
+private:
+    /**
+     * \brief Result of a forward search.
+     */
+    struct ForwardResult {
+        CUDD::BDD forward_set;  ///< States reachable from the node
+        CUDD::BDD skeleton;     ///< A path from the node to a state of the last BFS level
+        CUDD::BDD end_node;     ///< The last state of the skeleton
+    };
+
+    // SCCs of the last decomposed state set, with the states each one enters outside itself
+    mutable CUDD::BDD decomposed_states_;
+    mutable std::vector<CUDD::BDD> components_;
+    mutable std::vector<CUDD::BDD> component_exits_;
+    mutable bool has_decomposition_ = false;
+
+    /**
+     * \brief Computes the states of \a vertices reachable from \a node, with a skeleton.
+     */
+    ForwardResult Forward(const CUDD::BDD& vertices, const CUDD::BDD& node) const;
+
+    /**
+     * \brief Whether \a states is a union of the cached SCCs.
+     */
+    bool IsUnionOfComponents(const CUDD::BDD& states) const;
+
+    /**
+     * \brief Computes and caches the SCCs of the subgraph induced by \a states.
+     */
+    void Decompose(const CUDD::BDD& states) const;
+
+    /**
+     * \brief Returns the top layer of \a states, a union of the components in \a live.
+     */
+    CUDD::BDD TopLayer(const CUDD::BDD& states, const std::vector<std::size_t>& live) const;
+
+    /**
+     * \brief Returns the indices of the cached components inside \a states.
+     */
+    std::vector<std::size_t> LiveComponents(const CUDD::BDD& states) const;
+
+public:
+    /**
+     * \brief Constructs a SkeletonSCCDecomposer from a symbolic state DFA.
+     *
+     * \param arena The symbolic state DFA representing the game arena.
+     */
+    explicit SkeletonSCCDecomposer(const SymbolicStateDfa& arena)
+        : SCCDecomposer(arena) {}
+
+    /**
+     * \brief Peels off the SCCs of \a states that no other SCC of \a states reaches.
+     *
+     * \param states The set of states to peel a layer from.
+     * \return A BDD representing the top layer.
+     */
+    CUDD::BDD PeelLayer(const CUDD::BDD& states) const override;
+
+    /**
+     * \brief Peels all layers of \a states with one decomposition.
+     */
+    std::vector<CUDD::BDD> PeelLayers(const CUDD::BDD& states) const override;
+
+    /**
+     * \brief Returns the SCCs of the subgraph induced by \a states.
+     *
+     * This is exposed for testing purposes.
+     */
+    std::vector<CUDD::BDD> Components(const CUDD::BDD& states) const;
+};
+
 } // namespace Syft
 
 #endif // SCC_DECOMPOSER_H
@@ -0,0 +1,64 @@
+#ifndef LYDIASYFT_SAFETY_HPP
+#define LYDIASYFT_SAFETY_HPP
+
+#include "game/DfaGameSynthesizer.h"
+
+namespace Syft {
+/**
+ * \brief A single-strategy-synthesizer for a safety game given as a symbolic-state DFA.
+ *
+ * The protagonist wins if every state after the initial one is safe, so the
+ * initial state itself need not be safe, as in the DFAs of LTLf formulas.
+ */
+    class Safety : public DfaGameSynthesizer {
+    private:
+        /**
+         * \brief The set of safe states.
+         */
+        CUDD::BDD safe_states_;
+        /**
+         * \brief The state space to consider.
+         */
+        CUDD::BDD state_space_;
+
+    public:
+
+        /**
+         * \brief Construct a single-strategy-synthesizer for the given safety game.
+         *
+         * \param spec A symbolic-state DFA representing the safety game arena.
+         * \param starting_player The player that moves first each turn.
+         * \param protagonist_player The player for which we aim to find the winning strategy.
+         * \param safe_states The safety condition.
+         * \param state_space The state space.
+         */
+        Safety(const SymbolicStateDfa &spec, Player starting_player, Player protagonist_player,
+               const CUDD::BDD &safe_states, const CUDD::BDD &state_space);
+
+        /**
+         * \brief Construct a single-strategy-synthesizer for a safety game on an unmaterialized product.
+         *
+         * Same as above, with preimages computed compositionally on \a arena.
+         */
+        Safety(const ProductArena &arena, Player starting_player, Player protagonist_player,
+               const CUDD::BDD &safe_states, const CUDD::BDD &state_space);
+
+        /**
+         * \brief Solves the safety game.
+         *
+         * Computes the safe states the protagonist can stay in, νX. safe ∩ CPre(X),
+         * pruning in Frontier mode only the predecessors of the states removed by
+         * the previous iteration, and then the states that move into them.
+         *
+         * \return The result consists of
+         * realizability
+         * a set of agent winning states
+         * a transducer representing a winning strategy or nullptr if the game is unrealizable.
+         */
+        SynthesisResult run() const final;
+
+    };
+}
+
+
+#endif //LYDIASYFT_SAFETY_HPP
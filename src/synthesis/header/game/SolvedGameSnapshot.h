@@ -0,0 +1,113 @@
+#ifndef SOLVED_GAME_SNAPSHOT_H
+#define SOLVED_GAME_SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Synthesizer.h"
+#include "automata/SymbolicStateDfa.h"
+#include "game/BddCircuit.h"
+
+namespace Syft {
+
+/**
+ * \brief A read-only copy of a solved game, queried without CUDD.
+ *
+ * The winning states, the winning moves and the output functions of the
+ * strategy are compiled once into a BddCircuit and only its node array is
+ * kept, so a snapshot holds no BDD and outlives the variable manager of the
+ * game. Its slots are the state bits of the arena, then those of the
+ * transducer that are not state bits of the arena, e.g. the memory of a
+ * strategy, then the inputs and the outputs. A query walks the node array on
+ * a valuation of the slots owned by the caller, so any number of threads can
+ * query one snapshot at once, without locks, while the variable manager is
+ * used elsewhere.
+ */
+class SolvedGameSnapshot {
+ public:
+
+  /**
+   * \brief Compiles the result of solving \a arena.
+   *
+   * The winning moves and the transducer are optional, as a null BDD and a
+   * null pointer. Throws std::runtime_error if the result has no winning
+   * states, if a function depends on other variables than the slots, or if
+   * the strategy reads a variable it sets.
+   */
+  SolvedGameSnapshot(const SymbolicStateDfa& arena, const SynthesisResult& result);
+
+  bool realizability() const {return realizability_;}
+  bool has_winning_moves() const {return has_winning_moves_;}
+  bool has_strategy() const {return !strategy_.empty();}
+
+  std::size_t state_bit_count() const {return state_count_;}
+  std::size_t input_count() const {return input_count_;}
+  std::size_t output_count() const {return output_count_;}
+  std::size_t slot_count() const {return state_count_ + input_count_ + output_count_;}
+
+  /**
+   * \brief Returns the index in the variable manager of the variable of each slot.
+   */
+  const std::vector<int>& variable_indices() const {return variable_indices_;}
+
+  const std::vector<std::string>& input_labels() const {return input_labels_;}
+  const std::vector<std::string>& output_labels() const {return output_labels_;}
+
+  /**
+   * \brief Returns the first slot of the inputs, after the state bits.
+   */
+  std::size_t first_input_slot() const {return state_count_;}
+
+  /**
+   * \brief Returns the first slot of the outputs, after the inputs.
+   */
+  std::size_t first_output_slot() const {return state_count_ + input_count_;}
+
+  /**
+   * \brief Whether the state of \a values, one value (0 or 1) per slot, is winning.
+   */
+  bool is_winning(const std::uint8_t* values) const {
+    return BddCircuit::evaluate(nodes_.data(), winning_root_, values) == BddCircuit::true_node;
+  }
+
+  /**
+   * \brief Whether the inputs and outputs of \a values are a winning move from its state.
+   *
+   * Throws std::runtime_error if the snapshot has no winning moves.
+   */
+  bool is_winning_move(const std::uint8_t* values) const;
+
+  /**
+   * \brief Writes the move the strategy picks in the state of \a values into the slots of the variables it sets.
+   *
+   * The strategy sets the outputs of an agent protagonist and the inputs of
+   * an environment one, from the other variables of \a values. Throws
+   * std::runtime_error if the snapshot has no strategy.
+   */
+  void strategy_move(std::uint8_t* values) const;
+
+ private:
+
+  bool realizability_ = false;
+  bool has_winning_moves_ = false;
+  std::size_t state_count_ = 0;
+  std::size_t input_count_ = 0;
+  std::size_t output_count_ = 0;
+  std::vector<int> variable_indices_;
+  std::vector<std::string> input_labels_;
+  std::vector<std::string> output_labels_;
+
+  // Never changed once built
+  std::vector<BddCircuit::Node> nodes_;
+  std::uint32_t winning_root_ = BddCircuit::false_node;
+  std::uint32_t winning_moves_root_ = BddCircuit::false_node;
+  // The slot and root of each output function of the strategy
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> strategy_;
+};
+
+}
+
+#endif // SOLVED_GAME_SNAPSHOT_H
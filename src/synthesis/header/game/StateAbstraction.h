@@ -0,0 +1,56 @@
+#ifndef STATE_ABSTRACTION_H
+#define STATE_ABSTRACTION_H
+
+#include "BddBackend.h"
+#include "cuddObj.hh"
+
+namespace Syft {
+
+/**
+ * \brief The player that picks the next values of the hidden state bits of a StateAbstraction.
+ */
+    enum class HiddenChooser {
+        /** \brief An over-approximation of the game for the protagonist. */
+        Protagonist,
+        /** \brief An under-approximation of the game for the protagonist. */
+        Opponent
+    };
+
+/**
+ * \brief A game whose hidden state bits take any next value, picked by one player.
+ *
+ * The hidden bits are no longer updated by their transition functions: after
+ * every move of both players, the chooser picks their next values. The
+ * preimage of a target is then the concrete preimage of the target with its
+ * hidden bits quantified, universally if the opponent picks them and
+ * existentially if the protagonist does. Since the chooser may always pick the
+ * concrete next values, every state the protagonist wins when the opponent
+ * chooses is won in the concrete game, and every state it loses when it
+ * chooses itself is lost. The current values of the hidden bits are kept, so
+ * the winning condition reads them as before.
+ */
+    struct StateAbstraction {
+        /** \brief The cube of the hidden state variables. */
+        CUDD::BDD hidden_cube;
+        HiddenChooser chooser = HiddenChooser::Opponent;
+
+        /**
+         * \brief Returns the states whose hidden bits the chooser can set to land in \a states.
+         */
+        CUDD::BDD target(const CUDD::BDD &states, const BddBackend &backend) const {
+            return chooser == HiddenChooser::Opponent
+                   ? backend.UnivAbstract(states, hidden_cube)
+                   : backend.ExistAbstract(states, hidden_cube);
+        }
+
+        /**
+         * \brief Returns the states with some values of the hidden bits in \a states.
+         */
+        CUDD::BDD some_successor(const CUDD::BDD &states, const BddBackend &backend) const {
+            return backend.ExistAbstract(states, hidden_cube);
+        }
+    };
+
+}
+
+#endif // STATE_ABSTRACTION_H
@@ -0,0 +1,94 @@
+#ifndef STRATEGY_MINIMIZER_H
+#define STRATEGY_MINIMIZER_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cuddObj.hh"
+#include "VarMgr.h"
+
+namespace Syft {
+
+/**
+ * \brief How the output functions of a strategy are simplified on their care set.
+ */
+enum class StrategyMinimization {
+  Off,
+  /** \brief CUDD::BDD::Restrict, the cheaper of the two. */
+  Restrict,
+  /** \brief CUDD::BDD::LICompaction, often smaller. */
+  LICompaction
+};
+
+/**
+ * \brief Parses off, restrict or licompaction; throws std::runtime_error otherwise.
+ */
+StrategyMinimization strategy_minimization_from_string(const std::string& name);
+
+/**
+ * \brief Returns \a function simplified with \a method where \a care does not hold.
+ *
+ * The result agrees with \a function on \a care. Returns \a function itself
+ * if \a method is Off or \a care is empty.
+ */
+CUDD::BDD care_simplified(const CUDD::BDD& function, const CUDD::BDD& care, StrategyMinimization method);
+
+/**
+ * \brief Returns the number of nodes of \a functions, counting the shared ones once.
+ */
+std::size_t shared_node_count(const std::vector<CUDD::BDD>& functions);
+
+struct StrategyMinimizationOptions {
+  StrategyMinimization method = StrategyMinimization::Off;
+  /**
+   * \brief Whether each output is first simplified where both of its values are winning.
+   */
+  bool per_output = false;
+};
+
+/**
+ * \brief The shared BDD sizes of the output functions before and after minimize_strategy.
+ */
+struct StrategyMinimizationReport {
+  std::size_t nodes_before = 0;
+  std::size_t nodes_after = 0;
+  std::size_t reachable_iterations = 0;
+};
+
+/**
+ * \brief Returns the states reachable from \a initial_state, over \a state_variables, under \a transition_function.
+ *
+ * \a transition_function gives the next value of each state variable, and may
+ * depend on variables other than the state, which are quantified. Images are
+ * computed as the range of the constrained transition function, without
+ * next-state variables.
+ */
+CUDD::BDD reachable_states(const std::shared_ptr<VarMgr>& var_mgr, const CUDD::BDD& initial_state,
+                           const std::vector<CUDD::BDD>& transition_function,
+                           const std::vector<CUDD::BDD>& state_variables, std::size_t* iterations = nullptr);
+
+/**
+ * \brief Simplifies the output functions of a strategy where its behaviour does not matter.
+ *
+ * With options.per_output, each output in turn, the others fixed, is freed
+ * wherever both of its values give a winning move of \a winning_moves, or no
+ * value does. Then every output function is simplified outside the states
+ * reachable under the strategy from \a initial_state, on which the
+ * strategy is therefore unchanged.
+ *
+ * \param output_function The output functions, by output variable index, over the state and input variables.
+ * \param transition_function The next value of each of \a state_variables, over the state, input and output variables.
+ */
+StrategyMinimizationReport minimize_strategy(const std::shared_ptr<VarMgr>& var_mgr,
+                                             std::unordered_map<int, CUDD::BDD>& output_function,
+                                             const CUDD::BDD& winning_moves, const CUDD::BDD& initial_state,
+                                             const std::vector<CUDD::BDD>& transition_function,
+                                             const std::vector<CUDD::BDD>& state_variables,
+                                             const StrategyMinimizationOptions& options);
+
+}
+
+#endif // STRATEGY_MINIMIZER_H
@@ -0,0 +1,88 @@
+#ifndef LYDIASYFT_SYMBOLICEMERSONLEI_H
+#define LYDIASYFT_SYMBOLICEMERSONLEI_H
+
+#include "game/ColorFormula.h"
+#include "game/DfaGameSynthesizer.h"
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace Syft {
+/**
+ * \brief A synthesizer for an Emerson-Lei game that never builds the Zielonka tree of its condition.
+ *
+ * The game is solved by the recursive algorithm of McNaughton and Zielonka
+ * for Muller games, on the colors that each subgame actually contains: the
+ * condition is a BDD over one auxiliary variable per color, from which the
+ * color sets a subgame recurses on (the maximal subsets of its colors won by
+ * the other player) are computed when the subgame is reached. EmersonLei
+ * solves a fixpoint per node of the whole Zielonka tree, whose size may be
+ * exponential in the number of colors even when the arena only reaches a
+ * few of its color sets; the subgames here shrink with the colors they lose.
+ *
+ * Subgames are traps, solved on the arena of the whole game with the
+ * preimages of DfaGameSynthesizer: a player attracting to a target may also
+ * count the states that its own attractors removed, which its opponent is
+ * not allowed to enter.
+ */
+    class SymbolicEmersonLei : public DfaGameSynthesizer {
+    private:
+        ColorFormula color_formula_;
+        std::vector<CUDD::BDD> colors_;
+        CUDD::BDD state_space_;
+        // The condition, over variable i for color i; the manager is only written by the computation of subsets
+        mutable CUDD::Cudd color_mgr_;
+        CUDD::BDD condition_;
+        mutable std::size_t subgames_ = 0;
+        mutable std::size_t depth_ = 0;
+
+        // The states removed by the attractors of the protagonist (0) and of its opponent (1)
+        using Escapes = std::array<CUDD::BDD, 2>;
+
+        // The states of subgame from which player (0 for the protagonist) forces target in one step
+        CUDD::BDD cpre(std::size_t player, const CUDD::BDD &target, const CUDD::BDD &subgame,
+                       const Escapes &escapes) const;
+        CUDD::BDD attractor(std::size_t player, const CUDD::BDD &target, const CUDD::BDD &subgame,
+                            const Escapes &escapes) const;
+        // The protagonist winning states of subgame
+        CUDD::BDD solve(const CUDD::BDD &subgame, Escapes escapes, std::size_t depth) const;
+
+    public:
+
+        /**
+         * \brief Construct a synthesizer for the given Emerson-Lei game.
+         *
+         * Unlike EmersonLei, there are no instantly winning or losing states.
+         *
+         * \param spec A symbolic-state DFA representing the game arena.
+         * \param color_formula The Emerson-Lei condition over the colors.
+         * \param starting_player The player that moves first each turn.
+         * \param protagonist_player The player for which we aim to find the winning strategy.
+         * \param colorBDDs The states of each color.
+         * \param state_space The state space.
+         */
+        SymbolicEmersonLei(const SymbolicStateDfa &spec, ColorFormula color_formula, Player starting_player,
+                           Player protagonist_player, const std::vector<CUDD::BDD> &colorBDDs,
+                           const CUDD::BDD &state_space);
+
+        /**
+         * \brief Construct a synthesizer for an Emerson-Lei game on an unmaterialized product.
+         *
+         * Same as above, with preimages computed compositionally on \a arena.
+         */
+        SymbolicEmersonLei(const ProductArena &arena, ColorFormula color_formula, Player starting_player,
+                           Player protagonist_player, const std::vector<CUDD::BDD> &colorBDDs,
+                           const CUDD::BDD &state_space);
+
+        /**
+         * \brief Solves the Emerson-Lei game.
+         *
+         * \return The result consists of realizability and the set of protagonist
+         * winning states; no winning moves or transducer are built.
+         */
+        SynthesisResult run() const final;
+    };
+}
+
+#endif //LYDIASYFT_SYMBOLICEMERSONLEI_H
@@ -0,0 +1,88 @@
+#ifndef TRACE_SIMULATOR_H
+#define TRACE_SIMULATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "automata/SymbolicStateDfa.h"
+#include "game/BddCircuit.h"
+#include "game/CompiledTransducer.h"
+#include "game/Transducer.h"
+
+namespace Syft {
+
+/**
+ * \brief The outcome of simulating a strategy, see TraceSimulator.
+ */
+struct SimulationReport {
+  std::size_t traces = 0;
+  /** \brief The steps simulated, summed over the traces. */
+  std::size_t steps = 0;
+  /** \brief The number of traces ending outside the goal states of each color, in the order of the colors. */
+  std::vector<std::size_t> violations;
+};
+
+/**
+ * \brief Plays a strategy against many traces of the environment and checks the resulting traces with DFAs.
+ *
+ * The strategy runs as a CompiledTransducer, and the transition functions
+ * and goal states of the DFAs as BddCircuit, all bit-sliced: 64 traces per
+ * word and block_traces traces at a time, so that memory does not grow with
+ * the number of traces. At each step the strategy reads the inputs of every
+ * trace, and each DFA then reads the letter made of the inputs and the
+ * outputs of the strategy. A trace violates a color when it ends outside its
+ * goal states. Explicit DFAs are checked through SymbolicStateDfa::from_mona.
+ */
+class TraceSimulator {
+ public:
+
+  static constexpr std::size_t block_traces = 4096;
+
+  /**
+   * \brief One value per input of the strategy at each step.
+   */
+  typedef std::vector<std::vector<bool>> Trace;
+
+  /**
+   * \brief Creates a simulator of \a strategy checked by \a components.
+   *
+   * \param goal_states The goal states of each color, over the state variables of \a components.
+   */
+  TraceSimulator(const Transducer& strategy, const std::vector<SymbolicStateDfa>& components,
+                 const std::vector<CUDD::BDD>& goal_states);
+
+  /**
+   * \brief Simulates \a traces traces of \a length steps with uniformly random inputs.
+   */
+  SimulationReport simulate_random(std::size_t traces, std::size_t length, std::uint64_t seed = 0) const;
+
+  /**
+   * \brief Simulates recorded traces, which may have different lengths.
+   *
+   * Throws std::runtime_error if a step does not have one value per input.
+   */
+  SimulationReport simulate(const std::vector<Trace>& traces) const;
+
+ private:
+
+  typedef std::function<void(std::size_t step, CompiledTransducer::Batch& batch)> InputSource;
+
+  CompiledTransducer strategy_;
+  std::size_t input_count_;
+  std::size_t output_count_;
+  std::size_t state_count_;
+  // Both with the slots of the inputs, the outputs and the state bits of the DFAs
+  BddCircuit transitions_;
+  BddCircuit goals_;
+  std::vector<std::uint32_t> next_state_;
+  std::vector<std::uint32_t> goal_roots_;
+  std::vector<std::uint8_t> initial_state_;
+
+  void run_block(const std::vector<std::size_t>& lengths, const InputSource& inputs, SimulationReport& report) const;
+};
+
+}
+
+#endif // TRACE_SIMULATOR_H
@@ -2,6 +2,7 @@
 #define TRANSDUCER_H
 
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -26,18 +27,41 @@ class Transducer {
   const std::vector<CUDD::BDD> transition_function_;
   const Player starting_player_;
   const Player protagonist_player_;
+  const std::vector<CUDD::BDD> state_variables_;
 
  public:
 
+  /**
+   * \brief Creates a transducer.
+   *
+   * \param state_variables The variable updated by each bit of \a transition_function,
+   *   if known; needed to execute the transducer (see CompiledTransducer).
+   */
   Transducer(const std::shared_ptr<VarMgr>& var_mgr,
              const std::vector<int>& initial_vector,
              const std::unordered_map<int, CUDD::BDD>& output_function,
              const std::vector<CUDD::BDD>& transition_function,
              Player starting_player,
-             Player protagonist_player = Player::Agent);
+             Player protagonist_player = Player::Agent,
+             const std::vector<CUDD::BDD>& state_variables = {});
 
   inline std::unordered_map<int, CUDD::BDD> get_output_function() const {return output_function_;};
   inline std::vector<CUDD::BDD> get_transition_function() const {return transition_function_;}
+  inline const std::vector<CUDD::BDD>& get_state_variables() const {return state_variables_;}
+  inline const std::vector<int>& get_initial_vector() const {return initial_vector_;}
+  inline std::shared_ptr<VarMgr> get_var_mgr() const {return var_mgr_;}
+  inline Player get_starting_player() const {return starting_player_;}
+  inline Player get_protagonist_player() const {return protagonist_player_;}
+
+  /**
+   * \brief Returns the labels of the variables the protagonist reads, i.e. those of the other player.
+   */
+  std::vector<std::string> controller_inputs() const;
+
+  /**
+   * \brief Returns the labels of the variables the protagonist sets.
+   */
+  std::vector<std::string> controller_outputs() const;
 
   /**
    * \brief Saves the output function of the transducer in a .dot file.
@@ -0,0 +1,87 @@
+#ifndef TRANSDUCER_CODEGEN_H
+#define TRANSDUCER_CODEGEN_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "game/BddCircuit.h"
+#include "game/Transducer.h"
+
+namespace Syft {
+
+/**
+ * \brief The sizes of a transducer and of the code generated from it, to compare variable orders.
+ */
+struct CodegenReport {
+  /** \brief The BDD nodes of the output and next-state functions, shared ones counted once. */
+  std::size_t bdd_nodes = 0;
+  /** \brief The nodes of their BddCircuit, where a node reached with both polarities counts twice. */
+  std::size_t circuit_nodes = 0;
+  /** \brief The nodes read more than once, which become temporaries; the others are inlined. */
+  std::size_t temporaries = 0;
+};
+
+/**
+ * \brief Generates standalone C and Verilog from a Transducer, which must record its state variables.
+ *
+ * The output and next-state functions are compiled into a BddCircuit, like
+ * CompiledTransducer, so the generated code has the same slots and step: the
+ * inputs and outputs are arrays in the order of the controller labels, listed
+ * in a comment, and the state bits are registers initialised to the initial
+ * state of the transducer. For Emerson-Lei strategies extracted symbolically
+ * they are the state bits of the arena followed by the Zielonka tree memory.
+ * Each node of the circuit is a multiplexer simplified when a child is
+ * constant; a node read more than once is a temporary and the others are
+ * inlined. The C code does not allocate: a step reads a state struct and two
+ * byte arrays.
+ */
+class TransducerCodegen {
+ public:
+
+  /**
+   * \brief Compiles \a transducer; throws std::runtime_error as CompiledTransducer does.
+   */
+  explicit TransducerCodegen(const Transducer& transducer);
+
+  /**
+   * \brief Returns C code defining \a name_state, \a name_reset and \a name_step.
+   *
+   * Throws std::runtime_error if \a name is not an identifier.
+   */
+  std::string to_c(const std::string& name) const;
+
+  /**
+   * \brief Returns a Verilog module \a name with clock, synchronous reset, input and output ports.
+   *
+   * Throws std::runtime_error if \a name is not an identifier.
+   */
+  std::string to_verilog(const std::string& name) const;
+
+  const CodegenReport& report() const {return report_;}
+
+ private:
+
+  enum class Language {C, Verilog};
+
+  std::vector<std::string> inputs_;
+  std::vector<std::string> outputs_;
+  std::size_t state_count_;
+  BddCircuit circuit_;
+  std::size_t output_nodes_end_;
+  std::vector<std::uint32_t> output_roots_;
+  std::vector<std::uint32_t> next_state_roots_;
+  std::vector<std::uint8_t> initial_state_;
+  // Whether each node of the circuit is a temporary
+  std::vector<bool> temporary_;
+  CodegenReport report_;
+
+  std::string slot_name(std::uint32_t slot, Language language) const;
+  std::string expression(std::uint32_t node, Language language) const;
+  std::string node_expression(std::uint32_t node, Language language) const;
+};
+
+}
+
+#endif // TRANSDUCER_CODEGEN_H
@@ -3,9 +3,12 @@
 
 #include "automata/SymbolicStateDfa.h"
 #include "game/SCCDecomposer.h"
+#include "game/FixpointTrace.h"
+#include "game/PartitionedTransitionRelation.h"
 #include "VarMgr.h"
 #include "cuddObj.hh"
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace Syft {
@@ -30,6 +33,12 @@ struct WeakGameResult {
  * 4. Remove bottom SCCs and repeat
  */
 class WeakGameSolver {
+public:
+    /**
+     * \brief Layers with fewer states are solved as one BDD by default, even when several threads are available.
+     */
+    static constexpr double parallel_layer_min_states = 64;
+
 private:
     const SymbolicStateDfa& arena_;
     std::shared_ptr<VarMgr> var_mgr_;
@@ -39,8 +48,18 @@ private:
     // Cached primed automaton ID for transition computations
     mutable std::size_t primed_automaton_id_;
     mutable bool initialized_ = false;
+    // Partitioned transition relation, used instead of VectorCompose on large arenas
+    mutable std::unique_ptr<PartitionedTransitionRelation> partitioned_relation_;
+    // Relation for the forward search of ReachableStates on smaller arenas
+    mutable std::unique_ptr<PartitionedTransitionRelation> image_relation_;
     
     bool debug_ = true;  ///< Enable debug printing of state sets
+    FixpointMode fixpoint_mode_ = FixpointMode::Full;  ///< How reachability and safety fixpoints iterate
+    mutable FixpointTrace fixpoint_trace_;  ///< Iterations of all fixpoints of the last Solve
+    bool realizability_only_ = false;  ///< Stop once the initial state is decided
+    std::size_t threads_ = 1;  ///< Threads solving the SCCs of a layer
+    bool demand_driven_ = false;  ///< Only decompose the states reachable from the initial state
+    double parallel_min_states_ = parallel_layer_min_states;  ///< Smaller layers are solved sequentially
     
     /**
      * \brief Print the actual states in a BDD for debugging.
@@ -52,12 +71,41 @@ private:
      */
     void Initialize() const;
     
+    /**
+     * \brief Returns the states and moves leading into \a target in one step.
+     */
+    CUDD::BDD MovePreimage(const CUDD::BDD& target) const;
+
+    /**
+     * \brief Returns the moves of the states in \a care_states leading into \a target.
+     *
+     * The transition function is simplified with Restrict to \a care_states
+     * before composing.
+     */
+    CUDD::BDD MovePreimage(const CUDD::BDD& target, const CUDD::BDD& care_states) const;
+
+    /**
+     * \brief Returns the states with a transition into \a states, for some move.
+     */
+    CUDD::BDD Predecessors(const CUDD::BDD& states) const;
+
+    /**
+     * \brief Returns the states reachable from the initial state.
+     */
+    CUDD::BDD ReachableStates() const;
+
     /**
      * \brief Controllable predecessor for system (protagonist).
      * CPre_s(X) = {s | ∃y. ∀x'. T(s,y,x') → ∃y'. X(x',y')}
      * States from which protagonist can force reaching X in one step.
      */
     CUDD::BDD CPreSystem(const CUDD::BDD& target, const CUDD::BDD& state_space) const;
+
+    /**
+     * \brief CPre_s(X) restricted to \a care_states.
+     */
+    CUDD::BDD CPreSystem(const CUDD::BDD& target, const CUDD::BDD& state_space,
+                         const CUDD::BDD& care_states) const;
     
     /**
      * \brief Controllable predecessor for environment (antagonist).
@@ -69,14 +117,46 @@ private:
     /**
      * \brief Solve reachability game to goal_states within state_space.
      * Compute μX. goal ∪ CPre_s(X)
+     *
+     * In Frontier mode, each iteration only re-examines the predecessors of
+     * the states added by the previous one.
+     *
+     * \param node Names the fixpoint in the FixpointTelemetry, e.g. its layer.
      */
-    CUDD::BDD SolveReachability(const CUDD::BDD& goal_states, const CUDD::BDD& state_space) const;
+    CUDD::BDD SolveReachability(const CUDD::BDD& goal_states, const CUDD::BDD& state_space,
+                                const std::string& node = "") const;
     
     /**
      * \brief Solve safety game staying in safe_states within state_space.
      * Compute νX. safe ∩ CPre_s(X)
+     *
+     * In Frontier mode, each iteration only re-examines the predecessors of
+     * the states removed by the previous one.
+     *
+     * \param node Names the fixpoint in the FixpointTelemetry, e.g. its layer.
+     */
+    CUDD::BDD SolveSafety(const CUDD::BDD& safe_states, const CUDD::BDD& state_space,
+                          const std::string& node = "") const;
+
+    /**
+     * \brief Splits a layer into its SCCs.
+     *
+     * The SCCs of a layer are mutually unreachable, so each one is the
+     * backward closure of any of its states within the layer.
+     */
+    std::vector<CUDD::BDD> SplitLayer(const CUDD::BDD& layer) const;
+
+    /**
+     * \brief Solves the SCCs of one layer concurrently, each in its own manager.
+     *
+     * Every state below the layer must be decided. Each SCC, with the
+     * transition function restricted to it, the accepting states and the good
+     * states below, is transferred to a fresh manager, solved there by a
+     * worker thread and transferred back.
+     *
+     * \return The good states of the layer.
      */
-    CUDD::BDD SolveSafety(const CUDD::BDD& safe_states, const CUDD::BDD& state_space) const;
+    CUDD::BDD SolveComponents(const std::vector<CUDD::BDD>& components, const CUDD::BDD& good_states) const;
     
     /**
      * \brief Dump DFA transitions and accepting states for debugging.
@@ -89,6 +169,11 @@ private:
     void DumpDFAForPython() const;
 
 public:
+    /**
+     * \brief Arenas with at least this many state bits use a partitioned transition relation.
+     */
+    static constexpr std::size_t partitioned_relation_min_bits = 40;
+
     /**
      * \brief Constructs a WeakGameSolver.
      * 
@@ -108,6 +193,50 @@ public:
      * \brief Check if the initial state is winning.
      */
     bool IsWinning() const;
+
+    /**
+     * \brief Selects how reachability and safety fixpoints iterate; Full by default.
+     */
+    void SetFixpointMode(FixpointMode mode);
+
+    /**
+     * \brief Selects the SCC decomposition used to peel layers; Naive by default.
+     *
+     * \param chain The pivot selection, if \a algorithm is Chain.
+     */
+    void SetSCCAlgorithm(SCCAlgorithm algorithm, const ChainOptions& chain = ChainOptions());
+
+    /**
+     * \brief Only compute the verdict.
+     *
+     * Solve stops after the first layer that decides the initial state, so the
+     * returned winning states only cover the layers processed so far.
+     */
+    void SetRealizabilityOnly(bool realizability_only);
+
+    /**
+     * \brief Only decompose and solve the states reachable from the initial state.
+     *
+     * The reachable states are closed under successors, so their layers and
+     * their status are those of the whole arena; the SCC decomposition of the
+     * rest is skipped. The initial state lies in the top layer of the reachable
+     * states, so it is decided by the last layer solved. The returned winning
+     * states only cover the reachable states.
+     */
+    void SetDemandDriven(bool demand_driven);
+
+    /**
+     * \brief Sets the number of threads solving the SCCs of large layers; 1 (sequential) by default.
+     *
+     * \param threads The number of worker threads.
+     * \param min_layer_states Layers with fewer states are solved as one BDD.
+     */
+    void SetThreads(std::size_t threads, double min_layer_states = parallel_layer_min_states);
+
+    /**
+     * \brief Returns the iterations of the reachability and safety fixpoints of the last Solve, in order.
+     */
+    const FixpointTrace& GetFixpointTrace() const;
 };
 
 } // namespace Syft
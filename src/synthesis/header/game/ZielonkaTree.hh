@@ -1,8 +1,14 @@
 #pragma once
 
 #include <cstddef>
+#include <deque>
+#include <map>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 #include "ELHelpers.hh"
+#include "game/ColorFormula.h"
+#include "game/ColorSet.h"
 #include "VarMgr.h"
 #include "Transducer.h"
 
@@ -10,8 +16,9 @@ struct ZielonkaNode {
     std::vector<ZielonkaNode*> children;
     ZielonkaNode *parent;
     size_t parent_order;
+    // The index of the node among the children of its parent
     size_t sibling_order;
-    std::vector<bool> label;
+    Syft::ColorSet label;
     std::vector<CUDD::BDD> winningmoves;
     CUDD::BDD safenodes;
     CUDD::BDD targetnodes;
@@ -19,34 +26,102 @@ struct ZielonkaNode {
     size_t order;
     bool winning;
     std::vector<std::unique_ptr<Syft::Transducer>> transducers;
+    // Nodes with the same label root isomorphic subtrees and share their dag_id
+    size_t dag_id;
+    // Whether children holds the children of the node; lazy trees expand a node on first access
+    bool expanded = false;
     // std::vector<ZielonkaNode*> ancestors;
 };
 
+// The labels of the children of each label of a Zielonka tree, largest first (see ZielonkaTree::label_dag)
+typedef std::map<Syft::ColorSet, std::vector<Syft::ColorSet>> ZielonkaLabelDag;
+
 class ZielonkaTree {
 private:
     // Private Variables
     ZielonkaNode *root;
     size_t leaves = 0;
     size_t total_nodes = 0;
-    std::vector<std::string> phi; // Emerson-Lei condition in tokenized postfix format
+    Syft::ColorFormula phi; // Emerson-Lei condition, compiled
     std::vector<CUDD::BDD> colorBDDs_;
     std::shared_ptr<Syft::VarMgr> var_mgr_;
+    // Distinct labels, i.e. the nodes of the DAG obtained by merging isomorphic subtrees
+    std::unordered_map<Syft::ColorSet, size_t, Syft::ColorSetHash> dag_ids_;
+    // The condition over one variable per color of color_mgr_, from which children are extracted
+    std::unique_ptr<CUDD::Cudd> color_mgr_;
+    CUDD::BDD phi_bdd_;
+    // The children of each DAG node, computed on its first expansion and copied into every occurrence of its label
+    struct DagChild {
+        Syft::ColorSet label;
+        CUDD::BDD safenodes;
+        CUDD::BDD targetnodes;
+    };
+    std::vector<std::vector<DagChild>> dag_children_;
+    // Children labels computed ahead, read before extracting them from phi_bdd_
+    std::shared_ptr<const ZielonkaLabelDag> label_dag_;
+    std::vector<bool> dag_expanded_;
+    size_t next_order_ = 0;
+    // Owns every node, root included; declared after var_mgr_ so that the
+    // BDDs of the nodes are released before the manager can be
+    std::deque<ZielonkaNode> nodes_;
 
     // Private methods
-    void generate();
+    // Moves node into the arena, whose addresses are stable, and gives it the dag_id of its label
+    ZielonkaNode* add_node(ZielonkaNode node);
+    // Creates the children of node
+    void expand(ZielonkaNode* node);
+    // The color formula as a BDD over one variable per color of mgr
+    CUDD::BDD phi_to_bdd(CUDD::Cudd& mgr) const;
     void generate_parity();
     void generate_phi(const char*);
-    void generate_phi_from_str(const std::string color_formula);
-    bool evaluate_phi(std::vector<bool>);
+    // Compiles color_formula, exiting if it is empty
+    static Syft::ColorFormula phi_from_str(const std::string color_formula);
+    bool evaluate_phi(const Syft::ColorSet&) const;
     void graphZielonkaTree();
 
 public:
-    ZielonkaTree(const std::string, const std::vector<CUDD::BDD>&, std::shared_ptr<Syft::VarMgr>);
-    ~ZielonkaTree() {};
+    // The colors are one BDD each, the states that see the color: Inf(i) reads colorBDDs[i] and Fin(i) its complement.
+    // A lazy tree only builds its root, and each node on the first call of children on its parent, so that
+    // subtrees a solver never enters are never built; an eager tree is built whole by the constructor
+    ZielonkaTree(const std::string, const std::vector<CUDD::BDD>&, std::shared_ptr<Syft::VarMgr>, bool lazy = false);
+    // Builds the tree of an already compiled condition; the children of the labels of label_dag are taken from it
+    ZielonkaTree(Syft::ColorFormula, const std::vector<CUDD::BDD>&, std::shared_ptr<Syft::VarMgr>, bool lazy = false,
+                 std::shared_ptr<const ZielonkaLabelDag> label_dag = nullptr);
+    // Nodes point to each other, so trees are not copied
+    ZielonkaTree(const ZielonkaTree&) = delete;
+    ZielonkaTree& operator=(const ZielonkaTree&) = delete;
+    ~ZielonkaTree() = default;
+
+    // The maximal proper subsets of label on which phi_bdd, over one variable of mgr per color, is not winning,
+    // largest first: the labels of the children of a node
+    static std::vector<Syft::ColorSet> maximal_subsets(const Syft::ColorSet& label, bool winning,
+                                                       const CUDD::BDD& phi_bdd, CUDD::Cudd& mgr);
+
+    // The labels of the tree of phi over color_count colors with their children, breadth-first from the root
+    // until max_labels labels are expanded. Only uses a manager of its own, so it can run on another thread
+    // while the color BDDs are built, e.g. to pass to the constructor later
+    static std::shared_ptr<const ZielonkaLabelDag> label_dag(const Syft::ColorFormula& phi, size_t color_count,
+                                                             size_t max_labels);
 
     ZielonkaNode* get_root();
+    // The children of node, expanding it first if needed; not thread-safe, as expanding uses the BDD manager
+    const std::vector<ZielonkaNode*>& children(ZielonkaNode* node);
+    // Expands every node below node, node included, e.g. before its subtree is read without children
+    void expand_subtree(ZielonkaNode* node);
+    void expand_all() { expand_subtree(root); }
+    // Number of distinct subtrees built so far, i.e. of distinct dag_id values
+    size_t dag_size() const { return dag_ids_.size(); }
+    // Number of nodes built so far, root included: the whole tree unless it is lazy
+    size_t size() const { return nodes_.size(); }
+    // Intersects the safe and target sets of every node with states, e.g. the
+    // arena state space, so that the solver does not carry them separately;
+    // the nodes expanded later inherit the restriction from their parents
+    void restrict_to(const CUDD::BDD& states);
+    // Frees the winning moves and transducers of every node, once no strategy is extracted from them
+    void release_winning_moves();
+    // Both show the nodes built so far; expand_all first shows the whole tree
     void dump_dot(const std::string& path) const;
-        void displayZielonkaTree();
+    void displayZielonkaTree();
 
     inline void print_label(ZielonkaNode *z) {
         for (size_t i = 0; i < z->label.size(); ++i){
@@ -28,7 +28,10 @@ namespace Syft {
          * \brief The coBuchi condition represented as a Boolean formula \beta over input variables, denoting the coBuchi condition FG\beta
          */
         CUDD::BDD coBuchi_;
-
+        /**
+         * \brief The number of outer iterations of the last run.
+         */
+        mutable std::size_t outer_iterations_ = 0;
 
     public:
 
@@ -52,9 +55,21 @@ namespace Syft {
          * realizability
          * a set of agent winning states
          * a transducer representing a winning strategy or nullptr if the game is unrealizable.
+         *
+         * With FixpointMode::Frontier, the inner greatest fixpoint is warm-started: the
+         * states of the outer approximation are never re-examined, as the inner
+         * fixpoint grows with it, and after its first iteration only predecessors of
+         * the last removed states are. The composed sets (W | goal) and (Y | goal) are
+         * updated from their changes instead of being recomposed.
+         * The inner iterations are recorded in fixpoint_trace().
          */
         SynthesisResult run() const final;
 
+        /**
+         * \brief Returns the number of outer iterations of the last run.
+         */
+        std::size_t outer_iterations() const;
+
     };
 
 }
@@ -107,6 +107,29 @@ namespace Syft {
          */
         std::string get_slugs_path() const;
 
+        /**
+         * \brief The positions from which the environment can force the next position into \a target.
+         *
+         * A position is a state together with the letter that led to it. The
+         * agent picks the outputs of the next letter first, then the environment
+         * the inputs, and the state they lead to must be safe.
+         */
+        CUDD::BDD environment_pre(const CUDD::BDD &target) const;
+
+        /**
+         * \brief Solves the game in process with the three nested fixpoints of GR(1) games.
+         *
+         * Computes the positions from which the environment satisfies the
+         * game as Slugs would, with the mu-calculus formula of Bloem et al.
+         * [JCSS 2012], and negates the outcome for the agent.
+         */
+        SynthesisResult run_native() const;
+
+        /**
+         * \brief Solves the game by writing it for Slugs and running the Slugs binary.
+         */
+        SynthesisResult run_slugs() const;
+
 
     public:
 
@@ -134,6 +157,8 @@ namespace Syft {
         /**
          * \brief Solves the Buchi-reachability game.
          *
+         * Uses the native solver if the Slugs directory is empty, and Slugs otherwise.
+         *
          * \return The result consists of
          * realizability
          * a set of agent winning states
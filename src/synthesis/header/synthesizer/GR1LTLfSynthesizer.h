@@ -60,7 +60,7 @@ namespace Syft {
          * \param env_safety A symbolic-state DFA representing the LTLf formula indicating the environment safety condition
          * \param agn_reach  A symbolic-state DFA representing the LTLf formula indicating the system reachability condition
          * \param agn_safety A symbolic-state DFA representing the LTLf formula indicating the system safety condition
-         * \param slugs_dir  The root directory of SLUGS
+         * \param slugs_dir  The root directory of SLUGS, or empty to solve the GR(1) game natively
          */
         GR1LTLfSynthesizer(const std::shared_ptr<VarMgr> &var_mgr, const GR1 &gr1,
                            const SymbolicStateDfa &env_safety,
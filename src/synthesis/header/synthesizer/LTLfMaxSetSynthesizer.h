@@ -60,11 +60,16 @@ namespace Syft {
         /**
          * \brief Solves the MaxSet-LTLf synthesis problem.
          *
+         * The strategies of the result are computed on their first call (see ReachabilityMaxSet::run_maxset).
+         *
          * \return The synthesis result.
          */
         MaxSetSynthesisResult run() const;
 
-        void dump_dot(MaxSetSynthesisResult maxset, const std::string &def_filename,
+        /**
+         * \brief Dumps the strategies of \a maxset, skipping a strategy whose file name is empty.
+         */
+        void dump_dot(const MaxSetSynthesisResult &maxset, const std::string &def_filename,
                       const std::string &nondef_filename) const;
 
     };
@@ -0,0 +1,102 @@
+#ifndef LYDIASYFT_LTLFPLUSSESSION_H
+#define LYDIASYFT_LTLFPLUSSESSION_H
+
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "automata/ColorAutomatonBuilder.h"
+#include "automata/DfaCache.h"
+#include "game/EmersonLei.hpp"
+#include "game/InputOutputPartition.h"
+#include "InterfaceLayout.h"
+#include "Synthesizer.h"
+#include "VarMgr.h"
+
+namespace Syft {
+
+    /**
+     * \brief Solves successive edits of an LTLf+ spec over one partition, reusing the work of the previous solve.
+     *
+     * The DFAs of the colors stay in one ColorAutomatonBuilder, so that an edit
+     * only builds the DFAs of its new subformulas, and the product arena is
+     * recomposed from them. The previous solve is compared with the new spec by
+     * their top conjuncts (see top_conjuncts):
+     * - the same conjuncts: the previous result is returned;
+     * - conjuncts removed: the new spec is weaker, so the previous winning
+     *   states, with the removed DFAs quantified out, are instantly winning;
+     * - conjuncts added: the new spec is stronger, so the previous losing
+     *   states are instantly losing.
+     * Warm starts only use solves that computed the whole winning region, i.e.
+     * not in realizability-only or anytime mode.
+     */
+    class LTLfPlusSession {
+    public:
+
+        /**
+         * \brief How the last solve used the previous one.
+         */
+        enum class Reuse {
+            None,           ///< Solved from scratch
+            Verdict,        ///< Same conjuncts, the previous result was returned
+            WinningStates,  ///< Conjuncts removed, warm-started from the previous winning states
+            LosingStates    ///< Conjuncts added, warm-started from the previous losing states
+        };
+
+        /**
+         * \brief Creates a session over the variables of \a partition.
+         *
+         * \param var_mgr_options Sizing, limits and reordering policy of the BDD manager.
+         * \param dfa_options Construction of the DFAs and settings of the EL solver.
+         */
+        LTLfPlusSession(InputOutputPartition partition, Player starting_player, Player protagonist_player,
+                        VarMgrOptions var_mgr_options = VarMgrOptions(),
+                        DfaConstructionOptions dfa_options = DfaConstructionOptions());
+
+        /**
+         * \brief Creates a session over the variables of a shared interface layout, in its partition order.
+         */
+        LTLfPlusSession(const InterfaceLayout &layout, Player starting_player, Player protagonist_player,
+                        VarMgrOptions var_mgr_options = VarMgrOptions(),
+                        DfaConstructionOptions dfa_options = DfaConstructionOptions());
+
+        /**
+         * \brief Returns the variable manager shared by every solve.
+         */
+        std::shared_ptr<VarMgr> var_mgr() const { return var_mgr_; }
+
+        /**
+         * \brief Solves \a formula, whose variables must belong to the partition of the session.
+         */
+        ELSynthesisResult solve(const LTLfPlus &formula);
+
+        /**
+         * \brief Returns how the last solve used the previous one.
+         */
+        Reuse last_reuse() const { return last_reuse_; }
+
+    private:
+
+        struct Solved {
+            std::set<std::string> conjuncts;
+            std::vector<std::size_t> automaton_ids;
+            CUDD::BDD state_space;
+            ELSynthesisResult result;
+            // Owns the Zielonka tree the output function of the result points into
+            std::shared_ptr<EmersonLei> solver;
+        };
+
+        std::shared_ptr<VarMgr> var_mgr_;
+        Player starting_player_;
+        Player protagonist_player_;
+        DfaConstructionOptions dfa_options_;
+        ColorAutomatonBuilder builder_;
+        std::optional<Solved> previous_;
+        Reuse last_reuse_ = Reuse::None;
+    };
+
+}
+
+#endif //LYDIASYFT_LTLFPLUSSESSION_H
@@ -6,12 +6,24 @@
 #define LYDIASYFT_LTLFPLUSSYNTHESIZER_H
 
 #include <game/EmersonLei.hpp>
+#include <game/LayeredEmersonLei.h>
+#include <game/SymbolicEmersonLei.h>
 
+#include "automata/DfaCache.h"
 #include "automata/SymbolicStateDfa.h"
+#include "SolveCheckpoint.h"
+#include "SpecDecomposition.h"
+#include "InterfaceLayout.h"
 #include "Synthesizer.h"
 #include "game/InputOutputPartition.h"
 #include "lydia/parser/ltlf/driver.hpp"
 
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace Syft {
 
@@ -35,26 +47,215 @@ namespace Syft {
          */
         std::string color_formula_;
         mutable std::shared_ptr<EmersonLei> emerson_lei_;
+        /**
+         * \brief Threads and cache used to construct the DFAs of the subformulas.
+         */
+        DfaConstructionOptions dfa_options_;
+        /**
+         * \brief The partition and variable order, shared with the synthesizers of the components.
+         */
+        InterfaceLayout layout_;
+        VarMgrOptions var_mgr_options_;
+        /**
+         * \brief The synthesizers of the independent components solved by the last run, if any.
+         */
+        mutable std::vector<std::shared_ptr<LTLfPlusSynthesizer>> components_;
+
+        /**
+         * \brief The product arena of the DFAs of the colors, as solved by either EL solver.
+         */
+        struct GameArena {
+            ProductArena arena;
+            CUDD::BDD state_space;
+            std::vector<CUDD::BDD> goal_states;
+            // The condition left to solve on the state space, see restrict_to_safety_conjuncts
+            std::string color_formula;
+            // The labels of the Zielonka tree of color_formula_, computed during DFA construction, if any
+            std::shared_ptr<const ZielonkaLabelDag> zielonka_labels;
+            // The states from which the pre-check forced a settled region, if it reached the initial state
+            std::optional<CUDD::BDD> horizon_winning;
+        };
+
+        /**
+         * \brief Builds the DFAs and the product arena, on the whole color formula.
+         *
+         * With the pipeline_stages option, the labels of the Zielonka tree are
+         * computed on another thread, in a manager of their own, while the DFAs
+         * are built, and the trace reports which of the two took longer.
+         */
+        GameArena build_product() const;
+
+        /**
+         * \brief Builds the product arena, restricted for the starting player with the safety_first option.
+         *
+         * With the horizon_precheck option, first runs win_within_horizon, and
+         * leaves the arena unrestricted if it wins.
+         */
+        GameArena build_arena() const;
+
+        /**
+         * \brief Returns the states from which the protagonist forces a settled region of \a game within the horizon_precheck option, if they hold the initial state.
+         *
+         * A state is settled when the color formula holds for every color set
+         * containing its colors. Since the colors seen from some point on are
+         * all seen infinitely often, a play that stays among settled states
+         * satisfies the condition. The settled region, where the protagonist can
+         * stay so by a Safety game, is then the goal of a Reachability game
+         * bounded to that many steps, on the components of the arena.
+         */
+        std::optional<CUDD::BDD> win_within_horizon(const GameArena &game) const;
+
+        /**
+         * \brief Restricts \a state_space to the safe region of the Forall colors of the top conjunction.
+         *
+         * Every winning play stays out of the sinks of the G-DFAs of these colors,
+         * so the game is solved on the states from which the protagonist can do
+         * so forever, found by a Safety game. A color is also dropped from the
+         * condition when its DFA cannot loop on its initial state, since the plays
+         * of the region then visit its goal states infinitely often.
+         *
+         * \return The restricted state space and the remaining color formula.
+         */
+        std::pair<CUDD::BDD, std::string> restrict_to_safety_conjuncts(const ProductArena &arena,
+                                                                      const std::vector<CUDD::BDD> &goal_states,
+                                                                      const CUDD::BDD &state_space,
+                                                                      Player starting_player) const;
+
+        /**
+         * \brief Returns the configured EL solver of \a game when \a starting_player moves first.
+         *
+         * With a \a checkpoint, the solver starts from the root bounds saved in it, if any,
+         * and saves its own as it goes.
+         */
+        std::shared_ptr<EmersonLei> build_game(const GameArena &game, Player starting_player,
+                                               std::shared_ptr<const SolveCheckpoint> checkpoint = nullptr) const;
+
+        /**
+         * \brief Returns the checkpoint of \a game in the checkpoint directory of the options, or none.
+         *
+         * None either when the options extract a strategy or select the parity solver.
+         */
+        std::shared_ptr<SolveCheckpoint> attach_checkpoint(const GameArena &game) const;
+
+        /**
+         * \brief Returns the SymbolicEmersonLei or LayeredEmersonLei solver of \a game selected by the options.
+         */
+        std::shared_ptr<DfaGameSynthesizer> build_color_game(const GameArena &game, Player starting_player) const;
+
+        /**
+         * \brief Builds the game of the solver of the options, and returns how to solve it.
+         *
+         * The game is solved by EmersonLei, kept in emerson_lei_, unless the
+         * options select SymbolicEmersonLei or LayeredEmersonLei.
+         */
+        std::function<ELSynthesisResult()> build_solve() const;
+
+        /**
+         * \brief Builds the games of \a disjuncts on one arena, and returns how to solve them before the whole condition.
+         */
+        std::function<ELSynthesisResult()> build_disjunct_solve(GameArena game,
+                                                                const std::vector<std::string> &disjuncts) const;
+
+        /**
+         * \brief Solves the components of \a decomposition as separate games and combines their verdicts.
+         */
+        ELSynthesisResult run_components(const SpecDecomposition &decomposition) const;
 
     public:
 
         /**
          * \brief Construct an LtlfPlusSynthesizer.
+         *
+         * \param var_mgr_options Sizing, limits and reordering policy of the BDD manager.
+         * \param dfa_options Threads and persistent cache used to construct the DFAs of the subformulas.
          */
         LTLfPlusSynthesizer(
             LTLfPlus ltlf_plus_formula,
             InputOutputPartition partition,
             Player starting_player,
-            Player protagonist_player
+            Player protagonist_player,
+            VarMgrOptions var_mgr_options = VarMgrOptions(),
+            DfaConstructionOptions dfa_options = DfaConstructionOptions()
         );
 
+        /**
+         * \brief Construct an LtlfPlusSynthesizer over a shared interface layout, e.g. one per partition of a batch.
+         */
+        LTLfPlusSynthesizer(
+            LTLfPlus ltlf_plus_formula,
+            InterfaceLayout layout,
+            Player starting_player,
+            Player protagonist_player,
+            VarMgrOptions var_mgr_options = VarMgrOptions(),
+            DfaConstructionOptions dfa_options = DfaConstructionOptions()
+        );
+
+        /**
+         * \brief Returns the variable manager.
+         */
+        std::shared_ptr<VarMgr> var_mgr() const { return var_mgr_; }
+
         /**
          * \brief Solves the LTLfPlus synthesis problem.
          *
+         * Unless disabled in the DFA options, or a symbolic strategy is requested,
+         * independent components of the spec (see decompose_spec) are solved as
+         * separate games, on the component threads of the options, each with its
+         * own variable manager. The verdict then combines theirs, the output
+         * function gathers those of the winning components, and the winning
+         * states are only the constant verdict: the winning states of each
+         * component are in components().
+         *
+         * With the safety_first option, the game of each component is solved
+         * inside the safe region of the Forall colors of the top conjunction
+         * (see restrict_to_safety_conjuncts).
+         *
+         * With the split_disjuncts option, the top disjuncts of the color
+         * formula are first solved on the arena as separate EL games, in
+         * parallel on the EL threads: the union of their winning states is
+         * winning for the whole condition, so the spec is realizable if it holds
+         * the initial state, and otherwise the whole condition is solved with
+         * the union as instantly winning states. Only applies to the EmersonLei
+         * solver when no strategy is extracted.
+         *
+         * With the horizon_precheck option, and when no strategy is extracted,
+         * the spec is reported realizable without building the Zielonka tree if
+         * the protagonist forces a region where the condition is settled within
+         * that many steps (see win_within_horizon). The winning states are then
+         * only those of the pre-check.
+         *
+         * With a checkpoint directory in the options, the EmersonLei solver saves
+         * its root bounds there, and with the resume option continues from those
+         * of an interrupted run of the same game (see SolveCheckpoint).
+         *
          * \return The synthesis result.
          */
         ELSynthesisResult run() const;
 
+        /**
+         * \brief Solves the LTLfPlus synthesis problem for both orders of play, whatever the starting player.
+         *
+         * The DFAs and the product arena are built once and shared by the two
+         * games, which are solved one after the other on the same variable
+         * manager, so that the second reuses the BDDs and caches of the first;
+         * only the safety pre-pass and the fixpoints are computed twice.
+         * Decomposed specs solve both orders of each component in turn. The
+         * split_disjuncts option does not apply.
+         *
+         * \return The results with the agent moving first and with the environment moving first.
+         */
+        std::pair<ELSynthesisResult, ELSynthesisResult> run_both_orders() const;
+
+        /**
+         * \brief Applies the solver settings of \a options to \a solver.
+         */
+        static void configure_solver(EmersonLei &solver, const DfaConstructionOptions &options);
+
+        /**
+         * \brief Returns the synthesizers of the components solved by the last run, or none if it was not decomposed.
+         */
+        const std::vector<std::shared_ptr<LTLfPlusSynthesizer>> &components() const { return components_; }
+
         // EmersonLei::OneStepSynReturn synthesize(std::string X, ELSynthesisResult result) const;
 
 
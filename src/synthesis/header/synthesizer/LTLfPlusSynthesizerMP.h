@@ -6,7 +6,9 @@
 #define LTLFPLUSSYNTHESIZERMP_H
 
 
+#include "automata/DfaCache.h"
 #include "automata/SymbolicStateDfa.h"
+#include "InterfaceLayout.h"
 #include "Synthesizer.h"
 #include "game/InputOutputPartition.h"
 #include "lydia/parser/ltlf/driver.hpp"
@@ -26,6 +28,7 @@ namespace Syft {
     std::vector<int> F_colors_;
     std::vector<int> G_colors_;
     int game_solver_; // Manna-Pnueli-Adv=2; Manna-Pnueli=1 
+    DfaConstructionOptions dfa_options_; // threads and cache used to construct the DFAs of the subformulas
 
   public:
     LTLfPlusSynthesizerMP(
@@ -33,9 +36,29 @@ namespace Syft {
       InputOutputPartition partition,
       Player starting_player,
       Player protagonist_player,
-      int game_solver
+      int game_solver,
+      VarMgrOptions var_mgr_options = VarMgrOptions(),
+      DfaConstructionOptions dfa_options = DfaConstructionOptions()
     );
 
+    /**
+     * \brief Constructs the synthesizer over a shared interface layout, e.g. one per partition of a batch.
+     */
+    LTLfPlusSynthesizerMP(
+      LTLfPlus ltlf_plus_formula,
+      InterfaceLayout layout,
+      Player starting_player,
+      Player protagonist_player,
+      int game_solver,
+      VarMgrOptions var_mgr_options = VarMgrOptions(),
+      DfaConstructionOptions dfa_options = DfaConstructionOptions()
+    );
+
+
+    /**
+     * \brief Returns the variable manager.
+     */
+    std::shared_ptr<VarMgr> var_mgr() const { return var_mgr_; }
 
     MPSynthesisResult run() const;
   };
@@ -2,24 +2,69 @@
 #define OBLIGATION_LTLF_PLUS_SYNTHESIZER_H
 
 #include "automata/SymbolicStateDfa.h"
+#include "automata/DfaSymmetry.h"
 #include "automata/ExplicitStateDfa.h"
+#include "game/AbstractionRefinement.h"
 #include "game/BuchiSolver.hpp"
+#include "game/ExplicitGameSolver.h"
+#include "game/FixpointTrace.h"
 #include "game/InputOutputPartition.h"
+#include "game/SCCDecomposer.h"
 #include "lydia/logic/ltlfplus/base.hpp"
 #include "automata/SymbolicStateDfa.h"
+#include "InterfaceLayout.h"
 #include "Synthesizer.h"
 #include "game/InputOutputPartition.h"
 #include "lydia/parser/ppltl/driver.hpp"
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 
+/**
+ * \brief Estimates the cost of the explicit and symbolic products of two DFAs of an obligation arena.
+ *
+ * The explicit MONA product is charged per estimated product state and alphabet
+ * variable, and again for each operand of the subformula still to be folded
+ * into it; the symbolic product is charged per state bit of its operands and
+ * variable its transition functions may depend on. Operands sharing alphabet
+ * variables are expected to have fewer reachable product states. Each decision
+ * is logged with both costs, so that the coefficients can be calibrated.
+ */
+struct ProductCostModel {
+    bool enabled = true;  // If false, the fixed threshold and symbolic_threshold decide
+    double explicit_state_cost = 1.0;  // Per product state and alphabet variable
+    double symbolic_node_cost = 4.0;  // Per state bit and support variable
+    double overlap_shrink = 0.5;  // Fraction of product states lost when the alphabets coincide
+    double minimisation_gain = 0.5;  // Fraction of product states kept by minimisation
+};
+
 struct MinimisationOptions {
     bool allow_minimisation = true;
     int threshold = 128;  // By default, only minimise small weak automata
     int symbolic_threshold = 128;
+    Syft::ProductMinimisationPolicy product_policy;  // When MONA products are minimised
+    Syft::StateEncodingKind state_encoding = Syft::StateEncodingKind::Binary;  // How DFAs are encoded once symbolic
+    Syft::FixpointMode fixpoint_mode = Syft::FixpointMode::Full;  // How the weak game solver iterates
+    bool realizability_only = false;  // Stop the solvers once the initial state is decided
+    Syft::SCCAlgorithm scc_algorithm = Syft::SCCAlgorithm::Naive;  // How the weak game solver peels SCC layers
+    Syft::ChainOptions scc_chain;  // Pivot selection of the chain SCC algorithm
+    std::size_t layer_threads = 1;  // Threads solving the independent SCCs of a weak game layer
+    bool reachable_states_only = false;  // Only decompose the weak game states reachable from the initial state
+    Syft::StrategyMinimization care_simplification = Syft::StrategyMinimization::Off;  // Simplify the arena outside its reachable states before solving (see SymbolicStateDfa::simplify_on_care)
+    ProductCostModel cost_model;  // Chooses between the explicit and symbolic product of each pair
+    bool reachable_products = true;  // Explicit products on the fly (see ExplicitStateDfa::dfa_product_reachable)
+    bool minimize_arena = false;  // Quotient the arena by bisimulation before solving (see SymbolicStateDfa::minimize)
+    bool pure_obligation_games = true;  // Solve all-safety and all-guarantee specs with one fixpoint (see ObligationLTLfPlusSynthesizer::run)
+    bool merge_product_sinks = true;  // Merge the rejecting (AND) or accepting (OR) sinks of symbolic products into one sink
+    bool compact_arena = true;  // Re-encode an arena with merged sinks in fewer state bits (see SymbolicStateDfa::compact)
+    std::size_t explicit_game_max_states = Syft::ExplicitGameSolver::default_max_states;  // Solve smaller explicit arenas without BDDs (see ObligationLTLfPlusSynthesizer::run); 0 disables
+    bool symmetry_reduction = false;  // Quotient the arena by the permutations of isomorphic colors (see SymmetryQuotient)
+    std::size_t symmetry_max_atoms = Syft::default_symmetry_max_atoms;  // Largest color DFAs compared for symmetry, in atoms
+    bool abstraction_refinement = false;  // Solve Buchi arenas with more state bits than below by abstraction refinement (see AbstractionRefinement)
+    std::size_t abstraction_max_visible_bits = Syft::AbstractionRefinementOptions().max_visible_bits;  // State bits left visible by the first abstraction
 };
 
 namespace CUDD {
@@ -54,6 +99,7 @@ namespace Syft {
          * \param use_buchi         if true, use Büchi-based (mode controlling further) solver; if false, use SCC-based weak-game solver
          * \param buechi_mode       which Büchi algorithm to use (if use_buchi is true)
          * \param allow_minimisation if true, allows minimisation of intermediate DFAs to save memory
+         * \param var_mgr_options   sizing, limits and reordering policy of the BDD manager
          */
         ObligationLTLfPlusSynthesizer(
             LTLfPlus ltlf_plus_formula,
@@ -63,12 +109,43 @@ namespace Syft {
             bool use_buchi = false,
             Syft::BuchiSolver::BuchiMode buechi_mode = Syft::BuchiSolver::BuchiMode::CLASSIC,
             MinimisationOptions minimisation_options = MinimisationOptions(),
-            bool use_balanced_boolean_product = true
+            bool use_balanced_boolean_product = true,
+            VarMgrOptions var_mgr_options = VarMgrOptions()
         );
 
+        /**
+         * Construct an ObligationLTLfPlusSynthesizer over a shared interface layout, e.g. one per partition of a batch.
+         */
+        ObligationLTLfPlusSynthesizer(
+            LTLfPlus ltlf_plus_formula,
+            InterfaceLayout layout,
+            Player starting_player,
+            Player protagonist_player,
+            bool use_buchi = false,
+            Syft::BuchiSolver::BuchiMode buechi_mode = Syft::BuchiSolver::BuchiMode::CLASSIC,
+            MinimisationOptions minimisation_options = MinimisationOptions(),
+            bool use_balanced_boolean_product = true,
+            VarMgrOptions var_mgr_options = VarMgrOptions()
+        );
+
+        /**
+         * \brief Returns the variable manager.
+         */
+        std::shared_ptr<VarMgr> var_mgr() const { return var_mgr_; }
+
         /**
          * Run the synthesizer.
          *
+         * Unless disabled in the minimisation options, a spec whose colors all
+         * share one quantifier and whose color formula has no negation is solved
+         * with a single fixpoint on the arena: a safety game for A colors and a
+         * reachability game for E colors, skipping the Büchi or weak game solver.
+         *
+         * An arena that is still an explicit DFA of at most
+         * explicit_game_max_states states (see ExplicitGameSolver::applicable)
+         * is solved by the ExplicitGameSolver instead, for the same condition,
+         * and its winning strategy is returned as a transducer.
+         *
          * \return result in ELSynthesisResult format.
          */
         ELSynthesisResult run() const;
@@ -93,9 +170,26 @@ namespace Syft {
          *
          * The returned map has per-color final BDDs under their color key and
          * the combined/evaluated final-states of the whole arena under key -1.
+         *
+         * If \a explicit_arena is given and the arena is an explicit DFA the
+         * ExplicitGameSolver applies to, it is stored there and the symbolic
+         * arena is its plain conversion, neither minimized nor compacted.
+         *
+         * With symmetry_reduction, colors in orbits (see find_color_orbits) are
+         * instead combined by build_symmetric_arena.
          */
         std::pair<SymbolicStateDfa, std::map<int, CUDD::BDD>>
-        convert_to_symbolic_dfa() const;
+        convert_to_symbolic_dfa(SharedExplicitStateDfa* explicit_arena = nullptr) const;
+
+        /**
+         * \brief Builds the quotient of the product of all color DFAs by the permutations of \a orbits.
+         *
+         * The members of each orbit are converted from renamed copies of its
+         * representative, and the final states are the color formula over the
+         * final states of the colors.
+         */
+        SymbolicStateDfa build_symmetric_arena(const std::map<int, SharedExplicitStateDfa>& color_to_dfa,
+                                               const std::vector<ColorOrbit>& orbits) const;
 
         /**
          * \brief Solve the synthesis problem by running the Büchi solver on the arena.
@@ -118,6 +212,32 @@ namespace Syft {
     ELSynthesisResult solve_with_buchi(const SymbolicStateDfa& arena,
                        const std::map<int, CUDD::BDD>& color_to_final_states) const;
 
+        /**
+         * \brief Returns the quantifier of every color if they all share one and the color formula has no negation.
+         *
+         * The final states of such an arena are then never re-entered once left
+         * (A colors) or never left once entered (E colors), so its Büchi
+         * condition is a safety or a reachability condition.
+         */
+        std::optional<whitemech::lydia::PrefixQuantifier> pure_obligation_quantifier() const;
+
+        /**
+         * \brief Solves the arena of a pure safety or guarantee spec with a single Safety or Reachability fixpoint.
+         */
+        ELSynthesisResult solve_pure_obligation(const SymbolicStateDfa& arena,
+                                                whitemech::lydia::PrefixQuantifier quantifier) const;
+
+        /**
+         * \brief Returns the condition the selected solver decides, for the ExplicitGameSolver.
+         */
+        ExplicitGameCondition explicit_condition() const;
+
+        /**
+         * \brief Solves \a explicit_arena with the ExplicitGameSolver; \a arena is its symbolic conversion.
+         */
+        ELSynthesisResult solve_explicit(const SymbolicStateDfa& arena,
+                                         const SharedExplicitStateDfa& explicit_arena) const;
+
         // --- helpers exposed because they're implemented in the .cpp ---
         /**
          * Parse a boolean color formula string like "(1 & 2) | 3" and build an explicit
@@ -141,7 +261,8 @@ namespace Syft {
          */
         SymbolicStateDfa build_arena_from_color_formula_hybrid(
             const std::string& color_formula,
-            const std::map<int, ExplicitStateDfa>& color_to_dfa) const;
+            const std::map<int, SharedExplicitStateDfa>& color_to_dfa,
+            SharedExplicitStateDfa* explicit_arena = nullptr) const;
 
         /**
          * (Optional) Evaluate a boolean color formula by substituting color integers
@@ -8,6 +8,7 @@
 #include <game/EmersonLei.hpp>
 
 #include "automata/SymbolicStateDfa.h"
+#include "automata/ppltl/PPLTLDfaLibrary.h"
 #include "Synthesizer.h"
 #include "game/InputOutputPartition.h"
 #include "lydia/parser/ppltl/driver.hpp"
@@ -47,18 +48,44 @@ namespace Syft {
              */
             std::string color_formula_;
             mutable std::shared_ptr<EmersonLei> emerson_lei_;
+            PPLTLVariableOrder variable_order_ = PPLTLVariableOrder::Creation;
+            std::shared_ptr<const PPLTLDfaLibrary> dfa_library_;
+            StrategyMinimization care_simplification_ = StrategyMinimization::Off;
 
         public:
             /**
              * \brief Construct an f.
+             *
+             * \param var_mgr_options Sizing, limits and reordering policy of the BDD manager.
              */
             PPLTLfPlusSynthesizer(
                 PPLTLPlus ppltl_plus_formula,
                 InputOutputPartition partition,
                 Player starting_player,
-                Player protagonist_player
+                Player protagonist_player,
+                VarMgrOptions var_mgr_options = VarMgrOptions()
             );
 
+            /**
+             * \brief Returns the variable manager.
+             */
+            std::shared_ptr<VarMgr> var_mgr() const { return var_mgr_; }
+
+            /**
+             * \brief Sets where the state variables of the DFAs go in the variable order.
+             */
+            void set_variable_order(PPLTLVariableOrder order) { variable_order_ = order; }
+
+            /**
+             * \brief Loads the DFAs of the colors whose PPLTL argument is in \a library instead of building them.
+             */
+            void set_dfa_library(std::shared_ptr<const PPLTLDfaLibrary> library) { dfa_library_ = std::move(library); }
+
+            /**
+             * \brief Simplifies the transitions and colors with \a method on the reachable states, over which the game is then solved (see SymbolicStateDfa::simplify_on_care).
+             */
+            void set_care_simplification(StrategyMinimization method) { care_simplification_ = method; }
+
             /**
              * \brief Run the synthesis algorithm.
              */
@@ -7,6 +7,7 @@
 
 
 #include "automata/SymbolicStateDfa.h"
+#include "automata/ppltl/PPLTLDfaLibrary.h"
 #include "Synthesizer.h"
 #include "game/InputOutputPartition.h"
 #include "lydia/parser/ppltl/driver.hpp"
@@ -14,6 +15,8 @@
 #include "lydia/logic/pp_pnf.hpp"
 #include "lydia/parser/ppltlplus/driver.hpp"
 #include "lydia/utils/print.hpp"
+#include <string>
+#include <utility>
 
 namespace Syft {
   class PPLTLfPlusSynthesizerMP {
@@ -26,6 +29,10 @@ namespace Syft {
     std::vector<int> F_colors_;
     std::vector<int> G_colors_;
     int game_solver_;
+    std::string work_directory_;
+    PPLTLVariableOrder variable_order_ = PPLTLVariableOrder::Creation;
+    std::shared_ptr<const PPLTLDfaLibrary> dfa_library_;
+    StrategyMinimization care_simplification_ = StrategyMinimization::Off;
 
   public:
   PPLTLfPlusSynthesizerMP(
@@ -33,10 +40,38 @@ namespace Syft {
       InputOutputPartition partition,
       Player starting_player,
       Player protagonist_player,
-      int game_solver
+      int game_solver,
+      VarMgrOptions var_mgr_options = VarMgrOptions()
     );
 
 
+    /**
+     * \brief Returns the variable manager.
+     */
+    std::shared_ptr<VarMgr> var_mgr() const { return var_mgr_; }
+
+    /**
+     * \brief Solves the Manna-Pnueli DAG by worker processes sharing \a directory (see MannaPnueli::set_work_directory).
+     */
+    void set_work_directory(std::string directory) { work_directory_ = std::move(directory); }
+
+    /**
+     * \brief Sets where the state variables of the DFAs go in the variable order.
+     */
+    void set_variable_order(PPLTLVariableOrder order) { variable_order_ = order; }
+
+    /**
+     * \brief Loads the DFAs of the colors whose PPLTL argument is in \a library instead of building them.
+     *
+     * Forall colors, whose DFAs drop the self loops of their initial state, are still built.
+     */
+    void set_dfa_library(std::shared_ptr<const PPLTLDfaLibrary> library) { dfa_library_ = std::move(library); }
+
+    /**
+     * \brief Simplifies the transitions and colors with \a method on the reachable states, over which the game is then solved (see SymbolicStateDfa::simplify_on_care).
+     */
+    void set_care_simplification(StrategyMinimization method) { care_simplification_ = method; }
+
     MPSynthesisResult run() const;
   };
 }
@@ -48,6 +48,18 @@ namespace Syft {
          * \brief The simple Stability assumption represented as a Boolean formula \beta over input variables, denoting FG\beta
          */
         CUDD::BDD assumption_;
+        /**
+         * \brief How the nested fixpoints iterate.
+         */
+        FixpointMode fixpoint_mode_ = FixpointMode::Full;
+        /**
+         * \brief The inner iterations of the last run.
+         */
+        mutable FixpointTrace fixpoint_trace_;
+        /**
+         * \brief The outer iterations of the last run.
+         */
+        mutable std::size_t outer_iterations_ = 0;
 
     protected:
         CUDD::BDD load_CNF(const std::string &filename) const;
@@ -76,6 +88,21 @@ namespace Syft {
          */
         SynthesisResult run() const;
 
+        /**
+         * \brief Selects how the nested fixpoints iterate; Full by default (see BuchiReachability::run).
+         */
+        void set_fixpoint_mode(FixpointMode mode);
+
+        /**
+         * \brief Returns the inner fixpoint iterations of the last run.
+         */
+        const FixpointTrace &fixpoint_trace() const;
+
+        /**
+         * \brief Returns the number of outer fixpoint iterations of the last run.
+         */
+        std::size_t outer_iterations() const;
+
     };
 
 }
@@ -0,0 +1,316 @@
+#include "BatchRunner.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace Syft {
+
+namespace {
+  namespace fs = std::filesystem;
+
+  std::string resolve(const fs::path& base, const std::string& file) {
+    fs::path path(file);
+    return path.is_relative() ? (base / path).lexically_normal().string() : file;
+  }
+
+  std::vector<BatchJob> jobs_of_directory(const fs::path& root) {
+    std::vector<fs::path> formulas;
+    for (const fs::directory_entry& entry : fs::recursive_directory_iterator(root)) {
+      if (entry.is_regular_file() && entry.path().extension() == ".ltlfplus") {
+        formulas.push_back(entry.path());
+      }
+    }
+    std::sort(formulas.begin(), formulas.end());
+    std::vector<BatchJob> jobs;
+    for (const fs::path& formula : formulas) {
+      fs::path partition = formula;
+      partition.replace_extension(".part");
+      if (!fs::exists(partition)) {
+        throw std::runtime_error("Error: No partition file " + partition.string() + " for " + formula.string());
+      }
+      BatchJob job;
+      job.id = fs::relative(formula, root).replace_extension().string();
+      job.formula_file = formula.string();
+      job.partition_file = partition.string();
+      jobs.push_back(std::move(job));
+    }
+    return jobs;
+  }
+
+  BatchResult result_from_json(const std::string& json) {
+    JsonObject object = parse_json_object(json);
+    BatchResult result;
+    auto text = [&](const std::string& name) {
+      const JsonValue* value = json_field(object, name, JsonValue::Kind::String, 1);
+      return value ? value->text : std::string();
+    };
+    auto number = [&](const std::string& name) {
+      const JsonValue* value = json_field(object, name, JsonValue::Kind::Number, 1);
+      return value ? value->number : 0.0;
+    };
+    result.id = text("id");
+    result.verdict = text("verdict");
+    result.detail = text("detail");
+    result.wall_time = number("wall_time");
+    result.cpu_time = number("cpu_time");
+    return result;
+  }
+
+  bool write_all(int fd, const std::string& data) {
+    std::size_t written = 0;
+    while (written < data.size()) {
+      ssize_t n = write(fd, data.data() + written, data.size() - written);
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      if (n <= 0) {
+        return false;
+      }
+      written += static_cast<std::size_t>(n);
+    }
+    return true;
+  }
+
+  std::string exit_description(int status) {
+    if (WIFSIGNALED(status)) {
+      return "the batch worker was killed by signal " + std::to_string(WTERMSIG(status));
+    }
+    return "the batch worker exited with status " + std::to_string(WIFEXITED(status) ? WEXITSTATUS(status) : -1) +
+           " before reporting the job";
+  }
+}
+
+std::string BatchResult::to_json() const {
+  std::ostringstream out;
+  out << "{\"id\": " << json_quote(id) << ", \"verdict\": " << json_quote(verdict)
+      << ", \"wall_time\": " << wall_time << ", \"cpu_time\": " << cpu_time;
+  if (!detail.empty()) {
+    out << ", \"detail\": " << json_quote(detail);
+  }
+  out << "}";
+  return out.str();
+}
+
+BatchJob batch_job_from_json(const JsonObject& object, const std::string& base_directory, std::size_t line) {
+  static const std::vector<std::string> known = {"id", "formula", "partition", "starting_player", "game_solver",
+                                                 "obligation_simplification", "buechi_mode", "time_limit"};
+  for (const auto& [name, value] : object) {
+    if (std::find(known.begin(), known.end(), name) == known.end()) {
+      throw std::runtime_error("Error: Unknown field \"" + name + "\" on line " + std::to_string(line));
+    }
+  }
+  BatchJob job;
+  const JsonValue* formula = json_field(object, "formula", JsonValue::Kind::String, line);
+  const JsonValue* partition = json_field(object, "partition", JsonValue::Kind::String, line);
+  if (!formula || !partition) {
+    throw std::runtime_error("Error: A job needs a formula and a partition on line " + std::to_string(line));
+  }
+  job.formula_file = resolve(base_directory, formula->text);
+  job.partition_file = resolve(base_directory, partition->text);
+  const JsonValue* id = json_field(object, "id", JsonValue::Kind::String, line);
+  job.id = id ? id->text : formula->text;
+  if (const JsonValue* value = json_field(object, "starting_player", JsonValue::Kind::Number, line)) {
+    job.starting_player = static_cast<int>(value->number);
+  }
+  if (const JsonValue* value = json_field(object, "game_solver", JsonValue::Kind::Number, line)) {
+    job.game_solver = static_cast<int>(value->number);
+  }
+  if (const JsonValue* value = json_field(object, "obligation_simplification", JsonValue::Kind::Bool, line)) {
+    job.obligation_simplification = value->kind == JsonValue::Kind::Bool ? value->boolean : value->number != 0;
+  }
+  if (const JsonValue* value = json_field(object, "buechi_mode", JsonValue::Kind::String, line)) {
+    job.buechi_mode = value->text;
+  }
+  if (const JsonValue* value = json_field(object, "time_limit", JsonValue::Kind::Number, line)) {
+    job.time_limit = value->number;
+  }
+  return job;
+}
+
+std::vector<BatchJob> read_batch_manifest(const std::string& path) {
+  if (fs::is_directory(path)) {
+    return jobs_of_directory(path);
+  }
+  std::ifstream in(path);
+  if (!in.is_open()) {
+    throw std::runtime_error("Error: Could not open batch manifest: " + path);
+  }
+  fs::path base = fs::path(path).parent_path();
+  std::vector<BatchJob> jobs;
+  std::string line;
+  for (std::size_t line_number = 1; std::getline(in, line); ++line_number) {
+    if (line.find_first_not_of(" \t\r") == std::string::npos) {
+      continue;
+    }
+    jobs.push_back(batch_job_from_json(parse_json_object(line, line_number), base.string(), line_number));
+  }
+  return jobs;
+}
+
+BatchResult solve_batch_job(const BatchJob& job, const std::function<BatchResult(const BatchJob&)>& solve) {
+  auto start = std::chrono::steady_clock::now();
+  const std::clock_t cpu_start = std::clock();
+  BatchResult result;
+  try {
+    result = solve(job);
+  } catch (const std::exception& e) {
+    result.verdict = "ERROR";
+    result.detail = e.what();
+  } catch (...) {
+    result.verdict = "ERROR";
+    result.detail = "unknown error";
+  }
+  result.id = job.id;
+  result.wall_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  result.cpu_time = double(std::clock() - cpu_start) / double(CLOCKS_PER_SEC);
+  return result;
+}
+
+BatchRunner::BatchRunner(std::size_t workers)
+    : workers_(workers) {}
+
+std::size_t BatchRunner::run(const std::vector<BatchJob>& jobs, const Solver& solve, const Reporter& report) const {
+  if (workers_ > 1 && jobs.size() > 1) {
+    return run_pool(jobs, solve, report);
+  }
+  std::size_t solved = 0;
+  for (const BatchJob& job : jobs) {
+    BatchResult result = solve_batch_job(job, solve);
+    solved += result.verdict != "ERROR";
+    report(result);
+  }
+  return solved;
+}
+
+std::size_t BatchRunner::run_pool(const std::vector<BatchJob>& jobs, const Solver& solve,
+                                  const Reporter& report) const {
+  struct Worker {
+    pid_t pid;
+    int fd;
+    std::string buffer;
+    int status = 0;
+  };
+  std::size_t workers = std::min(workers_, jobs.size());
+
+  // Buffered output would otherwise be written once by every child
+  std::cout.flush();
+  std::cerr.flush();
+  std::fflush(nullptr);
+
+  std::map<std::size_t, Worker> pool;
+  for (std::size_t k = 0; k < workers; ++k) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+      continue;
+    }
+    pid_t pid = fork();
+    if (pid < 0) {
+      close(fds[0]);
+      close(fds[1]);
+      continue;
+    }
+    if (pid == 0) {
+      close(fds[0]);
+      for (const auto& [index, worker] : pool) {
+        close(worker.fd);
+      }
+      int status = 0;
+      for (std::size_t i = k; i < jobs.size(); i += workers) {
+        std::string line = std::to_string(i) + " " + solve_batch_job(jobs[i], solve).to_json() + "\n";
+        if (!write_all(fds[1], line)) {
+          status = 1;
+          break;
+        }
+      }
+      std::fflush(nullptr);
+      _exit(status);
+    }
+    close(fds[1]);
+    pool.emplace(k, Worker{pid, fds[0], "", 0});
+  }
+
+  std::vector<bool> reported(jobs.size(), false);
+  std::size_t solved = 0;
+  std::size_t open = pool.size();
+  while (open > 0) {
+    std::vector<pollfd> fds;
+    std::vector<Worker*> polled;
+    for (auto& [index, worker] : pool) {
+      if (worker.fd >= 0) {
+        fds.push_back(pollfd{worker.fd, POLLIN, 0});
+        polled.push_back(&worker);
+      }
+    }
+    if (poll(fds.data(), fds.size(), -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break;
+    }
+    for (std::size_t p = 0; p < fds.size(); ++p) {
+      if (fds[p].revents == 0) {
+        continue;
+      }
+      Worker& worker = *polled[p];
+      char chunk[4096];
+      ssize_t n = read(worker.fd, chunk, sizeof(chunk));
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      if (n <= 0) {
+        close(worker.fd);
+        worker.fd = -1;
+        --open;
+        continue;
+      }
+      worker.buffer.append(chunk, static_cast<std::size_t>(n));
+      std::size_t newline;
+      while ((newline = worker.buffer.find('\n')) != std::string::npos) {
+        std::string line = worker.buffer.substr(0, newline);
+        worker.buffer.erase(0, newline + 1);
+        std::size_t space = line.find(' ');
+        std::size_t index = std::stoul(line.substr(0, space));
+        BatchResult result = result_from_json(line.substr(space + 1));
+        reported.at(index) = true;
+        solved += result.verdict != "ERROR";
+        report(result);
+      }
+    }
+  }
+  for (auto& [index, worker] : pool) {
+    if (worker.fd >= 0) {
+      close(worker.fd);
+    }
+    while (waitpid(worker.pid, &worker.status, 0) < 0 && errno == EINTR) {}
+  }
+
+  for (std::size_t i = 0; i < jobs.size(); ++i) {
+    if (reported[i]) {
+      continue;
+    }
+    auto worker = pool.find(i % workers);
+    BatchResult result;
+    result.id = jobs[i].id;
+    result.verdict = "ERROR";
+    result.detail = worker == pool.end() ? "no batch worker could be started for the job"
+                                         : exit_description(worker->second.status);
+    report(result);
+  }
+  return solved;
+}
+
+}
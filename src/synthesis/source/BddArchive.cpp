@@ -0,0 +1,287 @@
+#include "BddArchive.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "dddmp.h"
+
+namespace Syft {
+
+namespace {
+  const std::string archive_magic = "lydiasyft-bdd-archive 1";
+  const std::string el_result_kind = "el-synthesis-result";
+
+  void collect_preorder(ZielonkaNode* node, std::vector<ZielonkaNode*>& nodes) {
+    nodes.push_back(node);
+    for (ZielonkaNode* child : node->children) {
+      collect_preorder(child, nodes);
+    }
+  }
+
+  std::vector<ZielonkaNode*> preorder_nodes(ZielonkaTree* tree) {
+    std::vector<ZielonkaNode*> nodes;
+    if (tree != nullptr && tree->get_root() != nullptr) {
+      collect_preorder(tree->get_root(), nodes);
+    }
+    return nodes;
+  }
+}
+
+void BddArchive::save(const std::string& filename, const std::shared_ptr<VarMgr>& var_mgr) const {
+  std::ofstream out(filename, std::ios::binary);
+  if (!out.is_open()) {
+    throw std::runtime_error("Could not open file for writing: " + filename);
+  }
+
+  std::vector<bool> in_layout(var_mgr->total_variable_count(), false);
+  std::vector<bool> in_support(var_mgr->total_variable_count(), !support_only);
+  if (support_only) {
+    for (const CUDD::BDD& bdd : bdds) {
+      for (unsigned int index : bdd.SupportIndices()) {
+        in_support[index] = true;
+      }
+    }
+  }
+  out << archive_magic << "\n";
+  out << "kind " << kind << "\n";
+  out << "variables " << var_mgr->total_variable_count() << "\n";
+
+  auto write_named = [&](const std::string& section, const std::vector<std::string>& labels) {
+    std::vector<std::pair<int, std::string>> named;
+    for (const std::string& label : labels) {
+      int index = var_mgr->name_to_variable(label).NodeReadIndex();
+      if (in_support[index]) {
+        named.emplace_back(index, label);
+      }
+    }
+    out << section << " " << named.size();
+    for (const auto& [index, label] : named) {
+      in_layout[index] = true;
+      out << " " << index << " " << label;
+    }
+    out << "\n";
+  };
+  write_named("inputs", var_mgr->input_variable_labels());
+  write_named("outputs", var_mgr->output_variable_labels());
+
+  std::vector<CUDD::BDD> state_variables = var_mgr->get_state_variables(automaton_id);
+  out << "states " << state_variables.size();
+  for (const CUDD::BDD& var : state_variables) {
+    in_layout[var.NodeReadIndex()] = true;
+    out << " " << var.NodeReadIndex();
+  }
+  out << "\n";
+
+  out << "values " << values.size();
+  for (int value : values) {
+    out << " " << value;
+  }
+  out << "\n";
+  out << "bdds " << bdds.size() << "\n";
+  out.close();
+
+  // Variables outside the layout could not be matched on load
+  for (const CUDD::BDD& bdd : bdds) {
+    for (unsigned int index : bdd.SupportIndices()) {
+      if (!in_layout[index]) {
+        throw std::runtime_error("BDD archive " + filename +
+                                 ": BDD depends on variables outside the alphabet and state space");
+      }
+    }
+  }
+
+  if (bdds.empty()) {
+    return;
+  }
+
+  std::FILE* fp = std::fopen(filename.c_str(), "ab");
+  if (fp == nullptr) {
+    throw std::runtime_error("Could not open file for writing: " + filename);
+  }
+  std::vector<DdNode*> roots;
+  for (const CUDD::BDD& bdd : bdds) {
+    roots.push_back(bdd.getNode());
+  }
+  int status = Dddmp_cuddBddArrayStore(var_mgr->cudd_mgr()->getManager(), nullptr,
+                                       static_cast<int>(roots.size()), roots.data(),
+                                       nullptr, nullptr, nullptr, DDDMP_MODE_BINARY,
+                                       DDDMP_VARIDS, nullptr, fp);
+  std::fclose(fp);
+  if (status != DDDMP_SUCCESS) {
+    throw std::runtime_error("Could not store BDDs in " + filename);
+  }
+}
+
+BddArchive BddArchive::load(const std::string& filename,
+                            const std::shared_ptr<VarMgr>& var_mgr,
+                            std::optional<std::size_t> automaton_id) {
+  std::ifstream in(filename, std::ios::binary);
+  if (!in.is_open()) {
+    throw std::runtime_error("Could not open file for reading: " + filename);
+  }
+
+  std::string line;
+  std::getline(in, line);
+  if (line != archive_magic) {
+    throw std::runtime_error("Not a BDD archive: " + filename);
+  }
+
+  std::string token;
+  auto expect = [&](const std::string& keyword) {
+    in >> token;
+    if (!in || token != keyword) {
+      throw std::runtime_error("Malformed BDD archive " + filename + ": expected " + keyword);
+    }
+  };
+
+  BddArchive archive;
+  std::size_t count;
+  std::size_t variable_count;
+  expect("kind");
+  in >> archive.kind;
+  expect("variables");
+  in >> variable_count;
+
+  // Index of each stored variable in var_mgr
+  std::vector<int> compose_ids(variable_count, 0);
+  auto map_variable = [&](int stored_index, int index) {
+    if (stored_index < 0 || static_cast<std::size_t>(stored_index) >= variable_count) {
+      throw std::runtime_error("Malformed BDD archive " + filename + ": variable index out of range");
+    }
+    compose_ids[stored_index] = index;
+  };
+
+  for (const std::string& section : {"inputs", "outputs"}) {
+    expect(section);
+    in >> count;
+    for (std::size_t i = 0; i < count && in; ++i) {
+      int stored_index;
+      std::string name;
+      in >> stored_index >> name;
+      try {
+        map_variable(stored_index, var_mgr->name_to_variable(name).NodeReadIndex());
+      } catch (const std::out_of_range&) {
+        throw std::runtime_error("BDD archive " + filename + " uses unknown variable " + name);
+      }
+    }
+  }
+
+  expect("states");
+  in >> count;
+  if (automaton_id) {
+    if (var_mgr->state_variable_count(*automaton_id) != count) {
+      throw std::runtime_error("BDD archive " + filename + ": " + std::to_string(count) +
+                               " state variables, expected " +
+                               std::to_string(var_mgr->state_variable_count(*automaton_id)));
+    }
+    archive.automaton_id = *automaton_id;
+  } else {
+    archive.automaton_id = var_mgr->create_state_variables(count);
+  }
+  std::vector<CUDD::BDD> state_variables = var_mgr->get_state_variables(archive.automaton_id);
+  for (std::size_t i = 0; i < count && in; ++i) {
+    int stored_index;
+    in >> stored_index;
+    map_variable(stored_index, state_variables[i].NodeReadIndex());
+  }
+
+  expect("values");
+  in >> count;
+  archive.values.resize(count);
+  for (std::size_t i = 0; i < count && in; ++i) {
+    in >> archive.values[i];
+  }
+
+  expect("bdds");
+  in >> count;
+  if (!in) {
+    throw std::runtime_error("Malformed BDD archive " + filename);
+  }
+  in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+  std::streamoff offset = in.tellg();
+  in.close();
+
+  if (count == 0) {
+    return archive;
+  }
+
+  std::FILE* fp = std::fopen(filename.c_str(), "rb");
+  if (fp == nullptr || std::fseek(fp, offset, SEEK_SET) != 0) {
+    if (fp != nullptr) {
+      std::fclose(fp);
+    }
+    throw std::runtime_error("Could not open file for reading: " + filename);
+  }
+  DdManager* dd = var_mgr->cudd_mgr()->getManager();
+  DdNode** roots = nullptr;
+  int root_count = Dddmp_cuddBddArrayLoad(dd, DDDMP_ROOT_MATCHLIST, nullptr,
+                                          DDDMP_VAR_COMPOSEIDS, nullptr, nullptr, compose_ids.data(),
+                                          DDDMP_MODE_DEFAULT, nullptr, fp, &roots);
+  std::fclose(fp);
+
+  for (int i = 0; i < root_count; ++i) {
+    archive.bdds.emplace_back(*var_mgr->cudd_mgr(), roots[i]);
+    Cudd_RecursiveDeref(dd, roots[i]);
+  }
+  std::free(roots);
+  if (root_count < 0 || static_cast<std::size_t>(root_count) != count) {
+    throw std::runtime_error("Could not load BDDs from " + filename);
+  }
+
+  return archive;
+}
+
+void save_el_synthesis_result(const std::string& filename,
+                              const std::shared_ptr<VarMgr>& var_mgr,
+                              std::size_t automaton_id,
+                              const ELSynthesisResult& result) {
+  std::vector<ZielonkaNode*> nodes = preorder_nodes(result.z_tree.get());
+
+  BddArchive archive;
+  archive.kind = el_result_kind;
+  archive.automaton_id = automaton_id;
+  archive.values = {result.realizability ? 1 : 0, static_cast<int>(nodes.size())};
+  archive.bdds.push_back(result.winning_states);
+  for (ZielonkaNode* node : nodes) {
+    archive.values.push_back(static_cast<int>(node->winningmoves.size()));
+    archive.bdds.insert(archive.bdds.end(), node->winningmoves.begin(), node->winningmoves.end());
+  }
+  archive.save(filename, var_mgr);
+}
+
+void load_el_synthesis_result(const std::string& filename,
+                              const std::shared_ptr<VarMgr>& var_mgr,
+                              std::size_t automaton_id,
+                              ELSynthesisResult& result) {
+  BddArchive archive = BddArchive::load(filename, var_mgr, automaton_id);
+  if (archive.kind != el_result_kind || archive.values.size() < 2 || archive.bdds.empty()) {
+    throw std::runtime_error("Not an EL synthesis result: " + filename);
+  }
+
+  result.realizability = archive.values[0] != 0;
+  result.winning_states = archive.bdds[0];
+  if (result.z_tree == nullptr) {
+    return;
+  }
+
+  std::vector<ZielonkaNode*> nodes = preorder_nodes(result.z_tree.get());
+  std::size_t node_count = static_cast<std::size_t>(archive.values[1]);
+  if (nodes.size() != node_count || archive.values.size() != 2 + node_count) {
+    throw std::runtime_error("EL synthesis result " + filename + " does not match the Zielonka tree");
+  }
+  std::size_t next_bdd = 1;
+  for (std::size_t i = 0; i < node_count; ++i) {
+    std::size_t move_count = static_cast<std::size_t>(archive.values[2 + i]);
+    if (next_bdd + move_count > archive.bdds.size()) {
+      throw std::runtime_error("Malformed EL synthesis result " + filename);
+    }
+    nodes[i]->winningmoves.assign(archive.bdds.begin() + next_bdd, archive.bdds.begin() + next_bdd + move_count);
+    next_bdd += move_count;
+  }
+}
+
+}
@@ -0,0 +1,104 @@
+#include "BddBackend.h"
+
+#include <stdexcept>
+#include <utility>
+
+namespace Syft {
+
+namespace {
+  class CuddBackend final : public BddBackend {
+   private:
+
+    std::shared_ptr<CUDD::Cudd> mgr_;
+
+   public:
+
+    explicit CuddBackend(std::shared_ptr<CUDD::Cudd> mgr) : mgr_(std::move(mgr)) {}
+
+    std::string name() const override {
+      return "cudd";
+    }
+
+    std::size_t threads() const override {
+      return 1;
+    }
+
+    CUDD::BDD And(const CUDD::BDD& f, const CUDD::BDD& g) const override {
+      return f & g;
+    }
+
+    CUDD::BDD Or(const CUDD::BDD& f, const CUDD::BDD& g) const override {
+      return f | g;
+    }
+
+    CUDD::BDD ExistAbstract(const CUDD::BDD& f, const CUDD::BDD& cube) const override {
+      return f.ExistAbstract(cube);
+    }
+
+    CUDD::BDD UnivAbstract(const CUDD::BDD& f, const CUDD::BDD& cube) const override {
+      return f.UnivAbstract(cube);
+    }
+
+    CUDD::BDD AndAbstract(const CUDD::BDD& f, const CUDD::BDD& g, const CUDD::BDD& cube) const override {
+      return f.AndAbstract(g, cube);
+    }
+
+    CUDD::BDD VectorCompose(const CUDD::BDD& f, const std::vector<CUDD::BDD>& vector) const override {
+      return f.VectorCompose(vector);
+    }
+
+    bool Eval(const CUDD::BDD& f, const std::vector<int>& assignment) const override {
+      return f.Eval(const_cast<int*>(assignment.data())).IsOne();
+    }
+  };
+}
+
+CUDD::BDD BddBackend::LeastFixpoint(const ControllableFixpoint& fixpoint) const {
+  CUDD::BDD iterate = fixpoint.start;
+  for (std::size_t step = 1; ; ++step) {
+    if (fixpoint.on_iteration) {
+      fixpoint.on_iteration();
+    }
+    CUDD::BDD predecessors = VectorCompose(iterate, fixpoint.vector);
+    for (const BddQuantifier& quantifier : fixpoint.quantifiers) {
+      predecessors = quantifier.universal ? UnivAbstract(predecessors, quantifier.cube)
+                                          : ExistAbstract(predecessors, quantifier.cube);
+    }
+    CUDD::BDD next = Or(iterate, And(fixpoint.care, predecessors));
+    if (next == iterate || !And(next, fixpoint.stop).IsZero() || step == fixpoint.max_steps) {
+      return next;
+    }
+    iterate = next;
+  }
+}
+
+BddBackendKind bdd_backend_from_string(const std::string& name) {
+  if (name == "cudd") {
+    return BddBackendKind::Cudd;
+  } else if (name == "sylvan") {
+#ifdef LYDIASYFT_WITH_SYLVAN
+    return BddBackendKind::Sylvan;
+#else
+    throw std::runtime_error("Error: Built without Sylvan, configure with -DLYDIASYFT_ENABLE_SYLVAN=ON");
+#endif
+  }
+  throw std::runtime_error("Error: Unknown BDD backend: " + name);
+}
+
+std::unique_ptr<BddBackend> make_bdd_backend(BddBackendKind kind, std::shared_ptr<CUDD::Cudd> mgr,
+                                             std::size_t threads) {
+  switch (kind) {
+    case BddBackendKind::Cudd:
+      return std::make_unique<CuddBackend>(std::move(mgr));
+    case BddBackendKind::Sylvan:
+#ifdef LYDIASYFT_WITH_SYLVAN
+      return make_sylvan_backend(std::move(mgr), threads);
+#else
+      static_cast<void>(threads);
+      throw std::runtime_error("Error: Built without Sylvan, configure with -DLYDIASYFT_ENABLE_SYLVAN=ON");
+#endif
+  }
+  throw std::runtime_error("Error: Unknown BDD backend");
+}
+
+}
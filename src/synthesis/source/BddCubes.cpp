@@ -0,0 +1,57 @@
+#include "BddCubes.h"
+
+#include <stdexcept>
+#include <utility>
+
+namespace Syft {
+
+BddCubes::BddCubes(const CUDD::BDD& bdd) : bdd_(bdd) {
+  CUDD_VALUE_TYPE value;
+  generator_ = Cudd_FirstCube(bdd_.manager(), bdd_.getNode(), &cube_, &value);
+  if (generator_ == nullptr) {
+    throw std::runtime_error("Error: Cannot enumerate the cubes of a BDD");
+  }
+  done_ = Cudd_IsGenEmpty(generator_) != 0;
+}
+
+BddCubes::~BddCubes() {
+  if (generator_ != nullptr) {
+    Cudd_GenFree(generator_);
+  }
+}
+
+void BddCubes::next() {
+  CUDD_VALUE_TYPE value;
+  done_ = Cudd_NextCube(generator_, &cube_, &value) == 0;
+}
+
+MintermPicker::MintermPicker(std::shared_ptr<CUDD::Cudd> mgr, const std::vector<CUDD::BDD>& variables)
+    : mgr_(std::move(mgr)), variables_(variables) {
+  for (const CUDD::BDD& variable : variables_) {
+    nodes_.push_back(variable.getNode());
+    indices_.push_back(static_cast<int>(variable.NodeReadIndex()));
+  }
+}
+
+CUDD::BDD MintermPicker::pick(const CUDD::BDD& bdd) const {
+  BddCubes cubes(bdd);
+  if (cubes.empty()) {
+    throw std::runtime_error("Error: Cannot pick a minterm of the zero BDD");
+  }
+  return minterm(*cubes.begin());
+}
+
+CUDD::BDD MintermPicker::minterm(const int* cube) const {
+  std::vector<int> phases(indices_.size());
+  for (std::size_t i = 0; i < indices_.size(); ++i) {
+    phases[i] = cube[indices_[i]] == 0 ? 0 : 1;
+  }
+  DdNode* node = Cudd_bddComputeCube(mgr_->getManager(), const_cast<DdNode**>(nodes_.data()), phases.data(),
+                                     static_cast<int>(nodes_.size()));
+  if (node == nullptr) {
+    throw std::runtime_error("Error: Cannot build a minterm");
+  }
+  return CUDD::BDD(*mgr_, node);
+}
+
+}
@@ -0,0 +1,194 @@
+#include "BenchmarkFamilies.h"
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace Syft {
+
+namespace {
+  std::string numbered(const std::string& prefix, std::size_t i) {
+    return prefix + std::to_string(i);
+  }
+
+  std::vector<std::string> numbered(const std::string& prefix, std::size_t first, std::size_t last) {
+    std::vector<std::string> names;
+    for (std::size_t i = first; i <= last; ++i) {
+      names.push_back(numbered(prefix, i));
+    }
+    return names;
+  }
+
+  // The parenthesized operands, joined by op; "true" if there are none
+  std::string join(const std::vector<std::string>& operands, const std::string& op) {
+    if (operands.empty()) {
+      return "true";
+    }
+    std::string joined;
+    for (const std::string& operand : operands) {
+      joined += (joined.empty() ? "(" : " " + op + " (") + operand + ")";
+    }
+    return joined;
+  }
+
+  // Infinitely often p, and from some point on always p: some or all prefixes end with p
+  std::string recurrently(const std::string& p) {
+    return "AE(F(" + p + " & X(false)))";
+  }
+
+  std::string persistently(const std::string& p) {
+    return "EA(F(" + p + " & X(false)))";
+  }
+
+  BenchmarkInstance make_instance(const std::string& family, std::size_t size, std::string formula,
+                                  const std::vector<std::string>& inputs, const std::vector<std::string>& outputs,
+                                  bool realizable, bool obligation) {
+    if (size == 0) {
+      throw std::runtime_error("Error: Benchmark family " + family + " starts at size 1");
+    }
+    BenchmarkInstance instance;
+    instance.family = family;
+    instance.size = size;
+    instance.formula = std::move(formula);
+    instance.partition = InputOutputPartition::construct_from_input(inputs, outputs);
+    instance.realizable = realizable;
+    instance.obligation = obligation;
+    return instance;
+  }
+
+  // The bits b0 (least significant) to b<n-1> start at 0 and count the steps with inc
+  std::string counter_arena(std::size_t n) {
+    std::vector<std::string> zero, steps;
+    for (std::size_t i = 0; i < n; ++i) {
+      std::string bit = numbered("b", i);
+      std::vector<std::string> carry = {"inc"};
+      for (std::size_t j = 0; j < i; ++j) {
+        carry.push_back(numbered("b", j));
+      }
+      std::string flips = join(carry, "&");
+      zero.push_back("!" + bit);
+      steps.push_back("((" + flips + ") -> ((" + bit + " -> X(!" + bit + ")) & (!" + bit + " -> X(" + bit + ")))) & "
+                      "(!(" + flips + ") -> ((" + bit + " -> X(" + bit + ")) & (!" + bit + " -> X(!" + bit + "))))");
+    }
+    return "A(" + join(zero, "&") + ") & A(G(" + join(steps, "&") + "))";
+  }
+
+  BenchmarkInstance counter(std::size_t n, bool assumption) {
+    std::vector<std::string> bits = numbered("b", 0, n - 1);
+    std::string maximum = "E(F(" + join(bits, "&") + "))";
+    std::string formula = counter_arena(n) + " & " +
+                          (assumption ? "(" + recurrently("inc") + " -> " + maximum + ")" : maximum);
+    return make_instance(assumption ? "counter" : "counter-unrealizable", n, formula, {"inc"}, bits, assumption,
+                         !assumption);
+  }
+
+  BenchmarkInstance obligation_chain(std::size_t n, bool realizable) {
+    std::vector<std::string> conjuncts;
+    for (std::size_t i = 1; i <= n; ++i) {
+      // A request answered by a grant, as a positive combination of A and E
+      conjuncts.push_back("A(G(!" + numbered("r", i) + ")) | E(F(" + numbered("g", i) + "))");
+    }
+    for (std::size_t i = 1; i < n; ++i) {
+      conjuncts.push_back("A(G(!(" + numbered("g", i) + " & " + numbered("g", i + 1) + ")))");
+    }
+    if (!realizable) {
+      conjuncts.push_back("A(G(r1 -> !g1))");
+    }
+    return make_instance(realizable ? "obligation-chain" : "obligation-chain-unrealizable", n,
+                         join(conjuncts, "&"), numbered("r", 1, n), numbered("g", 1, n), realizable, true);
+  }
+
+  BenchmarkInstance gr1(std::size_t n, bool realizable) {
+    std::vector<std::string> assumptions, guarantees, exclusions;
+    for (std::size_t i = 1; i <= n; ++i) {
+      assumptions.push_back(recurrently(numbered("r", i)));
+      guarantees.push_back(recurrently(numbered("g", i)));
+      for (std::size_t j = i + 1; j <= n; ++j) {
+        exclusions.push_back("A(G(!(" + numbered("g", i) + " & " + numbered("g", j) + ")))");
+      }
+    }
+    std::vector<std::string> conjuncts = {"(" + join(assumptions, "&") + ") -> (" + join(guarantees, "&") + ")"};
+    conjuncts.insert(conjuncts.end(), exclusions.begin(), exclusions.end());
+    if (!realizable) {
+      conjuncts.push_back("A(G(r1 -> !g1))");
+    }
+    return make_instance(realizable ? "gr1" : "gr1-unrealizable", n, join(conjuncts, "&"), numbered("r", 1, n),
+                         numbered("g", 1, n), realizable, false);
+  }
+
+  BenchmarkInstance nested(std::size_t n, bool realizable) {
+    std::string formula = recurrently("g1");
+    for (std::size_t i = 2; i <= n; ++i) {
+      formula = persistently(numbered("r", i)) + " -> (" + recurrently(numbered("g", i)) + " & (" + formula + "))";
+    }
+    if (!realizable) {
+      formula = "(" + formula + ") & A(G(" + numbered("r", n) + " -> !" + numbered("g", n) + "))";
+    }
+    return make_instance(realizable ? "nested" : "nested-unrealizable", n, formula, numbered("r", 1, n),
+                         numbered("g", 1, n), realizable, false);
+  }
+}
+
+std::string BenchmarkInstance::id() const {
+  return family + "/" + std::to_string(size);
+}
+
+const std::vector<BenchmarkFamily>& benchmark_families() {
+  static const std::vector<BenchmarkFamily> families = {
+      {"counter", "n-bit counter incremented by the environment, reaching its maximum under recurrent increments",
+       [](std::size_t n) { return counter(n, true); }},
+      {"counter-unrealizable", "n-bit counter incremented by the environment, reaching its maximum",
+       [](std::size_t n) { return counter(n, false); }},
+      {"obligation-chain", "n eventual grants of eventual requests, consecutive grants exclusive",
+       [](std::size_t n) { return obligation_chain(n, true); }},
+      {"obligation-chain-unrealizable", "obligation-chain with the first grant forbidden while requested",
+       [](std::size_t n) { return obligation_chain(n, false); }},
+      {"gr1", "n recurrent requests imply n recurrent grants, pairwise exclusive",
+       [](std::size_t n) { return gr1(n, true); }},
+      {"gr1-unrealizable", "gr1 with the first grant forbidden while requested",
+       [](std::size_t n) { return gr1(n, false); }},
+      {"nested", "persistent requests implying recurrent grants, nested n deep",
+       [](std::size_t n) { return nested(n, true); }},
+      {"nested-unrealizable", "nested with the outermost grant forbidden while requested",
+       [](std::size_t n) { return nested(n, false); }}};
+  return families;
+}
+
+const BenchmarkFamily& benchmark_family(const std::string& name) {
+  for (const BenchmarkFamily& family : benchmark_families()) {
+    if (family.name == name) {
+      return family;
+    }
+  }
+  throw std::runtime_error("Error: Unknown benchmark family " + name);
+}
+
+FuzzSpec parse_instance(const BenchmarkInstance& instance, Player starting_player) {
+  return DifferentialFuzzer::parse(instance.formula, instance.partition, starting_player);
+}
+
+std::string write_instance(const BenchmarkInstance& instance, const std::string& directory) {
+  std::filesystem::path family_directory = std::filesystem::path(directory) / instance.family;
+  std::filesystem::create_directories(family_directory);
+  std::filesystem::path base = family_directory / (instance.family + "_" + std::to_string(instance.size));
+
+  std::ofstream formula_file(base.string() + ".ltlfplus");
+  formula_file << instance.formula << "\n";
+
+  std::ofstream partition_file(base.string() + ".part");
+  partition_file << ".inputs:";
+  for (const std::string& input : instance.partition.input_variables) {
+    partition_file << " " << input;
+  }
+  partition_file << "\n.outputs:";
+  for (const std::string& output : instance.partition.output_variables) {
+    partition_file << " " << output;
+  }
+  partition_file << "\n";
+  if (!formula_file || !partition_file) {
+    throw std::runtime_error("Error: Cannot write " + base.string());
+  }
+  return base.string() + ".ltlfplus";
+}
+
+}
@@ -0,0 +1,318 @@
+#include "DifferentialFuzzer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+
+#include <lydia/logic/pnf.hpp>
+#include <spdlog/spdlog.h>
+
+#include "FlatJson.h"
+#include "ObligationFragmentDetector.h"
+#include "SolveBudget.h"
+#include "synthesizer/LTLfPlusSynthesizer.h"
+#include "synthesizer/LTLfPlusSynthesizerMP.h"
+#include "synthesizer/ObligationLTLfPlusSynthesizer.h"
+
+namespace Syft {
+
+namespace {
+  double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+  }
+
+  FuzzConfiguration emerson_lei_configuration(std::string name, bool parity, bool decompose,
+                                              bool symbolic_colors = false, bool scc_layers = false) {
+    return FuzzConfiguration{std::move(name), [parity, decompose, symbolic_colors, scc_layers](
+        const FuzzSpec& spec, const VarMgrOptions& options) {
+      DfaConstructionOptions dfa_options;
+      dfa_options.parity_solver = parity;
+      dfa_options.symbolic_colors = symbolic_colors;
+      dfa_options.scc_layers = scc_layers;
+      dfa_options.decompose_components = decompose;
+      LTLfPlusSynthesizer synthesizer(spec.ltlf_plus, spec.partition, spec.starting_player, Player::Agent, options,
+                                      dfa_options);
+      return synthesizer.run().realizability;
+    }};
+  }
+
+  FuzzConfiguration manna_pnueli_configuration(std::string name, int game_solver) {
+    return FuzzConfiguration{std::move(name), [game_solver](const FuzzSpec& spec, const VarMgrOptions& options) {
+      LTLfPlusSynthesizerMP synthesizer(spec.ltlf_plus, spec.partition, spec.starting_player, Player::Agent,
+                                        game_solver, options);
+      return synthesizer.run().realizability;
+    }};
+  }
+
+  FuzzConfiguration obligation_configuration(std::string name, std::optional<BuchiSolver::BuchiMode> mode) {
+    return FuzzConfiguration{std::move(name), [mode](const FuzzSpec& spec, const VarMgrOptions& options) {
+      ObligationLTLfPlusSynthesizer synthesizer(spec.ltlf_plus, spec.partition, spec.starting_player, Player::Agent,
+                                                mode.has_value(), mode.value_or(BuchiSolver::BuchiMode::CLASSIC),
+                                                MinimisationOptions(), true, options);
+      return synthesizer.run().realizability;
+    }, true};
+  }
+
+  std::vector<FuzzConfiguration> all_configurations() {
+    return {
+        emerson_lei_configuration("emerson-lei", false, true),
+        emerson_lei_configuration("emerson-lei-monolithic", false, false),
+        emerson_lei_configuration("parity", true, true),
+        emerson_lei_configuration("symbolic-colors", false, true, true),
+        emerson_lei_configuration("scc-layers", false, true, false, true),
+        manna_pnueli_configuration("manna-pnueli", 1),
+        manna_pnueli_configuration("manna-pnueli-adv", 2),
+        obligation_configuration("obligation-wg", std::nullopt),
+        obligation_configuration("obligation-cl", BuchiSolver::BuchiMode::CLASSIC),
+        obligation_configuration("obligation-pm", BuchiSolver::BuchiMode::PITERMAN),
+        obligation_configuration("obligation-cb", BuchiSolver::BuchiMode::COBUCHI),
+        obligation_configuration("obligation-lb", BuchiSolver::BuchiMode::LAYERED)};
+  }
+}
+
+RandomSpecGenerator::RandomSpecGenerator(unsigned int seed, std::size_t atoms)
+    : random_(seed) {
+  for (std::size_t i = 0; i < std::max<std::size_t>(atoms, 1); ++i) {
+    atoms_.push_back("p" + std::to_string(i));
+  }
+}
+
+bool RandomSpecGenerator::chance(double p) {
+  return std::uniform_real_distribution<double>(0, 1)(random_) < p;
+}
+
+const std::string& RandomSpecGenerator::any_atom() {
+  return atoms_[std::uniform_int_distribution<std::size_t>(0, atoms_.size() - 1)(random_)];
+}
+
+std::string RandomSpecGenerator::ltlf(std::size_t depth) {
+  if (depth == 0 || chance(0.3)) {
+    return (chance(0.3) ? "!" : "") + any_atom();
+  }
+  switch (std::uniform_int_distribution<int>(0, 6)(random_)) {
+    case 0:
+      return "(" + ltlf(depth - 1) + " & " + ltlf(depth - 1) + ")";
+    case 1:
+      return "(" + ltlf(depth - 1) + " | " + ltlf(depth - 1) + ")";
+    case 2:
+      return "X(" + ltlf(depth - 1) + ")";
+    case 3:
+      return "F(" + ltlf(depth - 1) + ")";
+    case 4:
+      return "G(" + ltlf(depth - 1) + ")";
+    case 5:
+      return "(" + ltlf(depth - 1) + " U " + ltlf(depth - 1) + ")";
+    default:
+      return "(" + ltlf(depth - 1) + " -> " + ltlf(depth - 1) + ")";
+  }
+}
+
+std::string RandomSpecGenerator::ltlf_plus(std::size_t boolean_depth, std::size_t ltlf_depth, bool obligation) {
+  if (boolean_depth == 0 || chance(0.4)) {
+    static const char* const quantifiers[] = {"A", "E", "AE", "EA"};
+    int quantifier = std::uniform_int_distribution<int>(0, obligation ? 1 : 3)(random_);
+    return std::string(quantifiers[quantifier]) + "(" + ltlf(ltlf_depth) + ")";
+  }
+  std::string left = ltlf_plus(boolean_depth - 1, ltlf_depth, obligation);
+  std::string right = ltlf_plus(boolean_depth - 1, ltlf_depth, obligation);
+  return "(" + left + (chance(0.5) ? " & " : " | ") + right + ")";
+}
+
+InputOutputPartition RandomSpecGenerator::partition() {
+  std::vector<std::string> shuffled = atoms_;
+  std::shuffle(shuffled.begin(), shuffled.end(), random_);
+  std::size_t split = shuffled.size() < 2
+                          ? shuffled.size()
+                          : std::uniform_int_distribution<std::size_t>(1, shuffled.size() - 1)(random_);
+  return InputOutputPartition::construct_from_input(
+      std::vector<std::string>(shuffled.begin(), shuffled.begin() + split),
+      std::vector<std::string>(shuffled.begin() + split, shuffled.end()));
+}
+
+std::vector<std::string> fuzz_configuration_names() {
+  std::vector<std::string> names;
+  for (const FuzzConfiguration& configuration : all_configurations()) {
+    names.push_back(configuration.name);
+  }
+  return names;
+}
+
+std::vector<FuzzConfiguration> fuzz_configurations(const std::vector<std::string>& names) {
+  std::vector<FuzzConfiguration> known = all_configurations();
+  std::vector<FuzzConfiguration> configurations;
+  for (const std::string& name : names) {
+    auto found = std::find_if(known.begin(), known.end(), [&name](const FuzzConfiguration& configuration) {
+      return configuration.name == name;
+    });
+    if (found == known.end()) {
+      throw std::runtime_error("Error: Unknown fuzzing configuration " + name);
+    }
+    configurations.push_back(*found);
+  }
+  return configurations;
+}
+
+DifferentialFuzzer::DifferentialFuzzer(std::vector<FuzzConfiguration> configurations, FuzzOptions options)
+    : configurations_(std::move(configurations)), options_(std::move(options)) {
+  if (configurations_.size() < 2) {
+    throw std::runtime_error("Error: A differential fuzzer needs at least two configurations");
+  }
+  if (!options_.corpus_directory.empty()) {
+    std::filesystem::create_directories(options_.corpus_directory);
+  }
+}
+
+FuzzSpec DifferentialFuzzer::parse(const std::string& formula, const InputOutputPartition& partition,
+                                   Player starting_player) {
+  FuzzSpec spec;
+  spec.formula = formula;
+  spec.partition = partition;
+  spec.starting_player = starting_player;
+  spec.driver = std::make_shared<whitemech::lydia::parsers::ltlfplus::LTLfPlusDriver>();
+  std::stringstream stream(formula);
+  spec.driver->parse(stream);
+  auto parsed = std::static_pointer_cast<const whitemech::lydia::LTLfPlusFormula>(spec.driver->get_result());
+  spec.obligation = ObligationFragmentDetector::isObligationFragment(parsed);
+
+  auto pnf = whitemech::lydia::get_pnf_result(*parsed);
+  spec.ltlf_plus.color_formula_ = pnf.color_formula_;
+  spec.ltlf_plus.formula_to_color_ = pnf.subformula_to_color_;
+  spec.ltlf_plus.formula_to_quantification_ = pnf.subformula_to_quantifier_;
+  return spec;
+}
+
+std::pair<std::optional<bool>, double> DifferentialFuzzer::measure(std::size_t index, const FuzzSpec& spec) const {
+  VarMgrOptions var_mgr_options = options_.var_mgr_options;
+  var_mgr_options.budget.set_time_limit(
+      std::chrono::milliseconds(static_cast<long long>(options_.time_limit * 1000)));
+  auto start = std::chrono::steady_clock::now();
+  std::optional<bool> verdict;
+  try {
+    verdict = configurations_[index].solve(spec, var_mgr_options);
+  } catch (const BudgetExceeded&) {
+    return {std::nullopt, options_.time_limit};
+  }
+  return {verdict, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()};
+}
+
+FuzzOutcome DifferentialFuzzer::run(const FuzzSpec& spec, const std::string& id) const {
+  FuzzOutcome outcome;
+  outcome.id = id;
+  std::size_t count = configurations_.size();
+  outcome.verdicts.resize(count);
+  outcome.seconds.assign(count, 0);
+  outcome.applicable.assign(count, false);
+  for (std::size_t i = 0; i < count; ++i) {
+    if (configurations_[i].obligation_only && !spec.obligation) {
+      continue;
+    }
+    outcome.applicable[i] = true;
+    std::tie(outcome.verdicts[i], outcome.seconds[i]) = measure(i, spec);
+  }
+
+  std::optional<bool> first_verdict;
+  for (const std::optional<bool>& verdict : outcome.verdicts) {
+    if (verdict && first_verdict && *verdict != *first_verdict) {
+      outcome.mismatch = true;
+    }
+    first_verdict = first_verdict ? first_verdict : verdict;
+  }
+
+  auto differential = [&outcome, count]() {
+    bool found = false;
+    for (std::size_t i = 0; i < count; ++i) {
+      if (!outcome.applicable[i]) {
+        continue;
+      }
+      if (!found || outcome.seconds[i] < outcome.seconds[outcome.fastest]) {
+        outcome.fastest = i;
+      }
+      if (!found || outcome.seconds[i] > outcome.seconds[outcome.slowest]) {
+        outcome.slowest = i;
+      }
+      found = true;
+    }
+    // The timer resolution bounds the ratio of runs that took no measurable time
+    outcome.differential = found ? outcome.seconds[outcome.slowest] /
+                                   std::max(outcome.seconds[outcome.fastest], 1e-6) : 1;
+    return found;
+  };
+  bool suspected = differential() && outcome.differential >= options_.differential &&
+                   outcome.seconds[outcome.slowest] >= options_.min_seconds;
+
+  // A suspected cliff is measured again, since a single run may be a hiccup of the machine
+  if (suspected && options_.repeats > 1) {
+    for (std::size_t i = 0; i < count; ++i) {
+      if (!outcome.applicable[i]) {
+        continue;
+      }
+      std::vector<double> seconds = {outcome.seconds[i]};
+      for (std::size_t repeat = 1; repeat < options_.repeats; ++repeat) {
+        seconds.push_back(measure(i, spec).second);
+      }
+      outcome.seconds[i] = median(seconds);
+    }
+    differential();
+  }
+  outcome.cliff = suspected && outcome.differential >= options_.differential &&
+                  outcome.seconds[outcome.slowest] >= options_.min_seconds;
+
+  if (outcome.mismatch || outcome.cliff) {
+    spdlog::info("[DifferentialFuzzer] {}: {}{}, {} is {:.1f}x slower than {}", id,
+                 outcome.mismatch ? "verdict mismatch" : "performance cliff",
+                 outcome.mismatch && outcome.cliff ? " and performance cliff" : "",
+                 configurations_[outcome.slowest].name, outcome.differential,
+                 configurations_[outcome.fastest].name);
+    save(spec, outcome);
+  }
+  return outcome;
+}
+
+void DifferentialFuzzer::save(const FuzzSpec& spec, const FuzzOutcome& outcome) const {
+  if (options_.corpus_directory.empty()) {
+    return;
+  }
+  std::filesystem::path base = std::filesystem::path(options_.corpus_directory) /
+                               ((outcome.mismatch ? "mismatch_" : "cliff_") + outcome.id);
+  std::ofstream formula_file(base.string() + ".ltlfplus");
+  formula_file << spec.formula << "\n";
+
+  std::ofstream partition_file(base.string() + ".part");
+  partition_file << ".inputs:";
+  for (const std::string& input : spec.partition.input_variables) {
+    partition_file << " " << input;
+  }
+  partition_file << "\n.outputs:";
+  for (const std::string& output : spec.partition.output_variables) {
+    partition_file << " " << output;
+  }
+  partition_file << "\n";
+
+  std::ofstream json_file(base.string() + ".json");
+  json_file << "{\"id\": " << json_quote(outcome.id)
+            << ", \"starting_player\": " << json_quote(spec.starting_player == Player::Agent ? "agent" : "environment")
+            << ", \"mismatch\": " << (outcome.mismatch ? "true" : "false")
+            << ", \"differential\": " << outcome.differential << ", \"runs\": [";
+  bool first = true;
+  for (std::size_t i = 0; i < configurations_.size(); ++i) {
+    if (!outcome.applicable[i]) {
+      continue;
+    }
+    const std::optional<bool>& verdict = outcome.verdicts[i];
+    json_file << (first ? "" : ", ") << "{\"configuration\": " << json_quote(configurations_[i].name)
+              << ", \"verdict\": " << json_quote(!verdict ? "UNKNOWN" : *verdict ? "REALIZABLE" : "UNREALIZABLE")
+              << ", \"seconds\": " << outcome.seconds[i] << "}";
+    first = false;
+  }
+  json_file << "]}\n";
+  if (!formula_file || !partition_file || !json_file) {
+    spdlog::warn("[DifferentialFuzzer::save] cannot write {}", base.string());
+  }
+}
+
+}
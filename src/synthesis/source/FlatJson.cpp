@@ -0,0 +1,214 @@
+#include "FlatJson.h"
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace Syft {
+
+namespace {
+  class FlatJsonReader {
+   public:
+
+    FlatJsonReader(const std::string& text, std::size_t line) : text_(text), line_(line) {}
+
+    JsonObject object() {
+      JsonObject result;
+      expect('{');
+      if (peek() == '}') {
+        ++pos_;
+      } else {
+        while (true) {
+          std::string key = string();
+          expect(':');
+          if (!result.emplace(key, value()).second) {
+            fail("duplicate field \"" + key + "\"");
+          }
+          char separator = next();
+          if (separator == '}') {
+            break;
+          }
+          if (separator != ',') {
+            fail("expected ',' or '}'");
+          }
+        }
+      }
+      if (peek() != '\0') {
+        fail("trailing characters after the object");
+      }
+      return result;
+    }
+
+   private:
+
+    const std::string& text_;
+    std::size_t line_;
+    std::size_t pos_ = 0;
+
+    [[noreturn]] void fail(const std::string& message) const {
+      throw std::runtime_error("Error: Invalid JSON on line " + std::to_string(line_) + ": " + message);
+    }
+
+    char peek() {
+      while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+        ++pos_;
+      }
+      return pos_ < text_.size() ? text_[pos_] : '\0';
+    }
+
+    char next() {
+      char c = peek();
+      if (c == '\0') {
+        fail("unexpected end of line");
+      }
+      ++pos_;
+      return c;
+    }
+
+    void expect(char c) {
+      if (next() != c) {
+        fail(std::string("expected '") + c + "'");
+      }
+    }
+
+    bool literal(const std::string& word) {
+      if (text_.compare(pos_, word.size(), word) != 0) {
+        return false;
+      }
+      pos_ += word.size();
+      return true;
+    }
+
+    static void append_utf8(std::string& out, unsigned code) {
+      if (code < 0x80) {
+        out += static_cast<char>(code);
+      } else if (code < 0x800) {
+        out += static_cast<char>(0xC0 | (code >> 6));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+      } else {
+        out += static_cast<char>(0xE0 | (code >> 12));
+        out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+      }
+    }
+
+    std::string string() {
+      expect('"');
+      std::string result;
+      while (true) {
+        if (pos_ >= text_.size()) {
+          fail("unterminated string");
+        }
+        char c = text_[pos_++];
+        if (c == '"') {
+          return result;
+        }
+        if (c != '\\') {
+          result += c;
+          continue;
+        }
+        if (pos_ >= text_.size()) {
+          fail("unterminated string");
+        }
+        char escaped = text_[pos_++];
+        switch (escaped) {
+          case '"': case '\\': case '/': result += escaped; break;
+          case 'b': result += '\b'; break;
+          case 'f': result += '\f'; break;
+          case 'n': result += '\n'; break;
+          case 'r': result += '\r'; break;
+          case 't': result += '\t'; break;
+          case 'u': {
+            if (pos_ + 4 > text_.size()) {
+              fail("truncated \\u escape");
+            }
+            std::string hex = text_.substr(pos_, 4);
+            char* end = nullptr;
+            unsigned code = static_cast<unsigned>(std::strtoul(hex.c_str(), &end, 16));
+            if (end != hex.c_str() + 4) {
+              fail("invalid \\u escape");
+            }
+            pos_ += 4;
+            append_utf8(result, code);
+            break;
+          }
+          default:
+            fail(std::string("invalid escape \\") + escaped);
+        }
+      }
+    }
+
+    JsonValue value() {
+      JsonValue result;
+      char c = peek();
+      if (c == '"') {
+        result.kind = JsonValue::Kind::String;
+        result.text = string();
+      } else if (literal("true")) {
+        result.kind = JsonValue::Kind::Bool;
+        result.boolean = true;
+      } else if (literal("false")) {
+        result.kind = JsonValue::Kind::Bool;
+      } else if (literal("null")) {
+        result.kind = JsonValue::Kind::Null;
+      } else if (c == '-' || std::isdigit(static_cast<unsigned char>(c))) {
+        const char* begin = text_.c_str() + pos_;
+        char* end = nullptr;
+        result.kind = JsonValue::Kind::Number;
+        result.number = std::strtod(begin, &end);
+        if (end == begin) {
+          fail("invalid number");
+        }
+        pos_ += end - begin;
+      } else if (c == '{' || c == '[') {
+        fail("nested values are not supported");
+      } else {
+        fail("expected a value");
+      }
+      return result;
+    }
+  };
+}
+
+JsonObject parse_json_object(const std::string& text, std::size_t line) {
+  return FlatJsonReader(text, line).object();
+}
+
+const JsonValue* json_field(const JsonObject& object, const std::string& name, JsonValue::Kind kind,
+                            std::size_t line) {
+  auto it = object.find(name);
+  if (it == object.end() || it->second.kind == JsonValue::Kind::Null) {
+    return nullptr;
+  }
+  // Booleans may also be written 0 or 1, as on the command line
+  bool as_bool = kind == JsonValue::Kind::Bool && it->second.kind == JsonValue::Kind::Number;
+  if (it->second.kind != kind && !as_bool) {
+    throw std::runtime_error("Error: Field \"" + name + "\" has the wrong type on line " + std::to_string(line));
+  }
+  return &it->second;
+}
+
+std::string json_quote(const std::string& text) {
+  std::string result = "\"";
+  for (char c : text) {
+    switch (c) {
+      case '"': result += "\\\""; break;
+      case '\\': result += "\\\\"; break;
+      case '\n': result += "\\n"; break;
+      case '\r': result += "\\r"; break;
+      case '\t': result += "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char code[8];
+          std::snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned>(static_cast<unsigned char>(c)));
+          result += code;
+        } else {
+          result += c;
+        }
+    }
+  }
+  return result + "\"";
+}
+
+}
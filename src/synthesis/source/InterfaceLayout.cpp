@@ -0,0 +1,51 @@
+#include "InterfaceLayout.h"
+
+#include <stdexcept>
+#include <unordered_set>
+#include <utility>
+
+#include "VariableOrdering.h"
+
+namespace Syft {
+
+InterfaceLayout::InterfaceLayout(InputOutputPartition partition) {
+  auto layout = std::make_shared<Layout>();
+  layout->order.reserve(partition.input_variables.size() + partition.output_variables.size());
+  layout->order.insert(layout->order.end(), partition.input_variables.begin(), partition.input_variables.end());
+  layout->order.insert(layout->order.end(), partition.output_variables.begin(), partition.output_variables.end());
+  std::unordered_set<std::string> seen;
+  for (const std::string& name : layout->order) {
+    if (!seen.insert(name).second) {
+      throw std::runtime_error("Error: Variable " + name + " is listed twice in the partition");
+    }
+  }
+  layout->partition = std::move(partition);
+  layout_ = std::move(layout);
+}
+
+InterfaceLayout InterfaceLayout::read_from_file(const std::string& filename) {
+  return InterfaceLayout(InputOutputPartition::read_from_file(filename));
+}
+
+std::vector<std::string> InterfaceLayout::variable_order(const LTLfPlus& formula, PropositionOrder order) const {
+  if (order == PropositionOrder::Force) {
+    return force_order(layout_->order, ltlf_plus_hyperedges(formula));
+  }
+  return layout_->order;
+}
+
+std::shared_ptr<VarMgr> InterfaceLayout::instantiate(const VarMgrOptions& options,
+                                                     const std::vector<std::string>& order) const {
+  auto var_mgr = std::make_shared<VarMgr>(options);
+  var_mgr->create_named_variables(order);
+  var_mgr->partition_variables(layout_->partition.input_variables, layout_->partition.output_variables);
+  var_mgr->input_cube();
+  var_mgr->output_cube();
+  return var_mgr;
+}
+
+std::shared_ptr<VarMgr> InterfaceLayout::instantiate(const VarMgrOptions& options) const {
+  return instantiate(options, layout_->order);
+}
+
+}
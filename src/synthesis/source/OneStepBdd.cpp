@@ -0,0 +1,159 @@
+#include "OneStepBdd.h"
+
+#include <lydia/logic/nnf.hpp>
+#include <lydia/visitor.hpp>
+#include <stdexcept>
+
+namespace Syft {
+
+    namespace {
+
+        // The letters of a formula in the first step: either exactly those of its
+        // one-letter traces, or, on NNF, those that may start a satisfying trace
+        class LettersVisitor : public whitemech::lydia::Visitor {
+        public:
+            LettersVisitor(const VarMgr &var_mgr, bool possible)
+                    : var_mgr_(var_mgr), possible_(possible), result_(var_mgr.cudd_mgr()->bddOne()) {}
+
+            void visit(const whitemech::lydia::LTLfTrue &) override {
+                result_ = var_mgr_.cudd_mgr()->bddOne();
+            }
+
+            void visit(const whitemech::lydia::LTLfFalse &) override {
+                result_ = var_mgr_.cudd_mgr()->bddZero();
+            }
+
+            void visit(const whitemech::lydia::LTLfAtom &formula) override {
+                result_ = var_mgr_.name_to_variable(formula.symbol->get_name());
+            }
+
+            void visit(const whitemech::lydia::LTLfNot &formula) override {
+                if (possible_ && !whitemech::lydia::is_a<const whitemech::lydia::LTLfAtom>(*formula.get_arg())) {
+                    throw std::logic_error("formula must be in NNF for the possible letters");
+                }
+                result_ = !apply(*formula.get_arg());
+            }
+
+            void visit(const whitemech::lydia::LTLfAnd &formula) override {
+                CUDD::BDD letters = var_mgr_.cudd_mgr()->bddOne();
+                for (const auto &arg: formula.get_args()) {
+                    letters &= apply(*arg);
+                    if (letters.IsZero()) {
+                        break;
+                    }
+                }
+                result_ = letters;
+            }
+
+            void visit(const whitemech::lydia::LTLfOr &formula) override {
+                CUDD::BDD letters = var_mgr_.cudd_mgr()->bddZero();
+                for (const auto &arg: formula.get_args()) {
+                    letters |= apply(*arg);
+                    if (letters.IsOne()) {
+                        break;
+                    }
+                }
+                result_ = letters;
+            }
+
+            // A one-letter trace has no next step; a longer trace may satisfy anything there
+            void visit(const whitemech::lydia::LTLfNext &) override {
+                result_ = possible_ ? var_mgr_.cudd_mgr()->bddOne() : var_mgr_.cudd_mgr()->bddZero();
+            }
+
+            void visit(const whitemech::lydia::LTLfWeakNext &) override {
+                result_ = var_mgr_.cudd_mgr()->bddOne();
+            }
+
+            void visit(const whitemech::lydia::LTLfUntil &formula) override {
+                if (!possible_) {
+                    result_ = apply(**formula.get_args().rbegin());
+                    return;
+                }
+                CUDD::BDD letters = var_mgr_.cudd_mgr()->bddZero();
+                for (const auto &arg: formula.get_args()) {
+                    letters |= apply(*arg);
+                }
+                result_ = letters;
+            }
+
+            void visit(const whitemech::lydia::LTLfRelease &formula) override {
+                result_ = apply(**formula.get_args().rbegin());
+            }
+
+            void visit(const whitemech::lydia::LTLfEventually &formula) override {
+                result_ = possible_ ? var_mgr_.cudd_mgr()->bddOne() : apply(*formula.get_arg());
+            }
+
+            void visit(const whitemech::lydia::LTLfAlways &formula) override {
+                result_ = apply(*formula.get_arg());
+            }
+
+            CUDD::BDD apply(const whitemech::lydia::LTLfFormula &formula) {
+                formula.accept(*this);
+                return result_;
+            }
+
+        private:
+            const VarMgr &var_mgr_;
+            bool possible_;
+            CUDD::BDD result_;
+        };
+    }
+
+    OneStepBdd::OneStepBdd(std::shared_ptr<VarMgr> var_mgr) : var_mgr_(std::move(var_mgr)) {}
+
+    CUDD::BDD OneStepBdd::satisfying_letters(const whitemech::lydia::LTLfFormula &formula) const {
+        LettersVisitor visitor(*var_mgr_, false);
+        return visitor.apply(formula);
+    }
+
+    CUDD::BDD OneStepBdd::possible_letters(const whitemech::lydia::LTLfFormula &formula) const {
+        LettersVisitor visitor(*var_mgr_, true);
+        return visitor.apply(*whitemech::lydia::to_nnf(formula));
+    }
+
+    std::optional<CUDD::BDD> OneStepBdd::realizable(const whitemech::lydia::LTLfFormula &formula) const {
+        // As the Z3 check: one move for every input, whoever plays first
+        CUDD::BDD moves = satisfying_letters(formula).UnivAbstract(var_mgr_->input_cube());
+        if (moves.IsZero()) {
+            return std::nullopt;
+        }
+        std::vector<CUDD::BDD> outputs;
+        for (const std::string &output: var_mgr_->output_variable_labels()) {
+            outputs.push_back(var_mgr_->name_to_variable(output));
+        }
+        return outputs.empty() ? moves : moves.PickOneMinterm(outputs);
+    }
+
+    bool OneStepBdd::unrealizable(const whitemech::lydia::LTLfFormula &formula, Player starting_player) const {
+        CUDD::BDD possible = possible_letters(formula);
+        CUDD::BDD winnable = starting_player == Player::Environment
+                             ? possible.ExistAbstract(var_mgr_->output_cube()).UnivAbstract(var_mgr_->input_cube())
+                             : possible.UnivAbstract(var_mgr_->input_cube()).ExistAbstract(var_mgr_->output_cube());
+        return winnable.IsZero();
+    }
+
+    std::optional<bool> OneStepBdd::constant_value(const whitemech::lydia::LTLfFormula &formula,
+                                                   whitemech::lydia::PrefixQuantifier quantifier) const {
+        if (possible_letters(formula).IsZero()) {
+            return false;
+        }
+        switch (quantifier) {
+            case whitemech::lydia::PrefixQuantifier::Exists:
+                if (satisfying_letters(formula).IsOne()) {
+                    return true;
+                }
+                break;
+            case whitemech::lydia::PrefixQuantifier::Forall:
+                if (satisfying_letters(formula).IsZero()) {
+                    return false;
+                }
+                break;
+            default:
+                break;
+        }
+        return std::nullopt;
+    }
+
+}
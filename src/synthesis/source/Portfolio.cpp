@@ -0,0 +1,136 @@
+#include "Portfolio.h"
+
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "SolveBudget.h"
+
+namespace Syft {
+
+namespace {
+  // Exit statuses of a child that reached a verdict
+  constexpr int realizable_status = 10;
+  constexpr int unrealizable_status = 20;
+  constexpr int failed_status = 1;
+  // Time a cancelled child gets to stop at its next budget check before being killed
+  constexpr auto cancellation_grace = std::chrono::seconds(1);
+  // Interval between two checks of the running children
+  constexpr auto child_poll = std::chrono::milliseconds(10);
+
+  void cancel_on_sigterm(int) {
+    SolveBudget::request_cancellation();
+  }
+}
+
+Portfolio::Portfolio(bool quiet_children)
+    : quiet_children_(quiet_children) {}
+
+void Portfolio::add(std::string name, std::function<bool()> solve) {
+  entries_.push_back(PortfolioEntry{std::move(name), std::move(solve)});
+}
+
+std::optional<PortfolioVerdict> Portfolio::run() const {
+  auto start = std::chrono::steady_clock::now();
+
+  // Buffered output would otherwise be written once by every child
+  std::cout.flush();
+  std::cerr.flush();
+  std::fflush(nullptr);
+
+  std::map<pid_t, std::size_t> running;
+  for (std::size_t i = 0; i < entries_.size(); ++i) {
+    pid_t pid = fork();
+    if (pid < 0) {
+      continue;
+    }
+    if (pid == 0) {
+      std::signal(SIGTERM, cancel_on_sigterm);
+      if (quiet_children_) {
+        int null_fd = open("/dev/null", O_WRONLY);
+        if (null_fd >= 0) {
+          dup2(null_fd, STDOUT_FILENO);
+          dup2(null_fd, STDERR_FILENO);
+          close(null_fd);
+        }
+      }
+      int status = failed_status;
+      try {
+        status = entries_[i].solve() ? realizable_status : unrealizable_status;
+      } catch (...) {
+        status = failed_status;
+      }
+      std::fflush(nullptr);
+      _exit(status);
+    }
+    running.emplace(pid, i);
+  }
+
+  if (running.empty()) {
+    throw std::runtime_error("Portfolio could not start any solver");
+  }
+
+  std::optional<PortfolioVerdict> verdict;
+  // Only the solvers' own pids are waited on: the portfolio may run in a process with other
+  // children, e.g. in the batch mode or the daemon, whose exit statuses belong to their owners
+  while (!running.empty() && !verdict) {
+    bool reaped = false;
+    for (auto it = running.begin(); it != running.end() && !verdict;) {
+      int status;
+      pid_t pid = waitpid(it->first, &status, WNOHANG);
+      if (pid == 0 || (pid < 0 && errno == EINTR)) {
+        ++it;
+        continue;
+      }
+      std::size_t index = it->second;
+      it = running.erase(it);
+      reaped = true;
+      if (pid > 0 && WIFEXITED(status) && (WEXITSTATUS(status) == realizable_status ||
+                                           WEXITSTATUS(status) == unrealizable_status)) {
+        verdict = PortfolioVerdict{
+            entries_[index].name,
+            WEXITSTATUS(status) == realizable_status,
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start)};
+      }
+    }
+    if (!reaped && !verdict) {
+      std::this_thread::sleep_for(child_poll);
+    }
+  }
+
+  // Cancel the losers: they stop at their next budget check, or are killed
+  for (const auto& [pid, index] : running) {
+    kill(pid, SIGTERM);
+  }
+  auto grace_end = std::chrono::steady_clock::now() + cancellation_grace;
+  while (!running.empty() && std::chrono::steady_clock::now() < grace_end) {
+    for (auto it = running.begin(); it != running.end();) {
+      if (waitpid(it->first, nullptr, WNOHANG) == it->first) {
+        it = running.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    std::this_thread::sleep_for(child_poll);
+  }
+  for (const auto& [pid, index] : running) {
+    kill(pid, SIGKILL);
+  }
+  for (const auto& [pid, index] : running) {
+    while (waitpid(pid, nullptr, 0) < 0 && errno == EINTR) {}
+  }
+
+  return verdict;
+}
+
+}
@@ -0,0 +1,204 @@
+#include "ResultCache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+#include <unistd.h>
+
+#include "lydia/utils/print.hpp"
+
+namespace Syft {
+
+namespace {
+  std::string quantifier_name(whitemech::lydia::PrefixQuantifier quantifier) {
+    switch (quantifier) {
+      case whitemech::lydia::PrefixQuantifier::ForallExists:
+        return "AE";
+      case whitemech::lydia::PrefixQuantifier::ExistsForall:
+        return "EA";
+      case whitemech::lydia::PrefixQuantifier::Forall:
+        return "A";
+      case whitemech::lydia::PrefixQuantifier::Exists:
+        return "E";
+    }
+    return "?";
+  }
+
+  std::vector<std::string> sorted(std::vector<std::string> names) {
+    std::sort(names.begin(), names.end());
+    return names;
+  }
+
+  // Whether \a labels are \a names in some order
+  bool same_variables(const std::vector<std::string>& labels, const std::vector<std::string>& names) {
+    return sorted(labels) == sorted(names);
+  }
+}
+
+ResultCache::ResultCache(std::string directory) : directory_(std::move(directory)) {
+  std::error_code error;
+  std::filesystem::create_directories(directory_, error);
+  if (error) {
+    throw std::runtime_error("Error: Cannot create result cache directory " + directory_ + ": " + error.message());
+  }
+}
+
+std::string ResultCache::cache_key(const LTLfPlus& spec, const InputOutputPartition& partition,
+                                   Player starting_player, const std::string& solver_options) {
+  std::vector<std::string> colors;
+  for (const auto& [formula, color] : spec.formula_to_color_) {
+    auto quantifier = spec.formula_to_quantification_.find(formula);
+    colors.push_back(color + " " +
+                     (quantifier == spec.formula_to_quantification_.end() ? "?" : quantifier_name(quantifier->second)) +
+                     " " + whitemech::lydia::to_string(*formula));
+  }
+  std::sort(colors.begin(), colors.end());
+
+  std::ostringstream key;
+  key << "solver: " << solver_options << "\n";
+  key << "starting: " << (starting_player == Player::Agent ? "agent" : "environment") << "\n";
+  key << "inputs:";
+  for (const std::string& input : sorted(partition.input_variables)) {
+    key << " " << input;
+  }
+  key << "\noutputs:";
+  for (const std::string& output : sorted(partition.output_variables)) {
+    key << " " << output;
+  }
+  key << "\ncondition: " << spec.color_formula_ << "\n";
+  for (const std::string& color : colors) {
+    key << "color: " << color << "\n";
+  }
+  return key.str();
+}
+
+std::string ResultCache::entry_path(const std::string& key) const {
+  std::ostringstream name;
+  name << std::hex << std::setw(16) << std::setfill('0') << std::hash<std::string>{}(key);
+  return (std::filesystem::path(directory_) / name.str()).string();
+}
+
+std::optional<CachedResult> ResultCache::load(const std::string& key, const InputOutputPartition* validate) const {
+  std::string path = entry_path(key);
+
+  // The verdict names the generation of the files of the entry, see store
+  std::ifstream verdict_file(path + ".verdict");
+  std::string verdict, generation, strategy_flag;
+  verdict_file >> verdict >> generation >> strategy_flag;
+  if (verdict != "REALIZABLE" && verdict != "UNREALIZABLE") {
+    return std::nullopt;
+  }
+  // Entries stored before generations keep their files under the entry path itself
+  std::string files = generation.empty() ? path : path + "." + generation;
+  std::ifstream key_file(files + ".key", std::ios::binary);
+  if (!key_file) {
+    return std::nullopt;
+  }
+  std::string stored_key((std::istreambuf_iterator<char>(key_file)), std::istreambuf_iterator<char>());
+  if (stored_key != key) {
+    // Hash collision: the entry belongs to a different key
+    return std::nullopt;
+  }
+  CachedResult result;
+  result.realizability = verdict == "REALIZABLE";
+
+  std::string strategy_path = files + ".strategy";
+  if (generation.empty() ? std::filesystem::exists(strategy_path) : strategy_flag == "strategy") {
+    try {
+      result.strategy = CompiledTransducer::load(strategy_path);
+    } catch (const std::runtime_error& e) {
+      spdlog::warn("[ResultCache::load] cannot read strategy {}: {}", strategy_path, e.what());
+      // A strategy listed by the verdict is part of the entry, e.g. removed by a newer store
+      if (validate || !generation.empty()) {
+        return std::nullopt;
+      }
+    }
+  }
+  if (validate && result.strategy) {
+    // The controller must read the inputs and write the outputs of the partition, and step from its initial state
+    const CompiledTransducer& strategy = *result.strategy;
+    if (!same_variables(strategy.input_labels(), validate->input_variables) ||
+        !same_variables(strategy.output_labels(), validate->output_variables)) {
+      spdlog::warn("[ResultCache::load] the strategy of {} does not match the partition", path);
+      return std::nullopt;
+    }
+    CompiledTransducer::Instance instance = strategy.make_instance();
+    std::vector<std::uint8_t> inputs(strategy.input_count(), 0), outputs(strategy.output_count(), 0);
+    strategy.step(instance, inputs.data(), outputs.data());
+  }
+
+  spdlog::debug("[ResultCache::load] hit for {}", path);
+  return result;
+}
+
+void ResultCache::store(const std::string& key, bool realizability, const Transducer* strategy) const {
+  std::string path = entry_path(key);
+  // The key and the strategy go to files of a generation unique per writer, pid included as thread ids
+  // repeat across processes, and the verdict naming the generation is renamed into place last, so that
+  // concurrent runs sharing the directory only ever see one complete entry
+  std::ostringstream generation;
+  generation << getpid() << "-" << std::this_thread::get_id() << "-"
+             << std::chrono::steady_clock::now().time_since_epoch().count();
+  std::string files = path + "." + generation.str();
+  std::string verdict_tmp = files + ".verdict";
+  auto discard = [&]() {
+    std::remove((files + ".key").c_str());
+    std::remove((files + ".strategy").c_str());
+    std::remove(verdict_tmp.c_str());
+  };
+
+  bool has_strategy = false;
+  if (strategy) {
+    try {
+      CompiledTransducer(*strategy).save(files + ".strategy");
+      has_strategy = true;
+    } catch (const std::runtime_error& e) {
+      spdlog::warn("[ResultCache::store] storing the verdict of {} without its strategy: {}", path, e.what());
+      std::remove((files + ".strategy").c_str());
+    }
+  }
+  {
+    std::ofstream key_file(files + ".key", std::ios::binary | std::ios::trunc);
+    key_file << key;
+    std::ofstream verdict_file(verdict_tmp, std::ios::trunc);
+    verdict_file << (realizability ? "REALIZABLE" : "UNREALIZABLE") << " " << generation.str() << " "
+                 << (has_strategy ? "strategy" : "none") << "\n";
+    if (!key_file || !verdict_file) {
+      spdlog::warn("[ResultCache::store] cannot write cache entry {}", path);
+      discard();
+      return;
+    }
+  }
+
+  std::string previous;
+  {
+    std::ifstream previous_verdict(path + ".verdict");
+    std::string verdict;
+    previous_verdict >> verdict >> previous;
+  }
+  std::error_code error;
+  std::filesystem::rename(verdict_tmp, path + ".verdict", error);
+  if (error) {
+    spdlog::warn("[ResultCache::store] cannot commit cache entry {}: {}", path, error.message());
+    discard();
+    return;
+  }
+  // The files of the replaced entry; a reader still on them gets a miss
+  std::string replaced = previous.empty() ? path : path + "." + previous;
+  std::filesystem::remove(replaced + ".key", error);
+  std::filesystem::remove(replaced + ".strategy", error);
+}
+
+}
@@ -0,0 +1,83 @@
+#include "SolveBudget.h"
+
+#include <atomic>
+#include <fstream>
+#include <utility>
+
+#include <unistd.h>
+
+namespace Syft {
+
+namespace {
+  // Lock-free, so that it may be set from a signal handler
+  std::atomic<bool> cancellation_flag(false);
+}
+
+BudgetExceeded::BudgetExceeded(std::string resource, std::string phase, BddStatsSnapshot snapshot)
+    : std::runtime_error("Budget exceeded (" + resource + ") during " + phase),
+      resource_(std::move(resource)), phase_(std::move(phase)), snapshot_(std::move(snapshot)) {}
+
+const std::string& BudgetExceeded::resource() const {
+  return resource_;
+}
+
+const std::string& BudgetExceeded::phase() const {
+  return phase_;
+}
+
+const BddStatsSnapshot& BudgetExceeded::snapshot() const {
+  return snapshot_;
+}
+
+void SolveBudget::set_time_limit(std::chrono::milliseconds time_limit) {
+  deadline_ = std::chrono::steady_clock::now() + time_limit;
+}
+
+void SolveBudget::set_max_live_nodes(long max_live_nodes) {
+  max_live_nodes_ = max_live_nodes;
+}
+
+void SolveBudget::set_max_rss(std::size_t max_rss) {
+  max_rss_ = max_rss;
+}
+
+void SolveBudget::set_cancellation_token(std::shared_ptr<const std::atomic<bool>> token) {
+  cancellation_token_ = std::move(token);
+}
+
+void SolveBudget::check(const CUDD::Cudd& mgr, const std::string& phase) const {
+  std::string resource;
+  if (cancellation_requested() || (cancellation_token_ && cancellation_token_->load(std::memory_order_relaxed))) {
+    resource = "cancelled";
+  } else if (deadline_ && std::chrono::steady_clock::now() > *deadline_) {
+    resource = "time";
+  } else if (max_live_nodes_ > 0 && Cudd_ReadNodeCount(mgr.getManager()) > max_live_nodes_) {
+    resource = "nodes";
+  } else if (max_rss_ > 0 && current_rss() > max_rss_) {
+    resource = "memory";
+  } else {
+    return;
+  }
+  throw BudgetExceeded(resource, phase, SolverStats::read(mgr, phase));
+}
+
+void SolveBudget::request_cancellation() {
+  cancellation_flag.store(true, std::memory_order_relaxed);
+}
+
+bool SolveBudget::cancellation_requested() {
+  return cancellation_flag.load(std::memory_order_relaxed);
+}
+
+std::size_t SolveBudget::current_rss() {
+  // The second field of statm is the resident set size in pages
+  std::ifstream statm("/proc/self/statm");
+  std::size_t size = 0;
+  std::size_t resident = 0;
+  if (!(statm >> size >> resident)) {
+    return 0;
+  }
+  return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+}
+
+}
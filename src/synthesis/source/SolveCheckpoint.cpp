@@ -0,0 +1,163 @@
+#include "SolveCheckpoint.h"
+
+#include "BddArchive.h"
+
+#include <spdlog/spdlog.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace Syft {
+
+namespace {
+  namespace fs = std::filesystem;
+
+  const std::string game_kind = "checkpoint-game";
+  const std::string node_kind = "checkpoint-node";
+  const std::string root_kind = "checkpoint-root";
+
+  std::string node_file(int node) {
+    return "node-" + std::to_string(node) + ".result";
+  }
+
+  // Whether \a name is a file written by SolveCheckpoint, which attach may clear
+  bool checkpoint_file(const std::string& name) {
+    return name == "game.description" || name == "game.bdds" || name == "root.bounds" ||
+           (name.rfind("node-", 0) == 0 && name.find(".result") != std::string::npos);
+  }
+
+  // Readers only ever see complete files: each is written aside and renamed
+  void save_archive(const BddArchive& archive, const fs::path& path, const std::shared_ptr<VarMgr>& var_mgr) {
+    fs::path temporary = path.string() + ".tmp";
+    archive.save(temporary.string(), var_mgr);
+    fs::rename(temporary, path);
+  }
+
+  std::vector<CUDD::BDD> game_bdds(const SymbolicStateDfa& arena, const std::vector<CUDD::BDD>& colors,
+                                   const CUDD::BDD& state_space) {
+    std::vector<CUDD::BDD> bdds = arena.transition_function();
+    bdds.push_back(arena.initial_state_bdd());
+    bdds.insert(bdds.end(), colors.begin(), colors.end());
+    bdds.push_back(state_space);
+    return bdds;
+  }
+}
+
+SolveCheckpoint::SolveCheckpoint(std::string directory, std::shared_ptr<VarMgr> var_mgr,
+                                 std::chrono::seconds interval)
+  : directory_(std::move(directory)), var_mgr_(std::move(var_mgr)), interval_(interval),
+    last_root_save_(std::chrono::steady_clock::now()) {
+  std::error_code error;
+  fs::create_directories(directory_, error);
+  if (error) {
+    throw std::runtime_error("Error: Cannot create checkpoint directory " + directory_ + ": " + error.message());
+  }
+}
+
+bool SolveCheckpoint::attach(const std::string& description, const SymbolicStateDfa& arena,
+                             const std::vector<CUDD::BDD>& colors, const CUDD::BDD& state_space, bool resume) {
+  fs::path root(directory_);
+  automaton_id_ = arena.automaton_id();
+  attached_ = true;
+  std::vector<CUDD::BDD> bdds = game_bdds(arena, colors, state_space);
+
+  if (resume) {
+    std::ifstream description_file(root / "game.description");
+    std::stringstream stored_description;
+    stored_description << description_file.rdbuf();
+    if (description_file && stored_description.str() == description && fs::exists(root / "game.bdds")) {
+      try {
+        BddArchive stored = BddArchive::load((root / "game.bdds").string(), var_mgr_, automaton_id_);
+        if (stored.kind == game_kind && stored.bdds == bdds) {
+          spdlog::info("[SolveCheckpoint::attach] resuming from {}", directory_);
+          return true;
+        }
+      } catch (const std::runtime_error& e) {
+        spdlog::warn("[SolveCheckpoint::attach] cannot read the checkpoint in {}: {}", directory_, e.what());
+      }
+    }
+    spdlog::warn("[SolveCheckpoint::attach] {} holds no checkpoint of this game, starting afresh", directory_);
+  }
+
+  for (const fs::directory_entry& entry : fs::directory_iterator(root)) {
+    if (checkpoint_file(entry.path().filename().string())) {
+      fs::remove(entry.path());
+    }
+  }
+  BddArchive game;
+  game.kind = game_kind;
+  game.automaton_id = automaton_id_;
+  game.bdds = std::move(bdds);
+  save_archive(game, root / "game.bdds", var_mgr_);
+  // Written last: a checkpoint without its description is never resumed
+  {
+    std::ofstream description_file((root / "game.description.tmp").string());
+    description_file << description;
+    if (!description_file) {
+      throw std::runtime_error("Error: Could not write the checkpoint in " + directory_);
+    }
+  }
+  fs::rename(root / "game.description.tmp", root / "game.description");
+  return false;
+}
+
+std::optional<ELSynthesisResult> SolveCheckpoint::load_node(int node) const {
+  fs::path path = fs::path(directory_) / node_file(node);
+  if (!attached_ || !fs::exists(path)) {
+    return std::nullopt;
+  }
+  BddArchive archive = BddArchive::load(path.string(), var_mgr_, automaton_id_);
+  if (archive.kind != node_kind || archive.values.size() != 1 || archive.bdds.size() != 1) {
+    throw std::runtime_error("Error: Not a checkpointed DAG node: " + path.string());
+  }
+  ELSynthesisResult result;
+  result.realizability = archive.values[0] != 0;
+  result.winning_states = archive.bdds[0];
+  result.z_tree = nullptr;
+  return result;
+}
+
+void SolveCheckpoint::store_node(int node, const ELSynthesisResult& result) const {
+  if (!attached_) {
+    throw std::runtime_error("Error: The checkpoint is not attached to a game");
+  }
+  BddArchive archive;
+  archive.kind = node_kind;
+  archive.automaton_id = automaton_id_;
+  archive.values = {result.realizability ? 1 : 0};
+  archive.bdds = {result.winning_states};
+  save_archive(archive, fs::path(directory_) / node_file(node), var_mgr_);
+}
+
+std::optional<PartialSynthesisResult> SolveCheckpoint::load_root() const {
+  fs::path path = fs::path(directory_) / "root.bounds";
+  if (!attached_ || !fs::exists(path)) {
+    return std::nullopt;
+  }
+  BddArchive archive = BddArchive::load(path.string(), var_mgr_, automaton_id_);
+  if (archive.kind != root_kind || archive.bdds.size() != 2) {
+    throw std::runtime_error("Error: Not checkpointed root bounds: " + path.string());
+  }
+  return PartialSynthesisResult{archive.bdds[0], archive.bdds[1]};
+}
+
+void SolveCheckpoint::store_root(const PartialSynthesisResult& partial, bool force) const {
+  if (!attached_) {
+    throw std::runtime_error("Error: The checkpoint is not attached to a game");
+  }
+  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+  if (!force && now - last_root_save_ < interval_) {
+    return;
+  }
+  last_root_save_ = now;
+  BddArchive archive;
+  archive.kind = root_kind;
+  archive.automaton_id = automaton_id_;
+  archive.bdds = {partial.winning, partial.losing};
+  save_archive(archive, fs::path(directory_) / "root.bounds", var_mgr_);
+  spdlog::debug("[SolveCheckpoint::store_root] saved the root bounds in {}", directory_);
+}
+
+}
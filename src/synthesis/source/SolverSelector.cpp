@@ -0,0 +1,237 @@
+#include "SolverSelector.h"
+
+#include "FlatJson.h"
+#include "automata/ColorAutomatonBuilder.h"
+#include "automata/ProductArena.h"
+#include "game/SCCDecomposer.h"
+#include "game/ZielonkaTree.hh"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace Syft {
+
+namespace {
+  // The model of perf/solver_model.jsonl
+  const char* const builtin_model =
+      "{\"node\": 0, \"feature\": \"obligation\", \"threshold\": 0.5, \"below\": 1, \"above\": 2}\n"
+      "{\"node\": 1, \"feature\": \"two_level\", \"threshold\": 0.5, \"below\": 3, \"above\": 4}\n"
+      "{\"node\": 2, \"solver\": \"obligation-wg\"}\n"
+      "{\"node\": 3, \"feature\": \"recurrence\", \"threshold\": 4.5, \"below\": 5, \"above\": 6}\n"
+      "{\"node\": 4, \"solver\": \"el\"}\n"
+      "{\"node\": 5, \"solver\": \"el\"}\n"
+      "{\"node\": 6, \"feature\": \"parity_chain\", \"threshold\": 0.5, \"below\": 7, \"above\": 8}\n"
+      "{\"node\": 7, \"solver\": \"mp\"}\n"
+      "{\"node\": 8, \"solver\": \"parity\"}\n";
+
+  std::string format_value(double value) {
+    std::ostringstream out;
+    out << value;
+    return out.str();
+  }
+}
+
+std::map<std::string, double> SpecFeatures::values() const {
+  return {
+      {"colors", static_cast<double>(colors)},
+      {"forall", static_cast<double>(forall)},
+      {"exists", static_cast<double>(exists)},
+      {"forall_exists", static_cast<double>(forall_exists)},
+      {"exists_forall", static_cast<double>(exists_forall)},
+      {"recurrence", static_cast<double>(forall_exists + exists_forall)},
+      {"obligation", obligation ? 1.0 : 0.0},
+      {"two_level", is_two_level(acceptance) ? 1.0 : 0.0},
+      {"parity_chain", acceptance == AcceptanceClass::ParityChain ? 1.0 : 0.0},
+      {"components", static_cast<double>(components)},
+      {"max_dfa_bits", static_cast<double>(max_dfa_bits)},
+      {"arena_bits", static_cast<double>(arena_bits)},
+      {"max_dfa_states", max_dfa_states},
+      {"total_dfa_states", total_dfa_states},
+      {"scc_layers", static_cast<double>(scc_layers)}};
+}
+
+std::string SpecFeatures::to_json() const {
+  std::string json = "{\"acceptance\": " + json_quote(to_string(acceptance));
+  for (const auto& [name, value] : values()) {
+    json += ", " + json_quote(name) + ": " + format_value(value);
+  }
+  return json + "}";
+}
+
+SpecFeatures extract_spec_features(const LTLfPlus& spec, bool obligation, const InterfaceLayout& layout,
+                                   const VarMgrOptions& var_mgr_options, DfaConstructionOptions& dfa_options) {
+  SpecFeatures features;
+  features.obligation = obligation;
+  for (const auto& [argument, quantifier] : spec.formula_to_quantification_) {
+    features.colors++;
+    switch (quantifier) {
+      case whitemech::lydia::PrefixQuantifier::Forall: features.forall++; break;
+      case whitemech::lydia::PrefixQuantifier::Exists: features.exists++; break;
+      case whitemech::lydia::PrefixQuantifier::ForallExists: features.forall_exists++; break;
+      case whitemech::lydia::PrefixQuantifier::ExistsForall: features.exists_forall++; break;
+    }
+  }
+
+  if (!dfa_options.shared_cache) {
+    dfa_options.shared_cache = std::make_shared<DfaCache>(dfa_options.cache_directory, true);
+  }
+  std::shared_ptr<VarMgr> var_mgr =
+      layout.instantiate(var_mgr_options, layout.variable_order(spec, var_mgr_options.proposition_order));
+  ColorArenas color_arenas = ColorAutomatonBuilder(var_mgr, dfa_options)
+      .build_symbolic(spec, ColorAutomatonBuilder::emerson_lei_transform);
+
+  features.components = color_arenas.components.size();
+  for (const SymbolicStateDfa& component : color_arenas.components) {
+    std::size_t bits = var_mgr->state_variable_count(component.automaton_id());
+    double states = component.reachable_states().CountMinterm(static_cast<int>(bits));
+    features.max_dfa_bits = std::max(features.max_dfa_bits, bits);
+    features.max_dfa_states = std::max(features.max_dfa_states, states);
+    features.total_dfa_states += states;
+    features.scc_layers += SCCDecomposer::Create(SCCAlgorithm::Chain, component)
+        ->PeelLayers(component.reachable_states()).size();
+  }
+  ZielonkaTree tree(spec.color_formula_, color_arenas.goal_states, var_mgr, true);
+  features.acceptance = classify_acceptance(tree);
+  ProductArena arena(std::move(color_arenas.components));
+  features.arena_bits = var_mgr->state_variable_count(arena.automaton_id());
+  return features;
+}
+
+SolverSelector::SolverSelector(std::vector<Node> nodes) : nodes_(std::move(nodes)) {
+  if (nodes_.empty()) {
+    throw std::runtime_error("Error: A solver model needs at least one node");
+  }
+  std::vector<std::size_t> pending = {0};
+  std::vector<bool> visited(nodes_.size(), false);
+  std::map<std::string, double> known_features = SpecFeatures().values();
+  while (!pending.empty()) {
+    std::size_t index = pending.back();
+    pending.pop_back();
+    if (index >= nodes_.size()) {
+      throw std::runtime_error("Error: Solver model node " + std::to_string(index) + " is missing");
+    }
+    // A node reached twice would make the tree a DAG or a cycle
+    if (visited[index]) {
+      throw std::runtime_error("Error: Solver model node " + std::to_string(index) + " has several parents");
+    }
+    visited[index] = true;
+    const Node& node = nodes_[index];
+    if (!node.solver.empty()) {
+      if (!solver_mode(node.solver)) {
+        throw std::runtime_error("Error: Unknown solver in solver model: " + node.solver);
+      }
+      continue;
+    }
+    if (known_features.count(node.feature) == 0) {
+      throw std::runtime_error("Error: Unknown feature in solver model: " + node.feature);
+    }
+    pending.push_back(node.below);
+    pending.push_back(node.above);
+  }
+}
+
+SolverSelector SolverSelector::builtin() {
+  return parse(builtin_model);
+}
+
+SolverSelector SolverSelector::parse(const std::string& text) {
+  std::map<std::size_t, Node> nodes;
+  std::istringstream in(text);
+  std::string line;
+  for (std::size_t line_number = 1; std::getline(in, line); ++line_number) {
+    if (line.find_first_not_of(" \t\r") == std::string::npos) {
+      continue;
+    }
+    JsonObject object = parse_json_object(line, line_number);
+    const JsonValue* id = json_field(object, "node", JsonValue::Kind::Number, line_number);
+    if (id == nullptr || id->number < 0) {
+      throw std::runtime_error("Error: Line " + std::to_string(line_number) + ": a solver model node needs an id");
+    }
+    Node node;
+    if (const JsonValue* solver = json_field(object, "solver", JsonValue::Kind::String, line_number)) {
+      node.solver = solver->text;
+    } else {
+      const JsonValue* feature = json_field(object, "feature", JsonValue::Kind::String, line_number);
+      const JsonValue* threshold = json_field(object, "threshold", JsonValue::Kind::Number, line_number);
+      const JsonValue* below = json_field(object, "below", JsonValue::Kind::Number, line_number);
+      const JsonValue* above = json_field(object, "above", JsonValue::Kind::Number, line_number);
+      if (feature == nullptr || threshold == nullptr || below == nullptr || above == nullptr ||
+          below->number < 0 || above->number < 0) {
+        throw std::runtime_error("Error: Line " + std::to_string(line_number) +
+                                 ": a solver model node needs a solver, or a feature, threshold, below and above");
+      }
+      node.feature = feature->text;
+      node.threshold = threshold->number;
+      node.below = static_cast<std::size_t>(below->number);
+      node.above = static_cast<std::size_t>(above->number);
+    }
+    if (!nodes.emplace(static_cast<std::size_t>(id->number), std::move(node)).second) {
+      throw std::runtime_error("Error: Line " + std::to_string(line_number) + ": duplicate solver model node " +
+                               format_value(id->number));
+    }
+  }
+  std::vector<Node> ordered;
+  for (auto& [id, node] : nodes) {
+    if (id != ordered.size()) {
+      throw std::runtime_error("Error: Solver model node " + std::to_string(ordered.size()) + " is missing");
+    }
+    ordered.push_back(std::move(node));
+  }
+  return SolverSelector(std::move(ordered));
+}
+
+SolverSelector SolverSelector::load(const std::string& filename) {
+  std::ifstream in(filename);
+  if (!in.is_open()) {
+    throw std::runtime_error("Error: Could not open solver model: " + filename);
+  }
+  std::stringstream text;
+  text << in.rdbuf();
+  return parse(text.str());
+}
+
+std::string SolverSelector::predict(const SpecFeatures& features, std::string* explanation) const {
+  std::map<std::string, double> values = features.values();
+  std::string path;
+  std::size_t index = 0;
+  while (nodes_[index].solver.empty()) {
+    const Node& node = nodes_[index];
+    double value = values.at(node.feature);
+    bool below = value <= node.threshold;
+    path += node.feature + "=" + format_value(value) + (below ? " <= " : " > ") + format_value(node.threshold) + ", ";
+    index = below ? node.below : node.above;
+  }
+  std::string solver = nodes_[index].solver;
+  if (solver_mode(solver)->obligation_simplification && !features.obligation) {
+    path += "not an obligation formula, ";
+    solver = "el";
+  }
+  if (explanation != nullptr) {
+    *explanation = path + solver;
+  }
+  return solver;
+}
+
+std::optional<SolverMode> SolverSelector::solver_mode(const std::string& name) {
+  static const std::map<std::string, SolverMode> modes = {
+      {"el", {0, false, ""}},
+      {"mp", {1, false, ""}},
+      {"mp-adv", {2, false, ""}},
+      {"parity", {3, false, ""}},
+      {"symbolic-colors", {4, false, ""}},
+      {"scc-layers", {5, false, ""}},
+      {"obligation-cl", {1, true, "cl"}},
+      {"obligation-pm", {1, true, "pm"}},
+      {"obligation-wg", {1, true, "wg"}},
+      {"obligation-cb", {1, true, "cb"}}};
+  auto mode = modes.find(name);
+  if (mode == modes.end()) {
+    return std::nullopt;
+  }
+  return mode->second;
+}
+
+}
@@ -0,0 +1,114 @@
+#include "SolverStats.h"
+
+#include <algorithm>
+
+#include <sys/resource.h>
+
+namespace Syft {
+
+SolverStats::SolverStats() {
+  start_time_ = std::chrono::steady_clock::now();
+}
+
+void SolverStats::set_enabled(bool enabled) {
+  enabled_ = enabled;
+}
+
+bool SolverStats::enabled() const {
+  return enabled_;
+}
+
+void SolverStats::snapshot(const CUDD::Cudd& mgr, const std::string& phase) {
+  if (!enabled_) {
+    return;
+  }
+
+  BddStatsSnapshot snapshot = read(mgr, phase);
+  snapshot.elapsed_ms = std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - start_time_).count();
+  snapshots_.push_back(snapshot);
+}
+
+BddStatsSnapshot SolverStats::read(const CUDD::Cudd& mgr, const std::string& phase) {
+  DdManager* dd = mgr.getManager();
+  BddStatsSnapshot snapshot;
+  snapshot.phase = phase;
+  snapshot.live_nodes = Cudd_ReadNodeCount(dd);
+  snapshot.peak_nodes = Cudd_ReadPeakNodeCount(dd);
+  snapshot.memory_in_use = Cudd_ReadMemoryInUse(dd);
+  snapshot.garbage_collections = Cudd_ReadGarbageCollections(dd);
+  snapshot.garbage_collection_ms = Cudd_ReadGarbageCollectionTime(dd);
+  snapshot.cache_lookups = Cudd_ReadCacheLookUps(dd);
+  snapshot.cache_hits = Cudd_ReadCacheHits(dd);
+  snapshot.reorderings = Cudd_ReadReorderings(dd);
+  snapshot.reordering_ms = Cudd_ReadReorderingTime(dd);
+  // In kilobytes on Linux
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+    snapshot.peak_rss_kb = usage.ru_maxrss;
+  }
+  return snapshot;
+}
+
+const std::vector<BddStatsSnapshot>& SolverStats::snapshots() const {
+  return snapshots_;
+}
+
+void SolverStats::print_json(std::ostream& out) const {
+  out << "{\n";
+  out << "  \"phases\": [";
+
+  for (std::size_t i = 0; i < snapshots_.size(); ++i) {
+    const BddStatsSnapshot& s = snapshots_[i];
+    double hit_rate = s.cache_lookups > 0 ? s.cache_hits / s.cache_lookups : 0;
+
+    if (i > 0) out << ",";
+    out << "\n    {";
+    out << "\"phase\": \"" << s.phase << "\", ";
+    out << "\"elapsed_ms\": " << s.elapsed_ms << ", ";
+    out << "\"live_nodes\": " << s.live_nodes << ", ";
+    out << "\"peak_nodes\": " << s.peak_nodes << ", ";
+    out << "\"memory_in_use\": " << s.memory_in_use << ", ";
+    out << "\"garbage_collections\": " << s.garbage_collections << ", ";
+    out << "\"garbage_collection_ms\": " << s.garbage_collection_ms << ", ";
+    out << "\"cache_lookups\": " << s.cache_lookups << ", ";
+    out << "\"cache_hits\": " << s.cache_hits << ", ";
+    out << "\"cache_hit_rate\": " << hit_rate << ", ";
+    out << "\"reorderings\": " << s.reorderings << ", ";
+    out << "\"reordering_ms\": " << s.reordering_ms << ", ";
+    out << "\"peak_rss_kb\": " << s.peak_rss_kb;
+    out << "}";
+  }
+
+  out << "\n  ]\n";
+  out << "}" << std::endl;
+}
+
+void SolverStats::record_size(const std::string& name, double value) {
+  auto [it, inserted] = sizes_.emplace(name, value);
+  if (!inserted) {
+    it->second = std::max(it->second, value);
+  }
+}
+
+const std::map<std::string, double>& SolverStats::sizes() const {
+  return sizes_;
+}
+
+void SolverStats::record_color_states(int color, int states) {
+  color_dfa_states_[color] = states;
+}
+
+const std::map<int, int>& SolverStats::color_dfa_states() const {
+  return color_dfa_states_;
+}
+
+void SolverStats::record_dfa_backend(const std::string& backend) {
+  dfa_backend_counts_[backend]++;
+}
+
+const std::map<std::string, int>& SolverStats::dfa_backend_counts() const {
+  return dfa_backend_counts_;
+}
+
+}
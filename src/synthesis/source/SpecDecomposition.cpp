@@ -0,0 +1,329 @@
+#include "SpecDecomposition.h"
+
+#include <iterator>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+
+#include <lydia/logic/ltlfplus/base.hpp>
+#include <lydia/utils/print.hpp>
+#include <lydia/visitor.hpp>
+
+#include "game/ELHelpers.hh"
+
+namespace Syft {
+
+    namespace {
+
+        class SupportVisitor : public whitemech::lydia::Visitor {
+        public:
+            void visit(const whitemech::lydia::LTLfTrue &) override {}
+
+            void visit(const whitemech::lydia::LTLfFalse &) override {}
+
+            void visit(const whitemech::lydia::LTLfAtom &formula) override {
+                support_.insert(formula.symbol->get_name());
+            }
+
+            void visit(const whitemech::lydia::LTLfNot &formula) override {
+                formula.get_arg()->accept(*this);
+            }
+
+            void visit(const whitemech::lydia::LTLfAnd &formula) override {
+                for (const auto &arg: formula.get_args()) {
+                    arg->accept(*this);
+                }
+            }
+
+            void visit(const whitemech::lydia::LTLfOr &formula) override {
+                for (const auto &arg: formula.get_args()) {
+                    arg->accept(*this);
+                }
+            }
+
+            void visit(const whitemech::lydia::LTLfNext &formula) override {
+                formula.get_arg()->accept(*this);
+            }
+
+            void visit(const whitemech::lydia::LTLfWeakNext &formula) override {
+                formula.get_arg()->accept(*this);
+            }
+
+            void visit(const whitemech::lydia::LTLfUntil &formula) override {
+                for (const auto &arg: formula.get_args()) {
+                    arg->accept(*this);
+                }
+            }
+
+            void visit(const whitemech::lydia::LTLfRelease &formula) override {
+                for (const auto &arg: formula.get_args()) {
+                    arg->accept(*this);
+                }
+            }
+
+            void visit(const whitemech::lydia::LTLfEventually &formula) override {
+                formula.get_arg()->accept(*this);
+            }
+
+            void visit(const whitemech::lydia::LTLfAlways &formula) override {
+                formula.get_arg()->accept(*this);
+            }
+
+            std::set<std::string> apply(const whitemech::lydia::LTLfFormula &formula) {
+                formula.accept(*this);
+                return support_;
+            }
+
+        private:
+            std::set<std::string> support_;
+        };
+
+        // A color formula as a tree: an operator with its operands, or a color or constant
+        struct ColorTree {
+            std::string token;
+            std::vector<ColorTree> operands;
+        };
+
+        ColorTree parse_color_tree(const std::string &color_formula) {
+            std::vector<ColorTree> stack;
+            for (const std::string &token: ELHelpers::infix2postfix(ELHelpers::tokenize(color_formula))) {
+                std::size_t arity = token == "!" ? 1 : (token == "&" || token == "|") ? 2 : 0;
+                if (stack.size() < arity) {
+                    throw std::runtime_error("Error: Missing operand in color formula at: " + token);
+                }
+                ColorTree tree{token, {}};
+                tree.operands.assign(std::make_move_iterator(stack.end() - arity), std::make_move_iterator(stack.end()));
+                stack.erase(stack.end() - arity, stack.end());
+                stack.push_back(std::move(tree));
+            }
+            if (stack.size() != 1) {
+                throw std::runtime_error("Error: Malformed color formula");
+            }
+            return std::move(stack.back());
+        }
+
+        // The operands of nested applications of op at the root
+        void flatten(const ColorTree &tree, const std::string &op, std::vector<const ColorTree *> &operands) {
+            if (tree.token != op) {
+                operands.push_back(&tree);
+                return;
+            }
+            for (const ColorTree &operand: tree.operands) {
+                flatten(operand, op, operands);
+            }
+        }
+
+        void collect_colors(const ColorTree &tree, std::set<int> &colors) {
+            if (ELHelpers::isNumber(tree.token) && !tree.token.empty()) {
+                colors.insert(std::stoi(tree.token));
+            }
+            for (const ColorTree &operand: tree.operands) {
+                collect_colors(operand, colors);
+            }
+        }
+
+        std::string to_infix(const ColorTree &tree, const std::map<int, int> &renamed) {
+            if (tree.operands.empty()) {
+                return ELHelpers::isNumber(tree.token) && !tree.token.empty()
+                       ? std::to_string(renamed.at(std::stoi(tree.token))) : tree.token;
+            }
+            if (tree.operands.size() == 1) {
+                return tree.token + "(" + to_infix(tree.operands[0], renamed) + ")";
+            }
+            return "(" + to_infix(tree.operands[0], renamed) + " " + tree.token + " " +
+                   to_infix(tree.operands[1], renamed) + ")";
+        }
+
+        std::string spell_out(const ColorTree &tree, const std::map<int, std::string> &color_names) {
+            if (tree.operands.empty()) {
+                return ELHelpers::isNumber(tree.token) && !tree.token.empty()
+                       ? "[" + color_names.at(std::stoi(tree.token)) + "]" : tree.token;
+            }
+            std::string spelled = tree.token + "(";
+            for (std::size_t i = 0; i < tree.operands.size(); ++i) {
+                spelled += (i == 0 ? "" : ", ") + spell_out(tree.operands[i], color_names);
+            }
+            return spelled + ")";
+        }
+
+        std::size_t find_root(std::vector<std::size_t> &parent, std::size_t i) {
+            while (parent[i] != i) {
+                parent[i] = parent[parent[i]];
+                i = parent[i];
+            }
+            return i;
+        }
+    }
+
+    std::set<std::string> variable_support(const whitemech::lydia::LTLfFormula &formula) {
+        SupportVisitor visitor;
+        return visitor.apply(formula);
+    }
+
+    std::set<std::string> top_conjuncts(const LTLfPlus &formula) {
+        std::map<int, std::string> color_names;
+        for (const auto &[ltlf_plus_arg, color]: formula.formula_to_color_) {
+            auto quantifier = formula.formula_to_quantification_.at(ltlf_plus_arg);
+            color_names[std::stoi(color)] = std::to_string(static_cast<int>(quantifier)) + ":" +
+                                            whitemech::lydia::to_string(*ltlf_plus_arg->ltlf_arg());
+        }
+        ColorTree root = parse_color_tree(formula.color_formula_);
+        std::vector<const ColorTree *> operands;
+        flatten(root, "&", operands);
+        std::set<std::string> conjuncts;
+        for (const ColorTree *operand: operands) {
+            conjuncts.insert(spell_out(*operand, color_names));
+        }
+        return conjuncts;
+    }
+
+    std::vector<std::string> top_disjuncts(const std::string &color_formula) {
+        ColorTree root = parse_color_tree(color_formula);
+        std::vector<const ColorTree *> operands;
+        flatten(root, "|", operands);
+        if (operands.size() < 2) {
+            return {color_formula};
+        }
+        std::vector<std::string> disjuncts;
+        for (const ColorTree *operand: operands) {
+            // The colors keep their numbers, so each disjunct reads the goal states of the whole formula
+            std::set<int> colors;
+            collect_colors(*operand, colors);
+            std::map<int, int> identity;
+            for (int color: colors) {
+                identity[color] = color;
+            }
+            disjuncts.push_back(to_infix(*operand, identity));
+        }
+        return disjuncts;
+    }
+
+    std::vector<int> top_conjunct_colors(const std::string &color_formula) {
+        ColorTree root = parse_color_tree(color_formula);
+        std::vector<const ColorTree *> operands;
+        flatten(root, "&", operands);
+        std::vector<int> colors;
+        for (const ColorTree *operand: operands) {
+            if (operand->operands.empty() && ELHelpers::isNumber(operand->token) && !operand->token.empty()) {
+                colors.push_back(std::stoi(operand->token));
+            }
+        }
+        return colors;
+    }
+
+    std::string drop_top_conjuncts(const std::string &color_formula, const std::set<int> &colors) {
+        ColorTree root = parse_color_tree(color_formula);
+        std::vector<const ColorTree *> operands;
+        flatten(root, "&", operands);
+        std::string residual;
+        for (const ColorTree *operand: operands) {
+            if (operand->operands.empty() && ELHelpers::isNumber(operand->token) && !operand->token.empty() &&
+                colors.count(std::stoi(operand->token)) > 0) {
+                continue;
+            }
+            std::set<int> operand_colors;
+            collect_colors(*operand, operand_colors);
+            std::map<int, int> identity;
+            for (int color: operand_colors) {
+                identity[color] = color;
+            }
+            residual += (residual.empty() ? "" : " & ") + to_infix(*operand, identity);
+        }
+        return residual.empty() ? "true" : residual;
+    }
+
+    SpecDecomposition decompose_spec(const LTLfPlus &formula, const InputOutputPartition &partition,
+                                     Player protagonist_player) {
+        SpecDecomposition decomposition;
+        ColorTree root = parse_color_tree(formula.color_formula_);
+        if (root.token != "&" && root.token != "|") {
+            decomposition.components.push_back(formula);
+            return decomposition;
+        }
+        decomposition.conjunction = root.token == "&";
+        std::vector<const ColorTree *> operands;
+        flatten(root, root.token, operands);
+
+        // The variables that keep operands together
+        const std::vector<std::string> &protagonist_variables =
+                protagonist_player == Player::Agent ? partition.output_variables : partition.input_variables;
+        std::set<std::string> binding(protagonist_variables.begin(), protagonist_variables.end());
+        if (!decomposition.conjunction) {
+            binding.insert(partition.input_variables.begin(), partition.input_variables.end());
+            binding.insert(partition.output_variables.begin(), partition.output_variables.end());
+        }
+
+        std::map<int, std::set<std::string>> color_support;
+        for (const auto &[ltlf_plus_arg, color]: formula.formula_to_color_) {
+            std::set<std::string> support = variable_support(*ltlf_plus_arg->ltlf_arg());
+            color_support[std::stoi(color)].insert(support.begin(), support.end());
+        }
+
+        // Operands sharing a color or a binding variable end up with the same root
+        std::vector<std::size_t> parent(operands.size());
+        std::iota(parent.begin(), parent.end(), 0);
+        std::map<std::string, std::size_t> owner;
+        std::vector<std::set<int>> operand_colors(operands.size());
+        for (std::size_t i = 0; i < operands.size(); ++i) {
+            collect_colors(*operands[i], operand_colors[i]);
+            std::set<std::string> keys;
+            for (int color: operand_colors[i]) {
+                keys.insert("#" + std::to_string(color));
+                auto support = color_support.find(color);
+                if (support == color_support.end()) {
+                    continue;
+                }
+                for (const std::string &variable: support->second) {
+                    if (binding.count(variable) > 0) {
+                        keys.insert(variable);
+                    }
+                }
+            }
+            for (const std::string &key: keys) {
+                auto [it, inserted] = owner.emplace(key, i);
+                if (!inserted) {
+                    parent[find_root(parent, i)] = find_root(parent, it->second);
+                }
+            }
+        }
+
+        std::map<std::size_t, std::vector<std::size_t>> groups;
+        for (std::size_t i = 0; i < operands.size(); ++i) {
+            groups[find_root(parent, i)].push_back(i);
+        }
+        if (groups.size() <= 1) {
+            decomposition.components.push_back(formula);
+            return decomposition;
+        }
+
+        for (const auto &[group_root, members]: groups) {
+            std::set<int> colors;
+            for (std::size_t i: members) {
+                colors.insert(operand_colors[i].begin(), operand_colors[i].end());
+            }
+            std::map<int, int> renamed;
+            for (int color: colors) {
+                renamed.emplace(color, static_cast<int>(renamed.size()));
+            }
+
+            LTLfPlus component;
+            for (std::size_t i: members) {
+                std::string operand = to_infix(*operands[i], renamed);
+                component.color_formula_ = component.color_formula_.empty()
+                                           ? operand : "(" + component.color_formula_ + " " + root.token + " " + operand + ")";
+            }
+            for (const auto &[ltlf_plus_arg, color]: formula.formula_to_color_) {
+                auto it = renamed.find(std::stoi(color));
+                if (it == renamed.end()) {
+                    continue;
+                }
+                component.formula_to_color_.emplace(ltlf_plus_arg, std::to_string(it->second));
+                component.formula_to_quantification_.emplace(ltlf_plus_arg,
+                                                             formula.formula_to_quantification_.at(ltlf_plus_arg));
+            }
+            decomposition.components.push_back(std::move(component));
+        }
+        return decomposition;
+    }
+
+}
@@ -0,0 +1,252 @@
+#ifdef LYDIASYFT_WITH_SYLVAN
+
+#include "BddBackend.h"
+
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <sylvan.h>
+#include <sylvan_obj.hpp>
+#include <spdlog/spdlog.h>
+
+namespace Syft {
+
+namespace {
+  // Sylvan and its Lace workers are global to the process
+  std::once_flag sylvan_started;
+
+  void start_sylvan(std::size_t threads) {
+    std::call_once(sylvan_started, [threads]() {
+      std::size_t workers = threads > 0 ? threads : std::thread::hardware_concurrency();
+      lace_start(static_cast<unsigned int>(workers), 0);
+      // Tables of up to 1 GB, of which the operation cache takes a quarter
+      sylvan_set_limits(std::size_t(1) << 30, 2, 6);
+      sylvan_init_package();
+      sylvan_init_bdd();
+      spdlog::info("[SylvanBackend] Started Sylvan with {} workers", lace_workers());
+    });
+  }
+
+  /**
+   * Translates between the BDDs of a CUDD manager and Sylvan.
+   *
+   * Sylvan orders its variables by index, so the Sylvan variable of a CUDD
+   * variable is its current level, which keeps the order of the manager.
+   * Translations of CUDD BDDs are kept until the manager reorders, keyed by
+   * their regular node, which the kept BDD prevents from being reused.
+   * LeastFixpoint translates its operands once and keeps the iterates in
+   * Sylvan until the last one.
+   */
+  class SylvanBackend final : public BddBackend {
+   private:
+
+    struct Translation {
+      CUDD::BDD node;
+      sylvan::Bdd bdd;
+    };
+
+    std::shared_ptr<CUDD::Cudd> mgr_;
+    mutable std::unordered_map<DdNode*, Translation> to_sylvan_;
+    mutable unsigned int reorderings_ = 0;
+
+    // Kept translations are dropped beyond this many, e.g. the operands of many distinct calls
+    static constexpr std::size_t max_translations = std::size_t(1) << 22;
+
+    void check_order() const {
+      unsigned int reorderings = mgr_->ReadReorderings();
+      if (reorderings != reorderings_ || to_sylvan_.size() > max_translations) {
+        to_sylvan_.clear();
+        reorderings_ = reorderings;
+      }
+    }
+
+    // The translation of a node whose regular node is translated already
+    sylvan::Bdd translated(DdNode* node) const {
+      DdNode* regular = Cudd_Regular(node);
+      sylvan::Bdd result = Cudd_IsConstant(regular) ? sylvan::Bdd::bddOne() : to_sylvan_.at(regular).bdd;
+      return Cudd_IsComplement(node) ? !result : result;
+    }
+
+    sylvan::Bdd translate(DdNode* node) const {
+      // Children first, on an explicit stack since the BDDs may be deeper than the call stack
+      std::vector<std::pair<DdNode*, bool>> stack{{Cudd_Regular(node), false}};
+      while (!stack.empty()) {
+        auto [regular, expanded] = stack.back();
+        if (Cudd_IsConstant(regular) || to_sylvan_.count(regular) > 0) {
+          stack.pop_back();
+        } else if (!expanded) {
+          stack.back().second = true;
+          stack.emplace_back(Cudd_Regular(Cudd_T(regular)), false);
+          stack.emplace_back(Cudd_Regular(Cudd_E(regular)), false);
+        } else {
+          stack.pop_back();
+          sylvan::Bdd variable = sylvan::Bdd::bddVar(
+              static_cast<uint32_t>(mgr_->ReadPerm(static_cast<int>(Cudd_NodeReadIndex(regular)))));
+          sylvan::Bdd result = variable.Ite(translated(Cudd_T(regular)), translated(Cudd_E(regular)));
+          to_sylvan_.emplace(regular, Translation{CUDD::BDD(*mgr_, regular), result});
+        }
+      }
+      return translated(node);
+    }
+
+    sylvan::Bdd to_sylvan(const CUDD::BDD& bdd) const {
+      return translate(bdd.getNode());
+    }
+
+    // The translation of a Sylvan node that is constant or in done
+    CUDD::BDD translated(const sylvan::Bdd& bdd, const std::unordered_map<BDD, CUDD::BDD>& done) const {
+      if (bdd.isOne()) {
+        return mgr_->bddOne();
+      }
+      if (bdd.isZero()) {
+        return mgr_->bddZero();
+      }
+      return done.at(bdd.GetBDD());
+    }
+
+    CUDD::BDD to_cudd(const sylvan::Bdd& bdd) const {
+      std::unordered_map<BDD, CUDD::BDD> done;
+      std::vector<std::pair<sylvan::Bdd, bool>> stack{{bdd, false}};
+      while (!stack.empty()) {
+        auto [node, expanded] = stack.back();
+        if (node.isOne() || node.isZero() || done.count(node.GetBDD()) > 0) {
+          stack.pop_back();
+        } else if (!expanded) {
+          stack.back().second = true;
+          stack.emplace_back(node.Then(), false);
+          stack.emplace_back(node.Else(), false);
+        } else {
+          stack.pop_back();
+          CUDD::BDD variable = mgr_->bddVar(mgr_->ReadInvPerm(static_cast<int>(node.TopVar())));
+          done.emplace(node.GetBDD(), variable.Ite(translated(node.Then(), done), translated(node.Else(), done)));
+        }
+      }
+      return translated(bdd, done);
+    }
+
+    sylvan::BddMap to_substitution(const std::vector<CUDD::BDD>& vector) const {
+      sylvan::BddMap substitution;
+      for (std::size_t index = 0; index < vector.size(); ++index) {
+        // The identity entries of the compose vectors of VarMgr are left out
+        const CUDD::BDD& entry = vector[index];
+        DdNode* node = entry.getNode();
+        if (!Cudd_IsComplement(node) && !Cudd_IsConstant(node) && Cudd_NodeReadIndex(node) == index &&
+            Cudd_IsConstant(Cudd_T(node)) && Cudd_IsConstant(Cudd_E(node)) &&
+            Cudd_IsComplement(Cudd_E(node))) {
+          continue;
+        }
+        substitution.put(static_cast<uint32_t>(mgr_->ReadPerm(static_cast<int>(index))), to_sylvan(entry));
+      }
+      return substitution;
+    }
+
+    // Keeps the variable order of the manager, on which the translations depend, until destroyed
+    class FixedOrder {
+     public:
+      explicit FixedOrder(CUDD::Cudd& mgr) : mgr_(mgr), reordering_(mgr.ReorderingStatus(&method_)) {
+        if (reordering_) {
+          mgr_.AutodynDisable();
+        }
+      }
+
+      ~FixedOrder() {
+        if (reordering_) {
+          mgr_.AutodynEnable(method_);
+        }
+      }
+
+     private:
+      CUDD::Cudd& mgr_;
+      Cudd_ReorderingType method_ = CUDD_REORDER_SAME;
+      bool reordering_;
+    };
+
+   public:
+
+    SylvanBackend(std::shared_ptr<CUDD::Cudd> mgr, std::size_t threads) : mgr_(std::move(mgr)) {
+      start_sylvan(threads);
+      reorderings_ = mgr_->ReadReorderings();
+    }
+
+    std::string name() const override {
+      return "sylvan";
+    }
+
+    std::size_t threads() const override {
+      return lace_workers();
+    }
+
+    CUDD::BDD And(const CUDD::BDD& f, const CUDD::BDD& g) const override {
+      check_order();
+      return to_cudd(to_sylvan(f) * to_sylvan(g));
+    }
+
+    CUDD::BDD Or(const CUDD::BDD& f, const CUDD::BDD& g) const override {
+      check_order();
+      return to_cudd(to_sylvan(f) + to_sylvan(g));
+    }
+
+    CUDD::BDD ExistAbstract(const CUDD::BDD& f, const CUDD::BDD& cube) const override {
+      check_order();
+      return to_cudd(to_sylvan(f).ExistAbstract(sylvan::BddSet(to_sylvan(cube))));
+    }
+
+    CUDD::BDD UnivAbstract(const CUDD::BDD& f, const CUDD::BDD& cube) const override {
+      check_order();
+      return to_cudd(to_sylvan(f).UnivAbstract(sylvan::BddSet(to_sylvan(cube))));
+    }
+
+    CUDD::BDD AndAbstract(const CUDD::BDD& f, const CUDD::BDD& g, const CUDD::BDD& cube) const override {
+      check_order();
+      return to_cudd(to_sylvan(f).AndAbstract(to_sylvan(g), sylvan::BddSet(to_sylvan(cube))));
+    }
+
+    CUDD::BDD VectorCompose(const CUDD::BDD& f, const std::vector<CUDD::BDD>& vector) const override {
+      check_order();
+      return to_cudd(to_sylvan(f).Compose(to_substitution(vector)));
+    }
+
+    bool Eval(const CUDD::BDD& f, const std::vector<int>& assignment) const override {
+      // A single path, not worth translating
+      return f.Eval(const_cast<int*>(assignment.data())).IsOne();
+    }
+
+    CUDD::BDD LeastFixpoint(const ControllableFixpoint& fixpoint) const override {
+      FixedOrder fixed_order(*mgr_);
+      check_order();
+      sylvan::Bdd iterate = to_sylvan(fixpoint.start);
+      sylvan::Bdd care = to_sylvan(fixpoint.care);
+      sylvan::Bdd stop = to_sylvan(fixpoint.stop);
+      sylvan::BddMap substitution = to_substitution(fixpoint.vector);
+      std::vector<std::pair<bool, sylvan::BddSet>> quantifiers;
+      for (const BddQuantifier& quantifier : fixpoint.quantifiers) {
+        quantifiers.emplace_back(quantifier.universal, sylvan::BddSet(to_sylvan(quantifier.cube)));
+      }
+      for (std::size_t step = 1; ; ++step) {
+        if (fixpoint.on_iteration) {
+          fixpoint.on_iteration();
+        }
+        sylvan::Bdd predecessors = iterate.Compose(substitution);
+        for (const auto& [universal, cube] : quantifiers) {
+          predecessors = universal ? predecessors.UnivAbstract(cube) : predecessors.ExistAbstract(cube);
+        }
+        sylvan::Bdd next = iterate + (care * predecessors);
+        if (next == iterate || !(next * stop).isZero() || step == fixpoint.max_steps) {
+          return to_cudd(next);
+        }
+        iterate = next;
+      }
+    }
+  };
+}
+
+std::unique_ptr<BddBackend> make_sylvan_backend(std::shared_ptr<CUDD::Cudd> mgr, std::size_t threads) {
+  return std::make_unique<SylvanBackend>(std::move(mgr), threads);
+}
+
+}
+
+#endif // LYDIASYFT_WITH_SYLVAN
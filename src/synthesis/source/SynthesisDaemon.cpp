@@ -0,0 +1,359 @@
+#include "SynthesisDaemon.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <spdlog/spdlog.h>
+
+#include "FlatJson.h"
+
+namespace Syft {
+
+struct SynthesisDaemon::Connection {
+  int fd;
+  std::mutex write_mutex;
+  bool writable = true;
+  std::mutex jobs_mutex;
+  // The cancellation tokens of the queued and running jobs, by id
+  std::map<std::string, std::shared_ptr<std::atomic<bool>>> jobs;
+
+  explicit Connection(int connection_fd) : fd(connection_fd) {}
+
+  ~Connection() {
+    close(fd);
+  }
+
+  void send(const std::string& line) {
+    std::lock_guard<std::mutex> lock(write_mutex);
+    if (!writable) {
+      return;
+    }
+    std::string data = line + "\n";
+    std::size_t written = 0;
+    while (written < data.size()) {
+      ssize_t n = ::send(fd, data.data() + written, data.size() - written, MSG_NOSIGNAL);
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      if (n <= 0) {
+        // The client went away: nobody is waiting for its jobs any more
+        writable = false;
+        cancel_all();
+        return;
+      }
+      written += static_cast<std::size_t>(n);
+    }
+  }
+
+  void cancel_all() {
+    std::lock_guard<std::mutex> lock(jobs_mutex);
+    for (const auto& [id, cancelled] : jobs) {
+      cancelled->store(true);
+    }
+  }
+};
+
+namespace {
+  std::string event(const std::string& id, const std::string& name) {
+    return "{\"id\": " + json_quote(id) + ", \"event\": \"" + name + "\"}";
+  }
+
+  std::string phase_event(const std::string& id, const BddStatsSnapshot& snapshot) {
+    std::ostringstream out;
+    out << "{\"id\": " << json_quote(id) << ", \"event\": \"phase\", \"phase\": " << json_quote(snapshot.phase)
+        << ", \"live_nodes\": " << snapshot.live_nodes << ", \"peak_nodes\": " << snapshot.peak_nodes
+        << ", \"memory_in_use\": " << snapshot.memory_in_use
+        << ", \"garbage_collections\": " << snapshot.garbage_collections
+        << ", \"reorderings\": " << snapshot.reorderings
+        << ", \"peak_rss_kb\": " << snapshot.peak_rss_kb << "}";
+    return out.str();
+  }
+
+  [[noreturn]] void fail_to_listen(int fd, const std::string& address) {
+    std::string reason = std::strerror(errno);
+    if (fd >= 0) {
+      close(fd);
+    }
+    throw std::runtime_error("Error: Could not listen on " + address + ": " + reason);
+  }
+}
+
+SynthesisDaemon::SynthesisDaemon(const std::string& address) {
+  const std::string tcp_prefix = "tcp:";
+  const std::string unix_prefix = "unix:";
+  if (address.compare(0, tcp_prefix.size(), tcp_prefix) == 0) {
+    int requested_port = std::stoi(address.substr(tcp_prefix.size()));
+    listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+    if (listen_fd_ < 0) {
+      fail_to_listen(listen_fd_, address);
+    }
+    int reuse = 1;
+    setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    sockaddr_in socket_address{};
+    socket_address.sin_family = AF_INET;
+    // Local clients only: the protocol reads any file the daemon can read
+    socket_address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socket_address.sin_port = htons(static_cast<std::uint16_t>(requested_port));
+    if (bind(listen_fd_, reinterpret_cast<sockaddr*>(&socket_address), sizeof(socket_address)) != 0) {
+      fail_to_listen(listen_fd_, address);
+    }
+    socklen_t length = sizeof(socket_address);
+    getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&socket_address), &length);
+    port_ = ntohs(socket_address.sin_port);
+  } else {
+    std::string path = address.compare(0, unix_prefix.size(), unix_prefix) == 0 ? address.substr(unix_prefix.size())
+                                                                                  : address;
+    sockaddr_un socket_address{};
+    if (path.empty() || path.size() >= sizeof(socket_address.sun_path)) {
+      throw std::runtime_error("Error: Invalid Unix socket path: " + path);
+    }
+    struct stat status;
+    if (stat(path.c_str(), &status) == 0 && S_ISSOCK(status.st_mode)) {
+      unlink(path.c_str());
+    }
+    listen_fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd_ < 0) {
+      fail_to_listen(listen_fd_, address);
+    }
+    socket_address.sun_family = AF_UNIX;
+    std::strncpy(socket_address.sun_path, path.c_str(), sizeof(socket_address.sun_path) - 1);
+    if (bind(listen_fd_, reinterpret_cast<sockaddr*>(&socket_address), sizeof(socket_address)) != 0) {
+      fail_to_listen(listen_fd_, address);
+    }
+    unix_path_ = path;
+  }
+  if (listen(listen_fd_, SOMAXCONN) != 0 || pipe(wake_fds_) != 0) {
+    fail_to_listen(listen_fd_, address);
+  }
+  spdlog::info("[SynthesisDaemon::SynthesisDaemon] listening on {}", address);
+}
+
+SynthesisDaemon::~SynthesisDaemon() {
+  stop();
+  close_connections();
+  close(listen_fd_);
+  close(wake_fds_[0]);
+  close(wake_fds_[1]);
+  if (!unix_path_.empty()) {
+    unlink(unix_path_.c_str());
+  }
+}
+
+void SynthesisDaemon::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopping_) {
+      return;
+    }
+    stopping_ = true;
+  }
+  queue_changed_.notify_all();
+  char wake = 0;
+  while (write(wake_fds_[1], &wake, 1) < 0 && errno == EINTR) {}
+}
+
+std::size_t SynthesisDaemon::serve(const Solver& solve) {
+  std::thread acceptor(&SynthesisDaemon::accept_connections, this);
+  std::size_t solved = 0;
+  while (true) {
+    QueuedJob queued;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      queue_changed_.wait(lock, [&]() {return stopping_ || !queue_.empty();});
+      if (stopping_) {
+        break;
+      }
+      queued = std::move(queue_.front());
+      queue_.pop_front();
+    }
+    const std::string id = queued.job.id;
+    BatchResult result;
+    if (queued.cancelled->load()) {
+      result.id = id;
+      result.verdict = "UNKNOWN";
+      result.detail = "cancelled before it started";
+    } else {
+      queued.connection->send(event(id, "started"));
+      DaemonJobContext context;
+      context.cancelled = queued.cancelled;
+      std::shared_ptr<Connection> connection = queued.connection;
+      context.progress = [connection, id](const BddStatsSnapshot& snapshot) {
+        connection->send(phase_event(id, snapshot));
+      };
+      result = solve_batch_job(queued.job, [&](const BatchJob& job) {return solve(job, context);});
+      solved += result.verdict != "ERROR";
+      spdlog::info("[SynthesisDaemon::serve] {}: {} in {} s", id, result.verdict, result.wall_time);
+    }
+    queued.connection->send(result.to_json());
+    std::lock_guard<std::mutex> lock(queued.connection->jobs_mutex);
+    queued.connection->jobs.erase(id);
+  }
+
+  std::deque<QueuedJob> abandoned;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    abandoned.swap(queue_);
+  }
+  for (const QueuedJob& queued : abandoned) {
+    BatchResult result;
+    result.id = queued.job.id;
+    result.verdict = "ERROR";
+    result.detail = "the daemon shut down before the job started";
+    queued.connection->send(result.to_json());
+  }
+  acceptor.join();
+  close_connections();
+  return solved;
+}
+
+void SynthesisDaemon::accept_connections() {
+  while (true) {
+    pollfd fds[2] = {{listen_fd_, POLLIN, 0}, {wake_fds_[0], POLLIN, 0}};
+    if (poll(fds, 2, -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      spdlog::error("[SynthesisDaemon::accept_connections] {}", std::strerror(errno));
+      return;
+    }
+    if (fds[1].revents != 0) {
+      return;
+    }
+    if ((fds[0].revents & POLLIN) == 0) {
+      continue;
+    }
+    int fd = accept(listen_fd_, nullptr, nullptr);
+    if (fd < 0) {
+      continue;
+    }
+    auto connection = std::make_shared<Connection>(fd);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      connections_.erase(std::remove_if(connections_.begin(), connections_.end(),
+                                        [](const std::weak_ptr<Connection>& c) {return c.expired();}),
+                         connections_.end());
+      connections_.push_back(connection);
+      ++active_readers_;
+    }
+    std::thread([this, connection]() {
+      read_requests(connection);
+      std::lock_guard<std::mutex> lock(mutex_);
+      --active_readers_;
+      readers_done_.notify_all();
+    }).detach();
+  }
+}
+
+void SynthesisDaemon::read_requests(const std::shared_ptr<Connection>& connection) {
+  std::string buffer;
+  std::size_t line_number = 0;
+  char chunk[4096];
+  while (true) {
+    ssize_t n = recv(connection->fd, chunk, sizeof(chunk), 0);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return;
+    }
+    buffer.append(chunk, static_cast<std::size_t>(n));
+    std::size_t newline;
+    while ((newline = buffer.find('\n')) != std::string::npos) {
+      std::string line = buffer.substr(0, newline);
+      buffer.erase(0, newline + 1);
+      ++line_number;
+      if (line.find_first_not_of(" \t\r") == std::string::npos) {
+        continue;
+      }
+      try {
+        handle_request(connection, line, line_number);
+      } catch (const std::exception& e) {
+        connection->send("{\"event\": \"error\", \"detail\": " + json_quote(e.what()) + "}");
+      }
+    }
+  }
+}
+
+void SynthesisDaemon::handle_request(const std::shared_ptr<Connection>& connection, const std::string& line,
+                                     std::size_t line_number) {
+  JsonObject request = parse_json_object(line, line_number);
+  if (request.count("shutdown") > 0) {
+    const JsonValue* shutdown = json_field(request, "shutdown", JsonValue::Kind::Bool, line_number);
+    if (shutdown && (shutdown->kind == JsonValue::Kind::Bool ? shutdown->boolean : shutdown->number != 0)) {
+      connection->send("{\"event\": \"shutdown\"}");
+      stop();
+    }
+    return;
+  }
+  if (request.count("cancel") > 0) {
+    const JsonValue* cancel = json_field(request, "cancel", JsonValue::Kind::String, line_number);
+    std::string id = cancel ? cancel->text : std::string();
+    {
+      std::lock_guard<std::mutex> lock(connection->jobs_mutex);
+      auto job = connection->jobs.find(id);
+      if (job == connection->jobs.end()) {
+        throw std::runtime_error("Error: No queued or running job " + id);
+      }
+      job->second->store(true);
+    }
+    connection->send(event(id, "cancelling"));
+    return;
+  }
+
+  // Relative paths are resolved against the working directory of the daemon
+  BatchJob job = batch_job_from_json(request, "", line_number);
+  auto cancelled = std::make_shared<std::atomic<bool>>(false);
+  {
+    std::lock_guard<std::mutex> lock(connection->jobs_mutex);
+    if (!connection->jobs.emplace(job.id, cancelled).second) {
+      throw std::runtime_error("Error: A job " + job.id + " is already queued or running");
+    }
+  }
+  std::size_t position;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    position = queue_.size() + 1;
+  }
+  // Sent before the job is queued, so that it precedes the events of the job
+  connection->send("{\"id\": " + json_quote(job.id) + ", \"event\": \"queued\", \"position\": " +
+                   std::to_string(position) + "}");
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopping_) {
+      std::lock_guard<std::mutex> jobs_lock(connection->jobs_mutex);
+      connection->jobs.erase(job.id);
+      throw std::runtime_error("Error: The daemon is shutting down");
+    }
+    queue_.push_back(QueuedJob{job, connection, cancelled});
+  }
+  queue_changed_.notify_one();
+}
+
+void SynthesisDaemon::close_connections() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (const std::weak_ptr<Connection>& weak : connections_) {
+    if (std::shared_ptr<Connection> connection = weak.lock()) {
+      // Wakes its reader, which then releases the connection
+      shutdown(connection->fd, SHUT_RDWR);
+    }
+  }
+  readers_done_.wait(lock, [&]() {return active_readers_ == 0;});
+  connections_.clear();
+}
+
+}
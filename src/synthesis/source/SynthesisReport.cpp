@@ -0,0 +1,122 @@
+#include "SynthesisReport.h"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "FlatJson.h"
+
+namespace Syft {
+
+namespace {
+  std::string number(double value) {
+    if (!std::isfinite(value)) {
+      return "null";
+    }
+    std::ostringstream out;
+    out.precision(15);
+    out << value;
+    return out.str();
+  }
+
+  std::string optional_text(const std::string& text) {
+    return text.empty() ? "null" : json_quote(text);
+  }
+
+  std::string size_field(const SolverStats* stats, const std::string& name) {
+    if (stats == nullptr) {
+      return "null";
+    }
+    auto size = stats->sizes().find(name);
+    return size == stats->sizes().end() ? "null" : number(size->second);
+  }
+}
+
+std::string SynthesisReport::to_json() const {
+  std::ostringstream out;
+  out << "{\n";
+  out << "  \"schema_version\": " << schema_version << ",\n";
+  out << "  \"tool\": " << json_quote(tool) << ",\n";
+  out << "  \"formula_file\": " << optional_text(formula_file) << ",\n";
+  out << "  \"partition_file\": " << optional_text(partition_file) << ",\n";
+  out << "  \"verdict\": " << optional_text(verdict) << ",\n";
+  out << "  \"solver\": " << optional_text(solver) << ",\n";
+  out << "  \"mode\": " << optional_text(mode) << ",\n";
+  out << "  \"starting_player\": " << json_quote(agent_starts ? "agent" : "environment") << ",\n";
+  out << "  \"detail\": " << optional_text(detail) << ",\n";
+  out << "  \"wall_time\": " << number(wall_time) << ",\n";
+  out << "  \"cpu_time\": " << number(cpu_time) << ",\n";
+
+  out << "  \"phases\": [";
+  if (stats != nullptr) {
+    double previous_ms = 0;
+    const std::vector<BddStatsSnapshot>& snapshots = stats->snapshots();
+    for (std::size_t i = 0; i < snapshots.size(); ++i) {
+      const BddStatsSnapshot& s = snapshots[i];
+      if (i > 0) out << ",";
+      out << "\n    {\"phase\": " << json_quote(s.phase)
+          << ", \"phase_ms\": " << number(s.elapsed_ms - previous_ms)
+          << ", \"elapsed_ms\": " << number(s.elapsed_ms)
+          << ", \"live_nodes\": " << s.live_nodes
+          << ", \"peak_nodes\": " << s.peak_nodes
+          << ", \"memory_in_use\": " << s.memory_in_use
+          << ", \"garbage_collections\": " << s.garbage_collections
+          << ", \"garbage_collection_ms\": " << s.garbage_collection_ms
+          << ", \"cache_lookups\": " << number(s.cache_lookups)
+          << ", \"cache_hits\": " << number(s.cache_hits)
+          << ", \"reorderings\": " << s.reorderings
+          << ", \"reordering_ms\": " << s.reordering_ms
+          << ", \"peak_rss_kb\": " << s.peak_rss_kb << "}";
+      previous_ms = s.elapsed_ms;
+    }
+    if (!snapshots.empty()) out << "\n  ";
+  }
+  out << "],\n";
+
+  out << "  \"arena_state_bits\": " << size_field(stats, "arena_state_bits") << ",\n";
+  out << "  \"color_dfa_states\": {";
+  if (stats != nullptr) {
+    bool first = true;
+    for (const auto& [color, states] : stats->color_dfa_states()) {
+      out << (first ? "" : ", ") << json_quote(std::to_string(color)) << ": " << states;
+      first = false;
+    }
+  }
+  out << "},\n";
+  out << "  \"dfa_backends\": {";
+  if (stats != nullptr) {
+    bool first = true;
+    for (const auto& [backend, count] : stats->dfa_backend_counts()) {
+      out << (first ? "" : ", ") << json_quote(backend) << ": " << count;
+      first = false;
+    }
+  }
+  out << "},\n";
+  out << "  \"zielonka_tree_nodes\": " << size_field(stats, "zielonka_tree_nodes") << ",\n";
+  out << "  \"mp_dag_nodes\": " << size_field(stats, "mp_dag_nodes") << "\n";
+  out << "}\n";
+  return out.str();
+}
+
+void SynthesisReport::write(const std::string& filename) const {
+  // Written aside and renamed, so that a reader never sees a partial report
+  std::string partial = filename + ".partial";
+  {
+    std::ofstream out(partial);
+    if (!out.is_open()) {
+      throw std::runtime_error("Error: Could not open file for writing: " + filename);
+    }
+    out << to_json();
+    if (!out.good()) {
+      throw std::runtime_error("Error: Could not write the result to: " + filename);
+    }
+  }
+  if (std::rename(partial.c_str(), filename.c_str()) != 0) {
+    std::remove(partial.c_str());
+    throw std::runtime_error("Error: Could not write the result to: " + filename);
+  }
+}
+
+}
@@ -0,0 +1,160 @@
+#include "Trace.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "FlatJson.h"
+
+namespace Syft {
+
+namespace {
+  struct TraceLog {
+    std::mutex mutex;
+    std::string filename;
+    std::vector<std::string> events;
+    std::size_t dropped = 0;
+    // The origin of the timestamps
+    std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    bool at_exit_registered = false;
+  };
+
+  std::atomic<bool> recording(false);
+
+  // Recursive solvers may end millions of spans; beyond this many only the count is kept
+  const std::size_t max_events = std::size_t(1) << 20;
+
+  TraceLog& trace_log() {
+    static TraceLog* log = new TraceLog();  // Never destroyed, so that spans may end during static destruction
+    return *log;
+  }
+
+  // Small thread ids in order of first span, which the viewers show as one track each
+  int current_thread_id() {
+    static std::atomic<int> next_id(1);
+    thread_local int id = next_id++;
+    return id;
+  }
+
+  std::string format_number(double value) {
+    if (!std::isfinite(value)) {
+      return "null";
+    }
+    std::ostringstream out;
+    // Enough digits for timestamps in microseconds
+    out.precision(15);
+    out << value;
+    return out.str();
+  }
+
+  double microseconds(std::chrono::steady_clock::duration duration) {
+    return std::chrono::duration<double, std::micro>(duration).count();
+  }
+
+  void finish_at_exit() {
+    try {
+      Tracer::finish();
+    } catch (const std::exception&) {
+      // Nothing to report to at exit
+    }
+  }
+}
+
+void Tracer::start(const std::string& filename) {
+  TraceLog& log = trace_log();
+  std::lock_guard<std::mutex> lock(log.mutex);
+  log.filename = filename;
+  log.events.clear();
+  log.dropped = 0;
+  if (!log.at_exit_registered) {
+    std::atexit(finish_at_exit);
+    log.at_exit_registered = true;
+  }
+  recording.store(true);
+}
+
+bool Tracer::enabled() {
+  return recording.load(std::memory_order_relaxed);
+}
+
+void Tracer::finish() {
+  if (!recording.exchange(false)) {
+    return;
+  }
+  TraceLog& log = trace_log();
+  std::lock_guard<std::mutex> lock(log.mutex);
+  std::FILE* out = std::fopen(log.filename.c_str(), "w");
+  if (!out) {
+    throw std::runtime_error("Error: Could not open trace file for writing: " + log.filename);
+  }
+  std::fputs("{\"traceEvents\": [\n", out);
+  for (std::size_t i = 0; i < log.events.size(); ++i) {
+    std::fputs(log.events[i].c_str(), out);
+    std::fputs(i + 1 < log.events.size() ? ",\n" : "\n", out);
+  }
+  std::fprintf(out, "], \"displayTimeUnit\": \"ms\", \"otherData\": {\"dropped_spans\": %zu}}\n", log.dropped);
+  std::fclose(out);
+  log.events.clear();
+}
+
+void Tracer::record(const char* name, const char* category, std::chrono::steady_clock::time_point start,
+                    const std::string& args) {
+  auto end = std::chrono::steady_clock::now();
+  TraceLog& log = trace_log();
+  std::string event = "{\"name\": " + json_quote(name) + ", \"cat\": " + json_quote(category) +
+                      ", \"ph\": \"X\", \"ts\": " + format_number(microseconds(start - log.epoch)) +
+                      ", \"dur\": " + format_number(microseconds(end - start)) +
+                      ", \"pid\": " + std::to_string(getpid()) + ", \"tid\": " + std::to_string(current_thread_id()) +
+                      ", \"args\": {" + args + "}}";
+  std::lock_guard<std::mutex> lock(log.mutex);
+  if (log.events.size() < max_events) {
+    log.events.push_back(std::move(event));
+  } else {
+    ++log.dropped;
+  }
+}
+
+TraceScope::TraceScope(const char* name, const char* category)
+  : active_(Tracer::enabled()), name_(name), category_(category) {
+  if (active_) {
+    start_ = std::chrono::steady_clock::now();
+  }
+}
+
+TraceScope::~TraceScope() {
+  // The trace may have been finished by another thread since
+  if (active_ && Tracer::enabled()) {
+    Tracer::record(name_, category_, start_, args_);
+  }
+}
+
+TraceScope& TraceScope::arg(const char* key, double value) {
+  if (active_) {
+    args_ += (args_.empty() ? "" : ", ") + json_quote(key) + ": " + format_number(value);
+  }
+  return *this;
+}
+
+TraceScope& TraceScope::arg(const char* key, const std::string& value) {
+  if (active_) {
+    args_ += (args_.empty() ? "" : ", ") + json_quote(key) + ": " + json_quote(value);
+  }
+  return *this;
+}
+
+TraceScope& TraceScope::bdd(const char* key, const CUDD::BDD& bdd) {
+  if (active_) {
+    arg(key, static_cast<double>(bdd.nodeCount()));
+  }
+  return *this;
+}
+
+}
@@ -3,12 +3,162 @@
 #include <cstring>
 #include <stdexcept>
 #include <sstream>
+#include <utility>
 #include <algorithm>
 
+#include <spdlog/spdlog.h>
+
 namespace Syft {
 
-VarMgr::VarMgr() {
-  mgr_ = std::make_shared<CUDD::Cudd>();
+ReorderPolicy ReorderPolicy::from_string(const std::string& mode,
+                                         const std::string& method) {
+  ReorderPolicy policy;
+
+  if (mode == "off") {
+    policy.mode = ReorderMode::Off;
+  } else if (mode == "auto") {
+    policy.mode = ReorderMode::Auto;
+  } else if (mode == "phase") {
+    policy.mode = ReorderMode::Phase;
+  } else {
+    throw std::runtime_error("Error: Unknown reordering mode: " + mode);
+  }
+
+  if (method == "sift") {
+    policy.method = CUDD_REORDER_SIFT;
+  } else if (method == "sift-converge") {
+    policy.method = CUDD_REORDER_SIFT_CONVERGE;
+  } else if (method == "symm-sift") {
+    policy.method = CUDD_REORDER_SYMM_SIFT;
+  } else if (method == "group-sift") {
+    policy.method = CUDD_REORDER_GROUP_SIFT;
+  } else if (method == "window") {
+    policy.method = CUDD_REORDER_WINDOW3_CONV;
+  } else if (method == "annealing") {
+    policy.method = CUDD_REORDER_ANNEALING;
+  } else if (method == "genetic") {
+    policy.method = CUDD_REORDER_GENETIC;
+  } else if (method == "exact") {
+    policy.method = CUDD_REORDER_EXACT;
+  } else {
+    throw std::runtime_error("Error: Unknown reordering method: " + method);
+  }
+
+  return policy;
+}
+
+VarMgr::VarMgr(const VarMgrOptions& options) {
+  mgr_ = std::make_shared<CUDD::Cudd>(0, 0, options.unique_slots,
+                                      options.cache_slots, options.max_memory);
+
+  if (options.max_cache_hard > 0) {
+    mgr_->SetMaxCacheHard(options.max_cache_hard);
+  }
+  if (options.max_memory > 0) {
+    mgr_->SetMaxMemory(options.max_memory);
+  }
+  if (options.loose_up_to > 0) {
+    mgr_->SetLooseUpTo(options.loose_up_to);
+  }
+
+  set_reorder_policy(options.reorder_policy);
+  stats_.set_enabled(options.collect_stats);
+  budget_ = options.budget;
+  phase_listener_ = options.phase_listener;
+  bdd_backend_kind_ = options.bdd_backend;
+  bdd_threads_ = options.bdd_threads;
+  bdd_backend_ = make_bdd_backend(bdd_backend_kind_, mgr_, bdd_threads_);
+}
+
+void VarMgr::set_reorder_policy(const ReorderPolicy& policy) {
+  reorder_policy_ = policy;
+
+  if (reorder_policy_.mode == ReorderMode::Auto) {
+    mgr_->AutodynEnable(reorder_policy_.method);
+  } else {
+    mgr_->AutodynDisable();
+  }
+}
+
+void VarMgr::reset_caches() {
+  input_cube_.reset();
+  output_cube_.reset();
+  state_cube_cache_.clear();
+  identity_compose_vector_.clear();
+  compose_cache_.clear();
+}
+
+const ReorderPolicy& VarMgr::reorder_policy() const {
+  return reorder_policy_;
+}
+
+std::vector<int> VarMgr::variable_order() const {
+  int size = mgr_->ReadSize();
+  std::vector<int> order;
+  order.reserve(size);
+  for (int level = 0; level < size; ++level) {
+    order.push_back(mgr_->ReadInvPerm(level));
+  }
+  return order;
+}
+
+void VarMgr::set_variable_order(const std::vector<int>& order) {
+  if (order.size() != static_cast<std::size_t>(mgr_->ReadSize())) {
+    throw std::runtime_error("Error: Variable order of " + std::to_string(order.size()) +
+                             " variables for a manager of " + std::to_string(mgr_->ReadSize()));
+  }
+  if (!order.empty()) {
+    std::vector<int> levels(order);
+    mgr_->ShuffleHeap(levels.data());
+  }
+}
+
+void VarMgr::reorder_at_phase(const std::string& phase) const {
+  if (reorder_policy_.mode != ReorderMode::Phase) {
+    return;
+  }
+
+  long nodes_before = mgr_->ReadNodeCount();
+  mgr_->ReduceHeap(reorder_policy_.method, 0);
+  spdlog::info("[VarMgr] reordered after {}: {} -> {} live nodes", phase,
+               nodes_before, mgr_->ReadNodeCount());
+}
+
+void VarMgr::end_phase(const std::string& phase) const {
+  reorder_at_phase(phase);
+  snapshot_stats(phase);
+  if (phase_listener_) {
+    phase_listener_(SolverStats::read(*mgr_, phase));
+  }
+  check_budget(phase);
+}
+
+void VarMgr::snapshot_stats(const std::string& phase) const {
+  stats_.snapshot(*mgr_, phase);
+}
+
+const SolverStats& VarMgr::stats() const {
+  return stats_;
+}
+
+void VarMgr::record_size(const std::string& name, double value) const {
+  stats_.record_size(name, value);
+}
+
+void VarMgr::record_color_states(int color, int states) const {
+  stats_.record_color_states(color, states);
+}
+
+void VarMgr::record_dfa_backend(const std::string& backend) const {
+  stats_.record_dfa_backend(backend);
+}
+
+void VarMgr::check_budget(const std::string& phase) const {
+  budget_.check(*mgr_, phase);
+}
+
+void VarMgr::set_budget(SolveBudget budget) {
+  budget_ = std::move(budget);
 }
 
 void VarMgr::print_mgr() const {
@@ -50,6 +200,8 @@ void VarMgr::print_mgr() const {
 
 void VarMgr::create_named_variables(
     const std::vector<std::string>& variable_names) {
+  reset_caches();
+
   for (const std::string& name : variable_names) {
     // Only create the variable if it doesn't already exist
     if (name_to_variable_.find(name) == name_to_variable_.end()) {
@@ -66,6 +218,8 @@ void VarMgr::create_named_variables(
 }
 
 std::size_t VarMgr::create_state_variables(std::size_t variable_count) {
+  reset_caches();
+
   std::size_t automaton_id = state_variables_.size();
 
   // Creates an additional space for variables at index automaton_id,
@@ -93,6 +247,8 @@ std::size_t VarMgr::create_state_variables(std::size_t variable_count) {
 }
 
 std::size_t VarMgr::create_named_state_variables(const std::vector<std::string>& vars) {
+  reset_caches();
+
   std::size_t automaton_id = state_variables_.size();
   std::size_t added_vars = 0;
 
@@ -203,6 +359,8 @@ void VarMgr::partition_variables(const std::vector<std::string>& input_names,
                 "Error: Input-output partition is the wrong size.");
     }
   
+  reset_caches();
+
   for (const std::string& input_name : input_names) {
     input_variables_.push_back(name_to_variable(input_name));
   }
@@ -216,6 +374,59 @@ std::shared_ptr<CUDD::Cudd> VarMgr::cudd_mgr() const {
   return mgr_;
 }
 
+const BddBackend& VarMgr::bdd_backend() const {
+  return *bdd_backend_;
+}
+
+std::shared_ptr<VarMgr> VarMgr::clone() const {
+  auto copy = std::make_shared<VarMgr>();
+
+  // Same indices, then the same order of levels
+  int size = mgr_->ReadSize();
+  std::vector<int> order(size);
+  for (int index = 0; index < size; ++index) {
+    copy->mgr_->bddVar(index);
+    order[mgr_->ReadPerm(index)] = index;
+  }
+  if (size > 0) {
+    copy->mgr_->ShuffleHeap(order.data());
+  }
+
+  auto same_variable = [&copy](const CUDD::BDD& variable) {
+    return copy->mgr_->bddVar(variable.NodeReadIndex());
+  };
+  auto same_variables = [&same_variable](const std::vector<CUDD::BDD>& variables) {
+    std::vector<CUDD::BDD> result;
+    result.reserve(variables.size());
+    for (const CUDD::BDD& variable : variables) {
+      result.push_back(same_variable(variable));
+    }
+    return result;
+  };
+
+  copy->index_to_name_ = index_to_name_;
+  for (const auto& [name, variable] : name_to_variable_) {
+    copy->name_to_variable_[name] = same_variable(variable);
+  }
+  copy->state_variable_count_ = state_variable_count_;
+  for (const std::vector<CUDD::BDD>& variables : state_variables_) {
+    copy->state_variables_.push_back(same_variables(variables));
+  }
+  copy->input_variables_ = same_variables(input_variables_);
+  copy->output_variables_ = same_variables(output_variables_);
+  copy->index_to_name_vec_ = index_to_name_vec_;
+  for (const auto& [name, variable] : name_to_variable_vec_) {
+    copy->name_to_variable_vec_.emplace_back(name, same_variable(variable));
+  }
+  copy->set_reorder_policy(reorder_policy_);
+  copy->budget_ = budget_;
+  copy->bdd_backend_kind_ = bdd_backend_kind_;
+  copy->bdd_threads_ = bdd_threads_;
+  copy->bdd_backend_ = make_bdd_backend(bdd_backend_kind_, copy->mgr_, bdd_threads_);
+
+  return copy;
+}
+
 CUDD::BDD VarMgr::name_to_variable(const std::string& name) const {
   return name_to_variable_.at(name);
 }
@@ -244,16 +455,27 @@ std::size_t VarMgr::output_variable_count() const {
   return output_variables_.size();
 }
 
-CUDD::BDD VarMgr::input_cube() const {
-  return mgr_->computeCube(input_variables_);
+const CUDD::BDD& VarMgr::input_cube() const {
+  if (!input_cube_) {
+    input_cube_ = mgr_->computeCube(input_variables_);
+  }
+  return *input_cube_;
 }
 
-CUDD::BDD VarMgr::output_cube() const {
-  return mgr_->computeCube(output_variables_);
+const CUDD::BDD& VarMgr::output_cube() const {
+  if (!output_cube_) {
+    output_cube_ = mgr_->computeCube(output_variables_);
+  }
+  return *output_cube_;
 }
 
-CUDD::BDD VarMgr::state_variables_cube(std::size_t automaton_id) const {
-    return mgr_->computeCube(state_variables_[automaton_id]);
+const CUDD::BDD& VarMgr::state_variables_cube(std::size_t automaton_id) const {
+  auto it = state_cube_cache_.find(automaton_id);
+  if (it == state_cube_cache_.end()) {
+    it = state_cube_cache_.emplace(
+        automaton_id, mgr_->computeCube(state_variables_[automaton_id])).first;
+  }
+  return it->second;
 }
 
 std::vector<int> VarMgr::make_eval_vector(
@@ -280,41 +502,46 @@ std::vector<int> VarMgr::make_state_eval_vector(
     return eval_vector;
 }
 
-std::vector<CUDD::BDD> VarMgr::make_compose_vector(
-    std::size_t automaton_id, const std::vector<CUDD::BDD>& state_bdds) const {
-  std::vector<CUDD::BDD> compose_vector(total_variable_count(),
-					mgr_->bddZero());
-
-  // All named variables get mapped to the variable itself
-  for (const auto& name_and_variable : name_to_variable_) {
-    CUDD::BDD variable = name_and_variable.second;
-    std::size_t index = variable.NodeReadIndex();
-    compose_vector[index] = variable;
-  }
+const std::vector<CUDD::BDD>& VarMgr::identity_compose_vector() const {
+  if (identity_compose_vector_.empty()) {
+    identity_compose_vector_.assign(total_variable_count(), mgr_->bddZero());
 
-  // State variables for other automaton ids get mapped to the variable itself
-  
-  for (std::size_t id = 0; id < automaton_id; ++id) {
-    for (const CUDD::BDD& variable : state_variables_[id]) {
+    // Every variable, named or state, gets mapped to the variable itself
+    for (const auto& name_and_variable : name_to_variable_) {
+      CUDD::BDD variable = name_and_variable.second;
       std::size_t index = variable.NodeReadIndex();
-      compose_vector[index] = variable;
+      identity_compose_vector_[index] = variable;
     }
-  }
 
-  for (std::size_t id = automaton_id + 1; id < state_variables_.size(); ++id) {
-    for (const CUDD::BDD& variable : state_variables_[id]) {
-      std::size_t index = variable.NodeReadIndex();
-      compose_vector[index] = variable;
+    for (const auto& variables : state_variables_) {
+      for (const CUDD::BDD& variable : variables) {
+        std::size_t index = variable.NodeReadIndex();
+        identity_compose_vector_[index] = variable;
+      }
     }
   }
 
+  return identity_compose_vector_;
+}
+
+const std::vector<CUDD::BDD>& VarMgr::make_compose_vector(
+    std::size_t automaton_id, const std::vector<CUDD::BDD>& state_bdds) const {
+  auto it = compose_cache_.find(automaton_id);
+  if (it != compose_cache_.end() && it->second.state_bdds == state_bdds) {
+    return it->second.compose_vector;
+  }
+
+  ComposeCacheEntry& entry = compose_cache_[automaton_id];
+  entry.state_bdds = state_bdds;
+  entry.compose_vector = identity_compose_vector();
+
   // The i-th state variable gets mapped to the i-th BDD from the input
   for (std::size_t i = 0; i < state_variables_[automaton_id].size(); ++i) {
     std::size_t index = state_variables_[automaton_id][i].NodeReadIndex();
-    compose_vector[index] = state_bdds[i];
+    entry.compose_vector[index] = state_bdds[i];
   }
 
-  return compose_vector;
+  return entry.compose_vector;
 }
   
 std::vector<std::string> VarMgr::variable_labels() const {
@@ -0,0 +1,271 @@
+#include "VariableOrdering.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+#include <lydia/logic/ltlfplus/base.hpp>
+#include <lydia/logic/ppltlplus/base.hpp>
+#include <lydia/utils/print.hpp>
+#include <lydia/visitor.hpp>
+
+namespace Syft {
+
+    namespace {
+
+        typedef std::set<std::set<std::string>> HyperedgeSet;
+
+        // Records the support of every subformula with at least two variables
+        class LTLfHyperedgeVisitor : public whitemech::lydia::Visitor {
+        public:
+            explicit LTLfHyperedgeVisitor(HyperedgeSet &hyperedges) : hyperedges_(hyperedges) {}
+
+            void visit(const whitemech::lydia::LTLfTrue &) override { support_.clear(); }
+
+            void visit(const whitemech::lydia::LTLfFalse &) override { support_.clear(); }
+
+            void visit(const whitemech::lydia::LTLfAtom &formula) override {
+                support_ = {formula.symbol->get_name()};
+            }
+
+            void visit(const whitemech::lydia::LTLfNot &formula) override { support_ = apply(*formula.get_arg()); }
+
+            void visit(const whitemech::lydia::LTLfAnd &formula) override { join(formula.get_args()); }
+
+            void visit(const whitemech::lydia::LTLfOr &formula) override { join(formula.get_args()); }
+
+            void visit(const whitemech::lydia::LTLfNext &formula) override { support_ = apply(*formula.get_arg()); }
+
+            void visit(const whitemech::lydia::LTLfWeakNext &formula) override {
+                support_ = apply(*formula.get_arg());
+            }
+
+            void visit(const whitemech::lydia::LTLfUntil &formula) override { join(formula.get_args()); }
+
+            void visit(const whitemech::lydia::LTLfRelease &formula) override { join(formula.get_args()); }
+
+            void visit(const whitemech::lydia::LTLfEventually &formula) override {
+                support_ = apply(*formula.get_arg());
+            }
+
+            void visit(const whitemech::lydia::LTLfAlways &formula) override {
+                support_ = apply(*formula.get_arg());
+            }
+
+            std::set<std::string> apply(const whitemech::lydia::LTLfFormula &formula) {
+                formula.accept(*this);
+                if (support_.size() >= 2) {
+                    hyperedges_.insert(support_);
+                }
+                return support_;
+            }
+
+        private:
+            HyperedgeSet &hyperedges_;
+            std::set<std::string> support_;
+
+            template<typename Args>
+            void join(const Args &args) {
+                std::set<std::string> support;
+                for (const auto &arg: args) {
+                    std::set<std::string> operand = apply(*arg);
+                    support.insert(operand.begin(), operand.end());
+                }
+                support_ = std::move(support);
+            }
+        };
+
+        class PPLTLHyperedgeVisitor : public whitemech::lydia::Visitor {
+        public:
+            explicit PPLTLHyperedgeVisitor(HyperedgeSet &hyperedges) : hyperedges_(hyperedges) {}
+
+            void visit(const whitemech::lydia::PPLTLTrue &) override { support_.clear(); }
+
+            void visit(const whitemech::lydia::PPLTLFalse &) override { support_.clear(); }
+
+            void visit(const whitemech::lydia::PPLTLAtom &formula) override { support_ = {printer_.apply(formula)}; }
+
+            void visit(const whitemech::lydia::PPLTLAnd &formula) override { join(formula.get_container()); }
+
+            void visit(const whitemech::lydia::PPLTLOr &formula) override { join(formula.get_container()); }
+
+            void visit(const whitemech::lydia::PPLTLNot &formula) override { support_ = apply(*formula.get_arg()); }
+
+            void visit(const whitemech::lydia::PPLTLYesterday &formula) override {
+                support_ = apply(*formula.get_arg());
+            }
+
+            void visit(const whitemech::lydia::PPLTLWeakYesterday &formula) override {
+                support_ = apply(*formula.get_arg());
+            }
+
+            void visit(const whitemech::lydia::PPLTLSince &formula) override { join(formula.get_args()); }
+
+            void visit(const whitemech::lydia::PPLTLTriggered &formula) override { join(formula.get_args()); }
+
+            void visit(const whitemech::lydia::PPLTLOnce &formula) override { support_ = apply(*formula.get_arg()); }
+
+            void visit(const whitemech::lydia::PPLTLHistorically &formula) override {
+                support_ = apply(*formula.get_arg());
+            }
+
+            std::set<std::string> apply(const whitemech::lydia::PPLTLFormula &formula) {
+                formula.accept(*this);
+                if (support_.size() >= 2) {
+                    hyperedges_.insert(support_);
+                }
+                return support_;
+            }
+
+        private:
+            HyperedgeSet &hyperedges_;
+            std::set<std::string> support_;
+            whitemech::lydia::StrPrinter printer_;
+
+            template<typename Args>
+            void join(const Args &args) {
+                std::set<std::string> support;
+                for (const auto &arg: args) {
+                    std::set<std::string> operand = apply(*arg);
+                    support.insert(operand.begin(), operand.end());
+                }
+                support_ = std::move(support);
+            }
+        };
+
+        std::vector<std::string> partition_order(const InputOutputPartition &partition) {
+            std::vector<std::string> variables = partition.input_variables;
+            variables.insert(variables.end(), partition.output_variables.begin(), partition.output_variables.end());
+            return variables;
+        }
+
+        double total_span(const std::vector<std::vector<std::size_t>> &edges, const std::vector<double> &position) {
+            double span = 0;
+            for (const auto &edge: edges) {
+                double low = std::numeric_limits<double>::max(), high = std::numeric_limits<double>::lowest();
+                for (std::size_t vertex: edge) {
+                    low = std::min(low, position[vertex]);
+                    high = std::max(high, position[vertex]);
+                }
+                span += high - low;
+            }
+            return span;
+        }
+    }
+
+    std::vector<std::set<std::string>> ltlf_plus_hyperedges(const LTLfPlus &formula) {
+        HyperedgeSet hyperedges;
+        LTLfHyperedgeVisitor visitor(hyperedges);
+        for (const auto &[ltlf_plus_arg, quantifier]: formula.formula_to_quantification_) {
+            visitor.apply(*ltlf_plus_arg->ltlf_arg());
+        }
+        return {hyperedges.begin(), hyperedges.end()};
+    }
+
+    std::vector<std::set<std::string>> ppltl_plus_hyperedges(const PPLTLPlus &formula) {
+        HyperedgeSet hyperedges;
+        PPLTLHyperedgeVisitor visitor(hyperedges);
+        for (const auto &[ppltl_plus_arg, quantifier]: formula.formula_to_quantification_) {
+            visitor.apply(*ppltl_plus_arg->ppltl_arg());
+        }
+        return {hyperedges.begin(), hyperedges.end()};
+    }
+
+    std::vector<std::string> force_order(const std::vector<std::string> &variables,
+                                         const std::vector<std::set<std::string>> &hyperedges,
+                                         std::size_t max_passes) {
+        std::unordered_map<std::string, std::size_t> vertex_of;
+        for (std::size_t i = 0; i < variables.size(); ++i) {
+            vertex_of.emplace(variables[i], i);
+        }
+        // The hyperedges over the given variables, and the hyperedges of each variable
+        std::vector<std::vector<std::size_t>> edges;
+        std::vector<std::vector<std::size_t>> edges_of(variables.size());
+        for (const auto &hyperedge: hyperedges) {
+            std::vector<std::size_t> edge;
+            for (const std::string &name: hyperedge) {
+                auto vertex = vertex_of.find(name);
+                if (vertex != vertex_of.end()) {
+                    edge.push_back(vertex->second);
+                }
+            }
+            if (edge.size() < 2) {
+                continue;
+            }
+            for (std::size_t vertex: edge) {
+                edges_of[vertex].push_back(edges.size());
+            }
+            edges.push_back(std::move(edge));
+        }
+
+        std::vector<std::size_t> order(variables.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::vector<double> position(variables.size());
+        for (std::size_t rank = 0; rank < order.size(); ++rank) {
+            position[order[rank]] = static_cast<double>(rank);
+        }
+        std::vector<std::size_t> best_order = order;
+        double best_span = total_span(edges, position);
+
+        for (std::size_t pass = 0; pass < max_passes && !edges.empty(); ++pass) {
+            std::vector<double> center(edges.size(), 0);
+            for (std::size_t e = 0; e < edges.size(); ++e) {
+                for (std::size_t vertex: edges[e]) {
+                    center[e] += position[vertex];
+                }
+                center[e] /= static_cast<double>(edges[e].size());
+            }
+            std::vector<double> target(position);
+            for (std::size_t vertex = 0; vertex < variables.size(); ++vertex) {
+                if (edges_of[vertex].empty()) {
+                    continue;
+                }
+                double sum = 0;
+                for (std::size_t e: edges_of[vertex]) {
+                    sum += center[e];
+                }
+                target[vertex] = sum / static_cast<double>(edges_of[vertex].size());
+            }
+            std::stable_sort(order.begin(), order.end(), [&target](std::size_t a, std::size_t b) {
+                return target[a] < target[b];
+            });
+            for (std::size_t rank = 0; rank < order.size(); ++rank) {
+                position[order[rank]] = static_cast<double>(rank);
+            }
+
+            double span = total_span(edges, position);
+            if (span >= best_span) {
+                break;
+            }
+            best_span = span;
+            best_order = order;
+        }
+
+        std::vector<std::string> result;
+        result.reserve(variables.size());
+        for (std::size_t vertex: best_order) {
+            result.push_back(variables[vertex]);
+        }
+        return result;
+    }
+
+    std::vector<std::string> proposition_order(const InputOutputPartition &partition, const LTLfPlus &formula,
+                                               PropositionOrder order) {
+        std::vector<std::string> variables = partition_order(partition);
+        if (order == PropositionOrder::Force) {
+            return force_order(variables, ltlf_plus_hyperedges(formula));
+        }
+        return variables;
+    }
+
+    std::vector<std::string> proposition_order(const InputOutputPartition &partition, const PPLTLPlus &formula,
+                                               PropositionOrder order) {
+        std::vector<std::string> variables = partition_order(partition);
+        if (order == PropositionOrder::Force) {
+            return force_order(variables, ppltl_plus_hyperedges(formula));
+        }
+        return variables;
+    }
+
+}
@@ -0,0 +1,367 @@
+#include "automata/ColorAutomatonBuilder.h"
+
+#include <limits>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+#include "Trace.h"
+#include "automata/PrecompiledAutomata.h"
+#include "lydia/utils/print.hpp"
+#include "lydia/logic/ltlfplus/base.hpp"
+
+namespace Syft {
+
+    namespace {
+        // How the DFA of an LTLf argument is built: explicitly for a leaf, or
+        // as the product of the DFAs of its operands
+        struct DfaPlan {
+            whitemech::lydia::ltlf_ptr formula;  // of a leaf, null for a product
+            bool conjunction = true;
+            std::vector<DfaPlan> operands;
+            std::size_t slot = 0;  // of a leaf, among the explicit DFAs built
+        };
+
+        DfaPlan plan_dfa(const whitemech::lydia::ltlf_ptr &formula, const QuantifierTransform &transform,
+                         std::size_t max_bits) {
+            DfaPlan leaf{formula};
+            bool conjunction = whitemech::lydia::is_a<const whitemech::lydia::LTLfAnd>(*formula);
+            bool disjunction = whitemech::lydia::is_a<const whitemech::lydia::LTLfOr>(*formula);
+            if (max_bits == 0 || !((conjunction && transform.distributes_over_and) ||
+                                   (disjunction && transform.distributes_over_or)) ||
+                ColorAutomatonBuilder::estimated_state_bits(*formula) <= max_bits) {
+                return leaf;
+            }
+
+            std::vector<whitemech::lydia::ltlf_ptr> args;
+            if (conjunction) {
+                const auto &container = static_cast<const whitemech::lydia::LTLfAnd &>(*formula).get_args();
+                args.assign(container.begin(), container.end());
+            } else {
+                const auto &container = static_cast<const whitemech::lydia::LTLfOr &>(*formula).get_args();
+                args.assign(container.begin(), container.end());
+            }
+
+            // Packs consecutive arguments into groups that fit the explicit construction
+            std::vector<std::vector<whitemech::lydia::ltlf_ptr>> groups;
+            std::size_t group_bits = 0;
+            for (const whitemech::lydia::ltlf_ptr &arg: args) {
+                std::size_t bits = ColorAutomatonBuilder::estimated_state_bits(*arg);
+                if (groups.empty() || group_bits + bits > max_bits) {
+                    groups.emplace_back();
+                    group_bits = 0;
+                }
+                groups.back().push_back(arg);
+                group_bits += bits;
+            }
+
+            DfaPlan product;
+            product.conjunction = conjunction;
+            for (std::vector<whitemech::lydia::ltlf_ptr> &group: groups) {
+                if (group.size() == 1) {
+                    product.operands.push_back(plan_dfa(group.front(), transform, max_bits));
+                } else {
+                    whitemech::lydia::set_ltlf_formulas operands(group.begin(), group.end());
+                    product.operands.push_back(DfaPlan{conjunction ? formula->ctx().makeLtlfAnd(operands)
+                                                                   : formula->ctx().makeLtlfOr(operands)});
+                }
+            }
+            return product;
+        }
+
+        template<typename Visit>
+        void for_each_leaf(DfaPlan &plan, const Visit &visit) {
+            if (plan.formula) {
+                visit(plan);
+                return;
+            }
+            for (DfaPlan &operand: plan.operands) {
+                for_each_leaf(operand, visit);
+            }
+        }
+
+        SymbolicStateDfa assemble(const DfaPlan &plan, std::vector<SymbolicStateDfa> &built) {
+            if (plan.formula) {
+                return std::move(built[plan.slot]);
+            }
+            std::vector<SymbolicStateDfa> operands;
+            operands.reserve(plan.operands.size());
+            for (const DfaPlan &operand: plan.operands) {
+                operands.push_back(assemble(operand, built));
+            }
+            return plan.conjunction ? SymbolicStateDfa::product_AND(std::move(operands))
+                                    : SymbolicStateDfa::product_OR(std::move(operands));
+        }
+    }
+
+    ColorAutomatonBuilder::ColorAutomatonBuilder(std::shared_ptr<VarMgr> var_mgr, DfaConstructionOptions options)
+            : var_mgr_(std::move(var_mgr)), options_(std::move(options)), one_step_(var_mgr_),
+              backend_selector_(options_.dfa_backend) {
+        if (options_.shared_cache) {
+            dfa_cache_ = options_.shared_cache;
+        } else if (!options_.cache_directory.empty()) {
+            dfa_cache_ = std::make_shared<DfaCache>(options_.cache_directory);
+        }
+        if (options_.precompiled) {
+            for (const std::string &name: var_mgr_->input_variable_labels()) {
+                partitioned_.insert(name);
+            }
+            for (const std::string &name: var_mgr_->output_variable_labels()) {
+                partitioned_.insert(name);
+            }
+        }
+    }
+
+    QuantifierTransform ColorAutomatonBuilder::emerson_lei_transform(whitemech::lydia::PrefixQuantifier quantifier) {
+        switch (quantifier) {
+            case whitemech::lydia::PrefixQuantifier::ForallExists:
+            case whitemech::lydia::PrefixQuantifier::ExistsForall:
+                return {"dfa", [](ExplicitStateDfa dfa) { return dfa; }, true, true};
+            case whitemech::lydia::PrefixQuantifier::Forall:
+                // Every prefix satisfies a conjunction iff every prefix satisfies each argument
+                return {"dfa_to_Gdfa", [](ExplicitStateDfa dfa) { return ExplicitStateDfa::dfa_to_Gdfa(dfa); },
+                        true, false};
+            case whitemech::lydia::PrefixQuantifier::Exists:
+                // Some prefix satisfies a disjunction iff some prefix satisfies one of its arguments
+                return {"dfa_to_Fdfa", [](ExplicitStateDfa dfa) { return ExplicitStateDfa::dfa_to_Fdfa(dfa); },
+                        false, true};
+            default:
+                throw std::runtime_error("Invalid argument in map LTLf+ formula to prefix quantification");
+        }
+    }
+
+    QuantifierTransform ColorAutomatonBuilder::manna_pnueli_transform(whitemech::lydia::PrefixQuantifier quantifier,
+                                                                      int game_solver) {
+        switch (quantifier) {
+            case whitemech::lydia::PrefixQuantifier::ForallExists:
+            case whitemech::lydia::PrefixQuantifier::ExistsForall:
+                return {"dfa", [](ExplicitStateDfa dfa) { return dfa; }, true, true};
+            case whitemech::lydia::PrefixQuantifier::Forall:
+                if (game_solver == 1) {
+                    return {"dfa_remove_initial_self_loops", [](ExplicitStateDfa dfa) {
+                        return ExplicitStateDfa::dfa_remove_initial_self_loops(dfa);
+                    }};
+                }
+                return {"dfa_to_Gdfa+dfa_remove_initial_self_loops", [](ExplicitStateDfa dfa) {
+                    ExplicitStateDfa g_dfa = ExplicitStateDfa::dfa_to_Gdfa(dfa);
+                    return ExplicitStateDfa::dfa_remove_initial_self_loops(g_dfa);
+                }};
+            case whitemech::lydia::PrefixQuantifier::Exists:
+                if (game_solver == 1) {
+                    return {"dfa", [](ExplicitStateDfa dfa) { return dfa; }, true, true};
+                }
+                return {"dfa_to_Fdfa", [](ExplicitStateDfa dfa) { return ExplicitStateDfa::dfa_to_Fdfa(dfa); },
+                        false, true};
+            default:
+                throw std::runtime_error("Invalid argument in map LTLf+ formula to prefix quantification");
+        }
+    }
+
+    std::size_t ColorAutomatonBuilder::estimated_state_bits(const whitemech::lydia::LTLfFormula &formula) {
+        return formula_shape(formula).temporal_operators;
+    }
+
+    std::optional<bool> ColorAutomatonBuilder::constant_color(const whitemech::lydia::LTLfFormula &formula,
+                                                              whitemech::lydia::PrefixQuantifier quantifier,
+                                                              int color) const {
+        if (!options_.one_step_colors) {
+            return std::nullopt;
+        }
+        std::optional<bool> value = one_step_.constant_value(formula, quantifier);
+        if (value) {
+            spdlog::info("[ColorAutomatonBuilder] color {} is {} on every play, its DFA is skipped",
+                         color, *value ? "true" : "false");
+        }
+        return value;
+    }
+
+    ExplicitStateDfa ColorAutomatonBuilder::transformed_dfa(const whitemech::lydia::LTLfFormula &formula,
+                                                            const QuantifierTransform &transform,
+                                                            const std::string &key) const {
+        if (options_.precompiled) {
+            if (std::optional<std::string> file = options_.precompiled->find(formula)) {
+                // Not cached: reading the file is the cheap path the cache stands for
+                TraceScope trace("precompiled DFA", "automata");
+                ExplicitStateDfa dfa = PrecompiledAutomata::load(*file);
+                for (const std::string &name: dfa.names) {
+                    if (!partitioned_.count(name)) {
+                        throw std::runtime_error("Error: The automaton " + *file + " reads " + name +
+                                                 ", which is not a variable of the partition");
+                    }
+                }
+                spdlog::info("[ColorAutomatonBuilder] read the DFA of {} from {}",
+                             whitemech::lydia::to_string(formula), *file);
+                dfa = transform.apply(std::move(dfa));
+                var_mgr_->record_dfa_backend("precompiled");
+                trace.arg("transform", transform.name).arg("states", dfa.dfa_->ns);
+                return dfa;
+            }
+        }
+        auto build = [&]() -> ExplicitStateDfa {
+            TraceScope trace("color DFA", "automata");
+            DfaBackend backend;
+            ExplicitStateDfa dfa = transform.apply(backend_selector_.build(formula, &backend));
+            var_mgr_->record_dfa_backend(to_string(backend));
+            trace.arg("transform", transform.name).arg("backend", to_string(backend)).arg("states", dfa.dfa_->ns);
+            return dfa;
+        };
+        if (!dfa_cache_) {
+            return build();
+        }
+        return dfa_cache_->get_or_build(key, build);
+    }
+
+    std::map<int, SharedExplicitStateDfa> ColorAutomatonBuilder::build_explicit(const LTLfPlus &formula,
+                                                                                const TransformPolicy &policy) const {
+        std::map<int, SharedExplicitStateDfa> color_to_dfa;
+        std::unordered_map<std::string, SharedExplicitStateDfa> key_to_dfa;
+        for (const auto &[ltlf_plus_arg, prefix_quantifier]: formula.formula_to_quantification_) {
+            var_mgr_->check_budget("DFA construction");
+            whitemech::lydia::ltlf_ptr ltlf_arg = ltlf_plus_arg->ltlf_arg();
+            int color = std::stoi(formula.formula_to_color_.at(ltlf_plus_arg));
+            // The explicit DFAs are read by their final states, which only match the value of A and E colors
+            bool obligation = prefix_quantifier == whitemech::lydia::PrefixQuantifier::Forall ||
+                              prefix_quantifier == whitemech::lydia::PrefixQuantifier::Exists;
+            std::optional<bool> value = obligation ? constant_color(*ltlf_arg, prefix_quantifier, color)
+                                                   : std::nullopt;
+            if (value) {
+                color_to_dfa.insert({color, std::make_shared<ExplicitStateDfa>(ExplicitStateDfa::dfa_constant(*value))});
+                continue;
+            }
+            QuantifierTransform transform = policy(prefix_quantifier);
+            std::string key = DfaCache::cache_key(transform.name, *ltlf_arg);
+
+            auto built = key_to_dfa.find(key);
+            if (built == key_to_dfa.end()) {
+                built = key_to_dfa.emplace(
+                        key, std::make_shared<ExplicitStateDfa>(transformed_dfa(*ltlf_arg, transform, key))).first;
+            }
+            color_to_dfa.insert({color, built->second});
+        }
+        for (const auto &[color, dfa]: color_to_dfa) {
+            var_mgr_->record_color_states(color, dfa->dfa_->ns);
+        }
+        spdlog::debug("[ColorAutomatonBuilder::build_explicit] {} subformulas share {} DFAs",
+                      formula.formula_to_quantification_.size(), key_to_dfa.size());
+        return color_to_dfa;
+    }
+
+    ColorArenas ColorAutomatonBuilder::build_symbolic(const LTLfPlus &formula, const TransformPolicy &policy) const {
+        // The DFA key and quantifier of each color; the first argument of a color wins
+        std::map<int, std::pair<std::string, whitemech::lydia::PrefixQuantifier>> color_to_key;
+        std::vector<std::function<ExplicitStateDfa()>> dfa_builders;
+        // The DFAs to build, by key, from the explicit DFAs of the builders
+        std::vector<std::pair<std::string, DfaPlan>> plans;
+        std::vector<int> built_states;
+        std::set<std::string> keys;
+        // The goal states of the colors decided by their first step
+        std::map<int, bool> color_to_constant;
+        for (const auto &[ltlf_plus_arg, prefix_quantifier]: formula.formula_to_quantification_) {
+            whitemech::lydia::ltlf_ptr ltlf_arg = ltlf_plus_arg->ltlf_arg();
+            int color = std::stoi(formula.formula_to_color_.at(ltlf_plus_arg));
+            if (std::optional<bool> value = constant_color(*ltlf_arg, prefix_quantifier, color)) {
+                // The goal states of an EA color are the complement of its value
+                bool goal = prefix_quantifier == whitemech::lydia::PrefixQuantifier::ExistsForall ? !*value : *value;
+                color_to_constant.insert({color, goal});
+                continue;
+            }
+            QuantifierTransform transform = policy(prefix_quantifier);
+            std::string key = DfaCache::cache_key(transform.name, *ltlf_arg);
+            color_to_key.insert({color, {key, prefix_quantifier}});
+            if (!keys.insert(key).second || symbolic_dfas_.count(key) > 0) {
+                continue;
+            }
+            // A precompiled DFA is read whole rather than composed
+            DfaPlan plan = options_.precompiled && options_.precompiled->find(*ltlf_arg)
+                ? DfaPlan{ltlf_arg} : plan_dfa(ltlf_arg, transform, options_.symbolic_construction_bits);
+            for_each_leaf(plan, [&](DfaPlan &leaf) {
+                leaf.slot = dfa_builders.size();
+                // A leaf of a product is its own DFA, with its own key
+                std::string leaf_key = leaf.formula == ltlf_arg ? key : DfaCache::cache_key(transform.name, *leaf.formula);
+                dfa_builders.push_back([this, formula = leaf.formula, transform, leaf_key, &built_states,
+                                        i = leaf.slot]() {
+                    ExplicitStateDfa dfa = transformed_dfa(*formula, transform, leaf_key);
+                    // Each builder runs once, on a single thread
+                    built_states[i] = dfa.dfa_->ns;
+                    return dfa;
+                });
+            });
+            if (!plan.formula) {
+                spdlog::info("[ColorAutomatonBuilder] the DFA of color {} is the product of {} DFAs, estimated at {} "
+                             "state bits", color, plan.operands.size(), estimated_state_bits(*ltlf_arg));
+            }
+            plans.emplace_back(key, std::move(plan));
+        }
+        built_states.resize(dfa_builders.size());
+
+        TraceScope trace("color DFAs", "automata");
+        std::vector<SymbolicStateDfa> built =
+                SymbolicStateDfa::from_explicit_parallel(var_mgr_, dfa_builders, options_.threads,
+                                                         options_.state_encoding);
+        if (trace.active()) {
+            double transition_nodes = 0;
+            for (const SymbolicStateDfa &dfa: built) {
+                for (const CUDD::BDD &function: dfa.transition_function()) {
+                    transition_nodes += function.nodeCount();
+                }
+            }
+            trace.arg("built", static_cast<double>(built.size())).arg("transition_nodes", transition_nodes);
+        }
+        for (auto &[key, plan]: plans) {
+            // A product has at most the product of the states of its leaves
+            int states = 1;
+            for_each_leaf(plan, [&](DfaPlan &leaf) {
+                states = built_states[leaf.slot] > std::numeric_limits<int>::max() / states
+                         ? std::numeric_limits<int>::max() : states * built_states[leaf.slot];
+            });
+            symbolic_dfas_.emplace(key, assemble(plan, built));
+            dfa_states_.emplace(key, states);
+        }
+        spdlog::debug("[ColorAutomatonBuilder::build_symbolic] {} subformulas share {} DFAs, {} built from {} "
+                      "explicit DFAs", formula.formula_to_quantification_.size(), keys.size(), plans.size(),
+                      dfa_builders.size());
+
+        ColorArenas arenas;
+        std::set<int> colors;
+        for (const auto &[color, entry]: color_to_key) {
+            colors.insert(color);
+        }
+        for (const auto &[color, goal]: color_to_constant) {
+            colors.insert(color);
+        }
+        std::set<std::size_t> automaton_ids;
+        for (int color: colors) {
+            auto keyed = color_to_key.find(color);
+            if (keyed == color_to_key.end()) {
+                arenas.colors.push_back(color);
+                arenas.goal_states.push_back(color_to_constant.at(color) ? var_mgr_->cudd_mgr()->bddOne()
+                                                                          : var_mgr_->cudd_mgr()->bddZero());
+                var_mgr_->record_color_states(color, 0);
+                continue;
+            }
+            const auto &entry = keyed->second;
+            const SymbolicStateDfa &dfa = symbolic_dfas_.at(entry.first);
+            var_mgr_->record_color_states(color, dfa_states_.at(entry.first));
+            // A shared DFA enters the product once
+            if (automaton_ids.insert(dfa.automaton_id()).second) {
+                arenas.components.push_back(dfa);
+            }
+            arenas.colors.push_back(color);
+            if (entry.second == whitemech::lydia::PrefixQuantifier::ExistsForall) {
+                arenas.goal_states.push_back(!dfa.final_states());
+            } else {
+                arenas.goal_states.push_back(dfa.final_states());
+            }
+        }
+        if (arenas.components.empty()) {
+            // Every color is constant; the game still needs an arena to play in
+            arenas.components.push_back(
+                    SymbolicStateDfa::from_mona(var_mgr_, ExplicitStateDfa::dfa_constant(true), options_.state_encoding));
+        }
+        return arenas;
+    }
+
+}
@@ -0,0 +1,338 @@
+#include "automata/DfaBackendSelector.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <spdlog/spdlog.h>
+
+#include "lydia/logic/nnf.hpp"
+#include "lydia/visitor.hpp"
+
+namespace Syft {
+
+    namespace {
+        // Whether the process runs other threads, as far as /proc tells. A child
+        // forked then may deadlock on a lock one of them held, e.g. in spdlog
+        bool other_threads_running() {
+            std::error_code error;
+            std::size_t count = 0;
+            for (std::filesystem::directory_iterator task("/proc/self/task", error);
+                 !error && task != std::filesystem::directory_iterator(); task.increment(error)) {
+                ++count;
+            }
+            return count > 1;
+        }
+
+        // Measures an LTLf formula; apply returns the temporal depth of its argument
+        class ShapeVisitor : public whitemech::lydia::Visitor {
+        public:
+            FormulaShape shape;
+
+            std::size_t apply(const whitemech::lydia::LTLfFormula &formula) {
+                shape.size++;
+                formula.accept(*this);
+                return depth_;
+            }
+
+            void visit(const whitemech::lydia::LTLfTrue &) override { depth_ = 0; }
+
+            void visit(const whitemech::lydia::LTLfFalse &) override { depth_ = 0; }
+
+            void visit(const whitemech::lydia::LTLfAtom &) override { depth_ = 0; }
+
+            void visit(const whitemech::lydia::LTLfNot &formula) override { depth_ = apply(*formula.get_arg()); }
+
+            void visit(const whitemech::lydia::LTLfAnd &formula) override { depth_ = deepest(formula.get_args()); }
+
+            void visit(const whitemech::lydia::LTLfOr &formula) override { depth_ = deepest(formula.get_args()); }
+
+            void visit(const whitemech::lydia::LTLfNext &formula) override {
+                depth_ = temporal(false, apply(*formula.get_arg()));
+            }
+
+            void visit(const whitemech::lydia::LTLfWeakNext &formula) override {
+                depth_ = temporal(true, apply(*formula.get_arg()));
+            }
+
+            void visit(const whitemech::lydia::LTLfUntil &formula) override {
+                depth_ = temporal(false, deepest(formula.get_args()));
+            }
+
+            void visit(const whitemech::lydia::LTLfRelease &formula) override {
+                depth_ = temporal(true, deepest(formula.get_args()));
+            }
+
+            void visit(const whitemech::lydia::LTLfEventually &formula) override {
+                depth_ = temporal(false, apply(*formula.get_arg()));
+            }
+
+            void visit(const whitemech::lydia::LTLfAlways &formula) override {
+                depth_ = temporal(true, apply(*formula.get_arg()));
+            }
+
+        private:
+            std::size_t depth_ = 0;
+
+            std::size_t temporal(bool universal, std::size_t arg_depth) {
+                shape.temporal_operators++;
+                shape.universal_operators += universal ? 1 : 0;
+                return arg_depth + 1;
+            }
+
+            template<typename Args>
+            std::size_t deepest(const Args &args) {
+                std::size_t depth = 0;
+                for (const auto &arg: args) {
+                    depth = std::max(depth, apply(*arg));
+                }
+                return depth;
+            }
+        };
+
+        // Tells apart the temporary files of the races of one process
+        std::atomic<std::size_t> race_count{0};
+    }
+
+    std::string to_string(DfaBackend backend) {
+        switch (backend) {
+            case DfaBackend::Compositional:
+                return "compositional";
+            case DfaBackend::Complemented:
+                return "complemented";
+            case DfaBackend::Decomposed:
+                return "decomposed";
+        }
+        throw std::runtime_error("Error: Unknown DFA backend");
+    }
+
+    std::optional<DfaBackend> parse_dfa_backend(const std::string &name) {
+        for (DfaBackend backend: {DfaBackend::Compositional, DfaBackend::Complemented, DfaBackend::Decomposed}) {
+            if (to_string(backend) == name) {
+                return backend;
+            }
+        }
+        return std::nullopt;
+    }
+
+    FormulaShape formula_shape(const whitemech::lydia::LTLfFormula &formula) {
+        ShapeVisitor visitor;
+        visitor.shape.temporal_depth = visitor.apply(formula);
+        if (whitemech::lydia::is_a<const whitemech::lydia::LTLfAnd>(formula)) {
+            visitor.shape.conjunction = true;
+            visitor.shape.junction_arity =
+                    static_cast<const whitemech::lydia::LTLfAnd &>(formula).get_args().size();
+        } else if (whitemech::lydia::is_a<const whitemech::lydia::LTLfOr>(formula)) {
+            visitor.shape.junction_arity =
+                    static_cast<const whitemech::lydia::LTLfOr &>(formula).get_args().size();
+        }
+        return visitor.shape;
+    }
+
+    DfaBackendSelector::DfaBackendSelector(DfaBackendOptions options)
+            : options_(std::move(options)) {}
+
+    std::vector<DfaBackend> DfaBackendSelector::candidates(const FormulaShape &shape) const {
+        // Without temporal operators, every backend ends in the same small construction
+        if (shape.temporal_operators == 0) {
+            return {DfaBackend::Compositional};
+        }
+        bool decomposable = shape.junction_arity >= 2;
+        // Many small arguments, whose products pay for being minimized one by one
+        bool wide = decomposable && shape.junction_arity >= 3 && shape.temporal_depth <= 2;
+        bool universal = 2 * shape.universal_operators > shape.temporal_operators;
+
+        std::vector<DfaBackend> ranked;
+        if (wide) {
+            ranked.push_back(DfaBackend::Decomposed);
+        }
+        if (universal) {
+            ranked.push_back(DfaBackend::Complemented);
+        }
+        ranked.push_back(DfaBackend::Compositional);
+        if (!universal) {
+            ranked.push_back(DfaBackend::Complemented);
+        }
+        if (decomposable && !wide) {
+            ranked.push_back(DfaBackend::Decomposed);
+        }
+        return ranked;
+    }
+
+    ExplicitStateDfa DfaBackendSelector::build_with(DfaBackend backend, const whitemech::lydia::LTLfFormula &formula) {
+        switch (backend) {
+            case DfaBackend::Compositional:
+                break;
+            case DfaBackend::Complemented: {
+                whitemech::lydia::ltlf_ptr negation =
+                        whitemech::lydia::to_nnf(*formula.ctx().makeLtlfNot(whitemech::lydia::to_nnf(formula)));
+                ExplicitStateDfa negation_dfa = ExplicitStateDfa::dfa_of_formula(*negation);
+                std::vector<ExplicitStateDfa> operands;
+                operands.push_back(ExplicitStateDfa::dfa_complement(negation_dfa));
+                // The complement also accepts the empty trace, which the DFAs of formulas reject
+                operands.push_back(ExplicitStateDfa::dfa_constant(true));
+                return ExplicitStateDfa::dfa_product_and(std::move(operands));
+            }
+            case DfaBackend::Decomposed: {
+                std::vector<ExplicitStateDfa> operands;
+                if (whitemech::lydia::is_a<const whitemech::lydia::LTLfAnd>(formula)) {
+                    for (const auto &arg: static_cast<const whitemech::lydia::LTLfAnd &>(formula).get_args()) {
+                        operands.push_back(ExplicitStateDfa::dfa_of_formula(*arg));
+                    }
+                    return ExplicitStateDfa::dfa_product_and(std::move(operands));
+                }
+                if (whitemech::lydia::is_a<const whitemech::lydia::LTLfOr>(formula)) {
+                    for (const auto &arg: static_cast<const whitemech::lydia::LTLfOr &>(formula).get_args()) {
+                        operands.push_back(ExplicitStateDfa::dfa_of_formula(*arg));
+                    }
+                    return ExplicitStateDfa::dfa_product_or(std::move(operands));
+                }
+                break;
+            }
+        }
+        return ExplicitStateDfa::dfa_of_formula(formula);
+    }
+
+    ExplicitStateDfa DfaBackendSelector::build(const whitemech::lydia::LTLfFormula &formula,
+                                               DfaBackend *winner) const {
+        DfaBackend chosen = options_.backend.value_or(DfaBackend::Compositional);
+        if (!options_.backend) {
+            FormulaShape shape = formula_shape(formula);
+            std::vector<DfaBackend> ranked = candidates(shape);
+            chosen = ranked.front();
+            if (ranked.size() > 1 && options_.race_budget.count() > 0 &&
+                shape.size >= options_.race_min_size && shape.size <= options_.race_max_size &&
+                !other_threads_running()) {
+                std::optional<ExplicitStateDfa> dfa = race(formula, ranked, chosen);
+                if (dfa) {
+                    if (winner != nullptr) {
+                        *winner = chosen;
+                    }
+                    return std::move(*dfa);
+                }
+                chosen = ranked.front();
+            }
+            spdlog::debug("[DfaBackendSelector::build] {} for a formula of {} nodes, {} temporal operators of "
+                          "depth {}", to_string(chosen), shape.size, shape.temporal_operators,
+                          shape.temporal_depth);
+        }
+        if (winner != nullptr) {
+            *winner = chosen;
+        }
+        return build_with(chosen, formula);
+    }
+
+    std::optional<ExplicitStateDfa> DfaBackendSelector::race(const whitemech::lydia::LTLfFormula &formula,
+                                                             const std::vector<DfaBackend> &candidates,
+                                                             DfaBackend &winner) const {
+        std::string prefix = "lydiasyft_dfa_race_" + std::to_string(getpid()) + "_" +
+                             std::to_string(race_count++) + "_";
+        std::vector<std::string> paths;
+        for (std::size_t i = 0; i < candidates.size(); ++i) {
+            paths.push_back((std::filesystem::temp_directory_path() / (prefix + std::to_string(i))).string());
+        }
+
+        // Buffered output would otherwise be written once by every child
+        std::cout.flush();
+        std::cerr.flush();
+        std::fflush(nullptr);
+
+        std::map<pid_t, std::size_t> running;
+        for (std::size_t i = 0; i < candidates.size(); ++i) {
+            pid_t pid = fork();
+            if (pid < 0) {
+                continue;
+            }
+            if (pid == 0) {
+                int status = 1;
+                try {
+                    ExplicitStateDfa dfa = build_with(candidates[i], formula);
+                    status = dfa.export_to_file(paths[i]) ? 0 : 1;
+                } catch (...) {
+                    status = 1;
+                }
+                _exit(status);
+            }
+            running.emplace(pid, i);
+        }
+
+        auto deadline = std::chrono::steady_clock::now() + options_.race_budget;
+        // A child stuck past this, e.g. on a lock held at the fork, is given up for an in-process build
+        auto final_deadline = deadline + options_.race_budget;
+        std::optional<std::size_t> first;
+        while (!running.empty() && !first) {
+            auto now = std::chrono::steady_clock::now();
+            if (now >= final_deadline) {
+                spdlog::warn("[DfaBackendSelector::race] no backend finished within twice the race budget, "
+                             "building in process");
+                break;
+            }
+            if (now >= deadline && running.size() > 1) {
+                // Out of budget: only the most preferred candidate left is waited for
+                auto preferred = std::min_element(running.begin(), running.end(), [](const auto &a, const auto &b) {
+                    return a.second < b.second;
+                });
+                for (auto it = running.begin(); it != running.end();) {
+                    if (it == preferred) {
+                        ++it;
+                        continue;
+                    }
+                    kill(it->first, SIGKILL);
+                    while (waitpid(it->first, nullptr, 0) < 0 && errno == EINTR) {}
+                    it = running.erase(it);
+                }
+            }
+            for (auto it = running.begin(); it != running.end();) {
+                int status;
+                pid_t done = waitpid(it->first, &status, WNOHANG);
+                if (done != it->first) {
+                    ++it;
+                    continue;
+                }
+                if (WIFEXITED(status) && WEXITSTATUS(status) == 0) {
+                    first = it->second;
+                }
+                it = running.erase(it);
+                if (first) {
+                    break;
+                }
+            }
+            if (!first && !running.empty()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        // The losers still running
+        for (const auto &[pid, index]: running) {
+            kill(pid, SIGKILL);
+        }
+        for (const auto &[pid, index]: running) {
+            while (waitpid(pid, nullptr, 0) < 0 && errno == EINTR) {}
+        }
+
+        std::optional<ExplicitStateDfa> dfa;
+        if (first) {
+            dfa = ExplicitStateDfa::import_from_file(paths[*first]);
+            if (dfa) {
+                winner = candidates[*first];
+                spdlog::debug("[DfaBackendSelector::race] {} won among {} backends", to_string(winner),
+                              candidates.size());
+            }
+        }
+        for (const std::string &path: paths) {
+            std::remove(path.c_str());
+        }
+        return dfa;
+    }
+
+}
@@ -0,0 +1,146 @@
+#include "automata/DfaCache.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+#include <unistd.h>
+
+#include "lydia/utils/print.hpp"
+
+namespace Syft {
+
+    DfaCache::DfaCache(std::string directory, bool keep_in_memory)
+            : directory_(std::move(directory)), keep_in_memory_(keep_in_memory) {
+        if (directory_.empty()) {
+            if (!keep_in_memory_) {
+                throw std::runtime_error("A DFA cache needs a directory or to keep its entries in memory");
+            }
+            return;
+        }
+        std::error_code error;
+        std::filesystem::create_directories(directory_, error);
+        if (error) {
+            throw std::runtime_error("Cannot create DFA cache directory " + directory_ +
+                                     ": " + error.message());
+        }
+    }
+
+    std::string DfaCache::cache_key(const std::string &transform,
+                                    const whitemech::lydia::LTLfFormula &formula) {
+        return transform + ":" + whitemech::lydia::to_string(formula);
+    }
+
+    std::string DfaCache::entry_path(const std::string &key) const {
+        std::ostringstream name;
+        name << std::hex << std::setw(16) << std::setfill('0') << std::hash<std::string>{}(key);
+        return (std::filesystem::path(directory_) / name.str()).string();
+    }
+
+    std::optional<ExplicitStateDfa> DfaCache::load(const std::string &key) const {
+        if (directory_.empty()) {
+            return std::nullopt;
+        }
+        std::string path = entry_path(key);
+
+        std::ifstream key_file(path + ".key", std::ios::binary);
+        if (!key_file) {
+            return std::nullopt;
+        }
+        std::string stored_key((std::istreambuf_iterator<char>(key_file)),
+                               std::istreambuf_iterator<char>());
+        if (stored_key != key) {
+            // Hash collision: the entry belongs to a different key
+            return std::nullopt;
+        }
+
+        std::string dfa_path = path + ".dfa";
+        std::optional<ExplicitStateDfa> dfa = ExplicitStateDfa::import_from_file(dfa_path);
+        if (!dfa) {
+            spdlog::warn("[DfaCache::load] cannot read cache entry {}", dfa_path);
+            return std::nullopt;
+        }
+
+        spdlog::debug("[DfaCache::load] hit for {}", key);
+        return dfa;
+    }
+
+    void DfaCache::store(const std::string &key, ExplicitStateDfa &dfa) const {
+        if (directory_.empty()) {
+            return;
+        }
+        std::string path = entry_path(key);
+        // Unique per writer, so that concurrent runs sharing the directory never
+        // observe a partially written entry; thread ids repeat across processes
+        std::ostringstream suffix;
+        suffix << ".tmp." << getpid() << "." << std::this_thread::get_id();
+        std::string key_tmp = path + ".key" + suffix.str();
+        std::string dfa_tmp = path + ".dfa" + suffix.str();
+
+        {
+            std::ofstream key_file(key_tmp, std::ios::binary | std::ios::trunc);
+            key_file << key;
+            if (!key_file) {
+                spdlog::warn("[DfaCache::store] cannot write cache entry {}", key_tmp);
+                std::remove(key_tmp.c_str());
+                return;
+            }
+        }
+
+        if (!dfa.export_to_file(dfa_tmp)) {
+            spdlog::warn("[DfaCache::store] cannot write cache entry {}", dfa_tmp);
+            std::remove(key_tmp.c_str());
+            std::remove(dfa_tmp.c_str());
+            return;
+        }
+
+        // The DFA becomes visible last, so that a present DFA always has its key
+        std::error_code error;
+        std::filesystem::rename(key_tmp, path + ".key", error);
+        if (!error) {
+            std::filesystem::rename(dfa_tmp, path + ".dfa", error);
+        }
+        if (error) {
+            spdlog::warn("[DfaCache::store] cannot commit cache entry {}: {}", path, error.message());
+            std::remove(key_tmp.c_str());
+            std::remove(dfa_tmp.c_str());
+        }
+    }
+
+    ExplicitStateDfa DfaCache::get_or_build(const std::string &key,
+                                            const std::function<ExplicitStateDfa()> &build) const {
+        if (keep_in_memory_) {
+            std::lock_guard<std::mutex> lock(memory_mutex_);
+            auto kept = memory_.find(key);
+            if (kept != memory_.end()) {
+                spdlog::debug("[DfaCache::get_or_build] memory hit for {}", key);
+                return kept->second;
+            }
+        }
+        std::optional<ExplicitStateDfa> cached = load(key);
+        ExplicitStateDfa dfa = cached ? std::move(*cached) : build();
+        if (!cached) {
+            store(key, dfa);
+        }
+        if (keep_in_memory_) {
+            std::lock_guard<std::mutex> lock(memory_mutex_);
+            memory_.emplace(key, dfa);
+        }
+        return dfa;
+    }
+
+    std::size_t DfaCache::memory_entries() const {
+        std::lock_guard<std::mutex> lock(memory_mutex_);
+        return memory_.size();
+    }
+
+}
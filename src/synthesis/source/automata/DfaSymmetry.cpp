@@ -0,0 +1,273 @@
+#include "automata/DfaSymmetry.h"
+
+#include <algorithm>
+#include <functional>
+#include <set>
+#include <stdexcept>
+#include <unordered_set>
+#include <spdlog/spdlog.h>
+
+namespace Syft {
+
+    namespace {
+        // Renamings tried per pair of DFAs before giving up
+        constexpr std::size_t max_candidates = std::size_t(1) << 16;
+        // Entries of a successor table, states times assignments
+        constexpr std::size_t max_table_size = std::size_t(1) << 22;
+
+        // The successors of the states of a DFA reachable from its initial state, under each assignment of its atoms
+        struct SuccessorTable {
+            std::size_t atoms = 0;
+            // By (state << atoms) + assignment, -1 for the states not reached
+            std::vector<int> successors;
+            // In the order of a search from the initial state
+            std::vector<int> reachable;
+            std::vector<bool> final;
+
+            int successor(int state, unsigned assignment) const {
+                return successors[(static_cast<std::size_t>(state) << atoms) + assignment];
+            }
+        };
+
+        SuccessorTable successor_table(const ExplicitStateDfa &dfa) {
+            const DFA *d = dfa.dfa_;
+            bdd_manager *bddm = d->bddm;
+            SuccessorTable table;
+            table.atoms = dfa.names.size();
+            std::size_t assignments = std::size_t(1) << table.atoms;
+            table.successors.assign(static_cast<std::size_t>(d->ns) * assignments, -1);
+            table.final.resize(d->ns);
+            for (int s = 0; s < d->ns; ++s) {
+                table.final[s] = d->f[s] == 1;
+            }
+            std::vector<bool> seen(d->ns, false);
+            table.reachable.push_back(d->s);
+            seen[d->s] = true;
+            for (std::size_t next = 0; next < table.reachable.size(); ++next) {
+                int state = table.reachable[next];
+                for (unsigned w = 0; w < assignments; ++w) {
+                    unsigned node = d->q[state];
+                    unsigned index, low, high;
+                    LOAD_lri(&bddm->node_table[node], low, high, index);
+                    while (index != BDD_LEAF_INDEX) {
+                        node = (w >> index) & 1 ? high : low;
+                        LOAD_lri(&bddm->node_table[node], low, high, index);
+                    }
+                    // The leaf holds the successor state
+                    table.successors[(static_cast<std::size_t>(state) << table.atoms) + w] = static_cast<int>(low);
+                    if (!seen[low]) {
+                        seen[low] = true;
+                        table.reachable.push_back(static_cast<int>(low));
+                    }
+                }
+            }
+            return table;
+        }
+
+        // For each atom, how many pairs of a reachable state and an assignment change their successor, and its
+        // acceptance, when the atom flips; a renaming under which two DFAs are isomorphic preserves both
+        std::vector<std::pair<std::size_t, std::size_t>> atom_signatures(const SuccessorTable &table) {
+            std::vector<std::pair<std::size_t, std::size_t>> signatures(table.atoms);
+            std::size_t assignments = std::size_t(1) << table.atoms;
+            for (int state : table.reachable) {
+                for (unsigned w = 0; w < assignments; ++w) {
+                    int successor = table.successor(state, w);
+                    for (std::size_t i = 0; i < table.atoms; ++i) {
+                        int flipped = table.successor(state, w ^ (1u << i));
+                        signatures[i].first += successor != flipped;
+                        signatures[i].second += table.final[successor] != table.final[flipped];
+                    }
+                }
+            }
+            return signatures;
+        }
+
+        // Whether the reachable parts of from and to are isomorphic when the i-th atom of from is the image[i]-th of to
+        bool isomorphic(const SuccessorTable &from, const SuccessorTable &to, const std::vector<std::size_t> &image) {
+            std::size_t assignments = std::size_t(1) << from.atoms;
+            std::vector<unsigned> renamed(assignments, 0);
+            for (unsigned w = 0; w < assignments; ++w) {
+                for (std::size_t i = 0; i < from.atoms; ++i) {
+                    if ((w >> i) & 1) {
+                        renamed[w] |= 1u << image[i];
+                    }
+                }
+            }
+            std::vector<int> paired(from.final.size(), -1);
+            std::vector<int> inverse(to.final.size(), -1);
+            std::vector<int> queue = {from.reachable.front()};
+            paired[from.reachable.front()] = to.reachable.front();
+            inverse[to.reachable.front()] = from.reachable.front();
+            for (std::size_t next = 0; next < queue.size(); ++next) {
+                int state = queue[next];
+                int image_state = paired[state];
+                if (from.final[state] != to.final[image_state]) {
+                    return false;
+                }
+                for (unsigned w = 0; w < assignments; ++w) {
+                    int successor = from.successor(state, w);
+                    int image_successor = to.successor(image_state, renamed[w]);
+                    if (paired[successor] < 0) {
+                        if (inverse[image_successor] >= 0) {
+                            return false;
+                        }
+                        paired[successor] = image_successor;
+                        inverse[image_successor] = successor;
+                        queue.push_back(successor);
+                    } else if (paired[successor] != image_successor) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        // 0 for the inputs, 1 for the outputs and 2 for the atoms in neither
+        std::vector<int> atom_classes(const ExplicitStateDfa &dfa, const VarMgr &var_mgr) {
+            std::vector<std::string> input_labels = var_mgr.input_variable_labels();
+            std::vector<std::string> output_labels = var_mgr.output_variable_labels();
+            std::unordered_set<std::string> inputs(input_labels.begin(), input_labels.end());
+            std::unordered_set<std::string> outputs(output_labels.begin(), output_labels.end());
+            std::vector<int> classes;
+            classes.reserve(dfa.names.size());
+            for (const std::string &name : dfa.names) {
+                classes.push_back(inputs.count(name) > 0 ? 0 : outputs.count(name) > 0 ? 1 : 2);
+            }
+            return classes;
+        }
+
+        // Whether swapping colors a and b leaves formula unchanged
+        bool swap_invariant(const ColorFormula &formula, std::size_t a, std::size_t b) {
+            CUDD::Cudd mgr;
+            auto color_variable = [&mgr](std::size_t color) {
+                return mgr.bddVar(static_cast<int>(color));
+            };
+            CUDD::BDD original = formula.to_bdd(color_variable, mgr);
+            CUDD::BDD swapped = formula.to_bdd([&](std::size_t color) {
+                return color_variable(color == a ? b : color == b ? a : color);
+            }, mgr);
+            return original == swapped;
+        }
+    }
+
+    std::optional<std::vector<std::string>> find_atom_renaming(const ExplicitStateDfa &from,
+                                                               const ExplicitStateDfa &to,
+                                                               const VarMgr &var_mgr,
+                                                               std::size_t max_atoms) {
+        std::size_t atoms = from.names.size();
+        if (atoms != to.names.size() || atoms > max_atoms ||
+            (static_cast<std::size_t>(std::max(from.dfa_->ns, to.dfa_->ns)) << atoms) > max_table_size) {
+            return std::nullopt;
+        }
+        SuccessorTable from_table = successor_table(from);
+        SuccessorTable to_table = successor_table(to);
+        auto final_count = [](const SuccessorTable &table) {
+            return std::count_if(table.reachable.begin(), table.reachable.end(),
+                                 [&table](int state) { return table.final[state]; });
+        };
+        if (from_table.reachable.size() != to_table.reachable.size() ||
+            final_count(from_table) != final_count(to_table)) {
+            return std::nullopt;
+        }
+
+        std::vector<std::pair<std::size_t, std::size_t>> from_signatures = atom_signatures(from_table);
+        std::vector<std::pair<std::size_t, std::size_t>> to_signatures = atom_signatures(to_table);
+        std::vector<int> from_classes = atom_classes(from, var_mgr);
+        std::vector<int> to_classes = atom_classes(to, var_mgr);
+
+        std::vector<std::size_t> image(atoms);
+        std::vector<bool> used(atoms, false);
+        std::size_t candidates = 0;
+        std::function<bool(std::size_t)> assign = [&](std::size_t i) {
+            if (i == atoms) {
+                candidates++;
+                return isomorphic(from_table, to_table, image);
+            }
+            for (std::size_t j = 0; j < atoms && candidates < max_candidates; ++j) {
+                if (used[j] || from_classes[i] != to_classes[j] || from_signatures[i] != to_signatures[j]) {
+                    continue;
+                }
+                used[j] = true;
+                image[i] = j;
+                if (assign(i + 1)) {
+                    return true;
+                }
+                used[j] = false;
+            }
+            return false;
+        };
+        if (!assign(0)) {
+            return std::nullopt;
+        }
+
+        std::vector<std::string> renaming;
+        renaming.reserve(atoms);
+        for (std::size_t i = 0; i < atoms; ++i) {
+            renaming.push_back(to.names[image[i]]);
+        }
+        return renaming;
+    }
+
+    ExplicitStateDfa rename_atoms(const ExplicitStateDfa &dfa, const std::vector<std::string> &atoms) {
+        if (atoms.size() != dfa.names.size()) {
+            throw std::runtime_error("Error: Renaming of " + std::to_string(atoms.size()) + " atoms for a DFA of " +
+                                     std::to_string(dfa.names.size()));
+        }
+        return ExplicitStateDfa(dfaCopy(dfa.dfa_), atoms);
+    }
+
+    std::vector<ColorOrbit> find_color_orbits(const std::map<int, SharedExplicitStateDfa> &color_to_dfa,
+                                              const ColorFormula &formula, const VarMgr &var_mgr,
+                                              std::size_t max_atoms) {
+        std::vector<ColorOrbit> orbits;
+        std::set<int> assigned;
+        for (auto it = color_to_dfa.begin(); it != color_to_dfa.end(); ++it) {
+            if (assigned.count(it->first) > 0) {
+                continue;
+            }
+            ColorOrbit orbit{{it->first}, {it->second->names}};
+            std::set<std::string> orbit_atoms(it->second->names.begin(), it->second->names.end());
+            for (auto other = std::next(it); other != color_to_dfa.end(); ++other) {
+                const std::vector<std::string> &names = other->second->names;
+                bool disjoint = std::none_of(names.begin(), names.end(), [&orbit_atoms](const std::string &name) {
+                    return orbit_atoms.count(name) > 0;
+                });
+                if (assigned.count(other->first) > 0 || !disjoint ||
+                    !swap_invariant(formula, static_cast<std::size_t>(it->first),
+                                    static_cast<std::size_t>(other->first))) {
+                    continue;
+                }
+                std::optional<std::vector<std::string>> renaming =
+                    find_atom_renaming(*it->second, *other->second, var_mgr, max_atoms);
+                if (!renaming) {
+                    continue;
+                }
+                orbit.colors.push_back(other->first);
+                orbit.atoms.push_back(std::move(*renaming));
+                orbit_atoms.insert(names.begin(), names.end());
+            }
+            if (orbit.colors.size() < 2) {
+                continue;
+            }
+
+            // The permutations of the orbit must fix the atoms of every other color
+            bool closed = true;
+            for (const auto &[color, dfa] : color_to_dfa) {
+                if (std::find(orbit.colors.begin(), orbit.colors.end(), color) != orbit.colors.end()) {
+                    continue;
+                }
+                for (const std::string &name : dfa->names) {
+                    closed = closed && orbit_atoms.count(name) == 0;
+                }
+            }
+            if (!closed) {
+                spdlog::debug("[find_color_orbits] colors isomorphic to {} share atoms with other colors", it->first);
+                continue;
+            }
+            assigned.insert(orbit.colors.begin(), orbit.colors.end());
+            orbits.push_back(std::move(orbit));
+        }
+        return orbits;
+    }
+
+}
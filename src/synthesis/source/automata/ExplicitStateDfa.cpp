@@ -1,9 +1,16 @@
 #include "automata/ExplicitStateDfa.h"
 
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
 #include <iostream>
+#include <map>
 #include <istream>
 #include <queue>
 #include <set>
+#include <stdexcept>
 // #include <bits/stdc++.h>
 
 #include <vector>
@@ -13,6 +20,7 @@
 #include <bitset>
 #include <unordered_map>
 #include <unordered_set>
+#include <thread>
 #include <tuple>
 #include "lydia/mona_ext/mona_ext_base.hpp"
 #include "lydia/dfa/mona_dfa.hpp"
@@ -27,9 +35,82 @@
 #include <boost/graph/topological_sort.hpp>
 
 #include "cudd.h"
+#include <spdlog/spdlog.h>
+
+#include <sys/wait.h>
+#include <unistd.h>
 
 namespace Syft {
 
+    namespace {
+        // MONA variable indices of d, one per variable name
+        std::vector<int> variable_indices(const ExplicitStateDfa &d) {
+            std::vector<int> indices(d.indices.begin(), d.indices.end());
+            indices.resize(d.names.size());
+            return indices;
+        }
+
+        // Reusable buffers for rebuilding a MONA DFA state by state.
+        // Transitions are read by walking the MONA BDD of a state directly and
+        // writing the guard of each path into one buffer, instead of building
+        // make_paths lists and a std::string guard per edge.
+        class TransitionScratch {
+        public:
+            explicit TransitionScratch(int nb_variables)
+                    : guard_size_(nb_variables + 1), guard_(nb_variables + 1, 'X') {
+                guard_[nb_variables] = '\0';
+            }
+
+            // Collects the transitions of the state whose BDD is rooted at root.
+            // map_target maps a successor to its new index, or to -1 to drop the
+            // transition so that it falls through to the default target.
+            template<typename MapTarget>
+            void collect(bdd_manager *bddm, bdd_ptr root, MapTarget &&map_target) {
+                walk(bddm, root, map_target);
+            }
+
+            bool empty() const { return targets_.empty(); }
+
+            int front_target() const { return targets_.front(); }
+
+            // Stores the collected transitions as the next state of the DFA
+            // under construction, and clears them for the next state
+            void store(int default_target) {
+                dfaAllocExceptions(static_cast<int>(targets_.size()));
+                for (std::size_t i = 0; i < targets_.size(); ++i) {
+                    dfaStoreException(targets_[i], guards_.data() + i * guard_size_);
+                }
+                dfaStoreState(default_target);
+                targets_.clear();
+                guards_.clear();
+            }
+
+        private:
+            std::size_t guard_size_;
+            std::vector<char> guard_;
+            std::vector<int> targets_;
+            std::vector<char> guards_;
+
+            template<typename MapTarget>
+            void walk(bdd_manager *bddm, bdd_ptr p, MapTarget &map_target) {
+                if (bdd_is_leaf(bddm, p)) {
+                    int target = map_target(static_cast<int>(bdd_leaf_value(bddm, p)));
+                    if (target >= 0) {
+                        targets_.push_back(target);
+                        guards_.insert(guards_.end(), guard_.begin(), guard_.end());
+                    }
+                    return;
+                }
+                unsigned index = bdd_ifindex(bddm, p);
+                guard_[index] = '0';
+                walk(bddm, bdd_else(bddm, p), map_target);
+                guard_[index] = '1';
+                walk(bddm, bdd_then(bddm, p), map_target);
+                guard_[index] = 'X';
+            }
+        };
+    }
+
     void ExplicitStateDfa::dfa_print() {
         std::cout << "Computed automaton: " << std::endl;
         whitemech::lydia::dfaPrint(get_dfa(),
@@ -76,6 +157,48 @@ namespace Syft {
         return exp_dfa;
     }
 
+    ExplicitStateDfa ExplicitStateDfa::dfa_constant(bool accepting) {
+        // The initial state rejects the empty trace, as in the DFAs of formulas
+        dfaSetup(2, 0, nullptr);
+        dfaAllocExceptions(0);
+        dfaStoreState(1);
+        dfaAllocExceptions(0);
+        dfaStoreState(1);
+        std::string statuses = accepting ? "-+" : "--";
+        return ExplicitStateDfa(dfaBuild(statuses.data()), std::vector<std::string>());
+    }
+
+    bool ExplicitStateDfa::export_to_file(const std::string &path) {
+        std::vector<std::string> variable_names = names;
+        std::vector<char *> name_ptrs;
+        for (std::string &name: variable_names) {
+            name_ptrs.push_back(name.data());
+        }
+        std::vector<char> orders(variable_names.size(), 0);
+        std::string file = path;
+        return dfaExport(dfa_, file.data(), static_cast<int>(variable_names.size()), name_ptrs.data(),
+                         orders.data()) != 0;
+    }
+
+    std::optional<ExplicitStateDfa> ExplicitStateDfa::import_from_file(const std::string &path) {
+        std::string file = path;
+        char **vars = nullptr;
+        int *orders = nullptr;
+        DFA *dfa = dfaImport(file.data(), &vars, &orders);
+        if (dfa == nullptr) {
+            return std::nullopt;
+        }
+
+        std::vector<std::string> variable_names;
+        for (char **var = vars; *var != nullptr; ++var) {
+            variable_names.emplace_back(*var);
+            mem_free(*var);
+        }
+        mem_free(vars);
+        mem_free(orders);
+        return ExplicitStateDfa(dfa, variable_names);
+    }
+
     ExplicitStateDfa
     ExplicitStateDfa::dfa_to_Gdfa(ExplicitStateDfa &d) {
         // std::cout << "--------- d:\n";
@@ -83,12 +206,9 @@ namespace Syft {
         int d_ns = d.get_nb_states();
         int new_ns = d.get_final().size() + 2; // initial state is "0" and sink state is "new_ns"
         int n = d.get_nb_variables();
-        int new_len = d.names.size();
 
-        bool safe_states[d_ns];
-        int state_map[d_ns];
-        memset(safe_states, false, sizeof(safe_states));
-        memset(state_map, -1, sizeof(state_map));
+        std::vector<bool> safe_states(d_ns, false);
+        std::vector<int> state_map(d_ns, -1);
 
         safe_states[0] = true; // we would like to keep initial state
         for (auto s: d.get_final()) {
@@ -103,47 +223,23 @@ namespace Syft {
 
         DFA *a = d.dfa_;
         DFA *result;
-        paths state_paths, pp;
         std::string statuses;
 
-        int indices[new_len];
-        for (int i = 0; i < d.indices.size(); i++) {
-            indices[i] = d.indices[i];
-        }
-
-        dfaSetup(new_ns, new_len, indices);
+        std::vector<int> indices = variable_indices(d);
+        dfaSetup(new_ns, static_cast<int>(indices.size()), indices.data());
 
+        TransitionScratch scratch(n);
         for (int i = 0; i < a->ns; i++) {
             // ignore non-safe_states
             if (!safe_states[i]) continue;
-            int next_state;
-            std::string next_guard;
-
-            auto transitions = std::vector<std::pair<int, std::string>>();
-            state_paths = pp = make_paths(a->bddm, a->q[i]);
-            while (pp) {
-                auto guard = whitemech::lydia::get_path_guard(n, pp->trace);
-                // ignore non safe_states
-                if (safe_states[pp->to]) {
-                    transitions.emplace_back(pp->to, guard);
-                }
-                pp = pp->next;
-            }
+            // transitions to non-safe states fall through to the sink
+            scratch.collect(a->bddm, a->q[i], [&](int to) { return state_map[to]; });
             if (i == 0) {
                 statuses += "-";
             } else {
                 statuses += "+";
             }
-//            statuses += "+";
-            // transitions
-            int nb_transitions = transitions.size();
-            dfaAllocExceptions(nb_transitions);
-            for (const auto &p: transitions) {
-                std::tie(next_state, next_guard) = p;
-                dfaStoreException(state_map[next_state], next_guard.data());
-            }
-            dfaStoreState(new_ns-1);
-            kill_paths(state_paths);
+            scratch.store(new_ns - 1);
         }
 
         statuses += "-";
@@ -164,75 +260,41 @@ namespace Syft {
     ExplicitStateDfa
     ExplicitStateDfa::dfa_to_Gdfa_obligation(const ExplicitStateDfa &input) {
         ExplicitStateDfa d(input);
-        int d_ns = d.get_nb_states();
-        int new_ns = d_ns + 1; // add a fresh initial state
         int n = d.get_nb_variables();
-        int new_len = d.names.size();
-
-        std::vector<size_t> finals = d.get_final();
-        std::vector<bool> is_final(d_ns, false);
-        for (auto s : finals) {
-            if (s < is_final.size()) {
-                is_final[s] = true;
-            }
-        }
 
         DFA *a = dfaMinimize(d.dfa_);
+        // States are those of the minimized DFA, which may have fewer than d
+        int a_ns = a->ns;
+        int new_ns = a_ns + 1; // add a fresh initial state
 
-        int indices[new_len];
-        for (int i = 0; i < d.indices.size(); ++i) {
-            indices[i] = d.indices[i];
-        }
-
-        dfaSetup(new_ns, new_len, indices);
+        std::vector<int> indices = variable_indices(d);
+        dfaSetup(new_ns, static_cast<int>(indices.size()), indices.data());
 
         std::string statuses;
         statuses.reserve(new_ns + 1);
 
-        auto collect_transitions = [&](int state_idx, int offset) {
-            std::vector<std::pair<int, std::string>> transitions;
-            paths local_paths = make_paths(a->bddm, a->q[state_idx]);
-            paths iter = local_paths;
-            while (iter) {
-                auto guard = whitemech::lydia::get_path_guard(n, iter->trace);
-                transitions.emplace_back(iter->to + offset, guard);
-                iter = iter->next;
-            }
-            kill_paths(local_paths);
-            return transitions;
-        };
-
-        auto emit_state = [&](const std::vector<std::pair<int, std::string>>& transitions,
-                              int default_target) {
-            dfaAllocExceptions(static_cast<int>(transitions.size()));
-            for (const auto &p : transitions) {
-                std::vector<char> guard(p.second.begin(), p.second.end());
-                guard.push_back('\0');
-                dfaStoreException(p.first, guard.data());
-            }
-            dfaStoreState(default_target);
-        };
+        TransitionScratch scratch(n);
+        auto shift = [](int to) { return to + 1; };
 
         // New non-accepting initial state (index 0) copies behaviour of original initial
         statuses += '-';
-        auto initial_transitions = collect_transitions(0, 1);
-        int initial_default = initial_transitions.empty() ? 0 : initial_transitions.front().first;
-        emit_state(initial_transitions, initial_default);
+        scratch.collect(a->bddm, a->q[a->s], shift);
+        scratch.store(scratch.empty() ? 0 : scratch.front_target());
 
         // Remaining states correspond to original ones, shifted by +1
-        for (int i = 0; i < d_ns; ++i) {
+        for (int i = 0; i < a_ns; ++i) {
             int new_idx = i + 1;
-            if (is_final[i]) {
+            if (a->f[i] == 1) {
                 statuses += '+';
-                auto transitions = collect_transitions(i, 1);
-                int default_target = transitions.empty() ? new_idx : transitions.front().first;
-                emit_state(transitions, default_target);
+                scratch.collect(a->bddm, a->q[i], shift);
+                scratch.store(scratch.empty() ? new_idx : scratch.front_target());
             } else {
                 statuses += '-';
                 dfaAllocExceptions(0);
                 dfaStoreState(new_idx);
             }
         }
+        dfaFree(a);
 
         statuses.push_back('\0');
         DFA *tmp = dfaBuild(statuses.data());
@@ -246,12 +308,9 @@ namespace Syft {
         int d_ns = d.get_nb_states();
         int new_ns = restricted_states.size();
         int n = d.get_nb_variables();
-        int new_len = d.names.size();
 
-        bool safe_states[d_ns];
-        int state_map[d_ns];
-        memset(safe_states, false, sizeof(safe_states));
-        memset(state_map, -1, sizeof(state_map));
+        std::vector<bool> safe_states(d_ns, false);
+        std::vector<int> state_map(d_ns, -1);
 
         for (auto s: restricted_states) {
             safe_states[s] = true;
@@ -264,44 +323,18 @@ namespace Syft {
         }
 
         DFA *a = d.dfa_;
-        DFA *result;
-        paths state_paths, pp;
         std::string statuses;
 
-        int indices[new_len];
-        for (int i = 0; i < d.indices.size(); i++) {
-            indices[i] = d.indices[i];
-        }
-
-        dfaSetup(new_ns + 1, new_len, indices);
+        std::vector<int> indices = variable_indices(d);
+        dfaSetup(new_ns + 1, static_cast<int>(indices.size()), indices.data());
 
+        TransitionScratch scratch(n);
         for (int i = 0; i < a->ns; i++) {
             // ignore non-safe_states
             if (!safe_states[i]) continue;
-            int next_state;
-            std::string next_guard;
-
-            auto transitions = std::vector<std::pair<int, std::string>>();
-            state_paths = pp = make_paths(a->bddm, a->q[i]);
-            while (pp) {
-                auto guard = whitemech::lydia::get_path_guard(n, pp->trace);
-                // ignore non safe_states
-                if (safe_states[pp->to]) {
-                    transitions.emplace_back(pp->to, guard);
-                }
-                pp = pp->next;
-            }
-
+            scratch.collect(a->bddm, a->q[i], [&](int to) { return state_map[to]; });
             statuses += "-";
-            // transitions
-            int nb_transitions = transitions.size();
-            dfaAllocExceptions(nb_transitions);
-            for (const auto &p: transitions) {
-                std::tie(next_state, next_guard) = p;
-                dfaStoreException(state_map[next_state], next_guard.data());
-            }
-            dfaStoreState(new_ns);
-            kill_paths(state_paths);
+            scratch.store(new_ns);
         }
 
         statuses += "+";
@@ -322,79 +355,33 @@ namespace Syft {
         int d_ns = d.get_nb_states();
         int new_ns = d_ns + 1; // initial state is "0", and new state is new_ns-1
         int n = d.get_nb_variables();
-        int new_len = d.names.size();
 
-        std::vector<size_t> final_states = d.get_final();
+        std::vector<bool> is_final(d_ns, false);
+        for (auto s: d.get_final()) {
+            is_final[s] = true;
+        }
 
         DFA *a = d.dfa_;
-        DFA *result;
-        paths state_paths, pp;
         std::string statuses;
 
-        int indices[new_len];
-        for (int i = 0; i < d.indices.size(); i++) {
-            indices[i] = d.indices[i];
-        }
-
-        dfaSetup(new_ns, new_len, indices);
-
-        int next_state;
-        std::string next_guard;
+        std::vector<int> indices = variable_indices(d);
+        dfaSetup(new_ns, static_cast<int>(indices.size()), indices.data());
 
-        auto transitions = std::vector<std::pair<int, std::string>>();
-        state_paths = pp = make_paths(a->bddm, a->q[0]);
-        // auto it = find(final_states.begin(), final_states.end(), i);
+        TransitionScratch scratch(n);
+        auto shift = [](int to) { return to + 1; };
 
-        while (pp) {
-            auto guard = whitemech::lydia::get_path_guard(n, pp->trace);
-            transitions.emplace_back(pp->to+1, guard);
-            pp = pp->next;
-        }
+        scratch.collect(a->bddm, a->q[0], shift);
         statuses += "+";
-
-        // transitions
-        int nb_transitions = transitions.size();
-        dfaAllocExceptions(nb_transitions);
-        for (const auto &p: transitions) {
-            std::tie(next_state, next_guard) = p;
-            dfaStoreException(next_state, next_guard.data());
-        }
-        dfaStoreState(new_ns);
-        kill_paths(state_paths);
+        scratch.store(new_ns);
 
         for (int i = 0; i < a->ns; i++) {
-            int next_state;
-            std::string next_guard;
-
-            auto transitions = std::vector<std::pair<int, std::string>>();
-            state_paths = pp = make_paths(a->bddm, a->q[i]);
-            auto it = find(final_states.begin(), final_states.end(), i);
-
-            while (pp) {
-                auto guard = whitemech::lydia::get_path_guard(n, pp->trace);
-                transitions.emplace_back(pp->to+1, guard);
-
-                pp = pp->next;
-            }
-
-
-
-
-            if (it != final_states.end()) {
+            scratch.collect(a->bddm, a->q[i], shift);
+            if (is_final[i]) {
                 statuses += "+";
             } else {
                 statuses += "-";
             }
-
-            // transitions
-            int nb_transitions = transitions.size();
-            dfaAllocExceptions(nb_transitions);
-            for (const auto &p: transitions) {
-                std::tie(next_state, next_guard) = p;
-                dfaStoreException(next_state, next_guard.data());
-            }
-            dfaStoreState(d_ns);
-            kill_paths(state_paths);
+            scratch.store(d_ns);
         }
 
 //        statuses += "+";
@@ -410,63 +397,32 @@ namespace Syft {
     ExplicitStateDfa
     ExplicitStateDfa::dfa_to_Fdfa(ExplicitStateDfa &d) {
         int d_ns = d.get_nb_states();
-        std::vector<size_t> final_states = d.get_final();
         int n = d.get_nb_variables();
-        int new_len = d.names.size();
 
-//        int state_map[d_ns];
-//        memset(state_map, -1, sizeof(state_map));
-//
-//        int index = 0;
-//        for (int i = 0; i < d_ns; i++) {
-//            state_map[i] = index++;
-//        }
+        std::vector<bool> is_final(d_ns, false);
+        for (auto s: d.get_final()) {
+            is_final[s] = true;
+        }
 
         DFA *a = d.dfa_;
         DFA *result;
-        paths state_paths, pp;
         std::string statuses;
 
-        int indices[new_len];
-        for (int i = 0; i < d.indices.size(); i++) {
-            indices[i] = d.indices[i];
-        }
-
-        dfaSetup(d_ns, new_len, indices);
+        std::vector<int> indices = variable_indices(d);
+        dfaSetup(d_ns, static_cast<int>(indices.size()), indices.data());
 
+        TransitionScratch scratch(n);
         for (int i = 0; i < a->ns; i++) {
-
-            int next_state;
-            std::string next_guard;
-
-            auto transitions = std::vector<std::pair<int, std::string>>();
-            state_paths = pp = make_paths(a->bddm, a->q[i]);
-            auto it = find(final_states.begin(), final_states.end(), i);
-            while (pp) {
-                auto guard = whitemech::lydia::get_path_guard(n, pp->trace);
-                if (it != final_states.end()) {
-                    transitions.emplace_back(i, guard);
-                } else {
-                    transitions.emplace_back(pp->to, guard);
-                }
-
-                pp = pp->next;
-            }
-            if (it != final_states.end()) {
+            if (is_final[i]) {
+                // final states become accepting sinks
                 statuses += "+";
+                dfaAllocExceptions(0);
+                dfaStoreState(i);
             } else {
                 statuses += "-";
+                scratch.collect(a->bddm, a->q[i], [](int to) { return to; });
+                scratch.store(d_ns);
             }
-
-            // transitions
-            int nb_transitions = transitions.size();
-            dfaAllocExceptions(nb_transitions);
-            for (const auto &p: transitions) {
-                std::tie(next_state, next_guard) = p;
-                dfaStoreException(next_state, next_guard.data());
-            }
-            dfaStoreState(d_ns);
-            kill_paths(state_paths);
         }
 
 //        statuses += "+";
@@ -482,74 +438,40 @@ namespace Syft {
     ExplicitStateDfa
     ExplicitStateDfa::dfa_to_Fdfa_obligation(const ExplicitStateDfa &input) {
         ExplicitStateDfa d(input);
-        int d_ns = d.get_nb_states();
-        int new_ns = d_ns + 1; // add a fresh initial state
         int n = d.get_nb_variables();
-        int new_len = d.names.size();
-
-        std::vector<size_t> final_states = d.get_final();
-        std::vector<bool> is_final(d_ns, false);
-        for (auto s : final_states) {
-            if (s < is_final.size()) {
-                is_final[s] = true;
-            }
-        }
 
         DFA *a = dfaMinimize(d.dfa_);
+        // States are those of the minimized DFA, which may have fewer than d
+        int a_ns = a->ns;
+        int new_ns = a_ns + 1; // add a fresh initial state
 
-        int indices[new_len];
-        for (int i = 0; i < d.indices.size(); ++i) {
-            indices[i] = d.indices[i];
-        }
-
-        dfaSetup(new_ns, new_len, indices);
-
-        auto collect_transitions = [&](int state_idx, int offset) {
-            std::vector<std::pair<int, std::string>> transitions;
-            paths local_paths = make_paths(a->bddm, a->q[state_idx]);
-            paths iter = local_paths;
-            while (iter) {
-                auto guard = whitemech::lydia::get_path_guard(n, iter->trace);
-                transitions.emplace_back(iter->to + offset, guard);
-                iter = iter->next;
-            }
-            kill_paths(local_paths);
-            return transitions;
-        };
-
-        auto emit_state = [&](const std::vector<std::pair<int, std::string>>& transitions,
-                              int default_target) {
-            dfaAllocExceptions(static_cast<int>(transitions.size()));
-            for (const auto &p : transitions) {
-                std::vector<char> guard(p.second.begin(), p.second.end());
-                guard.push_back('\0');
-                dfaStoreException(p.first, guard.data());
-            }
-            dfaStoreState(default_target);
-        };
+        std::vector<int> indices = variable_indices(d);
+        dfaSetup(new_ns, static_cast<int>(indices.size()), indices.data());
 
         std::string statuses;
         statuses.reserve(new_ns + 1);
 
+        TransitionScratch scratch(n);
+        auto shift = [](int to) { return to + 1; };
+
         // New initial state: always rejecting, mimics original initial moves
         statuses += '-';
-        auto initial_transitions = collect_transitions(0, 1);
-        int initial_default = initial_transitions.empty() ? 0 : initial_transitions.front().first;
-        emit_state(initial_transitions, initial_default);
+        scratch.collect(a->bddm, a->q[a->s], shift);
+        scratch.store(scratch.empty() ? 0 : scratch.front_target());
 
-        for (int i = 0; i < d_ns; ++i) {
+        for (int i = 0; i < a_ns; ++i) {
             int new_idx = i + 1;
-            if (is_final[i]) {
+            if (a->f[i] == 1) {
                 statuses += '+';
                 dfaAllocExceptions(0);
                 dfaStoreState(new_idx);
             } else {
                 statuses += '-';
-                auto transitions = collect_transitions(i, 1);
-                int default_target = transitions.empty() ? new_idx : transitions.front().first;
-                emit_state(transitions, default_target);
+                scratch.collect(a->bddm, a->q[i], shift);
+                scratch.store(scratch.empty() ? new_idx : scratch.front_target());
             }
         }
+        dfaFree(a);
 
         statuses.push_back('\0');
         DFA *tmp = dfaBuild(statuses.data());
@@ -627,12 +549,8 @@ namespace Syft {
         paths state_paths, pp;
         std::string statuses;
 
-        int indices[new_len];
-        for (int i = 0; i < d.indices.size(); i++) {
-            indices[i] = d.indices[i];
-        }
-
-        dfaSetup(new_ns + 1, new_len, indices);
+        std::vector<int> indices = variable_indices(d);
+        dfaSetup(new_ns + 1, static_cast<int>(indices.size()), indices.data());
 
         for (int i = 0; i < a->ns; i++) {
 
@@ -706,16 +624,318 @@ namespace Syft {
     }
 
 
-    ExplicitStateDfa ExplicitStateDfa::dfa_product_and(const std::vector<ExplicitStateDfa> &dfa_vector) {
+    namespace {
+        // An operand or intermediate result of a sequence of products
+        struct ProductItem {
+            DFA *dfa;
+            // Which of the propositions of the product the DFA reads
+            std::vector<bool> alphabet;
+            std::string label;
+        };
+
+        std::pair<std::size_t, std::size_t> alphabet_overlap(const std::vector<bool> &lhs,
+                                                             const std::vector<bool> &rhs) {
+            std::size_t shared = 0, united = 0;
+            for (std::size_t i = 0; i < lhs.size(); ++i) {
+                shared += lhs[i] && rhs[i] ? 1 : 0;
+                united += lhs[i] || rhs[i] ? 1 : 0;
+            }
+            return {shared, united};
+        }
+
+        // Between the larger operand, over the same propositions, and the full product, over disjoint ones
+        double estimated_product_states(double lhs, double rhs, const std::vector<bool> &lhs_alphabet,
+                                        const std::vector<bool> &rhs_alphabet) {
+            auto [shared, united] = alphabet_overlap(lhs_alphabet, rhs_alphabet);
+            double overlap = united == 0 ? 1.0 : static_cast<double>(shared) / united;
+            double larger = std::max(lhs, rhs);
+            return larger + (lhs * rhs - larger) * (1 - overlap);
+        }
+
+        std::vector<bool> united_alphabet(const std::vector<bool> &lhs, const std::vector<bool> &rhs) {
+            std::vector<bool> united(lhs.size());
+            for (std::size_t i = 0; i < lhs.size(); ++i) {
+                united[i] = lhs[i] || rhs[i];
+            }
+            return united;
+        }
+
+        std::atomic<std::size_t> product_count{0};
+
+        class ProductReducer {
+        public:
+            // names are those of the propositions the DFAs read, by MONA index
+            ProductReducer(dfaProductType type, const ProductMinimisationPolicy &policy,
+                           const std::vector<std::string> &names)
+                    : type_(type), type_name_(type == dfaProductType::dfaAND ? "AND" : "OR"), policy_(policy),
+                      names_(names) {}
+
+            // Takes ownership of the DFAs of lhs and rhs
+            ProductItem combine(ProductItem lhs, ProductItem rhs, double estimate) {
+                DFA *res = product(lhs.dfa, rhs.dfa);
+                return combined(std::move(lhs), std::move(rhs), res, estimate);
+            }
+
+            DFA *reduce(std::vector<ProductItem> items) {
+                std::size_t n = items.size();
+                ProductItem result = policy_.workers > 1 && n > 2
+                                     ? reduce_parallel(std::move(items))
+                                     : policy_.order == ProductOrder::Overlap && n > 2 &&
+                                       n <= std::min<std::size_t>(policy_.exhaustive_order_limit, 16)
+                                       ? reduce_exhaustive(std::move(items))
+                                       : reduce_greedy(std::move(items));
+                if (n > 1) {
+                    spdlog::debug("[ExplicitStateDfa::dfa_product] {} plan {} with intermediate states {}",
+                                  type_name_, result.label, steps_);
+                }
+                return result.dfa;
+            }
+
+        private:
+            dfaProductType type_;
+            const char *type_name_;
+            const ProductMinimisationPolicy &policy_;
+            const std::vector<std::string> &names_;
+            std::string steps_;
+
+            // The product of lhs and rhs, minimized as the policy decides; the operands are left alone
+            DFA *product(DFA *lhs, DFA *rhs) const {
+                int operand_states = std::max(lhs->ns, rhs->ns);
+                DFA *res = dfaProduct(lhs, rhs, type_);
+                if (policy_.should_minimise(res->ns, operand_states)) {
+                    DFA *minimized = dfaMinimize(res);
+                    spdlog::debug("[ExplicitStateDfa::dfa_product] {} product minimized from {} to {} states ({} saved)",
+                                  type_name_, res->ns, minimized->ns, res->ns - minimized->ns);
+                    dfaFree(res);
+                    res = minimized;
+                } else {
+                    spdlog::debug("[ExplicitStateDfa::dfa_product] {} product kept with {} states",
+                                  type_name_, res->ns);
+                }
+                return res;
+            }
+
+            // Takes ownership of the DFAs of lhs and rhs, of which res is the product
+            ProductItem combined(ProductItem lhs, ProductItem rhs, DFA *res, double estimate) {
+                dfaFree(lhs.dfa);
+                dfaFree(rhs.dfa);
+                steps_ += (steps_.empty() ? "" : ", ") + std::to_string(res->ns) + " (estimated " +
+                          std::to_string(static_cast<long long>(estimate)) + ")";
+                return ProductItem{res, united_alphabet(lhs.alphabet, rhs.alphabet),
+                                   "(" + lhs.label + " " + rhs.label + ")"};
+            }
+
+            double order_estimate(const ProductItem &lhs, const ProductItem &rhs) const {
+                double lhs_states = lhs.dfa->ns, rhs_states = rhs.dfa->ns;
+                // Ties are broken towards the smaller operands
+                return policy_.order == ProductOrder::Smallest
+                       ? lhs_states + rhs_states
+                       : estimated_product_states(lhs_states, rhs_states, lhs.alphabet, rhs.alphabet) +
+                         (lhs_states + rhs_states) * 1e-6;
+            }
+
+            ProductItem reduce_greedy(std::vector<ProductItem> items) {
+                while (items.size() > 1) {
+                    std::size_t best_lhs = 0, best_rhs = 1;
+                    double best_estimate = 0;
+                    for (std::size_t i = 0; i < items.size(); ++i) {
+                        for (std::size_t j = i + 1; j < items.size(); ++j) {
+                            double estimate = order_estimate(items[i], items[j]);
+                            if ((i == 0 && j == 1) || estimate < best_estimate) {
+                                best_lhs = i;
+                                best_rhs = j;
+                                best_estimate = estimate;
+                            }
+                        }
+                    }
+                    double estimate = estimated_product_states(items[best_lhs].dfa->ns, items[best_rhs].dfa->ns,
+                                                               items[best_lhs].alphabet, items[best_rhs].alphabet);
+                    ProductItem rhs = std::move(items[best_rhs]);
+                    items.erase(items.begin() + best_rhs);
+                    ProductItem lhs = std::move(items[best_lhs]);
+                    items.erase(items.begin() + best_lhs);
+                    items.push_back(combine(std::move(lhs), std::move(rhs), estimate));
+                }
+                return std::move(items.front());
+            }
+
+            // Plans over every bracketing of every order, by the total estimated states of the intermediate products
+            ProductItem reduce_exhaustive(std::vector<ProductItem> items) {
+                std::size_t n = items.size(), full = (std::size_t(1) << n) - 1;
+                std::vector<double> states(full + 1), cost(full + 1);
+                std::vector<std::vector<bool>> alphabets(full + 1);
+                std::vector<std::size_t> split(full + 1, 0);
+                for (std::size_t set = 1; set <= full; ++set) {
+                    if ((set & (set - 1)) == 0) {
+                        std::size_t index = 0;
+                        while ((std::size_t(1) << index) != set) {
+                            ++index;
+                        }
+                        states[set] = items[index].dfa->ns;
+                        alphabets[set] = items[index].alphabet;
+                        continue;
+                    }
+                    cost[set] = -1;
+                    for (std::size_t lhs = (set - 1) & set; lhs > 0; lhs = (lhs - 1) & set) {
+                        std::size_t rhs = set ^ lhs;
+                        if (lhs < rhs) {
+                            continue;
+                        }
+                        double estimate = estimated_product_states(states[lhs], states[rhs], alphabets[lhs],
+                                                                   alphabets[rhs]);
+                        double total = cost[lhs] + cost[rhs] + estimate;
+                        if (cost[set] < 0 || total < cost[set]) {
+                            cost[set] = total;
+                            states[set] = estimate;
+                            split[set] = lhs;
+                        }
+                    }
+                    alphabets[set] = united_alphabet(alphabets[split[set]], alphabets[set ^ split[set]]);
+                }
+                return execute(items, split, states, full);
+            }
+
+            ProductItem execute(std::vector<ProductItem> &items, const std::vector<std::size_t> &split,
+                                const std::vector<double> &states, std::size_t set) {
+                if ((set & (set - 1)) == 0) {
+                    std::size_t index = 0;
+                    while ((std::size_t(1) << index) != set) {
+                        ++index;
+                    }
+                    return std::move(items[index]);
+                }
+                ProductItem lhs = execute(items, split, states, split[set]);
+                ProductItem rhs = execute(items, split, states, set ^ split[set]);
+                return combine(std::move(lhs), std::move(rhs), states[set]);
+            }
+
+            // Pairs the items level by level, the pair of the best estimate first, so that the products of a level
+            // are independent; an odd item out is carried to the next level
+            ProductItem reduce_parallel(std::vector<ProductItem> items) {
+                while (items.size() > 1) {
+                    std::vector<std::pair<ProductItem, ProductItem>> pairs;
+                    std::vector<double> estimates;
+                    while (items.size() > 1) {
+                        std::size_t best_lhs = 0, best_rhs = 1;
+                        double best_estimate = 0;
+                        for (std::size_t i = 0; i < items.size(); ++i) {
+                            for (std::size_t j = i + 1; j < items.size(); ++j) {
+                                double estimate = order_estimate(items[i], items[j]);
+                                if ((i == 0 && j == 1) || estimate < best_estimate) {
+                                    best_lhs = i;
+                                    best_rhs = j;
+                                    best_estimate = estimate;
+                                }
+                            }
+                        }
+                        estimates.push_back(estimated_product_states(items[best_lhs].dfa->ns,
+                                                                     items[best_rhs].dfa->ns,
+                                                                     items[best_lhs].alphabet,
+                                                                     items[best_rhs].alphabet));
+                        ProductItem rhs = std::move(items[best_rhs]);
+                        items.erase(items.begin() + best_rhs);
+                        ProductItem lhs = std::move(items[best_lhs]);
+                        items.erase(items.begin() + best_lhs);
+                        pairs.emplace_back(std::move(lhs), std::move(rhs));
+                    }
+                    std::vector<DFA *> products = parallel_products(pairs);
+                    for (std::size_t k = 0; k < pairs.size(); ++k) {
+                        items.push_back(combined(std::move(pairs[k].first), std::move(pairs[k].second), products[k],
+                                                 estimates[k]));
+                    }
+                }
+                return std::move(items.front());
+            }
+
+            // The products of the pairs, by at most policy_.workers processes at once; the products whose process
+            // fails are computed here instead
+            std::vector<DFA *> parallel_products(const std::vector<std::pair<ProductItem, ProductItem>> &pairs) const {
+                std::vector<DFA *> products(pairs.size(), nullptr);
+                if (pairs.size() > 1) {
+                    std::string prefix = "lydiasyft_dfa_product_" + std::to_string(getpid()) + "_" +
+                                         std::to_string(product_count++) + "_";
+                    std::vector<std::string> paths;
+                    for (std::size_t k = 0; k < pairs.size(); ++k) {
+                        paths.push_back((std::filesystem::temp_directory_path() /
+                                         (prefix + std::to_string(k))).string());
+                    }
+
+                    // Buffered output would otherwise be written once by every child
+                    std::cout.flush();
+                    std::cerr.flush();
+                    std::fflush(nullptr);
+
+                    std::map<pid_t, std::size_t> running;
+                    std::size_t next = 0;
+                    while (next < pairs.size() || !running.empty()) {
+                        while (next < pairs.size() && running.size() < policy_.workers) {
+                            std::size_t k = next++;
+                            pid_t pid = fork();
+                            if (pid < 0) {
+                                continue;
+                            }
+                            if (pid == 0) {
+                                int status = 1;
+                                try {
+                                    ExplicitStateDfa res(product(pairs[k].first.dfa, pairs[k].second.dfa), names_);
+                                    status = res.export_to_file(paths[k]) ? 0 : 1;
+                                } catch (...) {
+                                    status = 1;
+                                }
+                                _exit(status);
+                            }
+                            running.emplace(pid, k);
+                        }
+                        bool reaped = false;
+                        for (auto it = running.begin(); it != running.end();) {
+                            int status;
+                            pid_t done = waitpid(it->first, &status, WNOHANG);
+                            if (done == 0 || (done < 0 && errno == EINTR)) {
+                                ++it;
+                                continue;
+                            }
+                            if (done == it->first && WIFEXITED(status) && WEXITSTATUS(status) == 0) {
+                                std::optional<ExplicitStateDfa> res = ExplicitStateDfa::import_from_file(
+                                        paths[it->second]);
+                                if (res) {
+                                    products[it->second] = res->release_dfa();
+                                }
+                            }
+                            it = running.erase(it);
+                            reaped = true;
+                        }
+                        if (!reaped && !running.empty()) {
+                            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                        }
+                    }
+                    for (const std::string &path: paths) {
+                        std::remove(path.c_str());
+                    }
+                }
+                for (std::size_t k = 0; k < pairs.size(); ++k) {
+                    if (products[k] == nullptr) {
+                        if (pairs.size() > 1) {
+                            spdlog::debug("[ExplicitStateDfa::dfa_product] {} product {} computed without a worker",
+                                          type_name_, k);
+                        }
+                        products[k] = product(pairs[k].first.dfa, pairs[k].second.dfa);
+                    }
+                }
+                return products;
+            }
+        };
+    }
+
+    ExplicitStateDfa ExplicitStateDfa::dfa_product(const std::vector<ExplicitStateDfa> &dfa_vector,
+                                                   const std::vector<DFA *> &dfas, dfaProductType type,
+                                                   const ProductMinimisationPolicy &policy) {
         // first record all variables, as they may not have the same alphabet
         std::unordered_map<std::string, int> name_to_index = {};
         std::vector<std::string> name_vector;
         std::set<std::string> names;
-        std::vector<DFA *> renamed_dfa_vector;
-        std::vector<std::vector<int>> mappings;
 
         //1. first collect all names
-        for (auto dfa: dfa_vector) {
+        for (const auto &dfa: dfa_vector) {
             // for each DFA, record its names and assign with global indices
             for (int i = 0; i < dfa.names.size(); i++) {
                 if (names.find(dfa.names[i]) == names.end()) {
@@ -740,131 +960,253 @@ namespace Syft {
             index++;
         }
 
-        for (auto dfa: dfa_vector) {
+        std::vector<ProductItem> items;
+        for (std::size_t k = 0; k < dfa_vector.size(); k++) {
+            const ExplicitStateDfa &dfa = dfa_vector[k];
             // for each DFA, record its names and assign with global indices
             // local index to global index
-            int map[ordered_name_vector.size()];
-            std::set<int> used_indices;
-            std::unordered_map<int, int> bimap = {};
+            // unused indices stay at -1
+            std::vector<int> map(ordered_name_vector.size(), -1);
+            std::vector<bool> alphabet(ordered_name_vector.size(), false);
             for (int i = 0; i < dfa.names.size(); i++) {
-                int name_index = name_to_index[dfa.names[i]];
-                map[i] = name_index;
-                used_indices.insert(name_index);
-                bimap[name_index] = i;
-            }
-            // unused indices
-            for (int j = dfa.names.size(); j < ordered_name_vector.size(); j++) {
-                map[j] = -1;
+                map[i] = name_to_index[dfa.names[i]];
+                alphabet[map[i]] = true;
             }
             //4. replace indices
-            DFA *copy = dfaCopy(dfa.dfa_);
-            dfaReplaceIndices(copy, map);
-            renamed_dfa_vector.push_back(copy);
+            dfaReplaceIndices(dfas[k], map.data());
+            items.push_back(ProductItem{dfas[k], std::move(alphabet), std::to_string(k)});
+        }
+
+        ExplicitStateDfa res_dfa(ProductReducer(type, policy, ordered_name_vector).reduce(std::move(items)), ordered_name_vector);
+        return res_dfa;
+    }
 
+    ExplicitStateDfa ExplicitStateDfa::dfa_product_and(const std::vector<ExplicitStateDfa> &dfa_vector,
+                                                       const ProductMinimisationPolicy &policy) {
+        std::vector<DFA *> dfas;
+        for (const auto &dfa: dfa_vector) {
+            dfas.push_back(dfaCopy(dfa.dfa_));
         }
+        return dfa_product(dfa_vector, dfas, dfaProductType::dfaAND, policy);
+    }
 
-        auto cmp = [](const DFA *d1, const DFA *d2) { return d1->ns > d2->ns; };
-        std::priority_queue<DFA *, std::vector<DFA *>, decltype(cmp)>
-                queue(renamed_dfa_vector.begin(), renamed_dfa_vector.end(), cmp);
-        while (queue.size() > 1) {
-            DFA *lhs = queue.top();
-            queue.pop();
-            DFA *rhs = queue.top();
-            queue.pop();
-            DFA *tmp = dfaProduct(lhs, rhs, dfaProductType::dfaAND);
-            std::cout << "Product DFA created with " << tmp->ns << " states." << std::endl;
-            dfaFree(lhs);
-            dfaFree(rhs);
-            DFA *res = dfaMinimize(tmp);
-            dfaFree(tmp);
-            queue.push(res);
+    ExplicitStateDfa ExplicitStateDfa::dfa_product_and(std::vector<ExplicitStateDfa> &&dfa_vector,
+                                                       const ProductMinimisationPolicy &policy) {
+        std::vector<DFA *> dfas;
+        for (auto &dfa: dfa_vector) {
+            dfas.push_back(dfa.release_dfa());
         }
+        return dfa_product(dfa_vector, dfas, dfaProductType::dfaAND, policy);
+    }
 
-        ExplicitStateDfa res_dfa(queue.top(), ordered_name_vector);
-        return res_dfa;
+    ExplicitStateDfa ExplicitStateDfa::dfa_product_or(const std::vector<ExplicitStateDfa> &dfa_vector,
+                                                      const ProductMinimisationPolicy &policy) {
+        std::vector<DFA *> dfas;
+        for (const auto &dfa: dfa_vector) {
+            dfas.push_back(dfaCopy(dfa.dfa_));
+        }
+        return dfa_product(dfa_vector, dfas, dfaProductType::dfaOR, policy);
     }
 
-    ExplicitStateDfa ExplicitStateDfa::dfa_product_or(const std::vector<ExplicitStateDfa> &dfa_vector) {
-        // first record all variables, as they may not have the same alphabet
-        std::unordered_map<std::string, int> name_to_index = {};
-        std::vector<std::string> name_vector;
-        std::set<std::string> names;
-        std::vector<DFA *> renamed_dfa_vector;
-        std::vector<std::vector<int>> mappings;
+    ExplicitStateDfa ExplicitStateDfa::dfa_product_or(std::vector<ExplicitStateDfa> &&dfa_vector,
+                                                      const ProductMinimisationPolicy &policy) {
+        std::vector<DFA *> dfas;
+        for (auto &dfa: dfa_vector) {
+            dfas.push_back(dfa.release_dfa());
+        }
+        return dfa_product(dfa_vector, dfas, dfaProductType::dfaOR, policy);
+    }
 
-        //1. first collect all names
-        for (auto dfa: dfa_vector) {
-            // for each DFA, record its names and assign with global indices
-            for (int i = 0; i < dfa.names.size(); i++) {
-                if (names.find(dfa.names[i]) == names.end()) {
-                    // not found
-                    names.insert(dfa.names[i]);
-                    name_vector.push_back(dfa.names[i]);
+    namespace {
+        // Appends the transitions of the state rooted at p, as guards over the
+        // product alphabet, to_global mapping the BDD indices of the DFA
+        void collect_guards(bdd_manager *bddm, bdd_ptr p, const std::vector<int> &to_global, std::string &guard,
+                            std::vector<std::pair<std::string, int>> &transitions) {
+            if (bdd_is_leaf(bddm, p)) {
+                transitions.emplace_back(guard, static_cast<int>(bdd_leaf_value(bddm, p)));
+                return;
+            }
+            int index = to_global[bdd_ifindex(bddm, p)];
+            guard[index] = '0';
+            collect_guards(bddm, bdd_else(bddm, p), to_global, guard, transitions);
+            guard[index] = '1';
+            collect_guards(bddm, bdd_then(bddm, p), to_global, guard, transitions);
+            guard[index] = 'X';
+        }
+
+        // Conjoins guard into combined, or returns false if they contradict
+        bool conjoin_guards(std::string &combined, const std::string &guard) {
+            for (std::size_t i = 0; i < guard.size(); ++i) {
+                if (guard[i] == 'X') {
+                    continue;
+                }
+                if (combined[i] != 'X' && combined[i] != guard[i]) {
+                    return false;
                 }
+                combined[i] = guard[i];
             }
+            return true;
         }
-        //2. order the names alphabetically
-        // Note: MONA DFA needs the names to be ordered alphabetically
-        auto str_cmp = [](const std::string &s1, const std::string &s2) { return s1 > s2; };
-        std::priority_queue<std::string, std::vector<std::string>, decltype(str_cmp)>
-                str_queue(name_vector.begin(), name_vector.end(), str_cmp);
-        int index = 0;
-        std::vector<std::string> ordered_name_vector;
-        while (str_queue.size() > 0) {
-            std::string name = str_queue.top();
-            str_queue.pop();
-            name_to_index[name] = index;
-            ordered_name_vector.push_back(name);
-            index++;
+    }
+
+    ExplicitStateDfa ExplicitStateDfa::dfa_product_reachable(const std::vector<ExplicitStateDfa> &dfa_vector,
+                                                             dfaProductType type) {
+        if (dfa_vector.empty()) {
+            throw std::runtime_error("Error: Empty product of DFAs");
+        }
+        const bool is_and = type == dfaProductType::dfaAND;
+        // A coordinate in a sink that does not decide the product
+        const int neutral = -1;
+        // The single tuple of every product state with a component in a deciding sink
+        const std::vector<int> decided_tuple = {-2};
+
+        // The MONA DFA needs the names ordered alphabetically
+        std::set<std::string> name_set;
+        for (const auto &dfa: dfa_vector) {
+            name_set.insert(dfa.names.begin(), dfa.names.end());
+        }
+        std::vector<std::string> ordered_names(name_set.begin(), name_set.end());
+        std::unordered_map<std::string, int> name_to_index;
+        for (std::size_t i = 0; i < ordered_names.size(); ++i) {
+            name_to_index[ordered_names[i]] = static_cast<int>(i);
         }
+        std::size_t nb_variables = ordered_names.size();
+
+        // Per component: the transitions of each state, and the sinks
+        std::size_t n = dfa_vector.size();
+        std::vector<std::vector<std::vector<std::pair<std::string, int>>>> transitions(n);
+        std::vector<std::vector<int>> sink(n);  // 1 accepting sink, -1 rejecting sink, 0 otherwise
+        for (std::size_t k = 0; k < n; ++k) {
+            DFA *a = dfa_vector[k].dfa_;
+            std::vector<int> to_global;
+            for (const std::string &name: dfa_vector[k].names) {
+                to_global.push_back(name_to_index.at(name));
+            }
+            transitions[k].resize(a->ns);
+            sink[k].assign(a->ns, 0);
+            std::string guard(nb_variables, 'X');
+            for (int state = 0; state < a->ns; ++state) {
+                collect_guards(a->bddm, a->q[state], to_global, guard, transitions[k][state]);
+                bool loops = std::all_of(transitions[k][state].begin(), transitions[k][state].end(),
+                                         [state](const auto &t) { return t.second == state; });
+                if (loops) {
+                    sink[k][state] = a->f[state] == 1 ? 1 : -1;
+                }
+            }
+        }
+        const int deciding_sink = is_and ? -1 : 1;
+
+        // Tuples are numbered as they are discovered, breadth first
+        std::map<std::vector<int>, int> tuple_to_state;
+        std::vector<std::vector<int>> tuples;
+        auto state_of = [&](std::vector<int> tuple) -> int {
+            for (std::size_t k = 0; k < n && tuple != decided_tuple; ++k) {
+                if (tuple[k] == neutral) {
+                    continue;
+                }
+                if (sink[k][tuple[k]] == deciding_sink) {
+                    tuple = decided_tuple;
+                } else if (sink[k][tuple[k]] != 0) {
+                    tuple[k] = neutral;
+                }
+            }
+            auto found = tuple_to_state.find(tuple);
+            if (found != tuple_to_state.end()) {
+                return found->second;
+            }
+            int state = static_cast<int>(tuples.size());
+            tuple_to_state.emplace(tuple, state);
+            tuples.push_back(std::move(tuple));
+            return state;
+        };
 
-        for (auto dfa: dfa_vector) {
-            // for each DFA, record its names and assign with global indices
-            // local index to global index
-            int map[ordered_name_vector.size()];
-            std::set<int> used_indices;
-            std::unordered_map<int, int> bimap = {};
-            for (int i = 0; i < dfa.names.size(); i++) {
-                int name_index = name_to_index[dfa.names[i]];
-                map[i] = name_index;
-                used_indices.insert(name_index);
-                bimap[name_index] = i;
+        std::vector<int> initial;
+        for (const auto &dfa: dfa_vector) {
+            initial.push_back(dfa.dfa_->s);
+        }
+        state_of(initial);
+
+        std::string statuses;
+        std::vector<std::vector<std::pair<std::string, int>>> product_transitions;
+        std::string top(nb_variables, 'X');
+        for (std::size_t state = 0; state < tuples.size(); ++state) {
+            std::vector<int> tuple = tuples[state];
+            std::vector<std::pair<std::string, int>> moves;
+            if (tuple == decided_tuple) {
+                statuses += is_and ? '-' : '+';
+                moves.emplace_back(top, static_cast<int>(state));
+                product_transitions.push_back(std::move(moves));
+                continue;
             }
-            // unused indices
-            for (int j = dfa.names.size(); j < ordered_name_vector.size(); j++) {
-                map[j] = -1;
+
+            bool accepting = is_and;
+            for (std::size_t k = 0; k < n; ++k) {
+                if (tuple[k] == neutral) {
+                    continue;
+                }
+                bool final = dfa_vector[k].dfa_->f[tuple[k]] == 1;
+                accepting = is_and ? accepting && final : accepting || final;
             }
-            //4. replace indices
-            DFA *copy = dfaCopy(dfa.dfa_);
-            dfaReplaceIndices(copy, map);
-            renamed_dfa_vector.push_back(copy);
+            statuses += accepting ? '+' : '-';
 
+            // The successor tuples under each consistent combination of component guards
+            std::vector<std::pair<std::string, std::vector<int>>> partial = {{top, tuple}};
+            for (std::size_t k = 0; k < n; ++k) {
+                if (tuple[k] == neutral) {
+                    continue;
+                }
+                std::vector<std::pair<std::string, std::vector<int>>> extended;
+                for (const auto &[guard, successor]: partial) {
+                    for (const auto &[component_guard, target]: transitions[k][tuple[k]]) {
+                        std::string combined = guard;
+                        if (conjoin_guards(combined, component_guard)) {
+                            extended.emplace_back(std::move(combined), successor);
+                            extended.back().second[k] = target;
+                        }
+                    }
+                }
+                partial = std::move(extended);
+            }
+            for (auto &[guard, successor]: partial) {
+                moves.emplace_back(std::move(guard), state_of(std::move(successor)));
+            }
+            product_transitions.push_back(std::move(moves));
         }
 
-        auto cmp = [](const DFA *d1, const DFA *d2) { return d1->ns > d2->ns; };
-        std::priority_queue<DFA *, std::vector<DFA *>, decltype(cmp)>
-                queue(renamed_dfa_vector.begin(), renamed_dfa_vector.end(), cmp);
-        while (queue.size() > 1) {
-            DFA *lhs = queue.top();
-            queue.pop();
-            DFA *rhs = queue.top();
-            queue.pop();
-            DFA *tmp = dfaProduct(lhs, rhs, dfaProductType::dfaOR);
-            dfaFree(lhs);
-            dfaFree(rhs);
-            //DFA *res = dfaMinimize(tmp);
-            //dfaFree(tmp);
-            queue.push(tmp);
+        std::vector<int> indices(nb_variables);
+        for (std::size_t i = 0; i < nb_variables; ++i) {
+            indices[i] = static_cast<int>(i);
+        }
+        int ns = static_cast<int>(tuples.size());
+        dfaSetup(ns, static_cast<int>(nb_variables), indices.data());
+        for (const auto &moves: product_transitions) {
+            // The guards partition the alphabet; the last one becomes the default
+            dfaAllocExceptions(static_cast<int>(moves.size()) - 1);
+            for (std::size_t i = 0; i + 1 < moves.size(); ++i) {
+                dfaStoreException(moves[i].second, const_cast<char *>(moves[i].first.c_str()));
+            }
+            dfaStoreState(moves.back().second);
         }
+        statuses.push_back('\0');
+        DFA *product = dfaBuild(statuses.data());
+        spdlog::debug("[ExplicitStateDfa::dfa_product_reachable] {} product of {} DFAs has {} states",
+                      is_and ? "AND" : "OR", n, ns);
+        return ExplicitStateDfa(product, ordered_names);
+    }
 
-        ExplicitStateDfa res_dfa(queue.top(), ordered_name_vector);
-        return res_dfa;
+    ExplicitStateDfa ExplicitStateDfa::take(SharedExplicitStateDfa &handle) {
+        SharedExplicitStateDfa owned = std::move(handle);
+        if (owned.use_count() == 1) {
+            return std::move(*owned);
+        }
+        return *owned;
     }
 
 
     ExplicitStateDfa ExplicitStateDfa::dfa_minimize(const ExplicitStateDfa &d) {
-        //DFA *res = dfaMinimize(d.dfa_);
-        ExplicitStateDfa res_dfa(d.dfa_, d.names);
+        DFA *res = dfaMinimize(d.dfa_);
+        spdlog::debug("[ExplicitStateDfa::dfa_minimize] minimized from {} to {} states", d.dfa_->ns, res->ns);
+        ExplicitStateDfa res_dfa(res, d.names);
         return res_dfa;
     }
 
@@ -890,15 +1232,16 @@ namespace Syft {
      * 
      * The result is a minimal weak automaton for the given ω-language.
      */
-    ExplicitStateDfa ExplicitStateDfa::dfa_minimize_weak(const ExplicitStateDfa &d) {
+    ExplicitStateDfa::StateSccs ExplicitStateDfa::state_sccs(const ExplicitStateDfa &d) {
         DFA* a = d.dfa_;
         int ns = a->ns;
-        
+        StateSccs sccs;
+
         // Build a Boost graph from the DFA
         typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS> Graph;
         Graph g(ns);
         // Store if a vertex has a self-loop
-        std::vector<bool> has_self_loop(ns, false);
+        sccs.has_self_loop.assign(ns, false);
 
         // Add edges to the graph
         for (int v = 0; v < ns; v++) {
@@ -914,14 +1257,46 @@ namespace Syft {
             for (int succ : successors) {
                 boost::add_edge(v, succ, g);
                 if (succ == v) {
-                    has_self_loop[v] = true;
+                    sccs.has_self_loop[v] = true;
                 }
             }
         }
         
-        // Step 1: Compute SCCs using Boost's strong_components
-        std::vector<int> scc_id(ns);
-        int num_sccs = boost::strong_components(g, &scc_id[0]);
+        // Compute SCCs using Boost's strong_components
+        sccs.scc_of_state.resize(ns);
+        int num_sccs = ns > 0 ? boost::strong_components(g, &sccs.scc_of_state[0]) : 0;
+
+        // Build SCC graph by collapsing edges of g into edges between SCC ids.
+        typedef boost::adjacency_list<boost::setS, boost::vecS, boost::directedS> SCCGraph;
+        SCCGraph scc_graph(num_sccs);
+        sccs.successors.resize(num_sccs);
+        typedef boost::graph_traits<Graph>::edge_iterator edge_iter;
+        edge_iter ei, ei_end;
+        for (boost::tie(ei, ei_end) = boost::edges(g); ei != ei_end; ++ei) {
+            int su = sccs.scc_of_state[boost::source(*ei, g)];
+            int sv = sccs.scc_of_state[boost::target(*ei, g)];
+            if (su != sv) {
+                boost::add_edge(su, sv, scc_graph);
+                sccs.successors[su].insert(sv);
+            }
+        }
+
+        // The SCC graph is acyclic by construction; the sort emits successors first
+        sccs.reverse_topological_order.reserve(num_sccs);
+        boost::topological_sort(scc_graph, std::back_inserter(sccs.reverse_topological_order));
+
+        return sccs;
+    }
+
+    ExplicitStateDfa ExplicitStateDfa::dfa_minimize_weak(const ExplicitStateDfa &d) {
+        DFA* a = d.dfa_;
+        int ns = a->ns;
+
+        // Step 1: Compute SCCs
+        StateSccs sccs = state_sccs(d);
+        const std::vector<int> &scc_id = sccs.scc_of_state;
+        const std::vector<bool> &has_self_loop = sccs.has_self_loop;
+        int num_sccs = static_cast<int>(sccs.successors.size());
         
         // Analyze SCCs - check if recurrent and accepting
         std::vector<bool> is_recurrent(num_sccs, false);
@@ -958,34 +1333,8 @@ namespace Syft {
             }
         }
         
-        // Step 2: Build SCC graph and compute topological order
-        typedef boost::adjacency_list<boost::setS, boost::vecS, boost::directedS> SCCGraph;
-        SCCGraph scc_graph(num_sccs);
-        
-        // Build SCC graph by collapsing edges of g into edges between SCC ids.
-        typedef boost::graph_traits<Graph>::edge_iterator edge_iter;
-        edge_iter ei, ei_end;
-        for (boost::tie(ei, ei_end) = boost::edges(g); ei != ei_end; ++ei) {
-            int u = boost::source(*ei, g);
-            int v = boost::target(*ei, g);
-            int su = scc_id[u];
-            int sv = scc_id[v];
-            if (su != sv) {
-            boost::add_edge(su, sv, scc_graph);
-            }
-        }
-        
-        // Compute topological sort
-        std::vector<int> topo_order;
-        topo_order.reserve(num_sccs);
-        try {
-            boost::topological_sort(scc_graph, std::back_inserter(topo_order));
-        } catch (boost::not_a_dag&) {
-            // This shouldn't happen with the SCC graph, but handle it gracefully
-            std::cerr << "Warning: SCC graph is not a DAG, using original automaton" << std::endl;
-            ExplicitStateDfa result(dfaCopy(a), d.names);
-            return result;
-        }
+        // Step 2: Walk the SCC graph in topological order, successors first
+        const std::vector<int> &topo_order = sccs.reverse_topological_order;
             
         // Step 3: Compute maximal coloring following Löding's algorithm (Fig. 1)
         const int k = (num_sccs | 1) + 1;  // Large enough even number
@@ -993,11 +1342,7 @@ namespace Syft {
         
         for (int vi : topo_order) {
             // Get successor SCCs
-            std::set<int> succ_sccs;
-            auto edge_range = boost::out_edges(vi, scc_graph);
-            for (auto it = edge_range.first; it != edge_range.second; ++it) {
-                succ_sccs.insert(boost::target(*it, scc_graph));
-            }
+            const std::set<int> &succ_sccs = sccs.successors[vi];
             
             if (succ_sccs.empty()) {
                 // No successors - terminal SCC
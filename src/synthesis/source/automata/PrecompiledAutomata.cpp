@@ -0,0 +1,462 @@
+#include "automata/PrecompiledAutomata.h"
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "FlatJson.h"
+#include "Utils.h"
+#include "lydia/parser/ltlf/driver.hpp"
+#include "lydia/utils/print.hpp"
+
+namespace Syft {
+
+    namespace {
+        struct HoaToken {
+            enum class Kind {Word, String, Integer, Punct, End};
+            Kind kind = Kind::End;
+            std::string text;
+        };
+
+        // Splits a HOA file into tokens, dropping whitespace and /* comments */
+        class HoaLexer {
+        public:
+            HoaLexer(std::istream &in, std::string source) : source_(std::move(source)) {
+                std::stringstream text;
+                text << in.rdbuf();
+                text_ = text.str();
+                advance();
+            }
+
+            const HoaToken &peek() const { return token_; }
+
+            HoaToken next() {
+                HoaToken token = token_;
+                advance();
+                return token;
+            }
+
+            bool at(HoaToken::Kind kind, const std::string &text) const {
+                return token_.kind == kind && token_.text == text;
+            }
+
+            void expect(HoaToken::Kind kind, const std::string &text) {
+                if (!at(kind, text)) {
+                    fail("expected '" + text + "'");
+                }
+                advance();
+            }
+
+            int integer() {
+                if (token_.kind != HoaToken::Kind::Integer) {
+                    fail("expected a number");
+                }
+                return std::stoi(next().text);
+            }
+
+            [[noreturn]] void fail(const std::string &message) const {
+                std::string found = token_.kind == HoaToken::Kind::End ? "end of input" : "'" + token_.text + "'";
+                throw std::runtime_error("Error: " + source_ + ": " + message + " at " + found);
+            }
+
+        private:
+            std::string source_;
+            std::string text_;
+            std::size_t position_ = 0;
+            HoaToken token_;
+
+            void advance() {
+                while (position_ < text_.size()) {
+                    if (std::isspace(static_cast<unsigned char>(text_[position_]))) {
+                        position_++;
+                    } else if (text_.compare(position_, 2, "/*") == 0) {
+                        std::size_t end = text_.find("*/", position_ + 2);
+                        position_ = end == std::string::npos ? text_.size() : end + 2;
+                    } else {
+                        break;
+                    }
+                }
+                token_ = HoaToken();
+                if (position_ == text_.size()) {
+                    return;
+                }
+                char c = text_[position_];
+                if (c == '"') {
+                    token_.kind = HoaToken::Kind::String;
+                    for (position_++; position_ < text_.size() && text_[position_] != '"'; position_++) {
+                        if (text_[position_] == '\\' && position_ + 1 < text_.size()) {
+                            position_++;
+                        }
+                        token_.text += text_[position_];
+                    }
+                    if (position_ == text_.size()) {
+                        throw std::runtime_error("Error: " + source_ + ": unterminated string");
+                    }
+                    position_++;
+                } else if (std::isdigit(static_cast<unsigned char>(c))) {
+                    token_.kind = HoaToken::Kind::Integer;
+                    while (position_ < text_.size() && std::isdigit(static_cast<unsigned char>(text_[position_]))) {
+                        token_.text += text_[position_++];
+                    }
+                } else if (std::string("[]{}()&|!").find(c) != std::string::npos) {
+                    token_.kind = HoaToken::Kind::Punct;
+                    token_.text = std::string(1, c);
+                    position_++;
+                } else {
+                    token_.kind = HoaToken::Kind::Word;
+                    while (position_ < text_.size()) {
+                        char d = text_[position_];
+                        if (!std::isalnum(static_cast<unsigned char>(d)) &&
+                            std::string("_-@.:").find(d) == std::string::npos) {
+                            break;
+                        }
+                        token_.text += d;
+                        position_++;
+                        // A header name ends at its colon, e.g. in "States:3"
+                        if (d == ':') {
+                            break;
+                        }
+                    }
+                    if (token_.text.empty()) {
+                        fail("unexpected character");
+                    }
+                }
+            }
+        };
+
+        bool is_header_name(const HoaToken &token) {
+            return token.kind == HoaToken::Kind::Word && token.text.size() > 1 && token.text.back() == ':';
+        }
+
+        // A cube over the atomic propositions: '0', '1' or 'X' per proposition
+        typedef std::string Cube;
+
+        std::vector<Cube> conjoin(const std::vector<Cube> &left, const std::vector<Cube> &right) {
+            std::vector<Cube> cubes;
+            for (const Cube &a: left) {
+                for (const Cube &b: right) {
+                    Cube cube = a;
+                    bool consistent = true;
+                    for (std::size_t i = 0; i < cube.size() && consistent; ++i) {
+                        if (b[i] == 'X') {
+                            continue;
+                        }
+                        consistent = cube[i] == 'X' || cube[i] == b[i];
+                        cube[i] = b[i];
+                    }
+                    if (consistent) {
+                        cubes.push_back(std::move(cube));
+                    }
+                }
+            }
+            return cubes;
+        }
+
+        // Reads a label of the grammar or := and ('|' and)*, and := not ('&' not)*,
+        // not := '!' not | 't' | 'f' | proposition | '(' or ')', as the cubes of a
+        // DNF; negations are pushed to the propositions as the label is read
+        std::vector<Cube> read_label(HoaLexer &lexer, std::size_t propositions, bool positive);
+
+        std::vector<Cube> read_negation(HoaLexer &lexer, std::size_t propositions, bool positive) {
+            if (lexer.at(HoaToken::Kind::Punct, "!")) {
+                lexer.next();
+                return read_negation(lexer, propositions, !positive);
+            }
+            if (lexer.at(HoaToken::Kind::Punct, "(")) {
+                lexer.next();
+                std::vector<Cube> cubes = read_label(lexer, propositions, positive);
+                lexer.expect(HoaToken::Kind::Punct, ")");
+                return cubes;
+            }
+            if (lexer.at(HoaToken::Kind::Word, "t") || lexer.at(HoaToken::Kind::Word, "f")) {
+                bool value = lexer.next().text == "t";
+                return value == positive ? std::vector<Cube>{Cube(propositions, 'X')} : std::vector<Cube>();
+            }
+            if (lexer.peek().kind == HoaToken::Kind::Word && lexer.peek().text.front() == '@') {
+                lexer.fail("aliases are not supported");
+            }
+            int proposition = lexer.integer();
+            if (proposition < 0 || static_cast<std::size_t>(proposition) >= propositions) {
+                lexer.fail("no such atomic proposition");
+            }
+            Cube cube(propositions, 'X');
+            cube[proposition] = positive ? '1' : '0';
+            return {cube};
+        }
+
+        std::vector<Cube> read_operands(HoaLexer &lexer, std::size_t propositions, bool positive,
+                                        const std::string &op) {
+            // Under a negation, a conjunction is read as the disjunction of the negated operands and conversely
+            bool conjunction = (op == "&") == positive;
+            std::vector<Cube> cubes = op == "&" ? read_negation(lexer, propositions, positive)
+                                                : read_operands(lexer, propositions, positive, "&");
+            while (lexer.at(HoaToken::Kind::Punct, op)) {
+                lexer.next();
+                std::vector<Cube> operand = op == "&" ? read_negation(lexer, propositions, positive)
+                                                      : read_operands(lexer, propositions, positive, "&");
+                if (conjunction) {
+                    cubes = conjoin(cubes, operand);
+                } else {
+                    cubes.insert(cubes.end(), operand.begin(), operand.end());
+                }
+            }
+            return cubes;
+        }
+
+        std::vector<Cube> read_label(HoaLexer &lexer, std::size_t propositions, bool positive) {
+            return read_operands(lexer, propositions, positive, "|");
+        }
+
+        bool overlap(const Cube &a, const Cube &b) {
+            for (std::size_t i = 0; i < a.size(); ++i) {
+                if (a[i] != 'X' && b[i] != 'X' && a[i] != b[i]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // The letters of a that are not in b, as disjoint cubes
+        std::vector<Cube> subtract(Cube a, const Cube &b) {
+            if (!overlap(a, b)) {
+                return {a};
+            }
+            std::vector<Cube> pieces;
+            for (std::size_t i = 0; i < a.size(); ++i) {
+                if (b[i] != 'X' && a[i] == 'X') {
+                    Cube piece = a;
+                    piece[i] = b[i] == '1' ? '0' : '1';
+                    pieces.push_back(std::move(piece));
+                    a[i] = b[i];
+                }
+            }
+            return pieces;
+        }
+
+        struct HoaEdge {
+            Cube guard;
+            int target;
+        };
+    }
+
+    PrecompiledAutomata PrecompiledAutomata::read_manifest(const std::string &path) {
+        std::ifstream in(path);
+        if (!in.is_open()) {
+            throw std::runtime_error("Error: Could not open automata manifest: " + path);
+        }
+        std::filesystem::path base = std::filesystem::path(path).parent_path();
+        auto driver = std::make_shared<whitemech::lydia::parsers::ltlf::LTLfDriver>();
+        PrecompiledAutomata automata;
+        std::string line;
+        for (std::size_t line_number = 1; std::getline(in, line); ++line_number) {
+            if (line.find_first_not_of(" \t\r") == std::string::npos) {
+                continue;
+            }
+            JsonObject object = parse_json_object(line, line_number);
+            const JsonValue *formula = json_field(object, "formula", JsonValue::Kind::String, line_number);
+            const JsonValue *automaton = json_field(object, "automaton", JsonValue::Kind::String, line_number);
+            if (formula == nullptr || automaton == nullptr) {
+                throw std::runtime_error("Error: Line " + std::to_string(line_number) + " of " + path +
+                                         ": an automaton needs a formula and a file");
+            }
+            whitemech::lydia::ltlf_ptr parsed = parse_formula(driver, formula->text);
+            if (automata.find(*parsed)) {
+                throw std::runtime_error("Error: Line " + std::to_string(line_number) + " of " + path +
+                                         ": the formula already has an automaton: " + formula->text);
+            }
+            std::filesystem::path file(automaton->text);
+            automata.add(*parsed, (file.is_absolute() ? file : base / file).string());
+        }
+        return automata;
+    }
+
+    void PrecompiledAutomata::add(const whitemech::lydia::LTLfFormula &formula, std::string file) {
+        files_[whitemech::lydia::to_string(formula)] = std::move(file);
+    }
+
+    std::optional<std::string> PrecompiledAutomata::find(const whitemech::lydia::LTLfFormula &formula) const {
+        auto entry = files_.find(whitemech::lydia::to_string(formula));
+        if (entry == files_.end()) {
+            return std::nullopt;
+        }
+        return entry->second;
+    }
+
+    ExplicitStateDfa PrecompiledAutomata::load(const std::string &file) {
+        if (std::filesystem::path(file).extension() == ".hoa") {
+            std::ifstream in(file);
+            if (!in.is_open()) {
+                throw std::runtime_error("Error: Could not open automaton: " + file);
+            }
+            return read_hoa(in, file);
+        }
+        std::optional<ExplicitStateDfa> dfa = ExplicitStateDfa::import_from_file(file);
+        if (!dfa) {
+            throw std::runtime_error("Error: Not a MONA DFA file: " + file);
+        }
+        return std::move(*dfa);
+    }
+
+    ExplicitStateDfa PrecompiledAutomata::read_hoa(std::istream &in, const std::string &source) {
+        HoaLexer lexer(in, source);
+        lexer.expect(HoaToken::Kind::Word, "HOA:");
+        lexer.next();  // the version
+
+        std::optional<int> state_count;
+        std::vector<int> start;
+        std::vector<std::string> propositions;
+        std::string acceptance;
+        while (!lexer.at(HoaToken::Kind::Word, "--BODY--")) {
+            if (!is_header_name(lexer.peek())) {
+                lexer.fail("expected a header or --BODY--");
+            }
+            std::string name = lexer.next().text;
+            if (name == "States:") {
+                state_count = lexer.integer();
+            } else if (name == "Start:") {
+                start.push_back(lexer.integer());
+                if (lexer.at(HoaToken::Kind::Punct, "&")) {
+                    lexer.fail("alternating automata are not supported");
+                }
+            } else if (name == "AP:") {
+                int count = lexer.integer();
+                for (int i = 0; i < count; ++i) {
+                    if (lexer.peek().kind != HoaToken::Kind::String) {
+                        lexer.fail("expected the name of an atomic proposition");
+                    }
+                    propositions.push_back(lexer.next().text);
+                }
+            } else if (name == "Alias:") {
+                lexer.fail("aliases are not supported");
+            } else if (name == "Acceptance:") {
+                while (!is_header_name(lexer.peek()) && !lexer.at(HoaToken::Kind::Word, "--BODY--") &&
+                       lexer.peek().kind != HoaToken::Kind::End) {
+                    acceptance += lexer.next().text;
+                }
+            } else {
+                // Other headers, such as acc-name: and properties:, do not change the automaton
+                while (!is_header_name(lexer.peek()) && !lexer.at(HoaToken::Kind::Word, "--BODY--") &&
+                       lexer.peek().kind != HoaToken::Kind::End) {
+                    lexer.next();
+                }
+            }
+        }
+        lexer.next();
+        if (start.size() != 1) {
+            lexer.fail("a DFA needs exactly one initial state");
+        }
+        if (acceptance != "1Inf(0)") {
+            lexer.fail("only the state-based acceptance 1 Inf(0) of finite-word automata is supported");
+        }
+
+        std::size_t n = propositions.size();
+        std::map<int, std::vector<HoaEdge>> edges;
+        std::map<int, bool> final_states;
+        int highest = start.front();
+        while (lexer.at(HoaToken::Kind::Word, "State:")) {
+            lexer.next();
+            if (lexer.at(HoaToken::Kind::Punct, "[")) {
+                lexer.fail("state labels are not supported");
+            }
+            int state = lexer.integer();
+            highest = std::max(highest, state);
+            if (edges.count(state) > 0) {
+                lexer.fail("state " + std::to_string(state) + " is listed twice");
+            }
+            std::vector<HoaEdge> &state_edges = edges[state];
+            if (lexer.peek().kind == HoaToken::Kind::String) {
+                lexer.next();
+            }
+            bool accepting = false;
+            if (lexer.at(HoaToken::Kind::Punct, "{")) {
+                lexer.next();
+                while (!lexer.at(HoaToken::Kind::Punct, "}")) {
+                    accepting |= lexer.integer() == 0;
+                }
+                lexer.next();
+            }
+            final_states[state] = accepting;
+            while (lexer.at(HoaToken::Kind::Punct, "[")) {
+                lexer.next();
+                std::vector<Cube> guard = read_label(lexer, n, true);
+                lexer.expect(HoaToken::Kind::Punct, "]");
+                int target = lexer.integer();
+                highest = std::max(highest, target);
+                if (lexer.at(HoaToken::Kind::Punct, "&")) {
+                    lexer.fail("alternating automata are not supported");
+                }
+                if (lexer.at(HoaToken::Kind::Punct, "{")) {
+                    lexer.fail("transition-based acceptance is not supported");
+                }
+                for (const Cube &cube: guard) {
+                    std::vector<Cube> pieces = {cube};
+                    for (const HoaEdge &edge: state_edges) {
+                        if (edge.target != target && overlap(cube, edge.guard)) {
+                            lexer.fail("state " + std::to_string(state) + " is not deterministic");
+                        }
+                        std::vector<Cube> rest;
+                        for (const Cube &piece: pieces) {
+                            std::vector<Cube> difference = subtract(piece, edge.guard);
+                            rest.insert(rest.end(), difference.begin(), difference.end());
+                        }
+                        pieces = std::move(rest);
+                    }
+                    for (Cube &piece: pieces) {
+                        state_edges.push_back(HoaEdge{std::move(piece), target});
+                    }
+                }
+            }
+            if (lexer.peek().kind == HoaToken::Kind::Integer) {
+                lexer.fail("implicit edge labels are not supported");
+            }
+        }
+        lexer.expect(HoaToken::Kind::Word, "--END--");
+
+        int hoa_states = state_count.value_or(highest + 1);
+        if (highest >= hoa_states) {
+            lexer.fail("state " + std::to_string(highest) + " is out of range");
+        }
+        // The initial state first, the others in order, and the sink last
+        std::vector<int> mona_state(hoa_states);
+        mona_state[start.front()] = 0;
+        for (int state = 0, next = 1; state < hoa_states; ++state) {
+            if (state != start.front()) {
+                mona_state[state] = next++;
+            }
+        }
+        int sink = hoa_states;
+        std::vector<int> indices(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            indices[i] = static_cast<int>(i);
+        }
+        std::vector<int> order(hoa_states);
+        for (int state = 0; state < hoa_states; ++state) {
+            order[mona_state[state]] = state;
+        }
+
+        dfaSetup(hoa_states + 1, static_cast<int>(n), n == 0 ? nullptr : indices.data());
+        std::string statuses;
+        for (int state: order) {
+            const std::vector<HoaEdge> &state_edges = edges[state];
+            dfaAllocExceptions(static_cast<int>(state_edges.size()));
+            for (const HoaEdge &edge: state_edges) {
+                std::string guard = edge.guard;
+                dfaStoreException(mona_state[edge.target], guard.data());
+            }
+            dfaStoreState(sink);
+            statuses += state != start.front() && final_states[state] ? "+" : "-";
+        }
+        dfaAllocExceptions(0);
+        dfaStoreState(sink);
+        statuses += "-";
+        return ExplicitStateDfa(dfaBuild(statuses.data()), propositions);
+    }
+
+}
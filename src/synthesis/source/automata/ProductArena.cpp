@@ -0,0 +1,173 @@
+#include "automata/ProductArena.h"
+
+#include <stdexcept>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+#include "Trace.h"
+
+namespace Syft {
+
+    ProductArena::ProductArena(std::vector<SymbolicStateDfa> components)
+            : components_(std::move(components)) {
+        if (components_.empty()) {
+            throw std::runtime_error("Incorrect usage of automata product");
+        }
+        var_mgr_ = components_[0].var_mgr();
+
+        std::vector<std::size_t> automaton_ids;
+        component_of_variable_.assign(var_mgr_->total_variable_count(), -1);
+        for (std::size_t i = 0; i < components_.size(); ++i) {
+            automaton_ids.push_back(components_[i].automaton_id());
+            for (const CUDD::BDD &var: var_mgr_->get_state_variables(components_[i].automaton_id())) {
+                component_of_variable_[var.NodeReadIndex()] = static_cast<int>(i);
+            }
+        }
+        automaton_id_ = var_mgr_->create_product_state_space(automaton_ids);
+    }
+
+    std::shared_ptr<VarMgr> ProductArena::var_mgr() const {
+        return var_mgr_;
+    }
+
+    std::size_t ProductArena::automaton_id() const {
+        return automaton_id_;
+    }
+
+    const std::vector<SymbolicStateDfa> &ProductArena::components() const {
+        return components_;
+    }
+
+    CUDD::BDD ProductArena::final_states(std::size_t i) const {
+        return components_[i].final_states();
+    }
+
+    CUDD::BDD ProductArena::final_states() const {
+        if (!final_states_) {
+            CUDD::BDD final_states = var_mgr_->cudd_mgr()->bddOne();
+            for (const SymbolicStateDfa &component: components_) {
+                final_states &= component.final_states();
+            }
+            final_states_ = final_states;
+        }
+        return *final_states_;
+    }
+
+    CUDD::BDD ProductArena::initial_state_bdd() const {
+        CUDD::BDD initial_state = var_mgr_->cudd_mgr()->bddOne();
+        for (const SymbolicStateDfa &component: components_) {
+            initial_state &= component.initial_state_bdd();
+        }
+        return initial_state;
+    }
+
+    CUDD::BDD ProductArena::preimage(const CUDD::BDD &target) const {
+        std::vector<bool> needed(components_.size(), false);
+        for (unsigned int index: target.SupportIndices()) {
+            if (index < component_of_variable_.size() && component_of_variable_[index] >= 0) {
+                needed[component_of_variable_[index]] = true;
+            }
+        }
+
+        // Identity everywhere but on the state variables of the needed components
+        std::size_t total_variable_count = var_mgr_->total_variable_count();
+        std::vector<CUDD::BDD> compose_vector;
+        compose_vector.reserve(total_variable_count);
+        for (std::size_t i = 0; i < total_variable_count; ++i) {
+            compose_vector.push_back(var_mgr_->cudd_mgr()->bddVar(static_cast<int>(i)));
+        }
+        for (std::size_t i = 0; i < components_.size(); ++i) {
+            if (!needed[i]) {
+                continue;
+            }
+            std::vector<CUDD::BDD> state_variables = var_mgr_->get_state_variables(components_[i].automaton_id());
+            const std::vector<CUDD::BDD> &transition_function = components_[i].transition_function();
+            for (std::size_t j = 0; j < state_variables.size(); ++j) {
+                compose_vector[state_variables[j].NodeReadIndex()] = transition_function[j];
+            }
+        }
+
+        return target.VectorCompose(compose_vector);
+    }
+
+    CUDD::BDD ProductArena::reachable_states() const {
+        if (!reachable_states_) {
+            TraceScope trace("product reachability", "automata");
+            reachable_states_ = symbolic_view().reachable_states();
+            trace.arg("components", static_cast<double>(components_.size())).bdd("reachable_nodes", *reachable_states_);
+        }
+        return *reachable_states_;
+    }
+
+    void ProductArena::simplify_transitions(const CUDD::BDD &care_states) {
+        TraceScope trace("product simplification", "automata");
+        for (SymbolicStateDfa &component: components_) {
+            component.simplify_transitions(care_states);
+        }
+    }
+
+    void ProductArena::simplify_on_care(const CUDD::BDD &care_states, std::vector<CUDD::BDD> &colors,
+                                        StrategyMinimization method) {
+        if (method == StrategyMinimization::Off) {
+            return;
+        }
+        TraceScope trace("care simplification", "automata");
+        std::vector<CUDD::BDD> before = colors;
+        std::vector<int> component_of_color(colors.size(), -1);
+        for (std::size_t c = 0; c < colors.size(); ++c) {
+            for (std::size_t i = 0; i < components_.size() && component_of_color[c] < 0; ++i) {
+                if (colors[c] == components_[i].final_states_) {
+                    component_of_color[c] = static_cast<int>(i);
+                }
+            }
+        }
+
+        std::vector<CUDD::BDD> after;
+        for (std::size_t i = 0; i < components_.size(); ++i) {
+            SymbolicStateDfa &component = components_[i];
+            before.insert(before.end(), component.transition_function_.begin(), component.transition_function_.end());
+            before.push_back(component.final_states_);
+            CUDD::BDD others = var_mgr_->cudd_mgr()->bddOne();
+            for (std::size_t j = 0; j < components_.size(); ++j) {
+                if (j != i) {
+                    others &= var_mgr_->state_variables_cube(components_[j].automaton_id());
+                }
+            }
+            CUDD::BDD care = care_states.ExistAbstract(others);
+            component.simplify_transitions(care, method);
+            component.final_states_ = care_simplified(component.final_states_, care, method);
+            after.insert(after.end(), component.transition_function_.begin(), component.transition_function_.end());
+            after.push_back(component.final_states_);
+        }
+        for (std::size_t c = 0; c < colors.size(); ++c) {
+            colors[c] = component_of_color[c] >= 0 ? components_[component_of_color[c]].final_states_
+                                                   : care_simplified(colors[c], care_states, method);
+        }
+        after.insert(after.end(), colors.begin(), colors.end());
+        final_states_.reset();
+
+        std::size_t nodes_before = shared_node_count(before);
+        std::size_t nodes_after = shared_node_count(after);
+        trace.arg("components", static_cast<double>(components_.size()))
+            .arg("nodes_before", static_cast<double>(nodes_before))
+            .arg("nodes_after", static_cast<double>(nodes_after));
+        spdlog::info("[ProductArena::simplify_on_care] transitions and {} colors from {} to {} nodes",
+                     colors.size(), nodes_before, nodes_after);
+    }
+
+    SymbolicStateDfa ProductArena::symbolic_view() const {
+        SymbolicStateDfa view(var_mgr_);
+        view.automaton_id_ = automaton_id_;
+        view.final_states_ = var_mgr_->cudd_mgr()->bddOne();
+        for (const SymbolicStateDfa &component: components_) {
+            std::vector<int> initial_state = component.initial_state();
+            view.initial_state_.insert(view.initial_state_.end(), initial_state.begin(), initial_state.end());
+            const std::vector<CUDD::BDD> &transition_function = component.transition_function();
+            view.transition_function_.insert(view.transition_function_.end(), transition_function.begin(),
+                                             transition_function.end());
+        }
+        return view;
+    }
+
+}
@@ -0,0 +1,130 @@
+#include "automata/StateEncoding.h"
+
+#include <stdexcept>
+#include <utility>
+
+namespace Syft {
+
+    namespace {
+        // Number of bits needed to give distinct codes to state_count states
+        std::size_t log_bit_count(std::size_t state_count) {
+            std::size_t bit_count = 0;
+            for (std::size_t max_state = state_count > 0 ? state_count - 1 : 0; max_state > 0; max_state >>= 1) {
+                ++bit_count;
+            }
+            return bit_count;
+        }
+
+        std::vector<int> to_bits(std::size_t value, std::size_t bit_count) {
+            std::vector<int> bits(bit_count, 0);
+            for (std::size_t i = 0; i < bit_count; ++i) {
+                bits[i] = (value >> i) & 1;
+            }
+            return bits;
+        }
+
+        std::size_t gray_code(std::size_t value) {
+            return value ^ (value >> 1);
+        }
+
+        // States listed SCC by SCC, following a topological order of the SCCs
+        std::vector<std::size_t> scc_ordered_states(const ExplicitStateDfa &dfa) {
+            ExplicitStateDfa::StateSccs sccs = ExplicitStateDfa::state_sccs(dfa);
+            std::vector<std::vector<std::size_t>> members(sccs.successors.size());
+            for (std::size_t state = 0; state < sccs.scc_of_state.size(); ++state) {
+                members[sccs.scc_of_state[state]].push_back(state);
+            }
+
+            std::vector<std::size_t> order;
+            order.reserve(sccs.scc_of_state.size());
+            for (auto it = sccs.reverse_topological_order.rbegin();
+                 it != sccs.reverse_topological_order.rend(); ++it) {
+                order.insert(order.end(), members[*it].begin(), members[*it].end());
+            }
+            return order;
+        }
+    }
+
+    StateEncoding::StateEncoding(StateEncodingKind kind, std::size_t bit_count,
+                                 std::vector<std::vector<int>> codes)
+            : kind_(kind), bit_count_(bit_count), codes_(std::move(codes)) {}
+
+    StateEncoding StateEncoding::of(const ExplicitStateDfa &dfa, StateEncodingKind kind) {
+        if (kind == StateEncodingKind::Automatic) {
+            kind = choose(dfa);
+        }
+
+        std::size_t state_count = dfa.dfa_->ns;
+        std::size_t bit_count = kind == StateEncodingKind::OneHot ? state_count : log_bit_count(state_count);
+        std::vector<std::vector<int>> codes(state_count);
+
+        switch (kind) {
+            case StateEncodingKind::Binary:
+                for (std::size_t state = 0; state < state_count; ++state) {
+                    codes[state] = to_bits(state, bit_count);
+                }
+                break;
+            case StateEncodingKind::Gray:
+                for (std::size_t state = 0; state < state_count; ++state) {
+                    codes[state] = to_bits(gray_code(state), bit_count);
+                }
+                break;
+            case StateEncodingKind::OneHot:
+                for (std::size_t state = 0; state < state_count; ++state) {
+                    codes[state].assign(bit_count, 0);
+                    codes[state][state] = 1;
+                }
+                break;
+            case StateEncodingKind::SccOrder: {
+                std::vector<std::size_t> order = scc_ordered_states(dfa);
+                for (std::size_t position = 0; position < order.size(); ++position) {
+                    codes[order[position]] = to_bits(gray_code(position), bit_count);
+                }
+                break;
+            }
+            case StateEncodingKind::Automatic:
+                break;
+        }
+
+        return StateEncoding(kind, bit_count, std::move(codes));
+    }
+
+    StateEncodingKind StateEncoding::choose(const ExplicitStateDfa &dfa) {
+        std::size_t state_count = dfa.dfa_->ns;
+        if (state_count <= one_hot_max_states) {
+            return StateEncodingKind::OneHot;
+        }
+        if (ExplicitStateDfa::state_sccs(dfa).successors.size() > 1) {
+            return StateEncodingKind::SccOrder;
+        }
+        return StateEncodingKind::Binary;
+    }
+
+    StateEncodingKind StateEncoding::kind_from_string(const std::string &name) {
+        if (name == "binary") {
+            return StateEncodingKind::Binary;
+        } else if (name == "gray") {
+            return StateEncodingKind::Gray;
+        } else if (name == "one-hot") {
+            return StateEncodingKind::OneHot;
+        } else if (name == "scc") {
+            return StateEncodingKind::SccOrder;
+        } else if (name == "auto") {
+            return StateEncodingKind::Automatic;
+        }
+        throw std::runtime_error("Error: Unknown state encoding: " + name);
+    }
+
+    StateEncodingKind StateEncoding::kind() const {
+        return kind_;
+    }
+
+    std::size_t StateEncoding::bit_count() const {
+        return bit_count_;
+    }
+
+    const std::vector<int> &StateEncoding::code(std::size_t state) const {
+        return codes_[state];
+    }
+
+}
@@ -1,9 +1,184 @@
 #include "automata/SymbolicStateDfa.h"
+#include "BddArchive.h"
+#include "BddCubes.h"
+#include "game/PartitionedTransitionRelation.h"
+#include "Trace.h"
+#include <algorithm>
+#include <cmath>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
 #include <fstream>
+#include <functional>
+#include <iterator>
+#include <mutex>
 #include <sstream>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+
+#include <spdlog/spdlog.h>
 
 namespace Syft {
 
+    namespace {
+        // lydia's translator and MONA keep global state, so explicit DFAs are
+        // only built and freed while holding this lock
+        std::mutex explicit_dfa_mutex;
+
+        // Moves the state variables of a PPLTL DFA created from index
+        // first_new_index on right below the deepest variable in the support of
+        // their transition function. Bits whose support holds other new bits
+        // are placed after them; a cycle is broken at the first bit left.
+        void order_by_dependency(const std::shared_ptr<VarMgr> &mgr,
+                                 const std::vector<CUDD::BDD> &state_variables,
+                                 const std::vector<CUDD::BDD> &transition_function,
+                                 int first_new_index) {
+            std::unordered_map<unsigned int, std::size_t> new_bits;
+            for (std::size_t i = 0; i < state_variables.size(); ++i) {
+                unsigned int index = state_variables[i].NodeReadIndex();
+                if (static_cast<int>(index) >= first_new_index) {
+                    new_bits.emplace(index, i);
+                }
+            }
+            if (new_bits.empty()) {
+                return;
+            }
+
+            std::vector<int> placed;
+            for (int index: mgr->variable_order()) {
+                if (new_bits.count(index) == 0) {
+                    placed.push_back(index);
+                }
+            }
+            std::vector<std::vector<unsigned int>> supports(state_variables.size());
+            for (const auto &[index, bit]: new_bits) {
+                supports[bit] = transition_function[bit].SupportIndices();
+            }
+
+            std::vector<bool> done(state_variables.size(), false);
+            auto ready = [&](std::size_t bit) {
+                unsigned int own = state_variables[bit].NodeReadIndex();
+                for (unsigned int index: supports[bit]) {
+                    auto other = new_bits.find(index);
+                    if (index != own && other != new_bits.end() && !done[other->second]) {
+                        return false;
+                    }
+                }
+                return true;
+            };
+            for (std::size_t round = 0; round < new_bits.size(); ++round) {
+                std::optional<std::size_t> next, first_left;
+                for (std::size_t bit = 0; bit < state_variables.size() && !next; ++bit) {
+                    if (done[bit] || new_bits.count(state_variables[bit].NodeReadIndex()) == 0) {
+                        continue;
+                    }
+                    if (!first_left) {
+                        first_left = bit;
+                    }
+                    if (ready(bit)) {
+                        next = bit;
+                    }
+                }
+                std::size_t bit = next ? *next : *first_left;
+
+                // Right below its deepest placed dependency, or at the top if it has none
+                std::size_t position = 0;
+                for (unsigned int index: supports[bit]) {
+                    auto found = std::find(placed.begin(), placed.end(), static_cast<int>(index));
+                    if (found != placed.end()) {
+                        position = std::max(position, static_cast<std::size_t>(found - placed.begin()) + 1);
+                    }
+                }
+                placed.insert(placed.begin() + position, static_cast<int>(state_variables[bit].NodeReadIndex()));
+                done[bit] = true;
+            }
+            mgr->set_variable_order(placed);
+            spdlog::debug("[SymbolicStateDfa::dfa_of_ppltl_formula] placed {} state variables by dependency",
+                          new_bits.size());
+        }
+
+        CUDD::BDD transfer_node(DdNode *node, const CUDD::Cudd &target,
+                                const std::unordered_map<unsigned int, CUDD::BDD> &index_map,
+                                std::unordered_map<DdNode *, CUDD::BDD> &memo) {
+            DdNode *regular = Cudd_Regular(node);
+            auto it = memo.find(regular);
+            CUDD::BDD result;
+
+            if (it != memo.end()) {
+                result = it->second;
+            } else {
+                if (Cudd_IsConstant(regular)) {
+                    result = target.bddOne();
+                } else {
+                    auto variable = index_map.find(Cudd_NodeReadIndex(regular));
+                    if (variable == index_map.end()) {
+                        throw std::runtime_error(
+                                "Error: BDD variable has no counterpart in the target manager.");
+                    }
+                    CUDD::BDD high = transfer_node(Cudd_T(regular), target, index_map, memo);
+                    CUDD::BDD low = transfer_node(Cudd_E(regular), target, index_map, memo);
+                    result = variable->second.Ite(high, low);
+                }
+                memo.emplace(regular, result);
+            }
+
+            return Cudd_IsComplement(node) ? !result : result;
+        }
+
+        // Encodes the MONA BDD nodes of a DFA as the bits of the code of the
+        // state they lead to, each bit a BDD over the alphabet. MONA shares
+        // nodes between states, so each node is converted once.
+        class MonaNodeEncoder {
+        public:
+            MonaNodeEncoder(const std::shared_ptr<VarMgr> &var_mgr, const ExplicitStateDfa &explicit_dfa,
+                            const StateEncoding &encoding)
+                    : bddm_(explicit_dfa.dfa_->bddm), encoding_(encoding), bit_count_(encoding.bit_count()),
+                      one_(var_mgr->cudd_mgr()->bddOne()), zero_(var_mgr->cudd_mgr()->bddZero()) {
+                for (const std::string &name: explicit_dfa.names) {
+                    variables_.push_back(var_mgr->name_to_variable(name));
+                }
+            }
+
+            const std::vector<CUDD::BDD> &bits(unsigned node_index) {
+                auto it = memo_.find(node_index);
+                if (it != memo_.end()) {
+                    return it->second;
+                }
+
+                unsigned name_index, low_child, high_child;
+                LOAD_lri(&bddm_->node_table[node_index], low_child, high_child, name_index);
+
+                std::vector<CUDD::BDD> result;
+                result.reserve(bit_count_);
+                if (name_index == BDD_LEAF_INDEX) {
+                    // the leaf holds the successor state
+                    for (int bit: encoding_.code(low_child)) {
+                        result.push_back(bit ? one_ : zero_);
+                    }
+                } else {
+                    // references into the memo stay valid when it grows
+                    const std::vector<CUDD::BDD> &low_bits = bits(low_child);
+                    const std::vector<CUDD::BDD> &high_bits = bits(high_child);
+                    const CUDD::BDD &variable = variables_[name_index];
+                    for (std::size_t i = 0; i < bit_count_; ++i) {
+                        result.push_back(variable.Ite(high_bits[i], low_bits[i]));
+                    }
+                }
+                return memo_.emplace(node_index, std::move(result)).first->second;
+            }
+
+        private:
+            bdd_manager *bddm_;
+            const StateEncoding &encoding_;
+            std::size_t bit_count_;
+            CUDD::BDD one_;
+            CUDD::BDD zero_;
+            std::vector<CUDD::BDD> variables_;
+            std::unordered_map<unsigned, std::vector<CUDD::BDD>> memo_;
+        };
+    }
+
     SymbolicStateDfa::SymbolicStateDfa(std::shared_ptr<VarMgr> var_mgr)
             : var_mgr_(std::move(var_mgr)) {}
 
@@ -123,6 +298,226 @@ namespace Syft {
         return symbolic_dfa;
     }
 
+    SymbolicStateDfa SymbolicStateDfa::from_mona(std::shared_ptr<VarMgr> var_mgr,
+                                                 const ExplicitStateDfa &explicit_dfa,
+                                                 StateEncodingKind encoding_kind) {
+        var_mgr->create_named_variables(explicit_dfa.names);
+
+        const DFA *dfa = explicit_dfa.dfa_;
+        std::size_t state_count = dfa->ns;
+        StateEncoding encoding = StateEncoding::of(explicit_dfa, encoding_kind);
+        std::size_t bit_count = encoding.bit_count();
+        std::size_t automaton_id = var_mgr->create_state_variables(bit_count);
+
+        CUDD::BDD final_states = var_mgr->cudd_mgr()->bddZero();
+        for (std::size_t i = 0; i < state_count; ++i) {
+            if (dfa->f[i] == 1) {
+                final_states |= var_mgr->state_vector_to_bdd(automaton_id, encoding.code(i));
+            }
+        }
+
+        MonaNodeEncoder encoder(var_mgr, explicit_dfa, encoding);
+        std::vector<CUDD::BDD> zeros(bit_count, var_mgr->cudd_mgr()->bddZero());
+
+        // Selects the successor bits of each state by the state variables, most
+        // significant bit first, splitting the states by the bits of their codes;
+        // unused codes have the all-zero successor, as with the ADD conversion
+        std::function<std::vector<CUDD::BDD>(int, const std::vector<std::size_t> &)> select =
+                [&](int bit, const std::vector<std::size_t> &states) -> std::vector<CUDD::BDD> {
+                    if (states.empty()) {
+                        return zeros;
+                    }
+                    if (bit < 0) {
+                        return encoder.bits(dfa->q[states.front()]);
+                    }
+                    std::vector<std::size_t> low_states, high_states;
+                    for (std::size_t state: states) {
+                        (encoding.code(state)[bit] ? high_states : low_states).push_back(state);
+                    }
+                    std::vector<CUDD::BDD> low = select(bit - 1, low_states);
+                    std::vector<CUDD::BDD> high = select(bit - 1, high_states);
+                    CUDD::BDD state_bit = var_mgr->state_variable(automaton_id, bit);
+                    for (std::size_t i = 0; i < bit_count; ++i) {
+                        low[i] = state_bit.Ite(high[i], low[i]);
+                    }
+                    return low;
+                };
+
+        std::vector<std::size_t> states(state_count);
+        for (std::size_t i = 0; i < state_count; ++i) {
+            states[i] = i;
+        }
+
+        SymbolicStateDfa symbolic_dfa(var_mgr);
+        symbolic_dfa.automaton_id_ = automaton_id;
+        symbolic_dfa.initial_state_ = encoding.code(dfa->s);
+        symbolic_dfa.final_states_ = std::move(final_states);
+        symbolic_dfa.transition_function_ = select(static_cast<int>(bit_count) - 1, states);
+
+        return symbolic_dfa;
+    }
+
+    std::vector<SymbolicStateDfa> SymbolicStateDfa::from_explicit_parallel(
+            std::shared_ptr<VarMgr> var_mgr,
+            const std::vector<std::function<ExplicitStateDfa()>> &dfa_builders,
+            std::size_t thread_count,
+            StateEncodingKind encoding) {
+        std::vector<SymbolicStateDfa> result;
+        result.reserve(dfa_builders.size());
+
+        if (thread_count <= 1 || dfa_builders.size() <= 1) {
+            for (const auto &build: dfa_builders) {
+                ExplicitStateDfa explicit_dfa = build();
+                result.push_back(from_mona(var_mgr, explicit_dfa, encoding));
+            }
+            return result;
+        }
+
+        std::vector<std::string> input_names = var_mgr->input_variable_labels();
+        std::vector<std::string> output_names = var_mgr->output_variable_labels();
+
+        std::vector<std::optional<SymbolicStateDfa>> local_dfas(dfa_builders.size());
+        std::vector<std::exception_ptr> errors(dfa_builders.size());
+        std::atomic<std::size_t> next_job{0};
+        std::atomic<bool> stopped{false};
+
+        // The DFAs are transferred as soon as they are encoded, in the order of
+        // the builders, while the workers build the next ones. A worker's
+        // manager is locked while it encodes and while its DFAs are transferred
+        std::size_t worker_count = std::min(thread_count, dfa_builders.size());
+        std::vector<std::mutex> manager_mutexes(worker_count);
+        std::vector<std::size_t> owner(dfa_builders.size());
+        std::vector<bool> done(dfa_builders.size(), false);
+        std::mutex done_mutex;
+        std::condition_variable done_changed;
+
+        auto worker = [&](std::size_t w) {
+            std::shared_ptr<VarMgr> local_mgr;
+            {
+                std::lock_guard<std::mutex> manager_lock(manager_mutexes[w]);
+                local_mgr = std::make_shared<VarMgr>();
+                local_mgr->create_named_variables(input_names);
+                local_mgr->create_named_variables(output_names);
+                local_mgr->partition_variables(input_names, output_names);
+            }
+
+            for (std::size_t i = next_job++; i < dfa_builders.size() && !stopped; i = next_job++) {
+                try {
+                    std::unique_lock<std::mutex> lock(explicit_dfa_mutex);
+                    auto explicit_dfa = std::make_unique<ExplicitStateDfa>(dfa_builders[i]());
+                    lock.unlock();
+
+                    {
+                        std::lock_guard<std::mutex> manager_lock(manager_mutexes[w]);
+                        owner[i] = w;
+                        local_dfas[i] = from_mona(local_mgr, *explicit_dfa, encoding);
+                    }
+
+                    lock.lock();
+                    explicit_dfa.reset();
+                    lock.unlock();
+                } catch (...) {
+                    errors[i] = std::current_exception();
+                }
+                {
+                    std::lock_guard<std::mutex> done_lock(done_mutex);
+                    done[i] = true;
+                }
+                done_changed.notify_all();
+            }
+            // The last reference to the manager may be this one
+            std::lock_guard<std::mutex> manager_lock(manager_mutexes[w]);
+            local_mgr.reset();
+        };
+
+        std::vector<std::thread> workers;
+        workers.reserve(worker_count);
+        for (std::size_t t = 0; t < worker_count; ++t) {
+            workers.emplace_back(worker, t);
+        }
+
+        std::exception_ptr error;
+        bool transferred_since_reorder = false;
+        for (std::size_t i = 0; i < dfa_builders.size() && !error; ++i) {
+            std::unique_lock<std::mutex> done_lock(done_mutex);
+            if (!done[i] && transferred_since_reorder) {
+                // Reorder the parts transferred so far while the next one is built
+                done_lock.unlock();
+                var_mgr->reorder_at_phase("partial DFA construction");
+                transferred_since_reorder = false;
+                done_lock.lock();
+            }
+            done_changed.wait(done_lock, [&]() { return done[i]; });
+            done_lock.unlock();
+            if (errors[i]) {
+                error = errors[i];
+                break;
+            }
+            std::lock_guard<std::mutex> manager_lock(manager_mutexes[owner[i]]);
+            result.push_back(local_dfas[i]->transfer_to(var_mgr));
+            local_dfas[i].reset();
+            transferred_since_reorder = true;
+        }
+        if (error) {
+            stopped = true;
+        }
+        for (auto &w: workers) {
+            w.join();
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+
+        return result;
+    }
+
+    SymbolicStateDfa SymbolicStateDfa::transfer_to(std::shared_ptr<VarMgr> var_mgr) const {
+        std::size_t bit_count = var_mgr_->state_variable_count(automaton_id_);
+        std::size_t automaton_id = var_mgr->create_state_variables(bit_count);
+
+        std::unordered_map<unsigned int, CUDD::BDD> index_map;
+        for (const std::string &name: var_mgr_->input_variable_labels()) {
+            index_map[var_mgr_->name_to_variable(name).NodeReadIndex()] = var_mgr->name_to_variable(name);
+        }
+        for (const std::string &name: var_mgr_->output_variable_labels()) {
+            index_map[var_mgr_->name_to_variable(name).NodeReadIndex()] = var_mgr->name_to_variable(name);
+        }
+        for (std::size_t i = 0; i < bit_count; ++i) {
+            index_map[var_mgr_->state_variable(automaton_id_, i).NodeReadIndex()] =
+                    var_mgr->state_variable(automaton_id, i);
+        }
+
+        const CUDD::Cudd &target = *var_mgr->cudd_mgr();
+        std::unordered_map<DdNode *, CUDD::BDD> memo;
+
+        SymbolicStateDfa transferred(var_mgr);
+        transferred.automaton_id_ = automaton_id;
+        transferred.initial_state_ = initial_state_;
+        transferred.final_states_ = transfer_node(final_states_.getNode(), target, index_map, memo);
+        transferred.transition_function_.reserve(bit_count);
+        for (const CUDD::BDD &bit_function: transition_function_) {
+            transferred.transition_function_.push_back(
+                    transfer_node(bit_function.getNode(), target, index_map, memo));
+        }
+
+        return transferred;
+    }
+
+    SymbolicStateDfa SymbolicStateDfa::transfer_to_clone(std::shared_ptr<VarMgr> var_mgr) const {
+        CUDD::Cudd &target = *var_mgr->cudd_mgr();
+
+        SymbolicStateDfa transferred(var_mgr);
+        transferred.automaton_id_ = automaton_id_;
+        transferred.initial_state_ = initial_state_;
+        transferred.final_states_ = final_states_.Transfer(target);
+        transferred.transition_function_.reserve(transition_function_.size());
+        for (const CUDD::BDD &bit_function: transition_function_) {
+            transferred.transition_function_.push_back(bit_function.Transfer(target));
+        }
+
+        return transferred;
+    }
+
     std::shared_ptr<VarMgr> SymbolicStateDfa::var_mgr() const {
         return var_mgr_;
     }
@@ -131,7 +526,7 @@ namespace Syft {
         return automaton_id_;
     }
 
-    std::vector<int> SymbolicStateDfa::initial_state() const {
+    const std::vector<int> &SymbolicStateDfa::initial_state() const {
         return initial_state_;
     }
 
@@ -147,15 +542,314 @@ namespace Syft {
         // return state_to_bdd(var_mgr_, automaton_id_, 1);
     }
 
-    CUDD::BDD SymbolicStateDfa::final_states() const {
+    const CUDD::BDD &SymbolicStateDfa::final_states() const {
         return final_states_;
     }
 
-    std::vector<CUDD::BDD> SymbolicStateDfa::transition_function() const {
+    const std::vector<CUDD::BDD> &SymbolicStateDfa::transition_function() const {
         return transition_function_;
     }
 
+    const CUDD::BDD &SymbolicStateDfa::transition_bit(std::size_t i) const {
+        return transition_function_[i];
+    }
+
+    CUDD::BDD SymbolicStateDfa::reachable_states() const {
+        if (!reachable_states_) {
+            std::size_t bit_count = var_mgr_->state_variable_count(automaton_id_);
+            std::size_t primed_automaton_id = var_mgr_->create_state_variables(bit_count);
+            PartitionedTransitionRelation transition_relation(*this, primed_automaton_id);
+
+            CUDD::BDD reachable = initial_state_bdd();
+            CUDD::BDD frontier = reachable;
+            while (!frontier.IsZero()) {
+                CUDD::BDD image = transition_relation.Image(frontier);
+                frontier = image & !reachable;
+                reachable |= frontier;
+            }
+            reachable_states_ = reachable;
+        }
+        return *reachable_states_;
+    }
+
+    CUDD::BDD SymbolicStateDfa::rejecting_sink_states() const {
+        std::vector<CUDD::BDD> step = var_mgr_->make_compose_vector(automaton_id_, transition_function_);
+        CUDD::BDD io_cube = var_mgr_->input_cube() * var_mgr_->output_cube();
+        // The states that can reach a final state
+        CUDD::BDD alive = final_states_;
+        while (true) {
+            CUDD::BDD next = alive | alive.VectorCompose(step).ExistAbstract(io_cube);
+            if (next == alive) {
+                break;
+            }
+            alive = next;
+        }
+        return !alive;
+    }
+
+    CUDD::BDD SymbolicStateDfa::accepting_sink_states() const {
+        std::vector<CUDD::BDD> step = var_mgr_->make_compose_vector(automaton_id_, transition_function_);
+        CUDD::BDD io_cube = var_mgr_->input_cube() * var_mgr_->output_cube();
+        CUDD::BDD sink = final_states_;
+        while (true) {
+            CUDD::BDD next = sink & sink.VectorCompose(step).UnivAbstract(io_cube);
+            if (next == sink) {
+                break;
+            }
+            sink = next;
+        }
+        return sink;
+    }
+
+    CUDD::BDD SymbolicStateDfa::care_states() const {
+        return care_states_ ? *care_states_ : var_mgr_->cudd_mgr()->bddOne();
+    }
+
+    void SymbolicStateDfa::merge_states(const CUDD::BDD &states) {
+        std::vector<CUDD::BDD> state_variables = var_mgr_->get_state_variables(automaton_id_);
+        if (states.IsZero() || states.CountMinterm(static_cast<int>(state_variables.size())) <= 1) {
+            return;
+        }
+        CUDD::BDD initial = initial_state_bdd();
+        CUDD::BDD representative = (initial & states).IsZero() ? states.PickOneMinterm(state_variables) : initial;
+
+        // The moves that lead into states, which now lead to the representative
+        std::vector<CUDD::BDD> step = var_mgr_->make_compose_vector(automaton_id_, transition_function_);
+        CUDD::BDD into = states.VectorCompose(step);
+        for (std::size_t i = 0; i < transition_function_.size(); ++i) {
+            bool bit = !(representative & state_variables[i]).IsZero();
+            transition_function_[i] = (transition_function_[i] & !into) | (bit ? into : var_mgr_->cudd_mgr()->bddZero());
+        }
+        care_states_ = care_states() & !(states & !representative);
+        reachable_states_.reset();
+    }
+
+    void SymbolicStateDfa::simplify_transitions(const CUDD::BDD &care_states, StrategyMinimization method) {
+        for (CUDD::BDD &bit_function: transition_function_) {
+            bit_function = care_simplified(bit_function, care_states, method);
+        }
+        reachable_states_.reset();
+    }
+
+    void SymbolicStateDfa::simplify_on_care(const CUDD::BDD &care_states, std::vector<CUDD::BDD> &colors,
+                                            StrategyMinimization method) {
+        if (method == StrategyMinimization::Off) {
+            return;
+        }
+        TraceScope trace("care simplification", "automata");
+        std::vector<CUDD::BDD> before = transition_function_;
+        before.push_back(final_states_);
+        before.insert(before.end(), colors.begin(), colors.end());
+        CUDD::BDD final_states = final_states_;
+        simplify_transitions(care_states, method);
+        final_states_ = care_simplified(final_states_, care_states, method);
+        for (CUDD::BDD &color: colors) {
+            color = color == final_states ? final_states_ : care_simplified(color, care_states, method);
+        }
+        care_states_ = this->care_states() & care_states;
+
+        std::vector<CUDD::BDD> after = transition_function_;
+        after.push_back(final_states_);
+        after.insert(after.end(), colors.begin(), colors.end());
+        std::size_t nodes_before = shared_node_count(before);
+        std::size_t nodes_after = shared_node_count(after);
+        trace.arg("nodes_before", static_cast<double>(nodes_before)).arg("nodes_after", static_cast<double>(nodes_after));
+        spdlog::info("[SymbolicStateDfa::simplify_on_care] transitions and {} colors from {} to {} nodes",
+                     colors.size(), nodes_before, nodes_after);
+    }
+
+    SymbolicStateDfa SymbolicStateDfa::encode_classes(const std::vector<CUDD::BDD> &class_cubes,
+                                                      const std::vector<CUDD::BDD> &class_members,
+                                                      std::vector<CUDD::BDD> &colors,
+                                                      const std::string &phase) const {
+        std::shared_ptr<VarMgr> var_mgr = var_mgr_;
+        std::shared_ptr<CUDD::Cudd> mgr = var_mgr->cudd_mgr();
+        std::vector<CUDD::BDD> state_variables = var_mgr->get_state_variables(automaton_id_);
+        std::size_t bit_count = state_variables.size();
+        auto identity = [&]() {
+            std::vector<CUDD::BDD> vector;
+            for (int i = 0; i < mgr->ReadSize(); ++i) {
+                vector.push_back(mgr->bddVar(i));
+            }
+            return vector;
+        };
+
+        SymbolicStateDfa quotient(var_mgr);
+        quotient.automaton_id_ = create_state_variables(var_mgr, std::max<std::size_t>(class_cubes.size(), 2)).second;
+        std::size_t new_bit_count = var_mgr->state_variable_count(quotient.automaton_id_);
+        std::vector<CUDD::BDD> class_codes;
+        for (std::size_t c = 0; c < class_cubes.size(); ++c) {
+            class_codes.push_back(state_to_bdd(var_mgr, quotient.automaton_id_, c));
+        }
+        // Bit j of the code of the class of each state
+        std::vector<CUDD::BDD> code_bits(new_bit_count, mgr->bddZero());
+        for (std::size_t c = 0; c < class_cubes.size(); ++c) {
+            std::vector<int> code = state_to_binary(c, new_bit_count);
+            for (std::size_t j = 0; j < new_bit_count; ++j) {
+                if (code[j]) {
+                    code_bits[j] |= class_members[c];
+                }
+            }
+        }
+
+        quotient.transition_function_.assign(new_bit_count, mgr->bddZero());
+        quotient.final_states_ = mgr->bddZero();
+        std::vector<CUDD::BDD> quotient_colors(colors.size(), mgr->bddZero());
+        CUDD::BDD initial = initial_state_bdd();
+        for (std::size_t c = 0; c < class_cubes.size(); ++c) {
+            var_mgr->check_budget(phase);
+            // The successors of the least state of the class
+            std::vector<CUDD::BDD> step = identity();
+            for (std::size_t i = 0; i < bit_count; ++i) {
+                step[state_variables[i].NodeReadIndex()] = transition_function_[i].Cofactor(class_cubes[c]);
+            }
+            for (std::size_t j = 0; j < new_bit_count; ++j) {
+                quotient.transition_function_[j] |= class_codes[c] & code_bits[j].VectorCompose(step);
+            }
+            if (!(final_states_ & class_cubes[c]).IsZero()) {
+                quotient.final_states_ |= class_codes[c];
+            }
+            for (std::size_t k = 0; k < colors.size(); ++k) {
+                if (!(colors[k] & class_cubes[c]).IsZero()) {
+                    quotient_colors[k] |= class_codes[c];
+                }
+            }
+            if (!(initial & class_members[c]).IsZero()) {
+                quotient.initial_state_ = state_to_binary(c, new_bit_count);
+            }
+        }
+        colors = std::move(quotient_colors);
+        // The codes past the last class are never used
+        CUDD::BDD used = mgr->bddZero();
+        for (const CUDD::BDD &code: class_codes) {
+            used |= code;
+        }
+        quotient.care_states_ = used;
+        return quotient;
+    }
+
+    SymbolicStateDfa SymbolicStateDfa::minimize(std::vector<CUDD::BDD> &colors, std::size_t max_classes) const {
+        std::shared_ptr<VarMgr> var_mgr = var_mgr_;
+        std::shared_ptr<CUDD::Cudd> mgr = var_mgr->cudd_mgr();
+        CUDD::BDD reachable = reachable_states();
+
+        std::vector<CUDD::BDD> state_variables = var_mgr->get_state_variables(automaton_id_);
+        std::size_t bit_count = state_variables.size();
+        std::size_t copy_id = var_mgr->create_state_variables(bit_count);
+        std::vector<CUDD::BDD> copy_variables = var_mgr->get_state_variables(copy_id);
+        // Compose vectors must cover every variable, so they are rebuilt once variables are created
+        auto identity = [&]() {
+            std::vector<CUDD::BDD> vector;
+            for (int i = 0; i < mgr->ReadSize(); ++i) {
+                vector.push_back(mgr->bddVar(i));
+            }
+            return vector;
+        };
+
+        // The state variables renamed to their copies, and both advanced by one step
+        std::vector<CUDD::BDD> to_copy = identity();
+        for (std::size_t i = 0; i < bit_count; ++i) {
+            to_copy[state_variables[i].NodeReadIndex()] = copy_variables[i];
+        }
+        std::vector<CUDD::BDD> to_successors = identity();
+        for (std::size_t i = 0; i < bit_count; ++i) {
+            to_successors[state_variables[i].NodeReadIndex()] = transition_function_[i];
+            to_successors[copy_variables[i].NodeReadIndex()] = transition_function_[i].VectorCompose(to_copy);
+        }
+        CUDD::BDD alphabet = var_mgr->input_cube() * var_mgr->output_cube();
+
+        // Pairs of reachable states with the same colors
+        CUDD::BDD equivalent = reachable & reachable.VectorCompose(to_copy);
+        std::vector<CUDD::BDD> signature = colors;
+        signature.push_back(final_states_);
+        for (const CUDD::BDD &color: signature) {
+            equivalent &= color.Xnor(color.VectorCompose(to_copy));
+        }
+        std::size_t rounds = 0;
+        while (true) {
+            var_mgr->check_budget("arena minimization");
+            rounds++;
+            CUDD::BDD refined = equivalent & equivalent.VectorCompose(to_successors).UnivAbstract(alphabet);
+            if (refined == equivalent) {
+                break;
+            }
+            equivalent = refined;
+        }
+
+        // Relates each state to the least state of its class, from the most significant bit
+        const CUDD::BDD &copy_cube = var_mgr->state_variables_cube(copy_id);
+        CUDD::BDD representative = equivalent;
+        for (std::size_t i = bit_count; i-- > 0;) {
+            CUDD::BDD has_zero = (representative & !copy_variables[i]).ExistAbstract(copy_cube);
+            representative &= !copy_variables[i] | !has_zero;
+        }
+        CUDD::BDD representatives = representative.ExistAbstract(var_mgr->state_variables_cube(automaton_id_));
+        double class_count = representatives.CountMinterm(static_cast<int>(bit_count));
+
+        std::size_t quotient_bits = 0;
+        for (std::size_t max_state = static_cast<std::size_t>(class_count) - 1; max_state > 0; max_state >>= 1) {
+            ++quotient_bits;
+        }
+        quotient_bits = std::max<std::size_t>(quotient_bits, 1);
+        if (class_count > static_cast<double>(max_classes) || quotient_bits >= bit_count) {
+            spdlog::info("[SymbolicStateDfa::minimize] {} classes after {} rounds; kept {} state bits",
+                         class_count, rounds, bit_count);
+            return *this;
+        }
+
+        // The least state of each class, and the states of each class
+        std::vector<CUDD::BDD> class_cubes;
+        std::vector<CUDD::BDD> class_members;
+        CUDD::BDD remaining = representatives;
+        while (!remaining.IsZero()) {
+            CUDD::BDD minterm = remaining.PickOneMinterm(copy_variables);
+            remaining &= !minterm;
+            std::vector<int> bits;
+            for (const CUDD::BDD &variable: copy_variables) {
+                bits.push_back((minterm & variable).IsZero() ? 0 : 1);
+            }
+            class_cubes.push_back(var_mgr->state_vector_to_bdd(automaton_id_, bits));
+            class_members.push_back((representative & minterm).ExistAbstract(copy_cube));
+        }
+
+        SymbolicStateDfa quotient = encode_classes(class_cubes, class_members, colors, "arena minimization");
+        std::size_t new_bit_count = var_mgr->state_variable_count(quotient.automaton_id_);
+        spdlog::info("[SymbolicStateDfa::minimize] {} classes after {} rounds; {} -> {} state bits",
+                     class_cubes.size(), rounds, bit_count, new_bit_count);
+        return quotient;
+    }
+
+    SymbolicStateDfa SymbolicStateDfa::compact(std::vector<CUDD::BDD> &colors, std::size_t max_states) const {
+        CUDD::BDD used = reachable_states() & care_states();
+        std::vector<CUDD::BDD> state_variables = var_mgr_->get_state_variables(automaton_id_);
+        std::size_t bit_count = state_variables.size();
+        double state_count = used.CountMinterm(static_cast<int>(bit_count));
+
+        std::size_t compact_bits = 1;
+        while (compact_bits < bit_count && std::ldexp(1.0, static_cast<int>(compact_bits)) < state_count) {
+            ++compact_bits;
+        }
+        if (state_count > static_cast<double>(max_states) || compact_bits >= bit_count) {
+            spdlog::info("[SymbolicStateDfa::compact] {} states in use; kept {} state bits", state_count, bit_count);
+            return *this;
+        }
+
+        // Each state in use is a class of its own
+        std::vector<CUDD::BDD> states;
+        CUDD::BDD remaining = used;
+        while (!remaining.IsZero()) {
+            CUDD::BDD minterm = remaining.PickOneMinterm(state_variables);
+            remaining &= !minterm;
+            states.push_back(minterm);
+        }
+        SymbolicStateDfa compacted = encode_classes(states, states, colors, "state compaction");
+        spdlog::info("[SymbolicStateDfa::compact] {} states in use; {} -> {} state bits", states.size(), bit_count,
+                     var_mgr_->state_variable_count(compacted.automaton_id_));
+        return compacted;
+    }
+
     void SymbolicStateDfa::restrict_dfa_with_states(const CUDD::BDD &valid_states) {
+        reachable_states_.reset();
         for (CUDD::BDD &bit_function: transition_function_) {
             // If the current state is not a valid state, send every transition to
             // the sink state 0
@@ -167,6 +861,7 @@ namespace Syft {
     }
 
     void SymbolicStateDfa::restrict_dfa_with_transitions(const CUDD::BDD &feasible_moves) {
+        reachable_states_.reset();
         for (CUDD::BDD &bit_function: transition_function_) {
             // Every transition has to be a feasible move
             bit_function &= feasible_moves;
@@ -329,6 +1024,134 @@ namespace Syft {
         out.close();
     }
 
+    void SymbolicStateDfa::dump_json_cubes(const std::string &filename,
+                                           std::optional<CUDD::BDD> alt_final_states,
+                                           bool reachable_only) const {
+        std::ofstream out(filename);
+        if (!out.is_open()) {
+            throw std::runtime_error("Could not open file for writing: " + filename);
+        }
+
+        CUDD::BDD care_states = reachable_only ? reachable_states() : var_mgr_->cudd_mgr()->bddOne();
+        CUDD::BDD final_to_use = (alt_final_states.has_value() ? alt_final_states.value() : final_states_) & care_states;
+
+        auto input_labels = var_mgr_->input_variable_labels();
+        auto output_labels = var_mgr_->output_variable_labels();
+        auto state_vars = var_mgr_->get_state_variables(automaton_id_);
+
+        // CUDD index of each position of a cube string
+        std::vector<int> cube_columns;
+        for (const CUDD::BDD &var: state_vars) {
+            cube_columns.push_back(var.NodeReadIndex());
+        }
+        for (const std::string &label: input_labels) {
+            cube_columns.push_back(var_mgr_->name_to_variable(label).NodeReadIndex());
+        }
+        for (const std::string &label: output_labels) {
+            cube_columns.push_back(var_mgr_->name_to_variable(label).NodeReadIndex());
+        }
+
+        auto write_labels = [&out](const std::vector<std::string> &labels) {
+            out << "[";
+            for (std::size_t i = 0; i < labels.size(); ++i) {
+                if (i > 0) out << ", ";
+                out << "\"" << labels[i] << "\"";
+            }
+            out << "]";
+        };
+
+        // Streams the disjoint cubes of bdd, one at a time
+        auto write_cubes = [&](const CUDD::BDD &bdd) {
+            bool first_cube = true;
+            out << "[";
+            for (const int *cube: BddCubes(bdd)) {
+                if (!first_cube) out << ", ";
+                first_cube = false;
+                out << "\"";
+                for (int column: cube_columns) {
+                    out << (cube[column] == 2 ? '-' : static_cast<char>('0' + cube[column]));
+                }
+                out << "\"";
+            }
+            out << "]";
+        };
+
+        out << "{\n";
+        out << "  \"format\": \"cubes\",\n";
+        out << "  \"num_state_bits\": " << state_vars.size() << ",\n";
+        out << "  \"num_inputs\": " << input_labels.size() << ",\n";
+        out << "  \"num_outputs\": " << output_labels.size() << ",\n";
+
+        out << "  \"state_var_indices\": [";
+        for (std::size_t i = 0; i < state_vars.size(); ++i) {
+            if (i > 0) out << ", ";
+            out << state_vars[i].NodeReadIndex();
+        }
+        out << "],\n";
+
+        out << "  \"input_labels\": ";
+        write_labels(input_labels);
+        out << ",\n";
+        out << "  \"output_labels\": ";
+        write_labels(output_labels);
+        out << ",\n";
+
+        out << "  \"initial_minterm\": \"";
+        for (int bit: initial_state_) {
+            out << (bit ? '1' : '0');
+        }
+        out << "\",\n";
+
+        if (reachable_only) {
+            out << "  \"reachable_cubes\": ";
+            write_cubes(care_states);
+            out << ",\n";
+        }
+
+        out << "  \"accepting_cubes\": ";
+        write_cubes(final_to_use);
+        out << ",\n";
+
+        out << "  \"trans_cubes\": {\n";
+        for (std::size_t bit = 0; bit < transition_function_.size(); ++bit) {
+            if (bit > 0) out << ",\n";
+            out << "    \"" << bit << "\": ";
+            write_cubes(transition_function_[bit] & care_states);
+        }
+        out << "\n  }\n";
+        out << "}\n";
+
+        out.close();
+    }
+
+    void SymbolicStateDfa::save(const std::string &filename) const {
+        BddArchive archive;
+        archive.kind = "symbolic-dfa";
+        archive.automaton_id = automaton_id_;
+        archive.support_only = true;
+        archive.values = initial_state_;
+        archive.bdds = transition_function_;
+        archive.bdds.push_back(final_states_);
+        archive.save(filename, var_mgr_);
+    }
+
+    SymbolicStateDfa SymbolicStateDfa::load(std::shared_ptr<VarMgr> var_mgr, const std::string &filename) {
+        BddArchive archive = BddArchive::load(filename, var_mgr);
+        std::size_t bit_count = var_mgr->state_variable_count(archive.automaton_id);
+        if (archive.kind != "symbolic-dfa" || archive.values.size() != bit_count ||
+            archive.bdds.size() != bit_count + 1) {
+            throw std::runtime_error("Not a symbolic DFA: " + filename);
+        }
+
+        SymbolicStateDfa dfa(var_mgr);
+        dfa.automaton_id_ = archive.automaton_id;
+        dfa.initial_state_ = std::move(archive.values);
+        dfa.final_states_ = archive.bdds.back();
+        archive.bdds.pop_back();
+        dfa.transition_function_ = std::move(archive.bdds);
+        return dfa;
+    }
+
     SymbolicStateDfa SymbolicStateDfa::from_predicates(
             std::shared_ptr<VarMgr> var_mgr,
             std::vector<CUDD::BDD> predicates) {
@@ -375,30 +1198,55 @@ namespace Syft {
         return clone;
     }
 
-    SymbolicStateDfa SymbolicStateDfa::product_AND(const std::vector<SymbolicStateDfa> &dfa_vector) {
+    template <typename DfaVector>
+    SymbolicStateDfa SymbolicStateDfa::product(DfaVector &&dfa_vector, bool conjunction, bool merge_sinks) {
         if (dfa_vector.size() < 1) {
-            throw std::runtime_error("Incorrect usage of automata product");
+            throw std::runtime_error(conjunction ? "Incorrect usage of automata product"
+                                                 : "Incorrect usage of automata union");
         }
+        constexpr bool owned = !std::is_lvalue_reference_v<DfaVector>;
 
         std::shared_ptr<VarMgr> var_mgr = dfa_vector[0].var_mgr();
 
         std::vector<std::size_t> automaton_ids;
+        automaton_ids.reserve(dfa_vector.size());
 
         std::vector<int> initial_state;
 
-        CUDD::BDD final_states = var_mgr->cudd_mgr()->bddOne();
+        CUDD::BDD final_states = conjunction ? var_mgr->cudd_mgr()->bddOne() : var_mgr->cudd_mgr()->bddZero();
         std::vector<CUDD::BDD> transition_function;
+        std::size_t bit_count = 0;
+        for (const SymbolicStateDfa &dfa: dfa_vector) {
+            bit_count += dfa.transition_function_.size();
+        }
+        transition_function.reserve(bit_count);
 
-        for (SymbolicStateDfa dfa: dfa_vector) {
-            automaton_ids.push_back(dfa.automaton_id());
+        // The sinks are found through the transition functions of the DFAs, so before they are moved
+        CUDD::BDD sinks = var_mgr->cudd_mgr()->bddZero();
+        if (merge_sinks) {
+            for (const SymbolicStateDfa &dfa: dfa_vector) {
+                sinks |= conjunction ? dfa.rejecting_sink_states() : dfa.accepting_sink_states();
+            }
+        }
 
-            std::vector<int> dfa_initial_state = dfa.initial_state();
-            initial_state.insert(initial_state.end(), dfa_initial_state.begin(), dfa_initial_state.end());
+        for (auto &dfa: dfa_vector) {
+            automaton_ids.push_back(dfa.automaton_id());
+            initial_state.insert(initial_state.end(), dfa.initial_state_.begin(), dfa.initial_state_.end());
 
-            final_states = final_states & dfa.final_states();
-            std::vector<CUDD::BDD> dfa_transition_function = dfa.transition_function();
-            transition_function.insert(transition_function.end(), dfa_transition_function.begin(),
-                                       dfa_transition_function.end());
+            if (conjunction) {
+                final_states &= dfa.final_states_;
+            } else {
+                final_states |= dfa.final_states_;
+            }
+            if constexpr (owned) {
+                std::move(dfa.transition_function_.begin(), dfa.transition_function_.end(),
+                          std::back_inserter(transition_function));
+                dfa.transition_function_.clear();
+                dfa.reachable_states_.reset();
+            } else {
+                transition_function.insert(transition_function.end(), dfa.transition_function_.begin(),
+                                           dfa.transition_function_.end());
+            }
         }
 
         std::size_t product_automaton_id = var_mgr->create_product_state_space(automaton_ids);
@@ -408,11 +1256,32 @@ namespace Syft {
         product_automaton.initial_state_ = std::move(initial_state);
         product_automaton.final_states_ = std::move(final_states);
         product_automaton.transition_function_ = std::move(transition_function);
+        for (const SymbolicStateDfa &dfa: dfa_vector) {
+            if (dfa.care_states_) {
+                product_automaton.care_states_ = product_automaton.care_states() & *dfa.care_states_;
+            }
+        }
+
+        if (merge_sinks) {
+            // The product is rejecting (accepting for OR) for good as soon as one DFA is
+            product_automaton.merge_states(sinks);
+        }
 
         return product_automaton;
     }
 
+    SymbolicStateDfa SymbolicStateDfa::product_AND(const std::vector<SymbolicStateDfa> &dfa_vector,
+                                                   bool merge_sinks) {
+        return product(dfa_vector, true, merge_sinks);
+    }
+
+    SymbolicStateDfa SymbolicStateDfa::product_AND(std::vector<SymbolicStateDfa> &&dfa_vector,
+                                                   bool merge_sinks) {
+        return product(std::move(dfa_vector), true, merge_sinks);
+    }
+
     void SymbolicStateDfa::new_sink_states(const CUDD::BDD &states) {
+        reachable_states_.reset();
         int i = 0;
         while (i < transition_function_.size()) {
             CUDD::BDD bit_function = transition_function_[i];
@@ -424,45 +1293,18 @@ namespace Syft {
         }
     }
 
-    SymbolicStateDfa SymbolicStateDfa::product_OR(const std::vector<SymbolicStateDfa> &dfa_vector) {
-        if (dfa_vector.size() < 1) {
-            throw std::runtime_error("Incorrect usage of automata union");
-        }
-
-        std::shared_ptr<VarMgr> var_mgr = dfa_vector[0].var_mgr();
-
-        std::vector<std::size_t> automaton_ids;
-
-        std::vector<int> initial_state;
-
-        CUDD::BDD final_states = var_mgr->cudd_mgr()->bddZero();
-        std::vector<CUDD::BDD> transition_function;
-
-        for (SymbolicStateDfa dfa: dfa_vector) {
-            automaton_ids.push_back(dfa.automaton_id());
-
-            std::vector<int> dfa_initial_state = dfa.initial_state();
-            initial_state.insert(initial_state.end(), dfa_initial_state.begin(), dfa_initial_state.end());
-
-            final_states = final_states | dfa.final_states();
-            std::vector<CUDD::BDD> dfa_transition_function = dfa.transition_function();
-            transition_function.insert(transition_function.end(), dfa_transition_function.begin(),
-                                       dfa_transition_function.end());
-        }
-
-        std::size_t union_automaton_id = var_mgr->create_product_state_space(automaton_ids);
-
-        SymbolicStateDfa product_automaton(var_mgr);
-        product_automaton.automaton_id_ = union_automaton_id;
-        product_automaton.initial_state_ = std::move(initial_state);
-        product_automaton.final_states_ = std::move(final_states);
-        product_automaton.transition_function_ = std::move(transition_function);
+    SymbolicStateDfa SymbolicStateDfa::product_OR(const std::vector<SymbolicStateDfa> &dfa_vector,
+                                                  bool merge_sinks) {
+        return product(dfa_vector, false, merge_sinks);
+    }
 
-        return product_automaton;
+    SymbolicStateDfa SymbolicStateDfa::product_OR(std::vector<SymbolicStateDfa> &&dfa_vector,
+                                                  bool merge_sinks) {
+        return product(std::move(dfa_vector), false, merge_sinks);
     }
 
 
-    SymbolicStateDfa SymbolicStateDfa::complement(const SymbolicStateDfa dfa) {
+    SymbolicStateDfa SymbolicStateDfa::complement(SymbolicStateDfa dfa) {
         std::shared_ptr<VarMgr> var_mgr = dfa.var_mgr();
 
         std::size_t complement_automaton_id = var_mgr->create_complement_state_space(dfa.automaton_id());
@@ -475,7 +1317,7 @@ namespace Syft {
         SymbolicStateDfa complement_automaton(std::move(var_mgr));
         complement_automaton.automaton_id_ = complement_automaton_id;
         complement_automaton.initial_state_ = std::move(initial_state);
-        complement_automaton.transition_function_ = std::move(dfa.transition_function());
+        complement_automaton.transition_function_ = std::move(dfa.transition_function_);
         complement_automaton.final_states_ = std::move(final_states);
 
         return complement_automaton;
@@ -483,7 +1325,15 @@ namespace Syft {
 
     SymbolicStateDfa SymbolicStateDfa::dfa_of_ppltl_formula(
         const whitemech::lydia::PPLTLFormula& formula,
-        std::shared_ptr<VarMgr> mgr) {
+        std::shared_ptr<VarMgr> mgr,
+        std::shared_ptr<PPLTLValuationTable> valuations,
+        PPLTLVariableOrder order) {
+        if (valuations && valuations->var_mgr() != mgr) {
+            throw std::runtime_error("PPLTL valuation table of another variable manager");
+        }
+        auto valuation = [&](const whitemech::lydia::PPLTLFormula& f) {
+            return valuations ? valuations->val(f) : val(f, mgr);
+        };
         
         // std::shared_ptr<VarMgr> mgr = std::make_shared<VarMgr>();
 
@@ -514,6 +1364,7 @@ namespace Syft {
         for (const auto& a : wy_sub) str_sub.push_back(p.apply(*a));
         auto val_str = "VAL"+std::to_string(mgr->automaton_num());
         str_sub.push_back(val_str);
+        int first_new_index = mgr->cudd_mgr()->ReadSize();
         auto dfa_id = mgr->create_named_state_variables(str_sub);
 
         // transition function and initial state
@@ -529,7 +1380,7 @@ namespace Syft {
         for (const auto& f : y_sub) {
             auto ya = std::static_pointer_cast<const whitemech::lydia::PPLTLYesterday>(f);
             auto arg = ya->get_arg();
-            auto bdd = val(*arg, mgr);
+            auto bdd = valuation(*arg);
             transition_function.push_back(bdd);
             init_state.push_back(0);
         }
@@ -537,14 +1388,18 @@ namespace Syft {
         for (const auto& f : wy_sub) {
             auto wya = std::static_pointer_cast<const whitemech::lydia::PPLTLWeakYesterday>(f);
             auto arg = wya->get_arg();
-            auto bdd = val(*arg, mgr);
+            auto bdd = valuation(*arg);
             transition_function.push_back(bdd);
             init_state.push_back(1);
         }
         // final state var
-        transition_function.push_back(val(*ynf, mgr));
+        transition_function.push_back(valuation(*ynf));
         init_state.push_back(0);
 
+        if (order == PPLTLVariableOrder::Dependency) {
+            order_by_dependency(mgr, mgr->get_state_variables(dfa_id), transition_function, first_new_index);
+        }
+
         // final states
         CUDD::BDD final_states = mgr->name_to_variable(val_str);
 
@@ -628,8 +1483,16 @@ namespace Syft {
 
     SymbolicStateDfa SymbolicStateDfa::dfa_of_ppltl_formula_remove_initial_self_loops(
         const whitemech::lydia::PPLTLFormula& formula,
-        std::shared_ptr<VarMgr> mgr
+        std::shared_ptr<VarMgr> mgr,
+        std::shared_ptr<PPLTLValuationTable> valuations,
+        PPLTLVariableOrder order
     )  {
+        if (valuations && valuations->var_mgr() != mgr) {
+            throw std::runtime_error("PPLTL valuation table of another variable manager");
+        }
+        auto valuation = [&](const whitemech::lydia::PPLTLFormula& f) {
+            return valuations ? valuations->val(f) : val(f, mgr);
+        };
         whitemech::lydia::StrPrinter p;
 
         // get NNF
@@ -662,6 +1525,7 @@ namespace Syft {
         auto nli_str = "NLI"+std::to_string(mgr->automaton_num());
         str_sub.push_back(nli_str);
 
+        int first_new_index = mgr->cudd_mgr()->ReadSize();
         auto dfa_id = mgr->create_named_state_variables(str_sub);
 
         // transition function and initial state
@@ -677,7 +1541,7 @@ namespace Syft {
         for (const auto& f : y_sub) {
             auto ya = std::static_pointer_cast<const whitemech::lydia::PPLTLYesterday>(f);
             auto arg = ya->get_arg();
-            auto bdd = val(*arg, mgr);
+            auto bdd = valuation(*arg);
             transition_function.push_back(bdd);
             init_state.push_back(0);
         }
@@ -685,17 +1549,21 @@ namespace Syft {
         for (const auto& f : wy_sub) {
             auto wya = std::static_pointer_cast<const whitemech::lydia::PPLTLWeakYesterday>(f);
             auto arg = wya->get_arg();
-            auto bdd = val(*arg, mgr);
+            auto bdd = valuation(*arg);
             transition_function.push_back(bdd);
             init_state.push_back(1);
         }
         // final state var
-        transition_function.push_back(val(*ynf, mgr));
+        transition_function.push_back(valuation(*ynf));
         init_state.push_back(0);
         // no loop initial state var
         transition_function.push_back(mgr->cudd_mgr()->bddZero());
         init_state.push_back(1);
 
+        if (order == PPLTLVariableOrder::Dependency) {
+            order_by_dependency(mgr, mgr->get_state_variables(dfa_id), transition_function, first_new_index);
+        }
+
         // final states
         CUDD::BDD final_states = mgr->name_to_variable(val_str) + mgr->name_to_variable(nli_str);
 
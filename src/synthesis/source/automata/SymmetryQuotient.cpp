@@ -0,0 +1,181 @@
+#include "automata/SymmetryQuotient.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <spdlog/spdlog.h>
+
+namespace Syft {
+
+    namespace {
+        // Whether code a is below code b, the first bits being the most significant
+        CUDD::BDD code_less(const std::vector<CUDD::BDD> &a, const std::vector<CUDD::BDD> &b, const CUDD::Cudd &mgr) {
+            CUDD::BDD less = mgr.bddZero();
+            CUDD::BDD equal = mgr.bddOne();
+            for (std::size_t i = 0; i < a.size(); ++i) {
+                less |= equal & !a[i] & b[i];
+                equal &= a[i].Xnor(b[i]);
+            }
+            return less;
+        }
+
+        // Sorts codes into nondecreasing order, by odd-even transposition of neighbours
+        void sort_codes(std::vector<std::vector<CUDD::BDD>> &codes, const CUDD::Cudd &mgr) {
+            std::size_t n = codes.size();
+            for (std::size_t round = 0; round < n; ++round) {
+                for (std::size_t i = round % 2; i + 1 < n; i += 2) {
+                    CUDD::BDD swap = code_less(codes[i + 1], codes[i], mgr);
+                    for (std::size_t bit = 0; bit < codes[i].size(); ++bit) {
+                        CUDD::BDD low = swap.Ite(codes[i + 1][bit], codes[i][bit]);
+                        CUDD::BDD high = swap.Ite(codes[i][bit], codes[i + 1][bit]);
+                        codes[i][bit] = std::move(low);
+                        codes[i + 1][bit] = std::move(high);
+                    }
+                }
+            }
+        }
+    }
+
+    SymmetryQuotient::SymmetryQuotient(std::vector<SymbolicStateDfa> components,
+                                       const std::vector<int> &component_colors,
+                                       const CUDD::BDD &final_states, std::vector<ColorOrbit> orbits)
+            : var_mgr_(components.at(0).var_mgr()), component_variables_(variables_of(components)),
+              arena_(SymbolicStateDfa::product_AND(std::move(components))) {
+        std::vector<std::size_t> offsets;
+        std::size_t offset = 0;
+        for (const std::vector<CUDD::BDD> &variables : component_variables_) {
+            offsets.push_back(offset);
+            offset += variables.size();
+        }
+        auto component_of = [&component_colors](int color) {
+            auto found = std::find(component_colors.begin(), component_colors.end(), color);
+            if (found == component_colors.end()) {
+                throw std::runtime_error("Error: Orbit of color " + std::to_string(color) + " without a component");
+            }
+            return static_cast<std::size_t>(found - component_colors.begin());
+        };
+
+        const CUDD::Cudd &mgr = *var_mgr_->cudd_mgr();
+        std::vector<CUDD::BDD> &transition_function = arena_.transition_function_;
+        canonical_states_ = mgr.bddOne();
+        for (const ColorOrbit &orbit : orbits) {
+            std::vector<std::size_t> members;
+            for (int color : orbit.colors) {
+                members.push_back(component_of(color));
+            }
+            std::size_t bits = component_variables_[members.front()].size();
+            std::vector<std::vector<CUDD::BDD>> next_codes;
+            std::vector<Member> orbit_members;
+            for (std::size_t k = 0; k < members.size(); ++k) {
+                const std::vector<CUDD::BDD> &variables = component_variables_[members[k]];
+                if (variables.size() != bits) {
+                    throw std::runtime_error("Error: Orbit of color " + std::to_string(orbit.colors.front()) +
+                                             " with codes of different widths");
+                }
+                auto first = transition_function.begin() + static_cast<std::ptrdiff_t>(offsets[members[k]]);
+                next_codes.emplace_back(first, first + static_cast<std::ptrdiff_t>(bits));
+
+                Member member;
+                for (const CUDD::BDD &variable : variables) {
+                    member.state_variables.push_back(static_cast<int>(variable.NodeReadIndex()));
+                }
+                for (const std::string &atom : orbit.atoms[k]) {
+                    member.atom_variables.push_back(static_cast<int>(var_mgr_->name_to_variable(atom).NodeReadIndex()));
+                }
+                orbit_members.push_back(std::move(member));
+
+                if (k > 0) {
+                    canonical_states_ &= !code_less(variables, component_variables_[members[k - 1]], mgr);
+                }
+            }
+
+            sort_codes(next_codes, mgr);
+            for (std::size_t k = 0; k < members.size(); ++k) {
+                std::move(next_codes[k].begin(), next_codes[k].end(),
+                          transition_function.begin() + static_cast<std::ptrdiff_t>(offsets[members[k]]));
+            }
+            orbit_members_.push_back(std::move(orbit_members));
+            spdlog::info("[SymmetryQuotient] quotienting the product by the {}! permutations of the orbit of color {}",
+                         members.size(), orbit.colors.front());
+        }
+
+        arena_.final_states_ = final_states;
+        arena_.care_states_ = arena_.care_states() & canonical_states_;
+        // No transition leaves the canonical states
+        arena_.simplify_transitions(canonical_states_);
+    }
+
+    std::vector<std::vector<CUDD::BDD>> SymmetryQuotient::variables_of(
+            const std::vector<SymbolicStateDfa> &components) {
+        std::vector<std::vector<CUDD::BDD>> variables;
+        variables.reserve(components.size());
+        for (const SymbolicStateDfa &component : components) {
+            variables.push_back(component.var_mgr()->get_state_variables(component.automaton_id()));
+        }
+        return variables;
+    }
+
+    const SymbolicStateDfa &SymmetryQuotient::arena() const {
+        return arena_;
+    }
+
+    const CUDD::BDD &SymmetryQuotient::canonical_states() const {
+        return canonical_states_;
+    }
+
+    std::vector<int> SymmetryQuotient::canonical_permutation(const std::vector<int> &assignment) const {
+        std::vector<int> permutation(assignment.size());
+        std::iota(permutation.begin(), permutation.end(), 0);
+        for (const std::vector<Member> &members : orbit_members_) {
+            std::vector<std::vector<int>> codes;
+            for (const Member &member : members) {
+                std::vector<int> code;
+                for (int variable : member.state_variables) {
+                    code.push_back(assignment.at(variable));
+                }
+                codes.push_back(std::move(code));
+            }
+            std::vector<std::size_t> order(members.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(order.begin(), order.end(), [&codes](std::size_t a, std::size_t b) {
+                return codes[a] < codes[b];
+            });
+
+            // The member with the p-th smallest code takes the place of member p
+            for (std::size_t p = 0; p < members.size(); ++p) {
+                const Member &from = members[order[p]];
+                const Member &to = members[p];
+                for (std::size_t bit = 0; bit < from.state_variables.size(); ++bit) {
+                    permutation[from.state_variables[bit]] = to.state_variables[bit];
+                }
+                for (std::size_t atom = 0; atom < from.atom_variables.size(); ++atom) {
+                    permutation[from.atom_variables[atom]] = to.atom_variables[atom];
+                }
+            }
+        }
+        return permutation;
+    }
+
+    std::vector<int> SymmetryQuotient::permute(const std::vector<int> &assignment,
+                                               const std::vector<int> &permutation) {
+        std::vector<int> permuted(assignment.size());
+        for (std::size_t i = 0; i < assignment.size(); ++i) {
+            permuted[permutation[i]] = assignment[i];
+        }
+        return permuted;
+    }
+
+    std::vector<int> SymmetryQuotient::lift_move(
+            const std::vector<int> &assignment,
+            const std::function<std::vector<int>(const std::vector<int> &)> &quotient_strategy) const {
+        std::vector<int> permutation = canonical_permutation(assignment);
+        std::vector<int> inverse(permutation.size());
+        for (std::size_t i = 0; i < permutation.size(); ++i) {
+            inverse[permutation[i]] = static_cast<int>(i);
+        }
+        return permute(quotient_strategy(permute(assignment, permutation)), inverse);
+    }
+
+}
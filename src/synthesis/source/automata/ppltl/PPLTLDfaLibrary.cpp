@@ -0,0 +1,156 @@
+#include "automata/ppltl/PPLTLDfaLibrary.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_set>
+#include <utility>
+
+#include "FlatJson.h"
+#include <lydia/parser/ppltl/driver.hpp>
+#include <lydia/utils/print.hpp>
+
+namespace Syft {
+
+    namespace {
+        whitemech::lydia::ppltl_ptr parse_ppltl(const std::string &text) {
+            whitemech::lydia::parsers::ppltl::PPLTLDriver driver;
+            std::stringstream stream(text);
+            driver.parse(stream);
+            auto parsed = driver.get_result();
+            if (!parsed) {
+                throw std::runtime_error("Error: Could not parse PPLTL formula: " + text);
+            }
+            return std::static_pointer_cast<const whitemech::lydia::PPLTLFormula>(parsed);
+        }
+    }
+
+    PPLTLDfaLibrary PPLTLDfaLibrary::compile(const std::vector<std::string> &formulas, const std::string &directory,
+                                             const std::shared_ptr<VarMgr> &var_mgr,
+                                             const InputOutputPartition *partition, PPLTLVariableOrder order) {
+        if (partition) {
+            std::vector<std::string> names = partition->input_variables;
+            names.insert(names.end(), partition->output_variables.begin(), partition->output_variables.end());
+            var_mgr->create_named_variables(names);
+        }
+
+        // The parsed formulas are kept alive while the valuation table may point into them
+        std::vector<whitemech::lydia::ppltl_ptr> parsed;
+        std::vector<std::string> keys;
+        std::vector<SymbolicStateDfa> dfas;
+        std::unordered_set<std::string> seen;
+        auto valuations = std::make_shared<PPLTLValuationTable>(var_mgr);
+        for (const std::string &text : formulas) {
+            whitemech::lydia::ppltl_ptr formula = parse_ppltl(text);
+            std::string key = whitemech::lydia::to_string(*formula);
+            if (!seen.insert(key).second) {
+                continue;
+            }
+            SymbolicStateDfa dfa = SymbolicStateDfa::dfa_of_ppltl_formula(*formula, var_mgr, valuations, order);
+            parsed.push_back(formula);
+            keys.push_back(std::move(key));
+            dfas.push_back(std::move(dfa));
+        }
+
+        // The archives record the variables by side of the partition
+        std::unordered_set<unsigned int> state_indices;
+        for (std::size_t id = 0; id < var_mgr->automaton_num(); ++id) {
+            for (const CUDD::BDD &variable : var_mgr->get_state_variables(id)) {
+                state_indices.insert(variable.NodeReadIndex());
+            }
+        }
+        std::vector<std::string> alphabet;
+        for (std::size_t index = 0; index < var_mgr->total_variable_count(); ++index) {
+            if (state_indices.count(static_cast<unsigned int>(index)) == 0) {
+                alphabet.push_back(var_mgr->index_to_name(static_cast<int>(index)));
+            }
+        }
+        if (partition) {
+            for (const std::string &name : alphabet) {
+                if (std::find(partition->input_variables.begin(), partition->input_variables.end(), name) ==
+                        partition->input_variables.end() &&
+                    std::find(partition->output_variables.begin(), partition->output_variables.end(), name) ==
+                        partition->output_variables.end()) {
+                    throw std::runtime_error("Error: Variable " + name + " of the formulas is not in the partition");
+                }
+            }
+            var_mgr->partition_variables(partition->input_variables, partition->output_variables);
+        } else {
+            var_mgr->partition_variables(alphabet, {});
+        }
+
+        std::filesystem::path base(directory);
+        std::filesystem::create_directories(base);
+        std::ofstream manifest(base / "manifest.jsonl");
+        if (!manifest.is_open()) {
+            throw std::runtime_error("Error: Could not write DFA manifest: " + (base / "manifest.jsonl").string());
+        }
+        PPLTLDfaLibrary library;
+        for (std::size_t i = 0; i < dfas.size(); ++i) {
+            std::string file = "dfa-" + std::to_string(i) + ".sdfa";
+            dfas[i].save((base / file).string());
+            manifest << "{\"formula\": " << json_quote(keys[i]) << ", \"dfa\": " << json_quote(file) << "}\n";
+            library.add(*parsed[i], (base / file).string());
+        }
+        manifest.close();
+        if (!manifest) {
+            throw std::runtime_error("Error: Could not write DFA manifest: " + (base / "manifest.jsonl").string());
+        }
+        return library;
+    }
+
+    PPLTLDfaLibrary PPLTLDfaLibrary::read_manifest(const std::string &path) {
+        std::ifstream in(path);
+        if (!in.is_open()) {
+            throw std::runtime_error("Error: Could not open DFA manifest: " + path);
+        }
+        std::filesystem::path base = std::filesystem::path(path).parent_path();
+        PPLTLDfaLibrary library;
+        std::string line;
+        for (std::size_t line_number = 1; std::getline(in, line); ++line_number) {
+            if (line.find_first_not_of(" \t\r") == std::string::npos) {
+                continue;
+            }
+            JsonObject object = parse_json_object(line, line_number);
+            const JsonValue *formula = json_field(object, "formula", JsonValue::Kind::String, line_number);
+            const JsonValue *dfa = json_field(object, "dfa", JsonValue::Kind::String, line_number);
+            if (formula == nullptr || dfa == nullptr) {
+                throw std::runtime_error("Error: Line " + std::to_string(line_number) + " of " + path +
+                                         ": a DFA needs a formula and a file");
+            }
+            whitemech::lydia::ppltl_ptr parsed = parse_ppltl(formula->text);
+            if (library.find(*parsed)) {
+                throw std::runtime_error("Error: Line " + std::to_string(line_number) + " of " + path +
+                                         ": the formula already has a DFA: " + formula->text);
+            }
+            std::filesystem::path file(dfa->text);
+            library.add(*parsed, (file.is_absolute() ? file : base / file).string());
+        }
+        return library;
+    }
+
+    void PPLTLDfaLibrary::add(const whitemech::lydia::PPLTLFormula &formula, std::string file) {
+        files_[whitemech::lydia::to_string(formula)] = std::move(file);
+    }
+
+    std::optional<std::string> PPLTLDfaLibrary::find(const whitemech::lydia::PPLTLFormula &formula) const {
+        auto entry = files_.find(whitemech::lydia::to_string(formula));
+        if (entry == files_.end()) {
+            return std::nullopt;
+        }
+        return entry->second;
+    }
+
+    SymbolicStateDfa PPLTLDfaLibrary::dfa_of(const whitemech::lydia::PPLTLFormula &formula,
+                                             std::shared_ptr<VarMgr> var_mgr,
+                                             std::shared_ptr<PPLTLValuationTable> valuations,
+                                             PPLTLVariableOrder order) const {
+        if (std::optional<std::string> file = find(formula)) {
+            return SymbolicStateDfa::load(std::move(var_mgr), *file);
+        }
+        return SymbolicStateDfa::dfa_of_ppltl_formula(formula, std::move(var_mgr), std::move(valuations), order);
+    }
+
+}
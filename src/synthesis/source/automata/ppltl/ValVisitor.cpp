@@ -102,7 +102,16 @@ namespace Syft {
     }
 
     CUDD::BDD ValVisitor::apply(const PPLTLFormula& x) {
+        auto it = memo_.find(&x);
+        if (it != memo_.end()) {
+            return it->second;
+        }
         x.accept(*this);
+        // The Yesterday nodes built while unfolding Since, Once, Historically
+        // and Triggered are temporaries whose address may be reused
+        if (!whitemech::lydia::is_a<PPLTLYesterday>(x) && !whitemech::lydia::is_a<PPLTLWeakYesterday>(x)) {
+            memo_.emplace(&x, result);
+        }
         return result;
     }
 
@@ -110,4 +119,30 @@ namespace Syft {
         ValVisitor v(mgr);
         return v.apply(x);
     }
+
+    PPLTLValuationTable::PPLTLValuationTable(std::shared_ptr<VarMgr> mgr) : mgr_(std::move(mgr)) {}
+
+    CUDD::BDD PPLTLValuationTable::val(const PPLTLFormula& x) {
+        std::string key = p_.apply(x);
+        auto it = valuations_.find(key);
+        if (it != valuations_.end()) {
+            ++hits_;
+            return it->second;
+        }
+        CUDD::BDD r = Syft::val(x, mgr_);
+        valuations_.emplace(std::move(key), r);
+        return r;
+    }
+
+    std::shared_ptr<VarMgr> PPLTLValuationTable::var_mgr() const {
+        return mgr_;
+    }
+
+    std::size_t PPLTLValuationTable::size() const {
+        return valuations_.size();
+    }
+
+    std::size_t PPLTLValuationTable::hits() const {
+        return hits_;
+    }
 }
\ No newline at end of file
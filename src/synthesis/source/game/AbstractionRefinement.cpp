@@ -0,0 +1,211 @@
+#include "game/AbstractionRefinement.h"
+
+#include "game/EmersonLei.hpp"
+#include "strategy.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <spdlog/spdlog.h>
+
+namespace Syft {
+
+    AbstractionRefinement::AbstractionRefinement(const SymbolicStateDfa &arena,
+                                                 std::vector<std::vector<CUDD::BDD>> components,
+                                                 AbstractionRefinementOptions options)
+            : var_mgr_(arena.var_mgr()),
+              state_bits_(arena.transition_function().size()),
+              components_(components.empty() ? state_bit_components(arena) : std::move(components)),
+              options_(std::move(options)) {
+        for (std::size_t component : options_.hidden_components) {
+            if (component >= components_.size()) {
+                throw std::runtime_error("Error: Hidden component " + std::to_string(component) + " of an arena of " +
+                                         std::to_string(components_.size()) + " components");
+            }
+        }
+    }
+
+    std::vector<std::vector<CUDD::BDD>> AbstractionRefinement::state_bit_components(const SymbolicStateDfa &arena) {
+        std::vector<CUDD::BDD> variables = arena.var_mgr()->get_state_variables(arena.automaton_id());
+        std::vector<int> bit_of(arena.var_mgr()->total_variable_count(), -1);
+        for (std::size_t i = 0; i < variables.size(); ++i) {
+            bit_of[variables[i].NodeReadIndex()] = static_cast<int>(i);
+        }
+
+        // Union-find over the bits, joining each bit with the state bits its function reads
+        std::vector<std::size_t> parent(variables.size());
+        std::iota(parent.begin(), parent.end(), 0);
+        auto find = [&parent](std::size_t bit) {
+            while (parent[bit] != bit) {
+                bit = parent[bit] = parent[parent[bit]];
+            }
+            return bit;
+        };
+        for (std::size_t i = 0; i < variables.size(); ++i) {
+            for (unsigned int index : arena.transition_bit(i).SupportIndices()) {
+                if (index < bit_of.size() && bit_of[index] >= 0) {
+                    parent[find(static_cast<std::size_t>(bit_of[index]))] = find(i);
+                }
+            }
+        }
+
+        std::vector<std::vector<CUDD::BDD>> components;
+        std::vector<int> component_of(variables.size(), -1);
+        for (std::size_t i = 0; i < variables.size(); ++i) {
+            std::size_t root = find(i);
+            if (component_of[root] < 0) {
+                component_of[root] = static_cast<int>(components.size());
+                components.emplace_back();
+            }
+            components[component_of[root]].push_back(variables[i]);
+        }
+        return components;
+    }
+
+    std::vector<std::size_t> AbstractionRefinement::initial_hidden() const {
+        if (!options_.hidden_components.empty()) {
+            return options_.hidden_components;
+        }
+        // The largest components first, as they save the most
+        std::vector<std::size_t> order(components_.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b) {
+            return components_[a].size() > components_[b].size();
+        });
+        std::vector<std::size_t> hidden;
+        std::size_t visible_bits = state_bits_;
+        // One component stays visible, since hiding all of them leaves no game to solve
+        for (std::size_t component : order) {
+            if (visible_bits <= options_.max_visible_bits || hidden.size() + 1 >= components_.size()) {
+                break;
+            }
+            hidden.push_back(component);
+            visible_bits -= components_[component].size();
+        }
+        return hidden;
+    }
+
+    CUDD::BDD AbstractionRefinement::hidden_cube(const std::vector<std::size_t> &hidden) const {
+        CUDD::BDD cube = var_mgr_->cudd_mgr()->bddOne();
+        for (std::size_t component : hidden) {
+            for (const CUDD::BDD &variable : components_[component]) {
+                cube &= variable;
+            }
+        }
+        return cube;
+    }
+
+    std::vector<std::size_t> AbstractionRefinement::components_to_refine(const std::vector<std::size_t> &hidden,
+                                                                         const CUDD::BDD &under,
+                                                                         const CUDD::BDD &over) const {
+        // In the states won by the over- but not the under-approximation, the
+        // protagonist wins by picking the hidden bits of the components the
+        // over-approximation depends on
+        CUDD::BDD undecided = over & !under;
+        int bits = static_cast<int>(state_bits_);
+        std::vector<std::pair<double, std::size_t>> scores;
+        for (std::size_t component : hidden) {
+            CUDD::BDD cube = hidden_cube({component});
+            CUDD::BDD depends = over.ExistAbstract(cube) & !over.UnivAbstract(cube);
+            scores.emplace_back((depends & undecided.ExistAbstract(cube)).CountMinterm(bits), component);
+        }
+        std::stable_sort(scores.begin(), scores.end(), [this](const auto &a, const auto &b) {
+            if (a.first != b.first) {
+                return a.first > b.first;
+            }
+            // Without evidence, the cheapest components first
+            return components_[a.second].size() < components_[b.second].size();
+        });
+
+        std::vector<std::size_t> refined;
+        std::size_t count = std::max<std::size_t>(1, options_.refine_per_round);
+        for (std::size_t i = 0; i < scores.size() && refined.size() < count; ++i) {
+            refined.push_back(scores[i].second);
+        }
+        return refined;
+    }
+
+    AbstractionRefinementResult AbstractionRefinement::run(const InnerSolver &solve) const {
+        AbstractionRefinementResult result;
+        result.hidden_components = initial_hidden();
+        while (true) {
+            result.rounds++;
+            std::vector<std::size_t> &hidden = result.hidden_components;
+            if (hidden.empty()) {
+                spdlog::info("[AbstractionRefinement] round {}: solving the arena", result.rounds);
+                SynthesisResult exact = solve(std::nullopt);
+                result.realizability = exact.realizability;
+                result.winning_states = exact.winning_states;
+                result.possibly_winning_states = exact.winning_states;
+                break;
+            }
+
+            StateAbstraction abstraction{hidden_cube(hidden), HiddenChooser::Opponent};
+            spdlog::info("[AbstractionRefinement] round {}: {} of {} state bits hidden in {} components",
+                         result.rounds, abstraction.hidden_cube.SupportSize(), state_bits_, hidden.size());
+            SynthesisResult under = solve(abstraction);
+            result.winning_states = under.winning_states;
+            if (under.realizability) {
+                result.realizability = true;
+                result.possibly_winning_states = var_mgr_->cudd_mgr()->bddOne();
+                break;
+            }
+
+            abstraction.chooser = HiddenChooser::Protagonist;
+            SynthesisResult over = solve(abstraction);
+            result.possibly_winning_states = over.winning_states;
+            if (!over.realizability) {
+                result.realizability = false;
+                break;
+            }
+
+            std::vector<std::size_t> refined = components_to_refine(hidden, under.winning_states, over.winning_states);
+            spdlog::info("[AbstractionRefinement] round {} is inconclusive, making {} components visible",
+                         result.rounds, refined.size());
+            hidden.erase(std::remove_if(hidden.begin(), hidden.end(), [&refined](std::size_t component) {
+                return std::find(refined.begin(), refined.end(), component) != refined.end();
+            }), hidden.end());
+        }
+        spdlog::info("[AbstractionRefinement] realizability {} after {} rounds", result.realizability, result.rounds);
+        var_mgr_->record_size("abstraction_rounds", static_cast<double>(result.rounds));
+        return result;
+    }
+
+    AbstractionRefinement::InnerSolver AbstractionRefinement::emerson_lei(
+            const SymbolicStateDfa &arena, ColorFormula color_formula, Player starting_player,
+            Player protagonist_player, std::vector<CUDD::BDD> colors, CUDD::BDD state_space,
+            CUDD::BDD instant_winning, CUDD::BDD instant_losing) {
+        // The Zielonka tree only depends on the colors and the state space, so the rounds share it
+        auto z_tree = std::make_shared<std::shared_ptr<ZielonkaTree>>();
+        return [=](const std::optional<StateAbstraction> &abstraction) {
+            EmersonLei solver(arena, color_formula, starting_player, protagonist_player, colors, state_space,
+                              instant_winning, instant_losing, false, *z_tree);
+            solver.set_state_abstraction(abstraction);
+            solver.set_release_winning_moves(true);
+            // Strategies of an abstraction are no strategies of the arena
+            solver.set_realizability_only(abstraction.has_value() && STRATEGY);
+            ELSynthesisResult el_result = solver.run_EL();
+            *z_tree = solver.zielonka_tree();
+
+            SynthesisResult result;
+            result.realizability = el_result.realizability;
+            result.winning_states = el_result.winning_states;
+            return result;
+        };
+    }
+
+    AbstractionRefinement::InnerSolver AbstractionRefinement::buchi(
+            const SymbolicStateDfa &arena, Player starting_player, Player protagonist_player,
+            CUDD::BDD state_space, BuchiSolver::BuchiMode mode) {
+        return [=](const std::optional<StateAbstraction> &abstraction) {
+            BuchiSolver::BuchiMode round_mode =
+                abstraction && mode == BuchiSolver::BuchiMode::LAYERED ? BuchiSolver::BuchiMode::CLASSIC : mode;
+            BuchiSolver solver(arena, starting_player, protagonist_player, state_space, round_mode);
+            solver.set_state_abstraction(abstraction);
+            return solver.run();
+        };
+    }
+
+}
@@ -0,0 +1,105 @@
+#include "game/AcceptanceClass.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace Syft {
+
+namespace {
+  std::size_t height(const ZielonkaNode *node) {
+    std::size_t children_height = 0;
+    for (const ZielonkaNode *child : node->children) {
+      children_height = std::max(children_height, height(child));
+    }
+    return children_height + 1;
+  }
+
+  bool is_chain(const ZielonkaNode *node) {
+    while (node->children.size() == 1) {
+      node = node->children[0];
+    }
+    return node->children.empty();
+  }
+}
+
+AcceptanceClass classify_acceptance(const ZielonkaNode *root) {
+  std::size_t tree_height = height(root);
+  if (tree_height == 1) {
+    return root->winning ? AcceptanceClass::Safety : AcceptanceClass::Reachability;
+  }
+  if (tree_height == 2) {
+    if (root->children.size() == 1) {
+      return root->winning ? AcceptanceClass::Buchi : AcceptanceClass::CoBuchi;
+    }
+    return root->winning ? AcceptanceClass::GeneralizedBuchi : AcceptanceClass::GeneralizedCoBuchi;
+  }
+  if (is_chain(root)) {
+    return AcceptanceClass::ParityChain;
+  }
+  if (tree_height == 3 && root->winning) {
+    return AcceptanceClass::GR1Like;
+  }
+  return AcceptanceClass::General;
+}
+
+AcceptanceClass classify_acceptance(ZielonkaTree &tree) {
+  // The class only tells heights one to three from deeper trees, so the nodes below the third level are not needed
+  ZielonkaNode *root = tree.get_root();
+  std::vector<ZielonkaNode*> level{root};
+  for (std::size_t depth = 0; depth < 3 && !level.empty(); ++depth) {
+    std::vector<ZielonkaNode*> next;
+    for (ZielonkaNode *node : level) {
+      const std::vector<ZielonkaNode*> &children = tree.children(node);
+      next.insert(next.end(), children.begin(), children.end());
+    }
+    level = std::move(next);
+  }
+  // And the chain of only children that is_chain follows
+  ZielonkaNode *node = root;
+  while (tree.children(node).size() == 1) {
+    node = node->children[0];
+  }
+  return classify_acceptance(static_cast<const ZielonkaNode*>(root));
+}
+
+bool is_two_level(AcceptanceClass acceptance) {
+  switch (acceptance) {
+    case AcceptanceClass::Reachability:
+    case AcceptanceClass::Safety:
+    case AcceptanceClass::Buchi:
+    case AcceptanceClass::CoBuchi:
+    case AcceptanceClass::GeneralizedBuchi:
+    case AcceptanceClass::GeneralizedCoBuchi:
+      return true;
+    default:
+      return false;
+  }
+}
+
+std::string to_string(AcceptanceClass acceptance) {
+  switch (acceptance) {
+    case AcceptanceClass::Reachability:
+      return "reachability";
+    case AcceptanceClass::Safety:
+      return "safety";
+    case AcceptanceClass::Buchi:
+      return "Buchi";
+    case AcceptanceClass::CoBuchi:
+      return "co-Buchi";
+    case AcceptanceClass::GeneralizedBuchi:
+      return "generalized Buchi";
+    case AcceptanceClass::GeneralizedCoBuchi:
+      return "generalized co-Buchi";
+    case AcceptanceClass::ParityChain:
+      return "parity chain";
+    case AcceptanceClass::GR1Like:
+      return "GR(1)-like";
+    case AcceptanceClass::General:
+      return "general Emerson-Lei";
+  }
+  return "general Emerson-Lei";
+}
+
+}
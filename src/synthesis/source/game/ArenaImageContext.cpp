@@ -0,0 +1,75 @@
+#include "game/ArenaImageContext.h"
+#include "VarMgr.h"
+
+namespace Syft {
+
+ArenaImageContext::ArenaImageContext(const SymbolicStateDfa& arena)
+    : arena_(arena)
+    , var_mgr_(arena.var_mgr())
+    , automaton_id_(arena.automaton_id())
+    , state_bits_(var_mgr_->state_variable_count(automaton_id_))
+    , transition_function_(arena.transition_function())
+    , state_variables_(var_mgr_->get_state_variables(automaton_id_))
+    , state_cube_(var_mgr_->state_variables_cube(automaton_id_))
+    , io_cube_(var_mgr_->input_cube() * var_mgr_->output_cube()) {}
+
+const std::vector<CUDD::BDD>& ArenaImageContext::ComposeVector() const {
+    if (compose_vector_.size() != var_mgr_->total_variable_count()) {
+        compose_vector_ = var_mgr_->make_compose_vector(automaton_id_, transition_function_);
+    }
+    return compose_vector_;
+}
+
+CUDD::BDD ArenaImageContext::Compose(const CUDD::BDD& states) const {
+    ++steps_;
+    return states.VectorCompose(ComposeVector());
+}
+
+CUDD::BDD ArenaImageContext::Image(const CUDD::BDD& states) const {
+    ++steps_;
+    return Relation().Image(states);
+}
+
+CUDD::BDD ArenaImageContext::Preimage(const CUDD::BDD& states) const {
+    return Compose(states).ExistAbstract(io_cube_);
+}
+
+CUDD::BDD ArenaImageContext::ToPrimed(const CUDD::BDD& states) const {
+    Relation();
+    return states.SwapVariables(unprimed_swap_, primed_swap_);
+}
+
+CUDD::BDD ArenaImageContext::SwapPrimed(const CUDD::BDD& relation) const {
+    Relation();
+    return relation.SwapVariables(unprimed_swap_, primed_swap_);
+}
+
+CUDD::BDD ArenaImageContext::PickState(const CUDD::BDD& states) const {
+    if (states.IsZero()) {
+        return states;
+    }
+    return states.PickOneMinterm(state_variables_);
+}
+
+const PartitionedTransitionRelation& ArenaImageContext::Relation() const {
+    if (!relation_) {
+        std::size_t primed_id = var_mgr_->create_state_variables(state_bits_);
+        relation_ = std::make_unique<PartitionedTransitionRelation>(arena_, primed_id);
+
+        // Canonical projection functions, so that SwapVariables never sees complemented nodes
+        auto mgr = var_mgr_->cudd_mgr();
+        for (const CUDD::BDD& var : state_variables_) {
+            unprimed_swap_.push_back(mgr->bddVar(var.NodeReadIndex()));
+        }
+        for (const CUDD::BDD& var : var_mgr_->get_state_variables(primed_id)) {
+            primed_swap_.push_back(mgr->bddVar(var.NodeReadIndex()));
+        }
+    }
+    return *relation_;
+}
+
+std::size_t ArenaImageContext::primed_automaton_id() const {
+    return Relation().primed_automaton_id();
+}
+
+} // namespace Syft
@@ -0,0 +1,77 @@
+#include "game/BddCircuit.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace Syft {
+
+BddCircuit::BddCircuit(std::shared_ptr<VarMgr> var_mgr)
+  : var_mgr_(std::move(var_mgr)), nodes_{Node{0, {false_node, false_node}}, Node{0, {true_node, true_node}}} {}
+
+std::uint32_t BddCircuit::add_slot(int index) {
+  auto slot = slot_of_.emplace(index, static_cast<std::uint32_t>(slot_of_.size()));
+  if (!slot.second) {
+    throw std::runtime_error("Error: Variable " + var_mgr_->index_to_name(index) + " already has a slot");
+  }
+  return slot.first->second;
+}
+
+std::uint32_t BddCircuit::slot(int index) const {
+  auto slot = slot_of_.find(index);
+  if (slot == slot_of_.end()) {
+    throw std::runtime_error("Error: No slot for variable " + var_mgr_->index_to_name(index));
+  }
+  return slot->second;
+}
+
+std::uint32_t BddCircuit::add(const CUDD::BDD& function) {
+  functions_.push_back(function);
+  return add(function.getNode(), false);
+}
+
+std::uint32_t BddCircuit::add(DdNode* node, bool complemented) {
+  DdNode* regular = Cudd_Regular(node);
+  complemented = complemented != static_cast<bool>(Cudd_IsComplement(node));
+  if (Cudd_IsConstant(regular)) {
+    return complemented ? false_node : true_node;
+  }
+  auto found = compiled_.find({regular, complemented});
+  if (found != compiled_.end()) {
+    return found->second;
+  }
+  std::uint32_t index_slot = slot(static_cast<int>(Cudd_NodeReadIndex(regular)));
+  std::uint32_t then_child = add(Cudd_T(regular), complemented);
+  std::uint32_t else_child = add(Cudd_E(regular), complemented);
+  nodes_.push_back(Node{index_slot, {else_child, then_child}});
+  std::uint32_t id = static_cast<std::uint32_t>(nodes_.size() - 1);
+  compiled_.emplace(std::make_pair(regular, complemented), id);
+  return id;
+}
+
+std::vector<std::uint32_t> BddCircuit::support(const CUDD::BDD& function) const {
+  std::vector<std::uint32_t> slots;
+  for (unsigned int index : function.SupportIndices()) {
+    slots.push_back(slot(static_cast<int>(index)));
+  }
+  std::sort(slots.begin(), slots.end());
+  return slots;
+}
+
+void BddCircuit::evaluate(const Node* nodes, std::size_t begin, std::size_t end, const std::uint64_t* values,
+                          std::size_t words, std::uint64_t* node_values) {
+  std::fill(node_values, node_values + words, std::uint64_t(0));
+  std::fill(node_values + words, node_values + 2 * words, ~std::uint64_t(0));
+  for (std::size_t id = std::max<std::size_t>(begin, 2); id < end; ++id) {
+    const Node& node = nodes[id];
+    const std::uint64_t* value = values + node.slot * words;
+    const std::uint64_t* then_value = node_values + node.child[1] * words;
+    const std::uint64_t* else_value = node_values + node.child[0] * words;
+    std::uint64_t* result = node_values + id * words;
+    for (std::size_t w = 0; w < words; ++w) {
+      result[w] = (value[w] & then_value[w]) | (~value[w] & else_value[w]);
+    }
+  }
+}
+
+}
@@ -18,59 +18,77 @@ namespace Syft {
         SynthesisResult result;
         CUDD::BDD winning_states = state_space_;
         CUDD::BDD winning_moves = winning_states;
-        int c = 0;
-        int inner_c = 0;
+        std::size_t state_bits = var_mgr_->state_variable_count(spec_.automaton_id());
+        bool frontier_mode = fixpoint_mode_ == FixpointMode::Frontier;
+        fixpoint_trace_ = FixpointTrace();
+        outer_iterations_ = 0;
+
+        // Preimages shared across iterations: (W | goal) and (Y | goal) composed with the transition function
+        CUDD::BDD transitions_to_goal = goal_states_.VectorCompose(transition_vector_);
+        CUDD::BDD transitions_to_winning_states_or_goal =
+                (winning_states | goal_states_).VectorCompose(transition_vector_);
+        // The inner fixpoint only shrinks as W does, so it stays within the previous one
+        CUDD::BDD previous_inner_winning_states = var_mgr_->cudd_mgr()->bddOne();
 
         while (true) {
-//            var_mgr_->dump_dot(winning_states.Add(), "winning_states_"+ std::to_string(c)+".dot");
-//            var_mgr_->dump_dot(winning_moves.Add(), "winning_moves_"+ std::to_string(c)+".dot");
+            var_mgr_->check_budget("fixpoint");
+            outer_iterations_++;
             CUDD::BDD new_winning_states, new_winning_moves;
             // inner least fixpoint
             CUDD::BDD inner_winning_states = state_space_ & goal_states_;
             CUDD::BDD inner_winning_moves = inner_winning_states;
+            CUDD::BDD transitions_to_inner_winning_states_or_goal = transitions_to_goal;
+            CUDD::BDD frontier = inner_winning_states;
+            bool first_inner_iteration = true;
 
             while (true) {
-//                var_mgr_->dump_dot(inner_winning_states.Add(), "inner_winning_states_"+ std::to_string(c)+".dot");
-//                var_mgr_->dump_dot(inner_winning_moves.Add(), "inner_winning_moves_"+ std::to_string(c)+".dot");
+                var_mgr_->check_budget("fixpoint");
                 CUDD::BDD new_inner_winning_states, new_inner_winning_moves;
 
-                CUDD::BDD transitions_to_winning_states_or_goal =
-                        (winning_states | goal_states_).VectorCompose(transition_vector_);
-//                    var_mgr_->dump_dot(transitions_to_winning_states_or_goal.Add(), "transitions_to_winning_states_or_goal.dot");
-                CUDD::BDD transitions_to_inner_winning_states_or_goal =
-                        (inner_winning_states | goal_states_).VectorCompose(transition_vector_);
-//                    var_mgr_->dump_dot(transitions_to_inner_winning_states_or_goal.Add(), "transitions_to_inner_winning_states_or_goal.dot");
-//                    var_mgr_->dump_dot(assumption_.Add(), "assumption.dot");
+                // The Buchi disjunct does not depend on Y, so after the first iteration
+                // only predecessors of the last added states can be added
+                CUDD::BDD candidates = !inner_winning_states;
+                if (frontier_mode) {
+                    candidates &= previous_inner_winning_states;
+                    if (!first_inner_iteration) {
+                        candidates &= predecessors(frontier);
+                    }
+                } else {
+                    transitions_to_inner_winning_states_or_goal =
+                            (inner_winning_states | goal_states_).VectorCompose(transition_vector_);
+                }
                 CUDD::BDD assumption_constrained_transitions =
                         ((Buchi_ | transitions_to_inner_winning_states_or_goal)) *
                         transitions_to_winning_states_or_goal;
-//                    var_mgr_->dump_dot(assumption_constrained_transitions.Add(), "assumption_constrained_transitions.dot");
+                if (frontier_mode) {
+                    assumption_constrained_transitions &= candidates;
+                }
                 if (starting_player_ == Player::Agent) {
                     // Quantify all variables that the outputs don't depend on
                     CUDD::BDD quantified_X_transitions_to_inner_winning_states = quantify_independent_variables_->apply(
                             assumption_constrained_transitions);
                     new_inner_winning_moves = inner_winning_moves | quantified_X_transitions_to_inner_winning_states;
 
-                    new_inner_winning_states = project_into_states(new_inner_winning_moves);
+                    new_inner_winning_states = frontier_mode
+                                               ? inner_winning_states |
+                                                 project_into_states(quantified_X_transitions_to_inner_winning_states)
+                                               : project_into_states(new_inner_winning_moves);
                 } else {
                     CUDD::BDD transitions_to_inner_winning_states = quantify_independent_variables_->apply(
                             assumption_constrained_transitions);
-//                        var_mgr_->dump_dot((quantify_independent_variables_->apply(assumption_constrained_transitions)).Add(), "quantified_assumption_constrained_transitions.dot");
                     CUDD::BDD new_collected_inner_winning_states = project_into_states(
                             transitions_to_inner_winning_states);
                     new_inner_winning_states = inner_winning_states | new_collected_inner_winning_states;
-//                        var_mgr_->dump_dot(new_inner_winning_states.Add(), "states.dot");
                     new_inner_winning_moves = inner_winning_moves |
                                               ((!inner_winning_states) & new_collected_inner_winning_states &
                                                transitions_to_inner_winning_states);
 
                 }
+                frontier = new_inner_winning_states & !inner_winning_states;
+                fixpoint_trace_.record(frontier, candidates, new_inner_winning_states, state_bits);
 
                 if (new_inner_winning_states == inner_winning_states) {
                     if (starting_player_ == Player::Agent) {
-//                        CUDD::BDD transitions_to_winning_states = preimage(inner_winning_states);
-//                        CUDD::BDD quantified_X_transitions_to_inner_winning_states = quantify_independent_variables_->apply(transitions_to_winning_states);
-//                        new_inner_winning_moves = inner_winning_moves & quantified_X_transitions_to_inner_winning_states;
                         new_winning_moves = winning_moves & inner_winning_moves;
                         new_winning_states = winning_states & inner_winning_states;
                     } else {
@@ -83,7 +101,10 @@ namespace Syft {
 
                 inner_winning_moves = new_inner_winning_moves;
                 inner_winning_states = new_inner_winning_states;
-                inner_c++;
+                if (frontier_mode) {
+                    transitions_to_inner_winning_states_or_goal |= frontier.VectorCompose(transition_vector_);
+                }
+                first_inner_iteration = false;
             }
 
 
@@ -102,11 +123,21 @@ namespace Syft {
                 return result;
             }
 
+            // W & Y | goal = (W | goal) & (Y | goal), and composition distributes over conjunction
+            if (frontier_mode) {
+                transitions_to_winning_states_or_goal &= transitions_to_inner_winning_states_or_goal;
+                previous_inner_winning_states = inner_winning_states;
+            } else {
+                transitions_to_winning_states_or_goal =
+                        (new_winning_states | goal_states_).VectorCompose(transition_vector_);
+            }
             winning_moves = new_winning_moves;
             winning_states = new_winning_states;
-            c++;
         }
     }
 
-}
+    std::size_t BuchiReachability::outer_iterations() const {
+        return outer_iterations_;
+    }
 
+}
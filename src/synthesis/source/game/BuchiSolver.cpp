@@ -1,6 +1,9 @@
 #include "game/BuchiSolver.hpp"
+#include "game/FixpointTelemetry.h"
 #include "automata/SymbolicStateDfa.h"
+#include "debug.hpp"
 #include <iostream>
+#include <stdexcept>
 #include <tuple>
 #include <spdlog/spdlog.h>
 
@@ -89,7 +92,7 @@ namespace Syft
         std::cout << "[BuchiSolver PRINT] final_states BDD = " << game_.final_states() << "\n";
 
         // print each transition function (bit-level) up to a reasonable number
-        auto tfs = game_.transition_function();
+        const auto &tfs = game_.transition_function();
         for (std::size_t i = 0; i < tfs.size(); ++i)
         {
             std::cout << "[BuchiSolver PRINT] transition bit " << i << " nodes=" << tfs[i].nodeCount()
@@ -117,41 +120,14 @@ namespace Syft
         input_cube_ = var_mgr_->input_cube();
         output_cube_ = var_mgr_->output_cube();
         output_count_ = var_mgr_->output_variable_count();
-        if (starting_player_ == Player::Environment)
-        {
-            if (protagonist_player_ == Player::Environment)
-            {
-                quantify_independent_variables_ = std::make_unique<Forall>(output_cube_);
-                quantify_non_state_variables_ = std::make_unique<Exists>(input_cube_);
-            }
-            else
-            {
-                quantify_independent_variables_ = std::make_unique<NoQuantification>();
-                quantify_non_state_variables_ = std::make_unique<ForallExists>(input_cube_,
-                                                                               output_cube_);
-            }
-        }
-        else
-        {
-            if (protagonist_player_ == Player::Environment)
-            {
-                quantify_independent_variables_ = std::make_unique<NoQuantification>();
-                quantify_non_state_variables_ = std::make_unique<ForallExists>(output_cube_,
-                                                                               input_cube_);
-            }
-            else
-            {
-                quantify_independent_variables_ = std::make_unique<Forall>(input_cube_);
-                quantify_non_state_variables_ = std::make_unique<Exists>(output_cube_);
-            }
-        }
+        kernel_ = GameKernel(starting_player_, protagonist_player_, input_cube_, output_cube_);
 
         // Dump information about starting and protagonist players
         if (debug_enabled_)
         {
-                spdlog::debug("[BuchiSolver INIT] starting_player={} protagonist_player={}",
-                              (starting_player_ == Player::Agent ? "Agent" : "Environment"),
-                              (protagonist_player_ == Player::Agent ? "Agent" : "Environment"));
+                SYFT_DEBUG_TRACE("[BuchiSolver INIT] starting_player={} protagonist_player={}",
+                                 (starting_player_ == Player::Agent ? "Agent" : "Environment"),
+                                 (protagonist_player_ == Player::Agent ? "Agent" : "Environment"));
 
             // print chosen Buchi mode
             std::string mode_str;
@@ -167,7 +143,7 @@ namespace Syft
                 mode_str = "CLASSIC";
                 break;
             }
-            spdlog::debug("[BuchiSolver INIT] mode={}", mode_str);
+            SYFT_DEBUG_TRACE("[BuchiSolver INIT] mode={}", mode_str);
         }
 
         // game_.dump_json("buchi_dfa.json");
@@ -179,45 +155,56 @@ namespace Syft
         return winning_states.Eval(tmp.data()).IsOne();
     }
 
-    CUDD::BDD BuchiSolver::CPre_agent(const CUDD::BDD &W_states) const
+    CUDD::BDD BuchiSolver::CPre(const CUDD::BDD &W_states) const
     {
         // Ensure we start from a pure-state target
         CUDD::BDD W = W_states & state_space_;
 
         // T(s,i,o) := next_state(s,i,o) ∈ W
         // This is a BDD over current STATE vars + IO vars (since we composed next-state bits).
-        CUDD::BDD T = W.VectorCompose(transition_compose_vector_);
-
-        // Step 1: Quantify independent variables (preimage)
-        CUDD::BDD moves = quantify_independent_variables_->apply(T);
-        // Step 2: Project into state space (eliminate IO vars)
-        CUDD::BDD pred = quantify_non_state_variables_->apply(moves);
-        // Step 3: Restrict to legal state space
-        return pred & state_space_;
+        const BddBackend &backend = var_mgr_->bdd_backend();
+        if (state_abstraction_)
+            W = state_abstraction_->target(W, backend);
+        CUDD::BDD T = backend.VectorCompose(W, transition_compose_vector_);
+
+        // Quantify the IO variables in the order of play, then restrict to legal state space
+        return kernel_.controllable(T, backend) & state_space_;
     }
 
-    CUDD::BDD BuchiSolver::CPre_env(const CUDD::BDD &W_states) const
+    CUDD::BDD BuchiSolver::CPre_care(const CUDD::BDD &W_states, const CUDD::BDD &care) const
     {
         CUDD::BDD W = W_states & state_space_;
-        CUDD::BDD T = W.VectorCompose(transition_compose_vector_);
-
-        // Step 1: Quantify independent variables (preimage)
-        CUDD::BDD moves = quantify_independent_variables_->apply(T);
-        // Step 2: Project into state space (eliminate IO vars)
-        CUDD::BDD pred = quantify_non_state_variables_->apply(moves);
-        // Step 3: Restrict to legal state space
-        return pred & state_space_;
-    }
-    CUDD::BDD BuchiSolver::computeCPreForPlayer(Player player, const CUDD::BDD &states) const
-    {
-        if (player == Player::Agent)
+        CUDD::BDD care_states = care & state_space_;
+
+        // Identity except on the state variables, whose next-state functions are
+        // simplified outside care; built locally to keep make_compose_vector's cache
+        std::size_t total_variable_count = var_mgr_->total_variable_count();
+        std::vector<CUDD::BDD> compose_vector;
+        compose_vector.reserve(total_variable_count);
+        for (std::size_t i = 0; i < total_variable_count; ++i)
         {
-            return CPre_agent(states);
+            compose_vector.push_back(var_mgr_->cudd_mgr()->bddVar(static_cast<int>(i)));
         }
-        else
+        auto state_vars = var_mgr_->get_state_variables(game_.automaton_id());
+        const auto &transition_function = game_.transition_function();
+        for (std::size_t i = 0; i < state_vars.size(); ++i)
         {
-            return CPre_env(states);
+            compose_vector[state_vars[i].NodeReadIndex()] = transition_function[i].Restrict(care_states);
         }
+
+        const BddBackend &backend = var_mgr_->bdd_backend();
+        if (state_abstraction_)
+            W = state_abstraction_->target(W, backend);
+        CUDD::BDD T = backend.VectorCompose(W, compose_vector);
+        return kernel_.controllable(T, backend) & care_states;
+    }
+
+    CUDD::BDD BuchiSolver::predecessors(const CUDD::BDD &states) const
+    {
+        CUDD::BDD T = state_abstraction_
+                      ? state_abstraction_->some_successor(states, var_mgr_->bdd_backend()).VectorCompose(transition_compose_vector_)
+                      : states.VectorCompose(transition_compose_vector_);
+        return T.ExistAbstract(input_cube_ * output_cube_) & state_space_;
     }
 
     // Alternating safety / reachability algorithm
@@ -232,75 +219,136 @@ namespace Syft
 
         // W = empty
         CUDD::BDD W = mgr->bddZero();
+        CUDD::BDD previous_reach = mgr->bddZero();
+        std::size_t state_bits = var_mgr_->state_variable_count(game_.automaton_id());
 
         int outer_iter = 0;
         while (true)
         {
+            var_mgr_->check_budget("fixpoint");
             outer_iter++;
 
             // Safety GFP: X, XX = BDD.one; iterate XX = (F || W) && Cpre(X)
             CUDD::BDD X = mgr->bddOne();
             CUDD::BDD XX = mgr->bddOne();
             int safety_iters = 0;
-            while (true)
+            FixpointTrace safety_trace;
+            if (warm_start_)
             {
-                safety_iters++;
-                XX = ((F | W) & computeCPreForPlayer(protagonist_player_, X)) & state_space_;
-                if (XX == X)
-                    break;
-                X = XX;
+                // W can force staying in W, so it is within the GFP: only the other
+                // states with a successor among the removed ones need re-checking
+                X = (F | W) & state_space_;
+                CUDD::BDD removed = !X;
+                while (true)
+                {
+                    var_mgr_->check_budget("fixpoint");
+                    safety_iters++;
+                    CUDD::BDD candidates = X & !W & predecessors(removed);
+                    XX = X & !(candidates & !CPre_care(X, candidates));
+                    removed = X & !XX;
+                    safety_trace.record(removed, candidates, XX, state_bits);
+                    if (XX == X)
+                        break;
+                    X = XX;
+                }
+            }
+            else
+            {
+                while (true)
+                {
+                    var_mgr_->check_budget("fixpoint");
+                    safety_iters++;
+                    XX = ((F | W) & CPre(X)) & state_space_;
+                    safety_trace.record(X & !XX, X, XX, state_bits);
+                    if (XX == X)
+                        break;
+                    X = XX;
+                }
             }
+            inner_traces_.push_back(std::move(safety_trace));
 
             if (debug_enabled_)
             {
-                spdlog::debug("[BuchiSolver Alternating] outer={} safety_iters={} X_nodes={}", outer_iter, safety_iters, X.nodeCount());
+                SYFT_DEBUG_TRACE("[BuchiSolver Alternating] outer={} safety_iters={} X_nodes={}", outer_iter, safety_iters, X.nodeCount());
                 //print_state_set(X, "X (after safety)");
             }
 
             if (W == X)
             {
                 if (debug_enabled_)
-                    spdlog::debug("[BuchiSolver Alternating] W==X, terminating at outer={}", outer_iter);
+                    SYFT_DEBUG_TRACE("[BuchiSolver Alternating] W==X, terminating at outer={}", outer_iter);
                 return W & state_space_;
             }
             else
             {
                 W = X & state_space_;
             }
+            // W only grows and is winning throughout
+            if (realizability_only_ && includes_initial_state(W))
+                return W;
 
             // Reachability LFP: Y, YY = BDD.zero; iterate YY = W || Cpre(Y)
             CUDD::BDD Y = mgr->bddZero();
             CUDD::BDD YY = mgr->bddZero();
             int reach_iters = 0;
-            while (true)
+            FixpointTrace reach_trace;
+            if (warm_start_)
             {
-                reach_iters++;
-                YY = (W | computeCPreForPlayer(protagonist_player_, Y)) & state_space_;
-                if (YY == Y)
-                    break;
-                Y = YY;
+                // States outside the last reachability result were not attracted
+                // to it, so only the states added since can attract new ones
+                Y = W;
+                CUDD::BDD frontier = W & !previous_reach;
+                while (true)
+                {
+                    var_mgr_->check_budget("fixpoint");
+                    reach_iters++;
+                    CUDD::BDD candidates = state_space_ & !Y & predecessors(frontier);
+                    YY = Y | CPre_care(Y, candidates);
+                    frontier = YY & !Y;
+                    reach_trace.record(frontier, candidates, YY, state_bits);
+                    if (YY == Y)
+                        break;
+                    Y = YY;
+                }
+                previous_reach = Y;
+            }
+            else
+            {
+                while (true)
+                {
+                    var_mgr_->check_budget("fixpoint");
+                    reach_iters++;
+                    YY = (W | CPre(Y)) & state_space_;
+                    reach_trace.record(YY & !Y, state_space_, YY, state_bits);
+                    if (YY == Y)
+                        break;
+                    Y = YY;
+                }
             }
+            inner_traces_.push_back(std::move(reach_trace));
 
             if (debug_enabled_)
             {
-                spdlog::debug("[BuchiSolver Alternating] outer={} reach_iters={} Y_nodes={}", outer_iter, reach_iters, Y.nodeCount());
+                SYFT_DEBUG_TRACE("[BuchiSolver Alternating] outer={} reach_iters={} Y_nodes={}", outer_iter, reach_iters, Y.nodeCount());
                 //print_state_set(Y, "Y (after reach)");
             }
 
             if (W == Y)
             {
                 if (debug_enabled_)
-                    spdlog::debug("[BuchiSolver Alternating] W==Y, terminating at outer={}", outer_iter);
+                    SYFT_DEBUG_TRACE("[BuchiSolver Alternating] W==Y, terminating at outer={}", outer_iter);
                 return W & state_space_;
             }
             else
             {
                 W = Y & state_space_;
             }
+            if (realizability_only_ && includes_initial_state(W))
+                return W;
         }
     }
 
-    bool BuchiSolver::DoubleFixpoint()
+    CUDD::BDD BuchiSolver::DoubleFixpoint()
     {
         // Compute nu X. mu Y. (F ∩ CPre_s(X)) ∪ CPre_s(Y)
         auto mgr = var_mgr_->cudd_mgr();
@@ -308,10 +356,13 @@ namespace Syft
         // Initialize X to the whole state space (greatest fixpoint start)
         CUDD::BDD X = mgr->bddOne();
         CUDD::BDD prevX = mgr->bddZero();
+        std::size_t state_bits = var_mgr_->state_variable_count(game_.automaton_id());
+        FixpointProbe outer_probe("buchi outer", "", state_bits);
 
         int outer_iter = 0;
         while (!(X == prevX))
         {
+            var_mgr_->check_budget("fixpoint");
             prevX = X;
             outer_iter++;
 
@@ -321,42 +372,199 @@ namespace Syft
             int inner_iter = 0;
 
             // Precompute the term F ∩ CPre_s(X) which is constant during inner loop
-            CUDD::BDD FcpreX = game_.final_states() & computeCPreForPlayer(protagonist_player_, X);
+            CUDD::BDD FcpreX = game_.final_states() & CPre(X);
 
-            // Use a do/while so the inner least-fixpoint iterates at least once.
-            do
+            FixpointTrace inner_trace;
+            // Each outer iteration has its own inner fixpoint
+            FixpointProbe inner_probe("buchi inner", std::to_string(outer_iter), state_bits);
+            if (warm_start_)
             {
-                prevY = Y;
-                inner_iter++;
-
-                // Add union with previous Y (target) as in EL solver
-                CUDD::BDD newY = (FcpreX | computeCPreForPlayer(protagonist_player_, Y)) | Y;
-                // keep within state space
-                Y = newY & state_space_;
-                if (debug_enabled_)
+                // The inner fixpoint shrinks with X, so it stays within the current X,
+                // and only predecessors of the last added states can be added
+                Y = FcpreX & state_space_;
+                CUDD::BDD frontier = Y;
+                do
+                {
+                    var_mgr_->check_budget("fixpoint");
+                    prevY = Y;
+                    inner_iter++;
+                    CUDD::BDD candidates = X & !Y & predecessors(frontier);
+                    Y = Y | CPre_care(Y, candidates);
+                    frontier = Y & !prevY;
+                    inner_trace.record(frontier, candidates, Y, state_bits);
+                    inner_probe.iteration(Y);
+                } while (!(Y == prevY));
+            }
+            else
             {
-                 spdlog::debug("[BuchiSolver DoubleFixpoint] inner_iter={}", inner_iter);
-                //(X, "X (current)");
+                // Use a do/while so the inner least-fixpoint iterates at least once.
+                do
+                {
+                    var_mgr_->check_budget("fixpoint");
+                    prevY = Y;
+                    inner_iter++;
+
+                    // Add union with previous Y (target) as in EL solver
+                    CUDD::BDD newY = (FcpreX | CPre(Y)) | Y;
+                    // keep within state space
+                    Y = newY & state_space_;
+                    inner_trace.record(Y & !prevY, state_space_, Y, state_bits);
+                    inner_probe.iteration(Y);
+                    if (debug_enabled_)
+                    {
+                        SYFT_DEBUG_TRACE("[BuchiSolver DoubleFixpoint] inner_iter={}", inner_iter);
+                    }
+                } while (!(Y == prevY));
             }
-            } while (!(Y == prevY));
-                spdlog::debug("[BuchiSolver DoubleFixpoint] inner finished");
+            inner_traces_.push_back(std::move(inner_trace));
+                SYFT_DEBUG_TRACE("[BuchiSolver DoubleFixpoint] inner finished");
 
             // The phi(X) is the inner fixpoint Y
             X = Y & state_space_;
+            outer_probe.iteration(X);
+            if (realizability_only_ && !includes_initial_state(X))
+            {
+                SYFT_DEBUG_TRACE("[BuchiSolver DoubleFixpoint] initial state lost at outer_iter={}", outer_iter);
+                return X;
+            }
 
             if (debug_enabled_)
             {
-                spdlog::debug("[BuchiSolver DoubleFixpoint] outer_iter={}, inner_iters={}, X_nodes={}", outer_iter, inner_iter, X.nodeCount());
+                SYFT_DEBUG_TRACE("[BuchiSolver DoubleFixpoint] outer_iter={}, inner_iters={}, X_nodes={}", outer_iter, inner_iter, X.nodeCount());
                 //print_state_set(X, "X (current)");
             }
         }
 
-        // Return whether initial state is contained in the outer fixpoint X
-        CUDD::BDD initial = game_.initial_state_bdd();
-        bool initial_in = (initial & !X).IsZero();
         if (debug_enabled_)
-                spdlog::debug("[BuchiSolver DoubleFixpoint] initial_in={}", initial_in);
-        return initial_in;
+                SYFT_DEBUG_TRACE("[BuchiSolver DoubleFixpoint] initial_in={}", includes_initial_state(X));
+        return X;
+    }
+
+    // Layered algorithm: the layers returned by an SCCDecomposer are solved
+    // bottom-up. The successors of a layer lie in the layer or below it, where
+    // every state is already decided, so a layer only needs a fixpoint over its
+    // own states, with the winning states below as an extra target.
+    CUDD::BDD BuchiSolver::LayeredFixpoint() const
+    {
+        auto mgr = var_mgr_->cudd_mgr();
+        std::size_t state_bits = var_mgr_->state_variable_count(game_.automaton_id());
+
+        std::unique_ptr<SCCDecomposer> decomposer = SCCDecomposer::Create(scc_algorithm_, game_, scc_chain_);
+        std::vector<CUDD::BDD> layers = decomposer->PeelLayers(state_space_);
+        var_mgr_->record_size("scc_symbolic_steps", static_cast<double>(decomposer->SymbolicSteps()));
+
+        CUDD::BDD remaining = state_space_;
+        for (const CUDD::BDD &layer : layers)
+        {
+            remaining &= !layer;
+        }
+        if (!remaining.IsZero())
+        {
+            // Not a layering of the state space: solve it as a single layer
+            spdlog::warn("[BuchiSolver LayeredFixpoint] {} states outside the SCC layers, solving the whole arena",
+                         remaining.CountMinterm(static_cast<int>(state_bits)));
+            return solve_layer(state_space_, mgr->bddZero());
+        }
+        spdlog::info("[BuchiSolver LayeredFixpoint] {} layers in {} symbolic steps", layers.size(),
+                     decomposer->SymbolicSteps());
+
+        CUDD::BDD initial = game_.initial_state_bdd();
+        CUDD::BDD winning = mgr->bddZero();
+        for (auto it = layers.rbegin(); it != layers.rend(); ++it)
+        {
+            var_mgr_->check_budget("fixpoint");
+            winning |= solve_layer(*it, winning);
+            if (realizability_only_ && !(initial & *it).IsZero())
+            {
+                SYFT_DEBUG_TRACE("[BuchiSolver LayeredFixpoint] initial state decided after {} of {} layers",
+                                 static_cast<std::size_t>(it - layers.rbegin()) + 1, layers.size());
+                break;
+            }
+        }
+        return winning;
+    }
+
+    CUDD::BDD BuchiSolver::solve_layer(const CUDD::BDD &layer, const CUDD::BDD &below) const
+    {
+        auto mgr = var_mgr_->cudd_mgr();
+        std::size_t state_bits = var_mgr_->state_variable_count(game_.automaton_id());
+        CUDD::BDD accepting = layer & game_.final_states();
+        CUDD::BDD rejecting = layer & !game_.final_states();
+
+        // Safety within the accepting states: nu X. states ∩ CPre(below ∪ X)
+        auto safety = [&](const CUDD::BDD &states)
+        {
+            FixpointTrace trace;
+            CUDD::BDD X = states;
+            CUDD::BDD prevX;
+            do
+            {
+                var_mgr_->check_budget("fixpoint");
+                prevX = X;
+                X = states & CPre(below | X);
+                trace.record(prevX & !X, states, X, state_bits);
+            } while (!(X == prevX));
+            inner_traces_.push_back(std::move(trace));
+            return X;
+        };
+        // Reachability of below through the rejecting states: mu X. states ∩ CPre(below ∪ X)
+        auto reachability = [&](const CUDD::BDD &states)
+        {
+            FixpointTrace trace;
+            CUDD::BDD X = mgr->bddZero();
+            CUDD::BDD prevX;
+            do
+            {
+                var_mgr_->check_budget("fixpoint");
+                prevX = X;
+                X = states & CPre(below | X);
+                trace.record(X & !prevX, states, X, state_bits);
+            } while (!(X == prevX));
+            inner_traces_.push_back(std::move(trace));
+            return X;
+        };
+
+        if (accepting.IsZero())
+        {
+            SYFT_DEBUG_TRACE("[BuchiSolver LayeredFixpoint] rejecting layer: reachability");
+            return reachability(layer);
+        }
+        if (rejecting.IsZero())
+        {
+            SYFT_DEBUG_TRACE("[BuchiSolver LayeredFixpoint] accepting layer: safety");
+            return safety(layer);
+        }
+        // Without a transition between its accepting and rejecting states, every
+        // SCC of the layer is accepting or rejecting: the layer is weak
+        if ((accepting & predecessors(rejecting)).IsZero() && (rejecting & predecessors(accepting)).IsZero())
+        {
+            SYFT_DEBUG_TRACE("[BuchiSolver LayeredFixpoint] weak layer: safety and reachability");
+            return safety(accepting) | reachability(rejecting);
+        }
+
+        // Büchi within the layer: nu Z. mu Y. layer ∩ ((F ∩ CPre(below ∪ Z)) ∪ CPre(below ∪ Y))
+        SYFT_DEBUG_TRACE("[BuchiSolver LayeredFixpoint] mixed layer: Büchi");
+        CUDD::BDD Z = layer;
+        CUDD::BDD prevZ;
+        do
+        {
+            var_mgr_->check_budget("fixpoint");
+            prevZ = Z;
+            CUDD::BDD recurrent = accepting & CPre(below | Z);
+            FixpointTrace trace;
+            CUDD::BDD Y = mgr->bddZero();
+            CUDD::BDD prevY;
+            do
+            {
+                var_mgr_->check_budget("fixpoint");
+                prevY = Y;
+                Y = recurrent | (layer & CPre(below | Y));
+                trace.record(Y & !prevY, layer, Y, state_bits);
+            } while (!(Y == prevY));
+            inner_traces_.push_back(std::move(trace));
+            Z = Y;
+        } while (!(Z == prevZ));
+        return Z;
     }
 
     // Main run
@@ -366,6 +574,7 @@ namespace Syft
             spdlog::info("[BuchiSolver] run: starting solver");
 
         SynthesisResult result;
+        inner_traces_.clear();
         print_automaton_summary();
 
         // If possible, print full set of all states in the state_space_ too
@@ -399,14 +608,24 @@ namespace Syft
             win_moves = CUDD::BDD();
             wining = includes_initial_state(norm_win_states);
         }
+        else if (buechi_mode_ == BuchiMode::LAYERED)
+        {
+            // The layers are the SCCs of the concrete arena, which the abstraction does not preserve
+            if (state_abstraction_)
+                throw std::runtime_error("Error: The layered Buchi mode does not support state abstractions");
+            spdlog::info("[BuchiSolver] run: using Layered mode");
+            norm_win_states = LayeredFixpoint();
+            win_moves = CUDD::BDD();
+            wining = includes_initial_state(norm_win_states);
+        }
         else
         {
             // Classic double-fixpoint mode
                         spdlog::info("[BuchiSolver] run: using Classic mode");
             
-            norm_win_states = CUDD::BDD();
+            norm_win_states = DoubleFixpoint();
             win_moves = CUDD::BDD();
-            wining = DoubleFixpoint();
+            wining = includes_initial_state(norm_win_states);
         }
         result.realizability = wining;
         result.winning_states = norm_win_states;
@@ -427,13 +646,15 @@ namespace Syft
 
         while (true)
         {
+            var_mgr_->check_budget("fixpoint");
             // Inner fixpoint: Y, YY = BDD.one
             CUDD::BDD Y = mgr->bddOne();
             CUDD::BDD YY = mgr->bddOne();
             while (true)
             {
+                var_mgr_->check_budget("fixpoint");
                 // YY = F && CPre(Y) || CPre(X)
-                YY = ((F & computeCPreForPlayer(protagonist_player_, Y)) | computeCPreForPlayer(protagonist_player_, X)) & state_space_;
+                YY = ((F & CPre(Y)) | CPre(X)) & state_space_;
                 if (YY == Y)
                     break;
                 Y = YY;
@@ -441,6 +662,9 @@ namespace Syft
             if (Y == X)
                 break;
             X = Y;
+            // X only grows and is winning throughout
+            if (realizability_only_ && includes_initial_state(X & state_space_))
+                break;
         }
         return X & state_space_;
     }
@@ -0,0 +1,341 @@
+#include "game/ColorFormula.h"
+#include "game/ELHelpers.hh"
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+
+namespace Syft {
+
+namespace {
+  bool color_in(std::uint64_t colors, std::uint32_t color) {
+    return color < 64 && ((colors >> color) & 1);
+  }
+}
+
+ColorFormula::ColorFormula() {
+  compile({"t"});
+}
+
+ColorFormula::ColorFormula(const std::string& formula) {
+  compile(ELHelpers::infix2postfix(ELHelpers::tokenize(formula)));
+}
+
+ColorFormula ColorFormula::from_postfix(const std::vector<std::string>& postfix) {
+  ColorFormula formula;
+  formula.compile(postfix);
+  return formula;
+}
+
+void ColorFormula::compile(const std::vector<std::string>& postfix) {
+  program_.clear();
+
+  std::size_t depth = 0;
+  for (const std::string& token : postfix) {
+    Instruction instruction{Opcode::True, 0};
+    std::size_t operands = 0;
+    if (ELHelpers::isNumber(token) && !token.empty()) {
+      unsigned long color = std::stoul(token);
+      if (color >= std::numeric_limits<std::uint32_t>::max()) {
+        throw std::runtime_error("Error: Color out of range in color formula: " + token);
+      }
+      instruction = Instruction{Opcode::Color, static_cast<std::uint32_t>(color)};
+    } else if (ELHelpers::isTrue(token)) {
+      instruction.opcode = Opcode::True;
+    } else if (ELHelpers::isFalse(token)) {
+      instruction.opcode = Opcode::False;
+    } else if (token == "!") {
+      instruction.opcode = Opcode::Not;
+      operands = 1;
+    } else if (token == "&" || token == "|") {
+      instruction.opcode = token == "&" ? Opcode::And : Opcode::Or;
+      operands = 2;
+    } else {
+      throw std::runtime_error("Error: Unknown token in color formula: " + token);
+    }
+    if (depth < operands) {
+      throw std::runtime_error("Error: Missing operand in color formula at: " + token);
+    }
+    depth = depth - operands + 1;
+    program_.push_back(instruction);
+  }
+  if (depth != 1) {
+    throw std::runtime_error("Error: Malformed color formula");
+  }
+  tabulate();
+}
+
+ColorFormula ColorFormula::from_bdd(const CUDD::BDD& formula, const std::function<std::size_t(int)>& variable_color) {
+  ColorFormula compiled;
+  compiled.program_.clear();
+  compiled.emit(formula.getNode(), false, variable_color);
+  compiled.tabulate();
+  return compiled;
+}
+
+void ColorFormula::emit(DdNode* node, bool complemented, const std::function<std::size_t(int)>& variable_color) {
+  DdNode* regular = Cudd_Regular(node);
+  complemented = complemented != static_cast<bool>(Cudd_IsComplement(node));
+  if (Cudd_IsConstant(regular)) {
+    program_.push_back(Instruction{complemented ? Opcode::False : Opcode::True, 0});
+    return;
+  }
+
+  std::size_t color = variable_color(static_cast<int>(Cudd_NodeReadIndex(regular)));
+  if (color >= std::numeric_limits<std::uint32_t>::max()) {
+    throw std::runtime_error("Error: Color out of range in color formula: " + std::to_string(color));
+  }
+  Instruction variable{Opcode::Color, static_cast<std::uint32_t>(color)};
+  // The cofactors, each either a constant or a subformula
+  DdNode* cofactors[2] = {Cudd_T(regular), Cudd_E(regular)};
+  std::optional<bool> constant[2];
+  for (int i = 0; i < 2; ++i) {
+    DdNode* cofactor = Cudd_Regular(cofactors[i]);
+    if (Cudd_IsConstant(cofactor)) {
+      constant[i] = complemented == static_cast<bool>(Cudd_IsComplement(cofactors[i]));
+    }
+  }
+  auto literal = [&](bool positive) {
+    program_.push_back(variable);
+    if (!positive) {
+      program_.push_back(Instruction{Opcode::Not, 0});
+    }
+  };
+
+  // (color & then) | (!color & else), simplified when a cofactor is constant
+  if (constant[0] && constant[1]) {
+    literal(*constant[0]);
+  } else if (constant[0]) {
+    literal(*constant[0]);
+    emit(cofactors[1], complemented, variable_color);
+    program_.push_back(Instruction{*constant[0] ? Opcode::Or : Opcode::And, 0});
+  } else if (constant[1]) {
+    literal(!*constant[1]);
+    emit(cofactors[0], complemented, variable_color);
+    program_.push_back(Instruction{*constant[1] ? Opcode::Or : Opcode::And, 0});
+  } else {
+    literal(true);
+    emit(cofactors[0], complemented, variable_color);
+    program_.push_back(Instruction{Opcode::And, 0});
+    literal(false);
+    emit(cofactors[1], complemented, variable_color);
+    program_.push_back(Instruction{Opcode::And, 0});
+    program_.push_back(Instruction{Opcode::Or, 0});
+  }
+}
+
+void ColorFormula::tabulate() {
+  truth_table_.clear();
+  color_count_ = 0;
+  max_depth_ = 0;
+  std::size_t depth = 0;
+  for (const Instruction& instruction : program_) {
+    switch (instruction.opcode) {
+      case Opcode::Color:
+        color_count_ = std::max(color_count_, static_cast<std::size_t>(instruction.color) + 1);
+        depth++;
+        break;
+      case Opcode::True:
+      case Opcode::False:
+        depth++;
+        break;
+      case Opcode::Not:
+        break;
+      case Opcode::And:
+      case Opcode::Or:
+        depth--;
+        break;
+    }
+    max_depth_ = std::max(max_depth_, depth);
+  }
+
+  if (color_count_ <= truth_table_max_colors) {
+    std::uint64_t sets = std::uint64_t(1) << color_count_;
+    truth_table_.resize(sets);
+    for (std::uint64_t colors = 0; colors < sets; ++colors) {
+      truth_table_[colors] = run(colors);
+    }
+  }
+}
+
+bool ColorFormula::run(std::uint64_t colors) const {
+  if (max_depth_ <= 64) {
+    // Bit 0 is the top of the stack
+    std::uint64_t stack = 0;
+    for (const Instruction& instruction : program_) {
+      switch (instruction.opcode) {
+        case Opcode::Color:
+          stack = (stack << 1) | (color_in(colors, instruction.color) ? 1 : 0);
+          break;
+        case Opcode::True:
+          stack = (stack << 1) | 1;
+          break;
+        case Opcode::False:
+          stack = stack << 1;
+          break;
+        case Opcode::Not:
+          stack ^= 1;
+          break;
+        case Opcode::And: {
+          std::uint64_t top = stack & 1;
+          stack >>= 1;
+          stack &= ~std::uint64_t(1) | top;
+          break;
+        }
+        case Opcode::Or:
+          stack = (stack >> 1) | (stack & 1);
+          break;
+      }
+    }
+    return stack & 1;
+  }
+
+  std::vector<char> stack;
+  stack.reserve(max_depth_);
+  for (const Instruction& instruction : program_) {
+    switch (instruction.opcode) {
+      case Opcode::Color:
+        stack.push_back(color_in(colors, instruction.color));
+        break;
+      case Opcode::True:
+        stack.push_back(true);
+        break;
+      case Opcode::False:
+        stack.push_back(false);
+        break;
+      case Opcode::Not:
+        stack.back() = !stack.back();
+        break;
+      case Opcode::And:
+      case Opcode::Or: {
+        char top = stack.back();
+        stack.pop_back();
+        stack.back() = instruction.opcode == Opcode::And ? (stack.back() && top) : (stack.back() || top);
+        break;
+      }
+    }
+  }
+  return stack.back();
+}
+
+bool ColorFormula::evaluate(std::uint64_t colors) const {
+  if (!truth_table_.empty()) {
+    return truth_table_[colors & ((std::uint64_t(1) << color_count_) - 1)];
+  }
+  return run(colors);
+}
+
+bool ColorFormula::evaluate(const std::vector<bool>& colors) const {
+  if (color_count_ <= 64) {
+    std::uint64_t mask = 0;
+    for (std::size_t i = 0; i < colors.size() && i < color_count_; ++i) {
+      if (colors[i]) {
+        mask |= std::uint64_t(1) << i;
+      }
+    }
+    return evaluate(mask);
+  }
+  return run_over(colors);
+}
+
+bool ColorFormula::evaluate(const ColorSet& colors) const {
+  if (color_count_ <= 64) {
+    // The colors past the formula are never read
+    return evaluate(colors.size() == 0 ? std::uint64_t(0) : colors.words()[0]);
+  }
+  return run_over(colors);
+}
+
+template <typename Colors>
+bool ColorFormula::run_over(const Colors& colors) const {
+  std::vector<char> stack;
+  stack.reserve(max_depth_);
+  for (const Instruction& instruction : program_) {
+    switch (instruction.opcode) {
+      case Opcode::Color:
+        stack.push_back(instruction.color < colors.size() && colors[instruction.color]);
+        break;
+      case Opcode::True:
+        stack.push_back(true);
+        break;
+      case Opcode::False:
+        stack.push_back(false);
+        break;
+      case Opcode::Not:
+        stack.back() = !stack.back();
+        break;
+      case Opcode::And:
+      case Opcode::Or: {
+        char top = stack.back();
+        stack.pop_back();
+        stack.back() = instruction.opcode == Opcode::And ? (stack.back() && top) : (stack.back() || top);
+        break;
+      }
+    }
+  }
+  return stack.back();
+}
+
+CUDD::BDD ColorFormula::to_bdd(const std::function<CUDD::BDD(std::size_t)>& color_bdd, const CUDD::Cudd& mgr) const {
+  std::vector<CUDD::BDD> stack;
+  stack.reserve(max_depth_);
+  for (const Instruction& instruction : program_) {
+    switch (instruction.opcode) {
+      case Opcode::Color:
+        stack.push_back(color_bdd(instruction.color));
+        break;
+      case Opcode::True:
+        stack.push_back(mgr.bddOne());
+        break;
+      case Opcode::False:
+        stack.push_back(mgr.bddZero());
+        break;
+      case Opcode::Not:
+        stack.back() = !stack.back();
+        break;
+      case Opcode::And:
+      case Opcode::Or: {
+        CUDD::BDD top = stack.back();
+        stack.pop_back();
+        stack.back() = instruction.opcode == Opcode::And ? (stack.back() & top) : (stack.back() | top);
+        break;
+      }
+    }
+  }
+  return stack.back();
+}
+
+std::vector<std::string> ColorFormula::to_postfix() const {
+  std::vector<std::string> postfix;
+  postfix.reserve(program_.size());
+  for (const Instruction& instruction : program_) {
+    switch (instruction.opcode) {
+      case Opcode::Color:
+        postfix.push_back(std::to_string(instruction.color));
+        break;
+      case Opcode::True:
+        postfix.push_back("t");
+        break;
+      case Opcode::False:
+        postfix.push_back("f");
+        break;
+      case Opcode::Not:
+        postfix.push_back("!");
+        break;
+      case Opcode::And:
+        postfix.push_back("&");
+        break;
+      case Opcode::Or:
+        postfix.push_back("|");
+        break;
+    }
+  }
+  return postfix;
+}
+
+std::size_t ColorFormula::color_count() const {
+  return color_count_;
+}
+
+}
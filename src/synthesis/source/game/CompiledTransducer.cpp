@@ -0,0 +1,342 @@
+#include "game/CompiledTransducer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Syft {
+
+namespace {
+  const char image_magic[8] = {'S', 'Y', 'F', 'T', 'C', 'T', 'R', 'L'};
+}
+
+CompiledTransducer::Instance::Instance(std::size_t slot_count, std::size_t state_count)
+  : values_(slot_count, 0), next_(state_count, 0) {}
+
+std::vector<bool> CompiledTransducer::Instance::state() const {
+  std::size_t first = values_.size() - next_.size();
+  return std::vector<bool>(values_.begin() + first, values_.end());
+}
+
+CompiledTransducer::Batch::Batch(std::size_t size, std::size_t slot_count, std::size_t input_count,
+                                 std::size_t output_count, std::size_t state_count, std::size_t node_count)
+  : size_(size), words_((size + 63) / 64), input_count_(input_count), output_count_(output_count),
+    state_count_(state_count), values_(slot_count * words_, 0), node_values_(node_count * words_, 0),
+    next_(state_count * words_, 0) {}
+
+void CompiledTransducer::Batch::set_input(std::size_t instance, std::size_t input, bool value) {
+  if (instance >= size_ || input >= input_count_) {
+    throw std::runtime_error("Error: No input " + std::to_string(input) + " of instance " +
+                             std::to_string(instance));
+  }
+  std::uint64_t& word = values_[input * words_ + instance / 64];
+  std::uint64_t bit = std::uint64_t(1) << (instance % 64);
+  word = value ? (word | bit) : (word & ~bit);
+}
+
+bool CompiledTransducer::Batch::output(std::size_t instance, std::size_t output) const {
+  if (instance >= size_ || output >= output_count_) {
+    throw std::runtime_error("Error: No output " + std::to_string(output) + " of instance " +
+                             std::to_string(instance));
+  }
+  return (values_[(input_count_ + output) * words_ + instance / 64] >> (instance % 64)) & 1;
+}
+
+std::vector<bool> CompiledTransducer::Batch::state(std::size_t instance) const {
+  if (instance >= size_) {
+    throw std::runtime_error("Error: No instance " + std::to_string(instance));
+  }
+  std::vector<bool> state(state_count_);
+  for (std::size_t k = 0; k < state_count_; ++k) {
+    std::size_t slot = input_count_ + output_count_ + k;
+    state[k] = (values_[slot * words_ + instance / 64] >> (instance % 64)) & 1;
+  }
+  return state;
+}
+
+CompiledTransducer::CompiledTransducer(const Transducer& transducer) {
+  std::shared_ptr<VarMgr> var_mgr = transducer.get_var_mgr();
+  const std::vector<CUDD::BDD>& transition_function = transducer.get_transition_function();
+  const std::vector<CUDD::BDD>& state_variables = transducer.get_state_variables();
+  if (state_variables.size() != transition_function.size()) {
+    throw std::runtime_error("Error: The transducer does not record the state variables of its transition function");
+  }
+
+  std::vector<std::string> inputs = transducer.controller_inputs();
+  std::vector<std::string> outputs = transducer.controller_outputs();
+  BddCircuit circuit(var_mgr);
+  for (const std::string& name : inputs) {
+    circuit.add_slot(static_cast<int>(var_mgr->name_to_variable(name).NodeReadIndex()));
+  }
+  std::vector<int> output_indices;
+  for (const std::string& name : outputs) {
+    output_indices.push_back(static_cast<int>(var_mgr->name_to_variable(name).NodeReadIndex()));
+    circuit.add_slot(output_indices.back());
+  }
+  const std::vector<int>& initial_vector = transducer.get_initial_vector();
+  std::vector<std::uint8_t> initial_state;
+  for (const CUDD::BDD& variable : state_variables) {
+    int index = static_cast<int>(variable.NodeReadIndex());
+    circuit.add_slot(index);
+    bool initial = index < static_cast<int>(initial_vector.size()) && initial_vector[index] != 0;
+    initial_state.push_back(initial ? 1 : 0);
+  }
+
+  std::vector<Function> functions;
+  auto add_function = [&](const CUDD::BDD& bdd) {
+    Function function{};
+    function.root = circuit.add(bdd);
+    std::vector<std::uint32_t> support = circuit.support(bdd);
+    if (support.size() <= lookup_table_max_support) {
+      function.tabulated = 1;
+      function.support = static_cast<std::uint32_t>(support.size());
+      std::copy(support.begin(), support.end(), function.slots);
+      std::vector<std::uint8_t> values(circuit.slot_count(), 0);
+      for (std::uint64_t row = 0; row < (std::uint64_t(1) << support.size()); ++row) {
+        for (std::size_t j = 0; j < support.size(); ++j) {
+          values[support[j]] = (row >> j) & 1;
+        }
+        function.table |= static_cast<std::uint64_t>(circuit.evaluate(function.root, values.data()) ==
+                                                     BddCircuit::true_node) << row;
+      }
+    }
+    functions.push_back(function);
+    return support;
+  };
+  const std::unordered_map<int, CUDD::BDD>& output_function = transducer.get_output_function();
+  for (std::size_t o = 0; o < outputs.size(); ++o) {
+    auto function = output_function.find(output_indices[o]);
+    if (function == output_function.end()) {
+      throw std::runtime_error("Error: The transducer has no function for output " + outputs[o]);
+    }
+    for (std::uint32_t slot : add_function(function->second)) {
+      if (slot >= inputs.size() && slot < inputs.size() + outputs.size()) {
+        throw std::runtime_error("Error: The function of output " + outputs[o] + " depends on an output");
+      }
+    }
+  }
+  std::size_t output_nodes_end = circuit.size();
+  for (const CUDD::BDD& bit : transition_function) {
+    add_function(bit);
+  }
+
+  // Each label ends with a newline
+  std::string labels;
+  for (const std::string& label : inputs) {
+    labels += label + "\n";
+  }
+  for (const std::string& label : outputs) {
+    labels += label + "\n";
+  }
+  auto aligned = [](std::uint64_t offset) {return (offset + 7) / 8 * 8;};
+  Header header{};
+  std::memcpy(header.magic, image_magic, sizeof(header.magic));
+  header.version = format_version;
+  header.byte_order = 0x01020304;
+  header.input_count = static_cast<std::uint32_t>(inputs.size());
+  header.output_count = static_cast<std::uint32_t>(outputs.size());
+  header.state_count = static_cast<std::uint32_t>(state_variables.size());
+  header.node_count = static_cast<std::uint32_t>(circuit.size());
+  header.output_nodes_end = static_cast<std::uint32_t>(output_nodes_end);
+  header.labels_size = static_cast<std::uint32_t>(labels.size());
+  header.labels_offset = aligned(sizeof(Header));
+  header.nodes_offset = aligned(header.labels_offset + labels.size());
+  header.functions_offset = aligned(header.nodes_offset + circuit.size() * sizeof(BddCircuit::Node));
+  header.initial_offset = header.functions_offset + functions.size() * sizeof(Function);
+  header.image_size = header.initial_offset + initial_state.size();
+
+  auto buffer = std::make_shared<std::vector<std::uint64_t>>((header.image_size + 7) / 8, 0);
+  char* image = reinterpret_cast<char*>(buffer->data());
+  std::memcpy(image, &header, sizeof(Header));
+  std::memcpy(image + header.labels_offset, labels.data(), labels.size());
+  std::memcpy(image + header.nodes_offset, circuit.nodes().data(), circuit.size() * sizeof(BddCircuit::Node));
+  std::memcpy(image + header.functions_offset, functions.data(), functions.size() * sizeof(Function));
+  std::memcpy(image + header.initial_offset, initial_state.data(), initial_state.size());
+  attach(std::shared_ptr<const void>(buffer, buffer->data()), header.image_size);
+}
+
+void CompiledTransducer::attach(std::shared_ptr<const void> image, std::size_t size) {
+  const char* base = static_cast<const char*>(image.get());
+  auto malformed = [](const std::string& reason) {
+    return std::runtime_error("Error: Not a compiled controller: " + reason);
+  };
+  if (size < sizeof(Header)) {
+    throw malformed("too short");
+  }
+  Header header;
+  std::memcpy(&header, base, sizeof(Header));
+  if (std::memcmp(header.magic, image_magic, sizeof(header.magic)) != 0) {
+    throw malformed("bad magic number");
+  }
+  if (header.version != format_version || header.byte_order != 0x01020304) {
+    throw malformed("unsupported version or byte order");
+  }
+  std::size_t slots = std::size_t(header.input_count) + header.output_count + header.state_count;
+  std::size_t function_count = std::size_t(header.output_count) + header.state_count;
+  bool aligned = header.nodes_offset % alignof(BddCircuit::Node) == 0 &&
+                 header.functions_offset % alignof(Function) == 0;
+  bool inside = header.image_size == size && header.labels_offset + header.labels_size <= size &&
+                header.nodes_offset + std::uint64_t(header.node_count) * sizeof(BddCircuit::Node) <= size &&
+                header.functions_offset + function_count * sizeof(Function) <= size &&
+                header.initial_offset + header.state_count <= size;
+  if (!aligned || !inside || header.node_count < 2 || header.output_nodes_end > header.node_count) {
+    throw malformed("inconsistent layout");
+  }
+
+  nodes_ = reinterpret_cast<const BddCircuit::Node*>(base + header.nodes_offset);
+  functions_ = reinterpret_cast<const Function*>(base + header.functions_offset);
+  initial_state_ = reinterpret_cast<const std::uint8_t*>(base + header.initial_offset);
+  // Children come first, so that evaluation always terminates
+  for (std::size_t id = 2; id < header.node_count; ++id) {
+    const BddCircuit::Node& node = nodes_[id];
+    if (node.slot >= slots || node.child[0] >= id || node.child[1] >= id) {
+      throw malformed("bad node " + std::to_string(id));
+    }
+  }
+  for (std::size_t f = 0; f < function_count; ++f) {
+    const Function& function = functions_[f];
+    bool bad = function.root >= header.node_count || function.support > lookup_table_max_support;
+    for (std::uint32_t j = 0; !bad && function.tabulated && j < function.support; ++j) {
+      bad = function.slots[j] >= slots;
+    }
+    if (bad) {
+      throw malformed("bad function " + std::to_string(f));
+    }
+  }
+
+  std::vector<std::string> labels;
+  std::string label;
+  for (std::size_t i = 0; i < header.labels_size; ++i) {
+    char c = base[header.labels_offset + i];
+    if (c == '\n') {
+      labels.push_back(label);
+      label.clear();
+    } else {
+      label += c;
+    }
+  }
+  if (labels.size() != std::size_t(header.input_count) + header.output_count) {
+    throw malformed("bad labels");
+  }
+  input_labels_.assign(labels.begin(), labels.begin() + header.input_count);
+  output_labels_.assign(labels.begin() + header.input_count, labels.end());
+
+  image_ = std::move(image);
+  image_size_ = size;
+  input_count_ = header.input_count;
+  output_count_ = header.output_count;
+  state_count_ = header.state_count;
+  node_total_ = header.node_count;
+  output_nodes_end_ = header.output_nodes_end;
+}
+
+CompiledTransducer CompiledTransducer::load(const std::string& filename) {
+  int descriptor = open(filename.c_str(), O_RDONLY);
+  if (descriptor < 0) {
+    throw std::runtime_error("Error: Could not open file for reading: " + filename);
+  }
+  struct stat status;
+  if (fstat(descriptor, &status) != 0 || status.st_size <= 0) {
+    close(descriptor);
+    throw std::runtime_error("Error: Not a compiled controller: " + filename);
+  }
+  std::size_t size = static_cast<std::size_t>(status.st_size);
+  void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+  close(descriptor);
+  if (mapping == MAP_FAILED) {
+    throw std::runtime_error("Error: Could not map file: " + filename);
+  }
+  std::shared_ptr<const void> image(mapping, [size](const void* address) {
+    munmap(const_cast<void*>(address), size);
+  });
+
+  CompiledTransducer compiled;
+  compiled.attach(std::move(image), size);
+  return compiled;
+}
+
+void CompiledTransducer::save(const std::string& filename) const {
+  std::ofstream out(filename, std::ios::binary);
+  if (!out.is_open()) {
+    throw std::runtime_error("Error: Could not open file for writing: " + filename);
+  }
+  out.write(static_cast<const char*>(image_.get()), static_cast<std::streamsize>(image_size_));
+  if (!out) {
+    throw std::runtime_error("Error: Could not write file: " + filename);
+  }
+}
+
+std::size_t CompiledTransducer::tabulated_count() const {
+  std::size_t tabulated = 0;
+  for (std::size_t f = 0; f < output_count_ + state_count_; ++f) {
+    tabulated += functions_[f].tabulated ? 1 : 0;
+  }
+  return tabulated;
+}
+
+bool CompiledTransducer::evaluate(const Function& function, const std::uint8_t* values) const {
+  if (function.tabulated) {
+    std::uint64_t row = 0;
+    for (std::uint32_t j = 0; j < function.support; ++j) {
+      row |= static_cast<std::uint64_t>(values[function.slots[j]]) << j;
+    }
+    return (function.table >> row) & 1;
+  }
+  return BddCircuit::evaluate(nodes_, function.root, values) == BddCircuit::true_node;
+}
+
+CompiledTransducer::Instance CompiledTransducer::make_instance() const {
+  Instance instance(slot_count(), state_count_);
+  std::copy(initial_state_, initial_state_ + state_count_, instance.values_.begin() + input_count_ + output_count_);
+  return instance;
+}
+
+void CompiledTransducer::step(Instance& instance, const std::uint8_t* inputs, std::uint8_t* outputs) const {
+  std::uint8_t* values = instance.values_.data();
+  std::copy(inputs, inputs + input_count_, values);
+  for (std::size_t o = 0; o < output_count_; ++o) {
+    values[input_count_ + o] = outputs[o] = evaluate(functions_[o], values);
+  }
+  // Every bit reads the current state, which is replaced at the end
+  for (std::size_t k = 0; k < state_count_; ++k) {
+    instance.next_[k] = evaluate(functions_[output_count_ + k], values);
+  }
+  std::copy(instance.next_.begin(), instance.next_.end(), values + input_count_ + output_count_);
+}
+
+CompiledTransducer::Batch CompiledTransducer::make_batch(std::size_t size) const {
+  Batch batch(size, slot_count(), input_count_, output_count_, state_count_, node_total_);
+  for (std::size_t k = 0; k < state_count_; ++k) {
+    std::uint64_t word = initial_state_[k] ? ~std::uint64_t(0) : 0;
+    std::size_t slot = input_count_ + output_count_ + k;
+    std::fill(batch.values_.begin() + slot * batch.words_, batch.values_.begin() + (slot + 1) * batch.words_, word);
+  }
+  return batch;
+}
+
+void CompiledTransducer::step(Batch& batch) const {
+  std::size_t words = batch.words_;
+  std::uint64_t* values = batch.values_.data();
+  std::uint64_t* node_values = batch.node_values_.data();
+  BddCircuit::evaluate(nodes_, 0, output_nodes_end_, values, words, node_values);
+  for (std::size_t o = 0; o < output_count_; ++o) {
+    std::copy_n(node_values + functions_[o].root * words, words, values + (input_count_ + o) * words);
+  }
+  // The nodes of the outputs keep their values, as they do not read the outputs
+  BddCircuit::evaluate(nodes_, output_nodes_end_, node_total_, values, words, node_values);
+  for (std::size_t k = 0; k < state_count_; ++k) {
+    std::copy_n(node_values + functions_[output_count_ + k].root * words, words, batch.next_.data() + k * words);
+  }
+  std::copy(batch.next_.begin(), batch.next_.end(), values + (input_count_ + output_count_) * words);
+}
+
+}
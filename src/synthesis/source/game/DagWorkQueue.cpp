@@ -0,0 +1,307 @@
+#include "game/DagWorkQueue.h"
+
+#include "BddArchive.h"
+#include "game/EmersonLei.hpp"
+
+#include <spdlog/spdlog.h>
+#include <unistd.h>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace Syft {
+
+namespace {
+  namespace fs = std::filesystem;
+
+  const std::string colors_kind = "mp-colors";
+  const std::string job_kind = "mp-job";
+  const std::string result_kind = "mp-result";
+
+  std::string job_name(const std::string& run, std::size_t job) {
+    return "job-" + run + "-" + std::to_string(job);
+  }
+
+  // Unique across the runs sharing a directory, even from other machines' processes
+  std::string new_run_token() {
+    auto now = std::chrono::system_clock::now().time_since_epoch();
+    char host[256] = {};
+    gethostname(host, sizeof(host) - 1);
+    return std::string(host) + "." + std::to_string(getpid()) + "." +
+           std::to_string(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+  }
+
+  // Readers only ever see complete files: each is written aside and renamed
+  void write_text(const fs::path& path, const std::string& text) {
+    fs::path temporary = path.string() + ".tmp";
+    {
+      std::ofstream out(temporary);
+      if (!out.is_open()) {
+        throw std::runtime_error("Error: Could not open file for writing: " + temporary.string());
+      }
+      out << text;
+    }
+    fs::rename(temporary, path);
+  }
+
+  void save_archive(const BddArchive& archive, const fs::path& path, const std::shared_ptr<VarMgr>& var_mgr) {
+    fs::path temporary = path.string() + ".tmp";
+    archive.save(temporary.string(), var_mgr);
+    fs::rename(temporary, path);
+  }
+
+  std::string read_text(const fs::path& path) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+      throw std::runtime_error("Error: Could not open file for reading: " + path.string());
+    }
+    std::stringstream text;
+    text << in.rdbuf();
+    return text.str();
+  }
+
+  // The run token held by a marker file, if it exists
+  std::optional<std::string> read_token(const fs::path& path) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+      return std::nullopt;
+    }
+    std::string token;
+    std::getline(in, token);
+    return token;
+  }
+
+  std::vector<std::string> words(const std::string& line) {
+    std::vector<std::string> result;
+    std::istringstream in(line);
+    for (std::string word; in >> word;) {
+      result.push_back(word);
+    }
+    return result;
+  }
+
+  std::string join(const std::vector<std::string>& parts) {
+    std::string result;
+    for (const std::string& word : parts) {
+      result += (result.empty() ? "" : " ") + word;
+    }
+    return result;
+  }
+}
+
+DagWorkQueue::DagWorkQueue(std::string directory, std::shared_ptr<VarMgr> var_mgr)
+  : directory_(std::move(directory)), var_mgr_(std::move(var_mgr)), run_(new_run_token()) {
+  fs::path root(directory_);
+  fs::create_directories(root);
+  // The files of an earlier or crashed run; arena.ready goes first, so that no worker loads the old arena
+  std::error_code ignored;
+  fs::remove(root / "arena.ready", ignored);
+  std::size_t stale = 0;
+  for (const fs::directory_entry& entry : fs::directory_iterator(root)) {
+    std::string file = entry.path().filename().string();
+    if (entry.is_regular_file() && (file.rfind("arena.", 0) == 0 || file.rfind("job-", 0) == 0 || file == "done")) {
+      fs::remove(entry.path(), ignored);
+      stale++;
+    }
+  }
+  if (stale > 0) {
+    spdlog::info("[DagWorkQueue::DagWorkQueue] removed {} files of an earlier run from {}", stale, directory_);
+  }
+}
+
+DagWorkQueue::~DagWorkQueue() {
+  try {
+    finish();
+  } catch (const std::exception& ex) {
+    spdlog::warn("[DagWorkQueue::~DagWorkQueue] could not stop the workers: {}", ex.what());
+  }
+}
+
+void DagWorkQueue::publish_arena(const SymbolicStateDfa& arena, const std::vector<CUDD::BDD>& colors,
+                                 const CUDD::BDD& state_space, Player starting_player, Player protagonist_player) {
+  fs::path root(directory_);
+  automaton_id_ = arena.automaton_id();
+
+  fs::path arena_path = root / "arena.dfa";
+  arena.save(arena_path.string() + ".tmp");
+  fs::rename(arena_path.string() + ".tmp", arena_path);
+  // Workers create the alphabet before loading, as archives match it by name
+  write_text(root / "arena.vars", join(var_mgr_->input_variable_labels()) + "\n" +
+                                  join(var_mgr_->output_variable_labels()) + "\n");
+
+  BddArchive archive;
+  archive.kind = colors_kind;
+  archive.automaton_id = automaton_id_;
+  archive.values = {static_cast<int>(starting_player), static_cast<int>(protagonist_player)};
+  archive.bdds = colors;
+  archive.bdds.push_back(state_space);
+  save_archive(archive, root / "arena.colors", var_mgr_);
+  write_text(root / "arena.ready", run_ + "\n");
+  spdlog::info("[DagWorkQueue::publish_arena] published the arena in {}", directory_);
+}
+
+std::size_t DagWorkQueue::submit(const ColorFormula& color_formula, const CUDD::BDD& instant_winning,
+                                 const CUDD::BDD& instant_losing) {
+  fs::path root(directory_);
+  std::size_t job = next_job_++;
+  std::string name = job_name(run_, job);
+
+  BddArchive archive;
+  archive.kind = job_kind;
+  archive.automaton_id = automaton_id_;
+  archive.bdds = {instant_winning, instant_losing};
+  save_archive(archive, root / (name + ".job"), var_mgr_);
+  write_text(root / (name + ".formula"), join(color_formula.to_postfix()) + "\n");
+  // Written last: a worker may claim the job as soon as it is queued
+  write_text(root / (name + ".queued"), "");
+  return job;
+}
+
+std::optional<DagWorkQueue::Outcome> DagWorkQueue::collect(std::size_t job) {
+  fs::path root(directory_);
+  std::string name = job_name(run_, job);
+  if (fs::exists(root / (name + ".error"))) {
+    throw std::runtime_error("Error: A DAG worker failed on " + name + ": " + read_text(root / (name + ".error")));
+  }
+  fs::path result_path = root / (name + ".result");
+  if (!fs::exists(result_path)) {
+    return std::nullopt;
+  }
+
+  BddArchive archive = BddArchive::load(result_path.string(), var_mgr_, automaton_id_);
+  if (archive.kind != result_kind || archive.values.size() != 1 || archive.bdds.size() != 1) {
+    throw std::runtime_error("Error: Not a DAG job result: " + result_path.string());
+  }
+  for (const std::string suffix : {".job", ".formula", ".claimed", ".result"}) {
+    std::error_code ignored;
+    fs::remove(root / (name + suffix), ignored);
+  }
+  return Outcome{archive.values[0] != 0, archive.bdds[0]};
+}
+
+void DagWorkQueue::finish() {
+  if (finished_) {
+    return;
+  }
+  finished_ = true;
+  write_text(fs::path(directory_) / "done", run_ + "\n");
+}
+
+namespace {
+  // Solves the jobs of \a run until it is done, returning true, or replaced by another run, returning false
+  bool serve_run(const fs::path& root, const std::string& run, const VarMgrOptions& options,
+                 std::chrono::milliseconds poll, std::size_t& solved) {
+    auto var_mgr = std::make_shared<VarMgr>(options);
+    std::istringstream variables(read_text(root / "arena.vars"));
+    std::string input_line, output_line;
+    std::getline(variables, input_line);
+    std::getline(variables, output_line);
+    std::vector<std::string> inputs = words(input_line);
+    std::vector<std::string> outputs = words(output_line);
+    std::vector<std::string> names = inputs;
+    names.insert(names.end(), outputs.begin(), outputs.end());
+    var_mgr->create_named_variables(names);
+    var_mgr->partition_variables(inputs, outputs);
+
+    SymbolicStateDfa arena = SymbolicStateDfa::load(var_mgr, (root / "arena.dfa").string());
+    std::size_t automaton_id = arena.automaton_id();
+    BddArchive shared = BddArchive::load((root / "arena.colors").string(), var_mgr, automaton_id);
+    if (shared.kind != colors_kind || shared.values.size() != 2 || shared.bdds.empty()) {
+      throw std::runtime_error("Error: Not a DAG arena: " + (root / "arena.colors").string());
+    }
+    Player starting_player = static_cast<Player>(shared.values[0]);
+    Player protagonist_player = static_cast<Player>(shared.values[1]);
+    CUDD::BDD state_space = shared.bdds.back();
+    shared.bdds.pop_back();
+    spdlog::info("[DagWorkQueue::serve] loaded the arena of {}", root.string());
+
+    // Jobs of other runs are left alone
+    const std::string prefix = "job-" + run + "-";
+    while (true) {
+      std::optional<std::string> claimed;
+      for (const fs::directory_entry& entry : fs::directory_iterator(root)) {
+        std::string file = entry.path().filename().string();
+        const std::string marker = ".queued";
+        if (file.size() <= marker.size() || file.compare(file.size() - marker.size(), marker.size(), marker) != 0 ||
+            file.rfind(prefix, 0) != 0) {
+          continue;
+        }
+        std::string name = file.substr(0, file.size() - marker.size());
+        // Fails if another worker renamed it first
+        std::error_code taken;
+        fs::rename(entry.path(), root / (name + ".claimed"), taken);
+        if (!taken) {
+          claimed = name;
+          break;
+        }
+      }
+      if (!claimed) {
+        if (read_token(root / "done") == run) {
+          return true;
+        }
+        if (read_token(root / "arena.ready") != run) {
+          return false;
+        }
+        std::this_thread::sleep_for(poll);
+        continue;
+      }
+
+      const std::string& name = *claimed;
+      try {
+        BddArchive job = BddArchive::load((root / (name + ".job")).string(), var_mgr, automaton_id);
+        if (job.kind != job_kind || job.bdds.size() != 2) {
+          throw std::runtime_error("Not a DAG job: " + name);
+        }
+        ColorFormula color_formula = ColorFormula::from_postfix(words(read_text(root / (name + ".formula"))));
+        EmersonLei solver(arena, color_formula, starting_player, protagonist_player, shared.bdds, state_space,
+                          job.bdds[0], job.bdds[1], false);
+        ELSynthesisResult result = solver.run_EL();
+
+        BddArchive outcome;
+        outcome.kind = result_kind;
+        outcome.automaton_id = automaton_id;
+        outcome.values = {result.realizability ? 1 : 0};
+        outcome.bdds = {result.winning_states};
+        save_archive(outcome, root / (name + ".result"), var_mgr);
+        spdlog::debug("[DagWorkQueue::serve] solved {}", name);
+      } catch (const std::exception& ex) {
+        write_text(root / (name + ".error"), ex.what());
+      }
+      solved++;
+    }
+  }
+}
+
+std::size_t DagWorkQueue::serve(const std::string& directory, const VarMgrOptions& options,
+                                std::chrono::milliseconds poll) {
+  fs::path root(directory);
+  std::size_t solved = 0;
+  while (true) {
+    // A run is live once published and until it is done; a finished run left behind is skipped
+    std::optional<std::string> run = read_token(root / "arena.ready");
+    if (!run || read_token(root / "done") == run) {
+      std::this_thread::sleep_for(poll);
+      continue;
+    }
+    bool done = false;
+    try {
+      done = serve_run(root, *run, options, poll, solved);
+    } catch (const std::exception&) {
+      // The next coordinator may remove the files of a finished run while they are loaded
+      if (read_token(root / "arena.ready") == run) {
+        throw;
+      }
+    }
+    if (done) {
+      spdlog::info("[DagWorkQueue::serve] solved {} jobs", solved);
+      return solved;
+    }
+    spdlog::info("[DagWorkQueue::serve] the run {} was replaced, waiting for the next one", *run);
+  }
+}
+
+}
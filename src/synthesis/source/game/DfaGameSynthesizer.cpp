@@ -1,5 +1,10 @@
 #include "game/DfaGameSynthesizer.h"
+#include <spdlog/spdlog.h>
 #include <cassert>
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <utility>
 
 namespace Syft {
 
@@ -19,6 +24,7 @@ namespace Syft {
 
         CUDD::BDD input_cube = var_mgr_->input_cube();
         CUDD::BDD output_cube = var_mgr_->output_cube();
+        independent_cube_ = var_mgr_->cudd_mgr()->bddOne();
 
         // quantify_independent_variables_ quantifies all variables that the outputs
         // don't depend on (input variables if the agent plays first, or no variables
@@ -27,6 +33,7 @@ namespace Syft {
         if (starting_player_ == Player::Environment) {
             if (protagonist_player_ == Player::Environment) {
                 quantify_independent_variables_ = std::make_unique<Forall>(output_cube);
+                independent_cube_ = output_cube;
                 quantify_non_state_variables_ = std::make_unique<Exists>(input_cube);
             } else {
                 quantify_independent_variables_ = std::make_unique<NoQuantification>();
@@ -40,28 +47,187 @@ namespace Syft {
                                                                                input_cube);
             } else {
                 quantify_independent_variables_ = std::make_unique<Forall>(input_cube);
+                independent_cube_ = input_cube;
                 quantify_non_state_variables_ = std::make_unique<Exists>(output_cube);
             }
         }
-
-
+        kernel_ = GameKernel(starting_player_, protagonist_player_, input_cube, output_cube);
     }
 
     CUDD::BDD DfaGameSynthesizer::preimage(
             const CUDD::BDD &winning_states) const {
+        if (state_abstraction_) {
+            // Once the target is independent of the hidden bits, their transition
+            // functions are never composed
+            CUDD::BDD target = state_abstraction_->target(winning_states, var_mgr_->bdd_backend());
+            return cached_preimage(target);
+        }
+        return cached_preimage(winning_states);
+    }
+
+    CUDD::BDD DfaGameSynthesizer::cached_preimage(const CUDD::BDD &winning_states) const {
+        if (preimage_cache_) {
+            if (std::optional<CUDD::BDD> cached = preimage_cache_->find(winning_states)) {
+                return *cached;
+            }
+            CUDD::BDD moves = compute_preimage(winning_states);
+            preimage_cache_->insert(winning_states, moves);
+            return moves;
+        }
+        return compute_preimage(winning_states);
+    }
+
+    CUDD::BDD DfaGameSynthesizer::compute_preimage(const CUDD::BDD &winning_states) const {
+        if (preimage_engine_ == PreimageEngine::Partitioned) {
+            const PartitionedTransitionRelation &relation = partitioned_relation();
+            if (independent_cube_.IsOne()) {
+                return relation.MovePreimage(winning_states);
+            }
+            // The relation is a function of the current state and move, so
+            // forall c. exists s'. R & X(s') = !exists c, s'. R & !X(s')
+            return !relation.MovePreimage(!winning_states, independent_cube_);
+        }
+
         // Transitions that move into a winning state
-        CUDD::BDD winning_transitions =
-                winning_states.VectorCompose(transition_vector_);
+        const BddBackend &backend = var_mgr_->bdd_backend();
+        CUDD::BDD winning_transitions = product_arena_
+                                        ? product_arena_->preimage(winning_states)
+                                        : backend.VectorCompose(winning_states, transition_vector_);
 
         // std::cout << "winning_transitions: " << winning_transitions << std::endl;
 
         // Quantify all variables that the outputs don't depend on
-        return quantify_independent_variables_->apply(winning_transitions);
+        return kernel_.independent(winning_transitions, backend);
+    }
+
+    CUDD::BDD DfaGameSynthesizer::preimage(const CUDD::BDD &winning_states,
+                                           const CUDD::BDD &care_states) const {
+        if (preimage_engine_ != PreimageEngine::Compose || product_arena_) {
+            return care_states & preimage(winning_states);
+        }
+
+        // Identity except on the state variables, which get their next-state
+        // function simplified outside the care set
+        std::size_t total_variable_count = var_mgr_->total_variable_count();
+        std::vector<CUDD::BDD> compose_vector;
+        compose_vector.reserve(total_variable_count);
+        for (std::size_t i = 0; i < total_variable_count; ++i) {
+            compose_vector.push_back(var_mgr_->cudd_mgr()->bddVar(static_cast<int>(i)));
+        }
+        std::vector<CUDD::BDD> state_variables = var_mgr_->get_state_variables(spec_.automaton_id());
+        const std::vector<CUDD::BDD> &transition_function = spec_.transition_function();
+        for (std::size_t i = 0; i < state_variables.size(); ++i) {
+            compose_vector[state_variables[i].NodeReadIndex()] = transition_function[i].Restrict(care_states);
+        }
+
+        const BddBackend &backend = var_mgr_->bdd_backend();
+        CUDD::BDD target = state_abstraction_ ? state_abstraction_->target(winning_states, backend) : winning_states;
+        return care_states & kernel_.independent(backend.VectorCompose(target, compose_vector), backend);
+    }
+
+    CUDD::BDD DfaGameSynthesizer::predecessors(const CUDD::BDD &states) const {
+        if (state_abstraction_) {
+            return predecessors_of(state_abstraction_->some_successor(states, var_mgr_->bdd_backend()));
+        }
+        return predecessors_of(states);
+    }
+
+    CUDD::BDD DfaGameSynthesizer::predecessors_of(const CUDD::BDD &states) const {
+        if (preimage_engine_ == PreimageEngine::Partitioned) {
+            return partitioned_relation().Preimage(states);
+        }
+        CUDD::BDD transitions = product_arena_
+                                ? product_arena_->preimage(states)
+                                : states.VectorCompose(transition_vector_);
+        return transitions.ExistAbstract(var_mgr_->input_cube() * var_mgr_->output_cube());
+    }
+
+    std::vector<CUDD::BDD> DfaGameSynthesizer::successor_cubes(const CUDD::BDD &state, const CUDD::BDD &move) const {
+        // Each next-state bit as a function of the inputs alone
+        CUDD::BDD fixed_cube = var_mgr_->state_variables_cube(spec_.automaton_id()) * var_mgr_->output_cube();
+        CUDD::BDD fixed = state * move;
+        std::vector<CUDD::BDD> next_bits;
+        for (const CUDD::BDD &bit : spec_.transition_function()) {
+            next_bits.push_back(bit.AndAbstract(fixed, fixed_cube));
+        }
+
+        // Depth first over the bits, keeping the inputs that lead to each prefix
+        std::vector<CUDD::BDD> successors;
+        std::function<void(std::size_t, const CUDD::BDD &, const CUDD::BDD &)> split =
+                [&](std::size_t i, const CUDD::BDD &inputs, const CUDD::BDD &successor) {
+            if (i == next_bits.size()) {
+                successors.push_back(successor);
+                return;
+            }
+            CUDD::BDD var = var_mgr_->state_variable(spec_.automaton_id(), i);
+            CUDD::BDD high = inputs & next_bits[i];
+            if (!high.IsZero()) {
+                split(i + 1, high, successor & var);
+            }
+            CUDD::BDD low = inputs & !next_bits[i];
+            if (!low.IsZero()) {
+                split(i + 1, low, successor & !var);
+            }
+        };
+        split(0, var_mgr_->cudd_mgr()->bddOne(), var_mgr_->cudd_mgr()->bddOne());
+        return successors;
+    }
+
+    const PartitionedTransitionRelation &DfaGameSynthesizer::partitioned_relation() const {
+        if (!partitioned_relation_) {
+            std::size_t primed_automaton_id =
+                    var_mgr_->create_state_variables(var_mgr_->state_variable_count(spec_.automaton_id()));
+            partitioned_relation_ = std::make_unique<PartitionedTransitionRelation>(spec_, primed_automaton_id);
+        }
+        return *partitioned_relation_;
+    }
+
+    void DfaGameSynthesizer::set_fixpoint_mode(FixpointMode mode) {
+        fixpoint_mode_ = mode;
+    }
+
+    const FixpointTrace &DfaGameSynthesizer::fixpoint_trace() const {
+        return fixpoint_trace_;
+    }
+
+    void DfaGameSynthesizer::set_realizability_only(bool realizability_only) {
+        realizability_only_ = realizability_only;
+    }
+
+    void DfaGameSynthesizer::set_strategy_minimization(const StrategyMinimizationOptions &options) {
+        strategy_minimization_ = options;
+    }
+
+    void DfaGameSynthesizer::set_preimage_engine(PreimageEngine engine) {
+        preimage_engine_ = engine;
+    }
+
+    PreimageEngine DfaGameSynthesizer::preimage_engine() const {
+        return preimage_engine_;
+    }
+
+    void DfaGameSynthesizer::set_preimage_cache(std::shared_ptr<PreimageCache> cache) {
+        if (cache) {
+            cache->attach(spec_.automaton_id(), starting_player_, protagonist_player_);
+        }
+        preimage_cache_ = std::move(cache);
+    }
+
+    const std::shared_ptr<PreimageCache> &DfaGameSynthesizer::preimage_cache() const {
+        return preimage_cache_;
+    }
+
+    void DfaGameSynthesizer::set_state_abstraction(std::optional<StateAbstraction> abstraction) {
+        state_abstraction_ = std::move(abstraction);
+    }
+
+    const std::optional<StateAbstraction> &DfaGameSynthesizer::state_abstraction() const {
+        return state_abstraction_;
     }
 
     CUDD::BDD DfaGameSynthesizer::project_into_states(
             const CUDD::BDD &winning_moves) const {
-        return quantify_non_state_variables_->apply(winning_moves);
+        return kernel_.non_state(winning_moves, var_mgr_->bdd_backend());
     }
 
     bool DfaGameSynthesizer::includes_initial_state(
@@ -143,9 +309,86 @@ namespace Syft {
             const std::vector<CUDD::BDD>& transition_vector,
             Player starting_player) const {
         std::unordered_map<int, CUDD::BDD> strategy = synthesize_strategy(winning_moves, var_mgr);
+        // The transition vector of the spec, whose bits update its state variables
+        std::vector<CUDD::BDD> state_variables;
+        if (transition_vector.size() == var_mgr->state_variable_count(spec_.automaton_id())) {
+            state_variables = var_mgr->get_state_variables(spec_.automaton_id());
+            CUDD::BDD initial_state = var_mgr->state_vector_to_bdd(spec_.automaton_id(), spec_.initial_state());
+            minimize_strategy(var_mgr, strategy, winning_moves, initial_state, transition_vector, state_variables,
+                              strategy_minimization_);
+        }
         auto transducer = std::make_unique<Transducer>(var_mgr, initial_vector, strategy, transition_vector,
-                                                       starting_player);
+                                                       starting_player, Player::Agent, state_variables);
         return transducer;
     }
 
+    std::unique_ptr<Transducer> DfaGameSynthesizer::memory_transducer(const std::vector<CUDD::BDD> &moves,
+                                                                      const std::vector<std::vector<CUDD::BDD>> &next,
+                                                                      const std::string &caller) const {
+        if (starting_player_ != Player::Agent) {
+            throw std::runtime_error("Error: Symbolic strategy extraction requires the agent to move first");
+        }
+        auto mgr = var_mgr_->cudd_mgr();
+        CUDD::BDD zero = mgr->bddZero();
+        std::size_t memory_size = moves.size();
+        std::size_t memory_bits = 1;
+        while ((std::size_t(1) << memory_bits) < memory_size) {
+            memory_bits++;
+        }
+        std::size_t memory_automaton = var_mgr_->create_state_variables(memory_bits);
+        std::vector<CUDD::BDD> memory_cubes;
+        for (std::size_t id = 0; id < memory_size; ++id) {
+            std::vector<int> bits(memory_bits);
+            for (std::size_t b = 0; b < memory_bits; ++b) {
+                bits[b] = (id >> b) & 1;
+            }
+            memory_cubes.push_back(var_mgr_->state_vector_to_bdd(memory_automaton, bits));
+        }
+
+        // Winning moves and memory updates as relations over states, memory and outputs
+        CUDD::BDD strategy = zero;
+        std::vector<CUDD::BDD> memory_update(memory_bits, zero);
+        for (std::size_t id = 0; id < memory_size; ++id) {
+            strategy |= memory_cubes[id] & moves[id];
+            for (std::size_t next_id = 0; next_id < next[id].size(); ++next_id) {
+                for (std::size_t b = 0; b < memory_bits; ++b) {
+                    if ((next_id >> b) & 1) {
+                        memory_update[b] |= memory_cubes[id] & next[id][next_id];
+                    }
+                }
+            }
+        }
+
+        // One output per state and memory value, substituted into the memory update
+        std::unordered_map<int, CUDD::BDD> output_function = synthesize_strategy(strategy, var_mgr_);
+        std::vector<CUDD::BDD> state_variables = var_mgr_->get_state_variables(spec_.automaton_id());
+        std::vector<CUDD::BDD> memory_variables = var_mgr_->get_state_variables(memory_automaton);
+        state_variables.insert(state_variables.end(), memory_variables.begin(), memory_variables.end());
+        if (strategy_minimization_.method != StrategyMinimization::Off) {
+            std::vector<CUDD::BDD> updates = spec_.transition_function();
+            updates.insert(updates.end(), memory_update.begin(), memory_update.end());
+            CUDD::BDD initial_state = var_mgr_->state_vector_to_bdd(spec_.automaton_id(), spec_.initial_state()) &
+                                      memory_cubes[0];
+            minimize_strategy(var_mgr_, output_function, strategy, initial_state, updates, state_variables,
+                              strategy_minimization_);
+        }
+        std::vector<CUDD::BDD> compose_vector;
+        for (std::size_t i = 0; i < var_mgr_->total_variable_count(); ++i) {
+            compose_vector.push_back(mgr->bddVar(static_cast<int>(i)));
+        }
+        for (const auto &[index, function] : output_function) {
+            compose_vector[index] = function;
+        }
+        std::vector<CUDD::BDD> transition_function = spec_.transition_function();
+        for (const CUDD::BDD &update : memory_update) {
+            transition_function.push_back(update.VectorCompose(compose_vector));
+        }
+        spdlog::info("[{}] {} memory values on {} variables, strategy nodes={}", caller, memory_size, memory_bits,
+                     strategy.nodeCount());
+
+        return std::make_unique<Transducer>(var_mgr_, var_mgr_->make_eval_vector(spec_.automaton_id(), spec_.initial_state()),
+                                            output_function, transition_function, starting_player_, protagonist_player_,
+                                            state_variables);
+    }
+
 }
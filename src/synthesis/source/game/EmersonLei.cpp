@@ -1,815 +1,1388 @@
-//
-// Created by dh on 25/11/24.
-//
-
-#include "game/EmersonLei.hpp"
-#include "debug.hpp"
-#include <spdlog/spdlog.h>
-#include <cstdlib>
-#include <exception>
-
-namespace Syft {
-  EmersonLei::EmersonLei(const SymbolicStateDfa &spec, std::string color_formula, Player starting_player,
-                         Player protagonist_player,
-                         const std::vector<CUDD::BDD> &colorBDDs,
-                         const CUDD::BDD &state_space,
-                         const CUDD::BDD &instant_winning,
-                         const CUDD::BDD &instant_losing,
-                         bool adv_mp)
-    : DfaGameSynthesizer(spec, starting_player, protagonist_player), color_formula_(color_formula), Colors_(colorBDDs),
-      state_space_(state_space), instant_winning_(instant_winning), instant_losing_(instant_losing), adv_mp_(adv_mp) {
-
-        // Just for debugging, dump the DFA as json
-    //spec_.dump_json("EmersonLei_spec.json");
-
-    // build Zielonka tree; parse formula from PHI_FILE, number of colors taken from Colors
-    spdlog::info("[EmersonLei::EmersonLei] building Zielonka tree");
-    z_tree_ = new ZielonkaTree(color_formula_, Colors_, var_mgr_);
-    spdlog::info("[EmersonLei::EmersonLei] built Zielonka tree");
-    z_tree_->displayZielonkaTree();
-    if (const char* dump_path = std::getenv("SYFT_ZIELONKA_DOT")) {
-      try {
-        z_tree_->dump_dot(dump_path);
-        spdlog::info("[EmersonLei::EmersonLei] dumped Zielonka tree to {}", dump_path);
-      } catch (const std::exception& ex) {
-        spdlog::warn("[EmersonLei::EmersonLei] failed to dump Zielonka tree: {}", ex.what());
-      }
-    }
-  }
-
-  CUDD::BDD EmersonLei::getOneUnprocessedState(CUDD::BDD states, CUDD::BDD processed) const {
-    if (DEBUG_MODE) {
-      std::cout << "states: " << states << "\n";
-      std::cout << "processed: " << processed << "\n";
-    }
-
-    DdNode *rawNode = (states * (!processed)).getNode();
-    if (DEBUG_MODE) {
-      // std::cout << "gameNode * winningmoves: " << gameNode * winningmoves << "\n";
-      // std::cout << "winningmoves: " << winningmoves << "\n";
-    }
-    CUDD::BDD Zs(*(var_mgr_->cudd_mgr()), rawNode);
-    if (DEBUG_MODE) {
-      std::cout << "All possible Zs: " << Zs << "\n";
-    }
-
-    int n_vars = var_mgr_->total_variable_count();
-    int *cube = nullptr;
-    CUDD_VALUE_TYPE value;
-    DdGen *g = Cudd_FirstCube(Zs.manager(), Zs.getNode(), &cube, &value);
-    assert(g != nullptr);
-    std::vector<uint8_t> Z_value = std::vector<uint8_t>(cube, cube + n_vars);
-    CUDD::BDD Z = var_mgr_->cudd_mgr()->bddOne();
-    std::vector<std::string> Z_names = var_mgr_->state_variable_labels(spec_.automaton_id());
-    for (auto var_name: Z_names) {
-      CUDD::BDD var = var_mgr_->name_to_variable(var_name);
-      int var_index = var.NodeReadIndex();
-      int var_value = static_cast<int>(cube[var_index]);
-      if (var_value == 2) {
-        // continue;
-        Z = Z * var;
-      } else if (var_value == 1) {
-        Z = Z * var;
-      } else {
-        Z = Z * !var;
-      }
-    }
-    return Z;
-  }
-
-// spdlog handles timestamps and formatting automatically
-
-
-  SynthesisResult EmersonLei::run() const {
-    SynthesisResult result;
-    result.realizability = true;
-    result.winning_states = var_mgr_->cudd_mgr()->bddZero();
-    result.winning_moves = var_mgr_->cudd_mgr()->bddZero();
-    result.transducer = nullptr;
-    return result;
-  }
-
-  ELSynthesisResult EmersonLei::run_EL() const {
-    if (DEBUG_MODE) {
-      std::cout << "Colors: \n";
-      for (size_t i = 0; i < Colors_.size(); i++) {
-        std::cout << Colors_[i] << '\n';
-      }
-    }
-    spdlog::info("[EmersonLei::run_EL] starting EmersonLeiSolve");
-    // Optionally run embedded Büchi-style double-fixpoint solver (often faster for some inputs)
-    CUDD::BDD winning_states;
-    if (use_embedded_buchi_) {
-      spdlog::info("[EmersonLei::run_EL] using embedded Büchi double-fixpoint algorithm");
-      winning_states = BuchiAlgorithm();
-    } else {
-      // solve EL game for root of Zielonka tree and BDD encoding emptyset as set of states currently assumed to be winning
-      winning_states = EmersonLeiSolve(z_tree_->get_root(), instant_winning_);
-    }
-    // std::cout << "winning_states: " << winning_states << std::endl;
-    // std::cout << "initial: " << spec_.initial_state_bdd() << "\n";
-    // var_mgr_->dump_dot(winning_states.Add(), "winning_states.dot");
-    // update result according to computed solution
-    ELSynthesisResult result;
-    if (includes_initial_state(winning_states)) {
-      result.realizability = true;
-      result.winning_states = winning_states;
-      result.z_tree = z_tree_;
-      EL_output_function op;
-      
-      if (STRATEGY) {
-        result.output_function = ExtractStrategy_Explicit(op, winning_states, spec_.initial_state_bdd(),
-                                                          z_tree_->get_root());
-      }
-      return result;
-    } else {
-      result.realizability = false;
-      result.winning_states = winning_states;
-      EL_output_function op;
-
-      if (STRATEGY) {
-        CUDD::BDD processed = var_mgr_->cudd_mgr()->bddZero();
-        while ((winning_states | !processed) != var_mgr_->cudd_mgr()->bddOne()) {
-        // while (winning_states.Xnor(processed) != var_mgr_->cudd_mgr()->bddOne()) {
-          // std::cout << "winning_states: " << winning_states << "\n";
-          // std::cout << "processed: " << processed << "\n";
-  
-          CUDD::BDD unprocessed_state = getOneUnprocessedState(winning_states, processed);
-          EL_output_function temp = ExtractStrategy_Explicit(op, winning_states, unprocessed_state,
-                                                          z_tree_->get_root());
-          for (auto item : temp) {
-            processed = processed | item.gameNode;
-          }
-          op = temp;
-        }
-      }
-      result.output_function = op;
-      return result;
-    }
-  }
-
-
-  int EmersonLei::index_below(ZielonkaNode *anchor_node, ZielonkaNode *old_memory) const {
-    if (old_memory == anchor_node) {
-      return 0;
-    } else {
-      if ((old_memory->parent) == anchor_node) {
-        for (int i = 0; i < (old_memory->parent)->children.size(); i++) {
-          if (old_memory == (old_memory->parent)->children[i]) {
-            return i;
-          }
-        }
-      } else {
-        return index_below(anchor_node, old_memory->parent);
-      }
-    }
-    return -1;
-  }
-
-  ZielonkaNode *EmersonLei::get_anchor(CUDD::BDD game_node, ZielonkaNode *t) const {
-    if (t->order == 1) {
-      return t;
-    }
-    CUDD::BDD restricted = game_node * t->targetnodes;
-    if (restricted != var_mgr_->cudd_mgr()->bddZero()) {
-      return t->parent;
-    } else {
-      return (get_anchor(game_node, t->parent));
-    }
-  }
-
-  ZielonkaNode *EmersonLei::get_leaf(ZielonkaNode *old_memory, ZielonkaNode *anchor_node, ZielonkaNode *curr,
-                                     CUDD::BDD Y) const {
-    // case: a leaf has been reached
-    if (curr->children.empty()) {
-      return curr;
-    }
-
-    // case: a leaf has not been reached and current node is winning
-    if (curr->winning) {
-      int old_branch = 0;
-      if (curr == anchor_node) {
-        // compute branching direction from anchor_node to old_memory
-        old_branch = index_below(anchor_node, old_memory);
-      }
-      // move one to the right, cycling back to 0 if old_branch is rightmost direction
-      int next_branch = (old_branch + 1) % (curr->children.size());
-      // find leaf below the new branching direction
-      return get_leaf(old_memory, anchor_node, curr->children[next_branch], Y);
-    } else {
-      // find branching direction from curr that allows system choice Y
-      int branch = 0;
-      while (branch < curr->children.size()) {
-        CUDD::BDD restricted = (Y * curr->winningmoves[branch]).ExistAbstract(var_mgr_->output_cube());
-        if (restricted != var_mgr_->cudd_mgr()->bddZero()) {
-          break;
-        }
-        branch++;
-      }
-      // find leaf below that branching direction
-      return get_leaf(old_memory, anchor_node, curr->children[branch], Y);
-    }
-  }
-
-  EL_output_function EmersonLei::ExtractStrategy_Explicit(EL_output_function op, CUDD::BDD winning_states,
-                                                          CUDD::BDD gameNode, ZielonkaNode *t) const {
-
-    //	t: tree node, s (anchor node): lowest ancester of t that includes all colors of gameNode
-    EL_output_function temp = op;
-    // stop recursion if the strategy has already been defined for (gameNode,t)
-
-    if (DEBUG_MODE) {
-      std::cout << "-----------\ngameNode: " << gameNode;
-      gameNode.PrintCover();
-      std::cout << "tree node: " << t->order << "\n";
-    }
-
-    std::pair<CUDD::BDD, ZielonkaNode *> curr;
-    curr.first = gameNode;
-    curr.second = t;
-    for (auto item: op) {
-      if (DEBUG_MODE) {
-        std::cout << item.gameNode << " " << item.t->order << "\n";
-        std::cout << item.Y << " " << item.u->order << "\n";
-      }
-      if ( (item.t->order == t->order)) {
-        // if ((item.gameNode.Xnor(gameNode) == var_mgr_->cudd_mgr()->bddOne())) {
-        if ((item.gameNode | !(gameNode)) == var_mgr_->cudd_mgr()->bddOne()) {
-          if (DEBUG_MODE) {
-            std::cout << "defined! " << gameNode << " " << t->order << "\n";
-            gameNode.PrintCover();
-            std::cout << "stored " << item.gameNode << " " << item.t->order << "\n";
-            item.gameNode.PrintCover();
-          }
-          return temp;
-        }
-      }
-    }
-
-    // the following assumes that system moves first and environment moves second
-
-    ZielonkaNode *s = get_anchor(gameNode, t);
-
-    // BDD that will be used to encode a single choice for system, default bddZero
-    CUDD::BDD Y = var_mgr_->cudd_mgr()->bddZero();
-
-    // pick one choice for system that is winning for system from gameNode for objective s
-    if (s->children.empty()) {
-      // have just a single winningmoves BDD
-      Y = getUniqueSystemChoice(gameNode, s->winningmoves[0]);
-      // Y = getUniqueSystemChoice(gameNode,s->winningmoves[0]);
-    } else {
-      // iterate through all winningmoves BDD until a choice for system is found that is winning from gameNode for objective s; one is guaranteed to be found
-      for (int i = 0; i < s->children.size(); i++) {
-        Y = getUniqueSystemChoice(gameNode, s->winningmoves[i]);
-        if (Y != var_mgr_->cudd_mgr()->bddZero()) {
-          break;
-        }
-      }
-    }
-
-    // get next memory value; t: old memory value, s: anchor node, move: system choice that has been picked
-    ZielonkaNode *u = get_leaf(t, s, s, Y);
-
-    // add system choice and resulting new memory to extracted strategy,
-    // currently assumes result has component "strategy" which is vector of (gameNode, ZielonkaNode), (CUDD::BDD,ZielonkaNode)
-    ELWinningMove move;
-    move.gameNode = gameNode;
-    move.t = t;
-    move.Y = Y;
-    move.u = u;
-    temp.push_back(move);
-    if (DEBUG_MODE) {
-      std::cout << " --> \n";
-      std::cout << "Y: " << Y << "\n";
-      std::cout << "tree node: " << u->order << "\n\n";
-    }
-
-    // compute game nodes that can result by taking system choice from gameNode
-    //TODO
-    std::vector<CUDD::BDD> newGameNodes = getSuccsWithYZ(gameNode, Y);
-
-    // continue strategy construction with each possible new game node and the new memory value
-    for (int i = 0; i < newGameNodes.size(); i++) {
-      EL_output_function temp_new = ExtractStrategy_Explicit(temp, winning_states, newGameNodes[i], u);
-      temp = temp_new;
-    }
-    return temp;
-  }
-  /*
-  EmersonLei::OneStepSynReturn EmersonLei::ExtractStrategy_Explicit_OneStep(EL_output_function op, CUDD::BDD winning_states,
-                                                          CUDD::BDD gameNode, ZielonkaNode *t, CUDD::BDD X) const {
-    //	t: tree node, s (anchor node): lowest ancester of t that includes all colors of gameNode
-    EL_output_function temp = op;
-    // stop recursion if the strategy has already been defined for (gameNode,t)
-
-    // std::cout << "-----------\ngameNode: " << gameNode;
-    // gameNode.PrintCover();
-    // std::cout << "tree node: " << t->order << "\n";
-
-    std::pair<CUDD::BDD, ZielonkaNode *> curr;
-    curr.first = gameNode;
-    curr.second = t;
-    for (auto item: op) {
-      // std::cout << item.gameNode << " " << item.t->order << "\n";
-      // std::cout << item.Y << " " << item.u->order << "\n";
-      if ((item.gameNode.Xnor(gameNode) == var_mgr_->cudd_mgr()->bddOne()) && (item.t->order == t->order)) {
-        // std::cout << "defined! " << gameNode << " " << t->order << "\n";
-        // gameNode.PrintCover();
-        // std::cout << "stored " << item.gameNode << " " << item.t->order << "\n";
-        // item.gameNode.PrintCover();
-        OneStepSynReturn res;
-        res.op_ = op;
-        res.game_state_ = gameNode;
-        res.tree_node_ = t->order;
-        res.Y_ = item.Y;
-        return res;
-      }
-    }
-
-    // the following assumes that system moves first and environment moves second
-
-    ZielonkaNode *s = get_anchor(gameNode, t);
-
-    // BDD that will be used to encode a single choice for system, default bddZero
-    CUDD::BDD Y = var_mgr_->cudd_mgr()->bddZero();
-
-    // pick one choice for system that is winning for system from gameNode for objective s
-    if (s->children.empty()) {
-      // have just a single winningmoves BDD
-      Y = getUniqueSystemChoice(gameNode, s->winningmoves[0]);
-      // Y = getUniqueSystemChoice(gameNode,s->winningmoves[0]);
-    } else {
-      // iterate through all winningmoves BDD until a choice for system is found that is winning from gameNode for objective s; one is guaranteed to be found
-      for (int i = 0; i < s->children.size(); i++) {
-        Y = getUniqueSystemChoice(gameNode, s->winningmoves[i]);
-        if (Y != var_mgr_->cudd_mgr()->bddZero()) {
-          break;
-        }
-      }
-    }
-
-    // get next memory value; t: old memory value, s: anchor node, move: system choice that has been picked
-    ZielonkaNode *u = get_leaf(t, s, s, Y);
-
-    // add system choice and resulting new memory to extracted strategy,
-    // currently assumes result has component "strategy" which is vector of (gameNode, ZielonkaNode), (CUDD::BDD,ZielonkaNode)
-    ELWinningMove move;
-    move.gameNode = gameNode;
-    move.t = t;
-    move.Y = Y;
-    move.u = u;
-    temp.push_back(move);
-    // std::cout << " --> \n";
-    // std::cout << "Y: " << Y << "\n";
-    // std::cout << "tree node: " << u->order << "\n\n";
-
-    // compute game nodes that can result by taking system choice from gameNode
-    CUDD::BDD newGameNode = getSuccsWithXYZ(gameNode, Y, X);
-
-
-    EL_output_function temp_new = ExtractStrategy_Explicit(temp, winning_states, newGameNode, u);
-    OneStepSynReturn res;
-    res.op_ = temp_new;
-    res.game_state_ = newGameNode;
-    res.tree_node_ = u->order;
-    res.Y_ = Y;
-
-    return res;
-  }
-*/
-  CUDD::BDD EmersonLei::getSuccsWithXYZ(CUDD::BDD gameNode, CUDD::BDD Y, CUDD::BDD X) const {
-    std::vector<CUDD::BDD> succs;
-    std::vector<CUDD::BDD> transition_vector = transition_function();
-    std::vector<CUDD::BDD> transition_vector_fix_Y_Z;
-    for (int i = 0; i < transition_vector.size(); i++) {
-      CUDD::BDD transition_fix_Y_Z = (transition_vector[i] * gameNode * Y * X).ExistAbstract(
-        var_mgr_->state_variables_cube(spec_id())).ExistAbstract(var_mgr_->output_cube()).ExistAbstract(var_mgr_->input_cube());
-      transition_vector_fix_Y_Z.push_back(transition_fix_Y_Z);
-    }
-
-    CUDD::BDD succ = var_mgr_->cudd_mgr()->bddOne();
-    for (int i = 0; i < transition_vector_fix_Y_Z.size(); i++) {
-      CUDD::BDD Z_var = var_mgr_->state_variable(spec_id(), i);
-      if (transition_vector_fix_Y_Z[i].IsOne()) {
-        succ = succ * Z_var;
-      } else {
-        succ = succ * !Z_var;
-      }
-    }
-    return succ;
-  }
-
-  std::vector<CUDD::BDD> EmersonLei::getSuccsWithYZ(CUDD::BDD gameNode, CUDD::BDD Y) const {
-    std::vector<CUDD::BDD> succs;
-    std::vector<CUDD::BDD> transition_vector = transition_function();
-    std::vector<CUDD::BDD> transition_vector_fix_Y_Z;
-    for (int i = 0; i < transition_vector.size(); i++) {
-      CUDD::BDD transition_fix_Y_Z = (transition_vector[i] * gameNode * Y).ExistAbstract(
-        var_mgr_->state_variables_cube(spec_id())).ExistAbstract(var_mgr_->output_cube());
-      transition_vector_fix_Y_Z.push_back(transition_fix_Y_Z);
-    }
-    std::vector<std::string> X_labels = var_mgr_->input_variable_labels();
-    int total = 1 << X_labels.size(); // 2^n
-    for (int mask = 0; mask < total; ++mask) {
-      std::vector<int> values(var_mgr_->total_variable_count(), 0);
-      for (int i = 0; i < X_labels.size(); ++i) {
-        CUDD::BDD X_var = var_mgr_->name_to_variable(X_labels[i]);
-        values[X_var.NodeReadIndex()] = (mask >> i) & 1; // Extract the i-th bit
-      }
-      std::vector<int> copy(values);
-      CUDD::BDD succ = var_mgr_->cudd_mgr()->bddOne();
-      for (int i = 0; i < transition_vector_fix_Y_Z.size(); i++) {
-        CUDD::BDD Z_var = var_mgr_->state_variable(spec_id(), i);
-        if (transition_vector_fix_Y_Z[i].Eval(copy.data()).IsOne()) {
-          succ = succ * Z_var;
-        } else {
-          succ = succ * !Z_var;
-        }
-      }
-      succs.push_back(succ);
-    }
-    return succs;
-  }
-
-
-  CUDD::BDD EmersonLei::getUniqueSystemChoice(CUDD::BDD gameNode, CUDD::BDD winningmoves) const {
-    DdNode *rawNode = Cudd_bddRestrict(var_mgr_->cudd_mgr()->getManager(), winningmoves.getNode(), gameNode.getNode());
-    // std::cout << "gameNode * winningmoves: " << gameNode * winningmoves << "\n";
-    if (DEBUG_MODE) {
-      std::cout << "winningmoves: " << winningmoves << "\n";
-    }
-    CUDD::BDD Ys(*(var_mgr_->cudd_mgr()), rawNode);
-    if (DEBUG_MODE) {
-      std::cout << "All possible Ys: " << Ys << "\n";
-    }
-    int n_vars = var_mgr_->total_variable_count();
-    int *cube = nullptr;
-    CUDD_VALUE_TYPE value;
-    DdGen *g = Cudd_FirstCube(Ys.manager(), Ys.getNode(), &cube, &value);
-    assert(g != nullptr);
-    std::vector<uint8_t> Y_Z_value = std::vector<uint8_t>(cube, cube + n_vars);
-    CUDD::BDD Y = var_mgr_->cudd_mgr()->bddOne();
-    std::vector<std::string> Y_names = var_mgr_->output_variable_labels();
-    for (auto var_name: Y_names) {
-      CUDD::BDD var = var_mgr_->name_to_variable(var_name);
-      int var_index = var.NodeReadIndex();
-      int var_value = static_cast<int>(cube[var_index]);
-      if (var_value == 2) {
-        // continue;
-        Y = Y * var;
-      } else if (var_value == 1) {
-        Y = Y * var;
-      } else {
-        Y = Y * !var;
-      }
-    }
-    return Y;
-  }
-
-  CUDD::BDD EmersonLei::cpre(ZielonkaNode *t, int i, CUDD::BDD target) const {
-    CUDD::BDD result;
-    if (DEBUG_MODE) {
-  spdlog::debug("[cpre] entering cpre: node={} idx={} target_nodes={}", t->order, i, target.nodeCount());
-    }
-
-    if (starting_player_ == Player::Agent) {
-      CUDD::BDD quantified_X_transitions_to_winning_states = preimage(target);
-      if (DEBUG_MODE) {
-  spdlog::debug("[cpre] quantified_X_transitions_to_winning_states nodes={}", quantified_X_transitions_to_winning_states.nodeCount());
-      }
-      //             CUDD::BDD new_target_moves = target |
-      //                                 (state_space_ & (!target) & quantified_X_transitions_to_winning_states);
-      //             result = project_into_states(new_target_moves);
-      // CUDD::BDD diffmoves = (result & (!target) & quantified_X_transitions_to_winning_states);
-      if (t->winning) {
-        CUDD::BDD new_target_moves;
-        if (adv_mp_) {
-          new_target_moves = (state_space_ & quantified_X_transitions_to_winning_states);
-        } else {
-          new_target_moves = (state_space_ & quantified_X_transitions_to_winning_states) & (!instant_losing_);
-        }
-        
-        result = project_into_states(new_target_moves);
-        if (DEBUG_MODE) {
-          spdlog::debug("[cpre] project_into_states(new_target_moves) nodes={}", project_into_states(new_target_moves).nodeCount());
-          spdlog::debug("[cpre] result nodes={}", result.nodeCount());
-          spdlog::debug("[cpre] winningmoves_before nodes={}", t->winningmoves[i].nodeCount());
-        }
-        // CUDD::BDD diffmoves = (result & (!target) & quantified_X_transitions_to_winning_states);
-        t->winningmoves[i] = t->winningmoves[i] & new_target_moves;
-        if (DEBUG_MODE) {
-          spdlog::debug("[cpre] winningmoves_after nodes={}", t->winningmoves[i].nodeCount());
-        }
-      } else {
-        CUDD::BDD new_target_moves_with_loops;
-        if (adv_mp_) {
-          new_target_moves_with_loops = (state_space_ & quantified_X_transitions_to_winning_states);
-        } else {
-          new_target_moves_with_loops = (state_space_ & quantified_X_transitions_to_winning_states) & (!instant_losing_);
-        }
-        
-        CUDD::BDD new_target_moves = (!target) & new_target_moves_with_loops;
-        result = project_into_states(new_target_moves_with_loops);
-        if (DEBUG_MODE) {
-          spdlog::debug("[cpre] project_into_states(new_target_moves_with_loops) nodes={}", project_into_states(new_target_moves_with_loops).nodeCount());
-          spdlog::debug("[cpre] result nodes={}", result.nodeCount());
-          spdlog::debug("[cpre] winningmoves_before nodes={}", t->winningmoves[i].nodeCount());
-        }
-        // CUDD::BDD diffmoves = (result & (!target) & quantified_X_transitions_to_winning_states);
-        t->winningmoves[i] = t->winningmoves[i] | new_target_moves;
-        if (DEBUG_MODE) {
-          spdlog::debug("[cpre] winningmoves_after nodes={}", t->winningmoves[i].nodeCount());
-        }
-      }
-    } else {
-      //TODO need to double-check
-      CUDD::BDD transitions_to_target_states = preimage(target);
-      if (DEBUG_MODE) {
-      spdlog::debug("[cpre] transitions_to_target_states nodes={}", transitions_to_target_states.nodeCount());
-      }
-      if (t->winning) {
-        result = state_space_ & project_into_states(transitions_to_target_states);
-        if (DEBUG_MODE) {
-          spdlog::debug("[cpre] project_into_states(transitions_to_target_states) nodes={}", project_into_states(transitions_to_target_states).nodeCount());
-          spdlog::debug("[cpre] result nodes={}", result.nodeCount());
-          spdlog::debug("[cpre] winningmoves_before nodes={}", t->winningmoves[i].nodeCount());
-        }
-        // result = target | new_collected_target_states;
-        CUDD::BDD new_target_moves;
-        if (adv_mp_) {
-          new_target_moves = (result & transitions_to_target_states);
-        } else {
-          new_target_moves = (result & transitions_to_target_states) & (!instant_losing_);
-        }
-        // CUDD::BDD diffmoves = (!target) & transitions_to_target_states;
-        t->winningmoves[i] = t->winningmoves[i] & new_target_moves;
-        if (DEBUG_MODE) {
-          spdlog::debug("[cpre] winningmoves_after nodes={}", t->winningmoves[i].nodeCount());
-        }
-      } else {
-        result = state_space_ & project_into_states(transitions_to_target_states);
-        if (DEBUG_MODE) {
-          std::cout << "[cpre] project_into_states(transitions_to_target_states) nodes=" << project_into_states(transitions_to_target_states).nodeCount() << "\n";
-          std::cout << "[cpre] result nodes=" << result.nodeCount() << "\n";
-          std::cout << "[cpre] winningmoves_before nodes=" << t->winningmoves[i].nodeCount() << "\n";
-        }
-        // result = target | new_collected_target_states;
-        
-        CUDD::BDD new_target_moves;
-        if (adv_mp_) {
-          new_target_moves = (!target) & result & transitions_to_target_states;
-        } else {
-          new_target_moves = (!target) & result & transitions_to_target_states & (!instant_losing_);
-        }
-        t->winningmoves[i] = t->winningmoves[i] | new_target_moves;
-        if (DEBUG_MODE) {
-          std::cout << "[cpre] winningmoves_after nodes=" << t->winningmoves[i].nodeCount() << "\n";
-        }
-      }
-    }
-      if (DEBUG_MODE) {
-  spdlog::debug("[cpre] exiting cpre: result nodes={}", result.nodeCount());
-    }
-    return result;
-  }
-
-  CUDD::BDD EmersonLei::EmersonLeiSolve(ZielonkaNode *t, CUDD::BDD term) const {
-    if (DEBUG_MODE) {
-      std::cout << "state space: " << state_space_ << std::endl;
-      std::cout << "term: " << term << std::endl;
-    }
-    CUDD::BDD X, XX;
-
-    // lightweight entry log (debug level for recursive calls)
-    spdlog::debug("[EmersonLeiSolve] entering node={} initial_X_nodes={}", t->order, (var_mgr_->cudd_mgr()->bddOne()).nodeCount());
-
-    // initialize variables for fixpoint computation (gfp for winning / lfp for losing)
-    if (t->winning) {
-      X = var_mgr_->cudd_mgr()->bddOne();
-      if (t->children.empty()) {
-        // t->winningmoves[0]=var_mgr_->cudd_mgr()->bddOne();
-        // t->winningmoves.push_back(var_mgr_->cudd_mgr()->bddOne());
-        
-        if (adv_mp_) {
-          t->winningmoves.push_back(state_space_);
-        } else {
-          t->winningmoves.push_back(!instant_losing_);
-        }
-      } else {
-        for (int i = 0; i < t->children.size(); i++) {
-          //t->winningmoves[i] = var_mgr_->cudd_mgr()->bddOne();
-          // t->winningmoves.push_back(var_mgr_->cudd_mgr()->bddOne());
-          if (adv_mp_) {
-            t->winningmoves.push_back(state_space_);
-          } else {
-            t->winningmoves.push_back(!instant_losing_);
-          }
-          
-        }
-      }
-    } else {
-      X = var_mgr_->cudd_mgr()->bddZero();
-      if (t->children.empty()) {
-        // t->winningmoves[0]=var_mgr_->cudd_mgr()->bddZero();
-        t->winningmoves.push_back(var_mgr_->cudd_mgr()->bddZero());
-      } else {
-        for (int i = 0; i < t->children.size(); i++) {
-          // t->winningmoves[i] = var_mgr_->cudd_mgr()->bddZero();
-          t->winningmoves.push_back(var_mgr_->cudd_mgr()->bddZero());
-        }
-      }
-    }
-    if (DEBUG_MODE) {
-      std::cout << "Node: " << t->order << "\n";
-      std::cout << X << "\n";
-    }
-
-    // loop until fixpoint has stabilized
-    int outer_iter = 0;
-    while (true) {
-      outer_iter++;
-      int inner_iter = 0;
-      if (DEBUG_MODE) {
-  spdlog::debug("[EmersonLeiSolve] Node: {} outer_iter={}", t->order, outer_iter);
-  spdlog::debug("[EmersonLeiSolve] X nodes={}", X.nodeCount());
-  spdlog::debug("instant winning: {}", instant_winning_.nodeCount());
-  spdlog::debug("instant losing: {}", instant_losing_.nodeCount());
-      }
-
-      // lightweight per-outer-iteration info log; includes inner iteration count later
-      // we'll update this after computing XX to include inner_iter and XX.nodeCount()
-
-      // if t is a leaf
-        if (t->children.empty()) {
-        
-        // std::cout << "t->safenodes:" <<  t->safenodes << "\n";
-        // XX = term | (t->safenodes & cpre(t, 0, X & (!instant_losing_)));
-        if (adv_mp_) {
-          inner_iter++;
-          {
-            auto t0 = std::chrono::steady_clock::now();
-            XX = term | (t->safenodes & cpre(t, 0, X | instant_winning_));
-            auto t1 = std::chrono::steady_clock::now();
-            //if (DEBUG_MODE) {
-              auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
-              spdlog::debug("[EmersonLeiSolve] cpre(child leaf) took={} ms", ms);
-            //}
-          }
-        } else {
-          inner_iter++;
-          XX = term | (t->safenodes & cpre(t, 0, X & (!instant_losing_)));
-        }
-        // std::cout << "cpre:" << cpre(t, 0, X & (!instant_losing_)) << "\n";
-        
-      }
-
-      // if t is not a leaf
-      else {
-        // initialize intersecion for winning / union for losing
-        if (t->winning) {
-          XX = var_mgr_->cudd_mgr()->bddOne();
-        } else {
-          XX = var_mgr_->cudd_mgr()->bddZero();
-        }
-
-        // iterate over direct children of t
-        // for (auto s : t->children) {
-        for (int i = 0; i < t->children.size(); i++) {
-          // add new choice to term
-          auto s = t->children[i];
-          CUDD::BDD current_term;
-
-          if (DEBUG_MODE) {
-            std::cout << "i: " << i << "\n";
-          }
-
-            if (adv_mp_){
-            inner_iter++;
-            auto t0 = std::chrono::steady_clock::now();
-            current_term = term | (s->targetnodes & cpre(t, i, X | instant_winning_));
-            auto t1 = std::chrono::steady_clock::now();
-            if (DEBUG_MODE) {
-              auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
-              spdlog::debug("[EmersonLeiSolve] cpre(child non-leaf) idx={} took={} ms", i, ms);
-            }
-          } else {
-            inner_iter++;
-            auto t0 = std::chrono::steady_clock::now();
-            current_term = term | (s->targetnodes & cpre(t, i, X & (!instant_losing_)));
-            auto t1 = std::chrono::steady_clock::now();
-            //if (DEBUG_MODE) {
-              auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
-              spdlog::debug("[EmersonLeiSolve] cpre(child non-leaf) idx={} took={} ms", i, ms);
-            //}
-          }
-          
-          // std::cout << "cpre:" << instant_winning_ << "\n";
-          
-          if (t->winning) {
-            // intersect with recursively computed solution for s and current term
-            XX &= EmersonLeiSolve(s, current_term);
-          } else {
-            // union with recursively computed solution for s and current term
-            XX |= EmersonLeiSolve(s, current_term);
-          }
-        }
-      }
-     if (DEBUG_MODE) {
-  spdlog::debug("[EmersonLeiSolve] outer_iter={} inner_iter={} X_nodes={} XX_nodes={}", outer_iter, inner_iter, X.nodeCount(), XX.nodeCount());
-        //var_mgr_->dump_dot(XX.Add(), "XX.dot");
-    }
-
-  // Info-level trace of the fixpoint progress for lightweight logging/monitoring
-  spdlog::info("[EmersonLeiSolve] node={} outer_iter={} inner_iter={} X_nodes={} XX_nodes={}",
-       t->order, outer_iter, inner_iter, X.nodeCount(), XX.nodeCount());
-
-      if (X == XX) {
-        break;
-      } else {
-        X = XX;
-      }
-    }
-
-    // return stabilized fixpoint
-    return X;
-  }
-
-
-  // A small, copy of the classic Büchi double-fixpoint (nu X. mu Y. (F ∩ CPre(X)) ∪ CPre(Y) ∪ Y)
-  // Implemented here inside EmersonLei so we can compare performance with the EL solver.
-  // Aligned to match EL solver's cpre pattern: restrict to state_space early, apply instant_winning/losing filters.
-  CUDD::BDD EmersonLei::BuchiAlgorithm() const {
-    auto mgr = var_mgr_->cudd_mgr();
-    CUDD::BDD F = spec_.final_states() & state_space_;
-
-    // Outer greatest fixpoint: X starts at true
-    CUDD::BDD X = mgr->bddOne();
-    CUDD::BDD prevX = mgr->bddZero();
-
-    int outer_iter = 0;
-    while (!(X == prevX)) {
-      prevX = X;
-      outer_iter++;
-
-      // Inner least fixpoint: Y starts at false
-      CUDD::BDD Y = mgr->bddZero();
-      CUDD::BDD prevY;
-      int inner_iter = 0;
-
-      // Precompute F ∩ CPre(X) using the same pattern as EL's cpre:
-      // 1. Restrict target to state_space (and optionally instant_winning if adv_mp)
-      // 2. Compute preimage
-      // 3. Restrict to state_space before projection
-      // 4. Project into states
-      CUDD::BDD X_target;
-      if (adv_mp_) {
-        X_target = (X | instant_winning_) & state_space_;
-      } else {
-        X_target = X & state_space_;
-      }
-      CUDD::BDD quantified_X = preimage(X_target);
-      CUDD::BDD new_target_moves;
-      if (adv_mp_) {
-        new_target_moves = (state_space_ & quantified_X);
-      } else {
-        new_target_moves = (state_space_ & quantified_X) & (!instant_losing_);
-      }
-      CUDD::BDD FcpreX = F & project_into_states(new_target_moves);
-
-      do {
-        prevY = Y;
-        inner_iter++;
-
-        // CPre(Y) using the same aligned pattern
-        CUDD::BDD Y_target;
-        if (adv_mp_) {
-          Y_target = (Y | instant_winning_) & state_space_;
-        } else {
-          Y_target = Y & state_space_;
-        }
-        CUDD::BDD quantified_Y = preimage(Y_target);
-        CUDD::BDD new_Y_moves;
-        if (adv_mp_) {
-          new_Y_moves = (state_space_ & quantified_Y);
-        } else {
-          new_Y_moves = (state_space_ & quantified_Y) & (!instant_losing_);
-        }
-        CUDD::BDD cpreY = project_into_states(new_Y_moves);
-
-        // newY = (F ∩ CPre(X)) ∪ CPre(Y) ∪ Y
-        CUDD::BDD newY = (FcpreX | cpreY) | Y;
-        Y = newY & state_space_;
-
-        spdlog::debug("[BuchiAlgorithm] outer={} inner={} Y_nodes={}", outer_iter, inner_iter, Y.nodeCount());
-      } while (!(Y == prevY));
-
-      X = Y & state_space_;
-      spdlog::info("[BuchiAlgorithm] finished outer={} inner_iters={} X_nodes={}", outer_iter, inner_iter, X.nodeCount());
-    }
-
-    return X & state_space_;
-  }
-
-
-}
+//
+// Created by dh on 25/11/24.
+//
+
+#include "game/EmersonLei.hpp"
+#include "game/ParitySolver.hpp"
+#include "game/FixpointTelemetry.h"
+#include "debug.hpp"
+#include "Trace.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+namespace Syft {
+  ChildOrder child_order_from_string(const std::string &name) {
+    if (name == "construction") {
+      return ChildOrder::Construction;
+    } else if (name == "smallest-target") {
+      return ChildOrder::SmallestTarget;
+    } else if (name == "changed-first") {
+      return ChildOrder::ChangedFirst;
+    }
+    throw std::runtime_error("Error: Unknown child order: " + name);
+  }
+
+  // The subtree of a Zielonka node solved on its own manager, as by
+  // EmersonLeiSolve when no winning moves are recorded
+  struct EmersonLei::SubtreeGame {
+    std::unique_ptr<CUDD::Cudd> mgr;  // Declared first, so destroyed after every BDD below
+    std::vector<CUDD::BDD> compose_vector;
+    std::unique_ptr<Quantification> quantify_independent;
+    std::unique_ptr<Quantification> quantify_non_state;
+    CUDD::BDD state_space;
+    CUDD::BDD instant_winning;
+    CUDD::BDD instant_losing;
+    bool agent_first;
+    bool adv_mp;
+    // By dag_id: the safe nodes of the node and the target nodes of its children
+    std::map<size_t, CUDD::BDD> safenodes;
+    std::map<size_t, std::vector<CUDD::BDD>> targetnodes;
+    std::map<std::pair<size_t, DdNode*>, std::pair<CUDD::BDD, CUDD::BDD>> cache;
+    ZielonkaNode *root;
+    CUDD::BDD term;
+    CUDD::BDD winning;
+
+    // Same as EmersonLei::cpre, which does not depend on the node besides winning moves
+    CUDD::BDD CPre(const CUDD::BDD &target) const {
+      CUDD::BDD moves = state_space & quantify_independent->apply(target.VectorCompose(compose_vector));
+      if (agent_first) {
+        return quantify_non_state->apply(adv_mp ? moves : moves & !instant_losing);
+      }
+      return state_space & quantify_non_state->apply(moves);
+    }
+
+    CUDD::BDD Solve(ZielonkaNode *t, const CUDD::BDD &t_term, const std::function<void()> &check_budget) {
+      std::pair<size_t, DdNode*> key(t->dag_id, t_term.getNode());
+      auto cached = cache.find(key);
+      if (cached != cache.end()) {
+        return cached->second.second;
+      }
+      CUDD::BDD X = t->winning ? mgr->bddOne() : mgr->bddZero();
+      while (true) {
+        check_budget();
+        CUDD::BDD pre = CPre(adv_mp ? (X | instant_winning) : (X & !instant_losing));
+        CUDD::BDD XX;
+        if (t->children.empty()) {
+          XX = t_term | (safenodes.at(t->dag_id) & pre);
+        } else {
+          XX = t->winning ? mgr->bddOne() : mgr->bddZero();
+          const std::vector<CUDD::BDD> &targets = targetnodes.at(t->dag_id);
+          for (size_t i = 0; i < t->children.size(); ++i) {
+            CUDD::BDD child_winning = Solve(t->children[i], t_term | (targets[i] & pre), check_budget);
+            XX = t->winning ? (XX & child_winning) : (XX | child_winning);
+          }
+        }
+        if (XX == X) {
+          break;
+        }
+        X = XX;
+      }
+      cache.emplace(key, std::make_pair(t_term, X));
+      return X;
+    }
+  };
+
+  EmersonLei::EmersonLei(const SymbolicStateDfa &spec, ColorFormula color_formula, Player starting_player,
+                         Player protagonist_player,
+                         const std::vector<CUDD::BDD> &colorBDDs,
+                         const CUDD::BDD &state_space,
+                         const CUDD::BDD &instant_winning,
+                         const CUDD::BDD &instant_losing,
+                         bool adv_mp,
+                         std::shared_ptr<ZielonkaTree> z_tree)
+    : DfaGameSynthesizer(spec, starting_player, protagonist_player), Colors_(colorBDDs), color_formula_(std::move(color_formula)),
+      state_space_(state_space), instant_winning_(instant_winning), instant_losing_(instant_losing),
+      z_tree_(std::move(z_tree)), adv_mp_(adv_mp),
+      state_picker_(var_mgr_->cudd_mgr(), var_mgr_->get_state_variables(spec_.automaton_id())) {
+    std::vector<CUDD::BDD> output_variables;
+    for (const std::string &label : var_mgr_->output_variable_labels()) {
+      output_variables.push_back(var_mgr_->name_to_variable(label));
+    }
+    output_picker_ = MintermPicker(var_mgr_->cudd_mgr(), output_variables);
+
+        // Just for debugging, dump the DFA as json
+    //spec_.dump_json("EmersonLei_spec.json");
+
+    if (z_tree_) {
+      spdlog::info("[EmersonLei::EmersonLei] reusing Zielonka tree");
+    } else {
+      // build Zielonka tree lazily: EmersonLeiSolve expands each node when it first enters it, so the subtrees
+      // below an early stop or a cached solve are never built
+      spdlog::info("[EmersonLei::EmersonLei] building Zielonka tree");
+      TraceScope trace("Zielonka tree", "game");
+      z_tree_ = std::make_shared<ZielonkaTree>(color_formula_, Colors_, var_mgr_, true);
+      // Every fixpoint stays inside the state space, so the node sets can be restricted once here
+      z_tree_->restrict_to(state_space_);
+      trace.arg("colors", static_cast<double>(Colors_.size())).arg("distinct_subtrees", z_tree_->dag_size());
+      spdlog::info("[EmersonLei::EmersonLei] built Zielonka tree");
+      var_mgr_->end_phase("Zielonka tree");
+    }
+    acceptance_class_ = classify_acceptance(*z_tree_);
+    spdlog::info("[EmersonLei::EmersonLei] condition classified as {}", to_string(acceptance_class_));
+    // Showing the tree builds it whole, so both are opt-in
+    if (DEBUG_MODE) {
+      z_tree_->expand_all();
+      z_tree_->displayZielonkaTree();
+    }
+    if (const char* dump_path = std::getenv("SYFT_ZIELONKA_DOT")) {
+      try {
+        z_tree_->expand_all();
+        z_tree_->dump_dot(dump_path);
+        spdlog::info("[EmersonLei::EmersonLei] dumped Zielonka tree to {}", dump_path);
+      } catch (const std::exception& ex) {
+        spdlog::warn("[EmersonLei::EmersonLei] failed to dump Zielonka tree: {}", ex.what());
+      }
+    }
+  }
+
+  EmersonLei::EmersonLei(const ProductArena &arena, ColorFormula color_formula, Player starting_player,
+                         Player protagonist_player,
+                         const std::vector<CUDD::BDD> &colorBDDs,
+                         const CUDD::BDD &state_space,
+                         const CUDD::BDD &instant_winning,
+                         const CUDD::BDD &instant_losing,
+                         bool adv_mp,
+                         std::shared_ptr<ZielonkaTree> z_tree)
+    : EmersonLei(arena.symbolic_view(), std::move(color_formula), starting_player, protagonist_player, colorBDDs,
+                 state_space, instant_winning, instant_losing, adv_mp, std::move(z_tree)) {
+    product_arena_ = std::make_shared<ProductArena>(arena);
+  }
+
+  EmersonLei::EmersonLei(const SymbolicStateDfa &spec, const std::string &color_formula, Player starting_player,
+                         Player protagonist_player,
+                         const std::vector<CUDD::BDD> &colorBDDs,
+                         const CUDD::BDD &state_space,
+                         const CUDD::BDD &instant_winning,
+                         const CUDD::BDD &instant_losing,
+                         bool adv_mp,
+                         std::shared_ptr<ZielonkaTree> z_tree)
+    : EmersonLei(spec, ColorFormula(color_formula), starting_player, protagonist_player, colorBDDs,
+                 state_space, instant_winning, instant_losing, adv_mp, std::move(z_tree)) {}
+
+  EmersonLei::EmersonLei(const ProductArena &arena, const std::string &color_formula, Player starting_player,
+                         Player protagonist_player,
+                         const std::vector<CUDD::BDD> &colorBDDs,
+                         const CUDD::BDD &state_space,
+                         const CUDD::BDD &instant_winning,
+                         const CUDD::BDD &instant_losing,
+                         bool adv_mp,
+                         std::shared_ptr<ZielonkaTree> z_tree)
+    : EmersonLei(arena, ColorFormula(color_formula), starting_player, protagonist_player, colorBDDs,
+                 state_space, instant_winning, instant_losing, adv_mp, std::move(z_tree)) {}
+
+  CUDD::BDD EmersonLei::getOneUnprocessedState(CUDD::BDD states, CUDD::BDD processed) const {
+    if (DEBUG_MODE) {
+      SYFT_DEBUG_TRACE("states: {}", Syft::debug_string(states));
+      SYFT_DEBUG_TRACE("processed: {}", Syft::debug_string(processed));
+    }
+
+    DdNode *rawNode = (states * (!processed)).getNode();
+    if (DEBUG_MODE) {
+      // std::cout << "gameNode * winningmoves: " << gameNode * winningmoves << "\n";
+      // std::cout << "winningmoves: " << winningmoves << "\n";
+    }
+    CUDD::BDD Zs(*(var_mgr_->cudd_mgr()), rawNode);
+    if (DEBUG_MODE) {
+      SYFT_DEBUG_TRACE("All possible Zs: {}", Syft::debug_string(Zs));
+    }
+
+    return state_picker_.pick(Zs);
+  }
+
+// spdlog handles timestamps and formatting automatically
+
+
+  SynthesisResult EmersonLei::run() const {
+    SynthesisResult result;
+    result.realizability = true;
+    result.winning_states = var_mgr_->cudd_mgr()->bddZero();
+    result.winning_moves = var_mgr_->cudd_mgr()->bddZero();
+    result.transducer = nullptr;
+    return result;
+  }
+
+  ELSynthesisResult EmersonLei::run_EL() const {
+    if (DEBUG_MODE) {
+      for (size_t i = 0; i < Colors_.size(); i++) {
+        SYFT_DEBUG_TRACE("Color {}: {}", i, Syft::debug_string(Colors_[i]));
+      }
+    }
+    spdlog::info("[EmersonLei::run_EL] starting EmersonLeiSolve");
+    cpre_calls_ = 0;
+    // Optionally run embedded Büchi-style double-fixpoint solver (often faster for some inputs)
+    CUDD::BDD winning_states;
+    if (use_embedded_buchi_) {
+      spdlog::info("[EmersonLei::run_EL] using embedded Büchi double-fixpoint algorithm");
+      winning_states = BuchiAlgorithm();
+    } else if (force_parity_) {
+      spdlog::info("[EmersonLei::run_EL] solving the {} condition with the parity solver",
+                   to_string(acceptance_class_));
+      winning_states = SolveParity();
+    } else if (auto_dispatch_ && is_two_level(acceptance_class_) && !(STRATEGY && !realizability_only_)) {
+      spdlog::info("[EmersonLei::run_EL] solving the {} condition with two-level fixpoints",
+                   to_string(acceptance_class_));
+      winning_states = SolveTwoLevel();
+    } else {
+      spdlog::info("[EmersonLei::run_EL] solving the {} condition with EmersonLeiSolve", to_string(acceptance_class_));
+      // solve EL game for root of Zielonka tree and BDD encoding emptyset as set of states currently assumed to be winning
+      solve_cache_.clear();
+      solve_cache_hits_ = 0;
+      warm_starts_.clear();
+      winning_states = EmersonLeiSolve(z_tree_->get_root(), instant_winning_);
+      warm_starts_.clear();
+      spdlog::info("[EmersonLei::run_EL] Zielonka tree: {} nodes and {} distinct subtrees built, {} solves reused, "
+                   "{} cpre calls", z_tree_->size(), z_tree_->dag_size(), solve_cache_hits_, cpre_calls_);
+      var_mgr_->record_size("el_cpre_calls", static_cast<double>(cpre_calls_));
+    }
+    var_mgr_->record_size("zielonka_tree_nodes", static_cast<double>(z_tree_->size()));
+    if (STRATEGY && !realizability_only_) {
+      // Strategy extraction walks the whole tree; solving without the cache has already entered every node
+      z_tree_->expand_all();
+    }
+    var_mgr_->snapshot_stats("fixpoint");
+    if (release_winning_moves_ && !(STRATEGY && !realizability_only_)) {
+      // Only strategy extraction reads the winning moves; the cached solves are not needed again either
+      z_tree_->release_winning_moves();
+      solve_cache_.clear();
+    }
+    // std::cout << "winning_states: " << winning_states << std::endl;
+    // std::cout << "initial: " << spec_.initial_state_bdd() << "\n";
+    // var_mgr_->dump_dot(winning_states.Add(), "winning_states.dot");
+    // update result according to computed solution
+    ELSynthesisResult result;
+    if (includes_initial_state(winning_states)) {
+      result.realizability = true;
+      result.winning_states = winning_states;
+      result.z_tree = z_tree_;
+      EL_output_function op;
+      
+      if (STRATEGY && !realizability_only_ && !force_parity_ && !defer_strategy_) {
+        TraceScope trace("strategy extraction", "game");
+        trace.arg("mode", symbolic_strategy_ ? "symbolic" : "explicit");
+        if (symbolic_strategy_) {
+          result.transducer = ExtractStrategy_Symbolic(winning_states);
+        } else {
+          result.output_function = ExtractStrategy_Explicit(op, winning_states, spec_.initial_state_bdd(),
+                                                            z_tree_->get_root());
+        }
+        var_mgr_->snapshot_stats("strategy extraction");
+      }
+      return result;
+    } else {
+      result.realizability = false;
+      result.winning_states = winning_states;
+      EL_output_function op;
+      if (defer_strategy_) {
+        result.z_tree = z_tree_;
+      }
+
+      if (STRATEGY && !realizability_only_ && !force_parity_ && !defer_strategy_) {
+        TraceScope trace("strategy extraction", "game");
+        trace.arg("mode", "environment");
+        CUDD::BDD processed = var_mgr_->cudd_mgr()->bddZero();
+        while ((winning_states | !processed) != var_mgr_->cudd_mgr()->bddOne()) {
+        // while (winning_states.Xnor(processed) != var_mgr_->cudd_mgr()->bddOne()) {
+          // std::cout << "winning_states: " << winning_states << "\n";
+          // std::cout << "processed: " << processed << "\n";
+  
+          CUDD::BDD unprocessed_state = getOneUnprocessedState(winning_states, processed);
+          EL_output_function temp = ExtractStrategy_Explicit(op, winning_states, unprocessed_state,
+                                                          z_tree_->get_root());
+          for (auto item : temp) {
+            processed = processed | item.gameNode;
+          }
+          op = temp;
+        }
+        var_mgr_->snapshot_stats("strategy extraction");
+      }
+      result.output_function = op;
+      return result;
+    }
+  }
+
+
+  int EmersonLei::index_below(ZielonkaNode *anchor_node, ZielonkaNode *old_memory) {
+    if (old_memory == anchor_node) {
+      return 0;
+    }
+    // The child of anchor_node on the path to old_memory knows its own index
+    while (old_memory->parent != anchor_node) {
+      if (old_memory->parent == nullptr) {
+        return -1;
+      }
+      old_memory = old_memory->parent;
+    }
+    return static_cast<int>(old_memory->sibling_order);
+  }
+
+  ZielonkaNode *EmersonLei::get_anchor(CUDD::BDD game_node, ZielonkaNode *t) const {
+    // Tested with Leq, which builds no BDD: game_node meets the targets iff it is not below their complement
+    while (t->order != 1) {
+      if (!game_node.Leq(!t->targetnodes)) {
+        return t->parent;
+      }
+      t = t->parent;
+    }
+    return t;
+  }
+
+  ZielonkaNode *EmersonLei::get_leaf(ZielonkaNode *old_memory, ZielonkaNode *anchor_node, ZielonkaNode *curr,
+                                     CUDD::BDD Y) const {
+    // case: a leaf has been reached
+    if (curr->children.empty()) {
+      return curr;
+    }
+
+    // case: a leaf has not been reached and current node is winning
+    if (curr->winning) {
+      int old_branch = 0;
+      if (curr == anchor_node) {
+        // compute branching direction from anchor_node to old_memory
+        old_branch = index_below(anchor_node, old_memory);
+      }
+      // move one to the right, cycling back to 0 if old_branch is rightmost direction
+      int next_branch = (old_branch + 1) % (curr->children.size());
+      // find leaf below the new branching direction
+      return get_leaf(old_memory, anchor_node, curr->children[next_branch], Y);
+    } else {
+      // find branching direction from curr that allows system choice Y, i.e. whose winning moves meet Y
+      int branch = 0;
+      while (branch < curr->children.size()) {
+        if (!Y.Leq(!curr->winningmoves[branch])) {
+          break;
+        }
+        branch++;
+      }
+      // find leaf below that branching direction
+      return get_leaf(old_memory, anchor_node, curr->children[branch], Y);
+    }
+  }
+
+  EL_output_function EmersonLei::ExtractStrategy_Explicit(EL_output_function op, CUDD::BDD winning_states,
+                                                          CUDD::BDD gameNode, ZielonkaNode *t) const {
+    // Index the moves already in op once, instead of scanning them for every visited pair
+    VisitedMoves visited;
+    visited.reserve(op.size());
+    for (std::size_t i = 0; i < op.size(); ++i) {
+      visited.emplace(std::make_pair(op[i].gameNode.getNode(), op[i].t->order), i);
+    }
+    ExtractStrategy_Explicit(op, visited, gameNode, t);
+    return op;
+  }
+
+  void EmersonLei::ExtractStrategy_Explicit(EL_output_function &op, VisitedMoves &visited,
+                                            const CUDD::BDD &gameNode, ZielonkaNode *t) const {
+
+    //	t: tree node, s (anchor node): lowest ancester of t that includes all colors of gameNode
+
+    if (DEBUG_MODE) {
+      SYFT_DEBUG_TRACE("gameNode: {}", Syft::debug_string(gameNode));
+      gameNode.PrintCover();
+      SYFT_DEBUG_TRACE("tree node: {}", t->order);
+    }
+
+    // stop recursion if the strategy has already been defined for (gameNode,t);
+    // game nodes are cubes over all state variables, so equal states have equal nodes
+    if (!visited.emplace(std::make_pair(gameNode.getNode(), t->order), op.size()).second) {
+      if (DEBUG_MODE) {
+        SYFT_DEBUG_TRACE("defined! {} {}", Syft::debug_string(gameNode), t->order);
+        gameNode.PrintCover();
+      }
+      return;
+    }
+
+    // the following assumes that system moves first and environment moves second
+
+    ZielonkaNode *s = get_anchor(gameNode, t);
+
+    // BDD that will be used to encode a single choice for system, default bddZero
+    CUDD::BDD Y = var_mgr_->cudd_mgr()->bddZero();
+
+    // pick one choice for system that is winning for system from gameNode for objective s
+    if (s->children.empty()) {
+      // have just a single winningmoves BDD
+      Y = getUniqueSystemChoice(gameNode, s->winningmoves[0]);
+    } else {
+      // iterate through all winningmoves BDD until a choice for system is found that is winning from gameNode for objective s; one is guaranteed to be found
+      for (int i = 0; i < s->children.size(); i++) {
+        Y = getUniqueSystemChoice(gameNode, s->winningmoves[i]);
+        if (Y != var_mgr_->cudd_mgr()->bddZero()) {
+          break;
+        }
+      }
+    }
+
+    // get next memory value; t: old memory value, s: anchor node, move: system choice that has been picked
+    ZielonkaNode *u = get_leaf(t, s, s, Y);
+
+    // add system choice and resulting new memory to extracted strategy,
+    // currently assumes result has component "strategy" which is vector of (gameNode, ZielonkaNode), (CUDD::BDD,ZielonkaNode)
+    ELWinningMove move;
+    move.gameNode = gameNode;
+    move.t = t;
+    move.Y = Y;
+    move.u = u;
+    op.push_back(move);
+    if (DEBUG_MODE) {
+      SYFT_DEBUG_TRACE(" --> Y: {} tree node: {}", Syft::debug_string(Y), u->order);
+    }
+
+    // compute game nodes that can result by taking system choice from gameNode
+    std::vector<CUDD::BDD> newGameNodes = getSuccsWithYZ(gameNode, Y);
+
+    // continue strategy construction with each possible new game node and the new memory value
+    for (int i = 0; i < newGameNodes.size(); i++) {
+      ExtractStrategy_Explicit(op, visited, newGameNodes[i], u);
+    }
+  }
+
+  EmersonLei::MemoryStrategy EmersonLei::memory_strategy(ZielonkaNode *root, const CUDD::BDD &winning_states,
+                                                         const std::shared_ptr<VarMgr> &var_mgr) {
+    CUDD::BDD zero = var_mgr->cudd_mgr()->bddZero();
+    CUDD::BDD output_cube = var_mgr->output_cube();
+
+    // The memory values reached by ExtractStrategy_Explicit: the root, where
+    // plays start, and the leaves returned by get_leaf
+    MemoryStrategy result;
+    result.memory.push_back(root);
+    std::map<ZielonkaNode *, std::size_t> memory_id{{root, 0}};
+    std::vector<ZielonkaNode *> nodes{root};
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+      for (ZielonkaNode *child : nodes[i]->children) {
+        nodes.push_back(child);
+      }
+      if (nodes[i]->children.empty() && memory_id.emplace(nodes[i], result.memory.size()).second) {
+        result.memory.push_back(nodes[i]);
+      }
+    }
+
+    // The moves picked at an anchor: those winning for its first child that
+    // has a winning move from the state, as the loop of ExtractStrategy_Explicit
+    std::map<ZielonkaNode *, CUDD::BDD> anchor_moves;
+    auto moves_of = [&](ZielonkaNode *s) {
+      auto it = anchor_moves.find(s);
+      if (it == anchor_moves.end()) {
+        CUDD::BDD moves = zero;
+        CUDD::BDD covered = zero;
+        // A leaf has a single entry; later entries are pushed by repeated solves and never refined
+        std::size_t entries = std::max<std::size_t>(s->children.size(), 1);
+        for (std::size_t i = 0; i < entries && i < s->winningmoves.size(); ++i) {
+          moves |= s->winningmoves[i] & !covered;
+          covered |= s->winningmoves[i].ExistAbstract(output_cube);
+        }
+        it = anchor_moves.emplace(s, moves).first;
+      }
+      return it->second;
+    };
+
+    // Splits moves by the leaf get_leaf reaches from curr. Below a losing node
+    // the branch is the first one the move is winning for from its own state;
+    // moves winning for none stay in the last branch, so the update is total
+    std::function<void(ZielonkaNode *, ZielonkaNode *, ZielonkaNode *, const CUDD::BDD &, std::vector<CUDD::BDD> &)>
+        split_by_leaf = [&](ZielonkaNode *old_memory, ZielonkaNode *anchor, ZielonkaNode *curr,
+                            const CUDD::BDD &moves, std::vector<CUDD::BDD> &next) {
+      if (moves.IsZero()) {
+        return;
+      }
+      if (curr->children.empty()) {
+        next[memory_id.at(curr)] |= moves;
+      } else if (curr->winning) {
+        int old_branch = curr == anchor ? index_below(anchor, old_memory) : 0;
+        int next_branch = (old_branch + 1) % static_cast<int>(curr->children.size());
+        split_by_leaf(old_memory, anchor, curr->children[next_branch], moves, next);
+      } else {
+        CUDD::BDD rest = moves;
+        for (std::size_t i = 0; i < curr->children.size(); ++i) {
+          CUDD::BDD branch = i + 1 == curr->children.size() ? rest : rest & curr->winningmoves[i];
+          split_by_leaf(old_memory, anchor, curr->children[i], branch, next);
+          rest &= !branch;
+        }
+      }
+    };
+
+    for (ZielonkaNode *t : result.memory) {
+      var_mgr->check_budget("strategy extraction");
+      CUDD::BDD moves_at_t = zero;
+      std::vector<CUDD::BDD> next(result.memory.size(), zero);
+      // As get_anchor: the anchor is the parent of the lowest ancestor of t
+      // whose target set holds the state, and the root for the other states
+      CUDD::BDD remaining = winning_states;
+      for (ZielonkaNode *a = t; !remaining.IsZero(); a = a->parent) {
+        ZielonkaNode *anchor = a->parent ? a->parent : a;
+        CUDD::BDD region = a->parent ? remaining & a->targetnodes : remaining;
+        remaining &= !region;
+        CUDD::BDD moves = region & moves_of(anchor);
+        moves_at_t |= moves;
+        split_by_leaf(t, anchor, anchor, moves, next);
+        if (!a->parent) {
+          break;
+        }
+      }
+      result.moves.push_back(moves_at_t);
+      result.next.push_back(std::move(next));
+    }
+    return result;
+  }
+
+  std::unique_ptr<Transducer> EmersonLei::ExtractStrategy_Symbolic(const CUDD::BDD &winning_states) const {
+    if (starting_player_ != Player::Agent) {
+      throw std::runtime_error("Error: Symbolic Emerson-Lei strategy extraction requires the agent to move first");
+    }
+    MemoryStrategy strategy = memory_strategy(z_tree_->get_root(), winning_states, var_mgr_);
+    return memory_transducer(strategy.moves, strategy.next, "EmersonLei::ExtractStrategy_Symbolic");
+  }
+  /*
+  EmersonLei::OneStepSynReturn EmersonLei::ExtractStrategy_Explicit_OneStep(EL_output_function op, CUDD::BDD winning_states,
+                                                          CUDD::BDD gameNode, ZielonkaNode *t, CUDD::BDD X) const {
+    //	t: tree node, s (anchor node): lowest ancester of t that includes all colors of gameNode
+    EL_output_function temp = op;
+    // stop recursion if the strategy has already been defined for (gameNode,t)
+
+    // std::cout << "-----------\ngameNode: " << gameNode;
+    // gameNode.PrintCover();
+    // std::cout << "tree node: " << t->order << "\n";
+
+    std::pair<CUDD::BDD, ZielonkaNode *> curr;
+    curr.first = gameNode;
+    curr.second = t;
+    for (auto item: op) {
+      // std::cout << item.gameNode << " " << item.t->order << "\n";
+      // std::cout << item.Y << " " << item.u->order << "\n";
+      if ((item.gameNode.Xnor(gameNode) == var_mgr_->cudd_mgr()->bddOne()) && (item.t->order == t->order)) {
+        // std::cout << "defined! " << gameNode << " " << t->order << "\n";
+        // gameNode.PrintCover();
+        // std::cout << "stored " << item.gameNode << " " << item.t->order << "\n";
+        // item.gameNode.PrintCover();
+        OneStepSynReturn res;
+        res.op_ = op;
+        res.game_state_ = gameNode;
+        res.tree_node_ = t->order;
+        res.Y_ = item.Y;
+        return res;
+      }
+    }
+
+    // the following assumes that system moves first and environment moves second
+
+    ZielonkaNode *s = get_anchor(gameNode, t);
+
+    // BDD that will be used to encode a single choice for system, default bddZero
+    CUDD::BDD Y = var_mgr_->cudd_mgr()->bddZero();
+
+    // pick one choice for system that is winning for system from gameNode for objective s
+    if (s->children.empty()) {
+      // have just a single winningmoves BDD
+      Y = getUniqueSystemChoice(gameNode, s->winningmoves[0]);
+      // Y = getUniqueSystemChoice(gameNode,s->winningmoves[0]);
+    } else {
+      // iterate through all winningmoves BDD until a choice for system is found that is winning from gameNode for objective s; one is guaranteed to be found
+      for (int i = 0; i < s->children.size(); i++) {
+        Y = getUniqueSystemChoice(gameNode, s->winningmoves[i]);
+        if (Y != var_mgr_->cudd_mgr()->bddZero()) {
+          break;
+        }
+      }
+    }
+
+    // get next memory value; t: old memory value, s: anchor node, move: system choice that has been picked
+    ZielonkaNode *u = get_leaf(t, s, s, Y);
+
+    // add system choice and resulting new memory to extracted strategy,
+    // currently assumes result has component "strategy" which is vector of (gameNode, ZielonkaNode), (CUDD::BDD,ZielonkaNode)
+    ELWinningMove move;
+    move.gameNode = gameNode;
+    move.t = t;
+    move.Y = Y;
+    move.u = u;
+    temp.push_back(move);
+    // std::cout << " --> \n";
+    // std::cout << "Y: " << Y << "\n";
+    // std::cout << "tree node: " << u->order << "\n\n";
+
+    // compute game nodes that can result by taking system choice from gameNode
+    CUDD::BDD newGameNode = getSuccsWithXYZ(gameNode, Y, X);
+
+
+    EL_output_function temp_new = ExtractStrategy_Explicit(temp, winning_states, newGameNode, u);
+    OneStepSynReturn res;
+    res.op_ = temp_new;
+    res.game_state_ = newGameNode;
+    res.tree_node_ = u->order;
+    res.Y_ = Y;
+
+    return res;
+  }
+*/
+  CUDD::BDD EmersonLei::getSuccsWithXYZ(CUDD::BDD gameNode, CUDD::BDD Y, CUDD::BDD X) const {
+    std::vector<CUDD::BDD> succs;
+    const std::vector<CUDD::BDD> &transition_vector = transition_function();
+    std::vector<CUDD::BDD> transition_vector_fix_Y_Z;
+    for (int i = 0; i < transition_vector.size(); i++) {
+      CUDD::BDD transition_fix_Y_Z = (transition_vector[i] * gameNode * Y * X).ExistAbstract(
+        var_mgr_->state_variables_cube(spec_id())).ExistAbstract(var_mgr_->output_cube()).ExistAbstract(var_mgr_->input_cube());
+      transition_vector_fix_Y_Z.push_back(transition_fix_Y_Z);
+    }
+
+    CUDD::BDD succ = var_mgr_->cudd_mgr()->bddOne();
+    for (int i = 0; i < transition_vector_fix_Y_Z.size(); i++) {
+      CUDD::BDD Z_var = var_mgr_->state_variable(spec_id(), i);
+      if (transition_vector_fix_Y_Z[i].IsOne()) {
+        succ = succ * Z_var;
+      } else {
+        succ = succ * !Z_var;
+      }
+    }
+    return succ;
+  }
+
+  std::vector<CUDD::BDD> EmersonLei::getSuccsWithYZ(CUDD::BDD gameNode, CUDD::BDD Y) const {
+    return successor_cubes(gameNode, Y);
+  }
+
+
+  CUDD::BDD EmersonLei::getUniqueSystemChoice(CUDD::BDD gameNode, CUDD::BDD winningmoves) const {
+    DdNode *rawNode = Cudd_bddRestrict(var_mgr_->cudd_mgr()->getManager(), winningmoves.getNode(), gameNode.getNode());
+    // std::cout << "gameNode * winningmoves: " << gameNode * winningmoves << "\n";
+    if (DEBUG_MODE) {
+      SYFT_DEBUG_TRACE("winningmoves: {}", Syft::debug_string(winningmoves));
+    }
+    CUDD::BDD Ys(*(var_mgr_->cudd_mgr()), rawNode);
+    if (DEBUG_MODE) {
+      SYFT_DEBUG_TRACE("All possible Ys: {}", Syft::debug_string(Ys));
+    }
+    return output_picker_.pick(Ys);
+  }
+
+  void EmersonLei::set_threads(std::size_t threads, std::size_t min_children, int min_nodes) {
+    threads_ = threads;
+    parallel_min_children_ = min_children;
+    parallel_min_nodes_ = min_nodes;
+  }
+
+  void EmersonLei::detach_subtree(SubtreeGame &game, ZielonkaNode *root, const CUDD::BDD &term) const {
+    std::size_t total_variable_count = var_mgr_->total_variable_count();
+    auto state_vars = var_mgr_->get_state_variables(spec_.automaton_id());
+    const std::vector<CUDD::BDD> &transition_vector = transition_function();
+    CUDD::Cudd &mgr = *(game.mgr = std::make_unique<CUDD::Cudd>(static_cast<unsigned int>(total_variable_count)));
+    game.compose_vector.reserve(total_variable_count);
+    for (std::size_t v = 0; v < total_variable_count; ++v) {
+      game.compose_vector.push_back(mgr.bddVar(static_cast<int>(v)));
+    }
+    for (std::size_t b = 0; b < state_vars.size(); ++b) {
+      game.compose_vector[state_vars[b].NodeReadIndex()] = transition_vector[b].Transfer(mgr);
+    }
+    game.quantify_independent = quantify_independent_variables_->transfer(mgr);
+    game.quantify_non_state = quantify_non_state_variables_->transfer(mgr);
+    game.state_space = state_space_.Transfer(mgr);
+    game.instant_winning = instant_winning_.Transfer(mgr);
+    game.instant_losing = instant_losing_.Transfer(mgr);
+    game.agent_first = starting_player_ == Player::Agent;
+    game.adv_mp = adv_mp_;
+    game.root = root;
+    game.term = term.Transfer(mgr);
+    // The workers read the children of the nodes without expanding them
+    z_tree_->expand_subtree(game.root);
+    // One copy per distinct subtree
+    std::vector<ZielonkaNode*> stack{game.root};
+    while (!stack.empty()) {
+      ZielonkaNode *node = stack.back();
+      stack.pop_back();
+      if (!game.safenodes.emplace(node->dag_id, node->safenodes.Transfer(mgr)).second) {
+        continue;
+      }
+      std::vector<CUDD::BDD> &targets = game.targetnodes[node->dag_id];
+      for (ZielonkaNode *child : node->children) {
+        targets.push_back(child->targetnodes.Transfer(mgr));
+        stack.push_back(child);
+      }
+    }
+  }
+
+  std::size_t EmersonLei::SolveDetached(std::vector<SubtreeGame> &games, std::size_t threads,
+                                        const std::function<void()> &check_budget) {
+    std::vector<std::exception_ptr> errors(games.size());
+    std::atomic<std::size_t> next_job{0};
+    auto worker = [&]() {
+      for (std::size_t k = next_job++; k < games.size(); k = next_job++) {
+        try {
+          games[k].winning = games[k].Solve(games[k].root, games[k].term, check_budget);
+        } catch (...) {
+          errors[k] = std::current_exception();
+        }
+      }
+    };
+    std::vector<std::thread> workers;
+    for (std::size_t w = 0; w < std::min(std::max<std::size_t>(threads, 1), games.size()); ++w) {
+      workers.emplace_back(worker);
+    }
+    for (std::thread &thread : workers) {
+      thread.join();
+    }
+    for (const std::exception_ptr &error : errors) {
+      if (error) {
+        std::rethrow_exception(error);
+      }
+    }
+    return workers.size();
+  }
+
+  std::vector<CUDD::BDD> EmersonLei::SolveChildrenInParallel(ZielonkaNode *t, const std::vector<CUDD::BDD> &terms) const {
+    std::vector<CUDD::BDD> results(terms.size());
+    std::vector<size_t> pending;
+    for (size_t i = 0; i < terms.size(); ++i) {
+      auto cached = solve_cache_.find(std::make_pair(t->children[i]->dag_id, terms[i].getNode()));
+      if (cached != solve_cache_.end()) {
+        solve_cache_hits_++;
+        results[i] = cached->second.second;
+      } else {
+        pending.push_back(i);
+      }
+    }
+    if (pending.empty()) {
+      return results;
+    }
+
+    // Transfer every game on this thread: CUDD managers are not thread-safe
+    std::vector<SubtreeGame> games(pending.size());
+    for (size_t k = 0; k < pending.size(); ++k) {
+      detach_subtree(games[k], t->children[pending[k]], terms[pending[k]]);
+    }
+
+    // The main manager is idle until the workers are joined, so they may read its budget
+    std::size_t workers = SolveDetached(games, threads_, [this]() { var_mgr_->check_budget("fixpoint"); });
+
+    SYFT_DEBUG_TRACE("[EmersonLeiSolve] node={} solved {} children on {} threads", t->order, games.size(), workers);
+    for (size_t k = 0; k < pending.size(); ++k) {
+      size_t i = pending[k];
+      results[i] = games[k].winning.Transfer(*var_mgr_->cudd_mgr());
+      solve_cache_.emplace(std::make_pair(t->children[i]->dag_id, terms[i].getNode()), std::make_pair(terms[i], results[i]));
+    }
+    return results;
+  }
+
+  std::vector<CUDD::BDD> EmersonLei::SolveInParallel(const std::vector<const EmersonLei*> &solvers, std::size_t threads) {
+    if (solvers.empty()) {
+      return {};
+    }
+    std::shared_ptr<VarMgr> var_mgr = solvers.front()->var_mgr_;
+    std::vector<SubtreeGame> games(solvers.size());
+    for (size_t k = 0; k < solvers.size(); ++k) {
+      if (solvers[k]->var_mgr_ != var_mgr) {
+        throw std::runtime_error("Error: The games solved in parallel must share their variable manager");
+      }
+      // From the root, the instantly winning states are the term, as in run_EL
+      solvers[k]->detach_subtree(games[k], solvers[k]->z_tree_->get_root(), solvers[k]->instant_winning_);
+    }
+    std::size_t workers = SolveDetached(games, threads, [&var_mgr]() { var_mgr->check_budget("fixpoint"); });
+    spdlog::info("[EmersonLei::SolveInParallel] solved {} games on {} threads", games.size(), workers);
+
+    std::vector<CUDD::BDD> winning;
+    winning.reserve(games.size());
+    for (SubtreeGame &game : games) {
+      winning.push_back(game.winning.Transfer(*var_mgr->cudd_mgr()));
+    }
+    return winning;
+  }
+
+  CUDD::BDD EmersonLei::cpre(ZielonkaNode *t, int i, CUDD::BDD target) const {
+    cpre_calls_++;
+    CUDD::BDD result;
+    if (DEBUG_MODE) {
+  SYFT_DEBUG_TRACE("[cpre] entering cpre: node={} idx={} target_nodes={}", t->order, i, target.nodeCount());
+    }
+
+    if (starting_player_ == Player::Agent) {
+      CUDD::BDD quantified_X_transitions_to_winning_states = preimage(target);
+      if (DEBUG_MODE) {
+  SYFT_DEBUG_TRACE("[cpre] quantified_X_transitions_to_winning_states nodes={}", quantified_X_transitions_to_winning_states.nodeCount());
+      }
+      //             CUDD::BDD new_target_moves = target |
+      //                                 (state_space_ & (!target) & quantified_X_transitions_to_winning_states);
+      //             result = project_into_states(new_target_moves);
+      // CUDD::BDD diffmoves = (result & (!target) & quantified_X_transitions_to_winning_states);
+      if (t->winning) {
+        CUDD::BDD new_target_moves;
+        if (adv_mp_) {
+          new_target_moves = (state_space_ & quantified_X_transitions_to_winning_states);
+        } else {
+          new_target_moves = (state_space_ & quantified_X_transitions_to_winning_states) & (!instant_losing_);
+        }
+        
+        result = project_into_states(new_target_moves);
+        if (DEBUG_MODE) {
+          SYFT_DEBUG_TRACE("[cpre] project_into_states(new_target_moves) nodes={}", project_into_states(new_target_moves).nodeCount());
+          SYFT_DEBUG_TRACE("[cpre] result nodes={}", result.nodeCount());
+          SYFT_DEBUG_TRACE("[cpre] winningmoves_before nodes={}", t->winningmoves[i].nodeCount());
+        }
+        // CUDD::BDD diffmoves = (result & (!target) & quantified_X_transitions_to_winning_states);
+        if (!realizability_only_) {
+          t->winningmoves[i] = t->winningmoves[i] & new_target_moves;
+        }
+        if (DEBUG_MODE) {
+          SYFT_DEBUG_TRACE("[cpre] winningmoves_after nodes={}", t->winningmoves[i].nodeCount());
+        }
+      } else {
+        CUDD::BDD new_target_moves_with_loops;
+        if (adv_mp_) {
+          new_target_moves_with_loops = (state_space_ & quantified_X_transitions_to_winning_states);
+        } else {
+          new_target_moves_with_loops = (state_space_ & quantified_X_transitions_to_winning_states) & (!instant_losing_);
+        }
+        
+        CUDD::BDD new_target_moves = (!target) & new_target_moves_with_loops;
+        result = project_into_states(new_target_moves_with_loops);
+        if (DEBUG_MODE) {
+          SYFT_DEBUG_TRACE("[cpre] project_into_states(new_target_moves_with_loops) nodes={}", project_into_states(new_target_moves_with_loops).nodeCount());
+          SYFT_DEBUG_TRACE("[cpre] result nodes={}", result.nodeCount());
+          SYFT_DEBUG_TRACE("[cpre] winningmoves_before nodes={}", t->winningmoves[i].nodeCount());
+        }
+        // CUDD::BDD diffmoves = (result & (!target) & quantified_X_transitions_to_winning_states);
+        if (!realizability_only_) {
+          t->winningmoves[i] = t->winningmoves[i] | new_target_moves;
+        }
+        if (DEBUG_MODE) {
+          SYFT_DEBUG_TRACE("[cpre] winningmoves_after nodes={}", t->winningmoves[i].nodeCount());
+        }
+      }
+    } else {
+      //TODO need to double-check
+      CUDD::BDD transitions_to_target_states = preimage(target);
+      if (DEBUG_MODE) {
+      SYFT_DEBUG_TRACE("[cpre] transitions_to_target_states nodes={}", transitions_to_target_states.nodeCount());
+      }
+      if (t->winning) {
+        result = state_space_ & project_into_states(transitions_to_target_states);
+        if (DEBUG_MODE) {
+          SYFT_DEBUG_TRACE("[cpre] project_into_states(transitions_to_target_states) nodes={}", project_into_states(transitions_to_target_states).nodeCount());
+          SYFT_DEBUG_TRACE("[cpre] result nodes={}", result.nodeCount());
+          SYFT_DEBUG_TRACE("[cpre] winningmoves_before nodes={}", t->winningmoves[i].nodeCount());
+        }
+        // result = target | new_collected_target_states;
+        CUDD::BDD new_target_moves;
+        if (adv_mp_) {
+          new_target_moves = (result & transitions_to_target_states);
+        } else {
+          new_target_moves = (result & transitions_to_target_states) & (!instant_losing_);
+        }
+        // CUDD::BDD diffmoves = (!target) & transitions_to_target_states;
+        if (!realizability_only_) {
+          t->winningmoves[i] = t->winningmoves[i] & new_target_moves;
+        }
+        if (DEBUG_MODE) {
+          SYFT_DEBUG_TRACE("[cpre] winningmoves_after nodes={}", t->winningmoves[i].nodeCount());
+        }
+      } else {
+        result = state_space_ & project_into_states(transitions_to_target_states);
+        if (DEBUG_MODE) {
+          SYFT_DEBUG_TRACE("[cpre] project_into_states(transitions_to_target_states) nodes={}", project_into_states(transitions_to_target_states).nodeCount());
+          SYFT_DEBUG_TRACE("[cpre] result nodes={}", result.nodeCount());
+          SYFT_DEBUG_TRACE("[cpre] winningmoves_before nodes={}", t->winningmoves[i].nodeCount());
+        }
+        // result = target | new_collected_target_states;
+        
+        CUDD::BDD new_target_moves;
+        if (adv_mp_) {
+          new_target_moves = (!target) & result & transitions_to_target_states;
+        } else {
+          new_target_moves = (!target) & result & transitions_to_target_states & (!instant_losing_);
+        }
+        if (!realizability_only_) {
+          t->winningmoves[i] = t->winningmoves[i] | new_target_moves;
+        }
+        if (DEBUG_MODE) {
+          SYFT_DEBUG_TRACE("[cpre] winningmoves_after nodes={}", t->winningmoves[i].nodeCount());
+        }
+      }
+    }
+      if (DEBUG_MODE) {
+  SYFT_DEBUG_TRACE("[cpre] exiting cpre: result nodes={}", result.nodeCount());
+    }
+    return result;
+  }
+
+  CUDD::BDD EmersonLei::controllable_pre(const CUDD::BDD &target) const {
+    if (starting_player_ == Player::Agent) {
+      CUDD::BDD moves = state_space_ & preimage(target);
+      if (!adv_mp_) {
+        moves &= !instant_losing_;
+      }
+      return project_into_states(moves);
+    }
+    return state_space_ & project_into_states(preimage(target));
+  }
+
+  CUDD::BDD EmersonLei::SolveTwoLevel() const {
+    ZielonkaNode *root = z_tree_->get_root();
+    CUDD::BDD one = var_mgr_->cudd_mgr()->bddOne();
+    CUDD::BDD zero = var_mgr_->cudd_mgr()->bddZero();
+    // The target passed to cpre by EmersonLeiSolve
+    auto target_of = [&](const CUDD::BDD &states) {
+      return adv_mp_ ? (states | instant_winning_) : (states & !instant_losing_);
+    };
+
+    CUDD::BDD X = root->winning ? one : zero;
+    int outer_iter = 0;
+    while (true) {
+      var_mgr_->check_budget("fixpoint");
+      outer_iter++;
+      CUDD::BDD XX;
+      if (root->children.empty()) {
+        XX = instant_winning_ | (root->safenodes & controllable_pre(target_of(X)));
+      } else {
+        XX = root->winning ? one : zero;
+        CUDD::BDD pre_X = controllable_pre(target_of(X));
+        for (ZielonkaNode *leaf : root->children) {
+          // The fixpoint of the leaf, with the states forcing X into its target set as extra target
+          CUDD::BDD term = instant_winning_ | (leaf->targetnodes & pre_X);
+          CUDD::BDD Y = leaf->winning ? one : zero;
+          while (true) {
+            var_mgr_->check_budget("fixpoint");
+            CUDD::BDD YY = term | (leaf->safenodes & controllable_pre(target_of(Y)));
+            if (YY == Y) {
+              break;
+            }
+            Y = YY;
+          }
+          if (root->winning) {
+            XX &= Y;
+          } else {
+            XX |= Y;
+          }
+        }
+      }
+      SYFT_DEBUG_TRACE("[EmersonLei::SolveTwoLevel] outer_iter={} X_nodes={} XX_nodes={}", outer_iter, X.nodeCount(),
+                       XX.nodeCount());
+      if (XX == X) {
+        break;
+      }
+      X = XX;
+      if (root_iteration_decides(X, root->winning)) {
+        spdlog::info("[EmersonLei::SolveTwoLevel] initial state decided at outer_iter={}", outer_iter);
+        break;
+      }
+    }
+    return X;
+  }
+
+  bool EmersonLei::root_iteration_decides(const CUDD::BDD &X, bool greatest) const {
+    if (anytime_ || root_progress_) {
+      PartialSynthesisResult partial;
+      if (greatest) {
+        partial.winning = instant_winning_;
+        partial.losing = state_space_ & !X;
+      } else {
+        partial.winning = X;
+        partial.losing = var_mgr_->cudd_mgr()->bddZero();
+      }
+      if (root_progress_) {
+        root_progress_(partial);
+      }
+      if (anytime_) {
+        anytime_(partial);
+      }
+    }
+    // The root fixpoint decides the initial state once it leaves a greatest
+    // fixpoint or enters a least fixpoint; stopping there leaves no winning moves to extract
+    bool may_stop = realizability_only_ || (anytime_ && !STRATEGY);
+    return may_stop && includes_initial_state(X) != greatest;
+  }
+
+  CUDD::BDD EmersonLei::SolveParity() const {
+    if (!instant_winning_.IsZero() || !instant_losing_.IsZero()) {
+      throw std::runtime_error("Error: The parity solver does not support instantly winning or losing states");
+    }
+    CUDD::BDD zero = var_mgr_->cudd_mgr()->bddZero();
+    ZielonkaNode *root = z_tree_->get_root();
+    // Priorities are even exactly at winning nodes
+    std::vector<CUDD::BDD> priorities;
+    if (!root->winning) {
+      priorities.push_back(zero);
+    }
+    // The states of node i but not of node i + 1 see no color outside the label of node i only
+    for (ZielonkaNode *node = root; node != nullptr;
+         node = z_tree_->children(node).empty() ? nullptr : node->children[0]) {
+      if (z_tree_->children(node).size() > 1) {
+        throw std::runtime_error("Error: The parity solver needs a Zielonka tree that is a chain, not a " +
+                                 to_string(acceptance_class_) + " condition");
+      }
+      CUDD::BDD deeper = node->children.empty() ? zero : node->children[0]->safenodes;
+      priorities.push_back(node->safenodes & !deeper);
+    }
+
+    std::unique_ptr<ParitySolver> solver =
+        product_arena_
+        ? std::make_unique<ParitySolver>(*product_arena_, starting_player_, protagonist_player_, priorities, state_space_)
+        : std::make_unique<ParitySolver>(spec_, starting_player_, protagonist_player_, priorities, state_space_);
+    solver->set_preimage_engine(preimage_engine_);
+    solver->set_state_abstraction(state_abstraction_);
+    solver->set_realizability_only(realizability_only_);
+    return solver->run().winning_states;
+  }
+
+  CUDD::BDD EmersonLei::EmersonLeiSolve(ZielonkaNode *t, CUDD::BDD term) const {
+    return EmersonLeiSolve(t, term, nullptr);
+  }
+
+  CUDD::BDD EmersonLei::EmersonLeiSolve(ZielonkaNode *t, CUDD::BDD term, const CUDD::BDD *start) const {
+    if (DEBUG_MODE) {
+      SYFT_DEBUG_TRACE("state space: {}", Syft::debug_string(state_space_));
+      SYFT_DEBUG_TRACE("term: {}", Syft::debug_string(term));
+    }
+    // Without strategy extraction, solving has no side effect that the cache would skip
+    bool use_cache = realizability_only_ || !STRATEGY;
+    std::pair<size_t, DdNode*> cache_key(t->dag_id, term.getNode());
+    if (use_cache) {
+      auto cached = solve_cache_.find(cache_key);
+      if (cached != solve_cache_.end()) {
+        solve_cache_hits_++;
+        SYFT_DEBUG_TRACE("[EmersonLeiSolve] node={} solved by dag node {} ({} cache hits)", t->order, t->dag_id,
+                         solve_cache_hits_);
+        return cached->second.second;
+      }
+    }
+
+    // Expanded on the first entry into the node; a cached solve above skips the subtree altogether
+    const std::vector<ZielonkaNode*> &children = z_tree_->children(t);
+    // The results kept for the grandchildren belong to the previous solve of t, whose terms are unrelated
+    bool warm_start = warm_start_ && use_cache;
+    if (warm_start) {
+      for (ZielonkaNode *s : children) {
+        for (ZielonkaNode *grandchild : s->children) {
+          warm_starts_.erase(grandchild);
+        }
+      }
+    }
+
+    TraceScope trace("EL node", "game");
+    trace.arg("node", t->order).bdd("term_nodes", term);
+    CUDD::BDD X, XX;
+
+    // lightweight entry log (debug level for recursive calls)
+    SYFT_DEBUG_TRACE("[EmersonLeiSolve] entering node={} initial_X_nodes={}", t->order, (var_mgr_->cudd_mgr()->bddOne()).nodeCount());
+
+    // initialize variables for fixpoint computation (gfp for winning / lfp for losing)
+    if (t->winning) {
+      X = var_mgr_->cudd_mgr()->bddOne();
+      if (children.empty()) {
+        // t->winningmoves[0]=var_mgr_->cudd_mgr()->bddOne();
+        // t->winningmoves.push_back(var_mgr_->cudd_mgr()->bddOne());
+        
+        if (adv_mp_) {
+          t->winningmoves.push_back(state_space_);
+        } else {
+          t->winningmoves.push_back(!instant_losing_);
+        }
+      } else {
+        for (int i = 0; i < children.size(); i++) {
+          //t->winningmoves[i] = var_mgr_->cudd_mgr()->bddOne();
+          // t->winningmoves.push_back(var_mgr_->cudd_mgr()->bddOne());
+          if (adv_mp_) {
+            t->winningmoves.push_back(state_space_);
+          } else {
+            t->winningmoves.push_back(!instant_losing_);
+          }
+          
+        }
+      }
+    } else {
+      X = var_mgr_->cudd_mgr()->bddZero();
+      if (children.empty()) {
+        // t->winningmoves[0]=var_mgr_->cudd_mgr()->bddZero();
+        t->winningmoves.push_back(var_mgr_->cudd_mgr()->bddZero());
+      } else {
+        for (int i = 0; i < children.size(); i++) {
+          // t->winningmoves[i] = var_mgr_->cudd_mgr()->bddZero();
+          t->winningmoves.push_back(var_mgr_->cudd_mgr()->bddZero());
+        }
+      }
+    }
+    if (start) {
+      // A bound of the fixpoint on the side of X, from which the iterates still move monotonically (see set_warm_start)
+      X = *start;
+      SYFT_DEBUG_TRACE("[EmersonLeiSolve] node={} warm start X_nodes={}", t->order, X.nodeCount());
+    }
+    if (DEBUG_MODE) {
+      SYFT_DEBUG_TRACE("Node: {} X: {}", t->order, Syft::debug_string(X));
+    }
+
+    // The children by target size (see set_child_order), and their last results
+    std::vector<int> by_target(children.size());
+    std::iota(by_target.begin(), by_target.end(), 0);
+    if (child_order_ == ChildOrder::SmallestTarget) {
+      int state_bits = static_cast<int>(var_mgr_->state_variable_count(spec_.automaton_id()));
+      std::vector<double> target_sizes;
+      for (ZielonkaNode *s : children) {
+        target_sizes.push_back(s->targetnodes.CountMinterm(state_bits));
+      }
+      std::stable_sort(by_target.begin(), by_target.end(), [&](int a, int b) {
+        return t->winning ? target_sizes[a] < target_sizes[b] : target_sizes[a] > target_sizes[b];
+      });
+    }
+    std::vector<CUDD::BDD> child_results(children.size());
+    std::vector<bool> child_changed(children.size(), true);
+
+    // loop until fixpoint has stabilized
+    FixpointProbe probe("emerson-lei", std::to_string(t->order),
+                        var_mgr_->state_variable_count(spec_.automaton_id()));
+    int outer_iter = 0;
+    while (true) {
+      var_mgr_->check_budget("fixpoint");
+      outer_iter++;
+      int inner_iter = 0;
+      if (DEBUG_MODE) {
+  SYFT_DEBUG_TRACE("[EmersonLeiSolve] Node: {} outer_iter={}", t->order, outer_iter);
+  SYFT_DEBUG_TRACE("[EmersonLeiSolve] X nodes={}", X.nodeCount());
+  SYFT_DEBUG_TRACE("instant winning: {}", instant_winning_.nodeCount());
+  SYFT_DEBUG_TRACE("instant losing: {}", instant_losing_.nodeCount());
+      }
+
+      // lightweight per-outer-iteration info log; includes inner iteration count later
+      // we'll update this after computing XX to include inner_iter and XX.nodeCount()
+
+      // if t is a leaf
+        if (children.empty()) {
+        
+        // std::cout << "t->safenodes:" <<  t->safenodes << "\n";
+        // XX = term | (t->safenodes & cpre(t, 0, X & (!instant_losing_)));
+        if (adv_mp_) {
+          inner_iter++;
+          {
+            Syft::DebugStopwatch stopwatch;
+            XX = term | (t->safenodes & cpre(t, 0, X | instant_winning_));
+            SYFT_DEBUG_TRACE("[EmersonLeiSolve] cpre(child leaf) took={} ms", stopwatch.elapsed_ms());
+          }
+        } else {
+          inner_iter++;
+          XX = term | (t->safenodes & cpre(t, 0, X & (!instant_losing_)));
+        }
+        // std::cout << "cpre:" << cpre(t, 0, X & (!instant_losing_)) << "\n";
+        
+      }
+
+      // if t is not a leaf
+      else {
+        // initialize intersecion for winning / union for losing
+        if (t->winning) {
+          XX = var_mgr_->cudd_mgr()->bddOne();
+        } else {
+          XX = var_mgr_->cudd_mgr()->bddZero();
+        }
+
+        // Children are solved concurrently when wide and large enough; their
+        // terms are then collected first
+        // The managers of the workers compose with the concrete transition function only
+        bool parallel = threads_ > 1 && use_cache && !state_abstraction_ &&
+                        children.size() >= parallel_min_children_ && X.nodeCount() >= parallel_min_nodes_;
+        std::vector<CUDD::BDD> child_terms;
+        // Without winning moves, the children that cannot change XX anymore are skipped
+        bool skip_decided = child_order_ != ChildOrder::Construction && use_cache && !parallel;
+        // The parallel solve takes the terms of all children in the order of the tree
+        std::vector<int> order(children.size());
+        std::iota(order.begin(), order.end(), 0);
+        if (!parallel && child_order_ == ChildOrder::SmallestTarget) {
+          order = by_target;
+        } else if (!parallel && child_order_ == ChildOrder::ChangedFirst) {
+          std::stable_partition(order.begin(), order.end(), [&](int i) { return child_changed[i]; });
+        }
+
+        // iterate over direct children of t
+        // for (auto s : children) {
+        for (int i : order) {
+          // add new choice to term
+          auto s = children[i];
+          CUDD::BDD current_term;
+
+          if (DEBUG_MODE) {
+            SYFT_DEBUG_TRACE("i: {}", i);
+          }
+
+            if (adv_mp_){
+            inner_iter++;
+            Syft::DebugStopwatch stopwatch;
+            current_term = term | (s->targetnodes & cpre(t, i, X | instant_winning_));
+            if (DEBUG_MODE) {
+              SYFT_DEBUG_TRACE("[EmersonLeiSolve] cpre(child non-leaf) idx={} took={} ms", i, stopwatch.elapsed_ms());
+            }
+          } else {
+            inner_iter++;
+            Syft::DebugStopwatch stopwatch;
+            current_term = term | (s->targetnodes & cpre(t, i, X & (!instant_losing_)));
+            SYFT_DEBUG_TRACE("[EmersonLeiSolve] cpre(child non-leaf) idx={} took={} ms", i, stopwatch.elapsed_ms());
+          }
+          
+          // std::cout << "cpre:" << instant_winning_ << "\n";
+          
+          if (parallel) {
+            child_terms.push_back(current_term);
+            continue;
+          }
+          CUDD::BDD child_winning;
+          if (warm_start) {
+            // The result of s in this iteration of t, from the previous iteration of the parent of t, if any
+            std::optional<CUDD::BDD> previous;
+            const std::vector<CUDD::BDD> &starts = warm_starts_[s];
+            if (static_cast<size_t>(outer_iter) <= starts.size() && starts[outer_iter - 1].getNode() != nullptr) {
+              previous = starts[outer_iter - 1];
+            }
+            child_winning = EmersonLeiSolve(s, current_term, previous ? &*previous : nullptr);
+            std::vector<CUDD::BDD> &results = warm_starts_[s];
+            if (results.size() < static_cast<size_t>(outer_iter)) {
+              results.resize(outer_iter);
+            }
+            results[outer_iter - 1] = child_winning;
+          } else {
+            child_winning = EmersonLeiSolve(s, current_term);
+          }
+          if (child_order_ == ChildOrder::ChangedFirst) {
+            child_changed[i] = child_results[i].getNode() == nullptr || child_results[i] != child_winning;
+            child_results[i] = child_winning;
+          }
+          if (t->winning) {
+            // intersect with recursively computed solution for s and current term
+            XX &= child_winning;
+          } else {
+            // union with recursively computed solution for s and current term
+            XX |= child_winning;
+          }
+          // Every child result contains its term, which contains term
+          if (skip_decided && (t->winning ? XX == term : XX.IsOne())) {
+            SYFT_DEBUG_TRACE("[EmersonLeiSolve] node={} decided after child {}", t->order, i);
+            break;
+          }
+        }
+        if (parallel) {
+          for (const CUDD::BDD &child_winning : SolveChildrenInParallel(t, child_terms)) {
+            if (t->winning) {
+              XX &= child_winning;
+            } else {
+              XX |= child_winning;
+            }
+          }
+        }
+      }
+     if (DEBUG_MODE) {
+  SYFT_DEBUG_TRACE("[EmersonLeiSolve] outer_iter={} inner_iter={} X_nodes={} XX_nodes={}", outer_iter, inner_iter, X.nodeCount(), XX.nodeCount());
+        //var_mgr_->dump_dot(XX.Add(), "XX.dot");
+    }
+
+  // Info-level trace of the fixpoint progress for lightweight logging/monitoring
+  spdlog::info("[EmersonLeiSolve] node={} outer_iter={} inner_iter={} X_nodes={} XX_nodes={}",
+       t->order, outer_iter, inner_iter, X.nodeCount(), XX.nodeCount());
+      probe.iteration(XX);
+
+      if (X == XX) {
+        break;
+      } else {
+        X = XX;
+      }
+
+      if (t == z_tree_->get_root() && root_iteration_decides(X, t->winning)) {
+        spdlog::info("[EmersonLeiSolve] initial state decided at outer_iter={}", outer_iter);
+        break;
+      }
+    }
+
+    // The root may stop before the fixpoint is reached, so it is not cached
+    if (use_cache && t != z_tree_->get_root()) {
+      // The key's term is kept alive by the entry, so its node cannot be reused
+      solve_cache_.emplace(cache_key, std::make_pair(term, X));
+    }
+
+    trace.arg("iterations", outer_iter).bdd("winning_nodes", X);
+    // return stabilized fixpoint
+    return X;
+  }
+
+
+  // A small, copy of the classic Büchi double-fixpoint (nu X. mu Y. (F ∩ CPre(X)) ∪ CPre(Y) ∪ Y)
+  // Implemented here inside EmersonLei so we can compare performance with the EL solver.
+  // Aligned to match EL solver's cpre pattern: restrict to state_space early, apply instant_winning/losing filters.
+  CUDD::BDD EmersonLei::BuchiAlgorithm() const {
+    auto mgr = var_mgr_->cudd_mgr();
+    CUDD::BDD F = (product_arena_ ? product_arena_->final_states() : spec_.final_states()) & state_space_;
+
+    // Outer greatest fixpoint: X starts at true
+    CUDD::BDD X = mgr->bddOne();
+    CUDD::BDD prevX = mgr->bddZero();
+
+    int outer_iter = 0;
+    while (!(X == prevX)) {
+      var_mgr_->check_budget("fixpoint");
+      prevX = X;
+      outer_iter++;
+
+      // Inner least fixpoint: Y starts at false
+      CUDD::BDD Y = mgr->bddZero();
+      CUDD::BDD prevY;
+      int inner_iter = 0;
+
+      // Precompute F ∩ CPre(X) using the same pattern as EL's cpre:
+      // 1. Restrict target to state_space (and optionally instant_winning if adv_mp)
+      // 2. Compute preimage
+      // 3. Restrict to state_space before projection
+      // 4. Project into states
+      CUDD::BDD X_target;
+      if (adv_mp_) {
+        X_target = (X | instant_winning_) & state_space_;
+      } else {
+        X_target = X & state_space_;
+      }
+      CUDD::BDD quantified_X = preimage(X_target);
+      CUDD::BDD new_target_moves;
+      if (adv_mp_) {
+        new_target_moves = (state_space_ & quantified_X);
+      } else {
+        new_target_moves = (state_space_ & quantified_X) & (!instant_losing_);
+      }
+      CUDD::BDD FcpreX = F & project_into_states(new_target_moves);
+
+      do {
+        var_mgr_->check_budget("fixpoint");
+        prevY = Y;
+        inner_iter++;
+
+        // CPre(Y) using the same aligned pattern
+        CUDD::BDD Y_target;
+        if (adv_mp_) {
+          Y_target = (Y | instant_winning_) & state_space_;
+        } else {
+          Y_target = Y & state_space_;
+        }
+        CUDD::BDD quantified_Y = preimage(Y_target);
+        CUDD::BDD new_Y_moves;
+        if (adv_mp_) {
+          new_Y_moves = (state_space_ & quantified_Y);
+        } else {
+          new_Y_moves = (state_space_ & quantified_Y) & (!instant_losing_);
+        }
+        CUDD::BDD cpreY = project_into_states(new_Y_moves);
+
+        // newY = (F ∩ CPre(X)) ∪ CPre(Y) ∪ Y
+        CUDD::BDD newY = (FcpreX | cpreY) | Y;
+        Y = newY & state_space_;
+
+        SYFT_DEBUG_TRACE("[BuchiAlgorithm] outer={} inner={} Y_nodes={}", outer_iter, inner_iter, Y.nodeCount());
+      } while (!(Y == prevY));
+
+      X = Y & state_space_;
+      spdlog::info("[BuchiAlgorithm] finished outer={} inner_iters={} X_nodes={}", outer_iter, inner_iter, X.nodeCount());
+      if (realizability_only_ && !includes_initial_state(X)) {
+        break;
+      }
+    }
+
+    return X & state_space_;
+  }
+
+
+}
@@ -0,0 +1,478 @@
+#include "game/ExplicitGameSolver.h"
+#include "Trace.h"
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <spdlog/spdlog.h>
+
+namespace Syft {
+
+namespace {
+    std::vector<std::string> labels_of(const VarMgr& var_mgr, Player player) {
+        return player == Player::Agent ? var_mgr.output_variable_labels() : var_mgr.input_variable_labels();
+    }
+
+    // The bit of each DFA variable in a move of player, or -1 for the variables of the other player
+    std::vector<int> move_bits(const ExplicitStateDfa& dfa, const VarMgr& var_mgr, Player player) {
+        std::vector<std::string> labels = labels_of(var_mgr, player);
+        std::unordered_set<std::string> moved(labels.begin(), labels.end());
+        std::vector<int> bits(dfa.names.size(), -1);
+        int next_bit = 0;
+        for (std::size_t i = 0; i < dfa.names.size(); ++i) {
+            if (moved.count(dfa.names[i]) > 0) {
+                bits[i] = next_bit++;
+            }
+        }
+        return bits;
+    }
+
+    std::size_t bit_count(const std::vector<int>& bits) {
+        std::size_t count = 0;
+        for (int bit : bits) {
+            count += bit >= 0;
+        }
+        return count;
+    }
+
+    // Calls visit(state) for each state of states, in increasing order
+    template <typename Visit>
+    void for_each_state(const StateBitset& states, Visit visit) {
+        const std::vector<std::uint64_t>& words = states.words();
+        for (std::size_t w = 0; w < words.size(); ++w) {
+            std::uint64_t word = words[w];
+            while (word != 0) {
+                visit(w * 64 + static_cast<std::size_t>(__builtin_ctzll(word)));
+                word &= word - 1;
+            }
+        }
+    }
+}
+
+StateBitset::StateBitset(std::size_t size, bool full)
+    : size_(size), words_((size + 63) / 64, full ? ~std::uint64_t(0) : 0) {
+    if (full && size % 64 != 0) {
+        words_.back() = (std::uint64_t(1) << (size % 64)) - 1;
+    }
+}
+
+std::size_t StateBitset::count() const {
+    std::size_t count = 0;
+    for (std::uint64_t word : words_) {
+        count += static_cast<std::size_t>(__builtin_popcountll(word));
+    }
+    return count;
+}
+
+bool StateBitset::none() const {
+    std::uint64_t any = 0;
+    for (std::uint64_t word : words_) {
+        any |= word;
+    }
+    return any == 0;
+}
+
+StateBitset StateBitset::operator~() const {
+    StateBitset complement(size_, true);
+    for (std::size_t w = 0; w < words_.size(); ++w) {
+        complement.words_[w] &= ~words_[w];
+    }
+    return complement;
+}
+
+StateBitset& StateBitset::operator|=(const StateBitset& other) {
+    for (std::size_t w = 0; w < words_.size(); ++w) {
+        words_[w] |= other.words_[w];
+    }
+    return *this;
+}
+
+StateBitset& StateBitset::operator&=(const StateBitset& other) {
+    for (std::size_t w = 0; w < words_.size(); ++w) {
+        words_[w] &= other.words_[w];
+    }
+    return *this;
+}
+
+ExplicitGameSolver::ExplicitGameSolver(SharedExplicitStateDfa dfa, std::shared_ptr<VarMgr> var_mgr,
+                                       Player starting_player, Player protagonist_player)
+    : dfa_(std::move(dfa)), var_mgr_(std::move(var_mgr)), starting_player_(starting_player),
+      protagonist_player_(protagonist_player) {
+    move_bit_ = move_bits(*dfa_, *var_mgr_, starting_player_);
+    move_count_ = std::size_t(1) << bit_count(move_bit_);
+    TraceScope trace("explicit game graph", "game");
+    build_rows();
+    trace.arg("states", static_cast<double>(state_count())).arg("edges", static_cast<double>(edge_count()));
+    spdlog::info("[ExplicitGameSolver] {} states, {} moves per state, {} edges", state_count(), move_count_,
+                 edge_count());
+}
+
+bool ExplicitGameSolver::applicable(const ExplicitStateDfa& dfa, const VarMgr& var_mgr, Player starting_player,
+                                    std::size_t max_states) {
+    std::size_t states = static_cast<std::size_t>(dfa.dfa_->ns);
+    std::size_t bits = bit_count(move_bits(dfa, var_mgr, starting_player));
+    return states <= max_states && bits < 32 && (states << bits) <= max_rows;
+}
+
+void ExplicitGameSolver::set_realizability_only(bool realizability_only) {
+    realizability_only_ = realizability_only;
+}
+
+std::size_t ExplicitGameSolver::state_count() const {
+    return static_cast<std::size_t>(dfa_->dfa_->ns);
+}
+
+std::size_t ExplicitGameSolver::move_count() const {
+    return move_count_;
+}
+
+std::size_t ExplicitGameSolver::edge_count() const {
+    return successors_.size();
+}
+
+const StateBitset& ExplicitGameSolver::final_states() const {
+    return final_states_;
+}
+
+bool ExplicitGameSolver::protagonist_moves_first() const {
+    return protagonist_player_ == starting_player_;
+}
+
+void ExplicitGameSolver::build_rows() {
+    const DFA* dfa = dfa_->dfa_;
+    bdd_manager* bddm = dfa->bddm;
+    std::size_t states = state_count();
+    std::size_t rows = states * move_count_;
+
+    final_states_ = StateBitset(states);
+    for (std::size_t s = 0; s < states; ++s) {
+        if (dfa->f[s] == 1) {
+            final_states_.set(s);
+        }
+    }
+
+    row_offsets_.clear();
+    row_offsets_.reserve(rows + 1);
+    row_offsets_.push_back(0);
+    successors_.clear();
+    // The last row that reached each state and each BDD node, so that neither is visited twice per row
+    std::vector<std::size_t> state_row(states, std::numeric_limits<std::size_t>::max());
+    std::unordered_map<unsigned, std::size_t> node_row;
+    std::vector<unsigned> stack;
+    for (std::size_t s = 0; s < states; ++s) {
+        for (std::size_t move = 0; move < move_count_; ++move) {
+            std::size_t row = s * move_count_ + move;
+            stack.assign(1, dfa->q[s]);
+            while (!stack.empty()) {
+                unsigned node = stack.back();
+                stack.pop_back();
+                auto [visited, inserted] = node_row.try_emplace(node, row);
+                if (!inserted) {
+                    if (visited->second == row) {
+                        continue;
+                    }
+                    visited->second = row;
+                }
+                unsigned index, low, high;
+                LOAD_lri(&bddm->node_table[node], low, high, index);
+                if (index == BDD_LEAF_INDEX) {
+                    // The leaf holds the successor state
+                    if (state_row[low] != row) {
+                        state_row[low] = row;
+                        successors_.push_back(low);
+                    }
+                } else if (move_bit_[index] >= 0) {
+                    stack.push_back((move >> move_bit_[index]) & 1 ? high : low);
+                } else {
+                    stack.push_back(low);
+                    stack.push_back(high);
+                }
+            }
+            row_offsets_.push_back(successors_.size());
+        }
+    }
+}
+
+StateBitset ExplicitGameSolver::controllable_preimage(const StateBitset& target) const {
+    std::size_t states = state_count();
+    StateBitset result(states);
+    auto row_in = [&](std::size_t row) {
+        for (std::size_t e = row_offsets_[row]; e < row_offsets_[row + 1]; ++e) {
+            if (!target.test(successors_[e])) {
+                return false;
+            }
+        }
+        return true;
+    };
+    auto row_meets = [&](std::size_t row) {
+        for (std::size_t e = row_offsets_[row]; e < row_offsets_[row + 1]; ++e) {
+            if (target.test(successors_[e])) {
+                return true;
+            }
+        }
+        return false;
+    };
+    bool first = protagonist_moves_first();
+    for (std::size_t s = 0; s < states; ++s) {
+        std::size_t begin = s * move_count_;
+        bool controlled = !first;
+        for (std::size_t row = begin; row < begin + move_count_; ++row) {
+            if (first && row_in(row)) {
+                controlled = true;
+                break;
+            }
+            if (!first && !row_meets(row)) {
+                controlled = false;
+                break;
+            }
+        }
+        if (controlled) {
+            result.set(s);
+        }
+    }
+    return result;
+}
+
+StateBitset ExplicitGameSolver::attractor(const StateBitset& base, const StateBitset& bound,
+                                          std::vector<std::uint32_t>& ranks, std::uint32_t first_rank,
+                                          bool stop_at_initial, std::size_t& iterations) const {
+    std::size_t initial = static_cast<std::size_t>(dfa_->dfa_->s);
+    StateBitset reached = base;
+    reached &= bound;
+    for_each_state(reached, [&](std::size_t s) { ranks[s] = first_rank; });
+    std::uint32_t rank = first_rank;
+    while (!(stop_at_initial && reached.test(initial))) {
+        var_mgr_->check_budget("fixpoint");
+        ++iterations;
+        ++rank;
+        // Rounds rather than a worklist, so that the successors of a state always have lower ranks
+        StateBitset added = controllable_preimage(reached);
+        added &= bound;
+        added &= ~reached;
+        if (added.none()) {
+            break;
+        }
+        for_each_state(added, [&](std::size_t s) { ranks[s] = rank; });
+        reached |= added;
+    }
+    return reached;
+}
+
+ExplicitGameResult ExplicitGameSolver::solve(ExplicitGameCondition condition) const {
+    TraceScope trace("explicit game", "game");
+    std::size_t states = state_count();
+    std::size_t initial = static_cast<std::size_t>(dfa_->dfa_->s);
+    StateBitset all(states, true);
+    ExplicitGameResult result;
+    result.ranks.assign(states, 0);
+
+    switch (condition) {
+        case ExplicitGameCondition::Reachability:
+            result.winning_states = attractor(final_states_, all, result.ranks, 0, realizability_only_, result.iterations);
+            break;
+        case ExplicitGameCondition::Safety: {
+            StateBitset X = final_states_;
+            while (true) {
+                var_mgr_->check_budget("fixpoint");
+                ++result.iterations;
+                StateBitset next = controllable_preimage(X);
+                next &= X;
+                if (next == X || (realizability_only_ && !next.test(initial))) {
+                    X = next;
+                    break;
+                }
+                X = next;
+            }
+            result.winning_states = X;
+            break;
+        }
+        case ExplicitGameCondition::Buchi: {
+            StateBitset Z = all;
+            while (true) {
+                ++result.iterations;
+                StateBitset base = controllable_preimage(Z);
+                base &= final_states_;
+                // Each inner attractor must complete, so only the outer fixpoint stops early
+                StateBitset Y = attractor(base, Z, result.ranks, 0, false, result.iterations);
+                bool stable = Y == Z;
+                Z = Y;
+                if (stable || (realizability_only_ && !Z.test(initial))) {
+                    break;
+                }
+            }
+            result.winning_states = Z;
+            break;
+        }
+        case ExplicitGameCondition::CoBuchi: {
+            StateBitset X(states);
+            for (std::uint32_t level = 1;; ++level) {
+                StateBitset escape = controllable_preimage(X);
+                ++result.iterations;
+                StateBitset Y = all;
+                while (true) {
+                    var_mgr_->check_budget("fixpoint");
+                    ++result.iterations;
+                    StateBitset next = controllable_preimage(Y);
+                    next &= final_states_;
+                    next |= escape;
+                    if (next == Y) {
+                        break;
+                    }
+                    Y = next;
+                }
+                StateBitset added = Y;
+                added &= ~X;
+                if (added.none()) {
+                    break;
+                }
+                for_each_state(added, [&](std::size_t s) { result.ranks[s] = level; });
+                X |= added;
+                if (realizability_only_ && X.test(initial)) {
+                    break;
+                }
+            }
+            result.winning_states = X;
+            break;
+        }
+    }
+
+    result.realizability = result.winning_states.test(initial);
+    trace.arg("iterations", static_cast<double>(result.iterations))
+         .arg("winning_states", static_cast<double>(result.winning_states.count()));
+    spdlog::info("[ExplicitGameSolver] {} of {} states winning after {} iterations",
+                 result.winning_states.count(), states, result.iterations);
+    return result;
+}
+
+bool ExplicitGameSolver::progresses(const ExplicitGameResult& result, ExplicitGameCondition condition,
+                                    std::size_t state, std::size_t successor) const {
+    const std::vector<std::uint32_t>& ranks = result.ranks;
+    bool winning = result.winning_states.test(successor);
+    switch (condition) {
+        case ExplicitGameCondition::Reachability:
+            // The goal is reached, whatever follows
+            return ranks[state] == 0 || (winning && ranks[successor] < ranks[state]);
+        case ExplicitGameCondition::Safety:
+            return winning;
+        case ExplicitGameCondition::Buchi:
+            // The final states of rank 0 may move anywhere in the winning region
+            return winning && (ranks[state] == 0 || ranks[successor] < ranks[state]);
+        case ExplicitGameCondition::CoBuchi:
+            // Only final states may stay on their level
+            return winning && (ranks[successor] < ranks[state] ||
+                               (final_states_.test(state) && ranks[successor] <= ranks[state]));
+    }
+    return false;
+}
+
+std::vector<int> ExplicitGameSolver::response(const ExplicitGameResult& result, ExplicitGameCondition condition,
+                                              std::size_t state, std::size_t move) const {
+    bdd_manager* bddm = dfa_->dfa_->bddm;
+    std::vector<int> values(dfa_->names.size(), 0);
+    // Nodes from which no assignment progresses
+    std::unordered_set<unsigned> failed;
+    std::function<bool(unsigned)> search = [&](unsigned node) {
+        if (failed.count(node) > 0) {
+            return false;
+        }
+        unsigned index, low, high;
+        LOAD_lri(&bddm->node_table[node], low, high, index);
+        bool found;
+        if (index == BDD_LEAF_INDEX) {
+            found = progresses(result, condition, state, low);
+        } else if (move_bit_[index] >= 0) {
+            found = search((move >> move_bit_[index]) & 1 ? high : low);
+        } else {
+            values[index] = 1;
+            found = search(high);
+            if (!found) {
+                values[index] = 0;
+                found = search(low);
+            }
+        }
+        if (!found) {
+            failed.insert(node);
+        }
+        return found;
+    };
+    if (!search(dfa_->dfa_->q[state])) {
+        throw std::runtime_error("Error: No winning response in state " + std::to_string(state));
+    }
+    return values;
+}
+
+CUDD::BDD ExplicitGameSolver::to_bdd(const StateBitset& states, const SymbolicStateDfa& arena,
+                                     StateEncodingKind encoding) const {
+    StateEncoding codes = StateEncoding::of(*dfa_, encoding);
+    CUDD::BDD result = var_mgr_->cudd_mgr()->bddZero();
+    for_each_state(states, [&](std::size_t s) {
+        result |= var_mgr_->state_vector_to_bdd(arena.automaton_id(), codes.code(s));
+    });
+    return result;
+}
+
+std::unique_ptr<Transducer> ExplicitGameSolver::transducer(const ExplicitGameResult& result,
+                                                           ExplicitGameCondition condition,
+                                                           const SymbolicStateDfa& arena,
+                                                           StateEncodingKind encoding) const {
+    StateEncoding codes = StateEncoding::of(*dfa_, encoding);
+    const std::vector<std::string>& names = dfa_->names;
+    std::vector<CUDD::BDD> variables;
+    for (const std::string& name : names) {
+        variables.push_back(var_mgr_->name_to_variable(name));
+    }
+    // Protagonist variables the DFA does not read stay false
+    std::unordered_map<int, CUDD::BDD> output_function;
+    for (const std::string& label : labels_of(*var_mgr_, protagonist_player_)) {
+        output_function[var_mgr_->name_to_variable(label).NodeReadIndex()] = var_mgr_->cudd_mgr()->bddZero();
+    }
+    auto set_outputs = [&](const std::vector<int>& values, const CUDD::BDD& guard) {
+        for (std::size_t i = 0; i < names.size(); ++i) {
+            if (values[i] == 1) {
+                output_function[variables[i].NodeReadIndex()] |= guard;
+            }
+        }
+    };
+
+    for_each_state(result.winning_states, [&](std::size_t s) {
+        CUDD::BDD state = var_mgr_->state_vector_to_bdd(arena.automaton_id(), codes.code(s));
+        for (std::size_t move = 0; move < move_count_; ++move) {
+            std::size_t row = s * move_count_ + move;
+            if (protagonist_moves_first()) {
+                bool progressing = true;
+                for (std::size_t e = row_offsets_[row]; e < row_offsets_[row + 1] && progressing; ++e) {
+                    progressing = progresses(result, condition, s, successors_[e]);
+                }
+                if (!progressing) {
+                    continue;
+                }
+                std::vector<int> values(names.size(), 0);
+                for (std::size_t i = 0; i < names.size(); ++i) {
+                    values[i] = move_bit_[i] >= 0 ? static_cast<int>((move >> move_bit_[i]) & 1) : 0;
+                }
+                set_outputs(values, state);
+                return;
+            }
+            // Answers each move of the other player
+            CUDD::BDD guard = state;
+            for (std::size_t i = 0; i < names.size(); ++i) {
+                if (move_bit_[i] >= 0) {
+                    guard &= (move >> move_bit_[i]) & 1 ? variables[i] : !variables[i];
+                }
+            }
+            set_outputs(response(result, condition, s, move), guard);
+        }
+        if (protagonist_moves_first()) {
+            throw std::runtime_error("Error: No winning move in state " + std::to_string(s));
+        }
+    });
+
+    return std::make_unique<Transducer>(var_mgr_,
+                                        var_mgr_->make_eval_vector(arena.automaton_id(), arena.initial_state()),
+                                        output_function, arena.transition_function(), starting_player_,
+                                        protagonist_player_, var_mgr_->get_state_variables(arena.automaton_id()));
+}
+
+}
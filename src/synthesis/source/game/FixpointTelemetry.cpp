@@ -0,0 +1,147 @@
+#include "game/FixpointTelemetry.h"
+
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "FlatJson.h"
+
+namespace Syft {
+
+namespace {
+    struct TelemetryFile {
+        std::mutex mutex;
+        int fd = -1;
+        bool csv = false;
+    };
+
+    std::atomic<bool> recording(false);
+
+    TelemetryFile& telemetry_file() {
+        static TelemetryFile* file = new TelemetryFile();  // Never destroyed, so that solvers may record at exit
+        return *file;
+    }
+
+    std::string format_number(double value, bool csv) {
+        if (!std::isfinite(value)) {
+            return csv ? "" : "null";
+        }
+        std::ostringstream out;
+        out.precision(15);
+        out << value;
+        return out.str();
+    }
+
+    std::string csv_field(const std::string& text) {
+        if (text.find_first_of(",\"\n") == std::string::npos) {
+            return text;
+        }
+        std::string quoted = "\"";
+        for (char c : text) {
+            quoted += c == '"' ? "\"\"" : std::string(1, c);
+        }
+        return quoted + "\"";
+    }
+
+    bool ends_with(const std::string& text, const std::string& suffix) {
+        return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+    // Telemetry must not fail a solve, so a failed write only leaves the file as written so far
+    void write_line(int fd, const std::string& line) {
+        ssize_t written = write(fd, line.data(), line.size());
+        static_cast<void>(written);
+    }
+
+    double milliseconds(std::chrono::steady_clock::duration duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+}
+
+void FixpointTelemetry::start(const std::string& filename) {
+    TelemetryFile& file = telemetry_file();
+    std::lock_guard<std::mutex> lock(file.mutex);
+    if (file.fd >= 0) {
+        close(file.fd);
+    }
+    file.fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0644);
+    if (file.fd < 0) {
+        recording.store(false);
+        throw std::runtime_error("Error: Could not open fixpoint telemetry file for writing: " + filename);
+    }
+    file.csv = ends_with(filename, ".csv");
+    if (file.csv) {
+        std::string header = "pid,solver,node,iteration,approximation_nodes,approximation_states,iteration_ms,"
+                             "elapsed_ms\n";
+        write_line(file.fd, header);
+    }
+    recording.store(true);
+}
+
+bool FixpointTelemetry::enabled() {
+    return recording.load(std::memory_order_relaxed);
+}
+
+void FixpointTelemetry::finish() {
+    if (!recording.exchange(false)) {
+        return;
+    }
+    TelemetryFile& file = telemetry_file();
+    std::lock_guard<std::mutex> lock(file.mutex);
+    close(file.fd);
+    file.fd = -1;
+}
+
+void FixpointTelemetry::record(const char* solver, const std::string& node, std::size_t iteration,
+                               double approximation_nodes, double approximation_states,
+                               double iteration_ms, double elapsed_ms) {
+    TelemetryFile& file = telemetry_file();
+    std::string line;
+    std::string pid = std::to_string(getpid());
+    if (file.csv) {
+        line = pid + "," + csv_field(solver) + "," + csv_field(node) + "," + std::to_string(iteration) + "," +
+               format_number(approximation_nodes, true) + "," + format_number(approximation_states, true) + "," +
+               format_number(iteration_ms, true) + "," + format_number(elapsed_ms, true) + "\n";
+    } else {
+        line = "{\"pid\": " + pid + ", \"solver\": " + json_quote(solver) + ", \"node\": " + json_quote(node) +
+               ", \"iteration\": " + std::to_string(iteration) +
+               ", \"approximation_nodes\": " + format_number(approximation_nodes, false) +
+               ", \"approximation_states\": " + format_number(approximation_states, false) +
+               ", \"iteration_ms\": " + format_number(iteration_ms, false) +
+               ", \"elapsed_ms\": " + format_number(elapsed_ms, false) + "}\n";
+    }
+    std::lock_guard<std::mutex> lock(file.mutex);
+    // Finished by another thread since the probe started
+    if (file.fd < 0) {
+        return;
+    }
+    write_line(file.fd, line);
+}
+
+FixpointProbe::FixpointProbe(const char* solver, std::string node, std::size_t state_bits)
+    : active_(FixpointTelemetry::enabled()), solver_(solver), node_(std::move(node)), state_bits_(state_bits) {
+    if (active_) {
+        start_ = last_ = std::chrono::steady_clock::now();
+    }
+}
+
+void FixpointProbe::iteration(const CUDD::BDD& approximation) {
+    if (!active_) {
+        return;
+    }
+    ++iterations_;
+    auto now = std::chrono::steady_clock::now();
+    FixpointTelemetry::record(solver_, node_, iterations_, approximation.nodeCount(),
+                              approximation.CountMinterm(static_cast<int>(state_bits_)),
+                              milliseconds(now - last_), milliseconds(now - start_));
+    // The time spent counting is not part of the next iteration
+    last_ = std::chrono::steady_clock::now();
+}
+
+}
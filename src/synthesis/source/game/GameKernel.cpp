@@ -0,0 +1,36 @@
+#include "game/GameKernel.h"
+
+namespace Syft {
+
+    GameKernel::GameKernel(Player starting_player, Player protagonist_player, const CUDD::BDD &input_cube,
+                           const CUDD::BDD &output_cube) {
+        bool agent = protagonist_player == Player::Agent;
+        cubes_.protagonist = agent ? output_cube : input_cube;
+        cubes_.opponent = agent ? input_cube : output_cube;
+
+        if (starting_player == Player::Agent) {
+            if (agent) {
+                select<Player::Agent, Player::Agent>();
+            } else {
+                select<Player::Agent, Player::Environment>();
+            }
+        } else {
+            if (agent) {
+                select<Player::Environment, Player::Agent>();
+            } else {
+                select<Player::Environment, Player::Environment>();
+            }
+        }
+    }
+
+    template <Player Starting, Player Protagonist>
+    void GameKernel::select() {
+        using Quantifiers = GameQuantifiers<Starting, Protagonist>;
+        protagonist_first_ = Quantifiers::protagonist_first;
+        independent_ = &Quantifiers::independent;
+        non_state_ = &Quantifiers::non_state;
+        controllable_ = &Quantifiers::controllable;
+        quantifiers_ = &Quantifiers::quantifiers;
+    }
+
+}
@@ -0,0 +1,113 @@
+#include "game/LayeredEmersonLei.h"
+#include "game/EmersonLei.hpp"
+#include "game/SCCDecomposer.h"
+#include "Trace.h"
+
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+namespace Syft {
+    LayeredEmersonLei::LayeredEmersonLei(const SymbolicStateDfa &spec, ColorFormula color_formula,
+                                         Player starting_player, Player protagonist_player,
+                                         const std::vector<CUDD::BDD> &colorBDDs, const CUDD::BDD &state_space)
+            : DfaGameSynthesizer(spec, starting_player, protagonist_player), color_formula_(std::move(color_formula)),
+              colors_(colorBDDs), state_space_(state_space) {
+        condition_ = color_formula_.to_bdd([&](std::size_t color) {
+            return color_mgr_.bddVar(static_cast<int>(color));
+        }, color_mgr_);
+    }
+
+    LayeredEmersonLei::LayeredEmersonLei(const ProductArena &arena, ColorFormula color_formula,
+                                         Player starting_player, Player protagonist_player,
+                                         const std::vector<CUDD::BDD> &colorBDDs, const CUDD::BDD &state_space)
+            : LayeredEmersonLei(arena.symbolic_view(), std::move(color_formula), starting_player,
+                                protagonist_player, colorBDDs, state_space) {
+        product_arena_ = std::make_shared<ProductArena>(arena);
+    }
+
+    CUDD::BDD LayeredEmersonLei::solve_layer(const CUDD::BDD &layer, const CUDD::BDD &winning_below,
+                                             const CUDD::BDD &losing_below, std::size_t &tree_nodes) const {
+        // The colors of the layer, renumbered from 0; the others are only visited finitely often
+        CUDD::BDD condition = condition_;
+        std::vector<CUDD::BDD> layer_colors;
+        std::vector<std::size_t> layer_color(std::max(colors_.size(), color_formula_.color_count()), 0);
+        for (std::size_t i = 0; i < layer_color.size(); ++i) {
+            if (i < colors_.size() && !(layer & colors_[i]).IsZero()) {
+                layer_color[i] = layer_colors.size();
+                layer_colors.push_back(colors_[i]);
+            } else {
+                condition = condition.Restrict(!color_mgr_.bddVar(static_cast<int>(i)));
+            }
+        }
+        ColorFormula formula = ColorFormula::from_bdd(condition, [&](int index) {
+            return layer_color[static_cast<std::size_t>(index)];
+        });
+
+        // The layer is left for decided states only: the winning ones are targets, the losing ones avoided
+        std::unique_ptr<EmersonLei> solver = product_arena_
+            ? std::make_unique<EmersonLei>(*product_arena_, std::move(formula), starting_player_, protagonist_player_,
+                                           layer_colors, layer, winning_below, losing_below, true)
+            : std::make_unique<EmersonLei>(spec_, std::move(formula), starting_player_, protagonist_player_,
+                                           layer_colors, layer, winning_below, losing_below, true);
+        solver->set_preimage_engine(preimage_engine_);
+        solver->set_preimage_cache(preimage_cache_);
+        // The layers above read the winning states, which a verdict-only solve may leave partial
+        solver->set_realizability_only(realizability_only_ && !(layer & spec_.initial_state_bdd()).IsZero());
+        solver->set_defer_strategy(true);
+        solver->set_release_winning_moves(true);
+        CUDD::BDD winning = layer & solver->run_EL().winning_states;
+        // The trees are built as they are solved
+        tree_nodes = std::max(tree_nodes, solver->zielonka_tree()->size());
+        return winning;
+    }
+
+    SynthesisResult LayeredEmersonLei::run() const {
+        CUDD::BDD zero = var_mgr_->cudd_mgr()->bddZero();
+        std::vector<CUDD::BDD> layers;
+        {
+            TraceScope trace("SCC layers", "game");
+            ChainSCCDecomposer decomposer(spec_);
+            layers = decomposer.PeelLayers(state_space_);
+            trace.arg("layers", static_cast<double>(layers.size()));
+            var_mgr_->record_size("scc_symbolic_steps", static_cast<double>(decomposer.SymbolicSteps()));
+        }
+        CUDD::BDD remaining = state_space_;
+        for (const CUDD::BDD &layer : layers) {
+            remaining &= !layer;
+        }
+        if (!remaining.IsZero()) {
+            // Not a layering of the state space: solve it as a single layer
+            spdlog::warn("[LayeredEmersonLei::run] states outside the SCC layers, solving the whole arena");
+            layers = {state_space_};
+        }
+        var_mgr_->record_size("el_scc_layers", static_cast<double>(layers.size()));
+
+        CUDD::BDD initial = spec_.initial_state_bdd();
+        CUDD::BDD winning = zero;
+        CUDD::BDD losing = zero;
+        std::size_t solved = 0, tree_nodes = 0;
+        for (auto it = layers.rbegin(); it != layers.rend(); ++it) {
+            var_mgr_->check_budget("fixpoint");
+            CUDD::BDD layer_winning = solve_layer(*it, winning, losing, tree_nodes);
+            winning |= layer_winning;
+            losing |= *it & !layer_winning;
+            solved++;
+            if (realizability_only_ && !(initial & *it).IsZero()) {
+                break;
+            }
+        }
+        var_mgr_->record_size("el_scc_largest_tree_nodes", static_cast<double>(tree_nodes));
+        spdlog::info("[LayeredEmersonLei::run] {} of {} SCC layers solved, Zielonka trees of at most {} nodes",
+                     solved, layers.size(), tree_nodes);
+
+        SynthesisResult result;
+        result.winning_states = winning;
+        result.realizability = includes_initial_state(winning);
+        result.winning_moves = zero;
+        result.transducer = nullptr;
+        return result;
+    }
+
+}
@@ -4,7 +4,9 @@
 
 #include "game/MannaPnueli.hpp"
 #include "game/EmersonLei.hpp"
+#include "game/ColorFormula.h"
 #include "debug.hpp"
+#include "Trace.h"
 #include <iostream>
 #include <cuddObj.hh>
 #include <stack>
@@ -12,10 +14,35 @@
 #include <map>
 #include <cctype>
 #include <sstream>
-#include <regex>
 #include <queue>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <set>
+#include <thread>
+#include <utility>
+#include <spdlog/spdlog.h>
 
 namespace Syft {
+  namespace {
+    // A DAG node solved on its own manager, as by the sequential loop of run_MP
+    struct DagNodeGame {
+      std::shared_ptr<VarMgr> var_mgr;  // Declared first, so destroyed after every BDD below
+      std::unique_ptr<SymbolicStateDfa> spec;
+      ColorFormula color_formula;
+      std::vector<CUDD::BDD> colors;
+      CUDD::BDD state_space;
+      CUDD::BDD instant_winning;
+      CUDD::BDD instant_losing;
+      bool realizability = false;
+      CUDD::BDD winning;
+    };
+  }
+
   MannaPnueli::MannaPnueli(const SymbolicStateDfa &spec, const std::string color_formula, std::vector<int> F_colors,
                            std::vector<int> G_colors, Player starting_player,
                            Player protagonist_player,
@@ -35,35 +62,38 @@ namespace Syft {
     //   std::cout << "Color " << pair.first << " -> BDD ID: " << pair.second << std::endl;
     // }
     tie(dag_, node_to_id_) = build_FG_dag();
+    var_mgr_->record_size("mp_dag_nodes", static_cast<double>(dag_.size()));
+    // The EL subgames of the DAG nodes share the arena, and so their preimages
+    set_preimage_cache(std::make_shared<PreimageCache>());
 
     if (DEBUG_MODE) {
       print_FG_dag();
     }
   }
 
+  MannaPnueli::MannaPnueli(const ProductArena &arena, const std::string color_formula, std::vector<int> F_colors,
+                           std::vector<int> G_colors, Player starting_player,
+                           Player protagonist_player,
+                           const std::vector<CUDD::BDD> &colorBDDs,
+                           const CUDD::BDD &state_space, int game_solver)
+    : MannaPnueli(arena.symbolic_view(), color_formula, std::move(F_colors), std::move(G_colors), starting_player,
+                  protagonist_player, colorBDDs, state_space, game_solver) {
+    product_arena_ = std::make_shared<ProductArena>(arena);
+  }
+
   void MannaPnueli::print_FG_dag() const {
     std::cout << "EL DAG:\n";
     for (auto &[id, node]: dag_) {
-      std::cout << "Dag Node " << node->id << " (";
-      for (int bit: node->F) std::cout << bit;
-      std::cout << ", ";
-      for (int bit: node->G) std::cout << bit;
-      std::cout << ") <- {";
+      std::cout << "Dag Node " << node->id << " (" << node->F.to_string() << ", " << node->G.to_string() << ") <- {";
       for (Node *parent: node->parents) {
-        std::cout << " Dag Node " << parent->id << " (";
-        for (int bit: parent->F) std::cout << bit;
-        std::cout << ", ";
-        for (int bit: parent->G) std::cout << bit;
-        std::cout << ") ";
+        std::cout << " Dag Node " << parent->id << " (" << parent->F.to_string() << ", " << parent->G.to_string()
+                  << ") ";
       }
       std::cout << "}\n";
       std::cout << "-> {";
       for (auto child: node->children) {
-        std::cout << " Node " << child.first->id << " (";
-        for (int bit: child.first->F) std::cout << bit;
-        std::cout << ", ";
-        for (int bit: child.first->G) std::cout << bit;
-        std::cout << ") ";
+        std::cout << " Node " << child.first->id << " (" << child.first->F.to_string() << ", "
+                  << child.first->G.to_string() << ") ";
         std::cout << child.second << " ";
       }
       std::cout << "}\n";
@@ -79,124 +109,25 @@ namespace Syft {
     return result;
   }
 
-  std::string MannaPnueli::remove_whitespace(const std::string &str) const {
-    std::string result;
-    for (char ch: str) {
-      if (!isspace(ch)) result += ch;
-    }
-    return result;
-  }
-
-  int MannaPnueli::precedence(char op) const {
-    if (op == '!') return 3; // Highest precedence (Unary NOT)
-    if (op == '&') return 2; // AND
-    if (op == '|') return 1; // OR
-    return 0;
-  }
-
-  // Convert infix expression to postfix using Shunting-yard algorithm
-  std::string MannaPnueli::infix_to_postfix(const std::string &infix) const {
-    std::string postfix;
-    std::stack<char> ops;
-
-    for (size_t i = 0; i < infix.size(); i++) {
-      char ch = infix[i];
-
-      if (isdigit(ch)) {
-        postfix += ch;
-        // Check if it's a multi-digit number
-        while (i + 1 < infix.size() && isdigit(infix[i + 1])) {
-          postfix += infix[++i];
-        }
-        postfix += ' '; // Space as delimiter
-      } else if (ch == '(') {
-        ops.push(ch);
-      } else if (ch == ')') {
-        while (!ops.empty() && ops.top() != '(') {
-          postfix += ops.top();
-          postfix += ' ';
-          ops.pop();
-        }
-        ops.pop(); // Remove '('
-      } else if (ch == '!' || ch == '&' || ch == '|') {
-        while (!ops.empty() && precedence(ops.top()) >= precedence(ch)) {
-          postfix += ops.top();
-          postfix += ' ';
-          ops.pop();
-        }
-        ops.push(ch);
-      }
-    }
-
-    while (!ops.empty()) {
-      postfix += ops.top();
-      postfix += ' ';
-      ops.pop();
-    }
-
-    return postfix;
-  }
-
-  // Function to construct BDD from postfix expression
+  // Function to construct BDD from the compiled color formula
   CUDD::BDD MannaPnueli::boolean_string_to_bdd(const std::string &color_formula) {
-    std::string formula = remove_whitespace(color_formula);
-    std::string postfix = infix_to_postfix(formula);
-
-    std::stack<CUDD::BDD> bdd_stack;
-    std::stringstream ss(postfix);
-    std::string token;
-
-    while (ss >> token) {
-      if (isdigit(token[0])) {
-        int var = stoi(token);
-        // If variable is not already created, create it
-        if (color_to_variable_.find(var) == color_to_variable_.end()) {
-          CUDD::BDD var_bdd = color_mgr_.bddVar();
-          color_to_variable_[var] = var_bdd;
-          bdd_id_to_color_[var_bdd.NodeReadIndex()] = var;
-        }
-        bdd_stack.push(color_to_variable_[var]);
-      } else if (token == "!") {
-        CUDD::BDD operand = bdd_stack.top();
-        bdd_stack.pop();
-        bdd_stack.push(!operand);
-      } else if (token == "&") {
-        CUDD::BDD right = bdd_stack.top();
-        bdd_stack.pop();
-        CUDD::BDD left = bdd_stack.top();
-        bdd_stack.pop();
-        bdd_stack.push(left & right);
-      } else if (token == "|") {
-        CUDD::BDD right = bdd_stack.top();
-        bdd_stack.pop();
-        CUDD::BDD left = bdd_stack.top();
-        bdd_stack.pop();
-        bdd_stack.push(left | right);
-      }
-    }
-
-    return bdd_stack.top();
-  }
-
-  std::string MannaPnueli::color_formula_bdd_to_string(const CUDD::BDD &color_formula_bdd) const {
-    std::string formula_str = color_formula_bdd.FactoredFormString();
-
-    formula_str = std::regex_replace(formula_str, std::regex("x(\\d+)"), "$1");
-
-    // replace the bdd ID with their corresponding color
-    std::regex prop_regex(R"(\b\d+\b)"); // Matches whole numbers
-    std::sregex_iterator it(formula_str.begin(), formula_str.end(), prop_regex);
-    std::sregex_iterator end;
-
-    for (; it != end; ++it) {
-      int prop = std::stoi(it->str()); // Convert matched string to integer
-      if (bdd_id_to_color_.find(prop) != bdd_id_to_color_.end()) {
-        formula_str = std::regex_replace(formula_str, std::regex("\\b" + std::to_string(prop) + "\\b"),
-                                         std::to_string(bdd_id_to_color_.at(prop)));
+    ColorFormula formula(color_formula);
+    return formula.to_bdd([this](std::size_t color) {
+      int var = static_cast<int>(color);
+      // If variable is not already created, create it
+      if (color_to_variable_.find(var) == color_to_variable_.end()) {
+        CUDD::BDD var_bdd = color_mgr_.bddVar();
+        color_to_variable_[var] = var_bdd;
+        bdd_id_to_color_[var_bdd.NodeReadIndex()] = var;
       }
-    }
+      return color_to_variable_[var];
+    }, color_mgr_);
+  }
 
-    return formula_str;
+  ColorFormula MannaPnueli::compile_color_formula(const CUDD::BDD &color_formula_bdd) const {
+    return ColorFormula::from_bdd(color_formula_bdd, [this](int index) {
+      return static_cast<std::size_t>(bdd_id_to_color_.at(index));
+    });
   }
 
   std::pair<MannaPnueli::Dag, MannaPnueli::Node_to_Id> MannaPnueli::build_FG_dag() {
@@ -207,7 +138,7 @@ namespace Syft {
     int nodeCounter = 0; // Sizes of F and G, and a counter for node IDs
     // Map (F, G) states to node IDs
     std::queue<Node *> q;
-    std::vector<int> initialF(m, 1), initialG(n, 0);
+    ColorSet initialF(m, true), initialG(n);
     Node *root = new Node{initialF, initialG, nodeCounter++};
     dag[root->id] = root;
     node_to_id[{initialF, initialG}] = root->id;
@@ -217,16 +148,16 @@ namespace Syft {
       Node *node = q.front();
       q.pop();
 
-      int x = count(node->F.begin(), node->F.end(), 1);
-      int y = count(node->G.begin(), node->G.end(), 0);
+      int x = static_cast<int>(node->F.count());
+      int y = n - static_cast<int>(node->G.count());
 
       if (x == 0 && y == 0) continue; // Stop when F is all 0s and G is all 1s
 
       // Generate all possible children by reducing different 1s in F
       for (int i = 0; i < m; i++) {
-        if (node->F[i] == 1) {
-          std::vector<int> newF = node->F;
-          newF[i] = 0;
+        if (node->F[i]) {
+          ColorSet newF = node->F;
+          newF.reset(i);
           if (node_to_id.find({newF, node->G}) == node_to_id.end()) {
             Node *newNode = new Node{newF, node->G, nodeCounter++};
             dag[newNode->id] = newNode;
@@ -241,9 +172,9 @@ namespace Syft {
 
       // Generate all possible children by reducing different 0s in G
       for (int i = 0; i < n; i++) {
-        if (node->G[i] == 0) {
-          std::vector<int> newG = node->G;
-          newG[i] = 1;
+        if (!node->G[i]) {
+          ColorSet newG = node->G;
+          newG.set(i);
           if (node_to_id.find({node->F, newG}) == node_to_id.end()) {
             Node *newNode = new Node{node->F, newG, nodeCounter++};
             dag[newNode->id] = newNode;
@@ -259,7 +190,7 @@ namespace Syft {
     return {dag, node_to_id};
   }
 
-  std::string MannaPnueli::simplify_color_formula(std::vector<int> F_color, std::vector<int> G_color) const {
+  CUDD::BDD MannaPnueli::simplify_color_formula(const ColorSet &F_color, const ColorSet &G_color) const {
     CUDD::BDD new_color_formula_bdd = color_formula_bdd_;
     // std::cout << new_color_formula_bdd.FactoredFormString()<< std::endl;
     for (int i = 0; i < F_color.size(); i++) {
@@ -268,7 +199,7 @@ namespace Syft {
       // retrive the BDD var of that color
       CUDD::BDD color_bdd = color_to_variable_.at(color);
       // std::cout << color_bdd.FactoredFormString()<< std::endl;
-      if (F_color[i] == 0) {
+      if (!F_color[i]) {
         new_color_formula_bdd = new_color_formula_bdd.Restrict(!color_bdd);
       } else {
         new_color_formula_bdd = new_color_formula_bdd.Restrict(color_bdd);
@@ -280,14 +211,14 @@ namespace Syft {
       int color = G_colors_[i];
       // retrive the BDD var of that color
       CUDD::BDD color_bdd = color_to_variable_.at(color);
-      if (G_color[i] == 0) {
+      if (!G_color[i]) {
         new_color_formula_bdd = new_color_formula_bdd.Restrict(!color_bdd);
       } else {
         new_color_formula_bdd = new_color_formula_bdd.Restrict(color_bdd);
       }
     }
     // std::cout << new_color_formula_bdd.FactoredFormString()<< std::endl;
-    return color_formula_bdd_to_string(new_color_formula_bdd);
+    return new_color_formula_bdd;
   }
 
   MannaPnueli::Node *MannaPnueli::bottom_node_Dag() const {
@@ -298,23 +229,22 @@ namespace Syft {
                                                            ZielonkaNode *t,
                                                            std::vector<ELSynthesisResult> EL_results) const {
     if (DEBUG_MODE) {
-      std::cout << "-----------\ngameNode: " << gameNode;
+      SYFT_DEBUG_TRACE("gameNode: {}", Syft::debug_string(gameNode));
       gameNode.PrintCover();
-      std::cout << "dag node: " << curr_node_id << "\n";
-      std::cout << "tree node: " << t->order << "\n";
+      SYFT_DEBUG_TRACE("dag node: {} tree node: {}", curr_node_id, t->order);
     }
 
     for (auto item: op) {
       if (DEBUG_MODE) {
-        std::cout << item.gameNode << " " << item.t->order << "\n";
-        std::cout << item.Y << " " << item.u->order << "\n";
+        SYFT_DEBUG_TRACE("{} {}", Syft::debug_string(item.gameNode), item.t->order);
+        SYFT_DEBUG_TRACE("{} {}", Syft::debug_string(item.Y), item.u->order);
       }
       if (((item.gameNode | !gameNode) == var_mgr_->cudd_mgr()->bddOne()) && (item.t->order == t->order) && (
             item.currDagNodeId == curr_node_id)) {
         if (DEBUG_MODE) {
-          std::cout << "defined! " << gameNode << " " << t->order << " " << curr_node_id << "\n";
+          SYFT_DEBUG_TRACE("defined! {} {} {}", Syft::debug_string(gameNode), t->order, curr_node_id);
           gameNode.PrintCover();
-          std::cout << "stored " << item.gameNode << " " << item.t->order << "\n";
+          SYFT_DEBUG_TRACE("stored {} {}", Syft::debug_string(item.gameNode), item.t->order);
           item.gameNode.PrintCover();
         }
         return op;
@@ -328,13 +258,13 @@ namespace Syft {
 
     Node *curr_node = dag_.at(curr_node_id);
 
-    std::vector<int> newFcolors = curr_node->F; // need to add 1
-    std::vector<int> newGcolors = curr_node->G; // need to remove 0
+    ColorSet newFcolors = curr_node->F; // need to add 1
+    ColorSet newGcolors = curr_node->G; // need to remove 0
     for (int i = 0; i < F_colors_.size(); i++) {
       int F_color = F_colors_[i];
       CUDD::BDD F_color_bdd = Colors_[F_color];
       if (gameNode.Constrain(F_color_bdd) != var_mgr_->cudd_mgr()->bddZero()) {
-        newFcolors[i] = 1;
+        newFcolors.set(i);
       }
     }
 
@@ -342,7 +272,7 @@ namespace Syft {
       int G_color = G_colors_[i];
       CUDD::BDD G_color_bdd = Colors_[G_color];
       if (gameNode.Constrain(!G_color_bdd) != var_mgr_->cudd_mgr()->bddZero()) { // if non-G color has been seen
-        newGcolors[i] = 0;
+        newGcolors.reset(i);
       }
     }
 
@@ -388,10 +318,8 @@ namespace Syft {
 
     temp.push_back(move);
     if (DEBUG_MODE) {
-      std::cout << " --> \n";
-      std::cout << "Y: " << move.Y << "\n";
-      std::cout << "dag node: " << move.newDagNodeId << "\n";
-      std::cout << "tree node: " << move.u->order << "\n\n";
+      SYFT_DEBUG_TRACE(" --> Y: {} dag node: {} tree node: {}", Syft::debug_string(move.Y), move.newDagNodeId,
+                       move.u->order);
     }
 
     // compute game nodes that can result by taking system choice from gameNode
@@ -407,36 +335,117 @@ namespace Syft {
     return temp;
   }
 
-  std::vector<CUDD::BDD> MannaPnueli::getSuccsWithYZ(CUDD::BDD gameNode, CUDD::BDD Y) const {
-    std::vector<CUDD::BDD> succs;
-    std::vector<CUDD::BDD> transition_vector = spec_.transition_function();
-    std::vector<CUDD::BDD> transition_vector_fix_Y_Z;
-    for (int i = 0; i < transition_vector.size(); i++) {
-      CUDD::BDD transition_fix_Y_Z = (transition_vector[i] * gameNode * Y).ExistAbstract(
-        var_mgr_->state_variables_cube(spec_.automaton_id())).ExistAbstract(var_mgr_->output_cube());
-      transition_vector_fix_Y_Z.push_back(transition_fix_Y_Z);
-    }
-    std::vector<std::string> X_labels = var_mgr_->input_variable_labels();
-    int total = 1 << X_labels.size(); // 2^n
-    for (int mask = 0; mask < total; ++mask) {
-      std::vector<int> values(var_mgr_->total_variable_count(), 0);
-      for (int i = 0; i < X_labels.size(); ++i) {
-        CUDD::BDD X_var = var_mgr_->name_to_variable(X_labels[i]);
-        values[X_var.NodeReadIndex()] = (mask >> i) & 1; // Extract the i-th bit
-      }
-      std::vector<int> copy(values);
-      CUDD::BDD succ = var_mgr_->cudd_mgr()->bddOne();
-      for (int i = 0; i < transition_vector_fix_Y_Z.size(); i++) {
-        CUDD::BDD Z_var = var_mgr_->state_variable(spec_.automaton_id(), i);
-        if (transition_vector_fix_Y_Z[i].Eval(copy.data()).IsOne()) {
-          succ = succ * Z_var;
+  std::vector<std::pair<int, CUDD::BDD>> MannaPnueli::successor_regions(int id) const {
+    const Node *node = dag_.at(id);
+    std::vector<std::pair<int, CUDD::BDD>> regions;
+    // As ExtractStrategy_Explicit: an F-bit is set by a state of its color, a G-bit cleared by a state of another
+    std::function<void(std::size_t, ColorSet &, ColorSet &, const CUDD::BDD &)> split =
+        [&](std::size_t bit, ColorSet &F, ColorSet &G, const CUDD::BDD &region) {
+      if (region.IsZero()) {
+        return;
+      }
+      if (bit == F.size() + G.size()) {
+        auto it = node_to_id_.find({F, G});
+        if (it != node_to_id_.end()) {
+          regions.emplace_back(it->second, region);
+        }
+        return;
+      }
+      bool is_F = bit < F.size();
+      std::size_t i = is_F ? bit : bit - F.size();
+      ColorSet &bits = is_F ? F : G;
+      // Bits already set (F) or cleared (G) stay so
+      if (bits[i] == is_F) {
+        split(bit + 1, F, G, region);
+        return;
+      }
+      const CUDD::BDD &color = Colors_[is_F ? F_colors_[i] : G_colors_[i]];
+      split(bit + 1, F, G, region & (is_F ? !color : color));
+      is_F ? bits.set(i) : bits.reset(i);
+      split(bit + 1, F, G, region & (is_F ? color : !color));
+      is_F ? bits.reset(i) : bits.set(i);
+    };
+    ColorSet F = node->F;
+    ColorSet G = node->G;
+    split(0, F, G, var_mgr_->cudd_mgr()->bddOne());
+    return regions;
+  }
+
+  std::unique_ptr<Transducer> MannaPnueli::ExtractStrategy_Symbolic(const std::vector<ELSynthesisResult> &EL_results) const {
+    CUDD::BDD zero = var_mgr_->cudd_mgr()->bddZero();
+    // The strategies of the DAG nodes by tree and winning states, so that the
+    // nodes that reused the result of an identical subgame share theirs
+    std::map<std::pair<const ZielonkaTree *, DdNode *>, EmersonLei::MemoryStrategy> fragments;
+    std::vector<const EmersonLei::MemoryStrategy *> fragment_of(dag_.size(), nullptr);
+    std::size_t shared = 0;
+    auto fragment = [&](int id) -> const EmersonLei::MemoryStrategy * {
+      const ELSynthesisResult &result = EL_results[id];
+      if (!fragment_of[id] && result.z_tree) {
+        std::pair<const ZielonkaTree *, DdNode *> key(result.z_tree.get(), result.winning_states.getNode());
+        auto it = fragments.find(key);
+        if (it == fragments.end()) {
+          it = fragments.emplace(key, EmersonLei::memory_strategy(result.z_tree->get_root(), result.winning_states,
+                                                                  var_mgr_)).first;
         } else {
-          succ = succ * !Z_var;
+          shared++;
+        }
+        fragment_of[id] = &it->second;
+      }
+      return fragment_of[id];
+    };
+
+    // The memory values reached from the root of the last node, as (DAG node id, memory value of its tree)
+    int last = static_cast<int>(dag_.size()) - 1;
+    std::vector<std::pair<int, std::size_t>> memory{{last, 0}};
+    std::map<std::pair<int, std::size_t>, std::size_t> memory_id{{memory[0], 0}};
+    std::map<int, std::vector<std::pair<int, CUDD::BDD>>> regions;
+    std::vector<CUDD::BDD> moves;
+    std::vector<std::vector<std::pair<std::size_t, CUDD::BDD>>> updates;
+    for (std::size_t id = 0; id < memory.size(); ++id) {
+      var_mgr_->check_budget("strategy extraction");
+      auto [node, value] = memory[id];
+      auto cached = regions.find(node);
+      if (cached == regions.end()) {
+        cached = regions.emplace(node, successor_regions(node)).first;
+      }
+      CUDD::BDD moves_at = zero;
+      std::vector<std::pair<std::size_t, CUDD::BDD>> updates_at;
+      for (const auto &[target, region] : cached->second) {
+        const EmersonLei::MemoryStrategy *strategy = fragment(target);
+        if (!strategy) {
+          continue;
+        }
+        // The memory of the tree carries on in the same node, and starts from the root of another
+        std::size_t from = target == node ? value : 0;
+        moves_at |= region & strategy->moves[from];
+        for (std::size_t to = 0; to < strategy->next[from].size(); ++to) {
+          CUDD::BDD update = region & strategy->next[from][to];
+          if (update.IsZero()) {
+            continue;
+          }
+          auto inserted = memory_id.emplace(std::make_pair(target, to), memory.size());
+          if (inserted.second) {
+            memory.emplace_back(target, to);
+          }
+          updates_at.emplace_back(inserted.first->second, update);
         }
       }
-      succs.push_back(succ);
+      moves.push_back(moves_at);
+      updates.push_back(std::move(updates_at));
     }
-    return succs;
+    std::vector<std::vector<CUDD::BDD>> next(memory.size(), std::vector<CUDD::BDD>(memory.size(), zero));
+    for (std::size_t id = 0; id < memory.size(); ++id) {
+      for (const auto &[to, update] : updates[id]) {
+        next[id][to] |= update;
+      }
+    }
+    spdlog::info("[MannaPnueli::ExtractStrategy_Symbolic] {} DAG node strategies, {} shared by identical subgames",
+                 fragments.size(), shared);
+    return memory_transducer(moves, next, "MannaPnueli::ExtractStrategy_Symbolic");
+  }
+
+  std::vector<CUDD::BDD> MannaPnueli::getSuccsWithYZ(CUDD::BDD gameNode, CUDD::BDD Y) const {
+    return successor_cubes(gameNode, Y);
   }
 
   CUDD::BDD MannaPnueli::cpre(CUDD::BDD target) const {
@@ -453,86 +462,422 @@ namespace Syft {
   }
 
 
+  void MannaPnueli::set_threads(std::size_t threads) {
+    threads_ = threads;
+  }
+
+  void MannaPnueli::set_work_directory(std::string directory) {
+    work_directory_ = std::move(directory);
+  }
+
+  void MannaPnueli::set_checkpoint(std::shared_ptr<SolveCheckpoint> checkpoint, bool resume) {
+    checkpoint_ = std::move(checkpoint);
+    resume_ = resume;
+  }
+
+  void MannaPnueli::set_anytime(PartialResultCallback callback) {
+    anytime_ = std::move(callback);
+  }
+
+  std::pair<CUDD::BDD, CUDD::BDD> MannaPnueli::children_instant_sets(const Node *node,
+                                                                     const std::vector<CUDD::BDD> &children_winning) const {
+    CUDD::BDD instant_winning = var_mgr_->cudd_mgr()->bddZero();
+    CUDD::BDD instant_losing = var_mgr_->cudd_mgr()->bddZero();
+    for (std::size_t i = 0; i < node->children.size(); ++i) {
+      const CUDD::BDD &child_winnning_states = children_winning[i];
+      int color_flipped = node->children[i].second; // the color that got flipped
+      auto is_F_color = std::find(F_colors_.begin(), F_colors_.end(), color_flipped);
+      auto is_G_color = std::find(G_colors_.begin(), G_colors_.end(), color_flipped);
+      assert((is_F_color != F_colors_.end()) || (is_G_color != G_colors_.end())); // it has to be either an F or G
+
+      if (is_F_color != F_colors_.end()) {
+        instant_winning = instant_winning | (child_winnning_states * Colors_[color_flipped]);
+        instant_losing = instant_losing | (!child_winnning_states * Colors_[color_flipped]);
+      } else {
+        // instant_winning = instant_winning | (child_winnning_states * !(Colors_[color_flipped] | spec_.initial_state_bdd()));
+        // instant_losing = instant_losing | (!child_winnning_states * !(Colors_[color_flipped] | spec_.initial_state_bdd()));
+        instant_winning = instant_winning | (child_winnning_states * !(Colors_[color_flipped]));
+        instant_losing = instant_losing | (!child_winnning_states * !(Colors_[color_flipped]));
+      }
+      if (DEBUG_MODE) {
+        SYFT_DEBUG_TRACE("instant_winning: {}", Syft::debug_string(instant_winning));
+        SYFT_DEBUG_TRACE("instant_losing: {}", Syft::debug_string(instant_losing));
+      }
+    }
+    return std::make_pair(instant_winning, instant_losing);
+  }
+
+  CUDD::BDD MannaPnueli::node_state_space(const Node *node) const {
+    // new MP: state space is the conjunction of the acc states of colors appearing in {F, G}, and the non-acc of the colors not appearing
+    CUDD::BDD EL_state_space = state_space_;
+    
+    for (int i = 0; i < node->F.size(); i++) {
+      // retrive the i-th F color
+      int color = F_colors_[i];
+      if (node->F[i]){
+        EL_state_space = EL_state_space * Colors_[color];
+      } else {
+        EL_state_space = EL_state_space * !Colors_[color];
+      }
+    }
+    // std::cout << new_color_formula_bdd.FactoredFormString()<< std::endl;
+    for (int i = 0; i < node->G.size(); i++) {
+      // retrive the i-th G color
+      int color = G_colors_[i];
+      if (node->G[i]){
+        EL_state_space = EL_state_space * Colors_[color];
+      } else {
+        EL_state_space = EL_state_space * !Colors_[color];
+      }
+    }
+    return EL_state_space;
+  }
+
+  std::vector<bool> MannaPnueli::prune_unreachable_nodes() const {
+    std::vector<bool> pruned(dag_.size(), false);
+    CUDD::BDD reachable = state_space_ & (product_arena_ ? product_arena_->reachable_states() : spec_.reachable_states());
+    std::size_t pruned_count = 0;
+    for (int id = 0; id < static_cast<int>(dag_.size()); ++id) {
+      if ((node_state_space(dag_.at(id)) & reachable).IsZero()) {
+        pruned[id] = true;
+        pruned_count++;
+      }
+    }
+    spdlog::info("[MannaPnueli::run_MP] skipping {} of {} DAG nodes without reachable states", pruned_count,
+                 dag_.size());
+    return pruned;
+  }
+
+  std::vector<std::vector<int>> MannaPnueli::dag_levels() const {
+    // Children always have smaller ids than their parents
+    std::vector<std::size_t> height(dag_.size(), 0);
+    std::vector<std::vector<int>> levels;
+    for (int id = 0; id < static_cast<int>(dag_.size()); ++id) {
+      for (const auto &child: dag_.at(id)->children) {
+        height[id] = std::max(height[id], height[child.first->id] + 1);
+      }
+      if (levels.size() <= height[id]) {
+        levels.resize(height[id] + 1);
+      }
+      levels[height[id]].push_back(id);
+    }
+    return levels;
+  }
+
+  void MannaPnueli::SolveLevelInParallel(const std::vector<int> &level,
+                                         std::vector<ELSynthesisResult> &EL_results) const {
+    // Set up every game on this thread: CUDD managers, and color_mgr_ used by
+    // simplify_color_formula, are not thread-safe
+    std::vector<DagNodeGame> games;
+    std::vector<SubgameKey> game_keys;
+    // The game solving each node of the level, unless its subgame was solved before
+    std::vector<std::optional<std::size_t>> node_game(level.size());
+    std::map<SubgameKey, std::size_t> pending;
+    for (std::size_t k = 0; k < level.size(); ++k) {
+      const Node *node = dag_.at(level[k]);
+      CUDD::BDD color_formula = simplify_color_formula(node->F, node->G);
+      std::vector<CUDD::BDD> children_winning;
+      for (const auto &child: node->children) {
+        children_winning.push_back(EL_results[child.first->id].winning_states);
+      }
+      auto [instant_winning, instant_losing] = children_instant_sets(node, children_winning);
+      SubgameKey key(color_formula.getNode(), state_space_.getNode(), instant_winning.getNode(),
+                     instant_losing.getNode());
+      auto cached = subgame_cache_.find(key);
+      if (cached != subgame_cache_.end()) {
+        subgame_cache_hits_++;
+        EL_results[level[k]] = cached->second.result;
+        continue;
+      }
+      auto solving = pending.find(key);
+      if (solving != pending.end()) {
+        subgame_cache_hits_++;
+        node_game[k] = solving->second;
+        continue;
+      }
+      node_game[k] = games.size();
+      pending.emplace(key, games.size());
+      game_keys.push_back(key);
+      subgame_cache_.emplace(key, Subgame{color_formula, state_space_, instant_winning, instant_losing,
+                                          ELSynthesisResult()});
+
+      DagNodeGame &game = games.emplace_back();
+      game.var_mgr = var_mgr_->clone();
+      CUDD::Cudd &mgr = *game.var_mgr->cudd_mgr();
+      game.spec = std::make_unique<SymbolicStateDfa>(spec_.transfer_to_clone(game.var_mgr));
+      game.color_formula = compile_color_formula(color_formula);
+      for (const CUDD::BDD &color: Colors_) {
+        game.colors.push_back(color.Transfer(mgr));
+      }
+      game.state_space = state_space_.Transfer(mgr);
+      game.instant_winning = instant_winning.Transfer(mgr);
+      game.instant_losing = instant_losing.Transfer(mgr);
+    }
+
+    std::vector<std::exception_ptr> errors(games.size());
+    std::atomic<std::size_t> next_job{0};
+    auto worker = [&]() {
+      for (std::size_t k = next_job++; k < games.size(); k = next_job++) {
+        try {
+          DagNodeGame &game = games[k];
+          TraceScope trace("MP DAG node", "game");
+          trace.arg("game", static_cast<double>(k));
+          EmersonLei solver(*game.spec, game.color_formula, starting_player_, protagonist_player_, game.colors,
+                            game.state_space, game.instant_winning, game.instant_losing, false);
+          solver.set_preimage_engine(preimage_engine_);
+          ELSynthesisResult result = solver.run_EL();
+          game.realizability = result.realizability;
+          game.winning = result.winning_states;
+          trace.bdd("winning_nodes", game.winning);
+        } catch (...) {
+          errors[k] = std::current_exception();
+        }
+      }
+    };
+    std::vector<std::thread> workers;
+    for (std::size_t w = 0; w < std::min(threads_, games.size()); ++w) {
+      workers.emplace_back(worker);
+    }
+    for (std::thread &thread: workers) {
+      thread.join();
+    }
+    for (std::size_t k = 0; k < errors.size(); ++k) {
+      if (errors[k]) {
+        // Do not leave the unsolved subgames in the cache
+        for (const SubgameKey &key: game_keys) {
+          subgame_cache_.erase(key);
+        }
+        std::rethrow_exception(errors[k]);
+      }
+    }
+
+    SYFT_DEBUG_TRACE("[MannaPnueli::run_MP] solved {} of {} DAG nodes on {} threads", games.size(), level.size(),
+                     workers.size());
+    for (std::size_t g = 0; g < games.size(); ++g) {
+      ELSynthesisResult &result = subgame_cache_.at(game_keys[g]).result;
+      result.realizability = games[g].realizability;
+      result.winning_states = games[g].winning.Transfer(*var_mgr_->cudd_mgr());
+    }
+    for (std::size_t k = 0; k < level.size(); ++k) {
+      if (node_game[k]) {
+        EL_results[level[k]] = subgame_cache_.at(game_keys[*node_game[k]]).result;
+      }
+    }
+  }
+
+  void MannaPnueli::SolveLevelDistributed(DagWorkQueue &queue, const std::vector<int> &level,
+                                          std::vector<ELSynthesisResult> &EL_results) const {
+    // The job solving each node of the level, unless its subgame was solved before
+    std::vector<std::optional<std::size_t>> node_job(level.size());
+    std::map<SubgameKey, std::size_t> pending;
+    std::map<std::size_t, SubgameKey> job_keys;
+    for (std::size_t k = 0; k < level.size(); ++k) {
+      const Node *node = dag_.at(level[k]);
+      CUDD::BDD color_formula = simplify_color_formula(node->F, node->G);
+      std::vector<CUDD::BDD> children_winning;
+      for (const auto &child: node->children) {
+        children_winning.push_back(EL_results[child.first->id].winning_states);
+      }
+      auto [instant_winning, instant_losing] = children_instant_sets(node, children_winning);
+      SubgameKey key(color_formula.getNode(), state_space_.getNode(), instant_winning.getNode(),
+                     instant_losing.getNode());
+      auto cached = subgame_cache_.find(key);
+      if (cached != subgame_cache_.end()) {
+        subgame_cache_hits_++;
+        EL_results[level[k]] = cached->second.result;
+        continue;
+      }
+      auto solving = pending.find(key);
+      if (solving != pending.end()) {
+        subgame_cache_hits_++;
+        node_job[k] = solving->second;
+        continue;
+      }
+      std::size_t job = queue.submit(compile_color_formula(color_formula), instant_winning, instant_losing);
+      node_job[k] = job;
+      pending.emplace(key, job);
+      job_keys.emplace(job, key);
+      subgame_cache_.emplace(key, Subgame{color_formula, state_space_, instant_winning, instant_losing,
+                                          ELSynthesisResult()});
+    }
+
+    try {
+      std::set<std::size_t> done;
+      while (done.size() < job_keys.size()) {
+        bool progress = false;
+        for (const auto &[job, key]: job_keys) {
+          if (done.count(job)) {
+            continue;
+          }
+          std::optional<DagWorkQueue::Outcome> outcome = queue.collect(job);
+          if (outcome) {
+            ELSynthesisResult &result = subgame_cache_.at(key).result;
+            result.realizability = outcome->realizability;
+            result.winning_states = outcome->winning_states;
+            done.insert(job);
+            progress = true;
+          }
+        }
+        if (!progress) {
+          var_mgr_->check_budget("Manna-Pnueli DAG");
+          std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+      }
+    } catch (...) {
+      // Do not leave the unsolved subgames in the cache
+      for (const auto &entry: job_keys) {
+        subgame_cache_.erase(entry.second);
+      }
+      throw;
+    }
+
+    SYFT_DEBUG_TRACE("[MannaPnueli::run_MP] workers solved {} of {} DAG nodes", job_keys.size(), level.size());
+    for (std::size_t k = 0; k < level.size(); ++k) {
+      if (node_job[k]) {
+        EL_results[level[k]] = subgame_cache_.at(job_keys.at(*node_job[k])).result;
+      }
+    }
+  }
+
+  void MannaPnueli::release_read_children(const std::vector<int> &level, std::vector<std::size_t> &unsolved_parents,
+                                          std::vector<ELSynthesisResult> &EL_results) const {
+    std::size_t released = 0;
+    for (int id: level) {
+      for (const auto &child: dag_.at(id)->children) {
+        if (--unsolved_parents[child.first->id] == 0) {
+          EL_results[child.first->id] = ELSynthesisResult();
+          released++;
+        }
+      }
+    }
+    if (released > 0) {
+      SYFT_DEBUG_TRACE("[MannaPnueli::run_MP] released the results of {} DAG nodes", released);
+    }
+  }
+
   MPSynthesisResult MannaPnueli::run_MP() const {
     std::vector<ELSynthesisResult> EL_results(dag_.size()); //TODO here initialized as Zero just for testing
-    std::vector<bool> computed(dag_.size(), false);
 
+    // The other solvers chain each node to all the nodes solved before it, so only MP may reorder them
+    bool parallel = threads_ > 1 && game_solver_ == 1 && !STRATEGY;
+    std::unique_ptr<DagWorkQueue> queue;
+    if (!work_directory_.empty() && game_solver_ == 1 && !STRATEGY) {
+      queue = std::make_unique<DagWorkQueue>(work_directory_, var_mgr_);
+      queue->publish_arena(spec_, Colors_, state_space_, starting_player_, protagonist_player_);
+    }
+    std::vector<std::vector<int>> schedule;
+    if (parallel || queue) {
+      schedule = dag_levels();
+    } else {
+      for (int index = 0; index < static_cast<int>(dag_.size()); ++index) {
+        schedule.push_back({index});
+      }
+    }
+
+    subgame_cache_hits_ = 0;
+    // Only the adv solver restricts each node to its own states; the others solve every node on the whole state space
+    std::vector<bool> pruned = (game_solver_ == 2 && prune_nodes_ && !STRATEGY)
+                                   ? prune_unreachable_nodes()
+                                   : std::vector<bool>(dag_.size(), false);
+    std::size_t pruned_nodes = std::count(pruned.begin(), pruned.end(), true);
+    std::shared_ptr<SolveCheckpoint> checkpoint;
+    if (checkpoint_ && STRATEGY) {
+      spdlog::warn("[MannaPnueli::run_MP] no checkpoint is kept when a strategy is extracted");
+    } else if (checkpoint_) {
+      checkpoint = checkpoint_;
+      // A fresh checkpoint holds no nodes, so the loop below solves them all
+      checkpoint->attach("manna-pnueli/" + std::to_string(game_solver_) + " " + color_formula_, spec_, Colors_,
+                         state_space_, resume_);
+    }
+    std::size_t restored_nodes = 0;
     // new MP: 
     CUDD::BDD adv_winning = var_mgr_->cudd_mgr()->bddZero();
     CUDD::BDD adv_losing = var_mgr_->cudd_mgr()->bddZero();
-    while (std::find(computed.begin(), computed.end(), false) != computed.end()) {
-      auto it = std::find(computed.begin(), computed.end(), false);
-      int index = distance(computed.begin(), it);
+    // The parents of each node not solved yet; without strategy extraction, a
+    // node's result is released once all its parents have read it
+    std::vector<std::size_t> unsolved_parents(dag_.size(), 0);
+    for (const auto &[id, node]: dag_) {
+      for (const auto &child: node->children) {
+        unsolved_parents[child.first->id]++;
+      }
+    }
+    const std::vector<int> *previous_level = nullptr;
+    for (const std::vector<int> &level: schedule) {
+      var_mgr_->check_budget("Manna-Pnueli DAG");
+      if (previous_level && !STRATEGY) {
+        release_read_children(*previous_level, unsolved_parents, EL_results);
+      }
+      previous_level = &level;
+      if (checkpoint) {
+        // Levels are solved whole, so a level is reloaded only if every node of it was saved
+        std::vector<ELSynthesisResult> saved;
+        for (int id : level) {
+          std::optional<ELSynthesisResult> node_result = pruned[id] ? std::nullopt : checkpoint->load_node(id);
+          if (!node_result) {
+            break;
+          }
+          saved.push_back(*node_result);
+        }
+        if (saved.size() == level.size()) {
+          for (std::size_t i = 0; i < level.size(); ++i) {
+            EL_results[level[i]] = saved[i];
+            CUDD::BDD EL_state_space = (game_solver_ == 2) ? node_state_space(dag_.at(level[i])) : state_space_;
+            adv_winning = adv_winning | saved[i].winning_states;
+            adv_losing = adv_losing | (EL_state_space * !(saved[i].winning_states));
+          }
+          restored_nodes += level.size();
+          continue;
+        }
+      }
+      if (queue || level.size() > 1) {
+        if (queue) {
+          SolveLevelDistributed(*queue, level, EL_results);
+        } else {
+          SolveLevelInParallel(level, EL_results);
+        }
+        if (checkpoint) {
+          for (int id : level) {
+            checkpoint->store_node(id, EL_results[id]);
+          }
+        }
+        continue;
+      }
+      int index = level.front();
       Node *node = dag_.at(index);
+      TraceScope trace("MP DAG node", "game");
+      trace.arg("node", index);
+      if (pruned[index]) {
+        // Solving the empty state space only adds the instantly winning states, which are adv_winning
+        EL_results[index].winning_states = adv_winning;
+        EL_results[index].realizability = includes_initial_state(adv_winning);
+        continue;
+      }
       if (DEBUG_MODE) {
-              std::cout << "Now process: Dag Node " << node->id << " (";
-              for (int bit : node->F) std::cout << bit;
-              std::cout << ", ";
-              for (int bit : node->G) std::cout << bit;
-              std::cout << ")\n";
+        SYFT_DEBUG_TRACE("Now process: Dag Node {} ({}, {})", node->id, node->F.to_string(), node->G.to_string());
       }
 
       
 
 
-      std::string curColor_formula = simplify_color_formula(node->F, node->G);
+      CUDD::BDD curColor_formula = simplify_color_formula(node->F, node->G);
       // std::cout << curColor_formula << std::endl;
 
       // build Zielonka tree for current F- and G-colors
       // ZielonkaTree *Ztree = new ZielonkaTree(curColor_formula, Colors_, var_mgr_);
 
 
-      CUDD::BDD instant_winning = var_mgr_->cudd_mgr()->bddZero();
-      CUDD::BDD instant_losing = var_mgr_->cudd_mgr()->bddZero();
+      std::vector<CUDD::BDD> children_winning;
       for (auto child: node->children) {
-        CUDD::BDD child_winnning_states = EL_results[child.first->id].winning_states;
-        int color_flipped = child.second; // the color that got flipped
-        auto is_F_color = std::find(F_colors_.begin(), F_colors_.end(), color_flipped);
-        auto is_G_color = std::find(G_colors_.begin(), G_colors_.end(), color_flipped);
-        assert((is_F_color != F_colors_.end()) || (is_G_color != G_colors_.end())); // it has to be either an F or G
-
-        if (is_F_color != F_colors_.end()) {
-          instant_winning = instant_winning | (child_winnning_states * Colors_[color_flipped]);
-          instant_losing = instant_losing | (!child_winnning_states * Colors_[color_flipped]);
-        } else {
-          // instant_winning = instant_winning | (child_winnning_states * !(Colors_[color_flipped] | spec_.initial_state_bdd()));
-          // instant_losing = instant_losing | (!child_winnning_states * !(Colors_[color_flipped] | spec_.initial_state_bdd()));
-          instant_winning = instant_winning | (child_winnning_states * !(Colors_[color_flipped]));
-          instant_losing = instant_losing | (!child_winnning_states * !(Colors_[color_flipped]));
-        }
-        if (DEBUG_MODE) {
-          std::cout << "instant_winning: " << instant_winning << std::endl;
-          std::cout << "instant_losing: " << instant_losing << std::endl;
-        }
+        children_winning.push_back(EL_results[child.first->id].winning_states);
       }
+      auto [instant_winning, instant_losing] = children_instant_sets(node, children_winning);
 
 
       // TODO: loop over existing entries in the vector result.winning_states; each entry is a pair (colors,winningStates).
       // 		 Add nodes from winningStates for which curcolors&seencolors=colors to instantWinning
       //		 Add nodes from !winningStates for which curcolors&seencolors=colors to instantLosing
 
-      // new MP: state space is the conjunction of the acc states of colors appearing in {F, G}, and the non-acc of the colors not appearing
-      CUDD::BDD EL_state_space = var_mgr_->cudd_mgr()->bddOne();
-      
-      for (int i = 0; i < node->F.size(); i++) {
-        // retrive the i-th F color
-        int color = F_colors_[i];
-        if (node->F[i] == 1){
-          EL_state_space = EL_state_space * Colors_[color];
-        } else {
-          EL_state_space = EL_state_space * !Colors_[color];
-        }
-      }
-      // std::cout << new_color_formula_bdd.FactoredFormString()<< std::endl;
-      for (int i = 0; i < node->G.size(); i++) {
-        // retrive the i-th G color
-        int color = G_colors_[i];
-        if (node->G[i] == 1){
-          EL_state_space = EL_state_space * Colors_[color];
-        } else {
-          EL_state_space = EL_state_space * !Colors_[color];
-        }
-      }
+      CUDD::BDD EL_state_space = node_state_space(node);
 
       // new MP: 
       // CUDD::BDD adv_instant_winning = EL_state_space & cpre(adv_winning);
@@ -542,28 +887,97 @@ namespace Syft {
       instant_losing = (game_solver_ == 1) ? instant_losing : adv_losing;
 
       bool adv_mp = (game_solver_ == 2) ? true : false;
-      EL_state_space = (game_solver_ == 2) ? EL_state_space : var_mgr_->cudd_mgr()->bddOne();
-
-      EmersonLei solver(spec_, curColor_formula, starting_player_, protagonist_player_,
-                        Colors_, EL_state_space, instant_winning, instant_losing, adv_mp);
-      ELSynthesisResult result = solver.run_EL();
-      // solve EL game for curColor_formula
-      //TODO change run_EL to take instantWinning, or change the constructor of EL
-      // ELSynthesisResult el_synthesis_result = solver.run_EL(instantWinning, instantLosing);
-      computed[index] = true;
+      EL_state_space = (game_solver_ == 2) ? EL_state_space : state_space_;
+
+      SubgameKey key(curColor_formula.getNode(), EL_state_space.getNode(), instant_winning.getNode(), instant_losing.getNode());
+      auto cached = subgame_cache_.find(key);
+      ELSynthesisResult result;
+      if (cached != subgame_cache_.end()) {
+        subgame_cache_hits_++;
+        result = cached->second.result;
+      } else {
+        // Trees hold the winning moves of their last solve, so they are only shared when no strategy is extracted
+        std::pair<DdNode*, DdNode*> tree_key(curColor_formula.getNode(), EL_state_space.getNode());
+        std::shared_ptr<ZielonkaTree> z_tree;
+        auto cached_tree = tree_cache_.find(tree_key);
+        if (!STRATEGY && cached_tree != tree_cache_.end()) {
+          z_tree = cached_tree->second.tree;
+        }
+        ColorFormula compiled_formula = compile_color_formula(curColor_formula);
+        std::unique_ptr<EmersonLei> solver = product_arena_
+            ? std::make_unique<EmersonLei>(*product_arena_, compiled_formula, starting_player_, protagonist_player_,
+                                           Colors_, EL_state_space, instant_winning, instant_losing, adv_mp, z_tree)
+            : std::make_unique<EmersonLei>(spec_, compiled_formula, starting_player_, protagonist_player_,
+                                           Colors_, EL_state_space, instant_winning, instant_losing, adv_mp, z_tree);
+        solver->set_preimage_engine(preimage_engine_);
+        solver->set_preimage_cache(preimage_cache_);
+        solver->set_release_winning_moves(true);
+        solver->set_defer_strategy(symbolic_strategy_);
+        // Only the last node decides the verdict, so only it may stop early
+        bool last_node = index == static_cast<int>(dag_.size()) - 1;
+        if (last_node) {
+          solver->set_anytime(anytime_);
+        }
+        result = solver->run_EL();
+        if (!STRATEGY) {
+          // Parents only read the verdict and the winning states: drop the tree and strategy at once
+          ELSynthesisResult verdict;
+          verdict.realizability = result.realizability;
+          verdict.winning_states = result.winning_states;
+          result = verdict;
+        }
+        // solve EL game for curColor_formula
+        //TODO change run_EL to take instantWinning, or change the constructor of EL
+        // ELSynthesisResult el_synthesis_result = solver.run_EL(instantWinning, instantLosing);
+        if (!STRATEGY && !z_tree) {
+          tree_cache_.emplace(tree_key, CachedTree{curColor_formula, EL_state_space, solver->zielonka_tree()});
+        }
+        if (!(last_node && anytime_)) {
+          subgame_cache_.emplace(key, Subgame{curColor_formula, EL_state_space, instant_winning, instant_losing, result});
+        }
+      }
       EL_results[index] = result;
+      if (checkpoint) {
+        checkpoint->store_node(index, result);
+      }
+      trace.bdd("winning_nodes", result.winning_states);
       // new MP: 
       adv_winning = adv_winning | result.winning_states;
 
       // new MP: 
       adv_losing = adv_losing | (EL_state_space * !(result.winning_states));
       if (DEBUG_MODE) {
-        std::cout << "adv_winning: " << adv_winning << std::endl;
+        SYFT_DEBUG_TRACE("adv_winning: {}", Syft::debug_string(adv_winning));
         var_mgr_->dump_dot(adv_winning.Add(), "adv_winning.dot");
       }
+      if (anytime_ && game_solver_ != 1) {
+        anytime_(PartialSynthesisResult{adv_winning, var_mgr_->cudd_mgr()->bddZero()});
+        if (!STRATEGY && includes_initial_state(adv_winning)) {
+          spdlog::info("[MannaPnueli::run_MP] initial state won after DAG node {}", index);
+          MPSynthesisResult early;
+          early.realizability = true;
+          early.winning_states = adv_winning;
+          early.pruned_nodes = pruned_nodes;
+          return early;
+        }
+      }
+    }
+    spdlog::info("[MannaPnueli::run_MP] {} DAG nodes, {} reused an identical subgame, {} Zielonka trees cached",
+                 dag_.size(), subgame_cache_hits_, tree_cache_.size());
+    if (checkpoint) {
+      spdlog::info("[MannaPnueli::run_MP] {} DAG nodes reloaded from the checkpoint", restored_nodes);
+    }
+    if (preimage_cache_) {
+      const PreimageCacheStats &cache_stats = preimage_cache_->stats();
+      spdlog::info("[MannaPnueli::run_MP] preimage cache: {} hits of {} lookups ({:.1f}%), {} entries of {} nodes, {} evicted",
+                   cache_stats.hits, cache_stats.lookups, 100.0 * cache_stats.hit_rate(), cache_stats.entries,
+                   cache_stats.nodes, cache_stats.evictions);
+      var_mgr_->record_size("preimage_cache_lookups", static_cast<double>(cache_stats.lookups));
+      var_mgr_->record_size("preimage_cache_hits", static_cast<double>(cache_stats.hits));
     }
     // update result according to computed solution, TODO: store result for curcolors; also, winningmoves
     MPSynthesisResult result;
+    result.pruned_nodes = pruned_nodes;
 
     if (EL_results[dag_.size() - 1].realizability) {
       result.realizability = true;
@@ -572,8 +986,15 @@ namespace Syft {
       // std::cout << "Strategy: \n";
 
       if (STRATEGY) {
-        result.output_function = ExtractStrategy_Explicit(op, dag_.size() - 1, spec_.initial_state_bdd(),
-          EL_results[dag_.size() - 1].z_tree->get_root(), EL_results);
+        TraceScope trace("strategy extraction", "game");
+        trace.arg("mode", symbolic_strategy_ ? "symbolic" : "explicit");
+        if (symbolic_strategy_) {
+          result.transducer = ExtractStrategy_Symbolic(EL_results);
+        } else {
+          result.output_function = ExtractStrategy_Explicit(op, dag_.size() - 1, spec_.initial_state_bdd(),
+            EL_results[dag_.size() - 1].z_tree->get_root(), EL_results);
+        }
+        var_mgr_->snapshot_stats("strategy extraction");
       }
       return result;
     } else {
@@ -0,0 +1,91 @@
+#include "game/ParitySolver.hpp"
+
+#include <spdlog/spdlog.h>
+#include <functional>
+
+namespace Syft {
+    ParitySolver::ParitySolver(const SymbolicStateDfa &spec, Player starting_player, Player protagonist_player,
+                               const std::vector<CUDD::BDD> &priorities, const CUDD::BDD &state_space)
+            : DfaGameSynthesizer(spec, starting_player, protagonist_player), priorities_(priorities),
+              state_space_(state_space) {
+    }
+
+    ParitySolver::ParitySolver(const ProductArena &arena, Player starting_player, Player protagonist_player,
+                               const std::vector<CUDD::BDD> &priorities, const CUDD::BDD &state_space)
+            : ParitySolver(arena.symbolic_view(), starting_player, protagonist_player, priorities, state_space) {
+        product_arena_ = std::make_shared<ProductArena>(arena);
+    }
+
+    CUDD::BDD ParitySolver::cpre(const CUDD::BDD &target) const {
+        if (starting_player_ == Player::Agent) {
+            return project_into_states(state_space_ & preimage(target));
+        }
+        return state_space_ & project_into_states(preimage(target));
+    }
+
+    SynthesisResult ParitySolver::run() const {
+        CUDD::BDD zero = var_mgr_->cudd_mgr()->bddZero();
+        std::size_t levels = priorities_.size();
+        // Even priorities are greatest fixpoints, odd ones least fixpoints
+        auto initial = [&](std::size_t i) { return i % 2 == 0 ? state_space_ : zero; };
+
+        std::vector<CUDD::BDD> Z;
+        // CPre(Z_i), recomputed only when Z_i changes
+        std::vector<CUDD::BDD> pre;
+        std::vector<bool> pre_valid(levels, false);
+        for (std::size_t i = 0; i < levels; ++i) {
+            Z.push_back(initial(i));
+            pre.push_back(zero);
+        }
+        std::size_t iterations = 0;
+
+        // The body of the fixpoints, i.e. the union over i of P_i & CPre(Z_i)
+        auto body = [&]() {
+            CUDD::BDD result = zero;
+            for (std::size_t i = 0; i < levels; ++i) {
+                if (!pre_valid[i]) {
+                    pre[i] = cpre(Z[i]);
+                    pre_valid[i] = true;
+                }
+                result |= priorities_[i] & pre[i];
+            }
+            return result;
+        };
+
+        // Iterates Z_level to its fixpoint, given the outer variables
+        std::function<CUDD::BDD(std::size_t)> solve = [&](std::size_t level) -> CUDD::BDD {
+            if (level == levels) {
+                return body();
+            }
+            while (true) {
+                var_mgr_->check_budget("fixpoint");
+                iterations++;
+                CUDD::BDD next = solve(level + 1);
+                if (next == Z[level]) {
+                    return next;
+                }
+                Z[level] = next;
+                pre_valid[level] = false;
+                for (std::size_t inner = level + 1; inner < levels; ++inner) {
+                    if (inner % 2 != level % 2) {
+                        Z[inner] = initial(inner);
+                        pre_valid[inner] = false;
+                    }
+                }
+                // The outermost greatest fixpoint only shrinks
+                if (level == 0 && realizability_only_ && !includes_initial_state(Z[0])) {
+                    return Z[0];
+                }
+            }
+        };
+
+        SynthesisResult result;
+        result.winning_states = levels == 0 ? zero : solve(0);
+        result.realizability = includes_initial_state(result.winning_states);
+        result.winning_moves = zero;
+        result.transducer = nullptr;
+        spdlog::info("[ParitySolver::run] {} priorities solved in {} iterations", levels, iterations);
+        return result;
+    }
+
+}
@@ -0,0 +1,190 @@
+#include "game/PartitionedTransitionRelation.h"
+#include "VarMgr.h"
+#include "debug.hpp"
+#include <spdlog/spdlog.h>
+
+namespace Syft {
+
+namespace {
+    // Variables as canonical projection functions, so that SwapVariables never
+    // sees complemented nodes
+    std::vector<CUDD::BDD> canonical_variables(const std::shared_ptr<VarMgr>& var_mgr,
+                                               std::size_t automaton_id) {
+        std::vector<CUDD::BDD> variables;
+        for (const CUDD::BDD& var : var_mgr->get_state_variables(automaton_id)) {
+            variables.push_back(var_mgr->cudd_mgr()->bddVar(var.NodeReadIndex()));
+        }
+        return variables;
+    }
+}
+
+PartitionedTransitionRelation::PartitionedTransitionRelation(const SymbolicStateDfa& dfa,
+                                                             std::size_t primed_automaton_id,
+                                                             std::size_t cluster_threshold)
+    : var_mgr_(dfa.var_mgr())
+    , automaton_id_(dfa.automaton_id())
+    , primed_automaton_id_(primed_automaton_id)
+    , state_variables_(canonical_variables(var_mgr_, automaton_id_))
+    , primed_variables_(canonical_variables(var_mgr_, primed_automaton_id)) {
+
+    CUDD::BDD io_cube = var_mgr_->input_cube() * var_mgr_->output_cube();
+    const CUDD::BDD& state_cube = var_mgr_->state_variables_cube(automaton_id_);
+    const CUDD::BDD& primed_cube = var_mgr_->state_variables_cube(primed_automaton_id_);
+    std::vector<bool> image_quantified = QuantifiedIndices({state_cube, io_cube});
+
+    // Order the bit relations as for an image, then merge neighbours up to the threshold
+    const std::vector<CUDD::BDD> &transition_function = dfa.transition_function();
+    std::vector<CUDD::BDD> bit_relations;
+    bit_relations.reserve(transition_function.size());
+    for (std::size_t i = 0; i < transition_function.size(); ++i) {
+        bit_relations.push_back(primed_variables_[i].Xnor(transition_function[i]));
+    }
+
+    Schedule bit_schedule = MakeSchedule(bit_relations, image_quantified);
+    for (std::size_t index : bit_schedule.order) {
+        const CUDD::BDD& bit_relation = bit_relations[index];
+        if (!clusters_.empty()) {
+            CUDD::BDD merged = clusters_.back() & bit_relation;
+            if (static_cast<std::size_t>(merged.nodeCount()) <= cluster_threshold) {
+                clusters_.back() = merged;
+                continue;
+            }
+        }
+        clusters_.push_back(bit_relation);
+    }
+
+    image_schedule_ = MakeSchedule(clusters_, image_quantified);
+    preimage_schedule_ = MakeSchedule(clusters_, QuantifiedIndices({primed_cube, io_cube}));
+    move_preimage_schedule_ = MakeSchedule(clusters_, QuantifiedIndices({primed_cube}));
+    state_relation_schedule_ = MakeSchedule(clusters_, QuantifiedIndices({io_cube}));
+
+    SYFT_DEBUG_TRACE("[PartitionedTransitionRelation] {} bit relations in {} clusters",
+                     bit_relations.size(), clusters_.size());
+}
+
+std::vector<bool> PartitionedTransitionRelation::QuantifiedIndices(
+        const std::vector<CUDD::BDD>& cubes) const {
+    std::vector<bool> quantified(var_mgr_->total_variable_count(), false);
+    for (const CUDD::BDD& cube : cubes) {
+        for (unsigned int index : cube.SupportIndices()) {
+            quantified[index] = true;
+        }
+    }
+    return quantified;
+}
+
+PartitionedTransitionRelation::Schedule PartitionedTransitionRelation::MakeSchedule(
+        const std::vector<CUDD::BDD>& parts,
+        const std::vector<bool>& quantified) const {
+    auto mgr = var_mgr_->cudd_mgr();
+    std::size_t variable_count = quantified.size();
+
+    std::vector<std::vector<unsigned int>> supports;
+    std::vector<std::size_t> occurrences(variable_count, 0);
+    for (const CUDD::BDD& part : parts) {
+        supports.push_back(part.SupportIndices());
+        for (unsigned int index : supports.back()) {
+            ++occurrences[index];
+        }
+    }
+
+    Schedule schedule;
+    schedule.leading_cube = mgr->bddOne();
+    for (std::size_t index = 0; index < variable_count; ++index) {
+        if (quantified[index] && occurrences[index] == 0) {
+            schedule.leading_cube &= mgr->bddVar(static_cast<int>(index));
+        }
+    }
+
+    // Greedily pick the part that abstracts the most variables while
+    // introducing the fewest new ones into the intermediate product
+    std::vector<bool> scheduled(parts.size(), false);
+    std::vector<bool> introduced(variable_count, false);
+    for (std::size_t step = 0; step < parts.size(); ++step) {
+        std::size_t best = parts.size();
+        long best_score = 0;
+        for (std::size_t candidate = 0; candidate < parts.size(); ++candidate) {
+            if (scheduled[candidate]) {
+                continue;
+            }
+            long score = 0;
+            for (unsigned int index : supports[candidate]) {
+                if (quantified[index] && occurrences[index] == 1) {
+                    ++score;
+                }
+                if (!introduced[index]) {
+                    --score;
+                }
+            }
+            if (best == parts.size() || score > best_score) {
+                best = candidate;
+                best_score = score;
+            }
+        }
+
+        scheduled[best] = true;
+        CUDD::BDD cube = mgr->bddOne();
+        for (unsigned int index : supports[best]) {
+            introduced[index] = true;
+            if (--occurrences[index] == 0 && quantified[index]) {
+                cube &= mgr->bddVar(static_cast<int>(index));
+            }
+        }
+        schedule.order.push_back(best);
+        schedule.cubes.push_back(cube);
+    }
+
+    return schedule;
+}
+
+CUDD::BDD PartitionedTransitionRelation::Apply(const CUDD::BDD& operand,
+                                               const Schedule& schedule) const {
+    CUDD::BDD result = operand.ExistAbstract(schedule.leading_cube);
+    for (std::size_t step = 0; step < schedule.order.size() && !result.IsZero(); ++step) {
+        result = result.AndAbstract(clusters_[schedule.order[step]], schedule.cubes[step]);
+    }
+    return result;
+}
+
+CUDD::BDD PartitionedTransitionRelation::Image(const CUDD::BDD& states) const {
+    return Apply(states, image_schedule_).SwapVariables(primed_variables_, state_variables_);
+}
+
+CUDD::BDD PartitionedTransitionRelation::Preimage(const CUDD::BDD& states) const {
+    return Apply(states.SwapVariables(state_variables_, primed_variables_), preimage_schedule_);
+}
+
+CUDD::BDD PartitionedTransitionRelation::MovePreimage(const CUDD::BDD& states) const {
+    return Apply(states.SwapVariables(state_variables_, primed_variables_), move_preimage_schedule_);
+}
+
+CUDD::BDD PartitionedTransitionRelation::MovePreimage(const CUDD::BDD& states,
+                                                      const CUDD::BDD& cube) const {
+    const Schedule* schedule = nullptr;
+    for (const auto& [scheduled_cube, cube_schedule] : cube_schedules_) {
+        if (scheduled_cube == cube) {
+            schedule = &cube_schedule;
+            break;
+        }
+    }
+    if (schedule == nullptr) {
+        const CUDD::BDD& primed_cube = var_mgr_->state_variables_cube(primed_automaton_id_);
+        cube_schedules_.emplace_back(cube, MakeSchedule(clusters_, QuantifiedIndices({primed_cube, cube})));
+        schedule = &cube_schedules_.back().second;
+    }
+    return Apply(states.SwapVariables(state_variables_, primed_variables_), *schedule);
+}
+
+CUDD::BDD PartitionedTransitionRelation::StateRelation() const {
+    return Apply(var_mgr_->cudd_mgr()->bddOne(), state_relation_schedule_);
+}
+
+const std::vector<CUDD::BDD>& PartitionedTransitionRelation::clusters() const {
+    return clusters_;
+}
+
+std::size_t PartitionedTransitionRelation::primed_automaton_id() const {
+    return primed_automaton_id_;
+}
+
+} // namespace Syft
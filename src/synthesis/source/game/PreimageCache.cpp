@@ -0,0 +1,62 @@
+#include "game/PreimageCache.h"
+
+#include <stdexcept>
+
+namespace Syft {
+
+    PreimageCache::PreimageCache(std::size_t max_nodes) : max_nodes_(max_nodes) {}
+
+    void PreimageCache::attach(std::size_t automaton_id, Player starting_player, Player protagonist_player) {
+        if (!game_) {
+            game_ = Game{automaton_id, starting_player, protagonist_player};
+        } else if (game_->automaton_id != automaton_id || game_->starting_player != starting_player ||
+                   game_->protagonist_player != protagonist_player) {
+            throw std::runtime_error("Error: Preimage cache shared by solvers of different games");
+        }
+    }
+
+    std::optional<CUDD::BDD> PreimageCache::find(const CUDD::BDD &target) {
+        stats_.lookups++;
+        auto found = index_.find(target.getNode());
+        if (found == index_.end()) {
+            return std::nullopt;
+        }
+        stats_.hits++;
+        entries_.splice(entries_.begin(), entries_, found->second);
+        return found->second->preimage;
+    }
+
+    void PreimageCache::insert(const CUDD::BDD &target, const CUDD::BDD &preimage) {
+        std::size_t nodes = static_cast<std::size_t>(target.nodeCount()) +
+                            static_cast<std::size_t>(preimage.nodeCount());
+        if (nodes > max_nodes_ || index_.count(target.getNode()) > 0) {
+            return;
+        }
+        while (!entries_.empty() && stats_.nodes + nodes > max_nodes_) {
+            const Entry &oldest = entries_.back();
+            stats_.nodes -= oldest.nodes;
+            index_.erase(oldest.target.getNode());
+            entries_.pop_back();
+            stats_.evictions++;
+        }
+        entries_.push_front(Entry{target, preimage, nodes});
+        index_.emplace(target.getNode(), entries_.begin());
+        stats_.nodes += nodes;
+        stats_.entries = entries_.size();
+    }
+
+    void PreimageCache::clear() {
+        index_.clear();
+        entries_.clear();
+        stats_ = PreimageCacheStats();
+    }
+
+    std::size_t PreimageCache::max_nodes() const {
+        return max_nodes_;
+    }
+
+    const PreimageCacheStats &PreimageCache::stats() const {
+        return stats_;
+    }
+
+}
@@ -8,6 +8,14 @@ namespace Syft {
         return bdd;
     }
 
+    CUDD::BDD NoQuantification::apply(const CUDD::BDD &bdd, const BddBackend &backend) const {
+        return bdd;
+    }
+
+    std::unique_ptr<Quantification> NoQuantification::transfer(CUDD::Cudd &mgr) const {
+        return std::make_unique<NoQuantification>();
+    }
+
     Forall::Forall(CUDD::BDD universal_variables)
             : universal_variables_(std::move(universal_variables)) {}
 
@@ -15,6 +23,14 @@ namespace Syft {
         return bdd.UnivAbstract(universal_variables_);
     }
 
+    CUDD::BDD Forall::apply(const CUDD::BDD &bdd, const BddBackend &backend) const {
+        return backend.UnivAbstract(bdd, universal_variables_);
+    }
+
+    std::unique_ptr<Quantification> Forall::transfer(CUDD::Cudd &mgr) const {
+        return std::make_unique<Forall>(universal_variables_.Transfer(mgr));
+    }
+
     Exists::Exists(CUDD::BDD existential_variables)
             : existential_variables_(std::move(existential_variables)) {}
 
@@ -22,6 +38,14 @@ namespace Syft {
         return bdd.ExistAbstract(existential_variables_);
     }
 
+    CUDD::BDD Exists::apply(const CUDD::BDD &bdd, const BddBackend &backend) const {
+        return backend.ExistAbstract(bdd, existential_variables_);
+    }
+
+    std::unique_ptr<Quantification> Exists::transfer(CUDD::Cudd &mgr) const {
+        return std::make_unique<Exists>(existential_variables_.Transfer(mgr));
+    }
+
     ForallExists::ForallExists(CUDD::BDD universal_variables,
                                CUDD::BDD existential_variables)
             : forall_(std::move(universal_variables)), exists_(std::move(existential_variables)) {}
@@ -30,6 +54,14 @@ namespace Syft {
         return forall_.apply(exists_.apply(bdd));
     }
 
+    CUDD::BDD ForallExists::apply(const CUDD::BDD &bdd, const BddBackend &backend) const {
+        return forall_.apply(exists_.apply(bdd, backend), backend);
+    }
+
+    std::unique_ptr<Quantification> ForallExists::transfer(CUDD::Cudd &mgr) const {
+        return std::make_unique<ForallExists>(forall_.variables().Transfer(mgr), exists_.variables().Transfer(mgr));
+    }
+
     ExistsForall::ExistsForall(CUDD::BDD existential_variables,
                                CUDD::BDD universal_variables)
             : exists_(std::move(existential_variables)), forall_(std::move(universal_variables)) {}
@@ -38,4 +70,12 @@ namespace Syft {
         return exists_.apply(forall_.apply(bdd));
     }
 
+    CUDD::BDD ExistsForall::apply(const CUDD::BDD &bdd, const BddBackend &backend) const {
+        return exists_.apply(forall_.apply(bdd, backend), backend);
+    }
+
+    std::unique_ptr<Quantification> ExistsForall::transfer(CUDD::Cudd &mgr) const {
+        return std::make_unique<ExistsForall>(exists_.variables().Transfer(mgr), forall_.variables().Transfer(mgr));
+    }
+
 }
@@ -3,6 +3,7 @@
 //
 
 #include "game/Reachability.hpp"
+#include "game/FixpointTelemetry.h"
 
 namespace Syft {
     Reachability::Reachability(const SymbolicStateDfa &spec, Player starting_player,
@@ -12,36 +13,96 @@ namespace Syft {
               state_space_(state_space) {
     }
 
+    Reachability::Reachability(const ProductArena &arena, Player starting_player, Player protagonist_player,
+                               const CUDD::BDD &goal_states, const CUDD::BDD &state_space)
+            : Reachability(arena.symbolic_view(), starting_player, protagonist_player, goal_states, state_space) {
+        product_arena_ = std::make_shared<ProductArena>(arena);
+    }
+
+    void Reachability::set_horizon(std::size_t steps) {
+        horizon_ = steps;
+    }
+
     SynthesisResult Reachability:: run() const {
         SynthesisResult result;
         CUDD::BDD winning_states = state_space_ & goal_states_;
         CUDD::BDD winning_moves = winning_states;
+        CUDD::BDD frontier = winning_states;
+        std::size_t state_bits = var_mgr_->state_variable_count(spec_.automaton_id());
+        fixpoint_trace_ = FixpointTrace();
+
+        // A backend other than CUDD keeps the iterates in its own package for the whole fixpoint,
+        // which records no trace; with the agent first, the added states are restricted to state_space
+        const BddBackend &backend = var_mgr_->bdd_backend();
+        if (realizability_only_ && fixpoint_mode_ == FixpointMode::Full && backend.name() != "cudd" &&
+            preimage_engine_ == PreimageEngine::Compose && !product_arena_ && !preimage_cache_ &&
+            !state_abstraction_) {
+            ControllableFixpoint fixpoint;
+            fixpoint.start = winning_states;
+            fixpoint.care = starting_player_ == Player::Agent ? state_space_ : var_mgr_->cudd_mgr()->bddOne();
+            fixpoint.vector = transition_vector_;
+            fixpoint.quantifiers = kernel_.quantifiers();
+            fixpoint.stop = spec_.initial_state_bdd();
+            fixpoint.max_steps = horizon_;
+            fixpoint.on_iteration = [this]() { var_mgr_->check_budget("fixpoint"); };
+            result.winning_states = backend.LeastFixpoint(fixpoint);
+            result.winning_moves = winning_moves;
+            result.realizability = includes_initial_state(result.winning_states);
+            result.transducer = nullptr;
+            return result;
+        }
 
-        while (true) {
+        FixpointProbe probe("reachability", std::to_string(spec_.automaton_id()), state_bits);
+
+        for (std::size_t step = 1; ; ++step) {
+            var_mgr_->check_budget("fixpoint");
             CUDD::BDD new_winning_states, new_winning_moves;
 
-            if (starting_player_ == Player::Agent) {
-                CUDD::BDD quantified_X_transitions_to_winning_states = preimage(winning_states);
-                new_winning_moves = winning_moves |
-                                    (state_space_ & (!winning_states) & quantified_X_transitions_to_winning_states);
+            // Only predecessors of the last added states can become winning
+            CUDD::BDD candidates = !winning_states;
+            if (fixpoint_mode_ == FixpointMode::Frontier) {
+                candidates &= predecessors(frontier);
+            }
 
-                new_winning_states = project_into_states(new_winning_moves);
+            if (starting_player_ == Player::Agent) {
+                CUDD::BDD quantified_X_transitions_to_winning_states =
+                        fixpoint_mode_ == FixpointMode::Frontier
+                        ? preimage(winning_states, state_space_ & candidates)
+                        : preimage(winning_states);
+                CUDD::BDD added_moves = state_space_ & candidates & quantified_X_transitions_to_winning_states;
+                if (realizability_only_) {
+                    // Only the states matter, not the moves accumulated so far
+                    new_winning_moves = winning_moves;
+                    new_winning_states = winning_states | project_into_states(added_moves);
+                } else {
+                    new_winning_moves = winning_moves | added_moves;
+                    new_winning_states = project_into_states(new_winning_moves);
+                }
             } else {
-                CUDD::BDD transitions_to_winning_states = preimage(winning_states);
+                CUDD::BDD transitions_to_winning_states =
+                        fixpoint_mode_ == FixpointMode::Frontier
+                        ? preimage(winning_states, candidates)
+                        : preimage(winning_states);
                 CUDD::BDD new_collected_winning_states = project_into_states(transitions_to_winning_states);
                 new_winning_states = winning_states | new_collected_winning_states;
-                new_winning_moves = winning_moves |
-                                    ((!winning_states) & new_collected_winning_states & transitions_to_winning_states);
+                new_winning_moves = realizability_only_
+                                    ? winning_moves
+                                    : winning_moves |
+                                      (candidates & new_collected_winning_states & transitions_to_winning_states);
             }
 
+            frontier = new_winning_states & !winning_states;
+            fixpoint_trace_.record(frontier, candidates, new_winning_states, state_bits);
+            probe.iteration(new_winning_states);
+
             if (includes_initial_state(new_winning_states)) {
                 result.realizability = true;
                 result.winning_states = new_winning_states;
                 result.winning_moves = new_winning_moves;
-                result.transducer = AbstractSingleStrategy(result);
+                result.transducer = realizability_only_ ? nullptr : AbstractSingleStrategy(result);
                 return result;
 
-            } else if (new_winning_states == winning_states) {
+            } else if (new_winning_states == winning_states || step == horizon_) {
                 result.realizability = false;
                 result.winning_states = new_winning_states;
                 result.winning_moves = new_winning_moves;
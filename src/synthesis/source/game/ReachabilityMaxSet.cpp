@@ -4,6 +4,8 @@
 
 #include "game/ReachabilityMaxSet.hpp"
 
+#include <optional>
+
 namespace Syft {
     ReachabilityMaxSet::ReachabilityMaxSet(const SymbolicStateDfa &spec, Player starting_player,
                                            Player protagonist_player, const CUDD::BDD &goal_states,
@@ -13,25 +15,59 @@ namespace Syft {
     }
 
     SynthesisResult ReachabilityMaxSet::run() const {
+        std::vector<CUDD::BDD> winning_sets;
+        return solve(true, winning_sets);
+    }
+
+    SynthesisResult ReachabilityMaxSet::solve(bool collect_moves, std::vector<CUDD::BDD> &winning_sets) const {
         SynthesisResult result;
         CUDD::BDD winning_states = state_space_ & goal_states_;
         CUDD::BDD winning_moves = winning_states;
+        CUDD::BDD frontier = winning_states;
+        std::size_t state_bits = var_mgr_->state_variable_count(spec_.automaton_id());
+        fixpoint_trace_ = FixpointTrace();
+        winning_sets.push_back(winning_states);
 
         while (true) {
+            var_mgr_->check_budget("fixpoint");
             CUDD::BDD new_winning_states, new_winning_moves;
 
-            if (starting_player_ == Player::Agent) {
-                CUDD::BDD quantified_X_transitions_to_winning_states = preimage(winning_states);
-                new_winning_moves = winning_moves |
-                                    (state_space_ & (!winning_states) & quantified_X_transitions_to_winning_states);
+            // Only predecessors of the last added states can become winning
+            CUDD::BDD candidates = !winning_states;
+            if (fixpoint_mode_ == FixpointMode::Frontier) {
+                candidates &= predecessors(frontier);
+            }
 
-                new_winning_states = project_into_states(new_winning_moves);
+            if (starting_player_ == Player::Agent) {
+                CUDD::BDD quantified_X_transitions_to_winning_states =
+                        fixpoint_mode_ == FixpointMode::Frontier
+                        ? preimage(winning_states, state_space_ & candidates)
+                        : preimage(winning_states);
+                CUDD::BDD added_moves = state_space_ & candidates & quantified_X_transitions_to_winning_states;
+                if (collect_moves) {
+                    new_winning_moves = winning_moves | added_moves;
+                    new_winning_states = project_into_states(new_winning_moves);
+                } else {
+                    new_winning_moves = winning_moves;
+                    new_winning_states = winning_states | project_into_states(added_moves);
+                }
             } else {
-                CUDD::BDD transitions_to_winning_states = preimage(winning_states);
+                CUDD::BDD transitions_to_winning_states =
+                        fixpoint_mode_ == FixpointMode::Frontier
+                        ? preimage(winning_states, candidates)
+                        : preimage(winning_states);
                 CUDD::BDD new_collected_winning_states = project_into_states(transitions_to_winning_states);
                 new_winning_states = winning_states | new_collected_winning_states;
-                new_winning_moves = winning_moves |
-                                    ((!winning_states) & new_collected_winning_states & transitions_to_winning_states);
+                new_winning_moves = collect_moves
+                                    ? winning_moves |
+                                      (candidates & new_collected_winning_states & transitions_to_winning_states)
+                                    : winning_moves;
+            }
+
+            frontier = new_winning_states & !winning_states;
+            fixpoint_trace_.record(frontier, candidates, new_winning_states, state_bits);
+            if (!frontier.IsZero()) {
+                winning_sets.push_back(new_winning_states);
             }
 
             if (includes_initial_state(new_winning_states)) {
@@ -55,23 +91,56 @@ namespace Syft {
     }
 
     MaxSetSynthesisResult ReachabilityMaxSet::run_maxset() const {
-        SynthesisResult result = run();
+        // Shared by both strategies, which are each computed once
+        struct Strategies {
+            std::vector<CUDD::BDD> winning_sets;
+            std::optional<CUDD::BDD> deferring;
+            std::optional<CUDD::BDD> nondeferring;
+        };
+        auto strategies = std::make_shared<Strategies>();
+        SynthesisResult result = solve(false, strategies->winning_sets);
+
         MaxSetSynthesisResult maxset;
         maxset.realizability = result.realizability;
-        if (result.realizability) {
-            maxset.nondeferring_strategy = result.winning_moves;
-            maxset.deferring_strategy =
-                    result.winning_moves | (result.winning_states & preimage(result.winning_states));
-        } else {
-            maxset.nondeferring_strategy = var_mgr_->cudd_mgr()->bddZero();
-            maxset.deferring_strategy = var_mgr_->cudd_mgr()->bddZero();
+        if (!result.realizability) {
+            CUDD::BDD none = var_mgr_->cudd_mgr()->bddZero();
+            maxset.deferring_strategy = [none]() { return none; };
+            maxset.nondeferring_strategy = [none]() { return none; };
+            return maxset;
         }
+
+        // Every move of a goal state, and every move of a winning state that stays winning
+        maxset.deferring_strategy = [this, strategies]() {
+            if (!strategies->deferring) {
+                const CUDD::BDD &goal = strategies->winning_sets.front();
+                const CUDD::BDD &winning_states = strategies->winning_sets.back();
+                strategies->deferring = goal | preimage(winning_states, winning_states);
+            }
+            return *strategies->deferring;
+        };
+        // Every move of a goal state, and every move of a state of layer i into a layer below i
+        maxset.nondeferring_strategy = [this, strategies]() {
+            if (!strategies->nondeferring) {
+                const std::vector<CUDD::BDD> &winning_sets = strategies->winning_sets;
+                CUDD::BDD strategy = winning_sets.front();
+                for (std::size_t i = 1; i < winning_sets.size(); ++i) {
+                    CUDD::BDD layer = winning_sets[i] & !winning_sets[i - 1];
+                    strategy |= preimage(winning_sets[i - 1], layer);
+                }
+                strategies->nondeferring = strategy;
+            }
+            return *strategies->nondeferring;
+        };
         return maxset;
     }
 
-    void ReachabilityMaxSet::dump_dot(MaxSetSynthesisResult maxset, const std::string &def_filename,
+    void ReachabilityMaxSet::dump_dot(const MaxSetSynthesisResult &maxset, const std::string &def_filename,
                                       const std::string &nondef_filename) const {
-        var_mgr_->dump_dot(maxset.deferring_strategy.Add(), def_filename);
-        var_mgr_->dump_dot(maxset.nondeferring_strategy.Add(), nondef_filename);
+        if (!def_filename.empty()) {
+            var_mgr_->dump_dot(maxset.deferring_strategy().Add(), def_filename);
+        }
+        if (!nondef_filename.empty()) {
+            var_mgr_->dump_dot(maxset.nondeferring_strategy().Add(), nondef_filename);
+        }
     }
 }
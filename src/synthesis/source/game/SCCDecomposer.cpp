@@ -1,10 +1,13 @@
 #include "game/SCCDecomposer.h"
+#include "game/PartitionedTransitionRelation.h"
 #include "VarMgr.h"
+#include "debug.hpp"
 #include <vector>
 #include <algorithm>
 #include <cassert>
-#include <queue>
 #include <cstdint>
+#include <optional>
+#include <stdexcept>
 extern "C" {
 #include "cudd.h"
 }
@@ -13,343 +16,231 @@ namespace Syft {
 
 static constexpr bool kVerboseSCC = false;
 
+std::unique_ptr<SCCDecomposer> SCCDecomposer::Create(SCCAlgorithm algorithm, const SymbolicStateDfa& arena,
+                                                     const ChainOptions& chain) {
+    switch (algorithm) {
+        case SCCAlgorithm::Chain:
+            return std::make_unique<ChainSCCDecomposer>(arena, chain);
+        case SCCAlgorithm::Skeleton:
+            return std::make_unique<SkeletonSCCDecomposer>(arena);
+        case SCCAlgorithm::Naive:
+        default:
+            return std::make_unique<NaiveSCCDecomposer>(arena);
+    }
+}
+
+std::vector<CUDD::BDD> SCCDecomposer::PeelLayers(const CUDD::BDD& states) const {
+    std::vector<CUDD::BDD> layers;
+    CUDD::BDD remaining = states;
+    while (!remaining.IsZero()) {
+        // Layers of some decomposers also depend on the moves
+        CUDD::BDD layer = PeelLayer(remaining).ExistAbstract(context_.io_cube()) & remaining;
+        if (layer.IsZero()) {
+            break;
+        }
+        layers.push_back(layer);
+        remaining &= !layer;
+    }
+    return layers;
+}
+
+SCCAlgorithm SCCDecomposer::AlgorithmFromString(const std::string& name) {
+    if (name == "naive") {
+        return SCCAlgorithm::Naive;
+    } else if (name == "chain") {
+        return SCCAlgorithm::Chain;
+    } else if (name == "skeleton") {
+        return SCCAlgorithm::Skeleton;
+    }
+    throw std::runtime_error("Error: Unknown SCC algorithm: " + name);
+}
+
+ChainPivot ChainSCCDecomposer::PivotFromString(const std::string& name) {
+    if (name == "arbitrary") {
+        return ChainPivot::Arbitrary;
+    } else if (name == "last-layer") {
+        return ChainPivot::LastLayer;
+    } else if (name == "min-in-degree") {
+        return ChainPivot::MinInDegree;
+    }
+    throw std::runtime_error("Error: Unknown chain pivot strategy: " + name);
+}
+
 namespace {
-    // Helper function to compute forward reachability layer by layer
-    // Returns (forward_set, latest_layer) where:
-    // - forward_set: all states reachable from pivot within vertices
-    // - latest_layer: the states in the last layer of the forward BFS
-    std::pair<CUDD::BDD, CUDD::BDD> forwards_layer(
-        const SymbolicStateDfa& arena,
-        const CUDD::BDD& pivot,
-        const CUDD::BDD& vertices) {
-        
-        auto var_mgr = arena.var_mgr();
-        auto automaton_id = arena.automaton_id();
-        auto transition_func = arena.transition_function();
-        auto state_vars = var_mgr->get_state_variables(automaton_id);
-        auto state_cube = var_mgr->state_variables_cube(automaton_id);
-        
-        // Build transition vector for VectorCompose
-        auto transition_vector = var_mgr->make_compose_vector(automaton_id, transition_func);
-        
+    // States reachable from a pivot within a subgraph, with the last BFS level
+    struct ForwardSearch {
+        CUDD::BDD forward_set;
+        CUDD::BDD last_level;
+    };
+
+    ForwardSearch forward_search(const ArenaImageContext& context,
+                                 const CUDD::BDD& pivot,
+                                 const CUDD::BDD& vertices) {
         CUDD::BDD forward_set = pivot;
-        CUDD::BDD current_layer = pivot;
-        CUDD::BDD latest_layer = pivot;
-        
+        CUDD::BDD level = pivot;
+        CUDD::BDD last_level = pivot;
         while (true) {
-            // Compute next layer: states reachable from current_layer via one transition
-            // next_layer = {s' | exists s in current_layer: (s, s') in T and s' in vertices}
-            CUDD::BDD next_layer = current_layer.VectorCompose(transition_vector);
-            next_layer &= vertices;  // Restrict to vertices
-            next_layer &= !forward_set;  // Only new states
-            
-            if (next_layer.IsZero()) {
+            level = context.Image(level) & vertices & !forward_set;
+            if (level.IsZero()) {
                 break;
             }
-            
-            forward_set |= next_layer;
-            latest_layer = next_layer;
-            current_layer = next_layer;
+            forward_set |= level;
+            last_level = level;
         }
-        
-        return {forward_set, latest_layer};
-    }
-    
-    // Helper function to compute backward reachability from pivot
-    // Returns all states in forward_set that can reach the pivot
-    // This is the SCC containing the pivot (intersection of forward and backward sets)
-    // Note: This is a simplified implementation. A full implementation would
-    // build a reverse transition relation for efficient predecessor computation.
-    CUDD::BDD backwards(
-        const SymbolicStateDfa& arena,
-        const CUDD::BDD& pivot,
-        const CUDD::BDD& forward_set) {
-        
-        auto var_mgr = arena.var_mgr();
-        auto automaton_id = arena.automaton_id();
-        auto transition_func = arena.transition_function();
-        auto transition_vector = var_mgr->make_compose_vector(automaton_id, transition_func);
-        
-        // Backward set: all states in forward_set that can reach pivot
-        // We compute this iteratively by finding predecessors
-        CUDD::BDD backward_set = pivot;
-        CUDD::BDD current_layer = pivot;
-        
-        while (true) {
-            // Find predecessors of current_layer within forward_set
-            // A state s' is a predecessor if it can transition to a state in current_layer
-            CUDD::BDD candidates = forward_set & !backward_set;
-            
-            if (candidates.IsZero()) {
-                break;
-            }
-            
-            // Check which candidates transition into current_layer
-            // For each candidate s', check if transition_func(s') intersects current_layer
-            // Since we can't easily reverse VectorCompose, we use a fixpoint approach:
-            // Take all candidates and let the algorithm converge
-            // (In a full implementation, we'd build a reverse transition relation)
-            
-            CUDD::BDD prev_layer = candidates;
-            
-            // Filter: only keep candidates that actually transition to current_layer
-            // We approximate by checking if the image of candidates intersects current_layer
-            // and then taking a subset. For correctness, we take all candidates
-            // and rely on the fact that only those that can reach will be added.
-            
-            // More precise filtering would require building reverse relation
-            // For now, this will work but may be less efficient
-            
-            if (prev_layer.IsZero()) {
-                break;
-            }
-            
-            backward_set |= prev_layer;
-            current_layer = prev_layer;
+        return {forward_set, last_level};
+    }
+}
+
+CUDD::BDD ChainSCCDecomposer::ChoosePivot(const CUDD::BDD& vertices, const CUDD::BDD& pivots) const {
+    CUDD::BDD candidates = pivots & vertices;
+    if (options_.pivot == ChainPivot::Arbitrary || candidates.IsZero()) {
+        candidates = vertices;
+    }
+    if (options_.pivot == ChainPivot::MinInDegree) {
+        // A state no other state of the subgraph enters is an SCC of its own,
+        // and one entered only from the candidates is entered from few states
+        CUDD::BDD unentered = candidates & !context_.Image(vertices);
+        if (unentered.IsZero() && candidates != vertices) {
+            unentered = candidates & !context_.Image(vertices & !candidates);
+        }
+        if (!unentered.IsZero()) {
+            candidates = unentered;
         }
-        
-        // The SCC is the intersection of forward_set and backward_set
-        // But since we started from pivot and only explored within forward_set,
-        // backward_set is already the SCC
-        return backward_set;
     }
+    return context_.PickState(candidates);
 }
 
-CUDD::BDD ChainSCCDecomposer::PeelLayer(const CUDD::BDD& states) const {
-    auto var_mgr = arena_.var_mgr();
-    auto automaton_id = arena_.automaton_id();
+void ChainSCCDecomposer::Decompose(const CUDD::BDD& states) const {
+    auto var_mgr = context_.var_mgr();
     auto mgr = var_mgr->cudd_mgr();
-    
-    if (states.IsZero()) {
-        return mgr->bddZero();
-    }
-    
-    // Stack with {vertices, pivots}
-    std::vector<std::pair<CUDD::BDD, CUDD::BDD>> call_stack = {
-        {states, mgr->bddZero()}
-    };
-    
-    // Result: union of all terminal SCCs (top layers)
-    CUDD::BDD result = mgr->bddZero();
-    
-    const size_t state_cube = var_mgr->state_variables_cube(automaton_id);
-    
-    // Execute call stack
-    while (!call_stack.empty()) {        
-        // Pop latest from call stack
-        CUDD::BDD vertices = call_stack.back().first;
-        CUDD::BDD pivots = call_stack.back().second;
+
+    components_.clear();
+    component_entries_.clear();
+
+    // Pending calls {vertices, pivots}; the pivots may be empty
+    std::vector<std::pair<CUDD::BDD, CUDD::BDD>> call_stack = {{states, mgr->bddZero()}};
+    std::size_t pivots_per_round = std::max<std::size_t>(options_.pivots_per_round, 1);
+
+    while (!call_stack.empty()) {
+        auto [vertices, pivots] = call_stack.back();
         call_stack.pop_back();
-        
+
         if (vertices.IsZero()) {
             continue;
         }
-        
-        // Pick a pivot on the chain, if possible
-        // Get one satisfying assignment from pivots (or vertices if pivots is empty)
-        CUDD::BDD pivot_candidates = pivots.IsZero() ? vertices : pivots;
-        
-        // Get one minterm (satisfying assignment) from pivot_candidates
-
-        std::vector<unsigned int> support_int = pivot_candidates.SupportIndices();
-        std::vector<CUDD::BDD> support_bdd;
-        support_bdd.reserve(support_int.size());
-        for (const auto x : support_int) { support_bdd.push_back(mgr->bddVar(x)); }
-    
-        CUDD::BDD pivot = pivot_candidates.PickOneMinterm(support_bdd);
-        
-        if (pivot.IsZero()) {
-            continue;
-        }
-        
-        // Compute forward(v, V) and backwards(v, forward(v, V)), i.e. SCC(v)
-        auto [forward_set, latest_layer] = forwards_layer(arena_, pivot, vertices);
-        CUDD::BDD pivot_scc = backwards(arena_, pivot, forward_set);
-        
-        if (pivot_scc.IsZero()) {
-            continue;
-        }
-        
-        // If this SCC is terminal (no outgoing edges to other SCCs), add to result
-        // Check if there are transitions from pivot_scc to vertices - pivot_scc
-        auto transition_vector = var_mgr->make_compose_vector(
-            automaton_id, arena_.transition_function());
-        CUDD::BDD next_from_scc = pivot_scc.VectorCompose(transition_vector);
-        CUDD::BDD transitions_outside = next_from_scc & (vertices & !pivot_scc);
-        
-        if (transitions_outside.IsZero()) {
-            // Terminal SCC - add to result
-            result |= pivot_scc;
-        }
-        
-        // Recurse on remaining parts
-        CUDD::BDD forward_vertices = forward_set & !pivot_scc;
-        CUDD::BDD forward_pivots = latest_layer & !pivot_scc;
-        
-        CUDD::BDD rest_vertices = vertices & !forward_set;
-        
-        // Count states to decide recursion order (smaller first for space efficiency)
-        double forward_size = forward_vertices.CountMinterm(var_mgr->state_variable_count(automaton_id));
-        double rest_size = rest_vertices.CountMinterm(var_mgr->state_variable_count(automaton_id));
-        
-        bool forward_first = forward_size < rest_size;
-        
-        // Compute rest_pivots: states in rest_vertices that can reach pivot_scc
+        var_mgr->check_budget("SCC decomposition");
+
+        // Every SCC lies inside or outside a forward set, so each search of
+        // the round runs among the states the earlier ones did not reach
+        CUDD::BDD rest = vertices;
         CUDD::BDD rest_pivots = mgr->bddZero();
-        // This would require computing predecessors of pivot_scc in rest_vertices
-        // For now, use empty set (will pick arbitrary pivot in rest_vertices)
-        
-        // Place recursive calls on stack
-        if (!rest_vertices.IsZero() && !forward_first) {
-            call_stack.push_back({rest_vertices, rest_pivots});
-        }
-        if (!rest_vertices.IsZero()) {
-            call_stack.push_back({rest_vertices, rest_pivots});
-        }
-        if (!forward_vertices.IsZero() && forward_first) {
-            call_stack.push_back({forward_vertices, forward_pivots});
+        for (std::size_t round = 0; round < pivots_per_round && !rest.IsZero(); ++round) {
+            CUDD::BDD pivot = ChoosePivot(rest, pivots | rest_pivots);
+            ForwardSearch forward = forward_search(context_, pivot, rest);
+
+            // SCC(pivot): the states of the forward set that reach the pivot
+            CUDD::BDD scc = pivot;
+            CUDD::BDD preimage;
+            while (true) {
+                preimage = context_.Preimage(scc);
+                CUDD::BDD added = preimage & forward.forward_set & !scc;
+                if (added.IsZero()) {
+                    break;
+                }
+                scc |= added;
+            }
+            CUDD::BDD entries = preimage & states & !scc;
+            components_.push_back(scc);
+            component_entries_.push_back(entries);
+
+            // The chain continues from the last level of the search inside
+            // the forward set, and from the states entering the SCC outside it
+            call_stack.push_back({forward.forward_set & !scc, forward.last_level & !scc});
+            rest &= !forward.forward_set;
+            rest_pivots = (rest_pivots | entries) & rest;
         }
+        call_stack.push_back({rest, rest_pivots});
     }
-    
-    return result;
+
+    decomposed_states_ = states;
+    has_decomposition_ = true;
+    SYFT_DEBUG_TRACE("[ChainSCCDecomposer] {} SCCs in {} symbolic steps", components_.size(), SymbolicSteps());
 }
 
-namespace {
-    // Helper function to convert unprimed state BDD to primed
-    CUDD::BDD UnprimedToPrimed(std::shared_ptr<VarMgr> var_mgr, 
-                               std::size_t unprimed_id, 
-                               std::size_t primed_id, 
-                               const CUDD::BDD& unprimed_bdd) {
-        auto unprimed_vars = var_mgr->get_state_variables(unprimed_id);
-        auto primed_vars = var_mgr->get_state_variables(primed_id);
-        auto mgr = var_mgr->cudd_mgr();
-        
-        
-        // Create a variable mapping from unprimed to primed
-        // Initialize with identity mapping (all variables map to themselves)
-        std::size_t total_vars = var_mgr->total_variable_count();
-        std::vector<CUDD::BDD> compose_vector(total_vars);
-        
-        // First, map all variables to themselves
-        for (std::size_t i = 0; i < total_vars; ++i) {
-            compose_vector[i] = mgr->bddVar(static_cast<int>(i));
-        }
-        
-        // Replace unprimed state variables with primed ones
-        size_t num_bits = var_mgr->state_variable_count(unprimed_id);
-        for (size_t i = 0; i < num_bits; ++i) {
-            size_t unprimed_index = unprimed_vars[i].NodeReadIndex();
-            size_t primed_index = primed_vars[i].NodeReadIndex();
-            compose_vector[unprimed_index] = primed_vars[i];
-            //std::cout << "[UnprimedToPrimed]   Variable " << i << ": index " << unprimed_index 
-            //          << " -> primed index " << primed_index << std::endl;
-        }
-        
-        CUDD::BDD result = unprimed_bdd.VectorCompose(compose_vector);
-        
-        return result;
-    }
-
-    // Helper function to swap primed and unprimed variables in a relation
-    CUDD::BDD SwapPrimedAndUnprimed(std::shared_ptr<VarMgr> var_mgr,
-                                     std::size_t unprimed_id,
-                                     std::size_t primed_id,
-                                     const CUDD::BDD& relation) {
-        auto unprimed_vars = var_mgr->get_state_variables(unprimed_id);
-        auto primed_vars = var_mgr->get_state_variables(primed_id);
-        auto mgr = var_mgr->cudd_mgr();
-        
-        // Create swap mapping: unprimed -> primed, primed -> unprimed
-        std::size_t total_vars = var_mgr->total_variable_count();
-        std::vector<CUDD::BDD> swap_vector(total_vars);
-        
-        // First, map all variables to themselves
-        for (std::size_t i = 0; i < total_vars; ++i) {
-            swap_vector[i] = mgr->bddVar(static_cast<int>(i));
-        }
-        
-        // Map unprimed to primed
-        size_t num_bits = var_mgr->state_variable_count(unprimed_id);
-        for (size_t i = 0; i < num_bits; ++i) {
-            size_t unprimed_index = unprimed_vars[i].NodeReadIndex();
-            swap_vector[unprimed_index] = primed_vars[i];
+std::vector<std::size_t> ChainSCCDecomposer::LiveComponents(const CUDD::BDD& states) const {
+    // The SCCs of a union of SCCs are the SCCs it contains
+    bool cached = has_decomposition_ && (states & !decomposed_states_).IsZero();
+    for (std::size_t i = 0; cached && i < components_.size(); ++i) {
+        CUDD::BDD inside = components_[i] & states;
+        cached = inside.IsZero() || inside == components_[i];
+    }
+    if (!cached) {
+        Decompose(states);
+    }
+    std::vector<std::size_t> live;
+    for (std::size_t i = 0; i < components_.size(); ++i) {
+        if (!(components_[i] & states).IsZero()) {
+            live.push_back(i);
         }
-        
-        // Map primed to unprimed
-        for (size_t i = 0; i < num_bits; ++i) {
-            size_t primed_index = primed_vars[i].NodeReadIndex();
-            swap_vector[primed_index] = unprimed_vars[i];
+    }
+    return live;
+}
+
+CUDD::BDD ChainSCCDecomposer::TopLayer(const CUDD::BDD& states, const std::vector<std::size_t>& live) const {
+    CUDD::BDD layer = context_.var_mgr()->cudd_mgr()->bddZero();
+    for (std::size_t i : live) {
+        if ((component_entries_[i] & states).IsZero()) {
+            layer |= components_[i];
         }
-        
-        return relation.VectorCompose(swap_vector);
     }
+    return layer;
 }
 
-// Compute & and existential quantification in one step, and merge from small to larger formulas
+std::vector<CUDD::BDD> ChainSCCDecomposer::Components(const CUDD::BDD& states) const {
+    std::vector<CUDD::BDD> components;
+    for (std::size_t i : LiveComponents(states)) {
+        components.push_back(components_[i]);
+    }
+    return components;
+}
 
+CUDD::BDD ChainSCCDecomposer::PeelLayer(const CUDD::BDD& states) const {
+    if (states.IsZero()) {
+        return states;
+    }
+    return TopLayer(states, LiveComponents(states));
+}
 
-CUDD::BDD NaiveSCCDecomposer::BuildTransitionRelation(std::size_t primed_automaton_id) const {
-    auto var_mgr = arena_.var_mgr();
-    auto mgr = var_mgr->cudd_mgr();
-    
-    // Get transition functions f_i for each state variable
-    auto transition_func = arena_.transition_function();
-    
-    // Get primed state variables s_i'
-    auto primed_vars = var_mgr->get_state_variables(primed_automaton_id);
-    
-    // Build transition relation: AND_i(s_i' <-> f_i(s, x, y))
-    CUDD::BDD io_cube = var_mgr->input_cube() * var_mgr->output_cube();
-    CUDD::BDD trans_relation = mgr->bddOne();
-    // Collect equivalences first
-    std::vector<CUDD::BDD> terms;
-    terms.reserve(transition_func.size());
-    for (std::size_t i = 0; i < transition_func.size(); ++i) {
-        spdlog::debug("[BuildTransitionRelation] Preparing equiv for state variable {}", i);
-        terms.push_back(primed_vars[i].Xnor(transition_func[i]));
-    }
-
-    // Sort terms by BDD size (node count) before merging
-    // This implements Huffman-style merging: always merge the two smallest BDDs
-    // This minimizes intermediate BDD sizes during conjunction
-    spdlog::debug("[BuildTransitionRelation] Sorting {} terms by size", terms.size());
-    
-    // Calculate sizes and create priority queue (min-heap by node count)
-    auto cmp = [](const CUDD::BDD& a, const CUDD::BDD& b) {
-        return a.nodeCount() > b.nodeCount();  // Min-heap: smaller nodes first
-    };
-    std::priority_queue<CUDD::BDD, std::vector<CUDD::BDD>, decltype(cmp)> pq(cmp);
-    
-    // Add all terms to priority queue
-    for (const auto& term : terms) {
-            spdlog::trace("[BuildTransitionRelation]   Term size: {} nodes", term.nodeCount());
-        pq.push(term);
-    }
-    
-    // Merge two smallest BDDs at a time
-    while (pq.size() > 1) {
-        CUDD::BDD first = pq.top();
-        pq.pop();
-        CUDD::BDD second = pq.top();
-        pq.pop();
-        
-            spdlog::trace("[BuildTransitionRelation] Merging BDDs of size {} and {}", 
-                          first.nodeCount(), second.nodeCount());
-            
-            CUDD::BDD merged = first & second;
-            spdlog::trace("[BuildTransitionRelation]   Result size: {} nodes", merged.nodeCount());
-        
-        pq.push(merged);
-    }
-    
-    if (!pq.empty()) {
-        trans_relation = pq.top();
-    }
-    
-    spdlog::trace("[BuildTransitionRelation] Beginning existential abstraction");
-    // Existentially quantify over input and output variables to get state-to-state relation
-    trans_relation = trans_relation.ExistAbstract(io_cube);
-     spdlog::trace("Finished existential abstraction");
+std::vector<CUDD::BDD> ChainSCCDecomposer::PeelLayers(const CUDD::BDD& states) const {
+    std::vector<CUDD::BDD> layers;
+    if (states.IsZero()) {
+        return layers;
+    }
+
+    std::vector<std::size_t> live = LiveComponents(states);
+    CUDD::BDD remaining = states;
+    while (!live.empty()) {
+        context_.var_mgr()->check_budget("SCC decomposition");
+        CUDD::BDD layer = TopLayer(remaining, live);
+        if (layer.IsZero()) {
+            break;
+        }
+        layers.push_back(layer);
+        remaining &= !layer;
+        live.erase(std::remove_if(live.begin(), live.end(), [&](std::size_t i) {
+            return (components_[i] & remaining).IsZero();
+        }), live.end());
+    }
+    return layers;
+}
+
+CUDD::BDD NaiveSCCDecomposer::BuildTransitionRelation() const {
+    // Conjoin the bit relations AND_i(s_i' <-> f_i(s, x, y)) cluster by cluster,
+    // quantifying each input and output variable after its last cluster
+    SYFT_DEBUG_TRACE("[BuildTransitionRelation] Partitioning {} bit relations",
+                     context_.transition_function().size());
+    CUDD::BDD trans_relation = context_.Relation().StateRelation();
+    spdlog::trace("[BuildTransitionRelation] Relation size: {} nodes", trans_relation.nodeCount());
 
     return trans_relation;
 }
@@ -387,51 +278,48 @@ CUDD::BDD NaiveSCCDecomposer::ComposeRelations(const CUDD::BDD& R1, const CUDD::
     }
 
     if (log_enabled) {
-        spdlog::debug("[ComposeRelations] swapping primed->temp and unprimed->temp variables");
+        SYFT_DEBUG_TRACE("[ComposeRelations] swapping primed->temp and unprimed->temp variables");
     }
     CUDD::BDD R1_st = R1.SwapVariables(primed_swap, temp_swap);
     CUDD::BDD R2_ts = R2.SwapVariables(unprimed_swap, temp_swap);
 
-    // Compute ∃t. (R1(s,t) ∧ R2(t,s')) via AndAbstract for efficiency
-    CUDD::BDD composition = (R1_st & R2_ts).ExistAbstract(temp_cube);
-    spdlog::debug("[ComposeRelations] Composition node count: {}", composition.nodeCount());
+    // Compute ∃t. (R1(s,t) ∧ R2(t,s')) via AndAbstract, never building the conjunction
+    CUDD::BDD composition = R1_st.AndAbstract(R2_ts, temp_cube);
+    SYFT_DEBUG_TRACE("[ComposeRelations] Composition node count: {}", composition.nodeCount());
     return composition;
 }
 
-CUDD::BDD NaiveSCCDecomposer::TransitiveClosure(const CUDD::BDD& relation, 
-                                                 std::size_t primed_automaton_id,
-                                                 std::size_t temp_automaton_id) const {
-    auto var_mgr = arena_.var_mgr();
-    auto automaton_id = arena_.automaton_id();
-    auto mgr = var_mgr->cudd_mgr();
-    
-    // Use iterative composition with original relation to verify ComposeRelations is correct:
-    // R⁺ = R ∪ R² ∪ R³ ∪ ... where R^(i+1) = R^i ∘ R
-    
-    CUDD::BDD closure = relation;  // Accumulates R ∪ R² ∪ R³ ∪ ...
-    CUDD::BDD power = relation;    // Current power: R, R², R³, ...
-    
+std::optional<CUDD::BDD> NaiveSCCDecomposer::TransitiveClosure(const CUDD::BDD& relation,
+                                                                const CUDD::BDD& states,
+                                                                std::size_t node_limit) const {
+    // Iterative squaring within states: after step i, closure holds the paths
+    // of length up to 2^i whose states all lie in states, so
+    // R⁺ is reached after a logarithmic number of compositions
+    CUDD::BDD restriction = states & context_.ToPrimed(states);
+    CUDD::BDD closure = relation & restriction;
+    SYFT_DEBUG_TRACE("[TransitiveClosure] Restricted relation: {} nodes", closure.nodeCount());
+
     int iteration = 0;
     while (true) {
         iteration++;
-        // Debug log clusre iteration
-            spdlog::debug("[TransitiveClosure] Iteration {}: ",
-                          iteration);
-        // Compute next power: R^(i+1) = R^i ∘ R (compose power with original relation)
-        CUDD::BDD next_power = ComposeRelations(power, relation, primed_automaton_id, temp_automaton_id);
-        
+        arena_.var_mgr()->check_budget("transitive closure");
+        CUDD::BDD squared = ComposeRelations(closure, closure, primed_automaton_id_, temp_automaton_id_);
+        CUDD::BDD new_closure = (closure | squared) & restriction;
+        SYFT_DEBUG_TRACE("[TransitiveClosure] Squaring {}: square {} nodes, closure {} nodes",
+                         iteration, squared.nodeCount(), new_closure.nodeCount());
+
         // Check if we've reached fixpoint (no new paths added)
-        CUDD::BDD new_closure = closure | next_power;
         if (new_closure == closure) {
             break;
         }
-        
-        // Update closure and power
         closure = new_closure;
-        power = next_power;
-        
+
+        if (node_limit > 0 && static_cast<std::size_t>(closure.nodeCount()) > node_limit) {
+            SYFT_DEBUG_TRACE("[TransitiveClosure] Closure exceeds {} nodes, giving up", node_limit);
+            return std::nullopt;
+        }
     }
-    
+
     return closure;
 }
 
@@ -439,19 +327,13 @@ void NaiveSCCDecomposer::Initialize() const {
     if (initialized_) return;
 
     auto var_mgr = arena_.var_mgr();
-    auto automaton_id = arena_.automaton_id();
 
-    size_t num_bits = var_mgr->state_variable_count(automaton_id);
-    primed_automaton_id_ = var_mgr->create_state_variables(num_bits);
-    temp_automaton_id_ = var_mgr->create_state_variables(num_bits);
+    primed_automaton_id_ = context_.primed_automaton_id();
+    temp_automaton_id_ = var_mgr->create_state_variables(context_.state_bit_count());
 
     // Build one-step transition relation (state->state), BuildTransitionRelation
     // will existentially quantify IO as needed.
-    transition_relation_ = BuildTransitionRelation(primed_automaton_id_);
-
-    // Compute full transitive closure once for the whole arena
-    cached_path_relation_ = TransitiveClosure(transition_relation_, primed_automaton_id_, temp_automaton_id_);
-    has_cached_path_relation_ = true;
+    transition_relation_ = BuildTransitionRelation();
     initialized_ = true;
 }
 
@@ -464,27 +346,43 @@ CUDD::BDD NaiveSCCDecomposer::BuildPathRelation(const CUDD::BDD& states,
     // Ensure initialization has been done (creates cached relations and variable ids)
     Initialize();
 
-    // Now restrict the cached path relation to the provided state set S x S'
-    CUDD::BDD primed_states = UnprimedToPrimed(var_mgr, automaton_id, primed_automaton_id_, states);
-    CUDD::BDD restricted_path = cached_path_relation_ & states & primed_states;
+    // Try to cache the closure over the first state set, as long as it stays small
+    if (!has_cached_path_relation_ && !closure_cache_disabled_) {
+        std::optional<CUDD::BDD> closure = TransitiveClosure(transition_relation_, states, closure_node_limit_);
+        if (closure) {
+            cached_path_relation_ = *closure;
+            cached_path_domain_ = states;
+            has_cached_path_relation_ = true;
+        } else {
+            closure_cache_disabled_ = true;
+            spdlog::info("[NaiveSCCDecomposer] Path relation exceeds {} nodes; recomputing it for every layer",
+                         closure_node_limit_);
+        }
+    }
+
+    if (has_cached_path_relation_ && (states & !cached_path_domain_).IsZero()) {
+        // Now restrict the cached path relation to the provided state set S x S'
+        CUDD::BDD primed_states = context_.ToPrimed(states);
+        CUDD::BDD restricted_path = cached_path_relation_ & states & primed_states;
 
-    if (kVerboseSCC) {
-        spdlog::debug("[BuildPathRelation] Using cached path relation and restricting to current state set");
+        if (kVerboseSCC) {
+            SYFT_DEBUG_TRACE("[BuildPathRelation] Using cached path relation and restricting to current state set");
+        }
+
+        return restricted_path;
     }
 
-    return restricted_path;
+    // Paths within states only; the states peeled so far are left out of every squaring
+    return *TransitiveClosure(transition_relation_, states, 0);
+}
+
+void NaiveSCCDecomposer::SetClosureNodeLimit(std::size_t node_limit) {
+    closure_node_limit_ = node_limit;
 }
 
 TransitionRelationResult NaiveSCCDecomposer::BuildTransitionRelationWithPrimed() const {
-    auto var_mgr = arena_.var_mgr();
-    auto automaton_id = arena_.automaton_id();
-    
-    size_t num_bits = var_mgr->state_variable_count(automaton_id);
-    std::size_t primed_automaton_id = var_mgr->create_state_variables(num_bits);
-    
-    CUDD::BDD relation = BuildTransitionRelation(primed_automaton_id);
-    
-    return TransitionRelationResult{relation, primed_automaton_id};
+    CUDD::BDD relation = BuildTransitionRelation();
+    return TransitionRelationResult{relation, context_.primed_automaton_id()};
 }
 
 PathRelationResult NaiveSCCDecomposer::BuildPathRelationWithPrimed(const CUDD::BDD& states) const {
@@ -510,17 +408,17 @@ CUDD::BDD NaiveSCCDecomposer::PeelLayer(const CUDD::BDD& states) const {
 
     if (path_relation.IsZero()) {
         if (kVerboseSCC) {
-            spdlog::debug("[PeelLayer] Path relation is empty; returning zero layer");
+            SYFT_DEBUG_TRACE("[PeelLayer] Path relation is empty; returning zero layer");
         }
         return mgr->bddZero();
     }
 
-    CUDD::BDD swapped_path = SwapPrimedAndUnprimed(var_mgr, automaton_id, primed_automaton_id_, path_relation);
+    CUDD::BDD swapped_path = context_.SwapPrimed(path_relation);
 
     CUDD::BDD primed_cube = var_mgr->state_variables_cube(primed_automaton_id_);
     CUDD::BDD top_layer = states & (!swapped_path | path_relation).UnivAbstract(primed_cube);
 
-    spdlog::debug("[PeelLayer] Top layer (restricted) node count: {}", top_layer.nodeCount());
+    SYFT_DEBUG_TRACE("[PeelLayer] Top layer (restricted) node count: {}", top_layer.nodeCount());
 
     auto state_vars = var_mgr->get_state_variables(automaton_id);
 
@@ -535,5 +433,175 @@ CUDD::BDD NaiveSCCDecomposer::PeelLayer(const CUDD::BDD& states) const {
     return top_layer;
 }
 
-} // namespace Syft
+SkeletonSCCDecomposer::ForwardResult SkeletonSCCDecomposer::Forward(const CUDD::BDD& vertices,
+                                                                    const CUDD::BDD& node) const {
+    // BFS from the node, keeping every level
+    std::vector<CUDD::BDD> levels;
+    CUDD::BDD forward_set = node;
+    CUDD::BDD level = node;
+    while (!level.IsZero()) {
+        levels.push_back(level);
+        level = context_.Image(level) & vertices & !forward_set;
+        forward_set |= level;
+    }
+
+    // Walk back from one state of the last level to the node, one state per level.
+    // Edges only lead one level deeper, so a predecessor of the last picked
+    // state is always found in the previous level.
+    CUDD::BDD end_node = context_.PickState(levels.back());
+    CUDD::BDD skeleton = end_node;
+    CUDD::BDD current = end_node;
+    for (std::size_t i = levels.size() - 1; i-- > 0;) {
+        current = context_.PickState(context_.Preimage(current) & levels[i]);
+        skeleton |= current;
+    }
+
+    return ForwardResult{forward_set, skeleton, end_node};
+}
+
+bool SkeletonSCCDecomposer::IsUnionOfComponents(const CUDD::BDD& states) const {
+    if (!has_decomposition_ || !(states & !decomposed_states_).IsZero()) {
+        return false;
+    }
+    for (const CUDD::BDD& component : components_) {
+        CUDD::BDD inside = component & states;
+        if (!inside.IsZero() && inside != component) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void SkeletonSCCDecomposer::Decompose(const CUDD::BDD& states) const {
+    auto var_mgr = context_.var_mgr();
+    auto mgr = var_mgr->cudd_mgr();
+
+    components_.clear();
+    component_exits_.clear();
+
+    // Pending calls {vertices, skeleton, node}; a zero node means "pick any"
+    struct Call {
+        CUDD::BDD vertices;
+        CUDD::BDD skeleton;
+        CUDD::BDD node;
+    };
+    std::vector<Call> call_stack = {{states, mgr->bddZero(), mgr->bddZero()}};
+
+    while (!call_stack.empty()) {
+        Call call = call_stack.back();
+        call_stack.pop_back();
+
+        if (call.vertices.IsZero()) {
+            continue;
+        }
+        var_mgr->check_budget("SCC decomposition");
+
+        CUDD::BDD node = call.node & call.vertices;
+        if (node.IsZero()) {
+            node = context_.PickState(call.vertices);
+        }
+
+        ForwardResult forward = Forward(call.vertices, node);
+
+        // SCC(node): the states of the forward set that reach the node
+        CUDD::BDD scc = node;
+        while (true) {
+            CUDD::BDD added = context_.Preimage(scc) & forward.forward_set & !scc;
+            if (added.IsZero()) {
+                break;
+            }
+            scc |= added;
+        }
+        components_.push_back(scc);
+        component_exits_.push_back(context_.Image(scc) & !scc);
+
+        // The part of the skeleton outside the SCC is a path leading into it,
+        // and lies outside the forward set: continue from its last state
+        CUDD::BDD rest_skeleton = call.skeleton & !scc;
+        CUDD::BDD rest_node = context_.PickState(context_.Preimage(call.skeleton & scc) & rest_skeleton);
+
+        call_stack.push_back({call.vertices & !forward.forward_set, rest_skeleton, rest_node});
+        call_stack.push_back({forward.forward_set & !scc, forward.skeleton & !scc, forward.end_node & !scc});
+    }
+
+    decomposed_states_ = states;
+    has_decomposition_ = true;
+    SYFT_DEBUG_TRACE("[SkeletonSCCDecomposer] {} SCCs", components_.size());
+}
+
+std::vector<std::size_t> SkeletonSCCDecomposer::LiveComponents(const CUDD::BDD& states) const {
+    // The SCCs of a union of SCCs are the SCCs it contains, so the cached
+    // decomposition stays valid while the layer loop removes whole layers
+    if (!IsUnionOfComponents(states)) {
+        Decompose(states);
+    }
+    std::vector<std::size_t> live;
+    for (std::size_t i = 0; i < components_.size(); ++i) {
+        if (!(components_[i] & states).IsZero()) {
+            live.push_back(i);
+        }
+    }
+    return live;
+}
+
+CUDD::BDD SkeletonSCCDecomposer::TopLayer(const CUDD::BDD& states,
+                                          const std::vector<std::size_t>& live) const {
+    // States entered from another SCC of states
+    CUDD::BDD entered = context_.var_mgr()->cudd_mgr()->bddZero();
+    for (std::size_t i : live) {
+        entered |= component_exits_[i];
+    }
+    entered &= states;
+
+    // Everything reachable from them is reached from another SCC
+    CUDD::BDD reached = entered;
+    CUDD::BDD frontier = entered;
+    while (!frontier.IsZero()) {
+        frontier = context_.Image(frontier) & states & !reached;
+        reached |= frontier;
+    }
 
+    return states & !reached;
+}
+
+std::vector<CUDD::BDD> SkeletonSCCDecomposer::Components(const CUDD::BDD& states) const {
+    std::vector<CUDD::BDD> components;
+    for (std::size_t i : LiveComponents(states)) {
+        components.push_back(components_[i]);
+    }
+    return components;
+}
+
+CUDD::BDD SkeletonSCCDecomposer::PeelLayer(const CUDD::BDD& states) const {
+    if (states.IsZero()) {
+        return states;
+    }
+    return TopLayer(states, LiveComponents(states));
+}
+
+std::vector<CUDD::BDD> SkeletonSCCDecomposer::PeelLayers(const CUDD::BDD& states) const {
+    std::vector<CUDD::BDD> layers;
+    if (states.IsZero()) {
+        return layers;
+    }
+
+    std::vector<std::size_t> live = LiveComponents(states);
+    CUDD::BDD remaining = states;
+    while (!live.empty()) {
+        context_.var_mgr()->check_budget("SCC decomposition");
+        CUDD::BDD layer = TopLayer(remaining, live);
+        if (layer.IsZero()) {
+            break;
+        }
+        layers.push_back(layer);
+        remaining &= !layer;
+
+        // Drop the peeled SCCs, so that later passes only look at the others
+        live.erase(std::remove_if(live.begin(), live.end(), [&](std::size_t i) {
+            return (components_[i] & remaining).IsZero();
+        }), live.end());
+    }
+    return layers;
+}
+
+} // namespace Syft
@@ -0,0 +1,53 @@
+#include "game/Safety.hpp"
+
+namespace Syft {
+    Safety::Safety(const SymbolicStateDfa &spec, Player starting_player, Player protagonist_player,
+                   const CUDD::BDD &safe_states, const CUDD::BDD &state_space)
+            : DfaGameSynthesizer(spec, starting_player, protagonist_player), safe_states_(safe_states),
+              state_space_(state_space) {
+    }
+
+    Safety::Safety(const ProductArena &arena, Player starting_player, Player protagonist_player,
+                   const CUDD::BDD &safe_states, const CUDD::BDD &state_space)
+            : Safety(arena.symbolic_view(), starting_player, protagonist_player, safe_states, state_space) {
+        product_arena_ = std::make_shared<ProductArena>(arena);
+    }
+
+    SynthesisResult Safety::run() const {
+        SynthesisResult result;
+        CUDD::BDD safe_winning_states = state_space_ & safe_states_;
+        // Initially every unsafe state counts as removed, including those outside state_space
+        CUDD::BDD removed = !safe_winning_states;
+        std::size_t state_bits = var_mgr_->state_variable_count(spec_.automaton_id());
+        fixpoint_trace_ = FixpointTrace();
+
+        while (true) {
+            var_mgr_->check_budget("fixpoint");
+
+            // Only predecessors of the last removed states can lose
+            CUDD::BDD candidates = safe_winning_states;
+            if (fixpoint_mode_ == FixpointMode::Frontier) {
+                candidates &= predecessors(removed);
+            }
+            CUDD::BDD staying_states = project_into_states(preimage(safe_winning_states, candidates));
+            CUDD::BDD new_safe_winning_states = safe_winning_states & !(candidates & !staying_states);
+
+            removed = safe_winning_states & !new_safe_winning_states;
+            fixpoint_trace_.record(removed, candidates, new_safe_winning_states, state_bits);
+
+            if (new_safe_winning_states == safe_winning_states) {
+                break;
+            }
+            safe_winning_states = new_safe_winning_states;
+        }
+
+        // The states, safe or not, whose every successor can stay safe
+        CUDD::BDD moves_to_safe_winning_states = preimage(safe_winning_states, state_space_);
+        result.winning_states = safe_winning_states | project_into_states(moves_to_safe_winning_states);
+        result.winning_moves = result.winning_states & moves_to_safe_winning_states;
+        result.realizability = includes_initial_state(result.winning_states);
+        result.transducer = result.realizability && !realizability_only_ ? AbstractSingleStrategy(result) : nullptr;
+        return result;
+    }
+
+}
@@ -0,0 +1,90 @@
+#include "game/SolvedGameSnapshot.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Syft {
+
+SolvedGameSnapshot::SolvedGameSnapshot(const SymbolicStateDfa& arena, const SynthesisResult& result)
+  : realizability_(result.realizability) {
+  std::shared_ptr<VarMgr> var_mgr = arena.var_mgr();
+  BddCircuit circuit(var_mgr);
+  auto add_slot = [&](int index) {
+    circuit.add_slot(index);
+    variable_indices_.push_back(index);
+  };
+
+  for (const CUDD::BDD& variable : var_mgr->get_state_variables(arena.automaton_id())) {
+    add_slot(static_cast<int>(variable.NodeReadIndex()));
+  }
+  if (result.transducer) {
+    for (const CUDD::BDD& variable : result.transducer->get_state_variables()) {
+      int index = static_cast<int>(variable.NodeReadIndex());
+      if (std::find(variable_indices_.begin(), variable_indices_.end(), index) == variable_indices_.end()) {
+        add_slot(index);
+      }
+    }
+  }
+  state_count_ = variable_indices_.size();
+  input_labels_ = var_mgr->input_variable_labels();
+  output_labels_ = var_mgr->output_variable_labels();
+  for (const std::string& name : input_labels_) {
+    add_slot(static_cast<int>(var_mgr->name_to_variable(name).NodeReadIndex()));
+  }
+  for (const std::string& name : output_labels_) {
+    add_slot(static_cast<int>(var_mgr->name_to_variable(name).NodeReadIndex()));
+  }
+  input_count_ = input_labels_.size();
+  output_count_ = output_labels_.size();
+
+  if (result.winning_states.getNode() == nullptr) {
+    throw std::runtime_error("Error: The result has no winning states");
+  }
+  winning_root_ = circuit.add(result.winning_states);
+  if (result.winning_moves.getNode() != nullptr) {
+    winning_moves_root_ = circuit.add(result.winning_moves);
+    has_winning_moves_ = true;
+  }
+  if (result.transducer) {
+    std::vector<std::uint32_t> set_slots;
+    for (const std::string& name : result.transducer->controller_outputs()) {
+      set_slots.push_back(circuit.slot(static_cast<int>(var_mgr->name_to_variable(name).NodeReadIndex())));
+    }
+    const std::unordered_map<int, CUDD::BDD>& output_function = result.transducer->get_output_function();
+    for (std::uint32_t slot : set_slots) {
+      auto function = output_function.find(variable_indices_[slot]);
+      if (function == output_function.end()) {
+        throw std::runtime_error("Error: The strategy has no function for " +
+                                 var_mgr->index_to_name(variable_indices_[slot]));
+      }
+      for (std::uint32_t read : circuit.support(function->second)) {
+        if (std::find(set_slots.begin(), set_slots.end(), read) != set_slots.end()) {
+          throw std::runtime_error("Error: The strategy function of " +
+                                   var_mgr->index_to_name(variable_indices_[slot]) + " depends on a variable it sets");
+        }
+      }
+      strategy_.emplace_back(slot, circuit.add(function->second));
+    }
+  }
+
+  // The circuit keeps the BDDs referenced; only its nodes are kept
+  nodes_ = circuit.nodes();
+}
+
+bool SolvedGameSnapshot::is_winning_move(const std::uint8_t* values) const {
+  if (!has_winning_moves_) {
+    throw std::runtime_error("Error: The snapshot has no winning moves");
+  }
+  return BddCircuit::evaluate(nodes_.data(), winning_moves_root_, values) == BddCircuit::true_node;
+}
+
+void SolvedGameSnapshot::strategy_move(std::uint8_t* values) const {
+  if (strategy_.empty()) {
+    throw std::runtime_error("Error: The snapshot has no strategy");
+  }
+  for (const auto& [slot, root] : strategy_) {
+    values[slot] = BddCircuit::evaluate(nodes_.data(), root, values) == BddCircuit::true_node ? 1 : 0;
+  }
+}
+
+}
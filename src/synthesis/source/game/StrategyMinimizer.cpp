@@ -0,0 +1,154 @@
+#include "game/StrategyMinimizer.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <spdlog/spdlog.h>
+
+namespace Syft {
+
+namespace {
+  std::size_t shared_size(const std::unordered_map<int, CUDD::BDD>& output_function) {
+    std::vector<CUDD::BDD> functions;
+    for (const auto& [index, function] : output_function) {
+      functions.push_back(function);
+    }
+    return shared_node_count(functions);
+  }
+
+  // The range of functions[first...] over variables[first...], splitting on each output in turn
+  CUDD::BDD range(const VarMgr& var_mgr, std::vector<CUDD::BDD> functions, const std::vector<CUDD::BDD>& variables,
+                  std::size_t first) {
+    var_mgr.check_budget("strategy minimization");
+    if (first == functions.size()) {
+      return var_mgr.cudd_mgr()->bddOne();
+    }
+    CUDD::BDD f = functions[first];
+    if (f.IsOne() || f.IsZero()) {
+      return (f.IsOne() ? variables[first] : !variables[first]) & range(var_mgr, functions, variables, first + 1);
+    }
+    std::vector<CUDD::BDD> high = functions;
+    std::vector<CUDD::BDD> low = functions;
+    for (std::size_t k = first + 1; k < functions.size(); ++k) {
+      high[k] = functions[k].Constrain(f);
+      low[k] = functions[k].Constrain(!f);
+    }
+    functions.clear();
+    return (variables[first] & range(var_mgr, std::move(high), variables, first + 1)) |
+           (!variables[first] & range(var_mgr, std::move(low), variables, first + 1));
+  }
+}
+
+StrategyMinimization strategy_minimization_from_string(const std::string& name) {
+  if (name == "off") {
+    return StrategyMinimization::Off;
+  } else if (name == "restrict") {
+    return StrategyMinimization::Restrict;
+  } else if (name == "licompaction") {
+    return StrategyMinimization::LICompaction;
+  }
+  throw std::runtime_error("Error: Unknown strategy minimization: " + name);
+}
+
+CUDD::BDD care_simplified(const CUDD::BDD& function, const CUDD::BDD& care, StrategyMinimization method) {
+  if (method == StrategyMinimization::Off || care.IsZero()) {
+    return function;
+  }
+  return method == StrategyMinimization::LICompaction ? function.LICompaction(care) : function.Restrict(care);
+}
+
+std::size_t shared_node_count(const std::vector<CUDD::BDD>& functions) {
+  std::vector<DdNode*> nodes;
+  for (const CUDD::BDD& function : functions) {
+    nodes.push_back(function.getNode());
+  }
+  return nodes.empty() ? 0 : static_cast<std::size_t>(Cudd_SharingSize(nodes.data(), static_cast<int>(nodes.size())));
+}
+
+CUDD::BDD reachable_states(const std::shared_ptr<VarMgr>& var_mgr, const CUDD::BDD& initial_state,
+                           const std::vector<CUDD::BDD>& transition_function,
+                           const std::vector<CUDD::BDD>& state_variables, std::size_t* iterations) {
+  CUDD::BDD reached = initial_state;
+  CUDD::BDD frontier = initial_state;
+  std::size_t iteration = 0;
+  while (!frontier.IsZero()) {
+    iteration++;
+    // The image of the frontier is the range of the transition function constrained to it
+    std::vector<CUDD::BDD> constrained;
+    for (const CUDD::BDD& bit : transition_function) {
+      constrained.push_back(bit.Constrain(frontier));
+    }
+    CUDD::BDD image = range(*var_mgr, std::move(constrained), state_variables, 0);
+    frontier = image & !reached;
+    reached |= image;
+  }
+  if (iterations) {
+    *iterations = iteration;
+  }
+  return reached;
+}
+
+StrategyMinimizationReport minimize_strategy(const std::shared_ptr<VarMgr>& var_mgr,
+                                             std::unordered_map<int, CUDD::BDD>& output_function,
+                                             const CUDD::BDD& winning_moves, const CUDD::BDD& initial_state,
+                                             const std::vector<CUDD::BDD>& transition_function,
+                                             const std::vector<CUDD::BDD>& state_variables,
+                                             const StrategyMinimizationOptions& options) {
+  StrategyMinimizationReport report;
+  report.nodes_before = shared_size(output_function);
+  if (options.method == StrategyMinimization::Off) {
+    report.nodes_after = report.nodes_before;
+    return report;
+  }
+  std::shared_ptr<CUDD::Cudd> mgr = var_mgr->cudd_mgr();
+  std::vector<int> outputs;
+  for (const auto& [index, function] : output_function) {
+    outputs.push_back(index);
+  }
+  std::sort(outputs.begin(), outputs.end());
+  auto identity = [&]() {
+    std::vector<CUDD::BDD> compose_vector;
+    for (std::size_t i = 0; i < var_mgr->total_variable_count(); ++i) {
+      compose_vector.push_back(mgr->bddVar(static_cast<int>(i)));
+    }
+    return compose_vector;
+  };
+
+  if (options.per_output) {
+    for (int output : outputs) {
+      var_mgr->check_budget("strategy minimization");
+      std::vector<CUDD::BDD> compose_vector = identity();
+      for (int other : outputs) {
+        if (other != output) {
+          compose_vector[other] = output_function.at(other);
+        }
+      }
+      CUDD::BDD moves = winning_moves.VectorCompose(compose_vector);
+      CUDD::BDD variable = mgr->bddVar(output);
+      // Where exactly one value of the output is winning, it must be kept
+      CUDD::BDD forced = moves.Cofactor(variable) ^ moves.Cofactor(!variable);
+      output_function[output] = care_simplified(output_function.at(output), forced, options.method);
+    }
+  }
+
+  std::vector<CUDD::BDD> compose_vector = identity();
+  for (int output : outputs) {
+    compose_vector[output] = output_function.at(output);
+  }
+  std::vector<CUDD::BDD> closed_loop;
+  for (const CUDD::BDD& bit : transition_function) {
+    closed_loop.push_back(bit.VectorCompose(compose_vector));
+  }
+  CUDD::BDD reachable = reachable_states(var_mgr, initial_state, closed_loop, state_variables,
+                                         &report.reachable_iterations);
+  for (int output : outputs) {
+    output_function[output] = care_simplified(output_function.at(output), reachable, options.method);
+  }
+
+  report.nodes_after = shared_size(output_function);
+  spdlog::info("[minimize_strategy] output functions from {} to {} nodes, {} reachability iterations",
+               report.nodes_before, report.nodes_after, report.reachable_iterations);
+  return report;
+}
+
+}
@@ -0,0 +1,126 @@
+#include "game/SymbolicEmersonLei.h"
+#include "game/ZielonkaTree.hh"
+
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <utility>
+
+namespace Syft {
+    SymbolicEmersonLei::SymbolicEmersonLei(const SymbolicStateDfa &spec, ColorFormula color_formula,
+                                           Player starting_player, Player protagonist_player,
+                                           const std::vector<CUDD::BDD> &colorBDDs, const CUDD::BDD &state_space)
+            : DfaGameSynthesizer(spec, starting_player, protagonist_player), color_formula_(std::move(color_formula)),
+              colors_(colorBDDs), state_space_(state_space) {
+        condition_ = color_formula_.to_bdd([&](std::size_t color) {
+            return color_mgr_.bddVar(static_cast<int>(color));
+        }, color_mgr_);
+    }
+
+    SymbolicEmersonLei::SymbolicEmersonLei(const ProductArena &arena, ColorFormula color_formula,
+                                           Player starting_player, Player protagonist_player,
+                                           const std::vector<CUDD::BDD> &colorBDDs, const CUDD::BDD &state_space)
+            : SymbolicEmersonLei(arena.symbolic_view(), std::move(color_formula), starting_player,
+                                 protagonist_player, colorBDDs, state_space) {
+        product_arena_ = std::make_shared<ProductArena>(arena);
+    }
+
+    CUDD::BDD SymbolicEmersonLei::cpre(std::size_t player, const CUDD::BDD &target, const CUDD::BDD &subgame,
+                                       const Escapes &escapes) const {
+        // The protagonist forcing its target, as ParitySolver::cpre
+        auto forces = [&](const CUDD::BDD &states) {
+            if (starting_player_ == Player::Agent) {
+                return project_into_states(state_space_ & preimage(states));
+            }
+            return state_space_ & project_into_states(preimage(states));
+        };
+        if (player == 0) {
+            return subgame & forces(target | escapes[0]);
+        }
+        // One step is determined: the opponent forces its target unless the protagonist forces the rest
+        return subgame & !forces(state_space_ & !(target | escapes[1]));
+    }
+
+    CUDD::BDD SymbolicEmersonLei::attractor(std::size_t player, const CUDD::BDD &target, const CUDD::BDD &subgame,
+                                            const Escapes &escapes) const {
+        CUDD::BDD attracted = subgame & target;
+        while (true) {
+            var_mgr_->check_budget("fixpoint");
+            CUDD::BDD next = attracted | cpre(player, attracted, subgame, escapes);
+            if (next == attracted) {
+                return attracted;
+            }
+            attracted = next;
+        }
+    }
+
+    CUDD::BDD SymbolicEmersonLei::solve(const CUDD::BDD &subgame, Escapes escapes, std::size_t depth) const {
+        CUDD::BDD zero = var_mgr_->cudd_mgr()->bddZero();
+        depth_ = std::max(depth_, depth);
+        CUDD::BDD game = subgame;
+        // The attractors removed from game so far that the protagonist wins
+        CUDD::BDD protagonist_won = zero;
+        while (!game.IsZero()) {
+            var_mgr_->check_budget("fixpoint");
+            subgames_++;
+            ColorSet present(std::max(colors_.size(), color_formula_.color_count()));
+            for (std::size_t i = 0; i < colors_.size(); ++i) {
+                if (!(game & colors_[i]).IsZero()) {
+                    present.set(i);
+                }
+            }
+            // Every play of game visits a subset of the present colors infinitely often
+            bool winning = color_formula_.evaluate(present);
+            std::size_t owner = winning ? 0 : 1;
+            std::vector<ColorSet> children =
+                    ZielonkaTree::maximal_subsets(present, winning, condition_, color_mgr_);
+
+            bool removed = false;
+            for (const ColorSet &child : children) {
+                CUDD::BDD target = zero;
+                (present - child).for_each([&](std::size_t i) {
+                    target |= colors_[i];
+                });
+                // Out of the attractor of its colors, the other player keeps the colors of child
+                CUDD::BDD attracted = attractor(owner, target, game, escapes);
+                Escapes child_escapes = escapes;
+                child_escapes[owner] |= attracted;
+                CUDD::BDD child_game = game & !attracted;
+                CUDD::BDD child_won = solve(child_game, child_escapes, depth + 1);
+                CUDD::BDD lost = owner == 0 ? child_game & !child_won : child_won;
+                if (lost.IsZero()) {
+                    continue;
+                }
+                // The other player wins its attractor to lost in game; the rest is solved again
+                CUDD::BDD other_won = attractor(1 - owner, lost, game, escapes);
+                if (owner == 1) {
+                    protagonist_won |= other_won;
+                }
+                escapes[1 - owner] |= other_won;
+                game &= !other_won;
+                removed = true;
+                break;
+            }
+            if (!removed) {
+                // The owner wins game by visiting the colors of every child in turn
+                return owner == 0 ? protagonist_won | game : protagonist_won;
+            }
+        }
+        return protagonist_won;
+    }
+
+    SynthesisResult SymbolicEmersonLei::run() const {
+        CUDD::BDD zero = var_mgr_->cudd_mgr()->bddZero();
+        subgames_ = 0;
+        depth_ = 0;
+        SynthesisResult result;
+        result.winning_states = solve(state_space_, {zero, zero}, 0);
+        result.realizability = includes_initial_state(result.winning_states);
+        result.winning_moves = zero;
+        result.transducer = nullptr;
+        var_mgr_->record_size("symbolic_el_subgames", static_cast<double>(subgames_));
+        spdlog::info("[SymbolicEmersonLei::run] {} colors solved in {} subgames, nested at most {} deep",
+                     colors_.size(), subgames_, depth_);
+        return result;
+    }
+
+}
@@ -0,0 +1,156 @@
+#include "game/TraceSimulator.h"
+
+#include <algorithm>
+#include <bitset>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+namespace Syft {
+
+TraceSimulator::TraceSimulator(const Transducer& strategy, const std::vector<SymbolicStateDfa>& components,
+                               const std::vector<CUDD::BDD>& goal_states)
+  : strategy_(strategy), input_count_(strategy_.input_count()), output_count_(strategy_.output_count()),
+    state_count_(0), transitions_(strategy.get_var_mgr()), goals_(strategy.get_var_mgr()) {
+  std::shared_ptr<VarMgr> var_mgr = strategy.get_var_mgr();
+  // The slots of CompiledTransducer, so that its words are copied as they are
+  std::vector<std::string> labels = strategy.controller_inputs();
+  std::vector<std::string> outputs = strategy.controller_outputs();
+  labels.insert(labels.end(), outputs.begin(), outputs.end());
+  std::vector<int> indices;
+  for (const std::string& label : labels) {
+    indices.push_back(static_cast<int>(var_mgr->name_to_variable(label).NodeReadIndex()));
+  }
+  std::vector<CUDD::BDD> transition_function;
+  for (const SymbolicStateDfa& component : components) {
+    std::vector<CUDD::BDD> variables = var_mgr->get_state_variables(component.automaton_id());
+    std::vector<int> initial_state = component.initial_state();
+    const std::vector<CUDD::BDD> &transitions = component.transition_function();
+    for (std::size_t k = 0; k < variables.size(); ++k) {
+      indices.push_back(static_cast<int>(variables[k].NodeReadIndex()));
+      initial_state_.push_back(initial_state[k] != 0 ? 1 : 0);
+    }
+    transition_function.insert(transition_function.end(), transitions.begin(), transitions.end());
+    state_count_ += variables.size();
+  }
+  for (int index : indices) {
+    transitions_.add_slot(index);
+    goals_.add_slot(index);
+  }
+  for (const CUDD::BDD& bit : transition_function) {
+    next_state_.push_back(transitions_.add(bit));
+  }
+  for (const CUDD::BDD& goal : goal_states) {
+    goal_roots_.push_back(goals_.add(goal));
+  }
+}
+
+SimulationReport TraceSimulator::simulate_random(std::size_t traces, std::size_t length, std::uint64_t seed) const {
+  SimulationReport report;
+  report.violations.assign(goal_roots_.size(), 0);
+  std::mt19937_64 random(seed);
+  InputSource inputs = [&](std::size_t, CompiledTransducer::Batch& batch) {
+    for (std::size_t i = 0; i < input_count_; ++i) {
+      std::uint64_t* words = batch.input_words(i);
+      for (std::size_t w = 0; w < batch.words(); ++w) {
+        words[w] = random();
+      }
+    }
+  };
+  for (std::size_t first = 0; first < traces; first += block_traces) {
+    std::vector<std::size_t> lengths(std::min(block_traces, traces - first), length);
+    run_block(lengths, inputs, report);
+  }
+  return report;
+}
+
+SimulationReport TraceSimulator::simulate(const std::vector<Trace>& traces) const {
+  for (const Trace& trace : traces) {
+    for (const std::vector<bool>& step : trace) {
+      if (step.size() != input_count_) {
+        throw std::runtime_error("Error: A trace step has " + std::to_string(step.size()) + " values for " +
+                                 std::to_string(input_count_) + " inputs");
+      }
+    }
+  }
+  SimulationReport report;
+  report.violations.assign(goal_roots_.size(), 0);
+  for (std::size_t first = 0; first < traces.size(); first += block_traces) {
+    std::size_t size = std::min(block_traces, traces.size() - first);
+    std::vector<std::size_t> lengths;
+    for (std::size_t t = first; t < first + size; ++t) {
+      lengths.push_back(traces[t].size());
+    }
+    InputSource inputs = [&](std::size_t step, CompiledTransducer::Batch& batch) {
+      for (std::size_t instance = 0; instance < size; ++instance) {
+        const Trace& trace = traces[first + instance];
+        for (std::size_t i = 0; i < input_count_; ++i) {
+          batch.set_input(instance, i, step < trace.size() && trace[step][i]);
+        }
+      }
+    };
+    run_block(lengths, inputs, report);
+  }
+  return report;
+}
+
+void TraceSimulator::run_block(const std::vector<std::size_t>& lengths, const InputSource& inputs,
+                               SimulationReport& report) const {
+  CompiledTransducer::Batch batch = strategy_.make_batch(lengths.size());
+  std::size_t words = batch.words();
+  std::size_t alphabet = input_count_ + output_count_;
+  std::vector<std::uint64_t> values((alphabet + state_count_) * words, 0);
+  for (std::size_t k = 0; k < state_count_; ++k) {
+    std::fill_n(values.begin() + (alphabet + k) * words, words, initial_state_[k] ? ~std::uint64_t(0) : 0);
+  }
+  std::vector<std::uint64_t> transition_values(transitions_.size() * words);
+  std::vector<std::uint64_t> goal_values(goals_.size() * words);
+  std::vector<std::uint64_t> next(state_count_ * words);
+  std::size_t max_length = lengths.empty() ? 0 : *std::max_element(lengths.begin(), lengths.end());
+
+  // Counts the traces of length \a length outside the goal states of each color
+  auto check_ends = [&](std::size_t length) {
+    std::vector<std::uint64_t> ending(words, 0);
+    bool any = false;
+    for (std::size_t instance = 0; instance < lengths.size(); ++instance) {
+      if (lengths[instance] == length) {
+        ending[instance / 64] |= std::uint64_t(1) << (instance % 64);
+        any = true;
+      }
+    }
+    if (!any) {
+      return;
+    }
+    goals_.evaluate(0, goals_.size(), values.data(), words, goal_values.data());
+    for (std::size_t c = 0; c < goal_roots_.size(); ++c) {
+      const std::uint64_t* goal = goal_values.data() + goal_roots_[c] * words;
+      for (std::size_t w = 0; w < words; ++w) {
+        report.violations[c] += std::bitset<64>(ending[w] & ~goal[w]).count();
+      }
+    }
+  };
+
+  check_ends(0);
+  for (std::size_t step = 0; step < max_length; ++step) {
+    inputs(step, batch);
+    strategy_.step(batch);
+    for (std::size_t i = 0; i < input_count_; ++i) {
+      std::copy_n(batch.input_words(i), words, values.begin() + i * words);
+    }
+    for (std::size_t o = 0; o < output_count_; ++o) {
+      std::copy_n(batch.output_words(o), words, values.begin() + (input_count_ + o) * words);
+    }
+    transitions_.evaluate(0, transitions_.size(), values.data(), words, transition_values.data());
+    for (std::size_t k = 0; k < state_count_; ++k) {
+      std::copy_n(transition_values.begin() + next_state_[k] * words, words, next.begin() + k * words);
+    }
+    std::copy(next.begin(), next.end(), values.begin() + alphabet * words);
+    check_ends(step + 1);
+  }
+  report.traces += lengths.size();
+  for (std::size_t length : lengths) {
+    report.steps += length;
+  }
+}
+
+}
@@ -9,15 +9,27 @@ Transducer::Transducer(const std::shared_ptr<VarMgr>& var_mgr,
                        const std::unordered_map<int, CUDD::BDD>& output_function,
                        const std::vector<CUDD::BDD>& transition_function,
                        Player starting_player,
-                       Player protagonist_player)
+                       Player protagonist_player,
+                       const std::vector<CUDD::BDD>& state_variables)
     : var_mgr_(var_mgr),
     initial_vector_(initial_vector),
     output_function_(output_function),
     transition_function_(transition_function),
     starting_player_(starting_player),
-    protagonist_player_(protagonist_player)
+    protagonist_player_(protagonist_player),
+    state_variables_(state_variables)
 {}
 
+std::vector<std::string> Transducer::controller_inputs() const {
+  return protagonist_player_ == Player::Agent ? var_mgr_->input_variable_labels()
+                                              : var_mgr_->output_variable_labels();
+}
+
+std::vector<std::string> Transducer::controller_outputs() const {
+  return protagonist_player_ == Player::Agent ? var_mgr_->output_variable_labels()
+                                              : var_mgr_->input_variable_labels();
+}
+
 void Transducer::dump_dot(const std::string& filename) const {
 	std::vector<std::string> output_labels;
 
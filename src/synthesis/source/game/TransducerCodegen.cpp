@@ -0,0 +1,254 @@
+#include "game/TransducerCodegen.h"
+
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace Syft {
+
+namespace {
+  void check_identifier(const std::string& name) {
+    bool valid = !name.empty() && !std::isdigit(static_cast<unsigned char>(name[0]));
+    for (char c : name) {
+      valid = valid && (std::isalnum(static_cast<unsigned char>(c)) || c == '_');
+    }
+    if (!valid) {
+      throw std::runtime_error("Error: Not an identifier: " + name);
+    }
+  }
+
+  std::string join(const std::vector<std::string>& labels) {
+    std::string result;
+    for (const std::string& label : labels) {
+      result += (result.empty() ? "" : " ") + label;
+    }
+    return result.empty() ? "none" : result;
+  }
+}
+
+TransducerCodegen::TransducerCodegen(const Transducer& transducer)
+  : inputs_(transducer.controller_inputs()), outputs_(transducer.controller_outputs()),
+    state_count_(transducer.get_state_variables().size()), circuit_(transducer.get_var_mgr()) {
+  std::shared_ptr<VarMgr> var_mgr = transducer.get_var_mgr();
+  const std::vector<CUDD::BDD>& transition_function = transducer.get_transition_function();
+  const std::vector<CUDD::BDD>& state_variables = transducer.get_state_variables();
+  if (state_variables.size() != transition_function.size()) {
+    throw std::runtime_error("Error: The transducer does not record the state variables of its transition function");
+  }
+
+  std::vector<int> output_indices;
+  for (const std::string& name : inputs_) {
+    circuit_.add_slot(static_cast<int>(var_mgr->name_to_variable(name).NodeReadIndex()));
+  }
+  for (const std::string& name : outputs_) {
+    output_indices.push_back(static_cast<int>(var_mgr->name_to_variable(name).NodeReadIndex()));
+    circuit_.add_slot(output_indices.back());
+  }
+  const std::vector<int>& initial_vector = transducer.get_initial_vector();
+  for (const CUDD::BDD& variable : state_variables) {
+    int index = static_cast<int>(variable.NodeReadIndex());
+    circuit_.add_slot(index);
+    initial_state_.push_back(index < static_cast<int>(initial_vector.size()) && initial_vector[index] != 0);
+  }
+
+  std::vector<DdNode*> functions;
+  const std::unordered_map<int, CUDD::BDD>& output_function = transducer.get_output_function();
+  for (std::size_t o = 0; o < outputs_.size(); ++o) {
+    auto function = output_function.find(output_indices[o]);
+    if (function == output_function.end()) {
+      throw std::runtime_error("Error: The transducer has no function for output " + outputs_[o]);
+    }
+    for (std::uint32_t slot : circuit_.support(function->second)) {
+      if (slot >= inputs_.size() && slot < inputs_.size() + outputs_.size()) {
+        throw std::runtime_error("Error: The function of output " + outputs_[o] + " depends on an output");
+      }
+    }
+    output_roots_.push_back(circuit_.add(function->second));
+    functions.push_back(function->second.getNode());
+  }
+  output_nodes_end_ = circuit_.size();
+  for (const CUDD::BDD& bit : transition_function) {
+    next_state_roots_.push_back(circuit_.add(bit));
+    functions.push_back(bit.getNode());
+  }
+
+  // A node read by two parents, or by a parent and a root, is computed once
+  const std::vector<BddCircuit::Node>& nodes = circuit_.nodes();
+  std::vector<std::size_t> readers(nodes.size(), 0);
+  for (std::size_t id = 2; id < nodes.size(); ++id) {
+    readers[nodes[id].child[0]]++;
+    readers[nodes[id].child[1]]++;
+  }
+  for (std::uint32_t root : output_roots_) {
+    readers[root]++;
+  }
+  for (std::uint32_t root : next_state_roots_) {
+    readers[root]++;
+  }
+  temporary_.assign(nodes.size(), false);
+  for (std::size_t id = 2; id < nodes.size(); ++id) {
+    temporary_[id] = readers[id] > 1;
+    report_.temporaries += temporary_[id];
+  }
+  report_.circuit_nodes = nodes.size() - 2;
+  report_.bdd_nodes = functions.empty() ? 0 : static_cast<std::size_t>(
+      Cudd_SharingSize(functions.data(), static_cast<int>(functions.size())));
+}
+
+std::string TransducerCodegen::slot_name(std::uint32_t slot, Language language) const {
+  std::size_t inputs = inputs_.size();
+  std::size_t outputs = outputs_.size();
+  if (slot < inputs) {
+    return "in[" + std::to_string(slot) + "]";
+  }
+  if (slot < inputs + outputs) {
+    return "out[" + std::to_string(slot - inputs) + "]";
+  }
+  std::string state = language == Language::C ? "s->state[" : "state[";
+  return state + std::to_string(slot - inputs - outputs) + "]";
+}
+
+std::string TransducerCodegen::expression(std::uint32_t node, Language language) const {
+  if (node == BddCircuit::false_node) {
+    return language == Language::C ? "0" : "1'b0";
+  }
+  if (node == BddCircuit::true_node) {
+    return language == Language::C ? "1" : "1'b1";
+  }
+  if (temporary_[node]) {
+    return "t" + std::to_string(node);
+  }
+  return node_expression(node, language);
+}
+
+std::string TransducerCodegen::node_expression(std::uint32_t node, Language language) const {
+  const BddCircuit::Node& current = circuit_.nodes()[node];
+  std::string variable = slot_name(current.slot, language);
+  std::string negated = (language == Language::C ? "!" : "~") + variable;
+  std::uint32_t then_child = current.child[1];
+  std::uint32_t else_child = current.child[0];
+  // Both children are never the same terminal, as the BDD is reduced
+  if (then_child == BddCircuit::true_node && else_child == BddCircuit::false_node) {
+    return variable;
+  }
+  if (then_child == BddCircuit::false_node && else_child == BddCircuit::true_node) {
+    return negated;
+  }
+  if (then_child == BddCircuit::true_node) {
+    return "(" + variable + " | " + expression(else_child, language) + ")";
+  }
+  if (then_child == BddCircuit::false_node) {
+    return "(" + negated + " & " + expression(else_child, language) + ")";
+  }
+  if (else_child == BddCircuit::true_node) {
+    return "(" + negated + " | " + expression(then_child, language) + ")";
+  }
+  if (else_child == BddCircuit::false_node) {
+    return "(" + variable + " & " + expression(then_child, language) + ")";
+  }
+  return "(" + variable + " ? " + expression(then_child, language) + " : " + expression(else_child, language) + ")";
+}
+
+std::string TransducerCodegen::to_c(const std::string& name) const {
+  check_identifier(name);
+  std::ostringstream code;
+  code << "/* Generated from a synthesized strategy. */\n"
+       << "/* Inputs: " << join(inputs_) << " */\n"
+       << "/* Outputs: " << join(outputs_) << " */\n"
+       << "/* " << state_count_ << " state bits, " << report_.bdd_nodes << " BDD nodes, "
+       << report_.temporaries << " temporaries */\n"
+       << "#include <stdint.h>\n\n"
+       << "typedef struct {\n"
+       << "    uint8_t state[" << std::max<std::size_t>(state_count_, 1) << "];\n"
+       << "} " << name << "_state;\n\n"
+       << "void " << name << "_reset(" << name << "_state* s) {\n";
+  for (std::size_t k = 0; k < std::max<std::size_t>(state_count_, 1); ++k) {
+    code << "    s->state[" << k << "] = " << (k < state_count_ ? int(initial_state_[k]) : 0) << ";\n";
+  }
+  code << "}\n\n"
+       << "void " << name << "_step(" << name << "_state* s, const uint8_t* in, uint8_t* out) {\n";
+  for (std::size_t id = 2; id < output_nodes_end_; ++id) {
+    if (temporary_[id]) {
+      code << "    const uint8_t t" << id << " = " << node_expression(id, Language::C) << ";\n";
+    }
+  }
+  for (std::size_t o = 0; o < output_roots_.size(); ++o) {
+    code << "    out[" << o << "] = " << expression(output_roots_[o], Language::C) << ";\n";
+  }
+  for (std::size_t id = output_nodes_end_; id < circuit_.size(); ++id) {
+    if (temporary_[id]) {
+      code << "    const uint8_t t" << id << " = " << node_expression(id, Language::C) << ";\n";
+    }
+  }
+  if (state_count_ > 0) {
+    code << "    uint8_t next[" << state_count_ << "];\n";
+    for (std::size_t k = 0; k < state_count_; ++k) {
+      code << "    next[" << k << "] = " << expression(next_state_roots_[k], Language::C) << ";\n";
+    }
+    for (std::size_t k = 0; k < state_count_; ++k) {
+      code << "    s->state[" << k << "] = next[" << k << "];\n";
+    }
+  } else {
+    code << "    (void) s;\n";
+  }
+  if (inputs_.empty()) {
+    code << "    (void) in;\n";
+  }
+  if (outputs_.empty()) {
+    code << "    (void) out;\n";
+  }
+  code << "}\n";
+  return code.str();
+}
+
+std::string TransducerCodegen::to_verilog(const std::string& name) const {
+  check_identifier(name);
+  std::ostringstream code;
+  code << "// Generated from a synthesized strategy.\n"
+       << "// Inputs: " << join(inputs_) << "\n"
+       << "// Outputs: " << join(outputs_) << "\n"
+       << "// " << state_count_ << " state bits, " << report_.bdd_nodes << " BDD nodes, "
+       << report_.temporaries << " temporaries\n"
+       << "module " << name << " (\n"
+       << "    input wire clk,\n"
+       << "    input wire rst";
+  if (!inputs_.empty()) {
+    code << ",\n    input wire [" << inputs_.size() - 1 << ":0] in";
+  }
+  if (!outputs_.empty()) {
+    code << ",\n    output wire [" << outputs_.size() - 1 << ":0] out";
+  }
+  code << "\n);\n";
+  if (state_count_ > 0) {
+    code << "    reg [" << state_count_ - 1 << ":0] state;\n"
+         << "    wire [" << state_count_ - 1 << ":0] next_state;\n";
+  }
+  for (std::size_t id = 2; id < circuit_.size(); ++id) {
+    if (temporary_[id]) {
+      code << "    wire t" << id << " = " << node_expression(id, Language::Verilog) << ";\n";
+    }
+  }
+  for (std::size_t o = 0; o < output_roots_.size(); ++o) {
+    code << "    assign out[" << o << "] = " << expression(output_roots_[o], Language::Verilog) << ";\n";
+  }
+  if (state_count_ > 0) {
+    for (std::size_t k = 0; k < state_count_; ++k) {
+      code << "    assign next_state[" << k << "] = " << expression(next_state_roots_[k], Language::Verilog)
+           << ";\n";
+    }
+    std::string initial;
+    for (std::size_t k = state_count_; k-- > 0;) {
+      initial += initial_state_[k] ? "1" : "0";
+    }
+    code << "    always @(posedge clk) begin\n"
+         << "        if (rst) state <= " << state_count_ << "'b" << initial << ";\n"
+         << "        else state <= next_state;\n"
+         << "    end\n";
+  }
+  code << "endmodule\n";
+  return code.str();
+}
+
+}
@@ -1,12 +1,59 @@
 #include "game/WeakGameSolver.h"
+#include "game/FixpointTelemetry.h"
+#include "Trace.h"
+#include "debug.hpp"
 #include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
 #include <iostream>
 #include <set>
 #include <chrono>
+#include <thread>
 #include <spdlog/spdlog.h>
 
 namespace Syft {
 
+namespace {
+    // One SCC of a layer in its own manager, so that it can be solved on another thread.
+    // The states below the layer are decided, so only the SCC itself is iterated.
+    struct ComponentGame {
+        std::unique_ptr<CUDD::Cudd> mgr;  // Declared first, so destroyed after every BDD below
+        std::vector<CUDD::BDD> compose_vector;
+        CUDD::BDD input_cube;
+        CUDD::BDD output_cube;
+        CUDD::BDD component;
+        CUDD::BDD accepting;
+        CUDD::BDD good_below;
+        CUDD::BDD winning;
+
+        CUDD::BDD CPre(const CUDD::BDD& target) const {
+            CUDD::BDD T = target.VectorCompose(compose_vector);
+            return component & T.ExistAbstract(output_cube).UnivAbstract(input_cube);
+        }
+
+        void Solve(const std::function<void()>& check_budget) {
+            // μY. C ∩ CPre_s(good ∪ Y)
+            CUDD::BDD reach = mgr->bddZero();
+            while (true) {
+                check_budget();
+                CUDD::BDD next = CPre(good_below | reach);
+                if (next == reach) break;
+                reach = next;
+            }
+            // νY. C ∩ CPre_s(good ∪ Y)
+            CUDD::BDD safe = component;
+            while (true) {
+                check_budget();
+                CUDD::BDD next = safe & CPre(good_below | safe);
+                if (next == safe) break;
+                safe = next;
+            }
+            winning = component & ((!accepting & reach) | (accepting & safe));
+        }
+    };
+}
+
 WeakGameSolver::WeakGameSolver(const SymbolicStateDfa& arena, const CUDD::BDD& accepting_states, bool debug)
     : arena_(arena)
     , var_mgr_(arena.var_mgr())
@@ -50,7 +97,7 @@ void WeakGameSolver::PrintStateSet(const std::string& name, const CUDD::BDD& sta
         if (i > 0) state_list_str += ", ";
         state_list_str += std::to_string(state_list[i]);
     }
-    spdlog::debug("[WeakGameSolver] {} ({} states) = {{{}}}", name, state_list.size(), state_list_str);
+    SYFT_DEBUG_TRACE("[WeakGameSolver] {} ({} states) = {{{}}}", name, state_list.size(), state_list_str);
 }
 
 void WeakGameSolver::Initialize() const {
@@ -61,48 +108,116 @@ void WeakGameSolver::Initialize() const {
     auto automaton_id = arena_.automaton_id();
     size_t num_bits = var_mgr_->state_variable_count(automaton_id);
     primed_automaton_id_ = var_mgr_->create_state_variables(num_bits);
+    if (num_bits >= partitioned_relation_min_bits) {
+        partitioned_relation_ = std::make_unique<PartitionedTransitionRelation>(arena_, primed_automaton_id_);
+    }
     
     initialized_ = true;
 }
 
+CUDD::BDD WeakGameSolver::MovePreimage(const CUDD::BDD& target) const {
+    Initialize();
+
+    if (partitioned_relation_) {
+        return partitioned_relation_->MovePreimage(target);
+    }
+    // T(s,i,o) := next_state(s,i,o) ∈ target
+    const auto& transition_compose_vector =
+        var_mgr_->make_compose_vector(arena_.automaton_id(), arena_.transition_function());
+    return target.VectorCompose(transition_compose_vector);
+}
+
+CUDD::BDD WeakGameSolver::MovePreimage(const CUDD::BDD& target, const CUDD::BDD& care_states) const {
+    Initialize();
+
+    if (partitioned_relation_) {
+        return care_states & partitioned_relation_->MovePreimage(target);
+    }
+    // Not make_compose_vector, which would evict the cached vector of the arena
+    size_t total_variable_count = var_mgr_->total_variable_count();
+    std::vector<CUDD::BDD> compose_vector;
+    compose_vector.reserve(total_variable_count);
+    for (size_t i = 0; i < total_variable_count; ++i) {
+        compose_vector.push_back(var_mgr_->cudd_mgr()->bddVar(static_cast<int>(i)));
+    }
+    auto state_vars = var_mgr_->get_state_variables(arena_.automaton_id());
+    const auto &transition_function = arena_.transition_function();
+    for (size_t i = 0; i < state_vars.size(); ++i) {
+        compose_vector[state_vars[i].NodeReadIndex()] = transition_function[i].Restrict(care_states);
+    }
+    return care_states & target.VectorCompose(compose_vector);
+}
+
+CUDD::BDD WeakGameSolver::ReachableStates() const {
+    Initialize();
+    if (!partitioned_relation_) {
+        image_relation_ = std::make_unique<PartitionedTransitionRelation>(arena_, primed_automaton_id_);
+    }
+    const PartitionedTransitionRelation& relation = partitioned_relation_ ? *partitioned_relation_ : *image_relation_;
+
+    CUDD::BDD reachable = arena_.initial_state_bdd();
+    CUDD::BDD frontier = reachable;
+    while (!frontier.IsZero()) {
+        var_mgr_->check_budget("reachable states");
+        frontier = relation.Image(frontier) & !reachable;
+        reachable |= frontier;
+    }
+    // Only needed once
+    image_relation_.reset();
+    return reachable;
+}
+
+CUDD::BDD WeakGameSolver::Predecessors(const CUDD::BDD& states) const {
+    Initialize();
+
+    if (partitioned_relation_) {
+        return partitioned_relation_->Preimage(states);
+    }
+    return MovePreimage(states).ExistAbstract(var_mgr_->input_cube() * var_mgr_->output_cube());
+}
+
 CUDD::BDD WeakGameSolver::CPreSystem(const CUDD::BDD& target, const CUDD::BDD& state_space) const {
     Initialize();
     
     auto automaton_id = arena_.automaton_id();
     auto mgr = var_mgr_->cudd_mgr();
-    // Use vector-compose approach: T(s,i,o) := next_state(s,i,o) ∈ target
+    // T(s,i,o) := next_state(s,i,o) ∈ target
     // Then quantify: CPre_system(X) = state_space & ∀inputs. ∃outputs. T
-    auto transition_func = arena_.transition_function();
-    auto transition_compose_vector = var_mgr_->make_compose_vector(automaton_id, transition_func);
 
     // Ensure we only consider pure-state target
     CUDD::BDD W = target & state_space;
 
     // T(s,i,o) is true when the next state is in W
-    CUDD::BDD T = W.VectorCompose(transition_compose_vector);
+    CUDD::BDD T = MovePreimage(W);
 
     CUDD::BDD exists_output = T.ExistAbstract(var_mgr_->output_cube());
     CUDD::BDD forall_input = exists_output.UnivAbstract(var_mgr_->input_cube());
 
     if (debug_ && kVerboseSolver) {
-        spdlog::debug("[WeakGameSolver] CPreSystem target count: {}", target.CountMinterm(var_mgr_->state_variable_count(automaton_id)));
+        SYFT_DEBUG_TRACE("[WeakGameSolver] CPreSystem target count: {}", target.CountMinterm(var_mgr_->state_variable_count(automaton_id)));
     }
 
     return state_space & forall_input;
 }
 
+CUDD::BDD WeakGameSolver::CPreSystem(const CUDD::BDD& target, const CUDD::BDD& state_space,
+                                     const CUDD::BDD& care_states) const {
+    CUDD::BDD care = state_space & care_states;
+    CUDD::BDD T = MovePreimage(target & state_space, care);
+
+    CUDD::BDD exists_output = T.ExistAbstract(var_mgr_->output_cube());
+    CUDD::BDD forall_input = exists_output.UnivAbstract(var_mgr_->input_cube());
+
+    return care & forall_input;
+}
+
 CUDD::BDD WeakGameSolver::CPreEnvironment(const CUDD::BDD& target, const CUDD::BDD& state_space) const {
     Initialize();
     
-    auto automaton_id = arena_.automaton_id();
-    auto mgr = var_mgr_->cudd_mgr();
-    // Use vector-compose approach: T(s,i,o) := next_state(s,i,o) ∈ target
+    // T(s,i,o) := next_state(s,i,o) ∈ target
     // Then quantify: CPre_env(X) = state_space & ∀outputs. ∃inputs. T
-    auto transition_func = arena_.transition_function();
-    auto transition_compose_vector = var_mgr_->make_compose_vector(automaton_id, transition_func);
-
     CUDD::BDD W = target & state_space;
-    CUDD::BDD T = W.VectorCompose(transition_compose_vector);
+    CUDD::BDD T = MovePreimage(W);
 
     CUDD::BDD exists_input = T.ExistAbstract(var_mgr_->input_cube());
     CUDD::BDD forall_output = exists_input.UnivAbstract(var_mgr_->output_cube());
@@ -111,12 +226,29 @@ CUDD::BDD WeakGameSolver::CPreEnvironment(const CUDD::BDD& target, const CUDD::B
 }
 
 CUDD::BDD WeakGameSolver::SolveReachability(const CUDD::BDD& goal_states,
-                                            const CUDD::BDD& state_space) const {
+                                            const CUDD::BDD& state_space, const std::string& node) const {
     // μX. (goal ∩ state_space) ∪ CPre_s(X)
     CUDD::BDD winning = state_space & goal_states;
+    CUDD::BDD frontier = winning;
+    size_t num_state_bits = var_mgr_->state_variable_count(arena_.automaton_id());
+    FixpointProbe probe("weak reachability", node, num_state_bits);
     
     while (true) {
-        CUDD::BDD new_winning = winning | (state_space & CPreSystem(winning, state_space));
+        var_mgr_->check_budget("fixpoint");
+        CUDD::BDD new_winning;
+        CUDD::BDD candidates;
+        if (fixpoint_mode_ == FixpointMode::Frontier) {
+            // Losing states without a successor in the frontier stay losing
+            candidates = state_space & !winning & Predecessors(frontier);
+            new_winning = winning | CPreSystem(winning, state_space, candidates);
+        } else {
+            candidates = state_space;
+            new_winning = winning | (state_space & CPreSystem(winning, state_space));
+        }
+
+        frontier = new_winning & !winning;
+        fixpoint_trace_.record(frontier, candidates, new_winning, num_state_bits);
+        probe.iteration(new_winning);
         
         if (new_winning == winning) {
             return winning;
@@ -127,12 +259,30 @@ CUDD::BDD WeakGameSolver::SolveReachability(const CUDD::BDD& goal_states,
 }
 
 CUDD::BDD WeakGameSolver::SolveSafety(const CUDD::BDD& safe_states,
-                                       const CUDD::BDD& state_space) const {
+                                       const CUDD::BDD& state_space, const std::string& node) const {
     // νX. (safe ∩ state_space) ∩ CPre_s(X)
     CUDD::BDD winning = state_space & safe_states;
+    // Initially every losing state counts as removed, including those outside state_space
+    CUDD::BDD removed = !winning;
+    size_t num_state_bits = var_mgr_->state_variable_count(arena_.automaton_id());
+    FixpointProbe probe("weak safety", node, num_state_bits);
     
     while (true) {
-        CUDD::BDD new_winning = winning & CPreSystem(winning, state_space);
+        var_mgr_->check_budget("fixpoint");
+        CUDD::BDD new_winning;
+        CUDD::BDD candidates;
+        if (fixpoint_mode_ == FixpointMode::Frontier) {
+            // Winning states without a successor among the removed ones stay winning
+            candidates = winning & Predecessors(removed);
+            new_winning = winning & !(candidates & !CPreSystem(winning, state_space, candidates));
+        } else {
+            candidates = winning;
+            new_winning = winning & CPreSystem(winning, state_space);
+        }
+
+        removed = winning & !new_winning;
+        fixpoint_trace_.record(removed, candidates, new_winning, num_state_bits);
+        probe.iteration(new_winning);
         
         if (new_winning == winning) {
             return winning;
@@ -147,20 +297,20 @@ void WeakGameSolver::DumpDFA() const {
     auto automaton_id = arena_.automaton_id();
     size_t num_state_bits = var_mgr_->state_variable_count(automaton_id);
     auto state_vars = var_mgr_->get_state_variables(automaton_id);
-    auto transition_func = arena_.transition_function();
+    const auto &transition_func = arena_.transition_function();
     
-    spdlog::debug("===== DFA DUMP =====");
-    spdlog::debug("[WeakGameSolver] State bits: {}", num_state_bits);
-    spdlog::debug("[WeakGameSolver] Input vars: {}", var_mgr_->input_variable_count());
-    spdlog::debug("[WeakGameSolver] Output vars: {}", var_mgr_->output_variable_count());
+    SYFT_DEBUG_TRACE("===== DFA DUMP =====");
+    SYFT_DEBUG_TRACE("[WeakGameSolver] State bits: {}", num_state_bits);
+    SYFT_DEBUG_TRACE("[WeakGameSolver] Input vars: {}", var_mgr_->input_variable_count());
+    SYFT_DEBUG_TRACE("[WeakGameSolver] Output vars: {}", var_mgr_->output_variable_count());
     
     // Dump initial state
     CUDD::BDD initial = arena_.initial_state_bdd();
-    spdlog::debug("[WeakGameSolver] Initial state BDD node count: {}", initial.nodeCount());
+    SYFT_DEBUG_TRACE("[WeakGameSolver] Initial state BDD node count: {}", initial.nodeCount());
     
     // Enumerate all states and transitions
     size_t num_states = 1 << num_state_bits;
-    spdlog::debug("[WeakGameSolver] Total possible states: {}", num_states);
+    SYFT_DEBUG_TRACE("[WeakGameSolver] Total possible states: {}", num_states);
     
     // Dump accepting states
     std::string accepting_states_str = "";
@@ -181,7 +331,7 @@ void WeakGameSolver::DumpDFA() const {
             first = false;
         }
     }
-    spdlog::debug("[WeakGameSolver] Accepting states: {{{}}}", accepting_states_str);
+    SYFT_DEBUG_TRACE("[WeakGameSolver] Accepting states: {{{}}}", accepting_states_str);
     
     // Get input/output variable counts
     size_t num_inputs = var_mgr_->input_variable_count();
@@ -190,12 +340,12 @@ void WeakGameSolver::DumpDFA() const {
     CUDD::BDD output_cube = var_mgr_->output_cube();
     size_t num_io = num_inputs + num_outputs;
     
-    spdlog::debug("[WeakGameSolver] Input variable count: {}", num_inputs);
-    spdlog::debug("[WeakGameSolver] Output variable count: {}", num_outputs);
+    SYFT_DEBUG_TRACE("[WeakGameSolver] Input variable count: {}", num_inputs);
+    SYFT_DEBUG_TRACE("[WeakGameSolver] Output variable count: {}", num_outputs);
     
     // Dump transitions (limit to small automata)
     if (num_states <= 16) {
-        spdlog::debug("[WeakGameSolver] Transitions (state -> possible next states):");
+        SYFT_DEBUG_TRACE("[WeakGameSolver] Transitions (state -> possible next states):");
         CUDD::BDD io_cube = input_cube * output_cube;
         
         for (size_t s = 0; s < num_states; ++s) {
@@ -234,13 +384,13 @@ void WeakGameSolver::DumpDFA() const {
                 next_states_str += std::to_string(ns);
                 trans_first = false;
             }
-            spdlog::debug("[WeakGameSolver]   {} -> {{{}}}", s, next_states_str);
+            SYFT_DEBUG_TRACE("[WeakGameSolver]   {} -> {{{}}}", s, next_states_str);
         }
     } else {
-        spdlog::debug("[WeakGameSolver] (Automaton too large to dump all transitions)");
+        SYFT_DEBUG_TRACE("[WeakGameSolver] (Automaton too large to dump all transitions)");
     }
     
-    spdlog::debug("[WeakGameSolver] ===== END DFA DUMP =====");
+    SYFT_DEBUG_TRACE("[WeakGameSolver] ===== END DFA DUMP =====");
     
     // Dump machine-readable format for Python reconstruction
     DumpDFAForPython();
@@ -251,7 +401,7 @@ void WeakGameSolver::DumpDFAForPython() const {
     auto automaton_id = arena_.automaton_id();
     size_t num_state_bits = var_mgr_->state_variable_count(automaton_id);
     auto state_vars = var_mgr_->get_state_variables(automaton_id);
-    auto transition_func = arena_.transition_function();
+    const auto &transition_func = arena_.transition_function();
     size_t num_inputs = var_mgr_->input_variable_count();
     size_t num_outputs = var_mgr_->output_variable_count();
     
@@ -402,20 +552,21 @@ void WeakGameSolver::DumpDFAForPython() const {
 WeakGameResult WeakGameSolver::Solve() const {
     auto mgr = var_mgr_->cudd_mgr();
     auto automaton_id = arena_.automaton_id();
+    fixpoint_trace_ = FixpointTrace();
     
     if (debug_ && kVerboseSolver) {
-        spdlog::debug("[WeakGameSolver] Starting Solve()");
+        SYFT_DEBUG_TRACE("[WeakGameSolver] Starting Solve()");
     }
     
     // Dump DFA info
     //DumpDFA();
     
     if (debug_ && kVerboseSolver) {
-        spdlog::debug("[WeakGameSolver] Accepting states count: {}", accepting_states_.CountMinterm(var_mgr_->state_variable_count(automaton_id)));
+        SYFT_DEBUG_TRACE("[WeakGameSolver] Accepting states count: {}", accepting_states_.CountMinterm(var_mgr_->state_variable_count(automaton_id)));
     }
     
     // Compute reachable states from initial state
-    spdlog::debug("[WeakGameSolver] Starting reachability computation...");
+    SYFT_DEBUG_TRACE("[WeakGameSolver] Starting reachability computation...");
     auto reachability_start = std::chrono::steady_clock::now();
     
     CUDD::BDD initial_state = arena_.initial_state_bdd();
@@ -423,10 +574,10 @@ WeakGameResult WeakGameSolver::Solve() const {
     
     // Compute reachable states via fixpoint using vector-compose (no explicit transition relation)
     // Reach = mu X. initial ∪ Post(X), where Post(X) is the image of X under the transition function
-    spdlog::debug("[WeakGameSolver] Computing reachability closure (fixpoint) using VectorCompose...");
+    SYFT_DEBUG_TRACE("[WeakGameSolver] Computing reachability closure (fixpoint) using VectorCompose...");
     auto closure_start = std::chrono::steady_clock::now();
 
-    auto transition_func = arena_.transition_function();
+    const auto &transition_func = arena_.transition_function();
     // transition_compose_vector maps this automaton's state vars -> next-state functions f_i(x,a)
     auto transition_compose_vector = var_mgr_->make_compose_vector(automaton_id, transition_func);
 
@@ -448,12 +599,12 @@ WeakGameResult WeakGameSolver::Solve() const {
     for (std::size_t i = 0; i < total_vars; ++i) primed_to_unprimed_compose[i] = mgr->bddVar(static_cast<int>(i));
     for (std::size_t i = 0; i < unprimed_vars.size(); ++i) {
         // Log coarse-grained progress (avoid printing individual variable indices).
-        spdlog::debug("[WeakGameSolver] Mapping primed vars progress: {} / {} bits", (i + 1), unprimed_vars.size());
+        SYFT_DEBUG_TRACE("[WeakGameSolver] Mapping primed vars progress: {} / {} bits", (i + 1), unprimed_vars.size());
         primed_to_unprimed_compose[primed_vars[i].NodeReadIndex()] = unprimed_vars[i];
     }
 
     CUDD::BDD reachable = initial_state;
-    spdlog::debug("[WeakGameSolver] Building explicit transition relation for forward reachability...");
+    SYFT_DEBUG_TRACE("[WeakGameSolver] Building explicit transition relation for forward reachability...");
     
     // Build explicit transition relation: trans(s₁,...,sₙ, s₁',...,sₙ') 
     // This means: ⋀ᵢ (sᵢ' ↔ transition_func[i](s,i,o))
@@ -466,14 +617,14 @@ WeakGameResult WeakGameSolver::Solve() const {
         CUDD::BDD equivalence = zprime.Xnor(eta);
         transition_relation &= equivalence;
     }
-    spdlog::debug("[WeakGameSolver] Transition relation built, starting fixpoint...");
+    SYFT_DEBUG_TRACE("[WeakGameSolver] Transition relation built, starting fixpoint...");
     
     CUDD::BDD unprimed_state_cube = var_mgr_->state_variables_cube(automaton_id);
     int closure_iterations = 0;
 
     while (true) {
         closure_iterations++;
-        spdlog::debug("[WeakGameSolver] Forward reachability iteration {}", closure_iterations);
+        SYFT_DEBUG_TRACE("[WeakGameSolver] Forward reachability iteration {}", closure_iterations);
         
         // Forward Post(X) = ∃s₁,...,sₙ. ∃I,O. (X(s₁,...,sₙ) ∧ trans(s₁,...,sₙ, s₁',...,sₙ'))
         CUDD::BDD post_primed = (reachable & transition_relation).ExistAbstract(unprimed_state_cube).ExistAbstract(io_cube);
@@ -488,11 +639,11 @@ WeakGameResult WeakGameSolver::Solve() const {
     
     auto closure_end = std::chrono::steady_clock::now();
     auto closure_duration = std::chrono::duration_cast<std::chrono::milliseconds>(closure_end - closure_start);
-    spdlog::debug("[WeakGameSolver] Reachability closure (explicit transition relation) completed in {} ms ({} iterations)", closure_duration.count(), closure_iterations);
-    spdlog::debug("[WeakGameSolver] Reachable states count: {}", reachable.CountMinterm(var_mgr_->state_variable_count(automaton_id)));
+    SYFT_DEBUG_TRACE("[WeakGameSolver] Reachability closure (explicit transition relation) completed in {} ms ({} iterations)", closure_duration.count(), closure_iterations);
+    SYFT_DEBUG_TRACE("[WeakGameSolver] Reachable states count: {}", reachable.CountMinterm(var_mgr_->state_variable_count(automaton_id)));
     auto reachability_end = std::chrono::steady_clock::now();
     auto reachability_duration = std::chrono::duration_cast<std::chrono::milliseconds>(reachability_end - reachability_start);
-    spdlog::debug("[WeakGameSolver] Total reachability computation: {} ms", reachability_duration.count());
+    SYFT_DEBUG_TRACE("[WeakGameSolver] Total reachability computation: {} ms", reachability_duration.count());
     
     //PrintStateSet("Reachable states from initial", reachable);
     */
@@ -500,52 +651,44 @@ WeakGameResult WeakGameSolver::Solve() const {
     spdlog::info("[WeakGameSolver] Starting SCC decomposition...");
     auto scc_start = std::chrono::steady_clock::now();
     
+    // Only the states reachable from the initial state matter for its verdict
+    CUDD::BDD universe = mgr->bddOne();
+    if (demand_driven_) {
+        universe = ReachableStates();
+        spdlog::info("[WeakGameSolver] Decomposing the {} states reachable from the initial state",
+                     universe.CountMinterm(var_mgr_->state_variable_count(automaton_id)));
+    }
+
+    // Peel all layers, top (source SCCs) first
     std::vector<CUDD::BDD> layers;
+    {
+        TraceScope trace("SCC decomposition", "game");
+        layers = decomposer_->PeelLayers(universe);
+        trace.arg("layers", static_cast<double>(layers.size()));
+    }
     std::vector<CUDD::BDD> layers_below;
-    CUDD::BDD remaining = mgr->bddOne(); // Start with all states
-    
-    int layer_idx = 0;
-    while (!remaining.IsZero()) {
+    CUDD::BDD remaining = universe; // Start with all states
+    for (const CUDD::BDD& layer_states : layers) {
         layers_below.push_back(remaining);  // States at this layer and below
-        
-        CUDD::BDD layer = decomposer_->PeelLayer(remaining);
-        
-        if (layer.IsZero()) {
-            if (debug_ && kVerboseSolver) {
-                spdlog::info("[WeakGameSolver] PeelLayer returned empty, breaking");
-            }
-            // States remaining here have no internal transitions - they only transition
-            // to already-peeled states. They will be handled via reachability/safety
-            // from the layers they can reach.
-            if (!remaining.IsZero()) {
-                CUDD::BDD io_cube = var_mgr_->input_cube() * var_mgr_->output_cube();
-                CUDD::BDD remaining_states = remaining.ExistAbstract(io_cube);
-                spdlog::error("[WeakGameSolver] Orphan states (not in any SCC, will be handled via reachability), count: {}", remaining_states.CountMinterm(var_mgr_->state_variable_count(automaton_id)));
-                //PrintStateSet("Orphan states (not in any SCC, will be handled via reachability)", remaining_states);
-            }
-            layers_below.pop_back();
-            break;
-        }
-        
-        // Ensure layer only depends on state variables (existentially quantify out I/O)
-        CUDD::BDD io_cube = var_mgr_->input_cube() * var_mgr_->output_cube();
-        CUDD::BDD layer_states = layer.ExistAbstract(io_cube);
-        
-        double layer_count = layer_states.CountMinterm(var_mgr_->state_variable_count(automaton_id));
-        //PrintStateSet("Peeled layer " + std::to_string(layer_idx), layer_states);
-        
-        layers.push_back(layer_states);
         remaining = (remaining & !layer_states);
-        //PrintStateSet("remaining after layer " + std::to_string(layer_idx), remaining);
-        layer_idx++;
+    }
+
+    if (!remaining.IsZero()) {
+        // States remaining here have no internal transitions - they only transition
+        // to already-peeled states. They will be handled via reachability/safety
+        // from the layers they can reach.
+        spdlog::error("[WeakGameSolver] Orphan states (not in any SCC, will be handled via reachability), count: {}", remaining.CountMinterm(var_mgr_->state_variable_count(automaton_id)));
+        //PrintStateSet("Orphan states (not in any SCC, will be handled via reachability)", remaining);
     }
     
     auto scc_end = std::chrono::steady_clock::now();
     auto scc_duration = std::chrono::duration_cast<std::chrono::milliseconds>(scc_end - scc_start);
-    spdlog::info("[WeakGameSolver] SCC decomposition completed in {} ms ({} layers)", scc_duration.count(), layers.size());
+    spdlog::info("[WeakGameSolver] SCC decomposition completed in {} ms ({} layers, {} symbolic steps)",
+                 scc_duration.count(), layers.size(), decomposer_->SymbolicSteps());
+    var_mgr_->record_size("scc_symbolic_steps", static_cast<double>(decomposer_->SymbolicSteps()));
     
     if (debug_ && kVerboseSolver) {
-        spdlog::debug("[WeakGameSolver] Total layers: {}", layers.size());
+        SYFT_DEBUG_TRACE("[WeakGameSolver] Total layers: {}", layers.size());
     }
         
     // Reverse layers so we process from bottom SCCs (terminal) to top (source)
@@ -557,18 +700,43 @@ WeakGameResult WeakGameSolver::Solve() const {
     CUDD::BDD accepting_states = accepting_states_;
     // Process each layer to compute winning states and moves
     for(int i = 0; i < layers.size(); i++) {
+        var_mgr_->check_budget("fixpoint");
+        TraceScope trace("SCC layer", "game");
 
         CUDD::BDD layer = layers[i];
+        trace.arg("layer", i).bdd("layer_nodes", layer);
         // Print layer info
         //PrintStateSet("Processing layer", layer);
         CUDD::BDD layer_below = layers_below[i];
-        
-        CUDD::BDD reach_good_states = SolveReachability(good_states, layer_below);
-        CUDD::BDD avoid_bad_states = SolveSafety(!bad_states, layer_below);
 
-        good_states |= layer & ((!accepting_states & reach_good_states) |
-		                             (accepting_states & avoid_bad_states));
+        // Independent SCCs of a wide layer are solved concurrently; this needs
+        // every state below the layer to be decided, so no orphans
+        std::vector<CUDD::BDD> components;
+        if (threads_ > 1 && remaining.IsZero() &&
+            layer.CountMinterm(var_mgr_->state_variable_count(automaton_id)) >= parallel_min_states_) {
+            components = SplitLayer(layer);
+        }
+
+        if (components.size() > 1) {
+            SYFT_DEBUG_TRACE("[WeakGameSolver] Solving {} SCCs of layer {} on {} threads",
+                             components.size(), i, std::min(threads_, components.size()));
+            good_states |= SolveComponents(components, good_states);
+        } else {
+            std::string node = "layer " + std::to_string(i);
+            CUDD::BDD reach_good_states = SolveReachability(good_states, layer_below, node);
+            CUDD::BDD avoid_bad_states = SolveSafety(!bad_states, layer_below, node);
+
+            good_states |= layer & ((!accepting_states & reach_good_states) |
+                                    (accepting_states & avoid_bad_states));
+        }
 		bad_states |= layer & !good_states;
+        trace.arg("components", static_cast<double>(std::max<std::size_t>(components.size(), 1)))
+             .bdd("good_nodes", good_states);
+
+        if (realizability_only_ && !(arena_.initial_state_bdd() & (good_states | bad_states)).IsZero()) {
+            spdlog::info("[WeakGameSolver] Initial state decided after {} of {} layers", i + 1, layers.size());
+            break;
+        }
 
         // Print good and bad states in this layer
         //PrintStateSet("Good states in current layer", good_states & layer);
@@ -580,13 +748,13 @@ WeakGameResult WeakGameSolver::Solve() const {
 
     if (debug_ && kVerboseSolver) {
         double final_good = good_states.CountMinterm(var_mgr_->state_variable_count(automaton_id));
-        spdlog::debug("[WeakGameSolver] Final winning states: {}", good_states);
+        SYFT_DEBUG_TRACE("[WeakGameSolver] Final winning states: {}", good_states);
     }
 
     CUDD::BDD initial = arena_.initial_state_bdd();
     bool initial_winning = !(initial & !good_states).IsZero() == false;
     if (debug_ && kVerboseSolver) {
-        spdlog::debug("[WeakGameSolver] Initial state is {}", (initial_winning ? "WINNING" : "LOSING"));
+        SYFT_DEBUG_TRACE("[WeakGameSolver] Initial state is {}", (initial_winning ? "WINNING" : "LOSING"));
     }
 
     return WeakGameResult{good_states, good_states};
@@ -598,5 +766,110 @@ bool WeakGameSolver::IsWinning() const {
     return !(initial & !result.winning_states).IsZero() == false;
 }
 
+void WeakGameSolver::SetRealizabilityOnly(bool realizability_only) {
+    realizability_only_ = realizability_only;
+}
+
+std::vector<CUDD::BDD> WeakGameSolver::SplitLayer(const CUDD::BDD& layer) const {
+    auto state_vars = var_mgr_->get_state_variables(arena_.automaton_id());
+    std::vector<CUDD::BDD> components;
+    CUDD::BDD rest = layer;
+    while (!rest.IsZero()) {
+        CUDD::BDD component = rest.PickOneMinterm(state_vars);
+        while (true) {
+            CUDD::BDD added = Predecessors(component) & layer & !component;
+            if (added.IsZero()) break;
+            component |= added;
+        }
+        components.push_back(component);
+        rest &= !component;
+    }
+    return components;
+}
+
+CUDD::BDD WeakGameSolver::SolveComponents(const std::vector<CUDD::BDD>& components,
+                                          const CUDD::BDD& good_states) const {
+    // Transfer every game on this thread: CUDD managers are not thread-safe
+    std::size_t total_variable_count = var_mgr_->total_variable_count();
+    auto state_vars = var_mgr_->get_state_variables(arena_.automaton_id());
+    const auto &transition_function = arena_.transition_function();
+    std::vector<ComponentGame> games(components.size());
+    for (std::size_t i = 0; i < components.size(); ++i) {
+        ComponentGame& game = games[i];
+        game.mgr = std::make_unique<CUDD::Cudd>(static_cast<unsigned int>(total_variable_count));
+        game.compose_vector.reserve(total_variable_count);
+        for (std::size_t v = 0; v < total_variable_count; ++v) {
+            game.compose_vector.push_back(game.mgr->bddVar(static_cast<int>(v)));
+        }
+        // Only the moves of the component's own states are ever evaluated
+        for (std::size_t b = 0; b < state_vars.size(); ++b) {
+            game.compose_vector[state_vars[b].NodeReadIndex()] =
+                transition_function[b].Restrict(components[i]).Transfer(*game.mgr);
+        }
+        game.input_cube = var_mgr_->input_cube().Transfer(*game.mgr);
+        game.output_cube = var_mgr_->output_cube().Transfer(*game.mgr);
+        game.component = components[i].Transfer(*game.mgr);
+        game.accepting = (accepting_states_ & components[i]).Transfer(*game.mgr);
+        game.good_below = good_states.Transfer(*game.mgr);
+    }
+
+    // The main manager is idle until the workers are joined, so they may read its budget
+    auto check_budget = [this]() { var_mgr_->check_budget("fixpoint"); };
+    std::vector<std::exception_ptr> errors(games.size());
+    std::atomic<std::size_t> next_job{0};
+    auto worker = [&]() {
+        for (std::size_t i = next_job++; i < games.size(); i = next_job++) {
+            try {
+                games[i].Solve(check_budget);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    std::size_t worker_count = std::min(threads_, games.size());
+    workers.reserve(worker_count);
+    for (std::size_t t = 0; t < worker_count; ++t) {
+        workers.emplace_back(worker);
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    CUDD::BDD good = var_mgr_->cudd_mgr()->bddZero();
+    for (const ComponentGame& game : games) {
+        good |= game.winning.Transfer(*var_mgr_->cudd_mgr());
+    }
+    return good;
+}
+
+void WeakGameSolver::SetDemandDriven(bool demand_driven) {
+    demand_driven_ = demand_driven;
+}
+
+void WeakGameSolver::SetThreads(std::size_t threads, double min_layer_states) {
+    threads_ = std::max<std::size_t>(threads, 1);
+    parallel_min_states_ = min_layer_states;
+}
+
+void WeakGameSolver::SetFixpointMode(FixpointMode mode) {
+    fixpoint_mode_ = mode;
+}
+
+void WeakGameSolver::SetSCCAlgorithm(SCCAlgorithm algorithm, const ChainOptions& chain) {
+    decomposer_ = SCCDecomposer::Create(algorithm, arena_, chain);
+}
+
+const FixpointTrace& WeakGameSolver::GetFixpointTrace() const {
+    return fixpoint_trace_;
+}
+
 } // namespace Syft
 
@@ -8,83 +8,180 @@
 #include <vector>
 #include <queue>
 #include <unordered_map>
+#include <utility>
 #include "debug.hpp"
 
 
-bool cmp_descending_count_true(const std::vector<bool>& a, const std::vector<bool>& b) {
-    return std::count(a.begin(), a.end(), true) > std::count(b.begin(), b.end(), true);
+bool cmp_descending_count_true(const Syft::ColorSet& a, const Syft::ColorSet& b) {
+    return a.count() > b.count();
 }
 
+CUDD::BDD ZielonkaTree::phi_to_bdd(CUDD::Cudd& mgr) const {
+    return phi.to_bdd([&](size_t color) { return mgr.bddVar(static_cast<int>(color)); }, mgr);
+}
+
+std::vector<Syft::ColorSet> ZielonkaTree::maximal_subsets(const Syft::ColorSet& label, bool winning,
+                                                          const CUDD::BDD& phi_bdd, CUDD::Cudd& mgr) {
+    // Proper subsets of the label whose winner differs from the node
+    CUDD::BDD candidates = winning ? !phi_bdd : phi_bdd;
+    CUDD::BDD full = mgr.bddOne();
+    for (size_t i = 0; i < label.size(); ++i) {
+        if (label[i]) {
+            full &= mgr.bddVar(static_cast<int>(i));
+        } else {
+            candidates &= !mgr.bddVar(static_cast<int>(i));
+        }
+    }
+    candidates &= !full;
+
+    std::vector<Syft::ColorSet> children;
+    while (!candidates.IsZero()) {
+        // Add every color that keeps a candidate superset: when no color can be
+        // added, no candidate strictly contains the set, which is thus a candidate
+        Syft::ColorSet child(label.size());
+        CUDD::BDD supersets = mgr.bddOne();
+        label.for_each([&](size_t i) {
+            CUDD::BDD extended = supersets & mgr.bddVar(static_cast<int>(i));
+            if (!(candidates & extended).IsZero()) {
+                supersets = extended;
+                child.set(i);
+            }
+        });
+        // Drop the child and all its subsets
+        CUDD::BDD subsets = mgr.bddOne();
+        for (size_t i = 0; i < label.size(); ++i) {
+            if (!child[i]) subsets &= !mgr.bddVar(static_cast<int>(i));
+        }
+        candidates &= !subsets;
+        children.push_back(std::move(child));
+    }
+    std::stable_sort(children.begin(), children.end(), cmp_descending_count_true);
+    return children;
+}
+
+ZielonkaNode* ZielonkaTree::add_node(ZielonkaNode node) {
+    auto [it, inserted] = dag_ids_.emplace(node.label, dag_children_.size());
+    if (inserted) {
+        dag_children_.emplace_back();
+        dag_expanded_.push_back(false);
+    }
+    node.dag_id = it->second;
+    total_nodes++;
+    nodes_.push_back(std::move(node));
+    return &nodes_.back();
+}
+
+void ZielonkaTree::release_winning_moves() {
+    for (ZielonkaNode& node : nodes_) {
+        std::vector<CUDD::BDD>().swap(node.winningmoves);
+        std::vector<std::unique_ptr<Syft::Transducer>>().swap(node.transducers);
+    }
+}
+
+void ZielonkaTree::expand(ZielonkaNode* current) {
+    // The children of a node only depend on its label, and so do their safe and
+    // target sets: they are computed once per DAG node and copied into every
+    // occurrence of the label. They are extracted from a BDD of the condition
+    // over the colors, so memory grows with the tree and not with the 2^k color sets
+    if (!dag_expanded_[current->dag_id]) {
+        const std::vector<Syft::ColorSet>* known = nullptr;
+        if (label_dag_) {
+            auto entry = label_dag_->find(current->label);
+            if (entry != label_dag_->end()) known = &entry->second;
+        }
+        std::vector<Syft::ColorSet> color_sets =
+            known ? *known : maximal_subsets(current->label, current->winning, phi_bdd_, *color_mgr_);
+        std::vector<DagChild> children;
+        for (Syft::ColorSet& color_set : color_sets) {
+            // The states of a removed color are the targets, and the others are safe
+            CUDD::BDD removed = ELHelpers::unionOf(ELHelpers::label_difference(current->label, color_set), colorBDDs_, var_mgr_);
+            children.push_back(DagChild{std::move(color_set), current->safenodes & !removed, current->safenodes & removed});
+        }
+        dag_children_[current->dag_id] = std::move(children);
+        dag_expanded_[current->dag_id] = true;
+    }
+    // Indexed, as adding nodes may add DAG nodes
+    for (size_t i = 0; i < dag_children_[current->dag_id].size(); ++i) {
+        const DagChild& dag_child = dag_children_[current->dag_id][i];
+        ZielonkaNode child {
+            .children = {},
+            .parent = current,
+            .parent_order = current->order,
+            .sibling_order = i,
+            .label = dag_child.label,
+            .winningmoves = {},
+            .safenodes = dag_child.safenodes,
+            .targetnodes = dag_child.targetnodes,
+            .level = current->level + 1,
+            .order = next_order_++,
+            .winning = !(current->winning),
+            .transducers = {}
+        };
+        current->children.push_back(add_node(std::move(child)));
+    }
+    current->expanded = true;
+    if (current->children.empty()) leaves++;
+}
 
+const std::vector<ZielonkaNode*>& ZielonkaTree::children(ZielonkaNode* node) {
+    if (!node->expanded) {
+        expand(node);
+    }
+    return node->children;
+}
 
-void ZielonkaTree::generate() {
+void ZielonkaTree::expand_subtree(ZielonkaNode* node) {
     if (DEBUG_MODE) {
-        std::cout << "generating... \n";
+        SYFT_DEBUG_TRACE("[ZielonkaTree] expanding from node {}", node->order);
     }
     std::queue<ZielonkaNode*> q;
-    q.push(root);
-    std::vector<std::vector<bool>> ps = ELHelpers::powerset(root->label.size());
-    std::sort(ps.begin(), ps.end(), cmp_descending_count_true);
-    size_t order = root->order + 1;
-    std::vector<std::vector<bool>> seen_from_parent{};
+    q.push(node);
     while (!q.empty()) {
-        seen_from_parent.clear();
         ZielonkaNode* current = q.front();
         q.pop();
-        total_nodes++;
-        for (size_t i = 0; i < ps.size(); ++i) {
-            std::vector<bool> color_set = ps[i];
-            if (!ELHelpers::proper_subset(color_set, current->label))
-                continue;
-            bool seen = false;
-            for (const auto& s : seen_from_parent) {
-                if (ELHelpers::proper_subset(color_set, s)) {
-                    seen = true;
-                    break;
-                }
-            }
-            if (seen) continue;
-            if (evaluate_phi(color_set) != current->winning) {
-                ZielonkaNode *child_zn = new ZielonkaNode {
-                    .children = {},
-                    .parent = current,
-                    .parent_order = current->order,
-                    .label = color_set,
-            	    .winningmoves = {},
-                    .safenodes = current->safenodes & ELHelpers::negIntersectionOf(ELHelpers::label_difference(current->label, color_set), colorBDDs_, var_mgr_),
-		            .targetnodes = current->safenodes & ELHelpers::unionOf(ELHelpers::label_difference(current->label, color_set), colorBDDs_, var_mgr_),
-                    .level = current->level + 1,
-                    .order = order++,
-                    .winning = !(current->winning),
-                    .transducers = {}
-                };
-                //child_zn->winningmoves.push_back(var_mgr_->cudd_mgr()->bddZero());
-                seen_from_parent.push_back(color_set);
-                current->children.push_back(child_zn);
-                //current->winningmoves.push_back(var_mgr_->cudd_mgr()->bddZero());
-                q.push(child_zn);
-            }
+        for (ZielonkaNode* child : children(current)) {
+            q.push(child);
         }
-        if (current->children.empty()) leaves++;
     }
-    //std::cout << "done generating...\n";
-    //TODO
-    // for every node, add another vector that stores its ancestor nodes
 }
+
+void ZielonkaTree::restrict_to(const CUDD::BDD& states) {
+    // Nodes with the same label share their sets, so each distinct set is
+    // conjoined once; the original is kept alive so that its node is not reused
+    std::unordered_map<DdNode*, std::pair<CUDD::BDD, CUDD::BDD>> restricted;
+    auto restrict_set = [&](CUDD::BDD& set) {
+        auto it = restricted.find(set.getNode());
+        if (it == restricted.end()) {
+            it = restricted.emplace(set.getNode(), std::make_pair(set, set & states)).first;
+        }
+        set = it->second.second;
+    };
+    for (ZielonkaNode& node : nodes_) {
+        restrict_set(node.safenodes);
+        restrict_set(node.targetnodes);
+    }
+    // The children already computed for DAG nodes are copied into the nodes expanded later
+    for (std::vector<DagChild>& dag_children : dag_children_) {
+        for (DagChild& dag_child : dag_children) {
+            restrict_set(dag_child.safenodes);
+            restrict_set(dag_child.targetnodes);
+        }
+    }
+}
+
 void ZielonkaTree::generate_parity() {
     // firstly evaluate root, then remove the last color from the current colorset
     //std::cout << "generating... \n";
     size_t order = root->order + 1;
-    std::vector<bool> colors;
-    for (const bool& b : root->label)
-        colors.push_back(b);
+    Syft::ColorSet colors = root->label;
     ZielonkaNode* current = root;
     for (int i = colors.size()-1; i >= 0; --i) {
-        colors[i] = false;
-        ZielonkaNode *child_zn = new ZielonkaNode {
+        colors.reset(i);
+        ZielonkaNode *child_zn = add_node(ZielonkaNode {
             .children = {},
             .parent = current,
             .parent_order = current->order,
+            .sibling_order = 0,
             .label = colors,
        	    .winningmoves = {},
             .safenodes = current->safenodes & ELHelpers::negIntersectionOf(ELHelpers::label_difference(current->label, colors), colorBDDs_, var_mgr_),
@@ -93,7 +190,7 @@ void ZielonkaTree::generate_parity() {
             .order = order++,
             .winning = !(current->winning),
             .transducers = {}
-        };
+        });
         current->children.push_back(child_zn);
         current = child_zn;
     }
@@ -109,34 +206,27 @@ void ZielonkaTree::generate_phi(const char* conditionFile){
         exit(1);
     }
 
-    phi = ELHelpers::infix2postfix(ELHelpers::tokenize(condition));
+    phi = Syft::ColorFormula(condition);
 }
 
-void ZielonkaTree::generate_phi_from_str(const std::string color_formula){
-//    std::ifstream ifs(conditionFile);
-//    std::string condition((std::istreambuf_iterator<char>(ifs)),
-//                          (std::istreambuf_iterator<char>()));
-
+Syft::ColorFormula ZielonkaTree::phi_from_str(const std::string color_formula){
     if (color_formula.empty()){
         std::cout << "Condition empty, exiting..." << std::endl;
         exit(1);
     }
 
-    phi = ELHelpers::infix2postfix(ELHelpers::tokenize(color_formula));
+    return Syft::ColorFormula(color_formula);
 }
 
-std::string label_to_string(std::vector<bool> label) {
+std::string label_to_string(const Syft::ColorSet& label) {
     std::string s;
-    for (size_t i = 0; i < label.size(); ++i) {
-        if (label[i])
-            s += static_cast<char>('a' + i);
-    }
+    label.for_each([&](size_t i) { s += static_cast<char>('a' + i); });
     if (s.empty()) return "∅";
     return s;
 }
 
-bool ZielonkaTree::evaluate_phi(std::vector<bool> colors) {
-    return ELHelpers::eval_postfix(phi, colors);
+bool ZielonkaTree::evaluate_phi(const Syft::ColorSet& colors) const {
+    return phi.evaluate(colors);
 }
 
 void ZielonkaTree::displayZielonkaTree() {
@@ -231,13 +321,20 @@ void ZielonkaTree::graphZielonkaTree() {
 }
 
 // Public
-ZielonkaTree::ZielonkaTree(const std::string color_formula, const std::vector<CUDD::BDD> &colorBDDs, std::shared_ptr<Syft::VarMgr> var_mgr) :  colorBDDs_(colorBDDs), var_mgr_(var_mgr){
-    generate_phi_from_str(color_formula);
-    std::vector<bool> label( colorBDDs.size()/2, true);
-    root = new ZielonkaNode {
+ZielonkaTree::ZielonkaTree(const std::string color_formula, const std::vector<CUDD::BDD> &colorBDDs, std::shared_ptr<Syft::VarMgr> var_mgr, bool lazy) :
+    ZielonkaTree(phi_from_str(color_formula), colorBDDs, std::move(var_mgr), lazy) {}
+
+ZielonkaTree::ZielonkaTree(Syft::ColorFormula color_formula, const std::vector<CUDD::BDD> &colorBDDs, std::shared_ptr<Syft::VarMgr> var_mgr, bool lazy,
+                           std::shared_ptr<const ZielonkaLabelDag> label_dag) :
+    phi(std::move(color_formula)), colorBDDs_(colorBDDs), var_mgr_(var_mgr), color_mgr_(std::make_unique<CUDD::Cudd>()),
+    label_dag_(std::move(label_dag)) {
+    phi_bdd_ = phi_to_bdd(*color_mgr_);
+    Syft::ColorSet label(colorBDDs.size(), true);
+    root = add_node(ZielonkaNode {
         .children  = {},
         .parent = nullptr,
         .parent_order = 0,
+        .sibling_order = 0,
         .label = label,
 	    .winningmoves = {},
 	    .safenodes = var_mgr_->cudd_mgr()->bddOne(),
@@ -246,14 +343,16 @@ ZielonkaTree::ZielonkaTree(const std::string color_formula, const std::vector<CU
         .order = 1,
         .winning = evaluate_phi(label),
         .transducers = {}
-    };
+    });
+    next_order_ = root->order + 1;
 //    this.colorBDDs = colorBDDs;
-    generate();
+    if (!lazy) {
+        expand_all();
+    }
     //generate_parity();
     //graphZielonkaTree();
     if (DEBUG_MODE) {
-        std::cout << "leaves: "<< leaves << '\n';
-        std::cout << "nodes: " << total_nodes  << '\n';
+        SYFT_DEBUG_TRACE("[ZielonkaTree] leaves: {} nodes: {} distinct subtrees: {}", leaves, total_nodes, dag_size());
     }
     //displayZielonkaTree();
     if (DEBUG_MODE) {
@@ -261,6 +360,28 @@ ZielonkaTree::ZielonkaTree(const std::string color_formula, const std::vector<CU
     }
 }
 
+std::shared_ptr<const ZielonkaLabelDag> ZielonkaTree::label_dag(const Syft::ColorFormula& phi, size_t color_count,
+                                                                size_t max_labels) {
+    CUDD::Cudd mgr;
+    CUDD::BDD phi_bdd = phi.to_bdd([&](size_t color) { return mgr.bddVar(static_cast<int>(color)); }, mgr);
+    auto dag = std::make_shared<ZielonkaLabelDag>();
+    std::queue<Syft::ColorSet> pending;
+    pending.push(Syft::ColorSet(color_count, true));
+    while (!pending.empty() && dag->size() < max_labels) {
+        Syft::ColorSet label = std::move(pending.front());
+        pending.pop();
+        if (dag->count(label) > 0) {
+            continue;
+        }
+        std::vector<Syft::ColorSet> children = maximal_subsets(label, phi.evaluate(label), phi_bdd, mgr);
+        for (const Syft::ColorSet& child : children) {
+            pending.push(child);
+        }
+        dag->emplace(std::move(label), std::move(children));
+    }
+    return dag;
+}
+
 ZielonkaNode* ZielonkaTree::get_root() { return root; }
 
 void ZielonkaTree::dump_dot(const std::string& path) const {
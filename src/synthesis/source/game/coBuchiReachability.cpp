@@ -18,29 +18,54 @@ namespace Syft {
         SynthesisResult result;
         CUDD::BDD winning_states = state_space_ & goal_states_;
         CUDD::BDD winning_moves = winning_states;
-        int c = 0;
-        int inner_c = 0;
+        std::size_t state_bits = var_mgr_->state_variable_count(spec_.automaton_id());
+        bool frontier_mode = fixpoint_mode_ == FixpointMode::Frontier;
+        fixpoint_trace_ = FixpointTrace();
+        outer_iterations_ = 0;
+
+        // Preimages shared across iterations: (W | goal) and (Y | goal) composed with the transition function
+        CUDD::BDD transitions_to_state_space_or_goal = (state_space_ | goal_states_).VectorCompose(transition_vector_);
+        CUDD::BDD transitions_to_winning_states_or_goal =
+                (winning_states | goal_states_).VectorCompose(transition_vector_);
 
         while (true) {
+            var_mgr_->check_budget("fixpoint");
+            outer_iterations_++;
             CUDD::BDD new_winning_states, new_winning_moves;
             // inner greatest fixpoint
             CUDD::BDD inner_winning_states = state_space_;
             CUDD::BDD inner_winning_moves = inner_winning_states;
+            CUDD::BDD transitions_to_inner_winning_states_or_goal = transitions_to_state_space_or_goal;
+            CUDD::BDD removed = !winning_states;
+            bool first_inner_iteration = true;
             while (true) {
+                var_mgr_->check_budget("fixpoint");
                 CUDD::BDD new_inner_winning_states, new_inner_winning_moves;
 
-                CUDD::BDD transitions_to_winning_states_or_goal =
-                        (winning_states | goal_states_).VectorCompose(transition_vector_);
-//                    var_mgr_->dump_dot(transitions_to_winning_states_or_goal.Add(), "transitions_to_winning_states_or_goal.dot");
-                CUDD::BDD transitions_to_inner_winning_states_or_goal =
-                        (inner_winning_states | goal_states_).VectorCompose(transition_vector_);
-//                    var_mgr_->dump_dot(transitions_to_inner_winning_states_or_goal.Add(), "transitions_to_inner_winning_states_or_goal.dot");
-//                    var_mgr_->dump_dot(assumption_.Add(), "assumption.dot");
+                // The inner fixpoint grows with W, so the states of W (other than goal
+                // states, which count as reached anyway) are never removed, and only
+                // predecessors of the last removed states can be removed
+                CUDD::BDD candidates = inner_winning_states;
+                if (frontier_mode) {
+                    candidates &= !winning_states;
+                    if (!first_inner_iteration) {
+                        candidates &= predecessors(removed);
+                    }
+                } else {
+                    transitions_to_inner_winning_states_or_goal =
+                            (inner_winning_states | goal_states_).VectorCompose(transition_vector_);
+                }
                 CUDD::BDD assumption_constrained_transitions =
                         ((coBuchi_ | transitions_to_winning_states_or_goal)) *
                         transitions_to_inner_winning_states_or_goal;
-//                    var_mgr_->dump_dot(assumption_constrained_transitions.Add(), "assumption_constrained_transitions.dot");
-                if (starting_player_ == Player::Agent) {
+                if (frontier_mode) {
+                    // The moves of the other states are those of the last iteration that examined them
+                    CUDD::BDD candidate_moves = quantify_independent_variables_->apply(
+                            candidates & assumption_constrained_transitions);
+                    new_inner_winning_moves = (inner_winning_moves & !candidates) | candidate_moves;
+                    new_inner_winning_states = inner_winning_states &
+                                               !(candidates & !project_into_states(candidate_moves));
+                } else if (starting_player_ == Player::Agent) {
                     // Quantify all variables that the outputs don't depend on
                     CUDD::BDD quantified_X_transitions_to_inner_winning_states = quantify_independent_variables_->apply(
                             assumption_constrained_transitions);
@@ -50,12 +75,12 @@ namespace Syft {
                 } else {
                     new_inner_winning_moves = inner_winning_moves & quantify_independent_variables_->apply(
                             assumption_constrained_transitions);
-//                        var_mgr_->dump_dot((quantify_independent_variables_->apply(assumption_constrained_transitions)).Add(), "quantified_assumption_constrained_transitions.dot");
                     new_inner_winning_states = project_into_states(
                             new_inner_winning_moves);
-//                        var_mgr_->dump_dot(new_inner_winning_states.Add(), "states.dot");
 
                 }
+                removed = inner_winning_states & !new_inner_winning_states;
+                fixpoint_trace_.record(removed, candidates, new_inner_winning_states, state_bits);
 
                 if (new_inner_winning_states == inner_winning_states) {
                     if (starting_player_ == Player::Agent) {
@@ -77,7 +102,12 @@ namespace Syft {
 
                 inner_winning_moves = new_inner_winning_moves;
                 inner_winning_states = new_inner_winning_states;
-                inner_c++;
+                if (frontier_mode) {
+                    // Y' | goal = (Y | goal) & !(removed & !goal), and composition distributes over both
+                    transitions_to_inner_winning_states_or_goal &=
+                            !((removed & !goal_states_).VectorCompose(transition_vector_));
+                }
+                first_inner_iteration = false;
             }
 
 
@@ -96,11 +126,21 @@ namespace Syft {
                 return result;
             }
 
+            // W | Y | goal = (W | goal) | (Y | goal)
+            if (frontier_mode) {
+                transitions_to_winning_states_or_goal |= transitions_to_inner_winning_states_or_goal;
+            } else {
+                transitions_to_winning_states_or_goal =
+                        (new_winning_states | goal_states_).VectorCompose(transition_vector_);
+            }
             winning_moves = new_winning_moves;
             winning_states = new_winning_states;
-            c++;
         }
 
     }
 
+    std::size_t coBuchiReachability::outer_iterations() const {
+        return outer_iterations_;
+    }
+
 }
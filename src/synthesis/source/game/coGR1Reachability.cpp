@@ -95,7 +95,7 @@ namespace Syft {
                 rename_map["(" + input_variable_label + ")"] = "(" + input_variable_new_label + ")";
             }
 
-            std::vector<CUDD::BDD> transition_function = arena.transition_function();
+            const std::vector<CUDD::BDD> &transition_function = arena.transition_function();
 
             std::unordered_map<std::string, std::string> rename_state_vars_map;
             for (size_t i = 0; i < transition_function.size(); i++) {
@@ -226,6 +226,91 @@ namespace Syft {
     }
 
     SynthesisResult coGR1Reachability::run() const {
+        if (slugs_dir_.empty()) {
+            return run_native();
+        }
+        return run_slugs();
+    }
+
+    CUDD::BDD coGR1Reachability::environment_pre(const CUDD::BDD &target) const {
+        // The state of target becomes the successor; its letter is the next letter
+        CUDD::BDD next = (target & state_space_).VectorCompose(
+                var_mgr_->make_compose_vector(arena_.automaton_id(), arena_.transition_function()));
+        return next.ExistAbstract(var_mgr_->input_cube()).UnivAbstract(var_mgr_->output_cube());
+    }
+
+    SynthesisResult coGR1Reachability::run_native() const {
+        Syft::Stopwatch gr1_game_stopwatch;
+        gr1_game_stopwatch.start();
+        std::cout << "* Start solving GR1 game natively...\n";
+
+        // Slugs reads missing justices as GF(true)
+        std::vector<CUDD::BDD> assumptions = gr1_.env_justices;
+        std::vector<CUDD::BDD> guarantees = gr1_.agn_justices;
+        if (assumptions.empty()) {
+            assumptions.push_back(var_mgr_->cudd_mgr()->bddOne());
+        }
+        if (guarantees.empty()) {
+            guarantees.push_back(var_mgr_->cudd_mgr()->bddOne());
+        }
+
+        // nu W. /\_j mu Y. \/_i nu X. (g_j & pre(W)) | pre(Y) | (!a_i & pre(X))
+        CUDD::BDD winning = state_space_;
+        std::size_t iterations = 0;
+        while (true) {
+            var_mgr_->check_budget("GR(1) fixpoint");
+            CUDD::BDD next_winning = state_space_;
+            CUDD::BDD pre_winning = environment_pre(winning);
+            for (const CUDD::BDD &guarantee: guarantees) {
+                CUDD::BDD reach = var_mgr_->cudd_mgr()->bddZero();
+                while (true) {
+                    CUDD::BDD progress = ((guarantee & pre_winning) | environment_pre(reach)) & state_space_;
+                    CUDD::BDD next_reach = progress;
+                    for (const CUDD::BDD &assumption: assumptions) {
+                        CUDD::BDD stay = state_space_;
+                        while (true) {
+                            ++iterations;
+                            CUDD::BDD next_stay = progress | (!assumption & environment_pre(stay) & state_space_);
+                            if (next_stay == stay) {
+                                break;
+                            }
+                            stay = next_stay;
+                        }
+                        next_reach |= stay;
+                    }
+                    if (next_reach == reach) {
+                        break;
+                    }
+                    reach = next_reach;
+                }
+                next_winning &= reach;
+            }
+            if (next_winning == winning) {
+                break;
+            }
+            winning = next_winning;
+        }
+
+        // As in Slugs, the agent picks the first outputs, then the environment the inputs
+        CUDD::BDD environment_wins = (winning & initial_condition_)
+                .ExistAbstract(var_mgr_->input_cube() * var_mgr_->state_variables_cube(arena_.automaton_id()))
+                .UnivAbstract(var_mgr_->output_cube());
+
+        auto gr1_game_time = gr1_game_stopwatch.stop();
+        std::cout << "* Finish solving GR1 game natively in " << iterations << " iterations, took time: "
+                  << gr1_game_time.count() << " ms" << std::endl;
+
+        SynthesisResult result;
+        if (environment_wins.IsOne()) {
+            result.realizability = false;
+        } else {
+            result.realizability = true;
+            result.safe_states = state_space_;
+        }
+        return result;
+    }
+
+    SynthesisResult coGR1Reachability::run_slugs() const {
         std::string to_slugs_parser = benchmark_name_ + ".parser";
         print_variables(to_slugs_parser);
         print_initial_conditions(initial_condition_, to_slugs_parser);
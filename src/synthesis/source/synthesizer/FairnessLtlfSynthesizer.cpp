@@ -25,7 +25,23 @@ namespace Syft {
     SynthesisResult FairnessLtlfSynthesizer::run() const {
         coBuchiReachability solver(spec_, starting_player_, protagonist_player_,
                                    goal_states_, !assumption_, state_space_);
-        return solver.run();
+        solver.set_fixpoint_mode(fixpoint_mode_);
+        SynthesisResult result = solver.run();
+        fixpoint_trace_ = solver.fixpoint_trace();
+        outer_iterations_ = solver.outer_iterations();
+        return result;
+    }
+
+    void FairnessLtlfSynthesizer::set_fixpoint_mode(FixpointMode mode) {
+        fixpoint_mode_ = mode;
+    }
+
+    const FixpointTrace &FairnessLtlfSynthesizer::fixpoint_trace() const {
+        return fixpoint_trace_;
+    }
+
+    std::size_t FairnessLtlfSynthesizer::outer_iterations() const {
+        return outer_iterations_;
     }
 
     CUDD::BDD FairnessLtlfSynthesizer::load_CNF(const std::string &filename) const {
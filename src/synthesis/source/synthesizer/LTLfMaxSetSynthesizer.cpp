@@ -6,6 +6,7 @@
 #include "game/DfaGameSynthesizer.h"
 
 #include <cassert>
+#include <memory>
 
 namespace Syft {
 
@@ -23,15 +24,27 @@ namespace Syft {
 
 
     MaxSetSynthesisResult LTLfMaxSetSynthesizer::run() const {
-        ReachabilityMaxSet solver(spec_, starting_player_, protagonist_player_,
-                                  goal_states_, state_space_);
-        return solver.run_maxset();
+        auto solver = std::make_shared<ReachabilityMaxSet>(spec_, starting_player_, protagonist_player_,
+                                                           goal_states_, state_space_);
+        MaxSetSynthesisResult maxset = solver->run_maxset();
+        // The strategies are derived through the solver, so they keep it alive
+        maxset.deferring_strategy = [solver, strategy = std::move(maxset.deferring_strategy)]() {
+            return strategy();
+        };
+        maxset.nondeferring_strategy = [solver, strategy = std::move(maxset.nondeferring_strategy)]() {
+            return strategy();
+        };
+        return maxset;
     }
 
-    void LTLfMaxSetSynthesizer::dump_dot(MaxSetSynthesisResult maxset, const std::string &def_filename,
+    void LTLfMaxSetSynthesizer::dump_dot(const MaxSetSynthesisResult &maxset, const std::string &def_filename,
                                          const std::string &nondef_filename) const {
-        var_mgr_->dump_dot(maxset.deferring_strategy.Add(), def_filename);
-        var_mgr_->dump_dot(maxset.nondeferring_strategy.Add(), nondef_filename);
+        if (!def_filename.empty()) {
+            var_mgr_->dump_dot(maxset.deferring_strategy().Add(), def_filename);
+        }
+        if (!nondef_filename.empty()) {
+            var_mgr_->dump_dot(maxset.nondeferring_strategy().Add(), nondef_filename);
+        }
     }
 
 
@@ -0,0 +1,95 @@
+#include "synthesizer/LTLfPlusSession.h"
+
+#include <algorithm>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+#include "automata/ProductArena.h"
+#include "SpecDecomposition.h"
+#include "synthesizer/LTLfPlusSynthesizer.h"
+
+namespace Syft {
+
+  LTLfPlusSession::LTLfPlusSession(InputOutputPartition partition, Player starting_player,
+                                   Player protagonist_player, VarMgrOptions var_mgr_options,
+                                   DfaConstructionOptions dfa_options)
+    : LTLfPlusSession(InterfaceLayout(std::move(partition)), starting_player, protagonist_player,
+                      std::move(var_mgr_options), std::move(dfa_options)) {
+  }
+
+  LTLfPlusSession::LTLfPlusSession(const InterfaceLayout &layout, Player starting_player,
+                                   Player protagonist_player, VarMgrOptions var_mgr_options,
+                                   DfaConstructionOptions dfa_options)
+    : var_mgr_(layout.instantiate(var_mgr_options)), starting_player_(starting_player),
+      protagonist_player_(protagonist_player), dfa_options_(std::move(dfa_options)),
+      builder_(var_mgr_, dfa_options_) {
+  }
+
+  ELSynthesisResult LTLfPlusSession::solve(const LTLfPlus &formula) {
+    // Only the DFAs of subformulas new to the session are built
+    ColorArenas color_arenas = builder_.build_symbolic(formula, ColorAutomatonBuilder::emerson_lei_transform);
+    var_mgr_->end_phase("DFA construction");
+    std::set<std::string> conjuncts = top_conjuncts(formula);
+    std::vector<std::size_t> automaton_ids;
+    for (const SymbolicStateDfa &component : color_arenas.components) {
+      automaton_ids.push_back(component.automaton_id());
+    }
+
+    CUDD::BDD instant_winning = var_mgr_->cudd_mgr()->bddZero();
+    CUDD::BDD instant_losing = var_mgr_->cudd_mgr()->bddZero();
+    last_reuse_ = Reuse::None;
+    if (previous_) {
+      bool weaker = std::includes(previous_->conjuncts.begin(), previous_->conjuncts.end(),
+                                  conjuncts.begin(), conjuncts.end());
+      bool stronger = std::includes(conjuncts.begin(), conjuncts.end(),
+                                    previous_->conjuncts.begin(), previous_->conjuncts.end());
+      bool exact = !dfa_options_.realizability_only && !dfa_options_.anytime;
+      if (weaker && stronger) {
+        last_reuse_ = Reuse::Verdict;
+        spdlog::info("[LTLfPlusSession::solve] same conjuncts as the previous spec, reusing its result");
+        return previous_->result;
+      } else if (weaker && exact) {
+        // A state winning with the removed conjuncts wins without them, whatever the state of their DFAs
+        CUDD::BDD removed_cube = var_mgr_->cudd_mgr()->bddOne();
+        for (std::size_t automaton_id : previous_->automaton_ids) {
+          if (std::find(automaton_ids.begin(), automaton_ids.end(), automaton_id) == automaton_ids.end()) {
+            removed_cube &= var_mgr_->state_variables_cube(automaton_id);
+          }
+        }
+        instant_winning = previous_->result.winning_states.ExistAbstract(removed_cube);
+        last_reuse_ = Reuse::WinningStates;
+      } else if (stronger && exact) {
+        // A state losing without the added conjuncts loses with them
+        instant_losing = previous_->state_space & !previous_->result.winning_states;
+        last_reuse_ = Reuse::LosingStates;
+      }
+    }
+    spdlog::info("[LTLfPlusSession::solve] {} conjuncts, warm start: {}", conjuncts.size(),
+                 last_reuse_ == Reuse::WinningStates ? "winning states"
+                 : last_reuse_ == Reuse::LosingStates ? "losing states" : "none");
+
+    ProductArena arena(color_arenas.components);
+    CUDD::BDD state_space = var_mgr_->cudd_mgr()->bddOne();
+    if (dfa_options_.reachable_states_only || dfa_options_.care_simplification != StrategyMinimization::Off) {
+      state_space = arena.reachable_states();
+      if (dfa_options_.care_simplification == StrategyMinimization::Off) {
+        arena.simplify_transitions(state_space);
+      } else {
+        arena.simplify_on_care(state_space, color_arenas.goal_states, dfa_options_.care_simplification);
+      }
+    }
+    var_mgr_->end_phase("arena product");
+    var_mgr_->record_size("arena_state_bits",
+                          static_cast<double>(var_mgr_->state_variable_count(arena.automaton_id())));
+
+    auto solver = std::make_shared<EmersonLei>(arena, formula.color_formula_, starting_player_, protagonist_player_,
+                                               color_arenas.goal_states, state_space, instant_winning & state_space,
+                                               instant_losing, false);
+    LTLfPlusSynthesizer::configure_solver(*solver, dfa_options_);
+    ELSynthesisResult result = solver->run_EL();
+    previous_ = Solved{std::move(conjuncts), std::move(automaton_ids), state_space, result, solver};
+    return result;
+  }
+
+}
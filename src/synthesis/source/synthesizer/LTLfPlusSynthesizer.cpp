@@ -8,141 +8,530 @@
 #include "lydia/logic/pnf.hpp"
 #include "lydia/parser/ltlfplus/driver.hpp"
 #include "lydia/utils/print.hpp"
+#include "game/Reachability.hpp"
+#include "game/Safety.hpp"
 #include "game/WeakGameSolver.h"
+#include "automata/ColorAutomatonBuilder.h"
+#include "SolveCheckpoint.h"
+#include "Trace.h"
+#include "strategy.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <future>
+#include <optional>
+#include <set>
+#include <tuple>
+#include <thread>
+#include <utility>
 
 namespace Syft {
   LTLfPlusSynthesizer::LTLfPlusSynthesizer(LTLfPlus ltlf_plus_formula,
                                            InputOutputPartition partition, Player starting_player,
-                                           Player protagonist_player)
+                                           Player protagonist_player, VarMgrOptions var_mgr_options,
+                                           DfaConstructionOptions dfa_options)
+    : LTLfPlusSynthesizer(std::move(ltlf_plus_formula), InterfaceLayout(std::move(partition)), starting_player,
+                          protagonist_player, std::move(var_mgr_options), std::move(dfa_options)) {
+  }
+
+  LTLfPlusSynthesizer::LTLfPlusSynthesizer(LTLfPlus ltlf_plus_formula,
+                                           InterfaceLayout layout, Player starting_player,
+                                           Player protagonist_player, VarMgrOptions var_mgr_options,
+                                           DfaConstructionOptions dfa_options)
     : ltlf_plus_formula_(ltlf_plus_formula),
       color_formula_(ltlf_plus_formula.color_formula_), starting_player_(starting_player),
-      protagonist_player_(protagonist_player) {
-    std::shared_ptr<VarMgr> var_mgr = std::make_shared<VarMgr>();
-    var_mgr->create_named_variables(partition.input_variables);
-    var_mgr->create_named_variables(partition.output_variables);
+      protagonist_player_(protagonist_player), dfa_options_(dfa_options), layout_(std::move(layout)),
+      var_mgr_options_(var_mgr_options) {
+    var_mgr_ = layout_.instantiate(var_mgr_options,
+                                   layout_.variable_order(ltlf_plus_formula, var_mgr_options.proposition_order));
+  }
 
-    var_mgr->partition_variables(partition.input_variables,
-                                 partition.output_variables);
-    var_mgr_ = var_mgr;
+  namespace {
+    ELSynthesisResult el_result(const SynthesisResult &solved) {
+      ELSynthesisResult result;
+      result.realizability = solved.realizability;
+      result.winning_states = solved.winning_states;
+      result.z_tree = nullptr;
+      return result;
+    }
   }
 
-  // TODO create a run
-  ELSynthesisResult LTLfPlusSynthesizer::run() const {
-    std::vector<SymbolicStateDfa> vec_spec;
-    std::vector<CUDD::BDD> goal_states;
-    // ensures that the "order" of colors is respected
-    std::map<int, SymbolicStateDfa> color_to_dfa;
-    std::map<int, CUDD::BDD> color_to_final_states;
-
-    for (const auto &[ltlf_plus_arg, prefix_quantifier]: ltlf_plus_formula_.formula_to_quantification_) {
-      whitemech::lydia::ltlf_ptr ltlf_arg = ltlf_plus_arg->ltlf_arg();
-      ExplicitStateDfa explicit_dfa = ExplicitStateDfa::dfa_of_formula(*ltlf_arg);
-
-      // std::cout << "LTLf formula: " << whitemech::lydia::to_string(*ltlf_arg) << std::endl;
-      // std::cout << "------ original DFA: \n";
-      // explicit_dfa.dfa_print();
-
-      switch (prefix_quantifier) {
-        case whitemech::lydia::PrefixQuantifier::ForallExists: {
-          ExplicitStateDfaAdd explicit_dfa_add = ExplicitStateDfaAdd::from_dfa_mona(var_mgr_,
-            explicit_dfa);
-          SymbolicStateDfa symbolic_dfa = SymbolicStateDfa::from_explicit(
-            std::move(explicit_dfa_add));
-
-          color_to_dfa.insert({std::stoi(ltlf_plus_formula_.formula_to_color_.at(ltlf_plus_arg)), symbolic_dfa});
-          color_to_final_states.insert({
-            std::stoi(ltlf_plus_formula_.formula_to_color_.at(ltlf_plus_arg)), symbolic_dfa.final_states()
-          });
-          // vec_spec.push_back(symbolic_dfa);
-          // goal_states.push_back(symbolic_dfa.final_states());
-          break;
-        }
-        case whitemech::lydia::PrefixQuantifier::ExistsForall: {
-          ExplicitStateDfaAdd explicit_dfa_add = ExplicitStateDfaAdd::from_dfa_mona(var_mgr_,
-            explicit_dfa);
-          SymbolicStateDfa symbolic_dfa = SymbolicStateDfa::from_explicit(
-            std::move(explicit_dfa_add));
-
-          color_to_dfa.insert({std::stoi(ltlf_plus_formula_.formula_to_color_.at(ltlf_plus_arg)), symbolic_dfa});
-          color_to_final_states.insert({
-            std::stoi(ltlf_plus_formula_.formula_to_color_.at(ltlf_plus_arg)), !symbolic_dfa.final_states()
-          });
-          // vec_spec.push_back(symbolic_dfa);
-          // goal_states.push_back(!symbolic_dfa.final_states());
-          break;
-        }
-        case whitemech::lydia::PrefixQuantifier::Forall: {
-          ExplicitStateDfa trimmed_explicit_dfa = ExplicitStateDfa::dfa_to_Gdfa(explicit_dfa);
-          // new MP: add a new line of dfa_remove_initial_self_loops
-
-          // std::cout << "------ trimmed DFA Gphi: \n";
-          // trimmed_explicit_dfa.dfa_print();
-
-          ExplicitStateDfaAdd explicit_dfa_add = ExplicitStateDfaAdd::from_dfa_mona(var_mgr_,
-            trimmed_explicit_dfa);
-          SymbolicStateDfa symbolic_dfa = SymbolicStateDfa::from_explicit(
-            std::move(explicit_dfa_add));
-
-          color_to_dfa.insert({std::stoi(ltlf_plus_formula_.formula_to_color_.at(ltlf_plus_arg)), symbolic_dfa});
-          color_to_final_states.insert({
-            std::stoi(ltlf_plus_formula_.formula_to_color_.at(ltlf_plus_arg)), symbolic_dfa.final_states()
-          });
-          // vec_spec.push_back(symbolic_dfa);
-          // goal_states.push_back(symbolic_dfa.final_states());
-          break;
-        }
-        case whitemech::lydia::PrefixQuantifier::Exists: {
-          std::vector<size_t> final_states = explicit_dfa.get_final();
-
-          // new MP: as it is  
-          ExplicitStateDfa trimmed_explicit_dfa = ExplicitStateDfa::dfa_to_Fdfa(explicit_dfa);
-          // std::cout << "------ trimmed DFA Fphi: \n";
-          // trimmed_explicit_dfa.dfa_print();
-
-          ExplicitStateDfaAdd explicit_dfa_add = ExplicitStateDfaAdd::from_dfa_mona(var_mgr_,
-            trimmed_explicit_dfa);
-          SymbolicStateDfa symbolic_dfa = SymbolicStateDfa::from_explicit(
-            std::move(explicit_dfa_add));
-
-          color_to_dfa.insert({std::stoi(ltlf_plus_formula_.formula_to_color_.at(ltlf_plus_arg)), symbolic_dfa});
-          color_to_final_states.insert({
-            std::stoi(ltlf_plus_formula_.formula_to_color_.at(ltlf_plus_arg)), symbolic_dfa.final_states()
-          });
-          // vec_spec.push_back(symbolic_dfa);
-          // goal_states.push_back(symbolic_dfa.final_states());
-          break;
-        }
-        default:
-          throw std::runtime_error("Invalid argument in map LTLf+ formula to prefix quantification");
-      }
+  namespace {
+    // Labels past which the rest of the Zielonka tree is left to the solver
+    constexpr std::size_t pipelined_zielonka_labels = 10000;
+
+    double elapsed_ms(std::chrono::steady_clock::time_point start) {
+      return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
     }
+  }
 
-    for (const auto &[color, dfa]: color_to_dfa) {
-      vec_spec.push_back(color_to_dfa.at(color));
-      goal_states.push_back(color_to_final_states.at(color));
+  LTLfPlusSynthesizer::GameArena LTLfPlusSynthesizer::build_product() const {
+    auto dfa_start = std::chrono::steady_clock::now();
+    // The labels only need the color formula, so they are computed while the DFAs are built
+    std::future<std::pair<std::shared_ptr<const ZielonkaLabelDag>, double>> zielonka_labels;
+    if (dfa_options_.pipeline_stages && !dfa_options_.symbolic_colors && !dfa_options_.scc_layers) {
+      std::size_t color_count = 0;
+      for (const auto &[ltlf_plus_arg, color] : ltlf_plus_formula_.formula_to_color_) {
+        color_count = std::max(color_count, static_cast<std::size_t>(std::stoi(color)) + 1);
+      }
+      zielonka_labels = std::async(std::launch::async, [formula = color_formula_, color_count]() {
+        TraceScope trace("Zielonka labels", "game");
+        auto start = std::chrono::steady_clock::now();
+        std::shared_ptr<const ZielonkaLabelDag> labels =
+            ZielonkaTree::label_dag(ColorFormula(formula), color_count, pipelined_zielonka_labels);
+        trace.arg("labels", static_cast<double>(labels->size()));
+        return std::make_pair(labels, elapsed_ms(start));
+      });
     }
 
-    std::size_t n_colors = goal_states.size();
-    for (auto i = 0; i < n_colors; i++) {
-      goal_states.push_back(!goal_states[i]);
+    ColorArenas color_arenas;
+    {
+      // Scoped, as the builder keeps its symbolic DFAs for later builds
+      ColorAutomatonBuilder builder(var_mgr_, dfa_options_);
+      color_arenas = builder.build_symbolic(ltlf_plus_formula_, ColorAutomatonBuilder::emerson_lei_transform);
     }
 
-    // for (auto j = 0; j < vec_spec.size(); j++) {
-    //   vec_spec[j].dump_dot("dfa" + std::to_string(j) + ".dot");
+    // for (auto j = 0; j < color_arenas.components.size(); j++) {
+    //   color_arenas.components[j].dump_dot("dfa" + std::to_string(j) + ".dot");
     // }
 
-    SymbolicStateDfa arena = SymbolicStateDfa::product_AND(vec_spec);
+    var_mgr_->end_phase("DFA construction");
+    // The product stays unmaterialized: the colors are the components' final states. Moved, so that
+    // simplify_transitions leaves no unsimplified copy of the components alive
+    ProductArena arena(std::move(color_arenas.components));
+    CUDD::BDD state_space = var_mgr_->cudd_mgr()->bddOne();
+    if (dfa_options_.reachable_states_only || dfa_options_.care_simplification != StrategyMinimization::Off) {
+      state_space = arena.reachable_states();
+      if (dfa_options_.care_simplification == StrategyMinimization::Off) {
+        arena.simplify_transitions(state_space);
+      } else {
+        arena.simplify_on_care(state_space, color_arenas.goal_states, dfa_options_.care_simplification);
+      }
+    }
+    var_mgr_->end_phase("arena product");
+    var_mgr_->record_size("arena_state_bits",
+                          static_cast<double>(var_mgr_->state_variable_count(arena.automaton_id())));
     // arena.dump_dot("arena.dot");
     
     // Add info log
     spdlog::info("[LTLfPlusSynthesizer::run] created game arena ");
-    std::shared_ptr<EmersonLei> emerson_lei = std::make_shared<EmersonLei>(arena, color_formula_, starting_player_, protagonist_player_,
-                      goal_states, var_mgr_->cudd_mgr()->bddOne(), var_mgr_->cudd_mgr()->bddZero(), var_mgr_->cudd_mgr()->bddZero(), false);
+    GameArena game{std::move(arena), state_space, std::move(color_arenas.goal_states), color_formula_, nullptr};
+    if (zielonka_labels.valid()) {
+      double dfa_ms = elapsed_ms(dfa_start);
+      TraceScope trace("pipeline", "synthesis");
+      auto wait_start = std::chrono::steady_clock::now();
+      double labels_ms = 0;
+      std::tie(game.zielonka_labels, labels_ms) = zielonka_labels.get();
+      double waited_ms = elapsed_ms(wait_start);
+      const char *critical_path = labels_ms > dfa_ms ? "Zielonka labels" : "color DFAs";
+      trace.arg("dfa_ms", dfa_ms).arg("zielonka_labels_ms", labels_ms).arg("waited_ms", waited_ms)
+          .arg("critical_path", std::string(critical_path));
+      spdlog::info("[LTLfPlusSynthesizer::run] computed {} Zielonka labels during DFA construction "
+                   "({:.1f} ms vs {:.1f} ms, waited {:.1f} ms): critical path {}",
+                   game.zielonka_labels->size(), labels_ms, dfa_ms, waited_ms, critical_path);
+    }
+    return game;
+  }
+
+  LTLfPlusSynthesizer::GameArena LTLfPlusSynthesizer::build_arena() const {
+    GameArena game = build_product();
+    if (dfa_options_.horizon_precheck > 0) {
+      if ((STRATEGY && !dfa_options_.realizability_only) || dfa_options_.symbolic_strategy) {
+        spdlog::warn("[LTLfPlusSynthesizer::run] the horizon pre-check is skipped when a strategy is extracted");
+      } else if ((game.horizon_winning = win_within_horizon(game))) {
+        return game;
+      }
+    }
+    if (dfa_options_.safety_first) {
+      std::tie(game.state_space, game.color_formula) =
+          restrict_to_safety_conjuncts(game.arena, game.goal_states, game.state_space, starting_player_);
+    }
+    return game;
+  }
+
+  namespace {
+    // The states whose colors satisfy the condition whatever other colors are seen later
+    CUDD::BDD settled_states(const std::string &color_formula, const std::vector<CUDD::BDD> &goal_states,
+                             const CUDD::Cudd &mgr) {
+      ColorFormula phi(color_formula);
+      if (phi.color_count() > goal_states.size()) {
+        return mgr.bddZero();
+      }
+      CUDD::Cudd color_mgr;
+      CUDD::BDD settled = phi.to_bdd([&](std::size_t color) { return color_mgr.bddVar(static_cast<int>(color)); },
+                                     color_mgr);
+      for (std::size_t color = 0; color < phi.color_count(); ++color) {
+        // Unseen, the color may still turn out to be seen infinitely often
+        CUDD::BDD seen = color_mgr.bddVar(static_cast<int>(color));
+        settled = settled.Cofactor(seen) & (seen | settled.Cofactor(!seen));
+      }
+      return ColorFormula::from_bdd(settled, [](int index) { return static_cast<std::size_t>(index); })
+          .to_bdd([&](std::size_t color) { return goal_states[color]; }, mgr);
+    }
+  }
+
+  std::optional<CUDD::BDD> LTLfPlusSynthesizer::win_within_horizon(const GameArena &game) const {
+    TraceScope trace("horizon pre-check", "game");
+    CUDD::BDD settled = settled_states(game.color_formula, game.goal_states, *var_mgr_->cudd_mgr());
+    Safety safety(game.arena, starting_player_, protagonist_player_, settled, game.state_space);
+    safety.set_realizability_only(true);
+    CUDD::BDD settled_region = safety.run().winning_states;
+
+    Reachability reachability(game.arena, starting_player_, protagonist_player_, settled_region, game.state_space);
+    reachability.set_realizability_only(true);
+    reachability.set_horizon(dfa_options_.horizon_precheck);
+    SynthesisResult reached = reachability.run();
+    var_mgr_->end_phase("horizon pre-check");
+    trace.arg("steps", static_cast<double>(dfa_options_.horizon_precheck))
+        .arg("realizable", reached.realizability ? 1.0 : 0.0)
+        .bdd("settled_region", settled_region);
+    spdlog::info("[LTLfPlusSynthesizer::run] horizon pre-check of {} steps: {}", dfa_options_.horizon_precheck,
+                 reached.realizability ? "realizable" : "inconclusive");
+    if (!reached.realizability) {
+      return std::nullopt;
+    }
+    return reached.winning_states;
+  }
+
+  std::pair<CUDD::BDD, std::string> LTLfPlusSynthesizer::restrict_to_safety_conjuncts(
+      const ProductArena &arena, const std::vector<CUDD::BDD> &goal_states, const CUDD::BDD &state_space,
+      Player starting_player) const {
+    std::set<int> forall_colors;
+    for (const auto &[ltlf_plus_arg, quantifier] : ltlf_plus_formula_.formula_to_quantification_) {
+      if (quantifier == whitemech::lydia::PrefixQuantifier::Forall) {
+        forall_colors.insert(std::stoi(ltlf_plus_formula_.formula_to_color_.at(ltlf_plus_arg)));
+      }
+    }
+    CUDD::BDD safe_states = var_mgr_->cudd_mgr()->bddOne();
+    std::size_t restricting = 0;
+    std::set<int> dropped;
+    for (int color : top_conjunct_colors(color_formula_)) {
+      if (forall_colors.count(color) == 0 || static_cast<std::size_t>(color) >= goal_states.size()) {
+        continue;
+      }
+      // The G-DFA of a Forall color (see dfa_to_Gdfa) only leaves its goal states in its initial state and
+      // its sink, so its Inf holds iff the play never reaches the sink nor stays in the initial state forever
+      for (std::size_t i = 0; i < arena.components().size(); ++i) {
+        if (arena.final_states(i) != goal_states[color]) {
+          continue;
+        }
+        CUDD::BDD initial = arena.components()[i].initial_state_bdd();
+        safe_states &= goal_states[color] | initial;
+        restricting++;
+        // Without a loop on the initial state, every play avoiding the sink visits the goal states infinitely often
+        if ((arena.preimage(initial) & initial).IsZero()) {
+          dropped.insert(color);
+        }
+        break;
+      }
+    }
+    if (restricting == 0) {
+      return {state_space, color_formula_};
+    }
+
+    // Every winning play stays in the safe region, so the game can be solved inside it
+    Safety safety(arena, starting_player, protagonist_player_, safe_states, state_space);
+    safety.set_realizability_only(true);
+    CUDD::BDD safe_region = state_space & safe_states & safety.run().winning_states;
+    std::string residual = drop_top_conjuncts(color_formula_, dropped);
+    var_mgr_->end_phase("safety conjuncts");
+    spdlog::info("[LTLfPlusSynthesizer::run] restricted the arena to the safe region of {} Forall conjuncts, "
+                 "solving {}", restricting, residual);
+    return {safe_region, residual};
+  }
+
+  std::shared_ptr<EmersonLei> LTLfPlusSynthesizer::build_game(const GameArena &game, Player starting_player,
+                                                          std::shared_ptr<const SolveCheckpoint> checkpoint) const {
+    CUDD::BDD instant_winning = var_mgr_->cudd_mgr()->bddZero();
+    CUDD::BDD instant_losing = var_mgr_->cudd_mgr()->bddZero();
+    if (checkpoint) {
+      // Sound bounds of the interrupted solve, which the game then only has to close
+      if (std::optional<PartialSynthesisResult> bounds = checkpoint->load_root()) {
+        instant_winning = bounds->winning;
+        instant_losing = bounds->losing;
+        spdlog::info("[LTLfPlusSynthesizer::run] resuming from root bounds: winning nodes={} losing nodes={}",
+                     instant_winning.nodeCount(), instant_losing.nodeCount());
+      }
+    }
+    std::shared_ptr<ZielonkaTree> z_tree;
+    if (game.zielonka_labels && game.color_formula == color_formula_) {
+      TraceScope trace("Zielonka tree", "game");
+      z_tree = std::make_shared<ZielonkaTree>(ColorFormula(game.color_formula), game.goal_states, var_mgr_, true,
+                                              game.zielonka_labels);
+      z_tree->restrict_to(game.state_space);
+      trace.arg("colors", static_cast<double>(game.goal_states.size())).arg("distinct_subtrees", z_tree->dag_size());
+      var_mgr_->end_phase("Zielonka tree");
+    }
+    std::shared_ptr<EmersonLei> emerson_lei = std::make_shared<EmersonLei>(game.arena, game.color_formula, starting_player, protagonist_player_,
+                      game.goal_states, game.state_space, instant_winning, instant_losing, false, z_tree);
         spdlog::info("[LTLfPlusSynthesizer::run] created el solver ");
+    configure_solver(*emerson_lei, dfa_options_);
+    if (checkpoint) {
+      emerson_lei->set_root_progress([checkpoint, instant_winning, instant_losing](const PartialSynthesisResult &partial) {
+        checkpoint->store_root(PartialSynthesisResult{partial.winning | instant_winning, partial.losing | instant_losing});
+      });
+    }
+    return emerson_lei;
+  }
 
-    emerson_lei_ = emerson_lei;
+  std::shared_ptr<SolveCheckpoint> LTLfPlusSynthesizer::attach_checkpoint(const GameArena &game) const {
+    if (dfa_options_.checkpoint_directory.empty()) {
+      return nullptr;
+    }
+    if ((STRATEGY && !dfa_options_.realizability_only) || dfa_options_.symbolic_strategy || dfa_options_.parity_solver) {
+      spdlog::warn("[LTLfPlusSynthesizer::run] no checkpoint is kept when a strategy is extracted or for the parity solver");
+      return nullptr;
+    }
+    auto checkpoint = std::make_shared<SolveCheckpoint>(dfa_options_.checkpoint_directory, var_mgr_,
+                                                        std::chrono::seconds(dfa_options_.checkpoint_interval));
+    SymbolicStateDfa view = game.arena.symbolic_view();
+    checkpoint->attach("emerson-lei " + game.color_formula, view, game.goal_states, game.state_space,
+                       dfa_options_.resume);
+    return checkpoint;
+  }
+
+  std::function<ELSynthesisResult()> LTLfPlusSynthesizer::build_solve() const {
+    GameArena game = build_arena();
+    if (game.horizon_winning) {
+      ELSynthesisResult result;
+      result.realizability = true;
+      result.winning_states = *game.horizon_winning;
+      result.z_tree = nullptr;
+      return [result]() { return result; };
+    }
+    if (!dfa_options_.symbolic_colors && !dfa_options_.scc_layers) {
+      if (dfa_options_.split_disjuncts) {
+        std::vector<std::string> disjuncts = top_disjuncts(color_formula_);
+        if ((STRATEGY && !dfa_options_.realizability_only) || dfa_options_.symbolic_strategy) {
+          spdlog::warn("[LTLfPlusSynthesizer::run] the disjuncts are not split when a strategy is extracted");
+        } else if (dfa_options_.parity_solver) {
+          spdlog::warn("[LTLfPlusSynthesizer::run] the disjuncts are not split for the parity solver");
+        } else if (disjuncts.size() > 1) {
+          return build_disjunct_solve(std::move(game), disjuncts);
+        }
+      }
+      emerson_lei_ = build_game(game, starting_player_, attach_checkpoint(game));
+      return [game = emerson_lei_]() { return game->run_EL(); };
+    }
+    if (dfa_options_.symbolic_strategy) {
+      spdlog::warn("[LTLfPlusSynthesizer::run] the {} solver extracts no strategy",
+                   dfa_options_.symbolic_colors ? "symbolic-color" : "SCC-layer");
+    }
+    std::shared_ptr<DfaGameSynthesizer> solver = build_color_game(game, starting_player_);
+    return [solver]() { return el_result(solver->run()); };
+  }
+
+  std::shared_ptr<DfaGameSynthesizer> LTLfPlusSynthesizer::build_color_game(const GameArena &game,
+                                                                            Player starting_player) const {
+    std::shared_ptr<DfaGameSynthesizer> solver;
+    if (dfa_options_.symbolic_colors) {
+      solver = std::make_shared<SymbolicEmersonLei>(game.arena, ColorFormula(game.color_formula), starting_player,
+                                                    protagonist_player_, game.goal_states, game.state_space);
+    } else {
+      solver = std::make_shared<LayeredEmersonLei>(game.arena, ColorFormula(game.color_formula), starting_player,
+                                                   protagonist_player_, game.goal_states, game.state_space);
+    }
+    solver->set_realizability_only(dfa_options_.realizability_only);
+    return solver;
+  }
+
+  std::function<ELSynthesisResult()> LTLfPlusSynthesizer::build_disjunct_solve(
+      GameArena arena, const std::vector<std::string> &disjuncts) const {
+    auto game = std::make_shared<GameArena>(std::move(arena));
+    CUDD::BDD zero = var_mgr_->cudd_mgr()->bddZero();
+    std::vector<std::shared_ptr<EmersonLei>> disjunct_games;
+    for (const std::string &disjunct : disjuncts) {
+      // Given the goal states of every color, of which the tree of the disjunct only reads its own
+      disjunct_games.push_back(std::make_shared<EmersonLei>(game->arena, disjunct, starting_player_, protagonist_player_,
+                                                            game->goal_states, game->state_space, zero, zero, false));
+    }
+    spdlog::info("[LTLfPlusSynthesizer::run] created el solvers of {} disjuncts", disjunct_games.size());
+    return [this, game, disjunct_games]() mutable {
+      std::vector<const EmersonLei*> solvers;
+      for (const std::shared_ptr<EmersonLei> &disjunct_game : disjunct_games) {
+        solvers.push_back(disjunct_game.get());
+      }
+      // Winning for one disjunct is winning for the whole condition
+      CUDD::BDD winning_disjuncts = var_mgr_->cudd_mgr()->bddZero();
+      for (const CUDD::BDD &winning : EmersonLei::SolveInParallel(solvers, dfa_options_.el_threads)) {
+        winning_disjuncts |= winning;
+      }
+      solvers.clear();
+      disjunct_games.clear();
+      var_mgr_->end_phase("disjunct games");
+
+      if (!(winning_disjuncts & game->arena.initial_state_bdd()).IsZero()) {
+        spdlog::info("[LTLfPlusSynthesizer::run] a disjunct is won from the initial state");
+        ELSynthesisResult result;
+        result.realizability = true;
+        result.winning_states = winning_disjuncts;
+        result.z_tree = nullptr;
+        return result;
+      }
+      spdlog::info("[LTLfPlusSynthesizer::run] no disjunct is won from the initial state, solving the whole condition");
+      emerson_lei_ = std::make_shared<EmersonLei>(game->arena, game->color_formula, starting_player_, protagonist_player_,
+                                                  game->goal_states, game->state_space, winning_disjuncts,
+                                                  var_mgr_->cudd_mgr()->bddZero(), false);
+      configure_solver(*emerson_lei_, dfa_options_);
+      return emerson_lei_->run_EL();
+    };
+  }
+
+  void LTLfPlusSynthesizer::configure_solver(EmersonLei &solver, const DfaConstructionOptions &options) {
+    solver.set_realizability_only(options.realizability_only);
+    solver.set_threads(options.el_threads);
+    solver.set_child_order(options.el_child_order);
+    solver.set_warm_start(options.el_warm_start);
+    solver.set_symbolic_strategy(options.symbolic_strategy);
+    solver.set_strategy_minimization(options.strategy_minimization);
+    solver.set_release_winning_moves(true);
+    solver.set_auto_dispatch(options.el_auto_dispatch);
+    solver.set_force_parity(options.parity_solver);
+    if (options.anytime) {
+      solver.set_anytime([](const PartialSynthesisResult &partial) {
+        spdlog::info("[LTLfPlusSynthesizer::run] anytime: winning states nodes={} losing states nodes={}",
+                     partial.winning.nodeCount(), partial.losing.nodeCount());
+      });
+    }
+  }
+
+  ELSynthesisResult LTLfPlusSynthesizer::run_components(const SpecDecomposition &decomposition) const {
+    std::size_t count = decomposition.components.size();
+    spdlog::info("[LTLfPlusSynthesizer::run] solving {} independent components", count);
+    components_.clear();
+    std::vector<std::function<ELSynthesisResult()>> games;
+    for (const LTLfPlus &component : decomposition.components) {
+      DfaConstructionOptions options = dfa_options_;
+      options.decompose_components = false;
+      if (!options.checkpoint_directory.empty()) {
+        // One checkpoint per game, so the components do not clear each other's
+        options.checkpoint_directory += "/component-" + std::to_string(components_.size());
+      }
+      auto synthesizer = std::make_shared<LTLfPlusSynthesizer>(component, layout_, starting_player_,
+                                                               protagonist_player_, var_mgr_options_, options);
+      // Built here rather than on the workers, as lydia and MONA keep global state
+      games.push_back(synthesizer->build_solve());
+      components_.push_back(synthesizer);
+    }
+
+    // Each game has its own manager, so the workers share no BDDs
+    std::vector<ELSynthesisResult> results(count);
+    std::vector<std::exception_ptr> errors(count);
+    std::atomic<std::size_t> next_component{0};
+    auto worker = [&]() {
+      for (std::size_t i = next_component++; i < count; i = next_component++) {
+        try {
+          results[i] = games[i]();
+        } catch (...) {
+          errors[i] = std::current_exception();
+        }
+      }
+    };
+    std::vector<std::thread> workers;
+    std::size_t worker_count = std::max<std::size_t>(1, std::min(dfa_options_.component_threads, count));
+    for (std::size_t t = 1; t < worker_count; ++t) {
+      workers.emplace_back(worker);
+    }
+    worker();
+    for (std::thread &thread : workers) {
+      thread.join();
+    }
+    for (const std::exception_ptr &error : errors) {
+      if (error) {
+        std::rethrow_exception(error);
+      }
+    }
+
+    ELSynthesisResult result;
+    result.realizability = decomposition.conjunction;
+    for (std::size_t i = 0; i < count; ++i) {
+      spdlog::info("[LTLfPlusSynthesizer::run] component {}: {}", i,
+                   results[i].realizability ? "realizable" : "unrealizable");
+      if (results[i].realizability != decomposition.conjunction) {
+        result.realizability = results[i].realizability;
+      }
+    }
+    // Each winning component fixes its own protagonist variables
+    for (const ELSynthesisResult &component : results) {
+      if (component.realizability) {
+        result.output_function.insert(result.output_function.end(), component.output_function.begin(),
+                                      component.output_function.end());
+        if (!decomposition.conjunction) {
+          break;
+        }
+      }
+    }
+    result.winning_states = result.realizability ? var_mgr_->cudd_mgr()->bddOne() : var_mgr_->cudd_mgr()->bddZero();
+    result.z_tree = nullptr;
+    return result;
+  }
+
+  std::pair<ELSynthesisResult, ELSynthesisResult> LTLfPlusSynthesizer::run_both_orders() const {
+    components_.clear();
+    if (dfa_options_.decompose_components && !dfa_options_.symbolic_strategy) {
+      SpecDecomposition decomposition = decompose_spec(ltlf_plus_formula_, layout_.partition(), protagonist_player_);
+      if (decomposition.components.size() > 1) {
+        // Each component decides both verdicts as in run_components, one component at a time
+        std::pair<ELSynthesisResult, ELSynthesisResult> results;
+        for (ELSynthesisResult *result : {&results.first, &results.second}) {
+          result->realizability = decomposition.conjunction;
+          result->z_tree = nullptr;
+        }
+        for (const LTLfPlus &component : decomposition.components) {
+          DfaConstructionOptions options = dfa_options_;
+          options.decompose_components = false;
+          LTLfPlusSynthesizer synthesizer(component, layout_, starting_player_, protagonist_player_,
+                                          var_mgr_options_, options);
+          std::pair<ELSynthesisResult, ELSynthesisResult> component_results = synthesizer.run_both_orders();
+          if (component_results.first.realizability != decomposition.conjunction) {
+            results.first.realizability = component_results.first.realizability;
+          }
+          if (component_results.second.realizability != decomposition.conjunction) {
+            results.second.realizability = component_results.second.realizability;
+          }
+        }
+        for (ELSynthesisResult *result : {&results.first, &results.second}) {
+          result->winning_states = result->realizability ? var_mgr_->cudd_mgr()->bddOne()
+                                                         : var_mgr_->cudd_mgr()->bddZero();
+        }
+        return results;
+      }
+    }
+
+    // Only the safety pre-pass and the fixpoints depend on the order of play
+    GameArena product = build_product();
+    std::pair<ELSynthesisResult, ELSynthesisResult> results;
+    for (Player starting_player : {Player::Agent, Player::Environment}) {
+      GameArena game = product;
+      if (dfa_options_.safety_first) {
+        std::tie(game.state_space, game.color_formula) =
+            restrict_to_safety_conjuncts(game.arena, game.goal_states, game.state_space, starting_player);
+      }
+      ELSynthesisResult result = dfa_options_.symbolic_colors || dfa_options_.scc_layers
+          ? el_result(build_color_game(game, starting_player)->run())
+          : build_game(game, starting_player)->run_EL();
+      bool agent_first = starting_player == Player::Agent;
+      var_mgr_->end_phase(agent_first ? "agent-first game" : "environment-first game");
+      spdlog::info("[LTLfPlusSynthesizer::run_both_orders] {} first: {}", agent_first ? "agent" : "environment",
+                   result.realizability ? "realizable" : "unrealizable");
+      (agent_first ? results.first : results.second) = std::move(result);
+    }
+    return results;
+  }
+
+  ELSynthesisResult LTLfPlusSynthesizer::run() const {
+    components_.clear();
+    if (dfa_options_.decompose_components && !dfa_options_.symbolic_strategy) {
+      SpecDecomposition decomposition = decompose_spec(ltlf_plus_formula_, layout_.partition(), protagonist_player_);
+      if (decomposition.components.size() > 1) {
+        return run_components(decomposition);
+      }
+    }
+    std::function<ELSynthesisResult()> solve = build_solve();
             spdlog::info("[LTLfPlusSynthesizer::run] starting el solver ");
-    return emerson_lei_->run_EL();
+    return solve();
   }
 
   // EmersonLei::OneStepSynReturn LTLfPlusSynthesizer::synthesize(std::string X, ELSynthesisResult result) const {
@@ -3,21 +3,37 @@
 //
 
 #include "synthesizer/LTLfPlusSynthesizerMP.h"
+#include "automata/ColorAutomatonBuilder.h"
+#include "SolveCheckpoint.h"
+#include "SpecDecomposition.h"
 #include "game/MannaPnueli.hpp"
+#include "game/Safety.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <set>
+#include <utility>
+
+#include <spdlog/spdlog.h>
 
 namespace Syft {
   LTLfPlusSynthesizerMP::LTLfPlusSynthesizerMP(LTLfPlus ltlf_plus_formula,
                                                InputOutputPartition partition, Player starting_player,
-                                               Player protagonist_player, int game_solver)
-    : ltlf_plus_formula_(ltlf_plus_formula), starting_player_(starting_player),
-      protagonist_player_(protagonist_player), game_solver_(game_solver) {
-    std::shared_ptr<VarMgr> var_mgr = std::make_shared<VarMgr>();
-    var_mgr->create_named_variables(partition.input_variables);
-    var_mgr->create_named_variables(partition.output_variables);
+                                               Player protagonist_player, int game_solver,
+                                               VarMgrOptions var_mgr_options, DfaConstructionOptions dfa_options)
+    : LTLfPlusSynthesizerMP(std::move(ltlf_plus_formula), InterfaceLayout(std::move(partition)), starting_player,
+                            protagonist_player, game_solver, std::move(var_mgr_options), std::move(dfa_options)) {
+  }
 
-    var_mgr->partition_variables(partition.input_variables,
-                                 partition.output_variables);
-    var_mgr_ = var_mgr;
+  LTLfPlusSynthesizerMP::LTLfPlusSynthesizerMP(LTLfPlus ltlf_plus_formula,
+                                               InterfaceLayout layout, Player starting_player,
+                                               Player protagonist_player, int game_solver,
+                                               VarMgrOptions var_mgr_options, DfaConstructionOptions dfa_options)
+    : ltlf_plus_formula_(ltlf_plus_formula), starting_player_(starting_player),
+      protagonist_player_(protagonist_player), game_solver_(game_solver), dfa_options_(dfa_options) {
+    var_mgr_ = layout.instantiate(var_mgr_options,
+                                  layout.variable_order(ltlf_plus_formula, var_mgr_options.proposition_order));
     for (const auto &[ltlf_plus_arg, prefix_quantifier]: ltlf_plus_formula_.formula_to_quantification_) {
       switch (prefix_quantifier) {
         case whitemech::lydia::PrefixQuantifier::ForallExists: {
@@ -48,110 +64,96 @@ namespace Syft {
 
 
   MPSynthesisResult LTLfPlusSynthesizerMP::run() const {
-    std::vector<SymbolicStateDfa> vec_spec;
-    std::vector<CUDD::BDD> goal_states;
-    // ensures that the "order" of colors is respected
-    std::map<int, SymbolicStateDfa> color_to_dfa;
-    std::map<int, CUDD::BDD> color_to_final_states;
-
-    for (const auto &[ltlf_plus_arg, prefix_quantifier]: ltlf_plus_formula_.formula_to_quantification_) {
-      whitemech::lydia::ltlf_ptr ltlf_arg = ltlf_plus_arg->ltlf_arg();
-      ExplicitStateDfa explicit_dfa = ExplicitStateDfa::dfa_of_formula(*ltlf_arg);
-
-      // std::cout << "LTLf formula: " << whitemech::lydia::to_string(*ltlf_arg) << std::endl;
-      // std::cout << "------ original DFA: \n";
-      // explicit_dfa.dfa_print();
-
-      switch (prefix_quantifier) {
-        case whitemech::lydia::PrefixQuantifier::ForallExists: {
-          ExplicitStateDfaAdd explicit_dfa_add = ExplicitStateDfaAdd::from_dfa_mona(var_mgr_,
-            explicit_dfa);
-          SymbolicStateDfa symbolic_dfa = SymbolicStateDfa::from_explicit(
-            std::move(explicit_dfa_add));
-
-          color_to_dfa.insert({std::stoi(ltlf_plus_formula_.formula_to_color_.at(ltlf_plus_arg)), symbolic_dfa});
-          color_to_final_states.insert({
-            std::stoi(ltlf_plus_formula_.formula_to_color_.at(ltlf_plus_arg)), symbolic_dfa.final_states()
+    int game_solver = game_solver_;
+    ColorArenas color_arenas;
+    {
+      // Scoped, as the builder keeps its symbolic DFAs for later builds
+      ColorAutomatonBuilder builder(var_mgr_, dfa_options_);
+      color_arenas = builder.build_symbolic(
+          ltlf_plus_formula_, [game_solver](whitemech::lydia::PrefixQuantifier quantifier) {
+            return ColorAutomatonBuilder::manna_pnueli_transform(quantifier, game_solver);
           });
-          // vec_spec.push_back(symbolic_dfa);
-          // goal_states.push_back(symbolic_dfa.final_states());
-          break;
-        }
-        case whitemech::lydia::PrefixQuantifier::ExistsForall: {
-          ExplicitStateDfaAdd explicit_dfa_add = ExplicitStateDfaAdd::from_dfa_mona(var_mgr_,
-            explicit_dfa);
-          SymbolicStateDfa symbolic_dfa = SymbolicStateDfa::from_explicit(
-            std::move(explicit_dfa_add));
+    }
+    std::vector<CUDD::BDD> &goal_states = color_arenas.goal_states;
 
-          color_to_dfa.insert({std::stoi(ltlf_plus_formula_.formula_to_color_.at(ltlf_plus_arg)), symbolic_dfa});
-          color_to_final_states.insert({
-            std::stoi(ltlf_plus_formula_.formula_to_color_.at(ltlf_plus_arg)), !symbolic_dfa.final_states()
-          });
-          // vec_spec.push_back(symbolic_dfa);
-          // goal_states.push_back(!symbolic_dfa.final_states());
-          break;
-        }
-        case whitemech::lydia::PrefixQuantifier::Forall: {
-          ExplicitStateDfa dfa_input = (game_solver_ == 1) ? explicit_dfa : ExplicitStateDfa::dfa_to_Gdfa(explicit_dfa);
-          ExplicitStateDfa explicit_dfa_remove_initial_loops = ExplicitStateDfa::dfa_remove_initial_self_loops(dfa_input);
-          
-          // ExplicitStateDfa explicit_dfa_remove_initial_loops = ExplicitStateDfa::dfa_remove_initial_self_loops(explicit_dfa);
-          // explicit_dfa_remove_initial_loops.dfa_print();
-          ExplicitStateDfaAdd explicit_dfa_add = ExplicitStateDfaAdd::from_dfa_mona(var_mgr_,
-            explicit_dfa_remove_initial_loops);
-          // explicit_dfa_add.dump_dot("dfa_add.dot");
-          SymbolicStateDfa symbolic_dfa = SymbolicStateDfa::from_explicit(
-            std::move(explicit_dfa_add));
+    // for (auto j = 0; j < color_arenas.components.size(); j++) {
+    //   color_arenas.components[j].dump_dot("dfa" + std::to_string(j) + ".dot");
+    // }
 
-          color_to_dfa.insert({std::stoi(ltlf_plus_formula_.formula_to_color_.at(ltlf_plus_arg)), symbolic_dfa});
-          CUDD::BDD final_states = symbolic_dfa.final_states();
-          color_to_final_states.insert({
-            std::stoi(ltlf_plus_formula_.formula_to_color_.at(ltlf_plus_arg)), final_states
-          });
-          // vec_spec.push_back(symbolic_dfa);
-          // goal_states.push_back(symbolic_dfa.final_states());
-          break;
-        }
-        case whitemech::lydia::PrefixQuantifier::Exists: {
-          ExplicitStateDfa dfa_input = (game_solver_ == 1) ? explicit_dfa : ExplicitStateDfa::dfa_to_Fdfa(explicit_dfa);
-        
-          ExplicitStateDfaAdd explicit_dfa_add = ExplicitStateDfaAdd::from_dfa_mona(var_mgr_,
-            dfa_input);
-          SymbolicStateDfa symbolic_dfa = SymbolicStateDfa::from_explicit(
-            std::move(explicit_dfa_add));
+    var_mgr_->end_phase("DFA construction");
+    // The product stays unmaterialized: the colors are the components' final states. Moved, so that
+    // simplify_transitions leaves no unsimplified copy of the components alive
+    ProductArena arena(std::move(color_arenas.components));
+    CUDD::BDD state_space = var_mgr_->cudd_mgr()->bddOne();
+    if (dfa_options_.reachable_states_only || dfa_options_.care_simplification != StrategyMinimization::Off) {
+      state_space = arena.reachable_states();
+      if (dfa_options_.care_simplification == StrategyMinimization::Off) {
+        arena.simplify_transitions(state_space);
+      } else {
+        arena.simplify_on_care(state_space, goal_states, dfa_options_.care_simplification);
+      }
+    }
+    var_mgr_->end_phase("arena product");
+    var_mgr_->record_size("arena_state_bits",
+                          static_cast<double>(var_mgr_->state_variable_count(arena.automaton_id())));
+    // arena.dump_dot("arena.dot");
 
-          color_to_dfa.insert({std::stoi(ltlf_plus_formula_.formula_to_color_.at(ltlf_plus_arg)), symbolic_dfa});
-          color_to_final_states.insert({
-            std::stoi(ltlf_plus_formula_.formula_to_color_.at(ltlf_plus_arg)), symbolic_dfa.final_states()
-          });
-          // vec_spec.push_back(symbolic_dfa);
-          // goal_states.push_back(symbolic_dfa.final_states());
+    std::string color_formula = ltlf_plus_formula_.color_formula_;
+    std::vector<int> G_colors = G_colors_;
+    if (dfa_options_.safety_first) {
+      CUDD::BDD safe_states = var_mgr_->cudd_mgr()->bddOne();
+      std::size_t restricting = 0;
+      std::set<int> dropped;
+      for (int color : top_conjunct_colors(color_formula)) {
+        if (std::find(G_colors_.begin(), G_colors_.end(), color) == G_colors_.end() ||
+            static_cast<std::size_t>(color) >= goal_states.size()) {
+          continue;
+        }
+        // A G color holds iff every state after the initial one, which has no self-loop, is a goal state
+        for (std::size_t i = 0; i < arena.components().size(); ++i) {
+          if (arena.final_states(i) != goal_states[color]) {
+            continue;
+          }
+          CUDD::BDD initial = arena.components()[i].initial_state_bdd();
+          safe_states &= goal_states[color] | initial;
+          restricting++;
+          if ((initial & !goal_states[color]).IsZero()) {
+            dropped.insert(color);
+          }
           break;
         }
-        default:
-          throw std::runtime_error("Invalid argument in map LTLf+ formula to prefix quantification");
+      }
+      if (restricting > 0) {
+        Safety safety(arena, starting_player_, protagonist_player_, safe_states, state_space);
+        safety.set_realizability_only(true);
+        state_space &= safe_states & safety.run().winning_states;
+        color_formula = drop_top_conjuncts(color_formula, dropped);
+        G_colors.erase(std::remove_if(G_colors.begin(), G_colors.end(),
+                                      [&dropped](int color) { return dropped.count(color) > 0; }),
+                       G_colors.end());
+        var_mgr_->end_phase("safety conjuncts");
+        spdlog::info("[LTLfPlusSynthesizerMP::run] restricted the arena to the safe region of {} G colors, "
+                     "solving {}", restricting, color_formula);
       }
     }
-
-    for (const auto &[color, dfa]: color_to_dfa) {
-      vec_spec.push_back(color_to_dfa.at(color));
-      goal_states.push_back(color_to_final_states.at(color));
+    MannaPnueli solver(arena, color_formula, F_colors_, G_colors, starting_player_,
+                       protagonist_player_,
+                       goal_states, state_space, game_solver_);
+    solver.set_threads(dfa_options_.mp_threads);
+    solver.set_work_directory(dfa_options_.mp_work_directory);
+    solver.set_prune_nodes(dfa_options_.mp_prune_nodes);
+    if (!dfa_options_.checkpoint_directory.empty()) {
+      solver.set_checkpoint(std::make_shared<SolveCheckpoint>(dfa_options_.checkpoint_directory, var_mgr_,
+                                                              std::chrono::seconds(dfa_options_.checkpoint_interval)),
+                            dfa_options_.resume);
     }
-
-    std::size_t n_colors = goal_states.size();
-    for (auto i = 0; i < n_colors; i++) {
-      goal_states.push_back(!goal_states[i]);
+    solver.set_symbolic_strategy(dfa_options_.symbolic_strategy);
+    if (dfa_options_.anytime) {
+      solver.set_anytime([](const PartialSynthesisResult &partial) {
+        spdlog::info("[LTLfPlusSynthesizerMP::run] anytime: winning states nodes={} losing states nodes={}",
+                     partial.winning.nodeCount(), partial.losing.nodeCount());
+      });
     }
-
-    // for (auto j = 0; j < vec_spec.size(); j++) {
-    //   vec_spec[j].dump_dot("dfa" + std::to_string(j) + ".dot");
-    // }
-
-    SymbolicStateDfa arena = SymbolicStateDfa::product_AND(vec_spec);
-    // arena.dump_dot("arena.dot");
-    MannaPnueli solver(arena, ltlf_plus_formula_.color_formula_, F_colors_, G_colors_, starting_player_,
-                       protagonist_player_,
-                       goal_states, var_mgr_->cudd_mgr()->bddOne(), game_solver_);
     return solver.run_MP();
   }
 }
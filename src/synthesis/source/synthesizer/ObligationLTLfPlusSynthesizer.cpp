@@ -1,9 +1,15 @@
 // ObligationLTLfPlusSynthesizer.cpp
 #include "synthesizer/ObligationLTLfPlusSynthesizer.h"
+#include "automata/ColorAutomatonBuilder.h"
 #include "automata/ExplicitStateDfa.h"
-#include "automata/ExplicitStateDfaAdd.h"
+#include "automata/SymmetryQuotient.h"
+#include "game/ColorFormula.h"
+#include "game/ELHelpers.hh"
+#include "game/Reachability.hpp"
+#include "game/Safety.hpp"
 #include "game/BuchiSolver.hpp"   // standalone Buchi solver (uses arena.final_states())
 #include "game/WeakGameSolver.h"
+#include "Trace.h"
 #include "lydia/logic/ltlfplus/base.hpp"
 #include "lydia/logic/pnf.hpp"
 #include "lydia/utils/print.hpp"
@@ -21,6 +27,9 @@
 #include <utility>
 #include <functional>
 #include <cmath>
+#include <iterator>
+#include <memory>
+#include <set>
 #include <boost/multiprecision/cpp_int.hpp>
 
 namespace {
@@ -68,6 +77,23 @@ namespace Syft {
         return dfa;
     }
 
+    // Safety arguments become G(phi) and guarantee arguments F(phi), minimised when that saves state bits
+    static QuantifierTransform obligation_transform(whitemech::lydia::PrefixQuantifier quantifier) {
+        switch (quantifier) {
+            case whitemech::lydia::PrefixQuantifier::Forall:
+                return {"dfa_to_Gdfa_obligation+minimize_if_fewer_bits", [](ExplicitStateDfa dfa) {
+                    return minimize_if_fewer_bits(ExplicitStateDfa::dfa_to_Gdfa_obligation(dfa));
+                }};
+            case whitemech::lydia::PrefixQuantifier::Exists:
+                return {"dfa_to_Fdfa_obligation+minimize_if_fewer_bits", [](ExplicitStateDfa dfa) {
+                    return minimize_if_fewer_bits(ExplicitStateDfa::dfa_to_Fdfa_obligation(dfa));
+                }};
+            default:
+                // This should not happen since validate_obligation_fragment was called
+                throw std::runtime_error("Unexpected quantifier in obligation fragment conversion");
+        }
+    }
+
     ObligationLTLfPlusSynthesizer::ObligationLTLfPlusSynthesizer(
         LTLfPlus ltlf_plus_formula,
         InputOutputPartition partition,
@@ -76,7 +102,24 @@ namespace Syft {
                 bool use_buchi,
                 Syft::BuchiSolver::BuchiMode buechi_mode,
                 MinimisationOptions minimisation_options,
-                bool use_balanced_boolean_product)
+                bool use_balanced_boolean_product,
+                VarMgrOptions var_mgr_options)
+        : ObligationLTLfPlusSynthesizer(std::move(ltlf_plus_formula), InterfaceLayout(std::move(partition)),
+                                        starting_player, protagonist_player, use_buchi, buechi_mode,
+                                        std::move(minimisation_options), use_balanced_boolean_product,
+                                        std::move(var_mgr_options)) {
+    }
+
+    ObligationLTLfPlusSynthesizer::ObligationLTLfPlusSynthesizer(
+        LTLfPlus ltlf_plus_formula,
+        InterfaceLayout layout,
+        Player starting_player,
+        Player protagonist_player,
+                bool use_buchi,
+                Syft::BuchiSolver::BuchiMode buechi_mode,
+                MinimisationOptions minimisation_options,
+                bool use_balanced_boolean_product,
+                VarMgrOptions var_mgr_options)
         : ltlf_plus_formula_(ltlf_plus_formula),
           starting_player_(starting_player),
           protagonist_player_(protagonist_player),
@@ -84,13 +127,8 @@ namespace Syft {
                     minimisation_options_(minimisation_options),
                     use_balanced_boolean_product_(use_balanced_boolean_product) {
         buechi_mode_ = buechi_mode;
-        std::shared_ptr<VarMgr> var_mgr = std::make_shared<VarMgr>();
-        var_mgr->create_named_variables(partition.input_variables);
-        var_mgr->create_named_variables(partition.output_variables);
-
-        var_mgr->partition_variables(partition.input_variables,
-                                     partition.output_variables);
-        var_mgr_ = var_mgr;
+        var_mgr_ = layout.instantiate(var_mgr_options,
+                                      layout.variable_order(ltlf_plus_formula, var_mgr_options.proposition_order));
     }
 
     void ObligationLTLfPlusSynthesizer::validate_obligation_fragment() const {
@@ -122,22 +160,29 @@ namespace Syft {
 
     // Helper struct to hold either explicit or symbolic DFA
     struct HybridDfa {
-    std::optional<ExplicitStateDfa> explicit_dfa;
+    SharedExplicitStateDfa explicit_dfa;
     std::optional<SymbolicStateDfa> symbolic_dfa;
     std::optional<BigInt> approx_state_count; // Optional approximation of number of states
         bool is_symbolic;
         std::shared_ptr<VarMgr> var_mgr;
+        std::set<std::string> alphabet;  // The variables the DFA reads
         
         // Constructor from explicit DFA
                                 HybridDfa(ExplicitStateDfa e, std::shared_ptr<VarMgr> vm) 
-                                        : explicit_dfa(std::move(e)), symbolic_dfa(std::nullopt), 
-                                            is_symbolic(false), var_mgr(vm) {
-                                                approx_state_count = BigInt(explicit_dfa->get_nb_states());
+                                        : HybridDfa(std::make_shared<ExplicitStateDfa>(std::move(e)), vm) {
               }
+
+        // Constructor sharing an explicit DFA with other owners
+        HybridDfa(SharedExplicitStateDfa e, std::shared_ptr<VarMgr> vm)
+            : explicit_dfa(std::move(e)), symbolic_dfa(std::nullopt),
+              is_symbolic(false), var_mgr(vm),
+              alphabet(explicit_dfa->names.begin(), explicit_dfa->names.end()) {
+            approx_state_count = BigInt(explicit_dfa->get_nb_states());
+        }
         
         // Constructor from symbolic DFA (already converted)
         HybridDfa(const SymbolicStateDfa& s, std::shared_ptr<VarMgr> vm)
-            : explicit_dfa(std::nullopt), symbolic_dfa(s), 
+            : explicit_dfa(nullptr), symbolic_dfa(s), 
               is_symbolic(true), var_mgr(vm) {
               }
         
@@ -160,37 +205,37 @@ namespace Syft {
             approx_state_count.reset();
         }
         
-        void convert_to_symbolic_if_needed(int symbolic_threshold) {
+        void convert_to_symbolic_if_needed(int symbolic_threshold, StateEncodingKind encoding) {
             if (!is_symbolic && explicit_dfa->dfa_->ns > symbolic_threshold) {
                 spdlog::debug("[ObligationFragment] Converting to symbolic (exceeded threshold: {} > {})",
                               explicit_dfa->dfa_->ns, symbolic_threshold);
                 BigInt explicit_count = BigInt(explicit_dfa->get_nb_states());
-                symbolic_dfa = SymbolicStateDfa::from_explicit(
-                    ExplicitStateDfaAdd::from_dfa_mona(var_mgr, *explicit_dfa));
+                symbolic_dfa = SymbolicStateDfa::from_mona(var_mgr, *explicit_dfa, encoding);
                 is_symbolic = true;
                 approx_state_count = explicit_count;
-                explicit_dfa = std::nullopt;  // Free the explicit DFA
+                explicit_dfa.reset();  // Release the explicit DFA
             }
         }
         
-        SymbolicStateDfa to_symbolic() {
+        SymbolicStateDfa to_symbolic(StateEncodingKind encoding) {
             if (!is_symbolic) {
                 BigInt explicit_count = BigInt(explicit_dfa->get_nb_states());
-                symbolic_dfa = SymbolicStateDfa::from_explicit(
-                    ExplicitStateDfaAdd::from_dfa_mona(var_mgr, *explicit_dfa));
+                symbolic_dfa = SymbolicStateDfa::from_mona(var_mgr, *explicit_dfa, encoding);
                 is_symbolic = true;
                 approx_state_count = explicit_count;
-                explicit_dfa = std::nullopt;  // Free the explicit DFA
+                explicit_dfa.reset();  // Release the explicit DFA
             }
             return *symbolic_dfa;
         }
     };
 
     // Helper to parse color formula and build arena using hybrid approach
-    // Starts with explicit DFAs, automatically switches to symbolic when threshold exceeded
+    // Starts with explicit DFAs and switches to symbolic products per pair, as the cost model
+    // (or, if disabled, the fixed thresholds) of the minimisation options decides
     SymbolicStateDfa ObligationLTLfPlusSynthesizer::build_arena_from_color_formula_hybrid(
         const std::string& color_formula,
-        const std::map<int, ExplicitStateDfa>& color_to_dfa) const {
+        const std::map<int, SharedExplicitStateDfa>& color_to_dfa,
+        SharedExplicitStateDfa* explicit_arena) const {
         
         // Parse the color formula (e.g., "(1 & 2) | 3") and build DFA product using hybrid approach
         // Simple recursive descent parser for: expr = term (('|' term)*)
@@ -211,9 +256,54 @@ namespace Syft {
             }
         };
 
-        auto combine_pair = [&](HybridDfa left, HybridDfa right, bool is_or) -> HybridDfa {
+        auto state_bits = [&](double states) -> double {
+            if (minimisation_options_.state_encoding == StateEncodingKind::OneHot) {
+                return states;
+            }
+            return std::max(1.0, std::ceil(std::log2(std::max(states, 2.0))));
+        };
+
+        // Whether the cost model prefers the symbolic product of two explicit operands
+        auto prefer_symbolic = [&](const HybridDfa& left, const HybridDfa& right, bool is_or,
+                                   std::size_t pending) -> bool {
+            const ProductCostModel& model = minimisation_options_.cost_model;
+            double left_states = static_cast<double>(left.explicit_dfa->dfa_->ns);
+            double right_states = static_cast<double>(right.explicit_dfa->dfa_->ns);
+            std::set<std::string> shared;
+            std::set_intersection(left.alphabet.begin(), left.alphabet.end(),
+                                  right.alphabet.begin(), right.alphabet.end(),
+                                  std::inserter(shared, shared.begin()));
+            double alphabet = static_cast<double>(left.alphabet.size() + right.alphabet.size() - shared.size());
+            double overlap = alphabet > 0 ? static_cast<double>(shared.size()) / alphabet : 0.0;
+
+            double states = left_states * right_states * (1.0 - model.overlap_shrink * overlap);
+            if (minimisation_options_.allow_minimisation && states < minimisation_options_.threshold) {
+                states *= model.minimisation_gain;
+            }
+            double explicit_cost = std::max(states, 1.0) * std::max(alphabet, 1.0) * model.explicit_state_cost *
+                                   static_cast<double>(1 + pending);
+            double bits = state_bits(left_states) + state_bits(right_states);
+            double symbolic_cost = bits * (bits + alphabet) * model.symbolic_node_cost;
+
+            bool symbolic = symbolic_cost < explicit_cost;
+            spdlog::info("[ObligationFragment] {} product of {} and {} states: ~{:.0f} states, {} variables "
+                         "({:.2f} shared), {} pending, explicit cost {:.0f}, symbolic cost {:.0f} -> {}",
+                         is_or ? "OR" : "AND", left.explicit_dfa->dfa_->ns, right.explicit_dfa->dfa_->ns,
+                         states, alphabet, overlap, pending, explicit_cost, symbolic_cost,
+                         symbolic ? "symbolic" : "explicit");
+            return symbolic;
+        };
+
+        // pending counts the products still to fold the result into within its subformula
+        auto combine_pair = [&](HybridDfa left, HybridDfa right, bool is_or, std::size_t pending) -> HybridDfa {
+            var_mgr_->check_budget("arena product");
+            TraceScope trace("product step", "automata");
+            trace.arg("operation", is_or ? "OR" : "AND");
             auto left_est = left.state_count();
             auto right_est = right.state_count();
+            std::set<std::string> alphabet = left.alphabet;
+            alphabet.insert(right.alphabet.begin(), right.alphabet.end());
+            bool use_model = minimisation_options_.cost_model.enabled;
             // Also switch to symbolic if product estimate exceeds threshold
             auto estimated_product = std::optional<BigInt>(1);
             if (left_est.has_value()) {
@@ -226,15 +316,22 @@ namespace Syft {
             } else {
                 estimated_product = std::nullopt;
             }
-            if (left.is_symbolic || right.is_symbolic || (estimated_product.has_value() && estimated_product.value() > minimisation_options_.symbolic_threshold)) {
+            bool symbolic = left.is_symbolic || right.is_symbolic;
+            if (!symbolic) {
+                symbolic = use_model
+                    ? prefer_symbolic(left, right, is_or, pending)
+                    : estimated_product.has_value() && estimated_product.value() > minimisation_options_.symbolic_threshold;
+            }
+            if (symbolic) {
                 spdlog::debug("[ObligationFragment] Computing {} product using symbolic representation",
                               is_or ? "OR" : "AND");
-                SymbolicStateDfa left_sym = left.to_symbolic();
-                SymbolicStateDfa right_sym = right.to_symbolic();
+                SymbolicStateDfa left_sym = left.to_symbolic(minimisation_options_.state_encoding);
+                SymbolicStateDfa right_sym = right.to_symbolic(minimisation_options_.state_encoding);
                 SymbolicStateDfa product = is_or
-                    ? SymbolicStateDfa::product_OR({left_sym, right_sym})
-                    : SymbolicStateDfa::product_AND({left_sym, right_sym});
+                    ? SymbolicStateDfa::product_OR({left_sym, right_sym}, minimisation_options_.merge_product_sinks)
+                    : SymbolicStateDfa::product_AND({left_sym, right_sym}, minimisation_options_.merge_product_sinks);
                 HybridDfa combined(product, var_mgr_);
+                combined.alphabet = std::move(alphabet);
                 if (left_est && right_est) {
                     combined.set_state_count(left_est.value() * right_est.value());
                 } else {
@@ -248,6 +345,8 @@ namespace Syft {
                     bigint_to_string(left_est),
                     bigint_to_string(right_est),
                     combined.state_count_str());
+                trace.arg("representation", combined.is_symbolic ? "symbolic" : "explicit")
+                     .arg("states", combined.state_count_str());
                 return combined;
             }
 
@@ -257,9 +356,39 @@ namespace Syft {
                 spdlog::debug("[ObligationFragment] Computing AND product using MONA");
             }
 
+            // Operands owned only by this pair are consumed rather than copied
+            std::vector<ExplicitStateDfa> operands;
+            operands.push_back(ExplicitStateDfa::take(left.explicit_dfa));
+            operands.push_back(ExplicitStateDfa::take(right.explicit_dfa));
+            if (minimisation_options_.reachable_products) {
+                // Weakly minimised at every step, so that folds stay near their final size
+                ExplicitStateDfa product = ExplicitStateDfa::dfa_product_reachable(
+                    operands, is_or ? dfaProductType::dfaOR : dfaProductType::dfaAND);
+                spdlog::debug("[ObligationFragment] {} product has {} reachable states",
+                              is_or ? "OR" : "AND",
+                              product.dfa_->ns);
+                if (minimisation_options_.allow_minimisation) {
+                    product = ExplicitStateDfa::dfa_minimize_weak(product);
+                }
+                HybridDfa combined(std::move(product), var_mgr_);
+                if (!use_model) {
+                    combined.convert_to_symbolic_if_needed(minimisation_options_.symbolic_threshold,
+                                                           minimisation_options_.state_encoding);
+                }
+                spdlog::debug(
+                    "[ObligationFragment] {} product combined ~{} with ~{} -> ~{}",
+                    is_or ? "OR" : "AND",
+                    bigint_to_string(left_est),
+                    bigint_to_string(right_est),
+                    combined.state_count_str());
+                trace.arg("representation", combined.is_symbolic ? "symbolic" : "explicit")
+                     .arg("states", combined.state_count_str());
+                return combined;
+            }
+
             ExplicitStateDfa product = is_or
-                ? ExplicitStateDfa::dfa_product_or({*left.explicit_dfa, *right.explicit_dfa})
-                : ExplicitStateDfa::dfa_product_and({*left.explicit_dfa, *right.explicit_dfa});
+                ? ExplicitStateDfa::dfa_product_or(std::move(operands), minimisation_options_.product_policy)
+                : ExplicitStateDfa::dfa_product_and(std::move(operands), minimisation_options_.product_policy);
             spdlog::debug("[ObligationFragment] {} product has {} states",
                          is_or ? "OR" : "AND",
                          product.dfa_->ns);
@@ -273,7 +402,11 @@ namespace Syft {
             }
 
             HybridDfa combined(std::move(product), var_mgr_);
-            combined.convert_to_symbolic_if_needed(minimisation_options_.symbolic_threshold);
+            // The cost model decides at the next product instead
+            if (!use_model) {
+                combined.convert_to_symbolic_if_needed(minimisation_options_.symbolic_threshold,
+                                                       minimisation_options_.state_encoding);
+            }
 
             spdlog::debug(
                 "[ObligationFragment] {} product combined ~{} with ~{} -> ~{}",
@@ -281,6 +414,8 @@ namespace Syft {
                 bigint_to_string(left_est),
                 bigint_to_string(right_est),
                 combined.state_count_str());
+            trace.arg("representation", combined.is_symbolic ? "symbolic" : "explicit")
+                 .arg("states", combined.state_count_str());
 
             return combined;
         };
@@ -296,9 +431,14 @@ namespace Syft {
             while (current.size() > 1) {
                 std::vector<HybridDfa> next;
                 next.reserve((current.size() + 1) / 2);
+                // The rounds left after this one
+                std::size_t pending = 0;
+                for (std::size_t width = (current.size() + 1) / 2; width > 1; width = (width + 1) / 2) {
+                    pending++;
+                }
                 std::size_t i = 0;
                 for (; i + 1 < current.size(); i += 2) {
-                    next.push_back(combine_pair(std::move(current[i]), std::move(current[i + 1]), is_or));
+                    next.push_back(combine_pair(std::move(current[i]), std::move(current[i + 1]), is_or, pending));
                 }
                 if (i < current.size()) {
                     next.push_back(std::move(current.back()));
@@ -360,7 +500,7 @@ namespace Syft {
 
             HybridDfa accum = std::move(factors.front());
             for (std::size_t idx = 1; idx < factors.size(); ++idx) {
-                accum = combine_pair(std::move(accum), std::move(factors[idx]), false);
+                accum = combine_pair(std::move(accum), std::move(factors[idx]), false, factors.size() - idx - 1);
             }
             return accum;
         };
@@ -384,7 +524,7 @@ namespace Syft {
 
             HybridDfa accum = std::move(terms.front());
             for (std::size_t idx = 1; idx < terms.size(); ++idx) {
-                accum = combine_pair(std::move(accum), std::move(terms[idx]), true);
+                accum = combine_pair(std::move(accum), std::move(terms[idx]), true, terms.size() - idx - 1);
             }
             return accum;
         };
@@ -395,71 +535,83 @@ namespace Syft {
             throw std::runtime_error("Trailing characters in color formula after parsing");
         }
 
-        auto symbolic_arena = res.to_symbolic();
+        if (explicit_arena != nullptr && !res.is_symbolic &&
+            ExplicitGameSolver::applicable(*res.explicit_dfa, *var_mgr_, starting_player_,
+                                           minimisation_options_.explicit_game_max_states)) {
+            *explicit_arena = res.explicit_dfa;
+        }
+        auto symbolic_arena = res.to_symbolic(minimisation_options_.state_encoding);
         // info_log the number of states we approximated using spdlog
         spdlog::info("[ObligationFragment] Final arena has approximately {} states, {} bits ",
                      res.state_count_str(),
                      symbolic_arena.transition_function().size());
 
         // Always return symbolic representation
-                // Trigger CUDD variable reordering to compact BDDs after product construction
+        // Trigger CUDD variable reordering to compact BDDs after product construction
+        var_mgr_->end_phase("arena product");
 
         return symbolic_arena;
     }
 
     std::pair<SymbolicStateDfa, std::map<int, CUDD::BDD>> 
-    ObligationLTLfPlusSynthesizer::convert_to_symbolic_dfa() const {
+    ObligationLTLfPlusSynthesizer::convert_to_symbolic_dfa(SharedExplicitStateDfa* explicit_arena) const {
         using clock = std::chrono::high_resolution_clock;
         auto t0 = clock::now();
         
         // Step 1: Build all explicit DFAs with obligation transformations
-        std::map<int, ExplicitStateDfa> color_to_explicit_dfa;
         std::map<int, CUDD::BDD> color_to_final_states;
 
         spdlog::info("[ObligationFragment] Building explicit DFAs for each color...");
-        
-        for (const auto& [ltlf_plus_arg, prefix_quantifier] : ltlf_plus_formula_.formula_to_quantification_) {
-            whitemech::lydia::ltlf_ptr ltlf_arg = ltlf_plus_arg->ltlf_arg();
-            ExplicitStateDfa explicit_dfa = ExplicitStateDfa::dfa_of_formula(*ltlf_arg);
-            
-            int color = std::stoi(ltlf_plus_formula_.formula_to_color_.at(ltlf_plus_arg));
-
-            switch (prefix_quantifier) {
-                case whitemech::lydia::PrefixQuantifier::Forall: {
-                    // Safety property: convert to G(phi) form
-                    spdlog::debug("[ObligationFragment] Applying Forall transformation for color {}", color);
-                    ExplicitStateDfa trimmed_explicit_dfa = ExplicitStateDfa::dfa_to_Gdfa_obligation(explicit_dfa);
-                    ExplicitStateDfa minised = minimize_if_fewer_bits(std::move(trimmed_explicit_dfa));
-                    color_to_explicit_dfa.insert({color, std::move(minised)});
-                    break;
-                }
-                case whitemech::lydia::PrefixQuantifier::Exists: {
-                    // Guarantee property: convert to F(phi) form
-                    spdlog::debug("[ObligationFragment] Applying Exists transformation for color {}", color);
-                    ExplicitStateDfa trimmed_explicit_dfa = ExplicitStateDfa::dfa_to_Fdfa_obligation(explicit_dfa);
-                    ExplicitStateDfa minised = minimize_if_fewer_bits(std::move(trimmed_explicit_dfa));
-                    color_to_explicit_dfa.insert({color, std::move(minised)});
-                    break;
-                }
-                default:
-                    // This should not happen since validate_obligation_fragment was called
-                    throw std::runtime_error("Unexpected quantifier in obligation fragment conversion");
-            }
+        ColorAutomatonBuilder builder(var_mgr_, DfaConstructionOptions());
+        std::map<int, SharedExplicitStateDfa> color_to_explicit_dfa =
+            builder.build_explicit(ltlf_plus_formula_, obligation_transform);
+
+        var_mgr_->snapshot_stats("DFA construction");
+
+        std::vector<ColorOrbit> orbits;
+        if (minimisation_options_.symmetry_reduction) {
+            orbits = find_color_orbits(color_to_explicit_dfa, ColorFormula(ltlf_plus_formula_.color_formula_),
+                                       *var_mgr_, minimisation_options_.symmetry_max_atoms);
+            spdlog::info("[ObligationFragment] {} orbits of symmetric colors", orbits.size());
         }
 
         // Step 2: Build the product arena using hybrid approach (MONA when small, symbolic when large)
         spdlog::info("[ObligationFragment] Computing product DFA using hybrid approach...");
-        SymbolicStateDfa arena = build_arena_from_color_formula_hybrid(
-            ltlf_plus_formula_.color_formula_, color_to_explicit_dfa);
+        SymbolicStateDfa arena = orbits.empty()
+            ? build_arena_from_color_formula_hybrid(ltlf_plus_formula_.color_formula_, color_to_explicit_dfa,
+                                                    explicit_arena)
+            : build_symmetric_arena(color_to_explicit_dfa, orbits);
         
         spdlog::info("[ObligationFragment] Final arena DFA created");
-        // Step 3: Collect final states for debugging (convert individual DFAs just for final state info)
+        // Collect final states for debugging (convert individual DFAs just for final state info),
+        // then free the explicit DFAs before the arena is minimized
         for (const auto &[color, explicit_dfa] : color_to_explicit_dfa) {
-            ExplicitStateDfaAdd add = ExplicitStateDfaAdd::from_dfa_mona(var_mgr_, explicit_dfa);
-            SymbolicStateDfa symbolic = SymbolicStateDfa::from_explicit(std::move(add));
+            SymbolicStateDfa symbolic = SymbolicStateDfa::from_mona(var_mgr_, *explicit_dfa);
             color_to_final_states[color] = symbolic.final_states();
         }
-
+        color_to_explicit_dfa.clear();
+        if (explicit_arena != nullptr && *explicit_arena) {
+            // The explicit solver reads the states by the codes of the plain conversion
+        } else if (minimisation_options_.minimize_arena) {
+            // The solvers only read the final states, which minimize always preserves
+            std::vector<CUDD::BDD> no_colors;
+            arena = arena.minimize(no_colors);
+            var_mgr_->end_phase("arena minimization");
+        } else if (minimisation_options_.compact_arena && !arena.care_states().IsOne()) {
+            // Merged sinks leave codes unused; minimize already re-encodes
+            std::vector<CUDD::BDD> no_colors;
+            arena = arena.compact(no_colors);
+            var_mgr_->end_phase("state compaction");
+        }
+        if (minimisation_options_.care_simplification != StrategyMinimization::Off &&
+            (explicit_arena == nullptr || !*explicit_arena)) {
+            // Narrows the care states, which the solvers take as their state space, to the reachable states
+            std::vector<CUDD::BDD> no_colors;
+            arena.simplify_on_care(arena.reachable_states(), no_colors, minimisation_options_.care_simplification);
+            var_mgr_->end_phase("care simplification");
+        }
+        var_mgr_->record_size("arena_state_bits",
+                              static_cast<double>(arena.transition_function().size()));
         // the arena already encodes the combined finals in arena.final_states()
         color_to_final_states[-1] = arena.final_states();
         
@@ -470,6 +622,58 @@ namespace Syft {
         return std::make_pair(arena, color_to_final_states);
     }
 
+    SymbolicStateDfa ObligationLTLfPlusSynthesizer::build_symmetric_arena(
+        const std::map<int, SharedExplicitStateDfa>& color_to_dfa,
+        const std::vector<ColorOrbit>& orbits) const {
+        // The orbit and the position in it of each color of an orbit
+        std::map<int, std::pair<const ColorOrbit*, std::size_t>> orbit_of;
+        for (const ColorOrbit& orbit : orbits) {
+            for (std::size_t k = 0; k < orbit.colors.size(); ++k) {
+                orbit_of.emplace(orbit.colors[k], std::make_pair(&orbit, k));
+            }
+        }
+
+        std::vector<SymbolicStateDfa> components;
+        std::vector<int> component_colors;
+        std::map<int, CUDD::BDD> color_to_final_states;
+        for (const auto& [color, dfa] : color_to_dfa) {
+            auto member = orbit_of.find(color);
+            bool renamed = member != orbit_of.end() && member->second.second > 0;
+            SymbolicStateDfa symbolic = renamed
+                ? SymbolicStateDfa::from_mona(var_mgr_,
+                                              rename_atoms(*color_to_dfa.at(member->second.first->colors.front()),
+                                                           member->second.first->atoms[member->second.second]),
+                                              minimisation_options_.state_encoding)
+                : SymbolicStateDfa::from_mona(var_mgr_, *dfa, minimisation_options_.state_encoding);
+            color_to_final_states[color] = symbolic.final_states();
+            components.push_back(std::move(symbolic));
+            component_colors.push_back(color);
+        }
+        CUDD::BDD final_states =
+            evaluate_color_formula_with_bdds(ltlf_plus_formula_.color_formula_, color_to_final_states);
+
+        SymmetryQuotient quotient(std::move(components), component_colors, final_states, orbits);
+        spdlog::info("[ObligationFragment] Symmetric arena has {} bits, {} canonical codes",
+                     quotient.arena().transition_function().size(),
+                     quotient.canonical_states().CountMinterm(
+                         static_cast<int>(quotient.arena().transition_function().size())));
+        var_mgr_->end_phase("arena product");
+        return quotient.arena();
+    }
+
+    CUDD::BDD ObligationLTLfPlusSynthesizer::evaluate_color_formula_with_bdds(
+        const std::string& color_formula,
+        const std::map<int, CUDD::BDD>& color_to_bdd) const {
+        ColorFormula formula(color_formula);
+        return formula.to_bdd([&](std::size_t color) {
+            auto it = color_to_bdd.find(static_cast<int>(color));
+            if (it == color_to_bdd.end()) {
+                throw std::runtime_error("Error: Unknown color in color formula: " + std::to_string(color));
+            }
+            return it->second;
+        }, *var_mgr_->cudd_mgr());
+    }
+
     ELSynthesisResult ObligationLTLfPlusSynthesizer::solve_with_scc(
         const SymbolicStateDfa& arena,
         const std::map<int, CUDD::BDD>& color_to_final_states) const {
@@ -480,7 +684,16 @@ namespace Syft {
                 
         // Create and run the weak game solver (debug=true for detailed output)
         WeakGameSolver solver(arena, accepting_states, true);
+        solver.SetFixpointMode(minimisation_options_.fixpoint_mode);
+        solver.SetSCCAlgorithm(minimisation_options_.scc_algorithm, minimisation_options_.scc_chain);
+        solver.SetThreads(minimisation_options_.layer_threads);
+        // The transitions outside the reachable states are arbitrary after care simplification
+        solver.SetDemandDriven(minimisation_options_.reachable_states_only ||
+                               minimisation_options_.care_simplification != StrategyMinimization::Off);
+        solver.SetRealizabilityOnly(minimisation_options_.realizability_only);
         WeakGameResult game_result = solver.Solve();
+        var_mgr_->snapshot_stats("fixpoint");
+        spdlog::info("[ObligationFragment] Fixpoint iterations: {}", solver.GetFixpointTrace().iterations());
                 
         // Check if initial state is winning
         CUDD::BDD initial_state = arena.initial_state_bdd();
@@ -513,7 +726,7 @@ namespace Syft {
         auto var_mgr = arena.var_mgr();
         auto mgr = var_mgr->cudd_mgr();
         auto automaton_id = arena.automaton_id();
-        auto transition_func = arena.transition_function();
+        const auto &transition_func = arena.transition_function();
         auto initial_state = arena.initial_state_bdd();
         
         CUDD::BDD state_space = initial_state;
@@ -522,9 +735,44 @@ namespace Syft {
         CUDD::BDD io_cube = var_mgr->input_cube() * var_mgr->output_cube();
         
         
+        if (minimisation_options_.abstraction_refinement &&
+            transition_func.size() > minimisation_options_.abstraction_max_visible_bits) {
+            AbstractionRefinementOptions options;
+            options.max_visible_bits = minimisation_options_.abstraction_max_visible_bits;
+            AbstractionRefinement refinement(arena, {}, options);
+            AbstractionRefinementResult refined = refinement.run(AbstractionRefinement::buchi(
+                arena, starting_player_, protagonist_player_, arena.care_states(), buechi_mode_));
+            var_mgr_->snapshot_stats("fixpoint");
+            spdlog::info("[ObligationFragment] Abstraction refinement: {} rounds over {} components",
+                         refined.rounds, refinement.components().size());
+            spdlog::info("[ObligationFragment] Realizability: {}", (refined.realizability ? "true" : "false"));
+
+            ELSynthesisResult result;
+            result.realizability = refined.realizability;
+            result.winning_states = refined.winning_states;
+            result.output_function = {};  // strategy extraction omitted
+            result.z_tree = nullptr;
+            return result;
+        }
+
         // Create and run the Büchi solver (arena already has final_states)
-    BuchiSolver solver(arena, starting_player_, protagonist_player_, var_mgr_->cudd_mgr()->bddOne(), buechi_mode_);
+    BuchiSolver solver(arena, starting_player_, protagonist_player_, arena.care_states(), buechi_mode_);
+        solver.set_warm_start(minimisation_options_.fixpoint_mode == FixpointMode::Frontier);
+        solver.set_realizability_only(minimisation_options_.realizability_only);
+        solver.set_scc_algorithm(minimisation_options_.scc_algorithm, minimisation_options_.scc_chain);
         SynthesisResult game_result = solver.run();
+        var_mgr_->snapshot_stats("fixpoint");
+
+        std::size_t inner_iterations = 0;
+        double candidate_states = 0;
+        for (const FixpointTrace& trace : solver.inner_traces()) {
+            inner_iterations += trace.iterations();
+            for (double candidates : trace.candidate_states) {
+                candidate_states += candidates;
+            }
+        }
+        spdlog::info("[ObligationFragment] Inner fixpoints: {}, inner iterations: {}, states re-examined: {}",
+                     solver.inner_traces().size(), inner_iterations, candidate_states);
         
         spdlog::info("[ObligationFragment] BuchiStandalone completed");
         spdlog::info("[ObligationFragment] Realizability: {}", (game_result.realizability ? "true" : "false"));
@@ -539,12 +787,110 @@ namespace Syft {
         return result;
     }
 
+    std::optional<whitemech::lydia::PrefixQuantifier>
+    ObligationLTLfPlusSynthesizer::pure_obligation_quantifier() const {
+        for (const std::string& token : ELHelpers::tokenize(ltlf_plus_formula_.color_formula_)) {
+            if (token == "!") {
+                return std::nullopt;
+            }
+        }
+        std::optional<whitemech::lydia::PrefixQuantifier> shared;
+        for (const auto& [formula, quantifier] : ltlf_plus_formula_.formula_to_quantification_) {
+            if (shared && *shared != quantifier) {
+                return std::nullopt;
+            }
+            shared = quantifier;
+        }
+        return shared;
+    }
+
+    ELSynthesisResult ObligationLTLfPlusSynthesizer::solve_pure_obligation(
+        const SymbolicStateDfa& arena,
+        whitemech::lydia::PrefixQuantifier quantifier) const {
+        bool safety = quantifier == whitemech::lydia::PrefixQuantifier::Forall;
+        spdlog::info("[ObligationFragment] Solving as a {} game", safety ? "safety" : "reachability");
+
+        CUDD::BDD state_space = arena.care_states();
+        std::unique_ptr<DfaGameSynthesizer> solver;
+        if (safety) {
+            solver = std::make_unique<Safety>(arena, starting_player_, protagonist_player_,
+                                              arena.final_states(), state_space);
+        } else {
+            solver = std::make_unique<Reachability>(arena, starting_player_, protagonist_player_,
+                                                    arena.final_states(), state_space);
+        }
+        solver->set_fixpoint_mode(minimisation_options_.fixpoint_mode);
+        solver->set_realizability_only(minimisation_options_.realizability_only);
+        SynthesisResult game_result = solver->run();
+        var_mgr_->snapshot_stats("fixpoint");
+        spdlog::info("[ObligationFragment] Fixpoint iterations: {}", solver->fixpoint_trace().iterations());
+        spdlog::info("[ObligationFragment] Realizability: {}", (game_result.realizability ? "true" : "false"));
+
+        ELSynthesisResult result;
+        result.realizability = game_result.realizability;
+        result.winning_states = game_result.winning_states;
+        result.output_function = {};  // strategy extraction omitted
+        result.z_tree = nullptr;
+        return result;
+    }
+
+    ExplicitGameCondition ObligationLTLfPlusSynthesizer::explicit_condition() const {
+        if (minimisation_options_.pure_obligation_games) {
+            if (std::optional<whitemech::lydia::PrefixQuantifier> quantifier = pure_obligation_quantifier()) {
+                return *quantifier == whitemech::lydia::PrefixQuantifier::Forall
+                    ? ExplicitGameCondition::Safety
+                    : ExplicitGameCondition::Reachability;
+            }
+        }
+        // The weak game solver and the other Büchi modes all decide the Büchi condition
+        if (use_buchi_ && buechi_mode_ == BuchiSolver::BuchiMode::COBUCHI) {
+            return ExplicitGameCondition::CoBuchi;
+        }
+        return ExplicitGameCondition::Buchi;
+    }
+
+    ELSynthesisResult ObligationLTLfPlusSynthesizer::solve_explicit(
+        const SymbolicStateDfa& arena,
+        const SharedExplicitStateDfa& explicit_arena) const {
+        spdlog::info("[ObligationFragment] Solving the {} states of the arena explicitly", explicit_arena->dfa_->ns);
+
+        ExplicitGameCondition condition = explicit_condition();
+        ExplicitGameSolver solver(explicit_arena, var_mgr_, starting_player_, protagonist_player_);
+        solver.set_realizability_only(minimisation_options_.realizability_only);
+        ExplicitGameResult game_result = solver.solve(condition);
+        var_mgr_->snapshot_stats("fixpoint");
+        spdlog::info("[ObligationFragment] Fixpoint iterations: {}", game_result.iterations);
+        spdlog::info("[ObligationFragment] Realizability: {}", (game_result.realizability ? "true" : "false"));
+
+        ELSynthesisResult result;
+        result.realizability = game_result.realizability;
+        result.winning_states = solver.to_bdd(game_result.winning_states, arena, minimisation_options_.state_encoding);
+        result.output_function = {};
+        result.z_tree = nullptr;
+        if (game_result.realizability && !minimisation_options_.realizability_only) {
+            result.transducer = solver.transducer(game_result, condition, arena, minimisation_options_.state_encoding);
+        }
+        return result;
+    }
+
     ELSynthesisResult ObligationLTLfPlusSynthesizer::run() const {
         // Step 1: Validate that the formula is in obligation fragment
         validate_obligation_fragment();
         
         // Step 2: Convert to symbolic state DFA
-        auto [arena, color_to_final_states] = convert_to_symbolic_dfa();
+        SharedExplicitStateDfa explicit_arena;
+        auto [arena, color_to_final_states] = convert_to_symbolic_dfa(
+            minimisation_options_.explicit_game_max_states > 0 ? &explicit_arena : nullptr);
+
+        if (explicit_arena) {
+            return solve_explicit(arena, explicit_arena);
+        }
+
+        if (minimisation_options_.pure_obligation_games) {
+            if (std::optional<whitemech::lydia::PrefixQuantifier> quantifier = pure_obligation_quantifier()) {
+                return solve_pure_obligation(arena, *quantifier);
+            }
+        }
         
         // Step 3: Solve using Büchi solver (replaces SCC/WeakGame path)
         if (use_buchi_) {
@@ -3,6 +3,7 @@
 //
 
 #include "synthesizer/PPLTLfPlusSynthesizer.h"
+#include "VariableOrdering.h"
 #include "game/EmersonLei.hpp"
 #include "lydia/logic/ppltlplus/base.hpp"
 #include "lydia/logic/pp_pnf.hpp"
@@ -14,14 +15,15 @@ namespace Syft {
         PPLTLPlus ppltl_plus_formula,
         InputOutputPartition partition,
         Player starting_player,
-        Player protagonist_player) : 
+        Player protagonist_player,
+        VarMgrOptions var_mgr_options) : 
             ppltl_plus_formula_(ppltl_plus_formula), 
             color_formula_(ppltl_plus_formula.color_formula_), 
             starting_player_(starting_player), 
             protagonist_player_(protagonist_player) {
-        std::shared_ptr<Syft::VarMgr> var_mgr = std::make_shared<Syft::VarMgr>();
-        var_mgr->create_named_variables(partition.input_variables);
-        var_mgr->create_named_variables(partition.output_variables);
+        std::shared_ptr<Syft::VarMgr> var_mgr = std::make_shared<Syft::VarMgr>(var_mgr_options);
+        var_mgr->create_named_variables(
+            proposition_order(partition, ppltl_plus_formula, var_mgr_options.proposition_order));
 
         var_mgr->partition_variables(partition.input_variables,
                                      partition.output_variables);
@@ -34,11 +36,15 @@ namespace Syft {
         // ensures that the "order" of colors is respected
         std::map<int, SymbolicStateDfa> color_to_dfa;
         std::map<int, CUDD::BDD> color_to_final_states;
+        // shared by the colors, so that common subformulas are evaluated once
+        auto valuations = std::make_shared<PPLTLValuationTable>(var_mgr_);
 
         for (const auto& [ppltl_plus_arg, prefix_quantifier] : ppltl_plus_formula_.formula_to_quantification_) {
             whitemech::lydia::ppltl_ptr ppltl_arg = ppltl_plus_arg->ppltl_arg();
             std::cout << "PPLTL formula: " << whitemech::lydia::to_string(*ppltl_arg) << std::endl;
-            SymbolicStateDfa sdfa = SymbolicStateDfa::dfa_of_ppltl_formula(*ppltl_arg, var_mgr_);
+            SymbolicStateDfa sdfa = dfa_library_
+                ? dfa_library_->dfa_of(*ppltl_arg, var_mgr_, valuations, variable_order_)
+                : SymbolicStateDfa::dfa_of_ppltl_formula(*ppltl_arg, var_mgr_, valuations, variable_order_);
 
             switch (prefix_quantifier) {
                 case whitemech::lydia::PrefixQuantifier::ForallExists:
@@ -79,19 +85,29 @@ namespace Syft {
             goal_states.push_back(color_to_final_states.at(color));
         }
 
-        std::size_t n_colors = goal_states.size();
-        for (auto i = 0; i < n_colors; i++){
-            goal_states.push_back(!goal_states[i]);
-        }
-
         for (auto j = 0; j < vec_spec.size(); j++) {
             vec_spec[j].dump_dot("dfa"+std::to_string(j)+".dot");
         }
 
+        var_mgr_->end_phase("DFA construction");
         SymbolicStateDfa arena = SymbolicStateDfa::product_AND(vec_spec);
+        // The game only needs the goal states of the colors, not their DFAs
+        std::vector<SymbolicStateDfa>().swap(vec_spec);
+        color_to_dfa.clear();
+        color_to_final_states.clear();
+        valuations.reset();
+        var_mgr_->end_phase("arena product");
+        var_mgr_->record_size("arena_state_bits",
+                              static_cast<double>(arena.transition_function().size()));
         arena.dump_dot("arena.dot");
+        CUDD::BDD state_space = var_mgr_->cudd_mgr()->bddOne();
+        if (care_simplification_ != StrategyMinimization::Off) {
+            state_space = arena.reachable_states();
+            arena.simplify_on_care(state_space, goal_states, care_simplification_);
+        }
         std::shared_ptr<EmersonLei> emerson_lei = std::make_shared<EmersonLei>(arena, color_formula_, starting_player_, protagonist_player_,
-            goal_states, var_mgr_->cudd_mgr()->bddOne(), var_mgr_->cudd_mgr()->bddZero(), var_mgr_->cudd_mgr()->bddZero(), false);
+            goal_states, state_space, var_mgr_->cudd_mgr()->bddZero(), var_mgr_->cudd_mgr()->bddZero(), false);
+        emerson_lei->set_release_winning_moves(true);
         emerson_lei_ = emerson_lei;
         return emerson_lei_->run_EL();
     }
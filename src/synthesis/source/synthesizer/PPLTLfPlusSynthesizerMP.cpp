@@ -3,6 +3,7 @@
 // 
 
 #include "synthesizer/PPLTLfPlusSynthesizerMP.h"
+#include "VariableOrdering.h"
 #include "game/MannaPnueli.hpp"
 
 namespace Syft {
@@ -11,12 +12,13 @@ namespace Syft {
         InputOutputPartition partition,
         Player starting_player,
         Player protagonist_player,
-        int game_solver
+        int game_solver,
+        VarMgrOptions var_mgr_options
     ) : ppltl_plus_formula_(ppltl_plus_formula), starting_player_(starting_player),
         protagonist_player_(protagonist_player), game_solver_(game_solver) {
-        std::shared_ptr<VarMgr> var_mgr = std::make_shared<VarMgr>();
-        var_mgr->create_named_variables(partition.input_variables);
-        var_mgr->create_named_variables(partition.output_variables);
+        std::shared_ptr<VarMgr> var_mgr = std::make_shared<VarMgr>(var_mgr_options);
+        var_mgr->create_named_variables(
+            proposition_order(partition, ppltl_plus_formula, var_mgr_options.proposition_order));
         var_mgr->partition_variables(partition.input_variables, partition.output_variables);
         var_mgr_ = var_mgr;
 
@@ -54,6 +56,13 @@ namespace Syft {
         // ensures that the "order" of colors is respected
         std::map<int, SymbolicStateDfa> color_to_dfa;
         std::map<int, CUDD::BDD> color_to_final_states;
+        // shared by the colors, so that common subformulas are evaluated once
+        auto valuations = std::make_shared<PPLTLValuationTable>(var_mgr_);
+        // Loaded from the DFA library, if one is set (see set_dfa_library)
+        auto dfa_of = [&](const whitemech::lydia::PPLTLFormula &formula) {
+            return dfa_library_ ? dfa_library_->dfa_of(formula, var_mgr_, valuations, variable_order_)
+                                : SymbolicStateDfa::dfa_of_ppltl_formula(formula, var_mgr_, valuations, variable_order_);
+        };
 
         for (const auto& [ppltl_plus_arg, prefix_quantifier] : ppltl_plus_formula_.formula_to_quantification_) {
             whitemech::lydia::ppltl_ptr ppltl_arg = ppltl_plus_arg -> ppltl_arg();
@@ -62,7 +71,7 @@ namespace Syft {
             switch (prefix_quantifier) {
                 case whitemech::lydia::PrefixQuantifier::ForallExists:
                     {
-                    SymbolicStateDfa sdfa = SymbolicStateDfa::dfa_of_ppltl_formula(*ppltl_arg, var_mgr_);    
+                    SymbolicStateDfa sdfa = dfa_of(*ppltl_arg);    
                     color_to_dfa.insert({std::stoi(ppltl_plus_formula_.formula_to_color_.at(ppltl_plus_arg)), sdfa});
                     color_to_final_states.insert({
                       std::stoi(ppltl_plus_formula_.formula_to_color_.at(ppltl_plus_arg)), sdfa.final_states()
@@ -70,7 +79,7 @@ namespace Syft {
                     break;}
                 case whitemech::lydia::PrefixQuantifier::ExistsForall: 
                     {
-                    SymbolicStateDfa sdfa = SymbolicStateDfa::dfa_of_ppltl_formula(*ppltl_arg, var_mgr_); 
+                    SymbolicStateDfa sdfa = dfa_of(*ppltl_arg); 
                     color_to_dfa.insert({std::stoi(ppltl_plus_formula_.formula_to_color_.at(ppltl_plus_arg)), sdfa});
                     color_to_final_states.insert({
                       std::stoi(ppltl_plus_formula_.formula_to_color_.at(ppltl_plus_arg)), !sdfa.final_states()
@@ -78,7 +87,7 @@ namespace Syft {
                     break;}
                 case whitemech::lydia::PrefixQuantifier::Forall: {
                     // TODO, if game_solver_ == 2,  build forall_dfa, then remove initial self loops
-                    SymbolicStateDfa sdfa = SymbolicStateDfa::dfa_of_ppltl_formula_remove_initial_self_loops(*ppltl_arg, var_mgr_); 
+                    SymbolicStateDfa sdfa = SymbolicStateDfa::dfa_of_ppltl_formula_remove_initial_self_loops(*ppltl_arg, var_mgr_, valuations, variable_order_); 
                     color_to_dfa.insert({std::stoi(ppltl_plus_formula_.formula_to_color_.at(ppltl_plus_arg)), sdfa});
                     // CUDD::BDD final_states = sdfa.final_states() + sdfa.initial_state_bdd();
                     color_to_final_states.insert(
@@ -89,7 +98,7 @@ namespace Syft {
                 case whitemech::lydia::PrefixQuantifier::Exists: 
                 {
                     // TODO, if game_solver_ == 2,  build exists_dfa
-                    SymbolicStateDfa sdfa = SymbolicStateDfa::dfa_of_ppltl_formula(*ppltl_arg, var_mgr_); 
+                    SymbolicStateDfa sdfa = dfa_of(*ppltl_arg); 
                     color_to_dfa.insert({std::stoi(ppltl_plus_formula_.formula_to_color_.at(ppltl_plus_arg)), sdfa});
                     color_to_final_states.insert(
                         {std::stoi(ppltl_plus_formula_.formula_to_color_.at(ppltl_plus_arg)), sdfa.final_states()
@@ -105,21 +114,31 @@ namespace Syft {
               goal_states.push_back(color_to_final_states.at(color));
             }
         
-            std::size_t n_colors = goal_states.size();
-            for (auto i = 0; i < n_colors; i++) {
-              goal_states.push_back(!goal_states[i]);
-            }
-        
             for (auto j = 0; j < vec_spec.size(); j++) {
               vec_spec[j].dump_dot("dfa" + std::to_string(j) + ".dot");
             }
         
+            var_mgr_->end_phase("DFA construction");
             SymbolicStateDfa arena = SymbolicStateDfa::product_AND(vec_spec);
+            // The game only needs the goal states of the colors, not their DFAs
+            std::vector<SymbolicStateDfa>().swap(vec_spec);
+            color_to_dfa.clear();
+            color_to_final_states.clear();
+            valuations.reset();
+            var_mgr_->end_phase("arena product");
+            var_mgr_->record_size("arena_state_bits",
+                                  static_cast<double>(arena.transition_function().size()));
             arena.dump_dot("arena.dot");
+            CUDD::BDD state_space = var_mgr_->cudd_mgr()->bddOne();
+            if (care_simplification_ != StrategyMinimization::Off) {
+                state_space = arena.reachable_states();
+                arena.simplify_on_care(state_space, goal_states, care_simplification_);
+            }
             
             MannaPnueli solver(arena, ppltl_plus_formula_.color_formula_, F_colors_, G_colors_, starting_player_,
                                protagonist_player_,
-                               goal_states, var_mgr_->cudd_mgr()->bddOne(), 1);
+                               goal_states, state_space, 1);
+            solver.set_work_directory(work_directory_);
             return solver.run_MP();
     }
 }
\ No newline at end of file
@@ -1,4 +1,64 @@
 #pragma once
 
-inline bool DEBUG_MODE = false;  
-inline bool STRATEGY;
+#include <chrono>
+#include <sstream>
+#include <string>
+
+#include <spdlog/spdlog.h>
+
+#include "strategy.hpp"
+
+// Diagnostics of the solvers.
+//
+// Built with LYDIASYFT_DEBUG_TRACE (the LYDIASYFT_ENABLE_DEBUG_TRACE option,
+// on by default in Debug builds), SYFT_DEBUG_TRACE logs at spdlog's debug
+// level, and DEBUG_MODE is set at run time (--debug) to also dump the BDDs
+// and strategies of the solvers. Otherwise SYFT_DEBUG_TRACE expands to
+// nothing, so that its arguments are neither evaluated nor formatted, and
+// DEBUG_MODE is the constant false, so that the branches it guards are
+// compiled out of the hot loops.
+#ifdef LYDIASYFT_DEBUG_TRACE
+inline bool DEBUG_MODE = false;
+#define SYFT_DEBUG_TRACE(...) spdlog::debug(__VA_ARGS__)
+#else
+inline constexpr bool DEBUG_MODE = false;
+#define SYFT_DEBUG_TRACE(...) do {} while (0)
+#endif
+
+namespace Syft {
+
+/**
+ * \brief Returns \a value as printed by its operator<<, e.g. a BDD, for SYFT_DEBUG_TRACE.
+ */
+template <typename T>
+std::string debug_string(const T& value) {
+  std::ostringstream out;
+  out << value;
+  return out.str();
+}
+
+/**
+ * \brief Measures the time since its construction, for SYFT_DEBUG_TRACE.
+ *
+ * Reads no clock unless built with LYDIASYFT_DEBUG_TRACE.
+ */
+class DebugStopwatch {
+#ifdef LYDIASYFT_DEBUG_TRACE
+ public:
+  DebugStopwatch() : start_(std::chrono::steady_clock::now()) {}
+
+  long long elapsed_ms() const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_).count();
+  }
+
+ private:
+  std::chrono::steady_clock::time_point start_;
+#else
+ public:
+  DebugStopwatch() {}
+
+  long long elapsed_ms() const { return 0; }
+#endif
+};
+
+}
@@ -0,0 +1,55 @@
+#include "formula_file.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Syft {
+
+  void FormulaFile::ViewBuffer::reset(std::string_view view) {
+    // The get area is never written to, the const_cast is only for the interface of streambuf
+    char* begin = const_cast<char*>(view.data());
+    setg(begin, begin, begin + view.size());
+  }
+
+  FormulaFile::FormulaFile(const std::string& filename) : stream_(&buffer_) {
+    int descriptor = open(filename.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+      throw std::runtime_error("Error: Could not open formula file: " + filename);
+    }
+    struct stat status;
+    if (fstat(descriptor, &status) != 0) {
+      close(descriptor);
+      throw std::runtime_error("Error: Could not read formula file: " + filename);
+    }
+    std::size_t size = static_cast<std::size_t>(status.st_size);
+    // An empty file cannot be mapped, and has an empty formula
+    if (size > 0) {
+      void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+      if (mapping == MAP_FAILED) {
+        close(descriptor);
+        throw std::runtime_error("Error: Could not map formula file: " + filename);
+      }
+      // The file is read once, front to back
+      madvise(mapping, size, MADV_SEQUENTIAL);
+      mapping_ = std::shared_ptr<const char>(static_cast<const char*>(mapping), [size](const char* address) {
+        munmap(const_cast<char*>(address), size);
+      });
+      const char* end = static_cast<const char*>(std::memchr(mapping_.get(), '\n', size));
+      formula_ = std::string_view(mapping_.get(), end ? static_cast<std::size_t>(end - mapping_.get()) : size);
+    }
+    close(descriptor);
+  }
+
+  std::istream& FormulaFile::stream() {
+    buffer_.reset(formula_);
+    stream_.clear();
+    return stream_;
+  }
+
+}
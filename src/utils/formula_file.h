@@ -0,0 +1,57 @@
+#ifndef LYDIASYFT_FORMULA_FILE_H
+#define LYDIASYFT_FORMULA_FILE_H
+
+#include <cstddef>
+#include <istream>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <string_view>
+
+namespace Syft {
+
+  /**
+   * \brief The formula of a spec file, mapped in memory and read in place.
+   *
+   * The formula is the first line of the file, as the mains have always read
+   * it. The parsers read it through stream(), which serves the mapped bytes
+   * directly, so a formula of megabytes is neither copied into a string nor
+   * into a stringstream before parsing. The mapping is released with the
+   * object, so it should not outlive the parse.
+   */
+  class FormulaFile {
+   public:
+    /**
+     * \brief Maps \a filename; throws std::runtime_error if it cannot be opened or mapped.
+     */
+    explicit FormulaFile(const std::string& filename);
+
+    FormulaFile(const FormulaFile&) = delete;
+    FormulaFile& operator=(const FormulaFile&) = delete;
+
+    /**
+     * \brief Returns the formula, without the line break.
+     */
+    std::string_view formula() const {return formula_;}
+
+    /**
+     * \brief Returns a stream over the formula, for the parsers, which reads from the start on every call.
+     */
+    std::istream& stream();
+
+   private:
+    // Serves the bytes of a view, without a buffer of its own
+    class ViewBuffer : public std::streambuf {
+     public:
+      void reset(std::string_view view);
+    };
+
+    std::shared_ptr<const char> mapping_;
+    std::string_view formula_;
+    ViewBuffer buffer_;
+    std::istream stream_;
+  };
+
+}
+
+#endif //LYDIASYFT_FORMULA_FILE_H
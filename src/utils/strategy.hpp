@@ -0,0 +1,4 @@
+#pragma once
+
+// Whether the solvers keep what strategy extraction needs; set at run time
+inline bool STRATEGY;
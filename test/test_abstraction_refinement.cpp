@@ -0,0 +1,97 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <memory>
+#include <sstream>
+#include "automata/ExplicitStateDfa.h"
+#include "automata/SymbolicStateDfa.h"
+#include "game/AbstractionRefinement.h"
+#include "VarMgr.h"
+#include "lydia/parser/ltlf/driver.hpp"
+
+namespace {
+  Syft::ExplicitStateDfa dfa_of(const std::string& formula) {
+    whitemech::lydia::parsers::ltlf::LTLfDriver driver;
+    std::stringstream stream(formula);
+    driver.parse(stream);
+    auto parsed = std::static_pointer_cast<const whitemech::lydia::LTLfFormula>(driver.get_result());
+    return Syft::ExplicitStateDfa::dfa_of_formula(*parsed);
+  }
+
+  // The agent wins if both DFAs end in final states forever; the second one is hidden at first
+  Syft::AbstractionRefinementResult refine(const std::string& visible, const std::string& hidden) {
+    auto var_mgr = std::make_shared<Syft::VarMgr>();
+    var_mgr->create_named_variables({"i", "o1", "o2"});
+    var_mgr->partition_variables({"i"}, {"o1", "o2"});
+    std::vector<Syft::SymbolicStateDfa> components = {
+      Syft::SymbolicStateDfa::from_mona(var_mgr, dfa_of(visible)),
+      Syft::SymbolicStateDfa::from_mona(var_mgr, dfa_of(hidden))};
+    std::vector<std::vector<CUDD::BDD>> variables = {
+      var_mgr->get_state_variables(components[0].automaton_id()),
+      var_mgr->get_state_variables(components[1].automaton_id())};
+    Syft::SymbolicStateDfa arena = Syft::SymbolicStateDfa::product_AND(components);
+
+    Syft::AbstractionRefinementOptions options;
+    options.hidden_components = {1};
+    Syft::AbstractionRefinement refinement(arena, variables, options);
+    return refinement.run(Syft::AbstractionRefinement::buchi(
+        arena, Syft::Player::Agent, Syft::Player::Agent, arena.care_states()));
+  }
+}
+
+TEST_CASE("Abstraction refinement stops at a conclusive abstraction", "[abstraction]")
+{
+  SECTION("The under-approximation is won") {
+    Syft::AbstractionRefinementResult result = refine("F(o1)", "G(true) | F(o2)");
+    REQUIRE(result.realizability);
+  }
+
+  SECTION("The over-approximation is lost") {
+    // The environment never has to set i, whatever the agent does with the hidden DFA
+    Syft::AbstractionRefinementResult result = refine("F(i)", "F(o2)");
+    REQUIRE_FALSE(result.realizability);
+    REQUIRE(result.rounds == 1);
+    REQUIRE(result.hidden_components == std::vector<std::size_t>{1});
+  }
+}
+
+TEST_CASE("Abstraction refinement makes the hidden components visible when inconclusive", "[abstraction]")
+{
+  SECTION("Realizable") {
+    // Picking the hidden bits, the opponent keeps the hidden DFA out of the final states the agent reaches
+    Syft::AbstractionRefinementResult result = refine("F(o1)", "F(o2)");
+    REQUIRE(result.realizability);
+    REQUIRE(result.rounds == 2);
+    REQUIRE(result.hidden_components.empty());
+  }
+
+  SECTION("Unrealizable") {
+    Syft::AbstractionRefinementResult result = refine("F(o1)", "F(i)");
+    REQUIRE_FALSE(result.realizability);
+    REQUIRE(result.rounds == 2);
+    REQUIRE(result.hidden_components.empty());
+  }
+}
+
+TEST_CASE("The state bits of a product fall into the components", "[abstraction]")
+{
+  auto var_mgr = std::make_shared<Syft::VarMgr>();
+  var_mgr->create_named_variables({"i", "o1", "o2"});
+  var_mgr->partition_variables({"i"}, {"o1", "o2"});
+  Syft::SymbolicStateDfa first = Syft::SymbolicStateDfa::from_mona(var_mgr, dfa_of("F(o1 & X(i))"));
+  Syft::SymbolicStateDfa second = Syft::SymbolicStateDfa::from_mona(var_mgr, dfa_of("F(o2 & X(i))"));
+  CUDD::BDD first_cube = var_mgr->state_variables_cube(first.automaton_id());
+  Syft::SymbolicStateDfa arena = Syft::SymbolicStateDfa::product_AND({first, second});
+
+  std::vector<std::vector<CUDD::BDD>> components = Syft::AbstractionRefinement::state_bit_components(arena);
+  REQUIRE(components.size() >= 2);
+  std::size_t bits = 0;
+  for (const std::vector<CUDD::BDD>& component : components) {
+    std::size_t in_first = 0;
+    for (const CUDD::BDD& variable : component) {
+      in_first += first_cube.ExistAbstract(variable) != first_cube ? 1 : 0;
+    }
+    REQUIRE((in_first == 0 || in_first == component.size()));
+    bits += component.size();
+  }
+  REQUIRE(bits == arena.transition_function().size());
+}
@@ -0,0 +1,158 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "BatchRunner.h"
+
+namespace {
+  void write_file(const std::filesystem::path& path, const std::string& text) {
+    std::filesystem::create_directories(path.parent_path());
+    std::ofstream out(path);
+    out << text;
+  }
+
+  std::vector<Syft::BatchJob> numbered_jobs(std::size_t count) {
+    std::vector<Syft::BatchJob> jobs(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      jobs[i].id = "job" + std::to_string(i);
+      jobs[i].game_solver = static_cast<int>(i);
+    }
+    return jobs;
+  }
+
+  // Even jobs are realizable, and every third job fails
+  Syft::BatchResult fake_solve(const Syft::BatchJob& job) {
+    int n = *job.game_solver;
+    if (n % 3 == 2) {
+      throw std::runtime_error("job \"" + job.id + "\" failed");
+    }
+    Syft::BatchResult result;
+    result.verdict = n % 2 == 0 ? "REALIZABLE" : "UNREALIZABLE";
+    return result;
+  }
+}
+
+TEST_CASE("Batch manifest in JSONL", "[batch]")
+{
+  std::filesystem::path directory = std::filesystem::temp_directory_path() / "lydiasyft_test_batch_manifest";
+  std::filesystem::remove_all(directory);
+  write_file(directory / "jobs.jsonl",
+             "{\"formula\": \"specs/a.ltlfplus\", \"partition\": \"specs/a.part\"}\n"
+             "\n"
+             "{\"id\": \"b \\\"quoted\\\"\", \"formula\": \"/abs/b.ltlfplus\", \"partition\": \"b.part\", "
+             "\"starting_player\": 1, \"game_solver\": 2, \"obligation_simplification\": true, "
+             "\"buechi_mode\": \"pm\", \"time_limit\": 2.5}\n"
+             "{\"formula\": \"c.ltlfplus\", \"partition\": \"c.part\", \"obligation_simplification\": 0, "
+             "\"game_solver\": null}\n");
+
+  std::vector<Syft::BatchJob> jobs = Syft::read_batch_manifest((directory / "jobs.jsonl").string());
+  REQUIRE(jobs.size() == 3);
+  REQUIRE(jobs[0].id == "specs/a.ltlfplus");
+  REQUIRE(jobs[0].formula_file == (directory / "specs/a.ltlfplus").string());
+  REQUIRE(jobs[0].partition_file == (directory / "specs/a.part").string());
+  REQUIRE_FALSE(jobs[0].game_solver.has_value());
+  REQUIRE_FALSE(jobs[0].obligation_simplification.has_value());
+
+  REQUIRE(jobs[1].id == "b \"quoted\"");
+  REQUIRE(jobs[1].formula_file == "/abs/b.ltlfplus");
+  REQUIRE(jobs[1].starting_player == 1);
+  REQUIRE(jobs[1].game_solver == 2);
+  REQUIRE(jobs[1].obligation_simplification == true);
+  REQUIRE(jobs[1].buechi_mode == "pm");
+  REQUIRE(jobs[1].time_limit == 2.5);
+
+  REQUIRE(jobs[2].obligation_simplification == false);
+  REQUIRE_FALSE(jobs[2].game_solver.has_value());
+
+  write_file(directory / "bad.jsonl", "{\"formula\": \"a\", \"partition\": \"b\"}\n{\"formula\": \"a\", \"solver\": 1}\n");
+  REQUIRE_THROWS_AS(Syft::read_batch_manifest((directory / "bad.jsonl").string()), std::runtime_error);
+  write_file(directory / "truncated.jsonl", "{\"formula\": \"a\", \"partition\": \"b\"\n");
+  REQUIRE_THROWS_AS(Syft::read_batch_manifest((directory / "truncated.jsonl").string()), std::runtime_error);
+}
+
+TEST_CASE("Batch manifest as a directory", "[batch]")
+{
+  std::filesystem::path directory = std::filesystem::temp_directory_path() / "lydiasyft_test_batch_directory";
+  std::filesystem::remove_all(directory);
+  write_file(directory / "b.ltlfplus", "F(a)\n");
+  write_file(directory / "b.part", ".inputs: a\n.outputs: b\n");
+  write_file(directory / "nested" / "a.ltlfplus", "G(a)\n");
+  write_file(directory / "nested" / "a.part", ".inputs: a\n.outputs: b\n");
+  write_file(directory / "notes.txt", "not a job\n");
+
+  std::vector<Syft::BatchJob> jobs = Syft::read_batch_manifest(directory.string());
+  REQUIRE(jobs.size() == 2);
+  REQUIRE(jobs[0].id == "b");
+  REQUIRE(jobs[0].partition_file == (directory / "b.part").string());
+  REQUIRE(jobs[1].id == (std::filesystem::path("nested") / "a").string());
+
+  write_file(directory / "orphan.ltlfplus", "F(b)\n");
+  REQUIRE_THROWS_AS(Syft::read_batch_manifest(directory.string()), std::runtime_error);
+}
+
+TEST_CASE("Batch result as JSON", "[batch]")
+{
+  Syft::BatchResult result;
+  result.id = "a\\b";
+  result.verdict = "ERROR";
+  result.detail = "line\n\"x\"";
+  result.wall_time = 1.5;
+  REQUIRE(result.to_json() ==
+          "{\"id\": \"a\\\\b\", \"verdict\": \"ERROR\", \"wall_time\": 1.5, \"cpu_time\": 0, "
+          "\"detail\": \"line\\n\\\"x\\\"\"}");
+}
+
+TEST_CASE("Batch runner in one process and on workers", "[batch]")
+{
+  std::vector<Syft::BatchJob> jobs = numbered_jobs(7);
+  for (std::size_t workers : {1, 3}) {
+    std::vector<Syft::BatchResult> results;
+    std::size_t solved = Syft::BatchRunner(workers).run(jobs, fake_solve, [&](const Syft::BatchResult& result) {
+      results.push_back(result);
+    });
+    REQUIRE(solved == 5);
+    REQUIRE(results.size() == jobs.size());
+    std::sort(results.begin(), results.end(), [](const Syft::BatchResult& a, const Syft::BatchResult& b) {
+      return a.id < b.id;
+    });
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+      REQUIRE(results[i].id == jobs[i].id);
+      if (i % 3 == 2) {
+        REQUIRE(results[i].verdict == "ERROR");
+        // The message survives the pipe from the workers
+        REQUIRE(results[i].detail == "job \"" + jobs[i].id + "\" failed");
+      } else {
+        REQUIRE(results[i].verdict == (i % 2 == 0 ? "REALIZABLE" : "UNREALIZABLE"));
+      }
+    }
+  }
+}
+
+TEST_CASE("Batch worker that dies", "[batch]")
+{
+  std::vector<Syft::BatchJob> jobs = numbered_jobs(4);
+  std::vector<Syft::BatchResult> results;
+  // The worker of the odd jobs exits on its first job
+  std::size_t solved = Syft::BatchRunner(2).run(jobs, [](const Syft::BatchJob& job) {
+    if (*job.game_solver % 2 == 1) {
+      _exit(7);
+    }
+    Syft::BatchResult result;
+    result.verdict = "REALIZABLE";
+    return result;
+  }, [&](const Syft::BatchResult& result) {
+    results.push_back(result);
+  });
+  REQUIRE(solved == 2);
+  REQUIRE(results.size() == 4);
+  std::size_t errors = std::count_if(results.begin(), results.end(), [](const Syft::BatchResult& result) {
+    return result.verdict == "ERROR" && result.detail.find("status 7") != std::string::npos;
+  });
+  REQUIRE(errors == 2);
+}
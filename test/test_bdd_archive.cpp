@@ -0,0 +1,76 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <filesystem>
+#include <sstream>
+#include "automata/ExplicitStateDfa.h"
+#include "automata/SymbolicStateDfa.h"
+#include "BddArchive.h"
+#include "VarMgr.h"
+#include "lydia/parser/ltlf/driver.hpp"
+
+namespace {
+  Syft::ExplicitStateDfa dfa_of(const std::string& formula) {
+    whitemech::lydia::parsers::ltlf::LTLfDriver driver;
+    std::stringstream stream(formula);
+    driver.parse(stream);
+    auto parsed = std::static_pointer_cast<const whitemech::lydia::LTLfFormula>(driver.get_result());
+    return Syft::ExplicitStateDfa::dfa_of_formula(*parsed);
+  }
+}
+
+TEST_CASE("Symbolic DFA archive round trip", "[bddarchive]")
+{
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "lydiasyft_test_dfa.bdd";
+
+    std::shared_ptr<Syft::VarMgr> var_mgr = std::make_shared<Syft::VarMgr>();
+    Syft::SymbolicStateDfa dfa = Syft::SymbolicStateDfa::from_mona(var_mgr, dfa_of("G(a -> X(b)) & F(c)"));
+    var_mgr->partition_variables({"a", "c"}, {"b"});
+    dfa.save(path.string());
+
+    SECTION("Into the same variable manager") {
+        Syft::SymbolicStateDfa loaded = Syft::SymbolicStateDfa::load(var_mgr, path.string());
+        REQUIRE(loaded.automaton_id() != dfa.automaton_id());
+        REQUIRE(loaded.initial_state() == dfa.initial_state());
+
+        // Renaming the fresh state variables gives back the saved BDDs
+        std::vector<CUDD::BDD> state_vars = var_mgr->get_state_variables(dfa.automaton_id());
+        std::vector<CUDD::BDD> loaded_vars = var_mgr->get_state_variables(loaded.automaton_id());
+        REQUIRE(loaded.final_states().SwapVariables(loaded_vars, state_vars) == dfa.final_states());
+        std::vector<CUDD::BDD> transition_function = dfa.transition_function();
+        std::vector<CUDD::BDD> loaded_function = loaded.transition_function();
+        REQUIRE(loaded_function.size() == transition_function.size());
+        for (std::size_t i = 0; i < transition_function.size(); ++i) {
+            REQUIRE(loaded_function[i].SwapVariables(loaded_vars, state_vars) == transition_function[i]);
+        }
+    }
+
+    SECTION("Into a manager without the alphabet") {
+        std::shared_ptr<Syft::VarMgr> other = std::make_shared<Syft::VarMgr>();
+        other->create_named_variables({"a"});
+        REQUIRE_THROWS_AS(Syft::SymbolicStateDfa::load(other, path.string()), std::runtime_error);
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("EL synthesis result archive round trip", "[bddarchive]")
+{
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "lydiasyft_test_el_result.bdd";
+
+    std::shared_ptr<Syft::VarMgr> var_mgr = std::make_shared<Syft::VarMgr>();
+    Syft::SymbolicStateDfa dfa = Syft::SymbolicStateDfa::from_mona(var_mgr, dfa_of("F(a & X(b))"));
+    var_mgr->partition_variables({"a"}, {"b"});
+
+    Syft::ELSynthesisResult result;
+    result.realizability = true;
+    result.winning_states = dfa.final_states() | dfa.initial_state_bdd();
+    Syft::save_el_synthesis_result(path.string(), var_mgr, dfa.automaton_id(), result);
+
+    Syft::ELSynthesisResult loaded;
+    loaded.realizability = false;
+    Syft::load_el_synthesis_result(path.string(), var_mgr, dfa.automaton_id(), loaded);
+    REQUIRE(loaded.realizability);
+    REQUIRE(loaded.winning_states == result.winning_states);
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,128 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "BddBackend.h"
+#include "VarMgr.h"
+
+namespace {
+  // The last iterate of fixpoint, by the operations of CUDD
+  CUDD::BDD cudd_least_fixpoint(const Syft::ControllableFixpoint& fixpoint) {
+    CUDD::BDD iterate = fixpoint.start;
+    for (std::size_t step = 1; ; ++step) {
+      CUDD::BDD predecessors = iterate.VectorCompose(fixpoint.vector);
+      for (const Syft::BddQuantifier& quantifier : fixpoint.quantifiers) {
+        predecessors = quantifier.universal ? predecessors.UnivAbstract(quantifier.cube)
+                                            : predecessors.ExistAbstract(quantifier.cube);
+      }
+      CUDD::BDD next = iterate | (fixpoint.care & predecessors);
+      if (next == iterate || !(next & fixpoint.stop).IsZero() || step == fixpoint.max_steps) {
+        return next;
+      }
+      iterate = next;
+    }
+  }
+
+  // Every operation of backend agrees with CUDD on BDDs over a, b and c
+  void require_agrees_with_cudd(const Syft::BddBackend& backend, Syft::VarMgr& var_mgr) {
+    CUDD::BDD a = var_mgr.name_to_variable("a");
+    CUDD::BDD b = var_mgr.name_to_variable("b");
+    CUDD::BDD c = var_mgr.name_to_variable("c");
+    CUDD::BDD f = (a & !b) | c;
+    CUDD::BDD g = a.Xnor(c);
+
+    REQUIRE(backend.And(f, g) == (f & g));
+    REQUIRE(backend.Or(f, !g) == (f | !g));
+    REQUIRE(backend.ExistAbstract(f, a & c) == f.ExistAbstract(a & c));
+    REQUIRE(backend.UnivAbstract(f, b) == f.UnivAbstract(b));
+    REQUIRE(backend.AndAbstract(f, g, c) == f.AndAbstract(g, c));
+
+    std::vector<CUDD::BDD> vector = {a, b, c};
+    vector[a.NodeReadIndex()] = b | c;
+    vector[c.NodeReadIndex()] = !a;
+    REQUIRE(backend.VectorCompose(f, vector) == f.VectorCompose(vector));
+
+    std::vector<int> assignment(3, 0);
+    assignment[c.NodeReadIndex()] = 1;
+    REQUIRE(backend.Eval(f, assignment));
+    REQUIRE_FALSE(backend.Eval(g, assignment));
+
+    std::size_t iterations = 0;
+    Syft::ControllableFixpoint fixpoint;
+    fixpoint.start = a & b & !c;
+    fixpoint.care = !b | c;
+    fixpoint.vector = {a, b, c};
+    fixpoint.vector[a.NodeReadIndex()] = b.Xnor(c);
+    fixpoint.vector[b.NodeReadIndex()] = a | c;
+    fixpoint.quantifiers = {Syft::BddQuantifier{true, c}, Syft::BddQuantifier{false, b}};
+    fixpoint.stop = var_mgr.cudd_mgr()->bddZero();
+    fixpoint.on_iteration = [&iterations]() { iterations++; };
+    REQUIRE(backend.LeastFixpoint(fixpoint) == cudd_least_fixpoint(fixpoint));
+    REQUIRE(iterations > 0);
+    fixpoint.stop = !a & !b;
+    REQUIRE(backend.LeastFixpoint(fixpoint) == cudd_least_fixpoint(fixpoint));
+    fixpoint.stop = var_mgr.cudd_mgr()->bddZero();
+    fixpoint.max_steps = 1;
+    REQUIRE(backend.LeastFixpoint(fixpoint) == cudd_least_fixpoint(fixpoint));
+  }
+}
+
+TEST_CASE("BDD backends by name", "[bddbackend]")
+{
+  REQUIRE(Syft::bdd_backend_from_string("cudd") == Syft::BddBackendKind::Cudd);
+  REQUIRE_THROWS_AS(Syft::bdd_backend_from_string("buddy"), std::runtime_error);
+#ifdef LYDIASYFT_WITH_SYLVAN
+  REQUIRE(Syft::bdd_backend_from_string("sylvan") == Syft::BddBackendKind::Sylvan);
+#else
+  REQUIRE_THROWS_AS(Syft::bdd_backend_from_string("sylvan"), std::runtime_error);
+#endif
+}
+
+TEST_CASE("The CUDD backend runs the operations in the manager", "[bddbackend]")
+{
+  Syft::VarMgr var_mgr;
+  var_mgr.create_named_variables({"a", "b", "c"});
+  REQUIRE(var_mgr.bdd_backend().name() == "cudd");
+  REQUIRE(var_mgr.bdd_backend().threads() == 1);
+  require_agrees_with_cudd(var_mgr.bdd_backend(), var_mgr);
+  REQUIRE(var_mgr.clone()->bdd_backend().name() == "cudd");
+}
+
+#ifdef LYDIASYFT_WITH_SYLVAN
+TEST_CASE("The Sylvan backend agrees with CUDD", "[bddbackend]")
+{
+  Syft::VarMgrOptions options;
+  options.bdd_backend = Syft::BddBackendKind::Sylvan;
+  options.bdd_threads = 2;
+  Syft::VarMgr var_mgr(options);
+  var_mgr.create_named_variables({"a", "b", "c"});
+  REQUIRE(var_mgr.bdd_backend().name() == "sylvan");
+  require_agrees_with_cudd(var_mgr.bdd_backend(), var_mgr);
+
+  // The translations follow the order of the manager
+  var_mgr.cudd_mgr()->ReduceHeap(CUDD_REORDER_RANDOM);
+  require_agrees_with_cudd(var_mgr.bdd_backend(), var_mgr);
+  REQUIRE(var_mgr.clone()->bdd_backend().name() == "sylvan");
+}
+
+TEST_CASE("The Sylvan backend translates BDDs deeper than the call stack", "[bddbackend]")
+{
+  Syft::VarMgrOptions options;
+  options.bdd_backend = Syft::BddBackendKind::Sylvan;
+  Syft::VarMgr var_mgr(options);
+  std::vector<std::string> names;
+  for (int i = 0; i < 100000; ++i) {
+    names.push_back("x" + std::to_string(i));
+  }
+  var_mgr.create_named_variables(names);
+  // Built from the bottom, so that CUDD only adds one node on top at a time
+  CUDD::BDD cube = var_mgr.cudd_mgr()->bddOne();
+  for (auto name = names.rbegin(); name != names.rend(); ++name) {
+    cube = var_mgr.name_to_variable(*name) & cube;
+  }
+  REQUIRE(var_mgr.bdd_backend().And(cube, cube) == cube);
+  REQUIRE(var_mgr.bdd_backend().And(cube, !cube).IsZero());
+}
+#endif
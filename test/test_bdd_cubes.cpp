@@ -0,0 +1,61 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <stdexcept>
+#include <vector>
+#include "BddCubes.h"
+#include "VarMgr.h"
+
+TEST_CASE("The cubes of a BDD cover it disjointly", "[bddcubes]")
+{
+  Syft::VarMgr var_mgr;
+  var_mgr.create_named_variables({"a", "b", "c"});
+  CUDD::BDD a = var_mgr.name_to_variable("a");
+  CUDD::BDD b = var_mgr.name_to_variable("b");
+  CUDD::BDD c = var_mgr.name_to_variable("c");
+  std::vector<CUDD::BDD> variables = {a, b, c};
+  CUDD::BDD f = (a & !b) | c;
+
+  CUDD::BDD covered = var_mgr.cudd_mgr()->bddZero();
+  for (const int* cube : Syft::BddCubes(f)) {
+    CUDD::BDD term = var_mgr.cudd_mgr()->bddOne();
+    for (const CUDD::BDD& variable : variables) {
+      int value = cube[variable.NodeReadIndex()];
+      if (value != 2) {
+        term &= value == 1 ? variable : !variable;
+      }
+    }
+    REQUIRE((covered & term).IsZero());
+    covered |= term;
+  }
+  REQUIRE(covered == f);
+
+  Syft::BddCubes none(var_mgr.cudd_mgr()->bddZero());
+  REQUIRE(none.empty());
+  REQUIRE(none.begin() == none.end());
+
+  // Stopping early frees the generator as well
+  for (const int* cube : Syft::BddCubes(f)) {
+    REQUIRE(cube != nullptr);
+    break;
+  }
+}
+
+TEST_CASE("Minterms picked over a subset of the variables", "[bddcubes]")
+{
+  Syft::VarMgr var_mgr;
+  var_mgr.create_named_variables({"a", "b", "c"});
+  CUDD::BDD a = var_mgr.name_to_variable("a");
+  CUDD::BDD b = var_mgr.name_to_variable("b");
+  CUDD::BDD c = var_mgr.name_to_variable("c");
+  Syft::MintermPicker picker(var_mgr.cudd_mgr(), {a, b});
+
+  for (const CUDD::BDD& f : {a & !b, (a & c) | (!a & b & !c), c}) {
+    CUDD::BDD minterm = picker.pick(f);
+    REQUIRE(minterm.CountMinterm(2) == 1);
+    REQUIRE(!(minterm & f).IsZero());
+    // Deterministic, with the variables the first cube leaves out set to true
+    REQUIRE(minterm == picker.pick(f));
+  }
+  REQUIRE(picker.pick(c) == (a & b));
+  REQUIRE_THROWS_AS(picker.pick(var_mgr.cudd_mgr()->bddZero()), std::runtime_error);
+}
@@ -0,0 +1,43 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <filesystem>
+#include <stdexcept>
+#include "BenchmarkFamilies.h"
+#include "synthesizer/LTLfPlusSynthesizer.h"
+
+TEST_CASE("Benchmark families have their known verdicts", "[families]")
+{
+  for (const Syft::BenchmarkFamily& family : Syft::benchmark_families()) {
+    for (std::size_t size : {1, 2}) {
+      Syft::BenchmarkInstance instance = family.generate(size);
+      INFO("instance: " << instance.id() << " formula: " << instance.formula);
+      REQUIRE(instance.family == family.name);
+      for (Syft::Player starting_player : {Syft::Player::Agent, Syft::Player::Environment}) {
+        Syft::FuzzSpec spec = Syft::parse_instance(instance, starting_player);
+        REQUIRE(spec.obligation == instance.obligation);
+        Syft::LTLfPlusSynthesizer synthesizer(spec.ltlf_plus, spec.partition, starting_player, Syft::Player::Agent,
+                                              Syft::VarMgrOptions(), Syft::DfaConstructionOptions());
+        REQUIRE(synthesizer.run().realizability == instance.realizable);
+      }
+    }
+  }
+  REQUIRE_THROWS_AS(Syft::benchmark_family("unknown"), std::runtime_error);
+  REQUIRE_THROWS_AS(Syft::benchmark_family("counter").generate(0), std::runtime_error);
+}
+
+TEST_CASE("Benchmark instances are written as formula and partition files", "[families]")
+{
+  std::filesystem::path directory = std::filesystem::temp_directory_path() / "lydiasyft_test_families";
+  std::filesystem::remove_all(directory);
+  Syft::BenchmarkInstance instance = Syft::benchmark_family("gr1").generate(3);
+  REQUIRE(instance.id() == "gr1/3");
+
+  std::filesystem::path formula = Syft::write_instance(instance, directory.string());
+  REQUIRE(formula == directory / "gr1" / "gr1_3.ltlfplus");
+  REQUIRE(std::filesystem::exists(formula));
+  Syft::InputOutputPartition partition =
+      Syft::InputOutputPartition::read_from_file((directory / "gr1" / "gr1_3.part").string());
+  REQUIRE(partition.input_variables == instance.partition.input_variables);
+  REQUIRE(partition.output_variables == instance.partition.output_variables);
+  std::filesystem::remove_all(directory);
+}
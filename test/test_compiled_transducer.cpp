@@ -0,0 +1,178 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "VarMgr.h"
+#include "game/CompiledTransducer.h"
+#include "game/TransducerCodegen.h"
+#include "game/Transducer.h"
+
+namespace {
+  struct Controller {
+    std::shared_ptr<Syft::VarMgr> var_mgr;
+    std::unordered_map<int, CUDD::BDD> output_function;
+    std::vector<CUDD::BDD> transition_function;
+    std::vector<CUDD::BDD> state_variables;
+    std::vector<int> initial_vector;
+  };
+
+  // Outputs b = z0 xor z1 and c = z0 & a; next state z0' = a xor b, z1' = z0; initially z0 = 1, z1 = 0
+  Controller make_controller() {
+    Controller controller;
+    controller.var_mgr = std::make_shared<Syft::VarMgr>();
+    auto& var_mgr = controller.var_mgr;
+    var_mgr->create_named_variables({"a", "b", "c"});
+    var_mgr->partition_variables({"a"}, {"b", "c"});
+    std::size_t id = var_mgr->create_state_variables(2);
+    CUDD::BDD a = var_mgr->name_to_variable("a");
+    CUDD::BDD b = var_mgr->name_to_variable("b");
+    CUDD::BDD c = var_mgr->name_to_variable("c");
+    CUDD::BDD z0 = var_mgr->state_variable(id, 0);
+    CUDD::BDD z1 = var_mgr->state_variable(id, 1);
+    controller.output_function = {{b.NodeReadIndex(), z0 ^ z1}, {c.NodeReadIndex(), z0 & a}};
+    controller.transition_function = {a ^ b, z0};
+    controller.state_variables = {z0, z1};
+    controller.initial_vector.assign(var_mgr->total_variable_count(), 0);
+    controller.initial_vector[z0.NodeReadIndex()] = 1;
+    return controller;
+  }
+}
+
+TEST_CASE("Compiled transducer steps like its BDDs", "[transducer]")
+{
+    Controller controller = make_controller();
+    Syft::Transducer transducer(controller.var_mgr, controller.initial_vector, controller.output_function,
+                                controller.transition_function, Syft::Player::Environment, Syft::Player::Agent,
+                                controller.state_variables);
+    Syft::CompiledTransducer compiled(transducer);
+    REQUIRE(compiled.input_count() == 1);
+    REQUIRE(compiled.output_count() == 2);
+    REQUIRE(compiled.state_bit_count() == 2);
+    REQUIRE(compiled.tabulated_count() == 4);
+
+    int a = controller.var_mgr->name_to_variable("a").NodeReadIndex();
+    int b = controller.var_mgr->name_to_variable("b").NodeReadIndex();
+    int c = controller.var_mgr->name_to_variable("c").NodeReadIndex();
+    std::vector<int> valuation = controller.initial_vector;
+
+    std::mt19937 random(7);
+    std::vector<std::uint8_t> inputs;
+    Syft::CompiledTransducer::Instance instance = compiled.make_instance();
+    Syft::CompiledTransducer::Batch batch = compiled.make_batch(70);
+    for (int t = 0; t < 20; ++t) {
+        std::uint8_t input = random() & 1;
+        inputs.push_back(input);
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            batch.set_input(i, 0, i == 69 ? input : 0);
+        }
+        compiled.step(batch);
+
+        valuation[a] = input;
+        valuation[b] = controller.output_function.at(b).Eval(valuation.data()).IsOne();
+        valuation[c] = controller.output_function.at(c).Eval(valuation.data()).IsOne();
+        std::vector<int> next;
+        for (const CUDD::BDD& bit : controller.transition_function) {
+            next.push_back(bit.Eval(valuation.data()).IsOne());
+        }
+
+        std::uint8_t outputs[2];
+        compiled.step(instance, &input, outputs);
+        REQUIRE(outputs[0] == valuation[b]);
+        REQUIRE(outputs[1] == valuation[c]);
+        REQUIRE(batch.output(69, 0) == (valuation[b] != 0));
+        REQUIRE(batch.output(69, 1) == (valuation[c] != 0));
+
+        for (std::size_t k = 0; k < next.size(); ++k) {
+            valuation[controller.state_variables[k].NodeReadIndex()] = next[k];
+        }
+        std::vector<bool> state = instance.state();
+        REQUIRE(state == std::vector<bool>{next[0] != 0, next[1] != 0});
+        REQUIRE(batch.state(69) == state);
+    }
+
+    // The other instances only ever read false inputs
+    Syft::CompiledTransducer::Instance idle = compiled.make_instance();
+    std::uint8_t input = 0;
+    std::uint8_t outputs[2];
+    for (int t = 0; t < 20; ++t) {
+        compiled.step(idle, &input, outputs);
+    }
+    REQUIRE(batch.state(0) == idle.state());
+    REQUIRE(batch.state(64) == idle.state());
+}
+
+TEST_CASE("Compiled transducer needs the updated state variables", "[transducer]")
+{
+    Controller controller = make_controller();
+    Syft::Transducer transducer(controller.var_mgr, controller.initial_vector, controller.output_function,
+                                controller.transition_function, Syft::Player::Environment);
+    REQUIRE_THROWS_AS(Syft::CompiledTransducer(transducer), std::runtime_error);
+}
+
+TEST_CASE("Transducers are exported to C and Verilog", "[transducer]")
+{
+    Controller controller = make_controller();
+    Syft::Transducer transducer(controller.var_mgr, controller.initial_vector, controller.output_function,
+                                controller.transition_function, Syft::Player::Environment, Syft::Player::Agent,
+                                controller.state_variables);
+    Syft::TransducerCodegen codegen(transducer);
+    const Syft::CodegenReport& report = codegen.report();
+    REQUIRE(report.bdd_nodes > 0);
+    REQUIRE(report.circuit_nodes >= report.temporaries);
+
+    std::string c = codegen.to_c("controller");
+    REQUIRE(c.find("void controller_step(controller_state* s, const uint8_t* in, uint8_t* out)") != std::string::npos);
+    REQUIRE(c.find("s->state[0] = 1;") != std::string::npos);
+    REQUIRE(c.find("out[1] = ") != std::string::npos);
+    REQUIRE(c.find("next[1] = ") != std::string::npos);
+
+    std::string verilog = codegen.to_verilog("controller");
+    REQUIRE(verilog.find("module controller (") != std::string::npos);
+    REQUIRE(verilog.find("if (rst) state <= 2'b01;") != std::string::npos);
+    REQUIRE(verilog.find("assign out[0] = ") != std::string::npos);
+    REQUIRE(verilog.find("endmodule") != std::string::npos);
+
+    REQUIRE_THROWS_AS(codegen.to_c("1st"), std::runtime_error);
+}
+
+TEST_CASE("Compiled transducers are saved and mapped back", "[transducer]")
+{
+    Controller controller = make_controller();
+    Syft::Transducer transducer(controller.var_mgr, controller.initial_vector, controller.output_function,
+                                controller.transition_function, Syft::Player::Environment, Syft::Player::Agent,
+                                controller.state_variables);
+    Syft::CompiledTransducer compiled(transducer);
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "lydiasyft_test_controller.bin";
+    compiled.save(path.string());
+
+    Syft::CompiledTransducer loaded = Syft::CompiledTransducer::load(path.string());
+    REQUIRE(loaded.input_labels() == std::vector<std::string>{"a"});
+    REQUIRE(loaded.output_labels() == std::vector<std::string>{"b", "c"});
+    REQUIRE(loaded.node_count() == compiled.node_count());
+    REQUIRE(loaded.tabulated_count() == compiled.tabulated_count());
+
+    Syft::CompiledTransducer::Instance original = compiled.make_instance();
+    Syft::CompiledTransducer::Instance mapped = loaded.make_instance();
+    for (std::uint8_t input : {1, 0, 0, 1, 1, 0}) {
+        std::uint8_t expected[2], outputs[2];
+        compiled.step(original, &input, expected);
+        loaded.step(mapped, &input, outputs);
+        REQUIRE(outputs[0] == expected[0]);
+        REQUIRE(outputs[1] == expected[1]);
+        REQUIRE(mapped.state() == original.state());
+    }
+
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << "not a controller";
+    }
+    REQUIRE_THROWS_AS(Syft::CompiledTransducer::load(path.string()), std::runtime_error);
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,109 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include "automata/DfaBackendSelector.h"
+#include "automata/ExplicitStateDfa.h"
+#include "lydia/parser/ltlf/driver.hpp"
+
+namespace {
+  std::shared_ptr<const whitemech::lydia::LTLfFormula> parse(const std::string& formula) {
+    whitemech::lydia::parsers::ltlf::LTLfDriver driver;
+    std::stringstream stream(formula);
+    driver.parse(stream);
+    return std::static_pointer_cast<const whitemech::lydia::LTLfFormula>(driver.get_result());
+  }
+
+  int minimal_states(const Syft::ExplicitStateDfa& dfa) {
+    return Syft::ExplicitStateDfa::dfa_minimize(dfa).get_nb_states();
+  }
+}
+
+TEST_CASE("The shape of a formula", "[dfa_backend]")
+{
+  Syft::FormulaShape shape = Syft::formula_shape(*parse("G(a -> X(b)) & G(b -> X(c)) & F(c)"));
+  REQUIRE(shape.conjunction);
+  REQUIRE(shape.junction_arity == 3);
+  REQUIRE(shape.temporal_operators == 5);
+  // G and the weak X
+  REQUIRE(shape.universal_operators == 4);
+  REQUIRE(shape.temporal_depth == 2);
+
+  REQUIRE(Syft::formula_shape(*parse("a & b")).temporal_operators == 0);
+  REQUIRE(Syft::formula_shape(*parse("F(G(a U b))")).temporal_depth == 3);
+}
+
+TEST_CASE("Candidate backends follow the shape of the formula", "[dfa_backend]")
+{
+  Syft::DfaBackendSelector selector;
+  REQUIRE(selector.candidates(Syft::formula_shape(*parse("a & b"))) ==
+          std::vector<Syft::DfaBackend>{Syft::DfaBackend::Compositional});
+  REQUIRE(selector.candidates(Syft::formula_shape(*parse("G(a -> X(b)) & G(b -> X(c)) & F(c)"))).front() ==
+          Syft::DfaBackend::Decomposed);
+  REQUIRE(selector.candidates(Syft::formula_shape(*parse("G(a) | G(b)"))).front() ==
+          Syft::DfaBackend::Complemented);
+  REQUIRE(selector.candidates(Syft::formula_shape(*parse("F(a & X(F(b)))"))).front() ==
+          Syft::DfaBackend::Compositional);
+}
+
+TEST_CASE("Every backend builds a DFA of the formula", "[dfa_backend]")
+{
+  for (const std::string& formula : {"G(a -> X(b)) & G(b -> X(c)) & F(c)", "G(a) | F(b & X(c))", "a U (b & X[!](c))"}) {
+    INFO("formula: " << formula);
+    auto parsed = parse(formula);
+    int expected = minimal_states(Syft::ExplicitStateDfa::dfa_of_formula(*parsed));
+    for (Syft::DfaBackend backend : {Syft::DfaBackend::Compositional, Syft::DfaBackend::Complemented,
+                                     Syft::DfaBackend::Decomposed}) {
+      INFO("backend: " << Syft::to_string(backend));
+      REQUIRE(minimal_states(Syft::DfaBackendSelector::build_with(backend, *parsed)) == expected);
+    }
+  }
+}
+
+TEST_CASE("Candidate backends race in forked processes", "[dfa_backend]")
+{
+  Syft::DfaBackendOptions options;
+  options.race_min_size = 0;
+  Syft::DfaBackendSelector selector(options);
+  auto parsed = parse("G(a -> X(b)) & G(b -> X(c)) & F(c)");
+  std::vector<Syft::DfaBackend> candidates = selector.candidates(Syft::formula_shape(*parsed));
+
+  Syft::DfaBackend winner;
+  Syft::ExplicitStateDfa dfa = selector.build(*parsed, &winner);
+  REQUIRE(std::find(candidates.begin(), candidates.end(), winner) != candidates.end());
+  REQUIRE(minimal_states(dfa) == minimal_states(Syft::ExplicitStateDfa::dfa_of_formula(*parsed)));
+
+  // A fixed backend never races
+  options.backend = Syft::DfaBackend::Complemented;
+  Syft::DfaBackendSelector fixed(options);
+  fixed.build(*parsed, &winner);
+  REQUIRE(winner == Syft::DfaBackend::Complemented);
+  REQUIRE(Syft::parse_dfa_backend("decomposed") == Syft::DfaBackend::Decomposed);
+  REQUIRE_FALSE(Syft::parse_dfa_backend("auto").has_value());
+}
+
+TEST_CASE("Candidate backends do not race while other threads run", "[dfa_backend]")
+{
+  Syft::DfaBackendOptions options;
+  options.race_min_size = 0;
+  Syft::DfaBackendSelector selector(options);
+  auto parsed = parse("G(a -> X(b)) & G(b -> X(c)) & F(c)");
+  std::vector<Syft::DfaBackend> candidates = selector.candidates(Syft::formula_shape(*parsed));
+  REQUIRE(candidates.size() > 1);
+
+  std::promise<void> release;
+  std::thread other([finished = release.get_future()]() { finished.wait(); });
+  Syft::DfaBackend winner;
+  Syft::ExplicitStateDfa dfa = selector.build(*parsed, &winner);
+  release.set_value();
+  other.join();
+  // Built in process by the preferred backend, where /proc shows the threads
+  if (std::filesystem::exists("/proc/self/task")) {
+    REQUIRE(winner == candidates.front());
+  }
+  REQUIRE(minimal_states(dfa) == minimal_states(Syft::ExplicitStateDfa::dfa_of_formula(*parsed)));
+}
@@ -0,0 +1,70 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <filesystem>
+#include <sstream>
+#include <stdexcept>
+#include "automata/DfaCache.h"
+#include "lydia/parser/ltlf/driver.hpp"
+
+namespace {
+  whitemech::lydia::ltlf_ptr parse_ltlf(const std::string& formula) {
+    whitemech::lydia::parsers::ltlf::LTLfDriver driver;
+    std::stringstream stream(formula);
+    driver.parse(stream);
+    return std::static_pointer_cast<const whitemech::lydia::LTLfFormula>(driver.get_result());
+  }
+}
+
+TEST_CASE("DFA cache round trip", "[dfacache]")
+{
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "lydiasyft_test_dfa_cache";
+    std::filesystem::remove_all(directory);
+
+    whitemech::lydia::ltlf_ptr formula = parse_ltlf("F(a & X(b))");
+    std::string key = Syft::DfaCache::cache_key("dfa", *formula);
+    REQUIRE(key != Syft::DfaCache::cache_key("dfa_to_Gdfa", *formula));
+
+    int built = 0;
+    auto build = [&]() {
+        ++built;
+        return Syft::ExplicitStateDfa::dfa_of_formula(*formula);
+    };
+
+    Syft::ExplicitStateDfa first = Syft::DfaCache(directory.string()).get_or_build(key, build);
+    REQUIRE(built == 1);
+
+    // A fresh cache on the same directory reads the stored entry
+    Syft::DfaCache cache(directory.string());
+    Syft::ExplicitStateDfa second = cache.get_or_build(key, build);
+    REQUIRE(built == 1);
+    REQUIRE(second.get_nb_states() == first.get_nb_states());
+    REQUIRE(second.names == first.names);
+    REQUIRE(second.get_final() == first.get_final());
+    REQUIRE(second.get_initial() == first.get_initial());
+
+    REQUIRE_FALSE(cache.load("dfa:" + key).has_value());
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("DFA cache in memory", "[dfacache]")
+{
+    whitemech::lydia::ltlf_ptr formula = parse_ltlf("G(a | b)");
+    std::string key = Syft::DfaCache::cache_key("dfa", *formula);
+    int built = 0;
+    auto build = [&]() {
+        ++built;
+        return Syft::ExplicitStateDfa::dfa_of_formula(*formula);
+    };
+
+    REQUIRE_THROWS_AS(Syft::DfaCache(""), std::runtime_error);
+    Syft::DfaCache cache("", true);
+    Syft::ExplicitStateDfa first = cache.get_or_build(key, build);
+    Syft::ExplicitStateDfa second = cache.get_or_build(key, build);
+    REQUIRE(built == 1);
+    REQUIRE(cache.memory_entries() == 1);
+    // Each caller gets a copy of its own
+    REQUIRE(second.get_dfa() != first.get_dfa());
+    REQUIRE(second.get_nb_states() == first.get_nb_states());
+    REQUIRE_FALSE(cache.load(key).has_value());
+}
@@ -0,0 +1,111 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <map>
+#include <memory>
+#include <sstream>
+#include "automata/DfaSymmetry.h"
+#include "automata/ExplicitStateDfa.h"
+#include "automata/SymbolicStateDfa.h"
+#include "automata/SymmetryQuotient.h"
+#include "game/ColorFormula.h"
+#include "VarMgr.h"
+#include "lydia/parser/ltlf/driver.hpp"
+
+namespace {
+  Syft::SharedExplicitStateDfa dfa_of(const std::string& formula) {
+    whitemech::lydia::parsers::ltlf::LTLfDriver driver;
+    std::stringstream stream(formula);
+    driver.parse(stream);
+    auto parsed = std::static_pointer_cast<const whitemech::lydia::LTLfFormula>(driver.get_result());
+    return std::make_shared<Syft::ExplicitStateDfa>(Syft::ExplicitStateDfa::dfa_of_formula(*parsed));
+  }
+
+  // The a atoms are inputs and the b atoms outputs
+  std::shared_ptr<Syft::VarMgr> var_mgr_of_two_clients() {
+    auto var_mgr = std::make_shared<Syft::VarMgr>();
+    var_mgr->create_named_variables({"a1", "b1", "a2", "b2"});
+    var_mgr->partition_variables({"a1", "a2"}, {"b1", "b2"});
+    return var_mgr;
+  }
+}
+
+TEST_CASE("Atom renamings between isomorphic DFAs", "[symmetry]")
+{
+  std::shared_ptr<Syft::VarMgr> var_mgr = var_mgr_of_two_clients();
+  Syft::SharedExplicitStateDfa first = dfa_of("F(a1 & X(b1))");
+  Syft::SharedExplicitStateDfa second = dfa_of("F(a2 & X(b2))");
+
+  auto renaming = Syft::find_atom_renaming(*first, *second, *var_mgr);
+  REQUIRE(renaming.has_value());
+  std::map<std::string, std::string> image;
+  for (std::size_t i = 0; i < first->names.size(); ++i) {
+    image[first->names[i]] = (*renaming)[i];
+  }
+  REQUIRE(image["a1"] == "a2");
+  REQUIRE(image["b1"] == "b2");
+
+  // Not the same language, and inputs are not renamed into outputs
+  REQUIRE_FALSE(Syft::find_atom_renaming(*first, *dfa_of("F(a2 | X(b2))"), *var_mgr).has_value());
+  REQUIRE_FALSE(Syft::find_atom_renaming(*first, *dfa_of("F(b2 & X(a2))"), *var_mgr).has_value());
+}
+
+TEST_CASE("Orbits of colors the formula does not tell apart", "[symmetry]")
+{
+  std::shared_ptr<Syft::VarMgr> var_mgr = var_mgr_of_two_clients();
+  std::map<int, Syft::SharedExplicitStateDfa> color_to_dfa = {
+    {0, dfa_of("F(a1 & X(b1))")},
+    {1, dfa_of("F(a2 & X(b2))")}};
+
+  std::vector<Syft::ColorOrbit> orbits = Syft::find_color_orbits(color_to_dfa, Syft::ColorFormula("0 & 1"), *var_mgr);
+  REQUIRE(orbits.size() == 1);
+  REQUIRE(orbits[0].colors == std::vector<int>{0, 1});
+  REQUIRE(orbits[0].atoms.size() == 2);
+
+  REQUIRE(Syft::find_color_orbits(color_to_dfa, Syft::ColorFormula("0 & !1"), *var_mgr).empty());
+}
+
+TEST_CASE("The symmetry quotient keeps one state per class of permuted states", "[symmetry]")
+{
+  std::shared_ptr<Syft::VarMgr> var_mgr = var_mgr_of_two_clients();
+  std::map<int, Syft::SharedExplicitStateDfa> color_to_dfa = {
+    {0, dfa_of("F(a1 & X(b1))")},
+    {1, dfa_of("F(a2 & X(b2))")}};
+  std::vector<Syft::ColorOrbit> orbits = Syft::find_color_orbits(color_to_dfa, Syft::ColorFormula("0 & 1"), *var_mgr);
+  REQUIRE(orbits.size() == 1);
+
+  Syft::SymbolicStateDfa representative = Syft::SymbolicStateDfa::from_mona(var_mgr, *color_to_dfa.at(0));
+  Syft::SymbolicStateDfa copy = Syft::SymbolicStateDfa::from_mona(
+      var_mgr, Syft::rename_atoms(*color_to_dfa.at(0), orbits[0].atoms[1]));
+  std::vector<std::vector<CUDD::BDD>> variables = {
+    var_mgr->get_state_variables(representative.automaton_id()),
+    var_mgr->get_state_variables(copy.automaton_id())};
+  CUDD::BDD final_states = representative.final_states() & copy.final_states();
+
+  Syft::SymbolicStateDfa product = Syft::SymbolicStateDfa::product_AND({representative, copy});
+  Syft::SymmetryQuotient quotient({representative, copy}, {0, 1}, final_states, orbits);
+
+  int bits = static_cast<int>(quotient.arena().transition_function().size());
+  CUDD::BDD reachable = quotient.arena().reachable_states();
+  REQUIRE((reachable & !quotient.canonical_states()).IsZero());
+  REQUIRE(reachable.CountMinterm(bits) < product.reachable_states().CountMinterm(bits));
+
+  // The member with the larger code moves to the place of the other, along with its atoms
+  std::vector<int> assignment(var_mgr->total_variable_count(), 0);
+  for (const CUDD::BDD& variable : variables[0]) {
+    assignment[variable.NodeReadIndex()] = 1;
+  }
+  assignment[var_mgr->name_to_variable("a1").NodeReadIndex()] = 1;
+  std::vector<int> canonical = Syft::SymmetryQuotient::permute(assignment, quotient.canonical_permutation(assignment));
+  REQUIRE(quotient.canonical_states().Eval(canonical.data()).IsOne());
+  REQUIRE(canonical[var_mgr->name_to_variable("a2").NodeReadIndex()] == 1);
+  REQUIRE(canonical[var_mgr->name_to_variable("a1").NodeReadIndex()] == 0);
+
+  // A move chosen in the canonical state is played by the permuted atom
+  std::vector<int> lifted = quotient.lift_move(assignment, [&](const std::vector<int>& state) {
+    std::vector<int> move = state;
+    move[var_mgr->name_to_variable("b2").NodeReadIndex()] = 1;
+    return move;
+  });
+  REQUIRE(lifted[var_mgr->name_to_variable("b1").NodeReadIndex()] == 1);
+  REQUIRE(lifted[var_mgr->name_to_variable("b2").NodeReadIndex()] == 0);
+}
@@ -0,0 +1,79 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include "DifferentialFuzzer.h"
+#include "SolveBudget.h"
+
+TEST_CASE("Random specs are reproducible and parse", "[fuzzer]")
+{
+  Syft::RandomSpecGenerator first(7, 4);
+  Syft::RandomSpecGenerator second(7, 4);
+  for (int i = 0; i < 20; ++i) {
+    std::string formula = first.ltlf_plus(2, 3, i % 2 == 0);
+    REQUIRE(formula == second.ltlf_plus(2, 3, i % 2 == 0));
+    Syft::InputOutputPartition partition = first.partition();
+    second.partition();
+
+    REQUIRE_FALSE(partition.input_variables.empty());
+    REQUIRE_FALSE(partition.output_variables.empty());
+    std::vector<std::string> variables = partition.input_variables;
+    variables.insert(variables.end(), partition.output_variables.begin(), partition.output_variables.end());
+    std::sort(variables.begin(), variables.end());
+    REQUIRE(variables == first.atoms());
+
+    Syft::FuzzSpec spec = Syft::DifferentialFuzzer::parse(formula, partition, Syft::Player::Agent);
+    REQUIRE_FALSE(spec.ltlf_plus.formula_to_color_.empty());
+    // Positive combinations of A and E are obligations
+    if (i % 2 == 0) {
+      REQUIRE(spec.obligation);
+    }
+  }
+}
+
+TEST_CASE("Differential fuzzer saves mismatches and cliffs", "[fuzzer]")
+{
+  std::filesystem::path corpus = std::filesystem::temp_directory_path() / "lydiasyft_test_fuzz_corpus";
+  std::filesystem::remove_all(corpus);
+  Syft::FuzzOptions options;
+  options.corpus_directory = corpus.string();
+  options.min_seconds = 0;
+  options.repeats = 1;
+  Syft::InputOutputPartition partition = Syft::InputOutputPartition::construct_from_input({"a"}, {"b"});
+  Syft::FuzzSpec spec = Syft::DifferentialFuzzer::parse("A(F(b)) & E(a)", partition, Syft::Player::Agent);
+
+  SECTION("Verdict mismatch") {
+    Syft::DifferentialFuzzer fuzzer({
+      {"yes", [](const Syft::FuzzSpec&, const Syft::VarMgrOptions&) { return true; }},
+      {"no", [](const Syft::FuzzSpec&, const Syft::VarMgrOptions&) { return false; }},
+      {"timeout", [](const Syft::FuzzSpec&, const Syft::VarMgrOptions&) -> bool {
+        throw Syft::BudgetExceeded("time", "test", Syft::BddStatsSnapshot());
+      }}}, options);
+    Syft::FuzzOutcome outcome = fuzzer.run(spec, "m");
+    REQUIRE(outcome.mismatch);
+    REQUIRE_FALSE(outcome.verdicts[2].has_value());
+    REQUIRE(std::filesystem::exists(corpus / "mismatch_m.ltlfplus"));
+    REQUIRE(std::filesystem::exists(corpus / "mismatch_m.json"));
+    Syft::InputOutputPartition saved = Syft::InputOutputPartition::read_from_file((corpus / "mismatch_m.part").string());
+    REQUIRE(saved.input_variables == partition.input_variables);
+    REQUIRE(saved.output_variables == partition.output_variables);
+  }
+
+  SECTION("Agreeing configurations") {
+    options.differential = 1e9;
+    Syft::DifferentialFuzzer fuzzer({
+      {"yes", [](const Syft::FuzzSpec&, const Syft::VarMgrOptions&) { return true; }},
+      {"also-yes", [](const Syft::FuzzSpec&, const Syft::VarMgrOptions&) { return true; }}}, options);
+    Syft::FuzzOutcome outcome = fuzzer.run(spec, "a");
+    REQUIRE_FALSE(outcome.mismatch);
+    REQUIRE_FALSE(outcome.cliff);
+    REQUIRE(std::filesystem::is_empty(corpus));
+  }
+
+  SECTION("Unknown configuration") {
+    REQUIRE_THROWS_AS(Syft::fuzz_configurations({"emerson-lei", "unknown"}), std::runtime_error);
+  }
+  std::filesystem::remove_all(corpus);
+}
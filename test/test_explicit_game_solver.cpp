@@ -0,0 +1,96 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <memory>
+#include <sstream>
+#include "automata/ExplicitStateDfa.h"
+#include "automata/SymbolicStateDfa.h"
+#include "game/ExplicitGameSolver.h"
+#include "VarMgr.h"
+#include "lydia/parser/ltlf/driver.hpp"
+
+namespace {
+  Syft::SharedExplicitStateDfa dfa_of(const std::string& formula) {
+    whitemech::lydia::parsers::ltlf::LTLfDriver driver;
+    std::stringstream stream(formula);
+    driver.parse(stream);
+    auto parsed = std::static_pointer_cast<const whitemech::lydia::LTLfFormula>(driver.get_result());
+    return std::make_shared<Syft::ExplicitStateDfa>(Syft::ExplicitStateDfa::dfa_of_formula(*parsed));
+  }
+
+  // The variable a is an output of the agent if agent_controls_a, an input otherwise
+  std::shared_ptr<Syft::VarMgr> var_mgr_with(bool agent_controls_a) {
+    auto var_mgr = std::make_shared<Syft::VarMgr>();
+    var_mgr->create_named_variables({"a", "b"});
+    if (agent_controls_a) {
+      var_mgr->partition_variables({"b"}, {"a"});
+    } else {
+      var_mgr->partition_variables({"a"}, {"b"});
+    }
+    return var_mgr;
+  }
+
+  bool realizable(const std::string& formula, bool agent_controls_a, Syft::ExplicitGameCondition condition,
+                  Syft::Player starting_player) {
+    std::shared_ptr<Syft::VarMgr> var_mgr = var_mgr_with(agent_controls_a);
+    Syft::ExplicitGameSolver solver(dfa_of(formula), var_mgr, starting_player, Syft::Player::Agent);
+    return solver.solve(condition).realizability;
+  }
+}
+
+TEST_CASE("State bitsets", "[explicitgame]")
+{
+  Syft::StateBitset states(70);
+  REQUIRE(states.none());
+  states.set(3);
+  states.set(69);
+  REQUIRE(states.count() == 2);
+  REQUIRE(states.test(69));
+  REQUIRE_FALSE(states.test(68));
+
+  Syft::StateBitset complement = ~states;
+  REQUIRE(complement.count() == 68);
+  complement &= states;
+  REQUIRE(complement.none());
+  complement |= states;
+  REQUIRE(complement == states);
+  REQUIRE(Syft::StateBitset(70, true).count() == 70);
+}
+
+TEST_CASE("Explicit games are decided by who controls the variables", "[explicitgame]")
+{
+  for (Syft::Player starting_player : {Syft::Player::Agent, Syft::Player::Environment}) {
+    REQUIRE(realizable("F(a)", true, Syft::ExplicitGameCondition::Reachability, starting_player));
+    REQUIRE_FALSE(realizable("F(a)", false, Syft::ExplicitGameCondition::Reachability, starting_player));
+    REQUIRE(realizable("G(a)", true, Syft::ExplicitGameCondition::Safety, starting_player));
+    REQUIRE_FALSE(realizable("G(a)", false, Syft::ExplicitGameCondition::Safety, starting_player));
+    REQUIRE(realizable("F(a)", true, Syft::ExplicitGameCondition::Buchi, starting_player));
+    REQUIRE_FALSE(realizable("F(a)", false, Syft::ExplicitGameCondition::Buchi, starting_player));
+    REQUIRE(realizable("F(a)", true, Syft::ExplicitGameCondition::CoBuchi, starting_player));
+    REQUIRE_FALSE(realizable("F(a)", false, Syft::ExplicitGameCondition::CoBuchi, starting_player));
+  }
+}
+
+TEST_CASE("Explicit winning states and strategies", "[explicitgame]")
+{
+  std::shared_ptr<Syft::VarMgr> var_mgr = var_mgr_with(true);
+  Syft::SharedExplicitStateDfa dfa = dfa_of("F(a)");
+  REQUIRE(Syft::ExplicitGameSolver::applicable(*dfa, *var_mgr, Syft::Player::Agent));
+  REQUIRE_FALSE(Syft::ExplicitGameSolver::applicable(*dfa, *var_mgr, Syft::Player::Agent, 1));
+
+  Syft::SymbolicStateDfa arena = Syft::SymbolicStateDfa::from_mona(var_mgr, *dfa);
+  Syft::ExplicitGameSolver solver(dfa, var_mgr, Syft::Player::Agent, Syft::Player::Agent);
+  REQUIRE(solver.move_count() == 2);
+  // Setting a keeps the accepting sink accepting
+  Syft::StateBitset kept = solver.controllable_preimage(solver.final_states());
+  kept &= solver.final_states();
+  REQUIRE(kept == solver.final_states());
+
+  Syft::ExplicitGameResult result = solver.solve(Syft::ExplicitGameCondition::Reachability);
+  REQUIRE(result.realizability);
+  CUDD::BDD winning = solver.to_bdd(result.winning_states, arena, Syft::StateEncodingKind::Binary);
+  REQUIRE(arena.final_states() <= winning);
+
+  std::unique_ptr<Syft::Transducer> transducer =
+      solver.transducer(result, Syft::ExplicitGameCondition::Reachability, arena, Syft::StateEncodingKind::Binary);
+  REQUIRE(transducer->controller_outputs() == std::vector<std::string>{"a"});
+}
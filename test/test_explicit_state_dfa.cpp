@@ -0,0 +1,268 @@
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/generators/catch_generators_all.hpp"
+
+#include <set>
+#include <sstream>
+#include "automata/ExplicitStateDfa.h"
+#include "automata/StateEncoding.h"
+#include "automata/SymbolicStateDfa.h"
+#include "VarMgr.h"
+#include "lydia/parser/ltlf/driver.hpp"
+
+namespace {
+  Syft::ExplicitStateDfa dfa_of(const std::string& formula) {
+    whitemech::lydia::parsers::ltlf::LTLfDriver driver;
+    std::stringstream stream(formula);
+    driver.parse(stream);
+    auto parsed = std::static_pointer_cast<const whitemech::lydia::LTLfFormula>(driver.get_result());
+    return Syft::ExplicitStateDfa::dfa_of_formula(*parsed);
+  }
+}
+
+TEST_CASE("Product minimisation policy", "[explicitdfa]")
+{
+    Syft::ProductMinimisationPolicy always;
+    REQUIRE(always.should_minimise(1, 1));
+
+    Syft::ProductMinimisationPolicy adaptive{100, 2.0};
+    REQUIRE_FALSE(adaptive.should_minimise(40, 30));
+    REQUIRE(adaptive.should_minimise(70, 30));
+    REQUIRE(adaptive.should_minimise(101, 90));
+}
+
+TEST_CASE("Products are minimised as the policy decides", "[explicitdfa]")
+{
+    Syft::ExplicitStateDfa fa = dfa_of("F(a)");
+    Syft::ExplicitStateDfa minimal = Syft::ExplicitStateDfa::dfa_minimize(fa);
+    REQUIRE(minimal.get_nb_states() <= fa.get_nb_states());
+
+    Syft::ExplicitStateDfa minimised = Syft::ExplicitStateDfa::dfa_product_or({fa, fa});
+    REQUIRE(minimised.get_nb_states() == minimal.get_nb_states());
+
+    Syft::ProductMinimisationPolicy never{1 << 30, 0};
+    Syft::ExplicitStateDfa kept = Syft::ExplicitStateDfa::dfa_product_or({fa, fa}, never);
+    REQUIRE(kept.get_nb_states() >= minimised.get_nb_states());
+}
+
+TEST_CASE("Product orders agree", "[explicitdfa]")
+{
+    std::vector<Syft::ExplicitStateDfa> operands = {
+        dfa_of("F(a & X(b))"), dfa_of("G(c -> X(d))"), dfa_of("F(b) | G(a)"), dfa_of("F(d & c)")};
+
+    for (bool conjunction : {true, false}) {
+        Syft::ProductMinimisationPolicy smallest;
+        smallest.order = Syft::ProductOrder::Smallest;
+        Syft::ProductMinimisationPolicy greedy;
+        greedy.exhaustive_order_limit = 0;
+        Syft::ProductMinimisationPolicy exhaustive;
+        Syft::ProductMinimisationPolicy parallel;
+        parallel.workers = 2;
+
+        std::vector<int> states;
+        for (const Syft::ProductMinimisationPolicy& policy : {smallest, greedy, exhaustive, parallel}) {
+            Syft::ExplicitStateDfa product = conjunction
+                ? Syft::ExplicitStateDfa::dfa_product_and(operands, policy)
+                : Syft::ExplicitStateDfa::dfa_product_or(operands, policy);
+            REQUIRE(product.names == std::vector<std::string>{"a", "b", "c", "d"});
+            states.push_back(product.get_nb_states());
+        }
+        // Every product is minimized, so that the orders end in the same minimal DFA
+        REQUIRE(states[0] == states[1]);
+        REQUIRE(states[0] == states[2]);
+        REQUIRE(states[0] == states[3]);
+    }
+}
+
+TEST_CASE("Reachable products agree with MONA products", "[explicitdfa]")
+{
+    Syft::ExplicitStateDfa fa = Syft::ExplicitStateDfa::dfa_to_Fdfa_obligation(dfa_of("a"));
+    Syft::ExplicitStateDfa gb = Syft::ExplicitStateDfa::dfa_to_Gdfa_obligation(dfa_of("b"));
+
+    for (dfaProductType type : {dfaProductType::dfaAND, dfaProductType::dfaOR}) {
+        Syft::ExplicitStateDfa reachable = Syft::ExplicitStateDfa::dfa_product_reachable({fa, gb}, type);
+        Syft::ExplicitStateDfa mona = type == dfaProductType::dfaAND
+            ? Syft::ExplicitStateDfa::dfa_product_and({fa, gb})
+            : Syft::ExplicitStateDfa::dfa_product_or({fa, gb});
+        REQUIRE(reachable.names == mona.names);
+        REQUIRE(reachable.get_nb_states() <= fa.get_nb_states() * gb.get_nb_states());
+        REQUIRE(Syft::ExplicitStateDfa::dfa_minimize_weak(reachable).get_nb_states() ==
+                Syft::ExplicitStateDfa::dfa_minimize_weak(mona).get_nb_states());
+    }
+}
+
+TEST_CASE("Explicit DFAs move and share without copying", "[explicitdfa]")
+{
+    Syft::ExplicitStateDfa fa = dfa_of("F(a)");
+    DFA* mona = fa.get_dfa();
+    int states = fa.get_nb_states();
+
+    Syft::ExplicitStateDfa moved(std::move(fa));
+    REQUIRE(moved.get_dfa() == mona);
+    REQUIRE(moved.get_nb_states() == states);
+
+    Syft::SharedExplicitStateDfa shared = std::make_shared<Syft::ExplicitStateDfa>(std::move(moved));
+    Syft::SharedExplicitStateDfa other = shared;
+    Syft::ExplicitStateDfa copied = Syft::ExplicitStateDfa::take(shared);
+    REQUIRE(shared == nullptr);
+    REQUIRE(copied.get_dfa() != mona);
+    REQUIRE(other->get_dfa() == mona);
+
+    Syft::ExplicitStateDfa taken = Syft::ExplicitStateDfa::take(other);
+    REQUIRE(taken.get_dfa() == mona);
+
+    std::vector<Syft::ExplicitStateDfa> operands;
+    operands.push_back(std::move(taken));
+    operands.push_back(std::move(copied));
+    Syft::ExplicitStateDfa product = Syft::ExplicitStateDfa::dfa_product_and(std::move(operands));
+    REQUIRE(product.get_nb_states() <= states);
+}
+
+TEST_CASE("Direct MONA conversion matches the ADD conversion", "[explicitdfa]")
+{
+    Syft::ExplicitStateDfa dfa = dfa_of("G(a -> X(b | F(c)))");
+    std::shared_ptr<Syft::VarMgr> var_mgr = std::make_shared<Syft::VarMgr>();
+
+    Syft::SymbolicStateDfa direct = Syft::SymbolicStateDfa::from_mona(var_mgr, dfa);
+    Syft::SymbolicStateDfa through_add = Syft::SymbolicStateDfa::from_explicit(
+        Syft::ExplicitStateDfaAdd::from_dfa_mona(var_mgr, dfa));
+
+    std::size_t bit_count = var_mgr->state_variable_count(direct.automaton_id());
+    REQUIRE(var_mgr->state_variable_count(through_add.automaton_id()) == bit_count);
+    REQUIRE(direct.initial_state() == through_add.initial_state());
+
+    // Express the ADD result over the state variables of the direct one
+    std::vector<CUDD::BDD> direct_vars, add_vars;
+    for (std::size_t i = 0; i < bit_count; ++i) {
+        direct_vars.push_back(var_mgr->state_variable(direct.automaton_id(), i));
+        add_vars.push_back(var_mgr->state_variable(through_add.automaton_id(), i));
+    }
+    REQUIRE(direct.final_states() == through_add.final_states().SwapVariables(add_vars, direct_vars));
+
+    std::vector<CUDD::BDD> direct_transitions = direct.transition_function();
+    std::vector<CUDD::BDD> add_transitions = through_add.transition_function();
+    for (std::size_t i = 0; i < bit_count; ++i) {
+        REQUIRE(direct_transitions[i] == add_transitions[i].SwapVariables(add_vars, direct_vars));
+    }
+}
+
+TEST_CASE("Bisimilar product states are merged", "[explicitdfa]")
+{
+    std::shared_ptr<Syft::VarMgr> var_mgr = std::make_shared<Syft::VarMgr>();
+    var_mgr->create_named_variables({"a", "b"});
+    var_mgr->partition_variables({"a"}, {"b"});
+
+    Syft::SymbolicStateDfa fa = Syft::SymbolicStateDfa::from_mona(var_mgr, dfa_of("F(a)"));
+    Syft::SymbolicStateDfa product = Syft::SymbolicStateDfa::product_AND({fa, fa.clone_with_fresh_state_space()});
+    std::size_t product_bits = var_mgr->state_variable_count(product.automaton_id());
+
+    std::vector<CUDD::BDD> colors = {product.final_states()};
+    Syft::SymbolicStateDfa quotient = product.minimize(colors);
+    REQUIRE(var_mgr->state_variable_count(quotient.automaton_id()) < product_bits);
+    REQUIRE(colors.size() == 1);
+    REQUIRE(colors[0] == quotient.final_states());
+    REQUIRE(quotient.initial_state_bdd() <= !quotient.final_states());
+}
+
+TEST_CASE("State encodings give distinct codes", "[explicitdfa]")
+{
+    Syft::ExplicitStateDfa dfa = dfa_of("F(a & X(b & X(c)))");
+    std::size_t state_count = dfa.get_nb_states();
+    std::size_t final_count = 0;
+    for (std::size_t i = 0; i < state_count; ++i) {
+        final_count += dfa.get_dfa()->f[i] == 1;
+    }
+
+    auto kind = GENERATE(Syft::StateEncodingKind::Binary, Syft::StateEncodingKind::Gray,
+                         Syft::StateEncodingKind::OneHot, Syft::StateEncodingKind::SccOrder,
+                         Syft::StateEncodingKind::Automatic);
+    Syft::StateEncoding encoding = Syft::StateEncoding::of(dfa, kind);
+    REQUIRE(encoding.kind() != Syft::StateEncodingKind::Automatic);
+
+    std::set<std::vector<int>> codes;
+    for (std::size_t i = 0; i < state_count; ++i) {
+        REQUIRE(encoding.code(i).size() == encoding.bit_count());
+        codes.insert(encoding.code(i));
+    }
+    REQUIRE(codes.size() == state_count);
+
+    std::shared_ptr<Syft::VarMgr> var_mgr = std::make_shared<Syft::VarMgr>();
+    Syft::SymbolicStateDfa symbolic = Syft::SymbolicStateDfa::from_mona(var_mgr, dfa, kind);
+    REQUIRE(var_mgr->state_variable_count(symbolic.automaton_id()) == encoding.bit_count());
+    REQUIRE(symbolic.initial_state() == encoding.code(dfa.get_initial_state()));
+    REQUIRE(symbolic.final_states().CountMinterm(encoding.bit_count()) == final_count);
+}
+
+TEST_CASE("Tiny DFAs are one-hot encoded", "[explicitdfa]")
+{
+    Syft::ExplicitStateDfa dfa = dfa_of("a");
+    bool tiny = dfa.get_nb_states() <= Syft::StateEncoding::one_hot_max_states;
+    REQUIRE(tiny == (Syft::StateEncoding::choose(dfa) == Syft::StateEncodingKind::OneHot));
+    REQUIRE(Syft::StateEncoding::kind_from_string("scc") == Syft::StateEncodingKind::SccOrder);
+    REQUIRE_THROWS(Syft::StateEncoding::kind_from_string("unary"));
+}
+
+TEST_CASE("Rejecting sinks of product operands are merged", "[explicitdfa]")
+{
+    std::shared_ptr<Syft::VarMgr> var_mgr = std::make_shared<Syft::VarMgr>();
+    var_mgr->create_named_variables({"a", "b"});
+    var_mgr->partition_variables({"a"}, {"b"});
+
+    Syft::SymbolicStateDfa ga = Syft::SymbolicStateDfa::from_mona(var_mgr, dfa_of("G(a)"));
+    Syft::SymbolicStateDfa gb = Syft::SymbolicStateDfa::from_mona(var_mgr, dfa_of("G(b)"));
+    REQUIRE_FALSE(ga.rejecting_sink_states().IsZero());
+
+    Syft::SymbolicStateDfa plain = Syft::SymbolicStateDfa::product_AND({ga, gb});
+    Syft::SymbolicStateDfa merged = Syft::SymbolicStateDfa::product_AND({ga, gb}, true);
+    REQUIRE(plain.care_states().IsOne());
+    REQUIRE_FALSE(merged.care_states().IsOne());
+
+    int bits = static_cast<int>(var_mgr->state_variable_count(merged.automaton_id()));
+    REQUIRE(merged.reachable_states() <= merged.care_states());
+    REQUIRE(merged.reachable_states().CountMinterm(bits) < plain.reachable_states().CountMinterm(bits));
+    // The same accepting reachable states: only rejecting ones were merged
+    REQUIRE((merged.reachable_states() & merged.final_states()) == (plain.reachable_states() & plain.final_states()));
+}
+
+TEST_CASE("Merged products are compacted to fewer state bits", "[explicitdfa]")
+{
+    std::shared_ptr<Syft::VarMgr> var_mgr = std::make_shared<Syft::VarMgr>();
+    var_mgr->create_named_variables({"a", "b", "c"});
+    var_mgr->partition_variables({"a"}, {"b", "c"});
+
+    std::vector<Syft::SymbolicStateDfa> operands = {
+        Syft::SymbolicStateDfa::from_mona(var_mgr, dfa_of("G(a)")),
+        Syft::SymbolicStateDfa::from_mona(var_mgr, dfa_of("G(b)")),
+        Syft::SymbolicStateDfa::from_mona(var_mgr, dfa_of("G(c)"))};
+    Syft::SymbolicStateDfa merged = Syft::SymbolicStateDfa::product_AND(operands, true);
+    std::size_t merged_bits = var_mgr->state_variable_count(merged.automaton_id());
+    double states = merged.reachable_states().CountMinterm(static_cast<int>(merged_bits));
+
+    std::vector<CUDD::BDD> colors = {merged.final_states()};
+    Syft::SymbolicStateDfa compacted = merged.compact(colors);
+    std::size_t compacted_bits = var_mgr->state_variable_count(compacted.automaton_id());
+    REQUIRE(compacted_bits < merged_bits);
+    REQUIRE(colors[0] == compacted.final_states());
+    REQUIRE(compacted.reachable_states().CountMinterm(static_cast<int>(compacted_bits)) == states);
+    REQUIRE(compacted.reachable_states() <= compacted.care_states());
+    REQUIRE((compacted.initial_state_bdd() & compacted.final_states()).IsZero() ==
+            (merged.initial_state_bdd() & merged.final_states()).IsZero());
+}
+
+TEST_CASE("Care simplification narrows the care states", "[explicitdfa]")
+{
+    std::shared_ptr<Syft::VarMgr> var_mgr = std::make_shared<Syft::VarMgr>();
+    var_mgr->create_named_variables({"a", "b"});
+    var_mgr->partition_variables({"a"}, {"b"});
+
+    Syft::SymbolicStateDfa arena = Syft::SymbolicStateDfa::product_AND(
+        {Syft::SymbolicStateDfa::from_mona(var_mgr, dfa_of("F(a)")),
+         Syft::SymbolicStateDfa::from_mona(var_mgr, dfa_of("G(b)"))});
+    CUDD::BDD reachable = arena.reachable_states();
+    CUDD::BDD final_states = arena.final_states();
+    std::vector<CUDD::BDD> colors = {final_states};
+    arena.simplify_on_care(reachable, colors, Syft::StrategyMinimization::Restrict);
+    REQUIRE(arena.care_states() == reachable);
+    REQUIRE(arena.reachable_states() == reachable);
+    REQUIRE(colors[0] == arena.final_states());
+    REQUIRE((arena.final_states() & reachable) == (final_states & reachable));
+}
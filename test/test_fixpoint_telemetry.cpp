@@ -0,0 +1,71 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cuddObj.hh>
+#include "FlatJson.h"
+#include "game/FixpointTelemetry.h"
+
+namespace {
+  std::vector<std::string> read_lines(const std::filesystem::path& path) {
+    std::ifstream in(path);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(in, line);) {
+      lines.push_back(line);
+    }
+    return lines;
+  }
+}
+
+TEST_CASE("Fixpoint telemetry as JSONL and CSV", "[telemetry]")
+{
+  CUDD::Cudd mgr;
+  CUDD::BDD x0 = mgr.bddVar(0);
+  CUDD::BDD x1 = mgr.bddVar(1);
+  std::filesystem::path jsonl = std::filesystem::temp_directory_path() / "lydiasyft_test_telemetry.jsonl";
+  std::filesystem::path csv = std::filesystem::temp_directory_path() / "lydiasyft_test_telemetry.csv";
+
+  {
+    // Not recorded: telemetry is off
+    Syft::FixpointProbe probe("untraced", "", 2);
+    probe.iteration(x0);
+  }
+
+  Syft::FixpointTelemetry::start(jsonl.string());
+  REQUIRE(Syft::FixpointTelemetry::enabled());
+  {
+    Syft::FixpointProbe probe("weak reachability", "layer \"0\"", 2);
+    probe.iteration(x0);
+    probe.iteration(x0 | x1);
+  }
+  Syft::FixpointTelemetry::finish();
+  REQUIRE_FALSE(Syft::FixpointTelemetry::enabled());
+
+  std::vector<std::string> lines = read_lines(jsonl);
+  REQUIRE(lines.size() == 2);
+  Syft::JsonObject first = Syft::parse_json_object(lines[0]);
+  Syft::JsonObject second = Syft::parse_json_object(lines[1]);
+  REQUIRE(first.at("solver").text == "weak reachability");
+  REQUIRE(first.at("node").text == "layer \"0\"");
+  REQUIRE(first.at("iteration").number == 1);
+  REQUIRE(second.at("iteration").number == 2);
+  // States are counted over the two state bits
+  REQUIRE(first.at("approximation_states").number == 2);
+  REQUIRE(second.at("approximation_states").number == 3);
+  REQUIRE(second.at("approximation_nodes").number == (x0 | x1).nodeCount());
+  REQUIRE(second.at("elapsed_ms").number >= second.at("iteration_ms").number);
+
+  Syft::FixpointTelemetry::start(csv.string());
+  {
+    Syft::FixpointProbe probe("buchi inner", "a,b", 2);
+    probe.iteration(x0 & x1);
+  }
+  Syft::FixpointTelemetry::finish();
+
+  lines = read_lines(csv);
+  REQUIRE(lines.size() == 2);
+  REQUIRE(lines[0] == "pid,solver,node,iteration,approximation_nodes,approximation_states,iteration_ms,elapsed_ms");
+  REQUIRE(lines[1].find(",buchi inner,\"a,b\",1,3,1,") != std::string::npos);
+}
@@ -0,0 +1,41 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include "formula_file.h"
+
+namespace {
+  std::string read_all(std::istream& stream) {
+    return std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+  }
+}
+
+TEST_CASE("Formula file read in place", "[formulafile]")
+{
+  std::filesystem::path directory = std::filesystem::temp_directory_path() / "lydiasyft_test_formula_file";
+  std::filesystem::remove_all(directory);
+  std::filesystem::create_directories(directory);
+
+  {
+    std::ofstream(directory / "spec.ltlfplus") << "AE(F(a)) & EA(G(b))\nignored second line\n";
+  }
+  Syft::FormulaFile file((directory / "spec.ltlfplus").string());
+  REQUIRE(file.formula() == "AE(F(a)) & EA(G(b))");
+  REQUIRE(read_all(file.stream()) == "AE(F(a)) & EA(G(b))");
+  // Every call reads from the start again
+  REQUIRE(read_all(file.stream()) == "AE(F(a)) & EA(G(b))");
+
+  {
+    std::ofstream(directory / "no_newline.ltlfplus") << "F(a)";
+    std::ofstream(directory / "empty.ltlfplus");
+  }
+  REQUIRE(Syft::FormulaFile((directory / "no_newline.ltlfplus").string()).formula() == "F(a)");
+  Syft::FormulaFile empty((directory / "empty.ltlfplus").string());
+  REQUIRE(empty.formula().empty());
+  REQUIRE(read_all(empty.stream()).empty());
+
+  REQUIRE_THROWS_AS(Syft::FormulaFile((directory / "missing.ltlfplus").string()), std::runtime_error);
+}
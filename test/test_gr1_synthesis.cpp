@@ -0,0 +1,76 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include "utils.hpp"
+#include "GR1.h"
+#include "Parser.h"
+#include "Utils.h"
+#include "synthesizer/GR1LTLfSynthesizer.h"
+
+namespace {
+  // The justices of a GR(1) assumption, built once the variables of the spec exist
+  using GR1Builder = std::function<Syft::GR1(const std::shared_ptr<Syft::VarMgr>&)>;
+
+  // Realizability of reaching goal while keeping agent_safety, unless the environment breaks env_safety or the
+  // GR(1) assumption, as decided by the native GR(1) solver (no Slugs directory)
+  bool gr1_realizability(const vars& inputs, const vars& outputs, const std::string& goal,
+                         const std::string& agent_safety, const std::string& env_safety, const GR1Builder& gr1) {
+    auto driver = std::make_shared<whitemech::lydia::parsers::ltlf::LTLfDriver>();
+    Syft::InputOutputPartition partition = Syft::InputOutputPartition::construct_from_input(inputs, outputs);
+    std::shared_ptr<Syft::VarMgr> var_mgr = Syft::build_var_mgr(partition);
+    Syft::SymbolicStateDfa goal_dfa = Syft::do_dfa_construction(*Syft::parse_formula(driver, goal), var_mgr);
+    Syft::SymbolicStateDfa agent_dfa = Syft::do_dfa_construction(*Syft::parse_formula(driver, agent_safety), var_mgr);
+    Syft::SymbolicStateDfa env_dfa = Syft::do_dfa_construction(*Syft::parse_formula(driver, env_safety), var_mgr);
+    Syft::GR1 assumption = gr1(var_mgr);
+    var_mgr->partition_variables(partition.input_variables, partition.output_variables);
+    Syft::GR1LTLfSynthesizer synthesizer(var_mgr, assumption, env_dfa, goal_dfa, agent_dfa, "", "test_gr1");
+    return synthesizer.run().realizability;
+  }
+
+  // GF(justice of the agent) -> GF(justice of the environment), the shape of the finding_nemo assumptions
+  GR1Builder fairness(const std::string& agent_variable, const std::string& env_variable) {
+    return [agent_variable, env_variable](const std::shared_ptr<Syft::VarMgr>& var_mgr) {
+      Syft::GR1 gr1;
+      gr1.env_justices.push_back(var_mgr->name_to_variable(agent_variable));
+      gr1.agn_justices.push_back(var_mgr->name_to_variable(env_variable));
+      return gr1;
+    };
+  }
+
+  Syft::GR1 no_assumption(const std::shared_ptr<Syft::VarMgr>&) {
+    return Syft::GR1();
+  }
+}
+
+TEST_CASE("Native GR(1) solving of the finding_nemo example", "[gr1]")
+{
+  std::string directory = Syft::Test::DATASET_FOLDER + "/GR1benchmarks/finding_nemo/";
+  Syft::Parser parser = Syft::Parser::read_from_file(Syft::Test::SYFCO_LOCATION, directory + "finding_nemo_1.tlsf");
+  std::string agent_safety = Syft::read_assumption_file_if_file_specified(directory + "finding_nemo_1_agn_safety.ltlf");
+  std::string env_safety = Syft::read_assumption_file_if_file_specified(directory + "finding_nemo_1_env_safety.ltlf");
+  GR1Builder from_file = [&](const std::shared_ptr<Syft::VarMgr>& var_mgr) {
+    return Syft::GR1::read_from_gr1_file(var_mgr, directory + "finding_nemo_1_env_gr1.txt");
+  };
+
+  // Realizable with Slugs (see docs/api/p10_cli.md)
+  REQUIRE(gr1_realizability(parser.get_input_variables(), parser.get_output_variables(), parser.get_formula(),
+                            agent_safety, env_safety, from_file));
+}
+
+TEST_CASE("Native GR(1) solving of small games", "[gr1]")
+{
+  // The agent sets a in the first step
+  REQUIRE(gr1_realizability(vars{"e"}, vars{"a"}, "F(a)", "true", "true", no_assumption));
+  // The environment never sets e
+  REQUIRE_FALSE(gr1_realizability(vars{"e"}, vars{"a"}, "F(a & e)", "true", "true", no_assumption));
+  // The environment must set e, and the agent sets a in the first step
+  REQUIRE(gr1_realizability(vars{"e"}, vars{"a"}, "F(a & e)", "true", "G(e)", no_assumption));
+  // The agent sets a forever, so the environment must eventually set e with it
+  REQUIRE(gr1_realizability(vars{"e"}, vars{"a"}, "F(a & e)", "true", "true", fairness("a", "e")));
+  // The agent may not set a, so the assumption never obliges the environment to set e
+  REQUIRE_FALSE(gr1_realizability(vars{"e"}, vars{"a"}, "F(a & e)", "G(!a)", "true", fairness("a", "e")));
+  // The environment sets e exactly when the agent sets a, which meets the assumption
+  REQUIRE_FALSE(gr1_realizability(vars{"e"}, vars{"a"}, "F(!a & e)", "true", "true", fairness("a", "e")));
+}
@@ -5,11 +5,19 @@
 #include "catch2/catch_test_macros.hpp"
 #include "catch2/generators/catch_generators_all.hpp"
 
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
 #include <tuple>
 #include "utils.hpp"
+#include "debug.hpp"
+#include "game/DagWorkQueue.h"
 #include "game/InputOutputPartition.h"
 #include "Synthesizer.h"
+#include "synthesizer/LTLfPlusSession.h"
 #include "synthesizer/LTLfPlusSynthesizer.h"
+#include "synthesizer/LTLfPlusSynthesizerMP.h"
 
 TEST_CASE("LTLf+ EL game test", "[test]")
 {
@@ -23,6 +31,18 @@ TEST_CASE("LTLf+ EL game test", "[test]")
     REQUIRE(actual == expected);
 }
 
+TEST_CASE("LTLf+ EL game test decomposed", "[test]")
+{
+
+    std::string boolean_formula = "(AE(F(e1 & X(false))) -> AE(F(a1 & X(false)))) & (EA(F(e2 & X(false))) -> EA(F(a2 & X(false)))) & (E(G(e3 -> F(a3))))";
+
+    bool expected = true;
+    INFO("tested\n");
+    std::cout.flush();
+    bool actual = Syft::Test::get_realizability_ltlfplus_from_input(boolean_formula, vars{"e1", "e2", "e3"}, vars{"a1", "a2", "a3"}, true);
+    REQUIRE(actual == expected);
+}
+
 TEST_CASE("LTLf+ EL game test1", "[test1a]")
 {
 
@@ -35,6 +55,18 @@ TEST_CASE("LTLf+ EL game test1", "[test1a]")
     REQUIRE(actual == expected);
 }
 
+TEST_CASE("LTLf+ EL game test1 decomposed", "[test1a]")
+{
+
+    std::string boolean_formula = "(AE(e1) -> AE(s1)) & (AE(e2) -> AE(s2)) & E(F(X(false) & s3)) & (AE(e4) -> AE(s4)) & (AE(e5) -> AE(s5))";
+
+    bool expected = true;
+    INFO("tested\n");
+    std::cout.flush();
+    bool actual = Syft::Test::get_realizability_ltlfplus_from_input(boolean_formula, vars{"e1", "e2", "e3", "e4", "e5", "e6"}, vars{"s1", "s2", "s3", "s4", "s5", "s6"}, true);
+    REQUIRE(actual == expected);
+}
+
 TEST_CASE("LTLf+ EL game test2", "[test2]")
 {
 
@@ -47,6 +79,18 @@ TEST_CASE("LTLf+ EL game test2", "[test2]")
     REQUIRE(actual == expected);
 }
 
+TEST_CASE("LTLf+ EL game test2 decomposed", "[test2]")
+{
+
+    std::string boolean_formula = "AE(a) && EA(b) && A(c) || E(d) || E(d1)";
+
+    bool expected = true;
+    INFO("tested\n");
+    std::cout.flush();
+    bool actual = Syft::Test::get_realizability_ltlfplus_from_input(boolean_formula, vars{"d", "d1"}, vars{"a", "b", "c"}, true);
+    REQUIRE(actual == expected);
+}
+
 TEST_CASE("LTLf+ EL game test3", "[test3]")
 {
 
@@ -59,6 +103,18 @@ TEST_CASE("LTLf+ EL game test3", "[test3]")
     REQUIRE(actual == expected);
 }
 
+TEST_CASE("LTLf+ EL game test3 decomposed", "[test3]")
+{
+
+    std::string boolean_formula = "A(F((a & X[!](a | !a) & !(X[!](X[!](a | !a))))))";
+
+    bool expected = false;
+    INFO("tested\n");
+    std::cout.flush();
+    bool actual = Syft::Test::get_realizability_ltlfplus_from_input(boolean_formula, vars{}, vars{"a"}, true);
+    REQUIRE(actual == expected);
+}
+
 TEST_CASE("LTLf+ EL game test4", "[test4]")
 {
 
@@ -71,6 +127,243 @@ TEST_CASE("LTLf+ EL game test4", "[test4]")
     REQUIRE(actual == expected);
 }
 
+TEST_CASE("LTLf+ EL game test4 decomposed", "[test4]")
+{
+
+    std::string boolean_formula = "(AE(a) & AE(b)) | EA(c) | EA(d) | A(e)";
+
+    bool expected = true;
+    INFO("tested\n");
+    std::cout.flush();
+    bool actual = Syft::Test::get_realizability_ltlfplus_from_input(boolean_formula, vars{"c", "d", "e"}, vars{"a", "b"}, true);
+    REQUIRE(actual == expected);
+}
+
+TEST_CASE("LTLf+ EL game split into independent components", "[test1]")
+{
+
+    std::string boolean_formula = "(AE(e1) -> AE(s1)) & (AE(e2) -> AE(s2)) & E(F(X(false) & s3)) & A(G(e4 -> s4)) & A(G(e4 -> !s4))";
+
+    bool expected = Syft::Test::get_realizability_ltlfplus_from_input(boolean_formula, vars{"e1", "e2", "e3", "e4"}, vars{"s1", "s2", "s3", "s4"}, false);
+    REQUIRE(expected == false);
+    for (std::size_t threads : {1, 2}) {
+        INFO("threads: " << threads);
+        bool actual = Syft::Test::get_realizability_ltlfplus_from_input(boolean_formula, vars{"e1", "e2", "e3", "e4"}, vars{"s1", "s2", "s3", "s4"}, true, threads);
+        REQUIRE(actual == expected);
+    }
+}
+
+TEST_CASE("LTLf+ EL session across conjunct edits", "[test1]")
+{
+
+    std::vector<std::string> edits = {
+        "(AE(e1) -> AE(s1)) & E(F(X(false) & s3))",
+        "(AE(e1) -> AE(s1)) & E(F(X(false) & s3)) & A(G(e4 -> s4)) & A(G(e4 -> !s4))",
+        "(AE(e1) -> AE(s1)) & E(F(X(false) & s3))",
+        "(AE(e1) -> AE(s1)) & E(F(X(false) & s3))"};
+    std::vector<Syft::LTLfPlusSession::Reuse> reuses = {
+        Syft::LTLfPlusSession::Reuse::None, Syft::LTLfPlusSession::Reuse::LosingStates,
+        Syft::LTLfPlusSession::Reuse::WinningStates, Syft::LTLfPlusSession::Reuse::Verdict};
+    Syft::InputOutputPartition partition = Syft::InputOutputPartition::construct_from_input(
+        vars{"e1", "e3", "e4"}, vars{"s1", "s3", "s4"});
+    Syft::DfaConstructionOptions dfa_options;
+    dfa_options.decompose_components = false;
+    Syft::LTLfPlusSession session(partition, Syft::Player::Agent, Syft::Player::Agent, Syft::VarMgrOptions(), dfa_options);
+    for (std::size_t i = 0; i < edits.size(); ++i) {
+        INFO("edit: " << edits[i]);
+        bool expected = Syft::Test::get_realizability_ltlfplus_from_input(edits[i], vars{"e1", "e3", "e4"}, vars{"s1", "s3", "s4"}, false);
+        bool actual = session.solve(Syft::Test::get_ltlfplus_from_input(edits[i])).realizability;
+        REQUIRE(actual == expected);
+        REQUIRE(session.last_reuse() == reuses[i]);
+    }
+}
+
+TEST_CASE("LTLf+ EL game with the DFAs of large conjunctions composed symbolically", "[test1]")
+{
+
+    std::vector<std::string> formulas = {
+        "A(G(e1 -> X(s1)) & G(e2 -> X(s2)) & G(s1 -> !s2)) & E(F(s3) & F(s4))",
+        "A(G(e1 -> X(s1)) & G(e2 -> X(s2)) & G(s1 -> !s2)) & AE(F(e1 & e2) | F(s3 & X(s4)))"};
+    Syft::InputOutputPartition partition = Syft::InputOutputPartition::construct_from_input(
+        vars{"e1", "e2"}, vars{"s1", "s2", "s3", "s4"});
+    for (const std::string& formula : formulas) {
+        INFO("formula: " << formula);
+        bool expected = Syft::Test::get_realizability_ltlfplus_from_input(formula, vars{"e1", "e2"}, vars{"s1", "s2", "s3", "s4"}, false);
+        for (std::size_t bits : {0, 1, 2}) {
+            INFO("bits: " << bits);
+            Syft::DfaConstructionOptions dfa_options;
+            dfa_options.decompose_components = false;
+            dfa_options.symbolic_construction_bits = bits;
+            Syft::LTLfPlusSession session(partition, Syft::Player::Agent, Syft::Player::Agent, Syft::VarMgrOptions(), dfa_options);
+            REQUIRE(session.solve(Syft::Test::get_ltlfplus_from_input(formula)).realizability == expected);
+        }
+    }
+}
+
+TEST_CASE("LTLf+ EL game solved on the colors of each subgame", "[test1]")
+{
+
+    std::vector<std::tuple<std::string, vars, vars>> specs = {
+        {"(AE(F(e1 & X(false))) -> AE(F(a1 & X(false)))) & (EA(F(e2 & X(false))) -> EA(F(a2 & X(false)))) & (E(G(e3 -> F(a3))))",
+         vars{"e1", "e2", "e3"}, vars{"a1", "a2", "a3"}},
+        {"(AE(e1) -> AE(s1)) & (AE(e2) -> AE(s2)) & E(F(X(false) & s3)) & A(G(e4 -> s4)) & A(G(e4 -> !s4))",
+         vars{"e1", "e2", "e3", "e4"}, vars{"s1", "s2", "s3", "s4"}},
+        {"AE(a) && EA(b) && A(c) || E(d) || E(d1)", vars{"d", "d1"}, vars{"a", "b", "c"}},
+        {"A(F((a & X[!](a | !a) & !(X[!](X[!](a | !a))))))", vars{}, vars{"a"}},
+        {"(AE(a) & AE(b)) | EA(c) | EA(d) | A(e)", vars{"c", "d", "e"}, vars{"a", "b"}}};
+    for (const auto& [formula, inputs, outputs] : specs) {
+        INFO("formula: " << formula);
+        Syft::InputOutputPartition partition = Syft::InputOutputPartition::construct_from_input(inputs, outputs);
+        for (bool decompose : {false, true}) {
+            INFO("decompose: " << decompose);
+            REQUIRE(Syft::Test::verdicts_agree(formula, partition, [decompose](Syft::DfaConstructionOptions& dfa_options) {
+                dfa_options.decompose_components = decompose;
+                dfa_options.symbolic_colors = true;
+            }));
+        }
+    }
+}
+
+TEST_CASE("LTLf+ EL game solved one SCC layer at a time", "[test1]")
+{
+
+    std::vector<std::tuple<std::string, vars, vars>> specs = {
+        {"(AE(F(e1 & X(false))) -> AE(F(a1 & X(false)))) & (EA(F(e2 & X(false))) -> EA(F(a2 & X(false)))) & (E(G(e3 -> F(a3))))",
+         vars{"e1", "e2", "e3"}, vars{"a1", "a2", "a3"}},
+        {"(AE(e1) -> AE(s1)) & (AE(e2) -> AE(s2)) & E(F(X(false) & s3)) & A(G(e4 -> s4)) & A(G(e4 -> !s4))",
+         vars{"e1", "e2", "e3", "e4"}, vars{"s1", "s2", "s3", "s4"}},
+        {"AE(a) && EA(b) && A(c) || E(d) || E(d1)", vars{"d", "d1"}, vars{"a", "b", "c"}},
+        {"A(F((a & X[!](a | !a) & !(X[!](X[!](a | !a))))))", vars{}, vars{"a"}},
+        {"(AE(a) & AE(b)) | EA(c) | EA(d) | A(e)", vars{"c", "d", "e"}, vars{"a", "b"}}};
+    for (const auto& [formula, inputs, outputs] : specs) {
+        INFO("formula: " << formula);
+        Syft::InputOutputPartition partition = Syft::InputOutputPartition::construct_from_input(inputs, outputs);
+        for (bool realizability_only : {false, true}) {
+            INFO("realizability only: " << realizability_only);
+            REQUIRE(Syft::Test::verdicts_agree(formula, partition, [realizability_only](Syft::DfaConstructionOptions& dfa_options) {
+                dfa_options.scc_layers = true;
+                dfa_options.realizability_only = realizability_only;
+            }));
+        }
+    }
+}
+
+TEST_CASE("LTLf+ EL game with its top disjuncts solved first", "[test1]")
+{
+
+    REQUIRE(Syft::top_disjuncts("0 & 1") == std::vector<std::string>{"0 & 1"});
+    REQUIRE(Syft::top_disjuncts("(0 & 1) | !2 | 3") == std::vector<std::string>{"(0 & 1)", "!(2)", "3"});
+
+    // The first two need the whole condition: neither disjunct is won alone
+    std::vector<std::tuple<std::string, vars, vars>> specs = {
+        {"E(F(e)) | A(G(!e))", vars{"e"}, vars{"a"}},
+        {"E(F(e & a)) | A(G(!e | !a))", vars{"e"}, vars{"a"}},
+        {"AE(a) && EA(b) && A(c) || E(d) || E(d1)", vars{"d", "d1"}, vars{"a", "b", "c"}},
+        {"(AE(a) & AE(b)) | EA(c) | EA(d) | A(e)", vars{"c", "d", "e"}, vars{"a", "b"}},
+        {"E(F(e & X(false))) | A(G(e -> a)) | A(G(e -> !a))", vars{"e"}, vars{"a"}}};
+    for (const auto& [formula, inputs, outputs] : specs) {
+        INFO("formula: " << formula);
+        Syft::InputOutputPartition partition = Syft::InputOutputPartition::construct_from_input(inputs, outputs);
+        REQUIRE(Syft::Test::verdicts_agree(formula, partition, [](Syft::DfaConstructionOptions& dfa_options) {
+            dfa_options.split_disjuncts = true;
+            dfa_options.el_threads = 2;
+        }));
+    }
+}
+
+TEST_CASE("LTLf+ games restricted to the safe region of their Forall conjuncts", "[test1]")
+{
+
+    REQUIRE(Syft::top_conjunct_colors("0 & (1 | 2) & !3 & 4") == std::vector<int>{0, 4});
+    REQUIRE(Syft::drop_top_conjuncts("0 & (1 | 2) & 4", {0, 4}) == "(1 | 2)");
+    REQUIRE(Syft::drop_top_conjuncts("0 & 4", {0, 4}) == "true");
+
+    std::vector<std::tuple<std::string, vars, vars>> specs = {
+        {"A(G(e -> a)) & E(F(a))", vars{"e"}, vars{"a"}},
+        {"A(G(e -> X(a))) & E(F(e))", vars{"e"}, vars{"a"}},
+        {"(AE(e1) -> AE(s1)) & A(G(e4 -> s4)) & A(G(e4 -> !s4))", vars{"e1", "e4"}, vars{"s1", "s4"}},
+        {"A(F(a)) & EA(b)", vars{"c"}, vars{"a", "b"}},
+        {"A(a) & A(G(e -> !a)) & AE(b)", vars{"e"}, vars{"a", "b"}}};
+    for (const auto& [formula, inputs, outputs] : specs) {
+        INFO("formula: " << formula);
+        Syft::InputOutputPartition partition = Syft::InputOutputPartition::construct_from_input(inputs, outputs);
+        REQUIRE(Syft::Test::verdicts_agree(formula, partition, [](Syft::DfaConstructionOptions& dfa_options) {
+            dfa_options.safety_first = true;
+        }, true));
+    }
+}
+
+TEST_CASE("LTLf+ EL game pre-checked within a bounded horizon", "[test1]")
+{
+
+    // Those marked are won within a few steps, by the colors they settle
+    std::vector<std::tuple<std::string, vars, vars, bool>> specs = {
+        {"E(F(a))", vars{"e"}, vars{"a"}, true},
+        {"E(F(a & X(a))) & A(G(e -> a))", vars{"e"}, vars{"a"}, true},
+        {"E(F(e)) | A(G(!e))", vars{"e"}, vars{"a"}, true},
+        {"E(F(e))", vars{"e"}, vars{"a"}, false},
+        {"AE(a) && EA(b) && A(c) || E(d) || E(d1)", vars{"d", "d1"}, vars{"a", "b", "c"}, false}};
+    for (const auto& [formula, inputs, outputs, won_early] : specs) {
+        INFO("formula: " << formula);
+        Syft::InputOutputPartition partition = Syft::InputOutputPartition::construct_from_input(inputs, outputs);
+        REQUIRE(Syft::Test::verdicts_agree(formula, partition, [](Syft::DfaConstructionOptions& dfa_options) {
+            dfa_options.realizability_only = true;
+            dfa_options.horizon_precheck = 3;
+        }));
+        // A hit skips the Zielonka tree, which the full solve returns
+        for (Syft::Player starting_player : {Syft::Player::Agent, Syft::Player::Environment}) {
+            INFO("agent first: " << (starting_player == Syft::Player::Agent));
+            for (std::size_t horizon : {0, 3}) {
+                Syft::DfaConstructionOptions dfa_options;
+                dfa_options.realizability_only = true;
+                dfa_options.horizon_precheck = horizon;
+                Syft::LTLfPlusSynthesizer synthesizer(Syft::Test::get_ltlfplus_from_input(formula), partition,
+                                                      starting_player, Syft::Player::Agent, Syft::VarMgrOptions(),
+                                                      dfa_options);
+                Syft::ELSynthesisResult result = synthesizer.run();
+                if (horizon == 0) {
+                    REQUIRE((!result.realizability || result.z_tree != nullptr));
+                } else if (won_early) {
+                    REQUIRE(result.realizability);
+                    REQUIRE(result.z_tree == nullptr);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("LTLf+ EL game solved for both orders of play on one arena", "[test1]")
+{
+
+    std::vector<std::tuple<std::string, vars, vars>> specs = {
+        {"E(F(e)) | A(G(!e))", vars{"e"}, vars{"a"}},
+        {"A(G(e -> a)) & E(F(a))", vars{"e"}, vars{"a"}},
+        {"A(G(a <-> e))", vars{"e"}, vars{"a"}},
+        {"(AE(e1) -> AE(s1)) & (AE(e2) -> AE(s2))", vars{"e1", "e2"}, vars{"s1", "s2"}}};
+    for (const auto& [formula, inputs, outputs] : specs) {
+        INFO("formula: " << formula);
+        Syft::InputOutputPartition partition = Syft::InputOutputPartition::construct_from_input(inputs, outputs);
+        for (bool symbolic_colors : {false, true}) {
+            INFO("symbolic colors: " << symbolic_colors);
+            Syft::DfaConstructionOptions dfa_options;
+            dfa_options.symbolic_colors = symbolic_colors;
+            std::vector<bool> expected;
+            for (Syft::Player starting_player : {Syft::Player::Agent, Syft::Player::Environment}) {
+                Syft::LTLfPlusSynthesizer synthesizer(Syft::Test::get_ltlfplus_from_input(formula), partition,
+                                                      starting_player, Syft::Player::Agent, Syft::VarMgrOptions(),
+                                                      dfa_options);
+                expected.push_back(synthesizer.run().realizability);
+            }
+            Syft::LTLfPlusSynthesizer synthesizer(Syft::Test::get_ltlfplus_from_input(formula), partition,
+                                                  Syft::Player::Agent, Syft::Player::Agent, Syft::VarMgrOptions(),
+                                                  dfa_options);
+            auto [agent_first, environment_first] = synthesizer.run_both_orders();
+            REQUIRE(agent_first.realizability == expected[0]);
+            REQUIRE(environment_first.realizability == expected[1]);
+        }
+    }
+}
+
 TEST_CASE("LTLf+ MP game test", "[test]")
 {
 
@@ -131,6 +424,100 @@ TEST_CASE("LTLf+ MP game test4", "[test4]")
     REQUIRE(actual == expected);
 }
 
+TEST_CASE("LTLf+ MP game with parallel DAG levels", "[test1]")
+{
+
+    std::string boolean_formula = "(AE(e1) -> AE(s1)) & (AE(e2) -> AE(s2)) & E(F(X(false) & s3)) & (AE(e4) -> AE(s4)) & (AE(e5) -> AE(s5))";
+
+    bool expected = Syft::Test::get_realizability_ltlfplusMP_from_input(boolean_formula, vars{"e1", "e2", "e3", "e4", "e5", "e6"}, vars{"s1", "s2", "s3", "s4", "s5", "s6"}, 1);
+    for (std::size_t threads : {2, 4}) {
+        INFO("threads: " << threads);
+        bool actual = Syft::Test::get_realizability_ltlfplusMP_from_input(boolean_formula, vars{"e1", "e2", "e3", "e4", "e5", "e6"}, vars{"s1", "s2", "s3", "s4", "s5", "s6"}, 1, threads);
+        REQUIRE(actual == expected);
+    }
+}
+
+TEST_CASE("LTLf+ MP game solved by a DAG worker", "[test1]")
+{
+
+    std::string boolean_formula = "(AE(e1) -> AE(s1)) & (AE(e2) -> AE(s2)) & E(F(X(false) & s3)) & (AE(e4) -> AE(s4)) & (AE(e5) -> AE(s5))";
+
+    bool expected = Syft::Test::get_realizability_ltlfplusMP_from_input(boolean_formula, vars{"e1", "e2", "e3", "e4", "e5", "e6"}, vars{"s1", "s2", "s3", "s4", "s5", "s6"}, 1);
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "lydiasyft_dag_worker_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    // The worker has its own manager, as it would in another process
+    std::size_t solved = 0;
+    std::thread worker([&]() { solved = Syft::DagWorkQueue::serve(directory.string(), Syft::VarMgrOptions(), std::chrono::milliseconds(5)); });
+    bool actual = Syft::Test::get_realizability_ltlfplusMP_from_input(boolean_formula, vars{"e1", "e2", "e3", "e4", "e5", "e6"}, vars{"s1", "s2", "s3", "s4", "s5", "s6"}, 1, 1, directory.string());
+    worker.join();
+    REQUIRE(actual == expected);
+    REQUIRE(solved > 0);
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("LTLf+ MP game solved by DAG workers twice in one directory", "[test1]")
+{
+
+    std::string boolean_formula = "(AE(e1) -> AE(s1)) & (AE(e2) -> AE(s2)) & E(F(X(false) & s3)) & (AE(e4) -> AE(s4)) & (AE(e5) -> AE(s5))";
+
+    bool expected = Syft::Test::get_realizability_ltlfplusMP_from_input(boolean_formula, vars{"e1", "e2", "e3", "e4", "e5", "e6"}, vars{"s1", "s2", "s3", "s4", "s5", "s6"}, 1);
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "lydiasyft_dag_worker_rerun_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    // Left behind by a crashed run: neither a result nor a done marker of this one
+    std::ofstream(directory / "job-0.result") << "not a result";
+    std::ofstream(directory / "done") << "crashed-run\n";
+    // The second run finds the done marker and the arena of the first one
+    for (int run = 0; run < 2; ++run) {
+        INFO("run: " << run);
+        std::size_t solved = 0;
+        std::thread worker([&]() { solved = Syft::DagWorkQueue::serve(directory.string(), Syft::VarMgrOptions(), std::chrono::milliseconds(5)); });
+        bool actual = Syft::Test::get_realizability_ltlfplusMP_from_input(boolean_formula, vars{"e1", "e2", "e3", "e4", "e5", "e6"}, vars{"s1", "s2", "s3", "s4", "s5", "s6"}, 1, 1, directory.string());
+        worker.join();
+        REQUIRE(actual == expected);
+        REQUIRE(solved > 0);
+    }
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("LTLf+ MP game with a symbolic strategy", "[test1]")
+{
+
+    std::vector<std::tuple<std::string, vars, vars>> specs = {
+        {"(AE(a) & AE(b)) | EA(c) | EA(d) | A(e)", vars{"c", "d", "e"}, vars{"a", "b"}},
+        {"(AE(e1) -> AE(s1)) & (AE(e2) -> AE(s2)) & E(F(X(false) & s3))", vars{"e1", "e2", "e3"}, vars{"s1", "s2", "s3"}}};
+    bool strategy = STRATEGY;
+    STRATEGY = true;
+    for (const auto& [formula, inputs, outputs] : specs) {
+        for (int game_solver : {1, 2}) {
+            INFO("formula: " << formula << " game solver: " << game_solver);
+            Syft::InputOutputPartition partition = Syft::InputOutputPartition::construct_from_input(inputs, outputs);
+            Syft::DfaConstructionOptions dfa_options;
+            Syft::LTLfPlusSynthesizerMP explicit_synthesizer(Syft::Test::get_ltlfplus_from_input(formula), partition,
+                                                             Syft::Player::Agent, Syft::Player::Agent, game_solver,
+                                                             Syft::VarMgrOptions(), dfa_options);
+            Syft::MPSynthesisResult explicit_result = explicit_synthesizer.run();
+            REQUIRE(explicit_result.realizability);
+            REQUIRE(!explicit_result.output_function.empty());
+            REQUIRE(!explicit_result.transducer);
+
+            dfa_options.symbolic_strategy = true;
+            Syft::LTLfPlusSynthesizerMP symbolic_synthesizer(Syft::Test::get_ltlfplus_from_input(formula), partition,
+                                                             Syft::Player::Agent, Syft::Player::Agent, game_solver,
+                                                             Syft::VarMgrOptions(), dfa_options);
+            Syft::MPSynthesisResult symbolic_result = symbolic_synthesizer.run();
+            REQUIRE(symbolic_result.realizability);
+            REQUIRE(symbolic_result.output_function.empty());
+            REQUIRE(symbolic_result.transducer);
+            REQUIRE(symbolic_result.transducer->get_output_function().size() == outputs.size());
+            REQUIRE(symbolic_result.transducer->get_transition_function().size() ==
+                    symbolic_result.transducer->get_state_variables().size());
+        }
+    }
+    STRATEGY = strategy;
+}
+
 TEST_CASE("LTLf+ MP Adv game test", "[test]")
 {
 
@@ -191,3 +578,34 @@ TEST_CASE("LTLf+ MP Adv game test4", "[test4]")
     REQUIRE(actual == expected);
 }
 
+
+TEST_CASE("LTLf+ MP Adv game with DAG nodes without reachable states", "[test]")
+{
+
+    // The colors of a1 and !a1, or of e1 and !e1, never hold together: the DAG nodes with both bits set are empty
+    std::vector<std::tuple<std::string, vars, vars>> specs = {
+        {"AE(a1) | EA(!a1)", vars{"e1"}, vars{"a1"}},
+        {"(AE(e1) -> AE(a1)) & (EA(!e1) | A(!a1))", vars{"e1"}, vars{"a1"}}};
+    bool strategy = STRATEGY;
+    STRATEGY = false;
+    for (const auto& [formula, inputs, outputs] : specs) {
+        INFO("formula: " << formula);
+        Syft::InputOutputPartition partition = Syft::InputOutputPartition::construct_from_input(inputs, outputs);
+        Syft::DfaConstructionOptions dfa_options;
+        dfa_options.mp_prune_nodes = false;
+        Syft::LTLfPlusSynthesizerMP unpruned_synthesizer(Syft::Test::get_ltlfplus_from_input(formula), partition,
+                                                         Syft::Player::Agent, Syft::Player::Agent, 2,
+                                                         Syft::VarMgrOptions(), dfa_options);
+        Syft::MPSynthesisResult unpruned_result = unpruned_synthesizer.run();
+        REQUIRE(unpruned_result.pruned_nodes == 0);
+
+        dfa_options.mp_prune_nodes = true;
+        Syft::LTLfPlusSynthesizerMP pruned_synthesizer(Syft::Test::get_ltlfplus_from_input(formula), partition,
+                                                       Syft::Player::Agent, Syft::Player::Agent, 2,
+                                                       Syft::VarMgrOptions(), dfa_options);
+        Syft::MPSynthesisResult pruned_result = pruned_synthesizer.run();
+        REQUIRE(pruned_result.pruned_nodes > 0);
+        REQUIRE(pruned_result.realizability == unpruned_result.realizability);
+    }
+    STRATEGY = strategy;
+}
@@ -0,0 +1,50 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <string>
+#include <vector>
+#include "utils.hpp"
+#include "game/FixpointTrace.h"
+#include "game/InputOutputPartition.h"
+#include "synthesizer/ObligationLTLfPlusSynthesizer.h"
+
+namespace {
+  bool obligation_realizability(const std::string& formula, const Syft::InputOutputPartition& partition,
+                                Syft::Player starting_player, Syft::FixpointMode mode, bool pure_obligation_games) {
+    MinimisationOptions options;
+    options.fixpoint_mode = mode;
+    options.pure_obligation_games = pure_obligation_games;
+    // Small arenas would otherwise be solved explicitly, before the pure obligation games
+    options.explicit_game_max_states = 0;
+    Syft::ObligationLTLfPlusSynthesizer synthesizer(Syft::Test::get_ltlfplus_from_input(formula), partition,
+                                                    starting_player, Syft::Player::Agent, false,
+                                                    Syft::BuchiSolver::BuchiMode::CLASSIC, options);
+    return synthesizer.run().realizability;
+  }
+}
+
+TEST_CASE("Pure obligation games agree with the weak game solver", "[obligation]")
+{
+  std::vector<std::string> specs = {
+      // All colors A: one safety game
+      "A(G(e1 -> a1))",
+      "A(G(e1 -> a1)) & A(G(e2 -> !a1))",
+      "A(G(a1 | e1)) | A(G(!a1 & a2))",
+      // All colors E: one reachability game
+      "E(F(a1 & e1))",
+      "E(F(a1)) & E(F(e1 & a2))",
+      "E(F(e1 & a1)) | E(F(!e1 & a2))"};
+  Syft::InputOutputPartition partition =
+      Syft::InputOutputPartition::construct_from_input(vars{"e1", "e2"}, vars{"a1", "a2"});
+
+  for (const std::string& formula : specs) {
+    for (Syft::Player starting_player : {Syft::Player::Agent, Syft::Player::Environment}) {
+      for (Syft::FixpointMode mode : {Syft::FixpointMode::Full, Syft::FixpointMode::Frontier}) {
+        INFO("formula: " << formula << ", agent first: " << (starting_player == Syft::Player::Agent)
+             << ", frontier: " << (mode == Syft::FixpointMode::Frontier));
+        bool weak_game = obligation_realizability(formula, partition, starting_player, mode, false);
+        bool pure_game = obligation_realizability(formula, partition, starting_player, mode, true);
+        REQUIRE(pure_game == weak_game);
+      }
+    }
+  }
+}
@@ -0,0 +1,53 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <memory>
+#include <sstream>
+#include "OneStepBdd.h"
+#include "VarMgr.h"
+#include "lydia/parser/ltlf/driver.hpp"
+
+namespace {
+  whitemech::lydia::ltlf_ptr parse(const std::string& formula) {
+    whitemech::lydia::parsers::ltlf::LTLfDriver driver;
+    std::stringstream stream(formula);
+    driver.parse(stream);
+    return std::static_pointer_cast<const whitemech::lydia::LTLfFormula>(driver.get_result());
+  }
+}
+
+TEST_CASE("One-step letters and checks", "[onestep]")
+{
+    auto var_mgr = std::make_shared<Syft::VarMgr>();
+    var_mgr->create_named_variables({"x", "y"});
+    var_mgr->partition_variables({"x"}, {"y"});
+    Syft::OneStepBdd one_step(var_mgr);
+    CUDD::BDD x = var_mgr->name_to_variable("x");
+    CUDD::BDD y = var_mgr->name_to_variable("y");
+
+    REQUIRE(one_step.satisfying_letters(*parse("F(x & y)")) == (x & y));
+    REQUIRE(one_step.possible_letters(*parse("F(x & y)")).IsOne());
+    REQUIRE(one_step.satisfying_letters(*parse("y & X(x)")).IsZero());
+    REQUIRE(one_step.possible_letters(*parse("y & X(x)")) == y);
+
+    REQUIRE(one_step.realizable(*parse("x | y")) == std::optional<CUDD::BDD>(y));
+    REQUIRE_FALSE(one_step.realizable(*parse("x & y")).has_value());
+    REQUIRE(one_step.unrealizable(*parse("G(x)"), Syft::Player::Agent));
+    REQUIRE_FALSE(one_step.unrealizable(*parse("G(y)"), Syft::Player::Agent));
+}
+
+TEST_CASE("Colors decided by their first step", "[onestep]")
+{
+    auto var_mgr = std::make_shared<Syft::VarMgr>();
+    var_mgr->create_named_variables({"x", "y"});
+    var_mgr->partition_variables({"x"}, {"y"});
+    Syft::OneStepBdd one_step(var_mgr);
+    using whitemech::lydia::PrefixQuantifier;
+
+    REQUIRE(one_step.constant_value(*parse("x | !x"), PrefixQuantifier::Exists) == std::optional<bool>(true));
+    REQUIRE(one_step.constant_value(*parse("X(y)"), PrefixQuantifier::Forall) == std::optional<bool>(false));
+    REQUIRE(one_step.constant_value(*parse("y & !y"), PrefixQuantifier::ForallExists) ==
+            std::optional<bool>(false));
+    // Decided by later steps
+    REQUIRE_FALSE(one_step.constant_value(*parse("F(y)"), PrefixQuantifier::Exists).has_value());
+    REQUIRE_FALSE(one_step.constant_value(*parse("x | !x"), PrefixQuantifier::Forall).has_value());
+}
@@ -0,0 +1,40 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <optional>
+#include <string>
+#include <vector>
+#include "Parser.h"
+
+TEST_CASE("Basic TLSF is parsed without syfco", "[parser]")
+{
+    std::string spec = R"(INFO {
+  TITLE:       "LTLf-test"
+  SEMANTICS:   Finite,Moore
+  TARGET:      Moore
+}
+// The signals
+MAIN {
+  INPUTS { a1; a2; }
+  OUTPUTS { b1; /* the only output */ }
+  ASSUMPTIONS { G(a1 -> a2); }
+  GUARANTEES {
+    F(a1 <-> b1);
+    G(a2);
+  }
+})";
+    std::optional<Syft::Parser> parser = Syft::Parser::parse_basic_tlsf(spec);
+    REQUIRE(parser.has_value());
+    REQUIRE(parser->get_input_variables() == std::vector<std::string>{"a1", "a2"});
+    REQUIRE(parser->get_output_variables() == std::vector<std::string>{"b1"});
+    REQUIRE(parser->get_sys_first());
+    REQUIRE(parser->get_formula() == "(G(a1 -> a2)) -> ((F(a1 <-> b1)) && (G(a2)))");
+
+    std::string parameterized = R"(INFO { TARGET: Mealy }
+GLOBAL { PARAMETERS { n = 2; } }
+MAIN { INPUTS { a; } OUTPUTS { b; } GUARANTEES { F(a); } })";
+    REQUIRE_FALSE(Syft::Parser::parse_basic_tlsf(parameterized).has_value());
+
+    std::string bus = R"(INFO { TARGET: Mealy }
+MAIN { INPUTS { a[2]; } OUTPUTS { b; } GUARANTEES { F(b); } })";
+    REQUIRE_FALSE(Syft::Parser::parse_basic_tlsf(bus).has_value());
+}
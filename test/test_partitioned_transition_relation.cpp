@@ -0,0 +1,61 @@
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/generators/catch_generators_all.hpp"
+
+#include <sstream>
+#include "automata/ExplicitStateDfa.h"
+#include "automata/SymbolicStateDfa.h"
+#include "game/PartitionedTransitionRelation.h"
+#include "VarMgr.h"
+#include "lydia/parser/ltlf/driver.hpp"
+
+namespace {
+  Syft::ExplicitStateDfa dfa_of(const std::string& formula) {
+    whitemech::lydia::parsers::ltlf::LTLfDriver driver;
+    std::stringstream stream(formula);
+    driver.parse(stream);
+    auto parsed = std::static_pointer_cast<const whitemech::lydia::LTLfFormula>(driver.get_result());
+    return Syft::ExplicitStateDfa::dfa_of_formula(*parsed);
+  }
+}
+
+TEST_CASE("Partitioned relation agrees with the monolithic relation", "[partitioned]")
+{
+    std::shared_ptr<Syft::VarMgr> var_mgr = std::make_shared<Syft::VarMgr>();
+    Syft::SymbolicStateDfa dfa = Syft::SymbolicStateDfa::from_mona(
+        var_mgr, dfa_of("G(a -> X(b)) & F(c & X(a | b))"));
+    var_mgr->partition_variables({"a", "c"}, {"b"});
+
+    std::size_t automaton_id = dfa.automaton_id();
+    std::size_t bit_count = var_mgr->state_variable_count(automaton_id);
+    std::size_t primed_id = var_mgr->create_state_variables(bit_count);
+
+    // 1 keeps every bit relation in its own cluster
+    std::size_t threshold = GENERATE(std::size_t(1), Syft::PartitionedTransitionRelation::default_cluster_threshold);
+    Syft::PartitionedTransitionRelation relation(dfa, primed_id, threshold);
+    REQUIRE(relation.clusters().size() <= bit_count);
+
+    std::vector<CUDD::BDD> state_vars = var_mgr->get_state_variables(automaton_id);
+    std::vector<CUDD::BDD> primed_vars = var_mgr->get_state_variables(primed_id);
+    std::vector<CUDD::BDD> transition_function = dfa.transition_function();
+    CUDD::BDD monolithic = var_mgr->cudd_mgr()->bddOne();
+    for (std::size_t i = 0; i < bit_count; ++i) {
+        monolithic &= primed_vars[i].Xnor(transition_function[i]);
+    }
+    CUDD::BDD io_cube = var_mgr->input_cube() * var_mgr->output_cube();
+    CUDD::BDD state_cube = var_mgr->state_variables_cube(automaton_id);
+
+    CUDD::BDD finals = dfa.final_states();
+    CUDD::BDD composed = finals.VectorCompose(var_mgr->make_compose_vector(automaton_id, transition_function));
+    REQUIRE(relation.MovePreimage(finals) == composed);
+    REQUIRE(relation.Preimage(finals) == composed.ExistAbstract(io_cube));
+    CUDD::BDD output_cube = var_mgr->output_cube();
+    REQUIRE(relation.MovePreimage(finals, output_cube) == composed.ExistAbstract(output_cube));
+    REQUIRE(relation.MovePreimage(finals, io_cube) == relation.Preimage(finals));
+
+    CUDD::BDD initial = dfa.initial_state_bdd();
+    CUDD::BDD image = (initial & monolithic).ExistAbstract(state_cube * io_cube)
+        .SwapVariables(primed_vars, state_vars);
+    REQUIRE(relation.Image(initial) == image);
+
+    REQUIRE(relation.StateRelation() == monolithic.ExistAbstract(io_cube));
+}
@@ -0,0 +1,58 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "Portfolio.h"
+
+TEST_CASE("Portfolio reports the first verdict", "[portfolio]") {
+  Syft::Portfolio portfolio;
+  portfolio.add("slow", []() {
+    std::this_thread::sleep_for(std::chrono::seconds(30));
+    return true;
+  });
+  portfolio.add("failing", []() -> bool {
+    throw std::runtime_error("not applicable");
+  });
+  portfolio.add("fast", []() { return false; });
+
+  auto start = std::chrono::steady_clock::now();
+  std::optional<Syft::PortfolioVerdict> verdict = portfolio.run();
+  REQUIRE(verdict.has_value());
+  REQUIRE(verdict->winner == "fast");
+  REQUIRE_FALSE(verdict->realizability);
+  // The slow entry was cancelled rather than waited for
+  REQUIRE(std::chrono::steady_clock::now() - start < std::chrono::seconds(10));
+}
+
+TEST_CASE("Portfolio without any verdict", "[portfolio]") {
+  Syft::Portfolio portfolio;
+  portfolio.add("failing", []() -> bool {
+    throw std::runtime_error("not applicable");
+  });
+  REQUIRE_FALSE(portfolio.run().has_value());
+}
+
+TEST_CASE("Portfolio leaves the other children of the process alone", "[portfolio]") {
+  // A child of the caller, e.g. another job of the batch mode, that exits while the portfolio runs
+  pid_t other = fork();
+  REQUIRE(other >= 0);
+  if (other == 0) {
+    _exit(42);
+  }
+  Syft::Portfolio portfolio;
+  portfolio.add("slow", []() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    return true;
+  });
+  std::optional<Syft::PortfolioVerdict> verdict = portfolio.run();
+  REQUIRE(verdict.has_value());
+  REQUIRE(verdict->winner == "slow");
+
+  int status = 0;
+  REQUIRE(waitpid(other, &status, 0) == other);
+  REQUIRE(WIFEXITED(status));
+  REQUIRE(WEXITSTATUS(status) == 42);
+}
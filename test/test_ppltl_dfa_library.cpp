@@ -0,0 +1,81 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include "utils.hpp"
+#include "automata/ppltl/PPLTLDfaLibrary.h"
+#include "lydia/parser/ppltl/driver.hpp"
+#include "synthesizer/PPLTLfPlusSynthesizer.h"
+#include "synthesizer/PPLTLfPlusSynthesizerMP.h"
+
+namespace {
+  whitemech::lydia::ppltl_ptr parse_ppltl(const std::string& text) {
+    whitemech::lydia::parsers::ppltl::PPLTLDriver driver;
+    std::stringstream stream(text);
+    driver.parse(stream);
+    return std::static_pointer_cast<const whitemech::lydia::PPLTLFormula>(driver.get_result());
+  }
+
+  bool realizable(const Syft::PPLTLPlus& spec, const Syft::InputOutputPartition& partition,
+                  const std::shared_ptr<const Syft::PPLTLDfaLibrary>& library) {
+    Syft::PPLTLfPlusSynthesizer synthesizer(spec, partition, Syft::Player::Agent, Syft::Player::Agent);
+    synthesizer.set_dfa_library(library);
+    return synthesizer.run().realizability;
+  }
+}
+
+TEST_CASE("Batches of PPLTL formulas are converted once", "[ppltl-dfa-library]")
+{
+  std::filesystem::path directory = std::filesystem::temp_directory_path() / "lydiasyft_test_dfa_library";
+  std::filesystem::remove_all(directory);
+  Syft::InputOutputPartition partition = Syft::InputOutputPartition::construct_from_input({"b"}, {"a"});
+  auto var_mgr = std::make_shared<Syft::VarMgr>();
+  Syft::PPLTLDfaLibrary compiled = Syft::PPLTLDfaLibrary::compile(
+      {"O(a)", "Y(b) & O(a)", "O(a)"}, directory.string(), var_mgr, &partition);
+  // Formulas listed twice are converted once
+  REQUIRE(compiled.size() == 2);
+  REQUIRE(std::filesystem::exists(directory / "manifest.jsonl"));
+
+  Syft::PPLTLDfaLibrary library = Syft::PPLTLDfaLibrary::read_manifest((directory / "manifest.jsonl").string());
+  REQUIRE(library.size() == 2);
+  REQUIRE(library.find(*parse_ppltl("O(a)")).has_value());
+  REQUIRE_FALSE(library.find(*parse_ppltl("Y(a)")).has_value());
+
+  // A DFA only needs the variables it depends on
+  auto fresh = std::make_shared<Syft::VarMgr>();
+  fresh->create_named_variables({"a"});
+  Syft::SymbolicStateDfa loaded = Syft::SymbolicStateDfa::load(fresh, *library.find(*parse_ppltl("O(a)")));
+  REQUIRE_FALSE(loaded.final_states().IsZero());
+
+  // Formulas over variables outside the partition are refused
+  REQUIRE_THROWS_AS(Syft::PPLTLDfaLibrary::compile({"O(c)"}, directory.string(), std::make_shared<Syft::VarMgr>(),
+                                                   &partition), std::runtime_error);
+  std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("Synthesizers load the DFAs of a library", "[ppltl-dfa-library]")
+{
+  std::filesystem::path directory = std::filesystem::temp_directory_path() / "lydiasyft_test_dfa_library_spec";
+  std::filesystem::remove_all(directory);
+  Syft::InputOutputPartition partition = Syft::InputOutputPartition::construct_from_input({"b"}, {"a"});
+  Syft::PPLTLPlus spec = Syft::Test::get_ppltlfplus_from_input("E(O(a))");
+  REQUIRE(realizable(spec, partition, nullptr));
+
+  Syft::PPLTLDfaLibrary::compile({"O(a)", "a & !a"}, directory.string(), std::make_shared<Syft::VarMgr>(),
+                                 &partition);
+  auto library = std::make_shared<Syft::PPLTLDfaLibrary>(
+      Syft::PPLTLDfaLibrary::read_manifest((directory / "manifest.jsonl").string()));
+  REQUIRE(realizable(spec, partition, library));
+  Syft::PPLTLfPlusSynthesizerMP mp_synthesizer(spec, partition, Syft::Player::Agent, Syft::Player::Agent, 1);
+  mp_synthesizer.set_dfa_library(library);
+  REQUIRE(mp_synthesizer.run().realizability);
+
+  // The DFAs are trusted: one accepting nothing makes the spec unrealizable
+  library->add(*parse_ppltl("O(a)"), (directory / "dfa-1.sdfa").string());
+  REQUIRE_FALSE(realizable(spec, partition, library));
+  std::filesystem::remove_all(directory);
+}
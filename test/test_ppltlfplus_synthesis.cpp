@@ -10,6 +10,9 @@
 #include "game/InputOutputPartition.h"
 #include "Synthesizer.h"
 #include "synthesizer/PPLTLfPlusSynthesizer.h"
+#include "automata/SymbolicStateDfa.h"
+#include "automata/ppltl/ValVisitor.h"
+#include <lydia/parser/ppltl/driver.hpp>
 
 
 TEST_CASE("PPLTLf+ EL game test", "[test]")
@@ -49,3 +52,55 @@ TEST_CASE("PPLTLf+ MP Adv game test", "[test]")
 }
 
 
+
+TEST_CASE("PPLTL valuations are shared across formulas", "[ppltl]")
+{
+    auto parse = [](const std::string& formula) {
+        whitemech::lydia::parsers::ppltl::PPLTLDriver driver;
+        std::stringstream stream(formula);
+        driver.parse(stream);
+        return std::static_pointer_cast<const whitemech::lydia::PPLTLFormula>(driver.get_result());
+    };
+    auto first = parse("Y(a) & O(b)");
+    auto second = parse("O(b) | Y(a)");
+
+    std::shared_ptr<Syft::VarMgr> var_mgr = std::make_shared<Syft::VarMgr>();
+    auto valuations = std::make_shared<Syft::PPLTLValuationTable>(var_mgr);
+    Syft::SymbolicStateDfa::dfa_of_ppltl_formula(*first, var_mgr, valuations);
+    REQUIRE(valuations->hits() == 0);
+
+    // The arguments of Y(a) and Y(O(b)) are evaluated once
+    Syft::SymbolicStateDfa shared = Syft::SymbolicStateDfa::dfa_of_ppltl_formula(*second, var_mgr, valuations);
+    REQUIRE(valuations->hits() >= 2);
+    Syft::SymbolicStateDfa unshared = Syft::SymbolicStateDfa::dfa_of_ppltl_formula(*second, var_mgr);
+    REQUIRE(shared.transition_function() == unshared.transition_function());
+
+    std::shared_ptr<Syft::VarMgr> other = std::make_shared<Syft::VarMgr>();
+    REQUIRE_THROWS_AS(Syft::SymbolicStateDfa::dfa_of_ppltl_formula(*second, other, valuations), std::runtime_error);
+}
+
+TEST_CASE("PPLTL state variables ordered by dependency", "[ppltl]")
+{
+    whitemech::lydia::parsers::ppltl::PPLTLDriver driver;
+    std::stringstream stream("Y(a) & O(b)");
+    driver.parse(stream);
+    auto formula = std::static_pointer_cast<const whitemech::lydia::PPLTLFormula>(driver.get_result());
+
+    std::shared_ptr<Syft::VarMgr> var_mgr = std::make_shared<Syft::VarMgr>();
+    var_mgr->create_named_variables({"a", "b"});
+    Syft::SymbolicStateDfa dfa = Syft::SymbolicStateDfa::dfa_of_ppltl_formula(
+        *formula, var_mgr, nullptr, Syft::PPLTLVariableOrder::Dependency);
+
+    // Every state bit lies below the other variables its transition reads
+    auto cudd = var_mgr->cudd_mgr();
+    std::vector<CUDD::BDD> state_variables = var_mgr->get_state_variables(dfa.automaton_id());
+    for (std::size_t i = 0; i < state_variables.size(); ++i) {
+        unsigned int own = state_variables[i].NodeReadIndex();
+        for (unsigned int index : dfa.transition_function()[i].SupportIndices()) {
+            if (index != own) {
+                REQUIRE(cudd->ReadPerm(index) < cudd->ReadPerm(own));
+            }
+        }
+    }
+    REQUIRE(var_mgr->variable_order().size() == var_mgr->total_variable_count());
+}
@@ -0,0 +1,113 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include "utils.hpp"
+#include "automata/PrecompiledAutomata.h"
+#include "lydia/logic/ltlfplus/base.hpp"
+#include "synthesizer/LTLfPlusSynthesizer.h"
+#include "synthesizer/LTLfPlusSynthesizerMP.h"
+
+namespace {
+  // A DFA of F(a) over the propositions "b" and "a", in the HOA format of Spot
+  const std::string eventually_a =
+      "HOA: v1\n"
+      "States: 2\n"
+      "Start: 0\n"
+      "AP: 2 \"b\" \"a\"\n"
+      "acc-name: Buchi\n"
+      "Acceptance: 1 Inf(0)\n"
+      "properties: trans-labels explicit-labels state-acc deterministic\n"
+      "--BODY--\n"
+      "State: 0\n"
+      "[1] 1\n"
+      "[!1 & (0 | !0)] 0\n"
+      "State: 1 \"done\" {0}\n"
+      "[t] 1\n"
+      "--END--\n";
+
+  void write_file(const std::filesystem::path& path, const std::string& text) {
+    std::ofstream(path) << text;
+  }
+
+  bool realizable(const Syft::LTLfPlus& spec, const Syft::InputOutputPartition& partition,
+                  const Syft::DfaConstructionOptions& dfa_options) {
+    Syft::LTLfPlusSynthesizer synthesizer(spec, partition, Syft::Player::Agent, Syft::Player::Agent,
+                                          Syft::VarMgrOptions(), dfa_options);
+    return synthesizer.run().realizability;
+  }
+}
+
+TEST_CASE("HOA automata are read as DFAs", "[precompiled-automata]")
+{
+  std::istringstream in(eventually_a);
+  Syft::ExplicitStateDfa dfa = Syft::PrecompiledAutomata::read_hoa(in);
+  REQUIRE(dfa.names == std::vector<std::string>{"b", "a"});
+  // The two states and the sink of missing transitions
+  REQUIRE(dfa.get_nb_states() == 3);
+  REQUIRE(dfa.get_final() == std::vector<std::size_t>{1});
+
+  std::istringstream nondeterministic(
+      "HOA: v1\nStart: 0\nAP: 1 \"a\"\nAcceptance: 1 Inf(0)\n--BODY--\n"
+      "State: 0 {0}\n[0] 0\n[t] 1\nState: 1\n[t] 1\n--END--\n");
+  REQUIRE_THROWS_AS(Syft::PrecompiledAutomata::read_hoa(nondeterministic), std::runtime_error);
+  std::istringstream transition_based(
+      "HOA: v1\nStart: 0\nAP: 1 \"a\"\nAcceptance: 1 Inf(0)\n--BODY--\nState: 0\n[0] 0 {0}\n--END--\n");
+  REQUIRE_THROWS_AS(Syft::PrecompiledAutomata::read_hoa(transition_based), std::runtime_error);
+  std::istringstream two_initial_states(
+      "HOA: v1\nStart: 0\nStart: 1\nAP: 0\nAcceptance: 1 Inf(0)\n--BODY--\nState: 0\nState: 1\n--END--\n");
+  REQUIRE_THROWS_AS(Syft::PrecompiledAutomata::read_hoa(two_initial_states), std::runtime_error);
+}
+
+TEST_CASE("Colors read the precompiled DFAs of their arguments", "[precompiled-automata]")
+{
+  std::filesystem::path directory = std::filesystem::temp_directory_path() / "lydiasyft_test_precompiled";
+  std::filesystem::remove_all(directory);
+  std::filesystem::create_directories(directory);
+  Syft::InputOutputPartition partition = Syft::InputOutputPartition::construct_from_input({"b"}, {"a"});
+  Syft::LTLfPlus spec = Syft::Test::get_ltlfplus_from_input("E(F(a))");
+  const whitemech::lydia::LTLfFormula& argument = *spec.formula_to_quantification_.begin()->first->ltlf_arg();
+  Syft::DfaConstructionOptions dfa_options;
+  dfa_options.one_step_colors = false;
+  REQUIRE(realizable(spec, partition, dfa_options));
+
+  // The same language from a HOA file and from a MONA export
+  write_file(directory / "eventually_a.hoa", eventually_a);
+  auto automata = std::make_shared<Syft::PrecompiledAutomata>();
+  automata->add(argument, (directory / "eventually_a.hoa").string());
+  dfa_options.precompiled = automata;
+  REQUIRE(realizable(spec, partition, dfa_options));
+  Syft::LTLfPlusSynthesizerMP mp_synthesizer(spec, partition, Syft::Player::Agent, Syft::Player::Agent, 1,
+                                             Syft::VarMgrOptions(), dfa_options);
+  REQUIRE(mp_synthesizer.run().realizability);
+
+  Syft::ExplicitStateDfa exported = Syft::ExplicitStateDfa::dfa_of_formula(argument);
+  REQUIRE(exported.export_to_file((directory / "eventually_a.dfa").string()));
+  automata->add(argument, (directory / "eventually_a.dfa").string());
+  REQUIRE(realizable(spec, partition, dfa_options));
+
+  // The automaton is trusted: one accepting nothing makes the spec unrealizable
+  write_file(directory / "never.hoa",
+             "HOA: v1\nStart: 0\nAP: 1 \"a\"\nAcceptance: 1 Inf(0)\n--BODY--\nState: 0\n[t] 0\n--END--\n");
+  automata->add(argument, (directory / "never.hoa").string());
+  REQUIRE_FALSE(realizable(spec, partition, dfa_options));
+
+  // As do the automata of a manifest, whose files are relative to it
+  write_file(directory / "automata.jsonl", "{\"formula\": \"F(a)\", \"automaton\": \"never.hoa\"}\n");
+  dfa_options.precompiled = std::make_shared<Syft::PrecompiledAutomata>(
+      Syft::PrecompiledAutomata::read_manifest((directory / "automata.jsonl").string()));
+  REQUIRE(dfa_options.precompiled->find(argument).has_value());
+  REQUIRE_FALSE(realizable(spec, partition, dfa_options));
+
+  // Automata over variables outside the partition are refused
+  write_file(directory / "other.hoa",
+             "HOA: v1\nStart: 0\nAP: 1 \"c\"\nAcceptance: 1 Inf(0)\n--BODY--\nState: 0 {0}\n[t] 0\n--END--\n");
+  automata->add(argument, (directory / "other.hoa").string());
+  dfa_options.precompiled = automata;
+  REQUIRE_THROWS_AS(realizable(spec, partition, dfa_options), std::runtime_error);
+  std::filesystem::remove_all(directory);
+}
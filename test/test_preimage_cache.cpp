@@ -0,0 +1,66 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <stdexcept>
+#include "VarMgr.h"
+#include "game/PreimageCache.h"
+
+TEST_CASE("The preimage cache counts hits and misses", "[preimagecache]")
+{
+  Syft::VarMgr var_mgr;
+  var_mgr.create_named_variables({"a", "b", "c"});
+  CUDD::BDD a = var_mgr.name_to_variable("a");
+  CUDD::BDD b = var_mgr.name_to_variable("b");
+
+  Syft::PreimageCache cache;
+  REQUIRE_FALSE(cache.find(a).has_value());
+  cache.insert(a, a & b);
+  auto cached = cache.find(a);
+  REQUIRE(cached.has_value());
+  REQUIRE(*cached == (a & b));
+  REQUIRE_FALSE(cache.find(b).has_value());
+
+  REQUIRE(cache.stats().lookups == 3);
+  REQUIRE(cache.stats().hits == 1);
+  REQUIRE(cache.stats().entries == 1);
+  REQUIRE(cache.stats().hit_rate() > 0.3);
+
+  cache.clear();
+  REQUIRE(cache.stats().lookups == 0);
+  REQUIRE_FALSE(cache.find(a).has_value());
+}
+
+TEST_CASE("The preimage cache evicts the least recently used entries", "[preimagecache]")
+{
+  Syft::VarMgr var_mgr;
+  var_mgr.create_named_variables({"a", "b", "c"});
+  CUDD::BDD a = var_mgr.name_to_variable("a");
+  CUDD::BDD b = var_mgr.name_to_variable("b");
+  CUDD::BDD c = var_mgr.name_to_variable("c");
+
+  // A variable and its negation have 2 nodes each, so two entries fit
+  Syft::PreimageCache cache(8);
+  cache.insert(a, !a);
+  cache.insert(b, !b);
+  REQUIRE(cache.find(a).has_value());
+  cache.insert(c, !c);
+
+  REQUIRE(cache.stats().evictions == 1);
+  REQUIRE(cache.stats().nodes <= cache.max_nodes());
+  REQUIRE(cache.find(a).has_value());
+  REQUIRE_FALSE(cache.find(b).has_value());
+  REQUIRE(cache.find(c).has_value());
+
+  // Larger than the whole bound
+  Syft::PreimageCache small_cache(3);
+  small_cache.insert(a, !a);
+  REQUIRE_FALSE(small_cache.find(a).has_value());
+}
+
+TEST_CASE("The preimage cache is bound to one game", "[preimagecache]")
+{
+  Syft::PreimageCache cache;
+  cache.attach(0, Syft::Player::Agent, Syft::Player::Agent);
+  REQUIRE_NOTHROW(cache.attach(0, Syft::Player::Agent, Syft::Player::Agent));
+  REQUIRE_THROWS_AS(cache.attach(1, Syft::Player::Agent, Syft::Player::Agent), std::runtime_error);
+  REQUIRE_THROWS_AS(cache.attach(0, Syft::Player::Environment, Syft::Player::Agent), std::runtime_error);
+}
@@ -0,0 +1,135 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <sstream>
+#include "automata/ExplicitStateDfa.h"
+#include "automata/ProductArena.h"
+#include "automata/SymbolicStateDfa.h"
+#include "VarMgr.h"
+#include "lydia/parser/ltlf/driver.hpp"
+
+namespace {
+  Syft::ExplicitStateDfa dfa_of(const std::string& formula) {
+    whitemech::lydia::parsers::ltlf::LTLfDriver driver;
+    std::stringstream stream(formula);
+    driver.parse(stream);
+    auto parsed = std::static_pointer_cast<const whitemech::lydia::LTLfFormula>(driver.get_result());
+    return Syft::ExplicitStateDfa::dfa_of_formula(*parsed);
+  }
+}
+
+TEST_CASE("Product arena agrees with the materialized product", "[productarena]")
+{
+    std::shared_ptr<Syft::VarMgr> var_mgr = std::make_shared<Syft::VarMgr>();
+    std::vector<Syft::SymbolicStateDfa> components = {
+        Syft::SymbolicStateDfa::from_mona(var_mgr, dfa_of("F(a & X(b))")),
+        Syft::SymbolicStateDfa::from_mona(var_mgr, dfa_of("G(b -> X(c))")),
+        Syft::SymbolicStateDfa::from_mona(var_mgr, dfa_of("F(c)"))
+    };
+
+    Syft::SymbolicStateDfa product = Syft::SymbolicStateDfa::product_AND(components);
+    Syft::ProductArena arena(components);
+    Syft::SymbolicStateDfa view = arena.symbolic_view();
+
+    REQUIRE(view.transition_function() == product.transition_function());
+    REQUIRE(view.initial_state() == product.initial_state());
+    REQUIRE(arena.initial_state_bdd() == product.initial_state_bdd());
+    REQUIRE(arena.final_states() == product.final_states());
+    REQUIRE(arena.final_states(1) == components[1].final_states());
+
+    const std::vector<CUDD::BDD>& compose_vector =
+        var_mgr->make_compose_vector(product.automaton_id(), product.transition_function());
+    std::vector<CUDD::BDD> targets = {
+        components[0].final_states(),
+        components[1].final_states() | !components[2].final_states(),
+        product.final_states()
+    };
+    for (const CUDD::BDD& target : targets) {
+        REQUIRE(arena.preimage(target) == target.VectorCompose(compose_vector));
+    }
+}
+
+TEST_CASE("Reachable states of a product arena are closed under transitions", "[productarena]")
+{
+    std::shared_ptr<Syft::VarMgr> var_mgr = std::make_shared<Syft::VarMgr>();
+    std::vector<Syft::SymbolicStateDfa> components = {
+        Syft::SymbolicStateDfa::from_mona(var_mgr, dfa_of("F(a & X(b))")),
+        Syft::SymbolicStateDfa::from_mona(var_mgr, dfa_of("G(b -> X(c))"))
+    };
+    // The image abstracts the alphabet, which needs the partition
+    var_mgr->partition_variables({"a", "c"}, {"b"});
+
+    Syft::SymbolicStateDfa product = Syft::SymbolicStateDfa::product_AND(components);
+    Syft::ProductArena arena(components);
+    CUDD::BDD reachable = arena.reachable_states();
+
+    SECTION("Contains the initial state and reaches a fixpoint") {
+        const std::vector<CUDD::BDD>& compose_vector =
+            var_mgr->make_compose_vector(product.automaton_id(), product.transition_function());
+        REQUIRE((arena.initial_state_bdd() & !reachable).IsZero());
+        REQUIRE((reachable & (!reachable).VectorCompose(compose_vector)).IsZero());
+        REQUIRE(reachable == product.reachable_states());
+    }
+
+    SECTION("Simplified transitions agree on the reachable states") {
+        std::vector<CUDD::BDD> targets = {
+            components[0].final_states(),
+            components[0].final_states() & !components[1].final_states()
+        };
+        std::vector<CUDD::BDD> preimages;
+        for (const CUDD::BDD& target : targets) {
+            preimages.push_back(arena.preimage(target) & reachable);
+        }
+
+        arena.simplify_transitions(reachable);
+        REQUIRE(arena.reachable_states() == reachable);
+        for (std::size_t i = 0; i < targets.size(); ++i) {
+            REQUIRE((arena.preimage(targets[i]) & reachable) == preimages[i]);
+        }
+    }
+}
+
+TEST_CASE("Care simplification keeps the transitions and colors on the care states", "[productarena]")
+{
+    std::shared_ptr<Syft::VarMgr> var_mgr = std::make_shared<Syft::VarMgr>();
+    std::vector<Syft::SymbolicStateDfa> components = {
+        Syft::SymbolicStateDfa::from_mona(var_mgr, dfa_of("F(a & X(b))")),
+        Syft::SymbolicStateDfa::from_mona(var_mgr, dfa_of("G(b -> X(c))"))
+    };
+    var_mgr->partition_variables({"a", "c"}, {"b"});
+
+    for (Syft::StrategyMinimization method :
+         {Syft::StrategyMinimization::Restrict, Syft::StrategyMinimization::LICompaction}) {
+        Syft::ProductArena arena(components);
+        CUDD::BDD reachable = arena.reachable_states();
+        // A color of its own and one that is the final states of a component
+        std::vector<CUDD::BDD> colors = {
+            components[0].final_states() & !components[1].final_states(),
+            components[1].final_states()
+        };
+        std::vector<CUDD::BDD> preimages;
+        for (const CUDD::BDD& color : colors) {
+            preimages.push_back(arena.preimage(color) & reachable);
+        }
+
+        std::vector<CUDD::BDD> simplified = colors;
+        arena.simplify_on_care(reachable, simplified, method);
+        REQUIRE(arena.reachable_states() == reachable);
+        REQUIRE(simplified[1] == arena.final_states(1));
+        for (std::size_t i = 0; i < colors.size(); ++i) {
+            REQUIRE((simplified[i] & reachable) == (colors[i] & reachable));
+            REQUIRE((arena.preimage(colors[i]) & reachable) == preimages[i]);
+        }
+        // Each component still only reads its own state variables
+        CUDD::BDD own_state = var_mgr->state_variables_cube(arena.components()[0].automaton_id());
+        CUDD::BDD other_state = var_mgr->state_variables_cube(arena.components()[1].automaton_id());
+        for (const CUDD::BDD& bit : arena.components()[0].transition_function()) {
+            REQUIRE(bit.ExistAbstract(other_state) == bit);
+        }
+        REQUIRE(arena.final_states(1).ExistAbstract(own_state) == arena.final_states(1));
+    }
+
+    Syft::ProductArena arena(components);
+    std::vector<CUDD::BDD> colors = {components[0].final_states()};
+    arena.simplify_on_care(var_mgr->cudd_mgr()->bddZero(), colors, Syft::StrategyMinimization::Off);
+    REQUIRE(colors[0] == components[0].final_states());
+}
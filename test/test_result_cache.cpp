@@ -0,0 +1,119 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <atomic>
+#include <filesystem>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "ResultCache.h"
+#include "VarMgr.h"
+#include "game/Transducer.h"
+
+namespace {
+  // A controller without state whose output b is a
+  Syft::Transducer copy_controller(const std::shared_ptr<Syft::VarMgr>& var_mgr) {
+    std::unordered_map<int, CUDD::BDD> output_function = {
+        {var_mgr->name_to_variable("b").NodeReadIndex(), var_mgr->name_to_variable("a")}};
+    return Syft::Transducer(var_mgr, std::vector<int>(var_mgr->total_variable_count(), 0), output_function, {},
+                            Syft::Player::Environment, Syft::Player::Agent, {});
+  }
+}
+
+TEST_CASE("Result cache keys are canonical", "[result-cache]")
+{
+  Syft::LTLfPlus spec;
+  spec.color_formula_ = "1 & 2";
+  Syft::InputOutputPartition partition = Syft::InputOutputPartition::construct_from_input({"r1", "r2"}, {"g"});
+  Syft::InputOutputPartition reordered = Syft::InputOutputPartition::construct_from_input({"r2", "r1"}, {"g"});
+  std::string key = Syft::ResultCache::cache_key(spec, partition, Syft::Player::Agent, "game-solver/0");
+
+  REQUIRE(key == Syft::ResultCache::cache_key(spec, reordered, Syft::Player::Agent, "game-solver/0"));
+  REQUIRE(key != Syft::ResultCache::cache_key(spec, partition, Syft::Player::Environment, "game-solver/0"));
+  REQUIRE(key != Syft::ResultCache::cache_key(spec, partition, Syft::Player::Agent, "game-solver/1"));
+  Syft::LTLfPlus other = spec;
+  other.color_formula_ = "1 | 2";
+  REQUIRE(key != Syft::ResultCache::cache_key(other, partition, Syft::Player::Agent, "game-solver/0"));
+}
+
+TEST_CASE("Result cache entries keep their verdict and strategy", "[result-cache]")
+{
+  std::filesystem::path directory = std::filesystem::temp_directory_path() / "lydiasyft_test_result_cache";
+  std::filesystem::remove_all(directory);
+  Syft::ResultCache cache(directory.string());
+  Syft::LTLfPlus spec;
+  spec.color_formula_ = "1";
+  Syft::InputOutputPartition partition = Syft::InputOutputPartition::construct_from_input({"a"}, {"b"});
+  std::string unrealizable = Syft::ResultCache::cache_key(spec, partition, Syft::Player::Agent, "");
+  std::string realizable = Syft::ResultCache::cache_key(spec, partition, Syft::Player::Environment, "");
+
+  REQUIRE_FALSE(cache.load(unrealizable).has_value());
+  cache.store(unrealizable, false);
+  std::optional<Syft::CachedResult> verdict = cache.load(unrealizable, &partition);
+  REQUIRE(verdict.has_value());
+  REQUIRE_FALSE(verdict->realizability);
+  REQUIRE_FALSE(verdict->strategy.has_value());
+
+  auto var_mgr = std::make_shared<Syft::VarMgr>();
+  var_mgr->create_named_variables({"a", "b"});
+  var_mgr->partition_variables({"a"}, {"b"});
+  Syft::Transducer strategy = copy_controller(var_mgr);
+  cache.store(realizable, true, &strategy);
+  std::optional<Syft::CachedResult> hit = cache.load(realizable, &partition);
+  REQUIRE(hit.has_value());
+  REQUIRE(hit->realizability);
+  REQUIRE(hit->strategy.has_value());
+  REQUIRE(hit->strategy->input_labels() == std::vector<std::string>{"a"});
+
+  // Validation refuses a strategy over other variables, which an unvalidated load returns
+  Syft::InputOutputPartition swapped = Syft::InputOutputPartition::construct_from_input({"b"}, {"a"});
+  REQUIRE_FALSE(cache.load(realizable, &swapped).has_value());
+  REQUIRE(cache.load(realizable).has_value());
+
+  // Storing again replaces the entry, without the previous strategy
+  cache.store(realizable, false);
+  REQUIRE_FALSE(cache.load(realizable)->strategy.has_value());
+  // and removes its files: a verdict and a key per entry remain
+  REQUIRE(std::distance(std::filesystem::directory_iterator(directory), std::filesystem::directory_iterator()) == 4);
+  std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("Concurrent result cache stores publish whole entries", "[result-cache]")
+{
+  std::filesystem::path directory = std::filesystem::temp_directory_path() / "lydiasyft_test_result_cache_concurrent";
+  std::filesystem::remove_all(directory);
+  Syft::ResultCache cache(directory.string());
+  Syft::LTLfPlus spec;
+  spec.color_formula_ = "1";
+  Syft::InputOutputPartition partition = Syft::InputOutputPartition::construct_from_input({"a"}, {"b"});
+  std::string key = Syft::ResultCache::cache_key(spec, partition, Syft::Player::Agent, "");
+
+  auto var_mgr = std::make_shared<Syft::VarMgr>();
+  var_mgr->create_named_variables({"a", "b"});
+  var_mgr->partition_variables({"a"}, {"b"});
+  Syft::Transducer strategy = copy_controller(var_mgr);
+  // Only one writer reads the BDDs of the strategy, which CUDD does not share between threads
+  std::vector<std::thread> writers;
+  for (int writer = 0; writer < 4; ++writer) {
+    writers.emplace_back([&, writer]() {
+      for (int round = 0; round < 20; ++round) {
+        cache.store(key, writer == 0, writer == 0 ? &strategy : nullptr);
+      }
+    });
+  }
+  std::atomic<int> mixed{0};
+  for (int read = 0; read < 200; ++read) {
+    std::optional<Syft::CachedResult> entry = cache.load(key, &partition);
+    // Realizable entries come with their strategy, unrealizable ones without
+    if (entry && entry->realizability != entry->strategy.has_value()) {
+      ++mixed;
+    }
+  }
+  for (std::thread& writer : writers) {
+    writer.join();
+  }
+  REQUIRE(mixed == 0);
+  REQUIRE(cache.load(key, &partition).has_value());
+  std::filesystem::remove_all(directory);
+}
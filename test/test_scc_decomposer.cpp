@@ -1,6 +1,11 @@
 #include "catch2/catch_test_macros.hpp"
 #include "catch2/generators/catch_generators_all.hpp"
 #include "game/SCCDecomposer.h"
+#include "game/BuchiSolver.hpp"
+#include "game/EmersonLei.hpp"
+#include "debug.hpp"
+#include "game/Reachability.hpp"
+#include "game/WeakGameSolver.h"
 #include "automata/SymbolicStateDfa.h"
 #include "automata/ExplicitStateDfaAdd.h"
 #include "automata/ExplicitStateDfa.h"
@@ -11,6 +16,9 @@
 #include <memory>
 #include <functional>
 #include <random>
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
 
 extern "C" {
 #include <mona/bdd.h>
@@ -51,8 +59,9 @@ const std::vector<std::vector<int>>& get_test_transitions() {
     return transitions;
 }
 
-// Helper to create the standard test DFA
-Syft::SymbolicStateDfa create_test_dfa() {
+// Helper to create the standard test DFA, with the given accepting states
+// With agent_chooses, the guard variable is an output, so the agent picks the successor
+Syft::SymbolicStateDfa create_test_dfa(const std::set<int>& accepting = {}, bool agent_chooses = false) {
     const auto& transitions = get_test_transitions();
     const int num_states = transitions.size();
     const int num_vars = 1;
@@ -62,7 +71,7 @@ Syft::SymbolicStateDfa create_test_dfa() {
     
     std::string statuses_str;
     for (int state = 0; state < num_states; ++state) {
-        statuses_str += "-";
+        statuses_str += accepting.count(state) ? "+" : "-";
         int num_trans = transitions[state].size();
         dfaAllocExceptions(num_trans);
         int trans_idx = 0;
@@ -86,7 +95,11 @@ Syft::SymbolicStateDfa create_test_dfa() {
     
     std::shared_ptr<Syft::VarMgr> var_mgr = std::make_shared<Syft::VarMgr>();
     var_mgr->create_named_variables(dfa_var_names);
-    var_mgr->partition_variables(dfa_var_names, {});
+    if (agent_chooses) {
+        var_mgr->partition_variables({}, dfa_var_names);
+    } else {
+        var_mgr->partition_variables(dfa_var_names, {});
+    }
     Syft::ExplicitStateDfaAdd explicit_dfa_add = Syft::ExplicitStateDfaAdd::from_dfa_mona(var_mgr, explicit_dfa);
     
     return Syft::SymbolicStateDfa::from_explicit(std::move(explicit_dfa_add));
@@ -188,7 +201,11 @@ TEST_CASE("Transition Relation Random Graph Test", "[transitionrand]")
 
     std::shared_ptr<Syft::VarMgr> var_mgr = std::make_shared<Syft::VarMgr>();
     var_mgr->create_named_variables(dfa_var_names);
-    var_mgr->partition_variables(dfa_var_names, {});
+    if (agent_chooses) {
+        var_mgr->partition_variables({}, dfa_var_names);
+    } else {
+        var_mgr->partition_variables(dfa_var_names, {});
+    }
     Syft::ExplicitStateDfaAdd explicit_dfa_add = Syft::ExplicitStateDfaAdd::from_dfa_mona(var_mgr, explicit_dfa);
     Syft::SymbolicStateDfa symbolic_dfa = Syft::SymbolicStateDfa::from_explicit(std::move(explicit_dfa_add));
 
@@ -648,7 +665,11 @@ TEST_CASE("SCC Decomposition Random Graph Test", "[scc_random]")
     
     std::shared_ptr<Syft::VarMgr> var_mgr = std::make_shared<Syft::VarMgr>();
     var_mgr->create_named_variables(dfa_var_names);
-    var_mgr->partition_variables(dfa_var_names, {});
+    if (agent_chooses) {
+        var_mgr->partition_variables({}, dfa_var_names);
+    } else {
+        var_mgr->partition_variables(dfa_var_names, {});
+    }
     Syft::ExplicitStateDfaAdd explicit_dfa_add = Syft::ExplicitStateDfaAdd::from_dfa_mona(var_mgr, explicit_dfa);
     Syft::SymbolicStateDfa symbolic_dfa = Syft::SymbolicStateDfa::from_explicit(std::move(explicit_dfa_add));
     
@@ -840,7 +861,11 @@ TEST_CASE("SCC Decomposition with Unreachable States", "[scc][unreachable]")
     
     std::shared_ptr<Syft::VarMgr> var_mgr = std::make_shared<Syft::VarMgr>();
     var_mgr->create_named_variables(dfa_var_names);
-    var_mgr->partition_variables(dfa_var_names, {});
+    if (agent_chooses) {
+        var_mgr->partition_variables({}, dfa_var_names);
+    } else {
+        var_mgr->partition_variables(dfa_var_names, {});
+    }
     Syft::ExplicitStateDfaAdd explicit_dfa_add = Syft::ExplicitStateDfaAdd::from_dfa_mona(var_mgr, explicit_dfa);
     
     Syft::SymbolicStateDfa symbolic_dfa = Syft::SymbolicStateDfa::from_explicit(std::move(explicit_dfa_add));
@@ -944,3 +969,533 @@ TEST_CASE("SCC Decomposition with Unreachable States", "[scc][unreachable]")
     REQUIRE(found_layers[0] == std::set<int>{0});
     REQUIRE(found_layers[1] == std::set<int>{1, 2});
 }
+
+TEST_CASE("Frontier fixpoints match full fixpoints", "[fixpoint][frontier]")
+{
+    Syft::SymbolicStateDfa dfa = create_test_dfa();
+    auto var_mgr = dfa.var_mgr();
+    auto automaton_id = dfa.automaton_id();
+    auto state_vars = var_mgr->get_state_variables(automaton_id);
+
+    CUDD::BDD goal = state_to_bdd(5, state_vars, var_mgr, automaton_id);
+    CUDD::BDD accepting = goal | state_to_bdd(6, state_vars, var_mgr, automaton_id) |
+                          state_to_bdd(7, state_vars, var_mgr, automaton_id);
+
+    Syft::Reachability full(dfa, Syft::Player::Agent, Syft::Player::Agent, goal, var_mgr->cudd_mgr()->bddOne());
+    Syft::Reachability frontier(dfa, Syft::Player::Agent, Syft::Player::Agent, goal, var_mgr->cudd_mgr()->bddOne());
+    frontier.set_fixpoint_mode(Syft::FixpointMode::Frontier);
+    Syft::SynthesisResult full_result = full.run();
+    Syft::SynthesisResult frontier_result = frontier.run();
+    REQUIRE(full_result.realizability == frontier_result.realizability);
+    REQUIRE(full_result.winning_states == frontier_result.winning_states);
+    REQUIRE(full.fixpoint_trace().iterations() == frontier.fixpoint_trace().iterations());
+    for (std::size_t i = 0; i < frontier.fixpoint_trace().iterations(); ++i) {
+        REQUIRE(frontier.fixpoint_trace().candidate_states[i] <= full.fixpoint_trace().candidate_states[i]);
+    }
+
+    Syft::WeakGameSolver full_solver(dfa, accepting);
+    Syft::WeakGameSolver frontier_solver(dfa, accepting);
+    frontier_solver.SetFixpointMode(Syft::FixpointMode::Frontier);
+    REQUIRE(full_solver.Solve().winning_states == frontier_solver.Solve().winning_states);
+    REQUIRE(frontier_solver.GetFixpointTrace().iterations() > 0);
+}
+
+TEST_CASE("Warm-started Buchi fixpoints match cold ones", "[fixpoint][buchi]")
+{
+    // 8 -> 9 -> 8 never visits the accepting state; the 5, 6, 7 cycle does
+    Syft::SymbolicStateDfa dfa = create_test_dfa({6});
+    auto one = dfa.var_mgr()->cudd_mgr()->bddOne();
+
+    for (auto mode : {Syft::BuchiSolver::BuchiMode::CLASSIC, Syft::BuchiSolver::BuchiMode::PITERMAN}) {
+        Syft::BuchiSolver cold(dfa, Syft::Player::Agent, Syft::Player::Agent, one, mode);
+        Syft::BuchiSolver warm(dfa, Syft::Player::Agent, Syft::Player::Agent, one, mode);
+        warm.set_warm_start(true);
+        Syft::SynthesisResult cold_result = cold.run();
+        Syft::SynthesisResult warm_result = warm.run();
+        REQUIRE(cold_result.realizability == warm_result.realizability);
+        if (mode == Syft::BuchiSolver::BuchiMode::PITERMAN) {
+            REQUIRE(cold_result.winning_states == warm_result.winning_states);
+        }
+        REQUIRE(cold.inner_traces().size() == warm.inner_traces().size());
+    }
+}
+
+TEST_CASE("Realizability-only solvers agree on the verdict", "[fixpoint][realizability]")
+{
+    Syft::SymbolicStateDfa dfa = create_test_dfa({6});
+    auto var_mgr = dfa.var_mgr();
+    auto state_vars = var_mgr->get_state_variables(dfa.automaton_id());
+    auto one = var_mgr->cudd_mgr()->bddOne();
+    CUDD::BDD initial = dfa.initial_state_bdd();
+
+    for (int goal_state : {5, 9}) {
+        CUDD::BDD goal = state_to_bdd(goal_state, state_vars, var_mgr, dfa.automaton_id());
+        Syft::Reachability full(dfa, Syft::Player::Agent, Syft::Player::Agent, goal, one);
+        Syft::Reachability verdict_only(dfa, Syft::Player::Agent, Syft::Player::Agent, goal, one);
+        verdict_only.set_realizability_only(true);
+        Syft::SynthesisResult verdict_result = verdict_only.run();
+        REQUIRE(full.run().realizability == verdict_result.realizability);
+        REQUIRE(verdict_result.transducer == nullptr);
+
+        Syft::WeakGameSolver full_solver(dfa, goal);
+        Syft::WeakGameSolver verdict_solver(dfa, goal);
+        verdict_solver.SetRealizabilityOnly(true);
+        REQUIRE((initial & !full_solver.Solve().winning_states).IsZero() ==
+                (initial & !verdict_solver.Solve().winning_states).IsZero());
+    }
+
+    for (auto mode : {Syft::BuchiSolver::BuchiMode::CLASSIC, Syft::BuchiSolver::BuchiMode::PITERMAN,
+                      Syft::BuchiSolver::BuchiMode::COBUCHI}) {
+        Syft::BuchiSolver full(dfa, Syft::Player::Agent, Syft::Player::Agent, one, mode);
+        Syft::BuchiSolver verdict_only(dfa, Syft::Player::Agent, Syft::Player::Agent, one, mode);
+        verdict_only.set_realizability_only(true);
+        REQUIRE(full.run().realizability == verdict_only.run().realizability);
+    }
+}
+
+// Helper to create a DFA over 3 variables with random transitions
+Syft::SymbolicStateDfa create_random_dfa(int num_states, unsigned seed) {
+    std::mt19937 rng(seed);
+    const int num_vars = 3;
+    int indices[3] = {0, 1, 2};
+    dfaSetup(num_states, num_vars, indices);
+
+    std::string statuses_str;
+    for (int state = 0; state < num_states; ++state) {
+        statuses_str += "-";
+        // Mostly local edges, so that the graph has many small SCCs
+        std::set<int> targets;
+        int num_trans = 1 + static_cast<int>(rng() % 3);
+        while ((int)targets.size() < num_trans) {
+            int offset = static_cast<int>(rng() % 5) - 1;
+            targets.insert(std::min(num_states - 1, std::max(0, state + offset)));
+            if (state == num_states - 1) break;
+        }
+        dfaAllocExceptions(targets.size());
+        int trans_idx = 0;
+        for (int target : targets) {
+            std::string guard_str;
+            guard_str += ((trans_idx & 4) ? '1' : '0');
+            guard_str += ((trans_idx & 2) ? '1' : '0');
+            guard_str += ((trans_idx & 1) ? '1' : '0');
+            std::vector<char> guard(guard_str.begin(), guard_str.end());
+            guard.push_back('\0');
+            dfaStoreException(target, guard.data());
+            trans_idx++;
+        }
+        dfaStoreState(*targets.begin());
+    }
+
+    std::vector<char> statuses(statuses_str.begin(), statuses_str.end());
+    statuses.push_back('\0');
+    DFA* mona_dfa = dfaBuild(statuses.data());
+
+    std::vector<std::string> dfa_var_names = {"v0", "v1", "v2"};
+    Syft::ExplicitStateDfa explicit_dfa(mona_dfa, dfa_var_names);
+
+    std::shared_ptr<Syft::VarMgr> var_mgr = std::make_shared<Syft::VarMgr>();
+    var_mgr->create_named_variables(dfa_var_names);
+    if (agent_chooses) {
+        var_mgr->partition_variables({}, dfa_var_names);
+    } else {
+        var_mgr->partition_variables(dfa_var_names, {});
+    }
+    Syft::ExplicitStateDfaAdd explicit_dfa_add = Syft::ExplicitStateDfaAdd::from_dfa_mona(var_mgr, explicit_dfa);
+    return Syft::SymbolicStateDfa::from_explicit(std::move(explicit_dfa_add));
+}
+
+// Helper to peel all layers of the given states, as sets of state numbers
+std::vector<std::set<int>> peel_all_layers(const Syft::SCCDecomposer& decomposer,
+                                           const Syft::SymbolicStateDfa& dfa, int num_states) {
+    auto var_mgr = dfa.var_mgr();
+    auto automaton_id = dfa.automaton_id();
+    auto state_vars = var_mgr->get_state_variables(automaton_id);
+
+    CUDD::BDD remaining = var_mgr->cudd_mgr()->bddZero();
+    for (int state = 0; state < num_states; ++state) {
+        remaining |= state_to_bdd(state, state_vars, var_mgr, automaton_id);
+    }
+
+    std::vector<std::set<int>> layers;
+    while (!remaining.IsZero()) {
+        CUDD::BDD layer = decomposer.PeelLayer(remaining);
+        if (layer.IsZero()) {
+            break;
+        }
+        std::set<int> layer_states;
+        for (int state = 0; state < num_states; ++state) {
+            if (!(layer & state_to_bdd(state, state_vars, var_mgr, automaton_id)).IsZero()) {
+                layer_states.insert(state);
+            }
+        }
+        layers.push_back(layer_states);
+        remaining &= !layer;
+    }
+    return layers;
+}
+
+TEST_CASE("Naive decomposition without a cached closure", "[scc][closure]")
+{
+    Syft::SymbolicStateDfa dfa = create_test_dfa();
+    Syft::NaiveSCCDecomposer cached(dfa);
+    Syft::NaiveSCCDecomposer uncached(dfa);
+    // Every closure exceeds one node, so each layer recomputes its own
+    uncached.SetClosureNodeLimit(1);
+    REQUIRE(peel_all_layers(uncached, dfa, 10) == peel_all_layers(cached, dfa, 10));
+}
+
+TEST_CASE("Skeleton SCC decomposition matches the naive one", "[scc][skeleton]")
+{
+    SECTION("Standard test graph") {
+        Syft::SymbolicStateDfa dfa = create_test_dfa();
+        Syft::SkeletonSCCDecomposer skeleton(dfa);
+        Syft::NaiveSCCDecomposer naive(dfa);
+        REQUIRE(peel_all_layers(skeleton, dfa, 10) == peel_all_layers(naive, dfa, 10));
+
+        auto var_mgr = dfa.var_mgr();
+        auto state_vars = var_mgr->get_state_variables(dfa.automaton_id());
+        CUDD::BDD all_states = var_mgr->cudd_mgr()->bddZero();
+        for (int state = 0; state < 10; ++state) {
+            all_states |= state_to_bdd(state, state_vars, var_mgr, dfa.automaton_id());
+        }
+        // {0, 1}, {2}, {3}, {4}, {5, 6, 7}, {8, 9}
+        REQUIRE(skeleton.Components(all_states).size() == 6);
+        // Peeling all layers in one call matches peeling them one by one
+        REQUIRE(skeleton.PeelLayers(all_states) == naive.PeelLayers(all_states));
+    }
+
+    SECTION("Random graphs with many small SCCs, against the other decomposers") {
+        const int num_states = 120;
+        for (unsigned seed : {1u, 2u, 3u}) {
+            Syft::SymbolicStateDfa dfa = create_random_dfa(num_states, seed);
+            Syft::NaiveSCCDecomposer naive(dfa);
+            std::vector<std::set<int>> expected = peel_all_layers(naive, dfa, num_states);
+            for (auto algorithm : {Syft::SCCAlgorithm::Chain, Syft::SCCAlgorithm::Skeleton}) {
+                INFO("SCC algorithm " << static_cast<int>(algorithm) << ", seed " << seed);
+                auto decomposer = Syft::SCCDecomposer::Create(algorithm, dfa);
+                REQUIRE(peel_all_layers(*decomposer, dfa, num_states) == expected);
+            }
+        }
+    }
+
+    REQUIRE(Syft::SCCDecomposer::AlgorithmFromString("skeleton") == Syft::SCCAlgorithm::Skeleton);
+    REQUIRE_THROWS_AS(Syft::SCCDecomposer::AlgorithmFromString("tarjan"), std::runtime_error);
+}
+
+TEST_CASE("Parallel layer solving matches sequential solving", "[weak][parallel]")
+{
+    const int num_states = 120;
+    Syft::SymbolicStateDfa dfa = create_random_dfa(num_states, 4);
+    auto var_mgr = dfa.var_mgr();
+    auto state_vars = var_mgr->get_state_variables(dfa.automaton_id());
+
+    CUDD::BDD accepting = var_mgr->cudd_mgr()->bddZero();
+    for (int state = 0; state < num_states; state += 3) {
+        accepting |= state_to_bdd(state, state_vars, var_mgr, dfa.automaton_id());
+    }
+
+    Syft::WeakGameSolver sequential(dfa, accepting);
+    Syft::WeakGameSolver parallel(dfa, accepting);
+    // Split every layer, however small
+    parallel.SetThreads(4, 0);
+    REQUIRE(sequential.Solve().winning_states == parallel.Solve().winning_states);
+}
+
+TEST_CASE("Demand-driven weak-game solving agrees on the reachable states", "[weak][demand]")
+{
+    // From 0, the 8 <-> 9 cycle and the 5, 6, 7 cycle are both reachable
+    Syft::SymbolicStateDfa dfa = create_test_dfa();
+    auto var_mgr = dfa.var_mgr();
+    auto state_vars = var_mgr->get_state_variables(dfa.automaton_id());
+    CUDD::BDD accepting = state_to_bdd(6, state_vars, var_mgr, dfa.automaton_id()) |
+                          state_to_bdd(9, state_vars, var_mgr, dfa.automaton_id());
+
+    Syft::WeakGameSolver full(dfa, accepting);
+    Syft::WeakGameSolver demand_driven(dfa, accepting);
+    demand_driven.SetDemandDriven(true);
+    CUDD::BDD full_winning = full.Solve().winning_states;
+    CUDD::BDD demand_winning = demand_driven.Solve().winning_states;
+
+    CUDD::BDD reachable = var_mgr->cudd_mgr()->bddZero();
+    for (int state = 0; state < 10; ++state) {
+        reachable |= state_to_bdd(state, state_vars, var_mgr, dfa.automaton_id());
+    }
+    REQUIRE((full_winning & reachable) == demand_winning);
+}
+
+TEST_CASE("Layered Buchi solving matches the Piterman fixpoint", "[fixpoint][buchi][layered]")
+{
+    // {6} makes the 5, 6, 7 cycle a mixed SCC; {5, 6, 7, 9} keeps every SCC pure
+    for (const std::set<int>& accepting : {std::set<int>{6}, std::set<int>{5, 6, 7, 9}}) {
+        Syft::SymbolicStateDfa dfa = create_test_dfa(accepting);
+        auto one = dfa.var_mgr()->cudd_mgr()->bddOne();
+
+        Syft::BuchiSolver piterman(dfa, Syft::Player::Agent, Syft::Player::Agent, one,
+                                   Syft::BuchiSolver::BuchiMode::PITERMAN);
+        Syft::SynthesisResult expected = piterman.run();
+
+        for (auto algorithm : {Syft::SCCAlgorithm::Naive, Syft::SCCAlgorithm::Chain, Syft::SCCAlgorithm::Skeleton}) {
+            Syft::BuchiSolver layered(dfa, Syft::Player::Agent, Syft::Player::Agent, one,
+                                      Syft::BuchiSolver::BuchiMode::LAYERED);
+            layered.set_scc_algorithm(algorithm);
+            Syft::SynthesisResult result = layered.run();
+            REQUIRE(result.realizability == expected.realizability);
+            REQUIRE(result.winning_states == expected.winning_states);
+            REQUIRE(!layered.inner_traces().empty());
+        }
+    }
+}
+
+TEST_CASE("Parallel Emerson-Lei solving matches sequential solving", "[el][parallel]")
+{
+    // Inf 0 & Inf 1 gives the root two children, one per missing color
+    Syft::SymbolicStateDfa dfa = create_test_dfa();
+    auto var_mgr = dfa.var_mgr();
+    auto state_vars = var_mgr->get_state_variables(dfa.automaton_id());
+    CUDD::BDD color0 = state_to_bdd(6, state_vars, var_mgr, dfa.automaton_id());
+    CUDD::BDD color1 = state_to_bdd(5, state_vars, var_mgr, dfa.automaton_id()) |
+                       state_to_bdd(9, state_vars, var_mgr, dfa.automaton_id());
+    std::vector<CUDD::BDD> colors{color0, color1};
+    auto one = var_mgr->cudd_mgr()->bddOne();
+    auto zero = var_mgr->cudd_mgr()->bddZero();
+
+    Syft::EmersonLei sequential(dfa, "Inf 0 & Inf 1", Syft::Player::Agent, Syft::Player::Agent, colors, one, zero,
+                                zero, false);
+    Syft::EmersonLei parallel(dfa, "Inf 0 & Inf 1", Syft::Player::Agent, Syft::Player::Agent, colors, one, zero,
+                              zero, false);
+    sequential.set_realizability_only(true);
+    parallel.set_realizability_only(true);
+    // Split every node with two children, however small
+    parallel.set_threads(2, 2, 0);
+
+    Syft::ELSynthesisResult sequential_result = sequential.run_EL();
+    Syft::ELSynthesisResult parallel_result = parallel.run_EL();
+    REQUIRE(sequential_result.realizability == parallel_result.realizability);
+    REQUIRE(sequential_result.winning_states == parallel_result.winning_states);
+}
+
+TEST_CASE("Symbolic Emerson-Lei strategies visit every color", "[el][strategy]")
+{
+    // The agent must keep cycling through 5 -> 6 -> 7 rather than 8 <-> 9
+    Syft::SymbolicStateDfa dfa = create_test_dfa({}, true);
+    auto var_mgr = dfa.var_mgr();
+    auto state_vars = var_mgr->get_state_variables(dfa.automaton_id());
+    CUDD::BDD color0 = state_to_bdd(6, state_vars, var_mgr, dfa.automaton_id());
+    CUDD::BDD color1 = state_to_bdd(5, state_vars, var_mgr, dfa.automaton_id());
+    std::vector<CUDD::BDD> colors{color0, color1};
+    auto one = var_mgr->cudd_mgr()->bddOne();
+    auto zero = var_mgr->cudd_mgr()->bddZero();
+
+    bool strategy = STRATEGY;
+    STRATEGY = true;
+    Syft::EmersonLei solver(dfa, "Inf 0 & Inf 1", Syft::Player::Agent, Syft::Player::Agent, colors, one, zero,
+                            zero, false);
+    solver.set_symbolic_strategy(true);
+    Syft::ELSynthesisResult result = solver.run_EL();
+    STRATEGY = strategy;
+    REQUIRE(result.realizability);
+    REQUIRE(result.transducer);
+
+    // Run the transducer: the memory variables are the last ones created
+    std::vector<CUDD::BDD> transition_function = result.transducer->get_transition_function();
+    std::size_t total = var_mgr->total_variable_count();
+    std::size_t memory_bits = transition_function.size() - state_vars.size();
+    std::vector<int> indices;
+    for (const CUDD::BDD& var : state_vars) {
+        indices.push_back(var.NodeReadIndex());
+    }
+    for (std::size_t b = 0; b < memory_bits; ++b) {
+        indices.push_back(static_cast<int>(total - memory_bits + b));
+    }
+    std::vector<int> values = var_mgr->make_eval_vector(dfa.automaton_id(), dfa.initial_state());
+    values.resize(total, 0);
+    int visits0 = 0;
+    int visits1 = 0;
+    for (int step = 0; step < 40; ++step) {
+        for (const auto& [index, function] : result.transducer->get_output_function()) {
+            values[index] = function.Eval(values.data()).IsOne();
+        }
+        std::vector<int> next(values);
+        for (std::size_t i = 0; i < transition_function.size(); ++i) {
+            next[indices[i]] = transition_function[i].Eval(values.data()).IsOne();
+        }
+        values = next;
+        if (step >= 20) {
+            visits0 += color0.Eval(values.data()).IsOne();
+            visits1 += color1.Eval(values.data()).IsOne();
+        }
+    }
+    REQUIRE(visits0 > 0);
+    REQUIRE(visits1 > 0);
+}
+
+TEST_CASE("Two-level dispatch matches Emerson-Lei solving", "[el][acceptance]")
+{
+    Syft::SymbolicStateDfa dfa = create_test_dfa({}, true);
+    auto var_mgr = dfa.var_mgr();
+    auto state_vars = var_mgr->get_state_variables(dfa.automaton_id());
+    CUDD::BDD color0 = state_to_bdd(6, state_vars, var_mgr, dfa.automaton_id());
+    CUDD::BDD color1 = state_to_bdd(8, state_vars, var_mgr, dfa.automaton_id()) |
+                       state_to_bdd(5, state_vars, var_mgr, dfa.automaton_id());
+    std::vector<CUDD::BDD> colors{color0, color1};
+    auto one = var_mgr->cudd_mgr()->bddOne();
+    auto zero = var_mgr->cudd_mgr()->bddZero();
+
+    for (const std::string formula : {"Inf 0 & Inf 1", "Inf 1", "Fin 0 | Fin 1", "Fin 1", "t"}) {
+        Syft::EmersonLei dispatched(dfa, formula, Syft::Player::Agent, Syft::Player::Agent, colors, one, zero, zero,
+                                    false);
+        Syft::EmersonLei general(dfa, formula, Syft::Player::Agent, Syft::Player::Agent, colors, one, zero, zero,
+                                 false);
+        dispatched.set_auto_dispatch(true);
+        REQUIRE(Syft::is_two_level(dispatched.acceptance_class()));
+
+        Syft::ELSynthesisResult dispatched_result = dispatched.run_EL();
+        Syft::ELSynthesisResult general_result = general.run_EL();
+        REQUIRE(dispatched_result.realizability == general_result.realizability);
+        REQUIRE(dispatched_result.winning_states == general_result.winning_states);
+    }
+}
+
+TEST_CASE("Parity solving matches Emerson-Lei solving on chain conditions", "[el][parity]")
+{
+    Syft::SymbolicStateDfa dfa = create_test_dfa({}, true);
+    auto var_mgr = dfa.var_mgr();
+    auto state_vars = var_mgr->get_state_variables(dfa.automaton_id());
+    auto state = [&](int index) { return state_to_bdd(index, state_vars, var_mgr, dfa.automaton_id()); };
+    CUDD::BDD color0 = state(6) | state(9);
+    CUDD::BDD color1 = state(5) | state(8);
+    CUDD::BDD color2 = state(7);
+    std::vector<CUDD::BDD> colors{color0, color1, color2};
+    auto one = var_mgr->cudd_mgr()->bddOne();
+    auto zero = var_mgr->cudd_mgr()->bddZero();
+
+    for (const std::string formula : {"Inf 0 | Fin 1", "Fin 0 & Inf 1", "Inf 2 | (Fin 1 & Inf 0)", "Inf 1"}) {
+        Syft::EmersonLei parity(dfa, formula, Syft::Player::Agent, Syft::Player::Agent, colors, one, zero, zero,
+                                false);
+        Syft::EmersonLei general(dfa, formula, Syft::Player::Agent, Syft::Player::Agent, colors, one, zero, zero,
+                                 false);
+        parity.set_force_parity(true);
+        general.set_auto_dispatch(false);
+
+        Syft::ELSynthesisResult parity_result = parity.run_EL();
+        Syft::ELSynthesisResult general_result = general.run_EL();
+        REQUIRE(parity_result.realizability == general_result.realizability);
+        REQUIRE(parity_result.winning_states == general_result.winning_states);
+    }
+
+    Syft::EmersonLei streett(dfa, "(Fin 0 | Inf 1) & (Fin 2 | Inf 0)", Syft::Player::Agent, Syft::Player::Agent,
+                             colors, one, zero, zero, false);
+    streett.set_force_parity(true);
+    REQUIRE_THROWS_AS(streett.run_EL(), std::runtime_error);
+}
+
+TEST_CASE("Anytime Emerson-Lei solving publishes sound bounds", "[el][anytime]")
+{
+    Syft::SymbolicStateDfa dfa = create_test_dfa({}, true);
+    auto var_mgr = dfa.var_mgr();
+    auto state_vars = var_mgr->get_state_variables(dfa.automaton_id());
+    auto state = [&](int index) { return state_to_bdd(index, state_vars, var_mgr, dfa.automaton_id()); };
+    CUDD::BDD color0 = state(6) | state(9);
+    CUDD::BDD color1 = state(5) | state(8);
+    std::vector<CUDD::BDD> colors{color0, color1};
+    auto one = var_mgr->cudd_mgr()->bddOne();
+    auto zero = var_mgr->cudd_mgr()->bddZero();
+
+    for (const std::string formula : {"Fin 0 & Inf 1", "Inf 0 | Fin 1", "Inf 0 & Inf 1", "Fin 0 | Fin 1"}) {
+        INFO("formula: " << formula);
+        Syft::EmersonLei exact(dfa, formula, Syft::Player::Agent, Syft::Player::Agent, colors, one, zero, zero, false);
+        exact.set_auto_dispatch(false);
+        Syft::ELSynthesisResult exact_result = exact.run_EL();
+
+        Syft::EmersonLei anytime(dfa, formula, Syft::Player::Agent, Syft::Player::Agent, colors, one, zero, zero,
+                                 false);
+        // Two-level conditions are published by SolveTwoLevel, the others by EmersonLeiSolve
+        anytime.set_auto_dispatch(Syft::is_two_level(anytime.acceptance_class()));
+        std::vector<Syft::PartialSynthesisResult> partials;
+        anytime.set_anytime([&](const Syft::PartialSynthesisResult &partial) { partials.push_back(partial); });
+        Syft::ELSynthesisResult anytime_result = anytime.run_EL();
+
+        REQUIRE(anytime_result.realizability == exact_result.realizability);
+        for (const Syft::PartialSynthesisResult &partial : partials) {
+            REQUIRE((partial.winning & !exact_result.winning_states).IsZero());
+            REQUIRE((partial.losing & exact_result.winning_states).IsZero());
+        }
+    }
+}
+
+TEST_CASE("Child orders and warm starts keep the Emerson-Lei solution", "[el][child-order]")
+{
+    Syft::SymbolicStateDfa dfa = create_test_dfa({}, true);
+    auto var_mgr = dfa.var_mgr();
+    auto state_vars = var_mgr->get_state_variables(dfa.automaton_id());
+    auto state = [&](int index) { return state_to_bdd(index, state_vars, var_mgr, dfa.automaton_id()); };
+    std::vector<CUDD::BDD> colors{state(6) | state(9), state(5) | state(8), state(7)};
+    auto one = var_mgr->cudd_mgr()->bddOne();
+    auto zero = var_mgr->cudd_mgr()->bddZero();
+
+    for (const std::string formula : {"(Fin 0 | Inf 1) & (Fin 2 | Inf 0)", "Inf 2 | (Fin 1 & Inf 0)",
+                                      "(Inf 0 & Inf 1) | Fin 2", "(Inf 0 | Fin 1) & (Inf 2 | Fin 0)"}) {
+        INFO("formula: " << formula);
+        Syft::EmersonLei baseline(dfa, formula, Syft::Player::Agent, Syft::Player::Agent, colors, one, zero, zero,
+                                  false);
+        baseline.set_auto_dispatch(false);
+        baseline.set_realizability_only(true);
+        Syft::ELSynthesisResult baseline_result = baseline.run_EL();
+        REQUIRE(baseline.cpre_calls() > 0);
+
+        for (Syft::ChildOrder order : {Syft::ChildOrder::Construction, Syft::ChildOrder::SmallestTarget,
+                                       Syft::ChildOrder::ChangedFirst}) {
+            for (bool warm_start : {false, true}) {
+                Syft::EmersonLei solver(dfa, formula, Syft::Player::Agent, Syft::Player::Agent, colors, one, zero,
+                                        zero, false);
+                solver.set_auto_dispatch(false);
+                solver.set_realizability_only(true);
+                solver.set_child_order(order);
+                solver.set_warm_start(warm_start);
+                Syft::ELSynthesisResult result = solver.run_EL();
+                REQUIRE(result.realizability == baseline_result.realizability);
+                REQUIRE(result.winning_states == baseline_result.winning_states);
+                REQUIRE(solver.cpre_calls() > 0);
+            }
+        }
+    }
+    REQUIRE(Syft::child_order_from_string("changed-first") == Syft::ChildOrder::ChangedFirst);
+    REQUIRE_THROWS_AS(Syft::child_order_from_string("random"), std::runtime_error);
+}
+
+TEST_CASE("Chain pivot strategies match the naive decomposition", "[scc][chain]")
+{
+    const int num_states = 120;
+    for (unsigned seed : {1u, 2u, 3u}) {
+        Syft::SymbolicStateDfa dfa = create_random_dfa(num_states, seed);
+        Syft::NaiveSCCDecomposer naive(dfa);
+        std::vector<std::set<int>> expected = peel_all_layers(naive, dfa, num_states);
+
+        for (Syft::ChainPivot pivot : {Syft::ChainPivot::Arbitrary, Syft::ChainPivot::LastLayer,
+                                       Syft::ChainPivot::MinInDegree}) {
+            for (std::size_t pivots_per_round : {1u, 3u}) {
+                Syft::ChainSCCDecomposer chain(dfa, Syft::ChainOptions{pivot, pivots_per_round});
+                REQUIRE(peel_all_layers(chain, dfa, num_states) == expected);
+                REQUIRE(chain.SymbolicSteps() > 0);
+                std::cout << "Chain pivot " << static_cast<int>(pivot) << ", " << pivots_per_round
+                          << " per round, seed " << seed << ": " << chain.SymbolicSteps() << " symbolic steps"
+                          << std::endl;
+            }
+        }
+    }
+
+    // {0, 1}, {2}, {3}, {4}, {5, 6, 7}, {8, 9}
+    Syft::SymbolicStateDfa dfa = create_test_dfa();
+    auto var_mgr = dfa.var_mgr();
+    auto state_vars = var_mgr->get_state_variables(dfa.automaton_id());
+    CUDD::BDD all_states = var_mgr->cudd_mgr()->bddZero();
+    for (int state = 0; state < 10; ++state) {
+        all_states |= state_to_bdd(state, state_vars, var_mgr, dfa.automaton_id());
+    }
+    Syft::ChainSCCDecomposer chain(dfa);
+    REQUIRE(chain.Components(all_states).size() == 6);
+    REQUIRE(chain.PeelLayers(all_states) == Syft::NaiveSCCDecomposer(dfa).PeelLayers(all_states));
+
+    REQUIRE(Syft::ChainSCCDecomposer::PivotFromString("min-in-degree") == Syft::ChainPivot::MinInDegree);
+    REQUIRE_THROWS_AS(Syft::ChainSCCDecomposer::PivotFromString("random"), std::runtime_error);
+}
@@ -0,0 +1,65 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <filesystem>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "utils.hpp"
+#include "synthesizer/LTLfPlusSynthesizer.h"
+#include "synthesizer/LTLfPlusSynthesizerMP.h"
+
+namespace {
+  // The verdicts of the EL solver and of both MP solvers on \a formula, checkpointed in \a directory if not empty
+  std::vector<bool> verdicts(const std::string& formula, const Syft::InputOutputPartition& partition,
+                             Syft::DfaConstructionOptions dfa_options, const std::filesystem::path& directory) {
+    std::vector<bool> result;
+    auto checkpoint = [&](const std::string& solver) {
+      dfa_options.checkpoint_directory = directory.empty() ? "" : (directory / solver).string();
+    };
+    checkpoint("el");
+    Syft::LTLfPlusSynthesizer synthesizer(Syft::Test::get_ltlfplus_from_input(formula), partition,
+                                          Syft::Player::Agent, Syft::Player::Agent, Syft::VarMgrOptions(), dfa_options);
+    result.push_back(synthesizer.run().realizability);
+    for (int game_solver : {1, 2}) {
+      checkpoint("mp" + std::to_string(game_solver));
+      Syft::LTLfPlusSynthesizerMP mp_synthesizer(Syft::Test::get_ltlfplus_from_input(formula), partition,
+                                                 Syft::Player::Agent, Syft::Player::Agent, game_solver,
+                                                 Syft::VarMgrOptions(), dfa_options);
+      result.push_back(mp_synthesizer.run().realizability);
+    }
+    return result;
+  }
+}
+
+TEST_CASE("Solves resumed from a checkpoint keep their verdicts", "[checkpoint]")
+{
+  std::filesystem::path directory = std::filesystem::temp_directory_path() / "lydiasyft_test_checkpoint";
+  std::vector<std::tuple<std::string, vars, vars>> specs = {
+      {"(AE(e1) -> AE(s1)) & (AE(e2) -> AE(s2)) & E(F(X(false) & s3))", vars{"e1", "e2", "e3"}, vars{"s1", "s2", "s3"}},
+      {"E(F(e)) | A(G(!e))", vars{"e"}, vars{"a"}},
+      {"EA(e) -> AE(a)", vars{"e"}, vars{"a"}}};
+  for (const auto& [formula, inputs, outputs] : specs) {
+    INFO("formula: " << formula);
+    std::filesystem::remove_all(directory);
+    Syft::InputOutputPartition partition = Syft::InputOutputPartition::construct_from_input(inputs, outputs);
+    Syft::DfaConstructionOptions dfa_options;
+    dfa_options.decompose_components = false;
+    dfa_options.checkpoint_interval = 0;
+    std::vector<bool> expected = verdicts(formula, partition, Syft::DfaConstructionOptions(), "");
+    REQUIRE(verdicts(formula, partition, dfa_options, directory) == expected);
+    REQUIRE(std::filesystem::exists(directory / "mp1" / "node-0.result"));
+
+    // Resuming reloads the saved nodes and root bounds
+    dfa_options.resume = true;
+    REQUIRE(verdicts(formula, partition, dfa_options, directory) == expected);
+    REQUIRE(verdicts(formula, partition, dfa_options, directory) == expected);
+  }
+  // A checkpoint of another spec is cleared rather than resumed
+  std::string other = "E(F(e & a)) | A(G(!e | !a))";
+  Syft::InputOutputPartition partition = Syft::InputOutputPartition::construct_from_input({"e"}, {"a"});
+  Syft::DfaConstructionOptions dfa_options;
+  dfa_options.resume = true;
+  REQUIRE(verdicts(other, partition, dfa_options, directory) ==
+          verdicts(other, partition, Syft::DfaConstructionOptions(), ""));
+  std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,126 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "VarMgr.h"
+#include "automata/SymbolicStateDfa.h"
+#include "game/Reachability.hpp"
+#include "game/SolvedGameSnapshot.h"
+
+namespace {
+  // The answers of every query, one per valuation of the slots
+  struct Answers {
+    std::vector<bool> winning;
+    std::vector<bool> winning_move;
+    std::vector<std::vector<std::uint8_t>> move;
+  };
+
+  std::vector<std::uint8_t> slot_values(std::size_t slots, std::size_t row) {
+    std::vector<std::uint8_t> values(slots);
+    for (std::size_t slot = 0; slot < slots; ++slot) {
+      values[slot] = (row >> slot) & 1;
+    }
+    return values;
+  }
+
+  Answers query_all(const Syft::SolvedGameSnapshot& snapshot) {
+    Answers answers;
+    for (std::size_t row = 0; row < (std::size_t(1) << snapshot.slot_count()); ++row) {
+      std::vector<std::uint8_t> values = slot_values(snapshot.slot_count(), row);
+      answers.winning.push_back(snapshot.is_winning(values.data()));
+      answers.winning_move.push_back(snapshot.is_winning_move(values.data()));
+      snapshot.strategy_move(values.data());
+      answers.move.push_back(values);
+    }
+    return answers;
+  }
+}
+
+TEST_CASE("Solved game snapshots answer like the BDDs of the result", "[snapshot]")
+{
+    std::optional<Syft::SolvedGameSnapshot> snapshot;
+    Answers expected;
+    {
+        auto var_mgr = std::make_shared<Syft::VarMgr>();
+        var_mgr->create_named_variables({"a", "b"});
+        var_mgr->partition_variables({"a"}, {"b"});
+        CUDD::BDD a = var_mgr->name_to_variable("a");
+        CUDD::BDD b = var_mgr->name_to_variable("b");
+        // The state bits remember a and b; the agent wins by setting b once
+        Syft::SymbolicStateDfa arena = Syft::SymbolicStateDfa::from_predicates(var_mgr, {a, b});
+        CUDD::BDD goal = var_mgr->state_variable(arena.automaton_id(), 1);
+        Syft::Reachability game(arena, Syft::Player::Environment, Syft::Player::Agent, goal,
+                                var_mgr->cudd_mgr()->bddOne());
+        Syft::SynthesisResult result = game.run();
+        REQUIRE(result.realizability);
+
+        snapshot.emplace(arena, result);
+        REQUIRE(snapshot->state_bit_count() == 2);
+        REQUIRE(snapshot->input_labels() == std::vector<std::string>{"a"});
+        REQUIRE(snapshot->has_strategy());
+
+        const std::vector<int>& indices = snapshot->variable_indices();
+        CUDD::BDD strategy_b = result.transducer->get_output_function().at(b.NodeReadIndex());
+        for (std::size_t row = 0; row < (std::size_t(1) << snapshot->slot_count()); ++row) {
+            std::vector<std::uint8_t> values = slot_values(snapshot->slot_count(), row);
+            std::vector<int> valuation(var_mgr->total_variable_count(), 0);
+            for (std::size_t slot = 0; slot < values.size(); ++slot) {
+                valuation[indices[slot]] = values[slot];
+            }
+            expected.winning.push_back(result.winning_states.Eval(valuation.data()).IsOne());
+            expected.winning_move.push_back(result.winning_moves.Eval(valuation.data()).IsOne());
+            values[snapshot->first_output_slot()] = strategy_b.Eval(valuation.data()).IsOne();
+            expected.move.push_back(values);
+        }
+    }
+
+    // The variable manager is gone, and the threads share the snapshot
+    Answers answers = query_all(*snapshot);
+    REQUIRE(answers.winning == expected.winning);
+    REQUIRE(answers.winning_move == expected.winning_move);
+    REQUIRE(answers.move == expected.move);
+
+    std::atomic<int> mismatches{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&]() {
+            for (int repeat = 0; repeat < 100; ++repeat) {
+                Answers mine = query_all(*snapshot);
+                if (mine.winning != expected.winning || mine.winning_move != expected.winning_move ||
+                    mine.move != expected.move) {
+                    ++mismatches;
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    REQUIRE(mismatches == 0);
+}
+
+TEST_CASE("Solved game snapshots refuse missing parts", "[snapshot]")
+{
+    auto var_mgr = std::make_shared<Syft::VarMgr>();
+    var_mgr->create_named_variables({"a", "b"});
+    var_mgr->partition_variables({"a"}, {"b"});
+    Syft::SymbolicStateDfa arena =
+        Syft::SymbolicStateDfa::from_predicates(var_mgr, {var_mgr->name_to_variable("a")});
+
+    Syft::SynthesisResult result;
+    result.realizability = false;
+    REQUIRE_THROWS_AS(Syft::SolvedGameSnapshot(arena, result), std::runtime_error);
+
+    result.winning_states = var_mgr->state_variable(arena.automaton_id(), 0);
+    Syft::SolvedGameSnapshot snapshot(arena, result);
+    REQUIRE_FALSE(snapshot.has_strategy());
+    std::vector<std::uint8_t> values(snapshot.slot_count(), 1);
+    REQUIRE(snapshot.is_winning(values.data()));
+    REQUIRE_THROWS_AS(snapshot.is_winning_move(values.data()), std::runtime_error);
+    REQUIRE_THROWS_AS(snapshot.strategy_move(values.data()), std::runtime_error);
+}
@@ -0,0 +1,78 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <stdexcept>
+#include <string>
+#include "utils.hpp"
+#include "SolverSelector.h"
+
+TEST_CASE("Solver models predict by their thresholds", "[solver-selector]")
+{
+  Syft::SolverSelector selector = Syft::SolverSelector::parse(
+      "{\"node\": 0, \"feature\": \"colors\", \"threshold\": 2, \"below\": 1, \"above\": 2}\n"
+      "\n"
+      "{\"node\": 1, \"solver\": \"mp\"}\n"
+      "{\"node\": 2, \"solver\": \"obligation-cl\"}\n");
+  Syft::SpecFeatures features;
+  features.colors = 2;
+  std::string explanation;
+  REQUIRE(selector.predict(features, &explanation) == "mp");
+  REQUIRE(explanation == "colors=2 <= 2, mp");
+
+  // Obligation solvers are only predicted for obligation formulas
+  features.colors = 3;
+  REQUIRE(selector.predict(features) == "el");
+  features.obligation = true;
+  REQUIRE(selector.predict(features) == "obligation-cl");
+
+  Syft::SpecFeatures recurrence;
+  recurrence.forall_exists = 3;
+  recurrence.exists_forall = 3;
+  recurrence.acceptance = Syft::AcceptanceClass::ParityChain;
+  REQUIRE(Syft::SolverSelector::builtin().predict(recurrence) == "parity");
+  recurrence.acceptance = Syft::AcceptanceClass::Buchi;
+  REQUIRE(Syft::SolverSelector::builtin().predict(recurrence) == "el");
+  features.acceptance = Syft::AcceptanceClass::General;
+  REQUIRE(Syft::SolverSelector::builtin().predict(features) == "obligation-wg");
+
+  REQUIRE(Syft::SolverSelector::solver_mode("obligation-wg")->buechi_mode == "wg");
+  REQUIRE(Syft::SolverSelector::solver_mode("scc-layers")->game_solver == 5);
+  REQUIRE_FALSE(Syft::SolverSelector::solver_mode("auto").has_value());
+}
+
+TEST_CASE("Malformed solver models are refused", "[solver-selector]")
+{
+  // A missing child, an unknown feature, an unknown solver and a cycle
+  REQUIRE_THROWS_AS(Syft::SolverSelector::parse(
+      "{\"node\": 0, \"feature\": \"colors\", \"threshold\": 2, \"below\": 1, \"above\": 2}\n"
+      "{\"node\": 1, \"solver\": \"el\"}\n"), std::runtime_error);
+  REQUIRE_THROWS_AS(Syft::SolverSelector::parse(
+      "{\"node\": 0, \"feature\": \"size\", \"threshold\": 2, \"below\": 1, \"above\": 2}\n"
+      "{\"node\": 1, \"solver\": \"el\"}\n"
+      "{\"node\": 2, \"solver\": \"mp\"}\n"), std::runtime_error);
+  REQUIRE_THROWS_AS(Syft::SolverSelector::parse("{\"node\": 0, \"solver\": \"fastest\"}\n"), std::runtime_error);
+  REQUIRE_THROWS_AS(Syft::SolverSelector::parse(
+      "{\"node\": 0, \"feature\": \"colors\", \"threshold\": 2, \"below\": 0, \"above\": 1}\n"
+      "{\"node\": 1, \"solver\": \"el\"}\n"), std::runtime_error);
+  REQUIRE_THROWS_AS(Syft::SolverSelector::parse(""), std::runtime_error);
+}
+
+TEST_CASE("Spec features count the colors and DFAs", "[solver-selector]")
+{
+  Syft::InputOutputPartition partition =
+      Syft::InputOutputPartition::construct_from_input(vars{"e1", "e2"}, vars{"s1", "s2"});
+  Syft::DfaConstructionOptions dfa_options;
+  Syft::SpecFeatures features = Syft::extract_spec_features(
+      Syft::Test::get_ltlfplus_from_input("(AE(e1) -> AE(s1)) & A(G(!e2 | s2))"), false,
+      Syft::InterfaceLayout(partition), Syft::VarMgrOptions(), dfa_options);
+
+  REQUIRE(features.colors == 3);
+  REQUIRE(features.forall == 1);
+  REQUIRE(features.exists_forall == 1);
+  REQUIRE(features.forall_exists == 1);
+  REQUIRE(features.components >= 1);
+  REQUIRE(features.max_dfa_states <= features.total_dfa_states);
+  REQUIRE(features.arena_bits >= features.max_dfa_bits);
+  // The DFAs are kept for the solver that runs next
+  REQUIRE(dfa_options.shared_cache != nullptr);
+  REQUIRE(features.to_json().find("\"colors\": 3") != std::string::npos);
+}
@@ -0,0 +1,49 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+#include "VarMgr.h"
+#include "game/StrategyMinimizer.h"
+
+TEST_CASE("Strategies are minimized outside their reachable states", "[strategy]")
+{
+    auto var_mgr = std::make_shared<Syft::VarMgr>();
+    var_mgr->create_named_variables({"a", "b"});
+    var_mgr->partition_variables({"a"}, {"b"});
+    std::size_t id = var_mgr->create_state_variables(2);
+    CUDD::BDD a = var_mgr->name_to_variable("a");
+    CUDD::BDD b = var_mgr->name_to_variable("b");
+    CUDD::BDD z0 = var_mgr->state_variable(id, 0);
+    CUDD::BDD z1 = var_mgr->state_variable(id, 1);
+    int b_index = b.NodeReadIndex();
+
+    // z0 stays false, so only the moves copying a to b matter
+    std::vector<CUDD::BDD> transition_function = {var_mgr->cudd_mgr()->bddZero(), a};
+    std::vector<CUDD::BDD> state_variables = {z0, z1};
+    CUDD::BDD initial_state = !z0 & !z1;
+    REQUIRE(Syft::reachable_states(var_mgr, initial_state, transition_function, state_variables) == !z0);
+
+    CUDD::BDD function = (!z0 & a) | (z0 & (z1 ^ a));
+    CUDD::BDD winning_moves = b.Xnor(function);
+    std::unordered_map<int, CUDD::BDD> output_function = {{b_index, function}};
+    Syft::StrategyMinimizationOptions options;
+    options.method = Syft::StrategyMinimization::Restrict;
+    Syft::StrategyMinimizationReport report = Syft::minimize_strategy(var_mgr, output_function, winning_moves,
+                                                                      initial_state, transition_function,
+                                                                      state_variables, options);
+    REQUIRE(output_function.at(b_index) == a);
+    REQUIRE(report.nodes_after < report.nodes_before);
+
+    // Where every value of b is winning, per-output minimization may pick any
+    CUDD::BDD free_moves = (!z0 & b.Xnor(a)) | z0;
+    output_function = {{b_index, (!z0 & a) | (z0 & z1)}};
+    options.per_output = true;
+    Syft::minimize_strategy(var_mgr, output_function, free_moves, initial_state, transition_function,
+                            state_variables, options);
+    REQUIRE(output_function.at(b_index) == a);
+
+    REQUIRE(Syft::strategy_minimization_from_string("licompaction") == Syft::StrategyMinimization::LICompaction);
+    REQUIRE_THROWS_AS(Syft::strategy_minimization_from_string("minimal"), std::runtime_error);
+}
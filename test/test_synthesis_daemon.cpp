@@ -0,0 +1,118 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "FlatJson.h"
+#include "SynthesisDaemon.h"
+
+namespace {
+  int connect_to(const std::string& path) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    REQUIRE(connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0);
+    return fd;
+  }
+
+  void send_line(int fd, const std::string& line) {
+    std::string data = line + "\n";
+    REQUIRE(write(fd, data.data(), data.size()) == static_cast<ssize_t>(data.size()));
+  }
+
+  // Reads replies until the connection is closed
+  std::vector<Syft::JsonObject> read_replies(int fd) {
+    std::string text;
+    char chunk[4096];
+    ssize_t n;
+    while ((n = read(fd, chunk, sizeof(chunk))) > 0) {
+      text.append(chunk, static_cast<std::size_t>(n));
+    }
+    std::vector<Syft::JsonObject> replies;
+    std::size_t begin = 0;
+    for (std::size_t end; (end = text.find('\n', begin)) != std::string::npos; begin = end + 1) {
+      replies.push_back(Syft::parse_json_object(text.substr(begin, end - begin)));
+    }
+    return replies;
+  }
+
+  std::string text_of(const Syft::JsonObject& reply, const std::string& name) {
+    auto it = reply.find(name);
+    return it == reply.end() ? "" : it->second.text;
+  }
+}
+
+TEST_CASE("Synthesis daemon streams events and results", "[daemon]")
+{
+  std::string path = (std::filesystem::temp_directory_path() / "lydiasyft_test_daemon.sock").string();
+  Syft::SynthesisDaemon daemon("unix:" + path);
+  REQUIRE(daemon.port() == 0);
+
+  std::atomic<bool> second_started(false);
+  std::size_t solved = 0;
+  std::thread server([&]() {
+    solved = daemon.serve([&](const Syft::BatchJob& job, const Syft::DaemonJobContext& context) {
+      Syft::BddStatsSnapshot snapshot;
+      snapshot.phase = "DFA construction";
+      context.progress(snapshot);
+      Syft::BatchResult result;
+      if (job.id == "slow") {
+        second_started = true;
+        // Runs until the client cancels it, as a solver would at its next budget check
+        while (!context.cancelled->load()) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        result.verdict = "UNKNOWN";
+        result.detail = "budget exceeded (cancelled)";
+        return result;
+      }
+      result.verdict = *job.starting_player == 1 ? "REALIZABLE" : "UNREALIZABLE";
+      return result;
+    });
+  });
+
+  int fd = connect_to(path);
+  send_line(fd, "{\"id\": \"fast\", \"formula\": \"/a.ltlfplus\", \"partition\": \"/a.part\", \"starting_player\": 1}");
+  send_line(fd, "{\"id\": \"slow\", \"formula\": \"/b.ltlfplus\", \"partition\": \"/b.part\"}");
+  send_line(fd, "{\"id\": \"partial\", \"formula\": \"/a.ltlfplus\"}");
+  while (!second_started) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  send_line(fd, "{\"cancel\": \"slow\"}");
+  send_line(fd, "{\"shutdown\": true}");
+  // The replies still come once the client is done writing
+  shutdown(fd, SHUT_WR);
+  std::vector<Syft::JsonObject> replies = read_replies(fd);
+  close(fd);
+  server.join();
+  REQUIRE(solved == 2);
+
+  std::vector<std::string> fast_events;
+  std::string fast_verdict, slow_verdict;
+  std::size_t errors = 0;
+  for (const Syft::JsonObject& reply : replies) {
+    std::string id = text_of(reply, "id");
+    if (text_of(reply, "event") == "error") {
+      ++errors;
+    } else if (id == "fast" && reply.count("verdict") > 0) {
+      fast_verdict = text_of(reply, "verdict");
+    } else if (id == "fast") {
+      fast_events.push_back(text_of(reply, "event"));
+    } else if (id == "slow" && reply.count("verdict") > 0) {
+      slow_verdict = text_of(reply, "verdict");
+    }
+  }
+  REQUIRE(fast_events == std::vector<std::string>{"queued", "started", "phase"});
+  REQUIRE(fast_verdict == "REALIZABLE");
+  REQUIRE(slow_verdict == "UNKNOWN");
+  // The job without a partition
+  REQUIRE(errors == 1);
+}
@@ -0,0 +1,80 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "SynthesisReport.h"
+
+namespace {
+  std::string read_file(const std::filesystem::path& path) {
+    std::ifstream in(path);
+    std::stringstream content;
+    content << in.rdbuf();
+    return content.str();
+  }
+}
+
+TEST_CASE("Sizes keep their largest value", "[report]")
+{
+  Syft::SolverStats stats;
+  // Sizes are recorded even though snapshots are not
+  stats.record_size("zielonka_tree_nodes", 5);
+  stats.record_size("zielonka_tree_nodes", 3);
+  stats.record_size("mp_dag_nodes", 4);
+  stats.record_color_states(1, 3);
+  stats.record_color_states(1, 2);
+  REQUIRE(stats.snapshots().empty());
+  REQUIRE(stats.sizes().at("zielonka_tree_nodes") == 5);
+  REQUIRE(stats.sizes().at("mp_dag_nodes") == 4);
+  REQUIRE(stats.color_dfa_states().at(1) == 2);
+}
+
+TEST_CASE("JSON result of a run", "[report]")
+{
+  Syft::SolverStats stats;
+  stats.record_size("arena_state_bits", 7);
+  stats.record_size("zielonka_tree_nodes", 4);
+  stats.record_color_states(0, 3);
+  stats.record_color_states(2, 0);
+  stats.record_dfa_backend("compositional");
+  stats.record_dfa_backend("compositional");
+  stats.record_dfa_backend("decomposed");
+
+  Syft::SynthesisReport report;
+  report.tool = "LydiaSyftEL";
+  report.formula_file = "examples/\"quoted\".ltlfplus";
+  report.verdict = "REALIZABLE";
+  report.solver = "emerson-lei";
+  report.agent_starts = true;
+  report.wall_time = 1.5;
+  report.stats = &stats;
+  std::string json = report.to_json();
+
+  REQUIRE(json.find("\"schema_version\": 1,") != std::string::npos);
+  REQUIRE(json.find("\"formula_file\": \"examples/\\\"quoted\\\".ltlfplus\",") != std::string::npos);
+  REQUIRE(json.find("\"partition_file\": null,") != std::string::npos);
+  REQUIRE(json.find("\"verdict\": \"REALIZABLE\",") != std::string::npos);
+  REQUIRE(json.find("\"mode\": null,") != std::string::npos);
+  REQUIRE(json.find("\"starting_player\": \"agent\",") != std::string::npos);
+  REQUIRE(json.find("\"wall_time\": 1.5,") != std::string::npos);
+  REQUIRE(json.find("\"phases\": [],") != std::string::npos);
+  REQUIRE(json.find("\"arena_state_bits\": 7,") != std::string::npos);
+  REQUIRE(json.find("\"color_dfa_states\": {\"0\": 3, \"2\": 0},") != std::string::npos);
+  REQUIRE(json.find("\"dfa_backends\": {\"compositional\": 2, \"decomposed\": 1},") != std::string::npos);
+  REQUIRE(json.find("\"zielonka_tree_nodes\": 4,") != std::string::npos);
+  // Not reached by an Emerson-Lei run
+  REQUIRE(json.find("\"mp_dag_nodes\": null\n") != std::string::npos);
+
+  std::filesystem::path file = std::filesystem::temp_directory_path() / "lydiasyft_test_result.json";
+  report.write(file.string());
+  REQUIRE(read_file(file) == json);
+  REQUIRE_FALSE(std::filesystem::exists(file.string() + ".partial"));
+
+  // A portfolio has no statistics to report
+  report.stats = nullptr;
+  json = report.to_json();
+  REQUIRE(json.find("\"arena_state_bits\": null,") != std::string::npos);
+  REQUIRE(json.find("\"color_dfa_states\": {},") != std::string::npos);
+  REQUIRE(json.find("\"dfa_backends\": {},") != std::string::npos);
+}
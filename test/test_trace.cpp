@@ -0,0 +1,45 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include "Trace.h"
+
+TEST_CASE("Chrome trace of nested spans", "[trace]")
+{
+  std::filesystem::path path = std::filesystem::temp_directory_path() / "lydiasyft_test_trace.json";
+  std::filesystem::remove(path);
+  {
+    // Not recorded: tracing is off
+    Syft::TraceScope untraced("untraced");
+    REQUIRE_FALSE(untraced.active());
+  }
+
+  Syft::Tracer::start(path.string());
+  REQUIRE(Syft::Tracer::enabled());
+  {
+    Syft::TraceScope outer("outer \"span\"", "test");
+    REQUIRE(outer.active());
+    outer.arg("states", 42).arg("operation", "AND");
+    std::thread([]() {
+      Syft::TraceScope inner("inner", "test");
+    }).join();
+  }
+  Syft::Tracer::finish();
+  REQUIRE_FALSE(Syft::Tracer::enabled());
+
+  std::ifstream in(path);
+  std::string trace((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  REQUIRE(trace.rfind("{\"traceEvents\": [", 0) == 0);
+  REQUIRE(trace.find("untraced") == std::string::npos);
+  REQUIRE(trace.find("\"name\": \"outer \\\"span\\\"\", \"cat\": \"test\", \"ph\": \"X\"") != std::string::npos);
+  REQUIRE(trace.find("\"args\": {\"states\": 42, \"operation\": \"AND\"}") != std::string::npos);
+  // The inner span ended first, on a thread of its own
+  std::size_t inner = trace.find("\"name\": \"inner\"");
+  REQUIRE(inner != std::string::npos);
+  REQUIRE(inner < trace.find("outer"));
+  REQUIRE(trace.find("\"tid\": 1,") != std::string::npos);
+  REQUIRE(trace.find("\"tid\": 2,") != std::string::npos);
+}
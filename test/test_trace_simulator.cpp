@@ -0,0 +1,61 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+#include "VarMgr.h"
+#include "automata/ExplicitStateDfa.h"
+#include "automata/SymbolicStateDfa.h"
+#include "game/TraceSimulator.h"
+#include "game/Transducer.h"
+#include "lydia/parser/ltlf/driver.hpp"
+
+namespace {
+  Syft::ExplicitStateDfa dfa_of(const std::string& formula) {
+    whitemech::lydia::parsers::ltlf::LTLfDriver driver;
+    std::stringstream stream(formula);
+    driver.parse(stream);
+    auto parsed = std::static_pointer_cast<const whitemech::lydia::LTLfFormula>(driver.get_result());
+    return Syft::ExplicitStateDfa::dfa_of_formula(*parsed);
+  }
+
+  // A controller without state whose output b is f(a)
+  Syft::Transducer controller(const std::shared_ptr<Syft::VarMgr>& var_mgr, const CUDD::BDD& f) {
+    std::unordered_map<int, CUDD::BDD> output_function = {{var_mgr->name_to_variable("b").NodeReadIndex(), f}};
+    return Syft::Transducer(var_mgr, std::vector<int>(var_mgr->total_variable_count(), 0), output_function, {},
+                            Syft::Player::Environment, Syft::Player::Agent, {});
+  }
+}
+
+TEST_CASE("Simulated traces are checked against the color DFAs", "[simulator]")
+{
+    auto var_mgr = std::make_shared<Syft::VarMgr>();
+    var_mgr->create_named_variables({"a", "b"});
+    var_mgr->partition_variables({"a"}, {"b"});
+    Syft::SymbolicStateDfa copy = Syft::SymbolicStateDfa::from_mona(var_mgr, dfa_of("G((a -> b) & (b -> a))"));
+    Syft::SymbolicStateDfa eventually = Syft::SymbolicStateDfa::from_mona(var_mgr, dfa_of("F(a)"));
+    std::vector<Syft::SymbolicStateDfa> components = {copy, eventually};
+    std::vector<CUDD::BDD> goals = {copy.final_states(), eventually.final_states()};
+    CUDD::BDD a = var_mgr->name_to_variable("a");
+
+    Syft::TraceSimulator follower(controller(var_mgr, a), components, goals);
+    Syft::SimulationReport report = follower.simulate_random(5000, 8, 3);
+    REQUIRE(report.traces == 5000);
+    REQUIRE(report.steps == 40000);
+    REQUIRE(report.violations[0] == 0);
+    // Only the traces that never set a, about one in 256
+    REQUIRE(report.violations[1] > 0);
+    REQUIRE(report.violations[1] < 100);
+
+    Syft::TraceSimulator contrarian(controller(var_mgr, !a), components, goals);
+    REQUIRE(contrarian.simulate_random(300, 4).violations[0] == 300);
+
+    std::vector<Syft::TraceSimulator::Trace> recorded = {{{true}, {false}}, {{false}}, {{false}, {false}, {true}}};
+    Syft::SimulationReport replayed = follower.simulate(recorded);
+    REQUIRE(replayed.traces == 3);
+    REQUIRE(replayed.steps == 6);
+    REQUIRE(replayed.violations == std::vector<std::size_t>{0, 1});
+    REQUIRE_THROWS_AS(follower.simulate(std::vector<Syft::TraceSimulator::Trace>{{{true, false}}}), std::runtime_error);
+}
@@ -0,0 +1,180 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "InterfaceLayout.h"
+#include "VarMgr.h"
+#include "VariableOrdering.h"
+
+TEST_CASE("Reorder policy parsing", "[varmgr]")
+{
+    Syft::ReorderPolicy policy = Syft::ReorderPolicy::from_string("phase", "group-sift");
+    REQUIRE(policy.mode == Syft::ReorderMode::Phase);
+    REQUIRE(policy.method == CUDD_REORDER_GROUP_SIFT);
+
+    REQUIRE(Syft::ReorderPolicy::from_string("off").mode == Syft::ReorderMode::Off);
+    REQUIRE_THROWS_AS(Syft::ReorderPolicy::from_string("sometimes"), std::runtime_error);
+    REQUIRE_THROWS_AS(Syft::ReorderPolicy::from_string("auto", "bubble"), std::runtime_error);
+}
+
+TEST_CASE("Phase reordering preserves functions and variables", "[varmgr]")
+{
+    auto var_mgr = std::make_shared<Syft::VarMgr>();
+    var_mgr->create_named_variables({"a", "b", "c"});
+    var_mgr->partition_variables({"a"}, {"b", "c"});
+    std::size_t id = var_mgr->create_state_variables(3);
+
+    CUDD::BDD f = var_mgr->name_to_variable("a") * var_mgr->state_variable(id, 0) +
+                  var_mgr->name_to_variable("b") * var_mgr->state_variable(id, 1) +
+                  var_mgr->name_to_variable("c") * var_mgr->state_variable(id, 2);
+    CUDD::BDD a_var = var_mgr->name_to_variable("a");
+
+    var_mgr->set_reorder_policy(Syft::ReorderPolicy::from_string("phase"));
+    var_mgr->reorder_at_phase("test");
+
+    CUDD::BDD g = var_mgr->name_to_variable("a") * var_mgr->state_variable(id, 0) +
+                  var_mgr->name_to_variable("b") * var_mgr->state_variable(id, 1) +
+                  var_mgr->name_to_variable("c") * var_mgr->state_variable(id, 2);
+    REQUIRE(f == g);
+    REQUIRE(var_mgr->name_to_variable("a") == a_var);
+    REQUIRE(var_mgr->index_to_name(a_var.NodeReadIndex()) == "a");
+}
+
+TEST_CASE("Manager options are applied", "[varmgr]")
+{
+    Syft::VarMgrOptions options;
+    options.max_cache_hard = 1u << 20;
+    options.loose_up_to = 1u << 18;
+    Syft::VarMgr var_mgr(options);
+
+    REQUIRE(var_mgr.cudd_mgr()->ReadMaxCacheHard() == options.max_cache_hard);
+    REQUIRE(var_mgr.cudd_mgr()->ReadLooseUpTo() == options.loose_up_to);
+}
+
+TEST_CASE("Cubes and compose vectors are memoized until variables are added", "[varmgr]")
+{
+    auto var_mgr = std::make_shared<Syft::VarMgr>();
+    var_mgr->create_named_variables({"a", "b"});
+    var_mgr->partition_variables({"a"}, {"b"});
+    std::size_t id = var_mgr->create_state_variables(2);
+
+    const CUDD::BDD& first = var_mgr->state_variables_cube(id);
+    REQUIRE(&first == &var_mgr->state_variables_cube(id));
+    REQUIRE(first == var_mgr->state_variable(id, 0) * var_mgr->state_variable(id, 1));
+    REQUIRE(var_mgr->input_cube() == var_mgr->name_to_variable("a"));
+
+    std::vector<CUDD::BDD> next = {var_mgr->name_to_variable("a"), !var_mgr->state_variable(id, 0)};
+    const auto& compose = var_mgr->make_compose_vector(id, next);
+    REQUIRE(&compose == &var_mgr->make_compose_vector(id, next));
+    REQUIRE(compose.size() == var_mgr->total_variable_count());
+
+    std::size_t other = var_mgr->create_state_variables(1);
+    const auto& grown = var_mgr->make_compose_vector(id, next);
+    REQUIRE(grown.size() == var_mgr->total_variable_count());
+    CUDD::BDD z = var_mgr->state_variable(other, 0);
+    REQUIRE(grown[z.NodeReadIndex()] == z);
+    REQUIRE(grown[var_mgr->state_variable(id, 1).NodeReadIndex()] == !var_mgr->state_variable(id, 0));
+}
+
+TEST_CASE("Statistics are recorded only when enabled", "[varmgr]")
+{
+    Syft::VarMgr silent;
+    silent.end_phase("DFA construction");
+    REQUIRE(silent.stats().snapshots().empty());
+
+    Syft::VarMgrOptions options;
+    options.collect_stats = true;
+    Syft::VarMgr var_mgr(options);
+    var_mgr.create_named_variables({"a"});
+    var_mgr.end_phase("DFA construction");
+    var_mgr.snapshot_stats("fixpoint");
+
+    const auto& snapshots = var_mgr.stats().snapshots();
+    REQUIRE(snapshots.size() == 2);
+    REQUIRE(snapshots[0].phase == "DFA construction");
+    REQUIRE(snapshots[1].phase == "fixpoint");
+    REQUIRE(snapshots[1].peak_nodes >= snapshots[1].live_nodes);
+    REQUIRE(snapshots[0].peak_rss_kb > 0);
+    REQUIRE(snapshots[1].peak_rss_kb >= snapshots[0].peak_rss_kb);
+}
+
+TEST_CASE("Exhausted budgets stop at the next check", "[varmgr]")
+{
+    Syft::VarMgrOptions options;
+    options.budget.set_max_live_nodes(1);
+    auto var_mgr = std::make_shared<Syft::VarMgr>(options);
+    std::size_t id = var_mgr->create_state_variables(4);
+    // Keep a few internal nodes alive; isolated variables are not counted
+    CUDD::BDD f = var_mgr->state_variable(id, 0) * var_mgr->state_variable(id, 1) +
+                  var_mgr->state_variable(id, 2) * var_mgr->state_variable(id, 3);
+
+    try {
+        var_mgr->check_budget("test");
+        FAIL("the node budget should be exceeded");
+    } catch (const Syft::BudgetExceeded& e) {
+        REQUIRE(e.resource() == "nodes");
+        REQUIRE(e.phase() == "test");
+        REQUIRE(e.snapshot().live_nodes > 1);
+    }
+
+    auto unbounded = std::make_shared<Syft::VarMgr>();
+    REQUIRE_NOTHROW(unbounded->check_budget("test"));
+}
+
+TEST_CASE("Cloned managers keep variable indices and levels", "[varmgr]")
+{
+    auto var_mgr = std::make_shared<Syft::VarMgr>();
+    var_mgr->create_named_variables({"a", "b"});
+    var_mgr->partition_variables({"a"}, {"b"});
+    std::size_t id = var_mgr->create_state_variables(3);
+    CUDD::BDD f = var_mgr->name_to_variable("a") * var_mgr->state_variable(id, 0) +
+                  !var_mgr->name_to_variable("b") * var_mgr->state_variable(id, 2);
+
+    std::shared_ptr<Syft::VarMgr> copy = var_mgr->clone();
+    REQUIRE(copy->cudd_mgr() != var_mgr->cudd_mgr());
+    REQUIRE(copy->total_variable_count() == var_mgr->total_variable_count());
+    REQUIRE(copy->state_variable_count(id) == 3);
+    REQUIRE(copy->input_variable_labels() == var_mgr->input_variable_labels());
+    REQUIRE(copy->output_variable_labels() == var_mgr->output_variable_labels());
+    for (int index = 0; index < var_mgr->cudd_mgr()->ReadSize(); ++index) {
+        REQUIRE(copy->cudd_mgr()->ReadPerm(index) == var_mgr->cudd_mgr()->ReadPerm(index));
+    }
+
+    CUDD::BDD g = f.Transfer(*copy->cudd_mgr());
+    REQUIRE(g == copy->name_to_variable("a") * copy->state_variable(id, 0) +
+                 !copy->name_to_variable("b") * copy->state_variable(id, 2));
+    REQUIRE(g.Transfer(*var_mgr->cudd_mgr()) == f);
+}
+
+TEST_CASE("FORCE order brings co-occurring variables together", "[varmgr]")
+{
+    std::vector<std::string> variables = {"a", "c", "b", "d"};
+    std::vector<std::set<std::string>> hyperedges = {{"a", "b"}, {"c", "d"}};
+    REQUIRE(Syft::force_order(variables, hyperedges) == std::vector<std::string>{"a", "b", "c", "d"});
+
+    // Nothing to improve: the given order is kept
+    REQUIRE(Syft::force_order(variables, {}) == variables);
+    REQUIRE(Syft::force_order({"a", "b", "c", "d"}, hyperedges) == std::vector<std::string>{"a", "b", "c", "d"});
+}
+
+TEST_CASE("Interface layout instantiates partitioned managers", "[varmgr]")
+{
+    Syft::InterfaceLayout layout(Syft::InputOutputPartition::construct_from_input({"x1", "x2"}, {"y"}));
+    REQUIRE(layout.partition_order() == std::vector<std::string>{"x1", "x2", "y"});
+
+    // Copies share the layout, and every instance has a manager of its own
+    Syft::InterfaceLayout copy = layout;
+    std::shared_ptr<Syft::VarMgr> first = layout.instantiate(Syft::VarMgrOptions());
+    std::shared_ptr<Syft::VarMgr> second = copy.instantiate(Syft::VarMgrOptions(), {"y", "x2", "x1"});
+    REQUIRE(first->cudd_mgr() != second->cudd_mgr());
+    REQUIRE(first->input_variable_count() == 2);
+    REQUIRE(first->output_variable_count() == 1);
+    REQUIRE(first->index_to_name(first->name_to_variable("x1").NodeReadIndex()) == "x1");
+    REQUIRE(second->name_to_variable("y").NodeReadIndex() == 0);
+    REQUIRE(second->input_cube() == second->name_to_variable("x1") * second->name_to_variable("x2"));
+
+    REQUIRE_THROWS_AS(Syft::InterfaceLayout(Syft::InputOutputPartition::construct_from_input({"a"}, {"a"})),
+                      std::runtime_error);
+}
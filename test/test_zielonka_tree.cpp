@@ -0,0 +1,309 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "game/AcceptanceClass.h"
+#include "game/ColorSet.h"
+#include "game/ColorFormula.h"
+#include "game/ELHelpers.hh"
+#include "game/ZielonkaTree.hh"
+#include "VarMgr.h"
+
+namespace {
+  // Colors that every state sees
+  std::vector<CUDD::BDD> trivial_colors(const std::shared_ptr<Syft::VarMgr>& var_mgr, std::size_t colors) {
+    std::vector<CUDD::BDD> color_bdds(colors, var_mgr->cudd_mgr()->bddOne());
+    return color_bdds;
+  }
+}
+
+TEST_CASE("Zielonka tree children are the maximal color sets of the other player", "[zielonka]")
+{
+  auto var_mgr = std::make_shared<Syft::VarMgr>();
+  ZielonkaTree tree("Inf 0 | Fin 1", trivial_colors(var_mgr, 2), var_mgr);
+
+  ZielonkaNode* root = tree.get_root();
+  REQUIRE(root->winning);
+  REQUIRE(root->children.size() == 1);
+  ZielonkaNode* child = root->children[0];
+  REQUIRE(child->label.to_bools() == std::vector<bool>{false, true});
+  REQUIRE(!child->winning);
+  REQUIRE(child->children.size() == 1);
+  REQUIRE(child->children[0]->label.none());
+  REQUIRE(child->children[0]->children.empty());
+}
+
+TEST_CASE("Zielonka trees of many colors are built without the powerset", "[zielonka]")
+{
+  // A generalized Büchi condition: 2^24 color sets, but only 25 nodes
+  const std::size_t colors = 24;
+  std::string formula;
+  for (std::size_t i = 0; i < colors; ++i) {
+    formula += (i == 0 ? "" : " & ") + std::string("Inf ") + std::to_string(i);
+  }
+  auto var_mgr = std::make_shared<Syft::VarMgr>();
+  ZielonkaTree tree(formula, trivial_colors(var_mgr, colors), var_mgr);
+
+  ZielonkaNode* root = tree.get_root();
+  REQUIRE(root->winning);
+  REQUIRE(root->children.size() == colors);
+  for (ZielonkaNode* child : root->children) {
+    REQUIRE(!child->winning);
+    REQUIRE(child->children.empty());
+    REQUIRE(child->label.count() == colors - 1);
+  }
+}
+
+TEST_CASE("Color sets work a word at a time, inline or not", "[zielonka][color]")
+{
+  // 100 colors stay inline, 200 spill to the heap
+  for (std::size_t colors : {std::size_t(100), std::size_t(200)}) {
+    Syft::ColorSet all(colors, true), some(colors);
+    REQUIRE(all.count() == colors);
+    REQUIRE(some.none());
+    for (std::size_t color = 0; color < colors; color += 7) {
+      some.set(color);
+    }
+    REQUIRE(some.is_proper_subset_of(all));
+    REQUIRE_FALSE(all.is_subset_of(some));
+    Syft::ColorSet rest = all - some;
+    REQUIRE(rest.count() + some.count() == colors);
+    REQUIRE((rest & some).none());
+    REQUIRE((rest | some) == all);
+
+    std::vector<std::size_t> visited;
+    some.for_each([&](std::size_t color) { visited.push_back(color); });
+    REQUIRE(visited.size() == some.count());
+    REQUIRE(visited.back() == (colors - 1) / 7 * 7);
+    REQUIRE(Syft::ColorSet::from_bools(some.to_bools()) == some);
+
+    some.reset(0);
+    REQUIRE_FALSE(some[0]);
+    REQUIRE(some != Syft::ColorSet::from_bools(rest.to_bools()));
+  }
+}
+
+TEST_CASE("Compiled color formulas agree with the postfix evaluator", "[zielonka][color]")
+{
+  // 5 colors are evaluated through the truth table, 20 by running the program
+  for (const std::string formula : {"(Inf 0 & Fin 1) | !(2 & (3 | Fin 4)) & true",
+                                    "(Inf 0 | Fin 19) & (Inf 7 | Fin 12) & !(3 & 15) | false"}) {
+    std::vector<std::string> postfix = ELHelpers::infix2postfix(ELHelpers::tokenize(formula));
+    Syft::ColorFormula compiled(formula);
+    std::size_t colors = compiled.color_count();
+    for (std::uint64_t mask = 0; mask < 4096; ++mask) {
+      // Spread the 12 bits over all colors
+      std::uint64_t set = (mask * 0x9E3779B97F4A7C15ull) >> (64 - colors);
+      std::vector<bool> label(colors);
+      for (std::size_t i = 0; i < colors; ++i) {
+        label[i] = (set >> i) & 1;
+      }
+      REQUIRE(compiled.evaluate(set) == ELHelpers::eval_postfix(postfix, label));
+      REQUIRE(compiled.evaluate(label) == ELHelpers::eval_postfix(postfix, label));
+      REQUIRE(compiled.evaluate(Syft::ColorSet::from_bools(label)) == ELHelpers::eval_postfix(postfix, label));
+    }
+  }
+
+  REQUIRE_THROWS_AS(Syft::ColorFormula("0 &"), std::runtime_error);
+  REQUIRE_THROWS_AS(Syft::ColorFormula("0 ^ 1"), std::runtime_error);
+}
+
+TEST_CASE("Color formulas are compiled back from their BDDs", "[zielonka][color]")
+{
+  CUDD::Cudd mgr;
+  // Color c is variable 4 - c, so the variable order is not the color order
+  Syft::ColorFormula compiled("(Inf 0 & Fin 1) | !(2 & (3 | Fin 4))");
+  CUDD::BDD formula = compiled.to_bdd([&](std::size_t color) { return mgr.bddVar(4 - static_cast<int>(color)); }, mgr);
+  auto variable_color = [](int index) { return static_cast<std::size_t>(4 - index); };
+
+  Syft::ColorFormula decompiled = Syft::ColorFormula::from_bdd(formula, variable_color);
+  // Color 1 fixed to true, as for a Manna-Pnueli DAG node
+  Syft::ColorFormula restricted = Syft::ColorFormula::from_bdd(formula.Restrict(mgr.bddVar(3)), variable_color);
+  for (std::uint64_t set = 0; set < 32; ++set) {
+    REQUIRE(decompiled.evaluate(set) == compiled.evaluate(set));
+    REQUIRE(restricted.evaluate(set) == compiled.evaluate(set | 2));
+  }
+
+  REQUIRE(!Syft::ColorFormula::from_bdd(mgr.bddZero(), variable_color).evaluate(std::uint64_t(0)));
+  REQUIRE(Syft::ColorFormula::from_bdd(mgr.bddOne(), variable_color).evaluate(std::uint64_t(0)));
+}
+
+TEST_CASE("Repeated Zielonka subtrees share their DAG node", "[zielonka][dag]")
+{
+  // Two Streett pairs: both branches end in a leaf labelled with the empty set
+  auto var_mgr = std::make_shared<Syft::VarMgr>();
+  ZielonkaTree tree("(Fin 0 | Inf 1) & (Fin 2 | Inf 3)", trivial_colors(var_mgr, 4), var_mgr);
+
+  std::vector<ZielonkaNode*> nodes{tree.get_root()};
+  std::vector<ZielonkaNode*> empty_leaves;
+  for (std::size_t i = 0; i < nodes.size(); ++i) {
+    for (ZielonkaNode* child : nodes[i]->children) {
+      nodes.push_back(child);
+    }
+    if (nodes[i]->label.none()) {
+      empty_leaves.push_back(nodes[i]);
+    }
+  }
+  REQUIRE(nodes.size() == 9);
+  REQUIRE(tree.dag_size() == 8);
+  REQUIRE(empty_leaves.size() == 2);
+  REQUIRE(empty_leaves[0]->dag_id == empty_leaves[1]->dag_id);
+  REQUIRE(empty_leaves[0] != empty_leaves[1]);
+}
+
+TEST_CASE("Zielonka node sets can be restricted to the state space", "[zielonka]")
+{
+  // Color 0 holds exactly where p holds, color 1 everywhere
+  auto var_mgr = std::make_shared<Syft::VarMgr>();
+  var_mgr->create_named_variables({"p", "q"});
+  CUDD::BDD p = var_mgr->name_to_variable("p");
+  CUDD::BDD q = var_mgr->name_to_variable("q");
+  std::vector<CUDD::BDD> color_bdds{p, var_mgr->cudd_mgr()->bddOne()};
+  ZielonkaTree tree("Inf 0 | Fin 1", color_bdds, var_mgr);
+  REQUIRE(tree.get_root()->label.size() == 2);
+
+  ZielonkaNode* child = tree.get_root()->children[0];
+  REQUIRE(child->targetnodes == p);
+  REQUIRE(child->safenodes == !p);
+
+  tree.restrict_to(q);
+  REQUIRE(tree.get_root()->safenodes == q);
+  REQUIRE(child->targetnodes == (p & q));
+  REQUIRE(child->safenodes == (!p & q));
+  REQUIRE(child->children[0]->targetnodes == (!p & q));
+}
+
+TEST_CASE("Zielonka trees read Fin colors as the complements of their states", "[zielonka]")
+{
+  // Color 0 holds where p holds and color 1 where q holds
+  auto var_mgr = std::make_shared<Syft::VarMgr>();
+  var_mgr->create_named_variables({"p", "q"});
+  CUDD::BDD p = var_mgr->name_to_variable("p");
+  CUDD::BDD q = var_mgr->name_to_variable("q");
+  ZielonkaTree tree("Inf(0) & Fin(1)", std::vector<CUDD::BDD>{p, q}, var_mgr);
+
+  // The root is losing, as both colors are seen: its child drops color 1, whose states are the targets
+  ZielonkaNode* root = tree.get_root();
+  REQUIRE_FALSE(root->winning);
+  REQUIRE(root->children.size() == 1);
+  ZielonkaNode* child = root->children[0];
+  REQUIRE(child->label.to_bools() == std::vector<bool>{true, false});
+  REQUIRE(child->targetnodes == q);
+  REQUIRE(child->safenodes == !q);
+  REQUIRE(child->children.size() == 1);
+  REQUIRE(child->children[0]->targetnodes == (!q & p));
+  REQUIRE(child->children[0]->safenodes == (!q & !p));
+}
+
+TEST_CASE("Zielonka trees release the winning moves of their nodes", "[zielonka]")
+{
+  auto var_mgr = std::make_shared<Syft::VarMgr>();
+  ZielonkaTree tree("Inf 0 | Fin 1", trivial_colors(var_mgr, 2), var_mgr);
+  std::vector<ZielonkaNode*> nodes{tree.get_root()};
+  for (std::size_t i = 0; i < nodes.size(); ++i) {
+    nodes[i]->winningmoves.push_back(var_mgr->cudd_mgr()->bddOne());
+    for (ZielonkaNode* child : nodes[i]->children) {
+      nodes.push_back(child);
+    }
+  }
+
+  tree.release_winning_moves();
+  for (ZielonkaNode* node : nodes) {
+    REQUIRE(node->winningmoves.empty());
+  }
+  REQUIRE(tree.get_root()->children.size() == 1);
+}
+
+TEST_CASE("Acceptance classes are read off the Zielonka tree", "[zielonka][acceptance]")
+{
+  auto var_mgr = std::make_shared<Syft::VarMgr>();
+  auto classify = [&](const std::string& formula, std::size_t colors) {
+    ZielonkaTree tree(formula, trivial_colors(var_mgr, colors), var_mgr);
+    return Syft::classify_acceptance(tree.get_root());
+  };
+
+  REQUIRE(classify("t", 1) == Syft::AcceptanceClass::Safety);
+  REQUIRE(classify("f", 1) == Syft::AcceptanceClass::Reachability);
+  REQUIRE(classify("Inf 0", 1) == Syft::AcceptanceClass::Buchi);
+  REQUIRE(classify("Inf 0 | Inf 1", 2) == Syft::AcceptanceClass::Buchi);
+  REQUIRE(classify("Fin 0", 1) == Syft::AcceptanceClass::CoBuchi);
+  REQUIRE(classify("Inf 0 & Inf 1", 2) == Syft::AcceptanceClass::GeneralizedBuchi);
+  REQUIRE(classify("Fin 0 | Fin 1", 2) == Syft::AcceptanceClass::GeneralizedCoBuchi);
+  REQUIRE(classify("Inf 0 | Fin 1", 2) == Syft::AcceptanceClass::ParityChain);
+  REQUIRE(classify("(Fin 0 | Fin 1) | (Inf 2 & Inf 3)", 4) == Syft::AcceptanceClass::GR1Like);
+  REQUIRE(classify("(Fin 0 | Inf 1) & (Fin 2 | Inf 3)", 4) == Syft::AcceptanceClass::General);
+  REQUIRE(Syft::is_two_level(Syft::AcceptanceClass::GeneralizedCoBuchi));
+  REQUIRE(!Syft::is_two_level(Syft::AcceptanceClass::ParityChain));
+}
+
+TEST_CASE("Lazy Zielonka trees expand their nodes on first access", "[zielonka][lazy]")
+{
+  auto var_mgr = std::make_shared<Syft::VarMgr>();
+  const std::string formula = "(Fin 0 | Inf 1) & (Fin 2 | Inf 3)";
+  ZielonkaTree eager(formula, trivial_colors(var_mgr, 4), var_mgr);
+  ZielonkaTree lazy(formula, trivial_colors(var_mgr, 4), var_mgr, true);
+  REQUIRE(lazy.size() == 1);
+  REQUIRE(!lazy.get_root()->expanded);
+
+  // The class only needs the first three levels, whose children are the fourth
+  REQUIRE(Syft::classify_acceptance(lazy) == Syft::AcceptanceClass::General);
+  REQUIRE(lazy.size() == 7);
+
+  lazy.expand_all();
+  REQUIRE(lazy.size() == eager.size());
+  REQUIRE(lazy.dag_size() == eager.dag_size());
+  std::vector<ZielonkaNode*> eager_nodes{eager.get_root()}, lazy_nodes{lazy.get_root()};
+  for (std::size_t i = 0; i < eager_nodes.size(); ++i) {
+    REQUIRE(lazy_nodes[i]->label == eager_nodes[i]->label);
+    REQUIRE(lazy_nodes[i]->winning == eager_nodes[i]->winning);
+    REQUIRE(lazy_nodes[i]->children.size() == eager_nodes[i]->children.size());
+    eager_nodes.insert(eager_nodes.end(), eager_nodes[i]->children.begin(), eager_nodes[i]->children.end());
+    lazy_nodes.insert(lazy_nodes.end(), lazy_nodes[i]->children.begin(), lazy_nodes[i]->children.end());
+  }
+}
+
+TEST_CASE("Lazy Zielonka nodes inherit the restriction to the state space", "[zielonka][lazy]")
+{
+  auto var_mgr = std::make_shared<Syft::VarMgr>();
+  var_mgr->create_named_variables({"p", "q"});
+  CUDD::BDD p = var_mgr->name_to_variable("p");
+  CUDD::BDD q = var_mgr->name_to_variable("q");
+  std::vector<CUDD::BDD> color_bdds{p, var_mgr->cudd_mgr()->bddOne()};
+  ZielonkaTree tree("Inf 0 | Fin 1", color_bdds, var_mgr, true);
+
+  tree.restrict_to(q);
+  ZielonkaNode* child = tree.children(tree.get_root())[0];
+  REQUIRE(child->targetnodes == (p & q));
+  REQUIRE(child->safenodes == (!p & q));
+  REQUIRE(tree.children(child)[0]->targetnodes == (!p & q));
+  REQUIRE(tree.children(child->children[0]).empty());
+}
+
+TEST_CASE("Zielonka trees built from a label DAG match those built without", "[zielonka][dag]")
+{
+  auto var_mgr = std::make_shared<Syft::VarMgr>();
+  const std::string formula = "(Fin 0 | Inf 1) & (Fin 2 | Inf 3)";
+  ZielonkaTree plain(formula, trivial_colors(var_mgr, 4), var_mgr);
+
+  // A partial DAG leaves the labels past its limit to the tree
+  for (std::size_t max_labels : {std::size_t(3), std::size_t(100)}) {
+    std::shared_ptr<const ZielonkaLabelDag> labels =
+        ZielonkaTree::label_dag(Syft::ColorFormula(formula), 4, max_labels);
+    REQUIRE(labels->size() == std::min(max_labels, plain.dag_size()));
+    ZielonkaTree precomputed(Syft::ColorFormula(formula), trivial_colors(var_mgr, 4), var_mgr, true, labels);
+    precomputed.expand_all();
+    REQUIRE(precomputed.size() == plain.size());
+    REQUIRE(precomputed.dag_size() == plain.dag_size());
+    std::vector<ZielonkaNode*> plain_nodes{plain.get_root()}, nodes{precomputed.get_root()};
+    for (std::size_t i = 0; i < plain_nodes.size(); ++i) {
+      REQUIRE(nodes[i]->label == plain_nodes[i]->label);
+      REQUIRE(nodes[i]->children.size() == plain_nodes[i]->children.size());
+      plain_nodes.insert(plain_nodes.end(), plain_nodes[i]->children.begin(), plain_nodes[i]->children.end());
+      nodes.insert(nodes.end(), nodes[i]->children.begin(), nodes[i]->children.end());
+    }
+  }
+}
@@ -1,5 +1,8 @@
 #include "game/InputOutputPartition.h"
 #include "Utils.h"
+#include <algorithm>
+#include <functional>
+#include <vector>
 #include <lydia/logic/ltlfplus/base.hpp>
 #include <lydia/logic/ltlfplus/duality.hpp>
 #include <lydia/parser/ltlfplus/driver.hpp>
@@ -72,8 +75,26 @@ namespace Syft
         //     return result.realizability;
         // }
 
+        Syft::LTLfPlus get_ltlfplus_from_input(const std::string &ltlfplus_formula)
+        {
+            std::shared_ptr<whitemech::lydia::parsers::ltlfplus::LTLfPlusDriver> driver =
+                std::make_shared<whitemech::lydia::parsers::ltlfplus::LTLfPlusDriver>();
+            std::stringstream formula_stream(ltlfplus_formula);
+            driver->parse(formula_stream);
+            auto ptr_ltlf_plus_formula =
+                std::static_pointer_cast<const whitemech::lydia::LTLfPlusFormula>(driver->get_result());
+
+            auto pnf = whitemech::lydia::get_pnf_result(*ptr_ltlf_plus_formula);
+            Syft::LTLfPlus ltlf_plus_formula;
+            ltlf_plus_formula.color_formula_ = pnf.color_formula_;
+            ltlf_plus_formula.formula_to_color_ = pnf.subformula_to_color_;
+            ltlf_plus_formula.formula_to_quantification_ = pnf.subformula_to_quantifier_;
+            return ltlf_plus_formula;
+        }
+
         bool get_realizability_ltlfplus_from_input(const std::string &ltlfplus_formula, const std::vector<std::string> &input_variables,
-                                                   const std::vector<std::string> &output_variables)
+                                                   const std::vector<std::string> &output_variables, bool decompose_components,
+                                                   std::size_t component_threads)
         {
             // LTLf+ driver
             std::shared_ptr<whitemech::lydia::parsers::ltlfplus::LTLfPlusDriver> driver =
@@ -98,17 +119,24 @@ namespace Syft
                                                                                                     output_variables);
             Syft::Player starting_player = Syft::Player::Agent;
 
+            Syft::DfaConstructionOptions dfa_options;
+            dfa_options.decompose_components = decompose_components;
+            dfa_options.component_threads = component_threads;
+
             Syft::LTLfPlusSynthesizer synthesizer(
                 ltlf_plus_formula,
                 partition,
                 starting_player,
-                Syft::Player::Agent);
+                Syft::Player::Agent,
+                Syft::VarMgrOptions(),
+                dfa_options);
             auto synthesis_result = synthesizer.run();
             return synthesis_result.realizability;
         }
 
         bool get_realizability_ltlfplusMP_from_input(const std::string &ltlfplus_formula, const std::vector<std::string> &input_variables,
-                                                     const std::vector<std::string> &output_variables, int mp_solver)
+                                                     const std::vector<std::string> &output_variables, int mp_solver,
+                                                     std::size_t mp_threads, const std::string &mp_work_directory)
         {
             // LTLf+ driver
             std::shared_ptr<whitemech::lydia::parsers::ltlfplus::LTLfPlusDriver> driver =
@@ -133,16 +161,64 @@ namespace Syft
                                                                                                     output_variables);
             Syft::Player starting_player = Syft::Player::Agent;
 
+            Syft::DfaConstructionOptions dfa_options;
+            dfa_options.mp_threads = mp_threads;
+            dfa_options.mp_work_directory = mp_work_directory;
             Syft::LTLfPlusSynthesizerMP synthesizer(
                 ltlf_plus_formula,
                 partition,
                 starting_player,
                 Syft::Player::Agent,
-                mp_solver);
+                mp_solver,
+                Syft::VarMgrOptions(),
+                dfa_options);
             auto synthesis_result = synthesizer.run();
             return synthesis_result.realizability;
         }
 
+        bool verdicts_agree(const std::string &ltlfplus_formula, const Syft::InputOutputPartition &partition,
+                            const std::function<void(Syft::DfaConstructionOptions &)> &option_setter, bool mp_solvers)
+        {
+            Syft::DfaConstructionOptions changed_options;
+            option_setter(changed_options);
+            for (Syft::Player starting_player : {Syft::Player::Agent, Syft::Player::Environment}) {
+                std::vector<bool> verdicts;
+                for (const Syft::DfaConstructionOptions &dfa_options : {Syft::DfaConstructionOptions(), changed_options}) {
+                    Syft::LTLfPlusSynthesizer synthesizer(get_ltlfplus_from_input(ltlfplus_formula), partition,
+                                                          starting_player, Syft::Player::Agent, Syft::VarMgrOptions(),
+                                                          dfa_options);
+                    verdicts.push_back(synthesizer.run().realizability);
+                    for (int game_solver : mp_solvers ? std::vector<int>{1, 2} : std::vector<int>{}) {
+                        Syft::LTLfPlusSynthesizerMP mp_synthesizer(get_ltlfplus_from_input(ltlfplus_formula), partition,
+                                                                   starting_player, Syft::Player::Agent, game_solver,
+                                                                   Syft::VarMgrOptions(), dfa_options);
+                        verdicts.push_back(mp_synthesizer.run().realizability);
+                    }
+                }
+                if (!std::all_of(verdicts.begin(), verdicts.end(), [&verdicts](bool verdict) { return verdict == verdicts[0]; })) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        Syft::PPLTLPlus get_ppltlfplus_from_input(const std::string &ppltlplus_formula)
+        {
+            std::shared_ptr<whitemech::lydia::parsers::ppltlplus::PPLTLPlusDriver> driver =
+                std::make_shared<whitemech::lydia::parsers::ppltlplus::PPLTLPlusDriver>();
+            std::stringstream formula_stream(ppltlplus_formula);
+            driver->parse(formula_stream);
+            auto ppltl_plus_ptr =
+                std::static_pointer_cast<const whitemech::lydia::PPLTLPlusFormula>(driver->get_result());
+
+            auto pnf = whitemech::lydia::get_pnf_result(*ppltl_plus_ptr);
+            Syft::PPLTLPlus ppltl_plus_formula;
+            ppltl_plus_formula.color_formula_ = pnf.color_formula_;
+            ppltl_plus_formula.formula_to_color_ = pnf.subformula_to_color_;
+            ppltl_plus_formula.formula_to_quantification_ = pnf.subformula_to_quantifier_;
+            return ppltl_plus_formula;
+        }
+
         bool get_realizability_ppltlfplus_from_input(const std::string &ppltlfplus_formula, const std::vector<std::string> &input_variables,
                                                      const std::vector<std::string> &output_variables)
         {
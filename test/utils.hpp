@@ -1,12 +1,14 @@
 #ifndef LYDIASYFT_TEST_UTILS_HPP
 #define LYDIASYFT_TEST_UTILS_HPP
 
+#include <functional>
 #include <string>
 #include <sstream>
 #include <chrono>
 #include <ctime>
 #include <iomanip>
 #include "lydia/parser/ltlf/driver.hpp"
+#include "automata/DfaCache.h"
 #include "game/InputOutputPartition.h"
 #include "string_utilities.h"
 #include "Synthesizer.h"
@@ -64,8 +66,16 @@ namespace Syft::Test {
   bool get_realizability_from_input(const std::string& formula, const std::vector<std::string>& input_variables, const std::vector<std::string>& output_variables);
   bool get_realizability(const whitemech::lydia::ltlf_ptr & formula, const Syft::InputOutputPartition& partition);
 
-  bool get_realizability_ltlfplus_from_input(const std::string& ltlfplus_formula, const std::vector<std::string>& input_variables, const std::vector<std::string>& output_variables);
-  bool get_realizability_ltlfplusMP_from_input(const std::string& ltlfplus_formula, const std::vector<std::string>& input_variables, const std::vector<std::string>& output_variables, int mp_solver);
+  Syft::LTLfPlus get_ltlfplus_from_input(const std::string& ltlfplus_formula);
+  bool get_realizability_ltlfplus_from_input(const std::string& ltlfplus_formula, const std::vector<std::string>& input_variables, const std::vector<std::string>& output_variables, bool decompose_components = false, std::size_t component_threads = 1);
+  bool get_realizability_ltlfplusMP_from_input(const std::string& ltlfplus_formula, const std::vector<std::string>& input_variables, const std::vector<std::string>& output_variables, int mp_solver, std::size_t mp_threads = 1, const std::string& mp_work_directory = "");
+  /**
+   * \brief Whether the LTLf+ formula gets the same verdict with the DFA construction options set by \a option_setter as with the default ones.
+   *
+   * Both orders of play are solved by the EL synthesizer and, if \a mp_solvers, also by both Manna-Pnueli solvers.
+   */
+  bool verdicts_agree(const std::string& ltlfplus_formula, const Syft::InputOutputPartition& partition, const std::function<void(Syft::DfaConstructionOptions&)>& option_setter, bool mp_solvers = false);
+  Syft::PPLTLPlus get_ppltlfplus_from_input(const std::string& ppltlfplus_formula);
   bool get_realizability_ppltlfplus_from_input(const std::string& ppltlfplus_formula, const std::vector<std::string>& input_variables, const std::vector<std::string>& output_variables);
   bool get_realizability_ppltlfplusMP_from_input(const std::string& ppltlfplus_formula, const std::vector<std::string>& input_variables, const std::vector<std::string>& output_variables, int mp_solver);
 }